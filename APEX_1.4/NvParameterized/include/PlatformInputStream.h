@@ -74,6 +74,12 @@ public:
 	//Deserialize array of structs of primitive type
 	Serializer::ErrorType readSimpleStructArray(Handle &handle);
 
+	//Storage of already resized dynamic array, NULL if its elements are not elemSize bytes large
+	char *getDynamicArrayBuffer(Handle &handle, int32_t elemSize) const;
+
+	//Do simple struct elements have the same layout in file and in memory?
+	bool isSameSimpleStructLayout(const Definition *pdStruct) const;
+
 	//Deserialize array of primitive type
 	template<typename T> PX_INLINE Serializer::ErrorType readSimpleArray(Handle &handle);
 
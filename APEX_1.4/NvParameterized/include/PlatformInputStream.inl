@@ -90,7 +90,10 @@ template<typename T> PX_INLINE Serializer::ErrorType PlatformInputStream::readSi
 		}
 
 		PX_ASSERT(elemSize * n >= 0);
-		char *p = (char *)mTraits->alloc(static_cast<uint32_t>(elemSize * n));
+
+		//Read straight into the array if we can, this saves a temporary copy of every large array
+		char *buf = getDynamicArrayBuffer(handle, elemSize);
+		char *p = buf ? buf : (char *)mTraits->alloc(static_cast<uint32_t>(elemSize * n));
 		mStream.read(p, static_cast<uint32_t>(elemSize * n));
 
 		if( mCurParams.endian != mTargetParams.endian )
@@ -103,9 +106,12 @@ template<typename T> PX_INLINE Serializer::ErrorType PlatformInputStream::readSi
 			}
 		}
 
-		handle.setParamArray<T>((const T *)p, n);
+		if( !buf )
+		{
+			handle.setParamArray<T>((const T *)p, n);
 
-		mTraits->free(p);
+			mTraits->free(p);
+		}
 	}
 	else
 	{
@@ -29,6 +29,7 @@
 // check comments at the head of BinSerializer.cpp
 
 #include "PlatformInputStream.h"
+#include "NvParameters.h"
 
 using namespace NvParameterized;
 
@@ -183,6 +184,65 @@ Serializer::ErrorType PlatformInputStream::readObjHeader(ObjHeader &hdr)
 	return Serializer::ERROR_NONE;
 }
 
+char *PlatformInputStream::getDynamicArrayBuffer(Handle &handle, int32_t elemSize) const
+{
+	const Definition *pd = handle.parameterDefinition();
+	if( TYPE_ARRAY != pd->type() || pd->arraySizeIsFixed() || 1 != pd->arrayDimension() )
+		return 0;
+
+	NvParameters *obj = static_cast<NvParameters *>(handle.getInterface());
+	if( !obj )
+		return 0;
+
+	void *ptr = 0;
+	size_t offset;
+	obj->getVarPtr(handle, ptr, offset);
+	if( !ptr )
+		return 0;
+
+	DummyDynamicArrayStruct *dynArray = reinterpret_cast<DummyDynamicArrayStruct *>(ptr);
+	return dynArray->elementSize == elemSize ? reinterpret_cast<char *>(dynArray->buf) : 0;
+}
+
+bool PlatformInputStream::isSameSimpleStructLayout(const Definition *pdStruct) const
+{
+	if( mCurParams.endian != mTargetParams.endian
+			|| mCurParams.getSize(pdStruct) != mTargetParams.getSize(pdStruct)
+			|| mCurParams.getAlignment(pdStruct) != mTargetParams.getAlignment(pdStruct)
+			|| mCurParams.getPadding(pdStruct) != mTargetParams.getPadding(pdStruct) )
+		return false;
+
+	//Same sizes and alignments of all fields result in same offsets
+	for(int32_t j = 0; j < pdStruct->numChildren(); ++j)
+	{
+		const Definition *pdField = pdStruct->child(j);
+
+		if( pdField->hint("DONOTSERIALIZE") )
+			return false;
+
+		switch( pdField->type() )
+		{
+#		define NV_PARAMETERIZED_TYPES_NO_LEGACY_TYPES
+#		define NV_PARAMETERIZED_TYPES_ONLY_SIMPLE_TYPES
+#		define NV_PARAMETERIZED_TYPES_NO_STRING_TYPES
+#		define NV_PARAMETERIZED_TYPE(type_name, enum_name, c_type) \
+		case TYPE_##enum_name:
+#		include "nvparameterized/NvParameterized_types.h"
+			break;
+
+		//Legacy matrices are converted on load
+		default:
+			return false;
+		}
+
+		if( mCurParams.getSize(pdField) != mTargetParams.getSize(pdField)
+				|| mCurParams.getAlignment(pdField) != mTargetParams.getAlignment(pdField) )
+			return false;
+	}
+
+	return true;
+}
+
 Serializer::ErrorType PlatformInputStream::readSimpleStructArray(Handle &handle)
 {
 	int32_t n;
@@ -196,6 +256,24 @@ Serializer::ErrorType PlatformInputStream::readSimpleStructArray(Handle &handle)
 
 	align(align_);
 
+	if( n > 0 && isSameSimpleStructLayout(pdStruct) )
+	{
+		//Fast path: elements are stored exactly as we need them, read the whole array at once
+		const int32_t elemSize = static_cast<int32_t>(mCurParams.getSize(pdStruct));
+
+		if( char *buf = getDynamicArrayBuffer(handle, elemSize) )
+		{
+			if( mStream.tellRead() + elemSize * n >= mStream.getFileLength() )
+			{
+				DEBUG_ALWAYS_ASSERT();
+				return Serializer::ERROR_INVALID_INTERNAL_PTR;
+			}
+
+			mStream.read(buf, static_cast<uint32_t>(elemSize * n));
+			return Serializer::ERROR_NONE;
+		}
+	}
+
 	for(int32_t i = 0; i < n; ++i)
 	{
 		beginStruct(align_, pad_);
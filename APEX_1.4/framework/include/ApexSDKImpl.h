@@ -408,6 +408,7 @@ namespace nvidia
 
 #if PX_PHYSICS_VERSION_MAJOR == 0
 			PxCpuDispatcher*			mApexThreadPool;
+			PxCpuDispatcher*			mSharedCpuDispatcher;
 			physx::Array<PxCpuDispatcher*> mUserAllocThreadPools;
 #else
 			PxPhysics*	    				physXSDK;
@@ -138,6 +138,11 @@ PxCudaContextManager* CreateCudaContextManager(const PxCudaContextManagerDesc& d
 
 PxCpuDispatcher* ApexSDKImpl::getDefaultThreadPool()
 {
+	if (mSharedCpuDispatcher)
+	{
+		return mSharedCpuDispatcher;
+	}
+
 	if (!mApexThreadPool)
 	{
 		mApexThreadPool = createDefaultThreadPool(0);
@@ -151,6 +151,7 @@ ApexSDKImpl::ApexSDKImpl(ApexCreateError* errorCode, uint32_t /*inAPEXsdkVersion
 	, mNumTempMemoriesActive(0)
 #if PX_PHYSICS_VERSION_MAJOR == 0
 	, mApexThreadPool(0)
+	, mSharedCpuDispatcher(NULL)
 #endif
 	, renderResourceManager(NULL)
 	, renderResourceManagerWrapper(NULL)
@@ -210,6 +211,8 @@ void ApexSDKImpl::init(const ApexSDKDesc& desc)
 	cooking = desc.cooking;
 	physXSDK = desc.physXSDK;
 	physXsdkVersion = desc.physXSDKVersion;
+#else
+	mSharedCpuDispatcher = desc.cpuDispatcher;
 #endif
 
 	mDllLoadPath = desc.dllLoadPath;
@@ -61,6 +61,10 @@ PxCpuDispatcher* createDefaultThreadPool(unsigned int numThreads)
 		numThreads = 4;
 #elif PX_APPLE_FAMILY
 		numThreads = 2;
+#else
+		// leave one core to the thread that submits the work
+		const uint32_t numCores = shdfnd::Thread::getNbPhysicalCores();
+		numThreads = numCores > 1 ? numCores - 1 : 1;
 #endif
 	}
 	return PX_NEW(DefaultCpuDispatcher)(numThreads, 0);
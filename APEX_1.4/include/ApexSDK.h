@@ -176,6 +176,14 @@ public:
 	\brief Pointer to the cooking interface (PhysX SDK version specific structure)
 	*/
 	PxCooking* cooking;
+#else
+	/**
+	\brief CpuDispatcher shared by all scenes that don't provide their own (optional)
+
+	If NULL, the APEX SDK creates its own default thread pool. Passing the dispatcher the
+	application already uses keeps APEX from starting a second set of worker threads.
+	*/
+	PxCpuDispatcher* cpuDispatcher;
 #endif
 
 	/**
@@ -327,6 +335,8 @@ private:
 		physXSDKVersion = PX_PHYSICS_VERSION;
 		physXSDK = NULL;
 		cooking = NULL;
+#else
+		cpuDispatcher = NULL;
 #endif
 		pvd = NULL;
 		resourceCallback = NULL;
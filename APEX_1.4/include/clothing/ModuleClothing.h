@@ -80,6 +80,20 @@ public:
 	*/
 	virtual ClothingPhysicalMesh* createSingleLayeredMesh(RenderMeshAssetAuthoring* asset, uint32_t subdivision, bool mergeVertices, bool closeHoles, IProgressListener* progress) = 0;
 
+	/**
+	\brief Sets the cloth solver time per scene and frame, in milliseconds, that the clothing actors may use.
+
+	The measured solver time is used to estimate the cost of each actor. Actors that don't fit into the budget
+	are taken out of the simulation and are either frozen or only skinned, depending on ClothingActorDesc::freezeByLOD.
+	Actors that are simulated already are preferred over new ones. A value <= 0 disables the budget, which is the default.
+	*/
+	virtual void setSimulationBudget(float milliseconds) = 0;
+
+	/**
+	\brief Returns the budget set with setSimulationBudget.
+	*/
+	virtual float getSimulationBudget() const = 0;
+
 protected:
 	virtual ~ModuleClothing() {}
 };
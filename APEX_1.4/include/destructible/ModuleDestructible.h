@@ -788,6 +788,21 @@ public:
 	*/
 	virtual void							setMaxFracturesProcessedPerFrame(uint32_t maxFracturesProcessedPerFrame) = 0;
 
+	/**
+		Lets the user throttle the number of weak links the stress solver evaluates per frame (per scene), as peninsula
+		traversal of large structures can be quite costly.  Links beyond this limit are evaluated in subsequent frames.
+		The default is 0xffffffff (unlimited).
+	*/
+	virtual void							setMaxStressEvaluationsPerFrame(uint32_t maxStressEvaluationsPerFrame) = 0;
+
+	/**
+		Lets the user keep up to maxPooledChunkActors released chunk actors (per scene) for reuse by subsequent fractures,
+		instead of releasing them and creating new ones.  Only the actors are reused, chunk shapes are always recreated.
+		Reused actors are reported through DestructiblePhysXActorReport just like newly created ones.
+		The default is 0 (no pooling).
+	*/
+	virtual void							setMaxPooledChunkActors(uint32_t maxPooledChunkActors) = 0;
+
     /**
         Set the callback pointers from which APEX will use to return sync-able data.
     */
@@ -186,6 +186,8 @@ public:
 	bool isVisible() const;
 	void setFrozen(bool enable);
 	bool isFrozenBuffered() const;
+	void setSuspendedByBudget(bool suspend);
+	bool isSimulatingCloth() const;
 	bool shouldComputeRenderData() const;
 	ClothSolverMode::Enum getClothSolverMode() const;
 	void setGraphicalLOD(uint32_t lod);
@@ -524,6 +526,7 @@ protected:
 	uint32_t bUpdateFrozenFlag : 1;
 	uint32_t bBufferedFrozen : 1;
 	uint32_t bInternalFrozen : 1;
+	uint32_t bSuspendedByBudget : 1;						// ClothingScene ran out of simulation budget for this actor
 
 	uint32_t bPressureWarning : 1;
 	uint32_t bUnsucessfullCreation : 1;
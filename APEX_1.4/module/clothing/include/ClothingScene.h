@@ -72,6 +72,7 @@ class ApexSimpleString;
 namespace clothing
 {
 class ModuleClothingImpl;
+class ClothingActorImpl;
 class ClothingAssetImpl;
 class ClothingCookingTask;
 class ClothingDebugRenderParams;
@@ -185,6 +186,7 @@ protected:
 	float					mSumBenefit;
 
 	void					destroy();
+	void					scheduleSimulationBudget();
 
 	class ClothingBeforeTickStartTask : public PxTask
 	{
@@ -231,6 +233,27 @@ private:
 #endif
 
 	nvidia::Time							mClothingSimulationTime;
+	float									mLastSolverTime;
+
+	// simulation budget cost model, in ms per simulated vertex and solver iteration
+	struct BudgetEntry
+	{
+		ClothingActorImpl*	actor;
+		float				cost;
+		bool				simulating;
+	};
+	class BudgetEntryPredicate
+	{
+	public:
+		PX_INLINE bool operator()(const BudgetEntry& a, const BudgetEntry& b) const
+		{
+			// actors that are simulated already go first so they don't toggle from frame to frame
+			return a.simulating != b.simulating ? a.simulating : a.cost < b.cost;
+		}
+	};
+	Array<BudgetEntry>						mBudgetEntries;
+	float									mScheduledCostUnits;
+	float									mSolverCostPerUnit;
 
 	ClothFactory							mCpuFactory;
 #if APEX_CUDA_SUPPORT
@@ -120,6 +120,8 @@ public:
 
 	ClothingPhysicalMesh*		createEmptyPhysicalMesh();
 	ClothingPhysicalMesh*		createSingleLayeredMesh(RenderMeshAssetAuthoring* asset, uint32_t subdivisionSize, bool mergeVertices, bool closeHoles, IProgressListener* progress);
+	void						setSimulationBudget(float milliseconds);
+	float						getSimulationBudget() const;
 
 	PX_INLINE NvParameterized::Interface* getApexClothingActorParams(void) const
 	{
@@ -231,6 +233,8 @@ private:
 	DummyAsset*					mDummyAsset;
 	nvidia::Mutex				mDummyProtector;
 
+	float						mSimulationBudget;
+
 	class ClothingBackendFactory : public BackendFactory, public nvidia::UserAllocated
 	{
 	public:
@@ -314,6 +314,19 @@ void ClothingActorData::skinToAnimation_NoPhysX(bool fromFetchResults)
 	}
 }
 
+// Barycentric interpolation of a mesh-to-mesh skinning target, offset along the interpolated normal by the target height
+PX_INLINE Simd4f interpolateSkinClothMap(const PxVec3& bary, float actorScale, const Simd4f (&vtx)[3], const Simd4f (&nrm)[3])
+{
+	const Simd4f baryX = Simd4fScalarFactory(bary.x);
+	const Simd4f baryY = Simd4fScalarFactory(bary.y);
+	const Simd4f baryZ = Simd4fScalarFactory(1.0f - bary.x - bary.y);
+	const Simd4f height = Simd4fScalarFactory(bary.z * actorScale);
+
+	const Simd4f position = baryX * vtx[0] + baryY * vtx[1] + baryZ * vtx[2];
+	const Simd4f normal = baryX * nrm[0] + baryY * nrm[1] + baryZ * nrm[2];
+	return position + normal * height;
+}
+
 template<bool computeNormals>
 uint32_t ClothingAssetData::skinClothMap(PxVec3* dstPositions, PxVec3* dstNormals, PxVec4* dstTangents, uint32_t numVertices,
 									const AbstractMeshDescription& srcPM, ClothingGraphicalLodParametersNS::SkinClothMapD_Type* map,
@@ -324,7 +337,7 @@ uint32_t ClothingAssetData::skinClothMap(PxVec3* dstPositions, PxVec3* dstNormal
 	const ClothingGraphicalLodParametersNS::SkinClothMapD_Type* PX_RESTRICT pTCM = map;
 	nvidia::prefetchLine(pTCM);
 
-	const float invOffsetAlongNormal = 1.0f / offsetAlongNormal;
+	const Simd4f invOffsetAlongNormalV = Simd4fScalarFactory(1.0f / offsetAlongNormal);
 
 	uint32_t numVerticesWritten = 0;
 	uint32_t numTangentsWritten = 0;
@@ -373,92 +386,43 @@ uint32_t ClothingAssetData::skinClothMap(PxVec3* dstPositions, PxVec3* dstNormal
 
 			numVerticesWritten++;
 
-			//PX_ASSERT(!vertexWriteCache.IsStomped());
-
-			const PxVec3 vtx[3] =
+			const Simd4f vtx[3] =
 			{
-				*(PxVec3*)&srcPM.pPosition[physVertIndex0],
-				*(PxVec3*)&srcPM.pPosition[physVertIndex1],
-				*(PxVec3*)&srcPM.pPosition[physVertIndex2],
+				createSimd3f(srcPM.pPosition[physVertIndex0]),
+				createSimd3f(srcPM.pPosition[physVertIndex1]),
+				createSimd3f(srcPM.pPosition[physVertIndex2]),
 			};
 
-			//PX_ASSERT(!vertexWriteCache.IsStomped());
-
-			const PxVec3 nrm[3] =
+			const Simd4f nrm[3] =
 			{
-				*(PxVec3*)&srcPM.pNormal[physVertIndex0],
-				*(PxVec3*)&srcPM.pNormal[physVertIndex1],
-				*(PxVec3*)&srcPM.pNormal[physVertIndex2],
+				createSimd3f(srcPM.pNormal[physVertIndex0]),
+				createSimd3f(srcPM.pNormal[physVertIndex1]),
+				createSimd3f(srcPM.pNormal[physVertIndex2]),
 			};
 
-			//PX_ASSERT(!vertexWriteCache.IsStomped());
-
-			PxVec3 bary = pTCMLocal->vertexBary;
-			const float vHeight = bary.z * actorScale;
-			bary.z = 1.0f - bary.x - bary.y;
+			const Simd4f resultPosition = interpolateSkinClothMap(pTCMLocal->vertexBary, actorScale, vtx, nrm);
+			store3(&dstPositions[vertexIndex].x, resultPosition);
 
-			const PxVec3 positionVertex = bary.x * vtx[0] + bary.y * vtx[1] + bary.z * vtx[2];
-			const PxVec3 positionNormal = (bary.x * nrm[0] + bary.y * nrm[1] + bary.z * nrm[2]) * vHeight;
-
-			const PxVec3 resultPosition = positionVertex + positionNormal;
-			//Write back - to use a DMA list
-
-			PxVec3* dstPosition = (PxVec3*)&dstPositions[vertexIndex];
-
-			*dstPosition = resultPosition;
-
-			PX_ASSERT(resultPosition.isFinite());
+			PX_ASSERT(dstPositions[vertexIndex].isFinite());
 
 			if (computeNormals)
 			{
-				bary = pTCMLocal->normalBary;
-				const float nHeight = bary.z * actorScale;
-				bary.z = 1.0f - bary.x - bary.y;
-
-				const PxVec3 normalVertex = bary.x * vtx[0] + bary.y * vtx[1] + bary.z * vtx[2];
-				const PxVec3 normalNormal = (bary.x * nrm[0] + bary.y * nrm[1] + bary.z * nrm[2]) * nHeight;
-
-				PxVec3* dstNormal = (PxVec3*)&dstNormals[vertexIndex];
-
 				// we multiply in invOffsetAlongNormal in order to get a newNormal that is closer to size 1,
 				// so the normalize approximation will be better
-				PxVec3 newNormal = ((normalVertex + normalNormal) - (resultPosition)) * invOffsetAlongNormal;
-#if 1
-				// PH: Normally this is accurate enough. For testing we can also use the second
-				const PxVec3 resultNormal = newNormal * nvidia::recipSqrtFast(newNormal.magnitudeSquared());
-				*dstNormal = resultNormal;
-#else
-				newNormal.normalize();
-				*dstNormal = newNormal;
-#endif
+				const Simd4f newNormal = (interpolateSkinClothMap(pTCMLocal->normalBary, actorScale, vtx, nrm) - resultPosition) * invOffsetAlongNormalV;
+				store3(&dstNormals[vertexIndex].x, normalizeSimd3f(newNormal));
 			}
 			if (dstTangents != NULL)
 			{
-				bary = pTCMLocal->tangentBary;
-				const float nHeight = bary.z * actorScale;
-				bary.z = 1.0f - bary.x - bary.y;
-
-				const PxVec3 tangentVertex = bary.x * vtx[0] + bary.y * vtx[1] + bary.z * vtx[2];
-				const PxVec3 tangentTangent = (bary.x * nrm[0] + bary.y * nrm[1] + bary.z * nrm[2]) * nHeight;
-
-				PxVec4* dstTangent = (PxVec4*)&dstTangents[vertexIndex];
-
-				// we multiply in invOffsetAlongNormal in order to get a newNormal that is closer to size 1,
-				// so the normalize approximation will be better
-				PxVec3 newTangent = ((tangentVertex + tangentTangent) - (resultPosition)) * invOffsetAlongNormal;
-#if 1
-				// PH: Normally this is accurate enough. For testing we can also use the second
-				const PxVec3 resultTangent = newTangent * nvidia::recipSqrtFast(newTangent.magnitudeSquared());
+				const Simd4f newTangent = (interpolateSkinClothMap(pTCMLocal->tangentBary, actorScale, vtx, nrm) - resultPosition) * invOffsetAlongNormalV;
 
 				uint32_t arrayIndex	= numTangentsWritten / 4;
 				uint32_t offset		= numTangentsWritten % 4;
 				float w = ((mCompressedTangentW[arrayIndex] >> offset) & 1) ? 1.f : -1.f;
 
-				*dstTangent = PxVec4(resultTangent, w);
-#else
-				newTangent.normalize();
-				*dstTangent = newTangent;
-#endif
+				PxVec4* dstTangent = &dstTangents[vertexIndex];
+				store3(&dstTangent->x, normalizeSimd3f(newTangent));
+				dstTangent->w = w;
 			}
 
 			pTCM++;
@@ -122,6 +122,7 @@ ClothingActorImpl::ClothingActorImpl(const NvParameterized::Interface& descripto
 	bUpdateFrozenFlag(0),
 	bBufferedFrozen(0),
 	bInternalFrozen(0),
+	bSuspendedByBudget(0),
 	bPressureWarning(0),
 	bUnsucessfullCreation(0),
 	bInternalTeleportDue(ClothingTeleportMode::Continuous),
@@ -767,6 +768,21 @@ bool ClothingActorImpl::isFrozenBuffered() const
 
 
 
+void ClothingActorImpl::setSuspendedByBudget(bool suspend)
+{
+	// picked up by the next lodTick, same as the lod dependent solver iterations
+	bSuspendedByBudget = suspend ? 1u : 0u;
+}
+
+
+
+bool ClothingActorImpl::isSimulatingCloth() const
+{
+	return mClothingSimulation != NULL && mCurrentSolverIterations > 0 && bInternalFrozen == 0;
+}
+
+
+
 ClothSolverMode::Enum ClothingActorImpl::getClothSolverMode() const
 {
 	return ClothSolverMode::v3;
@@ -4399,7 +4415,7 @@ void ClothingActorImpl::lodTick_LocksPhysX(float simulationDelta)
 		ClothingMaterialLibraryParametersNS::ClothingMaterial_Type* clothingMaterial = getCurrentClothingMaterial();
 		const uint32_t solverIterations = clothingMaterial != NULL ? clothingMaterial->solverIterations : 5;
 
-		uint32_t solverIterationsTarget = solverIterations;
+		uint32_t solverIterationsTarget = bSuspendedByBudget == 1 ? 0 : solverIterations;
 
 		bool solverIterChanged = (mCurrentSolverIterations != solverIterationsTarget);
 		mCurrentSolverIterations = solverIterationsTarget;
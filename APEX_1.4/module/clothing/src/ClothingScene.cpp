@@ -45,6 +45,7 @@
 #include "PsThread.h"
 #include "ApexUsingNamespace.h"
 #include "PsAtomic.h"
+#include "PsSort.h"
 
 #if APEX_CUDA_SUPPORT
 #include "PxGpuDispatcher.h"
@@ -78,6 +79,9 @@ ClothingScene::ClothingScene(ModuleClothingImpl& _module, SceneIntl& scene, Rend
 	, mSimulatedTime(0.f)
 	, mTimestep(0.f)
 #endif
+	, mLastSolverTime(0.0f)
+	, mScheduledCostUnits(0.0f)
+	, mSolverCostPerUnit(0.0f)
 	, mCpuFactory(NULL, NULL)
 #if APEX_CUDA_SUPPORT
 	, mGpuFactory(NULL, NULL)
@@ -133,6 +137,8 @@ void ClothingScene::simulate(float elapsedTime)
 		clothingActor->waitForFetchResults();
 	}
 
+	scheduleSimulationBudget();
+
 	if (mLastSimulationDeltas.size() < mLastSimulationDeltas.capacity())
 	{
 		mCurrentSimulationDelta = mLastSimulationDeltas.size();
@@ -158,6 +164,60 @@ void ClothingScene::simulate(float elapsedTime)
 
 
 
+void ClothingScene::scheduleSimulationBudget()
+{
+	// the solver of the last frame is done, calibrate the cost model with what it actually took
+	if (mScheduledCostUnits > 0.0f && mLastSolverTime > 0.0f)
+	{
+		const float measuredCostPerUnit = mLastSolverTime / mScheduledCostUnits;
+		mSolverCostPerUnit = mSolverCostPerUnit > 0.0f ? mSolverCostPerUnit + 0.1f * (measuredCostPerUnit - mSolverCostPerUnit) : measuredCostPerUnit;
+	}
+	mLastSolverTime = 0.0f;
+	mScheduledCostUnits = 0.0f;
+
+	const float budget = mModule->getSimulationBudget();
+
+	mBudgetEntries.clear();
+	for (uint32_t i = 0; i < mActorArray.size(); i++)
+	{
+		ClothingActorImpl* clothingActor = static_cast<ClothingActorImpl*>(mActorArray[i]);
+
+		// frozen actors are not simulated and don't use up any budget
+		if (clothingActor->isFrozenBuffered())
+		{
+			clothingActor->setSuspendedByBudget(false);
+			continue;
+		}
+
+		BudgetEntry entry;
+		entry.actor = clothingActor;
+		entry.cost = clothingActor->getMaximumSimulationBudget();
+		entry.simulating = clothingActor->isSimulatingCloth();
+		mBudgetEntries.pushBack(entry);
+	}
+
+	// without a budget or before the first measurement everything is simulated
+	const bool unlimited = budget <= 0.0f || mSolverCostPerUnit <= 0.0f;
+	if (!unlimited)
+	{
+		nvidia::sort(mBudgetEntries.begin(), mBudgetEntries.size(), BudgetEntryPredicate());
+	}
+
+	const float budgetUnits = unlimited ? PX_MAX_F32 : budget / mSolverCostPerUnit;
+	for (uint32_t i = 0; i < mBudgetEntries.size(); i++)
+	{
+		const BudgetEntry& entry = mBudgetEntries[i];
+		const bool fits = mScheduledCostUnits + entry.cost <= budgetUnits;
+		entry.actor->setSuspendedByBudget(!fits);
+		if (fits)
+		{
+			mScheduledCostUnits += entry.cost;
+		}
+	}
+}
+
+
+
 bool ClothingScene::needsManualSubstepping() const
 {
 	// we could test if any of them is being simulated, but assuming some sane budget settings
@@ -779,7 +839,8 @@ void ClothingScene::setSceneRunning(bool on)
 	else
 	{
 		StatValue dataVal;
-		dataVal.Float = (float)(1000.0f * mClothingSimulationTime.getElapsedSeconds());
+		mLastSolverTime = (float)(1000.0f * mClothingSimulationTime.getElapsedSeconds());
+		dataVal.Float = mLastSolverTime;
 		APEX_CHECK_STAT_TIMER("--------- Stop ClothingSimulationTime");
 		mApexScene->setApexStatValue(SceneIntl::ClothingSimulationTime, dataVal);
 
@@ -811,7 +872,15 @@ void ClothingScene::setSceneRunning(bool on)
 		APEX_INTERNAL_ERROR("scene running state was not tracked properly!: on = %s, prevValue = %d", on ? "true" : "false", newValue);
 	}
 #else
-	PX_UNUSED(on);
+	// the simulation budget needs the solver time in all builds
+	if (on)
+	{
+		mClothingSimulationTime.getElapsedSeconds();
+	}
+	else
+	{
+		mLastSolverTime = (float)(1000.0f * mClothingSimulationTime.getElapsedSeconds());
+	}
 #endif
 }
 
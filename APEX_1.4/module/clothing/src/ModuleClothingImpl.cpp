@@ -270,6 +270,7 @@ private:
 ModuleClothingImpl::ModuleClothingImpl(ApexSDKIntl* inSdk)
 	: mDummyActor(NULL)
 	, mDummyAsset(NULL)
+	, mSimulationBudget(0.0f)
 	, mModuleParams(NULL)
 	, mApexClothingActorParams(NULL)
 	, mApexClothingPreviewParams(NULL)
@@ -562,6 +563,22 @@ ClothingPhysicalMesh* ModuleClothingImpl::createSingleLayeredMesh(RenderMeshAsse
 
 
 
+void ModuleClothingImpl::setSimulationBudget(float milliseconds)
+{
+	WRITE_ZONE();
+	mSimulationBudget = milliseconds;
+}
+
+
+
+float ModuleClothingImpl::getSimulationBudget() const
+{
+	READ_ZONE();
+	return mSimulationBudget;
+}
+
+
+
 void ModuleClothingImpl::destroy()
 {
 	mClothingSceneList.clear();
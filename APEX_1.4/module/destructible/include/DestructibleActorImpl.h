@@ -277,6 +277,7 @@ public:
 	PxVec3			getInitialChunkLinearVelocity(uint32_t index) const;
 	PxVec3			getInitialChunkAngularVelocity(uint32_t index) const;
 	PxTransform		getChunkPose(uint32_t index) const;
+	PxTransform		getChunkPose(uint32_t index, DestructibleStructure::ActorPoseCache& cache) const;
 	PxTransform		getChunkTransform(uint32_t index) const;
 	PxVec3			getChunkLinearVelocity(uint32_t index) const;
 	PxVec3			getChunkAngularVelocity(uint32_t index) const;
@@ -340,6 +340,7 @@ public:
 
 	bool						isActorCreationRateExceeded();
 	bool						isFractureBufferProcessRateExceeded();
+	bool						isStressEvaluationRateExceeded();
 
 	void						addToAwakeList(DestructibleActorImpl& actor);
 	void						removeFromAwakeList(DestructibleActorImpl& actor);
@@ -405,6 +406,9 @@ public:
 	}
 
 	void						releasePhysXActor(PxRigidDynamic& actor);
+	PxRigidDynamic*				acquirePhysXActor(const PxTransform& pose);
+	bool						poolPhysXActor(PxRigidDynamic& actor);
+	void						releasePhysXActorPool();
 
 	void						resetEmitterActors();
 
@@ -585,6 +589,7 @@ public:
 
 	uint32_t					mNumFracturesProcessedThisFrame;
 	uint32_t					mNumActorsCreatedThisFrame;
+	uint32_t					mNumStressEvaluationsThisFrame;
 
 	uint32_t					mFractureEventCount;
 
@@ -602,6 +607,18 @@ public:
 	physx::Array<PxRigidDynamic*>			mActorKillList;
 	ResourceList					mApexActorKillList;
 
+	// Released chunk actors kept for reuse, see ModuleDestructible::setMaxPooledChunkActors
+	physx::Array<PxRigidDynamic*>			mPhysXActorPool;
+	struct PooledActorDefaults
+	{
+		bool	valid;
+		float	sleepThreshold;
+		float	stabilizationThreshold;
+		float	minCCDAdvanceCoefficient;
+		float	maxContactImpulse;
+	};
+	PooledActorDefaults				mPooledActorDefaults;	// Captured from a newly created actor, restored on reuse
+
 	// Damage queue
 	RingBuffer<DamageEvent>		mDamageBuffer[2];	// Double-buffering
 	uint32_t						mDamageBufferWriteIndex;
@@ -751,6 +768,7 @@ private:
 	friend class DestructibleActorProxy;
 	friend class DestructibleActorJointImpl;
 	friend class DestructibleStructure;
+	friend class DestructibleStructureStressSolver;
 	friend class DestructibleContactReport;
 	friend class DestructibleContactModify;
 	friend class OverlapSphereShapesReport;
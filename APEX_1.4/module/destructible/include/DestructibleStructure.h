@@ -306,6 +306,7 @@ public:
 	bool						supportInvalid;
 	PxRigidDynamic*					actorForStaticChunks;
 	StressSolver *				stressSolver;
+	Array<PxRigidDynamic*>		supportChunkActors;			// Per chunk, the intact actor of each support depth chunk as of the last separateUnsupportedIslands.  Empty if invalid.
 	
 	typedef HashMap<PxRigidDynamic*, uint32_t> ActorToIslandMap;
 	typedef HashMap<uint32_t, PxRigidDynamic*>	IslandToActorMap;
@@ -409,6 +410,26 @@ public:
 		return getChunkActorPose(chunk) * getChunkLocalPose(chunk);
 	}
 
+	/**
+		Remembers the last actor global pose read by getChunkGlobalPose(chunk, cache).  Chunks
+		of one island share a PxRigidDynamic, so walking them in order reads each actor pose once.
+		Call invalidate() after moving any chunk actor.
+	*/
+	struct ActorPoseCache
+	{
+		ActorPoseCache() : actor(NULL), pose(PxIdentity) {}
+
+		void invalidate()
+		{
+			actor = NULL;
+		}
+
+		const PxRigidActor*	actor;
+		PxTransform			pose;
+	};
+
+	PxTransform getChunkGlobalPose(const Chunk& chunk, ActorPoseCache& cache) const;
+
 	PxTransform getChunkLocalTransform(const Chunk& chunk) const
 	{
 		const physx::Array<PxShape*>* shapes;
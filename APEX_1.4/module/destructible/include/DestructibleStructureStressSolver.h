@@ -241,6 +241,8 @@ public:
 	void							onTick(float deltaTime);
 	void							onUpdate(uint32_t linkedChunkIndex);
 	void							onResolve();
+	void							onResolvePending();
+	bool							isResolvePending() const;
 private:
 	DestructibleStructureStressSolver();
 	DestructibleStructureStressSolver(const DestructibleStructureStressSolver &);
@@ -264,7 +266,7 @@ private:
 	static const StressEvaluationType::Enum StressEvaluationEnum = StressEvaluationType::EvaluateByMoment;
 
 	void							processLinkedChunkIndicesForEvaluation(physx::Array<uint32_t> & linkedChunkIndicesForEvaluation);
-	void							evaluateForPotentialIslands(const physx::Array<uint32_t> & linkedChunkIndicesForEvaluation);
+	void							evaluateForPotentialIslands();
 	bool							passLinkCountTest(uint32_t linkedChunkIndex, physx::Array<uint32_t> & unbrokenAdjacentLinkedChunkIndices) const;
 	bool							passLinkAdjacencyTest(const physx::Array<uint32_t> & unbrokenAdjacentLinkedChunkIndices, uint32_t (&linkedChunkIndicesForTraversal)[2]) const;
 	void							evaluateForPotentialPeninsulas(uint32_t rootLinkedChunkIndex, const uint32_t (&linkedChunkIndicesForTraversal)[2]);
@@ -296,6 +298,7 @@ private:
 	float					userMassThreshold;
 	physx::Array<uint32_t>		recentlyBrokenLinkedChunkIndices;
 	physx::Array<uint32_t>		strainedLinkedChunkIndices;
+	physx::Array<uint32_t>		pendingLinkedChunkIndices;	// links awaiting evaluation, carried over frames once the per-frame evaluation limit is reached
 	physx::Array<SnapEvent*>		snapEventContainer;
 
 	//Shadow scene to simulate a set of linked rigidbodies
@@ -189,6 +189,8 @@ public:
 
 	void						setMaxActorCreatesPerFrame(uint32_t maxActorsPerFrame);
 	void						setMaxFracturesProcessedPerFrame(uint32_t maxActorsPerFrame);
+	void						setMaxStressEvaluationsPerFrame(uint32_t maxStressEvaluationsPerFrame);
+	void						setMaxPooledChunkActors(uint32_t maxPooledChunkActors);
 	void                        setValidBoundsPadding(float);
 
 #if 0 // dead code
@@ -259,6 +261,8 @@ private:
 	float							m_validBoundsPadding;
 	uint32_t							m_maxFracturesProcessedPerFrame;
 	uint32_t							m_maxActorsCreateablePerFrame;
+	uint32_t							m_maxStressEvaluationsPerFrame;
+	uint32_t							m_maxPooledChunkActors;
 	uint32_t							m_dynamicActorFIFOMax;
 	uint32_t							m_chunkFIFOMax;
 	bool									m_sortByBenefit;
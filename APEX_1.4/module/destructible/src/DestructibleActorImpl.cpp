@@ -1099,6 +1099,14 @@ PxTransform DestructibleActorImpl::getChunkPose(uint32_t index) const
 	return mStructure->getChunkGlobalPose(mStructure->chunks[index + mFirstChunkIndex]);
 }
 
+PxTransform DestructibleActorImpl::getChunkPose(uint32_t index, DestructibleStructure::ActorPoseCache& cache) const
+{
+	PX_ASSERT(mStructure != NULL);
+	PX_ASSERT(index + mFirstChunkIndex < mStructure->chunks.size());
+	PX_ASSERT(!mStructure->chunks[index + mFirstChunkIndex].isDestroyed());
+	return mStructure->getChunkGlobalPose(mStructure->chunks[index + mFirstChunkIndex], cache);
+}
+
 PxTransform DestructibleActorImpl::getChunkTransform(uint32_t index) const
 {
 	PX_ASSERT(mStructure != NULL);
@@ -2218,13 +2226,17 @@ void DestructibleActorImpl::fillInstanceBuffers()
 	const uint16_t* indexPtr = mVisibleChunks.usedIndices();
 	const uint16_t* indexPtrStop = indexPtr + mVisibleChunks.usedCount();
 	DestructibleAssetParametersNS::InstanceInfo_Type* instanceDataArray = mAsset->mParams->chunkInstanceInfo.buf;
+
+	// One read lock for the whole pass; chunks sharing a dynamic actor reuse its global pose
+	SCOPED_PHYSX_LOCK_READ(mDestructibleScene->mApexScene);
+	DestructibleStructure::ActorPoseCache poseCache;
 	while (indexPtr < indexPtrStop)
 	{
 		const uint16_t index = *indexPtr++;
 		if (index < mAsset->getChunkCount())
 		{
 			DestructibleAssetParametersNS::Chunk_Type& sourceChunk = sourceChunks[index];
-			PxMat44 pose(getChunkPose(index));
+			PxMat44 pose(getChunkPose(index, poseCache));
 			const PxMat33 poseScaledRotation = PxMat33(getScale().x*pose.getBasis(0), getScale().y*pose.getBasis(1), getScale().z*pose.getBasis(2));
 
 			// Instanced chunks
@@ -2327,6 +2339,10 @@ void DestructibleActorImpl::setRenderTMs(bool processChunkPoseForSyncing /*= fal
 
 		// TODO: Here we update all chunks although we practically know the chunks (active transforms) that have moved. Improve. [APEX-670]
 
+		// Hold the read lock across the pass unless chunk poses may be written below, which needs the write lock
+		ScopedPhysXLockRead passLock(canSyncReadTM ? NULL : mDestructibleScene->mApexScene, __FILE__, __LINE__);
+		DestructibleStructure::ActorPoseCache poseCache;
+
 		while (indexPtr < indexPtrStop)
 		{
 			const uint16_t index = *indexPtr++;
@@ -2358,7 +2374,7 @@ void DestructibleActorImpl::setRenderTMs(bool processChunkPoseForSyncing /*= fal
 								{
 									SCOPED_PHYSX_LOCK_READ(mDestructibleScene->mApexScene);
 
-									const PxTransform calculatedChunkPose = getChunkPose(index);
+									const PxTransform calculatedChunkPose = getChunkPose(index, poseCache);
 									mSyncParams.pushCachedChunkTransform(CachedChunk(index, calculatedChunkPose));
 									chunkPose = calculatedChunkPose;
 									isChunkPoseInit = true;
@@ -2371,6 +2387,7 @@ void DestructibleActorImpl::setRenderTMs(bool processChunkPoseForSyncing /*= fal
 									SCOPED_PHYSX_LOCK_WRITE(getDestructibleScene()->getApexScene());
 									setChunkPose(index, controlledChunkPose);
 								}
+								poseCache.invalidate();
 								chunk.controlledChunk = NULL;
 								chunkPose = controlledChunkPose;
 								isChunkPoseInit = true;
@@ -2378,14 +2395,13 @@ void DestructibleActorImpl::setRenderTMs(bool processChunkPoseForSyncing /*= fal
 							if (!isChunkPoseInit)
 							{
 								SCOPED_PHYSX_LOCK_READ(mDestructibleScene->mApexScene);
-								chunkPose = getChunkPose(index);
+								chunkPose = getChunkPose(index, poseCache);
 								isChunkPoseInit = true;
 							}
 						}
 						else
 						{
-							SCOPED_PHYSX_LOCK_READ(mDestructibleScene->mApexScene);
-							chunkPose = getChunkPose(index);
+							chunkPose = getChunkPose(index, poseCache);
 							isChunkPoseInit = true;
 						}
 						PX_ASSERT(isChunkPoseInit);
@@ -2433,12 +2449,14 @@ void DestructibleActorImpl::setRenderTMs(bool processChunkPoseForSyncing /*= fal
 	{
 		const uint16_t* indexPtr = mVisibleChunks.usedIndices();
 		const uint16_t* indexPtrStop = indexPtr + mVisibleChunks.usedCount();
+		SCOPED_PHYSX_LOCK_READ(mDestructibleScene->mApexScene);
+		DestructibleStructure::ActorPoseCache poseCache;
 		while (indexPtr < indexPtrStop)
 		{
 			const uint16_t index = *indexPtr++;
 			if (index < mAsset->getChunkCount())
 			{
-				const PxMat44 pose(getChunkPose(index));
+				const PxMat44 pose(getChunkPose(index, poseCache));
 				for (uint32_t hullIndex = mAsset->getChunkHullIndexStart(index); hullIndex < mAsset->getChunkHullIndexStop(index); ++hullIndex)
 				{
 					const ConvexHullImpl& chunkSourceConvexHull = mAsset->chunkConvexHulls[hullIndex];
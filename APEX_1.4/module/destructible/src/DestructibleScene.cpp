@@ -684,6 +684,8 @@ DestructibleScene::DestructibleScene(ModuleDestructibleImpl& module, SceneIntl&
 	mContactModify.destructibleScene = this;
 	mNumFracturesProcessedThisFrame = 0;
 	mNumActorsCreatedThisFrame = 0;
+	mNumStressEvaluationsThisFrame = 0;
+	mPooledActorDefaults.valid = false;
 	mApexScene->addModuleUserNotifier(mUserNotify);
 
 #if APEX_RUNTIME_FRACTURE
@@ -997,6 +999,8 @@ void DestructibleScene::reset()
 	mChunkKillList.clear();
 
 	m_damageApplicationRaycastFlags = nvidia::DestructibleActorRaycastFlags::StaticChunks;
+
+	releasePhysXActorPool();
 }
 
 void DestructibleScene::resetEmitterActors()
@@ -1129,6 +1133,7 @@ void DestructibleScene::tasked_beforeTick(float elapsedTime)
 
 	mNumFracturesProcessedThisFrame = 0;	//reset this counter
 	mNumActorsCreatedThisFrame = 0;			//reset this counter
+	mNumStressEvaluationsThisFrame = 0;		//reset this counter
 
 	resetEmitterActors();
 
@@ -2530,8 +2535,82 @@ void DestructibleScene::releasePhysXActor(PxRigidDynamic& actor)
 
 
 	mModule->mSdk->releaseObjectDesc(&actor);
-	SCOPED_PHYSX_LOCK_WRITE(actor.getScene());
-	actor.release();
+	if (!poolPhysXActor(actor))
+	{
+		SCOPED_PHYSX_LOCK_WRITE(actor.getScene());
+		actor.release();
+	}
+}
+
+PxRigidDynamic* DestructibleScene::acquirePhysXActor(const PxTransform& pose)
+{
+	if (mPhysXActorPool.empty())
+	{
+		PxRigidDynamic* actor = mPhysXScene->getPhysics().createRigidDynamic(pose);
+		if (actor != NULL && !mPooledActorDefaults.valid)
+		{
+			mPooledActorDefaults.sleepThreshold = actor->getSleepThreshold();
+			mPooledActorDefaults.stabilizationThreshold = actor->getStabilizationThreshold();
+			mPooledActorDefaults.minCCDAdvanceCoefficient = actor->getMinCCDAdvanceCoefficient();
+			mPooledActorDefaults.maxContactImpulse = actor->getMaxContactImpulse();
+			mPooledActorDefaults.valid = true;
+		}
+		return actor;
+	}
+
+	// Restore whatever the PhysX3 template and the callers do not set on a new chunk actor
+	PxRigidDynamic* actor = mPhysXActorPool.popBack();
+	actor->setRigidBodyFlags(PxRigidBodyFlags());
+	actor->setGlobalPose(pose);
+	actor->setLinearVelocity(PxVec3(0.0f), false);
+	actor->setAngularVelocity(PxVec3(0.0f), false);
+	actor->setRigidDynamicLockFlags(PxRigidDynamicLockFlags());
+	actor->setContactReportThreshold(PX_MAX_F32);
+	actor->setSleepThreshold(mPooledActorDefaults.sleepThreshold);
+	actor->setStabilizationThreshold(mPooledActorDefaults.stabilizationThreshold);
+	actor->setMinCCDAdvanceCoefficient(mPooledActorDefaults.minCCDAdvanceCoefficient);
+	actor->setMaxContactImpulse(mPooledActorDefaults.maxContactImpulse);
+	actor->setName(NULL);
+	return actor;
+}
+
+bool DestructibleScene::poolPhysXActor(PxRigidDynamic& actor)
+{
+	if (mPhysXActorPool.size() >= mModule->m_maxPooledChunkActors || !mPooledActorDefaults.valid)
+	{
+		return false;
+	}
+
+	PxScene* scene = actor.getScene();
+	SCOPED_PHYSX_LOCK_WRITE(scene);
+
+	// Joints and aggregates would carry over to the next chunk using this actor
+	if (actor.getNbConstraints() > 0 || actor.getAggregate() != NULL)
+	{
+		return false;
+	}
+
+	if (scene != NULL)
+	{
+		scene->removeActor(actor, false);
+	}
+	while (actor.getNbShapes() > 0)
+	{
+		PxShape* shape;
+		actor.getShapes(&shape, 1, 0);
+		actor.detachShape(*shape, false);
+	}
+	mPhysXActorPool.pushBack(&actor);
+	return true;
+}
+
+void DestructibleScene::releasePhysXActorPool()
+{
+	for (uint32_t i = 0; i < mPhysXActorPool.size(); ++i)
+	{
+		mPhysXActorPool[i]->release();
+	}
+	mPhysXActorPool.reset();
 }
 
 bool DestructibleScene::scheduleChunkShapesForDelete(DestructibleStructure::Chunk& chunk)
@@ -2741,6 +2820,11 @@ bool DestructibleScene::isFractureBufferProcessRateExceeded()
 	return mNumFracturesProcessedThisFrame >= mModule->m_maxFracturesProcessedPerFrame;
 }
 
+bool DestructibleScene::isStressEvaluationRateExceeded()
+{
+	return mNumStressEvaluationsThisFrame >= mModule->m_maxStressEvaluationsPerFrame;
+}
+
 void DestructibleScene::addToAwakeList(DestructibleActorImpl& actor)
 {
 	if (mAwakeActors.use(actor.getID()))
@@ -3600,7 +3684,7 @@ PxRigidDynamic* DestructibleScene::createRoot(DestructibleStructure::Chunk& chun
 
 	poseActor.q.normalize();
 
-	newActor = mPhysXScene->getPhysics().createRigidDynamic(poseActor);
+	newActor = acquirePhysXActor(poseActor);
 
 	PX_ASSERT(newActor && "creating actor failed");
 	if (!newActor)
@@ -509,6 +509,10 @@ void DestructibleStructure::tickStressSolver(float deltaTime)
 		{
 			stressSolver->onResolve();
 		}
+		else if (stressSolver->isResolvePending())
+		{
+			stressSolver->onResolvePending();
+		}
 	}
 }
 
@@ -1334,7 +1338,44 @@ void DestructibleStructure::separateUnsupportedIslands()
 	// have been three (or more) because of discontinuities.  Fix it.
 
 	PX_PROFILE_ZONE("DestructibleSeparateUnsupportedIslands", GetInternalApexSDK()->getContextId());
-	physx::Array<uint32_t> chunksRemaining = supportDepthChunks;
+
+	// All island actors live in the module's PhysX scene, so take the read lock once for both
+	// the island discovery and the island separation passes instead of once per island.
+	SCOPED_PHYSX_LOCK_READ(dscene->getModulePhysXScene());
+
+	// Only chunks whose actor changed since the last pass, and their neighbors, can belong to an island
+	// that needs separating.  Untouched islands were already resolved by an earlier pass, so the search
+	// starts from those seeds instead of the whole support graph.  Without a valid cache (first pass,
+	// support graph rebuilt, external support changed) every support chunk is a seed.
+	physx::Array<uint32_t> seeds;
+	const bool fullSearch = supportChunkActors.size() != chunks.size();
+	if (fullSearch)
+	{
+		seeds = supportDepthChunks;
+		supportChunkActors.resize(chunks.size());
+		for (uint32_t i = 0; i < supportChunkActors.size(); ++i)
+		{
+			supportChunkActors[i] = NULL;
+		}
+	}
+	else
+	{
+		for (uint32_t supportChunkNum = 0; supportChunkNum < supportDepthChunks.size(); ++supportChunkNum)
+		{
+			const uint32_t chunkIndex = supportDepthChunks[supportChunkNum];
+			if (dscene->chunkIntact(chunks[chunkIndex]) == supportChunkActors[chunkIndex])
+			{
+				continue;
+			}
+			seeds.pushBack(chunkIndex);
+			for (uint32_t j = firstOverlapIndices[chunkIndex]; j < firstOverlapIndices[chunkIndex + 1]; ++j)
+			{
+				seeds.pushBack(overlaps[j]);
+			}
+		}
+	}
+
+	physx::Array<uint32_t> visited;
 	physx::Array<ChunkIsland> islands;
 
 	// Instead of sorting to find islands that share actors, will merely count.
@@ -1342,10 +1383,9 @@ void DestructibleStructure::separateUnsupportedIslands()
 	// to eliminate most of the work this way.
 	physx::Array<ActorIslandData> islandData(dscene->mActorFIFO.size() + dscene->mDormantActors.usedCount() + 1);	// Max size needed
 
-	while (chunksRemaining.size())
+	for (uint32_t seedNum = seeds.size(); seedNum--;)
 	{
-		uint32_t chunkIndex = chunksRemaining.back();
-		chunksRemaining.popBack();
+		uint32_t chunkIndex = seeds[seedNum];
 
 		Chunk& chunk = chunks[chunkIndex];
 
@@ -1367,14 +1407,14 @@ void DestructibleStructure::separateUnsupportedIslands()
 			
 			continue;
 		}
-		SCOPED_PHYSX_LOCK_READ(actor->getScene());
 		ChunkIsland& island = islands.insert();
 		island.indices.pushBack(chunkIndex);
 		island.actor = actor;
 		const bool actorStatic = (chunk.state & ChunkDynamic) == 0;
+		const bool actorKinematic = actor->getRigidBodyFlags() & physx::PxRigidBodyFlag::eKINEMATIC;
 		PhysXObjectDesc* actorObjDesc = (PhysXObjectDesc*) dscene->mModule->mSdk->getPhysXObjectInfo(island.actor);
 		int32_t index = -(int32_t)(intptr_t)actorObjDesc->userData;
-		if (index > 0 && actor->getRigidBodyFlags() & physx::PxRigidBodyFlag::eKINEMATIC)
+		if (index > 0 && actorKinematic)
 		{
 			index = int32_t(dscene->mDormantActors.getRank((uint32_t)index-1) + dscene->mActorFIFO.size());	// Get to the dormant portion of the array
 		}
@@ -1384,6 +1424,7 @@ void DestructibleStructure::separateUnsupportedIslands()
 
 		++islandData[(uint32_t)index].islandCount;
 		chunk.state |= ChunkTemp0;
+		visited.pushBack(chunkIndex);
 		for (uint32_t i = 0; i < island.indices.size(); ++i)
 		{
 			const uint32_t chunkIndex = island.indices[i];
@@ -1396,6 +1437,16 @@ void DestructibleStructure::separateUnsupportedIslands()
 			{
 				island.flags |= ChunkExternallySupported;
 			}
+			if (!fullSearch && actorKinematic && (island.flags & ChunkExternallySupported) != 0)
+			{
+				// A supported static island stays put, there is no need to walk the rest of it.  Unmark the
+				// chunks walked so far, so searches from other seeds in this island can still reach the support.
+				for (uint32_t k = 0; k < island.indices.size(); ++k)
+				{
+					chunks[island.indices[k]].state &= ~(uint32_t)ChunkTemp0;
+				}
+				break;
+			}
 			const uint32_t firstOverlapIndex = firstOverlapIndices[chunkIndex];
 			const uint32_t stopOverlapIndex = firstOverlapIndices[chunkIndex + 1];
 			for (uint32_t j = firstOverlapIndex; j < stopOverlapIndex; ++j)
@@ -1413,6 +1464,7 @@ void DestructibleStructure::separateUnsupportedIslands()
 						{
 							island.indices.pushBack(overlapChunkIndex);
 							overlapChunk.state |= (uint32_t)ChunkTemp0;
+							visited.pushBack(overlapChunkIndex);
 						}
 					}
 				}
@@ -1428,7 +1480,6 @@ void DestructibleStructure::separateUnsupportedIslands()
 	{
 		ChunkIsland& island = islands[islandNum];
 
-		SCOPED_PHYSX_LOCK_READ(island.actor->getScene());
 		if (island.actor->getNbShapes() == 0)
 		{
 			// This can happen if this island's chunks have all been destroyed
@@ -1575,9 +1626,19 @@ void DestructibleStructure::separateUnsupportedIslands()
 		}
 	}
 
-	for (uint32_t supportChunkNum = 0; supportChunkNum < supportDepthChunks.size(); ++supportChunkNum)
+	for (uint32_t visitedNum = 0; visitedNum < visited.size(); ++visitedNum)
 	{
-		chunks[supportDepthChunks[supportChunkNum]].state &= ~(uint32_t)ChunkTemp0;
+		chunks[visited[visitedNum]].state &= ~(uint32_t)ChunkTemp0;
+	}
+
+	// Record the actors after separation, so the next pass only revisits what changes from here
+	for (uint32_t seedNum = 0; seedNum < seeds.size(); ++seedNum)
+	{
+		supportChunkActors[seeds[seedNum]] = dscene->chunkIntact(chunks[seeds[seedNum]]);
+	}
+	for (uint32_t visitedNum = 0; visitedNum < visited.size(); ++visitedNum)
+	{
+		supportChunkActors[visited[visitedNum]] = dscene->chunkIntact(chunks[visited[visitedNum]]);
 	}
 
 	setSupportInvalid(false);
@@ -1712,7 +1773,7 @@ void DestructibleStructure::createDynamicIsland(const physx::Array<uint32_t>& in
 
 			if (!newActor)
 			{
-				newActor = dscene->mPhysXScene->getPhysics().createRigidDynamic(actor->getGlobalPose());
+				newActor = dscene->acquirePhysXActor(actor->getGlobalPose());
 
 				PX_ASSERT(newActor);
 				physX3Template.apply(newActor);
@@ -1905,6 +1966,7 @@ void DestructibleStructure::calculateExternalSupportChunks()
 
 	supportDepthChunks.resize(0);
 	supportDepthChunksNotExternallySupportedCount = 0;
+	supportChunkActors.reset();	// External support may have changed, force a full island search
 
 	// iterate all chunks, one destructible after the other
 	for (uint32_t i = 0; i < destructibles.size(); ++i)
@@ -2030,6 +2092,7 @@ void DestructibleStructure::invalidateBounds(const PxBounds3* bounds, uint32_t b
 		{
 			chunk.flags &= ~(uint8_t)ChunkExternallySupported;
 			swap(supportDepthChunks[supportDepthChunksNotExternallySupportedCount++], supportDepthChunks[chunkNum++]);
+			supportChunkActors.reset();	// Islands which were supported may no longer be, force a full island search
 			supportInvalid = true;
 		}
 	}
@@ -2421,6 +2484,30 @@ PxTransform DestructibleStructure::getChunkActorPose(const Chunk& chunk) const
 	return pose;
 }
 
+PxTransform DestructibleStructure::getChunkGlobalPose(const Chunk& chunk, ActorPoseCache& cache) const
+{
+	const physx::Array<PxShape*>& shapes = getChunkShapes(chunk);
+	if (shapes.empty() || NULL == shapes[0])
+	{
+		return getChunkLocalPose(chunk);
+	}
+
+	SCOPED_PHYSX_LOCK_READ(dscene->getModulePhysXScene());
+	const PxRigidActor* actor = shapes[0]->getActor();
+	if (actor != cache.actor)
+	{
+		cache.actor = actor;
+		cache.pose = actor->getGlobalPose();
+	}
+
+	PxTransform localPose = shapes[0]->getLocalPose();
+	if (chunk.visibleAncestorIndex != (int32_t)InvalidChunkIndex)
+	{
+		localPose.p += chunk.localOffset - chunks[(uint32_t)chunk.visibleAncestorIndex].localOffset;
+	}
+	return cache.pose * localPose;
+}
+
 void DestructibleStructure::setSupportInvalid(bool supportIsInvalid)
 {
 	supportInvalid = supportIsInvalid;
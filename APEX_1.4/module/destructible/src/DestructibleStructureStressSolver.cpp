@@ -848,12 +848,26 @@ void DestructibleStructureStressSolver::onResolve()
 {
 	physx::Array<uint32_t> linkedChunkIndicesForEvaluation;
 	processLinkedChunkIndicesForEvaluation(linkedChunkIndicesForEvaluation);
-	if(!linkedChunkIndicesForEvaluation.empty())
+	for(physx::Array<uint32_t>::ConstIterator kIter = linkedChunkIndicesForEvaluation.begin(); kIter != linkedChunkIndicesForEvaluation.end(); ++kIter)
+	{
+		pendingLinkedChunkIndices.pushBack(*kIter);
+	}
+	onResolvePending();
+}
+
+void DestructibleStructureStressSolver::onResolvePending()
+{
+	if(!pendingLinkedChunkIndices.empty())
 	{
-		evaluateForPotentialIslands(linkedChunkIndicesForEvaluation);
+		evaluateForPotentialIslands();
 	}
 }
 
+bool DestructibleStructureStressSolver::isResolvePending() const
+{
+	return !pendingLinkedChunkIndices.empty();
+}
+
 void DestructibleStructureStressSolver::processLinkedChunkIndicesForEvaluation(physx::Array<uint32_t> & linkedChunkIndicesForEvaluation)
 {
 	PX_ASSERT(NULL != &linkedChunkIndicesForEvaluation);
@@ -877,6 +891,15 @@ void DestructibleStructureStressSolver::processLinkedChunkIndicesForEvaluation(p
 		}
 	}
 
+	// avoid getting links which are still pending evaluation from a previous frame
+	for(physx::Array<uint32_t>::ConstIterator kIter = pendingLinkedChunkIndices.begin(); kIter != pendingLinkedChunkIndices.end(); ++kIter)
+	{
+		if(!evaluationRecord.isOccupied(*kIter))
+		{
+			evaluationRecord.setOccupied(*kIter);
+		}
+	}
+
 	// push unique adjacent unbroken links of recently broken links
 	while(!recentlyBrokenLinkedChunkIndices.empty())
 	{
@@ -943,15 +966,25 @@ void DestructibleStructureStressSolver::processLinkedChunkIndicesForEvaluation(p
 	PX_ASSERT(recentlyBrokenLinkedChunkIndices.empty());
 }
 
-void DestructibleStructureStressSolver::evaluateForPotentialIslands(const physx::Array<uint32_t> & linkedChunkIndicesForEvaluation)
+void DestructibleStructureStressSolver::evaluateForPotentialIslands()
 {
 	PX_COMPILE_TIME_ASSERT(2 == DestructibleStructureStressSolver::PathTraversalCount);
-	PX_ASSERT(NULL != &linkedChunkIndicesForEvaluation);
-	PX_ASSERT(!linkedChunkIndicesForEvaluation.empty());
-	for(physx::Array<uint32_t>::ConstIterator kIter = linkedChunkIndicesForEvaluation.begin(); kIter != linkedChunkIndicesForEvaluation.end(); ++kIter)
+	PX_ASSERT(!pendingLinkedChunkIndices.empty());
+
+	// evaluate up to the scene's per-frame limit, the remaining links are carried over to the next frame
+	DestructibleScene & scene = *bindedStructureAlias.dscene;
+	uint32_t evaluatedCount = 0;
+	for(; evaluatedCount < pendingLinkedChunkIndices.size() && !scene.isStressEvaluationRateExceeded(); ++evaluatedCount)
 	{
-		const uint32_t currentLinkedChunkIndex = *kIter;
+		const uint32_t currentLinkedChunkIndex = pendingLinkedChunkIndices[evaluatedCount];
 		PX_ASSERT(assertLinkedChunkIndexOk(currentLinkedChunkIndex));
+		++scene.mNumStressEvaluationsThisFrame;
+
+		// a link carried over from a previous frame may have been broken off in the meantime
+		if(isLinkedChunkBroken(currentLinkedChunkIndex))
+		{
+			continue;
+		}
 		physx::Array<uint32_t> unbrokenAdjacentLinkedChunkIndices;
 		if(passLinkCountTest(currentLinkedChunkIndex, unbrokenAdjacentLinkedChunkIndices))
 		{
@@ -964,6 +997,7 @@ void DestructibleStructureStressSolver::evaluateForPotentialIslands(const physx:
 			}
 		}
 	}
+	pendingLinkedChunkIndices.removeRange(0, evaluatedCount);
 }
 
 bool DestructibleStructureStressSolver::passLinkCountTest(uint32_t linkedChunkIndex, physx::Array<uint32_t> & unbrokenAdjacentLinkedChunkIndices) const
@@ -228,6 +228,8 @@ ModuleDestructibleImpl::ModuleDestructibleImpl(ApexSDKIntl* inSdk) :
 	m_maxChunkSeparationLOD(0.5f),
 	m_maxFracturesProcessedPerFrame(UINT32_MAX),
 	m_maxActorsCreateablePerFrame(UINT32_MAX),
+	m_maxStressEvaluationsPerFrame(UINT32_MAX),
+	m_maxPooledChunkActors(0),
 	m_dynamicActorFIFOMax(0),
 	m_chunkFIFOMax(0),
 	m_sortByBenefit(false),
@@ -628,6 +630,18 @@ void ModuleDestructibleImpl::setMaxFracturesProcessedPerFrame(uint32_t maxFractu
 	m_maxFracturesProcessedPerFrame = maxFracturesProcessedPerFrame;
 }
 
+void ModuleDestructibleImpl::setMaxStressEvaluationsPerFrame(uint32_t maxStressEvaluationsPerFrame)
+{
+	WRITE_ZONE();
+	m_maxStressEvaluationsPerFrame = maxStressEvaluationsPerFrame;
+}
+
+void ModuleDestructibleImpl::setMaxPooledChunkActors(uint32_t maxPooledChunkActors)
+{
+	WRITE_ZONE();
+	m_maxPooledChunkActors = maxPooledChunkActors;
+}
+
 #if 0 // dead code
 void ModuleDestructible::releaseBufferedConvexMeshes()
 {
@@ -67,6 +67,10 @@ public:
 
 	virtual PxVec3				randomPosInFullVolume(const PxMat44&, QDSRand&) const = 0;
 
+	/* Batched position generation for large bursts, the poses are only set up once per batch */
+	virtual void				randomPositionsInFullVolume(const PxMat44&, QDSRand&, PxVec3* positions, uint32_t count) const;
+	virtual void				randomPositionsInNewlyCoveredVolume(const PxMat44&, const PxMat44&, QDSRand&, PxVec3* positions, uint32_t count) const;
+
 	/* AssetPreview methods */
 	virtual void                        drawPreview(float scale, RenderDebugInterface* renderDebug) const = 0;
 
@@ -77,7 +81,13 @@ public:
 	virtual PxVec3				randomPosInNewlyCoveredVolume(const PxMat44&, const PxMat44&, QDSRand&) const;
 
 protected:
-	virtual bool						isInEmitter(const PxVec3& pos, const PxMat44& pose) const = 0;
+	/* Tests a position given in the emitter's local frame */
+	virtual bool						isInEmitterLocal(const PxVec3& localPos) const = 0;
+
+	bool								isInEmitter(const PxVec3& pos, const PxMat44& pose) const
+	{
+		return isInEmitterLocal(pose.inverseRT().transform(pos));
+	}
 };
 
 }
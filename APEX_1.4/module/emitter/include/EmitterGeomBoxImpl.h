@@ -78,8 +78,6 @@ public:
 
 	/* Actor callable methods */
 	void						visualize(const PxTransform& pose, RenderDebugInterface& renderDebug);
-	float				computeNewlyCoveredVolume(const PxMat44&, const PxMat44&, float, QDSRand&) const;
-
 	void						computeFillPositions(physx::Array<PxVec3>& positions,
 	        physx::Array<PxVec3>& velocities,
 	        const PxTransform&,
@@ -92,13 +90,7 @@ public:
 	PxVec3				randomPosInFullVolume(
 	    const PxMat44& pose,
 	    QDSRand& rand) const;
-	PxVec3				randomPosInNewlyCoveredVolume(
-	    const PxMat44& pose,
-	    const PxMat44& oldPose,
-	    QDSRand& rand) const;
-	bool						isInEmitter(
-	    const PxVec3& pos,
-	    const PxMat44& pose) const;
+	bool						isInEmitterLocal(const PxVec3& localPos) const;
 
 protected:
 	EmitterType::Enum		mType;
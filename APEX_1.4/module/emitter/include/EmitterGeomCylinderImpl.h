@@ -97,7 +97,7 @@ public:
 
 	float				computeEmitterVolume() const;
 	PxVec3				randomPosInFullVolume(const PxMat44& pose, QDSRand& rand) const;
-	bool						isInEmitter(const PxVec3& pos, const PxMat44& pose) const;
+	bool						isInEmitterLocal(const PxVec3& localPos) const;
 
 protected:
 	EmitterType::Enum		mType;
@@ -114,7 +114,7 @@ public:
 	{
 		return PxVec3(0.0f, 0.0f, 0.0f);
 	}
-	bool						isInEmitter(const PxVec3&, const PxMat44&) const
+	bool						isInEmitterLocal(const PxVec3&) const
 	{
 		return false;
 	}
@@ -601,45 +601,52 @@ void EmitterActorImpl::emitObjects(const PxTransform& pose, uint32_t toEmitNum,
 	}
 
 	PxVec3 emitterOrigin = getGlobalPose().getPosition();
-	// TODO: This could obviously be more efficient
+	const uint32_t maxSamples = mAsset->getMaxSamples();
+	const PxMat44 poseMat(pose);
+	const PxMat44 oldPoseMat(mOldPose);
+
 	uint32_t emittedCount = 0;
+	uint32_t sampleCount = 0;
 	mNewObjectArray.clear();
-	mNewObjectArray.reserve(mAsset->getMaxSamples());
-	for (uint32_t i = 0; i < mAsset->getMaxSamples(); i++)
+	mNewObjectArray.reserve(PxMin(toEmitNum, maxSamples));
+	while (emittedCount < toEmitNum && sampleCount < maxSamples)
 	{
-		PxVec3 pos;
+		// generate the positions that are still missing in one batch, only rejected ones cause another round
+		const uint32_t batchSize = PxMin(toEmitNum - emittedCount, maxSamples - sampleCount);
+		mNewPositions.resizeUninitialized(batchSize);
 		if (useFullVolume)
 		{
-			pos = mAsset->mGeom->randomPosInFullVolume(pose, mRand);
+			mAsset->mGeom->randomPositionsInFullVolume(poseMat, mRand, mNewPositions.begin(), batchSize);
 		}
 		else
 		{
-			pos = mAsset->mGeom->randomPosInNewlyCoveredVolume(pose, mOldPose, mRand);
+			mAsset->mGeom->randomPositionsInNewlyCoveredVolume(poseMat, oldPoseMat, mRand, mNewPositions.begin(), batchSize);
 		}
+		sampleCount += batchSize;
 
-		if ( mEmitterValidateCallback )
+		for (uint32_t i = 0; i < batchSize; i++)
 		{
-			if ( !mEmitterValidateCallback->validateEmitterPosition(emitterOrigin, pos))
+			PxVec3& pos = mNewPositions[i];
+			if ( mEmitterValidateCallback )
 			{
-				continue;
+				if ( !mEmitterValidateCallback->validateEmitterPosition(emitterOrigin, pos))
+				{
+					continue;
+				}
 			}
-		}
 
+			mOverlapAABB.include(pos);
 
-		mOverlapAABB.include(pos);
+			IosNewObject& obj = mNewObjectArray.insert();
+			obj.initialPosition = pos;
+			obj.initialVelocity = pose.rotate(mRand.getScaled(mVelocityLow, mVelocityHigh));
 
-		IosNewObject& obj = mNewObjectArray.insert();
-		obj.initialPosition = pos;
-		obj.initialVelocity = pose.rotate(mRand.getScaled(mVelocityLow, mVelocityHigh));
+			obj.lifetime = mRand.getScaled(mLifetimeLow, mLifetimeHigh);
+			obj.iofxActorID	= IofxActorIDIntl(0);
+			obj.lodBenefit	= 0.0f;
+			obj.userData = 0;
 
-		obj.lifetime = mRand.getScaled(mLifetimeLow, mLifetimeHigh);
-		obj.iofxActorID	= IofxActorIDIntl(0);
-		obj.lodBenefit	= 0.0f;
-		obj.userData = 0;
-
-		if (++emittedCount >= toEmitNum)
-		{
-			break;
+			emittedCount++;
 		}
 	}
 
@@ -44,10 +44,12 @@ float EmitterGeomBase::computeNewlyCoveredVolume(
 {
 	// estimate by sampling
 	const uint32_t numSamples = 100;
+	const PxMat44 scaledNewPose = PxMat44(newPose) * scale;
+	const PxMat44 invScaledOldPose = (PxMat44(oldPose) * scale).inverseRT();
 	uint32_t numOutsideOldVolume = 0;
 	for (uint32_t i = 0; i < numSamples; i++)
 	{
-		if (!isInEmitter(randomPosInFullVolume(PxMat44(newPose) * scale, rand), PxMat44(oldPose) * scale))
+		if (!isInEmitterLocal(invScaledOldPose.transform(randomPosInFullVolume(scaledNewPose, rand))))
 		{
 			numOutsideOldVolume++;
 		}
@@ -70,5 +72,31 @@ PxVec3 EmitterGeomBase::randomPosInNewlyCoveredVolume(const PxMat44& pose, const
 	return pos;
 }
 
+
+void EmitterGeomBase::randomPositionsInFullVolume(const PxMat44& pose, QDSRand& rand, PxVec3* positions, uint32_t count) const
+{
+	for (uint32_t i = 0; i < count; i++)
+	{
+		positions[i] = randomPosInFullVolume(pose, rand);
+	}
+}
+
+
+void EmitterGeomBase::randomPositionsInNewlyCoveredVolume(const PxMat44& pose, const PxMat44& oldPose, QDSRand& rand, PxVec3* positions, uint32_t count) const
+{
+	// invert the old pose once for all rejection tests instead of once per test
+	const PxMat44 invOldPose = oldPose.inverseRT();
+	for (uint32_t i = 0; i < count; i++)
+	{
+		PxVec3 pos;
+		do
+		{
+			pos = randomPosInFullVolume(pose, rand);
+		}
+		while (isInEmitterLocal(invOldPose.transform(pos)));
+		positions[i] = pos;
+	}
+}
+
 }
 } // namespace nvidia::apex
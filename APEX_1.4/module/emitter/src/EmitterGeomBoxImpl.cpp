@@ -131,28 +131,6 @@ float EmitterGeomBoxImpl::computeEmitterVolume() const
 }
 
 
-/* Return percentage of new volume not covered by old volume */
-float EmitterGeomBoxImpl::computeNewlyCoveredVolume(
-    const PxMat44& oldPose,
-    const PxMat44& newPose,
-	float scale,
-    QDSRand& rand) const
-{
-	// estimate by sampling
-	const uint32_t numSamples = 100;
-	uint32_t numOutsideOldVolume = 0;
-	for (uint32_t i = 0; i < numSamples; i++)
-	{
-		if (!isInEmitter(randomPosInFullVolume(PxMat44(newPose) * scale, rand), PxMat44(oldPose) * scale))
-		{
-			numOutsideOldVolume++;
-		}
-	}
-
-	return (float) numOutsideOldVolume / numSamples;
-}
-
-
 void EmitterGeomBoxImpl::computeFillPositions(physx::Array<PxVec3>& positions,
         physx::Array<PxVec3>& velocities,
         const PxTransform& pose,
@@ -198,10 +176,8 @@ PxVec3 EmitterGeomBoxImpl::randomPosInFullVolume(const PxMat44& pose, QDSRand& r
 	return pose.transform(pos);
 }
 
-bool EmitterGeomBoxImpl::isInEmitter(const PxVec3& pos, const PxMat44& pose) const
+bool EmitterGeomBoxImpl::isInEmitterLocal(const PxVec3& localPos) const
 {
-	PxVec3 localPos = pose.inverseRT().transform(pos);
-
 	if (localPos.x < -mExtents->x)
 	{
 		return false;
@@ -230,18 +206,5 @@ bool EmitterGeomBoxImpl::isInEmitter(const PxVec3& pos, const PxMat44& pose) con
 	return true;
 }
 
-PxVec3 EmitterGeomBoxImpl::randomPosInNewlyCoveredVolume(const PxMat44& pose, const PxMat44& oldPose, QDSRand& rand) const
-{
-	// TODO make better, this is very slow when emitter moves slowly
-	// SJB: I'd go one further, this seems mildly retarted
-	PxVec3 pos;
-	do
-	{
-		pos = randomPosInFullVolume(pose, rand);
-	}
-	while (isInEmitter(pos, oldPose));
-	return pos;
-}
-
 }
 } // namespace nvidia::apex
@@ -153,19 +153,14 @@ PxVec3 EmitterGeomCylinderImpl::randomPosInFullVolume(const PxMat44& pose, QDSRa
 
 	pos = PxVec3(u * (*mRadius), v, w * (*mRadius));
 
-#if _DEBUG
-	PxMat44 tmpPose(PxIdentity);
-	PX_ASSERT(isInEmitter(pos, tmpPose));
-#endif
+	PX_ASSERT(isInEmitterLocal(pos));
 
 	return pose.transform(pos);
 }
 
 
-bool EmitterGeomCylinderImpl::isInEmitter(const PxVec3& pos, const PxMat44& pose) const
+bool EmitterGeomCylinderImpl::isInEmitterLocal(const PxVec3& localPos) const
 {
-	PxVec3 localPos = pose.inverseRT().transform(pos);
-
 	if (localPos.x < -*mRadius)
 	{
 		return false;
@@ -211,9 +211,8 @@ PxVec3 EmitterGeomSphereImpl::randomPosInFullVolume(const PxMat44& pose, QDSRand
 }
 
 
-bool EmitterGeomSphereImpl::isInEmitter(const PxVec3& pos, const PxMat44& pose) const
+bool EmitterGeomSphereImpl::isInEmitterLocal(const PxVec3& localPos) const
 {
-	const PxVec3 localPos = pose.inverseRT().transform(pos);
 	const float radius = *mRadius;
 	const float radiusSquared = radius * radius;
 	const float hemisphere = *mHemisphere;
@@ -277,14 +277,13 @@ PxVec3 EmitterGeomSphereShellImpl::randomPosInFullVolume(const PxMat44& pose, QD
 }
 
 
-bool EmitterGeomSphereShellImpl::isInEmitter(const PxVec3& pos, const PxMat44& pose) const
+bool EmitterGeomSphereShellImpl::isInEmitterLocal(const PxVec3& localPos) const
 {
-	PxVec3 localPos = pose.inverseRT().transform(pos);
 	const float sphereCapBaseHeight = -(*mRadius + *mShellThickness) + 2 * (*mRadius + *mShellThickness) * (*mHemisphere);
 	float d2 = localPos.x * localPos.x + localPos.y * localPos.y + localPos.z * localPos.z;
 	bool isInBigSphere = d2 < (*mRadius + *mShellThickness) * (*mRadius + *mShellThickness);
 	bool isInSmallSphere = d2 < *mRadius * *mRadius;
-	bool higherThanHemisphereCut = pos.y > sphereCapBaseHeight;
+	bool higherThanHemisphereCut = localPos.y > sphereCapBaseHeight;
 	return isInBigSphere && !isInSmallSphere && higherThanHemisphereCut;
 }
 
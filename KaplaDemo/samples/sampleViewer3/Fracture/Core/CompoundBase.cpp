@@ -43,6 +43,7 @@
 #include "foundation/PxMathUtils.h"
 
 #include <stdio.h>
+#include "PsTime.h"
 
 #include "MathUtils.h"
 
@@ -184,13 +185,16 @@ bool Compound::createFromConvexes(Convex** convexes, int numConvexes, const PxTr
 		return false;
 
 	clear();
+	shdfnd::Time timer;
 	PxVec3 center(0.0f, 0.0f, 0.0f);
 	for (int i = 0; i < numConvexes; i++) 
 		center += convexes[i]->getCenter();
 	center /= (float)numConvexes;
 
-	shdfnd::Array<PxShape*> shapes;
-
+	// create all the convexes first so that their meshes can be cooked in one batch
+	shdfnd::Array<Convex*> prepared;
+	shdfnd::Array<Convex*> toCook;
+	shdfnd::Array<bool> reused;
 	for (int i = 0; i < numConvexes; i++) {
 		Convex *c;
 		if (copyConvexes) {
@@ -201,20 +205,34 @@ bool Compound::createFromConvexes(Convex** convexes, int numConvexes, const PxTr
 			c = convexes[i];
 
 		c->increaseRefCounter();
-		mConvexes.pushBack(c);
+		prepared.pushBack(c);
 
 		PxVec3 off = c->centerAtZero();
 		c->setMaterialOffset(c->getMaterialOffset() + off);
 		c->setLocalPose(PxTransform(off - center));
 
+		reused.pushBack(c->getPxConvexMesh() != NULL);
+		if (!convexes[i]->isGhostConvex())
+			toCook.pushBack(c);
+	}
+	const float prepareMs = (float)timer.getElapsedSeconds() * 1000.0f;
+
+	mScene->profileBegin("cook convex meshes"); //Profiler::getInstance()->begin("cook convex meshes");
+	if (!toCook.empty())
+		Convex::createPxConvexMeshes(&toCook[0], toCook.size(), this, mScene->getPxPhysics(), mScene->getPxCooking());
+	mScene->profileEnd("cook convex meshes"); //Profiler::getInstance()->end("cook convex meshes");
+	const float cookMs = (float)timer.getElapsedSeconds() * 1000.0f;
+
+	shdfnd::Array<PxShape*> shapes;
+
+	for (int i = 0; i < numConvexes; i++) {
+		Convex *c = prepared[i];
+		mConvexes.pushBack(c);
+
 		if (convexes[i]->isGhostConvex())
 			continue;
 
-		bool reused = c->getPxConvexMesh() != NULL;
-
-		mScene->profileBegin("cook convex meshes"); //Profiler::getInstance()->begin("cook convex meshes");
-		PxConvexMesh* mesh = c->createPxConvexMesh(this, mScene->getPxPhysics(), mScene->getPxCooking());
-		mScene->profileEnd("cook convex meshes"); //Profiler::getInstance()->end("cook convex meshes");
+		PxConvexMesh* mesh = c->getPxConvexMesh();
 
 		if (mesh == NULL) {
 			if (c->decreaseRefCounter() <= 0)
@@ -226,7 +244,7 @@ bool Compound::createFromConvexes(Convex** convexes, int numConvexes, const PxTr
 		if (!c->hasExplicitVisMesh())
 			c->createVisMeshFromConvex();
 
-		if (!reused)
+		if (!reused[i])
 			convexAdded(c); //mScene->getConvexRenderer().add(c);
 
 		PxShape *shape = mScene->getPxPhysics()->createShape(
@@ -255,6 +273,7 @@ bool Compound::createFromConvexes(Convex** convexes, int numConvexes, const PxTr
 	}
 
 	createPxActor(shapes, pose, vel, omega);
+	mScene->addCreationTimes(shapes.size(), prepareMs, cookMs, (float)timer.getElapsedSeconds() * 1000.0f);
 
 
 	return true;
@@ -306,23 +325,38 @@ bool Compound::createFromGeometry(const CompoundGeometry &geom, PxRigidDynamic*
 bool Compound::createFromGeometry(const CompoundGeometry &geom, const PxTransform &pose, const PxVec3 &vel, const PxVec3 &omega, Shader* myShader, int matID, int surfMatID)
 {
 	clear();
+	shdfnd::Time timer;
 
-	shdfnd::Array<PxShape*> shapes;
-
-	for (int i = 0; i < (int)geom.convexes.size(); i++) {
+	// create all the convexes first so that their meshes can be cooked in one batch
+	const int numConvexes = (int)geom.convexes.size();
+	shdfnd::Array<Convex*> prepared;
+	shdfnd::Array<bool> reused;
+	for (int i = 0; i < numConvexes; i++) {
 		Convex *c = mScene->createConvex();
 		c->createFromGeometry(geom, i, 0, matID, surfMatID);
 		c->increaseRefCounter();
-		mConvexes.pushBack(c);
+		prepared.pushBack(c);
 
 		PxVec3 off = c->centerAtZero();
 		c->setMaterialOffset(c->getMaterialOffset() + off);
 		c->createVisMeshFromConvex();
 		c->setLocalPose(PxTransform(off));
 
-		bool reused = c->getPxConvexMesh() != NULL;
+		reused.pushBack(c->getPxConvexMesh() != NULL);
+	}
+	const float prepareMs = (float)timer.getElapsedSeconds() * 1000.0f;
 
-		PxConvexMesh* mesh = c->createPxConvexMesh(this, mScene->getPxPhysics(), mScene->getPxCooking());
+	if (numConvexes > 0)
+		Convex::createPxConvexMeshes(&prepared[0], numConvexes, this, mScene->getPxPhysics(), mScene->getPxCooking());
+	const float cookMs = (float)timer.getElapsedSeconds() * 1000.0f;
+
+	shdfnd::Array<PxShape*> shapes;
+
+	for (int i = 0; i < numConvexes; i++) {
+		Convex *c = prepared[i];
+		mConvexes.pushBack(c);
+
+		PxConvexMesh* mesh = c->getPxConvexMesh();
 		if (mesh == NULL) {
 			if (c->decreaseRefCounter() <= 0)
 				PX_DELETE(c);
@@ -330,7 +364,7 @@ bool Compound::createFromGeometry(const CompoundGeometry &geom, const PxTransfor
 			continue;
 		}
 
-		if (!reused)
+		if (!reused[i])
 			convexAdded(c, myShader); //mScene->getConvexRenderer().add(c);
 
 		PxShape *shape;
@@ -364,6 +398,7 @@ bool Compound::createFromGeometry(const CompoundGeometry &geom, const PxTransfor
 		return false;
 
 	createPxActor(shapes, pose, vel, omega);
+	mScene->addCreationTimes(shapes.size(), prepareMs, cookMs, (float)timer.getElapsedSeconds() * 1000.0f);
 	return true;
 }
 
@@ -421,8 +456,6 @@ bool Compound::createPxActor(shdfnd::Array<PxShape*> &shapes, const PxTransform
 	body->setWakeCounter(100000000000.f);
 #endif
 
-	mScene->getScene()->addActor(*body);
-
 	for (int i = 0; i < (int)shapes.size(); i++)
 		body->attachShape(*shapes[i]);
 
@@ -442,6 +475,9 @@ bool Compound::createPxActor(shdfnd::Array<PxShape*> &shapes, const PxTransform
 	body->setLinearVelocity(vel);
 	body->setAngularVelocity(omega);
 
+	// shapes are attached before the insertion, it is either immediate or part of a bulk insertion
+	mScene->insertActor(*body);
+
 	/*if (vel.isZero() && omega.isZero())
 	{
 		body->putToSleep();
@@ -657,36 +657,11 @@ bool Convex::cut(const PxVec3 &localPlaneN, float localPlaneD, bool &cutEmpty, b
 }
 
 // --------------------------------------------------------------------------------------------
-PxConvexMesh* Convex::createPxConvexMesh(Compound *parent, PxPhysics *pxPhysics, PxCooking *pxCooking)
+void Convex::getPxConvexMeshDesc(PxConvexMeshDesc &meshDesc, shdfnd::Array<PxHullPolygon> &polygons)
 {
-	mParent = parent;
-
-	if (mVertices.empty())
-		return NULL;
-
-	if (mPxConvexMesh != NULL) 
-		return mPxConvexMesh;
-
-	mPxConvexMesh = NULL;
-	mPxActor = NULL;
-
 #if COOK_TRIANGLES
-	// create tri mesh
-	// in this tri mesh vertices are shared in contrast to the tri mesh for rendering
-	shdfnd::Array<PxU32> indices;
-	for (int i = 0; i < (int)mFaces.size(); i++) {
-		Face &f = mFaces[i];
-		if (f.numIndices < 3)
-			continue;
-		int *ids = &mIndices[f.firstIndex];
-		for (int j = 1; j < f.numIndices-1; j++) {
-			indices.pushBack(ids[0]);
-			indices.pushBack(ids[j]);
-			indices.pushBack(ids[j+1]);
-		}
-	}
-
-	PxConvexMeshDesc meshDesc;
+	// the hull is computed from the vertices
+	PX_UNUSED(polygons);
 	meshDesc.setToDefault();
 	meshDesc.points.count	  = mVertices.size();
 	meshDesc.points.stride    = sizeof(PxVec3);
@@ -694,7 +669,7 @@ PxConvexMesh* Convex::createPxConvexMesh(Compound *parent, PxPhysics *pxPhysics,
 
 	meshDesc.flags |= PxConvexFlag::eCOMPUTE_CONVEX;
 #else
-	shdfnd::Array<PxHullPolygon> polygons;
+	polygons.clear();
 	polygons.reserve(mFaces.size());
 	if (mPlanes.size() != mFaces.size())
 		updatePlanes();
@@ -713,7 +688,6 @@ PxConvexMesh* Convex::createPxConvexMesh(Compound *parent, PxPhysics *pxPhysics,
 		polygons.pushBack(p);
 	}
 
-	PxConvexMeshDesc meshDesc;
 	meshDesc.setToDefault();
 	meshDesc.flags |= PxConvexFlag::eDISABLE_MESH_VALIDATION;
 	meshDesc.points.count	  = mVertices.size();
@@ -727,6 +701,25 @@ PxConvexMesh* Convex::createPxConvexMesh(Compound *parent, PxPhysics *pxPhysics,
 	meshDesc.polygons.stride  = sizeof(PxHullPolygon);
 
 #endif
+}
+
+// --------------------------------------------------------------------------------------------
+PxConvexMesh* Convex::createPxConvexMesh(Compound *parent, PxPhysics *pxPhysics, PxCooking *pxCooking)
+{
+	mParent = parent;
+
+	if (mVertices.empty())
+		return NULL;
+
+	if (mPxConvexMesh != NULL) 
+		return mPxConvexMesh;
+
+	mPxConvexMesh = NULL;
+	mPxActor = NULL;
+
+	PxConvexMeshDesc meshDesc;
+	shdfnd::Array<PxHullPolygon> polygons;
+	getPxConvexMeshDesc(meshDesc, polygons);
 
 	// Cooking from memory
 	PxDefaultMemoryOutputStream outBuffer;
@@ -739,6 +732,46 @@ PxConvexMesh* Convex::createPxConvexMesh(Compound *parent, PxPhysics *pxPhysics,
 	return mPxConvexMesh;
 }
 
+// --------------------------------------------------------------------------------------------
+class CookingStream : public PxDefaultMemoryOutputStream, public ::physx::shdfnd::UserAllocated {};
+
+void Convex::createPxConvexMeshes(Convex** convexes, int numConvexes, Compound *parent, PxPhysics *pxPhysics, PxCooking *pxCooking)
+{
+	shdfnd::Array<Convex*> toCook;
+	for (int i = 0; i < numConvexes; i++) {
+		Convex *c = convexes[i];
+		c->mParent = parent;
+		if (c->mVertices.empty() || c->mPxConvexMesh != NULL)
+			continue;
+		c->mPxActor = NULL;
+		toCook.pushBack(c);
+	}
+	if (toCook.empty())
+		return;
+
+	const int num = (int)toCook.size();
+	shdfnd::Array<PxConvexMeshDesc> descs(num);
+	shdfnd::Array<shdfnd::Array<PxHullPolygon> > polygons(num);	// referenced by the descriptors, not resized below
+	shdfnd::Array<PxOutputStream*> streams(num);
+	shdfnd::Array<PxConvexMeshCookingResult::Enum> results(num);
+	for (int i = 0; i < num; i++) {
+		toCook[i]->getPxConvexMeshDesc(descs[i], polygons[i]);
+		streams[i] = PX_NEW(CookingStream)();
+	}
+
+	// one call, the cooking library spreads the hull computations over its CPU dispatcher if it has one
+	pxCooking->cookConvexMeshes((PxU32)num, descs.begin(), streams.begin(), results.begin());
+
+	for (int i = 0; i < num; i++) {
+		CookingStream *stream = static_cast<CookingStream*>(streams[i]);
+		if (results[i] == PxConvexMeshCookingResult::eSUCCESS && stream->getSize() > 0) {
+			PxDefaultMemoryInputData inBuffer(stream->getData(), stream->getSize());
+			toCook[i]->mPxConvexMesh = pxPhysics->createConvexMesh(inBuffer);
+		}
+		PX_DELETE(stream);
+	}
+}
+
 // --------------------------------------------------------------------------------------------
 void Convex::setMaterialOffset(const PxVec3 &offset)
 {
@@ -83,6 +83,8 @@ public:
 	virtual void draw(bool /*debug*/ = false) {}
 
 	PxConvexMesh* createPxConvexMesh(Compound *parent, PxPhysics *pxPhysics, PxCooking *pxCooking);
+	// same as createPxConvexMesh() for several convexes, cooked with a single batched cooking call
+	static void createPxConvexMeshes(Convex** convexes, int numConvexes, Compound *parent, PxPhysics *pxPhysics, PxCooking *pxCooking);
 	void setPxActor(PxRigidActor *actor);
 	void setLocalPose(const PxTransform &pose);
 
@@ -176,6 +178,7 @@ protected:
 	void finalize();
 	void updateBounds();
 	void updatePlanes();
+	void getPxConvexMeshDesc(PxConvexMeshDesc &meshDesc, shdfnd::Array<PxHullPolygon> &polygons);
 
 	bool computeVisMeshNeighbors();
 	void computeVisTangentsFromPoly();
@@ -46,6 +46,9 @@
 #include "PhysXMacros.h"
 #include "PxScene.h"
 #include "PxD6Joint.h"
+#include "PsTime.h"
+
+#include <stdio.h>
 
 #define USE_CONVEX_RENDERER 1
 #define NUM_NO_SOUND_FRAMES 1
@@ -145,6 +148,9 @@ SimScene::SimScene(PxPhysics *pxPhysics, PxCooking *pxCooking, bool isGrbScene,
 	mPolygonTriangulator = NULL;
 
 	mAppNotify = NULL;
+
+	mActorInsertionDepth = 0;
+	mCreationTimes.init();
 }
 
 // --------------------------------------------------------------------------------------------
@@ -217,6 +223,52 @@ void SimScene::deleteCompounds()
 	delCompoundList.clear();
 }
 
+// --------------------------------------------------------------------------------------------
+void SimScene::beginActorInsertion()
+{
+	if (mActorInsertionDepth++ == 0)
+		mCreationTimes.init();
+}
+
+// --------------------------------------------------------------------------------------------
+void SimScene::endActorInsertion()
+{
+	PX_ASSERT(mActorInsertionDepth > 0);
+	if (--mActorInsertionDepth > 0)
+		return;
+
+	shdfnd::Time timer;
+	if (!mPendingActors.empty())
+		mScene->addActors(&mPendingActors[0], mPendingActors.size());
+	const float insertMs = (float)timer.getElapsedSeconds() * 1000.0f;
+
+	if (mCreationTimes.numCompounds > 0) {
+		printf("created %d compounds, %d convexes: prepare %.2f ms, cook %.2f ms, shapes %.2f ms, insert %.2f ms\n",
+			mCreationTimes.numCompounds, mCreationTimes.numConvexes,
+			mCreationTimes.prepareMs, mCreationTimes.cookMs, mCreationTimes.shapesMs, insertMs);
+	}
+	mPendingActors.clear();
+}
+
+// --------------------------------------------------------------------------------------------
+void SimScene::insertActor(PxRigidActor& actor)
+{
+	if (mActorInsertionDepth > 0)
+		mPendingActors.pushBack(&actor);
+	else
+		mScene->addActor(actor);
+}
+
+// --------------------------------------------------------------------------------------------
+void SimScene::addCreationTimes(int numConvexes, float prepareMs, float cookMs, float shapesMs)
+{
+	mCreationTimes.numCompounds++;
+	mCreationTimes.numConvexes += numConvexes;
+	mCreationTimes.prepareMs += prepareMs;
+	mCreationTimes.cookMs += cookMs;
+	mCreationTimes.shapesMs += shapesMs;
+}
+
 // --------------------------------------------------------------------------------------------
 void SimScene::preSim(float dt)
 {
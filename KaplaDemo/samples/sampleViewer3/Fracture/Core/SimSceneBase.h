@@ -42,6 +42,8 @@ namespace physx
 class PxPhysics;
 class PxCooking;
 class PxScene;
+class PxActor;
+class PxRigidActor;
 class PxRigidDynamic;
 class PxD6Joint;
 namespace fracture
@@ -86,6 +88,14 @@ public:
 	// perform deferred deletion
 	void deleteCompounds();
 
+	// Bulk insertion: the actors of the compounds created between these calls are added to the PxScene
+	// with a single addActors() call, and the time spent creating them is printed. Calls can be nested.
+	void beginActorInsertion();
+	void endActorInsertion();
+	// used by the compounds, adds the actor right away or queues it during a bulk insertion
+	void insertActor(PxRigidActor& actor);
+	void addCreationTimes(int numConvexes, float prepareMs, float cookMs, float shapesMs);
+
 	void setScene(PxScene* scene) { mScene = scene; }
 	// 
 	bool findCompound(const Compound* c, int& actorNr, int& compoundNr);
@@ -263,6 +273,22 @@ protected:
 	// Deferred Deletion list
 	shdfnd::Array<Compound*> delCompoundList;
 
+	// Bulk actor insertion
+	int mActorInsertionDepth;
+	shdfnd::Array<PxActor*> mPendingActors;
+	struct CreationTimes {
+		void init() {
+			numCompounds = 0; numConvexes = 0;
+			prepareMs = cookMs = shapesMs = 0.0f;
+		}
+		int numCompounds;
+		int numConvexes;
+		float prepareMs;
+		float cookMs;
+		float shapesMs;
+	};
+	CreationTimes mCreationTimes;
+
 	// Map used to determine SimScene ownership of shape
 	shdfnd::HashMap<const PxShape*,Convex*> mShapeMap;
 };
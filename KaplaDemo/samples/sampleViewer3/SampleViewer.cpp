@@ -765,8 +765,13 @@ bool InitPhysX()
 		printf("\nPhysXSDK create error.\nUnable to initialize the PhysX SDK, exiting the sample.\n\n");
 		return false;
 	}
+	// the scenes share the dispatcher with the cooking library, which uses it for batches of convex meshes
+	if (!gPxDispatcher)
+		gPxDispatcher = PxDefaultCpuDispatcherCreate(gNrWorkerThreads);
+
 	PxCookingParams params(gPxPhysics->getTolerancesScale());
 	params.buildGPUData = true;
+	params.cpuDispatcher = gPxDispatcher;
 	gPxCooking = PxCreateCooking(PX_PHYSICS_VERSION, *gPxFoundation, params);
 
 	if (gPxCooking == NULL) 
@@ -401,6 +401,9 @@ void SceneKapla::createCylindricalTower(PxU32 nbRadialPoints, PxReal maxRadius,
 
 	mSimScene->getCompoundCreator()->createBox(2.f*dims);//0.5f, 0.2f, 20, 20);
 
+	// all the bricks are added to the scene at once when the tower is complete
+	mSimScene->beginActorInsertion();
+
 	PxReal startHeight = 0.f;
 
 	PxTransform objectTransform(PxVec3(3.172 - 2.3 - 39.87), PxQuat());
@@ -434,7 +437,7 @@ void SceneKapla::createCylindricalTower(PxU32 nbRadialPoints, PxReal maxRadius,
 			innerBox->setMassSpaceInertiaTensor(innerBox->getMassSpaceInertiaTensor() * 4.f);
 
 			if (bStartAsleep)
-				innerBox->putToSleep();
+				innerBox->setWakeCounter(0.0f);	// inserted asleep by endActorInsertion()
 
 		}
 
@@ -469,7 +472,7 @@ void SceneKapla::createCylindricalTower(PxU32 nbRadialPoints, PxReal maxRadius,
 			innerBox->setMassSpaceInertiaTensor(innerBox->getMassSpaceInertiaTensor() * 4.f);
 
 			if (bStartAsleep)
-				innerBox->putToSleep();
+				innerBox->setWakeCounter(0.0f);	// inserted asleep by endActorInsertion()
 		}
 
 		for (PxU32 a = 0; a < nbMidSlabs; a++)
@@ -493,7 +496,7 @@ void SceneKapla::createCylindricalTower(PxU32 nbRadialPoints, PxReal maxRadius,
 			innerBox->setMassSpaceInertiaTensor(innerBox->getMassSpaceInertiaTensor() * 4.f);
 
 			if (bStartAsleep)
-				innerBox->putToSleep();
+				innerBox->setWakeCounter(0.0f);	// inserted asleep by endActorInsertion()
 		}
 
 		for (PxU32 a = 0; a < nbOuterSlabs; a++)
@@ -517,7 +520,7 @@ void SceneKapla::createCylindricalTower(PxU32 nbRadialPoints, PxReal maxRadius,
 			outerBox->setMassSpaceInertiaTensor(outerBox->getMassSpaceInertiaTensor() * 4.f);
 
 			if (bStartAsleep)
-				outerBox->putToSleep();
+				outerBox->setWakeCounter(0.0f);	// inserted asleep by endActorInsertion()
 		}
 
 		startHeight += 4.f * dims.y;
@@ -553,9 +556,10 @@ void SceneKapla::createCylindricalTower(PxU32 nbRadialPoints, PxReal maxRadius,
 		innerBox->setMassSpaceInertiaTensor(innerBox->getMassSpaceInertiaTensor() * 4.f);
 
 		if (bStartAsleep)
-			innerBox->putToSleep();
+			innerBox->setWakeCounter(0.0f);	// inserted asleep by endActorInsertion()
 	}
 
+	mSimScene->endActorInsertion();
 }
 
 
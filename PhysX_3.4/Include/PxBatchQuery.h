@@ -46,6 +46,8 @@ namespace physx
 class PxBoxGeometry;
 class PxSphereGeometry;
 struct PxQueryCache;
+class PxCpuDispatcher;
+class PxBaseTask;
 
 /**
 \brief Batched queries object. This is used to perform several queries at the same time. 
@@ -60,9 +62,42 @@ class PX_DEPRECATED PxBatchQuery
 
 	/**
 	\brief Executes batched queries.
+
+	\note The scene read lock is not required if all queued queries use PxQueryFlag::eSNAPSHOT. Such a batch can be executed
+	while the scene is simulated.
 	*/
 	virtual	void							execute() = 0;
 
+	/**
+	\brief Executes batched queries using the worker threads of a CPU dispatcher.
+
+	The queued queries are split into chunks of consecutive queries, and each chunk is executed by a task
+	submitted to the dispatcher. Each chunk records its touches in its own buffers. When the last chunk is done,
+	the touches are copied to the user touch buffers in query order, so the results and touch buffer layout do
+	not depend on the number of worker threads or on the order in which the chunks ran. The continuation task
+	is then released and this batch can be used again.
+
+	A query may report up to maxTouchHits touches whatever the space left in the touch buffer. If the touch
+	buffer runs out of space, the touches of the query are truncated when they are copied and the query reports
+	PxBatchQueryStatus::eOVERFLOW. This can differ slightly from execute(), which limits the touches of each query
+	to the space left while the query runs.
+
+	When PVD scene query capture is enabled, the queries run on the calling thread as with execute(), and the
+	continuation is released before this function returns.
+
+	\param[in] dispatcher		The dispatcher running the query tasks.
+	\param[in] continuation	Task released when all queries are done and the result buffers are filled. A reference is
+								added to it when the execution starts and removed when it completes, so it will not run before then.
+	\return True if the execution started. False if this batch is already executing, or if the user memory is not valid.
+	In this case, the continuation is left untouched.
+
+	\note The scene must not be modified, and the user memory must not be changed or read, until the continuation runs.
+	Any scene read lock requirement applies to the whole execution, unless all queued queries use PxQueryFlag::eSNAPSHOT.
+
+	@see execute() PxBatchQueryMemory PxCpuDispatcher
+	*/
+	virtual	bool							executeParallel(PxCpuDispatcher& dispatcher, PxBaseTask* continuation) = 0;
+
 	/**
 	\brief Gets the prefilter shader in use for this scene query.
 
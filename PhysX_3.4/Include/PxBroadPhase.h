@@ -56,6 +56,10 @@ namespace physx
 	issues as eSAP when all objects are moving or when inserting large numbers of objects. However
 	its generic performance when many objects are sleeping might be inferior to eSAP, and it requires
 	users to define world bounds in order to work.
+
+	eGPU runs the broad phase on the GPU. It does not require PxSceneFlag::eENABLE_GPU_DYNAMICS: without that flag
+	the narrow phase and the solver stay on the CPU, so only the broad phase is offloaded. This requires a GPU
+	dispatcher in PxSceneDesc and falls back to eSAP otherwise.
 	*/
 	struct PxBroadPhaseType
 	{
@@ -63,7 +67,7 @@ namespace physx
 		{
 			eSAP,		//!< 3-axes sweep-and-prune
 			eMBP,		//!< Multi box pruning
-			eGPU,
+			eGPU,		//!< GPU broad phase, see above
 
 			eLAST
 		};
@@ -97,6 +97,7 @@ struct PxConstraintShaderTable
 	PxConstraintProject				project;					//!< constraint projection function
 	PxConstraintVisualize			visualize;					//!< constraint visualization function
 	PxConstraintFlag::Enum			flag;						//!< gpu constraint
+	PxConstraintSolverPrep4			solverPrep4;				//!< optional batched solver constraint generation function, may be NULL
 };
 
 
@@ -232,6 +232,36 @@ typedef PxU32 (*PxConstraintSolverPrep)(Px1DConstraint* constraints,
 										const PxTransform& bodyAToWorld,
 										const PxTransform& bodyBToWorld);
 
+/** batched solver constraint generation shader
+
+Optional variant of #PxConstraintSolverPrep which generates the rows of four constraints of the same type in one call, so that
+the shader can process them together using SIMD. It is called instead of the per-constraint shader when the solver batches four
+constraints sharing the same #PxConstraintSolverPrep. The same reentrancy rules apply.
+
+The row buffers are initialized by the caller exactly as for #PxConstraintSolverPrep. A row count of zero for any constraint makes
+the solver process the four constraints individually.
+
+\param[out] constraints four arrays of solver constraint rows to be filled in, one per constraint
+\param[out] rowCounts the number of constraint rows written for each constraint
+\param[out] bodyAWorldOffsets the origin point of each constraint, see #PxConstraintSolverPrep
+\param[in] maxConstraints the size of each constraint buffer. At most this many constraints rows may be written per constraint
+\param[out] invMassScales the inverse mass and inertia scales for each constraint
+\param[in] constantBlocks the constant data block of each constraint
+\param[in] bodyAToWorld the center of mass frames of the first constrained bodies
+\param[in] bodyBToWorld the center of mass frames of the second constrained bodies
+
+@see PxConstraintSolverPrep PxConstraintShaderTable
+*/
+
+typedef void (*PxConstraintSolverPrep4)(Px1DConstraint* const* constraints,
+										PxU32* rowCounts,
+										PxVec3* bodyAWorldOffsets,
+										PxU32 maxConstraints,
+										PxConstraintInvMassScale* invMassScales,
+										const void* const* constantBlocks,
+										const PxTransform* bodyAToWorld,
+										const PxTransform* bodyBToWorld);
+
 /** solver constraint projection shader
 
 This function is called by the constraint post-solver framework. The function must be reentrant, since it may be called simultaneously
@@ -435,6 +435,30 @@ public:
 	*/
 	virtual void onContactModify(PxContactModifyPair* const pairs, PxU32 count) = 0;
 
+	/**
+	\brief Passes modifiable arrays of contacts to the application, together with the index of the calling narrow phase context.
+
+	This is the method the SDK calls. The default implementation forwards to onContactModify(pairs, count).
+
+	The narrow phase splits its pairs into batches and every batch with modifiable pairs triggers one call from the worker
+	that processes it, so calls for different batches run in parallel. A pair is passed to exactly one call per simulation
+	step. threadIndex identifies the narrow phase context of the call: no two calls that run at the same time share an index,
+	and the index stays below the number of threads that run simulation tasks. Override this method to keep per-thread
+	modification state in an array indexed by threadIndex instead of guarding shared state with a lock. In that case
+	onContactModify(pairs, count) can be left empty.
+
+	\param[in] pairs The modifiable contact pairs of the batch
+	\param[in] count Number of pairs in the batch
+	\param[in] threadIndex Index of the narrow phase context running the batch
+
+	@see PxContactModifyPair
+	*/
+	virtual void onContactModifyBatch(PxContactModifyPair* const pairs, PxU32 count, PxU32 threadIndex)
+	{
+		PX_UNUSED(threadIndex);
+		onContactModify(pairs, count);
+	}
+
 protected:
 	virtual ~PxContactModifyCallback(){}
 };
@@ -615,6 +615,43 @@ typedef PxFilterFlags (*PxSimulationFilterShader)
 	 PxPairFlags& pairFlags, const void* constantBlock, PxU32 constantBlockSize);
 
 
+/**
+\brief Batched variant of #PxSimulationFilterShader.
+
+Evaluates the filter logic for pairCount new collision pairs at once. Entry i of each input array describes pair i, and
+the result for pair i has to be written to filterFlags[i] and pairFlags[i]. The inputs are laid out as separate arrays
+per pair object, so a shader that only combines filter words (a group mask test, for instance) can process several
+pairs per SIMD instruction.
+
+If #PxSceneDesc.filterShaderBatch is set, the simulation uses it for rigid body shape pairs whose bounding volumes start
+to overlap and that passed the hardwired filter criteria listed for #PxSimulationFilterShader. All other filtering
+requests (refiltering, triggers against particles, scene queries etc.) keep using #PxSceneDesc.filterShader, so both
+shaders have to implement the same logic. PxFilterFlag::eCALLBACK is supported and leads to
+PxSimulationFilterCallback::pairFound() being called for the affected pairs as usual.
+
+\note The same restrictions as for #PxSimulationFilterShader apply. The shader may get called from several threads
+in parallel with disjoint batches.
+
+\param[in] pairCount Number of pairs in the batch
+\param[in] attributes0 The filter attributes of the first object of each pair
+\param[in] filterData0 The custom filter data of the first object of each pair
+\param[in] attributes1 The filter attributes of the second object of each pair
+\param[in] filterData1 The custom filter data of the second object of each pair
+\param[out] filterFlags Filter flags for each pair, see the return value of #PxSimulationFilterShader
+\param[out] pairFlags Pair flags for each accepted pair
+\param[in] constantBlock The constant global filter data (see #PxSceneDesc.filterShaderData)
+\param[in] constantBlockSize Size of the global filter data (see #PxSceneDesc.filterShaderDataSize)
+
+@see PxSimulationFilterShader PxSceneDesc.filterShaderBatch
+*/
+
+typedef void (*PxSimulationFilterShaderBatch)
+	(PxU32 pairCount,
+	 const PxFilterObjectAttributes* attributes0, const PxFilterData* filterData0,
+	 const PxFilterObjectAttributes* attributes1, const PxFilterData* filterData1,
+	 PxFilterFlags* filterFlags, PxPairFlags* pairFlags, const void* constantBlock, PxU32 constantBlockSize);
+
+
 
 /**
 \brief Filter callback to specify handling of collision pairs.
@@ -214,6 +214,98 @@ namespace immediate
 	PX_C_EXPORT PX_PHYSX_CORE_API bool PxGenerateContacts(const PxGeometry* const * geom0, const PxGeometry* const * geom1, const PxTransform* pose0, const PxTransform* pose1, PxCache* contactCache, const PxU32 nbPairs, PxContactRecorder& contactRecorder,
 		const PxReal contactDistance, const PxReal meshContactMargin, const PxReal toleranceLength, PxCacheAllocator& allocator);
 
+	/**
+	\brief Pool owning the persistent contact cache memory of a set of immediate mode pairs.
+
+	Each pair is identified by an index in [0, getNbPairs()). The pool stores the PxCache of every pair and allocates its manifold data from fixed-size
+	blocks. Blocks are double-buffered: the data written in a frame stays valid for the following frame and is recycled by the next call to beginFrame.
+	Pairs that were not refreshed during the previous frame have their cache reset at that point, so the pool never references recycled memory and
+	its footprint only covers the pairs that are still active.
+
+	Contact generation can be split across threads by giving each thread its own stream index. Threads sharing a pool must process disjoint pairs.
+
+	@see PxCreateContactCachePool
+	*/
+	class PxContactCachePool
+	{
+	public:
+		/**
+		\brief Sets the number of pairs addressable by the pool. Caches of pairs below the new count are preserved; caches above it are discarded.
+
+		Must not be called while contacts are being generated.
+		*/
+		virtual void setNbPairs(const PxU32 nbPairs) = 0;
+
+		/**
+		\brief Returns the number of pairs addressable by the pool.
+		*/
+		virtual PxU32 getNbPairs() const = 0;
+
+		/**
+		\brief Starts a new frame. The blocks written two frames ago are returned to the pool and the caches of pairs that were not refreshed during the
+		previous frame are reset.
+
+		Must not be called while contacts are being generated.
+		*/
+		virtual void beginFrame() = 0;
+
+		/**
+		\brief Performs contact generation for a set of pairs using the caches stored in the pool.
+
+		\param[in] pairIds Array of pool pair indices, one per pair
+		\param[in] geom0 Array of geometries to perform collision detection on.
+		\param[in] geom1 Array of geometries to perform collision detection on
+		\param[in] pose0 Array of poses associated with the corresponding entry in the geom0 array
+		\param[in] pose1 Array of poses associated with the corresponding entry in the geom1 array
+		\param[in] nbPairs The total number of pairs to process
+		\param[in] contactRecorder A callback that is called to record contacts for each pair that detects contacts. The index passed to the recorder is the index in the pairIds array.
+		\param[in] contactDistance The distance at which contacts begin to be generated between the pairs
+		\param[in] meshContactMargin The mesh contact margin.
+		\param[in] toleranceLength The toleranceLength. Used for scaling distance-based thresholds internally to produce appropriate results given simulations in different units
+		\param[in] streamIndex The stream to allocate cache data from. Must be less than the number of streams the pool was created with.
+
+		\return a boolean indicating if the function was successful or not.
+
+		@see PxGenerateContacts
+		*/
+		virtual bool generateContacts(const PxU32* pairIds, const PxGeometry* const * geom0, const PxGeometry* const * geom1, const PxTransform* pose0, const PxTransform* pose1, const PxU32 nbPairs,
+			PxContactRecorder& contactRecorder, const PxReal contactDistance, const PxReal meshContactMargin, const PxReal toleranceLength, const PxU32 streamIndex = 0) = 0;
+
+		/**
+		\brief Discards the cache of a pair, e.g. when the pair stops overlapping or its index is reassigned to a different pair.
+		*/
+		virtual void resetPair(const PxU32 pairId) = 0;
+
+		/**
+		\brief Returns the number of blocks allocated by the pool, whether in use or waiting to be reused.
+		*/
+		virtual PxU32 getNbBlocks() const = 0;
+
+		/**
+		\brief Returns the number of blocks currently holding cache data.
+		*/
+		virtual PxU32 getNbUsedBlocks() const = 0;
+
+		/**
+		\brief Releases the pool and all the memory it owns.
+		*/
+		virtual void release() = 0;
+
+	protected:
+		virtual ~PxContactCachePool() {}
+	};
+
+	/**
+	\brief Creates a contact cache pool.
+
+	\param[in] nbStreams The number of threads that may generate contacts concurrently through the pool.
+
+	\return the new pool.
+
+	@see PxContactCachePool
+	*/
+	PX_C_EXPORT PX_PHYSX_CORE_API PxContactCachePool* PxCreateContactCachePool(const PxU32 nbStreams = 1);
+
 #if !PX_DOXYGEN
 }
 #endif
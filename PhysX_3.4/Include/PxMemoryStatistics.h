@@ -0,0 +1,108 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#ifndef PX_MEMORY_STATISTICS
+#define PX_MEMORY_STATISTICS
+/** \addtogroup physics
+@{
+*/
+
+#include "PxPhysXConfig.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+/**
+\brief Subsystems that SDK memory is accounted against.
+
+@see PxMemoryStatistics
+*/
+struct PxMemoryCategory
+{
+	enum Enum
+	{
+		eOTHER = 0,			//!< Shared containers used outside any tagged scope, and untagged sources
+		eFOUNDATION,		//!< Foundation internals, including the temp allocator pool
+		eSDK,				//!< API objects: scenes, actors, shapes, materials
+		eSIMULATION,		//!< Simulation controller: interactions, element and body sims
+		eLOW_LEVEL,			//!< Low level contexts, contact managers and islands
+		eBROADPHASE,		//!< Broad phase and AABB manager
+		eDYNAMICS,			//!< Solver and integration
+		eGEOMETRY,			//!< Meshes, height fields and convexes
+		eSCENE_QUERY,		//!< Scene query pruners
+		eCOOKING,			//!< Runtime cooking
+		eCHARACTER,			//!< Character controllers
+		eVEHICLE,			//!< Vehicles
+		eEXTENSIONS,		//!< Extensions and serialization
+		eCOUNT
+	};
+};
+
+/**
+\brief Bytes allocated through the foundation allocator, per subsystem.
+
+Counters are maintained for every allocation regardless of PVD, and cover the whole process since the foundation
+is shared by all PxPhysics and PxScene instances. Allocations are charged to the subsystem whose code is running
+on the allocating thread, falling back to the module of the allocating source file. Sizes are rounded up to
+16 bytes per allocation and do not include the overhead of the user allocator.
+
+@see PxPhysics::getMemoryStatistics()
+*/
+struct PxMemoryStatistics
+{
+	/**
+	\brief Bytes currently allocated, per PxMemoryCategory.
+	*/
+	PxU64	liveBytes[PxMemoryCategory::eCOUNT];
+
+	/**
+	\brief Highest value of liveBytes since the foundation was created or PxPhysics::resetMemoryPeakStatistics() was called.
+	*/
+	PxU64	peakBytes[PxMemoryCategory::eCOUNT];
+
+	/**
+	\brief Bytes currently allocated, over all categories.
+	*/
+	PxU64	totalLiveBytes;
+
+	/**
+	\brief Highest value of totalLiveBytes. The sum of the peakBytes entries can exceed it, since categories peak at different times.
+	*/
+	PxU64	totalPeakBytes;
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
@@ -0,0 +1,139 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#ifndef PX_NARROW_PHASE_BACKEND_H
+#define PX_NARROW_PHASE_BACKEND_H
+/** \addtogroup physics
+@{
+*/
+
+#include "PxPhysXConfig.h"
+#include "foundation/PxTransform.h"
+#include "geometry/PxGeometry.h"
+#include "GeomUtils/GuContactPoint.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxBaseTask;
+
+/**
+\brief A batch of shape pairs submitted to a PxNarrowPhaseBackend.
+
+The inputs are stored as arrays of nbPairs entries each. The pairs are ordered so that
+geometries0[i]->getType() <= geometries1[i]->getType().
+
+The backend fills the outputs. contacts[i] points to nbContacts[i] contacts for pair i, using the same conventions as
+the built-in contact generation: the positions are in world space, the normal points from the second shape to the
+first one, and internalFaceIndex1 is the triangle index for meshes and heightfields, or PXC_CONTACT_NO_FACE_INDEX.
+At most 64 contacts per pair are used. Only the normal, point, separation and internalFaceIndex1 members are read.
+
+@see PxNarrowPhaseBackend
+*/
+struct PxNarrowPhaseBackendBatch
+{
+	PxU32						nbPairs;			//!< Number of pairs in the batch
+
+	const PxU32*				pairIds;			//!< Identifies a pair from one step to the next, until PxNarrowPhaseBackend::releasePair() is called for it
+	const PxGeometry* const*	geometries0;		//!< Geometry of the first shape
+	const PxGeometry* const*	geometries1;		//!< Geometry of the second shape
+	const PxTransform*			poses0;				//!< World pose of the first shape
+	const PxTransform*			poses1;				//!< World pose of the second shape
+	const PxReal*				contactDistances;	//!< Sum of the contact offsets of the two shapes
+
+	const Gu::ContactPoint**	contacts;			//!< Output: contacts of each pair
+	PxU32*						nbContacts;			//!< Output: number of contacts of each pair
+};
+
+/**
+\brief An interface to generate the contacts of the discrete narrow phase outside the SDK, for example on an accelerator.
+
+The narrow phase gathers the pairs that need new contacts in batches, and submits each batch to the backend from a
+worker thread. The backend may process the batch asynchronously. Once the outputs of the batch are written, it calls
+removeReference() on the completion task exactly once, from any thread. The SDK then builds the contact streams and
+touch events of the batch. The simulation step does not complete before all batches have been completed.
+
+Pairs of unsupported geometry types, and pairs that do not need new contacts because their bodies are asleep, do not
+reach the backend. The contact modification callback and contact reports work as with the built-in narrow phase.
+
+The backend is only used by the CPU narrow phase, so it cannot be combined with PxSceneFlag::eENABLE_GPU_DYNAMICS.
+
+\note All methods may be called from several worker threads at the same time.
+
+@see PxSceneDesc.narrowPhaseBackend PxNarrowPhaseBackendBatch
+*/
+class PxNarrowPhaseBackend
+{
+public:
+
+	/**
+	\brief Tells whether the backend generates contacts for a pair of geometry types, with type0 <= type1.
+
+	Other pairs are processed by the built-in narrow phase.
+	*/
+	virtual bool	supportsPair(PxGeometryType::Enum type0, PxGeometryType::Enum type1) const = 0;
+
+	/**
+	\brief Called at the start of the narrow phase of each simulation step.
+
+	The contacts returned for the previous step are no longer read after this call, so their memory can be reused.
+	*/
+	virtual void	beginStep() = 0;
+
+	/**
+	\brief Submits a batch of pairs.
+
+	The batch and its arrays stay valid until the completion task runs. The contacts written to the outputs must stay
+	valid until the next call to beginStep().
+
+	\param[in] batch The pairs, and the arrays receiving the contacts.
+	\param[in] completionTask The task to call removeReference() on once the outputs are written.
+	*/
+	virtual void	submit(PxNarrowPhaseBackendBatch& batch, PxBaseTask& completionTask) = 0;
+
+	/**
+	\brief Called when a pair is lost or reset, so the backend can release the data it keeps for it.
+
+	The pair id may be reused for a new pair afterwards. This is never called for a pair of a batch in flight.
+	*/
+	virtual void	releasePair(PxU32 pairId) = 0;
+
+protected:
+	virtual ~PxNarrowPhaseBackend() {}
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
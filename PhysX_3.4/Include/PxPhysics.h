@@ -40,6 +40,7 @@
 #include "PxDeletionListener.h"
 #include "foundation/PxTransform.h"
 #include "PxShape.h"
+#include "PxMemoryStatistics.h"
 
 
 #if PX_USE_CLOTH_API
@@ -65,6 +66,7 @@ class PxFoundation;
 class PxSerializationRegistry;
 
 class PxPruningStructure;
+class PxCpuDispatcher;
 
 /**
 \brief Abstract singleton factory class used for instancing objects in the Physics SDK.
@@ -149,6 +151,25 @@ public:
 	@see PxTriangleMesh PxMeshPreprocessingFlag PxTriangleMesh.release() PxInputStream PxTriangleMeshFlag
 	*/
 	virtual PxTriangleMesh*    createTriangleMesh(PxInputStream& stream) = 0;
+
+	/**
+	\brief Creates a triangle mesh object that references cooked data in place.
+
+	Works like createTriangleMesh(PxInputStream&), but the mesh arrays point directly into the cooked data instead of
+	being copied, which avoids the allocations and copies when the data is already in memory (e.g. a memory-mapped file).
+	Arrays which are not properly aligned, which need endian conversion or which are stored compressed (8-bit indices,
+	8 or 16-bit face remap) are still copied, as well as the GPU data.
+
+	The cooked data is not owned by the mesh: it must stay valid and unmodified until the mesh has been released.
+	PxTriangleMesh::getVerticesForModification() and PxTriangleMesh::refitBVH() are not supported for meshes created this way.
+
+	\param[in] cookedData The cooked triangle mesh data, as written by PxCooking::cookTriangleMesh(). 16-byte alignment is recommended.
+	\param[in] size The size of the cooked data in bytes.
+	\return The new triangle mesh.
+
+	@see createTriangleMesh() PxTriangleMesh PxTriangleMesh.release()
+	*/
+	virtual PxTriangleMesh*    createTriangleMeshInPlace(const void* cookedData, PxU32 size) = 0;
 	
 
 
@@ -441,10 +462,12 @@ public:
 
 	\param[in] actors Array of actors to add to the pruning structure. Must be non NULL.
 	\param[in] nbActors Number of actors in the array. Must be >0.
+	\param[in] dispatcher Optional CPU dispatcher used to build the trees of large structures in parallel. The result does not depend on it.
+	The calling thread also takes part in the build and waits for the submitted tasks, so it must not be one of the dispatcher's worker threads.
 	\return Pruning structure created from given actors, or NULL if any of the actors did not comply with the above requirements.
 	@see PxActor PxPruningStructure
 	*/
-	virtual PxPruningStructure*	createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors)	= 0;
+	virtual PxPruningStructure*	createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors, PxCpuDispatcher* dispatcher = NULL)	= 0;
 	
 	//@}
 	/** @name Shapes
@@ -681,6 +704,30 @@ public:
 	*/
 	virtual PxPhysicsInsertionCallback& getPhysicsInsertionCallback() = 0;
 
+	//@}
+	/** @name Memory
+	*/
+	//@{
+
+	/**
+	\brief Reads the live and peak byte counts of SDK allocations per subsystem.
+
+	The counters are always maintained and do not require PVD or a tracking allocator callback. They are process
+	wide, as all PxPhysics and PxScene instances allocate through the same foundation.
+
+	\param[out] stats Receives the byte counts.
+
+	@see PxMemoryStatistics resetMemoryPeakStatistics()
+	*/
+	virtual void getMemoryStatistics(PxMemoryStatistics& stats) const = 0;
+
+	/**
+	\brief Lowers the peak counts of PxMemoryStatistics to the current live counts, to start a new measurement window.
+
+	@see getMemoryStatistics()
+	*/
+	virtual void resetMemoryPeakStatistics() = 0;
+
 	//@}
 };
 
@@ -132,6 +132,8 @@ Alternatively, one can instead directly #include a subset of the below files.
 #include "PxForceMode.h"
 #include "PxLockedData.h"
 #include "PxMaterial.h"
+#include "PxMemoryStatistics.h"
+#include "PxNarrowPhaseBackend.h"
 #include "PxPhysics.h"
 #include "PxPhysicsVersion.h"
 #include "PxPhysXConfig.h"
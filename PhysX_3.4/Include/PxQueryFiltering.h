@@ -72,6 +72,19 @@ struct PxQueryFlag
 		eNO_BLOCK			= (1<<5),	//!< All hits are reported as touching. Overrides eBLOCK returned from user filters with eTOUCH.
 										//!< This is also an optimization hint that may improve query performance.
 
+		eSNAPSHOT			= (1<<6),	//!< Run the query against the scene query snapshot published by the last fetchResults(), see
+										//!< #PxSceneFlag::eENABLE_SCENE_QUERY_SNAPSHOTS. The query does not need the scene read lock and can run
+										//!< while the scene is simulated or modified. The query cache is ignored. Reports no hit if no snapshot was published yet.
+
+		eCACHE_RESULTS		= (1<<7),	//!< Reuse the hits of the previous identical PxScene query (same geometry, pose, distance, hit flags, filter data and
+										//!< filter callback address) if the scene query structures it traverses did not change since. Filter callbacks are not
+										//!< run for reused hits, so their results must only depend on the shapes. Queries whose touch buffer overflowed are
+										//!< not cached. Ignored by batched queries and with eSNAPSHOT or a PxQueryCache. See #PxScene::getQueryResultCacheStats().
+
+		eBATCH_PREFILTER	= (1<<8),	//!< Together with ePREFILTER, overlap queries collect the candidates that passed the filter data test and run
+										//!< #PxQueryFilterCallback::preFilterBatch() once per group of candidates, instead of preFilter() once per candidate.
+										//!< Ignored by raycasts, sweeps and batched queries.
+
 		eRESERVED			= (1<<15)	//!< Reserved for internal use
 	};
 };
@@ -183,6 +196,28 @@ public:
 	virtual PxQueryHitType::Enum preFilter(
 		const PxFilterData& filterData, const PxShape* shape, const PxRigidActor* actor, PxHitFlags& queryFlags) = 0;
 
+	/**
+	\brief Batched pre-filter, executed instead of #preFilter() by overlap queries if both PxQueryFlag::ePREFILTER and PxQueryFlag::eBATCH_PREFILTER are set.
+
+	The candidates are passed in groups of at most 32, in traversal order. The exact intersection tests of a group run after this call returns.
+	Overriding this function saves a virtual call per candidate for overlaps returning many shapes. The default implementation calls #preFilter()
+	for each candidate.
+
+	\param[in] filterData custom filter data specified as the query's filterData.data parameter.
+	\param[in] shapes Shapes that have not yet passed the exact intersection test.
+	\param[in] actors The shapes' actors.
+	\param[in] count Number of candidates.
+	\param[in,out] hitTypes The hit type of each candidate (see #PxQueryHitType). Set it to PxQueryHitType::eNONE to skip the candidate.
+	\param[in,out] queryFlags The scene query flags of each candidate, as in #preFilter() (only flags from PxHitFlag::eMODIFIABLE_FLAGS bitmask can be modified)
+	*/
+	virtual void preFilterBatch(
+		const PxFilterData& filterData, const PxShape*const* shapes, const PxRigidActor*const* actors, PxU32 count,
+		PxQueryHitType::Enum* hitTypes, PxHitFlags* queryFlags)
+	{
+		for(PxU32 i=0; i<count; i++)
+			hitTypes[i] = preFilter(filterData, shapes[i], actors[i], queryFlags[i]);
+	}
+
 	/**
 	\brief This filter callback is executed if the exact intersection test returned true and PxQueryFlag::ePOSTFILTER flag was set.
 
@@ -125,6 +125,12 @@ struct PxRigidBodyFlag
 
 		/**
 		\brief Register a rigid body to dynamicly adjust contact offset based on velocity. This can be used to achieve a CCD effect.
+
+		The contact offset of the body's shapes is inflated by the distance the body can travel in one step, so that the regular
+		narrow phase generates speculative contacts that the solver resolves. This avoids the additional sweep passes of #eENABLE_CCD
+		and cannot be combined with it. Sleeping and frozen bodies keep their last contact offset and add no per-step cost.
+
+		@see eENABLE_CCD
 		*/
 		eENABLE_SPECULATIVE_CCD 			= (1 << 5),
 
@@ -40,6 +40,7 @@
 #include "PxQueryReport.h"
 #include "PxQueryFiltering.h"
 #include "PxClient.h"
+#include "foundation/PxStrideIterator.h"
 #include "task/PxTask.h"
 
 #if PX_USE_PARTICLE_SYSTEM_API
@@ -59,6 +60,7 @@ class PxRigidDynamic;
 class PxConstraint;
 class PxMaterial;
 class PxSimulationEventCallback;
+class PxContactSummaryCallback;
 class PxPhysics;
 class PxBatchQueryDesc;
 class PxBatchQuery;
@@ -90,6 +92,49 @@ struct PX_DEPRECATED PxActiveTransform
 	PxTransform		actor2World;		//!< Actor-to-world transform of the actor
 };
 
+/**
+\brief State of a rigid dynamic actor at the end of a simulation step.
+
+@see PxSceneFrameState
+*/
+struct PxRigidDynamicFrameState
+{
+	PxRigidDynamic*	actor;				//!< The actor, only valid as long as the user has not released it
+	PxTransform		pose;				//!< Actor-to-world transform of the actor
+	PxVec3			linearVelocity;		//!< Linear velocity of the actor
+	PxVec3			angularVelocity;	//!< Angular velocity of the actor
+};
+
+/**
+\brief Summary of the contact reports of an actor pair for a simulation step.
+
+@see PxSceneFrameState PxContactPairHeader
+*/
+struct PxFrameContactSummary
+{
+	PxRigidActor*	actors[2];			//!< The actors of the pair, NULL if the actor was removed during the step
+	PxU32			nbShapePairs;		//!< Number of reported shape pairs, see PxContactPairHeader::nbPairs
+	PxPairFlags		events;				//!< Union of the events of the reported shape pairs, see PxContactPair::events
+};
+
+/**
+\brief Read-only copy of the scene state at the end of a simulation step.
+
+The data is written by PxScene::fetchResults() if #PxSceneFlag::eENABLE_FRAME_STATE_BUFFER is set, and stays unchanged until
+the second fetchResults() call after the one that produced it. It can therefore be read from any thread without locking while
+the next step simulates and is fetched.
+
+@see PxScene::getFrameState()
+*/
+struct PxSceneFrameState
+{
+	const PxRigidDynamicFrameState*	bodies;			//!< State of all rigid dynamic actors of the scene
+	PxU32							nbBodies;		//!< Number of entries in bodies
+	const PxFrameContactSummary*	contacts;		//!< Contact report summary for each actor pair with a contact report
+	PxU32							nbContacts;		//!< Number of entries in contacts
+	PxU32							frameIndex;		//!< Number of fetchResults() calls that produced a state, 0 if there is none yet
+};
+
 /**
 \brief Expresses the dominance relationship of a contact.
 For the time being only three settings are permitted:
@@ -416,6 +461,24 @@ class PxScene
 	*/
 	virtual	void				removeActors(PxActor*const* actors, PxU32 nbActors, bool wakeOnLostTouch = true) = 0;
 
+	/**
+	\brief Removes the actors of a pruning structure from this scene.
+
+	This is the counterpart of #addActors(const PxPruningStructure&) for streaming out a block of actors. The pruning structure stays
+	valid as long as its actors are not modified, so the same block can be streamed in again with addActors(const PxPruningStructure&)
+	without building a new structure.
+
+	\note If some actor of the pruning structure is not part of this scene, the call is ignored and an error is issued.
+
+	\note This method does not support buffering. It may not be called during simulation.
+
+	\param[in] pruningStructure Pruning structure previously added to this scene.
+	\param[in] wakeOnLostTouch Specifies whether touching objects from the previous frame should get woken up in the next frame.
+
+	@see addActors(const PxPruningStructure&) PxPhysics::createPruningStructure
+	*/
+	virtual	void				removeActors(const PxPruningStructure& pruningStructure, bool wakeOnLostTouch = true) = 0;
+
 	/**
 	\brief Adds an aggregate to this scene.
 	
@@ -460,6 +523,144 @@ class PxScene
 	//@}
 	/************************************************************************************************/
 
+	/** @name Bulk Rigid Dynamic State
+	*/
+	//@{
+
+	/**
+	\brief Reads the global poses of several rigid dynamic actors of this scene.
+
+	Equivalent to calling PxRigidDynamic::getGlobalPose() for each actor, but checks the read access only once.
+
+	\param[in] actors		Actors of this scene.
+	\param[in] nbActors		Number of actors in the array.
+	\param[out] poses		Receives the actor poses, may use any stride.
+
+	@see PxRigidDynamic::getGlobalPose() setRigidDynamicPoses()
+	*/
+	virtual	void				getRigidDynamicPoses(PxRigidDynamic*const* actors, PxU32 nbActors, PxStrideIterator<PxTransform> poses) const = 0;
+
+	/**
+	\brief Sets the global poses of several rigid dynamic actors of this scene.
+
+	Equivalent to calling PxRigidDynamic::setGlobalPose() for each actor, but checks the write access only once. The per-actor
+	parameter checks are only done in checked builds, where the whole call is ignored if one of the actors or poses is invalid.
+
+	\param[in] actors		Actors of this scene.
+	\param[in] nbActors		Number of actors in the array.
+	\param[in] poses		New actor poses, may use any stride.
+	\param[in] autowake		Whether to wake the actors up, see PxRigidDynamic::setGlobalPose().
+
+	@see PxRigidDynamic::setGlobalPose() getRigidDynamicPoses()
+	*/
+	virtual	void				setRigidDynamicPoses(PxRigidDynamic*const* actors, PxU32 nbActors, PxStrideIterator<const PxTransform> poses, bool autowake = true) = 0;
+
+	/**
+	\brief Reads the linear and angular velocities of several rigid dynamic actors of this scene.
+
+	\param[in] actors				Actors of this scene.
+	\param[in] nbActors				Number of actors in the array.
+	\param[out] linearVelocities	Receives the linear velocities, may use any stride. Skipped if NULL.
+	\param[out] angularVelocities	Receives the angular velocities, may use any stride. Skipped if NULL.
+
+	@see PxRigidBody::getLinearVelocity() PxRigidBody::getAngularVelocity() setRigidDynamicVelocities()
+	*/
+	virtual	void				getRigidDynamicVelocities(PxRigidDynamic*const* actors, PxU32 nbActors,
+									PxStrideIterator<PxVec3> linearVelocities, PxStrideIterator<PxVec3> angularVelocities) const = 0;
+
+	/**
+	\brief Sets the linear and angular velocities of several non-kinematic rigid dynamic actors of this scene.
+
+	Equivalent to calling PxRigidDynamic::setLinearVelocity() and PxRigidDynamic::setAngularVelocity() for each actor, but checks
+	the write access only once. The per-actor parameter checks are only done in checked builds, where the whole call is ignored if one of
+	the actors or velocities is invalid.
+
+	\param[in] actors				Actors of this scene.
+	\param[in] nbActors				Number of actors in the array.
+	\param[in] linearVelocities		New linear velocities, may use any stride. Left unchanged if NULL.
+	\param[in] angularVelocities	New angular velocities, may use any stride. Left unchanged if NULL.
+	\param[in] autowake				Whether to wake the actors up, see PxRigidDynamic::setLinearVelocity().
+
+	@see PxRigidDynamic::setLinearVelocity() PxRigidDynamic::setAngularVelocity() getRigidDynamicVelocities()
+	*/
+	virtual	void				setRigidDynamicVelocities(PxRigidDynamic*const* actors, PxU32 nbActors,
+									PxStrideIterator<const PxVec3> linearVelocities, PxStrideIterator<const PxVec3> angularVelocities, bool autowake = true) = 0;
+
+	/**
+	\brief Sets the kinematic targets of several kinematic rigid dynamic actors of this scene.
+
+	Equivalent to calling PxRigidDynamic::setKinematicTarget() for each actor, but checks the write access only once. The per-actor
+	parameter checks are only done in checked builds, where the whole call is ignored if one of the actors or targets is invalid.
+
+	\note Kinematics without a new target for the next simulation step do not move, and their shapes are skipped in the bounds and
+	broad-phase update of that step.
+
+	\param[in] actors		Kinematic actors of this scene.
+	\param[in] nbActors		Number of actors in the array.
+	\param[in] targets		New kinematic target poses, may use any stride.
+
+	@see PxRigidDynamic::setKinematicTarget()
+	*/
+	virtual	void				setRigidDynamicKinematicTargets(PxRigidDynamic*const* actors, PxU32 nbActors, PxStrideIterator<const PxTransform> targets) = 0;
+
+	/**
+	\brief Returns the scene state captured by the last fetchResults() call.
+
+	This call does not take the scene lock and may be made from any thread, also while the scene simulates. The returned arrays
+	stay valid and unchanged until the second fetchResults() call from now, see #PxSceneFrameState. Contacts are only summarized
+	for the pairs that request contact reports in the filter shader.
+
+	\return The last captured state. All counts are 0 if #PxSceneFlag::eENABLE_FRAME_STATE_BUFFER is not set.
+
+	@see PxSceneFrameState PxSceneFlag::eENABLE_FRAME_STATE_BUFFER
+	*/
+	virtual	PxSceneFrameState	getFrameState() const = 0;
+
+	/**
+	\brief Returns the size in bytes of a snapshot of the rigid dynamic actors currently in the scene.
+
+	@see saveSnapshot() restoreSnapshot()
+	*/
+	virtual	PxU32				getSnapshotSize() const = 0;
+
+	/**
+	\brief Copies the simulation state of all the rigid dynamic actors of the scene into a user buffer.
+
+	The snapshot holds, for each actor, the body pose, the velocities, the wake counter and sleep state, the kinematic target,
+	and the sleep and freeze accumulators of the solver, so that a restored body steps exactly like the saved one. It is meant
+	for rollback, where the scene is rewound to a recent frame and simulated again: the snapshot is a flat copy, and is only
+	valid for this scene while the set of rigid dynamic actors and their rigid body flags do not change.
+
+	Contact caches, persistent manifolds and friction anchors are not part of the snapshot. They are rebuilt by the next
+	simulation step from the restored poses, the same way they are after PxRigidDynamic::setGlobalPose().
+
+	\note Not allowed while the simulation is running.
+
+	\param[out] buffer		Destination, 16 byte aligned.
+	\param[in] bufferSize	Size of the buffer in bytes, at least getSnapshotSize().
+	\return Number of bytes written, 0 if the buffer is too small or the call is not allowed.
+
+	@see getSnapshotSize() restoreSnapshot()
+	*/
+	virtual	PxU32				saveSnapshot(void* buffer, PxU32 bufferSize) const = 0;
+
+	/**
+	\brief Restores the state saved by saveSnapshot().
+
+	The actors are not woken up beyond the saved sleep state, and scene queries see the restored poses right away.
+
+	\note Not allowed while the simulation is running.
+
+	\param[in] buffer		Snapshot written by saveSnapshot() for this scene.
+	\param[in] bufferSize	Size of the snapshot in bytes.
+	\return False, and the scene is left unchanged, if the snapshot does not match the actors of the scene.
+
+	@see saveSnapshot()
+	*/
+	virtual	bool				restoreSnapshot(const void* buffer, PxU32 bufferSize) = 0;
+	//@}
+	/************************************************************************************************/
+
 	/** @name Contained Object Retrieval
 	*/
 	//@{
@@ -830,6 +1031,27 @@ class PxScene
 	virtual PxSimulationEventCallback*
 								getSimulationEventCallback(PX_DEPRECATED PxClientID client = PX_DEFAULT_CLIENT) const = 0;
 
+	/**
+	\brief Sets a user object which receives the contact reports of each step as one structure-of-arrays summary.
+
+	\note Do not set the callback while the simulation is running. Calls to this method while the simulation is running will be ignored.
+
+	\param[in] callback User summary callback, NULL to disable the summary. See #PxContactSummaryCallback.
+
+	@see PxContactSummaryCallback PxContactSummaryReport getContactSummaryCallback()
+	*/
+	virtual void				setContactSummaryCallback(PxContactSummaryCallback* callback) = 0;
+
+	/**
+	\brief Retrieves the callback set with setContactSummaryCallback().
+
+	\return The current contact summary callback, NULL if none is set. See #PxContactSummaryCallback.
+
+	@see PxContactSummaryCallback setContactSummaryCallback()
+	*/
+	virtual PxContactSummaryCallback*
+								getContactSummaryCallback() const = 0;
+
 	/**
 	\brief Sets a user callback object, which receives callbacks on all contacts generated for specified actors.
 
@@ -1051,6 +1273,29 @@ class PxScene
 	virtual	void				simulate(PxReal elapsedTime, physx::PxBaseTask* completionTask = NULL,
 									void* scratchMemBlock = 0, PxU32 scratchMemBlockSize = 0, bool controlSimulation = true) = 0;
 
+	/**
+	\brief Advances the simulation by elapsedTime in nbSubsteps steps of equal length and waits for the results.
+
+	This is equivalent to calling simulate() and fetchResults(true) nbSubsteps times with elapsedTime/nbSubsteps, except that the
+	broad phase only runs in the first substep. The contact distances of bodies with PxRigidBodyFlag::eENABLE_SPECULATIVE_CCD
+	are inflated by their velocity over the whole frame for that update, so that the pairs it finds remain valid for the
+	following substeps, in which the narrow phase only refreshes the contacts of the existing pairs (reusing PCM manifolds)
+	before the solver runs. Bodies without speculative CCD only see new pairs within their contact offset until the next frame.
+
+	If actors or shapes are added to or removed from the broad phase during a substep, for example from a callback, the broad phase
+	runs again in the following substep. Simulation event callbacks are sent after each substep.
+
+	\note Must not be called while the scene is being simulated.
+
+	\param[in] elapsedTime Amount of time to advance simulation by. <b>Range:</b> (0, PX_MAX_F32)
+	\param[in] nbSubsteps Number of substeps to split elapsedTime into. <b>Range:</b> [1, PX_MAX_U32)
+	\param[in] scratchMemBlock a memory region for physx to use for temporary data during simulation. Must be aligned on a 16-byte boundary
+	\param[in] scratchMemBlockSize the size of the scratch memory block. Must be a multiple of 16K.
+
+	@see simulate() fetchResults() PxRigidBodyFlag::eENABLE_SPECULATIVE_CCD
+	*/
+	virtual	void				simulateSubsteps(PxReal elapsedTime, PxU32 nbSubsteps, void* scratchMemBlock = 0, PxU32 scratchMemBlockSize = 0) = 0;
+
 
 	/**
  	\brief Performs dynamics phase of the simulation pipeline.
@@ -1154,6 +1399,9 @@ class PxScene
 	This is a utility function to make it easier to process callbacks in parallel using the PhysX task system. It can only be used in conjunction with 
 	fetchResultsStart(...) and fetchResultsFinish(...)
 
+	Besides the contact reports, the trigger and constraint break callbacks are fired from their own tasks. If this function is not called,
+	fetchResultsFinish() fires them before the buffer swap.
+
 	\param[in] continuation The task that will be executed once all callbacks have been processed.
 	*/
 	virtual void				processCallbacks(physx::PxBaseTask* continuation) = 0;
@@ -1414,6 +1662,9 @@ class PxScene
 	\param[in] rebuildStaticStructure	True to rebuild the dynamic tree containing static objects
 	\param[in] rebuildDynamicStructure	True to rebuild the dynamic tree containing dynamic objects
 
+	\note Large trees are built in parallel on the worker threads of the scene's CPU dispatcher, so this function
+	must not be called from one of these threads.
+
 	@see PxSceneDesc.dynamicTreeRebuildRateHint setDynamicTreeRebuildRateHint() getDynamicTreeRebuildRateHint()
 	*/
 	virtual void				forceDynamicTreeRebuild(bool rebuildStaticStructure, bool rebuildDynamicStructure)	= 0;
@@ -1571,6 +1822,23 @@ class PxScene
 	\return scene query static timestamp
 	*/
 	virtual	PxU32	getSceneQueryStaticTimestamp()	const	= 0;
+
+	/**
+	\brief Retrieves the number of queries with PxQueryFlag::eCACHE_RESULTS that reused cached hits and that had to run.
+
+	\param[out] nbHits		Number of queries answered from the result cache
+	\param[out] nbMisses	Number of queries that traversed the scene query structures
+
+	@see PxQueryFlag::eCACHE_RESULTS resetQueryResultCacheStats()
+	*/
+	virtual	void	getQueryResultCacheStats(PxU32& nbHits, PxU32& nbMisses)	const	= 0;
+
+	/**
+	\brief Resets the counters returned by getQueryResultCacheStats().
+
+	@see getQueryResultCacheStats()
+	*/
+	virtual	void	resetQueryResultCacheStats()	= 0;
 	//@}
 	
 	/************************************************************************************************/
@@ -1643,6 +1911,31 @@ class PxScene
 	*/
 	virtual	bool					removeBroadPhaseRegion(PxU32 handle)				= 0;
 
+	/**
+	\brief Enables or disables automatic broad-phase regions.
+
+	This is an alternative to creating regions manually with #addBroadPhaseRegion() and
+	PxBroadPhaseExt::createRegionsFromWorldBounds(). The SDK starts with a single region covering the world bounds,
+	and then subdivides crowded regions and merges sparse ones automatically while objects move, so that the number
+	of objects per region stays close to the provided limit. At most one region is subdivided or merged per
+	simulation step.
+
+	Automatic regions are reported by #getBroadPhaseRegions() with a NULL user-data, and coexist with user-defined
+	regions. Objects leaving the world bounds (and all user-defined regions) are still reported as out-of-bounds.
+
+	Calling this function again replaces the previous automatic regions. Passing 0 for maxNbObjectsPerRegion
+	removes them.
+
+	\note This function is only supported by PxBroadPhaseType::eMBP. It returns false for other broad-phases.
+
+	\param[in]	worldBounds				Bounds covering the simulated world
+	\param[in]	maxNbObjectsPerRegion	Number of objects above which a region gets subdivided, or 0 to disable automatic regions
+	\return True if success
+
+	@see addBroadPhaseRegion PxBroadPhaseExt
+	*/
+	virtual	bool					setBroadPhaseAutoRegions(const PxBounds3& worldBounds, PxU32 maxNbObjectsPerRegion)	= 0;
+
 	//@}
 
 	/************************************************************************************************/
@@ -1816,6 +2109,35 @@ class PxScene
 	*/
 	virtual	void					shiftOrigin(const PxVec3& shift) = 0;
 
+	/**
+	\brief Moves the scene origin to the specified world position.
+
+	The world position of the scene origin is the summed total of all origin shifts. It is tracked in double precision, so objects can
+	be placed and read back relative to a precise large world anchor while PhysX itself keeps working with float coordinates that stay
+	close to the origin. This call computes the required shift in double precision and applies it with #shiftOrigin(). The same notes
+	and cost apply.
+
+	\param[in] x World position of the new origin, x component.
+	\param[in] y World position of the new origin, y component.
+	\param[in] z World position of the new origin, z component.
+
+	@see shiftOrigin() getOrigin()
+	*/
+	virtual	void					setOrigin(PxF64 x, PxF64 y, PxF64 z) = 0;
+
+	/**
+	\brief Returns the world position of the scene origin, i.e. the summed total of all origin shifts, in double precision.
+
+	The world position of a point given in scene coordinates is the returned origin plus the point.
+
+	\param[out] x World position of the origin, x component.
+	\param[out] y World position of the origin, y component.
+	\param[out] z World position of the origin, z component.
+
+	@see shiftOrigin() setOrigin()
+	*/
+	virtual	void					getOrigin(PxF64& x, PxF64& y, PxF64& z) const = 0;
+
 	/**
 	\brief Returns the Pvd client associated with the scene.
 	\return the client, NULL if no PVD supported.
@@ -63,6 +63,12 @@ dynamic AABB tree, without the per-frame overhead. This can be a good choice for
 objects, if no static objects are added, moved or removed after the scene has been
 created. If there is no such guarantee (e.g. when streaming parts of the world in and out),
 then the dynamic version is a better choice even for static objects.
+
+eINCREMENTAL_AABB_TREE keeps a single tree that is updated immediately when objects are added,
+removed or moved, instead of being periodically rebuilt. There is no per-frame rebuild cost
+and no temporary structure for changed objects, but the tree quality can degrade over time.
+This can be a good choice for dynamic objects that move, appear and disappear all the time.
+It is not allowed for #PxSceneDesc::staticStructure.
 */
 struct PxPruningStructureType
 {
@@ -71,6 +77,7 @@ struct PxPruningStructureType
 		eNONE,					//!< Using a simple data structure
 		eDYNAMIC_AABB_TREE,		//!< Using a dynamic AABB tree
 		eSTATIC_AABB_TREE,		//!< Using a static AABB tree
+		eINCREMENTAL_AABB_TREE,	//!< Using an incrementally updated AABB tree
 
 		eLAST
 	};
@@ -355,6 +362,8 @@ struct PxSceneFlag
 
 		When set to true, a CUDA ARCH 3.0 or above-enabled NVIDIA GPU is present and the GPU dispatcher has been configured, this will run the GPU dynamics pipelin instead of the CPU dynamics pipeline.
 
+		To offload only the broad phase and keep the dynamics on the CPU, leave this flag unset and use PxBroadPhaseType::eGPU.
+
 		Note that this flag is not mutable and must be set in PxSceneDesc at scene creation.
 		*/
 		eENABLE_GPU_DYNAMICS = (1 << 19),
@@ -372,6 +381,9 @@ struct PxSceneFlag
 		with the existing actors in the scene. Determinism is only guaranteed if the actors are inserted in a consistent order each run in a newly-created scene and simulated using a consistent time-stepping
 		scheme.
 
+		With this flag, the simulation results, the trigger reports and the contact force threshold reports also do not depend on the number of worker threads
+		of the CPU dispatcher, or on the order in which the simulation tasks complete.
+
 		Note that this flag is not mutable and must be set at scene creation.
 
 		Note that enabling this flag can have a negative impact on performance.
@@ -382,6 +394,187 @@ struct PxSceneFlag
 		*/
 		eENABLE_ENHANCED_DETERMINISM = (1<<20),
 
+		/**
+		\brief Enables the 8-wide AVX constraint solver path.
+
+		When set, the CPU solver pairs up batches of 4 contact or joint constraints that belong to the same partition and solves
+		them 8 at a time using AVX instructions. The flag is ignored if the CPU or operating system does not support AVX, with the
+		GPU solver, and with the #PxFrictionType::eONE_DIRECTIONAL and #PxFrictionType::eTWO_DIRECTIONAL friction models. The
+		simulation results are the same as with the default 4-wide path.
+
+		Note that this flag is not mutable and must be set in PxSceneDesc at scene creation.
+
+		<b>Default</b> false
+		*/
+		eENABLE_AVX_SOLVER = (1<<21),
+
+		/**
+		\brief Enables incremental constraint partitioning.
+
+		By default the constraint partitions of every island are rebuilt from scratch each frame. When this flag is set, each joint
+		and contact pair between two dynamic rigid bodies remembers the partition it was placed in and is put back into it in the
+		next frame if that does not conflict with another constraint. Only new constraints and those that cannot keep their
+		partition are placed again. If every constraint of an island keeps its partition, partition balancing is skipped for that
+		island. This is most effective for scenes with many resting contacts where the constraint graph changes little between frames.
+
+		The flag is ignored if #eENABLE_ENHANCED_DETERMINISM is set, because it makes the partitioning depend on previous frames.
+
+		Note that this flag is not mutable and must be set in PxSceneDesc at scene creation.
+
+		<b>Default</b> false
+		*/
+		eENABLE_INCREMENTAL_PARTITIONING = (1<<22),
+
+		/**
+		\brief Lets each island stop iterating once its solver has converged.
+
+		By default every island runs the largest position and velocity iteration counts requested by any of its bodies. When this
+		flag is set, an island stops iterating early once no body's velocity changes by more than PxSceneDesc::solverResidualTolerance
+		over an iteration. The iterations that apply friction and the final position and velocity iterations are always run. The
+		number of iterations each island used is reported in PxSimulationStatistics.
+
+		The flag only affects islands solved by a single thread without articulations, using the default #PxFrictionType::ePATCH
+		friction model. Other islands always run all their iterations.
+
+		Note that this flag is not mutable and must be set in PxSceneDesc at scene creation.
+
+		<b>Default</b> false
+
+		@see PxSceneDesc::solverResidualTolerance PxSimulationStatistics::nbIslandsPerPositionIterations
+		*/
+		eENABLE_ADAPTIVE_SOLVER_ITERATIONS = (1<<23),
+
+		/**
+		\brief Publishes an immutable snapshot of the scene query structures at the end of each fetchResults().
+
+		Queries using #PxQueryFlag::eSNAPSHOT run against the last published snapshot instead of the live scene query structures.
+		They do not take the scene read lock, so they can be issued from any number of threads while the scene is simulated,
+		including while the next fetchResults() runs. The snapshot reflects the shape bounds at the end of the fetchResults() that
+		published it; the hits are computed with the current shape geometries and poses.
+
+		A snapshot is only rebuilt when the static or dynamic shapes changed since the previous one. A slot still used by a query
+		issued before the previous fetchResults() delays the publication to the next fetchResults().
+
+		Shapes and actors must not be released while snapshot queries that may report them are running. Scene query
+		changes made between fetchResults() calls are only visible to snapshot queries after the next fetchResults().
+
+		Note that this flag is not mutable and must be set in PxSceneDesc at scene creation.
+
+		<b>Default</b> false
+
+		@see PxQueryFlag::eSNAPSHOT
+		*/
+		eENABLE_SCENE_QUERY_SNAPSHOTS = (1<<24),
+
+		/**
+		\brief Rebuilds the static scene query tree in a task submitted to the scene's CPU dispatcher.
+
+		Without this flag the static tree is either rebuilt synchronously when the next query or fetchResults() commits the
+		changes (#PxPruningStructureType::eSTATIC_AABB_TREE), or progressively over #PxSceneDesc::dynamicTreeRebuildRateHint
+		frames (#PxPruningStructureType::eDYNAMIC_AABB_TREE). When it is set, adding, removing or moving static shapes starts a
+		rebuild in a single background task. Shapes added in the meantime are stored in a temporary structure that is queried
+		along with the current tree, and the new tree is swapped in by the first commit after the task completed.
+
+		PxScene::forceDynamicTreeRebuild() also starts a background rebuild of the static tree instead of rebuilding it in place.
+
+		Only used when #PxSceneDesc::staticStructure is eSTATIC_AABB_TREE or eDYNAMIC_AABB_TREE.
+
+		Note that this flag is not mutable and must be set in PxSceneDesc at scene creation.
+
+		<b>Default</b> false
+
+		@see PxSceneDesc::staticStructure PxScene::forceDynamicTreeRebuild()
+		*/
+		eENABLE_BACKGROUND_STATIC_TREE_REBUILD = (1<<25),
+
+		/**
+		\brief Stores the static scene query tree in a compact quantized format.
+
+		The static tree is built as usual and then collapsed into a 4-wide tree whose child bounds are quantized to 16 bits
+		per coordinate, relative to the bounds of the whole tree. This roughly halves the memory used by the tree nodes and
+		improves cache behavior for raycasts, sweeps and overlaps, at the cost of slightly looser bounds.
+
+		Only used when #PxSceneDesc::staticStructure is eSTATIC_AABB_TREE and #eENABLE_BACKGROUND_STATIC_TREE_REBUILD is
+		not set. Pruning structures added to the scene are not merged into a quantized tree, the tree is rebuilt instead.
+
+		Note that this flag is not mutable and must be set in PxSceneDesc at scene creation.
+
+		<b>Default</b> false
+
+		@see PxSceneDesc::staticStructure
+		*/
+		eENABLE_QUANTIZED_STATIC_TREE = (1<<26),
+
+		/**
+		\brief Writes the simulation results back to the actors in parallel in PxScene::fetchResults().
+
+		The poses, velocities and sleep states of the active bodies are copied to the API-visible state of the actors by
+		the worker threads of the CPU dispatcher, while the calling thread takes part and waits for them. Actors changed by
+		the user during the simulation are still synced on the calling thread. The active actor lists (see #eENABLE_ACTIVE_ACTORS)
+		are built the same way. The results, including the order of the active actors, are the same as without the flag.
+
+		Because of the wait, fetchResults() must not be called from a worker thread of the scene's CPU dispatcher when
+		this flag is set.
+
+		Note that this flag is not mutable and must be set in PxSceneDesc at scene creation.
+
+		<b>Default</b> false
+
+		@see PxScene::fetchResults() PxSceneDesc::cpuDispatcher
+		*/
+		eENABLE_PARALLEL_STATE_SYNC = (1<<27),
+
+		/**
+		\brief Keeps a double-buffered copy of the rigid dynamic states and contact report summary of the last step.
+
+		PxScene::fetchResults() writes the copy into the buffer that is not being read and then publishes it, so that
+		PxScene::getFrameState() can be read from any thread while the next step simulates.
+
+		Note that this flag is not mutable and must be set in PxSceneDesc at scene creation.
+
+		<b>Default</b> false
+
+		@see PxScene::getFrameState() PxSceneFrameState
+		*/
+		eENABLE_FRAME_STATE_BUFFER = (1<<28),
+
+		/**
+		\brief Generates the debug visualization of the rigid actors in parallel.
+
+		When debug visualization is enabled, the rigid actors are split into ranges that are visualized by the worker threads
+		of the CPU dispatcher into separate render buffers, while the calling thread takes part and waits for them. The buffers
+		are then appended to the scene render buffer in actor order, so the result is the same as without the flag.
+
+		Because of the wait, PxScene::simulate() and PxScene::collide() must not be called from a worker thread of the scene's
+		CPU dispatcher when this flag is set.
+
+		Note that this flag is not mutable and must be set in PxSceneDesc at scene creation.
+
+		<b>Default</b> false
+
+		@see PxScene::getRenderBuffer() PxSceneDesc::cpuDispatcher
+		*/
+		eENABLE_PARALLEL_VISUALIZATION = (1<<29),
+
+		/**
+		\brief Lets settled islands go to sleep even if a few of their bodies keep moving slightly.
+
+		By default an island only goes to sleep once all its bodies are ready for sleeping, so a single jittering body keeps a whole
+		pile awake. When this flag is set, an island also goes to sleep if the bodies ready for sleeping carry at least
+		PxSceneDesc::islandSleepMassFraction of its mass and the mass-weighted kinetic energy of the island is below the mass-weighted
+		sleep thresholds of its bodies. The remaining bodies are put to sleep with the island.
+
+		Islands with articulations always use the default rule. The number of islands put to sleep by this rule is reported in
+		PxSimulationStatistics::nbSettledIslands.
+
+		Note that this flag is not mutable and must be set in PxSceneDesc at scene creation.
+
+		<b>Default</b> false
+
+		@see PxSceneDesc::islandSleepMassFraction PxRigidDynamic::setSleepThreshold()
+		*/
+		eENABLE_ISLAND_SLEEP = (1<<30),
+
 		eMUTABLE_FLAGS = eENABLE_ACTIVE_ACTORS|eENABLE_ACTIVETRANSFORMS|eEXCLUDE_KINEMATICS_FROM_ACTIVE_ACTORS
 	};
 };
@@ -399,6 +592,7 @@ PX_FLAGS_OPERATORS(PxSceneFlag::Enum,PxU32)
 class PxSimulationEventCallback;
 class PxContactModifyCallback;
 class PxCCDContactModifyCallback;
+class PxNarrowPhaseBackend;
 class PxSimulationFilterCallback;
 
 /**
@@ -549,6 +743,15 @@ public:
 	*/
 	PxCCDContactModifyCallback*	ccdContactModifyCallback;
 
+	/**
+	\brief Optional backend generating the contacts of the discrete narrow phase, e.g. on an accelerator.
+
+	<b>Default:</b> NULL
+
+	@see PxNarrowPhaseBackend
+	*/
+	PxNarrowPhaseBackend*		narrowPhaseBackend;
+
 	/**
 	\brief Shared global filter data which will get passed into the filter shader.
 
@@ -580,6 +783,17 @@ public:
 	*/
 	PxSimulationFilterShader	filterShader;
 
+	/**
+	\brief Optional batched filter shader for newly overlapping rigid body shape pairs.
+
+	Has to implement the same logic as #filterShader, which is still used for all other filtering requests.
+
+	<b>Default:</b> NULL
+
+	@see PxSimulationFilterShaderBatch
+	*/
+	PxSimulationFilterShaderBatch	filterShaderBatch;
+
 	/**
 	\brief A custom collision filter callback which can be used to implement more complex filtering operations which need
 	access to the simulation state, for example.
@@ -695,6 +909,111 @@ public:
 
 	PxReal solverOffsetSlop;
 
+	/**
+	\brief The largest change of a body's linear or angular velocity over one solver iteration for which an island is considered
+	converged.
+
+	\note This only has an effect if PxSceneFlag::eENABLE_ADAPTIVE_SOLVER_ITERATIONS is set.
+
+	<b>Range:</b> [0, PX_MAX_F32)<br>
+	<b>Default:</b> 0.001 * PxTolerancesScale::speed
+
+	@see PxSceneFlag::eENABLE_ADAPTIVE_SOLVER_ITERATIONS
+	*/
+	PxReal solverResidualTolerance;
+
+	/**
+	\brief The fraction of an island's mass that must be ready for sleeping before the whole island may go to sleep.
+
+	\note This only has an effect if PxSceneFlag::eENABLE_ISLAND_SLEEP is set.
+
+	<b>Range:</b> (0, 1]<br>
+	<b>Default:</b> 0.95
+
+	@see PxSceneFlag::eENABLE_ISLAND_SLEEP
+	*/
+	PxReal islandSleepMassFraction;
+
+	/**
+	\brief The fraction of the island id range that must be unused before the island sims start compacting it.
+
+	Islands that split, merge or fall asleep leave freed ids behind, and a large scene can end up with many more island slots than
+	islands. Once the free fraction reaches this value, the highest island ids are moved into the lowest free slots and the node and
+	edge lists of each island are relinked in index order, spread over the following simulation steps with a bounded amount of work
+	per step. Scenes with fewer than a few hundred island slots are never compacted. A value of 0 disables compaction.
+
+	<b>Range:</b> [0, 1)<br>
+	<b>Default:</b> 0.0
+
+	@see PxSimulationStatistics::nbFreeIslandSlots
+	*/
+	PxReal islandCompactionThreshold;
+
+	/**
+	\brief The largest relative translation of a pair of shapes, since its contacts were last fully generated, for which the previous
+	contacts are reused.
+
+	When PCM is enabled, a pair whose relative pose has changed by less than this distance and by less than #contactReuseAngularThreshold
+	since its persistent manifold was last (re)built skips both GJK and the manifold refresh, and reports last step's contacts again.
+	Since the reused contacts are in world space, this is only done when one of the two shapes is static or did not move during the
+	step. This mostly benefits bodies resting on static geometry, such as the bottom of stacks and piles, that jitter slightly without
+	coming to rest. Such pairs are counted in PxSimulationStatistics::nbDiscreteContactPairsWithCacheHits.
+
+	Reused contacts can be off by up to this distance, so keep it well below the contact offsets of the shapes. A value of 0 together
+	with a #contactReuseAngularThreshold of 0 disables the test.
+
+	\note This only has an effect if PxSceneFlag::eENABLE_PCM is set.
+
+	<b>Range:</b> [0, PX_MAX_F32)<br>
+	<b>Default:</b> 0.0
+
+	@see contactReuseAngularThreshold
+	*/
+	PxReal contactReuseLinearThreshold;
+
+	/**
+	\brief The largest relative rotation (in radians) of a pair of shapes, since its contacts were last fully generated, for which the
+	previous contacts are reused.
+
+	<b>Range:</b> [0, PxPi)<br>
+	<b>Default:</b> 0.0
+
+	@see contactReuseLinearThreshold
+	*/
+	PxReal contactReuseAngularThreshold;
+
+	/**
+	\brief Number of simulation steps between two spatial reorderings of the narrow phase pairs.
+
+	The CPU narrow phase processes its pairs in fixed size batches. By default the pairs are batched in the order they were
+	created, so each batch reads the transforms and shapes of bodies spread all over the scene. When this is not zero, the
+	persistent pairs are sorted every narrowPhaseSortInterval steps by the Morton code of the midpoint of their two shapes, so
+	that each batch works on nearby bodies. New pairs are appended at the end until the next sort.
+
+	The sort costs a pass over all pairs, so an interval of a few steps or more is recommended.
+
+	<b>Range:</b> [0, PX_MAX_U32)<br>
+	<b>Default:</b> 0 (disabled)
+	*/
+	PxU32 narrowPhaseSortInterval;
+
+	/**
+	\brief Pushes the simulated shape bounds to the scene query structures at the end of simulate() instead of in fetchResults().
+
+	By default fetchResults() copies the new bounds of the simulated dynamic shapes into the dynamic pruner and marks the
+	tree nodes to refit. When this is true the same work runs in a task at the end of the simulation step, so it overlaps
+	with the application and fetchResults() returns sooner.
+
+	The live scene query structures are then modified while the simulation runs. Between simulate() and fetchResults() the
+	application must not run scene queries other than #PxQueryFlag::eSNAPSHOT queries, call PxScene::flushQueryUpdates(),
+	or add, remove or change shapes that take part in scene queries.
+
+	Ignored when PxSceneFlag::eENABLE_GPU_DYNAMICS is set.
+
+	<b>Default:</b> false
+	*/
+	bool syncSceneQueryBoundsInSimulation;
+
 	/**
 	\brief Flags used to select scene options.
 
@@ -955,10 +1274,12 @@ PX_INLINE PxSceneDesc::PxSceneDesc(const PxTolerancesScale& scale):
 	simulationEventCallback				(NULL),
 	contactModifyCallback				(NULL),
 	ccdContactModifyCallback			(NULL),
+	narrowPhaseBackend					(NULL),
 
 	filterShaderData					(NULL),
 	filterShaderDataSize				(0),
 	filterShader						(NULL),
+	filterShaderBatch					(NULL),
 	filterCallback						(NULL),
 
 	kineKineFilteringMode				(PxPairFilteringMode::eDEFAULT),
@@ -972,6 +1293,13 @@ PX_INLINE PxSceneDesc::PxSceneDesc(const PxTolerancesScale& scale):
 	frictionOffsetThreshold				(0.04f * scale.length),
 	ccdMaxSeparation					(0.04f * scale.length),
 	solverOffsetSlop					(0.0f),
+	solverResidualTolerance				(0.001f * scale.speed),
+	islandSleepMassFraction				(0.95f),
+	islandCompactionThreshold			(0.0f),
+	contactReuseLinearThreshold			(0.0f),
+	contactReuseAngularThreshold		(0.0f),
+	narrowPhaseSortInterval				(0),
+	syncSceneQueryBoundsInSimulation	(false),
 
 	flags								(PxSceneFlag::eENABLE_PCM),
 
@@ -1031,6 +1359,16 @@ PX_INLINE bool PxSceneDesc::isValid() const
 		return false;
 	if(ccdMaxSeparation < 0.0f)
 		return false;
+	if(solverResidualTolerance < 0.0f)
+		return false;
+	if(islandSleepMassFraction <= 0.0f || islandSleepMassFraction > 1.0f)
+		return false;
+	if(islandCompactionThreshold < 0.0f || islandCompactionThreshold >= 1.0f)
+		return false;
+	if(contactReuseLinearThreshold < 0.0f)
+		return false;
+	if(contactReuseAngularThreshold < 0.0f || contactReuseAngularThreshold >= PxPi)
+		return false;
 
 	if(!cpuDispatcher)
 		return false;
@@ -1051,6 +1389,10 @@ PX_INLINE bool PxSceneDesc::isValid() const
 	if(!sanityBounds.isValid())
 		return false;
 
+	//The narrow phase backend replaces the CPU narrow phase, which GPU dynamics do not use
+	if(narrowPhaseBackend && (flags & PxSceneFlag::eENABLE_GPU_DYNAMICS))
+		return false;
+
 	//gpuMaxNumPartitions must be power of 2
 	if((gpuMaxNumPartitions&(gpuMaxNumPartitions - 1)) != 0)
 		return false;
@@ -191,6 +191,26 @@ public:
 	*/
 	virtual		void					setGeometry(const PxGeometry& geometry) = 0;
 
+	/**
+	\brief Notifies the shape that samples of its heightfield have been modified with PxHeightField::modifySamples.
+
+	This is a lighter alternative to setGeometry for mutable terrain: the scene query and broadphase bounds of the shape
+	are refreshed, but only the contact pairs whose bounds overlap the modified region, at any height, lose their
+	cached contact data.
+
+	\note The shape must be a heightfield shape.
+	\note While the scene is simulating, the notification is buffered and behaves like setGeometry.
+	\note This function does not guarantee correct/continuous behavior when objects are resting on top of old or new geometry.
+
+	\param[in] startCol The startCol passed to PxHeightField::modifySamples.
+	\param[in] startRow The startRow passed to PxHeightField::modifySamples.
+	\param[in] nbColumns Number of modified columns, i.e. PxHeightFieldDesc::nbColumns of the subfield.
+	\param[in] nbRows Number of modified rows, i.e. PxHeightFieldDesc::nbRows of the subfield.
+
+	@see PxHeightField.modifySamples setGeometry()
+	*/
+	virtual		void					notifyHeightFieldModified(PxI32 startCol, PxI32 startRow, PxU32 nbColumns, PxU32 nbRows) = 0;
+
 
 	/**
 	\brief Retrieve the geometry from the shape in a PxGeometryHolder wrapper class.
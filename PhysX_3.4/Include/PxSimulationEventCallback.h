@@ -51,6 +51,7 @@ class PxActor;
 class PxRigidActor;
 class PxRigidBody;
 class PxConstraint;
+class PxMaterial;
 
 
 /**
@@ -525,6 +526,9 @@ struct PxContactPair
 
 	This pointer is only valid if contact point information has been requested for the contact report pair (see #PxPairFlag::eNOTIFY_CONTACT_POINTS).
 	Use #extractContacts() as a reference for the data layout of the stream.
+
+	\note The pointer references the narrow phase contact stream of the simulation directly, no copy of the contact data is made for the
+	report. The data stays valid until #PxScene::fetchResults() returns. Use #bufferContacts() to keep the data around for longer.
 	*/
 	const PxU8* contactPatches;
 
@@ -533,6 +537,8 @@ struct PxContactPair
 
 	This pointer is only valid if contact point information has been requested for the contact report pair (see #PxPairFlag::eNOTIFY_CONTACT_POINTS).
 	Use #extractContacts() as a reference for the data layout of the stream.
+
+	\note Like #contactPatches, this points straight into the narrow phase contact stream and stays valid until #PxScene::fetchResults() returns.
 	*/
 	const PxU8* contactPoints;
 
@@ -613,8 +619,9 @@ struct PxContactPair
 	/**
 	\brief Helper method to clone the contact pair and copy the contact data stream into a user buffer.
 	
-	The contact data stream is only accessible during the contact report callback. This helper function provides copy functionality
-	to buffer the contact stream information such that it can get accessed at a later stage.
+	The contact data stream is only accessible until #PxScene::fetchResults() returns. This helper function provides copy functionality
+	to buffer the contact stream information such that it can get accessed at a later stage. Only use it for the pairs that need
+	the data later on, the stream is not copied for the report itself.
 
 	\param[out] newPair The contact pair info will get copied to this instance. The contact data stream pointer of the copy will be redirected to the provided user buffer. Use NULL to skip the contact pair copy operation.
 	\param[out] bufferMemory Memory block to store the contact data stream to. At most #requiredBufferSize bytes will get written to the buffer.
@@ -909,6 +916,56 @@ class PxSimulationEventCallback
 	virtual ~PxSimulationEventCallback() {}
 	};
 
+
+/**
+\brief Per shape pair summary of the contact reports of a simulation step, stored as one array per attribute.
+
+Entry i of every array describes the same shape pair. The pairs are the ones reported through
+PxSimulationEventCallback::onContact(), in the same order. Pairs without contact points (for example pairs that
+lost touch, or pairs that did not request PxPairFlag::eNOTIFY_CONTACT_POINTS) have a zero impulse, point and normal,
+and NULL materials.
+
+The arrays are only valid during the PxContactSummaryCallback::onContactSummary() call.
+
+@see PxContactSummaryCallback PxContactPair
+*/
+struct PxContactSummaryReport
+{
+	PxU32					nbPairs;			//!< Number of entries in each array
+	PxRigidActor*const*		actors[2];			//!< Actors of each pair, NULL if the actor was removed during the step
+	PxShape*const*			shapes[2];			//!< Shapes of each pair, NULL if the shape was removed during the step
+	const PxPairFlags*		events;				//!< Events of each pair, see PxContactPair::events
+	const PxReal*			totalImpulses;		//!< Sum of the normal impulses applied to the contacts of each pair, 0 if the solver did not write impulses
+	const PxVec3*			points;				//!< Impulse weighted average of the contact points of each pair, or their plain average without impulses
+	const PxVec3*			normals;			//!< Impulse weighted average normal of each pair, normalized, using the convention of PxContactPairPoint::normal
+	PxMaterial*const*		materials[2];		//!< Materials of the first contact patch of each pair
+};
+
+/**
+\brief Receives the contact reports of a simulation step as a single PxContactSummaryReport.
+
+This is meant for systems that only need one impulse, point and normal per pair for many pairs, and would otherwise
+have to extract the individual contact points of every pair with PxContactPair::extractContacts(). The summary is
+computed directly from the contact streams of the reports and does not need a #PxSimulationEventCallback.
+
+\note Impulses are only available for pairs the solver wrote impulses for, see PxContactPairFlag::eINTERNAL_HAS_IMPULSES.
+
+@see PxScene::setContactSummaryCallback()
+*/
+class PxContactSummaryCallback
+{
+public:
+	/**
+	\brief Called from PxScene::fetchResults() or PxScene::fetchResultsStart(), before the contact callbacks are sent.
+
+	\param[in] report The summary of all shape pairs with a contact report this step.
+	*/
+	virtual void onContactSummary(const PxContactSummaryReport& report) = 0;
+
+protected:
+	virtual ~PxContactSummaryCallback() {}
+};
+
 #if !PX_DOXYGEN
 } // namespace physx
 #endif
@@ -120,6 +120,22 @@ public:
 		eTRIGGER_PAIRS
 	};
 
+	/**
+	\brief Stages of a simulation step with a measured wall time.
+	@see stageWallTime
+	*/
+	enum SimulationStage
+	{
+		eSTAGE_BROAD_PHASE,		//!< From the start of the broad phase update to the end of the new and lost pair processing
+		eSTAGE_NARROW_PHASE,	//!< First pass of contact generation, from its start to the contact manager outputs being fetched
+		eSTAGE_ISLAND_GEN,		//!< From the start of the island generation to the start of the solver setup
+		eSTAGE_SOLVER,			//!< Constraint setup, solver and integration run by the dynamics context
+		eSTAGE_INTEGRATION,		//!< Post-integration update of the rigid bodies, bounds and sleep state
+		eSTAGE_CCD,				//!< All the continuous collision detection passes. Zero if CCD is disabled.
+		eSTAGE_FETCH_RESULTS,	//!< PxScene::fetchResults() of the step, including the contact and event callbacks
+		eSTAGE_COUNT
+	};
+
 
 //objects:
 	/**
@@ -142,6 +158,37 @@ public:
 	*/
 	PxU32   nbActiveKinematicBodies;
 
+	/**
+	\brief Number of awake islands after the current simulation step.
+	*/
+	PxU32	nbActiveIslands;
+
+	/**
+	\brief Number of islands put to sleep during the current simulation step although some of their bodies were not ready for sleeping.
+
+	\note Always 0 unless PxSceneFlag::eENABLE_ISLAND_SLEEP is set.
+	*/
+	PxU32	nbSettledIslands;
+
+	/**
+	\brief Number of island ids in use or free after the current simulation step.
+	*/
+	PxU32	nbIslandSlots;
+
+	/**
+	\brief Number of free island ids after the current simulation step.
+
+	@see PxSceneDesc::islandCompactionThreshold
+	*/
+	PxU32	nbFreeIslandSlots;
+
+	/**
+	\brief Number of islands moved to a lower id or relinked in index order during the current simulation step.
+
+	\note Always 0 unless PxSceneDesc::islandCompactionThreshold is set.
+	*/
+	PxU32	nbCompactedIslands;
+
 	/**
 	\brief Number of static bodies for the current simulation step.
 	*/
@@ -191,6 +238,40 @@ public:
 	*/
 	PxU32   peakConstraintMemory;
 
+//narrowphase:
+	/**
+	\brief The number of 16K memory blocks taken by the narrow phase for contact and cache data in the current simulation step
+	*/
+	PxU32	nbNpMemBlockAcquires;
+
+	/**
+	\brief The number of times the narrow phase had to lock the shared 16K block pool in the current simulation step.
+
+	Blocks are taken from the pool and handed back to it in batches through per-thread caches. Lower is better: a value close to
+	nbNpMemBlockAcquires means the caches are not effective.
+	*/
+	PxU32	nbNpMemBlockPoolRefills;
+
+//scratch block:
+	/**
+	\brief The peak amount of memory (in bytes) used from the scratch block passed to PxScene::simulate() in the current simulation step.
+
+	The memory used for constraints is not included, see peakConstraintMemory.
+	*/
+	PxU32	scratchBlockPeakUsage;
+
+	/**
+	\brief The number of transient allocations in the current simulation step that did not fit into the scratch block and came from the heap.
+
+	Each of them is also reported as a PxErrorCode::ePERF_WARNING with its call site. Always 0 if no scratch block was passed to PxScene::simulate().
+	*/
+	PxU32	nbScratchBlockOverflows;
+
+	/**
+	\brief The total size (in bytes) of the allocations counted in nbScratchBlockOverflows.
+	*/
+	PxU32	scratchBlockOverflowSize;
+
 //broadphase:
 	/**
 	\brief Get number of broadphase volumes of a certain type added for the current simulation step.
@@ -316,10 +397,85 @@ public:
 	*/
 	PxU32	nbPartitions;
 
+	/**
+	\brief Number of entries in nbIslandsPerPositionIterations and nbIslandsPerVelocityIterations.
+	*/
+	enum { eSOLVER_ITERATION_HISTOGRAM_SIZE = 16 };
+
+	/**
+	\brief Number of islands solved this frame that ran a given number of position iterations.
+
+	Entry i counts the islands that ran i iterations, the last entry counts those that ran eSOLVER_ITERATION_HISTOGRAM_SIZE-1 or
+	more. Islands without constraints run no iterations. Islands only run fewer iterations than their bodies request if
+	PxSceneFlag::eENABLE_ADAPTIVE_SOLVER_ITERATIONS is set.
+	*/
+	PxU32	nbIslandsPerPositionIterations[eSOLVER_ITERATION_HISTOGRAM_SIZE];
+
+	/**
+	\brief Number of islands solved this frame that ran a given number of velocity iterations.
+
+	@see nbIslandsPerPositionIterations
+	*/
+	PxU32	nbIslandsPerVelocityIterations[eSOLVER_ITERATION_HISTOGRAM_SIZE];
+
+	/**
+	\brief Wall time in seconds of each stage of the step.
+
+	The stages run as tasks and can overlap, e.g. the narrow phase runs while the broad phase finishes. The sum of these times
+	is not the time of the step, see stepWallTime for that.
+
+	@see SimulationStage getStageWallTime
+	*/
+	PxReal	stageWallTime[eSTAGE_COUNT];
+
+	/**
+	\brief Wall time in seconds from the start of the collision phase of the step to the end of its finalization, excluding fetchResults().
+	*/
+	PxReal	stepWallTime;
+
+	/**
+	\brief Run time in seconds of the SDK tasks of the step, summed over all threads. Also covers the scene query update tasks.
+
+	\note Not available when the scene does not own its task manager, e.g. when it is stepped by an external task graph.
+	*/
+	PxReal	taskCpuTime;
+
+	/**
+	\brief Number of SDK tasks run during the step.
+	*/
+	PxU32	nbTasks;
+
+	/**
+	\brief Number of worker threads of the CPU dispatcher of the scene.
+	*/
+	PxU32	nbWorkerThreads;
+
+	/**
+	\brief Estimated time in seconds the worker threads did not spend in SDK tasks during the step.
+
+	Computed as nbWorkerThreads * stepWallTime - taskCpuTime, clamped to zero. This includes the time spent running tasks that do
+	not belong to the scene, and does not account for tasks the application thread runs itself.
+	*/
+	PxReal	workerIdleTime;
+
+	/**
+	\brief Returns the wall time of a stage of the step, see stageWallTime.
+	*/
+	PX_FORCE_INLINE PxReal getStageWallTime(SimulationStage stage) const
+	{
+		PX_ASSERT(stage < eSTAGE_COUNT);
+		return stageWallTime[stage];
+	}
+
 	PxSimulationStatistics() :
 		nbActiveConstraints					(0),
 		nbActiveDynamicBodies				(0),
 		nbActiveKinematicBodies				(0),
+		nbActiveIslands						(0),
+		nbSettledIslands					(0),
+		nbIslandSlots						(0),
+		nbFreeIslandSlots					(0),
+		nbCompactedIslands					(0),
 		nbStaticBodies						(0),
 		nbDynamicBodies						(0),
 		nbAggregates						(0),
@@ -328,6 +484,11 @@ public:
 		compressedContactSize				(0),
 		requiredContactConstraintMemory		(0),
 		peakConstraintMemory				(0),
+		nbNpMemBlockAcquires				(0),
+		nbNpMemBlockPoolRefills				(0),
+		scratchBlockPeakUsage				(0),
+		nbScratchBlockOverflows				(0),
+		scratchBlockOverflowSize			(0),
 		nbDiscreteContactPairsTotal			(0),
 		nbDiscreteContactPairsWithCacheHits	(0),
 		nbDiscreteContactPairsWithContacts	(0),
@@ -336,6 +497,11 @@ public:
 		nbNewTouches						(0),
 		nbLostTouches						(0),
 		nbPartitions						(0),
+		stepWallTime						(0.0f),
+		taskCpuTime							(0.0f),
+		nbTasks								(0),
+		nbWorkerThreads						(0),
+		workerIdleTime						(0.0f),
 		particlesGpuMeshCacheSize			(0),
 		particlesGpuMeshCacheUsed			(0),
 		particlesGpuMeshCacheHitrate		(0.0f)
@@ -361,6 +527,15 @@ public:
 		{
 			nbShapes[i] = 0;
 		}
+
+		for(PxU32 i=0; i < eSOLVER_ITERATION_HISTOGRAM_SIZE; i++)
+		{
+			nbIslandsPerPositionIterations[i] = 0;
+			nbIslandsPerVelocityIterations[i] = 0;
+		}
+
+		for(PxU32 i=0; i < eSTAGE_COUNT; i++)
+			stageWallTime[i] = 0.0f;
 	}
 
 
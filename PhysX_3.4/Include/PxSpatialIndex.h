@@ -43,6 +43,8 @@ namespace physx
 {
 #endif
 
+class PxCpuDispatcher;
+
 typedef PxU32 PxSpatialIndexItemId;
 static const PxSpatialIndexItemId PX_SPATIAL_INDEX_INVALID_ITEM_ID = 0xffffffff;
 
@@ -136,6 +138,35 @@ public:
 	virtual	void					update(PxSpatialIndexItemId id,
 										   const PxBounds3& bounds)							= 0;
 
+	/**
+	\brief insert several bounding boxes into a spatial index
+
+	This is equivalent to calling insert() for each item, but faster. Inserting many items into an empty index builds the
+	index directly from them.
+
+	\param[in] items the items to be inserted
+	\param[in] bounds the bounds of the new items
+	\param[in] nbItems the number of items
+	\param[out] ids the ids of the new items, nbItems entries
+	*/
+	virtual	void					insert(PxSpatialIndexItem* const* items,
+										   const PxBounds3* bounds,
+										   PxU32 nbItems,
+										   PxSpatialIndexItemId* ids)						= 0;
+
+	/**
+	\brief update several bounding boxes in a spatial index
+
+	This is equivalent to calling update() for each item, but faster.
+
+	\param[in] ids the ids of the items to be updated
+	\param[in] bounds the new bounds of the items
+	\param[in] nbItems the number of items
+	*/
+	virtual	void					update(const PxSpatialIndexItemId* ids,
+										   const PxBounds3* bounds,
+										   PxU32 nbItems)									= 0;
+
 	/**
 	\brief remove an item from a spatial index
 
@@ -193,6 +224,16 @@ public:
 	*/
 	virtual void					rebuildFull()											= 0;
 
+	/**
+	\brief force a full optimized rebuild of the index, using the worker threads of a CPU dispatcher.
+
+	The calling thread takes part in the rebuild and returns once it is complete, the result is the same as rebuildFull().
+	Small indices are rebuilt on the calling thread only.
+
+	\param[in] dispatcher the dispatcher whose worker threads build parts of the index
+	*/
+	virtual void					rebuildFull(PxCpuDispatcher& dispatcher)				= 0;
+
 	/**
 	\brief set the incremental rebuild rate for the index. 
 	
@@ -35,6 +35,7 @@
 */
 
 #include "characterkinematic/PxCharacter.h"
+#include "characterkinematic/PxController.h"
 
 #include "PxPhysXConfig.h"
 #include "foundation/PxFlags.h"
@@ -52,6 +53,7 @@ class PxController;
 class PxControllerDesc;
 class PxObstacleContext;
 class PxControllerFilterCallback;
+class PxCpuDispatcher;
 
 /**
 \brief specifies debug-rendering flags
@@ -194,6 +196,38 @@ public:
 	*/
 	virtual	void				computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb=NULL) = 0;
 
+	/**
+	\brief Moves several characters using the worker threads of a CPU dispatcher.
+
+	This is equivalent to calling PxController::move(disps[i], minDist, elapsedTime, filters, obstacles) for each controllers[i], except that
+	the characters are moved concurrently. During the call, each character sees the other characters at the positions they had before the call,
+	so the results do not depend on the order in which the characters are processed. Overlaps created between characters are resolved by the
+	next computeInteractions() call, as usual.
+
+	The kinematic actors of the characters are updated on the calling thread once all characters have moved, or by the next
+	applyPendingMoves() call if scene query snapshots are enabled.
+
+	\note The callbacks of the characters and of the filters are called concurrently from the worker threads and must be thread-safe.
+	\note The scene is only read during the call, so it must not be modified concurrently. Debug rendering is disabled for these moves.
+	\note The calling thread processes characters too and blocks until all of them have moved, so it must not be a worker thread of the dispatcher.
+	\note Each character must appear at most once in the controllers array.
+
+	\param[in] nbControllers	Number of characters to move
+	\param[in] controllers		Characters to move. They must all belong to this manager.
+	\param[in] disps			Displacement vector of each character
+	\param[in] minDist			The minimum travelled distance to consider
+	\param[in] elapsedTime		Time elapsed since last call
+	\param[in] filters			User-defined filters for this move
+	\param[in] obstacles		Potential additional obstacles the characters should collide with
+	\param[in] dispatcher		CPU dispatcher whose worker threads move the characters
+	\param[out] collisionFlags	Collision flags of each character, as returned by PxController::move. Can be NULL.
+
+	@see PxController::move computeInteractions setSceneQuerySnapshots
+	*/
+	virtual	void				moveControllers(PxU32 nbControllers, PxController* const* controllers, const PxVec3* disps, PxF32 minDist, PxF32 elapsedTime,
+												const PxControllerFilters& filters, const PxObstacleContext* obstacles, PxCpuDispatcher& dispatcher,
+												PxControllerCollisionFlags* collisionFlags = NULL) = 0;
+
 	/**
 	\brief Enables or disables runtime tessellation.
 
@@ -256,6 +290,48 @@ public:
 	*/
 	virtual	void				setPreventVerticalSlidingAgainstCeiling(bool flag) = 0;
 
+	/**
+	\brief Enables or disables the sharing of static triangle mesh data between characters.
+
+	Each character caches the geometry around it, and refills that cache when it moves out of the cached volume. When
+	sharing is enabled, the triangles of static triangle meshes are gathered once per region of space and shared by all
+	characters whose cached volume falls within that region, instead of being queried from the mesh by each character.
+	This reduces the cost of refilling the caches in dense crowds, at the expense of the memory used by the shared sets.
+
+	By default, sharing is disabled.
+
+	\param[in] flag				True/false to enable/disable sharing.
+	*/
+	virtual	void				setStaticGeometrySharing(bool flag) = 0;
+
+	/**
+	\brief Enables or disables scene query snapshots for character moves.
+
+	When enabled, the scene queries of the characters use PxQueryFlag::eSNAPSHOT, so they run against the scene query snapshot
+	published by the last fetchResults() and do not need the scene read lock. The characters can then be moved while the scene is
+	simulated. The updates of their kinematic actors are not applied by PxController::move and moveControllers anymore: they are
+	kept until applyPendingMoves() is called, typically once fetchResults() has returned and before the next simulate() call.
+
+	The scene must be created with PxSceneFlag::eENABLE_SCENE_QUERY_SNAPSHOTS. The characters see the other actors as they were
+	at the end of the previous fetchResults(), which is also the state reported by the actor getters during the simulation.
+
+	By default, snapshots are disabled.
+
+	\param[in] flag				True/false to enable/disable scene query snapshots.
+
+	@see applyPendingMoves PxSceneFlag::eENABLE_SCENE_QUERY_SNAPSHOTS
+	*/
+	virtual	void				setSceneQuerySnapshots(bool flag) = 0;
+
+	/**
+	\brief Applies the kinematic actor updates of the characters moved since the last call.
+
+	Only needed when scene query snapshots are enabled. The scene is written to, so this must not be called while the scene is simulated.
+
+	@see setSceneQuerySnapshots
+	*/
+	virtual	void				applyPendingMoves() = 0;
+
 	/**
 	\brief Shift the origin of the character controllers and obstacle objects by the specified vector.
 
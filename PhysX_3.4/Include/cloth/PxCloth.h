@@ -318,6 +318,22 @@ public:
 	*/
 	virtual PxReal getSolverFrequency() const = 0;
 
+	/**
+	\brief Sets the level of detail factor.
+	\details The factor scales the solver frequency, and with it the number of fabric phase iterations
+	per frame, which allows trading accuracy for performance on distant or background cloth. 
+	A factor of 0 freezes the cloth: the solver skips it entirely, it is not woken up by collision 
+	shape or pose changes, and it reports being asleep until the factor is raised again.
+	\param [in] factor Level of detail factor. <b>Range:</b> [0, PX_MAX_F32) (default: 1.0).
+	\see setSolverFrequency()
+	*/
+	virtual void setLodFactor(PxReal factor) = 0;
+	/**
+	\brief Returns the level of detail factor.
+	\return Level of detail factor.
+	*/
+	virtual PxReal getLodFactor() const = 0;
+
 	/**
 	\brief Returns previous time step size.
 	\details Time between sampling of previous and current particle positions for computing particle velocity.
@@ -946,7 +962,9 @@ public:
 	\brief Sets the velocity threshold for putting cloth in sleep state.
 	\details If none of the particles moves faster (in local space)
 	than the threshold for a while, the cloth will be put in
-	sleep state and simulation will be skipped.
+	sleep state and simulation will be skipped. Sleeping cloth wakes up
+	when the collision shapes or the pose change, setting collision
+	spheres or planes to their current values does not wake it up.
 	\param [in] threshold Velocity threshold (default: 0.0f)
 	*/
 	virtual void setSleepLinearVelocity(PxReal threshold) = 0;
@@ -132,6 +132,10 @@ public:
 	\param address Location at which object is created. Address is increased by the size of the created object.
 	\param context Context for reading external data and resolving references.
 	\return	Created PxBase pointer (needs to be identical to address before increment).
+
+	\note With PxSerialization::createCollectionFromBinary(void*, PxSerializationRegistry&, PxCpuDispatcher&, const PxCollection*),
+	objects that do not require each other are created concurrently. Other objects may then only be modified through thread safe
+	operations, unless this object is the only one requiring them.
 	*/
 	virtual         PxBase*			createObject(PxU8*& address, PxDeserializationContext& context) const	= 0; 
 
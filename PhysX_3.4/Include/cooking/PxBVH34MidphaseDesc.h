@@ -42,6 +42,34 @@ namespace physx
 {
 #endif
 
+/**
+\brief Strategy used to split the nodes when building the BVH34 tree.
+
+@see PxBVH34MidphaseDesc
+*/
+struct PxBVH34BuildStrategy
+{
+	enum Enum
+	{
+		/**
+		\brief Splits nodes along the axis of greatest variance of the triangle centers. Fast to build.
+		*/
+		eDEFAULT	= 0,
+
+		/**
+		\brief Splits nodes with a binned surface area heuristic (SAH).
+
+		Slower to build than eDEFAULT, but the resulting tree is usually visited less by raycasts and other queries.
+		Recommended for meshes that are cooked offline and queried heavily at runtime.
+
+		@see PxBVH34MidphaseDesc::numSAHBins
+		*/
+		eSAH		= 1,
+
+		eLAST
+	};
+};
+
 /**
 
 \brief Structure describing parameters affecting BVH34 midphase mesh structure.
@@ -61,12 +89,33 @@ struct PxBVH34MidphaseDesc
 	*/
 	PxU32			numTrisPerLeaf;
 
+	/**
+	\brief Strategy used to split the nodes of the tree.
+
+	<b>Default value:</b> PxBVH34BuildStrategy::eDEFAULT
+
+	@see PxBVH34BuildStrategy
+	*/
+	PxBVH34BuildStrategy::Enum	buildStrategy;
+
+	/**
+	\brief Number of bins per axis evaluated for each split by PxBVH34BuildStrategy::eSAH. Ignored by other build strategies.
+
+	This is the quality/speed knob of the SAH build: more bins find better splits, at the cost of a longer build.
+
+	<b>Default value:</b> 16
+	<b>Range:</b> <2, 64>
+	*/
+	PxU32			numSAHBins;
+
 	/**
 	\brief Desc initialization to default value.
 	*/
     void setToDefault()
     {
 	    numTrisPerLeaf = 4;
+	    buildStrategy = PxBVH34BuildStrategy::eDEFAULT;
+	    numSAHBins = 16;
     }
 
 	/**
@@ -77,6 +126,10 @@ struct PxBVH34MidphaseDesc
 	{
 		if(numTrisPerLeaf < 4 || numTrisPerLeaf > 15)
 			return false;
+		if(buildStrategy >= PxBVH34BuildStrategy::eLAST)
+			return false;
+		if(buildStrategy == PxBVH34BuildStrategy::eSAH && (numSAHBins < 2 || numSAHBins > 64))
+			return false;
 		return true;
 	}
 };
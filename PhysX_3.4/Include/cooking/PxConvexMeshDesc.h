@@ -147,7 +147,34 @@ struct PxConvexFlag
 		numerical stability.
 		\note Is used only with eCOMPUTE_CONVEX flag.
 		*/
-		eSHIFT_VERTICES = (1 << 9)
+		eSHIFT_VERTICES = (1 << 9),
+
+		/**
+		\brief Defers the computation of the hill climbing data of hulls above PxCookingParams::gaussMapLimit.
+
+		The data is not computed nor stored by the cooking. The runtime builds it the first time the mesh is used by a
+		scene query, a sweep or contact generation, so meshes that are never tested against anything (e.g. fracture
+		pieces that never reach the narrowphase) do not pay for its memory and cooking time.
+
+		\note Meshes cooked with this flag can only be loaded by a runtime supporting it.
+		\note The data is built before a convex mesh is serialized with PxSerialization::serializeCollectionToBinary.
+
+		@see PxCookingParams::gaussMapLimit
+		*/
+		eDEFER_GAUSS_MAP = (1 << 10),
+
+		/**
+		\brief The input points are trusted to be the vertices of a convex hull, e.g. the cells of a runtime Voronoi fracture.
+
+		The hull computation neither welds duplicated input points nor merges adjacent faces beyond the planarity
+		tolerance of the hull, so that only faces lying on the same plane end up in the same polygon.
+		For the lightest runtime cooking, combine it with eDISABLE_MESH_VALIDATION, eFAST_INERTIA_COMPUTATION and
+		eDEFER_GAUSS_MAP.
+
+		\note Is used only with eCOMPUTE_CONVEX flag.
+		\note Duplicated or nearly duplicated input points are not supported with this flag.
+		*/
+		ePREHULLED_INPUT = (1 << 11)
 	};
 };
 
@@ -50,6 +50,8 @@ namespace physx
 class PxBinaryConverter;
 class PxPhysicsInsertionCallback;
 class PxFoundation;
+class PxCpuDispatcher;
+class PxOutputStream;
 
 struct PX_DEPRECATED PxPlatform
 {
@@ -199,12 +201,81 @@ struct PxMeshPreprocessingFlag
 
 		\note By default mesh will be created with 16-bit indices for triangle count <= 0xFFFF and 32-bit otherwise.
 		*/
-		eFORCE_32BIT_INDICES							=	1 << 3
+		eFORCE_32BIT_INDICES							=	1 << 3,
+
+		/**
+		\brief When set, the vertices are stored quantized to 16 bits per axis, and 32-bit triangle indices are stored as
+		16-bit offsets. The midphase decodes the triangles it touches on the fly.
+
+		This roughly halves the memory used by the vertices, and by the indices of meshes that need 32-bit indices. Vertex
+		positions are snapped to 1/65535 of the bounds of small groups of neighbouring vertices, and queries are slightly slower.
+		PxTriangleMesh::getVertices() and PxTriangleMesh::getTriangles() return decoded copies, allocated on first use.
+		Compressed meshes cannot be modified or refitted.
+
+		\note Only supported for PxMeshMidPhase::eBVH34 meshes without GPU data, ignored otherwise.
+		*/
+		eCOMPRESS_MESH_DATA								=	1 << 4
 	};
 };
 
 typedef PxFlags<PxMeshPreprocessingFlag::Enum,PxU32> PxMeshPreprocessingFlags;
 
+/**
+\brief 128-bit hash of the inputs of a cooking call.
+
+The key covers the content of the mesh descriptor and all the PxCookingParams members that affect the cooked data, as
+well as the SDK version. Identical inputs produce identical keys, on any machine.
+
+@see PxCookingCache
+*/
+struct PxCookingCacheKey
+{
+	PxU64	hash[2];
+
+	PX_INLINE bool operator==(const PxCookingCacheKey& other) const	{ return hash[0]==other.hash[0] && hash[1]==other.hash[1];	}
+	PX_INLINE bool operator!=(const PxCookingCacheKey& other) const	{ return !(*this==other);	}
+};
+
+/**
+\brief User cache of cooked streams, queried by PxCooking::cookTriangleMesh() and PxCooking::cookConvexMesh().
+
+When PxCookingParams::cache is set, the cooking functions first compute the key of their inputs and ask the cache for it.
+On a hit the cached data is written to the output stream and nothing is cooked. On a miss the mesh is cooked and the result
+is handed to store(). Failed cooks are not stored.
+
+The data is opaque: the cache must return exactly the bytes it has been given for a key. It contains the cooked stream and
+the cooking result code.
+
+PxCooking::cookConvexMeshes() can query the cache from several threads at the same time when PxCookingParams::cpuDispatcher
+is set, in which case the implementation must be thread-safe.
+
+@see PxCookingParams::cache PxDefaultCookingCache
+*/
+class PxCookingCache
+{
+public:
+	/**
+	\brief Looks up a key.
+
+	\param[in] key		key of the cooking inputs
+	\param[out] stream	stream receiving the data stored for this key, if any. Nothing must be written on a miss.
+	\return True if the key was found and its data written to the stream.
+	*/
+	virtual bool	load(const PxCookingCacheKey& key, PxOutputStream& stream) = 0;
+
+	/**
+	\brief Stores the data of a key. Called after a successful cook that missed the cache.
+
+	\param[in] key	key of the cooking inputs
+	\param[in] data	data to return for this key. Only valid during the call.
+	\param[in] size	size of the data in bytes
+	*/
+	virtual void	store(const PxCookingCacheKey& key, const void* data, PxU32 size) = 0;
+
+protected:
+	virtual			~PxCookingCache()	{}
+};
+
 /**
 
 \brief Structure describing parameters affecting mesh cooking.
@@ -393,9 +464,67 @@ struct PxCookingParams
 	extra structures actually hurt performance.
 
 	<b>Default value:</b> 32
+
+	@see PxConvexFlag::eDEFER_GAUSS_MAP
 	*/
 	PxU32	gaussMapLimit;
 
+	/**
+	\brief Optional CPU dispatcher used to build the midphase structure of triangle meshes with multiple threads.
+
+	When set, the tree of BVH34 meshes is built with parallel tasks, as well as the initial sorting stage of BVH33 meshes
+	cooked with PxMeshCookingHint::eSIM_PERFORMANCE. The cooked data is the same as without a dispatcher.
+	PxCooking::cookConvexMeshes() also uses it to cook the meshes of a batch in parallel.
+
+	The tasks are submitted directly to the dispatcher, and the cooking thread waits for them to complete. Cooking
+	must therefore not be called from one of the dispatcher's worker threads.
+
+	<b>Default value:</b> NULL
+
+	@see PxCpuDispatcher PxDefaultCpuDispatcher
+	*/
+	PxCpuDispatcher*	cpuDispatcher;
+
+	/**
+	\brief Optional user memory block for the temporary buffers of triangle mesh cooking.
+
+	When set, the mesh cleaning and edge list stages of PxCooking::cookTriangleMesh() and PxCooking::createTriangleMesh() carve
+	their temporary buffers out of this block instead of allocating them from the heap. Temporary buffers that do not fit are
+	allocated from the heap as usual. Repeatedly cooking meshes of similar size with the same block therefore avoids most of the
+	per-cook allocator traffic.
+
+	The block must be 16-byte aligned and must stay valid while the PxCooking object uses these parameters. Since the block is
+	shared by all cooking calls, triangle meshes must not be cooked from several threads at the same time when it is set.
+	Convex mesh and height field cooking do not use it.
+
+	<b>Default value:</b> NULL
+
+	@see scratchMemorySize
+	*/
+	void*	scratchMemory;
+
+	/**
+	\brief Size in bytes of the scratchMemory block.
+
+	<b>Default value:</b> 0
+
+	@see scratchMemory
+	*/
+	PxU32	scratchMemorySize;
+
+	/**
+	\brief Optional cache of cooked streams, used by PxCooking::cookTriangleMesh(), PxCooking::cookConvexMesh() and
+	PxCooking::cookConvexMeshes().
+
+	The cache and the members cpuDispatcher, scratchMemory and scratchMemorySize do not affect the cooked data, they are not
+	part of the cache keys. The createTriangleMesh() and createConvexMesh() functions do not use the cache.
+
+	<b>Default value:</b> NULL
+
+	@see PxCookingCache
+	*/
+	PxCookingCache*	cache;
+
 	PxCookingParams(const PxTolerancesScale& sc):
 		skinWidth						(0.025f*sc.length),
 		areaTestEpsilon					(0.06f*sc.length*sc.length),
@@ -408,7 +537,11 @@ struct PxCookingParams
 		meshPreprocessParams			(0),
 		meshCookingHint					(PxMeshCookingHint::eSIM_PERFORMANCE),
 		meshSizePerformanceTradeOff		(0.55f),
-		meshWeldTolerance				(0.f)
+		meshWeldTolerance				(0.f),
+		cpuDispatcher					(NULL),
+		scratchMemory					(NULL),
+		scratchMemorySize				(0),
+		cache							(NULL)
 	{
 #if PX_INTEL_FAMILY
 		targetPlatform = PxPlatform::ePC;
@@ -535,6 +668,27 @@ public:
 	*/
 	virtual bool  cookConvexMesh(const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition = NULL) const = 0;
 
+	/**
+	\brief Cooks a batch of convex meshes. The results are written to one stream per mesh.
+
+	This produces the same data as calling cookConvexMesh() for each descriptor. The meshes are cooked in parallel
+	when PxCookingParams::cpuDispatcher is set, and the working memory of the hull computation is reused
+	from one mesh to the next instead of being reallocated for each of them.
+
+	\note The streams are written from the dispatcher's worker threads, each one by a single thread at a time. They must
+	be distinct objects.
+	\note Like the other cooking functions using the dispatcher, this must not be called from one of its worker threads.
+
+	\param[in] nbMeshes Number of meshes to cook.
+	\param[in] descs Array of nbMeshes convex mesh descriptors.
+	\param[in] streams Array of nbMeshes user streams, the cooked data of descs[i] is written to streams[i].
+	\param[out] conditions Optional array of nbMeshes results, conditions[i] is the cooking result of descs[i].
+	\return true if all the meshes were cooked successfully.
+
+	@see cookConvexMesh() PxCookingParams::cpuDispatcher PxConvexMeshCookingResult::Enum
+	*/
+	virtual bool  cookConvexMeshes(PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions = NULL) const = 0;
+
 	/**
 	\brief Cooks and creates a convex mesh and inserts it into PxPhysics.
 
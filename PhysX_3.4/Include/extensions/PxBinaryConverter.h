@@ -41,6 +41,8 @@ namespace physx
 {
 #endif
 
+class PxCpuDispatcher;
+
 struct PxConverterReportMode
 {
 	enum Enum
@@ -51,6 +53,19 @@ struct PxConverterReportMode
 	};
 };
 
+/**
+\brief One collection of a batch conversion.
+
+@see PxBinaryConverter.convertBatch
+*/
+struct PxBinaryConverterBatchItem
+{
+	PxInputStream*		srcStream;		//!< Source stream
+	PxU32				srcSize;		//!< Number of bytes to convert
+	PxOutputStream*		targetStream;	//!< Target stream
+	bool				success;		//!< Written by convertBatch: true if this collection was converted successfully
+};
+
 
 /**
 \brief Binary converter for serialized streams.
@@ -60,8 +75,8 @@ such as windows, osx or linux to any game runtime platform supported by PhysX. P
 it is currently not supported to run the converter on a platforms that has an endian mismatch 
 with the platform corresponding to the source binary file and source meta data. 
 
-If you want to use multiple threads for batch conversions, please create one instance
-of this class for each thread.
+A single instance must not be used by several threads at the same time. Batch conversions
+should use convertBatch, which loads the meta data once and converts the collections in parallel.
 
 @see PxSerialization.createBinaryConverter
 */
@@ -118,6 +133,25 @@ public:
 	*/
 	virtual		bool	convert(PxInputStream& srcStream, PxU32 srcSize, PxOutputStream& targetStream)		= 0;
 
+	/**
+	\brief Converts a batch of binary streams from source platform to target platform
+
+	Each item is converted exactly as convert() would convert it, so the output does not depend on the
+	number of threads or on the order in which the items get processed. The meta data set with setMetaData 
+	is shared by all conversions.
+
+	The items are distributed over the worker threads of the dispatcher, the calling thread converts items too and 
+	returns once all of them are done. It must therefore not be one of the dispatcher's worker threads. The streams 
+	of different items are accessed concurrently and must be independent.
+
+	\param[in,out] items		Collections to convert. PxBinaryConverterBatchItem::success is written for each of them
+	\param[in] nbItems			Number of items
+	\param[in] dispatcher		Dispatcher providing the worker threads, or NULL to convert all items on the calling thread
+
+	\return True if all items were converted successfully
+	*/
+	virtual		bool	convertBatch(PxBinaryConverterBatchItem* items, PxU32 nbItems, PxCpuDispatcher* dispatcher)	= 0;
+
 
 protected:
 						PxBinaryConverter()		{}
@@ -45,6 +45,7 @@ namespace physx
 #endif
 
 class PxPhysics;
+class PxCpuDispatcher;
 
 struct PxFabricCookerImpl;
 
@@ -62,8 +63,10 @@ public:
 	\param useGeodesicTether A flag to indicate whether to compute geodesic distance for tether constraints.
 	\note The geodesic option for tether only works for manifold input.  For non-manifold input, a simple Euclidean distance will be used.
 	For more detailed cooker status for such cases, try running PxClothGeodesicTetherCooker directly.
+	\param dispatcher Optional dispatcher used to sort the constraint sets and to run the geodesic tether searches in parallel.
+	The cooked fabric does not depend on it. Must not be called from a worker thread of the dispatcher.
 	*/
-	PxClothFabricCooker(const PxClothMeshDesc& desc, const PxVec3& gravity, bool useGeodesicTether = true);
+	PxClothFabricCooker(const PxClothMeshDesc& desc, const PxVec3& gravity, bool useGeodesicTether = true, PxCpuDispatcher* dispatcher = NULL);
 	~PxClothFabricCooker();
 
 	/** \brief Returns the fabric descriptor to create the fabric. */
@@ -83,10 +86,11 @@ private:
 \param gravity A normalized vector which specifies the direction of gravity. 
 This information allows the cooker to generate a fabric with higher quality simulation behavior.
 \param useGeodesicTether A flag to indicate whether to compute geodesic distance for tether constraints.
+\param dispatcher Optional dispatcher for parallel cooking, see PxClothFabricCooker.
 \return The created cloth fabric, or NULL if creation failed.
 */
 PxClothFabric* PxClothFabricCreate(PxPhysics& physics, 
-	const PxClothMeshDesc& desc, const PxVec3& gravity, bool useGeodesicTether = true);
+	const PxClothMeshDesc& desc, const PxVec3& gravity, bool useGeodesicTether = true, PxCpuDispatcher* dispatcher = NULL);
 
 #if !PX_DOXYGEN
 } // namespace physx
@@ -73,6 +73,7 @@ private:
 
 
 struct PxClothGeodesicTetherCookerImpl;
+class PxCpuDispatcher;
 
 /**
 \deprecated The PhysX cloth feature has been deprecated in PhysX version 3.4.1
@@ -88,12 +89,14 @@ public:
 	But the cooking time is slower than the simple cooker.
 	\see PxClothSimpleTetherCooker
 	\param desc The cloth mesh descriptor prepared for cooking
+	\param dispatcher Optional dispatcher used to run the per-island distance searches and the per-particle tether
+	evaluations in parallel. The tether data does not depend on it. Must not be called from a worker thread of the dispatcher.
 	\note The geodesic distance is optimized to work for intended use in tether constraint.  
 	This is by no means a general purpose geodesic computation code for arbitrary meshes.
 	\note The geodesic cooker does not work with non-manifold input such as edges having more than two incident triangles, 
 	or adjacent triangles following inconsitent winding order (e.g. clockwise vs counter-clockwise). 
 	*/
-	PxClothGeodesicTetherCooker(const PxClothMeshDesc &desc);
+	PxClothGeodesicTetherCooker(const PxClothMeshDesc &desc, PxCpuDispatcher* dispatcher = NULL);
 	~PxClothGeodesicTetherCooker();
 
 	/**
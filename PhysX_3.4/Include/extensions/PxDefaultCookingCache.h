@@ -0,0 +1,95 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#ifndef PX_DEFAULT_COOKING_CACHE_H
+#define PX_DEFAULT_COOKING_CACHE_H
+/** \addtogroup extensions
+@{
+*/
+
+#include "common/PxPhysXCommonConfig.h"
+#include "cooking/PxCooking.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	/**
+	\brief Cooking cache storing each cooked stream in its own file of a directory.
+
+	Files are named after the hexadecimal cache key. They are written to a temporary file first and then renamed, so several
+	threads or processes can share the same directory: a reader never sees a partially written entry. Files which are
+	truncated or do not match their key are treated as misses.
+
+	The cache never removes files. Deleting the directory content at any time is safe.
+
+	@see PxCookingCache PxCookingParams::cache
+	*/
+	class PxDefaultCookingCache : public PxCookingCache
+	{
+		public:
+			/**
+			\brief Creates a cache backed by an existing directory.
+
+			\param[in] directory	path of the directory, with or without trailing separator. It is copied.
+			*/
+							PxDefaultCookingCache(const char* directory);
+			virtual			~PxDefaultCookingCache();
+
+			virtual	bool	load(const PxCookingCacheKey& key, PxOutputStream& stream);
+			virtual	void	store(const PxCookingCacheKey& key, const void* data, PxU32 size);
+
+			/**
+			\brief Returns the number of successful load() calls.
+			*/
+			PxU32			getNbHits()		const	{ return PxU32(mNbHits);	}
+
+			/**
+			\brief Returns the number of load() calls which did not find their key.
+			*/
+			PxU32			getNbMisses()	const	{ return PxU32(mNbMisses);	}
+
+		private:
+			char*			mDirectory;
+			volatile PxI32	mNbHits;
+			volatile PxI32	mNbMisses;
+			volatile PxI32	mNbTempFiles;
+
+			void			getFileName(const PxCookingCacheKey& key, char* buffer, PxU32 bufferSize)	const;
+
+							PxDefaultCookingCache(const PxDefaultCookingCache&);
+			PxDefaultCookingCache&	operator=(const PxDefaultCookingCache&);
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
@@ -42,6 +42,32 @@ namespace physx
 {
 #endif
 
+/**
+\brief Selects how PxDefaultCpuDispatcher distributes tasks to its worker threads.
+
+@see PxDefaultCpuDispatcherCreate()
+*/
+struct PxDefaultCpuDispatcherMode
+{
+	enum Enum
+	{
+		/**
+		\brief Tasks submitted from outside a worker thread go to a single queue shared by all workers.
+		Idle workers block on a common wake signal.
+		*/
+		eSHARED_QUEUE,
+
+		/**
+		\brief Each worker owns a bounded lock-free deque which receives the tasks it submits itself.
+		Idle workers steal from randomly selected victims and spin for a while before they block.
+
+		\note Preferable on machines with many cores, where contention on the shared queue becomes visible.
+		Tasks submitted from non-worker threads, or from a worker whose deque is full, still go to the shared queue.
+		*/
+		eWORK_STEALING
+	};
+};
+
 /**
 \brief A default implementation for a CPU task dispatcher.
 
@@ -74,6 +100,27 @@ public:
 	\return True if tasks should be profiled.
 	*/
 	virtual bool getRunProfiled() const = 0;
+
+	/**
+	\brief Returns the NUMA node the worker threads are bound to.
+
+	\return The node passed to #PxDefaultCpuDispatcherCreateForNumaNode(), or 0xffffffff if the workers are not bound to a node.
+	*/
+	virtual PxU32 getNumaNode() const = 0;
+
+	/**
+	\brief Writes to every page of a memory block from one of the worker threads, and waits for completion.
+
+	With the usual first-touch page placement policy of the operating system, this makes the memory resident
+	on the NUMA node of the workers. Use it for example on the scratch block handed to PxScene::setScratchBlock()
+	of a scene whose tasks are dispatched to this dispatcher. The contents of the block are zeroed.
+
+	\note Must not be called from one of this dispatcher's worker threads.
+
+	\param[in] memory Start of the memory block.
+	\param[in] size Size of the memory block in bytes.
+	*/
+	virtual void firstTouch(void* memory, PxU32 size) = 0;
 };
 
 
@@ -82,13 +129,47 @@ public:
 
 \param[in] numThreads Number of worker threads the dispatcher should use.
 \param[in] affinityMasks Array with affinity mask for each thread. If not defined, default masks will be used.
+\param[in] mode How tasks are distributed to the worker threads. See #PxDefaultCpuDispatcherMode.
 
 \note numThreads may be zero in which case no worker thread are initialized and
 simulation tasks will be executed on the thread that calls PxScene::simulate()
 
-@see PxDefaultCpuDispatcher
+@see PxDefaultCpuDispatcher PxDefaultCpuDispatcherMode
+*/
+PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks = NULL, PxDefaultCpuDispatcherMode::Enum mode = PxDefaultCpuDispatcherMode::eSHARED_QUEUE);
+
+/**
+\brief Returns the number of NUMA nodes of the machine.
+
+\note Always 1 on platforms where the topology cannot be queried.
+*/
+PxU32 PxDefaultCpuDispatcherGetNumaNodeCount();
+
+/**
+\brief Returns the affinity mask covering the logical processors of a NUMA node.
+
+\param[in] numaNode Index of the node, smaller than #PxDefaultCpuDispatcherGetNumaNodeCount().
+\return The mask, or 0 if unknown. Only the first 32 logical processors can be represented.
+*/
+PxU32 PxDefaultCpuDispatcherGetNumaNodeAffinityMask(PxU32 numaNode);
+
+/**
+\brief Create a default dispatcher whose worker threads form a group bound to one NUMA node.
+
+All workers get the affinity mask of the node, so the operating system keeps them on that socket.
+Several PxScenes can then be pinned to different nodes by giving each one its own group as
+PxSceneDesc::cpuDispatcher. Use #PxDefaultCpuDispatcher::firstTouch() to also place the scene's
+scratch block on the node.
+
+\param[in] numaNode Index of the node, smaller than #PxDefaultCpuDispatcherGetNumaNodeCount().
+\param[in] numThreads Number of worker threads in the group.
+\param[in] mode How tasks are distributed to the worker threads. See #PxDefaultCpuDispatcherMode.
+
+\note Falls back to unbound workers if the node mask is unknown.
+
+@see PxDefaultCpuDispatcherCreate() PxDefaultCpuDispatcherGetNumaNodeCount()
 */
-PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks = NULL);
+PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreateForNumaNode(PxU32 numaNode, PxU32 numThreads, PxDefaultCpuDispatcherMode::Enum mode = PxDefaultCpuDispatcherMode::eSHARED_QUEUE);
 
 #if !PX_DOXYGEN
 } // namespace physx
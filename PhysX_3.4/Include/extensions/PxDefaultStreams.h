@@ -139,6 +139,89 @@ private:
 		PxU32			mLength;
 };
 
+/** 
+\brief memory-mapped file read stream
+
+The file is mapped copy-on-write: getData() can be passed directly to in-place creation functions such as
+PxPhysics::createTriangleMeshInPlace() or PxSerialization::createCollectionFromBinary(), which may patch the data, without
+the file ever being modified or copied into an intermediate buffer. The mapping is page aligned, which satisfies
+PX_SERIAL_FILE_ALIGN.
+
+Objects created in place reference the mapped data, so the stream must outlive them.
+
+On platforms without file mapping support the stream is never valid.
+
+@see PxInputData PxDefaultFileInputData
+*/
+
+class PxDefaultMappedFileInputData: public PxInputData
+{
+public:
+						PxDefaultMappedFileInputData(const char* name);
+	virtual				~PxDefaultMappedFileInputData();
+
+	virtual		PxU32	read(void* dest, PxU32 count);
+	virtual		void	seek(PxU32 pos);
+	virtual		PxU32	tell() const;
+	virtual		PxU32	getLength() const;
+
+				bool	isValid() const		{ return mValid;	}
+
+	/**
+	\brief Returns the start of the mapped file, or NULL for an empty or invalid file.
+	*/
+				PxU8*	getData() const		{ return mData;		}
+private:
+		PxDefaultMappedFileInputData(const PxDefaultMappedFileInputData&);
+		PxDefaultMappedFileInputData& operator=(const PxDefaultMappedFileInputData&);
+
+		PxU8*			mData;
+		PxU32			mLength;
+		PxU32			mPos;
+		bool			mValid;
+};
+
+/** 
+\brief memory-mapped file write stream
+
+Writes go straight into a page-aligned mapping of the output file. When the mapping is full the file is extended and
+remapped, which does not copy the data written so far, unlike the reallocations of PxDefaultMemoryOutputStream. The
+file is truncated to the number of bytes written when the stream is destroyed.
+
+\note getData() is invalidated by a write() that grows the mapping.
+
+On platforms without file mapping support the stream is never valid.
+
+@see PxOutputStream PxDefaultFileOutputStream
+*/
+
+class PxDefaultMappedFileOutputStream: public PxOutputStream
+{
+public:
+	/**
+	\param[in] name Name of the file to create. An existing file is overwritten.
+	\param[in] initialCapacity Initial size of the mapping in bytes. Passing the expected output size avoids any remapping.
+	*/
+						PxDefaultMappedFileOutputStream(const char* name, PxU32 initialCapacity = 1<<20);
+	virtual				~PxDefaultMappedFileOutputStream();
+
+	virtual		PxU32	write(const void* src, PxU32 count);
+
+				bool	isValid() const		{ return mData != NULL;	}
+				PxU32	getSize() const		{ return mSize;			}
+				PxU8*	getData() const		{ return mData;			}
+private:
+		PxDefaultMappedFileOutputStream(const PxDefaultMappedFileOutputStream&);
+		PxDefaultMappedFileOutputStream& operator=(const PxDefaultMappedFileOutputStream&);
+
+				bool	remap(PxU32 capacity);
+
+		PxU8*			mData;
+		PxU32			mSize;
+		PxU32			mCapacity;
+		size_t			mFile;		// platform file handle or descriptor
+};
+
 #if !PX_DOXYGEN
 }
 #endif
@@ -61,6 +61,13 @@
 #include "extensions/PxClothMeshQuadifier.h"
 #include "extensions/PxMassProperties.h"
 #include "extensions/PxSceneQueryExt.h"
+#include "extensions/PxHeightFieldTileManager.h"
+#include "extensions/PxSceneGroup.h"
+#include "extensions/PxFrameProfiler.h"
+#include "extensions/PxSceneStateDelta.h"
+#include "extensions/PxSharedMeshStore.h"
+#include "extensions/PxDefaultCookingCache.h"
+#include "extensions/PxImmediatePipeline.h"
 
 /** \brief Initialize the PhysXExtensions library. 
 
@@ -0,0 +1,111 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_FRAME_PROFILER_H
+#define PX_FRAME_PROFILER_H
+/** \addtogroup extensions
+@{
+*/
+
+#include "common/PxPhysXCommonConfig.h"
+#include "foundation/PxProfiler.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxOutputStream;
+	class FrameProfilerInternal;
+
+	/**
+	\brief A profiler callback recording the SDK profile zones into per-thread ring buffers.
+
+	Recording a zone only stores its name, a timestamp and the context id in a buffer owned by the calling thread, so the
+	profiler can be left enabled in production builds. The last recorded frames can be written at any time to a Chrome
+	trace (JSON) file, viewable in chrome://tracing or Perfetto.
+
+	Install it with PxSetProfilerCallback(). Profile zones are compiled in debug, checked and profile builds only.
+
+	\note beginFrame() and dumpChromeTrace() must be called from the same thread, typically the one calling
+	PxScene::fetchResults(). Events written while a dump is in progress may appear truncated in that dump.
+
+	@see PxProfilerCallback PxSetProfilerCallback
+	*/
+	class PxFrameProfiler : public PxProfilerCallback
+	{
+		public:
+			/**
+			\brief Creates the profiler.
+
+			\param[in] eventsPerThread	capacity of the ring buffer of each thread, rounded up to a power of two
+			\param[in] maxFrames		number of frame markers kept, i.e. the maximum number of frames that can be dumped
+			\param[in] maxThreads		maximum number of threads recorded. Events from further threads are dropped.
+			\param[in] forward			optional callback receiving all the zones as well, e.g. the previously installed one
+			*/
+									PxFrameProfiler(PxU32 eventsPerThread = 16384, PxU32 maxFrames = 64, PxU32 maxThreads = 64, PxProfilerCallback* forward = NULL);
+			virtual					~PxFrameProfiler();
+
+			/**
+			\brief Marks the start of a new frame. Call it once per frame, e.g. before PxScene::simulate().
+			*/
+					void			beginFrame();
+
+			/**
+			\brief Returns the number of frames marked since the profiler was created.
+			*/
+					PxU32			getNbFrames()	const;
+
+			/**
+			\brief Writes the events of the last frames as a Chrome trace.
+
+			\param[in] stream		destination stream, e.g. a PxDefaultFileOutputStream
+			\param[in] nbFrames		number of frames to write, clamped to maxFrames. 0 writes everything still in the buffers.
+			\return Number of events written.
+			*/
+					PxU32			dumpChromeTrace(PxOutputStream& stream, PxU32 nbFrames)	const;
+
+			// PxProfilerCallback
+			virtual	void*			zoneStart(const char* eventName, bool detached, uint64_t contextId);
+			virtual	void			zoneEnd(void* profilerData, const char* eventName, bool detached, uint64_t contextId);
+			//~PxProfilerCallback
+
+		private:
+			FrameProfilerInternal*	mImpl;
+
+									PxFrameProfiler(const PxFrameProfiler&);
+			PxFrameProfiler&		operator=(const PxFrameProfiler&);
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
@@ -0,0 +1,207 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_HEIGHT_FIELD_TILE_MANAGER_H
+#define PX_HEIGHT_FIELD_TILE_MANAGER_H
+/** \addtogroup extensions
+@{
+*/
+
+#include "common/PxPhysXCommonConfig.h"
+#include "foundation/PxTransform.h"
+#include "foundation/PxBounds3.h"
+#include "geometry/PxTriangleMeshGeometry.h"
+#include "PxShape.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxPhysics;
+	class PxScene;
+	class PxMaterial;
+	class PxHeightField;
+	class PxRigidStatic;
+	class HeightFieldTileManagerInternal;
+
+	/**
+	\brief User-provided source of height field tiles for PxHeightFieldTileManager.
+
+	@see PxHeightFieldTileManager
+	*/
+	class PxHeightFieldTileStream
+	{
+		public:
+			/**
+			\brief Called when a tile gets mapped.
+
+			The height field is typically read from disk with PxPhysics::createHeightField(PxInputStream&). It must have
+			PxHeightFieldTileManagerDesc::nbSampleRows rows and PxHeightFieldTileManagerDesc::nbSampleColumns columns, and
+			share its border samples with the neighbor tiles.
+
+			\param[in] tileRow		row index of the tile, in [0, PxHeightFieldTileManagerDesc::nbTileRows)
+			\param[in] tileColumn	column index of the tile, in [0, PxHeightFieldTileManagerDesc::nbTileColumns)
+			\return The tile's height field, or NULL to leave the tile unmapped. Unmapped tiles are requested again by the next update.
+			*/
+			virtual	PxHeightField*	loadTile(PxU32 tileRow, PxU32 tileColumn)	= 0;
+
+			/**
+			\brief Called when a tile gets unmapped, after its actor has been removed from the scene and released.
+
+			\param[in] tileRow		row index of the tile
+			\param[in] tileColumn	column index of the tile
+			\param[in] heightField	height field previously returned by loadTile() for this tile. Usually released here.
+			*/
+			virtual	void			unloadTile(PxU32 tileRow, PxU32 tileColumn, PxHeightField& heightField)	= 0;
+
+		protected:
+			virtual					~PxHeightFieldTileStream()	{}
+	};
+
+	/**
+	\brief Descriptor of a PxHeightFieldTileManager.
+
+	The terrain is a grid of nbTileRows*nbTileColumns tiles. Like the samples of a height field, tile rows are along the
+	local x axis and tile columns along the local z axis. Tile (0,0) starts at the origin of the local frame, and each tile
+	covers (nbSampleRows-1)*rowScale along x and (nbSampleColumns-1)*columnScale along z.
+
+	@see PxHeightFieldTileManager PxHeightFieldGeometry
+	*/
+	struct PxHeightFieldTileManagerDesc
+	{
+		PxTransform			pose;				//!< Pose of the whole grid of tiles in world space
+		PxU32				nbTileRows;			//!< Number of tiles along the local x axis
+		PxU32				nbTileColumns;		//!< Number of tiles along the local z axis
+		PxU32				nbSampleRows;		//!< Number of sample rows of each tile's height field
+		PxU32				nbSampleColumns;	//!< Number of sample columns of each tile's height field
+		PxReal				heightScale;		//!< PxHeightFieldGeometry::heightScale of all the tiles
+		PxReal				rowScale;			//!< PxHeightFieldGeometry::rowScale of all the tiles
+		PxReal				columnScale;		//!< PxHeightFieldGeometry::columnScale of all the tiles
+		PxMeshGeometryFlags	heightFieldFlags;	//!< PxHeightFieldGeometry::heightFieldFlags of all the tiles
+		PxMaterial*			material;			//!< Material of the tiles' shapes
+		PxShapeFlags		shapeFlags;			//!< Flags of the tiles' shapes
+		PxReal				margin;				//!< Distance by which the active regions are inflated before selecting the tiles to map
+
+		PxHeightFieldTileManagerDesc() :
+			pose			(PxIdentity),
+			nbTileRows		(0),
+			nbTileColumns	(0),
+			nbSampleRows	(0),
+			nbSampleColumns	(0),
+			heightScale		(1.0f),
+			rowScale		(1.0f),
+			columnScale		(1.0f),
+			material		(NULL),
+			shapeFlags		(PxShapeFlag::eVISUALIZATION | PxShapeFlag::eSCENE_QUERY_SHAPE | PxShapeFlag::eSIMULATION_SHAPE),
+			margin			(0.0f)
+		{
+		}
+
+		/**
+		\brief Returns true if the descriptor is valid.
+		*/
+		PX_INLINE bool isValid() const
+		{
+			if(!pose.isValid())
+				return false;
+			if(!nbTileRows || !nbTileColumns)
+				return false;
+			if(nbSampleRows < 2 || nbSampleColumns < 2)
+				return false;
+			if(!(heightScale > 0.0f) || !(rowScale > 0.0f) || !(columnScale > 0.0f))
+				return false;
+			if(!material)
+				return false;
+			if(!(margin >= 0.0f))
+				return false;
+			return true;
+		}
+	};
+
+	/**
+	\brief Streams the tiles of a large height field terrain in and out of a scene.
+
+	Only the tiles overlapping active regions of the world are mapped: each mapped tile is a static actor with a single
+	height field shape, added to the scene. Memory thus scales with the active area rather than with the whole terrain.
+	The height fields are provided and released by a user PxHeightFieldTileStream.
+
+	The manager does not lock the scene. update(), updateFromScene() and the destructor must be called when the scene can
+	be written to, i.e. not between simulate() and fetchResults().
+
+	@see PxHeightFieldTileStream PxHeightFieldTileManagerDesc
+	*/
+	class PxHeightFieldTileManager
+	{
+		public:
+							PxHeightFieldTileManager(PxPhysics& physics, PxScene& scene, const PxHeightFieldTileManagerDesc& desc, PxHeightFieldTileStream& stream);
+
+			/**
+			\brief Unmaps all the tiles.
+			*/
+							~PxHeightFieldTileManager();
+
+			/**
+			\brief Maps the tiles overlapping the given regions, and unmaps the other tiles.
+
+			\param[in] regions		world-space bounds of the active regions. They are inflated by PxHeightFieldTileManagerDesc::margin.
+			\param[in] nbRegions	number of regions
+			*/
+			void			update(const PxBounds3* regions, PxU32 nbRegions);
+
+			/**
+			\brief Maps the tiles under the rigid dynamic actors of the scene, and unmaps the other tiles.
+
+			Sleeping actors count as active, so the terrain under them does not vanish.
+			*/
+			void			updateFromScene();
+
+			/**
+			\brief Returns the number of currently mapped tiles.
+			*/
+			PxU32			getNbMappedTiles()	const;
+
+			/**
+			\brief Returns the actor of a tile, or NULL if the tile is not mapped.
+			*/
+			PxRigidStatic*	getTileActor(PxU32 tileRow, PxU32 tileColumn)	const;
+
+		private:
+			HeightFieldTileManagerInternal*	mImpl;
+
+							PxHeightFieldTileManager(const PxHeightFieldTileManager&);
+			PxHeightFieldTileManager&	operator=(const PxHeightFieldTileManager&);
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
@@ -0,0 +1,162 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#ifndef PX_IMMEDIATE_PIPELINE_H
+#define PX_IMMEDIATE_PIPELINE_H
+/** \addtogroup extensions
+@{
+*/
+
+#include "PxImmediateMode.h"
+#include "common/PxTolerancesScale.h"
+#include "geometry/PxGeometryHelpers.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxCpuDispatcher;
+	class ImmediatePipelineInternal;
+
+	/**
+	\brief A body simulated by a PxImmediatePipeline.
+
+	Bodies with a zero inverse mass are static: they collide with the dynamic bodies but are never moved.
+
+	@see PxImmediatePipeline::simulate()
+	*/
+	struct PxImmediatePipelineBody
+	{
+		immediate::PxRigidBodyData	rigidData;			//!< State of the body. The pose and velocities of dynamic bodies are updated by each step.
+		PxGeometryHolder			geometry;			//!< Collision geometry, posed at rigidData.body2World
+		PxReal						staticFriction;		//!< Averaged with the other body of each contact
+		PxReal						dynamicFriction;	//!< Averaged with the other body of each contact
+		PxReal						restitution;		//!< Averaged with the other body of each contact
+	};
+
+	/**
+	\brief Settings of a PxImmediatePipeline. The distances and velocities are in simulation units, see PxTolerancesScale.
+	*/
+	struct PxImmediatePipelineDesc
+	{
+		PxCpuDispatcher*	cpuDispatcher;				//!< Worker threads used by the pipeline. NULL runs everything on the calling thread.
+		PxVec3				gravity;					//!< Gravity applied to the dynamic bodies
+		PxReal				contactDistance;			//!< Distance at which contacts start to be generated, also used to inflate the bounds
+		PxReal				meshContactMargin;			//!< See immediate::PxGenerateContacts
+		PxReal				toleranceLength;			//!< See immediate::PxGenerateContacts
+		PxReal				bounceThreshold;			//!< See immediate::PxCreateContactConstraints. Negative: approach velocities above its magnitude bounce.
+		PxReal				frictionOffsetThreshold;	//!< See immediate::PxCreateContactConstraints
+		PxReal				correlationDistance;		//!< See immediate::PxCreateContactConstraints
+		PxU32				nbPositionIterations;		//!< Position iterations of each island solve
+		PxU32				nbVelocityIterations;		//!< Velocity iterations of each island solve
+
+		PX_INLINE PxImmediatePipelineDesc(const PxTolerancesScale& scale) :
+			cpuDispatcher			(NULL),
+			gravity					(PxVec3(0.0f)),
+			contactDistance			(0.04f * scale.length),
+			meshContactMargin		(0.01f * scale.length),
+			toleranceLength			(scale.length),
+			bounceThreshold			(-0.2f * scale.speed),
+			frictionOffsetThreshold	(0.04f * scale.length),
+			correlationDistance		(0.025f * scale.length),
+			nbPositionIterations	(4),
+			nbVelocityIterations	(1)
+		{
+		}
+
+		PX_INLINE bool isValid() const
+		{
+			return gravity.isFinite() && contactDistance >= 0.0f && meshContactMargin >= 0.0f && toleranceLength > 0.0f && bounceThreshold < 0.0f &&
+				frictionOffsetThreshold > 0.0f && correlationDistance > 0.0f && nbPositionIterations >= 1 && nbVelocityIterations >= 1;
+		}
+	};
+
+	/**
+	\brief A ready-made immediate mode pipeline spreading the simulation of a set of bodies over worker threads.
+
+	Each step runs the following phases, each of them in parallel on the CPU dispatcher of the descriptor:
+	\li the world bounds of the bodies are computed and swept along the X axis to find the overlapping pairs
+	\li contacts are generated for the overlapping pairs with immediate::PxGenerateContacts
+	\li the dynamic bodies are split into islands, i.e. groups of bodies connected by contacts
+	\li each island is batched, has its contact constraints created, and is solved and integrated on its own
+
+	The contact caches and friction patches are kept from one step to the next. They are associated with the bodies by index,
+	so call resetCaches() after reordering, inserting or removing bodies. The results do not depend on the number of threads.
+
+	Joints, kinematic bodies and sleeping are not supported. Use the immediate mode functions directly for those.
+
+	\note simulate() must not be called from one of the worker threads of the CPU dispatcher, since it waits for them.
+
+	@see PxImmediatePipelineDesc PxImmediatePipelineBody
+	*/
+	class PxImmediatePipeline
+	{
+		public:
+								PxImmediatePipeline(const PxImmediatePipelineDesc& desc);
+								~PxImmediatePipeline();
+
+			/**
+			\brief Advances the bodies by one step.
+
+			\param[in,out] bodies	bodies to simulate. The poses and velocities of the dynamic ones are updated.
+			\param[in] nbBodies		number of bodies
+			\param[in] dt			step size
+			*/
+			void				simulate(PxImmediatePipelineBody* bodies, PxU32 nbBodies, PxReal dt);
+
+			/**
+			\brief Discards the contact caches and friction patches of all the pairs.
+			*/
+			void				resetCaches();
+
+			/**
+			\brief Returns the number of pairs that had contacts in the last step.
+			*/
+			PxU32				getNbTouchingPairs()	const;
+
+			/**
+			\brief Returns the number of islands solved in the last step, including the isolated dynamic bodies.
+			*/
+			PxU32				getNbIslands()			const;
+
+		private:
+			ImmediatePipelineInternal*	mImpl;
+
+								PxImmediatePipeline(const PxImmediatePipeline&);
+			PxImmediatePipeline&	operator=(const PxImmediatePipeline&);
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
@@ -44,6 +44,7 @@ namespace physx
 	class PxScene;
 	class PxShape;
 	class PxRigidDynamic;
+	class PxCpuDispatcher;
 	class RaycastCCDManagerInternal;
 
 	/**
@@ -84,10 +85,38 @@ namespace physx
 			/**
 			\brief Perform raycast CCD. Call this after your simulate/fetchResults calls.
 
+			The raycasts of all registered objects are executed as one batch, against the poses from the end of the simulation step.
+			A correction does not affect the dynamic-vs-dynamic raycasts of the other objects.
+
 			\param[in] doDynamicDynamicCCD	True to enable dynamic-vs-dynamic CCD (more expensive, not always needed)
 			*/
 			void	doRaycastCCD(bool doDynamicDynamicCCD);
 
+			/**
+			\brief Start raycast CCD on the given dispatcher's worker threads. Call this after your simulate/fetchResults calls.
+
+			The raycasts of all registered objects are executed as one parallel batch. Their results are applied by endRaycastCCD(),
+			with a single bulk update of the corrected poses, so that other user code can run in between.
+
+			\note The scene must not be modified between beginRaycastCCD() and endRaycastCCD(). If the scene uses
+			PxSceneFlag::eREQUIRE_RW_LOCK, the read lock must be held from beginRaycastCCD() until endRaycastCCD() starts.
+
+			\param[in] doDynamicDynamicCCD	True to enable dynamic-vs-dynamic CCD (more expensive, not always needed)
+			\param[in] dispatcher			Dispatcher running the raycasts
+
+			\return False if the raycasts could not be started (e.g. a previous batch has not been ended). No CCD is performed in that case.
+
+			@see endRaycastCCD
+			*/
+			bool	beginRaycastCCD(bool doDynamicDynamicCCD, PxCpuDispatcher& dispatcher);
+
+			/**
+			\brief Wait for the raycasts started by beginRaycastCCD() and correct the poses of the objects that went through something.
+
+			@see beginRaycastCCD
+			*/
+			void	endRaycastCCD();
+
 		private:
 			RaycastCCDManagerInternal*	mImpl;
 	};
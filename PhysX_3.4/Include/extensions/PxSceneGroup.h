@@ -0,0 +1,125 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_SCENE_GROUP_H
+#define PX_SCENE_GROUP_H
+/** \addtogroup extensions
+@{
+*/
+
+#include "common/PxPhysXCommonConfig.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxScene;
+	class SceneGroupInternal;
+
+	/**
+	\brief Timings of a scene stepped by a PxSceneGroup, in seconds.
+
+	@see PxSceneGroup::getTiming()
+	*/
+	struct PxSceneGroupTiming
+	{
+		PxReal	lastStepTime;		//!< Time from the start of the last simulate() call to the results being available
+		PxReal	averageStepTime;	//!< Exponential moving average of lastStepTime, used to order the scenes
+		PxReal	lastFetchTime;		//!< Time spent in the last fetchResults() call of the scene, including its callbacks
+		PxU32	nbSteps;			//!< Number of steps done since the scene was added to the group
+	};
+
+	/**
+	\brief Steps several independent scenes together.
+
+	The scenes are typically built with the same CPU dispatcher. simulate() starts all of them before any of them is
+	fetched, so their task graphs interleave on the worker threads instead of running one after the other. The scenes with
+	the largest average step time are started first: their tasks get queued first, which shortens the longest critical path
+	of the group. fetchResults() fetches the scenes in the order in which they complete.
+
+	The group does not lock the scenes. Scenes must not be simulated outside the group while they are part of it.
+
+	@see PxSceneGroupTiming
+	*/
+	class PxSceneGroup
+	{
+		public:
+							PxSceneGroup();
+							~PxSceneGroup();
+
+			/**
+			\brief Adds a scene to the group.
+
+			\return False if the scene is already part of the group.
+			*/
+			bool			addScene(PxScene& scene);
+
+			/**
+			\brief Removes a scene from the group. Must not be called between simulate() and fetchResults().
+			*/
+			void			removeScene(PxScene& scene);
+
+			/**
+			\brief Returns the number of scenes in the group.
+			*/
+			PxU32			getNbScenes()	const;
+
+			/**
+			\brief Calls PxScene::simulate() on all the scenes, slowest scenes first.
+
+			\param[in] elapsedTime	step size passed to all the scenes
+			*/
+			void			simulate(PxReal elapsedTime);
+
+			/**
+			\brief Calls PxScene::fetchResults() on all the scenes as they complete, and returns when all of them are fetched.
+			*/
+			void			fetchResults();
+
+			/**
+			\brief Returns the timings of a scene of the group.
+
+			\return False if the scene is not part of the group.
+			*/
+			bool			getTiming(const PxScene& scene, PxSceneGroupTiming& timing)	const;
+
+		private:
+			SceneGroupInternal*	mImpl;
+
+							PxSceneGroup(const PxSceneGroup&);
+			PxSceneGroup&	operator=(const PxSceneGroup&);
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
@@ -329,6 +329,39 @@ public:
 							const PxSceneQueryFilterData& filterData = PxSceneQueryFilterData(),
 							PxSceneQueryFilterCallback* filterCall = NULL,
 							PX_DEPRECATED PxClientID queryClient = PX_DEFAULT_CLIENT);
+
+	/**
+	\brief Computes the translation that moves a geometry out of all the objects it overlaps in the scene.
+
+	The overlapping shapes are found with a single overlap query at the initial pose. The penetration with each of them is
+	computed while the query traverses the scene, and the geometry is moved out of each shape in turn. Further iterations
+	then go over the shapes found by the query, without traversing the scene again, until the geometry no longer penetrates
+	any of them or maxIter iterations have been done. Shapes that only start to overlap once the geometry has moved are
+	ignored.
+
+	This is equivalent to calling PxGeometryQuery::computePenetration() for each hit of an overlap query, as the character
+	controller's overlap recovery does, but without a hit buffer.
+
+	\note Filtering: Overlap tests do not distinguish between touching and blocking hit types. All hits are used.
+
+	\param[in] scene			The scene
+	\param[in] geometry			Geometry of the object to depenetrate (supported types are: box, sphere, capsule, convex).
+	\param[in] pose				Pose of the object.
+	\param[out] direction		Unit direction of the total translation.
+	\param[out] depth			Length of the total translation.
+	\param[in] filterData		Filtering data and simple logic.
+	\param[in] filterCall		Custom filtering logic (optional). Only used if the corresponding #PxHitFlag flags are set. If NULL, all hits are assumed to overlap.
+	\param[in] maxIter			Maximum number of iterations over the overlapping shapes.
+	\return True if the object penetrated at least one shape, in which case direction and depth are valid.
+
+	@see PxGeometryQuery::computePenetration PxSceneQueryFilterData PxSceneQueryFilterCallback
+	*/
+	static bool	computeDepenetration(	const PxScene& scene,
+										const PxGeometry& geometry, const PxTransform& pose,
+										PxVec3& direction, PxReal& depth,
+										const PxSceneQueryFilterData& filterData = PxSceneQueryFilterData(),
+										PxSceneQueryFilterCallback* filterCall = NULL,
+										PxU32 maxIter = 4);
 };
 
 #if !PX_DOXYGEN
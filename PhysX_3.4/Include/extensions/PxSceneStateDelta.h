@@ -0,0 +1,257 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#ifndef PX_SCENE_STATE_DELTA_H
+#define PX_SCENE_STATE_DELTA_H
+/** \addtogroup extensions
+@{
+*/
+
+#include "common/PxPhysXCommonConfig.h"
+#include "foundation/PxTransform.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxScene;
+	class PxRigidDynamic;
+	class PxInputStream;
+	class PxOutputStream;
+	class SceneStateEncoderInternal;
+	class SceneStateDecoderInternal;
+
+	/**
+	\brief Quantization settings of a scene state stream.
+
+	Quantized values are stored as integer multiples of a step, lossless values as the raw floats. The decoder reads the
+	settings from each frame, so encoders with different settings can feed the same decoder.
+
+	@see PxSceneStateEncoder
+	*/
+	struct PxSceneStateQuantization
+	{
+		PxReal	positionStep;	//!< Step of positions and kinematic target positions, 0 to store them losslessly
+		PxReal	velocityStep;	//!< Step of linear and angular velocity components, 0 to store them losslessly
+		PxU32	rotationBits;	//!< Bits per stored quaternion component (smallest three encoding), in [4,20]. 0 to store rotations losslessly
+
+		PxSceneStateQuantization() : positionStep(0.0f), velocityStep(0.0f), rotationBits(0)	{}
+
+		/**
+		\brief Returns true if the settings are valid.
+		*/
+		PX_INLINE bool isValid() const
+		{
+			if(!(positionStep >= 0.0f) || !(velocityStep >= 0.0f))
+				return false;
+			if(rotationBits && (rotationBits < 4 || rotationBits > 20))
+				return false;
+			return true;
+		}
+	};
+
+	/**
+	\brief State of a rigid dynamic actor, as encoded in a scene state stream.
+	*/
+	struct PxRigidDynamicState
+	{
+		struct Flag
+		{
+			enum Enum
+			{
+				eSLEEPING				= (1<<0),	//!< The actor is asleep
+				eKINEMATIC				= (1<<1),	//!< The actor is kinematic
+				eHAS_KINEMATIC_TARGET	= (1<<2)	//!< The actor is kinematic and kinematicTarget is valid
+			};
+		};
+
+		PxU32		id;					//!< User id given to PxSceneStateEncoder::addActor
+		PxU32		flags;				//!< Combination of PxRigidDynamicState::Flag values
+		PxTransform	pose;				//!< Global pose
+		PxVec3		linearVelocity;		//!< Linear velocity, zero for kinematic actors
+		PxVec3		angularVelocity;	//!< Angular velocity, zero for kinematic actors
+		PxTransform	kinematicTarget;	//!< Kinematic target, valid with eHAS_KINEMATIC_TARGET only
+	};
+
+	/**
+	\brief Writes the state of a set of rigid dynamic actors as keyframes followed by compact delta frames.
+
+	A keyframe holds the full state of all the tracked actors. A delta frame only holds the fields that differ from the
+	last keyframe, fields being compared after quantization, so a delta frame can be decoded with its keyframe alone: a
+	replay can seek to any frame by reading its keyframe then the frame itself, and a server can send deltas against the
+	last keyframe a client acknowledged. Actors added or removed since the keyframe are recorded in the delta frames.
+
+	Reading the state of an actor from the SDK costs much more than comparing it, so writeDelta() can skip the actors the
+	simulation did not change: with a scene using PxSceneFlag::eENABLE_ACTIVE_ACTORS, only the active actors of the last
+	simulation step, and the actors reported with markDirty(), are read again. The others keep the state they had when
+	they were last read. Changes made through the API outside of the simulation (setGlobalPose(), setLinearVelocity(),
+	putToSleep() etc.) must then be reported with markDirty().
+
+	The encoder does not lock the scene. writeKeyframe() and writeDelta() read the actors, so they must not be called
+	between simulate() and fetchResults().
+
+	@see PxSceneStateDecoder PxSceneStateQuantization
+	*/
+	class PxSceneStateEncoder
+	{
+		public:
+							PxSceneStateEncoder(const PxSceneStateQuantization& quantization = PxSceneStateQuantization());
+							~PxSceneStateEncoder();
+
+			/**
+			\brief Starts tracking an actor. It is written as added in the delta frames until the next keyframe.
+
+			\param[in] actor	actor to track. It must be removed from the encoder before being released.
+			\param[in] id		user id identifying the actor in the stream, unique in this encoder
+			\return False if the actor or the id is already tracked
+			*/
+			bool			addActor(PxRigidDynamic& actor, PxU32 id);
+
+			/**
+			\brief Stops tracking an actor. It is written as removed in the delta frames until the next keyframe.
+
+			\return False if the actor is not tracked
+			*/
+			bool			removeActor(PxRigidDynamic& actor);
+
+			/**
+			\brief Reports an actor changed outside of the simulation, see the class description.
+			*/
+			void			markDirty(PxRigidDynamic& actor);
+
+			/**
+			\brief Returns the number of tracked actors.
+			*/
+			PxU32			getNbActors()	const;
+
+			/**
+			\brief Writes the full state of all the tracked actors, which becomes the reference of the following delta frames.
+
+			\param[in] stream	destination stream
+			\return Number of bytes written
+			*/
+			PxU32			writeKeyframe(PxOutputStream& stream);
+
+			/**
+			\brief Writes the fields that differ from the last keyframe.
+
+			writeKeyframe() must have been called once before.
+
+			\param[in] stream	destination stream
+			\param[in] scene	scene the actors belong to. If it uses PxSceneFlag::eENABLE_ACTIVE_ACTORS, only the active
+								actors and the dirty ones are read again. NULL reads all the actors.
+			\return Number of bytes written
+			*/
+			PxU32			writeDelta(PxOutputStream& stream, PxScene* scene = NULL);
+
+			/**
+			\brief Returns the number of frames written so far. Frame indices start at 0.
+			*/
+			PxU32			getNbFrames()	const;
+
+		private:
+			SceneStateEncoderInternal*	mImpl;
+
+							PxSceneStateEncoder(const PxSceneStateEncoder&);
+			PxSceneStateEncoder&	operator=(const PxSceneStateEncoder&);
+	};
+
+	/**
+	\brief Reads the frames written by a PxSceneStateEncoder.
+
+	After reading a frame, getStates() returns the state of all the actors present at that frame, sorted by id. A delta
+	frame can only be read after its keyframe, which the decoder keeps until the next keyframe is read.
+
+	@see PxSceneStateEncoder
+	*/
+	class PxSceneStateDecoder
+	{
+		public:
+							PxSceneStateDecoder();
+							~PxSceneStateDecoder();
+
+			/**
+			\brief Reads one frame.
+
+			\return False if the stream is truncated or invalid, or for a delta frame whose keyframe was not the last one read.
+			The last successfully read state is then left unchanged.
+			*/
+			bool			readFrame(PxInputStream& stream);
+
+			/**
+			\brief Returns true if the last frame read is a keyframe.
+			*/
+			bool			isKeyframe()	const;
+
+			/**
+			\brief Returns the index of the last frame read.
+			*/
+			PxU32			getFrameIndex()	const;
+
+			/**
+			\brief Returns the index of the keyframe of the last frame read.
+			*/
+			PxU32			getKeyframeIndex()	const;
+
+			/**
+			\brief Returns the number of actors present at the last frame read.
+			*/
+			PxU32			getNbStates()	const;
+
+			/**
+			\brief Returns the states of the actors present at the last frame read, sorted by id.
+			*/
+			const PxRigidDynamicState*	getStates()	const;
+
+			/**
+			\brief Returns the state of an actor at the last frame read, or NULL if it was not present.
+			*/
+			const PxRigidDynamicState*	findState(PxU32 id)	const;
+
+			/**
+			\brief Applies a decoded state to an actor.
+
+			Kinematic actors get their pose set, then their kinematic target if they have one. Other actors get their pose,
+			velocities and sleep state set. The kinematic flag of the actor itself is not changed.
+			*/
+			static	void	applyState(PxRigidDynamic& actor, const PxRigidDynamicState& state);
+
+		private:
+			SceneStateDecoderInternal*	mImpl;
+
+							PxSceneStateDecoder(const PxSceneStateDecoder&);
+			PxSceneStateDecoder&	operator=(const PxSceneStateDecoder&);
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
@@ -49,13 +49,15 @@
 /**
 PX_BINARY_SERIAL_VERSION is used to specify the binary data format compatibility additionally to the physics sdk version. 
 The binary format version is defined as "PX_PHYSICS_VERSION_MAJOR.PX_PHYSICS_VERSION_MINOR.PX_PHYSICS_VERSION_BUGFIX-PX_BINARY_SERIAL_VERSION".
-The following binary format versions are compatible with the current physics version:
-  (no compatible versions)
+No other binary format versions are compatible with the current physics version. Version 1 added the object layout table
+(see PxSerialization::createCollectionFromBinary), version 2 changed the triangle mesh layout for compressed meshes
+(see PxMeshPreprocessingFlag::eCOMPRESS_MESH_DATA), version 3 added the SoA support vertices pointer to the convex hull data, version 4 added the cached mesh-scaled local bounds to the
+shape core.
 
 The PX_BINARY_SERIAL_VERSION for a given PhysX release is typically 0. If incompatible modifications are made to a customer specific branch the
 number should be increased.
 */
-#define PX_BINARY_SERIAL_VERSION 0
+#define PX_BINARY_SERIAL_VERSION 4
 
 
 #if !PX_DOXYGEN
@@ -63,6 +65,67 @@ namespace physx
 {
 #endif
 
+class PxCpuDispatcher;
+
+/**
+\brief Loads a binary serialized collection from a stream in steps.
+
+The serialized data is read straight into an application provided memory block, which is used for the deserialized objects
+as by PxSerialization::createCollectionFromBinary(), and the objects are created a few at a time. This lets applications stream 
+in collections over several frames, without a file buffer next to the collection memory.
+
+@see PxSerialization::createBinaryCollectionLoader
+*/
+class PxBinaryCollectionLoader
+{
+public:
+	struct Status
+	{
+		enum Enum
+		{
+			eREADING,			//!< Reading the serialized data from the stream
+			eCREATING_OBJECTS,	//!< Creating the objects of the collection
+			eDONE,				//!< The collection is complete and its objects are added to the physics, see getCollection()
+			eFAILED				//!< The stream ended early or the data is invalid. An error was reported.
+		};
+	};
+
+	/**
+	\brief Advances the load.
+
+	Reads up to maxBytes bytes from the stream, then, once all the data is read, creates up to maxObjects objects.
+
+	\param[in] maxBytes Maximum number of bytes to read during the call.
+	\param[in] maxObjects Maximum number of objects to create during the call.
+	\return The status after the call.
+	*/
+	virtual	Status::Enum	update(PxU32 maxBytes, PxU32 maxObjects) = 0;
+
+	/**
+	\brief Returns the status of the load.
+	*/
+	virtual	Status::Enum	getStatus() const = 0;
+
+	/**
+	\brief Returns the loaded collection once the status is eDONE, NULL before.
+
+	The application takes ownership of the collection, and releases it as any collection created by 
+	PxSerialization::createCollectionFromBinary(). The loader returns NULL on subsequent calls.
+	*/
+	virtual	PxCollection*	getCollection() = 0;
+
+	/**
+	\brief Releases the loader.
+
+	Releasing the loader while it creates the objects abandons the load: the remaining objects are created and all of them are
+	released, to drop their references to objects of other collections. This is done during the call.
+	*/
+	virtual	void			release() = 0;
+
+protected:
+	virtual					~PxBinaryCollectionLoader() {}
+};
+
 /**
 \brief Utility functions for serialization
 
@@ -196,6 +259,51 @@ public:
 	*/
 	static	PxCollection*	createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* externalRefs = NULL);
 
+	/**
+	\brief Deserializes a PxCollection from memory, creating the objects in parallel.
+
+	Same as createCollectionFromBinary() above, except that the objects are created and their references resolved by tasks 
+	submitted to the dispatcher. The calling thread takes part in the work and blocks until it is done, so it must not be  
+	one of the dispatcher's worker threads.
+
+	serializeCollectionToBinary() stores the extra data offset of each object and its depth in the graph of required objects
+	(see PxSerializer::requiresObjects). Objects of the same depth are created concurrently, after all the objects they require.
+	PxSerializer::createObject may therefore only modify other objects through thread safe operations, such as reference
+	counts, unless it is the sole object requiring them.
+
+	The objects are created serially, as by the overload above, when the binary data has no object layout table (data converted 
+	with PxBinaryConverter, which drops the table), or when the collection has external references:
+	the creation of an object can update the external objects it references, e.g. joints register with actors of another 
+	collection.
+
+	\param[in] memBlock Pointer to memory block containing the serialized collection
+	\param[in] sr PxSerializationRegistry instance with information about registered classes.
+	\param[in] dispatcher CPU dispatcher running the deserialization tasks.
+	\param[in] externalRefs Collection to resolve external dependencies
+
+	@see createCollectionFromBinary, PxSerializer::createObject, PxCpuDispatcher
+	*/
+	static	PxCollection*	createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, PxCpuDispatcher& dispatcher, const PxCollection* externalRefs = NULL);
+
+	/**
+	\brief Creates a loader deserializing a PxCollection from a stream in steps.
+
+	The stream must provide the data written by serializeCollectionToBinary(). The size of that data is not serialized, so 
+	applications storing several collections in a stream are expected to record the size of each one, e.g. from the position
+	of their output stream. The loader reads exactly that many bytes.
+
+	\param[in] stream Stream providing the serialized collection. It must stay valid until the loader is done reading it.
+	\param[in] size Size in bytes of the serialized collection.
+	\param[in] memBlock 128 bytes aligned memory block of at least size bytes, receiving the serialized data. As with 
+	createCollectionFromBinary(), it holds the deserialized objects and must remain valid until they are all released.
+	\param[in] sr PxSerializationRegistry instance with information about registered classes.
+	\param[in] externalRefs Collection to resolve external dependencies. It must stay valid until the load is done.
+	\return The loader, or NULL if the memory block is not aligned.
+
+	@see PxBinaryCollectionLoader, createCollectionFromBinary
+	*/
+	static	PxBinaryCollectionLoader*	createBinaryCollectionLoader(PxInputStream& stream, PxU32 size, void* memBlock, PxSerializationRegistry& sr, const PxCollection* externalRefs = NULL);
+
 	/**
 	\brief Serializes a physics collection to an XML output stream.
 
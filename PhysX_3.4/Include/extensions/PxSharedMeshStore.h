@@ -0,0 +1,185 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#ifndef PX_SHARED_MESH_STORE_H
+#define PX_SHARED_MESH_STORE_H
+/** \addtogroup extensions
+@{
+*/
+
+#include "common/PxPhysXCommonConfig.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxPhysics;
+	class PxTriangleMesh;
+	class PxConvexMesh;
+	class PxHeightField;
+	class SharedMeshStoreInternal;
+
+	/**
+	\brief Kind of cooked data held by an entry of a PxSharedMeshStore.
+	*/
+	struct PxSharedMeshType
+	{
+		enum Enum
+		{
+			eTRIANGLE_MESH,	//!< Data written by PxCooking::cookTriangleMesh()
+			eCONVEX_MESH,	//!< Data written by PxCooking::cookConvexMesh()
+			eHEIGHTFIELD	//!< Data written by PxCooking::cookHeightField()
+		};
+	};
+
+	/**
+	\brief A named cooked mesh of a PxSharedMeshStore.
+
+	@see PxSharedMeshStore
+	*/
+	struct PxSharedMeshStoreEntry
+	{
+		const char*				name;		//!< Unique name of the mesh, at most PxSharedMeshStore::eMAX_NAME_LENGTH characters
+		PxSharedMeshType::Enum	type;		//!< Kind of cooked data
+		const void*				data;		//!< Cooked data
+		PxU32					size;		//!< Size of the cooked data in bytes
+
+		PxSharedMeshStoreEntry() : name(NULL), type(PxSharedMeshType::eTRIANGLE_MESH), data(NULL), size(0)	{}
+	};
+
+	/**
+	\brief Cooked meshes stored in a named shared-memory region, shared read-only by several processes.
+
+	One process publishes the region, copying the cooked data of all its entries into it once. Any number of processes
+	on the same host then open the region by name and map it read-only, so the operating system keeps a single physical
+	copy of the data.
+
+	Triangle meshes are created with PxPhysics::createTriangleMeshInPlace(): their arrays reference the mapped region
+	directly and cost no private memory beyond the mesh object. Convex meshes and height fields are loaded from the
+	region with the regular creation functions, which copy the data into each process.
+
+	Meshes created from a store reference its memory: the store must outlive them, in every process.
+
+	The region is removed from the system namespace when the publishing store is destroyed. Processes which already opened
+	it keep their mapping, but it cannot be opened anymore. Shared memory is supported on Windows and on Unix platforms; on
+	other platforms publishing and opening fail.
+
+	@see PxSharedMeshStoreEntry PxPhysics::createTriangleMeshInPlace()
+	*/
+	class PxSharedMeshStore
+	{
+		public:
+			enum
+			{
+				eMAX_NAME_LENGTH	= 63
+			};
+
+			/**
+			\brief Creates the shared-memory region and copies the cooked data of the entries into it.
+
+			Fails if a region with that name already exists, or if two entries have the same name.
+
+			\param[in] regionName	name of the region in the system namespace, e.g. "/level0_meshes"
+			\param[in] entries		meshes to publish. The data is copied, it can be released after the call.
+			\param[in] nbEntries	number of entries
+			*/
+							PxSharedMeshStore(const char* regionName, const PxSharedMeshStoreEntry* entries, PxU32 nbEntries);
+
+			/**
+			\brief Opens a region published by another store, and maps it read-only.
+
+			Fails if the region does not exist, or is not completely written yet.
+
+			\param[in] regionName	name the region has been published with
+			*/
+			explicit		PxSharedMeshStore(const char* regionName);
+
+			/**
+			\brief Unmaps the region. Meshes created from the store must have been released.
+			*/
+							~PxSharedMeshStore();
+
+			/**
+			\brief Returns true if the region was successfully published or opened.
+			*/
+			bool			isValid()	const;
+
+			/**
+			\brief Returns the number of entries. 0 if the store is not valid.
+			*/
+			PxU32			getNbEntries()	const;
+
+			/**
+			\brief Returns an entry. The name and data point into the mapped region.
+
+			\param[in] index	entry index, in [0, getNbEntries())
+			\param[out] entry	the entry
+			\return False if the index is out of range.
+			*/
+			bool			getEntry(PxU32 index, PxSharedMeshStoreEntry& entry)	const;
+
+			/**
+			\brief Returns the index of the entry with the given name, or 0xffffffff if there is none.
+			*/
+			PxU32			findEntry(const char* name)	const;
+
+			/**
+			\brief Creates a triangle mesh that references the region in place.
+
+			\return The new mesh, or NULL if there is no triangle mesh entry with that name.
+			*/
+			PxTriangleMesh*	createTriangleMesh(PxPhysics& physics, const char* name)	const;
+
+			/**
+			\brief Creates a convex mesh from the region. The data is copied.
+
+			\return The new mesh, or NULL if there is no convex mesh entry with that name.
+			*/
+			PxConvexMesh*	createConvexMesh(PxPhysics& physics, const char* name)	const;
+
+			/**
+			\brief Creates a height field from the region. The data is copied.
+
+			\return The new height field, or NULL if there is no height field entry with that name.
+			*/
+			PxHeightField*	createHeightField(PxPhysics& physics, const char* name)	const;
+
+		private:
+			SharedMeshStoreInternal*	mImpl;
+
+							PxSharedMeshStore(const PxSharedMeshStore&);
+			PxSharedMeshStore&	operator=(const PxSharedMeshStore&);
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
@@ -177,6 +177,115 @@ public:
 											const PxGeometry& geom0, const PxTransform& pose0,
 											const PxGeometry& geom1, const PxTransform& pose1);
 
+	/**
+	\brief Batched sweep of one geometry object from several poses against a given object.
+
+	Equivalent to calling #sweep for each entry of poses0, but the dispatch and the shape setup of both geometries are done once for the whole batch.
+	The supported combinations are the same as for #sweep.
+
+	\param[in] unitDir Normalized direction along which object geom0 should be swept
+	\param[in] maxDist Maximum sweep distance, has to be in the [0, inf) range
+	\param[in] geom0 The geometry object to sweep. Supported geometries are #PxSphereGeometry, #PxCapsuleGeometry, #PxBoxGeometry and #PxConvexMeshGeometry
+	\param[in] poses0 Array of start poses of the geometry object to sweep
+	\param[in] nbPoses Number of entries in poses0
+	\param[in] geom1 The geometry object to test the sweeps against
+	\param[in] pose1 Pose of the geometry object to sweep against
+	\param[out] sweepHits Array of nbPoses sweep hits. Entry i is only valid if results[i] is true.
+	\param[out] results Array of nbPoses booleans, set to true if the sweep from poses0[i] hits geom1
+	\param[in] hitFlags Specify which properties per hit should be computed and written to result hit array. Combination of #PxHitFlag flags
+	\param[in] inflation Surface of the swept shape is additively extruded in the normal direction, rounding corners and edges.
+
+	\return Number of sweeps that hit geom1
+
+	@see sweep
+	*/
+	PX_PHYSX_COMMON_API static PxU32 sweep(const PxVec3& unitDir,
+							const PxReal maxDist,
+							const PxGeometry& geom0,
+							const PxTransform* poses0,
+							PxU32 nbPoses,
+							const PxGeometry& geom1,
+							const PxTransform& pose1,
+							PxSweepHit* sweepHits,
+							bool* results,
+							PxHitFlags hitFlags = PxHitFlag::eDEFAULT,
+							const PxReal inflation = 0.f);
+
+	/**
+	\brief Batched overlap test of one geometry object at several poses against a given object.
+
+	Equivalent to calling #overlap for each entry of poses0. The dispatch is done once for the whole batch. Sphere vs. {sphere, capsule, box} tests
+	run four poses at a time, and tests involving a convex mesh build the support mappings of both objects (including mesh scaling) once.
+	The supported combinations are the same as for #overlap.
+
+	\param[in] geom0 The first geometry object
+	\param[in] poses0 Array of poses of the first geometry object
+	\param[in] nbPoses Number of entries in poses0
+	\param[in] geom1 The second geometry object
+	\param[in] pose1 Pose of the second geometry object
+	\param[out] results Array of nbPoses booleans, set to true if geom0 at poses0[i] overlaps geom1
+
+	\return Number of poses for which the two geometry objects overlap
+
+	@see overlap
+	*/
+	PX_PHYSX_COMMON_API static PxU32 overlap(const PxGeometry& geom0, const PxTransform* poses0, PxU32 nbPoses,
+											const PxGeometry& geom1, const PxTransform& pose1,
+											bool* results);
+
+	/**
+	\brief Batched raycast test of several rays against a geometry object.
+
+	Equivalent to calling #raycast with maxHits = 1 for each ray, with the dispatch done once for the whole batch.
+
+	\param[in] origins Array of ray origins
+	\param[in] unitDirs Array of normalized ray directions
+	\param[in] nbRays Number of rays
+	\param[in] geom The geometry object to test the rays against
+	\param[in] pose Pose of the geometry object
+	\param[in] maxDist Maximum ray length, has to be in the [0, inf) range
+	\param[in] hitFlags Specification of the kind of information to retrieve on hit. Combination of #PxHitFlag flags
+	\param[out] rayHits Array of nbRays hits. Entry i is only valid if results[i] is true.
+	\param[out] results Array of nbRays booleans, set to true if ray i hits the geometry object
+
+	\return Number of rays that hit the geometry object
+
+	@see raycast
+	*/
+	PX_PHYSX_COMMON_API static PxU32 raycast(const PxVec3* origins,
+							const PxVec3* unitDirs,
+							PxU32 nbRays,
+							const PxGeometry& geom,
+							const PxTransform& pose,
+							PxReal maxDist,
+							PxHitFlags hitFlags,
+							PxRaycastHit* PX_RESTRICT rayHits,
+							bool* results);
+
+	/**
+	\brief Batched MTD computation of one geometry object at several poses against a given object.
+
+	Equivalent to calling #computePenetration for each entry of poses0, with the dispatch done once for the whole batch.
+	The supported combinations are the same as for #computePenetration.
+
+	\param[out] directions Array of nbPoses MTD unit directions. Entry i is only valid if results[i] is true.
+	\param[out] depths Array of nbPoses penetration depths. Entry i is only valid if results[i] is true.
+	\param[in] geom0 The first geometry object
+	\param[in] poses0 Array of poses of the first geometry object
+	\param[in] nbPoses Number of entries in poses0
+	\param[in] geom1 The second geometry object
+	\param[in] pose1 Pose of the second geometry object
+	\param[out] results Array of nbPoses booleans, set to true if the MTD has been computed for poses0[i]
+
+	\return Number of poses for which the objects overlap
+
+	@see computePenetration
+	*/
+	PX_PHYSX_COMMON_API static PxU32	computePenetration(PxVec3* directions, PxF32* depths,
+											const PxGeometry& geom0, const PxTransform* poses0, PxU32 nbPoses,
+											const PxGeometry& geom1, const PxTransform& pose1,
+											bool* results);
+
 	/**
 	\brief Computes distance between a point and a geometry object.
 
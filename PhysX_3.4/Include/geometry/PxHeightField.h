@@ -115,16 +115,17 @@ class PxHeightField	: public PxBase
 	\param[in] startCol First cell in the destination heightfield to be modified. Can be negative.
 	\param[in] startRow First row in the destination heightfield to be modified. Can be negative.
 	\param[in] subfieldDesc Description of the source subfield to read the samples from.
-	\param[in] shrinkBounds If left as false, the bounds will never shrink but only grow. If set to true the bounds will be recomputed from all HF samples at O(nbColums*nbRows) perf cost.
+	\param[in] shrinkBounds If left as false, the bounds will never shrink but only grow. If set to true the bounds will be recomputed from the internal per-tile height bounds, or from all HF samples at O(nbColums*nbRows) perf cost for heightfields too small to have them.
 	\return True on success, false on failure. Failure can occur due to format mismatch.
 
 	\note Modified samples are constrained to the same height quantization range as the original heightfield.
 	Source samples that are out of range of target heightfield will be clipped with no error.
 	PhysX does not keep a mapping from the heightfield to heightfield shapes that reference it.
-	Call PxShape::setGeometry on each shape which references the height field, to ensure that internal data structures are updated to reflect the new geometry.
-	Please note that PxShape::setGeometry does not guarantee correct/continuous behavior when objects are resting on top of old or new geometry.
+	Call PxShape::notifyHeightFieldModified (or PxShape::setGeometry) on each shape which references the height field, to ensure that internal data structures are updated to reflect the new geometry.
+	PxShape::notifyHeightFieldModified only resets the contact pairs overlapping the modified region.
+	Please note that neither function guarantees correct/continuous behavior when objects are resting on top of old or new geometry.
 
-	@see PxHeightFieldDesc.samples PxShape.setGeometry
+	@see PxHeightFieldDesc.samples PxShape.setGeometry PxShape.notifyHeightFieldModified
 	*/
 	PX_PHYSX_COMMON_API virtual		bool						modifySamples(PxI32 startCol, PxI32 startRow, const PxHeightFieldDesc& subfieldDesc, bool shrinkBounds = false) = 0;
 
@@ -113,6 +113,31 @@ public:
 																const PxTriangleMeshGeometry& meshGeom, const PxTransform& meshPose,
 																PxU32* results, PxU32 maxResults, PxU32 startIndex, bool& overflow);
 
+	/**
+	\brief Find the pairs of overlapping triangles between two triangle meshes.
+
+	Both trees are traversed together. Triangles of the first mesh are tested against the triangles of the second mesh
+	four at a time using SIMD plane rejection, followed by an exact triangle-triangle test for the remaining candidates.
+
+	\param[in] meshGeom0 The first triangle mesh geometry
+	\param[in] meshPose0 Pose of the first triangle mesh
+	\param[in] meshGeom1 The second triangle mesh geometry
+	\param[in] meshPose1 Pose of the second triangle mesh
+	\param[out] results Overlapping triangle pairs. Pair i is stored as results[2*i] (triangle index in the first mesh) and results[2*i+1] (triangle index in the second mesh). The buffer must hold 2*maxPairs elements.
+	\param[in] maxPairs Number of pairs the 'results' buffer can hold
+	\param[in] startIndex Index of first pair to be retrieved. Previous pairs are skipped.
+	\param[out] overflow True if a buffer overflow occurred
+	\return Number of overlapping pairs found, i.e. number of pairs written to the results buffer
+
+	\note Only supported for meshes cooked with the BVH34 midphase (PxMeshMidPhase::eBVH34). Returns 0 for other meshes.
+	\note Triangles that merely touch may be reported.
+
+	@see PxTriangleMeshGeometry getTriangle() PxMeshMidPhase
+	*/
+	PX_PHYSX_COMMON_API static PxU32 findOverlapTriangleMesh(	const PxTriangleMeshGeometry& meshGeom0, const PxTransform& meshPose0,
+																const PxTriangleMeshGeometry& meshGeom1, const PxTransform& meshPose1,
+																PxU32* results, PxU32 maxPairs, PxU32 startIndex, bool& overflow);
+
 	/**
 	\brief Find the height field triangles which touch the specified geometry object.
 
@@ -135,6 +160,37 @@ public:
 															PxU32* results, PxU32 maxResults, PxU32 startIndex, bool& overflow);
 
 
+	/**
+	\brief Raycasts a batch of rays against a triangle mesh, returning the closest hit of each ray.
+
+	Rays are processed in packets: on meshes cooked with the BVH34 midphase, each packet traverses the mesh's tree once,
+	culling nodes against all the rays of the packet at the same time. This is cheaper than independent raycasts when the
+	rays are coherent, e.g. rays sharing an origin and covering a small cone of directions. Meshes cooked with the BVH33
+	midphase, and scaled meshes, fall back to casting the rays one by one.
+
+	\param[in] meshGeom The triangle mesh geometry to raycast against.
+	\param[in] meshPose Pose of the triangle mesh.
+	\param[in] nbRays Number of rays.
+	\param[in] rayOrigins Array of nbRays ray origins, in world space.
+	\param[in] unitDirs Array of nbRays normalized ray directions, in world space.
+	\param[in] maxDist Maximum distance of all rays. Needs to be finite and positive.
+	\param[in] hitFlags Specification of the kind of information to retrieve on hit. Combination of #PxHitFlag flags. PxHitFlag::eMESH_ANY and PxHitFlag::eMESH_BOTH_SIDES are supported, PxHitFlag::eMESH_MULTIPLE is ignored.
+	\param[out] hits Array of nbRays hits. hits[i] receives the hit of the i-th ray. A ray that misses the mesh gets a hit with empty flags and a faceIndex of 0xffffffff.
+	\return Number of rays that hit the mesh.
+
+	\note The returned PxRaycastHit::actor and PxRaycastHit::shape pointers are not filled.
+
+	@see PxTriangleMeshGeometry PxRaycastHit PxGeometryQuery::raycast
+	*/
+	PX_PHYSX_COMMON_API static PxU32 raycast(const PxTriangleMeshGeometry& meshGeom,
+							const PxTransform& meshPose,
+							PxU32 nbRays,
+							const PxVec3* rayOrigins,
+							const PxVec3* unitDirs,
+							PxReal maxDist,
+							PxHitFlags hitFlags,
+							PxRaycastHit* hits);
+
 	/**
 	\brief Sweep a specified geometry object in space and test for collision with a set of given triangles.
 
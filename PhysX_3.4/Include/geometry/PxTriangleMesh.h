@@ -151,7 +151,7 @@ class PxTriangleMesh : public PxBase
 
 	\return  inplace vertex coordinates for each existing mesh vertex.
 
-	\note works only for PxMeshMidPhase::eBVH33
+	\note works only for PxMeshMidPhase::eBVH33 and PxMeshMidPhase::eBVH34
 	\note Size of array returned is equal to the number returned by getNbVertices().
 	\note This function operates on cooked vertex indices.
 	\note This means the index mapping and vertex count can be different from what was provided as an input to the cooking routine.
@@ -171,7 +171,7 @@ class PxTriangleMesh : public PxBase
 
 	\return New bounds for the entire mesh.
 
-	\note works only for PxMeshMidPhase::eBVH33
+	\note works only for PxMeshMidPhase::eBVH33 and PxMeshMidPhase::eBVH34
 	\note PhysX does not keep a mapping from the mesh to mesh shapes that reference it.
 	\note Call PxShape::setGeometry on each shape which references the mesh, to ensure that internal data structures are updated to reflect the new geometry.
 	\note PxShape::setGeometry does not guarantee correct/continuous behavior when objects are resting on top of old or new geometry.
@@ -181,6 +181,25 @@ class PxTriangleMesh : public PxBase
 	@see getVerticesForModification()	
 	*/
 	virtual PxBounds3				refitBVH() = 0;
+
+	/**
+	\brief Refits BVH after a range of mesh vertices has been modified.
+
+	Same as refitBVH(), but only the parts of the BVH enclosing the triangles that reference the vertices
+	[firstDirtyVertex, firstDirtyVertex+nbDirtyVertices) are updated. This is cheaper than a full refit when
+	only a part of the mesh deforms.
+
+	\param[in] firstDirtyVertex	Index of the first modified vertex.
+	\param[in] nbDirtyVertices	Number of modified vertices.
+	\return New bounds for the entire mesh.
+
+	\note The partial refit is only implemented for PxMeshMidPhase::eBVH34. PxMeshMidPhase::eBVH33 meshes are fully refitted.
+	\note With PxMeshMidPhase::eBVH34, the whole tree is requantized when the vertices move outside of the range covered by the quantized nodes.
+	\note The same restrictions as for refitBVH() apply. Only the active edges of the refitted triangles are lost.
+	@see refitBVH()
+	@see getVerticesForModification()
+	*/
+	virtual PxBounds3				refitBVH(PxU32 firstDirtyVertex, PxU32 nbDirtyVertices) = 0;
 #endif // PX_ENABLE_DYNAMIC_MESH_RTREE
 
 	/**
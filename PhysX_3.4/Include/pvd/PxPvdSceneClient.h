@@ -74,6 +74,79 @@ struct PxPvdSceneFlag
 typedef PxFlags<PxPvdSceneFlag::Enum, PxU8> PxPvdSceneFlags;
 PX_FLAGS_OPERATORS(PxPvdSceneFlag::Enum, PxU8)
 
+/**
+\brief Controls how much of the scene query stream is captured when PxPvdSceneFlag::eTRANSMIT_SCENEQUERIES is set.
+
+@see PxPvdSceneQueryCaptureDesc PxPvdSceneClient::setSceneQueryCapture()
+*/
+struct PxPvdSceneQueryCaptureMode
+{
+	enum Enum
+	{
+		eALL,		//!< Every query is sent to PVD, with its inputs and hits.
+		eSAMPLED,	//!< Only the queries selected by the sampling settings of PxPvdSceneQueryCaptureDesc are sent, with their inputs and hits.
+		eSUMMARY	//!< No individual query is sent. Only per query type counts of queries and hits, and the time spent in them, are sent each frame.
+	};
+};
+
+/**
+\brief Scene query capture settings.
+
+In eSAMPLED mode a query is captured when it passes the group mask, is the sampleInterval-th candidate of the frame,
+and the quotas for its filter group and for the calling thread are not exhausted yet. All counters restart each frame.
+
+Batched queries are sampled per PxBatchQuery::execute() call rather than per query: a batch is captured or skipped as a
+whole. The group mask and the per group quota do not apply to batches.
+
+@see PxPvdSceneClient::setSceneQueryCapture()
+*/
+struct PxPvdSceneQueryCaptureDesc
+{
+	/**
+	\brief Capture mode.
+
+	<b>Default:</b> PxPvdSceneQueryCaptureMode::eALL
+	*/
+	PxPvdSceneQueryCaptureMode::Enum	mode;
+
+	/**
+	\brief In eSAMPLED mode, capture one query out of sampleInterval. Zero and one capture every candidate.
+
+	<b>Default:</b> 1
+	*/
+	PxU32								sampleInterval;
+
+	/**
+	\brief In eSAMPLED mode, only queries whose PxQueryFilterData::data.word0 shares a bit with this mask are candidates. Zero accepts every query.
+
+	<b>Default:</b> 0
+	*/
+	PxU32								groupMask;
+
+	/**
+	\brief In eSAMPLED mode, maximum number of queries captured per frame for each value of PxQueryFilterData::data.word0. Zero means no limit.
+
+	<b>Default:</b> 0
+	*/
+	PxU32								maxQueriesPerGroup;
+
+	/**
+	\brief In eSAMPLED mode, maximum number of queries (or batches) captured per frame for each calling thread. Zero means no limit.
+
+	<b>Default:</b> 0
+	*/
+	PxU32								maxQueriesPerThread;
+
+	PX_INLINE PxPvdSceneQueryCaptureDesc() :
+		mode				(PxPvdSceneQueryCaptureMode::eALL),
+		sampleInterval		(1),
+		groupMask			(0),
+		maxQueriesPerGroup	(0),
+		maxQueriesPerThread	(0)
+	{
+	}
+};
+
 /**
 \brief Special client for PxScene.
 It provides access to the PxPvdSceneFlag.
@@ -100,6 +173,32 @@ class PxPvdSceneClient
 	*/
 	virtual PxPvdSceneFlags getScenePvdFlags() const = 0;
 
+	/**
+	Sets the threshold below which the per-frame updates of awake rigid dynamics and articulation links are not sent.
+
+	An actor is sent when a component of its global pose or of its velocities moved by more than the threshold since it
+	was last sent, or when its sleep state changed. The default of zero only skips the actors that did not move at all.
+	\param threshold Threshold, in the units of the scene. Must not be negative.
+	*/
+	virtual void setActorUpdateThreshold(PxReal threshold) = 0;
+
+	/**
+	Retrieves the threshold set with setActorUpdateThreshold().
+	*/
+	virtual PxReal getActorUpdateThreshold() const = 0;
+
+	/**
+	Sets how much of the scene query stream is captured. Only used when PxPvdSceneFlag::eTRANSMIT_SCENEQUERIES is set.
+	The new settings take effect for the queries issued after the call.
+	\param desc Capture settings. See PxPvdSceneQueryCaptureDesc.
+	*/
+	virtual void setSceneQueryCapture(const PxPvdSceneQueryCaptureDesc& desc) = 0;
+
+	/**
+	Retrieves the settings set with setSceneQueryCapture().
+	*/
+	virtual PxPvdSceneQueryCaptureDesc getSceneQueryCapture() const = 0;
+
 	/**
 	update camera on PVD application's render window
 	*/
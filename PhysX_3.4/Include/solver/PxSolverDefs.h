@@ -101,7 +101,7 @@ struct PxSolverBodyData
 struct PxConstraintBatchHeader
 {
 	PxU32 mStartIndex;			//!< Start index for this batch
-	PxU16 mStride;				//!< Number of constraints in this batch (range: 1-4)
+	PxU16 mStride;				//!< Number of constraints in this batch (range: 1-4, or 8 for a pair of 4-wide blocks solved with AVX)
 	PxU16 mConstraintType;		//!< The type of constraint this batch references
 };
 
@@ -229,6 +229,41 @@ generates an acceleration greater than the specified value.
 */
 void PxVehicleSetMaxHitActorAcceleration(const PxF32 maxHitActorAcceleration);
 
+/**
+\brief Set the distance that the start of a suspension line may move before PxVehicleSuspensionRaycasts issues a fresh raycast for it.
+
+\note When all active wheels of a block of 4 wheels have a cached hit plane and the start of each of their suspension lines 
+has moved less than reuseTolerance since the raycast that produced the cached plane, PxVehicleSuspensionRaycasts issues no raycast 
+for the block and PxVehicleUpdates uses the cached hit planes instead.  Cached hit planes are only reused for wheels whose last 
+raycast hit a static actor or nothing at all.
+
+\note Blocks of wheels that are reused do not consume any entry of the sceneQueryResults buffer passed to PxVehicleSuspensionRaycasts.
+
+\note Default value of reuseTolerance is 0, which issues a raycast for every wheel at every call to PxVehicleSuspensionRaycasts.
+
+@see PxVehicleSuspensionRaycasts
+*/
+void PxVehicleSetSuspensionRaycastReuseTolerance(const PxF32 reuseTolerance);
+
+/**
+\brief Set whether PxVehicleSuspensionRaycasts and PxVehicleSuspensionSweeps query the scene query snapshot published by the last 
+fetchResults() instead of the live scene query structures.
+
+\note When enabled, the suspension queries are issued with PxQueryFlag::eSNAPSHOT.  The batch query does not need the scene read 
+lock and the suspension queries and PxVehicleUpdates can run while the scene is simulated.  The vehicles then see the scene as it was 
+at the end of the previous fetchResults(), which is also the state reported by the actor getters during the simulation.
+
+\note Vehicle updates that overlap the simulation should record their actor changes in PxVehicleConcurrentUpdateData buffers and 
+apply them with PxVehiclePostUpdates once fetchResults() has returned, so that they are applied before the next simulate() call.
+
+\note The scene must be created with PxSceneFlag::eENABLE_SCENE_QUERY_SNAPSHOTS.
+
+\note Default value is false.
+
+@see PxVehicleSuspensionRaycasts, PxVehicleSuspensionSweeps, PxVehicleUpdates, PxVehiclePostUpdates
+*/
+void PxVehicleSetSceneQuerySnapshots(const bool useSnapshots);
+
 #if !PX_DOXYGEN
 } // namespace physx
 #endif
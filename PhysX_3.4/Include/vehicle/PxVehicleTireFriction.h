@@ -203,11 +203,29 @@ private:
 	*/	
 	PxU32 mMaxNbTireTypes;			
 
+	/**
+	\brief Hash table heads used to find the index of a material in mDrivableSurfaceMaterials.
+
+	\note Computed in setup.
+	*/
+	PxU16* mSurfaceTypeHashHeads;
+
+	/**
+	\brief Hash table chains used to find the index of a material in mDrivableSurfaceMaterials.
+
+	\note Computed in setup.
+	*/
+	PxU16* mSurfaceTypeHashNexts;
+
+	/**
+	\brief Number of bits dropped from the material pointers before hashing.
+	*/
+	PxU32 mSurfaceTypeHashShift;
 
 #if !PX_P64_FAMILY
-	PxU32 mPad[1];
-#else
 	PxU32 mPad[2];
+#else
+	PxU32 mPad[1];
 #endif
 
 	PxVehicleDrivableSurfaceToTireFrictionPairs(){}
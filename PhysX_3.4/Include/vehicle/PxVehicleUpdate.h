@@ -47,6 +47,7 @@ namespace physx
 
 	class PxBatchQuery;
 	class PxContactModifyPair;
+	class PxCpuDispatcher;
 	class PxVehicleWheels;
 	class PxVehicleDrivableSurfaceToTireFrictionPairs;
 	class PxVehicleTelemetryData;
@@ -500,6 +501,51 @@ namespace physx
 		const PxU32 nbVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* vehicleWheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates = NULL);
 
 
+	/**
+	\brief Update an array of vehicles using the worker threads of a cpu dispatcher.
+
+	The vehicles are partitioned into batches of nbVehiclesPerTask vehicles and each batch is updated concurrently with 
+	PxVehicleUpdates.  The actor changes that cannot be safely applied during the concurrent updates are recorded in internally 
+	allocated PxVehicleConcurrentUpdateData buffers and applied with PxVehiclePostUpdates once all batches have completed.
+
+	\param[in] timestep is the timestep of the update
+
+	\param[in] gravity is the value of gravitational acceleration
+
+	\param[in] vehicleDrivableSurfaceToTireFrictionPairs describes the mapping between each PxMaterial ptr and an integer representing a 
+	surface type. It also stores the friction value for each combination of surface and tire type.
+
+	\param[in] nbVehicles is the number of vehicles pointers in the vehicles array
+
+	\param[in,out] vehicles is an array of length nbVehicles containing all vehicles to be updated by the specified timestep
+
+	\param[out] vehicleWheelQueryResults is an array of length nbVehicles storing the wheel query results of each corresponding vehicle and wheel in the 
+	vehicles array.  A NULL pointer is permitted.  
+
+	\param[in] dispatcher is the cpu dispatcher whose worker threads perform the concurrent updates.
+
+	\param[in] nbVehiclesPerTask is the number of vehicles updated by each batch.
+
+	\param[out] vehicleConcurrentUpdates is an optional array of length nbVehicles, set up as for the concurrent calls to PxVehicleUpdates.  
+	If it is specified, the actor changes are recorded in it and are not applied.  They must then be applied with PxVehiclePostUpdates, for 
+	instance once fetchResults() has returned when the update runs while the scene is simulated.
+
+	\note The calling thread also updates vehicles and blocks until all vehicles have been updated so it must not be a worker 
+	thread of the dispatcher.
+
+	\note If vehicleConcurrentUpdates is NULL, PxVehiclePostUpdates is called on the calling thread because the actor writes it performs are not thread-safe.
+
+	\note All vehicles must be in the scene specified by PxVehicleUpdateSetScene.
+
+	@see PxVehicleUpdates, PxVehiclePostUpdates
+	*/
+	void PxVehicleUpdates(
+		const PxReal timestep, const PxVec3& gravity, 
+		const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
+		const PxU32 nbVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* vehicleWheelQueryResults, 
+		PxCpuDispatcher& dispatcher, const PxU32 nbVehiclesPerTask = 16, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates = NULL);
+
+
 	/**
 	\brief Apply actor changes that were computed in concurrent calls to PxVehicleUpdates but which could not be safely applied due to the concurrency.
 
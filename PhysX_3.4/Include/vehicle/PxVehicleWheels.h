@@ -527,6 +527,28 @@ public:
 };
 PX_COMPILE_TIME_ASSERT(0==(sizeof(PxVehicleWheelsSimData) & 15));
 
+/**
+\brief Level of detail of the update of a vehicle in PxVehicleUpdates.
+@see PxVehicleWheelsDynData::setUpdateLOD
+*/
+struct PxVehicleUpdateLOD
+{
+	enum Enum
+	{
+		/**
+		\brief Full update with the sub-step count of PxVehicleWheelsSimData::setSubStepCount and suspension 
+		raycasts/sweeps issued whenever requested.
+		*/
+		eFULL=0,
+
+		/**
+		\brief Reduced update with a single sub-step per update and suspension raycasts/sweeps issued only once every 
+		interval calls to PxVehicleSuspensionRaycasts or PxVehicleSuspensionSweeps, the cached hit planes being used in between.
+		*/
+		eREDUCED
+	};
+};
+
 /**
 \brief Data structure with instanced dynamics data for wheels
 */
@@ -617,6 +639,23 @@ public:
 	*/
 	void copy(const PxVehicleWheelsDynData& src, const PxU32 srcWheel, const PxU32 trgWheel);
 
+	/**
+	\brief Set the level of detail of the vehicle update.
+	\param[in] lod is the level of detail used by subsequent calls to PxVehicleUpdates, PxVehicleSuspensionRaycasts and PxVehicleSuspensionSweeps.
+	\param[in] sceneQueryInterval is the number of raycast/sweep calls between two scene queries of the vehicle with PxVehicleUpdateLOD::eREDUCED.
+	\note The internal dynamics state (wheel rotation speeds, jounces, engine speed) is integrated at both levels of detail so the vehicle 
+	can switch between them at any time.
+	\note Scene queries are always issued while a block of 4 wheels has no cached hit plane, e.g. after setToRestState.
+	@see PxVehicleUpdateLOD
+	*/
+	void setUpdateLOD(const PxVehicleUpdateLOD::Enum lod, const PxU32 sceneQueryInterval = 4);
+
+	/**
+	\brief Return the level of detail of the vehicle update.
+	@see setUpdateLOD
+	*/
+	PxVehicleUpdateLOD::Enum getUpdateLOD() const {return PxVehicleUpdateLOD::Enum(mUpdateLOD);}
+
 private:
 
     /**
@@ -650,7 +689,21 @@ private:
 	*/
 	PxU32 mNbActiveWheels;
 
-	PxU32 mPad[3];
+	/**
+	\brief Level of detail of the update (PxVehicleUpdateLOD).
+	@see setUpdateLOD
+	*/
+	PxU32 mUpdateLOD;
+
+	/**
+	\brief Number of raycast/sweep calls between two scene queries with PxVehicleUpdateLOD::eREDUCED.
+	*/
+	PxU32 mSceneQueryInterval;
+
+	/**
+	\brief Number of raycast/sweep calls since the last scene query with PxVehicleUpdateLOD::eREDUCED.
+	*/
+	PxU32 mSceneQueryCounter;
 
 	/**
 	\brief see PxVehicleWheels::allocate
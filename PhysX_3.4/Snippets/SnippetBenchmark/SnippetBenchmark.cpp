@@ -0,0 +1,528 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet is a benchmark harness for measuring the scalability of the SDK.
+//
+// It builds standardized, parameterized scenes (pyramid stacks of boxes, a 
+// crowd of articulated ragdolls, dynamic shapes on a large static triangle 
+// mesh and a scene query raycast storm), simulates each of them with an 
+// increasing number of worker threads and prints one JSON object per run 
+// with the per-stage wall times, the task statistics and the memory usage
+// reported by the SDK.
+//
+// Usage: SnippetBenchmark [--scene=boxes|ragdolls|mesh|raycasts|all] 
+//        [--threads=N] [--frames=N] [--warmup=N] [--size=S] [--bp=sap|mbp]
+//        [--pcm=0|1]
+//
+// --threads=N runs every scene with 1, 2, 4, ... and N worker threads. The
+// default is the number of physical cores. --size scales the object counts.
+// ****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "PxPhysicsAPI.h"
+
+#include "../SnippetUtils/SnippetUtils.h"
+
+using namespace physx;
+using namespace SnippetUtils;
+
+PxDefaultAllocator			gAllocator;
+PxDefaultErrorCallback		gErrorCallback;
+
+PxFoundation*				gFoundation		= NULL;
+PxPhysics*					gPhysics		= NULL;
+PxCooking*					gCooking		= NULL;
+PxMaterial*					gMaterial		= NULL;
+
+PxDefaultCpuDispatcher*		gDispatcher		= NULL;
+PxScene*					gScene			= NULL;
+
+static const PxReal			TIMESTEP		= 1.0f/60.0f;
+static const PxReal			WORLD_EXTENT	= 200.0f;
+
+enum BenchmarkScene
+{
+	eSCENE_BOXES,
+	eSCENE_RAGDOLLS,
+	eSCENE_MESH,
+	eSCENE_RAYCASTS,
+	eSCENE_COUNT
+};
+
+static const char* const	gSceneNames[eSCENE_COUNT] = { "boxes", "ragdolls", "mesh", "raycasts" };
+
+static const char* const	gStageNames[PxSimulationStatistics::eSTAGE_COUNT] =
+{
+	"broadPhase", "narrowPhase", "islandGen", "solver", "integration", "ccd", "fetchResults"
+};
+
+static const char* const	gMemoryCategoryNames[PxMemoryCategory::eCOUNT] =
+{
+	"other", "foundation", "sdk", "simulation", "lowLevel", "broadPhase", "dynamics",
+	"geometry", "sceneQuery", "cooking", "character", "vehicle", "extensions"
+};
+
+struct BenchmarkParams
+{
+	PxU32	sceneMask;
+	PxU32	maxThreads;
+	PxU32	nbFrames;
+	PxU32	nbWarmupFrames;
+	PxReal	size;
+	bool	mbp;
+	bool	pcm;
+};
+
+// Statistics accumulated over the measured frames of a run.
+struct BenchmarkResults
+{
+	PxReal	frameTime;
+	PxReal	maxFrameTime;
+	PxReal	stepWallTime;
+	PxReal	stageWallTime[PxSimulationStatistics::eSTAGE_COUNT];
+	PxReal	taskCpuTime;
+	PxReal	workerIdleTime;
+	PxReal	sqTime;
+	PxU64	nbTasks;
+	PxU64	nbRayHits;
+	PxU32	nbActiveDynamics;
+	PxU32	nbContactPairs;
+};
+
+// A deterministic random number generator, so that every run simulates the same scene.
+static PxU32 gSeed = 0;
+
+static PxReal randomFloat(PxReal minValue, PxReal maxValue)
+{
+	gSeed = gSeed * 1664525u + 1013904223u;
+	return minValue + (maxValue - minValue) * PxReal(gSeed >> 8) / PxReal(1 << 24);
+}
+
+static PxVec3 randomPosition(PxReal extent, PxReal minHeight, PxReal maxHeight)
+{
+	return PxVec3(randomFloat(-extent, extent), randomFloat(minHeight, maxHeight), randomFloat(-extent, extent));
+}
+
+static void createPyramid(const PxVec3& origin, PxU32 size, PxReal halfExtent)
+{
+	PxShape* shape = gPhysics->createShape(PxBoxGeometry(halfExtent, halfExtent, halfExtent), *gMaterial);
+	for(PxU32 i=0; i<size; i++)
+	{
+		for(PxU32 j=0; j<size-i; j++)
+		{
+			const PxVec3 localPos(PxReal(j*2) - PxReal(size-i), PxReal(i*2+1), 0.0f);
+			PxRigidDynamic* body = gPhysics->createRigidDynamic(PxTransform(origin + localPos * halfExtent));
+			body->attachShape(*shape);
+			PxRigidBodyExt::updateMassAndInertia(*body, 10.0f);
+			gScene->addActor(*body);
+		}
+	}
+	shape->release();
+}
+
+static PxArticulationLink* createLimb(PxArticulation& articulation, PxArticulationLink* parent, const PxVec3& pos, 
+									  const PxVec3& parentAnchor, PxReal radius, PxReal halfHeight, bool vertical)
+{
+	// Capsules are aligned with the x axis, vertical limbs rotate it onto the y axis.
+	const PxQuat rot = vertical ? PxQuat(PxHalfPi, PxVec3(0.0f, 0.0f, 1.0f)) : PxQuat(PxIdentity);
+	PxArticulationLink* link = articulation.createLink(parent, PxTransform(pos, rot));
+	PxRigidActorExt::createExclusiveShape(*link, PxCapsuleGeometry(radius, halfHeight), *gMaterial);
+	PxRigidBodyExt::updateMassAndInertia(*link, 1000.0f);
+
+	PxArticulationJoint* joint = link->getInboundJoint();
+	if(joint)
+	{
+		const PxTransform parentPose = parent->getGlobalPose();
+		const PxVec3 anchor = parentPose.transform(parentAnchor);
+		joint->setParentPose(PxTransform(parentAnchor));
+		joint->setChildPose(PxTransform(link->getGlobalPose().transformInv(anchor)));
+		joint->setSwingLimit(PxPi/4.0f, PxPi/4.0f);
+		joint->setSwingLimitEnabled(true);
+		joint->setTwistLimit(-PxPi/8.0f, PxPi/8.0f);
+		joint->setTwistLimitEnabled(true);
+	}
+	return link;
+}
+
+// A ten-link humanoid with capsule limbs, standing on its feet at 'pos'.
+static void createRagdoll(const PxVec3& pos)
+{
+	PxArticulation* articulation = gPhysics->createArticulation();
+	articulation->setSolverIterationCounts(8, 2);
+
+	const PxReal r = 0.1f;
+	const PxVec3 hips = pos + PxVec3(0.0f, 1.0f, 0.0f);
+	PxArticulationLink* pelvis = createLimb(*articulation, NULL, hips, PxVec3(0.0f), 0.15f, 0.1f, false);
+	PxArticulationLink* torso = createLimb(*articulation, pelvis, hips + PxVec3(0.0f, 0.35f, 0.0f), PxVec3(0.0f, 0.1f, 0.0f), 0.15f, 0.2f, true);
+	createLimb(*articulation, torso, hips + PxVec3(0.0f, 0.8f, 0.0f), PxVec3(0.3f, 0.0f, 0.0f), 0.12f, 0.05f, true);
+
+	for(PxU32 side=0; side<2; side++)
+	{
+		const PxReal s = side ? 1.0f : -1.0f;
+		PxArticulationLink* upperArm = createLimb(*articulation, torso, hips + PxVec3(s*0.4f, 0.5f, 0.0f), PxVec3(0.2f, -s*0.2f, 0.0f), r, 0.12f, false);
+		createLimb(*articulation, upperArm, hips + PxVec3(s*0.75f, 0.5f, 0.0f), PxVec3(s*0.17f, 0.0f, 0.0f), r, 0.12f, false);
+		PxArticulationLink* thigh = createLimb(*articulation, pelvis, hips + PxVec3(s*0.12f, -0.3f, 0.0f), PxVec3(s*0.12f, -0.1f, 0.0f), r, 0.15f, true);
+		createLimb(*articulation, thigh, hips + PxVec3(s*0.12f, -0.75f, 0.0f), PxVec3(-0.22f, 0.0f, 0.0f), r, 0.15f, true);
+	}
+	gScene->addArticulation(*articulation);
+}
+
+// A (nbCells x nbCells) grid of triangles covering the world, with a rolling height profile.
+static PxTriangleMesh* createTerrainMesh(PxU32 nbCells)
+{
+	const PxU32 nbVerts = (nbCells+1)*(nbCells+1);
+	PxVec3* verts = new PxVec3[nbVerts];
+	PxU32* indices = new PxU32[nbCells*nbCells*6];
+
+	const PxReal cellSize = 2.0f*WORLD_EXTENT/PxReal(nbCells);
+	for(PxU32 z=0; z<=nbCells; z++)
+	{
+		for(PxU32 x=0; x<=nbCells; x++)
+		{
+			const PxReal px = -WORLD_EXTENT + PxReal(x)*cellSize;
+			const PxReal pz = -WORLD_EXTENT + PxReal(z)*cellSize;
+			verts[z*(nbCells+1)+x] = PxVec3(px, 2.0f*PxSin(px*0.05f)*PxCos(pz*0.07f), pz);
+		}
+	}
+
+	PxU32* index = indices;
+	for(PxU32 z=0; z<nbCells; z++)
+	{
+		for(PxU32 x=0; x<nbCells; x++)
+		{
+			const PxU32 v0 = z*(nbCells+1)+x;
+			const PxU32 v1 = v0 + 1;
+			const PxU32 v2 = v0 + nbCells + 1;
+			const PxU32 v3 = v2 + 1;
+			*index++ = v0;	*index++ = v2;	*index++ = v1;
+			*index++ = v1;	*index++ = v2;	*index++ = v3;
+		}
+	}
+
+	PxTriangleMeshDesc meshDesc;
+	meshDesc.points.count		= nbVerts;
+	meshDesc.points.stride		= sizeof(PxVec3);
+	meshDesc.points.data		= verts;
+	meshDesc.triangles.count	= nbCells*nbCells*2;
+	meshDesc.triangles.stride	= 3*sizeof(PxU32);
+	meshDesc.triangles.data		= indices;
+
+	PxTriangleMesh* mesh = gCooking->createTriangleMesh(meshDesc, gPhysics->getPhysicsInsertionCallback());
+
+	delete[] indices;
+	delete[] verts;
+	return mesh;
+}
+
+static void createTerrain(PxU32 nbCells)
+{
+	PxTriangleMesh* mesh = createTerrainMesh(nbCells);
+	PxRigidStatic* terrain = gPhysics->createRigidStatic(PxTransform(PxIdentity));
+	PxRigidActorExt::createExclusiveShape(*terrain, PxTriangleMeshGeometry(mesh), *gMaterial);
+	gScene->addActor(*terrain);
+	mesh->release();
+}
+
+static void createDebris(PxU32 nbObjects, PxReal extent)
+{
+	for(PxU32 i=0; i<nbObjects; i++)
+	{
+		const PxTransform pose(randomPosition(extent, 5.0f, 25.0f));
+		const PxReal size = randomFloat(0.3f, 1.0f);
+		PxRigidDynamic* body;
+		switch(i%3)
+		{
+		case 0:		body = PxCreateDynamic(*gPhysics, pose, PxBoxGeometry(size, size, size), *gMaterial, 10.0f);		break;
+		case 1:		body = PxCreateDynamic(*gPhysics, pose, PxSphereGeometry(size), *gMaterial, 10.0f);						break;
+		default:	body = PxCreateDynamic(*gPhysics, pose, PxCapsuleGeometry(size*0.5f, size), *gMaterial, 10.0f);			break;
+		}
+		gScene->addActor(*body);
+	}
+}
+
+static PxU32 scaledCount(PxU32 count, PxReal size)
+{
+	return PxMax(PxU32(PxReal(count)*size), 1u);
+}
+
+static void createScene(BenchmarkScene scene, const BenchmarkParams& params)
+{
+	gSeed = 0x5eed;
+	switch(scene)
+	{
+	case eSCENE_BOXES:
+	{
+		gScene->addActor(*PxCreatePlane(*gPhysics, PxPlane(0.0f, 1.0f, 0.0f, 0.0f), *gMaterial));
+		const PxU32 nbPyramids = scaledCount(32, params.size);
+		const PxU32 nbRows = PxU32(PxSqrt(PxReal(nbPyramids))) + 1;
+		for(PxU32 i=0; i<nbPyramids; i++)
+			createPyramid(PxVec3(PxReal(i%nbRows)*12.0f, 0.0f, PxReal(i/nbRows)*6.0f), 10, 0.5f);
+		break;
+	}
+	case eSCENE_RAGDOLLS:
+	{
+		gScene->addActor(*PxCreatePlane(*gPhysics, PxPlane(0.0f, 1.0f, 0.0f, 0.0f), *gMaterial));
+		const PxU32 nbRagdolls = scaledCount(128, params.size);
+		const PxU32 nbRows = PxU32(PxSqrt(PxReal(nbRagdolls))) + 1;
+		for(PxU32 i=0; i<nbRagdolls; i++)
+			createRagdoll(PxVec3(PxReal(i%nbRows)*2.5f, PxReal(i%4)*0.5f + 0.1f, PxReal(i/nbRows)*1.5f));
+		break;
+	}
+	case eSCENE_MESH:
+		createTerrain(256);
+		createDebris(scaledCount(4096, params.size), WORLD_EXTENT*0.9f);
+		break;
+	case eSCENE_RAYCASTS:
+		createTerrain(256);
+		createDebris(scaledCount(512, params.size), WORLD_EXTENT*0.9f);
+		break;
+	case eSCENE_COUNT:
+		break;
+	}
+}
+
+// Casts a grid of vertical rays over the world, e.g. the wheels of a crowd of vehicles.
+static PxU32 raycastStorm(PxU32 nbRays)
+{
+	const PxU32 nbRows = PxU32(PxSqrt(PxReal(nbRays))) + 1;
+	const PxReal spacing = 2.0f*WORLD_EXTENT/PxReal(nbRows);
+	PxU32 nbHits = 0;
+	for(PxU32 i=0; i<nbRays; i++)
+	{
+		const PxVec3 origin(-WORLD_EXTENT + PxReal(i%nbRows)*spacing, 50.0f, -WORLD_EXTENT + PxReal(i/nbRows)*spacing);
+		PxRaycastBuffer hit;
+		if(gScene->raycast(origin, PxVec3(0.0f, -1.0f, 0.0f), 100.0f, hit))
+			nbHits++;
+	}
+	return nbHits;
+}
+
+static void runBenchmark(BenchmarkScene scene, PxU32 nbThreads, const BenchmarkParams& params)
+{
+	gPhysics->resetMemoryPeakStatistics();
+
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
+	sceneDesc.cpuDispatcher = gDispatcher = PxDefaultCpuDispatcherCreate(nbThreads);
+	sceneDesc.filterShader = PxDefaultSimulationFilterShader;
+	sceneDesc.broadPhaseType = params.mbp ? PxBroadPhaseType::eMBP : PxBroadPhaseType::eSAP;
+	if(params.pcm)
+		sceneDesc.flags |= PxSceneFlag::eENABLE_PCM;
+	gScene = gPhysics->createScene(sceneDesc);
+
+	if(params.mbp)
+	{
+		PxBounds3 regions[64];
+		const PxBounds3 worldBounds(PxVec3(-WORLD_EXTENT, -WORLD_EXTENT, -WORLD_EXTENT), PxVec3(WORLD_EXTENT, WORLD_EXTENT, WORLD_EXTENT));
+		const PxU32 nbRegions = PxBroadPhaseExt::createRegionsFromWorldBounds(regions, worldBounds, 4);
+		for(PxU32 i=0; i<nbRegions; i++)
+		{
+			PxBroadPhaseRegion region;
+			region.bounds = regions[i];
+			region.userData = NULL;
+			gScene->addBroadPhaseRegion(region);
+		}
+	}
+
+	createScene(scene, params);
+
+	const PxU32 nbRays = scene == eSCENE_RAYCASTS ? scaledCount(16384, params.size) : 0;
+
+	BenchmarkResults results;
+	memset(&results, 0, sizeof(results));
+
+	for(PxU32 frame=0; frame<params.nbWarmupFrames+params.nbFrames; frame++)
+	{
+		const PxU64 frameStart = getCurrentTimeCounterValue();
+		gScene->simulate(TIMESTEP);
+		gScene->fetchResults(true);
+		const PxU64 sqStart = getCurrentTimeCounterValue();
+		const PxU32 nbHits = nbRays ? raycastStorm(nbRays) : 0;
+		const PxU64 frameEnd = getCurrentTimeCounterValue();
+
+		if(frame < params.nbWarmupFrames)
+			continue;
+
+		PxSimulationStatistics stats;
+		gScene->getSimulationStatistics(stats);
+
+		const PxReal frameTime = getElapsedTimeInMilliseconds(frameEnd - frameStart);
+		results.frameTime += frameTime;
+		results.maxFrameTime = PxMax(results.maxFrameTime, frameTime);
+		results.sqTime += getElapsedTimeInMilliseconds(frameEnd - sqStart);
+		results.stepWallTime += stats.stepWallTime;
+		for(PxU32 i=0; i<PxSimulationStatistics::eSTAGE_COUNT; i++)
+			results.stageWallTime[i] += stats.getStageWallTime(PxSimulationStatistics::SimulationStage(i));
+		results.taskCpuTime += stats.taskCpuTime;
+		results.workerIdleTime += stats.workerIdleTime;
+		results.nbTasks += stats.nbTasks;
+		results.nbRayHits += nbHits;
+		results.nbActiveDynamics = stats.nbActiveDynamicBodies;
+		results.nbContactPairs = stats.nbDiscreteContactPairsTotal;
+	}
+
+	PxMemoryStatistics memory;
+	gPhysics->getMemoryStatistics(memory);
+
+	// Times are averages over the measured frames, in milliseconds. The SDK reports seconds.
+	const PxReal frameScale = 1.0f/PxReal(PxMax(params.nbFrames, 1u));
+	const PxReal sdkScale = 1000.0f*frameScale;
+
+	printf("{\"scene\":\"%s\",\"threads\":%u,\"frames\":%u,\"size\":%g,\"broadPhase\":\"%s\",\"pcm\":%s,"
+		"\"actors\":%u,\"activeDynamics\":%u,\"contactPairs\":%u,",
+		gSceneNames[scene], nbThreads, params.nbFrames, double(params.size), params.mbp ? "mbp" : "sap", params.pcm ? "true" : "false",
+		gScene->getNbActors(PxActorTypeFlag::eRIGID_STATIC|PxActorTypeFlag::eRIGID_DYNAMIC), results.nbActiveDynamics, results.nbContactPairs);
+	printf("\"frameMs\":%.4f,\"maxFrameMs\":%.4f,\"stepMs\":%.4f,\"taskCpuMs\":%.4f,\"workerIdleMs\":%.4f,\"tasks\":%.1f,",
+		double(results.frameTime*frameScale), double(results.maxFrameTime), double(results.stepWallTime*sdkScale),
+		double(results.taskCpuTime*sdkScale), double(results.workerIdleTime*sdkScale), double(PxReal(results.nbTasks)*frameScale));
+	if(nbRays)
+		printf("\"rays\":%u,\"rayHits\":%.1f,\"sqMs\":%.4f,", nbRays, double(PxReal(results.nbRayHits)*frameScale), double(results.sqTime*frameScale));
+
+	printf("\"stageMs\":{");
+	for(PxU32 i=0; i<PxSimulationStatistics::eSTAGE_COUNT; i++)
+		printf("%s\"%s\":%.4f", i ? "," : "", gStageNames[i], double(results.stageWallTime[i]*sdkScale));
+
+	printf("},\"memory\":{\"liveBytes\":%llu,\"peakBytes\":%llu,\"categories\":{", 
+		static_cast<unsigned long long>(memory.totalLiveBytes), static_cast<unsigned long long>(memory.totalPeakBytes));
+	for(PxU32 i=0; i<PxMemoryCategory::eCOUNT; i++)
+	{
+		printf("%s\"%s\":[%llu,%llu]", i ? "," : "", gMemoryCategoryNames[i], 
+			static_cast<unsigned long long>(memory.liveBytes[i]), static_cast<unsigned long long>(memory.peakBytes[i]));
+	}
+	printf("}}}\n");
+	fflush(stdout);
+
+	gScene->release();
+	gScene = NULL;
+	gDispatcher->release();
+	gDispatcher = NULL;
+}
+
+static bool parseArgument(const char* arg, const char* name, const char*& value)
+{
+	const size_t length = strlen(name);
+	if(strncmp(arg, name, length) || arg[length] != '=')
+		return false;
+	value = arg + length + 1;
+	return true;
+}
+
+static bool parseArguments(int argc, const char*const* argv, BenchmarkParams& params)
+{
+	params.sceneMask		= (1<<eSCENE_COUNT)-1;
+	params.maxThreads		= PxMax(getNbPhysicalCores(), 1u);
+	params.nbFrames			= 300;
+	params.nbWarmupFrames	= 30;
+	params.size				= 1.0f;
+	params.mbp				= false;
+	params.pcm				= true;
+
+	for(int i=1; i<argc; i++)
+	{
+		const char* value;
+		if(parseArgument(argv[i], "--scene", value))
+		{
+			params.sceneMask = 0;
+			for(PxU32 j=0; j<eSCENE_COUNT; j++)
+			{
+				if(!strcmp(value, gSceneNames[j]))
+					params.sceneMask = 1u<<j;
+			}
+			if(!strcmp(value, "all"))
+				params.sceneMask = (1<<eSCENE_COUNT)-1;
+			if(!params.sceneMask)
+				return false;
+		}
+		else if(parseArgument(argv[i], "--threads", value))
+			params.maxThreads = PxU32(PxMax(atoi(value), 1));
+		else if(parseArgument(argv[i], "--frames", value))
+			params.nbFrames = PxU32(PxMax(atoi(value), 1));
+		else if(parseArgument(argv[i], "--warmup", value))
+			params.nbWarmupFrames = PxU32(PxMax(atoi(value), 0));
+		else if(parseArgument(argv[i], "--size", value))
+			params.size = PxMax(PxReal(atof(value)), 0.01f);
+		else if(parseArgument(argv[i], "--bp", value))
+			params.mbp = !strcmp(value, "mbp");
+		else if(parseArgument(argv[i], "--pcm", value))
+			params.pcm = atoi(value) != 0;
+		else
+			return false;
+	}
+	return true;
+}
+
+void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_FOUNDATION_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale());
+	gCooking = PxCreateCooking(PX_PHYSICS_VERSION, *gFoundation, PxCookingParams(PxTolerancesScale()));
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.1f);
+}
+
+void cleanupPhysics()
+{
+	gCooking->release();
+	gPhysics->release();
+	gFoundation->release();
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	BenchmarkParams params;
+	if(!parseArguments(argc, argv, params))
+	{
+		printf("Usage: SnippetBenchmark [--scene=boxes|ragdolls|mesh|raycasts|all] [--threads=N] [--frames=N] [--warmup=N] [--size=S] [--bp=sap|mbp] [--pcm=0|1]\n");
+		return 1;
+	}
+
+	initPhysics();
+
+	for(PxU32 scene=0; scene<eSCENE_COUNT; scene++)
+	{
+		if(!(params.sceneMask & (1<<scene)))
+			continue;
+
+		// 1, 2, 4, ... threads, always finishing with the maximum.
+		for(PxU32 nbThreads=1; ; nbThreads*=2)
+		{
+			nbThreads = PxMin(nbThreads, params.maxThreads);
+			runBenchmark(BenchmarkScene(scene), nbThreads, params);
+			if(nbThreads == params.maxThreads)
+				break;
+		}
+	}
+
+	cleanupPhysics();
+
+	return 0;
+}
@@ -0,0 +1,534 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet is a headless streaming benchmark derived from SampleLargeWorld.
+//
+// The world is a grid of square chunks. Each chunk holds a heightfield 
+// terrain, static box buildings, static triangle mesh trees and a few dynamic 
+// crates. A camera flies a closed, scripted path over the world; chunks that 
+// come within the streaming radius are created and added to the scene, chunks 
+// that fall out of it are removed and released. Like the sample's background 
+// loader, at most --budget chunks are streamed in per frame.
+//
+// At the end of a run the snippet prints one JSON object with the mean, 
+// median, 90th and 99th percentile and maximum per-frame times of chunk 
+// creation, addActors, removeActors, the scene query update (flushQueryUpdates
+// followed by a ring of raycasts around the camera), simulation and the whole 
+// frame.
+//
+// Usage: SnippetLargeWorldStreaming [--frames=N] [--threads=N] [--radius=R]
+//        [--budget=N] [--speed=S] [--pruning=0|1] [--bp=sap|mbp]
+//
+// --pruning=1 builds a PxPruningStructure for the statics of each chunk and
+// streams them with addActors/removeActors(const PxPruningStructure&).
+// ****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "PxPhysicsAPI.h"
+
+#include "../SnippetUtils/SnippetUtils.h"
+
+using namespace physx;
+using namespace SnippetUtils;
+
+PxDefaultAllocator			gAllocator;
+PxDefaultErrorCallback		gErrorCallback;
+
+PxFoundation*				gFoundation		= NULL;
+PxPhysics*					gPhysics		= NULL;
+PxCooking*					gCooking		= NULL;
+PxMaterial*					gMaterial		= NULL;
+
+PxDefaultCpuDispatcher*		gDispatcher		= NULL;
+PxScene*					gScene			= NULL;
+
+PxHeightField*				gTerrain		= NULL;
+PxTriangleMesh*				gTreeMesh		= NULL;
+
+static const PxReal			TIMESTEP			= 1.0f/60.0f;
+
+// The world is WORLD_CHUNKS x WORLD_CHUNKS chunks of CHUNK_WIDTH meters.
+static const PxU32			WORLD_CHUNKS		= 64;
+static const PxReal			CHUNK_WIDTH			= 64.0f;
+static const PxReal			WORLD_WIDTH			= CHUNK_WIDTH * PxReal(WORLD_CHUNKS);
+
+static const PxU32			TERRAIN_SAMPLES		= 33;
+static const PxReal			TERRAIN_HEIGHT		= 8.0f;
+static const PxReal			TERRAIN_HEIGHT_SCALE= TERRAIN_HEIGHT / 32767.0f;
+
+static const PxU32			NB_BUILDINGS		= 16;
+static const PxU32			NB_TREES			= 24;
+static const PxU32			NB_CRATES			= 8;
+static const PxU32			NB_STATICS			= 1 + NB_BUILDINGS + NB_TREES;
+static const PxU32			MAX_CHUNK_ACTORS	= NB_STATICS + NB_CRATES;
+
+static const PxU32			NB_RAYS				= 64;
+
+enum StreamingMetric
+{
+	eMETRIC_CREATE,
+	eMETRIC_ADD,
+	eMETRIC_REMOVE,
+	eMETRIC_SQ,
+	eMETRIC_SIMULATE,
+	eMETRIC_FRAME,
+	eMETRIC_COUNT
+};
+
+static const char* const	gMetricNames[eMETRIC_COUNT] = { "create", "addActors", "removeActors", "sceneQuery", "simulate", "frame" };
+
+struct StreamingParams
+{
+	PxU32	nbFrames;
+	PxU32	nbThreads;
+	PxU32	radius;
+	PxU32	budget;
+	PxReal	speed;
+	bool	pruning;
+	bool	mbp;
+};
+
+// A chunk is either streamed out (nbActors == 0) or fully part of the scene.
+struct Chunk
+{
+	PxRigidActor*		actors[MAX_CHUNK_ACTORS];
+	PxU32				nbActors;
+	PxPruningStructure*	pruningStructure;
+};
+
+struct StreamingCounters
+{
+	PxU32	nbLoaded;
+	PxU32	nbUnloaded;
+	PxU32	nbRayHits;
+	PxU32	maxActors;
+};
+
+static Chunk				gChunks[WORLD_CHUNKS*WORLD_CHUNKS];
+
+// A deterministic random number generator, seeded per chunk so that a chunk looks the same every time it is streamed in.
+static PxU32 gSeed = 0;
+
+static PxReal randomFloat(PxReal minValue, PxReal maxValue)
+{
+	gSeed = gSeed * 1664525u + 1013904223u;
+	return minValue + (maxValue - minValue) * PxReal(gSeed >> 8) / PxReal(1 << 24);
+}
+
+static PxReal terrainHeight(PxReal x, PxReal z)
+{
+	return 0.5f * TERRAIN_HEIGHT * (1.0f + PxSin(x*0.11f) * PxCos(z*0.07f));
+}
+
+// All chunks share the same terrain tile, like the sample shares its tree and windmill meshes.
+static PxHeightField* createTerrain()
+{
+	PxHeightFieldSample* samples = new PxHeightFieldSample[TERRAIN_SAMPLES*TERRAIN_SAMPLES];
+	memset(samples, 0, sizeof(PxHeightFieldSample)*TERRAIN_SAMPLES*TERRAIN_SAMPLES);
+
+	const PxReal spacing = CHUNK_WIDTH / PxReal(TERRAIN_SAMPLES-1);
+	for(PxU32 row=0; row<TERRAIN_SAMPLES; row++)
+	{
+		for(PxU32 col=0; col<TERRAIN_SAMPLES; col++)
+			samples[row*TERRAIN_SAMPLES+col].height = PxI16(terrainHeight(PxReal(row)*spacing, PxReal(col)*spacing) / TERRAIN_HEIGHT_SCALE);
+	}
+
+	PxHeightFieldDesc desc;
+	desc.nbRows			= TERRAIN_SAMPLES;
+	desc.nbColumns		= TERRAIN_SAMPLES;
+	desc.samples.data	= samples;
+	desc.samples.stride	= sizeof(PxHeightFieldSample);
+
+	PxHeightField* heightField = gCooking->createHeightField(desc, gPhysics->getPhysicsInsertionCallback());
+
+	delete[] samples;
+	return heightField;
+}
+
+// A crude tree: a square pyramid on top of a thin trunk.
+static PxTriangleMesh* createTreeMesh()
+{
+	const PxVec3 verts[] = 
+	{
+		PxVec3(-0.3f, 0.0f, -0.3f), PxVec3(0.3f, 0.0f, -0.3f), PxVec3(0.3f, 0.0f, 0.3f), PxVec3(-0.3f, 0.0f, 0.3f),
+		PxVec3(-2.0f, 2.0f, -2.0f), PxVec3(2.0f, 2.0f, -2.0f), PxVec3(2.0f, 2.0f, 2.0f), PxVec3(-2.0f, 2.0f, 2.0f),
+		PxVec3(0.0f, 7.0f, 0.0f)
+	};
+	const PxU32 indices[] =
+	{
+		0, 4, 1,	1, 4, 5,	1, 5, 2,	2, 5, 6,	2, 6, 3,	3, 6, 7,	3, 7, 0,	0, 7, 4,
+		4, 8, 5,	5, 8, 6,	6, 8, 7,	7, 8, 4
+	};
+
+	PxTriangleMeshDesc meshDesc;
+	meshDesc.points.count		= sizeof(verts)/sizeof(verts[0]);
+	meshDesc.points.stride		= sizeof(PxVec3);
+	meshDesc.points.data		= verts;
+	meshDesc.triangles.count	= sizeof(indices)/(3*sizeof(indices[0]));
+	meshDesc.triangles.stride	= 3*sizeof(PxU32);
+	meshDesc.triangles.data		= indices;
+
+	return gCooking->createTriangleMesh(meshDesc, gPhysics->getPhysicsInsertionCallback());
+}
+
+static void createChunkActors(PxU32 x, PxU32 z, Chunk& chunk)
+{
+	gSeed = 0x5eed + x*WORLD_CHUNKS + z;
+
+	const PxVec3 origin(PxReal(x)*CHUNK_WIDTH, 0.0f, PxReal(z)*CHUNK_WIDTH);
+	const PxReal spacing = CHUNK_WIDTH / PxReal(TERRAIN_SAMPLES-1);
+
+	PxU32 nb = 0;
+	PxRigidStatic* terrain = gPhysics->createRigidStatic(PxTransform(origin));
+	PxRigidActorExt::createExclusiveShape(*terrain, PxHeightFieldGeometry(gTerrain, PxMeshGeometryFlags(), TERRAIN_HEIGHT_SCALE, spacing, spacing), *gMaterial);
+	chunk.actors[nb++] = terrain;
+
+	for(PxU32 i=0; i<NB_BUILDINGS; i++)
+	{
+		const PxVec3 halfExtents(randomFloat(2.0f, 5.0f), randomFloat(3.0f, 12.0f), randomFloat(2.0f, 5.0f));
+		const PxReal px = randomFloat(halfExtents.x, CHUNK_WIDTH - halfExtents.x);
+		const PxReal pz = randomFloat(halfExtents.z, CHUNK_WIDTH - halfExtents.z);
+		PxRigidStatic* building = gPhysics->createRigidStatic(PxTransform(origin + PxVec3(px, terrainHeight(px, pz) + halfExtents.y - 1.0f, pz)));
+		PxRigidActorExt::createExclusiveShape(*building, PxBoxGeometry(halfExtents), *gMaterial);
+		chunk.actors[nb++] = building;
+	}
+
+	for(PxU32 i=0; i<NB_TREES; i++)
+	{
+		const PxReal px = randomFloat(0.0f, CHUNK_WIDTH);
+		const PxReal pz = randomFloat(0.0f, CHUNK_WIDTH);
+		const PxReal scale = randomFloat(0.7f, 1.5f);
+		PxRigidStatic* tree = gPhysics->createRigidStatic(PxTransform(origin + PxVec3(px, terrainHeight(px, pz), pz), PxQuat(randomFloat(0.0f, PxTwoPi), PxVec3(0.0f, 1.0f, 0.0f))));
+		PxRigidActorExt::createExclusiveShape(*tree, PxTriangleMeshGeometry(gTreeMesh, PxMeshScale(scale)), *gMaterial);
+		chunk.actors[nb++] = tree;
+	}
+
+	// The statics come first, so that they can be handed to createPruningStructure as one block.
+	for(PxU32 i=0; i<NB_CRATES; i++)
+	{
+		const PxReal px = randomFloat(4.0f, CHUNK_WIDTH - 4.0f);
+		const PxReal pz = randomFloat(4.0f, CHUNK_WIDTH - 4.0f);
+		const PxReal size = randomFloat(0.4f, 1.0f);
+		const PxTransform pose(origin + PxVec3(px, terrainHeight(px, pz) + randomFloat(2.0f, 6.0f), pz));
+		chunk.actors[nb++] = PxCreateDynamic(*gPhysics, pose, PxBoxGeometry(size, size, size), *gMaterial, 10.0f);
+	}
+
+	chunk.nbActors = nb;
+}
+
+static void releaseChunkActors(Chunk& chunk)
+{
+	// The pruning structure must be released before its actors.
+	if(chunk.pruningStructure)
+	{
+		chunk.pruningStructure->release();
+		chunk.pruningStructure = NULL;
+	}
+	for(PxU32 i=0; i<chunk.nbActors; i++)
+		chunk.actors[i]->release();
+	chunk.nbActors = 0;
+}
+
+// The camera flies a Lissajous figure over the world, mostly staying away from its borders.
+static PxVec3 getCameraPosition(PxU32 frame, PxReal speed)
+{
+	const PxReal amplitude = 0.4f * WORLD_WIDTH;
+	const PxReal t = PxReal(frame) * TIMESTEP * speed / amplitude;
+	return PxVec3(0.5f*WORLD_WIDTH + amplitude*PxSin(t), 30.0f, 0.5f*WORLD_WIDTH + amplitude*PxSin(t*0.75f + 0.5f));
+}
+
+static bool isInRange(PxU32 x, PxU32 z, PxI32 cameraX, PxI32 cameraZ, PxU32 radius)
+{
+	return PxU32(PxAbs(PxI32(x) - cameraX)) <= radius && PxU32(PxAbs(PxI32(z) - cameraZ)) <= radius;
+}
+
+// Removes the chunks that left the streaming radius and adds up to params.budget new ones.
+static void streamChunks(const PxVec3& camera, const StreamingParams& params, PxReal* times, StreamingCounters& counters)
+{
+	const PxI32 cameraX = PxI32(camera.x / CHUNK_WIDTH);
+	const PxI32 cameraZ = PxI32(camera.z / CHUNK_WIDTH);
+
+	PxU64 createTime = 0, addTime = 0, removeTime = 0;
+	PxU32 nbLoaded = 0;
+
+	for(PxU32 z=0; z<WORLD_CHUNKS; z++)
+	{
+		for(PxU32 x=0; x<WORLD_CHUNKS; x++)
+		{
+			Chunk& chunk = gChunks[z*WORLD_CHUNKS+x];
+			const bool inRange = isInRange(x, z, cameraX, cameraZ, params.radius);
+
+			if(chunk.nbActors && !inRange)
+			{
+				const PxU64 start = getCurrentTimeCounterValue();
+				if(chunk.pruningStructure)
+				{
+					gScene->removeActors(*chunk.pruningStructure);
+					gScene->removeActors(reinterpret_cast<PxActor*const*>(chunk.actors + NB_STATICS), chunk.nbActors - NB_STATICS);
+				}
+				else
+					gScene->removeActors(reinterpret_cast<PxActor*const*>(chunk.actors), chunk.nbActors);
+				removeTime += getCurrentTimeCounterValue() - start;
+
+				releaseChunkActors(chunk);
+				counters.nbUnloaded++;
+			}
+			else if(!chunk.nbActors && inRange && nbLoaded < params.budget)
+			{
+				const PxU64 createStart = getCurrentTimeCounterValue();
+				createChunkActors(x, z, chunk);
+				if(params.pruning)
+					chunk.pruningStructure = gPhysics->createPruningStructure(chunk.actors, NB_STATICS);
+				const PxU64 addStart = getCurrentTimeCounterValue();
+				createTime += addStart - createStart;
+
+				if(chunk.pruningStructure)
+				{
+					gScene->addActors(*chunk.pruningStructure);
+					gScene->addActors(reinterpret_cast<PxActor*const*>(chunk.actors + NB_STATICS), chunk.nbActors - NB_STATICS);
+				}
+				else
+					gScene->addActors(reinterpret_cast<PxActor*const*>(chunk.actors), chunk.nbActors);
+				addTime += getCurrentTimeCounterValue() - addStart;
+
+				nbLoaded++;
+				counters.nbLoaded++;
+			}
+		}
+	}
+
+	times[eMETRIC_CREATE] = getElapsedTimeInMilliseconds(createTime);
+	times[eMETRIC_ADD] = getElapsedTimeInMilliseconds(addTime);
+	times[eMETRIC_REMOVE] = getElapsedTimeInMilliseconds(removeTime);
+}
+
+// Commits the pending scene query updates, then casts a ring of rays down onto the terrain around the camera.
+static PxU32 updateSceneQueries(const PxVec3& camera)
+{
+	gScene->flushQueryUpdates();
+
+	PxU32 nbHits = 0;
+	for(PxU32 i=0; i<NB_RAYS; i++)
+	{
+		const PxReal angle = PxTwoPi * PxReal(i) / PxReal(NB_RAYS);
+		const PxReal distance = CHUNK_WIDTH * (0.5f + PxReal(i%4));
+		const PxVec3 origin = camera + PxVec3(PxCos(angle)*distance, 0.0f, PxSin(angle)*distance);
+		PxRaycastBuffer hit;
+		if(gScene->raycast(origin, PxVec3(0.0f, -1.0f, 0.0f), 100.0f, hit))
+			nbHits++;
+	}
+	return nbHits;
+}
+
+static int compareTimes(const void* a, const void* b)
+{
+	const PxReal ta = *static_cast<const PxReal*>(a);
+	const PxReal tb = *static_cast<const PxReal*>(b);
+	return ta < tb ? -1 : (ta > tb ? 1 : 0);
+}
+
+// Sorts the samples in place and prints "name":{"mean":..,"p50":..,"p90":..,"p99":..,"max":..}.
+static void printPercentiles(const char* name, PxReal* samples, PxU32 nbSamples, bool first)
+{
+	PxReal sum = 0.0f;
+	for(PxU32 i=0; i<nbSamples; i++)
+		sum += samples[i];
+	qsort(samples, nbSamples, sizeof(PxReal), compareTimes);
+
+	const PxU32 last = nbSamples - 1;
+	printf("%s\"%s\":{\"mean\":%.4f,\"p50\":%.4f,\"p90\":%.4f,\"p99\":%.4f,\"max\":%.4f}", first ? "" : ",", name,
+		double(sum/PxReal(nbSamples)), double(samples[last*50/100]), double(samples[last*90/100]), double(samples[last*99/100]), double(samples[last]));
+}
+
+static void runBenchmark(const StreamingParams& params)
+{
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
+	sceneDesc.cpuDispatcher = gDispatcher = PxDefaultCpuDispatcherCreate(params.nbThreads);
+	sceneDesc.filterShader = PxDefaultSimulationFilterShader;
+	sceneDesc.broadPhaseType = params.mbp ? PxBroadPhaseType::eMBP : PxBroadPhaseType::eSAP;
+	sceneDesc.flags |= PxSceneFlag::eENABLE_PCM;
+	gScene = gPhysics->createScene(sceneDesc);
+
+	if(params.mbp)
+	{
+		PxBounds3 regions[64];
+		const PxBounds3 worldBounds(PxVec3(0.0f, -WORLD_WIDTH, 0.0f), PxVec3(WORLD_WIDTH, WORLD_WIDTH, WORLD_WIDTH));
+		const PxU32 nbRegions = PxBroadPhaseExt::createRegionsFromWorldBounds(regions, worldBounds, 8);
+		for(PxU32 i=0; i<nbRegions; i++)
+		{
+			PxBroadPhaseRegion region;
+			region.bounds = regions[i];
+			region.userData = NULL;
+			gScene->addBroadPhaseRegion(region);
+		}
+	}
+
+	memset(gChunks, 0, sizeof(gChunks));
+
+	PxReal* samples[eMETRIC_COUNT];
+	for(PxU32 i=0; i<eMETRIC_COUNT; i++)
+		samples[i] = new PxReal[params.nbFrames];
+
+	StreamingCounters counters;
+	memset(&counters, 0, sizeof(counters));
+
+	for(PxU32 frame=0; frame<params.nbFrames; frame++)
+	{
+		const PxVec3 camera = getCameraPosition(frame, params.speed);
+		PxReal times[eMETRIC_COUNT];
+
+		const PxU64 frameStart = getCurrentTimeCounterValue();
+		streamChunks(camera, params, times, counters);
+
+		const PxU64 sqStart = getCurrentTimeCounterValue();
+		counters.nbRayHits += updateSceneQueries(camera);
+
+		const PxU64 simStart = getCurrentTimeCounterValue();
+		gScene->simulate(TIMESTEP);
+		gScene->fetchResults(true);
+		const PxU64 frameEnd = getCurrentTimeCounterValue();
+
+		times[eMETRIC_SQ] = getElapsedTimeInMilliseconds(simStart - sqStart);
+		times[eMETRIC_SIMULATE] = getElapsedTimeInMilliseconds(frameEnd - simStart);
+		times[eMETRIC_FRAME] = getElapsedTimeInMilliseconds(frameEnd - frameStart);
+		for(PxU32 i=0; i<eMETRIC_COUNT; i++)
+			samples[i][frame] = times[i];
+
+		counters.maxActors = PxMax(counters.maxActors, gScene->getNbActors(PxActorTypeFlag::eRIGID_STATIC|PxActorTypeFlag::eRIGID_DYNAMIC));
+	}
+
+	printf("{\"frames\":%u,\"threads\":%u,\"radius\":%u,\"budget\":%u,\"speed\":%g,\"pruning\":%s,\"broadPhase\":\"%s\","
+		"\"chunksLoaded\":%u,\"chunksUnloaded\":%u,\"maxActors\":%u,\"rayHits\":%u,\"ms\":{",
+		params.nbFrames, params.nbThreads, params.radius, params.budget, double(params.speed), params.pruning ? "true" : "false", params.mbp ? "mbp" : "sap",
+		counters.nbLoaded, counters.nbUnloaded, counters.maxActors, counters.nbRayHits);
+	for(PxU32 i=0; i<eMETRIC_COUNT; i++)
+		printPercentiles(gMetricNames[i], samples[i], params.nbFrames, i==0);
+	printf("}}\n");
+	fflush(stdout);
+
+	for(PxU32 i=0; i<eMETRIC_COUNT; i++)
+		delete[] samples[i];
+
+	for(PxU32 i=0; i<WORLD_CHUNKS*WORLD_CHUNKS; i++)
+	{
+		if(gChunks[i].nbActors)
+		{
+			if(gChunks[i].pruningStructure)
+				gScene->removeActors(*gChunks[i].pruningStructure);
+			releaseChunkActors(gChunks[i]);
+		}
+	}
+
+	gScene->release();
+	gScene = NULL;
+	gDispatcher->release();
+	gDispatcher = NULL;
+}
+
+static bool parseArgument(const char* arg, const char* name, const char*& value)
+{
+	const size_t length = strlen(name);
+	if(strncmp(arg, name, length) || arg[length] != '=')
+		return false;
+	value = arg + length + 1;
+	return true;
+}
+
+static bool parseArguments(int argc, const char*const* argv, StreamingParams& params)
+{
+	params.nbFrames		= 3600;
+	params.nbThreads	= PxMax(getNbPhysicalCores(), 1u);
+	params.radius		= 3;
+	params.budget		= 4;
+	params.speed		= 60.0f;
+	params.pruning		= false;
+	params.mbp			= false;
+
+	for(int i=1; i<argc; i++)
+	{
+		const char* value;
+		if(parseArgument(argv[i], "--frames", value))
+			params.nbFrames = PxU32(PxMax(atoi(value), 1));
+		else if(parseArgument(argv[i], "--threads", value))
+			params.nbThreads = PxU32(PxMax(atoi(value), 0));
+		else if(parseArgument(argv[i], "--radius", value))
+			params.radius = PxU32(PxClamp(atoi(value), 0, int(WORLD_CHUNKS/2)));
+		else if(parseArgument(argv[i], "--budget", value))
+			params.budget = PxU32(PxMax(atoi(value), 1));
+		else if(parseArgument(argv[i], "--speed", value))
+			params.speed = PxMax(PxReal(atof(value)), 0.0f);
+		else if(parseArgument(argv[i], "--pruning", value))
+			params.pruning = atoi(value) != 0;
+		else if(parseArgument(argv[i], "--bp", value))
+			params.mbp = !strcmp(value, "mbp");
+		else
+			return false;
+	}
+	return true;
+}
+
+void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_FOUNDATION_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale());
+	gCooking = PxCreateCooking(PX_PHYSICS_VERSION, *gFoundation, PxCookingParams(PxTolerancesScale()));
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.1f);
+	gTerrain = createTerrain();
+	gTreeMesh = createTreeMesh();
+}
+
+void cleanupPhysics()
+{
+	gTreeMesh->release();
+	gTerrain->release();
+	gCooking->release();
+	gPhysics->release();
+	gFoundation->release();
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	StreamingParams params;
+	if(!parseArguments(argc, argv, params))
+	{
+		printf("Usage: SnippetLargeWorldStreaming [--frames=N] [--threads=N] [--radius=R] [--budget=N] [--speed=S] [--pruning=0|1] [--bp=sap|mbp]\n");
+		return 1;
+	}
+
+	initPhysics();
+	runBenchmark(params);
+	cleanupPhysics();
+
+	return 0;
+}
@@ -0,0 +1,226 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#ifndef PX_PHYSICS_COMMON_HIERARCHICAL_BITMAP
+#define PX_PHYSICS_COMMON_HIERARCHICAL_BITMAP
+
+#include "foundation/PxAssert.h"
+#include "foundation/PxMath.h"
+#include "PsArray.h"
+#include "PsUserAllocated.h"
+#include "PsIntrinsics.h"
+#include "PsBitUtils.h"
+#include "CmPhysXCommon.h"
+
+namespace physx
+{
+namespace Cm
+{
+
+	/*!
+	Bitmap with a summary level: bit i of summary word j is set when map word j*32+i is non-zero.
+
+	Meant for large, sparsely populated dirty sets. Iteration, clear() and isEmpty() skip 1024 bits
+	per empty summary word, and clear() only touches the words that were actually set, so their cost
+	follows the number of dirty entries rather than the size of the map. set() and reset() pay one
+	extra word update to keep the summary in sync.
+
+	Unlike BitMap this class is not serialized, and copies are inhibited in the same way.
+	*/
+	class HierarchicalBitMap : public Ps::UserAllocated
+	{
+		PX_NOCOPY(HierarchicalBitMap)
+
+	public:
+		PX_INLINE HierarchicalBitMap() : mMap(PX_DEBUG_EXP("HierarchicalBitMap")), mSummary(PX_DEBUG_EXP("HierarchicalBitMapSummary"))	{}
+
+		PX_INLINE void growAndSet(PxU32 index)
+		{
+			extend(index+1);
+			set(index);
+		}
+
+		PX_INLINE Ps::IntBool boundedTest(PxU32 index) const
+		{
+			return Ps::IntBool(index>>5 >= mMap.size() ? Ps::IntFalse : (mMap[index>>5]&(1<<(index&31))));
+		}
+
+		// Special optimized versions, when you _know_ your index is in range
+		PX_INLINE void set(PxU32 index)
+		{
+			PX_ASSERT(index<size());
+			const PxU32 word = index>>5;
+			mMap[word] |= 1<<(index&31);
+			mSummary[word>>5] |= 1<<(word&31);
+		}
+
+		PX_INLINE void reset(PxU32 index)
+		{
+			PX_ASSERT(index<size());
+			const PxU32 word = index>>5;
+			mMap[word] &= ~(1<<(index&31));
+			if(!mMap[word])
+				mSummary[word>>5] &= ~(1<<(word&31));
+		}
+
+		PX_INLINE Ps::IntBool test(PxU32 index) const
+		{
+			PX_ASSERT(index<size());
+			return Ps::IntBool(mMap[index>>5]&(1<<(index&31)));
+		}
+
+		// Clears the set words only, using the summary to find them.
+		void clear()
+		{
+			const PxU32 summaryCount = mSummary.size();
+			for(PxU32 i=0; i<summaryCount; i++)
+			{
+				PxU32 summary = mSummary[i];
+				while(summary)
+				{
+					mMap[i<<5 | Ps::lowestSetBit(summary)] = 0;
+					summary &= summary-1;
+				}
+				mSummary[i] = 0;
+			}
+		}
+
+		PX_INLINE bool isEmpty() const
+		{
+			const PxU32 summaryCount = mSummary.size();
+			for(PxU32 i=0; i<summaryCount; i++)
+			{
+				if(mSummary[i])
+					return false;
+			}
+			return true;
+		}
+
+		PX_INLINE PxU32 count() const
+		{
+			PxU32 count = 0;
+			const PxU32 summaryCount = mSummary.size();
+			for(PxU32 i=0; i<summaryCount; i++)
+			{
+				PxU32 summary = mSummary[i];
+				while(summary)
+				{
+					count += Ps::bitCount(mMap[i<<5 | Ps::lowestSetBit(summary)]);
+					summary &= summary-1;
+				}
+			}
+			return count;
+		}
+
+		// Existing bits are preserved, new bits are cleared.
+		void resize(PxU32 newBitCount)
+		{
+			extend(newBitCount);
+		}
+
+		PX_INLINE PxU32 size() const { return mMap.size()*32; }
+
+		class Iterator
+		{
+		public:
+			static const PxU32 DONE = 0xffffffff;
+
+			PX_INLINE Iterator(const HierarchicalBitMap& map) : mBitMap(map)
+			{
+				reset();
+			}
+
+			PX_INLINE PxU32 getNext()
+			{
+				if(mBlock)
+				{
+					const PxU32 bitIndex = mWord<<5 | Ps::lowestSetBit(mBlock);
+					mBlock &= mBlock-1;
+					if(!mBlock)
+						nextWord();
+					return bitIndex;
+				}
+				return DONE;
+			}
+
+			PX_INLINE void reset()
+			{
+				mSummaryIndex = 0;
+				mSummary = mBitMap.mSummary.size() ? mBitMap.mSummary[0] : 0;
+				mWord = mBlock = 0;
+				nextWord();
+			}
+
+		private:
+			// Loads the next non-zero map word, skipping empty summary words entirely.
+			PX_INLINE void nextWord()
+			{
+				const PxU32 summaryCount = mBitMap.mSummary.size();
+				while(!mSummary)
+				{
+					if(++mSummaryIndex >= summaryCount)
+					{
+						mBlock = 0;
+						return;
+					}
+					mSummary = mBitMap.mSummary[mSummaryIndex];
+				}
+				mWord = mSummaryIndex<<5 | Ps::lowestSetBit(mSummary);
+				mSummary &= mSummary-1;
+				mBlock = mBitMap.mMap[mWord];
+			}
+
+			PxU32 mBlock, mWord, mSummary, mSummaryIndex;
+			const HierarchicalBitMap& mBitMap;
+			Iterator& operator=(const Iterator&);
+		};
+
+	private:
+		void extend(PxU32 size)
+		{
+			const PxU32 newWordCount = (size+31)>>5;
+			if(newWordCount > mMap.size())
+			{
+				mMap.resize(newWordCount, 0);
+				mSummary.resize((newWordCount+31)>>5, 0);
+			}
+		}
+
+		Ps::Array<PxU32>	mMap;
+		Ps::Array<PxU32>	mSummary;	// one bit per non-zero word of mMap
+
+		friend class Iterator;
+	};
+
+} // namespace Cm
+
+}
+
+#endif
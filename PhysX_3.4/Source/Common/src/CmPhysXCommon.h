@@ -41,6 +41,12 @@
 // Enable simulation statistics generation
 #define PX_ENABLE_SIM_STATS 1
 
+// Always run the PCM narrowphase, calling the PCM contact kernels directly instead of through g_PCMContactMethodTable.
+// Scenes created without PxSceneFlag::eENABLE_PCM still use PCM in such builds.
+#ifndef PX_STATIC_PCM_NARROWPHASE
+#define PX_STATIC_PCM_NARROWPHASE	0
+#endif
+
 // PT: typical "invalid" value in various CD algorithms
 #define	PX_INVALID_U32		0xffffffff
 #define PX_INVALID_U16		0xffff
@@ -445,6 +445,115 @@ RadixSort& RadixSort::Sort(const float* input2, PxU32 nb)
 	return *this;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *	Main sort routine.
+ *	This one is for unsigned 64-bit values, e.g. two 32-bit keys packed as (primary<<32)|secondary. After the call, mRanks contains a list of indices in sorted order.
+ *	The sort is stable, so the ranks double as the values of a key/value sort.
+ *	\param		input	[in] a list of unsigned 64-bit values to sort
+ *	\param		nb		[in] number of values to sort, must be < 2^31
+ *	\return		Self-Reference
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+RadixSort& RadixSort::Sort(const PxU64* input, PxU32 nb)
+{
+	PX_ASSERT(mHistogram1024);
+	PX_ASSERT(mLinks256);
+	PX_ASSERT(mRanks);
+	PX_ASSERT(mRanks2);
+
+	// Checkings
+	if(!input || !nb || nb&0x80000000)	return *this;
+
+	// Stats
+	mTotalCalls++;
+
+	// Temporal coherence: early exit if the input is already sorted in the previous order
+	{
+		bool AlreadySorted = true;
+		if(INVALID_RANKS)
+		{
+			for(PxU32 i=1;i<nb;i++)
+			{
+				if(input[i]<input[i-1])	{ AlreadySorted = false; break; }
+			}
+			if(AlreadySorted)
+			{
+				mNbHits++;
+				for(PxU32 i=0;i<nb;i++)	mRanks[i] = i;
+				VALIDATE_RANKS;
+				return *this;
+			}
+		}
+		else
+		{
+			for(PxU32 i=1;i<nb;i++)
+			{
+				if(input[mRanks[i]]<input[mRanks[i-1]])	{ AlreadySorted = false; break; }
+			}
+			if(AlreadySorted)	{ mNbHits++; return *this; }
+		}
+	}
+
+	// There are 8 passes but the histogram buffer only holds 4 histograms, so they are created 4 passes at a time.
+	// Digits are extracted with shifts, so this doesn't depend on the byte order.
+	for(PxU32 half=0;half<2;half++)
+	{
+		const PxU32 shift0 = half*32;
+
+		PxMemZero(mHistogram1024, 256*4*sizeof(PxU32));
+		PxU32* PX_RESTRICT h0 = &mHistogram1024[0];
+		PxU32* PX_RESTRICT h1 = &mHistogram1024[256];
+		PxU32* PX_RESTRICT h2 = &mHistogram1024[512];
+		PxU32* PX_RESTRICT h3 = &mHistogram1024[768];
+		for(PxU32 i=0;i<nb;i++)
+		{
+			const PxU32 Val = PxU32(input[i]>>shift0);
+			h0[Val&0xff]++;	h1[(Val>>8)&0xff]++;	h2[(Val>>16)&0xff]++;	h3[Val>>24]++;
+		}
+
+		for(PxU32 j=0;j<4;j++)
+		{
+			const PxU32 shift = shift0 + j*8;
+			const PxU32* PX_RESTRICT CurCount = &mHistogram1024[j<<8];
+
+			// If all values have the same byte, the pass is useless
+			if(CurCount[PxU32(input[0]>>shift)&0xff]==nb)
+				continue;
+
+			PxU32** PX_RESTRICT Links256 = mLinks256;
+
+			// Create offsets
+			Links256[0] = mRanks2;
+			for(PxU32 i=1;i<256;i++)
+				Links256[i] = Links256[i-1] + CurCount[i-1];
+
+			// Perform Radix Sort
+			if(INVALID_RANKS)
+			{
+				for(PxU32 i=0;i<nb;i++)
+					*Links256[PxU32(input[i]>>shift)&0xff]++ = i;
+				VALIDATE_RANKS;
+			}
+			else
+			{
+				PxU32* PX_RESTRICT Indices		= mRanks;
+				PxU32* PX_RESTRICT IndicesEnd	= &mRanks[nb];
+				while(Indices!=IndicesEnd)
+				{
+					const PxU32 id = *Indices++;
+					*Links256[PxU32(input[id]>>shift)&0xff]++ = id;
+				}
+			}
+
+			// Swap pointers for next pass. Valid indices - the most recent ones - are in mRanks after the swap.
+			PxU32* Tmp	= mRanks;	mRanks = mRanks2; mRanks2 = Tmp;
+		}
+	}
+	return *this;
+}
+
 bool RadixSort::SetBuffers(PxU32* ranks0, PxU32* ranks1, PxU32* histogram1024, PxU32** links256)
 {
 	if(!ranks0 || !ranks1 || !histogram1024 || !links256)	return false;
@@ -58,6 +58,7 @@ namespace Cm
 		// Sorting methods
 						RadixSort&		Sort(const PxU32* input, PxU32 nb, RadixHint hint=RADIX_SIGNED);
 						RadixSort&		Sort(const float* input, PxU32 nb);
+						RadixSort&		Sort(const PxU64* input, PxU32 nb);
 
 		//! Access to results. mRanks is a list of indices in sorted order, i.e. in the order you may further process your data
 		PX_FORCE_INLINE	const PxU32*	GetRanks()			const	{ return mRanks;		}
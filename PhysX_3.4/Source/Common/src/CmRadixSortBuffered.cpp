@@ -140,3 +140,30 @@ RadixSortBuffered& RadixSortBuffered::Sort(const float* input2, PxU32 nb)
 	return *this;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *	Main sort routine.
+ *	This one is for unsigned 64-bit values. After the call, mRanks contains a list of indices in sorted order, i.e. in the order you may process your data.
+ *	\param		input	[in] a list of unsigned 64-bit values to sort
+ *	\param		nb		[in] number of values to sort, must be < 2^31
+ *	\return		Self-Reference
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+RadixSortBuffered& RadixSortBuffered::Sort(const PxU64* input, PxU32 nb)
+{
+	// Checkings
+	if(!input || !nb || nb&0x80000000)	return *this;
+
+	// Resize lists if needed
+	CheckResize(nb);
+
+	//Set histogram buffers.
+	PxU32 histogram[1024];
+	PxU32* links[256];
+	mHistogram1024=histogram;
+	mLinks256=links;
+
+	RadixSort::Sort(input,nb);
+	return *this;
+}
+
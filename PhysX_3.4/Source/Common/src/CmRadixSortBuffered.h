@@ -45,6 +45,7 @@ namespace Cm
 
 		RadixSortBuffered&	Sort(const PxU32* input, PxU32 nb, RadixHint hint=RADIX_SIGNED);
 		RadixSortBuffered&	Sort(const float* input, PxU32 nb);
+		RadixSortBuffered&	Sort(const PxU64* input, PxU32 nb);
 
 	private:
 							RadixSortBuffered(const RadixSortBuffered& object);
@@ -32,6 +32,7 @@
 #define PX_FOUNDATION_PSRENDERBUFFER_H
 
 #include "common/PxRenderBuffer.h"
+#include "foundation/PxMemory.h"
 #include "CmPhysXCommon.h"
 #include "PsArray.h"
 #include "PsUserAllocated.h"
@@ -49,9 +50,11 @@ namespace Cm
 		template <typename T>
 		void append(Ps::Array<T>& dst, const T* src, PxU32 count)
 		{
-			dst.reserve(dst.size() + count);
-			for(const T* end=src+count; src<end; ++src)
-				dst.pushBack(*src);
+			if(!count)
+				return;
+			const PxU32 size = dst.size();
+			dst.resizeUninitialized(size + count);
+			PxMemCopy(dst.begin() + size, src, sizeof(T) * count);
 		}
 
 	public:
@@ -82,6 +85,35 @@ namespace Cm
 			append(mTexts, other.getTexts(), other.getNbTexts());
 		}
 
+		// unlike append(), this also copies the strings, so the texts don't point into the other buffer
+		void appendCopy(const RenderBuffer& other)
+		{
+			append(mPoints, other.mPoints.begin(), other.mPoints.size());
+			append(mLines, other.mLines.begin(), other.mLines.size());
+			append(mTriangles, other.mTriangles.begin(), other.mTriangles.size());
+
+			const PxU32 nbTexts = other.mTexts.size();
+			if(!nbTexts)
+				return;
+
+			const char* oldBuf = mCharBuf.begin();
+			const PxU32 charBufSize = mCharBuf.size();
+			mCharBuf.resizeUninitialized(charBufSize + other.mCharBuf.size());
+			const intptr_t diff = mCharBuf.begin() - oldBuf;
+			if(diff)
+			{
+				for(PxU32 i=0; i < mTexts.size(); i++)
+					mTexts[i].string += diff;
+			}
+			PxMemCopy(mCharBuf.begin() + charBufSize, other.mCharBuf.begin(), other.mCharBuf.size());
+
+			const PxU32 textOffset = mTexts.size();
+			append(mTexts, other.mTexts.begin(), nbTexts);
+			const intptr_t otherDiff = (mCharBuf.begin() + charBufSize) - other.mCharBuf.begin();
+			for(PxU32 i=textOffset; i < mTexts.size(); i++)
+				mTexts[i].string += otherDiff;
+		}
+
 		virtual void clear()
 		{
 			mPoints.clear(); 
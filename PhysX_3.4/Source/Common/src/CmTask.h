@@ -32,17 +32,35 @@
 #define PX_PHYSICS_COMMON_TASK
 
 #include "task/PxTask.h"
+#include "task/PxCpuDispatcher.h"
 #include "CmPhysXCommon.h"
 #include "PsUserAllocated.h"
 #include "PsAtomic.h"
 #include "PsMutex.h"
+#include "PsSync.h"
 #include "PsInlineArray.h"
 #include "PsFPU.h"
+#include "PsTime.h"
 
 namespace physx
 {
 namespace Cm
 {
+	// feeds the task statistics of the task manager, see PxSimulationStatistics::taskCpuTime
+	PX_FORCE_INLINE void recordTaskRun(physx::PxTaskManager* tm, PxU64 startTime)
+	{
+#if PX_ENABLE_SIM_STATS
+		if(tm)
+		{
+			const PxU64 duration = Ps::Time::getBootCounterFrequency().toTensOfNanos(Ps::Time::getCurrentCounterValue() - startTime);
+			tm->addTaskRun(PxU32(duration));
+		}
+#else
+		PX_UNUSED(tm);
+		PX_UNUSED(startTime);
+#endif
+	}
+
 	// wrapper around the public PxLightCpuTask
 	// internal SDK tasks should be inherited from
 	// this and override the runInternal() method
@@ -63,7 +81,10 @@ namespace Cm
 #else
 			PX_SIMD_GUARD;
 #endif
+			physx::PxTaskManager* tm = mTm;
+			const PxU64 startTime = Ps::Time::getCurrentCounterValue();
 			runInternal();
+			recordTaskRun(tm, startTime);
 		}
 
 		virtual void runInternal()=0;
@@ -82,7 +103,10 @@ namespace Cm
 #else
 			PX_SIMD_GUARD;
 #endif
+			physx::PxTaskManager* tm = mTm;
+			const PxU64 startTime = Ps::Time::getCurrentCounterValue();
 			runInternal();
+			recordTaskRun(tm, startTime);
 		}
 
 		virtual void runInternal()=0;
@@ -261,6 +285,109 @@ namespace Cm
 		T* mObj;
 	};
 
+	/**
+	\brief Shared state of the jobs started by runParallelJobs() below.
+	*/
+	template<class Job>
+	class ParallelJobs
+	{
+		PX_NOCOPY(ParallelJobs)
+	public:
+		ParallelJobs(Job& job, PxU32 nbJobs, PxU32 nbTasks) : mJob(job), mNbJobs(PxI32(nbJobs)), mNextJob(0), mNbPendingTasks(PxI32(nbTasks)) {}
+
+		void processJobs()
+		{
+			PxI32 index;
+			while((index = physx::shdfnd::atomicIncrement(&mNextJob) - 1) < mNbJobs)
+				mJob(PxU32(index));
+		}
+
+		void onTaskReleased()
+		{
+			if(!physx::shdfnd::atomicDecrement(&mNbPendingTasks))
+				mDone.set();
+		}
+
+		// always goes through the sync, so that the last task is done with it when this returns
+		PX_FORCE_INLINE void waitForTasks()
+		{
+			mDone.wait();
+		}
+
+	private:
+		Job&			mJob;
+		const PxI32		mNbJobs;
+		volatile PxI32	mNextJob;
+		volatile PxI32	mNbPendingTasks;
+		shdfnd::Sync	mDone;
+	};
+
+	/**
+	\brief A task submitted straight to a PxCpuDispatcher, pulling jobs from a ParallelJobs object until none is left.
+	*/
+	template<class Job>
+	class ParallelJobsTask : public physx::PxBaseTask
+	{
+	public:
+		ParallelJobsTask() : mJobs(NULL) {}
+
+		virtual void run()
+		{
+#if PX_SWITCH  // special case because default rounding mode is not nearest
+			PX_FPU_GUARD;
+#else
+			PX_SIMD_GUARD;
+#endif
+			mJobs->processJobs();
+		}
+
+		virtual const char* getName() const { return "Cm::ParallelJobsTask"; }
+
+		// the task is owned by runParallelJobs() and never shared, so there is nothing to count
+		virtual void addReference() {}
+		virtual void removeReference() {}
+		virtual PxI32 getReference() const { return 1; }
+
+		virtual void release() { mJobs->onTaskReleased(); }
+
+		ParallelJobs<Job>*	mJobs;
+	};
+
+	/**
+	\brief Calls job(i) for each i in [0, nbJobs), using the worker threads of a CPU dispatcher.
+
+	This is meant for code running outside of the simulation (e.g. cooking), where no task manager is available: tasks
+	are submitted directly to the dispatcher. The calling thread processes jobs too, then blocks until the dispatcher
+	has released all the submitted tasks, so it must not be one of the dispatcher's worker threads.
+
+	The jobs are claimed in an unspecified order, so job(i) must only write data that belongs to job i. With a NULL
+	dispatcher, or a single job, all jobs run on the calling thread.
+	*/
+	template<class Job>
+	void runParallelJobs(physx::PxCpuDispatcher* dispatcher, PxU32 nbJobs, Job& job)
+	{
+		static const PxU32 MAX_NB_TASKS = 32;
+
+		const PxU32 nbTasks = (dispatcher && nbJobs>1) ? PxMin(PxMin(nbJobs - 1, dispatcher->getWorkerCount()), MAX_NB_TASKS) : 0;
+		if(!nbTasks)
+		{
+			for(PxU32 i=0;i<nbJobs;i++)
+				job(i);
+			return;
+		}
+
+		ParallelJobs<Job> jobs(job, nbJobs, nbTasks);
+		ParallelJobsTask<Job> tasks[MAX_NB_TASKS];
+		for(PxU32 i=0;i<nbTasks;i++)
+		{
+			tasks[i].mJobs = &jobs;
+			dispatcher->submitTask(tasks[i]);
+		}
+
+		jobs.processJobs();
+		jobs.waitForTasks();
+	}
+
 } // namespace Cm
 
 }
@@ -207,6 +207,38 @@ static PX_FORCE_INLINE Vec4V basisExtentV(const PxMat33Padded& basis, const PxVe
 	return extentsV;
 }
 
+static PX_FORCE_INLINE void computeSphereBounds(PxBounds3& bounds, const PxSphereGeometry& shape, const PxTransform& pose, float contactOffset, float inflation)
+{
+	const PxVec3 extents((shape.radius+contactOffset)*inflation);
+	bounds.minimum = pose.p - extents;
+	bounds.maximum = pose.p + extents;
+}
+
+static PX_FORCE_INLINE void computeCapsuleBounds(PxBounds3& bounds, const PxCapsuleGeometry& shape, const PxTransform& pose, float contactOffset, float inflation)
+{
+	const PxVec3 d = pose.q.getBasisVector0();
+	PxVec3 extents;
+	for(PxU32 ax = 0; ax<3; ax++)
+		extents[ax] = (PxAbs(d[ax]) * shape.halfHeight + shape.radius + contactOffset)*inflation;
+	bounds.minimum = pose.p - extents;
+	bounds.maximum = pose.p + extents;
+}
+
+static PX_FORCE_INLINE void computeBoxBounds(PxBounds3& bounds, const PxBoxGeometry& shape, const PxTransform& pose, float contactOffset, float inflation)
+{
+	const Vec3p origin(pose.p);
+
+	const PxMat33Padded basis(pose.q);
+
+	const Vec4V extentsV = basisExtentV(basis, shape.halfExtents, contactOffset, inflation);
+
+	const Vec4V originV = V4LoadU(&origin.x);
+	const Vec4V minV = V4Sub(originV, extentsV);
+	const Vec4V maxV = V4Add(originV, extentsV);
+
+	StoreBounds(bounds, minV, maxV);
+}
+
 void Gu::computeBounds(PxBounds3& bounds, const PxGeometry& geometry, const PxTransform& pose, float contactOffset, const CenterExtentsPadded* PX_RESTRICT localSpaceBounds, float inflation, bool extrudeHeightfields)
 {
 	PX_ASSERT(contactOffset==0.0f || inflation==1.0f);
@@ -220,10 +252,7 @@ void Gu::computeBounds(PxBounds3& bounds, const PxGeometry& geometry, const PxTr
 		{
 			PX_ASSERT(!localSpaceBounds);
 
-			const PxSphereGeometry& shape = static_cast<const PxSphereGeometry&>(geometry);
-			const PxVec3 extents((shape.radius+contactOffset)*inflation);
-			bounds.minimum = pose.p - extents;
-			bounds.maximum = pose.p + extents;
+			computeSphereBounds(bounds, static_cast<const PxSphereGeometry&>(geometry), pose, contactOffset, inflation);
 		}
 		break;
 
@@ -239,13 +268,7 @@ void Gu::computeBounds(PxBounds3& bounds, const PxGeometry& geometry, const PxTr
 		{
 			PX_ASSERT(!localSpaceBounds);
 
-			const PxCapsuleGeometry& shape = static_cast<const PxCapsuleGeometry& >(geometry);
-			const PxVec3 d = pose.q.getBasisVector0();
-			PxVec3 extents;
-			for(PxU32 ax = 0; ax<3; ax++)
-				extents[ax] = (PxAbs(d[ax]) * shape.halfHeight + shape.radius + contactOffset)*inflation;
-			bounds.minimum = pose.p - extents;
-			bounds.maximum = pose.p + extents;
+			computeCapsuleBounds(bounds, static_cast<const PxCapsuleGeometry&>(geometry), pose, contactOffset, inflation);
 		}
 		break;
 
@@ -253,19 +276,7 @@ void Gu::computeBounds(PxBounds3& bounds, const PxGeometry& geometry, const PxTr
 		{
 			PX_ASSERT(!localSpaceBounds);
 
-			const PxBoxGeometry& shape = static_cast<const PxBoxGeometry& >(geometry);
-
-			const Vec3p origin(pose.p);
-
-			const PxMat33Padded basis(pose.q);
-
-			const Vec4V extentsV = basisExtentV(basis, shape.halfExtents, contactOffset, inflation);
-
-			const Vec4V originV = V4LoadU(&origin.x);
-			const Vec4V minV = V4Sub(originV, extentsV);
-			const Vec4V maxV = V4Add(originV, extentsV);
-
-			StoreBounds(bounds, minV, maxV);
+			computeBoxBounds(bounds, static_cast<const PxBoxGeometry&>(geometry), pose, contactOffset, inflation);
 		}
 		break;
 
@@ -396,6 +407,144 @@ void Gu::computeBounds(PxBounds3& bounds, const PxGeometry& geometry, const PxTr
 	}
 }
 
+bool Gu::computeScaledLocalBounds(PxVec3& center, PxVec3& extents, const PxGeometry& geometry)
+{
+	const CenterExtentsPadded* localBounds;
+	const PxMeshScale* scale;
+
+	switch(geometry.getType())
+	{
+		case PxGeometryType::eCONVEXMESH:
+		{
+			const PxConvexMeshGeometry& shape = static_cast<const PxConvexMeshGeometry& >(geometry);
+			if(shape.meshFlags & PxConvexMeshGeometryFlag::eTIGHT_BOUNDS)
+				return false;
+			localBounds = &static_cast<const Gu::ConvexMesh*>(shape.convexMesh)->getHull().getPaddedBounds();
+			scale = &shape.scale;
+		}
+		break;
+
+		case PxGeometryType::eTRIANGLEMESH:
+		{
+			const PxTriangleMeshGeometry& shape = static_cast<const PxTriangleMeshGeometry& >(geometry);
+			localBounds = &static_cast<const Gu::TriangleMesh*>(shape.triangleMesh)->getPaddedBounds();
+			scale = &shape.scale;
+		}
+		break;
+
+		default:
+			return false;
+	}
+
+	// With an axis-aligned scale the scaled box is exactly the box of the scaled mesh bounds. A rotated scale would
+	// give a looser box here than the one computeBounds produces, so we let computeBounds handle that case.
+	if(!scale->rotation.isIdentity())
+		return false;
+
+	center = localBounds->mCenter.multiply(scale->scale);
+	extents = localBounds->mExtents.multiply(scale->scale.abs());
+	return true;
+}
+
+static PX_FORCE_INLINE void computeBoundsFromScaledLocalBoundsInternal(PxBounds3& bounds, const PxVec3& center, const PxVec3& extents, const PxTransform& pose)
+{
+	const PxMat33Padded rot(pose.q);
+
+	// These loads are safe since extents follow center, and the caller guarantees extents are padded
+	const Vec4V centerV = V4LoadU(&center.x);
+	const Vec4V posV = Vec4V_From_Vec3V(V3LoadU(&pose.p.x));
+	const Vec4V originV = V4Add(multiply3x3V(centerV, rot), posV);
+
+	const Vec4V extentsInV = V4LoadU(&extents.x);
+	const Vec4V c0V = V4Scale(V4LoadU(&rot.column0.x), V4GetX(extentsInV));
+	const Vec4V c1V = V4Scale(V4LoadU(&rot.column1.x), V4GetY(extentsInV));
+	const Vec4V c2V = V4Scale(V4LoadU(&rot.column2.x), V4GetZ(extentsInV));
+	Vec4V extentsV = V4Add(V4Abs(c0V), V4Abs(c1V));
+	extentsV = V4Add(extentsV, V4Abs(c2V));
+
+	StoreBounds(bounds, V4Sub(originV, extentsV), V4Add(originV, extentsV));
+}
+
+void Gu::computeBoundsFromScaledLocalBounds(PxBounds3& bounds, const PxVec3& center, const PxVec3& extents, const PxTransform& pose)
+{
+	computeBoundsFromScaledLocalBoundsInternal(bounds, center, extents, pose);
+}
+
+namespace
+{
+	struct SphereBoundsOp
+	{
+		static PX_FORCE_INLINE void compute(PxBounds3& bounds, const BoundsBatchEntry& e)	{ computeSphereBounds(bounds, *static_cast<const PxSphereGeometry*>(e.geometry), *e.pose, 0.0f, 1.0f);		}
+	};
+	struct CapsuleBoundsOp
+	{
+		static PX_FORCE_INLINE void compute(PxBounds3& bounds, const BoundsBatchEntry& e)	{ computeCapsuleBounds(bounds, *static_cast<const PxCapsuleGeometry*>(e.geometry), *e.pose, 0.0f, 1.0f);	}
+	};
+	struct BoxBoundsOp
+	{
+		static PX_FORCE_INLINE void compute(PxBounds3& bounds, const BoundsBatchEntry& e)	{ computeBoxBounds(bounds, *static_cast<const PxBoxGeometry*>(e.geometry), *e.pose, 0.0f, 1.0f);			}
+	};
+	struct ScaledLocalBoundsOp
+	{
+		static PX_FORCE_INLINE void compute(PxBounds3& bounds, const BoundsBatchEntry& e)	{ computeBoundsFromScaledLocalBoundsInternal(bounds, e.scaledLocalBounds[0], e.scaledLocalBounds[1], *e.pose);	}
+	};
+}
+
+// The loop runs 4 entries per iteration and prefetches the poses and outputs of the next group, so that the
+// random accesses into the transform cache and bounds array overlap with the (branch-free) bounds math.
+template<class Op>
+static void computeBoundsBatchT(PxBounds3* PX_RESTRICT bounds, const BoundsBatchEntry* PX_RESTRICT entries, PxU32 nb)
+{
+	const PxU32 nb4 = nb & ~3;
+	PxU32 i = 0;
+	for(; i<nb4; i+=4)
+	{
+		if(i+4<nb)
+		{
+			const PxU32 nbToPrefetch = PxMin(nb - i - 4, 4u);
+			for(PxU32 j=0;j<nbToPrefetch;j++)
+			{
+				Ps::prefetchLine(entries[i+4+j].pose);
+				Ps::prefetchLine(bounds + entries[i+4+j].boundsIndex);
+			}
+		}
+
+		Op::compute(bounds[entries[i+0].boundsIndex], entries[i+0]);
+		Op::compute(bounds[entries[i+1].boundsIndex], entries[i+1]);
+		Op::compute(bounds[entries[i+2].boundsIndex], entries[i+2]);
+		Op::compute(bounds[entries[i+3].boundsIndex], entries[i+3]);
+	}
+	for(; i<nb; i++)
+		Op::compute(bounds[entries[i].boundsIndex], entries[i]);
+}
+
+void Gu::computeBoundsBatch(PxBounds3* PX_RESTRICT bounds, PxGeometryType::Enum type, const BoundsBatchEntry* PX_RESTRICT entries, PxU32 nb, bool extrudeHeightfields)
+{
+	switch(type)
+	{
+		case PxGeometryType::eSPHERE:		computeBoundsBatchT<SphereBoundsOp>(bounds, entries, nb);	break;
+		case PxGeometryType::eCAPSULE:		computeBoundsBatchT<CapsuleBoundsOp>(bounds, entries, nb);	break;
+		case PxGeometryType::eBOX:			computeBoundsBatchT<BoxBoundsOp>(bounds, entries, nb);		break;
+		case PxGeometryType::ePLANE:
+		case PxGeometryType::eCONVEXMESH:
+		case PxGeometryType::eTRIANGLEMESH:
+		case PxGeometryType::eHEIGHTFIELD:
+		{
+			for(PxU32 i=0;i<nb;i++)
+				computeBounds(bounds[entries[i].boundsIndex], *entries[i].geometry, *entries[i].pose, 0.0f, NULL, 1.0f, extrudeHeightfields);
+		}
+		break;
+		case PxGeometryType::eGEOMETRY_COUNT:
+		case PxGeometryType::eINVALID:
+			PX_ASSERT(0);
+	}
+}
+
+void Gu::computeBoundsFromScaledLocalBoundsBatch(PxBounds3* PX_RESTRICT bounds, const BoundsBatchEntry* PX_RESTRICT entries, PxU32 nb)
+{
+	computeBoundsBatchT<ScaledLocalBoundsOp>(bounds, entries, nb);
+}
+
 // PT: TODO: refactor this with regular function
 PxF32 Gu::computeBoundsWithCCDThreshold(Vec3p& origin, Vec3p& extent, const PxGeometry& geometry, const PxTransform& pose, const CenterExtentsPadded* PX_RESTRICT localSpaceBounds)
 {
@@ -60,6 +60,29 @@ PX_PHYSX_COMMON_API void computeBounds(PxBounds3& bounds, const PxGeometry& geom
 //prefetch the local space bounds if localSpaceBounds is NULL.
 PX_PHYSX_COMMON_API PxF32 computeBoundsWithCCDThreshold(Vec3p& origin, Vec3p& extent, const PxGeometry& geometry, const PxTransform& transform, const CenterExtentsPadded* PX_RESTRICT localSpaceBounds);	//AABB in world space.
 
+//Computes the local space bounds of a convex or triangle mesh with its PxMeshScale already applied, so that shapes sharing the same
+//geometry can compute their world space bounds with computeBoundsFromScaledLocalBounds. Returns false when the geometry does not
+//support this (primitives, heightfields, tight convex bounds, or a mesh scale with a non-identity rotation, which would loosen the bounds).
+PX_PHYSX_COMMON_API bool computeScaledLocalBounds(PxVec3& center, PxVec3& extents, const PxGeometry& geometry);
+
+//World space bounds from local bounds computed by computeScaledLocalBounds. 'extents' must be followed by 4 readable bytes (SIMD load).
+PX_PHYSX_COMMON_API void computeBoundsFromScaledLocalBounds(PxBounds3& bounds, const PxVec3& center, const PxVec3& extents, const PxTransform& transform);
+
+//Input of the batched bounds functions below. The result for an entry is written to bounds[boundsIndex].
+struct BoundsBatchEntry
+{
+	const PxGeometry*	geometry;
+	const PxVec3*		scaledLocalBounds;	//center followed by padded extents, only used by computeBoundsFromScaledLocalBoundsBatch
+	const PxTransform*	pose;
+	PxU32				boundsIndex;
+};
+
+//Batched computeBounds for shapes sharing the same geometry type, without contact offset or inflation. Spheres, capsules and boxes
+//use dedicated loops; other types fall back to computeBounds for each entry.
+PX_PHYSX_COMMON_API void computeBoundsBatch(PxBounds3* PX_RESTRICT bounds, PxGeometryType::Enum type, const BoundsBatchEntry* PX_RESTRICT entries, PxU32 nb, bool extrudeHeightfields);
+
+//Batched computeBoundsFromScaledLocalBounds.
+PX_PHYSX_COMMON_API void computeBoundsFromScaledLocalBoundsBatch(PxBounds3* PX_RESTRICT bounds, const BoundsBatchEntry* PX_RESTRICT entries, PxU32 nb);
 
 PX_FORCE_INLINE PxBounds3 computeBounds(const PxGeometry& geometry, const PxTransform& pose, bool extrudeHeightfields)
 {
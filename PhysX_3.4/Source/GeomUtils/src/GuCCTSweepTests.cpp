@@ -278,8 +278,18 @@ float localMinDist = 1.0f;
 
 	PxVec3 bestTriNormal(0.0f);
 
+	// Radius of the box's bounding sphere, for the 4-wide culling
+	const PxReal boundsRadius = box.extents.magnitude();
+	PxU32 cullMask = 0;
+
 	for(PxU32 ii=0;ii<nbTris;ii++)
 	{
+		// Cull the triangles 4 by 4 using the best distance found so far
+		if(!(ii&3))
+			cullMask = nbTris<4 ? 15 : cullTriangles4(triangles, nbTris, ii, idx, box.center, unitDir, localMinDist*distance, boxRadius, boundsRadius, dpc0);
+		if(!(cullMask & (1<<(ii&3))))
+			continue;
+
 		const PxU32 triangleIndex = getTriangleIndex(ii, idx);
 
 		const PxTriangle& tri = triangles[triangleIndex];
@@ -39,6 +39,10 @@
 #include "GuDistancePointSegment.h"
 #include "GuConvexMesh.h"
 #include "GuDistancePointBox.h"
+#include "GuVecBox.h"
+#include "GuVecCapsule.h"
+#include "GuVecConvexHull.h"
+#include "GuGJK.h"
 #include "PsFPU.h"
 #include "PxSphereGeometry.h"
 #include "PxBoxGeometry.h"
@@ -187,6 +191,121 @@ bool PxGeometryQuery::sweep(const PxVec3& unitDir, const PxReal distance,
 	return false;
 }
 
+#if PX_CHECKED
+static bool checkPoses(const PxTransform* poses, const PxU32 nbPoses, const char* msg)
+{
+	for(PxU32 i=0;i<nbPoses;i++)
+	{
+		if(!poses[i].isValid())
+		{
+			Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, msg);
+			return false;
+		}
+	}
+	return true;
+}
+#endif
+
+PxU32 PxGeometryQuery::sweep(const PxVec3& unitDir, const PxReal distance,
+							 const PxGeometry& geom0, const PxTransform* poses0, PxU32 nbPoses,
+							 const PxGeometry& geom1, const PxTransform& pose1,
+							 PxSweepHit* sweepHits, bool* results, PxHitFlags hitFlags,
+							 const PxReal inflation)
+{
+	PX_SIMD_GUARD;
+	PX_CHECK_AND_RETURN_VAL(pose1.isValid(), "PxGeometryQuery::sweep(): pose1 is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(unitDir.isFinite(), "PxGeometryQuery::sweep(): unitDir is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(PxIsFinite(distance), "PxGeometryQuery::sweep(): distance is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL((distance >= 0.0f && !(hitFlags & PxHitFlag::eASSUME_NO_INITIAL_OVERLAP)) || distance > 0.0f,
+		"PxGeometryQuery::sweep(): sweep distance must be >=0 or >0 with eASSUME_NO_INITIAL_OVERLAP.", 0);
+#if PX_CHECKED
+	if(!PxGeometryQuery::isValid(geom0))
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "Provided geometry 0 is not valid");
+		return 0;
+	}
+	if(!PxGeometryQuery::isValid(geom1))
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "Provided geometry 1 is not valid");
+		return 0;
+	}
+	if(!checkPoses(poses0, nbPoses, "PxGeometryQuery::sweep(): poses0 contains an invalid pose."))
+		return 0;
+#endif // PX_CHECKED
+
+	const GeomSweepFuncs& sf = gGeomSweepFuncs;
+	const bool precise = hitFlags & PxHitFlag::ePRECISE_SWEEP;
+
+	PxU32 nbHits = 0;
+	switch(geom0.getType())
+	{
+		case PxGeometryType::eSPHERE:
+		{
+			const PxSphereGeometry& sphereGeom = static_cast<const PxSphereGeometry&>(geom0);
+			const PxCapsuleGeometry capsuleGeom(sphereGeom.radius, 0.0f);
+			const SweepCapsuleFunc func = precise ? sf.preciseCapsuleMap[geom1.getType()] : sf.capsuleMap[geom1.getType()];
+
+			for(PxU32 i=0;i<nbPoses;i++)
+			{
+				const Capsule worldCapsule(poses0[i].p, poses0[i].p, sphereGeom.radius);
+				results[i] = func(geom1, pose1, capsuleGeom, poses0[i], worldCapsule, unitDir, distance, sweepHits[i], hitFlags, inflation);
+				nbHits += PxU32(results[i]);
+			}
+			break;
+		}
+
+		case PxGeometryType::eCAPSULE:
+		{
+			const PxCapsuleGeometry& capsuleGeom = static_cast<const PxCapsuleGeometry&>(geom0);
+			const SweepCapsuleFunc func = precise ? sf.preciseCapsuleMap[geom1.getType()] : sf.capsuleMap[geom1.getType()];
+
+			for(PxU32 i=0;i<nbPoses;i++)
+			{
+				Capsule worldCapsule;
+				getCapsule(worldCapsule, capsuleGeom, poses0[i]);
+				results[i] = func(geom1, pose1, capsuleGeom, poses0[i], worldCapsule, unitDir, distance, sweepHits[i], hitFlags, inflation);
+				nbHits += PxU32(results[i]);
+			}
+			break;
+		}
+
+		case PxGeometryType::eBOX:
+		{
+			const PxBoxGeometry& boxGeom = static_cast<const PxBoxGeometry&>(geom0);
+			const SweepBoxFunc func = precise ? sf.preciseBoxMap[geom1.getType()] : sf.boxMap[geom1.getType()];
+
+			for(PxU32 i=0;i<nbPoses;i++)
+			{
+				Box box;
+				buildFrom(box, poses0[i].p, boxGeom.halfExtents, poses0[i].q);
+				results[i] = func(geom1, pose1, boxGeom, poses0[i], box, unitDir, distance, sweepHits[i], hitFlags, inflation);
+				nbHits += PxU32(results[i]);
+			}
+			break;
+		}
+
+		case PxGeometryType::eCONVEXMESH:
+		{
+			const PxConvexMeshGeometry& convexGeom = static_cast<const PxConvexMeshGeometry&>(geom0);
+			const SweepConvexFunc func = sf.convexMap[geom1.getType()];
+
+			for(PxU32 i=0;i<nbPoses;i++)
+			{
+				results[i] = func(geom1, pose1, convexGeom, poses0[i], unitDir, distance, sweepHits[i], hitFlags, inflation);
+				nbHits += PxU32(results[i]);
+			}
+			break;
+		}
+		case PxGeometryType::ePLANE:
+		case PxGeometryType::eTRIANGLEMESH:
+		case PxGeometryType::eHEIGHTFIELD:
+		case PxGeometryType::eGEOMETRY_COUNT:
+		case PxGeometryType::eINVALID:
+			PX_CHECK_MSG(false, "PxGeometryQuery::sweep(): first geometry object parameter must be sphere, capsule, box or convex geometry.");
+	}
+	return nbHits;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 bool PxGeometryQuery::overlap(	const PxGeometry& geom0, const PxTransform& pose0,
@@ -196,6 +315,265 @@ bool PxGeometryQuery::overlap(	const PxGeometry& geom0, const PxTransform& pose0
 	return Gu::overlap(geom0, pose0, geom1, pose1, gGeomOverlapMethodTable);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+// Sphere vs. {sphere, capsule, box}, four sphere centers at a time. Everything happens in the local frame of geom1, where the three
+// shapes are boxes with (possibly zero) extents inflated by a radius: a capsule is a box of extents (halfHeight, 0, 0).
+static PxU32 overlapSpheres(const PxReal radius0, const PxTransform* PX_RESTRICT poses0, const PxU32 nbPoses,
+							const PxGeometry& geom1, const PxTransform& pose1, bool* PX_RESTRICT results)
+{
+	using namespace Ps::aos;
+
+	PxVec3 extents(0.0f);
+	PxReal radius = radius0;
+	switch(geom1.getType())
+	{
+		case PxGeometryType::eSPHERE:
+			radius += static_cast<const PxSphereGeometry&>(geom1).radius;
+			break;
+		case PxGeometryType::eCAPSULE:
+		{
+			const PxCapsuleGeometry& capsuleGeom = static_cast<const PxCapsuleGeometry&>(geom1);
+			extents.x = capsuleGeom.halfHeight;
+			radius += capsuleGeom.radius;
+			break;
+		}
+		case PxGeometryType::eBOX:
+			extents = static_cast<const PxBoxGeometry&>(geom1).halfExtents;
+			break;
+		case PxGeometryType::ePLANE:
+		case PxGeometryType::eCONVEXMESH:
+		case PxGeometryType::eTRIANGLEMESH:
+		case PxGeometryType::eHEIGHTFIELD:
+		case PxGeometryType::eGEOMETRY_COUNT:
+		case PxGeometryType::eINVALID:
+			PX_ASSERT(0);
+			return 0;
+	}
+	const PxReal radius2 = radius*radius;
+	const PxMat33 rot(pose1.q);
+
+	PxU32 nbOverlaps = 0;
+	PxU32 i = 0;
+	if(nbPoses>=4)
+	{
+		const Vec4V px = V4Load(pose1.p.x);
+		const Vec4V py = V4Load(pose1.p.y);
+		const Vec4V pz = V4Load(pose1.p.z);
+		const Vec4V ex = V4Load(extents.x);
+		const Vec4V ey = V4Load(extents.y);
+		const Vec4V ez = V4Load(extents.z);
+		const Vec4V r2 = V4Load(radius2);
+
+		for(;i+4<=nbPoses;i+=4)
+		{
+			Vec4V x = Vec4V_From_Vec3V(V3LoadU(poses0[i+0].p));
+			Vec4V y = Vec4V_From_Vec3V(V3LoadU(poses0[i+1].p));
+			Vec4V z = Vec4V_From_Vec3V(V3LoadU(poses0[i+2].p));
+			Vec4V w = Vec4V_From_Vec3V(V3LoadU(poses0[i+3].p));
+			V4Transpose(x, y, z, w);
+
+			const Vec4V dx = V4Sub(x, px);
+			const Vec4V dy = V4Sub(y, py);
+			const Vec4V dz = V4Sub(z, pz);
+
+			// delta in geom1 space (transposed rotation)
+			const Vec4V lx = V4MulAdd(dz, V4Load(rot.column0.z), V4MulAdd(dy, V4Load(rot.column0.y), V4Mul(dx, V4Load(rot.column0.x))));
+			const Vec4V ly = V4MulAdd(dz, V4Load(rot.column1.z), V4MulAdd(dy, V4Load(rot.column1.y), V4Mul(dx, V4Load(rot.column1.x))));
+			const Vec4V lz = V4MulAdd(dz, V4Load(rot.column2.z), V4MulAdd(dy, V4Load(rot.column2.y), V4Mul(dx, V4Load(rot.column2.x))));
+
+			const Vec4V cx = V4Sub(lx, V4Clamp(lx, V4Neg(ex), ex));
+			const Vec4V cy = V4Sub(ly, V4Clamp(ly, V4Neg(ey), ey));
+			const Vec4V cz = V4Sub(lz, V4Clamp(lz, V4Neg(ez), ez));
+
+			const Vec4V d2 = V4MulAdd(cz, cz, V4MulAdd(cy, cy, V4Mul(cx, cx)));
+
+			// PT: objects are defined as closed, so we return 'true' in case of equality
+			const PxU32 mask = BGetBitMask(V4IsGrtrOrEq(r2, d2));
+			results[i+0] = (mask & 1)!=0;
+			results[i+1] = (mask & 2)!=0;
+			results[i+2] = (mask & 4)!=0;
+			results[i+3] = (mask & 8)!=0;
+			nbOverlaps += Ps::bitCount(mask);
+		}
+	}
+
+	for(;i<nbPoses;i++)
+	{
+		const PxVec3 local = rot.transformTranspose(poses0[i].p - pose1.p);
+		const PxVec3 clipped(	local.x - PxClamp(local.x, -extents.x, extents.x),
+								local.y - PxClamp(local.y, -extents.y, extents.y),
+								local.z - PxClamp(local.z, -extents.z, extents.z));
+		results[i] = clipped.magnitudeSquared() <= radius2;
+		nbOverlaps += PxU32(results[i]);
+	}
+	return nbOverlaps;
+}
+
+// GJK overlap of convexA at each of poses0 against convexB, both support mappings being set up once for the batch
+template<class ConvexA, class ConvexB>
+static PxU32 overlapGJK(const ConvexA& convexA, const PxTransform* PX_RESTRICT poses0, const PxU32 nbPoses,
+						const ConvexB& convexB, const PxTransform& pose1, bool* PX_RESTRICT results)
+{
+	using namespace Ps::aos;
+
+	const PsTransformV transf1(V3LoadU(pose1.p), QuatVLoadU(&pose1.q.x));
+	const LocalConvex<ConvexB> localB(convexB);
+
+	PxU32 nbOverlaps = 0;
+	for(PxU32 i=0;i<nbPoses;i++)
+	{
+		const PsTransformV transf0(V3LoadU(poses0[i].p), QuatVLoadU(&poses0[i].q.x));
+		const PsMatTransformV aToB(transf1.transformInv(transf0));
+		const RelativeConvex<ConvexA> relativeA(convexA, aToB);
+
+		Vec3V contactA, contactB, normal;
+		FloatV dist;
+		const bool overlap = gjk(relativeA, localB, aToB.p, FZero(), contactA, contactB, normal, dist) == GJK_CONTACT;
+		results[i] = overlap;
+		nbOverlaps += PxU32(overlap);
+	}
+	return nbOverlaps;
+}
+
+template<class ConvexA>
+static PxU32 overlapGJKShape1(const ConvexA& convexA, const PxTransform* PX_RESTRICT poses0, const PxU32 nbPoses,
+							  const PxGeometry& geom1, const PxTransform& pose1, bool* PX_RESTRICT results)
+{
+	using namespace Ps::aos;
+	const Vec3V zeroV = V3Zero();
+
+	switch(geom1.getType())
+	{
+		case PxGeometryType::eSPHERE:
+		{
+			const CapsuleV sphere(zeroV, FLoad(static_cast<const PxSphereGeometry&>(geom1).radius));
+			return overlapGJK(convexA, poses0, nbPoses, sphere, pose1, results);
+		}
+		case PxGeometryType::eCAPSULE:
+		{
+			const PxCapsuleGeometry& capsuleGeom = static_cast<const PxCapsuleGeometry&>(geom1);
+			const CapsuleV capsule(zeroV, V3Scale(V3UnitX(), FLoad(capsuleGeom.halfHeight)), FLoad(capsuleGeom.radius));
+			return overlapGJK(convexA, poses0, nbPoses, capsule, pose1, results);
+		}
+		case PxGeometryType::eBOX:
+		{
+			const BoxV box(zeroV, V3LoadU(static_cast<const PxBoxGeometry&>(geom1).halfExtents));
+			return overlapGJK(convexA, poses0, nbPoses, box, pose1, results);
+		}
+		case PxGeometryType::eCONVEXMESH:
+		{
+			const PxConvexMeshGeometry& convexGeom = static_cast<const PxConvexMeshGeometry&>(geom1);
+			const ConvexMesh* cm = static_cast<const ConvexMesh*>(convexGeom.convexMesh);
+			const Vec3V vScale = V3LoadU_SafeReadW(convexGeom.scale.scale);	// PT: safe because 'rotation' follows 'scale' in PxMeshScale
+			const QuatV vQuat = QuatVLoadU(&convexGeom.scale.rotation.x);
+			const ConvexHullV convexHull(&cm->getHull(), zeroV, vScale, vQuat, convexGeom.scale.isIdentity());
+			return overlapGJK(convexA, poses0, nbPoses, convexHull, pose1, results);
+		}
+		case PxGeometryType::ePLANE:
+		case PxGeometryType::eTRIANGLEMESH:
+		case PxGeometryType::eHEIGHTFIELD:
+		case PxGeometryType::eGEOMETRY_COUNT:
+		case PxGeometryType::eINVALID:
+			break;
+	}
+	PX_ASSERT(0);
+	return 0;
+}
+
+static PxU32 overlapGJKShape0(const PxGeometry& geom0, const PxTransform* PX_RESTRICT poses0, const PxU32 nbPoses,
+							  const PxGeometry& geom1, const PxTransform& pose1, bool* PX_RESTRICT results)
+{
+	using namespace Ps::aos;
+	const Vec3V zeroV = V3Zero();
+
+	switch(geom0.getType())
+	{
+		case PxGeometryType::eSPHERE:
+		{
+			const CapsuleV sphere(zeroV, FLoad(static_cast<const PxSphereGeometry&>(geom0).radius));
+			return overlapGJKShape1(sphere, poses0, nbPoses, geom1, pose1, results);
+		}
+		case PxGeometryType::eCAPSULE:
+		{
+			const PxCapsuleGeometry& capsuleGeom = static_cast<const PxCapsuleGeometry&>(geom0);
+			const CapsuleV capsule(zeroV, V3Scale(V3UnitX(), FLoad(capsuleGeom.halfHeight)), FLoad(capsuleGeom.radius));
+			return overlapGJKShape1(capsule, poses0, nbPoses, geom1, pose1, results);
+		}
+		case PxGeometryType::eBOX:
+		{
+			const BoxV box(zeroV, V3LoadU(static_cast<const PxBoxGeometry&>(geom0).halfExtents));
+			return overlapGJKShape1(box, poses0, nbPoses, geom1, pose1, results);
+		}
+		case PxGeometryType::eCONVEXMESH:
+		{
+			const PxConvexMeshGeometry& convexGeom = static_cast<const PxConvexMeshGeometry&>(geom0);
+			const ConvexMesh* cm = static_cast<const ConvexMesh*>(convexGeom.convexMesh);
+			const Vec3V vScale = V3LoadU_SafeReadW(convexGeom.scale.scale);	// PT: safe because 'rotation' follows 'scale' in PxMeshScale
+			const QuatV vQuat = QuatVLoadU(&convexGeom.scale.rotation.x);
+			const ConvexHullV convexHull(&cm->getHull(), zeroV, vScale, vQuat, convexGeom.scale.isIdentity());
+			return overlapGJKShape1(convexHull, poses0, nbPoses, geom1, pose1, results);
+		}
+		case PxGeometryType::ePLANE:
+		case PxGeometryType::eTRIANGLEMESH:
+		case PxGeometryType::eHEIGHTFIELD:
+		case PxGeometryType::eGEOMETRY_COUNT:
+		case PxGeometryType::eINVALID:
+			break;
+	}
+	PX_ASSERT(0);
+	return 0;
+}
+
+static PX_FORCE_INLINE bool isGJKType(const PxGeometryType::Enum type)
+{
+	return type==PxGeometryType::eSPHERE || type==PxGeometryType::eCAPSULE || type==PxGeometryType::eBOX || type==PxGeometryType::eCONVEXMESH;
+}
+
+PxU32 PxGeometryQuery::overlap(	const PxGeometry& geom0, const PxTransform* poses0, PxU32 nbPoses,
+								const PxGeometry& geom1, const PxTransform& pose1,
+								bool* results)
+{
+	PX_SIMD_GUARD;
+	PX_CHECK_AND_RETURN_VAL(pose1.isValid(), "PxGeometryQuery::overlap(): pose1 is not valid.", 0);
+#if PX_CHECKED
+	if(!checkPoses(poses0, nbPoses, "PxGeometryQuery::overlap(): poses0 contains an invalid pose."))
+		return 0;
+#endif
+
+	const PxGeometryType::Enum type0 = geom0.getType();
+	const PxGeometryType::Enum type1 = geom1.getType();
+
+	if(type0==PxGeometryType::eSPHERE && (type1==PxGeometryType::eSPHERE || type1==PxGeometryType::eCAPSULE || type1==PxGeometryType::eBOX))
+		return overlapSpheres(static_cast<const PxSphereGeometry&>(geom0).radius, poses0, nbPoses, geom1, pose1, results);
+
+	if((type0==PxGeometryType::eCONVEXMESH || type1==PxGeometryType::eCONVEXMESH) && isGJKType(type0) && isGJKType(type1))
+		return overlapGJKShape0(geom0, poses0, nbPoses, geom1, pose1, results);
+
+	PxU32 nbOverlaps = 0;
+	if(type0 > type1)
+	{
+		const GeomOverlapFunc overlapFunc = gGeomOverlapMethodTable[type1][type0];
+		PX_ASSERT(overlapFunc);
+		for(PxU32 i=0;i<nbPoses;i++)
+		{
+			results[i] = overlapFunc(geom1, pose1, geom0, poses0[i], NULL);
+			nbOverlaps += PxU32(results[i]);
+		}
+	}
+	else
+	{
+		const GeomOverlapFunc overlapFunc = gGeomOverlapMethodTable[type0][type1];
+		PX_ASSERT(overlapFunc);
+		for(PxU32 i=0;i<nbPoses;i++)
+		{
+			results[i] = overlapFunc(geom0, poses0[i], geom1, pose1, NULL);
+			nbOverlaps += PxU32(results[i]);
+		}
+	}
+	return nbOverlaps;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 PxU32 PxGeometryQuery::raycast(	const PxVec3& rayOrigin, const PxVec3& rayDir,
 								const PxGeometry& geom, const PxTransform& pose,
@@ -214,6 +592,35 @@ PxU32 PxGeometryQuery::raycast(	const PxVec3& rayOrigin, const PxVec3& rayDir,
 	return func(geom, pose, rayOrigin, rayDir, maxDist, hitFlags, maxHits, rayHits);
 }
 
+PxU32 PxGeometryQuery::raycast(	const PxVec3* rayOrigins, const PxVec3* rayDirs, PxU32 nbRays,
+								const PxGeometry& geom, const PxTransform& pose,
+								PxReal maxDist, PxHitFlags hitFlags,
+								PxRaycastHit* PX_RESTRICT rayHits, bool* results)
+{
+	PX_SIMD_GUARD;
+	PX_CHECK_AND_RETURN_VAL(pose.isValid(), "PxGeometryQuery::raycast(): pose is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(maxDist >= 0.0f, "PxGeometryQuery::raycast(): maxDist is negative.", 0);
+	PX_CHECK_AND_RETURN_VAL(PxIsFinite(maxDist), "PxGeometryQuery::raycast(): maxDist is not valid.", 0);
+#if PX_CHECKED
+	for(PxU32 i=0;i<nbRays;i++)
+	{
+		PX_CHECK_AND_RETURN_VAL(rayDirs[i].isFinite(), "PxGeometryQuery::raycast(): rayDir is not valid.", 0);
+		PX_CHECK_AND_RETURN_VAL(rayOrigins[i].isFinite(), "PxGeometryQuery::raycast(): rayOrigin is not valid.", 0);
+		PX_CHECK_AND_RETURN_VAL(PxAbs(rayDirs[i].magnitudeSquared()-1)<1e-4f, "PxGeometryQuery::raycast(): ray direction must be unit vector.", 0);
+	}
+#endif
+
+	const RaycastFunc func = gRaycastMap[geom.getType()];
+
+	PxU32 nbHits = 0;
+	for(PxU32 i=0;i<nbRays;i++)
+	{
+		results[i] = func(geom, pose, rayOrigins[i], rayDirs[i], maxDist, hitFlags, 1, rayHits + i)!=0;
+		nbHits += PxU32(results[i]);
+	}
+	return nbHits;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 bool pointConvexDistance(PxVec3& normal_, PxVec3& closestPoint_, PxReal& sqDistance, const PxVec3& pt, const ConvexMesh* convexMesh, const PxMeshScale& meshScale, const PxTransform& convexPose);
@@ -349,3 +756,43 @@ bool PxGeometryQuery::computePenetration(	PxVec3& mtd, PxF32& depth,
 		return mtdFunc(mtd, depth, geom0, pose0, geom1, pose1);
 	}
 }
+
+PxU32 PxGeometryQuery::computePenetration(	PxVec3* mtds, PxF32* depths,
+											const PxGeometry& geom0, const PxTransform* poses0, PxU32 nbPoses,
+											const PxGeometry& geom1, const PxTransform& pose1,
+											bool* results)
+{
+	PX_SIMD_GUARD;
+	PX_CHECK_AND_RETURN_VAL(pose1.isValid(), "PxGeometryQuery::computePenetration(): pose1 is not valid.", 0);
+#if PX_CHECKED
+	if(!checkPoses(poses0, nbPoses, "PxGeometryQuery::computePenetration(): poses0 contains an invalid pose."))
+		return 0;
+#endif
+
+	PxU32 nbOverlaps = 0;
+	if(geom0.getType() > geom1.getType())
+	{
+		GeomMTDFunc mtdFunc = gGeomMTDMethodTable[geom1.getType()][geom0.getType()];
+		PX_ASSERT(mtdFunc);
+		for(PxU32 i=0;i<nbPoses;i++)
+		{
+			results[i] = mtdFunc(mtds[i], depths[i], geom1, pose1, geom0, poses0[i]);
+			if(results[i])
+			{
+				mtds[i] = -mtds[i];
+				nbOverlaps++;
+			}
+		}
+	}
+	else
+	{
+		GeomMTDFunc mtdFunc = gGeomMTDMethodTable[geom0.getType()][geom1.getType()];
+		PX_ASSERT(mtdFunc);
+		for(PxU32 i=0;i<nbPoses;i++)
+		{
+			results[i] = mtdFunc(mtds[i], depths[i], geom0, poses0[i], geom1, pose1);
+			nbOverlaps += PxU32(results[i]);
+		}
+	}
+	return nbOverlaps;
+}
@@ -144,70 +144,13 @@ PxTriangleMesh* GuMeshFactory::createTriangleMesh(void* data)
 	return createTriangleMesh(*reinterpret_cast<TriangleMeshData*>(data));
 }
 
-static TriangleMeshData* loadMeshData(PxInputStream& stream)
+//TODO: stop support for format conversion on load!!
+static void readMeshIndices(PxU32 serialFlags, void* tris, PxU32 nbIndices, bool has16BitIndices, bool mismatch, PxInputStream& stream)
 {
-	// Import header
-	PxU32 version;
-	bool mismatch;
-	if(!readHeader('M', 'E', 'S', 'H', version, mismatch, stream))
-		return NULL;
-
-	PxU32 midphaseID = PxMeshMidPhase::eBVH33;	// Default before version 14
-	if(version>=14)	// this refers to PX_MESH_VERSION
-	{
-		midphaseID = readDword(mismatch, stream);
-	}
-
-	// Check if old (incompatible) mesh format is loaded
-	if (version <= 9) // this refers to PX_MESH_VERSION
-	{
-		Ps::getFoundation().error(PxErrorCode::eINTERNAL_ERROR, __FILE__, __LINE__, "Loading triangle mesh failed: "
-			"Deprecated mesh cooking format. Please recook your mesh in a new cooking format.");
-		PX_ALWAYS_ASSERT_MESSAGE("Obsolete cooked mesh found. Mesh version has been updated, please recook your meshes.");
-		return NULL;
-	}
-
-	// Import serialization flags
-	const PxU32 serialFlags = readDword(mismatch, stream);
-
-	// Import misc values	
-	if (version <= 12) // this refers to PX_MESH_VERSION
-	{
-		// convexEdgeThreshold was removed in 3.4.0
-		readFloat(mismatch, stream);		
-	}
-
-	TriangleMeshData* data;
-	if(midphaseID==PxMeshMidPhase::eBVH33)
-		data = PX_NEW(RTreeTriangleData);
-	else if(midphaseID==PxMeshMidPhase::eBVH34)
-		data = PX_NEW(BV4TriangleData);
-	else return NULL;
-
-	// Import mesh
-	PxVec3* verts = data->allocateVertices(readDword(mismatch, stream));
-	const PxU32 nbTris = readDword(mismatch, stream);
-	bool force32 = (serialFlags & (IMSF_8BIT_INDICES|IMSF_16BIT_INDICES)) == 0;
-
-	//ML: this will allocate CPU triangle indices and GPU triangle indices if we have GRB data built
-	void* tris = data->allocateTriangles(nbTris, force32, serialFlags & IMSF_GRB_DATA);
-
-	stream.read(verts, sizeof(PxVec3)*data->mNbVertices);
-	if(mismatch)
-	{
-		for(PxU32 i=0;i<data->mNbVertices;i++)
-		{
-			flip(verts[i].x);
-			flip(verts[i].y);
-			flip(verts[i].z);
-		}
-	}
-	//TODO: stop support for format conversion on load!!
-	const PxU32 nbIndices = 3*data->mNbTriangles;
 	if(serialFlags & IMSF_8BIT_INDICES)
 	{
 		PxU8 x;
-		if(data->has16BitIndices())
+		if(has16BitIndices)
 		{
 			PxU16* tris16 = reinterpret_cast<PxU16*>(tris);
 			for(PxU32 i=0;i<nbIndices;i++)
@@ -228,7 +171,7 @@ static TriangleMeshData* loadMeshData(PxInputStream& stream)
 	}
 	else if(serialFlags & IMSF_16BIT_INDICES)
 	{
-		if(data->has16BitIndices())
+		if(has16BitIndices)
 		{
 			PxU16* tris16 = reinterpret_cast<PxU16*>(tris);
 			stream.read(tris16, nbIndices*sizeof(PxU16));
@@ -255,7 +198,7 @@ static TriangleMeshData* loadMeshData(PxInputStream& stream)
 	}
 	else
 	{
-		if(data->has16BitIndices())
+		if(has16BitIndices)
 		{
 			PxU32 x;
 			PxU16* tris16 = reinterpret_cast<PxU16*>(tris);
@@ -279,53 +222,272 @@ static TriangleMeshData* loadMeshData(PxInputStream& stream)
 			}
 		}
 	}
+}
 
-	if(serialFlags & IMSF_MATERIALS)
+// The compressed mesh is stored with its runtime layout, each array converted with its own type. In place, it can
+// be referenced as a whole.
+static bool loadCompressedMesh(TriangleMeshData& data, PxU32 nbVerts, PxU32 nbTris, bool mismatch, PxInputStream& stream, MemoryInputStream* inPlace)
+{
+	const PxU32 size = readDword(mismatch, stream);
+	if(size<sizeof(CompressedMesh))
+		return false;
+
+	CompressedMesh* compressed = inPlace ? reinterpret_cast<CompressedMesh*>(inPlace->referenceArray<PxU8>(size, 4)) : NULL;
+	if(compressed)
 	{
-		PxU16* materials = data->allocateMaterials();
-		stream.read(materials, sizeof(PxU16)*data->mNbTriangles);
+		data.mUserArrays |= IPMA_COMPRESSED;
+	}
+	else
+	{
+		compressed = reinterpret_cast<CompressedMesh*>(PX_ALLOC(size, "CompressedMesh"));
+		if(stream.read(compressed, size)!=size)
+		{
+			PX_FREE(compressed);
+			return false;
+		}
 		if(mismatch)
 		{
-			for(PxU32 i=0;i<data->mNbTriangles;i++)
-				flip(materials[i]);
+			PxU32* header = reinterpret_cast<PxU32*>(compressed);
+			for(PxU32 i=0;i<sizeof(CompressedMesh)/sizeof(PxU32);i++)
+				flip(header[i]);
+		}
+	}
+	data.mCompressed = compressed;
+
+	if(compressed->mSize!=size || !compressed->isValid(nbVerts, nbTris))
+		return false;
+
+	if(mismatch)
+	{
+		PxF32* blocks = &compressed->getVertexBlocks()->mMin.x;
+		const PxU32 nbFloats = CompressedMesh::getNbVertexBlocks(nbVerts)*sizeof(QuantizedVertexBlock)/sizeof(PxF32);
+		for(PxU32 i=0;i<nbFloats;i++)
+			flip(blocks[i]);
+
+		PxU16* quantized = compressed->getQuantizedVertices();
+		for(PxU32 i=0;i<nbVerts*3;i++)
+			flip(quantized[i]);
+
+		if(compressed->hasIndices())
+		{
+			PxU32* bases = compressed->getTriangleBases();
+			for(PxU32 i=0;i<CompressedMesh::getNbTriangleBlocks(nbTris);i++)
+				flip(bases[i]);
+
+			PxU16* offsets = compressed->getTriangleOffsets();
+			for(PxU32 i=0;i<nbTris*3;i++)
+				flip(offsets[i]);
+		}
+	}
+
+	data.mNbVertices = nbVerts;
+	return true;
+}
+
+static TriangleMeshData* loadMeshData(PxInputStream& stream, MemoryInputStream* inPlace)
+{
+	// Import header
+	PxU32 version;
+	bool mismatch;
+	if(!readHeader('M', 'E', 'S', 'H', version, mismatch, stream))
+		return NULL;
+
+	PxU32 midphaseID = PxMeshMidPhase::eBVH33;	// Default before version 14
+	if(version>=14)	// this refers to PX_MESH_VERSION
+	{
+		midphaseID = readDword(mismatch, stream);
+	}
+
+	// Check if old (incompatible) mesh format is loaded
+	if (version <= 9) // this refers to PX_MESH_VERSION
+	{
+		Ps::getFoundation().error(PxErrorCode::eINTERNAL_ERROR, __FILE__, __LINE__, "Loading triangle mesh failed: "
+			"Deprecated mesh cooking format. Please recook your mesh in a new cooking format.");
+		PX_ALWAYS_ASSERT_MESSAGE("Obsolete cooked mesh found. Mesh version has been updated, please recook your meshes.");
+		return NULL;
+	}
+
+	// Import serialization flags
+	const PxU32 serialFlags = readDword(mismatch, stream);
+
+	// Import misc values	
+	if (version <= 12) // this refers to PX_MESH_VERSION
+	{
+		// convexEdgeThreshold was removed in 3.4.0
+		readFloat(mismatch, stream);		
+	}
+
+	TriangleMeshData* data;
+	if(midphaseID==PxMeshMidPhase::eBVH33)
+		data = PX_NEW(RTreeTriangleData);
+	else if(midphaseID==PxMeshMidPhase::eBVH34)
+		data = PX_NEW(BV4TriangleData);
+	else return NULL;
+
+	// Arrays stored with the runtime layout can reference the user's memory directly, as long as they are properly
+	// aligned and need no endian conversion. Everything else falls back to the regular copying code.
+	if(mismatch)
+		inPlace = NULL;
+
+	// Import mesh
+	const PxU32 nbVerts = readDword(mismatch, stream);
+	const PxU32 nbTris = readDword(mismatch, stream);
+	bool force32 = (serialFlags & (IMSF_8BIT_INDICES|IMSF_16BIT_INDICES)) == 0;
+
+	PxVec3* verts = NULL;
+	if(serialFlags & IMSF_COMPRESSED)
+	{
+		// compressed meshes are only cooked for BVH34 and without GPU data
+		if(midphaseID!=PxMeshMidPhase::eBVH34 || (serialFlags & IMSF_GRB_DATA) || !loadCompressedMesh(*data, nbVerts, nbTris, mismatch, stream, inPlace))
+		{
+			Ps::getFoundation().error(PxErrorCode::eINTERNAL_ERROR, __FILE__, __LINE__, "Compressed mesh data load error.");
+			PX_DELETE(data);
+			return NULL;
+		}
+	}
+	else
+	{
+		// vertices are followed by indices in the stream, so it is safe to V4Load the last vertex in place
+		verts = inPlace ? inPlace->referenceArray<PxVec3>(nbVerts, 4) : NULL;
+		if(verts)
+		{
+			data->mVertices = verts;
+			data->mNbVertices = nbVerts;
+			data->mUserArrays |= IPMA_VERTICES;
+		}
+		else
+		{
+			verts = data->allocateVertices(nbVerts);
+			stream.read(verts, sizeof(PxVec3)*data->mNbVertices);
+			if(mismatch)
+			{
+				for(PxU32 i=0;i<data->mNbVertices;i++)
+				{
+					flip(verts[i].x);
+					flip(verts[i].y);
+					flip(verts[i].z);
+				}
+			}
+		}
+	}
+
+	const PxU32 nbIndices = 3*nbTris;
+	void* tris = NULL;
+	const bool compressedIndices = data->mCompressed && data->mCompressed->hasIndices();
+	if(inPlace && !compressedIndices)
+	{
+		// indices are only referenced when the stored width matches the runtime one (see allocateTriangles)
+		const bool index16 = nbVerts <= 0xffff && !force32;
+		if(index16 && (serialFlags & IMSF_16BIT_INDICES))
+			tris = inPlace->referenceArray<PxU16>(nbIndices, 2);
+		else if(!index16 && force32)
+			tris = inPlace->referenceArray<PxU32>(nbIndices, 4);
+
+		if(tris)
+		{
+			if(index16)
+				data->mFlags |= PxTriangleMeshFlag::e16_BIT_INDICES;
+			data->mTriangles = tris;
+			data->mNbTriangles = nbTris;
+			data->mUserArrays |= IPMA_TRIANGLES;
+			if(serialFlags & IMSF_GRB_DATA)
+				data->mGRB_triIndices = PX_ALLOC(nbIndices * (index16 ? sizeof(PxU16) : sizeof(PxU32)), "mGRB_triIndices");
+		}
+	}
+
+	if(compressedIndices)
+	{
+		// the indices are part of the compressed mesh, always decoded as 32-bit
+		data->mNbTriangles = nbTris;
+	}
+	else if(!tris)
+	{
+		//ML: this will allocate CPU triangle indices and GPU triangle indices if we have GRB data built
+		tris = data->allocateTriangles(nbTris, force32, serialFlags & IMSF_GRB_DATA);
+		readMeshIndices(serialFlags, tris, nbIndices, data->has16BitIndices(), mismatch, stream);
+	}
+
+	if(serialFlags & IMSF_MATERIALS)
+	{
+		PxU16* materials = inPlace ? inPlace->referenceArray<PxU16>(data->mNbTriangles, 2) : NULL;
+		if(materials)
+		{
+			data->mMaterialIndices = materials;
+			data->mUserArrays |= IPMA_MATERIALS;
+		}
+		else
+		{
+			materials = data->allocateMaterials();
+			stream.read(materials, sizeof(PxU16)*data->mNbTriangles);
+			if(mismatch)
+			{
+				for(PxU32 i=0;i<data->mNbTriangles;i++)
+					flip(materials[i]);
+			}
 		}
 	}
 	if(serialFlags & IMSF_FACE_REMAP)
 	{
-		PxU32* remap = data->allocateFaceRemap();
-		readIndices(readDword(mismatch, stream), data->mNbTriangles, remap, stream, mismatch);
+		const PxU32 maxIndex = readDword(mismatch, stream);
+		// the remap table is compressed to 8 or 16 bits when possible, only the 32-bit version can be referenced
+		PxU32* remap = (inPlace && maxIndex>0xffff) ? inPlace->referenceArray<PxU32>(data->mNbTriangles, 4) : NULL;
+		if(remap)
+		{
+			data->mFaceRemap = remap;
+			data->mUserArrays |= IPMA_FACE_REMAP;
+		}
+		else
+		{
+			remap = data->allocateFaceRemap();
+			readIndices(maxIndex, data->mNbTriangles, remap, stream, mismatch);
+		}
 	}
 
 	if(serialFlags & IMSF_ADJACENCIES)
 	{
-		PxU32* adj = data->allocateAdjacencies();
-		stream.read(adj, sizeof(PxU32)*data->mNbTriangles*3);
-		if(mismatch)
+		PxU32* adj = inPlace ? inPlace->referenceArray<PxU32>(data->mNbTriangles*3, 4) : NULL;
+		if(adj)
 		{
-			for(PxU32 i=0;i<data->mNbTriangles*3;i++)
-				flip(adj[i]);
-		}		
+			data->mAdjacencies = adj;
+			data->mFlags |= PxTriangleMeshFlag::eADJACENCY_INFO;
+			data->mUserArrays |= IPMA_ADJACENCIES;
+		}
+		else
+		{
+			adj = data->allocateAdjacencies();
+			stream.read(adj, sizeof(PxU32)*data->mNbTriangles*3);
+			if(mismatch)
+			{
+				for(PxU32 i=0;i<data->mNbTriangles*3;i++)
+					flip(adj[i]);
+			}		
+		}
 	}
 
 	// PT: TODO better
 	if(midphaseID==PxMeshMidPhase::eBVH33)
 	{
-		if(!static_cast<RTreeTriangleData*>(data)->mRTree.load(stream, version, mismatch))
+		RTree& rtree = static_cast<RTreeTriangleData*>(data)->mRTree;
+		if(!rtree.load(stream, version, mismatch, inPlace))
 		{
 			Ps::getFoundation().error(PxErrorCode::eINTERNAL_ERROR, __FILE__, __LINE__, "RTree binary image load error.");
 			PX_DELETE(data);
 			return NULL;
 		}
+		if(rtree.mFlags & RTree::USER_ALLOCATED)
+			data->mUserArrays |= IPMA_MIDPHASE;
 	}
 	else if(midphaseID==PxMeshMidPhase::eBVH34)
 	{
 		BV4TriangleData* bv4data = static_cast<BV4TriangleData*>(data);
-		if(!bv4data->mBV4Tree.load(stream, mismatch))
+		if(!bv4data->mBV4Tree.load(stream, mismatch, inPlace))
 		{
 			Ps::getFoundation().error(PxErrorCode::eINTERNAL_ERROR, __FILE__, __LINE__, "BV4 binary image load error.");
 			PX_DELETE(data);
 			return NULL;
 		}
+		if(bv4data->mBV4Tree.mUserAllocated)
+			data->mUserArrays |= IPMA_MIDPHASE;
 
 		bv4data->mMeshInterface.setNbTriangles(nbTris);
 		bv4data->mMeshInterface.setNbVertices(data->mNbVertices);
@@ -345,9 +507,17 @@ static TriangleMeshData* loadMeshData(PxInputStream& stream)
 	if(nb)
 	{
 		PX_ASSERT(nb==data->mNbTriangles);
-		data->allocateExtraTrigData();
-		// No need to convert those bytes
-		stream.read(data->mExtraTrigData, nb*sizeof(PxU8));
+		data->mExtraTrigData = inPlace ? inPlace->referenceArray<PxU8>(nb, 1) : NULL;
+		if(data->mExtraTrigData)
+		{
+			data->mUserArrays |= IPMA_EXTRA_TRIG_DATA;
+		}
+		else
+		{
+			data->allocateExtraTrigData();
+			// No need to convert those bytes
+			stream.read(data->mExtraTrigData, nb*sizeof(PxU8));
+		}
 	}
 
 	if (serialFlags & IMSF_GRB_DATA)
@@ -358,83 +528,7 @@ static TriangleMeshData* loadMeshData(PxInputStream& stream)
 
 		//read grb triangle indices
 		PX_ASSERT(data->mGRB_triIndices);
-
-		if (serialFlags & IMSF_8BIT_INDICES)
-		{
-			PxU8 x;
-			if (data->has16BitIndices())
-			{
-				PxU16* tris16 = reinterpret_cast<PxU16*>(data->mGRB_triIndices);
-				for (PxU32 i = 0; i<nbIndices; i++)
-				{
-					stream.read(&x, sizeof(PxU8));
-					*tris16++ = x;
-				}
-			}
-			else
-			{
-				PxU32* tris32 = reinterpret_cast<PxU32*>(data->mGRB_triIndices);
-				for (PxU32 i = 0; i<nbIndices; i++)
-				{
-					stream.read(&x, sizeof(PxU8));
-					*tris32++ = x;
-				}
-			}
-		}
-		else if (serialFlags & IMSF_16BIT_INDICES)
-		{
-			if (data->has16BitIndices())
-			{
-				PxU16* tris16 = reinterpret_cast<PxU16*>(data->mGRB_triIndices);
-				stream.read(tris16, nbIndices * sizeof(PxU16));
-				if (mismatch)
-				{
-					for (PxU32 i = 0; i<nbIndices; i++)
-						flip(tris16[i]);
-				}
-			}
-			else
-			{
-				PxU32* tris32 = reinterpret_cast<PxU32*>(data->mGRB_triIndices);
-				PxU16 x;
-				for (PxU32 i = 0; i<nbIndices; i++)
-				{
-					stream.read(&x, sizeof(PxU16));
-					if (mismatch)
-						flip(x);
-
-					*tris32++ = x;
-				}
-			}
-
-		}
-		else
-		{
-			if (data->has16BitIndices())
-			{
-				PxU32 x;
-				PxU16* tris16 = reinterpret_cast<PxU16*>(data->mGRB_triIndices);
-				for (PxU32 i = 0; i<nbIndices; i++)
-				{
-					stream.read(&x, sizeof(PxU32));
-					if (mismatch)
-						flip(x);
-					*tris16++ = Ps::to16(x);
-				}
-			}
-			else
-			{
-				PxU32* tris32 = reinterpret_cast<PxU32*>(data->mGRB_triIndices);
-				stream.read(tris32, nbIndices * sizeof(PxU32));
-
-				if (mismatch)
-				{
-					for (PxU32 i = 0; i<nbIndices; i++)
-						flip(tris32[i]);
-				}
-			}
-		}
-
+		readMeshIndices(serialFlags, data->mGRB_triIndices, nbIndices, data->has16BitIndices(), mismatch, stream);
 
 		data->mGRB_triAdjacencies = static_cast<void *>(PX_NEW(PxU32)[data->mNbTriangles * 4]);
 		data->mGRB_faceRemap = PX_NEW(PxU32)[data->mNbTriangles];
@@ -479,7 +573,19 @@ static TriangleMeshData* loadMeshData(PxInputStream& stream)
 
 PxTriangleMesh* GuMeshFactory::createTriangleMesh(PxInputStream& desc)
 {	
-	TriangleMeshData* data = ::loadMeshData(desc);
+	TriangleMeshData* data = ::loadMeshData(desc, NULL);
+	if(!data)
+		return NULL;
+	PxTriangleMesh* m = createTriangleMesh(*data);
+	PX_DELETE(data);
+	return m;
+}
+
+PxTriangleMesh* GuMeshFactory::createTriangleMeshInPlace(const void* cookedData, PxU32 size)
+{
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eGEOMETRY);
+	MemoryInputStream stream(cookedData, size);
+	TriangleMeshData* data = ::loadMeshData(stream, &stream);
 	if(!data)
 		return NULL;
 	PxTriangleMesh* m = createTriangleMesh(*data);
@@ -539,6 +645,7 @@ PxConvexMesh* GuMeshFactory::createConvexMesh(Gu::ConvexHullData& data)
 
 PxConvexMesh* GuMeshFactory::createConvexMesh(PxInputStream& desc)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eGEOMETRY);
 	ConvexMesh* np;
 	PX_NEW_SERIALIZED(np, ConvexMesh);
 	if(!np)
@@ -601,6 +708,7 @@ PxHeightField* GuMeshFactory::createHeightField(void* heightFieldMeshData)
 
 PxHeightField* GuMeshFactory::createHeightField(PxInputStream& stream)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eGEOMETRY);
 	HeightField* np;
 	PX_NEW_SERIALIZED(np, HeightField)(this);
 	if(!np)
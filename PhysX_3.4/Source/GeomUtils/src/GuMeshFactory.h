@@ -84,6 +84,7 @@ public:
 	void							addTriangleMesh(Gu::TriangleMesh* np, bool lock=true);
 	PxTriangleMesh*					createTriangleMesh(PxInputStream& stream);
 	PxTriangleMesh*					createTriangleMesh(void* triangleMeshData);
+	PxTriangleMesh*					createTriangleMeshInPlace(const void* cookedData, PxU32 size);
 	bool							removeTriangleMesh(PxTriangleMesh&);
 	PxU32							getNbTriangleMeshes()	const;
 	PxU32							getTriangleMeshes(PxTriangleMesh** userBuffer, PxU32 bufferSize, PxU32 startIndex)	const;
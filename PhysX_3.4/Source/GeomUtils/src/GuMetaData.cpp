@@ -114,7 +114,7 @@ static void getBinaryMetaData_HullPolygonData(PxOutputStream& stream)
 
 static void getBinaryMetaData_ConvexHullData(PxOutputStream& stream)
 {
-// 64 bytes
+// 68 bytes
 	PX_DEF_BIN_METADATA_CLASS(stream,	ConvexHullData)
 	PX_DEF_BIN_METADATA_ITEM(stream,	ConvexHullData, PxBounds3,				mAABB,				0)
 	PX_DEF_BIN_METADATA_ITEM(stream,	ConvexHullData, PxVec3,					mCenterOfMass,		0)
@@ -126,6 +126,7 @@ static void getBinaryMetaData_ConvexHullData(PxOutputStream& stream)
 	PX_DEF_BIN_METADATA_ITEM(stream,	ConvexHullData, PxU8,					mNbHullVertices,	0)
 	PX_DEF_BIN_METADATA_ITEM(stream,	ConvexHullData, PxU8,					mNbPolygons,		0)
 	PX_DEF_BIN_METADATA_ITEM(stream,	ConvexHullData, InternalObjectsData,	mInternal,			0)
+	PX_DEF_BIN_METADATA_ITEM(stream,	ConvexHullData, PxF32,					mSupportVertices,	PxMetaDataFlag::ePTR)
 }
 
 void Gu::ConvexMesh::getBinaryMetaData(PxOutputStream& stream)
@@ -178,6 +179,13 @@ static void getBinaryMetaData_PxHeightFieldSample(PxOutputStream& stream)
 	PX_DEF_BIN_METADATA_TYPEDEF(stream,	PxBitAndByte,			PxU8)
 }
 
+static void getBinaryMetaData_HeightFieldMinMax(PxOutputStream& stream)
+{
+	PX_DEF_BIN_METADATA_CLASS(stream,	HeightFieldMinMax)
+	PX_DEF_BIN_METADATA_ITEM(stream,	HeightFieldMinMax,	PxI16,	minHeight,	0)
+	PX_DEF_BIN_METADATA_ITEM(stream,	HeightFieldMinMax,	PxI16,	maxHeight,	0)
+}
+
 static void getBinaryMetaData_HeightFieldData(PxOutputStream& stream)
 {
 	PX_DEF_BIN_METADATA_TYPEDEF(stream,	PxHeightFieldFlags, PxU16)
@@ -198,11 +206,14 @@ static void getBinaryMetaData_HeightFieldData(PxOutputStream& stream)
 	PX_DEF_BIN_METADATA_ITEM(stream,	HeightFieldData, PxU16,					paddAfterFlags,			PxMetaDataFlag::ePADDING)
 #endif
 	PX_DEF_BIN_METADATA_ITEM(stream,	HeightFieldData, PxHeightFieldFormat::Enum,	format,					0)
+	PX_DEF_BIN_METADATA_ITEM(stream,	HeightFieldData, PxU32,					nbMinMaxLevels,			0)
+	PX_DEF_BIN_METADATA_ITEM(stream,	HeightFieldData, HeightFieldMinMax,		minMaxTree,				PxMetaDataFlag::ePTR)
 }
 
 void Gu::HeightField::getBinaryMetaData(PxOutputStream& stream)
 {
 	getBinaryMetaData_PxHeightFieldSample(stream);
+	getBinaryMetaData_HeightFieldMinMax(stream);
 	getBinaryMetaData_HeightFieldData(stream);
 
 	PX_DEF_BIN_METADATA_TYPEDEF(stream, PxMaterialTableIndex, PxU16)
@@ -275,6 +286,7 @@ void SourceMesh::getBinaryMetaData(PxOutputStream& stream)
 	PX_DEF_BIN_METADATA_ITEM(stream,	SourceMesh, PxU32,	mNbTris,		0)
 	PX_DEF_BIN_METADATA_ITEM(stream,	SourceMesh, void,	mTriangles32,	PxMetaDataFlag::ePTR)
 	PX_DEF_BIN_METADATA_ITEM(stream,	SourceMesh, void,	mTriangles16,	PxMetaDataFlag::ePTR)
+	PX_DEF_BIN_METADATA_ITEM(stream,	SourceMesh, void,	mCompressed,	PxMetaDataFlag::ePTR)
 	PX_DEF_BIN_METADATA_ITEM(stream,	SourceMesh, PxU32,	mRemap,			PxMetaDataFlag::ePTR)
 }
 
@@ -352,6 +364,7 @@ void Gu::TriangleMesh::getBinaryMetaData(PxOutputStream& stream)
 	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, PxReal,			mGeomEpsilon,			0)	
 
 	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, PxU8,				mFlags,					0)	
+	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, PxU8,				mUserArrays,			0)
 	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, PxU16,			mMaterialIndices,		PxMetaDataFlag::ePTR)
 	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, PxU32,			mFaceRemap,				PxMetaDataFlag::ePTR)
 	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, PxU32,			mAdjacencies,			PxMetaDataFlag::ePTR)
@@ -361,6 +374,11 @@ void Gu::TriangleMesh::getBinaryMetaData(PxOutputStream& stream)
 	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, PxU32,			mGRB_faceRemap,			PxMetaDataFlag::ePTR)
 	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, void,				mGRB_BV32Tree,			PxMetaDataFlag::ePTR)
 
+	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, PxU8,				mCompressed,			PxMetaDataFlag::ePTR)
+	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, PxU32,			mCompressedSize,		0)
+	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, PxVec3,			mDecompressedVertices,	PxMetaDataFlag::ePTR)
+	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, PxU32,			mDecompressedTriangles,	PxMetaDataFlag::ePTR)
+
 
 	//------ Extra-data ------
 
@@ -394,6 +412,9 @@ void Gu::TriangleMesh::getBinaryMetaData(PxOutputStream& stream)
 	PX_DEF_BIN_METADATA_EXTRA_ITEMS(stream, TriangleMesh, PxU32, mAdjacencies, mNbTriangles, 0, 0)
 	PX_DEF_BIN_METADATA_EXTRA_ITEMS(stream, TriangleMesh, PxU32, mAdjacencies, mNbTriangles, 0, 0)
 
+	// mCompressed
+	PX_DEF_BIN_METADATA_EXTRA_ITEMS(stream, TriangleMesh, PxU8, mCompressed, mCompressedSize, 0, PX_SERIAL_ALIGN)
+
 	PX_DEF_BIN_METADATA_ITEM(stream,		TriangleMesh, GuMeshFactory,		mMeshFactory,				PxMetaDataFlag::ePTR)
 
 
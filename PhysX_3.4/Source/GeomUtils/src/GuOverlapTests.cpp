@@ -64,7 +64,8 @@ static PxVec3 projectHull_(	const ConvexHullData& hull,
 	const PxVec3* Verts = hull.getHullVertices();
 	const PxVec3* bestVert = NULL;
 
-	if(!hull.mBigConvexRawData)	// Brute-force, local space. Experiments show break-even point is around 32 verts.
+	const BigConvexRawData* bigData = getBigConvexRawData(hull);
+	if(!bigData)	// Brute-force, local space. Experiments show break-even point is around 32 verts.
 	{
 		PxU32 NbVerts = hull.mNbHullVertices;
 		float min_ = PX_MAX_F32;
@@ -86,12 +87,12 @@ static PxVec3 projectHull_(	const ConvexHullData& hull,
 	}
 	else //*/if(1)	// This version is better for objects with a lot of vertices
 	{
-		const PxU32 Offset = ComputeCubemapNearestOffset(vertexSpaceDir, hull.mBigConvexRawData->mSubdiv);
-		PxU32 MinID = hull.mBigConvexRawData->mSamples[Offset];
-		PxU32 MaxID = hull.mBigConvexRawData->getSamples2()[Offset];
+		const PxU32 Offset = ComputeCubemapNearestOffset(vertexSpaceDir, bigData->mSubdiv);
+		PxU32 MinID = bigData->mSamples[Offset];
+		PxU32 MaxID = bigData->getSamples2()[Offset];
 
-		localSearch(MinID, -vertexSpaceDir, Verts, hull.mBigConvexRawData);
-		localSearch(MaxID, vertexSpaceDir, Verts, hull.mBigConvexRawData);
+		localSearch(MinID, -vertexSpaceDir, Verts, bigData);
+		localSearch(MaxID, vertexSpaceDir, Verts, bigData);
 
 		minimum = (Verts[MinID].dot(vertexSpaceDir));
 		maximum = (Verts[MaxID].dot(vertexSpaceDir));
@@ -32,6 +32,7 @@
 
 #include "foundation/PxSimpleTypes.h"
 #include "foundation/PxIO.h"
+#include "foundation/PxMemory.h"
 #include "CmPhysXCommon.h"
 #include "PxPhysXCommonConfig.h"
 #include "PsUtilities.h"
@@ -188,6 +189,48 @@ namespace Gu
 
 	PX_PHYSX_COMMON_API void StoreIndices(PxU16 maxIndex, PxU32 nbIndices, const PxU16* indices, PxOutputStream& stream, bool platformMismatch);
 						void ReadIndices(PxU16 maxIndex, PxU32 nbIndices, PxU16* indices, PxInputStream& stream, bool platformMismatch);
+
+	// Input stream over a user-provided memory block. On top of the regular read() it can reference the next bytes
+	// in place, which lets loaders point runtime arrays directly at the user's data instead of copying them.
+	class MemoryInputStream : public PxInputStream
+	{
+		public:
+		PX_FORCE_INLINE				MemoryInputStream(const void* data, PxU32 size) : mData(reinterpret_cast<const PxU8*>(data)), mSize(size), mPos(0)	{}
+		virtual						~MemoryInputStream()																								{}
+
+		virtual	PxU32				read(void* dest, PxU32 count)
+									{
+										const PxU32 nb = PxMin(count, mSize - mPos);
+										PxMemCopy(dest, mData + mPos, nb);
+										mPos += nb;
+										return nb;
+									}
+
+		// Returns a pointer to the next 'count' bytes and skips them. Returns NULL (and does not move the read position)
+		// if the stream does not contain enough data or if the bytes are not aligned on 'alignment' (a power of two).
+				const void*			reference(PxU32 count, PxU32 alignment)
+									{
+										const PxU8* current = mData + mPos;
+										if(count > mSize - mPos || (size_t(current) & (alignment-1)))
+											return NULL;
+										mPos += count;
+										return current;
+									}
+
+		template<class T>
+		PX_FORCE_INLINE	T*			referenceArray(PxU32 nb, PxU32 alignment)
+									{
+										return reinterpret_cast<T*>(const_cast<void*>(reference(nb*sizeof(T), alignment)));
+									}
+
+		PX_FORCE_INLINE	PxU32		getPosition()	const	{ return mPos;	}
+		private:
+				const PxU8*			mData;
+				const PxU32			mSize;
+				PxU32				mPos;
+
+		MemoryInputStream& operator=(const MemoryInputStream&);
+	};
 }
 
 
@@ -145,6 +145,25 @@ static PX_FORCE_INLINE bool hasInitialOverlap(PxSweepHit& sweepHit, const PxVec3
 	return false;
 }
 
+// Conservative early-out for the GJK-based convex sweeps: the bounding sphere of the swept shape, moved along the sweep,
+// must get within reach of the target's bounding sphere for a hit to be possible. Clustered queries return many hulls
+// whose bounds merely overlap the swept AABB, and this rejects them before any support mapping is set up.
+static PX_FORCE_INLINE bool sweptSphereMissesSphere(const PxVec3& center0, PxReal radius0, const PxVec3& unitDir, PxReal distance,
+													const PxVec3& center1, PxReal radius1)
+{
+	const PxVec3 d = center1 - center0;
+	const PxReal t = PxClamp(d.dot(unitDir), 0.0f, distance);
+	const PxReal r = radius0 + radius1;
+	return (d - unitDir*t).magnitudeSquared() > r*r;
+}
+
+static PX_FORCE_INLINE PxReal computeConvexBoundingSphere(PxVec3& center, const PxConvexMeshGeometry& convexGeom, const ConvexHullData& hullData, const PxTransform& pose)
+{
+	// the mesh scale stretches distances by at most its largest absolute scale factor
+	center = pose.transform(convexGeom.scale.transform(hullData.mAABB.mCenter));
+	return hullData.mAABB.mExtents.magnitude() * convexGeom.scale.scale.abs().maxElement();
+}
+
 /////////////////////////////////////////////////  sweepCapsule/Sphere  //////////////////////////////////////////////////////
 bool sweepCapsule_SphereGeom(GU_CAPSULE_SWEEP_FUNC_PARAMS)
 {
@@ -306,6 +325,13 @@ bool sweepCapsule_ConvexGeom(GU_CAPSULE_SWEEP_FUNC_PARAMS)
 	ConvexMesh* convexMesh = static_cast<ConvexMesh*>(convexGeom.convexMesh);
 	ConvexHullData* hullData = &convexMesh->getHull();
 
+	{
+		PxVec3 hullCenter;
+		const PxReal hullRadius = computeConvexBoundingSphere(hullCenter, convexGeom, *hullData, pose);
+		if(sweptSphereMissesSphere((lss.p0 + lss.p1)*0.5f, capsuleGeom_.halfHeight + lss.radius + inflation, unitDir, distance, hullCenter, hullRadius))
+			return false;
+	}
+
 	const Vec3V zeroV = V3Zero();
 	const FloatV zero = FZero();
 	const FloatV dist = FLoad(distance);
@@ -433,6 +459,13 @@ bool sweepBox_ConvexGeom(GU_BOX_SWEEP_FUNC_PARAMS)
 	ConvexMesh* convexMesh = static_cast<ConvexMesh*>(convexGeom.convexMesh);
 	ConvexHullData* hullData = &convexMesh->getHull();
 
+	{
+		PxVec3 hullCenter;
+		const PxReal hullRadius = computeConvexBoundingSphere(hullCenter, convexGeom, *hullData, pose);
+		if(sweptSphereMissesSphere(box.center, box.extents.magnitude() + inflation, unitDir, distance, hullCenter, hullRadius))
+			return false;
+	}
+
 	const Vec3V zeroV = V3Zero();
 	const FloatV zero = FZero();
 
@@ -680,6 +713,14 @@ bool sweepConvex_ConvexGeom(GU_CONVEX_SWEEP_FUNC_PARAMS)
 	ConvexHullData* hullData = &convexMesh->getHull();
 
 	ConvexHullData* otherHullData = &otherConvexMesh.getHull();
+
+	{
+		PxVec3 center, otherCenter;
+		const PxReal radius = computeConvexBoundingSphere(center, convexGeom, *hullData, convexPose);
+		const PxReal otherRadius = computeConvexBoundingSphere(otherCenter, otherConvexGeom, *otherHullData, pose);
+		if(sweptSphereMissesSphere(center, radius + inflation, unitDir, distance, otherCenter, otherRadius))
+			return false;
+	}
 	
 	const Vec3V zeroV = V3Zero();
 	const FloatV zero = FZero();
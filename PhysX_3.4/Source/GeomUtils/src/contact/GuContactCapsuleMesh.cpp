@@ -42,6 +42,8 @@
 #include "GuGeometryUnion.h"
 #include "GuSIMDHelpers.h"
 #include "GuBox.h"
+#include "GuContactTriangleBatch.h"
+#include "PsBitUtils.h"
 
 using namespace physx;
 using namespace Gu;
@@ -399,6 +401,7 @@ struct CapsuleMeshContactGenerationCallback_NoScale : MeshHitCallback<PxRaycastH
 {
 	CapsuleMeshContactGeneration		mGeneration;
 	const TriangleMesh*					mMeshData;
+	TriangleBatch4						mBatch;
 
 	CapsuleMeshContactGenerationCallback_NoScale(
 		ContactBuffer& contactBuffer,
@@ -413,25 +416,40 @@ struct CapsuleMeshContactGenerationCallback_NoScale : MeshHitCallback<PxRaycastH
 		PX_ASSERT(contactBuffer.count==0);
 	}
 
-	PX_FORCE_INLINE PxAgain processTriangle(const PxRaycastHit& hit, const TrianglePadded& tri)
+	// run the plane tests on the whole batch, then the exact tests on the remaining triangles, in the order the midphase reported them
+	void flushBatch()
 	{
-		const PxU32 triangleIndex = hit.faceIndex;
+		if(mBatch.isEmpty())
+			return;
+
+		const Segment& segment = mGeneration.mMeshCapsule;
+		const PxReal inflatedRadius = mGeneration.mInflatedRadius;
+		PxU32 mask = mBatch.computeCandidateMask(segment.p0, segment.p1, (segment.p0 + segment.p1)*0.5f, inflatedRadius*inflatedRadius);
+		while(mask)
+		{
+			const PxU32 i = Ps::lowestSetBit(mask);
+			mask &= mask - 1;
+			const PxU32 triangleIndex = mBatch.mTriangleIndices[i];
 
-		//ML::set all the edges to be active, if the mExtraTrigData exist, we overwrite this flag
-		const PxU8 extraData = getConvexEdgeFlags(mMeshData->getExtraTrigData(), triangleIndex);
-		mGeneration.processTriangle(triangleIndex, tri, extraData);
+			//ML::set all the edges to be active, if the mExtraTrigData exist, we overwrite this flag
+			const PxU8 extraData = getConvexEdgeFlags(mMeshData->getExtraTrigData(), triangleIndex);
+			mGeneration.processTriangle(triangleIndex, mBatch.mTriangles[i], extraData);
+		}
+		mBatch.reset();
+	}
+
+	PX_FORCE_INLINE PxAgain processTriangle(const PxRaycastHit& hit, const PxVec3& v0, const PxVec3& v1, const PxVec3& v2)
+	{
+		mBatch.addTriangle(v0, v1, v2, hit.faceIndex, NULL);
+		if(mBatch.isFull())
+			flushBatch();
 		return true;
 	}
 
 	virtual PxAgain processHit(
 		const PxRaycastHit& hit, const PxVec3& v0, const PxVec3& v1, const PxVec3& v2, PxReal&, const PxU32* /*vInds*/)
 	{
-		TrianglePadded tri;
-		// PT: TODO: revisit this, avoid the copy
-		tri.verts[0] = v0;
-		tri.verts[1] = v1;
-		tri.verts[2] = v2;
-		return processTriangle(hit, tri);
+		return processTriangle(hit, v0, v1, v2);
 	}
 
 private:
@@ -456,9 +474,9 @@ struct CapsuleMeshContactGenerationCallback_Scale : CapsuleMeshContactGeneration
 	virtual PxAgain processHit(
 		const PxRaycastHit& hit, const PxVec3& v0, const PxVec3& v1, const PxVec3& v2, PxReal&, const PxU32* /*vInds*/)
 	{
-		TrianglePadded tri;
-		getScaledVertices(tri.verts, v0, v1, v2, false, mScaling);
-		return processTriangle(hit, tri);
+		PxVec3 verts[3];
+		getScaledVertices(verts, v0, v1, v2, false, mScaling);
+		return processTriangle(hit, verts[0], verts[1], verts[2]);
 	}
 
 private:
@@ -504,6 +522,7 @@ bool Gu::contactCapsuleMesh(GU_CONTACT_METHOD_ARGS)
 
 		// PT: TODO: switch to capsule query here
 		Midphase::intersectOBB(meshData, queryBox, callback, true);
+		callback.flushBatch();
 	}
 	else
 	{
@@ -518,6 +537,7 @@ bool Gu::contactCapsuleMesh(GU_CONTACT_METHOD_ARGS)
 		meshScaling.transformQueryBounds(queryBox.center, queryBox.extents, queryBox.rot);
 
 		Midphase::intersectOBB(meshData, queryBox, callback, true);
+		callback.flushBatch();
 	}
 	return contactBuffer.count > 0;
 }
@@ -36,7 +36,9 @@
 #include "GuEntityReport.h"
 #include "GuHeightFieldUtil.h"
 #include "GuBox.h"
+#include "GuContactTriangleBatch.h"
 #include "PsSort.h"
+#include "PsBitUtils.h"
 
 #include "CmRenderOutput.h"
 
@@ -419,6 +421,7 @@ struct SphereMeshContactGenerationCallback_NoScale : MeshHitCallback<PxRaycastHi
 {
 	SphereMeshContactGeneration			mGeneration;
 	const TriangleMesh&					mMeshData;
+	TriangleBatch4						mBatch;
 
 	SphereMeshContactGenerationCallback_NoScale(const TriangleMesh& meshData, const PxSphereGeometry& shapeSphere,
 		const PxTransform& transform0, const PxTransform& transform1, ContactBuffer& contactBuffer,
@@ -431,9 +434,35 @@ struct SphereMeshContactGenerationCallback_NoScale : MeshHitCallback<PxRaycastHi
 
 	virtual ~SphereMeshContactGenerationCallback_NoScale()
 	{
+		flushBatch();
 		mGeneration.generateLastContacts();
 	}
 
+	// run the plane tests on the whole batch, then the exact tests on the remaining triangles, in the order the midphase reported them
+	void flushBatch()
+	{
+		if(mBatch.isEmpty())
+			return;
+
+		const PxVec3& center = mGeneration.mSphereCenterShape1Space;
+		PxU32 mask = mBatch.computeCandidateMask(center, center, center, mGeneration.mInflatedRadius2);
+		while(mask)
+		{
+			const PxU32 i = Ps::lowestSetBit(mask);
+			mask &= mask - 1;
+			const TrianglePadded& tri = mBatch.mTriangles[i];
+			mGeneration.processTriangle(mBatch.mTriangleIndices[i], tri.verts[0], tri.verts[1], tri.verts[2], mBatch.mVertIndices[i]);
+		}
+		mBatch.reset();
+	}
+
+	PX_FORCE_INLINE void addTriangle(PxU32 triangleIndex, const PxVec3& v0, const PxVec3& v1, const PxVec3& v2, const PxU32* vinds)
+	{
+		mBatch.addTriangle(v0, v1, v2, triangleIndex, vinds);
+		if(mBatch.isFull())
+			flushBatch();
+	}
+
 	virtual PxAgain processHit(
 		const PxRaycastHit& hit, const PxVec3& v0, const PxVec3& v1, const PxVec3& v2, PxReal&, const PxU32* vinds)
 	{
@@ -449,7 +478,7 @@ struct SphereMeshContactGenerationCallback_NoScale : MeshHitCallback<PxRaycastHi
 			mGeneration.mRenderOutput->outputSegment(wp2, wp0);
 		}
 
-		mGeneration.processTriangle(hit.faceIndex, v0, v1, v2, vinds);
+		addTriangle(hit.faceIndex, v0, v1, v2, vinds);
 		return true;
 	}
 
@@ -489,7 +518,7 @@ struct SphereMeshContactGenerationCallback_Scale : SphereMeshContactGenerationCa
 			mGeneration.mRenderOutput->outputSegment(wp2, wp0);
 		}
 
-		mGeneration.processTriangle(hit.faceIndex, verts[0], verts[1], verts[2], vinds);
+		addTriangle(hit.faceIndex, verts[0], verts[1], verts[2], vinds);
 		return true;
 	}
 protected:
@@ -0,0 +1,119 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#ifndef GU_CONTACT_TRIANGLE_BATCH_H
+#define GU_CONTACT_TRIANGLE_BATCH_H
+
+#include "GuSIMDHelpers.h"
+#include "PsVecMath.h"
+
+namespace physx
+{
+namespace Gu
+{
+	// triangles reported by the midphase are collected in batches of 4 so that the cheap plane-based rejection tests of the sphere/capsule
+	// vs mesh contact generation run on 4 triangles at once. The vertices are stored both as triangles for the exact tests, and in SoA form.
+	struct TriangleBatch4
+	{
+		PxF32			mV0[3][4];
+		PxF32			mV1[3][4];
+		PxF32			mV2[3][4];
+		TrianglePadded	mTriangles[4];
+		PxU32			mTriangleIndices[4];
+		PxU32			mVertIndices[4][3];
+		PxU32			mNbTriangles;
+
+		PX_FORCE_INLINE	TriangleBatch4() : mNbTriangles(0)	{}
+
+		PX_FORCE_INLINE	bool	isFull()	const	{ return mNbTriangles==4;	}
+		PX_FORCE_INLINE	bool	isEmpty()	const	{ return mNbTriangles==0;	}
+		PX_FORCE_INLINE	void	reset()				{ mNbTriangles = 0;			}
+
+		PX_FORCE_INLINE void addTriangle(const PxVec3& v0, const PxVec3& v1, const PxVec3& v2, PxU32 triangleIndex, const PxU32* vertInds)
+		{
+			PX_ASSERT(mNbTriangles<4);
+			const PxU32 i = mNbTriangles++;
+			mV0[0][i] = v0.x;	mV0[1][i] = v0.y;	mV0[2][i] = v0.z;
+			mV1[0][i] = v1.x;	mV1[1][i] = v1.y;	mV1[2][i] = v1.z;
+			mV2[0][i] = v2.x;	mV2[1][i] = v2.y;	mV2[2][i] = v2.z;
+			mTriangles[i].verts[0] = v0;
+			mTriangles[i].verts[1] = v1;
+			mTriangles[i].verts[2] = v2;
+			mTriangleIndices[i] = triangleIndex;
+			if(vertInds)
+			{
+				mVertIndices[i][0] = vertInds[0];
+				mVertIndices[i][1] = vertInds[1];
+				mVertIndices[i][2] = vertInds[2];
+			}
+		}
+
+		// returns a mask where bit i is set if triangle i is not back-facing 'center' and its plane is not further than sqrt(sqRadius) from segment (p0, p1).
+		// The exact tests reject the other triangles anyway, so they can be skipped. Use p0 = p1 for a sphere.
+		PX_FORCE_INLINE PxU32 computeCandidateMask(const PxVec3& p0, const PxVec3& p1, const PxVec3& center, PxReal sqRadius) const
+		{
+			using namespace Ps::aos;
+
+			// unused slots of a partial batch contain garbage, they are masked out below
+			const Vec4V v0x = V4LoadU(mV0[0]);	const Vec4V v0y = V4LoadU(mV0[1]);	const Vec4V v0z = V4LoadU(mV0[2]);
+			const Vec4V e0x = V4Sub(V4LoadU(mV1[0]), v0x);
+			const Vec4V e0y = V4Sub(V4LoadU(mV1[1]), v0y);
+			const Vec4V e0z = V4Sub(V4LoadU(mV1[2]), v0z);
+			const Vec4V e1x = V4Sub(V4LoadU(mV2[0]), v0x);
+			const Vec4V e1y = V4Sub(V4LoadU(mV2[1]), v0y);
+			const Vec4V e1z = V4Sub(V4LoadU(mV2[2]), v0z);
+
+			// non-normalized plane normals, same as the ones used by the exact tests
+			const Vec4V nx = V4NegMulSub(e0z, e1y, V4Mul(e0y, e1z));
+			const Vec4V ny = V4NegMulSub(e0x, e1z, V4Mul(e0z, e1x));
+			const Vec4V nz = V4NegMulSub(e0y, e1x, V4Mul(e0x, e1y));
+
+			const Vec4V planeD = V4MulAdd(nz, v0z, V4MulAdd(ny, v0y, V4Mul(nx, v0x)));
+			const Vec4V dc = V4MulAdd(nz, V4Load(center.z), V4MulAdd(ny, V4Load(center.y), V4Mul(nx, V4Load(center.x))));
+			const Vec4V d0 = V4Sub(V4MulAdd(nz, V4Load(p0.z), V4MulAdd(ny, V4Load(p0.y), V4Mul(nx, V4Load(p0.x)))), planeD);
+			const Vec4V d1 = V4Sub(V4MulAdd(nz, V4Load(p1.z), V4MulAdd(ny, V4Load(p1.y), V4Mul(nx, V4Load(p1.x)))), planeD);
+
+			// the segment is entirely in front of the plane, further than the radius. Compare squared values to avoid normalizing the normals.
+			const Vec4V minD = V4Min(d0, d1);
+			const Vec4V sqNormal = V4MulAdd(nz, nz, V4MulAdd(ny, ny, V4Mul(nx, nx)));
+			const BoolV tooFar = BAnd(V4IsGrtr(minD, V4Zero()), V4IsGrtr(V4Mul(minD, minD), V4Scale(sqNormal, FLoad(sqRadius))));
+
+			const BoolV backFacing = V4IsGrtr(planeD, dc);
+
+			const PxU32 validMask = (1u<<mNbTriangles)-1;
+			return BGetBitMask(BNot(BOr(tooFar, backFacing))) & validMask;
+		}
+	};
+
+} // namespace Gu
+
+}
+
+#endif
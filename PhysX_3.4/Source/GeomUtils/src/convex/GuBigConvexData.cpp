@@ -36,6 +36,9 @@
 #include "CmUtils.h"
 #include "PsUtilities.h"
 #include "PsAllocator.h"
+#include "PsAtomic.h"
+#include "PsThread.h"
+#include "GuConvexMeshData.h"
 
 using namespace physx;
 using namespace Gu;
@@ -167,6 +170,181 @@ bool BigConvexData::Load(PxInputStream& stream)
 	return VLoad(stream);
 }
 
+// Hill climbing from startIndex towards the vertex with minimal projection on negativeDir*dir.
+// Same as BigConvexDataBuilder::precomputeSample() in the cooking library.
+static void precomputeSample(const PxVec3* verts, const Valency* valency, const PxU8* adjacentVerts, const PxVec3& dir, PxU8& startIndex_, float negativeDir)
+{
+	PxU8 startIndex = startIndex_;
+
+	// we have only 256 verts
+	PxU32 smallBitMap[8] = {0,0,0,0,0,0,0,0};
+
+	float minimum = negativeDir * verts[startIndex].dot(dir);
+	PxU32 initialIndex = startIndex;
+	do
+	{
+		initialIndex = startIndex;
+		const PxU32 numNeighbours = valency[startIndex].mCount;
+		const PxU32 offset = valency[startIndex].mOffset;
+
+		for(PxU32 a = 0; a < numNeighbours; ++a)
+		{
+			const PxU8 neighbourIndex = adjacentVerts[offset + a];
+			const float dist = negativeDir * verts[neighbourIndex].dot(dir);
+			if(dist < minimum)
+			{
+				const PxU32 ind = PxU32(neighbourIndex >> 5);
+				const PxU32 mask = PxU32(1 << (neighbourIndex & 31));
+				if((smallBitMap[ind] & mask) == 0)
+				{
+					smallBitMap[ind] |= mask;
+					minimum = dist;
+					startIndex = neighbourIndex;
+				}
+			}
+		}
+
+	} while(startIndex != initialIndex);
+
+	startIndex_ = startIndex;
+}
+
+// Computes the valencies and the support vertex map from the runtime hull data, for meshes cooked with
+// PxConvexFlag::eDEFER_GAUSS_MAP. The cooking walks the edges around each vertex, here each polygon simply
+// gives each of its vertices the next vertex along its boundary. Hull polygons are consistently wound, so
+// each edge is visited once in each direction and each neighbor of a vertex is listed exactly once.
+void BigConvexData::buildFromHull(const Gu::ConvexHullData& hull, PxU32 subdiv)
+{
+	PX_ASSERT(isDeferred());
+	PX_ASSERT(!mData.mValencies);
+
+	const PxU32 nbVerts = hull.mNbHullVertices;
+	const PxU32 nbPolygons = hull.mNbPolygons;
+	const Gu::HullPolygonData* polygons = hull.mPolygons;
+	const PxU8* vertexData = hull.getVertexData8();
+
+	PxU32 nbAdjVerts = 0;
+	for(PxU32 i=0;i<nbPolygons;i++)
+		nbAdjVerts += polygons[i].mNbVerts;
+	PX_ASSERT(nbAdjVerts == PxU32(hull.mNbEdges*2));
+
+	// Valencies, same layout as VLoad()
+	const PxU32 numAlignedVerts = (nbVerts+3)&~3;
+	const PxU32 totalSize = sizeof(Gu::Valency)*numAlignedVerts + sizeof(PxU8)*nbAdjVerts;
+	mVBuffer = PX_ALLOC(totalSize, "BigConvexData data");
+	mData.mNbVerts			= nbVerts;
+	mData.mNbAdjVerts		= nbAdjVerts;
+	mData.mValencies		= reinterpret_cast<Gu::Valency*>(mVBuffer);
+	mData.mAdjacentVerts	= (reinterpret_cast<PxU8*>(mVBuffer)) + sizeof(Gu::Valency)*numAlignedVerts;
+	PxMemZero(mData.mValencies, numAlignedVerts*sizeof(Gu::Valency));
+
+	for(PxU32 i=0;i<nbPolygons;i++)
+	{
+		const PxU8* data = vertexData + polygons[i].mVRef8;
+		for(PxU32 j=0;j<polygons[i].mNbVerts;j++)
+			mData.mValencies[data[j]].mCount++;
+	}
+	CreateOffsets();
+
+	for(PxU32 i=0;i<nbPolygons;i++)
+	{
+		const PxU32 numVerts = polygons[i].mNbVerts;
+		const PxU8* data = vertexData + polygons[i].mVRef8;
+		for(PxU32 j=0;j<numVerts;j++)
+			mData.mAdjacentVerts[mData.mValencies[data[j]].mOffset++] = data[(j+1)%numVerts];
+	}
+	// Recreate offsets
+	CreateOffsets();
+
+	// Support vertex map, same as BigConvexDataBuilder::precompute()
+	const PxU32 nbSamples = 6 * subdiv*subdiv;
+	PxU8* samples = reinterpret_cast<PxU8*>(PX_ALLOC(sizeof(PxU8)*nbSamples*2, "BigConvex Samples Data"));
+
+	const PxVec3* verts = hull.getHullVertices();
+	PxU8 startIndex[12] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	PxU8 startIndex2[12] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+	const float halfSubdiv = float(subdiv - 1) * 0.5f;
+	for(PxU32 j = 0; j < subdiv; j++)
+	{
+		for(PxU32 i = j; i < subdiv; i++)
+		{
+			const float iSubDiv = 1.0f - i / halfSubdiv;
+			const float jSubDiv = 1.0f - j / halfSubdiv;
+
+			PxVec3 tempDir(1.0f, iSubDiv, jSubDiv);
+			tempDir.normalize();
+
+			const PxVec3 dirs[12] = {
+				PxVec3(-tempDir.x, tempDir.y, tempDir.z),
+				PxVec3(tempDir.x, tempDir.y, tempDir.z),
+
+				PxVec3(tempDir.z, -tempDir.x, tempDir.y),
+				PxVec3(tempDir.z, tempDir.x, tempDir.y),
+
+				PxVec3(tempDir.y, tempDir.z, -tempDir.x),
+				PxVec3(tempDir.y, tempDir.z, tempDir.x),
+
+				PxVec3(-tempDir.x, tempDir.z, tempDir.y),
+				PxVec3(tempDir.x, tempDir.z, tempDir.y),
+
+				PxVec3(tempDir.y, -tempDir.x, tempDir.z),
+				PxVec3(tempDir.y, tempDir.x, tempDir.z),
+
+				PxVec3(tempDir.z, tempDir.y, -tempDir.x),
+				PxVec3(tempDir.z, tempDir.y, tempDir.x)
+			};
+
+			for(PxU32 dStep = 0; dStep < 12; dStep++)
+			{
+				precomputeSample(verts, mData.mValencies, mData.mAdjacentVerts, dirs[dStep], startIndex[dStep], 1.0f);
+				precomputeSample(verts, mData.mValencies, mData.mAdjacentVerts, dirs[dStep], startIndex2[dStep], -1.0f);
+			}
+
+			for(PxU32 k = 0; k < 6; k++)
+			{
+				const PxU32 ksub = k*subdiv*subdiv;
+				const PxU32 offset = j + i*subdiv + ksub;
+				const PxU32 offset2 = i + j*subdiv + ksub;
+				PX_ASSERT(offset < nbSamples);
+				PX_ASSERT(offset2 < nbSamples);
+
+				samples[offset] = startIndex[k];
+				samples[offset + nbSamples] = startIndex2[k];
+
+				samples[offset2] = startIndex[k + 6];
+				samples[offset2 + nbSamples] = startIndex2[k + 6];
+			}
+		}
+	}
+
+	mData.mSubdiv		= Ps::to16(subdiv);
+	mData.mNbSamples	= Ps::to16(nbSamples);
+	// mSamples is what tells the readers that the data is ready, so it must be written last
+	Ps::memoryBarrier();
+	mData.mSamples		= samples;
+}
+
+// Deferred builds are rare and short, a global lock is enough
+static volatile PxI32 gDeferredBuildLock = 0;
+
+const BigConvexRawData* Gu::buildDeferredBigConvexData(const Gu::ConvexHullData& hull)
+{
+	BigConvexRawData* rawData = hull.mBigConvexRawData;
+	PX_ASSERT(rawData);
+
+	while(Ps::atomicCompareExchange(&gDeferredBuildLock, 1, 0) != 0)
+		PxSpinLockPause();
+
+	// another thread may have built it while we were waiting
+	BigConvexData* data = BigConvexData::fromRawData(rawData);
+	if(data->isDeferred())
+		data->buildFromHull(hull, 16);	// same density as the cooking
+
+	Ps::atomicExchange(&gDeferredBuildLock, 0);
+	return rawData;
+}
+
 // PX_SERIALIZATION
 void BigConvexData::exportExtraData(PxSerializationContext& stream)
 {
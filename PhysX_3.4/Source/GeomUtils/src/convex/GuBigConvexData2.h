@@ -35,6 +35,11 @@
 
 namespace physx
 {
+	namespace Gu
+	{
+		struct ConvexHullData;
+	}
+
 	class PxSerializationContext;
 	class PxDeserializationContext;
 
@@ -80,6 +85,14 @@ namespace physx
 					void					importExtraData(PxDeserializationContext& context);
 //~PX_SERIALIZATION
 					Gu::BigConvexRawData	mData;
+
+		// Deferred data (PxConvexFlag::eDEFER_GAUSS_MAP): the object is created empty and built on first use
+		PX_INLINE	bool					isDeferred()							const	{ return mData.mSamples == NULL;								}
+					void					buildFromHull(const Gu::ConvexHullData& hull, PxU32 subdiv);
+		PX_INLINE	static BigConvexData*	fromRawData(Gu::BigConvexRawData* data)
+											{
+												return reinterpret_cast<BigConvexData*>(reinterpret_cast<PxU8*>(data) - PX_OFFSET_OF(BigConvexData, mData));
+											}
 		protected:
 					void*					mVBuffer;
 		// Internal methods
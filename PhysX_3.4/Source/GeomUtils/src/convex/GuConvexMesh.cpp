@@ -77,6 +77,32 @@ static void initConvexHullData(Gu::ConvexHullData& data)
 	data.mBigConvexRawData = NULL;
 	data.mInternal.mRadius = 0.0f;
 	data.mInternal.mExtents[0] = data.mInternal.mExtents[1] = data.mInternal.mExtents[2] = 0.0f;
+	data.mSupportVertices = NULL;
+}
+
+// Builds the SoA copy of the hull vertices used by ConvexHullV's brute-force support mapping
+static void buildSupportVertices(Gu::ConvexHullData& data)
+{
+	PX_ASSERT(!data.mSupportVertices);
+
+	const PxU32 nbVerts = data.mNbHullVertices;
+	if(!nbVerts)
+		return;
+
+	const PxU32 nbGroups = (nbVerts + 3)>>2;
+	PxF32* soa = reinterpret_cast<PxF32*>(PX_ALLOC(sizeof(PxF32)*12*nbGroups, "ConvexHullData::mSupportVertices"));
+	PX_ASSERT((size_t(soa) & 15)==0);
+
+	const PxVec3* verts = data.getHullVertices();
+	for(PxU32 i=0;i<nbGroups*4;i++)
+	{
+		const PxVec3& v = verts[i<nbVerts ? i : 0];
+		PxF32* group = soa + (i>>2)*12 + (i&3);
+		group[0] = v.x;
+		group[4] = v.y;
+		group[8] = v.z;
+	}
+	data.mSupportVertices = soa;
 }
 
 Gu::ConvexMesh::ConvexMesh()
@@ -98,6 +124,8 @@ Gu::ConvexMesh::ConvexMesh(GuMeshFactory& factory, ConvexHullData& data)
 , mMeshFactory(&factory)
 {
 	mHullData = data;
+	mHullData.mSupportVertices = NULL;
+	buildSupportVertices(mHullData);
 }
 
 Gu::ConvexMesh::~ConvexMesh()
@@ -109,6 +137,10 @@ Gu::ConvexMesh::~ConvexMesh()
 		PX_DELETE_POD(mHullData.mPolygons);
 		PX_DELETE_AND_RESET(mBigConvexData);
 	}
+
+	// always heap-allocated, even for deserialized meshes
+	if(mHullData.mSupportVertices)
+		PX_FREE(mHullData.mSupportVertices);
 }
 
 bool Gu::ConvexMesh::isGpuCompatible() const
@@ -127,6 +159,10 @@ void Gu::ConvexMesh::exportExtraData(PxSerializationContext& stream)
 
 	if(mBigConvexData)
 	{
+		// deferred data isn't serialized as such, the collection gets the built version
+		if(mBigConvexData->isDeferred())
+			buildDeferredBigConvexData(mHullData);
+
 		stream.alignData(PX_SERIAL_ALIGN);
 		stream.writeData(mBigConvexData, sizeof(BigConvexData));
 
@@ -146,6 +182,10 @@ void Gu::ConvexMesh::importExtraData(PxDeserializationContext& context)
 		mBigConvexData->importExtraData(context);
 		mHullData.mBigConvexRawData = &mBigConvexData->mData;
 	}
+
+	// the support vertices aren't serialized, the exported pointer is stale
+	mHullData.mSupportVertices = NULL;
+	buildSupportVertices(mHullData);
 }
 
 Gu::ConvexMesh* Gu::ConvexMesh::createObject(PxU8*& address, PxDeserializationContext& context)
@@ -337,17 +377,19 @@ bool Gu::ConvexMesh::load(PxInputStream& stream)
 	}
 
 	// Import gaussmaps
+	// 1.0f: gaussmap data follows, -1.0f: no gaussmap, 0.0f: gaussmap built on first use (PxConvexFlag::eDEFER_GAUSS_MAP)
 	PxF32 gaussMapFlag = readFloat(mismatch, stream);
 	if(gaussMapFlag != -1.0f)
 	{
-		PX_ASSERT(gaussMapFlag == 1.0f);	//otherwise file is corrupt
+		PX_ASSERT(gaussMapFlag == 1.0f || gaussMapFlag == 0.0f);	//otherwise file is corrupt
 
 		PX_DELETE_AND_RESET(mBigConvexData);
 		PX_NEW_SERIALIZED(mBigConvexData,BigConvexData);	
       
 		if(mBigConvexData)	
 		{
-			mBigConvexData->Load(stream);
+			if(gaussMapFlag == 1.0f)
+				mBigConvexData->Load(stream);
 			mHullData.mBigConvexRawData = &mBigConvexData->mData;
 		}
 	}
@@ -368,6 +410,13 @@ bool Gu::ConvexMesh::load(PxInputStream& stream)
 	PX_ASSERT(mHullData.mInternal.mExtents[1] != 0.0f);
 	PX_ASSERT(mHullData.mInternal.mExtents[2] != 0.0f);
 //~TEST_INTERNAL_OBJECTS
+
+	if(mHullData.mSupportVertices)
+	{
+		PX_FREE(mHullData.mSupportVertices);
+		mHullData.mSupportVertices = NULL;
+	}
+	buildSupportVertices(mHullData);
 	return true;
 }
 
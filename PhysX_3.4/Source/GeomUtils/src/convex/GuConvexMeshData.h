@@ -35,6 +35,7 @@
 #include "GuSerialize.h"
 #include "GuCenterExtents.h"
 #include "foundation/PxBitAndData.h"
+#include "GuBigConvexData.h"
 
 // Data definition
 
@@ -131,11 +132,15 @@ namespace Gu
 		InternalObjectsData	mInternal;
 //~TEST_INTERNAL_OBJECTS
 
+		// Copy of the hull vertices in groups of four (x0 x1 x2 x3, y0..y3, z0..z3), padded with vertex 0, for SIMD brute-force
+		// support mapping. Owned by the ConvexMesh and rebuilt at load/deserialization time, NULL for hulls that aren't part of a mesh.
+		PxF32*				mSupportVertices;
+
 		PX_FORCE_INLINE ConvexHullData(const PxEMPTY) : mNbEdges(PxEmpty)
 		{
 		}
 
-		PX_FORCE_INLINE ConvexHullData()
+		PX_FORCE_INLINE ConvexHullData() : mSupportVertices(NULL)
 		{
 		}
 
@@ -198,14 +203,27 @@ namespace Gu
 
 	};
 	#if PX_P64_FAMILY
-	PX_COMPILE_TIME_ASSERT(sizeof(Gu::ConvexHullData) == 72);
+	PX_COMPILE_TIME_ASSERT(sizeof(Gu::ConvexHullData) == 80);
 	#else
-	PX_COMPILE_TIME_ASSERT(sizeof(Gu::ConvexHullData) == 64);
+	PX_COMPILE_TIME_ASSERT(sizeof(Gu::ConvexHullData) == 68);
 	#endif
 
 	// PT: 'getPaddedBounds()' is only safe if we make sure the bounds member is followed by at least 32bits of data
 	PX_COMPILE_TIME_ASSERT(PX_OFFSET_OF(Gu::ConvexHullData, mCenterOfMass)>=PX_OFFSET_OF(Gu::ConvexHullData, mAABB)+4);
 
+	// Builds the hill-climbing data of a hull cooked with PxConvexFlag::eDEFER_GAUSS_MAP. Thread-safe.
+	PX_PHYSX_COMMON_API const BigConvexRawData* buildDeferredBigConvexData(const ConvexHullData& hull);
+
+	// Returns the hill-climbing data of the hull, or NULL for small hulls. Deferred data is built on first access,
+	// so queries and contact generation must fetch it with this function rather than reading mBigConvexRawData.
+	PX_FORCE_INLINE const BigConvexRawData* getBigConvexRawData(const ConvexHullData& hull)
+	{
+		const BigConvexRawData* data = hull.mBigConvexRawData;
+		if(data && !data->mSamples)
+			return buildDeferredBigConvexData(hull);
+		return data;
+	}
+
 } // namespace Gu
 
 }
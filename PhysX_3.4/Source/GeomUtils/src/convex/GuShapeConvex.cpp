@@ -257,12 +257,12 @@ void Gu::getPolygonalData_Convex(PolygonalData* PX_RESTRICT dst, const Gu::Conve
 	dst->mInternal			= src->mInternal;
 //~TEST_INTERNAL_OBJECTS
 
-	dst->mBigData			= src->mBigConvexRawData;
+	dst->mBigData			= getBigConvexRawData(*src);
 
 	// This threshold test doesnt cost much and many customers cook on PC and use this on 360.
 	// 360 has a much higher threshold than PC(and it makes a big difference)
 	// PT: the cool thing is that this test is now done once by contact generation call, not once by hull projection
-	if(!src->mBigConvexRawData)
+	if(!dst->mBigData)
 		dst->mProjectHull = HullProjectionCB_SmallConvex;
 	else
 		dst->mProjectHull = HullProjectionCB_BigConvex;
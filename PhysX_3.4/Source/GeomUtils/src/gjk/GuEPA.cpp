@@ -63,10 +63,13 @@ namespace Gu
 	{	
 	public:
 		EPA(){}	
-		GjkStatus PenetrationDepth(const GjkConvex& a, const GjkConvex& b, const Ps::aos::Vec3V* PX_RESTRICT Q, const Ps::aos::Vec3V* PX_RESTRICT A, const Ps::aos::Vec3V* PX_RESTRICT B, const PxI32 size, Ps::aos::Vec3V& pa, Ps::aos::Vec3V& pb, Ps::aos::Vec3V& normal, Ps::aos::FloatV& penDepth, const bool takeCoreShape = false);
+		GjkStatus PenetrationDepth(const GjkConvex& a, const GjkConvex& b, const Ps::aos::Vec3V* PX_RESTRICT Q, const Ps::aos::Vec3V* PX_RESTRICT A, const Ps::aos::Vec3V* PX_RESTRICT B, const PxI32 size, Ps::aos::Vec3V& pa, Ps::aos::Vec3V& pb, Ps::aos::Vec3V& normal, Ps::aos::FloatV& penDepth, const bool takeCoreShape = false,
+			const Ps::aos::Vec3V* PX_RESTRICT warmStartNormal = NULL);
 		bool expandPoint(const GjkConvex& a, const GjkConvex& b, PxI32& numVerts, const FloatVArg upperBound);
 		bool expandSegment(const GjkConvex& a, const GjkConvex& b, PxI32& numVerts, const FloatVArg upperBound);
 		bool expandTriangle(PxI32& numVerts, const FloatVArg upperBound);
+		bool expandFacet(Facet* PX_RESTRICT facet, const Ps::aos::Vec3VArg supportA, const Ps::aos::Vec3VArg supportB, PxI32& numVerts, const Ps::aos::FloatVArg upperBound);
+		Facet* findSupportingFacet(const Ps::aos::Vec3VArg dir);
 
 		Facet* addFacet(const PxU32 i0, const PxU32 i1, const PxU32 i2, const Ps::aos::FloatVArg upper);
 	
@@ -103,7 +106,8 @@ namespace Gu
 		support = V3Sub(tSupportA, tSupportB);
 	}
 
-	GjkStatus epaPenetration(const GjkConvex& a, const GjkConvex& b, PxU8* PX_RESTRICT aInd, PxU8* PX_RESTRICT bInd, PxU8 _size, Ps::aos::Vec3V& contactA, Ps::aos::Vec3V& contactB, Ps::aos::Vec3V& normal, Ps::aos::FloatV& penetrationDepth, const bool takeCoreShape)
+	GjkStatus epaPenetration(const GjkConvex& a, const GjkConvex& b, PxU8* PX_RESTRICT aInd, PxU8* PX_RESTRICT bInd, PxU8 _size, Ps::aos::Vec3V& contactA, Ps::aos::Vec3V& contactB, Ps::aos::Vec3V& normal, Ps::aos::FloatV& penetrationDepth, const bool takeCoreShape,
+		const Ps::aos::Vec3V* PX_RESTRICT warmStartNormal)
 	{
 		using namespace Ps::aos;
 		const BoolV bTrue = BTTTT();
@@ -181,7 +185,7 @@ namespace Gu
 
 		EPA epa;
 
-		return epa.PenetrationDepth(a, b, Q, A, B, PxI32(size), contactA, contactB, normal, penetrationDepth, takeCoreShape);
+		return epa.PenetrationDepth(a, b, Q, A, B, PxI32(size), contactA, contactB, normal, penetrationDepth, takeCoreShape, warmStartNormal);
 	}
 
 	//ML: this function returns the signed distance of a point to a plane
@@ -384,6 +388,107 @@ namespace Gu
 	//For example, we treat sphere/capsule as a point/segment in the support function for GJK/EPA, so that the core shape for sphere/capsule is a point/segment. For PCM, we need 
 	//to take the point from the core shape because this will allows us recycle the contacts more stably. For SQ sweeps, we need to take the point on the surface of the sphere/capsule 
 	//when we calculate MTD because this is what will be reported to the user. Therefore, the takeCoreShape flag will be set to be false in SQ.
+	//ML: this function adds the support point(supportA - supportB) to the polytope. The support point must be on the positive side of the facet, so the facet
+	//will not be part of the expanded polytope. Returns false if the polytope can't be expanded any further
+	bool EPA::expandFacet(Facet* PX_RESTRICT facet, const Ps::aos::Vec3VArg supportA, const Ps::aos::Vec3VArg supportB, PxI32& numVerts, const Ps::aos::FloatVArg upperBound)
+	{
+		const Vec3V q = V3Sub(supportA, supportB);
+
+		aBuf[numVerts]=supportA;
+		bBuf[numVerts]=supportB;
+
+		const PxU32 index =PxU32(numVerts++);
+
+		// Compute the silhouette cast by the new vertex
+		// Note that the new vertex is on the positive side
+		// of the current facet, so the current facet will
+		// not be in the polytope. Start local search
+		// from this facet.
+
+		edgeBuffer.MakeEmpty();
+
+		facet->silhouette(q, aBuf, bBuf, edgeBuffer, facetManager);
+
+		//the edge buffer either empty or overflow
+		if (!edgeBuffer.IsValid())
+			return false;
+
+		Edge* PX_RESTRICT edge=edgeBuffer.Get(0);
+
+		PxU32 bufferSize=edgeBuffer.Size();
+
+		//check to see whether we have enough space in the facet manager to create new facets
+		if(bufferSize > facetManager.getNumRemainingIDs())
+			return false;
+
+		Facet *firstFacet = addFacet(edge->getTarget(), edge->getSource(),index, upperBound);
+		PX_ASSERT(firstFacet);
+		firstFacet->link(0, edge->getFacet(), edge->getIndex());
+
+		Facet * PX_RESTRICT lastFacet = firstFacet;
+
+#if EPA_DEBUG
+		bool degenerate = false;
+		for(PxU32 i=1; (i<bufferSize) && (!degenerate); ++i)
+		{
+			edge=edgeBuffer.Get(i);
+			Facet* PX_RESTRICT newFacet = addFacet(edge->getTarget(), edge->getSource(),index, upperBound);
+			PX_ASSERT(newFacet);
+			const bool b0 = newFacet->link(0, edge->getFacet(), edge->getIndex());
+			const bool b1 = newFacet->link(2, lastFacet, 1);
+			degenerate = degenerate || !b0 || !b1;
+			lastFacet = newFacet;
+		}
+
+		if (degenerate)
+			Ps::debugBreak();
+#else
+		for (PxU32 i = 1; i<bufferSize; ++i)
+		{
+			edge = edgeBuffer.Get(i);
+			Facet* PX_RESTRICT newFacet = addFacet(edge->getTarget(), edge->getSource(), index, upperBound);
+			newFacet->link(0, edge->getFacet(), edge->getIndex());
+			newFacet->link(2, lastFacet, 1);
+			lastFacet = newFacet;
+		}
+#endif
+
+		firstFacet->link(2, lastFacet, 1);
+		return true;
+	}
+
+	//ML: this function walks over the polytope, starting from the facet closest to the origin, towards the facet whose normal is the most aligned with dir.
+	//Only facets in the heap are visited, so the returned facet always has a valid plane
+	Facet* EPA::findSupportingFacet(const Ps::aos::Vec3VArg dir)
+	{
+		Facet* PX_RESTRICT facet = heap.top();
+		FloatV maxDot = V3Dot(facet->getPlaneNormal(), dir);
+
+		//maxDot strictly increases at each step so the walk can't cycle, MaxFacets just bounds the number of steps
+		for(PxU32 i = 0; i < MaxFacets; ++i)
+		{
+			Facet* PX_RESTRICT best = NULL;
+			for(PxU32 j = 0; j < 3; ++j)
+			{
+				Facet* PX_RESTRICT adj = facet->m_adjFacets[j];
+				if(adj->m_inHeap && !adj->isObsolete())
+				{
+					const FloatV d = V3Dot(adj->getPlaneNormal(), dir);
+					if(FAllGrtr(d, maxDot))
+					{
+						maxDot = d;
+						best = adj;
+					}
+				}
+			}
+
+			if(!best)
+				break;
+			facet = best;
+		}
+		return facet;
+	}
+
 	static void calculateContactInformation(const Ps::aos::Vec3V* PX_RESTRICT aBuf, const Ps::aos::Vec3V* PX_RESTRICT bBuf, Facet* facet, const GjkConvex& a, const GjkConvex& b, Vec3V& pa, Vec3V& pb, Vec3V& normal, FloatV& penDepth, const bool takeCoreShape)
 	{
 		const FloatV zero = FZero();
@@ -449,7 +554,8 @@ namespace Gu
 	//(1)EPA_FAIL:	the algorithm failed to create a valid polytope(the origin wasn't inside the polytope) from the input simplex
 	//(2)EPA_CONTACT : the algorithm found the MTD amd converged successfully.
 	//(3)EPA_DEGENERATE: the algorithm cannot make further progress and the result is unknown.
-	GjkStatus EPA::PenetrationDepth(const GjkConvex& a, const GjkConvex& b, const Ps::aos::Vec3V* PX_RESTRICT /*Q*/, const Ps::aos::Vec3V* PX_RESTRICT A, const Ps::aos::Vec3V* PX_RESTRICT B, const PxI32 size, Ps::aos::Vec3V& pa, Ps::aos::Vec3V& pb, Ps::aos::Vec3V& normal, Ps::aos::FloatV& penDepth, const bool takeCoreShape)
+	GjkStatus EPA::PenetrationDepth(const GjkConvex& a, const GjkConvex& b, const Ps::aos::Vec3V* PX_RESTRICT /*Q*/, const Ps::aos::Vec3V* PX_RESTRICT A, const Ps::aos::Vec3V* PX_RESTRICT B, const PxI32 size, Ps::aos::Vec3V& pa, Ps::aos::Vec3V& pb, Ps::aos::Vec3V& normal, Ps::aos::FloatV& penDepth, const bool takeCoreShape,
+		const Ps::aos::Vec3V* PX_RESTRICT warmStartNormal)
 	{
 	
 		using namespace Ps::aos;   
@@ -568,6 +674,33 @@ namespace Gu
 
 		Vec3V tempa, tempb, q;
 
+		//ML: seed the polytope with the support point along the previous frame's MTD. In a resting stack the MTD barely changes between frames, so the
+		//facet closest to the origin is usually created here and the upper bound is tightened straight away, which culls most of the facets the 
+		//expansion loop would otherwise have to visit
+		if(warmStartNormal && !heap.empty())
+		{
+			//the MTD normal points from A to B, whereas the facet normals point away from the origin of the Minkowski sum(A - B)
+			const Vec3V dir = V3Neg(*warmStartNormal);
+			Facet* PX_RESTRICT seed = findSupportingFacet(dir);
+
+			tempa = a.support(dir);
+			tempb = b.support(V3Neg(dir));
+			q = V3Sub(tempa, tempb);
+
+			//only expand the polytope if the new support point is visible from the seed facet. Otherwise, the previous MTD doesn't add anything to the polytope
+			if(FAllGrtr(seed->getPlaneDist(q, aBuf, bBuf), eps2))
+			{
+				upper_bound = FMin(upper_bound, V3Dot(q, dir));
+
+				//the seed facet is still in the heap, it will be released when it gets popped
+				if(!expandFacet(seed, tempa, tempb, numVertsLocal, upper_bound))
+				{
+					calculateContactInformation(aBuf, bBuf, seed, a, b, pa, pb, normal, penDepth, takeCoreShape);
+					return EPA_DEGENERATE;
+				}
+			}
+		}
+
 		do 
 		{
 	
@@ -608,72 +741,11 @@ namespace Gu
 				//update the upper bound to the minimum between existing upper bound and the distance
 				upper_bound = FMin(upper_bound, dist);
 
-				aBuf[numVertsLocal]=tempa;
-				bBuf[numVertsLocal]=tempb;
-
-				const PxU32 index =PxU32(numVertsLocal++);
-
-				// Compute the silhouette cast by the new vertex
-				// Note that the new vertex is on the positive side
-				// of the current facet, so the current facet will
-				// not be in the polytope. Start local search
-				// from this facet.
-
-				edgeBuffer.MakeEmpty();
-
-				facet->silhouette(q, aBuf, bBuf, edgeBuffer, facetManager);
-
-				//the edge buffer either empty or overflow
-				if (!edgeBuffer.IsValid())
+				if(!expandFacet(facet, tempa, tempb, numVertsLocal, upper_bound))
 				{
 					calculateContactInformation(aBuf, bBuf, facet, a, b, pa, pb, normal, penDepth, takeCoreShape);
 					return EPA_DEGENERATE;
 				}
-
-				Edge* PX_RESTRICT edge=edgeBuffer.Get(0);
-
-				PxU32 bufferSize=edgeBuffer.Size();
-
-				//check to see whether we have enough space in the facet manager to create new facets
-				if(bufferSize > facetManager.getNumRemainingIDs())
-				{
-					calculateContactInformation(aBuf, bBuf, facet, a, b, pa, pb, normal, penDepth, takeCoreShape);
-					return EPA_DEGENERATE;
-				}
-
-				Facet *firstFacet = addFacet(edge->getTarget(), edge->getSource(),index, upper_bound);
-				PX_ASSERT(firstFacet);
-				firstFacet->link(0, edge->getFacet(), edge->getIndex());
-
-				Facet * PX_RESTRICT lastFacet = firstFacet;
-
-#if EPA_DEBUG
-				bool degenerate = false;
-				for(PxU32 i=1; (i<bufferSize) && (!degenerate); ++i)
-				{
-					edge=edgeBuffer.Get(i);
-					Facet* PX_RESTRICT newFacet = addFacet(edge->getTarget(), edge->getSource(),index, upper_bound);
-					PX_ASSERT(newFacet);
-					const bool b0 = newFacet->link(0, edge->getFacet(), edge->getIndex());
-					const bool b1 = newFacet->link(2, lastFacet, 1);
-					degenerate = degenerate || !b0 || !b1;
-					lastFacet = newFacet;
-				}
-
-				if (degenerate)
-					Ps::debugBreak();
-#else
-				for (PxU32 i = 1; i<bufferSize; ++i)
-				{
-					edge = edgeBuffer.Get(i);
-					Facet* PX_RESTRICT newFacet = addFacet(edge->getTarget(), edge->getSource(), index, upper_bound);
-					newFacet->link(0, edge->getFacet(), edge->getIndex());
-					newFacet->link(2, lastFacet, 1);
-					lastFacet = newFacet;
-				}
-#endif
-
-				firstFacet->link(2, lastFacet, 1);
 			}
 			facetManager.freeID(facet->m_FacetId);
 
@@ -50,7 +50,8 @@ namespace Gu
 							   PxU8 _size,												// count of warm-start indices
 							   Ps::aos::Vec3V& contactA, Ps::aos::Vec3V& contactB,		// a point on each body: when B is translated by normal*penetrationDepth, these are coincident
 							   Ps::aos::Vec3V& normal, Ps::aos::FloatV& depth,			// MTD normal & penetration depth							    
-							   const bool takeCoreShape = false);						// indicates whether we take support point from the core shape of the convexes
+							   const bool takeCoreShape = false,						// indicates whether we take support point from the core shape of the convexes
+							   const Ps::aos::Vec3V* PX_RESTRICT warmStartNormal = NULL);	// optional MTD normal from the previous frame(e.g. the deepest PCM manifold contact), used to seed the polytope
 }
 
 }
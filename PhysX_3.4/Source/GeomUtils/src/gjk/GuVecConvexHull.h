@@ -50,6 +50,7 @@ namespace Gu
 #define	CONVEX_SWEEP_MARGIN_RATIO	0.025f
 #define TOLERANCE_MARGIN_RATIO		0.08f
 #define TOLERANCE_MIN_MARGIN_RATIO	0.05f
+#define CONVEX_SOA_SUPPORT_LIMIT	64
 
 
 	//This margin is used in Persistent contact manifold
@@ -209,10 +210,11 @@ namespace Gu
 			hullData = _hullData;
 			const PxVec3* PX_RESTRICT tempVerts = _hullData->getHullVertices();
 			verts = tempVerts;
+			supportVerts = _hullData->mSupportVertices;
 			numVerts = _hullData->mNbHullVertices;
 			CalculateConvexMargin(_hullData, margin, minMargin, sweepMargin, scale);
 			ConstructSkewMatrix(scale, scaleRot, vertex2Shape, shape2Vertex, center, idtScale);
-			data = _hullData->mBigConvexRawData;
+			data = getBigConvexRawData(*_hullData);
 		}
 
 		//this is used by CCD system
@@ -229,11 +231,12 @@ namespace Gu
 			hullData = hData;
 			const PxVec3* PX_RESTRICT tempVerts = hData->getHullVertices();
 			verts = tempVerts;
+			supportVerts = hData->mSupportVertices;
 			numVerts = hData->mNbHullVertices;
 			CalculateConvexMargin(hData, margin, minMargin, sweepMargin, vScale);
 			ConstructSkewMatrix(vScale, vRot, vertex2Shape, shape2Vertex, center, idtScale);
 
-			data = hData->mBigConvexRawData;
+			data = getBigConvexRawData(*hData);
 
 		}
 
@@ -247,20 +250,21 @@ namespace Gu
 			ConstructSkewMatrix(scale, scaleRot, vertex2Shape, shape2Vertex, center, idtScale);
 
 			verts = tempVerts;
+			supportVerts = _hullData->mSupportVertices;
 			numVerts = _hullData->mNbHullVertices;
 			//rot = _rot;	
 
 			center = _center;
 
 			//	searchIndex = 0;
-			data = _hullData->mBigConvexRawData;
+			data = getBigConvexRawData(*_hullData);
 
 			hullData = _hullData;
-			if (_hullData->mBigConvexRawData)
+			if (data)
 			{
-				Ps::prefetchLine(hullData->mBigConvexRawData->mValencies);
-				Ps::prefetchLine(hullData->mBigConvexRawData->mValencies, 128);
-				Ps::prefetchLine(hullData->mBigConvexRawData->mAdjacentVerts);
+				Ps::prefetchLine(data->mValencies);
+				Ps::prefetchLine(data->mValencies, 128);
+				Ps::prefetchLine(data->mAdjacentVerts);
 			}
 		}
 
@@ -361,10 +365,54 @@ namespace Gu
 			return maxIndex;
 		}
 
+		//same as bruteForceSearch, four vertices at a time using the SoA copy of the hull vertices
+		PX_SUPPORT_INLINE PxU32 bruteForceSearchSoA(const Ps::aos::Vec3VArg _dir)const
+		{
+			using namespace Ps::aos;
+
+			const Vec4V dirX = V4Splat(V3GetX(_dir));
+			const Vec4V dirY = V4Splat(V3GetY(_dir));
+			const Vec4V dirZ = V4Splat(V3GetZ(_dir));
+			const Vec4V four = V4Load(4.0f);
+
+			const PxF32* PX_RESTRICT group = supportVerts;
+			Vec4V index = V4LoadXYZW(0.0f, 1.0f, 2.0f, 3.0f);
+			Vec4V maxIndex = index;
+			Vec4V max = V4MulAdd(V4LoadA(group + 8), dirZ, V4MulAdd(V4LoadA(group + 4), dirY, V4Mul(V4LoadA(group), dirX)));
+
+			const PxU32 nbGroups = (PxU32(numVerts) + 3)>>2;
+			for(PxU32 i = 1; i < nbGroups; ++i)
+			{
+				group += 12;
+				index = V4Add(index, four);
+				const Vec4V dist = V4MulAdd(V4LoadA(group + 8), dirZ, V4MulAdd(V4LoadA(group + 4), dirY, V4Mul(V4LoadA(group), dirX)));
+				const BoolV better = V4IsGrtr(dist, max);
+				max = V4Sel(better, dist, max);
+				maxIndex = V4Sel(better, index, maxIndex);
+			}
+
+			PX_ALIGN(16, PxF32 maxs[4]);
+			PX_ALIGN(16, PxF32 indices[4]);
+			V4StoreA(max, maxs);
+			V4StoreA(maxIndex, indices);
+
+			// first vertex wins ties, as in bruteForceSearch. Padding lanes duplicate vertex 0 so they never beat a valid index.
+			PxU32 best = 0;
+			for(PxU32 j = 1; j < 4; ++j)
+			{
+				if(maxs[j] > maxs[best] || (maxs[j] == maxs[best] && indices[j] < indices[best]))
+					best = j;
+			}
+			return PxU32(indices[best]);
+		}
+
 		//points are in vertex space, _dir in vertex space
 		PX_NOINLINE PxU32 supportVertexIndex(const Ps::aos::Vec3VArg _dir)const
 		{
 			using namespace Ps::aos;
+			// up to CONVEX_SOA_SUPPORT_LIMIT vertices, a branch-free SIMD scan beats hill climbing
+			if(supportVerts && (!data || numVerts <= CONVEX_SOA_SUPPORT_LIMIT))
+				return bruteForceSearchSoA(_dir);
 			if(data)
 				return hillClimbing(_dir);
 			else
@@ -493,6 +541,7 @@ namespace Gu
 		const Gu::ConvexHullData* hullData;
 		const BigConvexRawData* data;  
 		const PxVec3* verts;
+		const PxF32* supportVerts;	//SoA copy of verts, see ConvexHullData::mSupportVertices
 		PxU8 numVerts;
 	};
 
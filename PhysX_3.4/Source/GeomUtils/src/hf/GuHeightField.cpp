@@ -59,6 +59,8 @@ Gu::HeightField::HeightField(GuMeshFactory* meshFactory)
 	mData.flags					= PxHeightFieldFlags();
 	mData.samples				= NULL;
 	mData.thickness				= 0;
+	mData.nbMinMaxLevels		= 0;
+	mData.minMaxTree			= NULL;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -74,6 +76,7 @@ Gu::HeightField::HeightField(GuMeshFactory& factory, Gu::HeightFieldData& data)
 {
 	mData = data;
 	data.samples = NULL; // set to null so that we don't release the memory
+	data.minMaxTree = NULL;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -113,6 +116,10 @@ void Gu::HeightField::exportExtraData(PxSerializationContext& stream)
 void Gu::HeightField::importExtraData(PxDeserializationContext& context)
 {
 	mData.samples = context.readExtraData<PxHeightFieldSample, PX_SERIAL_ALIGN>(mData.rows * mData.columns);
+
+	// PT: the min/max tree is not part of the serialized data, it is cheap enough to rebuild here
+	mData.minMaxTree = NULL;
+	buildMinMaxTree();
 }
 
 Gu::HeightField* Gu::HeightField::createObject(PxU8*& address, PxDeserializationContext& context)
@@ -184,18 +191,25 @@ bool Gu::HeightField::modifySamples(PxI32 startCol, PxI32 startRow, const PxHeig
 		}
 	}
 
+	// refit the min/max tree, a modified sample touches the cells on both sides of it
+	updateMinMaxTree(PxU32(PxMax(startRow - 1, 0)), PxMin(hiRow, nbRows - 1), PxU32(PxMax(startCol - 1, 0)), PxMin(hiCol, nbCols - 1));
+
 	if (shrinkBounds)
 	{
-		// do a full recompute on vertical bounds to allow shrinking
-		minHeight = PX_MAX_REAL;
-		maxHeight = -PX_MAX_REAL;
-		// have to recompute the min&max from scratch...
-		for (PxU32 vertexIndex = 0; vertexIndex < nbRows * nbCols; vertexIndex ++)
+		// recompute the vertical bounds to allow shrinking. The refitted min/max tree gives them from its
+		// coarsest level, only heightfields without a tree have to scan all the samples.
+		if (!getMinMaxHeight(0, nbRows - 1, 0, nbCols - 1, minHeight, maxHeight))
 		{
-				// update height extents
-				const PxReal h = getHeight(vertexIndex);
-				minHeight = physx::intrinsics::selectMin(h, minHeight);
-				maxHeight = physx::intrinsics::selectMax(h, maxHeight);
+			minHeight = PX_MAX_REAL;
+			maxHeight = -PX_MAX_REAL;
+			// have to recompute the min&max from scratch...
+			for (PxU32 vertexIndex = 0; vertexIndex < nbRows * nbCols; vertexIndex ++)
+			{
+					// update height extents
+					const PxReal h = getHeight(vertexIndex);
+					minHeight = physx::intrinsics::selectMin(h, minHeight);
+					maxHeight = physx::intrinsics::selectMax(h, maxHeight);
+			}
 		}
 	}
 	mMinHeight = minHeight;
@@ -272,6 +286,41 @@ bool Gu::HeightField::load(PxInputStream& stream)
 			}
 	}
 
+	// the min/max tree is cooked since version 2, older streams get it rebuilt
+	bool needsMinMaxTree = true;
+	if(version >= 2)
+	{
+		const PxU32 nbLevels = readDword(endian, stream);
+		const PxU32 nbNodes = readDword(endian, stream);
+		PxU32 expectedNbLevels;
+		const PxU32 expectedNbNodes = computeMinMaxTreeSize(mData.rows, mData.columns, expectedNbLevels);
+		if(nbLevels == expectedNbLevels && nbNodes == expectedNbNodes && nbNodes)
+		{
+			mData.minMaxTree = reinterpret_cast<HeightFieldMinMax*>(PX_ALLOC(nbNodes*sizeof(HeightFieldMinMax), "HeightFieldMinMax"));
+			if(mData.minMaxTree)
+			{
+				stream.read(mData.minMaxTree, nbNodes*sizeof(HeightFieldMinMax));
+				if(endian)
+					for(PxU32 i = 0; i < nbNodes; i++)
+					{
+						flip(mData.minMaxTree[i].minHeight);
+						flip(mData.minMaxTree[i].maxHeight);
+					}
+				mData.nbMinMaxLevels = nbLevels;
+				needsMinMaxTree = false;
+			}
+		}
+		if(needsMinMaxTree)
+		{
+			// skip the cooked nodes we could not use
+			HeightFieldMinMax node;
+			for(PxU32 i = 0; i < nbNodes; i++)
+				stream.read(&node, sizeof(HeightFieldMinMax));
+		}
+	}
+	if(needsMinMaxTree)
+		buildMinMaxTree();
+
 	return true;
 }
 
@@ -333,6 +382,8 @@ bool Gu::HeightField::loadFromDesc(const PxHeightFieldDesc& desc)
 
 	parseTrianglesForCollisionVertices(PxHeightFieldMaterial::eHOLE);
 
+	buildMinMaxTree();
+
 // PT: "mNbSamples" only used by binary converter
 	mNbSamples	= mData.rows * mData.columns;
 
@@ -372,6 +423,171 @@ PX_PHYSX_COMMON_API void Gu::HeightField::releaseMemory()
 		PX_FREE(mData.samples);
 		mData.samples = NULL;
 	}
+
+	// the min/max tree is always allocated by the heightfield itself, see importExtraData()
+	PX_FREE(mData.minMaxTree);
+	mData.minMaxTree = NULL;
+	mData.nbMinMaxLevels = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+PxU32 Gu::HeightField::computeMinMaxTreeSize(PxU32 nbRows, PxU32 nbColumns, PxU32& nbLevels)
+{
+	nbLevels = 0;
+	// PT: no need for a tree when all cells fit in a single leaf
+	if(nbRows < 2 || nbColumns < 2 || (nbRows - 1 <= (1<<GU_HF_MINMAX_LEAF_LOG2) && nbColumns - 1 <= (1<<GU_HF_MINMAX_LEAF_LOG2)))
+		return 0;
+
+	PxU32 nbNodes = 0;
+	PxU32 nbLevelRows, nbLevelColumns;
+	do
+	{
+		const PxU32 shift = GU_HF_MINMAX_LEAF_LOG2 + nbLevels;
+		nbLevelRows = ((nbRows - 2) >> shift) + 1;
+		nbLevelColumns = ((nbColumns - 2) >> shift) + 1;
+		nbNodes += nbLevelRows * nbLevelColumns;
+		nbLevels++;
+	}
+	while((nbLevelRows > 1 || nbLevelColumns > 1) && nbLevels < GU_HF_MINMAX_MAX_NB_LEVELS);
+
+	return nbNodes;
+}
+
+void Gu::HeightField::buildMinMaxTree()
+{
+	PX_FREE(mData.minMaxTree);
+	mData.minMaxTree = NULL;
+	mData.nbMinMaxLevels = 0;
+
+	PxU32 nbLevels;
+	const PxU32 nbNodes = computeMinMaxTreeSize(mData.rows, mData.columns, nbLevels);
+	if(!nbNodes)
+		return;
+
+	// PT: the tree is only an acceleration structure, queries still work without it
+	mData.minMaxTree = reinterpret_cast<HeightFieldMinMax*>(PX_ALLOC(nbNodes*sizeof(HeightFieldMinMax), "HeightFieldMinMax"));
+	if(!mData.minMaxTree)
+	{
+		Ps::getFoundation().error(PxErrorCode::eOUT_OF_MEMORY, __FILE__, __LINE__, "Gu::HeightField::buildMinMaxTree: PX_ALLOC failed!");
+		return;
+	}
+	mData.nbMinMaxLevels = nbLevels;
+
+	updateMinMaxTree(0, mData.rows - 1, 0, mData.columns - 1);
+}
+
+void Gu::HeightField::updateMinMaxTree(PxU32 minRow, PxU32 maxRow, PxU32 minColumn, PxU32 maxColumn)
+{
+	if(!mData.nbMinMaxLevels || minRow >= maxRow || minColumn >= maxColumn)
+		return;
+
+	HeightFieldMinMaxLevel levels[GU_HF_MINMAX_MAX_NB_LEVELS];
+	const PxU32 nbLevels = getMinMaxLevels(levels);
+
+	const PxU32 nbColumns = mData.columns;
+	const PxU32 nbCellRows = mData.rows - 1;
+	const PxU32 nbCellColumns = nbColumns - 1;
+
+	// leaves: scan the samples at the corners of the leaf cells
+	PxU32 bu0 = minRow >> GU_HF_MINMAX_LEAF_LOG2, bu1 = (maxRow - 1) >> GU_HF_MINMAX_LEAF_LOG2;
+	PxU32 bv0 = minColumn >> GU_HF_MINMAX_LEAF_LOG2, bv1 = (maxColumn - 1) >> GU_HF_MINMAX_LEAF_LOG2;
+	{
+		HeightFieldMinMax* leaves = const_cast<HeightFieldMinMax*>(levels[0].nodes);
+		for(PxU32 bu = bu0; bu <= bu1; bu++)
+		{
+			const PxU32 row0 = bu << GU_HF_MINMAX_LEAF_LOG2;
+			const PxU32 row1 = PxMin((bu + 1) << GU_HF_MINMAX_LEAF_LOG2, nbCellRows);
+			for(PxU32 bv = bv0; bv <= bv1; bv++)
+			{
+				const PxU32 col0 = bv << GU_HF_MINMAX_LEAF_LOG2;
+				const PxU32 col1 = PxMin((bv + 1) << GU_HF_MINMAX_LEAF_LOG2, nbCellColumns);
+				PxI16 minHeight = PX_MAX_I16;
+				PxI16 maxHeight = PX_MIN_I16;
+				for(PxU32 row = row0; row <= row1; row++)
+				{
+					for(PxU32 col = col0; col <= col1; col++)
+					{
+						const PxI16 height = getSample(row * nbColumns + col).height;
+						minHeight = height < minHeight ? height : minHeight;
+						maxHeight = height > maxHeight ? height : maxHeight;
+					}
+				}
+				HeightFieldMinMax& node = leaves[bu * levels[0].nbColumns + bv];
+				node.minHeight = minHeight;
+				node.maxHeight = maxHeight;
+			}
+		}
+	}
+
+	// upper levels: merge the (up to) 4 children of each node
+	for(PxU32 i = 1; i < nbLevels; i++)
+	{
+		const HeightFieldMinMaxLevel& children = levels[i - 1];
+		const PxU32 nbChildRows = ((nbCellRows - 1) >> (GU_HF_MINMAX_LEAF_LOG2 + i - 1)) + 1;
+		HeightFieldMinMax* nodes = const_cast<HeightFieldMinMax*>(levels[i].nodes);
+		bu0 >>= 1;	bu1 >>= 1;
+		bv0 >>= 1;	bv1 >>= 1;
+		for(PxU32 bu = bu0; bu <= bu1; bu++)
+		{
+			const PxU32 childRow1 = PxMin(bu * 2 + 2, nbChildRows);
+			for(PxU32 bv = bv0; bv <= bv1; bv++)
+			{
+				const PxU32 childCol1 = PxMin(bv * 2 + 2, children.nbColumns);
+				PxI16 minHeight = PX_MAX_I16;
+				PxI16 maxHeight = PX_MIN_I16;
+				for(PxU32 childRow = bu * 2; childRow < childRow1; childRow++)
+				{
+					for(PxU32 childCol = bv * 2; childCol < childCol1; childCol++)
+					{
+						const HeightFieldMinMax& child = children.nodes[childRow * children.nbColumns + childCol];
+						minHeight = child.minHeight < minHeight ? child.minHeight : minHeight;
+						maxHeight = child.maxHeight > maxHeight ? child.maxHeight : maxHeight;
+					}
+				}
+				HeightFieldMinMax& node = nodes[bu * levels[i].nbColumns + bv];
+				node.minHeight = minHeight;
+				node.maxHeight = maxHeight;
+			}
+		}
+	}
+}
+
+bool Gu::HeightField::getMinMaxHeight(PxU32 minRow, PxU32 maxRow, PxU32 minColumn, PxU32 maxColumn, PxReal& minHeight, PxReal& maxHeight) const
+{
+	PX_ASSERT(minRow < maxRow && minColumn < maxColumn);
+	PX_ASSERT(maxRow < mData.rows && maxColumn < mData.columns);
+	if(!mData.nbMinMaxLevels)
+		return false;
+
+	HeightFieldMinMaxLevel levels[GU_HF_MINMAX_MAX_NB_LEVELS];
+	const PxU32 nbLevels = getMinMaxLevels(levels);
+
+	// PT: pick the finest level where the cell range overlaps at most 2x2 nodes. This covers more cells
+	// than requested but keeps the query O(1), which is all the callers need for early rejection.
+	PxU32 level = 0;
+	PxU32 shift = GU_HF_MINMAX_LEAF_LOG2;
+	while(level < nbLevels - 1 && (((maxRow - 1) >> shift) - (minRow >> shift) > 1 || ((maxColumn - 1) >> shift) - (minColumn >> shift) > 1))
+	{
+		level++;
+		shift++;
+	}
+
+	const HeightFieldMinMaxLevel& l = levels[level];
+	PxI16 minH = PX_MAX_I16;
+	PxI16 maxH = PX_MIN_I16;
+	for(PxU32 bu = minRow >> shift; bu <= ((maxRow - 1) >> shift); bu++)
+	{
+		for(PxU32 bv = minColumn >> shift; bv <= ((maxColumn - 1) >> shift); bv++)
+		{
+			const HeightFieldMinMax& node = l.nodes[bu * l.nbColumns + bv];
+			minH = node.minHeight < minH ? node.minHeight : minH;
+			maxH = node.maxHeight > maxH ? node.maxHeight : maxH;
+		}
+	}
+	minHeight = PxReal(minH);
+	maxHeight = PxReal(maxH);
+	return true;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
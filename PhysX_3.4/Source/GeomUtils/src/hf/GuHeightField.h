@@ -40,7 +40,8 @@
 #include "PxHeightField.h"
 
 //#define PX_HEIGHTFIELD_VERSION 0
-#define PX_HEIGHTFIELD_VERSION 1  // tiled version that was needed for PS3 only has been removed
+//#define PX_HEIGHTFIELD_VERSION 1  // tiled version that was needed for PS3 only has been removed
+#define PX_HEIGHTFIELD_VERSION 2  // min/max tree added
 
 namespace physx
 {
@@ -52,6 +53,13 @@ namespace physx
 {
 namespace Gu
 {
+// Nodes of one min/max tree level, see HeightFieldData::minMaxTree
+struct HeightFieldMinMaxLevel
+{
+	const HeightFieldMinMax*	nodes;
+	PxU32						nbColumns;	// number of nodes per row of the level
+};
+
 class HeightField : public PxHeightField, public Ps::UserAllocated, public Cm::RefCountable
 {
 //= ATTENTION! =====================================================================================
@@ -257,6 +265,34 @@ public:
 	PX_FORCE_INLINE	PxReal						getMaxHeight()					const	{ return mMaxHeight; }
 
 	PX_FORCE_INLINE	const Gu::HeightFieldData&	getData()						const	{ return mData; }
+
+	PX_FORCE_INLINE	PxU32						getNbMinMaxLevels()				const	{ return mData.nbMinMaxLevels; }
+
+												// fills 'levels' (GU_HF_MINMAX_MAX_NB_LEVELS entries) and returns the number of min/max tree levels
+	PX_FORCE_INLINE	PxU32						getMinMaxLevels(HeightFieldMinMaxLevel* levels) const
+												{
+													const HeightFieldMinMax* nodes = mData.minMaxTree;
+													const PxU32 nbLevels = mData.nbMinMaxLevels;
+													for(PxU32 i=0;i<nbLevels;i++)
+													{
+														const PxU32 shift = GU_HF_MINMAX_LEAF_LOG2 + i;
+														const PxU32 nbColumns = ((mData.columns - 2) >> shift) + 1;
+														levels[i].nodes = nodes;
+														levels[i].nbColumns = nbColumns;
+														nodes += (((mData.rows - 2) >> shift) + 1) * nbColumns;
+													}
+													return nbLevels;
+												}
+
+												// conservative height range of cells [minRow, maxRow[ x [minColumn, maxColumn[, in unscaled sample units.
+												// Returns false if the heightfield has no min/max tree.
+	PX_PHYSX_COMMON_API	bool					getMinMaxHeight(PxU32 minRow, PxU32 maxRow, PxU32 minColumn, PxU32 maxColumn, PxReal& minHeight, PxReal& maxHeight) const;
+
+												// (re)builds the min/max tree from the samples, see HeightFieldData::minMaxTree
+	PX_PHYSX_COMMON_API	void					buildMinMaxTree();
+												// refits the min/max tree nodes overlapping cells [minRow, maxRow[ x [minColumn, maxColumn[
+	PX_PHYSX_COMMON_API	void					updateMinMaxTree(PxU32 minRow, PxU32 maxRow, PxU32 minColumn, PxU32 maxColumn);
+	PX_PHYSX_COMMON_API	static	PxU32			computeMinMaxTreeSize(PxU32 nbRows, PxU32 nbColumns, PxU32& nbLevels);
 	
 	PX_CUDA_CALLABLE PX_FORCE_INLINE	void	getTriangleVertices(PxU32 triangleIndex, PxU32 row, PxU32 column, PxVec3& v0, PxVec3& v1, PxVec3& v2) const;
 
@@ -41,6 +41,18 @@ namespace physx
 namespace Gu
 {
 
+// Cells covered by a leaf node of the min/max tree, per axis, as a power of two
+#define GU_HF_MINMAX_LEAF_LOG2		2
+// Upper bound on the number of min/max tree levels
+#define GU_HF_MINMAX_MAX_NB_LEVELS	30
+
+// Height range of a square block of heightfield cells, in unscaled sample units
+struct HeightFieldMinMax
+{
+	PxI16	minHeight;
+	PxI16	maxHeight;
+};
+
 #if PX_VC 
     #pragma warning(push)
 	#pragma warning( disable : 4251 ) // class needs to have dll-interface to be used by clients of class
@@ -68,6 +80,12 @@ struct PX_PHYSX_COMMON_API HeightFieldData
 
 					PxHeightFieldFormat::Enum	format;
 
+		// Min/max height quadtree stored level by level, finest level first. Level i nodes cover
+		// (1<<(GU_HF_MINMAX_LEAF_LOG2+i))^2 cells, row-major, and the last level is a single node.
+		// NULL (and nbMinMaxLevels zero) for heightfields too small to benefit from it.
+					PxU32						nbMinMaxLevels;
+					HeightFieldMinMax*			minMaxTree;
+
 	PX_FORCE_INLINE	const CenterExtentsPadded&	getPaddedBounds()				const
 												{
 													// PT: see compile-time assert below
@@ -700,6 +700,12 @@ bool Gu::HeightFieldUtil::overlapAABBTriangles(const PxTransform& pose, const Px
 	if(!maxNbTriangles)
 		return false;
 
+	// early exit for aabb entirely above or below the cells it overlaps in XZ, using the min/max tree
+	PxReal minHeight, maxHeight;
+	if(mHeightField->getMinMaxHeight(minRow, maxRow, minColumn, maxColumn, minHeight, maxHeight) &&
+		(localBounds.maximum.y < minHeight || localBounds.minimum.y > maxHeight))
+		return false;
+
 	if(flags & GuHfQueryFlags::eFIRST_CONTACT)
 		maxNbTriangles = 1;
 
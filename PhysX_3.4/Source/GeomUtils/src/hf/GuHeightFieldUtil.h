@@ -765,11 +765,89 @@ namespace Gu
 
 			const Gu::HeightField& hf = *mHeightField;
 
+			// the min/max tree lets raycasts skip whole blocks of cells the segment passes above or below.
+			// Overlaps and under face callbacks need to visit every cell, so they don't use it.
+			HeightFieldMinMaxLevel minMaxLevels[GU_HF_MINMAX_MAX_NB_LEVELS];
+			const PxU32 nbMinMaxLevels = (!overlap && !useUnderFaceCallback) ? hf.getMinMaxLevels(minMaxLevels) : 0;
+			PxI32 lastLeafU = -1, lastLeafV = -1; // leaf that was last tested and not skipped
+
 			// seed hLinePrev as h(0)
 			PxReal hLinePrev = COMPUTE_H_FROM_T(0);
 
 			do
 			{
+				if (nbMinMaxLevels)
+				{
+					// lowest u,v corner of the current cell
+					const PxI32 cu = PxMin(ui, ui + step_ui), cv = PxMin(vi, vi + step_vi);
+					PX_ASSERT(cu >= 0 && cv >= 0);
+					if ((cu >> GU_HF_MINMAX_LEAF_LOG2) != lastLeafU || (cv >> GU_HF_MINMAX_LEAF_LOG2) != lastLeafV)
+					{
+						lastLeafU = cu >> GU_HF_MINMAX_LEAF_LOG2;
+						lastLeafV = cv >> GU_HF_MINMAX_LEAF_LOG2;
+
+						// find the largest block around the current cell that the rest of the segment inside it doesn't touch.
+						// ku, kv are the numbers of u and v steps needed to leave the block.
+						PxI32 skipKu = 0, skipKv = 0;
+						PxF32 skipTuExit = 0.0f, skipTvExit = 0.0f;
+						for (PxU32 level = 0; level < nbMinMaxLevels; level++)
+						{
+							const PxU32 shift = GU_HF_MINMAX_LEAF_LOG2 + level;
+							const PxI32 bu = cu >> shift, bv = cv >> shift;
+							const PxI32 ku = step_ui > 0 ? ((bu + 1) << shift) - ui : ui - (bu << shift);
+							const PxI32 kv = step_vi > 0 ? ((bv + 1) << shift) - vi : vi - (bv << shift);
+							const PxF32 tuExit = tu + PxF32(ku - 1) * step_tu;
+							const PxF32 tvExit = tv + PxF32(kv - 1) * step_tv;
+							const PxF32 hExit = COMPUTE_H_FROM_T(PxMin(tuExit, tvExit));
+
+							const HeightFieldMinMax& node = minMaxLevels[level].nodes[PxU32(bu) * minMaxLevels[level].nbColumns + PxU32(bv)];
+							const PxF32 blockH0 = PxF32(node.minHeight) * heightScale, blockH1 = PxF32(node.maxHeight) * heightScale;
+							if (!(PxMin(hLinePrev, hExit) - hEpsilon > PxMax(blockH0, blockH1) || PxMax(hLinePrev, hExit) + hEpsilon < PxMin(blockH0, blockH1)))
+								break;
+
+							skipKu = ku; skipKv = kv;
+							skipTuExit = tuExit; skipTvExit = tvExit;
+						}
+
+						if (skipKu)
+						{
+							// jump the DDA to the first cell past the block. The tie breaking matches the u/v steps
+							// at the end of the loop: an u step is taken first only if tu < tv.
+							PxI32 nu, nv;
+							if (skipTuExit < skipTvExit)
+							{
+								nu = skipKu;
+								nv = tv <= skipTuExit ? PxMin(PxI32((skipTuExit - tv) / step_tv) + 1, skipKv - 1) : 0;
+							}
+							else
+							{
+								nv = skipKv;
+								nu = tu < skipTvExit ? PxMin(PxI32(PxCeil((skipTvExit - tu) / step_tu)), skipKu - 1) : 0;
+							}
+							tMinUV = PxMin(skipTuExit, skipTvExit);
+							if (nu)
+							{
+								ui += nu * step_ui;
+								uif += PxF32(nu) * step_uif;
+								last_tu = tu + PxF32(nu - 1) * step_tu;
+								tu += PxF32(nu) * step_tu;
+							}
+							if (nv)
+							{
+								vi += nv * step_vi;
+								vif += PxF32(nv) * step_vif;
+								last_tv = tv + PxF32(nv - 1) * step_tv;
+								tv += PxF32(nv) * step_tv;
+							}
+							// same exit conditions as the regular u/v steps
+							if (ui + step_ui < 0 || ui + step_ui >= nbUi || vi + step_vi < 0 || vi + step_vi >= nbVi)
+								break;
+							hLinePrev = COMPUTE_H_FROM_T(tMinUV);
+							continue;
+						}
+					}
+				}
+
 				tMinUV = PxMin(tu, tv); // determine where next closest u or v-intercept point is
 				PxF32 hLineNext = COMPUTE_H_FROM_T(tMinUV); // compute the corresponding h
 
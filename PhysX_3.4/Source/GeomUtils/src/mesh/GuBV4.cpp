@@ -30,6 +30,7 @@
 #include "foundation/PxMemory.h"
 #include "GuBV4.h"
 #include "GuSerialize.h"
+#include "GuMeshCompression.h"
 #include "CmUtils.h"
 #include "PsUtilities.h"
 
@@ -55,6 +56,7 @@ void SourceMesh::reset()
 	mNbTris			= 0;
 	mTriangles32	= NULL;
 	mTriangles16	= NULL;
+	mCompressed		= NULL;
 	mRemap			= NULL;
 }
 
@@ -65,6 +67,7 @@ void SourceMesh::operator=(SourceMesh& v)
 	mNbTris			= v.mNbTris;
 	mTriangles32	= v.mTriangles32;
 	mTriangles16	= v.mTriangles16;
+	mCompressed		= v.mCompressed;
 	mRemap			= v.mRemap;
 	v.reset();
 }
@@ -107,6 +110,7 @@ void SourceMesh::remapTopology(const PxU32* order)
 bool SourceMesh::isValid() const
 {
 	if(!mNbTris || !mNbVerts)			return false;
+	if(mCompressed)						return mCompressed->hasIndices() || mTriangles32 || mTriangles16;
 	if(!mVerts)							return false;
 	if(!mTriangles32 && !mTriangles16)	return false;
 	return true;
@@ -213,7 +217,7 @@ void BV4Tree::importExtraData(PxDeserializationContext& context)
 	PX_COMPILE_TIME_ASSERT(BVDataPackedNb * sizeof(float) == sizeof(BVDataPacked));
 #endif
 
-bool BV4Tree::load(PxInputStream& stream, bool mismatch_)
+bool BV4Tree::load(PxInputStream& stream, bool mismatch_, MemoryInputStream* inPlace)
 {
 	PX_ASSERT(!mUserAllocated);
 
@@ -241,6 +245,18 @@ bool BV4Tree::load(PxInputStream& stream, bool mismatch_)
 	const PxU32 nbNodes = readDword(mismatch, stream);
 	mNbNodes = nbNodes;
 
+	// the nodes are saved with the runtime layout, so they can be referenced directly when no conversion is needed
+	if(nbNodes && inPlace && !mismatch)
+	{
+		BVDataPacked* nodes = inPlace->referenceArray<BVDataPacked>(nbNodes, 16);
+		if(nodes)
+		{
+			mNodes = nodes;
+			mUserAllocated = true;
+			return true;
+		}
+	}
+
 	if(nbNodes)
 	{
 #ifdef GU_BV4_USE_SLABS
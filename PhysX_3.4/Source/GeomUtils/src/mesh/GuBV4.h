@@ -44,6 +44,8 @@ namespace physx
 {
 namespace Gu
 {
+	class MemoryInputStream;
+	class CompressedMesh;
 
 	struct VertexPointers
 	{
@@ -118,12 +120,14 @@ namespace Gu
 						PxU32			mNbTris;
 						IndTri32*		mTriangles32;
 						IndTri16*		mTriangles16;
+						const CompressedMesh*	mCompressed;	//!< owned by the mesh. mVerts is NULL when set, and so are the triangles with CMF_INDICES.
 
 		PX_FORCE_INLINE	PxU32			getNbTriangles()	const	{ return mNbTris;		}
 		PX_FORCE_INLINE	PxU32			getNbVertices()		const	{ return mNbVerts;		}
 		PX_FORCE_INLINE	const IndTri32*	getTris32()			const	{ return mTriangles32;	}
 		PX_FORCE_INLINE	const IndTri16*	getTris16()			const	{ return mTriangles16;	}
 		PX_FORCE_INLINE	const PxVec3*	getVerts()			const	{ return mVerts;		}
+		PX_FORCE_INLINE	const CompressedMesh*	getCompressedMesh()	const	{ return mCompressed;	}
 
 		PX_FORCE_INLINE	void			setNbTriangles(PxU32 nb)	{ mNbTris = nb;			}
 		PX_FORCE_INLINE	void			setNbVertices(PxU32 nb)		{ mNbVerts = nb;		}
@@ -135,6 +139,8 @@ namespace Gu
 											mVerts			= verts;
 										}
 
+		PX_FORCE_INLINE	void			setCompressedMesh(const CompressedMesh* compressed)	{ mCompressed = compressed;	}
+
 		PX_FORCE_INLINE	void			initRemap()			{ mRemap = NULL;				}
 		PX_FORCE_INLINE	const PxU32*	getRemap()	const	{ return mRemap;				}
 		PX_FORCE_INLINE	void			releaseRemap()		{ PX_FREE_AND_RESET(mRemap);	}
@@ -144,6 +150,7 @@ namespace Gu
 
 		PX_FORCE_INLINE	void			getTriangle(VertexPointers& vp, PxU32 index)	const
 										{
+											PX_ASSERT(!mCompressed);
 											PxU32 VRef0, VRef1, VRef2;
 											getVertexReferences(VRef0, VRef1, VRef2, index, mTriangles32, mTriangles16);
 											vp.Vertex[0] = mVerts + VRef0;
@@ -229,7 +236,7 @@ namespace Gu
 		PX_PHYSX_COMMON_API				BV4Tree(SourceMesh* meshInterface, const PxBounds3& localBounds);
 		PX_PHYSX_COMMON_API				~BV4Tree();
 
-						bool			load(PxInputStream& stream, bool mismatch);
+						bool			load(PxInputStream& stream, bool mismatch, MemoryInputStream* inPlace = NULL);	// if inPlace is set, nodes may reference its data
 
 						void			reset();
 						void			operator = (BV4Tree& v);
@@ -237,6 +244,11 @@ namespace Gu
 						bool			init(SourceMesh* meshInterface, const PxBounds3& localBounds);
 						void			release();
 
+						// Refits the tree after the vertices [firstVertex, firstVertex+nbVertices) of the source mesh have been
+						// modified. Only the leaves referencing these vertices and their parents are rewritten. The quantization
+						// coefficients are recomputed, and the whole tree requantized, when the new bounds no longer fit in them.
+						bool			refit(PxBounds3& bounds, float epsilon, PxU32 firstVertex, PxU32 nbVertices);
+
 						SourceMesh*		mMeshInterface;
 						LocalBounds		mLocalBounds;
 
@@ -35,6 +35,8 @@
 #include "CmPhysXCommon.h"
 #include "PsBasicTemplates.h"
 #include "GuCenterExtents.h"
+#include "CmTask.h"
+#include "PsArray.h"
 
 using namespace physx;
 using namespace Gu;
@@ -107,7 +109,110 @@ static PxU32 local_Split(const AABBTreeNode* PX_RESTRICT node, const PxBounds3*
 	return nbPos;
 }
 
-static bool local_Subdivide(AABBTreeNode* PX_RESTRICT node, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers, BuildStats& stats, const AABBTreeNode* const PX_RESTRICT node_base, PxU32 limit)
+static PX_FORCE_INLINE float local_HalfSurfaceArea(const PxBounds3& box)
+{
+	const PxVec3 d = box.maximum - box.minimum;
+	return d.x*d.y + d.y*d.z + d.z*d.x;
+}
+
+static PX_FORCE_INLINE PxU32 local_GetBinIndex(float value, float minValue, float binScale, PxU32 nbBins)
+{
+	return PxMin(PxU32((value - minValue) * binScale), nbBins-1);
+}
+
+// Binned SAH split. Primitives are binned by their box centers, along each axis, and the split minimizing the sum of the
+// children's surface areas weighted by their number of primitives is selected. Primitives of the bins above the split are
+// moved first, like the "positive" primitives of local_Split. Returns 0 if no valid split has been found.
+static PxU32 local_SplitSAH(const AABBTreeNode* PX_RESTRICT node, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers, PxU32 nbBins)
+{
+	const PxU32 nb = node->mNbPrimitives;
+	PxU32* PX_RESTRICT prims = node->mNodePrimitives;
+
+	PxBounds3 centerBounds = PxBounds3::empty();
+	for(PxU32 i=0;i<nb;i++)
+		centerBounds.include(centers[prims[i]]);
+
+	PX_ASSERT(nbBins<=GU_BV4_MAX_NB_SAH_BINS);
+	PxBounds3 binBounds[GU_BV4_MAX_NB_SAH_BINS];
+	PxU32 binCounts[GU_BV4_MAX_NB_SAH_BINS];
+	float rightCosts[GU_BV4_MAX_NB_SAH_BINS];
+	PxU32 rightCounts[GU_BV4_MAX_NB_SAH_BINS];
+
+	float bestCost = PX_MAX_F32;
+	PxU32 bestAxis = PX_INVALID_U32;
+	PxU32 bestBin = 0;
+	float bestScale = 0.0f;
+	for(PxU32 axis=0;axis<3;axis++)
+	{
+		const float extent = centerBounds.maximum[axis] - centerBounds.minimum[axis];
+		if(extent<=0.0f)
+			continue;
+		const float binScale = float(nbBins)/extent;
+
+		for(PxU32 i=0;i<nbBins;i++)
+		{
+			binBounds[i] = PxBounds3::empty();
+			binCounts[i] = 0;
+		}
+		for(PxU32 i=0;i<nb;i++)
+		{
+			const PxU32 index = prims[i];
+			const PxU32 bin = local_GetBinIndex(centers[index][axis], centerBounds.minimum[axis], binScale, nbBins);
+			binBounds[bin].include(boxes[index]);
+			binCounts[bin]++;
+		}
+
+		// Sweep from the right: cost of the right child for a split before bin i
+		PxBounds3 rightBounds = PxBounds3::empty();
+		PxU32 rightCount = 0;
+		for(PxU32 i=nbBins-1;i>0;i--)
+		{
+			rightBounds.include(binBounds[i]);
+			rightCount += binCounts[i];
+			rightCounts[i] = rightCount;
+			rightCosts[i] = rightCount ? local_HalfSurfaceArea(rightBounds)*float(rightCount) : 0.0f;
+		}
+
+		// Sweep from the left and evaluate the splits
+		PxBounds3 leftBounds = PxBounds3::empty();
+		PxU32 leftCount = 0;
+		for(PxU32 i=1;i<nbBins;i++)
+		{
+			leftBounds.include(binBounds[i-1]);
+			leftCount += binCounts[i-1];
+			if(!leftCount || !rightCounts[i])
+				continue;
+
+			const float cost = local_HalfSurfaceArea(leftBounds)*float(leftCount) + rightCosts[i];
+			if(cost<bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestBin = i;
+				bestScale = binScale;
+			}
+		}
+	}
+
+	if(bestAxis==PX_INVALID_U32)
+		return 0;
+
+	const float minValue = centerBounds.minimum[bestAxis];
+	PxU32 nbPos = 0;
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const PxU32 index = prims[i];
+		if(local_GetBinIndex(centers[index][bestAxis], minValue, bestScale, nbBins)>=bestBin)
+		{
+			prims[i] = prims[nbPos];
+			prims[nbPos] = index;
+			nbPos++;
+		}
+	}
+	return nbPos;
+}
+
+static bool local_Subdivide(AABBTreeNode* PX_RESTRICT node, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers, BuildStats& stats, const AABBTreeNode* const PX_RESTRICT node_base, PxU32 limit, PxU32 nbSAHBins)
 {
 	const PxU32* PX_RESTRICT prims = node->mNodePrimitives;
 	const PxU32 nb = node->mNbPrimitives;
@@ -149,6 +254,15 @@ static bool local_Subdivide(AABBTreeNode* PX_RESTRICT node, const PxBounds3* PX_
 
 	bool validSplit = true;
 	PxU32 nbPos;
+	if(nbSAHBins)
+	{
+		nbPos = local_SplitSAH(node, boxes, centers, nbSAHBins);
+
+		// Check split validity
+		if(!nbPos || nbPos==nb)
+			validSplit = false;
+	}
+	else
 	{
 		// Compute variances
 		Vec4V varsV = V4Zero();
@@ -231,18 +345,158 @@ static bool local_Subdivide(AABBTreeNode* PX_RESTRICT node, const PxBounds3* PX_
 	return true;
 }
 
-static void local_BuildHierarchy(AABBTreeNode* PX_RESTRICT node, const PxBounds3* PX_RESTRICT Boxes, const PxVec3* PX_RESTRICT centers, BuildStats& stats, const AABBTreeNode* const PX_RESTRICT node_base, PxU32 limit)
+static void local_BuildHierarchy(AABBTreeNode* PX_RESTRICT node, const PxBounds3* PX_RESTRICT Boxes, const PxVec3* PX_RESTRICT centers, BuildStats& stats, const AABBTreeNode* const PX_RESTRICT node_base, PxU32 limit, PxU32 nbSAHBins)
 {
-	if(local_Subdivide(node, Boxes, centers, stats, node_base, limit))
+	if(local_Subdivide(node, Boxes, centers, stats, node_base, limit, nbSAHBins))
 	{
 		AABBTreeNode* pos = const_cast<AABBTreeNode*>(node->getPos());
 		AABBTreeNode* neg = const_cast<AABBTreeNode*>(node->getNeg());
-		local_BuildHierarchy(pos, Boxes, centers, stats, node_base, limit);
-		local_BuildHierarchy(neg, Boxes, centers, stats, node_base, limit);
+		local_BuildHierarchy(pos, Boxes, centers, stats, node_base, limit, nbSAHBins);
+		local_BuildHierarchy(neg, Boxes, centers, stats, node_base, limit, nbSAHBins);
 	}
 }
 
-bool AABBTree::buildFromMesh(SourceMesh& mesh, PxU32 limit)
+// PT: parallel build. The top of the tree is subdivided serially, down to a set of independent subtrees that are then
+// built in parallel, each in its own pool of nodes. The subtrees are finally copied to the main pool in the order the
+// serial build would have allocated their nodes, so that the resulting tree is exactly the same as with the serial build.
+#define NB_PRIMS_PER_SUBTREE	4096	// Nodes with fewer primitives are not subdivided further by the serial top-down pass
+#define MAX_SUBTREE_DEPTH		6		// Depth at which the top-down pass stops, i.e. at most 2^MAX_SUBTREE_DEPTH subtrees
+#define MAX_NB_TOP_NODES		((2<<MAX_SUBTREE_DEPTH)-1)
+
+namespace
+{
+	struct Subtree
+	{
+		AABBTreeNode*	mNodes;		// Local pool of nodes. The first node is the subtree's root.
+		PxU32			mNbNodes;	// Number of used nodes in the pool
+	};
+
+	struct BuildSubtreesJob
+	{
+		const PxBounds3*	mBoxes;
+		const PxVec3*		mCenters;
+		Subtree*			mSubtrees;
+		PxU32				mLimit;
+		PxU32				mNbSAHBins;
+
+		void operator()(PxU32 index)
+		{
+			Subtree& subtree = mSubtrees[index];
+
+			BuildStats stats;
+			stats.setCount(1);
+			local_BuildHierarchy(subtree.mNodes, mBoxes, mCenters, stats, subtree.mNodes, mLimit, mNbSAHBins);
+			subtree.mNbNodes = stats.getCount();
+		}
+	};
+}
+
+static void local_BuildTopHierarchy(AABBTreeNode* node, const PxBounds3* PX_RESTRICT Boxes, const PxVec3* PX_RESTRICT centers, BuildStats& stats, const AABBTreeNode* const PX_RESTRICT node_base, PxU32 limit, PxU32 nbSAHBins, PxU32 depth, Ps::Array<AABBTreeNode*>& subtreeRoots)
+{
+	if(depth==MAX_SUBTREE_DEPTH || node->mNbPrimitives<=NB_PRIMS_PER_SUBTREE)
+	{
+		subtreeRoots.pushBack(node);
+		return;
+	}
+
+	if(local_Subdivide(node, Boxes, centers, stats, node_base, limit, nbSAHBins))
+	{
+		AABBTreeNode* pos = const_cast<AABBTreeNode*>(node->getPos());
+		AABBTreeNode* neg = const_cast<AABBTreeNode*>(node->getNeg());
+		local_BuildTopHierarchy(pos, Boxes, centers, stats, node_base, limit, nbSAHBins, depth+1, subtreeRoots);
+		local_BuildTopHierarchy(neg, Boxes, centers, stats, node_base, limit, nbSAHBins, depth+1, subtreeRoots);
+	}
+}
+
+static PX_FORCE_INLINE void local_CopyNode(AABBTreeNode& dst, const AABBTreeNode& src, const AABBTreeNode* srcBase, AABBTreeNode* dstBase)
+{
+	dst.mBV				= src.mBV;
+	dst.mPos			= src.isLeaf() ? 0 : size_t(dstBase + (src.getPos() - srcBase));
+	dst.mNodePrimitives	= src.mNodePrimitives;
+	dst.mNbPrimitives	= src.mNbPrimitives;
+}
+
+// PT: replays the node allocations of the serial build: the children of a node are allocated when it is subdivided,
+// then the whole positive subtree is built before the negative one.
+static void local_MergeHierarchy(AABBTreeNode* PX_RESTRICT dst, const AABBTreeNode* PX_RESTRICT src, const AABBTreeNode* PX_RESTRICT topNodes, const PxU32* PX_RESTRICT subtreeIndices,
+								const Subtree* PX_RESTRICT subtrees, AABBTreeNode* PX_RESTRICT pool, PxU32& count)
+{
+	const PxU32 subtreeIndex = subtreeIndices[src - topNodes];
+	if(subtreeIndex!=PX_INVALID_U32)
+	{
+		// Local node i>0 is the (i-1)-th node allocated while building the subtree
+		const Subtree& subtree = subtrees[subtreeIndex];
+		AABBTreeNode* dstBase = pool + count - 1;
+		local_CopyNode(*dst, subtree.mNodes[0], subtree.mNodes, dstBase);
+		for(PxU32 i=1;i<subtree.mNbNodes;i++)
+			local_CopyNode(dstBase[i], subtree.mNodes[i], subtree.mNodes, dstBase);
+		count += subtree.mNbNodes - 1;
+		return;
+	}
+
+	dst->mBV			= src->mBV;
+	dst->mNodePrimitives	= src->mNodePrimitives;
+	dst->mNbPrimitives	= src->mNbPrimitives;
+	if(src->isLeaf())
+	{
+		dst->mPos = 0;
+		return;
+	}
+
+	AABBTreeNode* children = pool + count;
+	dst->mPos = size_t(children);
+	count += 2;
+	local_MergeHierarchy(children, src->getPos(), topNodes, subtreeIndices, subtrees, pool, count);
+	local_MergeHierarchy(children+1, src->getNeg(), topNodes, subtreeIndices, subtrees, pool, count);
+}
+
+static PxU32 local_BuildHierarchyParallel(AABBTreeNode* PX_RESTRICT pool, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers, PxU32 limit, PxU32 nbSAHBins, PxCpuDispatcher* dispatcher)
+{
+	AABBTreeNode* topNodes = PX_NEW(AABBTreeNode)[MAX_NB_TOP_NODES];
+	topNodes->mNodePrimitives	= pool->mNodePrimitives;
+	topNodes->mNbPrimitives		= pool->mNbPrimitives;
+
+	BuildStats topStats;
+	topStats.setCount(1);
+	Ps::Array<AABBTreeNode*> subtreeRoots;
+	local_BuildTopHierarchy(topNodes, boxes, centers, topStats, topNodes, limit, nbSAHBins, 0, subtreeRoots);
+	PX_ASSERT(topStats.getCount()<=MAX_NB_TOP_NODES);
+
+	const PxU32 nbSubtrees = subtreeRoots.size();
+	Subtree* subtrees = reinterpret_cast<Subtree*>(PX_ALLOC(sizeof(Subtree)*nbSubtrees, "BV4 subtrees"));
+	PxU32 subtreeIndices[MAX_NB_TOP_NODES];
+	for(PxU32 i=0;i<MAX_NB_TOP_NODES;i++)
+		subtreeIndices[i] = PX_INVALID_U32;
+	for(PxU32 i=0;i<nbSubtrees;i++)
+	{
+		const AABBTreeNode* root = subtreeRoots[i];
+		subtreeIndices[root - topNodes] = i;
+
+		subtrees[i].mNodes = PX_NEW(AABBTreeNode)[root->mNbPrimitives*2 - 1];
+		subtrees[i].mNodes->mNodePrimitives	= root->mNodePrimitives;
+		subtrees[i].mNodes->mNbPrimitives	= root->mNbPrimitives;
+		subtrees[i].mNbNodes = 0;
+	}
+
+	BuildSubtreesJob job;
+	job.mBoxes		= boxes;
+	job.mCenters	= centers;
+	job.mSubtrees	= subtrees;
+	job.mLimit		= limit;
+	job.mNbSAHBins	= nbSAHBins;
+	Cm::runParallelJobs(dispatcher, nbSubtrees, job);
+
+	PxU32 count = 1;
+	local_MergeHierarchy(pool, topNodes, topNodes, subtreeIndices, subtrees, pool, count);
+
+	for(PxU32 i=0;i<nbSubtrees;i++)
+		DELETEARRAY(subtrees[i].mNodes);
+	PX_FREE(subtrees);
+	DELETEARRAY(topNodes);
+	return count;
+}
+
+bool AABBTree::buildFromMesh(SourceMesh& mesh, PxU32 limit, PxU32 nbSAHBins, PxCpuDispatcher* dispatcher)
 {
 	const PxU32 nbBoxes = mesh.getNbTriangles();
 	if(!nbBoxes)
@@ -293,10 +547,17 @@ bool AABBTree::buildFromMesh(SourceMesh& mesh, PxU32 limit)
 		mPool->mNbPrimitives	= nbBoxes;
 
 		// Build the hierarchy
-		local_BuildHierarchy(mPool, boxes, centers, Stats, mPool, limit);
+		if(dispatcher && nbBoxes>NB_PRIMS_PER_SUBTREE)
+		{
+			mTotalNbNodes = local_BuildHierarchyParallel(mPool, boxes, centers, limit, nbSAHBins, dispatcher);
+		}
+		else
+		{
+			local_BuildHierarchy(mPool, boxes, centers, Stats, mPool, limit, nbSAHBins);
 
-		// Get back total number of nodes
-		mTotalNbNodes = Stats.getCount();
+			// Get back total number of nodes
+			mTotalNbNodes = Stats.getCount();
+		}
 	}
 
 	PX_FREE(centers);
@@ -462,13 +723,25 @@ struct BV4Node : public physx::shdfnd::UserAllocated
 };
 
 #define NB_NODES_PER_SLAB	256
-struct BV4BuildParams
+#define MAX_SERIAL_BV4_DEPTH	3	// Depth below which nodes are built by parallel jobs, i.e. at most 4^MAX_SERIAL_BV4_DEPTH jobs
+
+struct DeferredBV4Node
+{
+	PX_FORCE_INLINE	DeferredBV4Node(BV4Node* node4, const AABBTreeNode* node) : mNode4(node4), mNode(node)	{}
+
+	BV4Node*			mNode4;
+	const AABBTreeNode*	mNode;
+};
+
+struct BV4BuildParams : public physx::shdfnd::UserAllocated
 {
-	PX_FORCE_INLINE	BV4BuildParams(float epsilon) : mEpsilon(epsilon)
+	PX_FORCE_INLINE	BV4BuildParams(float epsilon) : mNbNodes(0), mEpsilon(epsilon), mDepth(0), mDeferredNodes(NULL)
 #ifdef GU_BV4_USE_NODE_POOLS
 		,mTop(NULL)
 #endif
-	{}
+	{
+		mStats[0] = mStats[1] = mStats[2] = mStats[3] = 0;
+	}
 					~BV4BuildParams();
 
 	// Stats
@@ -478,6 +751,10 @@ struct BV4BuildParams
 	//
 	float			mEpsilon;
 
+	// Parallel build: when mDeferredNodes is set, nodes below MAX_SERIAL_BV4_DEPTH are recorded there instead of being built
+	PxU32							mDepth;
+	Ps::Array<DeferredBV4Node>*		mDeferredNodes;
+
 #ifdef GU_BV4_USE_NODE_POOLS
 	//
 	struct Slab : public physx::shdfnd::UserAllocated
@@ -569,6 +846,44 @@ static BV4Node* setNode(const AABBTree& source, BV4Node* node4, PxU32 i, const A
 	return child;
 }
 
+static void _BuildBV4(const AABBTree& source, BV4Node* tmp, const AABBTreeNode* current_node, BV4BuildParams& params);
+
+static PX_FORCE_INLINE void buildChildBV4(const AABBTree& source, BV4Node* child, const AABBTreeNode* node, BV4BuildParams& params)
+{
+	if(params.mDeferredNodes && params.mDepth==MAX_SERIAL_BV4_DEPTH)
+	{
+		params.mDeferredNodes->pushBack(DeferredBV4Node(child, node));
+		return;
+	}
+	params.mDepth++;
+	_BuildBV4(source, child, node, params);
+	params.mDepth--;
+}
+
+namespace
+{
+	struct BuildBV4NodesJob
+	{
+		const AABBTree*			mSource;
+		const DeferredBV4Node*	mDeferredNodes;
+		BV4BuildParams**		mParams;
+
+		void operator()(PxU32 index)
+		{
+			_BuildBV4(*mSource, mDeferredNodes[index].mNode4, mDeferredNodes[index].mNode, *mParams[index]);
+		}
+	};
+
+	struct DeferredBV4Params : public Ps::Array<BV4BuildParams*>
+	{
+		~DeferredBV4Params()
+		{
+			for(PxU32 i=0;i<size();i++)
+				PX_DELETE((*this)[i]);
+		}
+	};
+}
+
 static void _BuildBV4(const AABBTree& source, BV4Node* tmp, const AABBTreeNode* current_node, BV4BuildParams& params)
 {
 	PX_ASSERT(!current_node->isLeaf());
@@ -685,9 +1000,9 @@ static void _BuildBV4(const AABBTree& source, BV4Node* tmp, const AABBTreeNode*
 			tmp->mBVData[2].mTempPNS = precomputeNodeSorting(NP->mBV, NN->mBV);
 #endif
 			if(ChildNP)
-				_BuildBV4(source, ChildNP, NP, params);
+				buildChildBV4(source, ChildNP, NP, params);
 			if(ChildNN)
-				_BuildBV4(source, ChildNN, NN, params);
+				buildChildBV4(source, ChildNN, NN, params);
 		}
 	}
 	else
@@ -719,9 +1034,9 @@ static void _BuildBV4(const AABBTree& source, BV4Node* tmp, const AABBTreeNode*
 			tmp->mBVData[1].mTempPNS = precomputeNodeSorting(PP->mBV, PN->mBV);
 #endif
 			if(ChildPP)
-				_BuildBV4(source, ChildPP, PP, params);
+				buildChildBV4(source, ChildPP, PP, params);
 			if(ChildPN)
-				_BuildBV4(source, ChildPN, PN, params);
+				buildChildBV4(source, ChildPN, PN, params);
 		}
 		else
 		{
@@ -746,18 +1061,18 @@ static void _BuildBV4(const AABBTree& source, BV4Node* tmp, const AABBTreeNode*
 			tmp->mBVData[2].mTempPNS = precomputeNodeSorting(NP->mBV, NN->mBV);
 #endif
 			if(ChildPP)
-				_BuildBV4(source, ChildPP, PP, params);
+				buildChildBV4(source, ChildPP, PP, params);
 			if(ChildPN)
-				_BuildBV4(source, ChildPN, PN, params);
+				buildChildBV4(source, ChildPN, PN, params);
 			if(ChildNP)
-				_BuildBV4(source, ChildNP, NP, params);
+				buildChildBV4(source, ChildNP, NP, params);
 			if(ChildNN)
-				_BuildBV4(source, ChildNN, NN, params);
+				buildChildBV4(source, ChildNN, NN, params);
 		}
 	}
 }
 
-static bool BuildBV4Internal(BV4Tree& tree, const AABBTree& Source, SourceMesh* mesh, float epsilon)
+static bool BuildBV4Internal(BV4Tree& tree, const AABBTree& Source, SourceMesh* mesh, float epsilon, PxCpuDispatcher* dispatcher)
 {
 	if(mesh->getNbTriangles()<=4)
 		return tree.init(mesh, Source.getBV());
@@ -801,10 +1116,10 @@ static bool BuildBV4Internal(BV4Tree& tree, const AABBTree& Source, SourceMesh*
 
 	BV4BuildParams Params(epsilon);
 	Params.mNbNodes=1;	// Root node
-	Params.mStats[0]=0;
-	Params.mStats[1]=0;
-	Params.mStats[2]=0;
-	Params.mStats[3]=0;
+
+	Ps::Array<DeferredBV4Node> deferredNodes;
+	if(dispatcher)
+		Params.mDeferredNodes = &deferredNodes;
 
 #ifdef GU_BV4_USE_NODE_POOLS
 	BV4Node* Root = Params.allocateNode();
@@ -813,6 +1128,30 @@ static bool BuildBV4Internal(BV4Tree& tree, const AABBTree& Source, SourceMesh*
 #endif
 	_BuildBV4(Source, Root, Source.getNodes(), Params);
 
+	// PT: each deferred node gets its own params, i.e. its own node pool and stats. The BV4 nodes don't depend on the
+	// order in which they are allocated, and the stats are just counters, so this gives the same tree as the serial build.
+	const PxU32 nbDeferredNodes = deferredNodes.size();
+	DeferredBV4Params deferredParams;
+	if(nbDeferredNodes)
+	{
+		deferredParams.resize(nbDeferredNodes);
+		for(PxU32 i=0;i<nbDeferredNodes;i++)
+			deferredParams[i] = PX_NEW(BV4BuildParams)(epsilon);
+
+		BuildBV4NodesJob job;
+		job.mSource			= &Source;
+		job.mDeferredNodes	= deferredNodes.begin();
+		job.mParams			= deferredParams.begin();
+		Cm::runParallelJobs(dispatcher, nbDeferredNodes, job);
+
+		for(PxU32 i=0;i<nbDeferredNodes;i++)
+		{
+			Params.mNbNodes += deferredParams[i]->mNbNodes;
+			for(PxU32 j=0;j<4;j++)
+				Params.mStats[j] += deferredParams[i]->mStats[j];
+		}
+	}
+
 	if(!tree.init(mesh, Source.getBV()))
 		return false;
 	BV4Tree* T = &tree;
@@ -1183,6 +1522,8 @@ static bool BuildBV4Internal(BV4Tree& tree, const AABBTree& Source, SourceMesh*
 
 #ifdef GU_BV4_USE_NODE_POOLS
 		Params.releaseNodes();
+		for(PxU32 i=0;i<nbDeferredNodes;i++)
+			deferredParams[i]->releaseNodes();
 #endif
 
 #ifdef GU_BV4_USE_SLABS
@@ -1262,12 +1603,12 @@ static bool gReorderCallback(const AABBTreeNode* current, PxU32 /*depth*/, void*
 	return true;
 }
 
-bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMesh& mesh, float epsilon, PxU32 nbTrisPerLeaf)
+bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMesh& mesh, float epsilon, PxU32 nbTrisPerLeaf, PxU32 nbSAHBins, PxCpuDispatcher* dispatcher)
 {
 	const PxU32 nbTris = mesh.mNbTris;
 
 	AABBTree Source;
-	if(!Source.buildFromMesh(mesh, nbTrisPerLeaf))
+	if(!Source.buildFromMesh(mesh, nbTrisPerLeaf, nbSAHBins, dispatcher))
 		return false;
 
 	{
@@ -1291,5 +1632,5 @@ bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMesh& mesh, float epsilon, PxU32
 	if(mesh.getNbTriangles()<=nbTrisPerLeaf)
 		return tree.init(&mesh, Source.getBV());
 
-	return BuildBV4Internal(tree, Source, &mesh, epsilon);
+	return BuildBV4Internal(tree, Source, &mesh, epsilon, dispatcher);
 }
@@ -35,6 +35,8 @@
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 namespace Gu
 {
 	class BV4Tree;
@@ -99,7 +101,8 @@ namespace Gu
 											AABBTree();
 											~AABBTree();
 
-						bool				buildFromMesh(SourceMesh& mesh, PxU32 limit);
+						// PT: nbSAHBins = 0 uses the default split heuristic, otherwise the binned SAH with nbSAHBins bins.
+						bool				buildFromMesh(SourceMesh& mesh, PxU32 limit, PxU32 nbSAHBins=0, PxCpuDispatcher* dispatcher=NULL);
 						void				release();
 
 		PX_FORCE_INLINE	const PxU32*		getIndices()		const	{ return mIndices;		}	//!< Catch the indices
@@ -117,7 +120,8 @@ namespace Gu
 						PxU32				mTotalNbNodes;		//!< Number of nodes in the tree.
 	};
 
-	PX_PHYSX_COMMON_API bool BuildBV4Ex(BV4Tree& tree, SourceMesh& mesh, float epsilon, PxU32 nbTrisPerLeaf);
+	// PT: the optional dispatcher is used to build independent parts of the tree in parallel. The result is the same as without it.
+	PX_PHYSX_COMMON_API bool BuildBV4Ex(BV4Tree& tree, SourceMesh& mesh, float epsilon, PxU32 nbTrisPerLeaf, PxU32 nbSAHBins=0, PxCpuDispatcher* dispatcher=NULL);
 
 } // namespace Gu
 }
@@ -35,5 +35,7 @@
 	#define GU_BV4_PRECOMPUTED_NODE_SORT	// Use node sorting or not. This should probably always be enabled.
 	#define GU_BV4_QUANTIZED_TREE			// Use AABB quantization/compression or not.
 	#define GU_BV4_USE_SLABS				// Use swizzled data format or not. Swizzled = faster raycasts, but slower overlaps & larger trees.
+	#define GU_BV4_RAY_PACKET_SIZE	16		// Max number of rays traversing the tree together in packet raycasts.
+	#define GU_BV4_MAX_NB_SAH_BINS	64		// Max number of bins for the SAH build strategy. Must match PxBVH34MidphaseDesc::isValid().
 
 #endif // GU_BV4_SETTINGS_H
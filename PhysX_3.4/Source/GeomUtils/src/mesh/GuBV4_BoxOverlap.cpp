@@ -51,6 +51,7 @@ struct OBBParams : OBBTestParams
 	const IndTri32*	PX_RESTRICT	mTris32;
 	const IndTri16*	PX_RESTRICT	mTris16;
 	const PxVec3*	PX_RESTRICT	mVerts;
+	const CompressedMesh*	PX_RESTRICT	mCompressed;
 
 	PxMat33			mRModelToBox_Padded;	//!< Rotation from model space to obb space
 	Vec3p			mTModelToBox_Padded;	//!< Translation from model space to obb space
@@ -70,9 +71,10 @@ public:
 		do
 		{
 			PxU32 VRef0, VRef1, VRef2;
-			getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+			TriangleVertices TV;
+			getTriangleVertices(TV, VRef0, VRef1, VRef2, primIndex, params);
 
-			if(intersectTriangleBoxBV4(params->mVerts[VRef0], params->mVerts[VRef1], params->mVerts[VRef2], params->mRModelToBox_Padded, params->mTModelToBox_Padded, params->mBoxExtents_PaddedAligned))
+			if(intersectTriangleBoxBV4(*TV.mP[0], *TV.mP[1], *TV.mP[2], params->mRModelToBox_Padded, params->mTModelToBox_Padded, params->mBoxExtents_PaddedAligned))
 				return 1;
 			primIndex++;
 		}while(nbToGo--);
@@ -148,9 +150,10 @@ public:
 		do
 		{
 			PxU32 VRef0, VRef1, VRef2;
-			getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+			TriangleVertices TV;
+			getTriangleVertices(TV, VRef0, VRef1, VRef2, primIndex, params);
 
-			if(intersectTriangleBoxBV4(params->mVerts[VRef0], params->mVerts[VRef1], params->mVerts[VRef2], params->mRModelToBox_Padded, params->mTModelToBox_Padded, params->mBoxExtents_PaddedAligned))
+			if(intersectTriangleBoxBV4(*TV.mP[0], *TV.mP[1], *TV.mP[2], params->mRModelToBox_Padded, params->mTModelToBox_Padded, params->mBoxExtents_PaddedAligned))
 			{
 				OBBParamsAll* ParamsAll = static_cast<OBBParamsAll*>(params);
 				if(ParamsAll->mNbHits==ParamsAll->mMaxNbHits)
@@ -212,12 +215,13 @@ public:
 		do
 		{
 			PxU32 VRef0, VRef1, VRef2;
-			getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+			TriangleVertices TV;
+			getTriangleVertices(TV, VRef0, VRef1, VRef2, primIndex, params);
 
-			if(intersectTriangleBoxBV4(params->mVerts[VRef0], params->mVerts[VRef1], params->mVerts[VRef2], params->mRModelToBox_Padded, params->mTModelToBox_Padded, params->mBoxExtents_PaddedAligned))
+			if(intersectTriangleBoxBV4(*TV.mP[0], *TV.mP[1], *TV.mP[2], params->mRModelToBox_Padded, params->mTModelToBox_Padded, params->mBoxExtents_PaddedAligned))
 			{
 				const PxU32 vrefs[3] = { VRef0, VRef1, VRef2 };
-				if((params->mCallback)(params->mUserData, params->mVerts[VRef0], params->mVerts[VRef1], params->mVerts[VRef2], primIndex, vrefs))
+				if((params->mCallback)(params->mUserData, *TV.mP[0], *TV.mP[1], *TV.mP[2], primIndex, vrefs))
 					return 1;
 			}
 			primIndex++;
@@ -293,8 +297,9 @@ static bool CapsuleVsTriangle_SAT(const PxVec3& p0, const PxVec3& p1, const PxVe
 static Ps::IntBool PX_FORCE_INLINE __CapsuleTriangle(const CapsuleParamsAny* PX_RESTRICT params, PxU32 primIndex)
 {
 	PxU32 VRef0, VRef1, VRef2;
-	getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
-	return CapsuleVsTriangle_SAT(params->mVerts[VRef0], params->mVerts[VRef1], params->mVerts[VRef2], params);
+	TriangleVertices TV;
+	getTriangleVertices(TV, VRef0, VRef1, VRef2, primIndex, params);
+	return CapsuleVsTriangle_SAT(*TV.mP[0], *TV.mP[1], *TV.mP[2], params);
 }
 
 namespace
@@ -428,11 +433,12 @@ public:
 		do
 		{
 			PxU32 VRef0, VRef1, VRef2;
-			getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+			TriangleVertices TV;
+			getTriangleVertices(TV, VRef0, VRef1, VRef2, primIndex, params);
 
-			const PxVec3& p0 = params->mVerts[VRef0];
-			const PxVec3& p1 = params->mVerts[VRef1];
-			const PxVec3& p2 = params->mVerts[VRef2];
+			const PxVec3& p0 = *TV.mP[0];
+			const PxVec3& p1 = *TV.mP[1];
+			const PxVec3& p2 = *TV.mP[2];
 
 			if(CapsuleVsTriangle_SAT(p0, p1, p2, params))
 			{
@@ -78,11 +78,12 @@ static PX_FORCE_INLINE Vec4V multiply3x3V(const Vec4V p, const PxMat33& mat_Padd
 static bool /*__fastcall*/ triBoxSweep(BoxSweepParams* PX_RESTRICT params, PxU32 primIndex, bool nodeSorting=true)
 {
 	PxU32 VRef0, VRef1, VRef2;
-	getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+	TriangleVertices TV;
+	getTriangleVertices(TV, VRef0, VRef1, VRef2, primIndex, params);
 
-	const PxVec3& p0 = params->mVerts[VRef0];
-	const PxVec3& p1 = params->mVerts[VRef1];
-	const PxVec3& p2 = params->mVerts[VRef2];
+	const PxVec3& p0 = *TV.mP[0];
+	const PxVec3& p1 = *TV.mP[1];
+	const PxVec3& p2 = *TV.mP[2];
 
 	// Don't bother doing the actual sweep test if the triangle is too far away
 	if(1)
@@ -410,11 +411,12 @@ public:
 			// as soon as we find one. There is no need for shrinking or ordered traversals here.
 
 			PxU32 VRef0, VRef1, VRef2;
-			getVertexReferences(VRef0, VRef1, VRef2, prim_index, params->mTris32, params->mTris16);
+			TriangleVertices TV;
+			getTriangleVertices(TV, VRef0, VRef1, VRef2, prim_index, params);
 
-			const PxVec3& p0 = params->mVerts[VRef0];
-			const PxVec3& p1 = params->mVerts[VRef1];
-			const PxVec3& p2 = params->mVerts[VRef2];
+			const PxVec3& p0 = *TV.mP[0];
+			const PxVec3& p1 = *TV.mP[1];
+			const PxVec3& p2 = *TV.mP[2];
 
 			// Don't bother doing the actual sweep test if the triangle is too far away
 			const float dp0 = p0.dot(params->mLocalDir_Padded);
@@ -459,11 +461,12 @@ public:
 		do
 		{
 			PxU32 VRef0, VRef1, VRef2;
-			getVertexReferences(VRef0, VRef1, VRef2, prim_index, params->mTris32, params->mTris16);
+			TriangleVertices TV;
+			getTriangleVertices(TV, VRef0, VRef1, VRef2, prim_index, params);
 
-			const PxVec3& p0 = params->mVerts[VRef0];
-			const PxVec3& p1 = params->mVerts[VRef1];
-			const PxVec3& p2 = params->mVerts[VRef2];
+			const PxVec3& p0 = *TV.mP[0];
+			const PxVec3& p1 = *TV.mP[1];
+			const PxVec3& p2 = *TV.mP[2];
 
 			{
 //				const PxU32 vrefs[3] = { VRef0, VRef1, VRef2 };
@@ -46,6 +46,7 @@ struct BoxSweepParams : OBBTestParams
 	const IndTri32*	PX_RESTRICT	mTris32;
 	const IndTri16*	PX_RESTRICT	mTris16;
 	const PxVec3*	PX_RESTRICT	mVerts;
+	const CompressedMesh*	PX_RESTRICT	mCompressed;
 
 #ifndef SWEEP_AABB_IMPL
 	Box					mLocalBox;
@@ -243,11 +243,12 @@ static PX_FORCE_INLINE bool sweepCapsuleVsTriangle(const CapsuleSweepParams* PX_
 static bool /*__fastcall*/ triCapsuleSweep(CapsuleSweepParams* PX_RESTRICT params, PxU32 primIndex, bool nodeSorting=true)
 {
 	PxU32 VRef0, VRef1, VRef2;
-	getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+	TriangleVertices TV;
+	getTriangleVertices(TV, VRef0, VRef1, VRef2, primIndex, params);
 
-	const PxVec3& p0 = params->mVerts[VRef0];
-	const PxVec3& p1 = params->mVerts[VRef1];
-	const PxVec3& p2 = params->mVerts[VRef2];
+	const PxVec3& p0 = *TV.mP[0];
+	const PxVec3& p1 = *TV.mP[1];
+	const PxVec3& p2 = *TV.mP[2];
 
 	const PxTriangle Tri(p0, p1, p2);	// PT: TODO: check calls to empty ctor/dtor here (TA34704)
 
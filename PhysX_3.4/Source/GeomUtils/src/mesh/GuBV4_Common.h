@@ -37,6 +37,7 @@
 #include "GuSphere.h"
 #include "GuCapsule.h"
 #include "GuSIMDHelpers.h"
+#include "GuMeshCompression.h"
 
 #define BV4_ALIGN16(x)	PX_ALIGN_PREFIX(16)	x PX_ALIGN_SUFFIX(16)
 
@@ -92,6 +93,7 @@ namespace Gu
 	typedef		bool		(*MeshOverlapCallback)		(void* userData, const PxVec3& p0, const PxVec3& p1, const PxVec3& p2, PxU32 triangleIndex, const PxU32* vertexIndices);
 	typedef		bool		(*MeshSweepCallback)		(void* userData, const PxVec3& p0, const PxVec3& p1, const PxVec3& p2, PxU32 triangleIndex, /*const PxU32* vertexIndices,*/ float& dist);
 	typedef		bool		(*SweepUnlimitedCallback)	(void* userData, const SweepHit& hit);
+	typedef		bool		(*MeshMeshOverlapCallback)	(void* userData, PxU32 triangleIndex0, PxU32 triangleIndex1);
 
 	template<class ParamsT>
 	PX_FORCE_INLINE	void reportUnlimitedCallbackHit(ParamsT* PX_RESTRICT params, const SweepHit& hit)
@@ -233,6 +235,7 @@ namespace Gu
 		params->mTris32	= mesh->getTris32();
 		params->mTris16	= mesh->getTris16();
 		params->mVerts	= mesh->getVerts();
+		params->mCompressed	= mesh->getCompressedMesh();
 
 #ifdef GU_BV4_QUANTIZED_TREE
 		V4StoreA_Safe(V4LoadU_Safe(&tree->mCenterOrMinCoeff.x), &params->mCenterOrMinCoeff_PaddedAligned.x);
@@ -242,6 +245,40 @@ namespace Gu
 #endif
 	}
 
+	// Vertices of a triangle touched by a query: references to the mesh vertices, or copies decoded from the compressed mesh.
+	struct TriangleVertices
+	{
+		const PxVec3*	mP[3];
+		PxVec3			mDecoded[3];
+		float			mPad;		// makes it safe to V4Load the last decoded vertex
+	};
+
+	template<class ParamsT>
+	PX_FORCE_INLINE void getTriangleVertices(TriangleVertices& tv, PxU32& vref0, PxU32& vref1, PxU32& vref2, PxU32 primIndex, const ParamsT* PX_RESTRICT params)
+	{
+		const CompressedMesh* compressed = params->mCompressed;
+		if(!compressed)
+		{
+			getVertexReferences(vref0, vref1, vref2, primIndex, params->mTris32, params->mTris16);
+			tv.mP[0] = params->mVerts + vref0;
+			tv.mP[1] = params->mVerts + vref1;
+			tv.mP[2] = params->mVerts + vref2;
+			return;
+		}
+
+		if(compressed->hasIndices())
+			compressed->getVertexReferences(primIndex, vref0, vref1, vref2);
+		else
+			getVertexReferences(vref0, vref1, vref2, primIndex, params->mTris32, params->mTris16);
+
+		tv.mDecoded[0] = compressed->getVertex(vref0);
+		tv.mDecoded[1] = compressed->getVertex(vref1);
+		tv.mDecoded[2] = compressed->getVertex(vref2);
+		tv.mP[0] = &tv.mDecoded[0];
+		tv.mP[1] = &tv.mDecoded[1];
+		tv.mP[2] = &tv.mDecoded[2];
+	}
+
 	PX_FORCE_INLINE void rotateBox(Gu::Box& dst, const PxMat44& m, const Gu::Box& src)
 	{
 		// The extents remain constant
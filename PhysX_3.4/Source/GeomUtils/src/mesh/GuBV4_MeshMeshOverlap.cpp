@@ -0,0 +1,615 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "GuBV4.h"
+#include "PsFoundation.h"
+#include "PsInlineArray.h"
+#include "PsBitUtils.h"
+#include "PsUtilities.h"
+using namespace physx;
+using namespace Gu;
+
+#include "PsVecMath.h"
+using namespace physx::shdfnd::aos;
+
+#include "GuBV4_Common.h"
+
+// This file contains the mesh-vs-mesh overlap: both BV4 trees are traversed together, and the triangles of
+// overlapping leaves are tested against each other. Everything happens in the vertex space of the first mesh.
+
+#ifdef GU_BV4_USE_SLABS
+
+namespace
+{
+	struct MeshMeshParams
+	{
+		const IndTri32*			mTris32[2];
+		const IndTri16*			mTris16[2];
+		const PxVec3*			mVerts[2];
+		const CompressedMesh*	mCompressed[2];
+		const BVDataPacked*		mNodes[2];
+#ifdef GU_BV4_QUANTIZED_TREE
+		PxVec3					mMinCoeff[2];
+		PxVec3					mMaxCoeff[2];
+#endif
+		PxMat33					mRot;		// mesh 1 to mesh 0
+		PxMat33					mAbsRot;
+		PxVec3					mTrans;
+		MeshMeshOverlapCallback	mCallback;
+		void*					mUserData;
+	};
+
+	// A pair of tree 0 / tree 1 entries. The data is either a leaf or the children's data, as in the single-tree
+	// traversals. Both boxes are in mesh 0 space.
+	struct NodePair
+	{
+		PxU32	mData0;
+		PxU32	mData1;
+		PxVec3	mCenter0;
+		PxVec3	mExtents0;
+		PxVec3	mCenter1;
+		PxVec3	mExtents1;
+	};
+
+	struct ChildBoxes
+	{
+		BV4_ALIGN16(float	mCenterX[4]);
+		BV4_ALIGN16(float	mCenterY[4]);
+		BV4_ALIGN16(float	mCenterZ[4]);
+		BV4_ALIGN16(float	mExtentsX[4]);
+		BV4_ALIGN16(float	mExtentsY[4]);
+		BV4_ALIGN16(float	mExtentsZ[4]);
+
+		PX_FORCE_INLINE	PxVec3	getCenter(PxU32 i)	const	{ return PxVec3(mCenterX[i], mCenterY[i], mCenterZ[i]);		}
+		PX_FORCE_INLINE	PxVec3	getExtents(PxU32 i)	const	{ return PxVec3(mExtentsX[i], mExtentsY[i], mExtentsZ[i]);	}
+	};
+
+	// Leaf triangles of the second mesh, converted to mesh 0 space. They are stored twice: as regular vectors for the
+	// exact test, and in SoA form (vertices and planes) for the 4-wide rejection tests.
+	struct LeafTriangles
+	{
+		BV4_ALIGN16(float	mX[3][16]);
+		BV4_ALIGN16(float	mY[3][16]);
+		BV4_ALIGN16(float	mZ[3][16]);
+		BV4_ALIGN16(float	mNX[16]);
+		BV4_ALIGN16(float	mNY[16]);
+		BV4_ALIGN16(float	mNZ[16]);
+		BV4_ALIGN16(float	mD[16]);
+		PxVec3				mVerts[16][3];
+		PxU32				mNbTris;
+		PxU32				mFirstTri;
+	};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Exact triangle-triangle test, from Tomas Moller's "A Fast Triangle-Triangle Intersection Test".
+
+// Tests if edge (v0,v1) intersects one of the edges of (u0,u1,u2), in the plane (i0,i1)
+static PX_FORCE_INLINE bool edgeEdgeTest(const PxVec3& v0, float ax, float ay, const PxVec3& u0, const PxVec3& u1, PxU32 i0, PxU32 i1)
+{
+	const float bx = u0[i0] - u1[i0];
+	const float by = u0[i1] - u1[i1];
+	const float cx = v0[i0] - u0[i0];
+	const float cy = v0[i1] - u0[i1];
+	const float f = ay*bx - ax*by;
+	const float d = by*cx - bx*cy;
+	if((f>0.0f && d>=0.0f && d<=f) || (f<0.0f && d<=0.0f && d>=f))
+	{
+		const float e = ax*cy - ay*cx;
+		if(f>0.0f)
+			return e>=0.0f && e<=f;
+		else
+			return e<=0.0f && e>=f;
+	}
+	return false;
+}
+
+static PX_FORCE_INLINE bool edgeTriangleEdgesTest(const PxVec3& v0, const PxVec3& v1, const PxVec3* u, PxU32 i0, PxU32 i1)
+{
+	const float ax = v1[i0] - v0[i0];
+	const float ay = v1[i1] - v0[i1];
+	return edgeEdgeTest(v0, ax, ay, u[0], u[1], i0, i1) || edgeEdgeTest(v0, ax, ay, u[1], u[2], i0, i1) || edgeEdgeTest(v0, ax, ay, u[2], u[0], i0, i1);
+}
+
+static PX_FORCE_INLINE bool pointInTriangle(const PxVec3& p, const PxVec3* u, PxU32 i0, PxU32 i1)
+{
+	float a = u[1][i1] - u[0][i1];
+	float b = -(u[1][i0] - u[0][i0]);
+	float c = -a*u[0][i0] - b*u[0][i1];
+	const float d0 = a*p[i0] + b*p[i1] + c;
+
+	a = u[2][i1] - u[1][i1];
+	b = -(u[2][i0] - u[1][i0]);
+	c = -a*u[1][i0] - b*u[1][i1];
+	const float d1 = a*p[i0] + b*p[i1] + c;
+
+	a = u[0][i1] - u[2][i1];
+	b = -(u[0][i0] - u[2][i0]);
+	c = -a*u[2][i0] - b*u[2][i1];
+	const float d2 = a*p[i0] + b*p[i1] + c;
+
+	return d0*d1>0.0f && d0*d2>0.0f;
+}
+
+static bool coplanarTriangles(const PxVec3& n, const PxVec3* v, const PxVec3* u)
+{
+	// Project onto the axis-aligned plane that maximizes the triangles' area
+	const PxVec3 a(PxAbs(n.x), PxAbs(n.y), PxAbs(n.z));
+	PxU32 i0, i1;
+	if(a.x>a.y)
+	{
+		if(a.x>a.z)	{ i0 = 1; i1 = 2; }	// a.x is greatest
+		else		{ i0 = 0; i1 = 1; }	// a.z is greatest
+	}
+	else
+	{
+		if(a.z>a.y)	{ i0 = 0; i1 = 1; }	// a.z is greatest
+		else		{ i0 = 0; i1 = 2; }	// a.y is greatest
+	}
+
+	if(edgeTriangleEdgesTest(v[0], v[1], u, i0, i1) || edgeTriangleEdgesTest(v[1], v[2], u, i0, i1) || edgeTriangleEdgesTest(v[2], v[0], u, i0, i1))
+		return true;
+
+	// One triangle may be fully contained in the other
+	return pointInTriangle(v[0], u, i0, i1) || pointInTriangle(u[0], v, i0, i1);
+}
+
+static PX_FORCE_INLINE void computeInterval(float vv0, float vv1, float vv2, float d0, float d1, float d2, float& isect0, float& isect1)
+{
+	// vertex 0 is alone on its side of the plane
+	isect0 = vv0 + (vv1 - vv0)*d0/(d0 - d1);
+	isect1 = vv0 + (vv2 - vv0)*d0/(d0 - d2);
+}
+
+// Returns false if the triangles are coplanar
+static PX_FORCE_INLINE bool computeIntervals(float vv0, float vv1, float vv2, float d0, float d1, float d2, float& isect0, float& isect1)
+{
+	if(d0*d1>0.0f)
+		computeInterval(vv2, vv0, vv1, d2, d0, d1, isect0, isect1);
+	else if(d0*d2>0.0f)
+		computeInterval(vv1, vv0, vv2, d1, d0, d2, isect0, isect1);
+	else if(d1*d2>0.0f || d0!=0.0f)
+		computeInterval(vv0, vv1, vv2, d0, d1, d2, isect0, isect1);
+	else if(d1!=0.0f)
+		computeInterval(vv1, vv0, vv2, d1, d0, d2, isect0, isect1);
+	else if(d2!=0.0f)
+		computeInterval(vv2, vv0, vv1, d2, d0, d1, isect0, isect1);
+	else
+		return false;
+	return true;
+}
+
+static bool triangleTriangleOverlap(const PxVec3* v, const PxVec3* u)
+{
+	// Plane of triangle v, triangle u must straddle it
+	const PxVec3 n1 = (v[1] - v[0]).cross(v[2] - v[0]);
+	const float d1 = -n1.dot(v[0]);
+	const float du0 = n1.dot(u[0]) + d1;
+	const float du1 = n1.dot(u[1]) + d1;
+	const float du2 = n1.dot(u[2]) + d1;
+	const float du0du1 = du0*du1;
+	const float du0du2 = du0*du2;
+	if(du0du1>0.0f && du0du2>0.0f)
+		return false;
+
+	// Plane of triangle u, triangle v must straddle it
+	const PxVec3 n2 = (u[1] - u[0]).cross(u[2] - u[0]);
+	const float d2 = -n2.dot(u[0]);
+	const float dv0 = n2.dot(v[0]) + d2;
+	const float dv1 = n2.dot(v[1]) + d2;
+	const float dv2 = n2.dot(v[2]) + d2;
+	if(dv0*dv1>0.0f && dv0*dv2>0.0f)
+		return false;
+
+	// Both triangles cross the intersection line of the planes, compare their intervals on it. The line is projected
+	// onto its largest axis, which keeps the intervals' ordering.
+	const PxVec3 dir = n1.cross(n2);
+	const PxU32 index = PxAbs(dir.x)>PxAbs(dir.y) ? (PxAbs(dir.x)>PxAbs(dir.z) ? 0u : 2u) : (PxAbs(dir.y)>PxAbs(dir.z) ? 1u : 2u);
+
+	float isect10, isect11, isect20, isect21;
+	if(!computeIntervals(v[0][index], v[1][index], v[2][index], dv0, dv1, dv2, isect10, isect11))
+		return coplanarTriangles(n1, v, u);
+	if(!computeIntervals(u[0][index], u[1][index], u[2][index], du0, du1, du2, isect20, isect21))
+		return coplanarTriangles(n1, v, u);
+
+	if(isect10>isect11)
+		Ps::swap(isect10, isect11);
+	if(isect20>isect21)
+		Ps::swap(isect20, isect21);
+
+	return !(isect11<isect20 || isect21<isect10);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static PX_FORCE_INLINE void fetchTriangle(PxVec3* v, PxU32 meshIndex, PxU32 triangleIndex, const MeshMeshParams* PX_RESTRICT params)
+{
+	PxU32 vref0, vref1, vref2;
+	const CompressedMesh* compressed = params->mCompressed[meshIndex];
+	if(compressed && compressed->hasIndices())
+		compressed->getVertexReferences(triangleIndex, vref0, vref1, vref2);
+	else
+		getVertexReferences(vref0, vref1, vref2, triangleIndex, params->mTris32[meshIndex], params->mTris16[meshIndex]);
+
+	if(compressed)
+	{
+		v[0] = compressed->getVertex(vref0);
+		v[1] = compressed->getVertex(vref1);
+		v[2] = compressed->getVertex(vref2);
+		return;
+	}
+
+	const PxVec3* verts = params->mVerts[meshIndex];
+	v[0] = verts[vref0];
+	v[1] = verts[vref1];
+	v[2] = verts[vref2];
+}
+
+static void setupLeafTriangles(LeafTriangles& leaf, PxU32 primIndex, const MeshMeshParams* PX_RESTRICT params)
+{
+	const PxU32 nbTris = primIndex & 15;
+	const PxU32 firstTri = primIndex>>4;
+	leaf.mNbTris = nbTris;
+	leaf.mFirstTri = firstTri;
+
+	for(PxU32 i=0;i<nbTris;i++)
+	{
+		PxVec3 local[3];
+		fetchTriangle(local, 1, firstTri + i, params);
+
+		PxVec3* v = leaf.mVerts[i];
+		for(PxU32 j=0;j<3;j++)
+		{
+			v[j] = params->mRot * local[j] + params->mTrans;
+			leaf.mX[j][i] = v[j].x;
+			leaf.mY[j][i] = v[j].y;
+			leaf.mZ[j][i] = v[j].z;
+		}
+
+		const PxVec3 n = (v[1] - v[0]).cross(v[2] - v[0]);
+		leaf.mNX[i] = n.x;
+		leaf.mNY[i] = n.y;
+		leaf.mNZ[i] = n.z;
+		leaf.mD[i] = n.dot(v[0]);
+	}
+
+	// Pad the last batch with copies of the first triangle, these lanes are masked out anyway
+	const PxU32 nbPadded = (nbTris+3)&~3;
+	for(PxU32 i=nbTris;i<nbPadded;i++)
+	{
+		for(PxU32 j=0;j<3;j++)
+		{
+			leaf.mX[j][i] = leaf.mX[j][0];
+			leaf.mY[j][i] = leaf.mY[j][0];
+			leaf.mZ[j][i] = leaf.mZ[j][0];
+		}
+		leaf.mNX[i] = leaf.mNX[0];
+		leaf.mNY[i] = leaf.mNY[0];
+		leaf.mNZ[i] = leaf.mNZ[0];
+		leaf.mD[i] = leaf.mD[0];
+	}
+}
+
+// Returns a mask of the lanes whose three signed distances are all strictly positive or all strictly negative,
+// i.e. the triangle pairs separated by the plane.
+static PX_FORCE_INLINE PxU32 separatedByPlane(const Vec4V d0, const Vec4V d1, const Vec4V d2)
+{
+	const Vec4V zero = V4Zero();
+	const BoolV above = BAnd(BAnd(V4IsGrtr(d0, zero), V4IsGrtr(d1, zero)), V4IsGrtr(d2, zero));
+	const BoolV below = BAnd(BAnd(V4IsGrtr(zero, d0), V4IsGrtr(zero, d1)), V4IsGrtr(zero, d2));
+	return BGetBitMask(BOr(above, below));
+}
+
+// Tests all the triangles of the tree 0 leaf against the tree 1 leaf triangles. Each tree 0 triangle is tested against 4 triangles
+// at a time: the plane rejection tests run 4-wide, the remaining candidates go through the exact test.
+static Ps::IntBool processLeafPair(PxU32 primIndex0, const LeafTriangles& leaf1, const MeshMeshParams* PX_RESTRICT params)
+{
+	const PxU32 nbTris0 = primIndex0 & 15;
+	const PxU32 firstTri0 = primIndex0>>4;
+	const PxU32 nbTris1 = leaf1.mNbTris;
+
+	for(PxU32 i=0;i<nbTris0;i++)
+	{
+		PxVec3 v[3];
+		fetchTriangle(v, 0, firstTri0 + i, params);
+
+		const PxVec3 n = (v[1] - v[0]).cross(v[2] - v[0]);
+		const Vec4V nx = V4Load(n.x);
+		const Vec4V ny = V4Load(n.y);
+		const Vec4V nz = V4Load(n.z);
+		const Vec4V d = V4Load(n.dot(v[0]));
+
+		for(PxU32 batch=0;batch<nbTris1;batch+=4)
+		{
+			// Tree 1 triangles vs plane of the tree 0 triangle
+			const Vec4V du0 = V4Sub(V4MulAdd(nz, V4LoadA(&leaf1.mZ[0][batch]), V4MulAdd(ny, V4LoadA(&leaf1.mY[0][batch]), V4Mul(nx, V4LoadA(&leaf1.mX[0][batch])))), d);
+			const Vec4V du1 = V4Sub(V4MulAdd(nz, V4LoadA(&leaf1.mZ[1][batch]), V4MulAdd(ny, V4LoadA(&leaf1.mY[1][batch]), V4Mul(nx, V4LoadA(&leaf1.mX[1][batch])))), d);
+			const Vec4V du2 = V4Sub(V4MulAdd(nz, V4LoadA(&leaf1.mZ[2][batch]), V4MulAdd(ny, V4LoadA(&leaf1.mY[2][batch]), V4Mul(nx, V4LoadA(&leaf1.mX[2][batch])))), d);
+			PxU32 rejected = separatedByPlane(du0, du1, du2);
+
+			// Tree 0 triangle vs planes of the tree 1 triangles
+			const Vec4V n1x = V4LoadA(&leaf1.mNX[batch]);
+			const Vec4V n1y = V4LoadA(&leaf1.mNY[batch]);
+			const Vec4V n1z = V4LoadA(&leaf1.mNZ[batch]);
+			const Vec4V d1 = V4LoadA(&leaf1.mD[batch]);
+			const Vec4V dv0 = V4Sub(V4MulAdd(n1z, V4Load(v[0].z), V4MulAdd(n1y, V4Load(v[0].y), V4Mul(n1x, V4Load(v[0].x)))), d1);
+			const Vec4V dv1 = V4Sub(V4MulAdd(n1z, V4Load(v[1].z), V4MulAdd(n1y, V4Load(v[1].y), V4Mul(n1x, V4Load(v[1].x)))), d1);
+			const Vec4V dv2 = V4Sub(V4MulAdd(n1z, V4Load(v[2].z), V4MulAdd(n1y, V4Load(v[2].y), V4Mul(n1x, V4Load(v[2].x)))), d1);
+			rejected |= separatedByPlane(dv0, dv1, dv2);
+
+			const PxU32 nbInBatch = PxMin(nbTris1 - batch, 4u);
+			PxU32 candidates = ~rejected & ((1u<<nbInBatch)-1);
+			while(candidates)
+			{
+				const PxU32 j = Ps::lowestSetBit(candidates);
+				candidates &= candidates - 1;
+
+				if(triangleTriangleOverlap(v, leaf1.mVerts[batch + j]))
+				{
+					if((params->mCallback)(params->mUserData, firstTri0 + i, leaf1.mFirstTri + batch + j))
+						return 1;
+				}
+			}
+		}
+	}
+	return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Computes the boxes of the 4 children of a node, in the node's tree space
+static PX_FORCE_INLINE void getChildBoxes(Vec4V& centerX, Vec4V& centerY, Vec4V& centerZ, Vec4V& extentsX, Vec4V& extentsY, Vec4V& extentsZ,
+											const BVDataSwizzled* PX_RESTRICT node, PxU32 treeIndex, const MeshMeshParams* PX_RESTRICT params)
+{
+	PX_UNUSED(treeIndex);
+	PX_UNUSED(params);
+#ifdef GU_BV4_QUANTIZED_TREE
+	const PxVec3& minCoeff = params->mMinCoeff[treeIndex];
+	const PxVec3& maxCoeff = params->mMaxCoeff[treeIndex];
+	Vec4V minX, minY, minZ, maxX, maxY, maxZ;
+	{
+		const __m128i packed = _mm_load_si128(reinterpret_cast<const __m128i*>(node->mX));
+		minX = V4Mul(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(packed, 16), 16)), V4Load(minCoeff.x));
+		maxX = V4Mul(_mm_cvtepi32_ps(_mm_srai_epi32(packed, 16)), V4Load(maxCoeff.x));
+	}
+	{
+		const __m128i packed = _mm_load_si128(reinterpret_cast<const __m128i*>(node->mY));
+		minY = V4Mul(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(packed, 16), 16)), V4Load(minCoeff.y));
+		maxY = V4Mul(_mm_cvtepi32_ps(_mm_srai_epi32(packed, 16)), V4Load(maxCoeff.y));
+	}
+	{
+		const __m128i packed = _mm_load_si128(reinterpret_cast<const __m128i*>(node->mZ));
+		minZ = V4Mul(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(packed, 16), 16)), V4Load(minCoeff.z));
+		maxZ = V4Mul(_mm_cvtepi32_ps(_mm_srai_epi32(packed, 16)), V4Load(maxCoeff.z));
+	}
+#else
+	const Vec4V minX = V4LoadA(node->mMinX);
+	const Vec4V minY = V4LoadA(node->mMinY);
+	const Vec4V minZ = V4LoadA(node->mMinZ);
+	const Vec4V maxX = V4LoadA(node->mMaxX);
+	const Vec4V maxY = V4LoadA(node->mMaxY);
+	const Vec4V maxZ = V4LoadA(node->mMaxZ);
+#endif
+	const Vec4V half = V4Load(0.5f);
+	centerX = V4Mul(V4Add(maxX, minX), half);
+	centerY = V4Mul(V4Add(maxY, minY), half);
+	centerZ = V4Mul(V4Add(maxZ, minZ), half);
+	extentsX = V4Mul(V4Sub(maxX, minX), half);
+	extentsY = V4Mul(V4Sub(maxY, minY), half);
+	extentsZ = V4Mul(V4Sub(maxZ, minZ), half);
+}
+
+// AABB-AABB tests between the 4 children and a box, returns the mask of overlapping children
+static PX_FORCE_INLINE PxU32 overlapChildBoxes(	const Vec4V centerX, const Vec4V centerY, const Vec4V centerZ,
+												const Vec4V extentsX, const Vec4V extentsY, const Vec4V extentsZ,
+												const PxVec3& center, const PxVec3& extents)
+{
+	const BoolV separatedX = V4IsGrtr(V4Abs(V4Sub(centerX, V4Load(center.x))), V4Add(extentsX, V4Load(extents.x)));
+	const BoolV separatedY = V4IsGrtr(V4Abs(V4Sub(centerY, V4Load(center.y))), V4Add(extentsY, V4Load(extents.y)));
+	const BoolV separatedZ = V4IsGrtr(V4Abs(V4Sub(centerZ, V4Load(center.z))), V4Add(extentsZ, V4Load(extents.z)));
+	return ~BGetBitMask(BOr(BOr(separatedX, separatedY), separatedZ)) & 15;
+}
+
+static PX_FORCE_INLINE PxU32 getValidChildren(const BVDataSwizzled* PX_RESTRICT node, PxU32 childData)
+{
+	const PxU32 nbChildren = ((childData>>1)&3) + 2;
+	PxU32 mask = 0;
+	for(PxU32 i=0;i<nbChildren;i++)
+	{
+		if(node->mData[i]!=PX_INVALID_U32)
+			mask |= 1u<<i;
+	}
+	return mask;
+}
+
+static Ps::IntBool processTrees(PxU32 initData0, PxU32 initData1, const PxBounds3& rootBounds0, const PxBounds3& rootBounds1, const MeshMeshParams* PX_RESTRICT params)
+{
+	Ps::InlineArray<NodePair, GU_BV4_STACK_SIZE> stack;
+
+	{
+		NodePair root;
+		root.mData0		= initData0;
+		root.mData1		= initData1;
+		root.mCenter0	= rootBounds0.getCenter();
+		root.mExtents0	= rootBounds0.getExtents();
+		root.mCenter1	= params->mRot * rootBounds1.getCenter() + params->mTrans;
+		root.mExtents1	= params->mAbsRot * rootBounds1.getExtents();
+		stack.pushBack(root);
+	}
+
+	// Small cache for the converted triangles of the last tree 1 leaf
+	LeafTriangles leaf1;
+	PxU32 cachedLeaf1 = PX_INVALID_U32;
+
+	while(stack.size())
+	{
+		const NodePair pair = stack.popBack();
+		const bool isLeaf0 = (pair.mData0 & 1)!=0;
+		const bool isLeaf1 = (pair.mData1 & 1)!=0;
+
+		if(isLeaf0 && isLeaf1)
+		{
+			const PxU32 primIndex1 = pair.mData1>>1;
+			if(primIndex1!=cachedLeaf1)
+			{
+				setupLeafTriangles(leaf1, primIndex1, params);
+				cachedLeaf1 = primIndex1;
+			}
+			if(processLeafPair(pair.mData0>>1, leaf1, params))
+				return 1;
+			continue;
+		}
+
+		// Descend into the largest node, or into the only internal one
+		const float size0 = pair.mExtents0.x + pair.mExtents0.y + pair.mExtents0.z;
+		const float size1 = pair.mExtents1.x + pair.mExtents1.y + pair.mExtents1.z;
+		const bool descend0 = !isLeaf0 && (isLeaf1 || size0>=size1);
+
+		Vec4V centerX, centerY, centerZ, extentsX, extentsY, extentsZ;
+		if(descend0)
+		{
+			const BVDataSwizzled* node = reinterpret_cast<const BVDataSwizzled*>(params->mNodes[0] + (pair.mData0>>GU_BV4_CHILD_OFFSET_SHIFT_COUNT));
+			getChildBoxes(centerX, centerY, centerZ, extentsX, extentsY, extentsZ, node, 0, params);
+
+			PxU32 mask = overlapChildBoxes(centerX, centerY, centerZ, extentsX, extentsY, extentsZ, pair.mCenter1, pair.mExtents1);
+			mask &= getValidChildren(node, pair.mData0);
+			if(!mask)
+				continue;
+
+			ChildBoxes boxes;
+			V4StoreA(centerX, boxes.mCenterX);	V4StoreA(centerY, boxes.mCenterY);	V4StoreA(centerZ, boxes.mCenterZ);
+			V4StoreA(extentsX, boxes.mExtentsX);	V4StoreA(extentsY, boxes.mExtentsY);	V4StoreA(extentsZ, boxes.mExtentsZ);
+			while(mask)
+			{
+				const PxU32 i = Ps::lowestSetBit(mask);
+				mask &= mask - 1;
+
+				NodePair child = pair;
+				child.mData0	= node->mData[i];
+				child.mCenter0	= boxes.getCenter(i);
+				child.mExtents0	= boxes.getExtents(i);
+				stack.pushBack(child);
+			}
+		}
+		else
+		{
+			const BVDataSwizzled* node = reinterpret_cast<const BVDataSwizzled*>(params->mNodes[1] + (pair.mData1>>GU_BV4_CHILD_OFFSET_SHIFT_COUNT));
+			Vec4V localCX, localCY, localCZ, localEX, localEY, localEZ;
+			getChildBoxes(localCX, localCY, localCZ, localEX, localEY, localEZ, node, 1, params);
+
+			// Move the 4 boxes to mesh 0 space at once. The rotated boxes are bounded by AABBs.
+			const PxMat33& r = params->mRot;
+			const PxMat33& a = params->mAbsRot;
+			centerX = V4MulAdd(V4Load(r.column2.x), localCZ, V4MulAdd(V4Load(r.column1.x), localCY, V4MulAdd(V4Load(r.column0.x), localCX, V4Load(params->mTrans.x))));
+			centerY = V4MulAdd(V4Load(r.column2.y), localCZ, V4MulAdd(V4Load(r.column1.y), localCY, V4MulAdd(V4Load(r.column0.y), localCX, V4Load(params->mTrans.y))));
+			centerZ = V4MulAdd(V4Load(r.column2.z), localCZ, V4MulAdd(V4Load(r.column1.z), localCY, V4MulAdd(V4Load(r.column0.z), localCX, V4Load(params->mTrans.z))));
+			extentsX = V4MulAdd(V4Load(a.column2.x), localEZ, V4MulAdd(V4Load(a.column1.x), localEY, V4Mul(V4Load(a.column0.x), localEX)));
+			extentsY = V4MulAdd(V4Load(a.column2.y), localEZ, V4MulAdd(V4Load(a.column1.y), localEY, V4Mul(V4Load(a.column0.y), localEX)));
+			extentsZ = V4MulAdd(V4Load(a.column2.z), localEZ, V4MulAdd(V4Load(a.column1.z), localEY, V4Mul(V4Load(a.column0.z), localEX)));
+
+			PxU32 mask = overlapChildBoxes(centerX, centerY, centerZ, extentsX, extentsY, extentsZ, pair.mCenter0, pair.mExtents0);
+			mask &= getValidChildren(node, pair.mData1);
+			if(!mask)
+				continue;
+
+			ChildBoxes boxes;
+			V4StoreA(centerX, boxes.mCenterX);	V4StoreA(centerY, boxes.mCenterY);	V4StoreA(centerZ, boxes.mCenterZ);
+			V4StoreA(extentsX, boxes.mExtentsX);	V4StoreA(extentsY, boxes.mExtentsY);	V4StoreA(extentsZ, boxes.mExtentsZ);
+			while(mask)
+			{
+				const PxU32 i = Ps::lowestSetBit(mask);
+				mask &= mask - 1;
+
+				NodePair child = pair;
+				child.mData1	= node->mData[i];
+				child.mCenter1	= boxes.getCenter(i);
+				child.mExtents1	= boxes.getExtents(i);
+				stack.pushBack(child);
+			}
+		}
+	}
+	return 0;
+}
+
+static PX_FORCE_INLINE void setupTree(MeshMeshParams& params, PxU32 index, const BV4Tree& tree)
+{
+	const SourceMesh* mesh = tree.mMeshInterface;
+	params.mTris32[index]	= mesh->getTris32();
+	params.mTris16[index]	= mesh->getTris16();
+	params.mVerts[index]	= mesh->getVerts();
+	params.mCompressed[index]	= mesh->getCompressedMesh();
+	params.mNodes[index]	= tree.mNodes;
+#ifdef GU_BV4_QUANTIZED_TREE
+	params.mMinCoeff[index]	= tree.mCenterOrMinCoeff;
+	params.mMaxCoeff[index]	= tree.mExtentsOrMaxCoeff;
+#endif
+}
+
+static PX_FORCE_INLINE PxU32 getRootData(const BV4Tree& tree)
+{
+	if(tree.mNodes)
+		return tree.mInitData;
+
+	// No tree for small meshes, we use a single leaf containing all the triangles
+	const PxU32 nbTris = tree.mMeshInterface->getNbTriangles();
+	PX_ASSERT(nbTris<16);
+	return (nbTris<<1)|1;
+}
+
+static PX_FORCE_INLINE PxBounds3 getRootBounds(const BV4Tree& tree)
+{
+	return PxBounds3::centerExtents(tree.mLocalBounds.mCenter, PxVec3(tree.mLocalBounds.mExtentsMagnitude));
+}
+
+#endif // GU_BV4_USE_SLABS
+
+void BV4_OverlapMeshCB(const BV4Tree& tree0, const BV4Tree& tree1, const PxMat33& rot1to0, const PxVec3& trans1to0, MeshMeshOverlapCallback callback, void* userData)
+{
+#ifdef GU_BV4_USE_SLABS
+	MeshMeshParams Params;
+	setupTree(Params, 0, tree0);
+	setupTree(Params, 1, tree1);
+	Params.mRot			= rot1to0;
+	Params.mAbsRot		= PxMat33(rot1to0.column0.abs(), rot1to0.column1.abs(), rot1to0.column2.abs());
+	Params.mTrans		= trans1to0;
+	Params.mCallback	= callback;
+	Params.mUserData	= userData;
+
+	processTrees(getRootData(tree0), getRootData(tree1), getRootBounds(tree0), getRootBounds(tree1), &Params);
+#else
+	PX_UNUSED(tree0);
+	PX_UNUSED(tree1);
+	PX_UNUSED(rot1to0);
+	PX_UNUSED(trans1to0);
+	PX_UNUSED(callback);
+	PX_UNUSED(userData);
+	Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "BV4_OverlapMeshCB: only supported with GU_BV4_USE_SLABS.");
+#endif
+}
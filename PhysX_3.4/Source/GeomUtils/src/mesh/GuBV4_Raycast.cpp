@@ -156,6 +156,7 @@ struct RayParams
 	const IndTri32*	PX_RESTRICT	mTris32;
 	const IndTri16*	PX_RESTRICT	mTris16;
 	const PxVec3*	PX_RESTRICT	mVerts;
+	const CompressedMesh*	PX_RESTRICT	mCompressed;
 	PxVec3						mLocalDir_Padded;
 	PxVec3						mOrigin_Padded;
 
@@ -174,11 +175,11 @@ struct RayParams
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static PX_FORCE_INLINE void updateParamsAfterImpact(RayParams* PX_RESTRICT params, PxU32 primIndex, PxU32 VRef0, PxU32 VRef1, PxU32 VRef2, const PxRaycastHit& StabbedFace)
+static PX_FORCE_INLINE void updateParamsAfterImpact(RayParams* PX_RESTRICT params, PxU32 primIndex, const TriangleVertices& TV, const PxRaycastHit& StabbedFace)
 {
-	V4StoreA_Safe(V4LoadU_Safe(&params->mVerts[VRef0].x), &params->mP0_PaddedAligned.x);
-	V4StoreA_Safe(V4LoadU_Safe(&params->mVerts[VRef1].x), &params->mP1_PaddedAligned.x);
-	V4StoreA_Safe(V4LoadU_Safe(&params->mVerts[VRef2].x), &params->mP2_PaddedAligned.x);
+	V4StoreA_Safe(V4LoadU_Safe(&TV.mP[0]->x), &params->mP0_PaddedAligned.x);
+	V4StoreA_Safe(V4LoadU_Safe(&TV.mP[1]->x), &params->mP1_PaddedAligned.x);
+	V4StoreA_Safe(V4LoadU_Safe(&TV.mP[2]->x), &params->mP2_PaddedAligned.x);
 
 	params->mStabbedFace.mTriangleID = primIndex;
 	params->mStabbedFace.mDistance = StabbedFace.distance;
@@ -200,13 +201,14 @@ public:
 		do
 		{
 			PxU32 VRef0, VRef1, VRef2;
-			getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+			TriangleVertices TV;
+			getTriangleVertices(TV, VRef0, VRef1, VRef2, primIndex, params);
 
-			if(RayTriOverlapT<RayParams>(StabbedFace, params->mVerts[VRef0], params->mVerts[VRef1], params->mVerts[VRef2], params))
+			if(RayTriOverlapT<RayParams>(StabbedFace, *TV.mP[0], *TV.mP[1], *TV.mP[2], params))
 			{
 				if(StabbedFace.distance<params->mStabbedFace.mDistance)	//### just for a corner case UT in PhysX :(
 				{
-					updateParamsAfterImpact(params, primIndex, VRef0, VRef1, VRef2, StabbedFace);
+					updateParamsAfterImpact(params, primIndex, TV, StabbedFace);
 
 #ifndef GU_BV4_USE_SLABS
 					setupRayData(params, StabbedFace.distance, params->mOrigin_Padded, params->mLocalDir_Padded);
@@ -230,15 +232,16 @@ public:
 		do
 		{
 			PxU32 VRef0, VRef1, VRef2;
-			getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+			TriangleVertices TV;
+			getTriangleVertices(TV, VRef0, VRef1, VRef2, primIndex, params);
 
 			PX_ALIGN_PREFIX(16)	char buffer[sizeof(PxRaycastHit)] PX_ALIGN_SUFFIX(16);
 			PxRaycastHit& StabbedFace = reinterpret_cast<PxRaycastHit&>(buffer);
-			if(RayTriOverlapT<RayParams>(StabbedFace, params->mVerts[VRef0], params->mVerts[VRef1], params->mVerts[VRef2], params))
+			if(RayTriOverlapT<RayParams>(StabbedFace, *TV.mP[0], *TV.mP[1], *TV.mP[2], params))
 			{
 				if(StabbedFace.distance<params->mStabbedFace.mDistance)	//### just for a corner case UT in PhysX :(
 				{
-					updateParamsAfterImpact(params, primIndex, VRef0, VRef1, VRef2, StabbedFace);
+					updateParamsAfterImpact(params, primIndex, TV, StabbedFace);
 					return 1;
 				}
 			}
@@ -351,6 +354,7 @@ static PX_FORCE_INLINE void setupRayParams(ParamsT* PX_RESTRICT params, const Px
 #ifdef GU_BV4_USE_SLABS
 	#include "GuBV4_Slabs_KajiyaNoOrder.h"
 	#include "GuBV4_Slabs_KajiyaOrdered.h"
+	#include "GuBV4_Slabs_KajiyaPacket.h"
 #endif
 
 #ifndef GU_BV4_USE_SLABS
@@ -478,6 +482,50 @@ Ps::IntBool BV4_RaycastSingle(const PxVec3& origin, const PxVec3& dir, const BV4
 	return computeImpactData(hit, &Params, worldm_Aligned, hitFlags);
 }
 
+// Packet version. All rays share the same flags, and hence the same "any hit" or "closest hit" mode.
+// Returns a mask of the rays that hit the mesh.
+PxU32 BV4_RaycastPacket(PxU32 nbRays, const PxVec3* PX_RESTRICT origins, const PxVec3* PX_RESTRICT dirs, const float* PX_RESTRICT maxDists, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, PxRaycastHit* PX_RESTRICT hits, float geomEpsilon, PxU32 flags, PxHitFlags hitFlags)
+{
+	PX_ASSERT(nbRays && nbRays<=GU_BV4_RAY_PACKET_SIZE);
+
+	const SourceMesh* PX_RESTRICT mesh = tree.mMeshInterface;
+
+	RayParams Params[GU_BV4_RAY_PACKET_SIZE];
+	for(PxU32 i=0;i<nbRays;i++)
+		setupRayParams(Params + i, origins[i], dirs[i], &tree, worldm_Aligned, mesh, maxDists[i], geomEpsilon, flags);
+
+	if(tree.mNodes)
+	{
+#ifdef GU_BV4_USE_SLABS
+		if(Params[0].mEarlyExit)
+			BV4_ProcessStreamKajiyaPacket<LeafFunction_RaycastAny>(tree.mNodes, tree.mInitData, Params, nbRays);
+		else
+			BV4_ProcessStreamKajiyaPacket<LeafFunction_RaycastClosest>(tree.mNodes, tree.mInitData, Params, nbRays);
+#else
+		for(PxU32 i=0;i<nbRays;i++)
+		{
+			if(Params[i].mEarlyExit)
+				processStreamRayNoOrder(0, LeafFunction_RaycastAny)(tree.mNodes, tree.mInitData, Params + i);
+			else
+				processStreamRayOrdered(0, LeafFunction_RaycastClosest)(tree.mNodes, tree.mInitData, Params + i);
+		}
+#endif
+	}
+	else
+	{
+		for(PxU32 i=0;i<nbRays;i++)
+			doBruteForceTests<LeafFunction_RaycastAny, LeafFunction_RaycastClosest>(mesh->getNbTriangles(), Params + i);
+	}
+
+	PxU32 hitMask = 0;
+	for(PxU32 i=0;i<nbRays;i++)
+	{
+		if(computeImpactData(hits + i, Params + i, worldm_Aligned, hitFlags))
+			hitMask |= 1u<<i;
+	}
+	return hitMask;
+}
+
 
 
 // Callback-based version
@@ -500,11 +548,12 @@ public:
 		do
 		{
 			PxU32 VRef0, VRef1, VRef2;
-			getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+			TriangleVertices TV;
+			getTriangleVertices(TV, VRef0, VRef1, VRef2, primIndex, params);
 
-			const PxVec3& p0 = params->mVerts[VRef0];
-			const PxVec3& p1 = params->mVerts[VRef1];
-			const PxVec3& p2 = params->mVerts[VRef2];
+			const PxVec3& p0 = *TV.mP[0];
+			const PxVec3& p1 = *TV.mP[1];
+			const PxVec3& p2 = *TV.mP[2];
 
 			PX_ALIGN_PREFIX(16)	char buffer[sizeof(PxRaycastHit)] PX_ALIGN_SUFFIX(16);
 			PxRaycastHit& StabbedFace = reinterpret_cast<PxRaycastHit&>(buffer);
@@ -577,12 +626,13 @@ public:
 		do
 		{
 			PxU32 VRef0, VRef1, VRef2;
-			getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+			TriangleVertices TV;
+			getTriangleVertices(TV, VRef0, VRef1, VRef2, primIndex, params);
 
 			PxRaycastHit& StabbedFace = params->mHits[params->mNbHits];
-			if(RayTriOverlapT<RayParams>(StabbedFace, params->mVerts[VRef0], params->mVerts[VRef1], params->mVerts[VRef2], params))
+			if(RayTriOverlapT<RayParams>(StabbedFace, *TV.mP[0], *TV.mP[1], *TV.mP[2], params))
 			{
-				updateParamsAfterImpact(params, primIndex, VRef0, VRef1, VRef2, StabbedFace);
+				updateParamsAfterImpact(params, primIndex, TV, StabbedFace);
 
 				computeImpactData(&StabbedFace, params, params->mWorld_Aligned, params->mHitFlags);
 
@@ -0,0 +1,279 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "GuBV4.h"
+#include "PsFoundation.h"
+using namespace physx;
+using namespace Gu;
+
+#include "PsVecMath.h"
+using namespace physx::shdfnd::aos;
+
+#include "GuBV4_Common.h"
+
+#ifdef GU_BV4_USE_SLABS
+
+namespace
+{
+	struct RefitParams
+	{
+		const SourceMesh*	mMesh;
+		PxU32				mFirstVertex;
+		PxU32				mNbVertices;
+		float				mEpsilon;
+#ifdef GU_BV4_QUANTIZED_TREE
+		PxVec3				mMinQuantCoeff;
+		PxVec3				mMaxQuantCoeff;
+		PxVec3				mMinDequantCoeff;
+		PxVec3				mMaxDequantCoeff;
+		bool				mOverflow;
+#endif
+		bool				mFullRefit;
+	};
+}
+
+static PX_FORCE_INLINE bool isDirtyVertex(PxU32 vref, const RefitParams& params)
+{
+	// Unsigned trick, also catches vref<mFirstVertex
+	return (vref - params.mFirstVertex) < params.mNbVertices;
+}
+
+// Tests whether a leaf references any of the dirty vertices, and computes its new bounds if it does.
+static bool refitLeaf(PxBounds3& bounds, PxU32 primIndex, const RefitParams& params)
+{
+	const SourceMesh* mesh = params.mMesh;
+	const IndTri32* tris32 = mesh->getTris32();
+	const IndTri16* tris16 = mesh->getTris16();
+
+	const PxU32 nbTris = primIndex & 15;
+	const PxU32 firstTri = primIndex>>4;
+
+	if(!params.mFullRefit)
+	{
+		bool dirty = false;
+		for(PxU32 i=0;i<nbTris && !dirty;i++)
+		{
+			PxU32 vref0, vref1, vref2;
+			getVertexReferences(vref0, vref1, vref2, firstTri+i, tris32, tris16);
+			dirty = isDirtyVertex(vref0, params) || isDirtyVertex(vref1, params) || isDirtyVertex(vref2, params);
+		}
+		if(!dirty)
+			return false;
+	}
+
+	const PxVec3* verts = mesh->getVerts();
+	bounds.setEmpty();
+	for(PxU32 i=0;i<nbTris;i++)
+	{
+		PxU32 vref0, vref1, vref2;
+		getVertexReferences(vref0, vref1, vref2, firstTri+i, tris32, tris16);
+		bounds.include(verts[vref0]);
+		bounds.include(verts[vref1]);
+		bounds.include(verts[vref2]);
+	}
+	bounds.fattenFast(params.mEpsilon);
+	return true;
+}
+
+#ifdef GU_BV4_QUANTIZED_TREE
+// The quantized boxes must always enclose the real boxes, so we round the min down and the max up. Values
+// that cannot be represented with the current coefficients are clamped and flagged, the tree is then requantized.
+static PX_FORCE_INLINE PxI16 quantizeMin(float value, float quantCoeff, float dequantCoeff, bool& overflow)
+{
+	PxI32 q = PxI32(PxClamp(PxFloor(value * quantCoeff), -32767.0f, 32767.0f));
+	while(q>-32767 && float(q)*dequantCoeff>value)
+		q--;
+	if(float(q)*dequantCoeff>value)
+		overflow = true;
+	return PxI16(q);
+}
+
+static PX_FORCE_INLINE PxI16 quantizeMax(float value, float quantCoeff, float dequantCoeff, bool& overflow)
+{
+	PxI32 q = PxI32(PxClamp(PxCeil(value * quantCoeff), -32767.0f, 32767.0f));
+	while(q<32767 && float(q)*dequantCoeff<value)
+		q++;
+	if(float(q)*dequantCoeff<value)
+		overflow = true;
+	return PxI16(q);
+}
+#endif
+
+static PX_FORCE_INLINE void writeBox(BVDataSwizzled* node, PxU32 i, const PxBounds3& bounds, RefitParams& params)
+{
+#ifdef GU_BV4_QUANTIZED_TREE
+	node->mX[i].mMin = quantizeMin(bounds.minimum.x, params.mMinQuantCoeff.x, params.mMinDequantCoeff.x, params.mOverflow);
+	node->mY[i].mMin = quantizeMin(bounds.minimum.y, params.mMinQuantCoeff.y, params.mMinDequantCoeff.y, params.mOverflow);
+	node->mZ[i].mMin = quantizeMin(bounds.minimum.z, params.mMinQuantCoeff.z, params.mMinDequantCoeff.z, params.mOverflow);
+	node->mX[i].mMax = quantizeMax(bounds.maximum.x, params.mMaxQuantCoeff.x, params.mMaxDequantCoeff.x, params.mOverflow);
+	node->mY[i].mMax = quantizeMax(bounds.maximum.y, params.mMaxQuantCoeff.y, params.mMaxDequantCoeff.y, params.mOverflow);
+	node->mZ[i].mMax = quantizeMax(bounds.maximum.z, params.mMaxQuantCoeff.z, params.mMaxDequantCoeff.z, params.mOverflow);
+#else
+	PX_UNUSED(params);
+	node->mMinX[i] = bounds.minimum.x;
+	node->mMinY[i] = bounds.minimum.y;
+	node->mMinZ[i] = bounds.minimum.z;
+	node->mMaxX[i] = bounds.maximum.x;
+	node->mMaxY[i] = bounds.maximum.y;
+	node->mMaxZ[i] = bounds.maximum.z;
+#endif
+}
+
+static PX_FORCE_INLINE void readBox(PxBounds3& bounds, const BVDataSwizzled* node, PxU32 i, const RefitParams& params)
+{
+#ifdef GU_BV4_QUANTIZED_TREE
+	bounds.minimum = PxVec3(float(node->mX[i].mMin) * params.mMinDequantCoeff.x,
+							float(node->mY[i].mMin) * params.mMinDequantCoeff.y,
+							float(node->mZ[i].mMin) * params.mMinDequantCoeff.z);
+	bounds.maximum = PxVec3(float(node->mX[i].mMax) * params.mMaxDequantCoeff.x,
+							float(node->mY[i].mMax) * params.mMaxDequantCoeff.y,
+							float(node->mZ[i].mMax) * params.mMaxDequantCoeff.z);
+#else
+	PX_UNUSED(params);
+	bounds.minimum = PxVec3(node->mMinX[i], node->mMinY[i], node->mMinZ[i]);
+	bounds.maximum = PxVec3(node->mMaxX[i], node->mMaxY[i], node->mMaxZ[i]);
+#endif
+}
+
+// Refits the node encoded in childData. Only the slots whose subtree references a dirty vertex are rewritten,
+// the others are dequantized to compute the node's bounds. Returns true if any slot has been rewritten.
+static bool refitNode(PxBounds3& nodeBounds, BVDataPacked* root, PxU32 childData, RefitParams& params)
+{
+	BVDataSwizzled* node = reinterpret_cast<BVDataSwizzled*>(root + (childData>>GU_BV4_CHILD_OFFSET_SHIFT_COUNT));
+	const PxU32 nbChildren = ((childData>>1)&3) + 2;
+
+	bool modified = false;
+	nodeBounds.setEmpty();
+	for(PxU32 i=0;i<nbChildren;i++)
+	{
+		const PxU32 data = node->mData[i];
+		if(data==PX_INVALID_U32)
+			continue;
+
+		PxBounds3 childBounds;
+		const bool childModified = node->isLeaf(i) ? refitLeaf(childBounds, node->getPrimitive(i), params)
+													: refitNode(childBounds, root, data, params);
+		if(childModified)
+		{
+			writeBox(node, i, childBounds, params);
+			modified = true;
+		}
+		else
+			readBox(childBounds, node, i, params);
+
+		nodeBounds.include(childBounds);
+	}
+	return modified;
+}
+
+#ifdef GU_BV4_QUANTIZED_TREE
+static void computeQuantizationCoeffs(BV4Tree& tree, RefitParams& params, const PxBounds3& bounds)
+{
+	// Same 15-bit quantization as the build code, with a single coefficient covering both the min and max values
+	const float coeff = float((1<<15)-1);
+	for(PxU32 j=0;j<3;j++)
+	{
+		// Small margin so that the clamped values remain representable despite rounding
+		const float maxValue = PxMax(PxAbs(bounds.minimum[j]), PxAbs(bounds.maximum[j])) * 1.001f;
+		params.mMinQuantCoeff[j] = params.mMaxQuantCoeff[j] = maxValue!=0.0f ? coeff/maxValue : 0.0f;
+		tree.mCenterOrMinCoeff[j] = tree.mExtentsOrMaxCoeff[j] = maxValue/coeff;
+	}
+	params.mMinDequantCoeff = tree.mCenterOrMinCoeff;
+	params.mMaxDequantCoeff = tree.mExtentsOrMaxCoeff;
+}
+
+static PX_FORCE_INLINE float invCoeff(float coeff)
+{
+	return coeff!=0.0f ? 1.0f/coeff : 0.0f;
+}
+#endif
+
+#endif // GU_BV4_USE_SLABS
+
+bool BV4Tree::refit(PxBounds3& bounds, float epsilon, PxU32 firstVertex, PxU32 nbVertices)
+{
+	if(!mMeshInterface)
+		return false;
+
+	const PxU32 nbVerts = mMeshInterface->getNbVertices();
+	if(firstVertex>=nbVerts)
+		return false;
+	nbVertices = PxMin(nbVertices, nbVerts - firstVertex);
+
+	if(!mNodes)
+	{
+		// No tree for small meshes, the queries use brute-force tests
+		const PxVec3* verts = mMeshInterface->getVerts();
+		bounds.setEmpty();
+		for(PxU32 i=0;i<nbVerts;i++)
+			bounds.include(verts[i]);
+		mLocalBounds.init(bounds);
+		return true;
+	}
+
+#ifdef GU_BV4_USE_SLABS
+	RefitParams params;
+	params.mMesh		= mMeshInterface;
+	params.mFirstVertex	= firstVertex;
+	params.mNbVertices	= nbVertices;
+	params.mEpsilon		= epsilon;
+	params.mFullRefit	= firstVertex==0 && nbVertices==nbVerts;
+	#ifdef GU_BV4_QUANTIZED_TREE
+	params.mMinDequantCoeff	= mCenterOrMinCoeff;
+	params.mMaxDequantCoeff	= mExtentsOrMaxCoeff;
+	params.mMinQuantCoeff	= PxVec3(invCoeff(mCenterOrMinCoeff.x), invCoeff(mCenterOrMinCoeff.y), invCoeff(mCenterOrMinCoeff.z));
+	params.mMaxQuantCoeff	= PxVec3(invCoeff(mExtentsOrMaxCoeff.x), invCoeff(mExtentsOrMaxCoeff.y), invCoeff(mExtentsOrMaxCoeff.z));
+	params.mOverflow		= false;
+	#endif
+
+	// The root node is not stored, its children are at offset 0
+	const PxU32 rootData = mInitData;
+	refitNode(bounds, mNodes, rootData, params);
+
+	#ifdef GU_BV4_QUANTIZED_TREE
+	if(params.mOverflow)
+	{
+		// The vertices moved out of the range covered by the quantization coefficients. We compute new
+		// coefficients from the new bounds and requantize the whole tree, which is then a full refit.
+		computeQuantizationCoeffs(*this, params, bounds);
+		params.mFullRefit	= true;
+		params.mOverflow	= false;
+		refitNode(bounds, mNodes, rootData, params);
+		PX_ASSERT(!params.mOverflow);
+	}
+	#endif
+
+	mLocalBounds.init(bounds);
+	return true;
+#else
+	PX_UNUSED(epsilon);
+	Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "BV4Tree::refit: only supported with GU_BV4_USE_SLABS.");
+	return false;
+#endif
+}
@@ -0,0 +1,305 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_BV4_SLABS_KAJIYA_PACKET_H
+#define GU_BV4_SLABS_KAJIYA_PACKET_H
+
+#include "GuBVConstants.h"
+#include "PsBitUtils.h"
+
+	// PT: per-ray data for the packet version of the slabs test. This is what SLABS_INIT computes for a single ray.
+	struct BV4RaySlabs
+	{
+		Vec4V	mInvDX, mInvDY, mInvDZ;
+		Vec4V	mPInvDX, mPInvDY, mPInvDZ;
+	};
+
+	template<class ParamsT>
+	static PX_FORCE_INLINE void setupRaySlabs(BV4RaySlabs& slabs, Vec4V& invD, const ParamsT* PX_RESTRICT params)
+	{
+		SLABS_INIT
+		PX_UNUSED(maxT4);
+
+		slabs.mInvDX = rayInvDsplatX;
+		slabs.mInvDY = rayInvDsplatY;
+		slabs.mInvDZ = rayInvDsplatZ;
+		slabs.mPInvDX = rayPinvDsplatX;
+		slabs.mPInvDY = rayPinvDsplatY;
+		slabs.mPInvDZ = rayPinvDsplatZ;
+		invD = rayInvD;
+	}
+
+	// PT: interval version of the slab test, computing for the 4 children of a node bounds of the entry and exit distances
+	// of all the rays in the packet. A child that no ray can enter is culled for the whole packet at once.
+	static PX_FORCE_INLINE void slabsIntervalAxis(Vec4V& nearLo, Vec4V& farHi, const Vec4V min4, const Vec4V max4, const Vec4V pLo, const Vec4V pHi, const Vec4V invDLo, const Vec4V invDHi)
+	{
+		// (x - p) * invD, with p in [pLo, pHi] and invD in [invDLo, invDHi]
+		const Vec4V dMin0 = V4Sub(min4, pHi);
+		const Vec4V dMin1 = V4Sub(min4, pLo);
+		const Vec4V dMax0 = V4Sub(max4, pHi);
+		const Vec4V dMax1 = V4Sub(max4, pLo);
+
+		const Vec4V tMin00 = V4Mul(dMin0, invDLo);
+		const Vec4V tMin01 = V4Mul(dMin0, invDHi);
+		const Vec4V tMin10 = V4Mul(dMin1, invDLo);
+		const Vec4V tMin11 = V4Mul(dMin1, invDHi);
+		const Vec4V tMax00 = V4Mul(dMax0, invDLo);
+		const Vec4V tMax01 = V4Mul(dMax0, invDHi);
+		const Vec4V tMax10 = V4Mul(dMax1, invDLo);
+		const Vec4V tMax11 = V4Mul(dMax1, invDHi);
+
+		const Vec4V tMinLo = V4Min(V4Min(tMin00, tMin01), V4Min(tMin10, tMin11));
+		const Vec4V tMinHi = V4Max(V4Max(tMin00, tMin01), V4Max(tMin10, tMin11));
+		const Vec4V tMaxLo = V4Min(V4Min(tMax00, tMax01), V4Min(tMax10, tMax11));
+		const Vec4V tMaxHi = V4Max(V4Max(tMax00, tMax01), V4Max(tMax10, tMax11));
+
+		nearLo = V4Max(nearLo, V4Min(tMinLo, tMaxLo));
+		farHi = V4Min(farHi, V4Max(tMinHi, tMaxHi));
+	}
+
+	// Kajiya, packet of rays, PNS order of the packet's first ray
+	template<class LeafTestT, class ParamsT>
+	static void BV4_ProcessStreamKajiyaPacket(const BVDataPacked* PX_RESTRICT node, PxU32 initData, ParamsT* PX_RESTRICT params, PxU32 nbRays)
+	{
+		PX_ASSERT(nbRays && nbRays<=GU_BV4_RAY_PACKET_SIZE);
+
+		const BVDataPacked* root = node;
+
+		PxU32 nb=1;
+		PxU32 stack[GU_BV4_STACK_SIZE];
+		PxU32 stackRays[GU_BV4_STACK_SIZE];
+		stack[0] = initData;
+		stackRays[0] = (1u<<nbRays)-1;
+
+		PxU32 activeRays = stackRays[0];
+
+		const PxU32* tmp = reinterpret_cast<const PxU32*>(&params[0].mLocalDir_Padded);
+		const PxU32 X = tmp[0]>>31;
+		const PxU32 Y = tmp[1]>>31;
+		const PxU32 Z = tmp[2]>>31;
+		const PxU32 bitIndex = 3+(Z|(Y<<1)|(X<<2));
+		const PxU32 dirMask = 1u<<bitIndex;
+
+		BV4RaySlabs slabs[GU_BV4_RAY_PACKET_SIZE];
+		Vec4V pLo = V4LoadU_Safe(&params[0].mOrigin_Padded.x);
+		Vec4V pHi = pLo;
+		Vec4V invDLo, invDHi;
+		setupRaySlabs(slabs[0], invDLo, params);
+		invDHi = invDLo;
+		float packetMaxT = params[0].mStabbedFace.mDistance;
+		for(PxU32 i=1;i<nbRays;i++)
+		{
+			Vec4V rayInvD;
+			setupRaySlabs(slabs[i], rayInvD, params + i);
+			invDLo = V4Min(invDLo, rayInvD);
+			invDHi = V4Max(invDHi, rayInvD);
+			const Vec4V rayP = V4LoadU_Safe(&params[i].mOrigin_Padded.x);
+			pLo = V4Min(pLo, rayP);
+			pHi = V4Max(pHi, rayP);
+			packetMaxT = PxMax(packetMaxT, params[i].mStabbedFace.mDistance);
+		}
+		Vec4V packetMaxT4 = V4Load(packetMaxT);
+
+		const Vec4V pLoX = V4SplatElement<0>(pLo);	const Vec4V pHiX = V4SplatElement<0>(pHi);
+		const Vec4V pLoY = V4SplatElement<1>(pLo);	const Vec4V pHiY = V4SplatElement<1>(pHi);
+		const Vec4V pLoZ = V4SplatElement<2>(pLo);	const Vec4V pHiZ = V4SplatElement<2>(pHi);
+		const Vec4V invDLoX = V4SplatElement<0>(invDLo);	const Vec4V invDHiX = V4SplatElement<0>(invDHi);
+		const Vec4V invDLoY = V4SplatElement<1>(invDLo);	const Vec4V invDHiY = V4SplatElement<1>(invDHi);
+		const Vec4V invDLoZ = V4SplatElement<2>(invDLo);	const Vec4V invDHiZ = V4SplatElement<2>(invDHi);
+
+		// PT: the interval bounds are computed differently from the per-ray distances, so they are relaxed a bit to make sure
+		// no child is culled that the exact per-ray test would keep.
+		const Vec4V slackCoeff = V4Load(1e-5f);
+
+#ifdef GU_BV4_QUANTIZED_TREE
+		const Vec4V minCoeffV = V4LoadA_Safe(&params->mCenterOrMinCoeff_PaddedAligned.x);
+		const Vec4V maxCoeffV = V4LoadA_Safe(&params->mExtentsOrMaxCoeff_PaddedAligned.x);
+		const Vec4V minCoeffxV = V4SplatElement<0>(minCoeffV);
+		const Vec4V minCoeffyV = V4SplatElement<1>(minCoeffV);
+		const Vec4V minCoeffzV = V4SplatElement<2>(minCoeffV);
+		const Vec4V maxCoeffxV = V4SplatElement<0>(maxCoeffV);
+		const Vec4V maxCoeffyV = V4SplatElement<1>(maxCoeffV);
+		const Vec4V maxCoeffzV = V4SplatElement<2>(maxCoeffV);
+#endif
+
+		do
+		{
+			--nb;
+			const PxU32 childData = stack[nb];
+			const PxU32 rays = stackRays[nb] & activeRays;
+			if(!rays)
+				continue;
+
+			node = root + getChildOffset(childData);
+
+			const BVDataSwizzled* tn = reinterpret_cast<const BVDataSwizzled*>(node);
+
+#ifdef GU_BV4_QUANTIZED_TREE
+			Vec4V minx4a;
+			Vec4V maxx4a;
+			OPC_DEQ4(maxx4a, minx4a, mX, minCoeffxV, maxCoeffxV)
+
+			Vec4V miny4a;
+			Vec4V maxy4a;
+			OPC_DEQ4(maxy4a, miny4a, mY, minCoeffyV, maxCoeffyV)
+
+			Vec4V minz4a;
+			Vec4V maxz4a;
+			OPC_DEQ4(maxz4a, minz4a, mZ, minCoeffzV, maxCoeffzV)
+#else
+			Vec4V minx4a = V4LoadA(tn->mMinX);
+			Vec4V miny4a = V4LoadA(tn->mMinY);
+			Vec4V minz4a = V4LoadA(tn->mMinZ);
+
+			Vec4V maxx4a = V4LoadA(tn->mMaxX);
+			Vec4V maxy4a = V4LoadA(tn->mMaxY);
+			Vec4V maxz4a = V4LoadA(tn->mMaxZ);
+#endif
+			// PT: packet-level culling of the 4 children
+			PxU32 packetCode;
+			{
+				Vec4V nearLo = V4Load(-PX_MAX_F32);
+				Vec4V farHi = V4Load(PX_MAX_F32);
+				slabsIntervalAxis(nearLo, farHi, minx4a, maxx4a, pLoX, pHiX, invDLoX, invDHiX);
+				slabsIntervalAxis(nearLo, farHi, miny4a, maxy4a, pLoY, pHiY, invDLoY, invDHiY);
+				slabsIntervalAxis(nearLo, farHi, minz4a, maxz4a, pLoZ, pHiZ, invDLoZ, invDHiZ);
+
+				const Vec4V slack = V4Add(V4Mul(V4Add(V4Abs(nearLo), V4Abs(farHi)), slackCoeff), epsInflateFloat4);
+				const Vec4V nearLoRelaxed = V4Sub(nearLo, slack);
+				const Vec4V farHiRelaxed = V4Add(farHi, slack);
+
+				__m128 culled = _mm_cmpgt_ps(nearLoRelaxed, farHiRelaxed);
+				culled = _mm_or_ps(culled, _mm_cmpgt_ps(epsFloat4, farHiRelaxed));
+				culled = _mm_or_ps(culled, _mm_cmpgt_ps(nearLoRelaxed, packetMaxT4));
+				packetCode = PxU32(_mm_movemask_ps(culled));
+				if(packetCode==15)
+					continue;
+			}
+
+			// PT: exact per-ray tests of the remaining children, recording which rays enter each child
+			PxU32 childRays[4] = { 0, 0, 0, 0 };
+			PxU32 remaining = rays;
+			while(remaining)
+			{
+				const PxU32 r = Ps::lowestSetBit(remaining);
+				remaining &= remaining - 1;
+
+				const BV4RaySlabs& ray = slabs[r];
+				const Vec4V maxT4 = V4Load(params[r].mStabbedFace.mDistance);
+
+				const Vec4V tminxa0 = V4MulAdd(minx4a, ray.mInvDX, ray.mPInvDX);
+				const Vec4V tminya0 = V4MulAdd(miny4a, ray.mInvDY, ray.mPInvDY);
+				const Vec4V tminza0 = V4MulAdd(minz4a, ray.mInvDZ, ray.mPInvDZ);
+				const Vec4V tmaxxa0 = V4MulAdd(maxx4a, ray.mInvDX, ray.mPInvDX);
+				const Vec4V tmaxya0 = V4MulAdd(maxy4a, ray.mInvDY, ray.mPInvDY);
+				const Vec4V tmaxza0 = V4MulAdd(maxz4a, ray.mInvDZ, ray.mPInvDZ);
+				const Vec4V maxOfNeasa = V4Max(V4Max(V4Min(tminxa0, tmaxxa0), V4Min(tminya0, tmaxya0)), V4Min(tminza0, tmaxza0));
+				const Vec4V minOfFarsa = V4Min(V4Min(V4Max(tminxa0, tmaxxa0), V4Max(tminya0, tmaxya0)), V4Max(tminza0, tmaxza0));
+
+				__m128 resa4 = _mm_cmpgt_ps(maxOfNeasa, minOfFarsa);
+				resa4 = _mm_or_ps(resa4, _mm_cmpgt_ps(epsFloat4, minOfFarsa));
+				resa4 = _mm_or_ps(resa4, _mm_cmpgt_ps(maxOfNeasa, maxT4));
+				const PxU32 code = PxU32(_mm_movemask_ps(resa4)) | packetCode;
+
+				const PxU32 rayBit = 1u<<r;
+				if(!(code&1))	childRays[0] |= rayBit;
+				if(!(code&2))	childRays[1] |= rayBit;
+				if(!(code&4))	childRays[2] |= rayBit;
+				if(!(code&8))	childRays[3] |= rayBit;
+			}
+
+			const PxU32 nodeType = getChildType(childData);
+			if(nodeType<2)
+				childRays[3] = 0;
+			if(nodeType<1)
+				childRays[2] = 0;
+
+			// PT: leaves are tested right away for all the rays that reach them
+			bool newHits = false;
+			for(PxU32 c=0;c<4;c++)
+			{
+				if(childRays[c] && tn->isLeaf(c))
+				{
+					PxU32 leafRays = childRays[c] & activeRays;
+					while(leafRays)
+					{
+						const PxU32 r = Ps::lowestSetBit(leafRays);
+						leafRays &= leafRays - 1;
+						if(LeafTestT::doLeafTest(params + r, tn->getPrimitive(c)))
+							activeRays &= ~(1u<<r);
+					}
+					childRays[c] = 0;
+					newHits = true;
+				}
+			}
+
+			if(newHits)
+			{
+				float maxT = 0.0f;
+				PxU32 active = activeRays;
+				while(active)
+				{
+					const PxU32 r = Ps::lowestSetBit(active);
+					active &= active - 1;
+					maxT = PxMax(maxT, params[r].mStabbedFace.mDistance);
+				}
+				packetMaxT4 = V4Load(maxT);
+			}
+
+			// PT: internal nodes are pushed in PNS order, so that the nearest child is processed first
+			const PxU32 b0 = (tn->decodePNSNoShift(0) & dirMask) ? 1u : 0;
+			const PxU32 b1 = (tn->decodePNSNoShift(1) & dirMask) ? 1u : 0;
+			const PxU32 b2 = (tn->decodePNSNoShift(2) & dirMask) ? 1u : 0;
+			static const PxU8 pushOrder[8][4] = {
+				{ 0,1,2,3 },	// !b0 !b1 !b2
+				{ 0,1,3,2 },	// !b0 !b1  b2
+				{ 1,0,2,3 },	// !b0  b1 !b2
+				{ 1,0,3,2 },	// !b0  b1  b2
+				{ 2,3,0,1 },	//  b0 !b1 !b2
+				{ 3,2,0,1 },	//  b0 !b1  b2
+				{ 2,3,1,0 },	//  b0  b1 !b2
+				{ 3,2,1,0 },	//  b0  b1  b2
+			};
+			const PxU8* PX_RESTRICT order = pushOrder[(b0<<2)|(b1<<1)|b2];
+			for(PxU32 j=0;j<4;j++)
+			{
+				const PxU32 c = order[j];
+				if(childRays[c])
+				{
+					PX_ASSERT(nb<GU_BV4_STACK_SIZE);
+					stack[nb] = tn->getChildData(c);
+					stackRays[nb] = childRays[c];
+					nb++;
+				}
+			}
+
+		}while(nb && activeRays);
+	}
+
+#endif // GU_BV4_SLABS_KAJIYA_PACKET_H
@@ -54,6 +54,7 @@ struct SphereParams
 	const IndTri32*	PX_RESTRICT	mTris32;
 	const IndTri16*	PX_RESTRICT	mTris16;
 	const PxVec3*	PX_RESTRICT	mVerts;
+	const CompressedMesh*	PX_RESTRICT	mCompressed;
 
 #ifdef GU_BV4_QUANTIZED_TREE
 	BV4_ALIGN16(Vec3p	mCenterOrMinCoeff_PaddedAligned);
@@ -105,9 +106,10 @@ static PX_FORCE_INLINE Ps::IntBool __SphereTriangle(const SphereParams* PX_RESTR
 static /*PX_FORCE_INLINE*/ Ps::IntBool /*__fastcall*/ __SphereTriangle(const SphereParams* PX_RESTRICT params, PxU32 primIndex)
 {
 	PxU32 VRef0, VRef1, VRef2;
-	getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+	TriangleVertices TV;
+	getTriangleVertices(TV, VRef0, VRef1, VRef2, primIndex, params);
 
-	return __SphereTriangle(params, params->mVerts[VRef0], params->mVerts[VRef1], params->mVerts[VRef2]);
+	return __SphereTriangle(params, *TV.mP[0], *TV.mP[1], *TV.mP[2]);
 }
 
 namespace
@@ -285,11 +287,12 @@ public:
 		do
 		{
 			PxU32 VRef0, VRef1, VRef2;
-			getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+			TriangleVertices TV;
+			getTriangleVertices(TV, VRef0, VRef1, VRef2, primIndex, params);
 
-			const PxVec3& p0 = params->mVerts[VRef0];
-			const PxVec3& p1 = params->mVerts[VRef1];
-			const PxVec3& p2 = params->mVerts[VRef2];
+			const PxVec3& p0 = *TV.mP[0];
+			const PxVec3& p1 = *TV.mP[1];
+			const PxVec3& p2 = *TV.mP[2];
 
 			if(__SphereTriangle(params, p0, p1, p2))
 			{
@@ -70,6 +70,7 @@ namespace
 		const IndTri32*		PX_RESTRICT	mTris32;
 		const IndTri16*		PX_RESTRICT	mTris16;
 		const PxVec3*		PX_RESTRICT	mVerts;
+		const CompressedMesh*	PX_RESTRICT	mCompressed;
 
 		PxVec3				mOriginalExtents_Padded;
 
@@ -91,11 +92,12 @@ namespace
 static bool /*__fastcall*/ triSphereSweep(SphereSweepParams* PX_RESTRICT params, PxU32 primIndex, bool nodeSorting=true)
 {
 	PxU32 VRef0, VRef1, VRef2;
-	getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+	TriangleVertices TV;
+	getTriangleVertices(TV, VRef0, VRef1, VRef2, primIndex, params);
 
-	const PxVec3& p0 = params->mVerts[VRef0];
-	const PxVec3& p1 = params->mVerts[VRef1];
-	const PxVec3& p2 = params->mVerts[VRef2];
+	const PxVec3& p0 = *TV.mP[0];
+	const PxVec3& p1 = *TV.mP[1];
+	const PxVec3& p2 = *TV.mP[2];
 
 	PxVec3 normal = (p1 - p0).cross(p2 - p0);
 
@@ -328,12 +330,13 @@ public:
 		do
 		{
 			PxU32 VRef0, VRef1, VRef2;
-			getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+			TriangleVertices TV;
+			getTriangleVertices(TV, VRef0, VRef1, VRef2, primIndex, params);
 
 			{
 //				const PxU32 vrefs[3] = { VRef0, VRef1, VRef2 };
 				float dist = params->mStabbedFace.mDistance;
-				if((params->mCallback)(params->mUserData, params->mVerts[VRef0], params->mVerts[VRef1], params->mVerts[VRef2], primIndex, /*vrefs,*/ dist))
+				if((params->mCallback)(params->mUserData, *TV.mP[0], *TV.mP[1], *TV.mP[2], primIndex, /*vrefs,*/ dist))
 					return;
 
 				if(dist<params->mStabbedFace.mDistance)
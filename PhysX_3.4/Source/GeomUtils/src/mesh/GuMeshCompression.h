@@ -0,0 +1,163 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#ifndef GU_MESH_COMPRESSION_H
+#define GU_MESH_COMPRESSION_H
+
+#include "foundation/PxVec3.h"
+#include "CmPhysXCommon.h"
+
+namespace physx
+{
+namespace Gu
+{
+	// Vertices are quantized to 16 bits per axis, relative to the bounds of blocks of consecutive vertices. The
+	// cooking code sorts vertices by first use in BV4 leaf order, so the triangles of a leaf only touch a few blocks.
+	#define GU_COMPRESSED_VERTEX_BLOCK_SIZE		32
+
+	// Triangle indices are stored as 16-bit offsets from a 32-bit base shared by a block of consecutive triangles.
+	#define GU_COMPRESSED_TRIANGLE_BLOCK_SIZE	16
+
+	enum CompressedMeshFlag
+	{
+		CMF_INDICES	=	(1<<0)	//!< triangle indices are delta-coded, otherwise the mesh keeps its regular index buffer
+	};
+
+	struct QuantizedVertexBlock
+	{
+		PxVec3	mMin;
+		PxVec3	mScale;		//!< (max - min) / 65535
+	};
+	PX_COMPILE_TIME_ASSERT(sizeof(QuantizedVertexBlock)==24);
+
+	// The cooking code uses this same function to replace the source vertices with their decoded values, so
+	// that the BV4 tree is built from exactly the positions the queries will see.
+	PX_FORCE_INLINE PxVec3 dequantizeVertex(const QuantizedVertexBlock& block, const PxU16* PX_RESTRICT q)
+	{
+		return PxVec3(	block.mMin.x + block.mScale.x * PxReal(q[0]),
+						block.mMin.y + block.mScale.y * PxReal(q[1]),
+						block.mMin.z + block.mScale.z * PxReal(q[2]));
+	}
+
+	// Header of a compressed mesh. The arrays follow the header in the same allocation:
+	// QuantizedVertexBlock[nbVertexBlocks] | PxU16[nbVertices*3] | PxU32[nbTriangleBlocks] | PxU16[nbTriangles*3]
+	// The last two arrays are only present with CMF_INDICES.
+	class CompressedMesh
+	{
+		public:
+				PxU32						mNbVertices;
+				PxU32						mNbTriangles;
+				PxU32						mFlags;						//!< combination of CompressedMeshFlag
+				PxU32						mSize;						//!< total size in bytes, header included
+				PxU32						mQuantizedVerticesOffset;
+				PxU32						mTriangleBasesOffset;
+				PxU32						mTriangleOffsetsOffset;
+				PxU32						mPad;
+
+		static	PX_FORCE_INLINE	PxU32		getNbVertexBlocks(PxU32 nbVertices)		{ return (nbVertices + GU_COMPRESSED_VERTEX_BLOCK_SIZE - 1) / GU_COMPRESSED_VERTEX_BLOCK_SIZE;		}
+		static	PX_FORCE_INLINE	PxU32		getNbTriangleBlocks(PxU32 nbTriangles)	{ return (nbTriangles + GU_COMPRESSED_TRIANGLE_BLOCK_SIZE - 1) / GU_COMPRESSED_TRIANGLE_BLOCK_SIZE;	}
+
+		// Fills the header fields and returns the total size of the compressed mesh
+		static	PX_INLINE	PxU32			initLayout(CompressedMesh& header, PxU32 nbVertices, PxU32 nbTriangles, PxU32 flags)
+											{
+												header.mNbVertices				= nbVertices;
+												header.mNbTriangles				= nbTriangles;
+												header.mFlags					= flags;
+												header.mPad						= 0;
+												header.mQuantizedVerticesOffset	= sizeof(CompressedMesh) + getNbVertexBlocks(nbVertices) * sizeof(QuantizedVertexBlock);
+												header.mTriangleBasesOffset		= (header.mQuantizedVerticesOffset + nbVertices * 3 * sizeof(PxU16) + 3) & ~3;
+												PxU32 size = header.mTriangleBasesOffset;
+												if(flags & CMF_INDICES)
+												{
+													header.mTriangleOffsetsOffset	= header.mTriangleBasesOffset + getNbTriangleBlocks(nbTriangles) * sizeof(PxU32);
+													size = header.mTriangleOffsetsOffset + nbTriangles * 3 * sizeof(PxU16);
+												}
+												else
+													header.mTriangleOffsetsOffset	= size;
+												header.mSize = (size + 15) & ~15;
+												return header.mSize;
+											}
+
+		// Checks a header read from an untrusted stream against the layout it should have
+				PX_INLINE	bool			isValid(PxU32 nbVertices, PxU32 nbTriangles)	const
+											{
+												CompressedMesh expected;
+												initLayout(expected, nbVertices, nbTriangles, mFlags & CMF_INDICES);
+												return	mNbVertices == nbVertices && mNbTriangles == nbTriangles && mFlags == expected.mFlags &&
+														mSize == expected.mSize && mQuantizedVerticesOffset == expected.mQuantizedVerticesOffset &&
+														mTriangleBasesOffset == expected.mTriangleBasesOffset && mTriangleOffsetsOffset == expected.mTriangleOffsetsOffset;
+											}
+
+		PX_FORCE_INLINE	bool				hasIndices()					const	{ return (mFlags & CMF_INDICES)!=0;	}
+
+		PX_FORCE_INLINE	const QuantizedVertexBlock*	getVertexBlocks()		const	{ return reinterpret_cast<const QuantizedVertexBlock*>(this + 1);										}
+		PX_FORCE_INLINE	const PxU16*		getQuantizedVertices()			const	{ return reinterpret_cast<const PxU16*>(reinterpret_cast<const PxU8*>(this) + mQuantizedVerticesOffset);	}
+		PX_FORCE_INLINE	const PxU32*		getTriangleBases()				const	{ return reinterpret_cast<const PxU32*>(reinterpret_cast<const PxU8*>(this) + mTriangleBasesOffset);		}
+		PX_FORCE_INLINE	const PxU16*		getTriangleOffsets()			const	{ return reinterpret_cast<const PxU16*>(reinterpret_cast<const PxU8*>(this) + mTriangleOffsetsOffset);	}
+
+		PX_FORCE_INLINE	QuantizedVertexBlock*	getVertexBlocks()					{ return const_cast<QuantizedVertexBlock*>(static_cast<const CompressedMesh*>(this)->getVertexBlocks());	}
+		PX_FORCE_INLINE	PxU16*				getQuantizedVertices()					{ return const_cast<PxU16*>(static_cast<const CompressedMesh*>(this)->getQuantizedVertices());			}
+		PX_FORCE_INLINE	PxU32*				getTriangleBases()						{ return const_cast<PxU32*>(static_cast<const CompressedMesh*>(this)->getTriangleBases());				}
+		PX_FORCE_INLINE	PxU16*				getTriangleOffsets()					{ return const_cast<PxU16*>(static_cast<const CompressedMesh*>(this)->getTriangleOffsets());			}
+
+		PX_FORCE_INLINE	PxVec3				getVertex(PxU32 index)			const
+											{
+												PX_ASSERT(index<mNbVertices);
+												return dequantizeVertex(getVertexBlocks()[index / GU_COMPRESSED_VERTEX_BLOCK_SIZE], getQuantizedVertices() + index*3);
+											}
+
+		// Only valid with CMF_INDICES. Without it, the vertex references come from the mesh's regular index buffer.
+		PX_FORCE_INLINE	void				getVertexReferences(PxU32 triangleIndex, PxU32& vref0, PxU32& vref1, PxU32& vref2)	const
+											{
+												PX_ASSERT(hasIndices() && triangleIndex<mNbTriangles);
+												const PxU32 base = getTriangleBases()[triangleIndex / GU_COMPRESSED_TRIANGLE_BLOCK_SIZE];
+												const PxU16* PX_RESTRICT offsets = getTriangleOffsets() + triangleIndex*3;
+												vref0 = base + offsets[0];
+												vref1 = base + offsets[1];
+												vref2 = base + offsets[2];
+											}
+
+						void				decodeVertices(PxVec3* PX_RESTRICT dst)	const
+											{
+												for(PxU32 i=0;i<mNbVertices;i++)
+													dst[i] = getVertex(i);
+											}
+
+						void				decodeTriangles(PxU32* PX_RESTRICT dst)	const
+											{
+												for(PxU32 i=0;i<mNbTriangles;i++)
+													getVertexReferences(i, dst[i*3+0], dst[i*3+1], dst[i*3+2]);
+											}
+	};
+	PX_COMPILE_TIME_ASSERT(sizeof(CompressedMesh)==32);
+
+} // namespace Gu
+
+}
+
+#endif
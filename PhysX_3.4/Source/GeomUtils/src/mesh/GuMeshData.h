@@ -40,6 +40,7 @@
 #include "GuRTree.h"
 #include "GuBV4.h"
 #include "GuBV32.h"
+#include "GuMeshCompression.h"
 
 namespace physx
 {
@@ -71,7 +72,21 @@ enum InternalMeshSerialFlag
 	IMSF_8BIT_INDICES	=	(1<<2),	//!< if set, the cooked mesh file contains 8bit indices (topology)
 	IMSF_16BIT_INDICES	=	(1<<3),	//!< if set, the cooked mesh file contains 16bit indices (topology)
 	IMSF_ADJACENCIES	=	(1<<4),	//!< if set, the cooked mesh file contains adjacency structures
-	IMSF_GRB_DATA		=	(1<<5)	//!< if set, the cooked mesh file contains GRB data structures
+	IMSF_GRB_DATA		=	(1<<5),	//!< if set, the cooked mesh file contains GRB data structures
+	IMSF_COMPRESSED		=	(1<<6)	//!< if set, the cooked mesh file contains quantized vertices and possibly delta-coded indices
+};
+
+// these flags tell which mesh arrays reference user memory (in-place loading) and must not be freed by the mesh
+enum InPlaceMeshArray
+{
+	IPMA_VERTICES		=	(1<<0),	//!< vertices reference user memory
+	IPMA_TRIANGLES		=	(1<<1),	//!< triangle indices reference user memory
+	IPMA_MATERIALS		=	(1<<2),	//!< material indices reference user memory
+	IPMA_FACE_REMAP		=	(1<<3),	//!< face remap table references user memory
+	IPMA_ADJACENCIES	=	(1<<4),	//!< adjacencies reference user memory
+	IPMA_EXTRA_TRIG_DATA	=	(1<<5),	//!< extra triangle data references user memory
+	IPMA_MIDPHASE		=	(1<<6),	//!< midphase structure (RTree pages or BV4 nodes) references user memory
+	IPMA_COMPRESSED		=	(1<<7)	//!< compressed vertices/indices reference user memory
 };
 
 
@@ -96,6 +111,7 @@ enum InternalMeshSerialFlag
 		PxReal					mGeomEpsilon;
 
 		PxU8					mFlags;
+		PxU8					mUserArrays;	//!< combination of InPlaceMeshArray flags
 		PxU16*					mMaterialIndices;
 		PxU32*					mFaceRemap;
 		PxU32*					mAdjacencies;
@@ -110,6 +126,8 @@ enum InternalMeshSerialFlag
 		void*					mGRB_BV32Tree;
 		// End of GRB data ------------------
 
+		CompressedMesh*			mCompressed;	//!< quantized vertices, and indices with CMF_INDICES. mVertices (and mTriangles) are NULL once set.
+
 		TriangleMeshData() :
 			mNbVertices			(0),
 			mNbTriangles		(0),
@@ -119,6 +137,7 @@ enum InternalMeshSerialFlag
 			mExtraTrigData		(NULL),
 			mGeomEpsilon		(0.0f),
 			mFlags				(0),
+			mUserArrays			(0),
 			mMaterialIndices	(NULL),
 			mFaceRemap			(NULL),
 			mAdjacencies		(NULL),
@@ -126,24 +145,25 @@ enum InternalMeshSerialFlag
 			mGRB_triIndices					(NULL),
 			mGRB_triAdjacencies				(NULL),
 			mGRB_faceRemap					(NULL),
-			mGRB_BV32Tree					(NULL)
-			
+			mGRB_BV32Tree					(NULL),
+
+			mCompressed			(NULL)
 		{
 		}
 
 		virtual ~TriangleMeshData()
 		{
-			if(mVertices) 
+			if(mVertices && !(mUserArrays & IPMA_VERTICES))
 				PX_FREE(mVertices);
-			if(mTriangles) 
+			if(mTriangles && !(mUserArrays & IPMA_TRIANGLES))
 				PX_FREE(mTriangles);
-			if(mMaterialIndices)
+			if(mMaterialIndices && !(mUserArrays & IPMA_MATERIALS))
 				PX_DELETE_POD(mMaterialIndices);
-			if(mFaceRemap)
+			if(mFaceRemap && !(mUserArrays & IPMA_FACE_REMAP))
 				PX_DELETE_POD(mFaceRemap);
-			if(mAdjacencies)
+			if(mAdjacencies && !(mUserArrays & IPMA_ADJACENCIES))
 				PX_DELETE_POD(mAdjacencies);
-			if(mExtraTrigData)
+			if(mExtraTrigData && !(mUserArrays & IPMA_EXTRA_TRIG_DATA))
 				PX_DELETE_POD(mExtraTrigData);
 
 
@@ -162,7 +182,8 @@ enum InternalMeshSerialFlag
 				mGRB_BV32Tree = NULL;
 			}
 
-			
+			if(mCompressed && !(mUserArrays & IPMA_COMPRESSED))
+				PX_FREE(mCompressed);
 		}
 
 
@@ -183,6 +183,33 @@ PxU32 physx::PxMeshQuery::findOverlapTriangleMesh(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+PxU32 physx::PxMeshQuery::findOverlapTriangleMesh(	const PxTriangleMeshGeometry& meshGeom0, const PxTransform& meshPose0,
+													const PxTriangleMeshGeometry& meshGeom1, const PxTransform& meshPose1,
+													PxU32* results, PxU32 maxPairs, PxU32 startIndex, bool& overflow)
+{
+	PX_SIMD_GUARD;
+
+	overflow = false;
+
+	const TriangleMesh* tm0 = static_cast<const TriangleMesh*>(meshGeom0.triangleMesh);
+	const TriangleMesh* tm1 = static_cast<const TriangleMesh*>(meshGeom1.triangleMesh);
+	if(tm0->getConcreteType()!=PxConcreteType::eTRIANGLE_MESH_BVH34 || tm1->getConcreteType()!=PxConcreteType::eTRIANGLE_MESH_BVH34)
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "findOverlapTriangleMesh: mesh-vs-mesh queries are only supported for meshes cooked with the BVH34 midphase.");
+		return 0;
+	}
+
+	// results are stored as pairs of indices
+	LimitedResults limitedResults(results, maxPairs*2, startIndex*2);
+
+	Midphase::intersectMeshVsMesh(*tm0, meshPose0, meshGeom0.scale, *tm1, meshPose1, meshGeom1.scale, &limitedResults);
+
+	overflow = limitedResults.mOverflow;
+	return limitedResults.mNbResults/2;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 PxU32 physx::PxMeshQuery::findOverlapHeightField(	const PxGeometry& geom, const PxTransform& geomPose,
 													const PxHeightFieldGeometry& hfGeom, const PxTransform& hfPose,
 													PxU32* results, PxU32 maxResults, PxU32 startIndex, bool& overflow)
@@ -238,6 +265,23 @@ PxU32 physx::PxMeshQuery::findOverlapHeightField(	const PxGeometry& geom, const
 
 ///////////////////////////////////////////////////////////////////////////////
 
+PxU32 physx::PxMeshQuery::raycast(	const PxTriangleMeshGeometry& meshGeom, const PxTransform& meshPose,
+									PxU32 nbRays, const PxVec3* rayOrigins, const PxVec3* unitDirs, PxReal maxDist,
+									PxHitFlags hitFlags, PxRaycastHit* hits)
+{
+	PX_SIMD_GUARD;
+	PX_CHECK_AND_RETURN_VAL(meshPose.isValid(), "PxMeshQuery::raycast(): pose is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(rayOrigins && unitDirs && hits, "PxMeshQuery::raycast(): NULL ray or hit buffer.", 0);
+	PX_CHECK_AND_RETURN_VAL(PxIsFinite(maxDist) && maxDist >= 0.0f, "PxMeshQuery::raycast(): maxDist is not valid.", 0);
+
+	PX_PROFILE_ZONE("MeshQuery.raycast", 0);
+
+	const TriangleMesh* tm = static_cast<const TriangleMesh*>(meshGeom.triangleMesh);
+	return Midphase::raycastTriangleMeshPacket(tm, meshGeom, meshPose, nbRays, rayOrigins, unitDirs, maxDist, hitFlags, hits);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool physx::PxMeshQuery::sweep(	const PxVec3& unitDir, const PxReal maxDistance,
 								const PxGeometry& geom, const PxTransform& pose,
 								PxU32 triangleCount, const PxTriangle* triangles,
@@ -59,6 +59,7 @@ using namespace Cm;
 
 #if PX_INTEL_FAMILY && !defined(PX_SIMD_DISABLED)
 Ps::IntBool	BV4_RaycastSingle		(const PxVec3& origin, const PxVec3& dir, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, PxRaycastHit* PX_RESTRICT hit, float maxDist, float geomEpsilon, PxU32 flags, PxHitFlags hitFlags);
+PxU32		BV4_RaycastPacket		(PxU32 nbRays, const PxVec3* PX_RESTRICT origins, const PxVec3* PX_RESTRICT dirs, const float* PX_RESTRICT maxDists, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, PxRaycastHit* PX_RESTRICT hits, float geomEpsilon, PxU32 flags, PxHitFlags hitFlags);
 PxU32		BV4_RaycastAll			(const PxVec3& origin, const PxVec3& dir, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, PxRaycastHit* PX_RESTRICT hits, PxU32 maxNbHits, float maxDist, float geomEpsilon, PxU32 flags, PxHitFlags hitFlags);
 void		BV4_RaycastCB			(const PxVec3& origin, const PxVec3& dir, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, float maxDist, float geomEpsilon, PxU32 flags, MeshRayCallback callback, void* userData);
 
@@ -74,6 +75,8 @@ Ps::IntBool	BV4_OverlapCapsuleAny	(const Capsule& capsule, const BV4Tree& tree,
 PxU32		BV4_OverlapCapsuleAll	(const Capsule& capsule, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, PxU32* results, PxU32 size, bool& overflow);
 void		BV4_OverlapCapsuleCB	(const Capsule& capsule, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, MeshOverlapCallback callback, void* userData);
 
+void		BV4_OverlapMeshCB		(const BV4Tree& tree0, const BV4Tree& tree1, const PxMat33& rot1to0, const PxVec3& trans1to0, MeshMeshOverlapCallback callback, void* userData);
+
 Ps::IntBool	BV4_SphereSweepSingle	(const Sphere& sphere, const PxVec3& dir, float maxDist, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, SweepHit* PX_RESTRICT hit, PxU32 flags);
 void		BV4_SphereSweepCB		(const Sphere& sphere, const PxVec3& dir, float maxDist, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, SweepUnlimitedCallback callback, void* userData, PxU32 flags, bool nodeSorting);
 
@@ -236,6 +239,32 @@ static PX_FORCE_INLINE void boxSweepVsMeshCBOld(const BV4Tree& tree, const float
 
 //
 
+static PX_FORCE_INLINE void setupIdtScaleRaycastHit(PxRaycastHit& hit, const PxVec3& rayDir, bool isDoubleSided, PxHitFlags hitFlags)
+{
+	PxHitFlags dstFlags = PxHitFlag::ePOSITION|PxHitFlag::eDISTANCE|PxHitFlag::eUV|PxHitFlag::eFACE_INDEX;
+
+	// PT: TODO: pass flags to BV4 code (TA34704)
+	if(hitFlags & PxHitFlag::eNORMAL)
+	{
+		dstFlags |= PxHitFlag::eNORMAL;
+		if(isDoubleSided)
+		{
+			PxVec3 normal = hit.normal;
+			// PT: figure out correct normal orientation (DE7458)
+			// - if the mesh is single-sided the normal should be the regular triangle normal N, regardless of eMESH_BOTH_SIDES.
+			// - if the mesh is double-sided the correct normal can be either N or -N. We take the one opposed to ray direction.
+			if(normal.dot(rayDir) > 0.0f)
+				normal = -normal;
+			hit.normal = normal;
+		}
+	}
+	else
+	{
+		hit.normal = PxVec3(0.0f);
+	}
+	hit.flags = dstFlags;
+}
+
 static PX_FORCE_INLINE bool raycastVsMesh(PxRaycastHit& hitData, const BV4Tree& tree, const float* meshPos, const float* meshRot, const PxVec3& orig, const PxVec3& dir, float maxDist, float geomEpsilon, bool doubleSided, PxHitFlags hitFlags)
 {
 	BV4_ALIGN16(PxMat44 World);
@@ -384,30 +413,7 @@ PxU32 physx::Gu::raycast_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTri
 	{
 		bool b = raycastVsMesh(*hits, tree, &pose.p.x, &pose.q.x, rayOrigin, rayDir, maxDist, meshData->getGeomEpsilon(), bothSides, hitFlags);
 		if(b)
-		{
-			PxHitFlags dstFlags = PxHitFlag::ePOSITION|PxHitFlag::eDISTANCE|PxHitFlag::eUV|PxHitFlag::eFACE_INDEX;
-
-			// PT: TODO: pass flags to BV4 code (TA34704)
-			if(hitFlags & PxHitFlag::eNORMAL)
-			{
-				dstFlags |= PxHitFlag::eNORMAL;
-				if(isDoubleSided)
-				{
-					PxVec3 normal = hits->normal;
-					// PT: figure out correct normal orientation (DE7458)
-					// - if the mesh is single-sided the normal should be the regular triangle normal N, regardless of eMESH_BOTH_SIDES.
-					// - if the mesh is double-sided the correct normal can be either N or -N. We take the one opposed to ray direction.
-					if(normal.dot(rayDir) > 0.0f)
-						normal = -normal;
-					hits->normal = normal;
-				}
-			}
-			else
-			{
-				hits->normal = PxVec3(0.0f);
-			}
-			hits->flags = dstFlags;
-		}
+			setupIdtScaleRaycastHit(*hits, rayDir, isDoubleSided, hitFlags);
 		return PxU32(b);
 	}
 
@@ -481,6 +487,63 @@ PxU32 physx::Gu::raycast_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTri
 	return callback.mHitNum;
 }
 
+PxU32 physx::Gu::raycastPacket_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
+													PxU32 nbRays, const PxVec3* PX_RESTRICT rayOrigins, const PxVec3* PX_RESTRICT rayDirs, PxReal maxDist,
+													PxHitFlags hitFlags, PxRaycastHit* PX_RESTRICT hits)
+{
+	PX_ASSERT(mesh->getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34);
+	const BV4TriangleMesh* meshData = static_cast<const BV4TriangleMesh*>(mesh);
+
+	const bool isDoubleSided = meshGeom.meshFlags.isSet(PxMeshGeometryFlag::eDOUBLE_SIDED);
+	const bool bothSides = isDoubleSided || (hitFlags & PxHitFlag::eMESH_BOTH_SIDES);
+
+	PxU32 nbHits = 0;
+
+	// PT: scaled meshes need a per-ray transform to vertex space, and go through the regular single-ray code
+	if(!meshGeom.scale.isIdentity())
+	{
+		for(PxU32 i=0;i<nbRays;i++)
+		{
+			if(raycast_triangleMesh_BV4(mesh, meshGeom, pose, rayOrigins[i], rayDirs[i], maxDist, hitFlags, 1, hits + i))
+				nbHits++;
+			else
+				invalidateRaycastHit(hits[i]);
+		}
+		return nbHits;
+	}
+
+	const BV4Tree& tree = meshData->getBV4Tree();
+
+	BV4_ALIGN16(PxMat44 World);
+	const PxMat44* TM = setupWorldMatrix(World, &pose.p.x, &pose.q.x);
+
+	const bool anyHit = hitFlags & PxHitFlag::eMESH_ANY;
+	const PxU32 flags = setupFlags(anyHit, bothSides, false);
+
+	float maxDists[GU_BV4_RAY_PACKET_SIZE];
+	for(PxU32 i=0;i<GU_BV4_RAY_PACKET_SIZE;i++)
+		maxDists[i] = maxDist;
+
+	for(PxU32 offset=0;offset<nbRays;offset+=GU_BV4_RAY_PACKET_SIZE)
+	{
+		const PxU32 nbInPacket = PxMin(nbRays - offset, PxU32(GU_BV4_RAY_PACKET_SIZE));
+		const PxU32 hitMask = BV4_RaycastPacket(nbInPacket, rayOrigins + offset, rayDirs + offset, maxDists, tree, TM, hits + offset, meshData->getGeomEpsilon(), flags, hitFlags);
+
+		for(PxU32 i=0;i<nbInPacket;i++)
+		{
+			PxRaycastHit& hit = hits[offset + i];
+			if(hitMask & (1u<<i))
+			{
+				setupIdtScaleRaycastHit(hit, rayDirs[offset + i], isDoubleSided, hitFlags);
+				nbHits++;
+			}
+			else
+				invalidateRaycastHit(hit);
+		}
+	}
+	return nbHits;
+}
+
 namespace
 {
 struct IntersectShapeVsMeshCallback
@@ -723,6 +786,48 @@ bool physx::Gu::intersectCapsuleVsMesh_BV4(const Capsule& capsule, const Triangl
 	}
 }
 
+namespace
+{
+struct IntersectMeshVsMeshCallback
+{
+	IntersectMeshVsMeshCallback(LimitedResults* results) : mResults(results), mAnyHits(false)	{}
+
+	LimitedResults*	mResults;
+	bool			mAnyHits;
+};
+}
+
+// returns true to abort the traversal
+static bool gMeshVsMeshCallback(void* userData, PxU32 triangleIndex0, PxU32 triangleIndex1)
+{
+	IntersectMeshVsMeshCallback* callback = reinterpret_cast<IntersectMeshVsMeshCallback*>(userData);
+	callback->mAnyHits = true;
+	if(!callback->mResults)
+		return true;	// only interested in a boolean answer
+	return !callback->mResults->addPair(triangleIndex0, triangleIndex1);
+}
+
+bool physx::Gu::intersectMeshVsMesh_BV4(	const TriangleMesh& triMesh0, const PxTransform& meshTransform0, const PxMeshScale& meshScale0,
+											const TriangleMesh& triMesh1, const PxTransform& meshTransform1, const PxMeshScale& meshScale1,
+											LimitedResults* results)
+{
+	PX_ASSERT(triMesh0.getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34);
+	PX_ASSERT(triMesh1.getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34);
+	const BV4Tree& tree0 = static_cast<const BV4TriangleMesh&>(triMesh0).getBV4Tree();
+	const BV4Tree& tree1 = static_cast<const BV4TriangleMesh&>(triMesh1).getBV4Tree();
+
+	// Vertex space of mesh 1 to vertex space of mesh 0: v0 = S0^-1 * R0^T * (R1 * S1 * v1 + p1 - p0)
+	const PxMat33 invRot0(meshTransform0.q.getConjugate());
+	const PxMat33 invScale0 = meshScale0.getInverse().toMat33();
+	const PxMat33 world0 = invScale0 * invRot0;
+	const PxMat33 rot1to0 = world0 * PxMat33(meshTransform1.q) * meshScale1.toMat33();
+	const PxVec3 trans1to0 = world0 * (meshTransform1.p - meshTransform0.p);
+
+	IntersectMeshVsMeshCallback callback(results);
+	BV4_OverlapMeshCB(tree0, tree1, rot1to0, trans1to0, gMeshVsMeshCallback, &callback);
+	return callback.mAnyHits;
+}
+
 // PT: TODO: get rid of this (TA34704)
 static bool gVolumeCallback(void* userData, const PxVec3& p0, const PxVec3& p1, const PxVec3& p2, PxU32 triangleIndex, const PxU32* vertexIndices)
 {
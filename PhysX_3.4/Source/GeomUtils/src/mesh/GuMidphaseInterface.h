@@ -111,6 +111,26 @@ namespace Gu
 
 			return true;
 		}
+
+		// for pair queries: the two indices are always added together, capacity and start index count indices, not pairs
+		PX_FORCE_INLINE	bool addPair(PxU32 index0, PxU32 index1)
+		{
+			if(mNbResults+2>mMaxResults)
+			{
+				mOverflow = true;
+				return false;
+			}
+
+			if(mNbSkipped>=mStartIndex)
+			{
+				mResults[mNbResults++] = index0;
+				mResults[mNbResults++] = index1;
+			}
+			else
+				mNbSkipped+=2;
+
+			return true;
+		}
 	};
 
 	// Exposing wrapper for Midphase::intersectOBB just for particles in order to avoid DelayLoad performance problem. This should be removed with particles in PhysX 3.5 (US16993)
@@ -137,6 +157,9 @@ namespace Gu
 	PX_PHYSX_COMMON_API PxU32 raycast_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
 									const PxVec3& rayOrigin, const PxVec3& rayDir, PxReal maxDist,
 									PxHitFlags hitFlags, PxU32 maxHits, PxRaycastHit* PX_RESTRICT hits);
+	PX_PHYSX_COMMON_API PxU32 raycastPacket_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
+									PxU32 nbRays, const PxVec3* PX_RESTRICT rayOrigins, const PxVec3* PX_RESTRICT rayDirs, PxReal maxDist,
+									PxHitFlags hitFlags, PxRaycastHit* PX_RESTRICT hits);
 	PX_PHYSX_COMMON_API bool intersectSphereVsMesh_BV4	(const Sphere& sphere,		const TriangleMesh& triMesh, const PxTransform& meshTransform, const PxMeshScale& meshScale, LimitedResults* results);
 	PX_PHYSX_COMMON_API bool intersectBoxVsMesh_BV4		(const Box& box,			const TriangleMesh& triMesh, const PxTransform& meshTransform, const PxMeshScale& meshScale, LimitedResults* results);
 	PX_PHYSX_COMMON_API bool intersectCapsuleVsMesh_BV4	(const Capsule& capsule,	const TriangleMesh& triMesh, const PxTransform& meshTransform, const PxMeshScale& meshScale, LimitedResults* results);
@@ -148,8 +171,19 @@ namespace Gu
 								const Gu::Box& box, const PxVec3& unitDir, const PxReal distance,
 								PxSweepHit& sweepHit, PxHitFlags hitFlags, const PxReal inflation);
 	PX_PHYSX_COMMON_API void sweepConvex_MeshGeom_BV4(const TriangleMesh* mesh, const Gu::Box& hullBox, const PxVec3& localDir, const PxReal distance, SweepConvexMeshHitCallback& callback, bool anyHit);
+	PX_PHYSX_COMMON_API bool intersectMeshVsMesh_BV4(	const TriangleMesh& triMesh0, const PxTransform& meshTransform0, const PxMeshScale& meshScale0,
+														const TriangleMesh& triMesh1, const PxTransform& meshTransform1, const PxMeshScale& meshScale1,
+														LimitedResults* results);
 #endif
 
+	// PT: marks the hit of a ray that missed, in the packet versions where each ray has its own hit
+	PX_FORCE_INLINE void invalidateRaycastHit(PxRaycastHit& hit)
+	{
+		hit.faceIndex	= 0xffffffff;
+		hit.flags		= PxHitFlags(0);
+		hit.distance	= PX_MAX_REAL;
+	}
+
 	typedef PxU32 (*MidphaseRaycastFunction)(	const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
 												const PxVec3& rayOrigin, const PxVec3& rayDir, PxReal maxDist,
 												PxHitFlags hitFlags, PxU32 maxHits, PxRaycastHit* PX_RESTRICT hits);
@@ -320,6 +354,36 @@ namespace Midphase
 		return gMidphaseRaycastTable[index](mesh, meshGeom, meshTransform, rayOrigin, rayDir, maxDist, hitFlags, maxHits, hits);
 	}
 
+	// \param[in]	mesh			triangle mesh to raycast against
+	// \param[in]	meshGeom		geometry object associated with the mesh
+	// \param[in]	meshTransform	pose/transform of geometry object
+	// \param[in]	nbRays			number of rays
+	// \param[in]	rayOrigins		rays' origins
+	// \param[in]	rayDirs			rays' unit dirs
+	// \param[in]	maxDist			rays' length/max distance
+	// \param[in]	hitFlags		query behavior flags
+	// \param[out]	hits			result buffer with one closest (or any) hit per ray. Rays that miss get a hit with a 0xffffffff faceIndex and no flags.
+	// \return		number of rays that hit the mesh
+	// \note		the BV4 midphase traverses the tree with packets of rays, the RTree midphase casts the rays one by one.
+	PX_FORCE_INLINE PxU32 raycastTriangleMeshPacket(const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& meshTransform,
+													PxU32 nbRays, const PxVec3* PX_RESTRICT rayOrigins, const PxVec3* PX_RESTRICT rayDirs, PxReal maxDist,
+													PxHitFlags hitFlags, PxRaycastHit* PX_RESTRICT hits)
+	{
+	#if PX_INTEL_FAMILY && !defined(PX_SIMD_DISABLED)
+		if(mesh->getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34)
+			return raycastPacket_triangleMesh_BV4(mesh, meshGeom, meshTransform, nbRays, rayOrigins, rayDirs, maxDist, hitFlags, hits);
+	#endif
+		PxU32 nbHits = 0;
+		for(PxU32 i=0;i<nbRays;i++)
+		{
+			if(raycastTriangleMesh(mesh, meshGeom, meshTransform, rayOrigins[i], rayDirs[i], maxDist, hitFlags, 1, hits + i))
+				nbHits++;
+			else
+				invalidateRaycastHit(hits[i]);
+		}
+		return nbHits;
+	}
+
 	// \param[in]	sphere			sphere
 	// \param[in]	mesh			triangle mesh
 	// \param[in]	meshTransform	pose/transform of triangle mesh
@@ -356,6 +420,34 @@ namespace Midphase
 		return gMidphaseCapsuleOverlapTable[index](capsule, mesh, meshTransform, meshScale, results);
 	}
 
+	// \param[in]	mesh0			first triangle mesh
+	// \param[in]	meshTransform0	pose/transform of first triangle mesh
+	// \param[in]	meshScale0		scale of first triangle mesh
+	// \param[in]	mesh1			second triangle mesh
+	// \param[in]	meshTransform1	pose/transform of second triangle mesh
+	// \param[in]	meshScale1		scale of second triangle mesh
+	// \param[out]	results			results object receiving pairs of overlapping triangles (first mesh, second mesh), NULL if a simple boolean answer is enough
+	// \return 		true if at least one overlap has been found
+	// \note		only supported for BV4 meshes, returns false for other midphases
+	PX_FORCE_INLINE bool intersectMeshVsMesh(	const TriangleMesh& mesh0, const PxTransform& meshTransform0, const PxMeshScale& meshScale0,
+												const TriangleMesh& mesh1, const PxTransform& meshTransform1, const PxMeshScale& meshScale1,
+												LimitedResults* results)
+	{
+	#if PX_INTEL_FAMILY && !defined(PX_SIMD_DISABLED)
+		if(mesh0.getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34 && mesh1.getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34)
+			return intersectMeshVsMesh_BV4(mesh0, meshTransform0, meshScale0, mesh1, meshTransform1, meshScale1, results);
+	#else
+		PX_UNUSED(mesh0);
+		PX_UNUSED(meshTransform0);
+		PX_UNUSED(meshScale0);
+		PX_UNUSED(mesh1);
+		PX_UNUSED(meshTransform1);
+		PX_UNUSED(meshScale1);
+		PX_UNUSED(results);
+	#endif
+		return false;
+	}
+
 	// \param[in]	mesh						triangle mesh
 	// \param[in]	box							box
 	// \param[in]	callback					callback object, called each time a hit is found
@@ -263,8 +263,9 @@ void MeshRayCollider::collideOBB(
 	const Box& obb, bool bothTriangleSidesCollide, const RTreeTriangleMesh* mi, MeshHitCallback<PxRaycastHit>& callback,
 	bool checkObbIsAligned)
 {
-	const PxU32 maxResults = RTREE_N; // maxResults=rtree page size for more efficient early out
-	PxU32 buf[maxResults];
+	// leaves are reported in batches, except in ANY mode where maxResults=rtree page size for more efficient early out
+	PxU32 buf[RTREE_N*4];
+	const PxU32 maxResults = callback.inAnyMode() ? RTREE_N : RTREE_N*4;
 	RayRTreeCallback<false, false> rTreeCallback(
 		mi->getGeomEpsilon(), callback, mi->has16BitIndices(), mi->getTrianglesFast(), mi->getVerticesFast(),
 		PxVec3(0), PxVec3(0), 0.0f, bothTriangleSidesCollide, NULL);
@@ -282,10 +283,11 @@ void MeshRayCollider::collide(
 	const RTreeTriangleMesh* mi, MeshHitCallback<PxRaycastHit>& callback,
 	const PxVec3* inflate)
 {
-	const PxU32 maxResults = RTREE_N; // maxResults=rtree page size for more efficient early out
-	PxU32 buf[maxResults];
+	PxU32 buf[RTREE_N*4];
 	if (maxT == 0.0f) // AABB traversal path
 	{
+		// leaves are reported in batches, except in ANY mode where maxResults=rtree page size for more efficient early out
+		const PxU32 maxResults = callback.inAnyMode() ? RTREE_N : RTREE_N*4;
 		RayRTreeCallback<tInflate, false> rTreeCallback(
 			mi->getGeomEpsilon(), callback, mi->has16BitIndices(), mi->getTrianglesFast(), mi->getVerticesFast(),
 			orig, dir, maxT, bothSides, inflate);
@@ -294,10 +296,15 @@ void MeshRayCollider::collide(
 	}
 	else // ray traversal path
 	{
+		const PxU32 maxResults = RTREE_N;
 		RayRTreeCallback<tInflate, tRayTest> rTreeCallback(
 			mi->getGeomEpsilon(), callback, mi->has16BitIndices(), mi->getTrianglesFast(), mi->getVerticesFast(),
 			orig, dir, maxT, bothSides, inflate);
-		mi->getRTree().traverseRay<tInflate>(orig, dir, maxResults, buf, &rTreeCallback, inflate, maxT);
+		// closest hit raycasts shrink maxT with each hit, visiting the nodes front to back lets them cull the farther ones
+		if (tRayTest && !tInflate && callback.inClosestMode())
+			mi->getRTree().traverseRay<tInflate, 1>(orig, dir, maxResults, buf, &rTreeCallback, inflate, maxT);
+		else
+			mi->getRTree().traverseRay<tInflate, 0>(orig, dir, maxResults, buf, &rTreeCallback, inflate, maxT);
 	}
 }
 
@@ -59,7 +59,7 @@ namespace physx
 namespace Gu {
 
 /////////////////////////////////////////////////////////////////////////
-bool RTree::load(PxInputStream& stream, PxU32 meshVersion, bool mismatch_)	// PT: 'meshVersion' is the PX_MESH_VERSION from cooked file
+bool RTree::load(PxInputStream& stream, PxU32 meshVersion, bool mismatch_, MemoryInputStream* inPlace)	// PT: 'meshVersion' is the PX_MESH_VERSION from cooked file
 {
 	PX_UNUSED(meshVersion);
 
@@ -85,6 +85,19 @@ bool RTree::load(PxInputStream& stream, PxU32 meshVersion, bool mismatch_)	// PT
 	mTotalNodes = readDword(mismatch, stream);
 	mTotalPages = readDword(mismatch, stream);
 	PxU32 unused = readDword(mismatch, stream); PX_UNUSED(unused); // backwards compatibility
+
+	// the serialized pages use the runtime layout, so they can be referenced directly when no conversion is needed.
+	// Queries load them with aligned SIMD loads, hence the 16-byte alignment requirement.
+	if(inPlace && !mismatch)
+	{
+		RTreePage* pages = inPlace->referenceArray<RTreePage>(mTotalPages, 16);
+		if(pages)
+		{
+			mPages = pages;
+			mFlags |= USER_ALLOCATED;
+			return true;
+		}
+	}
 	mPages = static_cast<RTreePage*>(Ps::AlignedAllocator<128>().allocate(sizeof(RTreePage)*mTotalPages, __FILE__, __LINE__));
 	Cm::markSerializedMem(mPages, sizeof(RTreePage)*mTotalPages);
 	for(PxU32 j=0; j<mTotalPages; j++)
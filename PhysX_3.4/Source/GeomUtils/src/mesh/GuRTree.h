@@ -59,6 +59,7 @@ namespace physx
 namespace Gu {
 	
 	class Box;
+	class MemoryInputStream;
 	struct RTreePage;
 
 	typedef PxF32 RTreeValue;
@@ -138,7 +139,7 @@ namespace Gu {
 		~RTree() { release(); }
 
 		PX_INLINE void release();
-		bool load(PxInputStream& stream, PxU32 meshVersion, bool mismatch);
+		bool load(PxInputStream& stream, PxU32 meshVersion, bool mismatch, MemoryInputStream* inPlace = NULL);	// if inPlace is set, pages may reference its data
 
 		////////////////////////////////////////////////////////////////////////////
 		// QUERIES
@@ -161,7 +162,7 @@ namespace Gu {
             virtual ~CallbackRaycast() {}
 		};
 
-		// callback will be issued as soon as the buffer overflows maxResultsPerBlock-RTreePage:SIZE entries
+		// callback will be issued as soon as the buffer overflows maxResultsPerBlock-RTreePage:SIZE entries, i.e. with batches of leaves
 		// use maxResults = RTreePage:SIZE and return false from callback for "first hit" early out
 		void		traverseAABB(
 						const PxVec3& boxMin, const PxVec3& boxMax,
@@ -170,7 +171,9 @@ namespace Gu {
 						const Gu::Box& obb,
 						const PxU32 maxResultsPerBlock, PxU32* resultsBlockBuf, Callback* processResultsBlockCallback) const;
 
-		template <int inflate>
+		// with 'ordered', the children of each page are visited front to back and nodes starting beyond the current maxT
+		// are skipped, for callbacks shrinking newMaxT to the closest hit so far. Leaves are reported one at a time.
+		template <int inflate, int ordered>
 		void		traverseRay(
 						const PxVec3& rayOrigin, const PxVec3& rayDir, // dir doesn't have to be normalized and is B-A for raySegment
 						const PxU32 maxResults, PxU32* resultsPtr,
@@ -229,10 +232,16 @@ namespace Gu {
 #if PX_SUPPORT_EXTERN_TEMPLATE
 	//explicit template instantiation declaration
 	extern template
-	void RTree::traverseRay<0>(const PxVec3&, const PxVec3&, const PxU32, PxU32*, Gu::RTree::CallbackRaycast*, const PxVec3*, PxF32) const;
+	void RTree::traverseRay<0, 0>(const PxVec3&, const PxVec3&, const PxU32, PxU32*, Gu::RTree::CallbackRaycast*, const PxVec3*, PxF32) const;
 	
 	extern template
-	void RTree::traverseRay<1>(const PxVec3&, const PxVec3&, const PxU32, PxU32*, Gu::RTree::CallbackRaycast*, const PxVec3*, PxF32) const;
+	void RTree::traverseRay<1, 0>(const PxVec3&, const PxVec3&, const PxU32, PxU32*, Gu::RTree::CallbackRaycast*, const PxVec3*, PxF32) const;
+
+	extern template
+	void RTree::traverseRay<0, 1>(const PxVec3&, const PxVec3&, const PxU32, PxU32*, Gu::RTree::CallbackRaycast*, const PxVec3*, PxF32) const;
+
+	extern template
+	void RTree::traverseRay<1, 1>(const PxVec3&, const PxVec3&, const PxU32, PxU32*, Gu::RTree::CallbackRaycast*, const PxVec3*, PxF32) const;
 #endif
 
 #if PX_VC
@@ -83,11 +83,8 @@ using namespace Ps::aos;
 /////////////////////////////////////////////////////////////////////////
 void RTree::traverseAABB(const PxVec3& boxMin, const PxVec3& boxMax, const PxU32 maxResults, PxU32* resultsPtr, Callback* callback) const
 {
-	PX_UNUSED(resultsPtr);
-
 	PX_ASSERT(callback);
 	PX_ASSERT(maxResults >= mPageSize);
-	PX_UNUSED(maxResults);
 
 	const PxU32 maxStack = 128;
 	PxU32 stack1[maxStack];
@@ -121,6 +118,7 @@ void RTree::traverseAABB(const PxVec3& boxMin, const PxVec3& boxMax, const PxU32
 
 	PxU32 cacheTopValid = true;
 	PxU32 cacheTop = 0;
+	PxU32 nbResults = 0;
 
 	do {
 		stackPtr--;
@@ -156,10 +154,7 @@ void RTree::traverseAABB(const PxVec3& boxMin, const PxVec3& boxMax, const PxU32
 			if (resa[i])
 				continue;
 			if (tn->isLeaf(i))
-			{
-				if (!callback->processResults(1, &ptr))
-					return;
-			}
+				resultsPtr[nbResults++] = ptr;
 			else
 			{
 				*(stackPtr++) = ptr;
@@ -167,11 +162,22 @@ void RTree::traverseAABB(const PxVec3& boxMin, const PxVec3& boxMax, const PxU32
 				cacheTopValid = true;
 			}
 		}
+
+		// report the leaves once the next page could overflow the results buffer
+		if (nbResults > maxResults - RTREE_N)
+		{
+			if (!callback->processResults(nbResults, resultsPtr))
+				return;
+			nbResults = 0;
+		}
 	} while (stackPtr > stack);
+
+	if (nbResults)
+		callback->processResults(nbResults, resultsPtr);
 }
 
 /////////////////////////////////////////////////////////////////////////
-template <int inflate>
+template <int inflate, int ordered>
 void RTree::traverseRay(
 	const PxVec3& rayOrigin, const PxVec3& rayDir,
 	const PxU32 maxResults, PxU32* resultsPtr, Gu::RTree::CallbackRaycast* callback,
@@ -184,6 +190,7 @@ void RTree::traverseRay(
 	const PxU32 maxStack = 128;
 	PxU32 stack1[maxStack];
 	PxU32* stack = stack1+1;
+	PxF32 stackT[maxStack];	// entry distance along the ray of the nodes on the stack, only used when ordered
 
 	PX_ASSERT(mPages);
 	PX_ASSERT((uintptr_t(mPages) & 127) == 0);
@@ -233,13 +240,21 @@ void RTree::traverseRay(
 
 	PxU32 stackPtr = 0;
 	for (PxI32 j = PxI32(mNumRootPages-1); j >= 0; j --)
+	{
+		if (ordered)
+			stackT[stackPtr] = -PX_MAX_F32;
 		stack[stackPtr++] = j*sizeof(RTreePage);
+	}
 
 	PX_ALIGN_PREFIX(16) PxU32 resa[4] PX_ALIGN_SUFFIX(16);
+	PX_ALIGN_PREFIX(16) PxF32 tneara[4] PX_ALIGN_SUFFIX(16);
+	PX_UNUSED(tneara);
 
 	while (stackPtr)
 	{
 		PxU32 top = stack[--stackPtr];
+		if (ordered && stackT[stackPtr] > maxT)
+			continue; // the node starts beyond the closest hit found so far
 		if (top&1) // isLeaf test
 		{
 			top--;
@@ -312,24 +327,55 @@ void RTree::traverseRay(
 
 		PxU32* ptrs = (reinterpret_cast<RTreePage*>(tn))->ptrs;
 
-		stack[stackPtr] = ptrs[0]; stackPtr += (1+resa[0]); // AP scaffold TODO: use VecU32add
-		stack[stackPtr] = ptrs[1]; stackPtr += (1+resa[1]);
-		stack[stackPtr] = ptrs[2]; stackPtr += (1+resa[2]);
-		stack[stackPtr] = ptrs[3]; stackPtr += (1+resa[3]);
+		if (ordered)
+		{
+			V4StoreA(maxOfNeasa, tneara);
+
+			// sort the hit children far to near, so that the nearest one is popped first
+			PxU32 order[4];
+			PxU32 nbHits = 0;
+			for (PxU32 i = 0; i < 4; i++)
+			{
+				if (resa[i])
+					continue;
+				PxU32 j = nbHits++;
+				while (j && tneara[order[j-1]] < tneara[i])
+				{
+					order[j] = order[j-1];
+					j--;
+				}
+				order[j] = i;
+			}
+			for (PxU32 i = 0; i < nbHits; i++)
+			{
+				stackT[stackPtr] = tneara[order[i]];
+				stack[stackPtr++] = ptrs[order[i]];
+			}
+		}
+		else
+		{
+			stack[stackPtr] = ptrs[0]; stackPtr += (1+resa[0]); // AP scaffold TODO: use VecU32add
+			stack[stackPtr] = ptrs[1]; stackPtr += (1+resa[1]);
+			stack[stackPtr] = ptrs[2]; stackPtr += (1+resa[2]);
+			stack[stackPtr] = ptrs[3]; stackPtr += (1+resa[3]);
+		}
 	}
 }
 
 //explicit template instantiation
-template void RTree::traverseRay<0>(const PxVec3&, const PxVec3&, const PxU32, PxU32*, Gu::RTree::CallbackRaycast*, const PxVec3*, PxF32) const;
+template void RTree::traverseRay<0, 0>(const PxVec3&, const PxVec3&, const PxU32, PxU32*, Gu::RTree::CallbackRaycast*, const PxVec3*, PxF32) const;
+
+template void RTree::traverseRay<1, 0>(const PxVec3&, const PxVec3&, const PxU32, PxU32*, Gu::RTree::CallbackRaycast*, const PxVec3*, PxF32) const;
 
-template void RTree::traverseRay<1>(const PxVec3&, const PxVec3&, const PxU32, PxU32*, Gu::RTree::CallbackRaycast*, const PxVec3*, PxF32) const;
+template void RTree::traverseRay<0, 1>(const PxVec3&, const PxVec3&, const PxU32, PxU32*, Gu::RTree::CallbackRaycast*, const PxVec3*, PxF32) const;
+
+template void RTree::traverseRay<1, 1>(const PxVec3&, const PxVec3&, const PxU32, PxU32*, Gu::RTree::CallbackRaycast*, const PxVec3*, PxF32) const;
 
 /////////////////////////////////////////////////////////////////////////
 void RTree::traverseOBB(
 	const Gu::Box& obb, const PxU32 maxResults, PxU32* resultsPtr, Gu::RTree::Callback* callback) const
 {
-	PX_UNUSED(resultsPtr);
-	PX_UNUSED(maxResults);
+	PX_ASSERT(maxResults >= mPageSize);
 
 	const PxU32 maxStack = 128;
 	PxU32 stack[maxStack];
@@ -428,6 +474,7 @@ void RTree::traverseOBB(
 		*stackPtr++ = j*sizeof(RTreePage);
 	PxU32 cacheTopValid = true;
 	PxU32 cacheTop = 0;
+	PxU32 nbResults = 0;
 
 	PX_ALIGN_PREFIX(16) PxU32 resa_[4] PX_ALIGN_SUFFIX(16);
 
@@ -553,10 +600,7 @@ void RTree::traverseOBB(
 			if (resa_[i])
 			{
 				if (tn->isLeaf(i))
-				{
-					if (!callback->processResults(1, &ptr))
-						return;
-				}
+					resultsPtr[nbResults++] = ptr;
 				else
 				{
 					*(stackPtr++) = ptr;
@@ -565,7 +609,18 @@ void RTree::traverseOBB(
 				}
 			}
 		}
+
+		// report the leaves once the next page could overflow the results buffer
+		if (nbResults > maxResults - 4)
+		{
+			if (!callback->processResults(nbResults, resultsPtr))
+				return;
+			nbResults = 0;
+		}
 	} while (stackPtr > stack);
+
+	if (nbResults)
+		callback->processResults(nbResults, resultsPtr);
 }
 
 } // namespace Gu
@@ -36,6 +36,7 @@
 #include "GuBox.h"
 #include "PxMeshScale.h"
 #include "CmUtils.h"
+#include "PsAtomic.h"
 
 using namespace physx;
 
@@ -58,11 +59,16 @@ Gu::TriangleMesh::TriangleMesh(GuMeshFactory& factory, TriangleMeshData& d)
 ,	mExtraTrigData			(d.mExtraTrigData)
 ,	mGeomEpsilon			(d.mGeomEpsilon)
 ,	mFlags					(d.mFlags)
+,	mUserArrays				(d.mUserArrays)
 ,	mMaterialIndices		(d.mMaterialIndices)
 ,	mFaceRemap				(d.mFaceRemap)
 ,	mAdjacencies			(d.mAdjacencies)
 
 ,	mMeshFactory			(&factory)
+,	mCompressed				(d.mCompressed)
+,	mCompressedSize			(d.mCompressed ? d.mCompressed->mSize : 0)
+,	mDecompressedVertices	(NULL)
+,	mDecompressedTriangles	(NULL)
 
 ,	mGRB_triIndices					(d.mGRB_triIndices)
 
@@ -78,6 +84,8 @@ Gu::TriangleMesh::TriangleMesh(GuMeshFactory& factory, TriangleMeshData& d)
 	d.mFaceRemap = 0;
 	d.mAdjacencies = 0;
 	d.mMaterialIndices = 0;
+	d.mCompressed = 0;
+	d.mUserArrays = 0;
 
 	d.mGRB_triIndices = 0;
 
@@ -92,14 +100,28 @@ Gu::TriangleMesh::TriangleMesh(GuMeshFactory& factory, TriangleMeshData& d)
 
 Gu::TriangleMesh::~TriangleMesh() 
 { 	
+	// decoded copies are always owned by the mesh, including for deserialized meshes
+	PX_FREE_AND_RESET(mDecompressedVertices);
+	PX_FREE_AND_RESET(mDecompressedTriangles);
+
 	if(getBaseFlags() & PxBaseFlag::eOWNS_MEMORY)
 	{
+		// arrays loaded in place reference user memory, leave them alone
+		if(mUserArrays & IPMA_EXTRA_TRIG_DATA)	mExtraTrigData = NULL;
+		if(mUserArrays & IPMA_FACE_REMAP)		mFaceRemap = NULL;
+		if(mUserArrays & IPMA_ADJACENCIES)		mAdjacencies = NULL;
+		if(mUserArrays & IPMA_MATERIALS)		mMaterialIndices = NULL;
+		if(mUserArrays & IPMA_TRIANGLES)		mTriangles = NULL;
+		if(mUserArrays & IPMA_VERTICES)			mVertices = NULL;
+		if(mUserArrays & IPMA_COMPRESSED)		mCompressed = NULL;
+
 		PX_FREE_AND_RESET(mExtraTrigData);
 		PX_FREE_AND_RESET(mFaceRemap);
 		PX_FREE_AND_RESET(mAdjacencies);
 		PX_FREE_AND_RESET(mMaterialIndices);
 		PX_FREE_AND_RESET(mTriangles);
 		PX_FREE_AND_RESET(mVertices);
+		PX_FREE_AND_RESET(mCompressed);
 
 		PX_FREE_AND_RESET(mGRB_triIndices); 
 
@@ -157,6 +179,13 @@ void Gu::TriangleMesh::exportExtraData(PxSerializationContext& stream)
 		stream.alignData(PX_SERIAL_ALIGN);
 		stream.writeData(mAdjacencies, mNbTriangles * sizeof(PxU32) * 3);
 	}
+
+	// the decoded copies are not exported, they are rebuilt on demand
+	if(mCompressed)
+	{
+		stream.alignData(PX_SERIAL_ALIGN);
+		stream.writeData(mCompressed, mCompressedSize);
+	}
 }
 
 void Gu::TriangleMesh::importExtraData(PxDeserializationContext& context)
@@ -185,10 +214,18 @@ void Gu::TriangleMesh::importExtraData(PxDeserializationContext& context)
 	if(mAdjacencies)
 		mAdjacencies = context.readExtraData<PxU32, PX_SERIAL_ALIGN>(3*mNbTriangles);
 
+	if(mCompressed)
+		mCompressed = reinterpret_cast<CompressedMesh*>(context.readExtraData<PxU8, PX_SERIAL_ALIGN>(mCompressedSize));
+	mDecompressedVertices = NULL;
+	mDecompressedTriangles = NULL;
+
 	mGRB_triIndices = NULL;
 	mGRB_triAdjacencies = NULL;
 	mGRB_faceRemap = NULL;
 	mGRB_BV32Tree = NULL;
+
+	// everything now lives in the deserialization buffer
+	mUserArrays = 0;
 }
 
 void Gu::TriangleMesh::onRefCountZero()
@@ -213,20 +250,67 @@ void Gu::TriangleMesh::release()
 	decRefCount();
 }
 
+// Compressed meshes only decode their data for users of the public API. Concurrent first calls may both decode
+// it, in which case only one copy is published and the other one is discarded.
+const PxVec3* Gu::TriangleMesh::getDecompressedVertices() const
+{
+	PX_ASSERT(mCompressed);
+	PxVec3* vertices = mDecompressedVertices;
+	if(!vertices)
+	{
+		// one more vertex to make sure it's safe to V4Load the last one
+		PxVec3* decoded = reinterpret_cast<PxVec3*>(PX_ALLOC(sizeof(PxVec3)*(mNbVertices+1), "PxVec3"));
+		mCompressed->decodeVertices(decoded);
+		decoded[mNbVertices] = PxVec3(0.0f);
+
+		volatile void** dest = const_cast<volatile void**>(reinterpret_cast<void* const*>(&mDecompressedVertices));
+		vertices = reinterpret_cast<PxVec3*>(Ps::atomicCompareExchangePointer(dest, decoded, NULL));
+		if(vertices)
+			PX_FREE(decoded);
+		else
+			vertices = decoded;
+	}
+	return vertices;
+}
+
+const PxU32* Gu::TriangleMesh::getDecompressedTriangles() const
+{
+	PX_ASSERT(mCompressed && mCompressed->hasIndices());
+	PxU32* triangles = mDecompressedTriangles;
+	if(!triangles)
+	{
+		PxU32* decoded = reinterpret_cast<PxU32*>(PX_ALLOC(sizeof(PxU32)*mNbTriangles*3, "mTriangles"));
+		mCompressed->decodeTriangles(decoded);
+
+		volatile void** dest = const_cast<volatile void**>(reinterpret_cast<void* const*>(&mDecompressedTriangles));
+		triangles = reinterpret_cast<PxU32*>(Ps::atomicCompareExchangePointer(dest, decoded, NULL));
+		if(triangles)
+			PX_FREE(decoded);
+		else
+			triangles = decoded;
+	}
+	return triangles;
+}
+
 #if PX_ENABLE_DYNAMIC_MESH_RTREE
 PxVec3* Gu::TriangleMesh::getVerticesForModification()
 {
-	Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxTriangleMesh::getVerticesForModification() is only supported for meshes with PxMeshMidPhase::eBVH33.");
+	Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxTriangleMesh::getVerticesForModification() is only supported for meshes with PxMeshMidPhase::eBVH33 or PxMeshMidPhase::eBVH34.");
 
 	return NULL;
 }
 
 PxBounds3 Gu::TriangleMesh::refitBVH()
 {
-	Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxTriangleMesh::refitBVH() is only supported for meshes with PxMeshMidPhase::eBVH33.");
+	Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxTriangleMesh::refitBVH() is only supported for meshes with PxMeshMidPhase::eBVH33 or PxMeshMidPhase::eBVH34.");
 
 	return PxBounds3(mAABB.getMin(), mAABB.getMax());
 }
+
+PxBounds3 Gu::TriangleMesh::refitBVH(PxU32, PxU32)
+{
+	return refitBVH();
+}
 #endif
 
 } // namespace physx
@@ -88,10 +88,10 @@ public:
 	
 // PxTriangleMesh
 						virtual	PxU32					getNbVertices()						const	{ return mNbVertices; }
-						virtual	const PxVec3*			getVertices()						const	{ return mVertices; }
+						virtual	const PxVec3*			getVertices()						const	{ return mCompressed ? getDecompressedVertices() : mVertices; }
 						virtual	const PxU32*			getTrianglesRemap()					const	{ return mFaceRemap; }
 						virtual	PxU32					getNbTriangles()					const	{ return mNbTriangles; }
-						virtual	const void*				getTriangles()						const	{ return mTriangles; }
+						virtual	const void*				getTriangles()						const	{ return (mCompressed && mCompressed->hasIndices()) ? getDecompressedTriangles() : mTriangles; }
 						virtual	PxTriangleMeshFlags		getTriangleMeshFlags()				const	{ return PxTriangleMeshFlags(mFlags); }
 						virtual	PxMaterialTableIndex	getTriangleMaterialIndex(PxTriangleID triangleIndex) const {
 																				return hasPerTriangleMaterials() ? getMaterials()[triangleIndex] : PxMaterialTableIndex(0xffff);	}
@@ -99,6 +99,7 @@ public:
 #if PX_ENABLE_DYNAMIC_MESH_RTREE
 						virtual PxVec3*					getVerticesForModification();
 						virtual PxBounds3				refitBVH();
+						virtual PxBounds3				refitBVH(PxU32 firstDirtyVertex, PxU32 nbDirtyVertices);
 #endif 
 
 						virtual	PxBounds3				getLocalBounds()					const
@@ -126,6 +127,12 @@ public:
 	PX_FORCE_INLINE				const CenterExtents&	getLocalBoundsFast()				const	{ return mAABB;				}
 	PX_FORCE_INLINE				const PxU16*			getMaterials()						const	{ return mMaterialIndices;	}
 	PX_FORCE_INLINE				const PxU8*				getExtraTrigData()					const	{ return mExtraTrigData;	}
+	PX_FORCE_INLINE				bool					isModifiable()						const	{ return !mCompressed && (mUserArrays & (IPMA_VERTICES|IPMA_MIDPHASE|IPMA_EXTRA_TRIG_DATA))==0;	}
+	PX_FORCE_INLINE				const CompressedMesh*	getCompressedMesh()					const	{ return mCompressed;		}
+
+	// These work for compressed meshes as well, unlike getVerticesFast() / getTrianglesFast()
+	PX_FORCE_INLINE				PxVec3					getVertex(PxU32 index)				const	{ return mCompressed ? mCompressed->getVertex(index) : mVertices[index];	}
+	PX_FORCE_INLINE				void					getTriangleVertexIndices(PxU32 triangleIndex, PxU32& vref0, PxU32& vref1, PxU32& vref2)	const;
 
 	PX_FORCE_INLINE				const CenterExtentsPadded&	getPaddedBounds()				const
 														{
@@ -140,6 +147,10 @@ public:
 
 								void					setMeshFactory(GuMeshFactory* factory) { mMeshFactory = factory; }
 
+private:
+								const PxVec3*			getDecompressedVertices()			const;
+								const PxU32*			getDecompressedTriangles()			const;
+
 protected:
 								PxU32					mNbVertices;
 								PxU32					mNbTriangles;
@@ -160,12 +171,18 @@ protected:
 		*/
 								PxU8					mFlags;					//!< Flag whether indices are 16 or 32 bits wide
 																					//!< Flag whether triangle adajacencies are build
+								PxU8					mUserArrays;			//!< InPlaceMeshArray flags: arrays referencing user memory, not owned by the mesh
 								PxU16*					mMaterialIndices;		//!< the size of the array is numTriangles.
 								PxU32*					mFaceRemap;				//!< new faces to old faces mapping (after cleaning, etc). Usage: old = faceRemap[new]
 								PxU32*					mAdjacencies;			//!< Adjacency information for each face - 3 adjacent faces
 																					//!< Set to 0xFFFFffff if no adjacent face
 	
 								GuMeshFactory*			mMeshFactory;					// PT: changed to pointer for serialization
+
+								CompressedMesh*			mCompressed;			//!< quantized vertices (and indices with CMF_INDICES), NULL for regular meshes
+								PxU32					mCompressedSize;
+								PxVec3*					mDecompressedVertices;	//!< decoded on first call to getVertices(), not serialized
+								PxU32*					mDecompressedTriangles;	//!< decoded on first call to getTriangles(), not serialized
 public:
 								
 								// GRB data -------------------------
@@ -186,11 +203,13 @@ public:
 
 } // namespace Gu
 
-PX_FORCE_INLINE void Gu::TriangleMesh::computeWorldTriangle(PxTriangle& worldTri, PxTriangleID triangleIndex, const Cm::Matrix34& worldMatrix, bool flipNormal,
-	PxU32* PX_RESTRICT vertexIndices, PxU32* PX_RESTRICT adjacencyIndices) const
+PX_FORCE_INLINE void Gu::TriangleMesh::getTriangleVertexIndices(PxU32 triangleIndex, PxU32& vref0, PxU32& vref1, PxU32& vref2) const
 {
-	PxU32 vref0, vref1, vref2;
-	if(has16BitIndices())
+	if(mCompressed && mCompressed->hasIndices())
+	{
+		mCompressed->getVertexReferences(triangleIndex, vref0, vref1, vref2);
+	}
+	else if(has16BitIndices())
 	{
 		const Gu::TriangleT<PxU16>& T = (reinterpret_cast<const Gu::TriangleT<PxU16>*>(getTrianglesFast()))[triangleIndex];
 		vref0 = T.v[0];
@@ -204,12 +223,18 @@ PX_FORCE_INLINE void Gu::TriangleMesh::computeWorldTriangle(PxTriangle& worldTri
 		vref1 = T.v[1];
 		vref2 = T.v[2];
 	}
+}
+
+PX_FORCE_INLINE void Gu::TriangleMesh::computeWorldTriangle(PxTriangle& worldTri, PxTriangleID triangleIndex, const Cm::Matrix34& worldMatrix, bool flipNormal,
+	PxU32* PX_RESTRICT vertexIndices, PxU32* PX_RESTRICT adjacencyIndices) const
+{
+	PxU32 vref0, vref1, vref2;
+	getTriangleVertexIndices(triangleIndex, vref0, vref1, vref2);
 	if (flipNormal)
 		Ps::swap<PxU32>(vref1, vref2);
-	const PxVec3* PX_RESTRICT vertices = getVerticesFast();
-	worldTri.verts[0] = worldMatrix.transform(vertices[vref0]);
-	worldTri.verts[1] = worldMatrix.transform(vertices[vref1]);
-	worldTri.verts[2] = worldMatrix.transform(vertices[vref2]);
+	worldTri.verts[0] = worldMatrix.transform(getVertex(vref0));
+	worldTri.verts[1] = worldMatrix.transform(getVertex(vref1));
+	worldTri.verts[2] = worldMatrix.transform(getVertex(vref2));
 
 	if(vertexIndices)
 	{
@@ -238,26 +263,12 @@ PX_FORCE_INLINE void Gu::TriangleMesh::computeWorldTriangle(PxTriangle& worldTri
 PX_FORCE_INLINE void Gu::TriangleMesh::getLocalTriangle(PxTriangle& localTri, PxTriangleID triangleIndex, bool flipNormal) const
 {
 	PxU32 vref0, vref1, vref2;
-	if(has16BitIndices())
-	{
-		const Gu::TriangleT<PxU16>& T = (reinterpret_cast<const Gu::TriangleT<PxU16>*>(getTrianglesFast()))[triangleIndex];
-		vref0 = T.v[0];
-		vref1 = T.v[1];
-		vref2 = T.v[2];
-	}
-	else
-	{
-		const Gu::TriangleT<PxU32>& T = (reinterpret_cast<const Gu::TriangleT<PxU32>*>(getTrianglesFast()))[triangleIndex];
-		vref0 = T.v[0];
-		vref1 = T.v[1];
-		vref2 = T.v[2];
-	}
+	getTriangleVertexIndices(triangleIndex, vref0, vref1, vref2);
 	if (flipNormal)
 		Ps::swap<PxU32>(vref1, vref2);
-	const PxVec3* PX_RESTRICT vertices = getVerticesFast();
-	localTri.verts[0] = vertices[vref0];
-	localTri.verts[1] = vertices[vref1];
-	localTri.verts[2] = vertices[vref2];
+	localTri.verts[0] = getVertex(vref0);
+	localTri.verts[1] = getVertex(vref1);
+	localTri.verts[2] = getVertex(vref2);
 }
 
 PX_INLINE float computeSweepData(const PxTriangleMeshGeometry& triMeshGeom, /*const Cm::FastVertex2ShapeScaling& scaling,*/ PxVec3& sweepOrigin, PxVec3& sweepExtents, PxVec3& sweepDir, float distance)
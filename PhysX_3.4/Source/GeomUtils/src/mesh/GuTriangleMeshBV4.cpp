@@ -29,6 +29,8 @@
 
 #include "GuTriangleMesh.h"
 #include "GuTriangleMeshBV4.h"
+#include "GuConvexEdgeFlags.h"
+#include "PsFoundation.h"
 
 using namespace physx;
 
@@ -42,6 +44,7 @@ Gu::BV4TriangleMesh::BV4TriangleMesh(GuMeshFactory& factory, TriangleMeshData& d
 
 	BV4TriangleData& bv4Data = static_cast<BV4TriangleData&>(d);
 	mMeshInterface = bv4Data.mMeshInterface;
+	mMeshInterface.setCompressedMesh(mCompressed);
 	mBV4Tree = bv4Data.mBV4Tree;
 	mBV4Tree.mMeshInterface = &mMeshInterface;
 }
@@ -70,7 +73,60 @@ void Gu::BV4TriangleMesh::importExtraData(PxDeserializationContext& context)
 		mMeshInterface.setPointers(NULL, const_cast<IndTri16*>(reinterpret_cast<const IndTri16*>(getTrianglesFast())), getVerticesFast());
 	else
 		mMeshInterface.setPointers(const_cast<IndTri32*>(reinterpret_cast<const IndTri32*>(getTrianglesFast())), NULL, getVerticesFast());
+	mMeshInterface.setCompressedMesh(mCompressed);
 	mBV4Tree.mMeshInterface = &mMeshInterface;
 }
 
+#if PX_ENABLE_DYNAMIC_MESH_RTREE
+PxVec3* Gu::BV4TriangleMesh::getVerticesForModification()
+{
+	if(!isModifiable())
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxTriangleMesh::getVerticesForModification() is not supported for meshes loaded in place.");
+		return NULL;
+	}
+	return const_cast<PxVec3*>(getVertices());
+}
+
+PxBounds3 Gu::BV4TriangleMesh::refitBVH()
+{
+	return refitBVH(0, getNbVertices());
+}
+
+PxBounds3 Gu::BV4TriangleMesh::refitBVH(PxU32 firstDirtyVertex, PxU32 nbDirtyVertices)
+{
+	// Must match the box epsilon used by BV4TriangleMeshBuilder
+	const float boxEpsilon = 2e-4f;
+
+	if(!isModifiable())
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxTriangleMesh::refitBVH() is not supported for meshes loaded in place.");
+		return PxBounds3(mAABB.getMin(), mAABB.getMax());
+	}
+
+	PxBounds3 meshBounds;
+	if(!mBV4Tree.refit(meshBounds, boxEpsilon, firstDirtyVertex, nbDirtyVertices))
+		return PxBounds3(mAABB.getMin(), mAABB.getMax());
+
+	// The active edges are not recomputed, so we mark the edges of the refitted triangles as active
+	if(mExtraTrigData)
+	{
+		const PxU32 nbTris = getNbTriangles();
+		nbDirtyVertices = PxMin(nbDirtyVertices, getNbVertices() - firstDirtyVertex);
+		for(PxU32 i=0;i<nbTris;i++)
+		{
+			PxU32 vref0, vref1, vref2;
+			getVertexReferences(vref0, vref1, vref2, i, mMeshInterface.getTris32(), mMeshInterface.getTris16());
+			if(	(vref0 - firstDirtyVertex) < nbDirtyVertices ||
+				(vref1 - firstDirtyVertex) < nbDirtyVertices ||
+				(vref2 - firstDirtyVertex) < nbDirtyVertices)
+				mExtraTrigData[i] |= ETD_CONVEX_EDGE_ALL;
+		}
+	}
+
+	mAABB = meshBounds;
+	return meshBounds;
+}
+#endif
+
 } // namespace physx
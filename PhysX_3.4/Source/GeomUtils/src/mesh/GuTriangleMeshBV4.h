@@ -59,6 +59,12 @@ class BV4TriangleMesh : public TriangleMesh
 						virtual							~BV4TriangleMesh(){}
 
 						virtual	PxMeshMidPhase::Enum	getMidphaseID()			const	{ return PxMeshMidPhase::eBVH34;	}
+
+#if PX_ENABLE_DYNAMIC_MESH_RTREE
+						virtual PxVec3*					getVerticesForModification();
+						virtual PxBounds3				refitBVH();
+						virtual PxBounds3				refitBVH(PxU32 firstDirtyVertex, PxU32 nbDirtyVertices);
+#endif
 	PX_FORCE_INLINE				const Gu::BV4Tree&		getBV4Tree()			const	{ return mBV4Tree;				}
 	private:
 								Gu::SourceMesh			mMeshInterface;
@@ -31,6 +31,7 @@
 #include "GuTriangleMeshRTree.h"
 #if PX_ENABLE_DYNAMIC_MESH_RTREE
 #include "GuConvexEdgeFlags.h"
+#include "PsFoundation.h"
 #endif
 
 using namespace physx;
@@ -72,6 +73,11 @@ void Gu::RTreeTriangleMesh::importExtraData(PxDeserializationContext& context)
 #if PX_ENABLE_DYNAMIC_MESH_RTREE
 PxVec3 * Gu::RTreeTriangleMesh::getVerticesForModification()
 {
+	if(!isModifiable())
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxTriangleMesh::getVerticesForModification() is not supported for meshes loaded in place.");
+		return NULL;
+	}
 	return const_cast<PxVec3*>(getVertices());
 }
 
@@ -119,6 +125,12 @@ struct RefitCallback : Gu::RTree::CallbackRefit
 
 PxBounds3 Gu::RTreeTriangleMesh::refitBVH()
 {
+	if(!isModifiable())
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxTriangleMesh::refitBVH() is not supported for meshes loaded in place.");
+		return PxBounds3(mAABB.getMin(), mAABB.getMax());
+	}
+
 	PxBounds3 meshBounds;
 	if (has16BitIndices())
 	{
@@ -146,6 +158,12 @@ PxBounds3 Gu::RTreeTriangleMesh::refitBVH()
 	mAABB = meshBounds;
 	return meshBounds;
 }
+
+PxBounds3 Gu::RTreeTriangleMesh::refitBVH(PxU32 /*firstDirtyVertex*/, PxU32 /*nbDirtyVertices*/)
+{
+	// The RTree refit has no partial mode, it always goes through the whole tree
+	return refitBVH();
+}
 #endif
 
 } // namespace physx
@@ -63,6 +63,7 @@ class RTreeTriangleMesh : public TriangleMesh
 #if PX_ENABLE_DYNAMIC_MESH_RTREE
 						virtual PxVec3*					getVerticesForModification();
 						virtual PxBounds3				refitBVH();
+						virtual PxBounds3				refitBVH(PxU32 firstDirtyVertex, PxU32 nbDirtyVertices);
 #endif
 
 	PX_FORCE_INLINE				const Gu::RTree&		getRTree()				const	{ return mRTree; }
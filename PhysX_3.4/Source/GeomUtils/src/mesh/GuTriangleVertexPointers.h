@@ -41,6 +41,16 @@ namespace physx {
 	{
 		static void PX_FORCE_INLINE getTriangleVerts(const TriangleMesh* mesh, PxU32 triangleIndex, PxVec3& v0, PxVec3& v1, PxVec3& v2)
 		{
+			if(mesh->getCompressedMesh())
+			{
+				PxU32 vref0, vref1, vref2;
+				mesh->getTriangleVertexIndices(triangleIndex, vref0, vref1, vref2);
+				v0 = mesh->getVertex(vref0);
+				v1 = mesh->getVertex(vref1);
+				v2 = mesh->getVertex(vref2);
+				return;
+			}
+
 			const PxVec3* verts = mesh->getVerticesFast();
 			if(mesh->has16BitIndices())
 			{
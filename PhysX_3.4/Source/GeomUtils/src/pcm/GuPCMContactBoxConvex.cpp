@@ -133,8 +133,12 @@ static bool addGJKEPAContacts(Gu::ShrunkConvexHullV& convexHull, Gu::BoxV& box,
 		RelativeConvex<BoxV> epaConvexA(box, aToB);
 		LocalConvex<ConvexHullV> epaConvexB(convexHull);
 
+		//warm start EPA with the deepest contact which survived the refresh
+		Vec3V warmStartNormal;
+		const bool hasWarmStartNormal = manifold.getDeepestNormal(warmStartNormal);
+
 		status = epaPenetration(epaConvexA, epaConvexB, manifold.mAIndice, manifold.mBIndice, manifold.mNumWarmStartPoints,
-			closestA, closestB, normal, penDep);
+			closestA, closestB, normal, penDep, false, hasWarmStartNormal ? &warmStartNormal : NULL);
 		if (status == EPA_CONTACT)
 		{
 
@@ -171,8 +171,12 @@ static bool addGJKEPAContacts(Gu::ShrunkConvexHullV& convexHull0, Gu::ShrunkConv
 		RelativeConvex<ConvexHullV> convexA1(convexHull0, aToB);
 		LocalConvex<ConvexHullV> convexB1(convexHull1);
 
+		//warm start EPA with the deepest contact which survived the refresh
+		Vec3V warmStartNormal;
+		const bool hasWarmStartNormal = manifold.getDeepestNormal(warmStartNormal);
+
 		status = epaPenetration(convexA1, convexB1, manifold.mAIndice, manifold.mBIndice, manifold.mNumWarmStartPoints,
-			closestA, closestB, normal, penDep);
+			closestA, closestB, normal, penDep, false, hasWarmStartNormal ? &warmStartNormal : NULL);
 
 		if (status == EPA_CONTACT)
 		{
@@ -43,6 +43,7 @@
 #include "GuPCMContactMeshCallback.h"
 #include "GuIntersectionTriangleBox.h"
 #include "GuBox.h"
+#include "GuTriangleMesh.h"
 
 using namespace physx;
 using namespace Gu;
@@ -99,6 +100,78 @@ public:
 	
 };
 
+//This callback collects the indices of the triangles overlapping the inflated query volume of the triangle cache
+struct PCMConvexVsMeshTriangleCacheCallback : MeshHitCallback<PxRaycastHit>
+{
+	PCMConvexVsMeshTriangleCacheCallback& operator=(const PCMConvexVsMeshTriangleCacheCallback&);
+public:
+	PxU32*	mTriangleIndices;
+	PxU32	mNumTriangles;
+	bool	mOverflow;
+
+	PCMConvexVsMeshTriangleCacheCallback(PxU32* triangleIndices) :
+		MeshHitCallback<PxRaycastHit>(CallbackMode::eMULTIPLE),
+		mTriangleIndices(triangleIndices), mNumTriangles(0), mOverflow(false)
+	{
+	}
+
+	virtual PxAgain processHit(const PxRaycastHit& hit, const PxVec3&, const PxVec3&, const PxVec3&, PxReal&, const PxU32*)
+	{
+		if(mNumTriangles == GU_MAX_CACHED_TRIANGLES)
+		{
+			mOverflow = true;
+			return false;
+		}
+		mTriangleIndices[mNumTriangles++] = hit.faceIndex;
+		return true;
+	}
+};
+
+//The hull bounds are inflated by this ratio of their largest extent when the triangle cache gets refreshed, so the cache stays valid while the hull moves
+//around its resting position
+static const PxReal gTriangleCacheInflation = 0.25f;
+
+//ML: this function reports the triangles overlapping the hull OBB from the triangle cache in the multiple manifold, instead of querying the midphase. 
+//The cache is refreshed with an inflated query whenever the hull leaves the cached bounds. Returns false if the triangles overlapping the inflated
+//volume don't fit in the cache, in which case the caller has to go through the midphase
+static bool processCachedTriangles(const TriangleMesh* PX_RESTRICT meshData, const Box& hullOBB, MultiplePersistentContactManifold& multiManifold, 
+	PCMConvexVsMeshContactGenerationCallback& callback)
+{
+	//hullOBB is in mesh vertex space, so is the triangle cache
+	const PxVec3 hullExtents = hullOBB.computeAABBExtent();
+	const PxBounds3 hullBounds(hullOBB.center - hullExtents, hullOBB.center + hullExtents);
+
+	if(!multiManifold.isTriangleCacheValid(hullBounds))
+	{
+		const PxVec3 inflatedExtents = hullExtents + PxVec3(hullExtents.maxElement() * gTriangleCacheInflation);
+		const Box queryBox(hullOBB.center, inflatedExtents, PxMat33(PxIdentity));
+
+		PCMConvexVsMeshTriangleCacheCallback cacheCallback(multiManifold.mCachedTriangles);
+		Midphase::intersectOBB(meshData, queryBox, cacheCallback, true);
+
+		if(cacheCallback.mOverflow)
+		{
+			multiManifold.invalidateTriangleCache();
+			return false;
+		}
+
+		multiManifold.setTriangleCache(PxBounds3(hullOBB.center - inflatedExtents, hullOBB.center + inflatedExtents), cacheCallback.mNumTriangles);
+	}
+
+	PxRaycastHit hit;
+	PxReal unused = 0.0f;
+	PxU32 vertIndices[3];
+	for(PxU32 i = 0; i < multiManifold.mNumCachedTriangles; ++i)
+	{
+		const PxU32 triangleIndex = multiManifold.mCachedTriangles[i];
+		meshData->getTriangleVertexIndices(triangleIndex, vertIndices[0], vertIndices[1], vertIndices[2]);
+		hit.faceIndex = triangleIndex;
+		//the callback tests the triangle against the hull OBB, exactly like it does for the triangles reported by the midphase
+		callback.processHit(hit, meshData->getVertex(vertIndices[0]), meshData->getVertex(vertIndices[1]), meshData->getVertex(vertIndices[2]), unused, vertIndices);
+	}
+	return true;
+}
+
 
 bool Gu::PCMContactConvexMesh(const PolygonalData& polyData, SupportLocal* polyMap, const Ps::aos::FloatVArg minMargin, const PxBounds3& hullAABB, const PxTriangleMeshGeometryLL& shapeMesh,
 						const PxTransform& transform0, const PxTransform& transform1,
@@ -148,7 +221,8 @@ bool Gu::PCMContactConvexMesh(const PolygonalData& polyData, SupportLocal* polyM
 			polyData, polyMap, &delayedContacts, convexScaling, idtConvexScale, meshScaling, extraData, idtMeshScale, true, 
 			hullOBB, renderOutput);
 
-		Midphase::intersectOBB(meshData, hullOBB, blockCallback, true);
+		if(!processCachedTriangles(meshData, hullOBB, multiManifold, blockCallback))
+			Midphase::intersectOBB(meshData, hullOBB, blockCallback, true);
 
 		PX_ASSERT(multiManifold.mNumManifolds <= GU_MAX_MANIFOLD_SIZE);
 
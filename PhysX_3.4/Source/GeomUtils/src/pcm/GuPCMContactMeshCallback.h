@@ -125,48 +125,59 @@ public:
 		const PxU32 CacheSize = 16;
 		Gu::TriangleCache<CacheSize> cache;
 
-		const PxU32 nbPasses = (nb+(CacheSize-1))/CacheSize;
-		PxU32 nbTrigs = nb;
-		PxU32* inds0 = indices;
-
 		const PxU8 nextInd[] = {2,0,1};
 
-		for(PxU32 i = 0; i < nbPasses; ++i)
+		//The heightfield reports the triangles of a block of cells in ascending order, so most of the adjacent triangles we need to compute the
+		//edge flags are part of the same batch. We fetch all the triangles of the batch once and only go back to the heightfield for the adjacent
+		//triangles outside of the block
+		PxTriangle triangles[HF_SWEEP_REPORT_BUFFER_SIZE];
+		PxU32 vertIndices[HF_SWEEP_REPORT_BUFFER_SIZE][3];
+		PxU32 adjIndices[HF_SWEEP_REPORT_BUFFER_SIZE][3];
+		PxVec3 normals[HF_SWEEP_REPORT_BUFFER_SIZE];
+
+		while(nb)
 		{
-			cache.mNumTriangles = 0;
-			PxU32 trigCount = PxMin(nbTrigs, CacheSize);
-			nbTrigs -= trigCount;
-			while(trigCount--)
-			{
-				PxU32 triangleIndex = *(inds0++);
-				PxU32 vertIndices[3];
+			const PxU32 nbBatch = PxMin(nb, PxU32(HF_SWEEP_REPORT_BUFFER_SIZE));
 
-				PxTriangle currentTriangle;	// in world space
+			for(PxU32 i = 0; i < nbBatch; ++i)
+			{
+				mHfUtil.getTriangle(mHeightfieldTransform, triangles[i], vertIndices[i], adjIndices[i], indices[i], false, false);
+				triangles[i].denormalizedNormal(normals[i]);
+			}
 
-				PxU32 adjInds[3];
-				mHfUtil.getTriangle(mHeightfieldTransform, currentTriangle, vertIndices, adjInds, triangleIndex, false, false);
+			cache.mNumTriangles = 0;
+			for(PxU32 i = 0; i < nbBatch; ++i)
+			{
+				const PxTriangle& currentTriangle = triangles[i];	// in world space
 
-				PxVec3 normal;
-				currentTriangle.normal(normal);
+				PxVec3 normal = normals[i];
+				normal.normalize();
 
 				PxU8 triFlags = 0; //KS - temporary until we can calculate triFlags for HF
 
 				for(PxU32 a = 0; a < 3; ++a)
 				{
-
-					if (adjInds[a] != 0xFFFFFFFF)
+					const PxU32 adjIndex = adjIndices[i][a];
+					if (adjIndex != 0xFFFFFFFF)
 					{
 						PxTriangle adjTri;
-						PxU32 inds[3];
-						mHfUtil.getTriangle(mHeightfieldTransform, adjTri, inds, NULL, adjInds[a], false, false);
+						PxVec3 adjNormal;
+						const PxU32 batchIndex = findTriangle(indices, nbBatch, adjIndex);
+						if(batchIndex != 0xFFFFFFFF)
+						{
+							adjTri = triangles[batchIndex];
+							adjNormal = normals[batchIndex];
+						}
+						else
+						{
+							PxU32 inds[3];
+							mHfUtil.getTriangle(mHeightfieldTransform, adjTri, inds, NULL, adjIndex, false, false);
+							PX_ASSERT(inds[0] == vertIndices[i][a] || inds[1] == vertIndices[i][a] || inds[2] == vertIndices[i][a]);
+							PX_ASSERT(inds[0] == vertIndices[i][(a + 1) % 3] || inds[1] == vertIndices[i][(a + 1) % 3] || inds[2] == vertIndices[i][(a + 1) % 3]);
+							adjTri.denormalizedNormal(adjNormal);
+						}
 						//We now compare the triangles to see if this edge is active
 
-						PX_ASSERT(inds[0] == vertIndices[a] || inds[1] == vertIndices[a] || inds[2] == vertIndices[a]);
-						PX_ASSERT(inds[0] == vertIndices[(a + 1) % 3] || inds[1] == vertIndices[(a + 1) % 3] || inds[2] == vertIndices[(a + 1) % 3]);
-
-
-						PxVec3 adjNormal;
-						adjTri.denormalizedNormal(adjNormal);
 						PxU32 otherIndex = nextInd[a];
 						PxF32 projD = adjNormal.dot(currentTriangle.verts[otherIndex] - adjTri.verts[0]);
 
@@ -188,14 +199,39 @@ public:
 						triFlags |= (1 << a); //Mark as silhouette edge
 				}
 
-				cache.addTriangle(currentTriangle.verts, vertIndices, triangleIndex, triFlags);
+				if(cache.isFull())
+				{
+					(static_cast<Derived*>(this))->template processTriangleCache< CacheSize >(cache);
+					cache.mNumTriangles = 0;
+				}
+				cache.addTriangle(currentTriangle.verts, vertIndices[i], indices[i], triFlags);
 			}
 			PX_ASSERT(cache.mNumTriangles <= 16);
 
-			(static_cast<Derived*>(this))->template processTriangleCache< CacheSize >(cache);
+			if(cache.mNumTriangles)
+				(static_cast<Derived*>(this))->template processTriangleCache< CacheSize >(cache);
+
+			nb -= nbBatch;
+			indices += nbBatch;
 		}
 		return true;
 	}	
+
+	//This function returns the position of triangleIndex in the sorted array of reported triangles, or 0xFFFFFFFF if it isn't part of the batch
+	static PX_FORCE_INLINE PxU32 findTriangle(const PxU32* PX_RESTRICT indices, PxU32 nb, PxU32 triangleIndex)
+	{
+		PxU32 low = 0;
+		PxU32 high = nb;
+		while(low < high)
+		{
+			const PxU32 mid = (low + high) >> 1;
+			if(indices[mid] < triangleIndex)
+				low = mid + 1;
+			else
+				high = mid;
+		}
+		return (low < nb && indices[low] == triangleIndex) ? low : 0xFFFFFFFF;
+	}
 protected:
 	PCMHeightfieldContactGenerationCallback& operator=(const PCMHeightfieldContactGenerationCallback&);
 };
@@ -153,7 +153,7 @@ namespace Gu
 		dst->mFacesByEdges		= src->getFacesByEdges8();
 		dst->mVerticesByEdges   = src->getVerticesByEdges16();
 
-		dst->mBigData			= src->mBigConvexRawData;
+		dst->mBigData			= getBigConvexRawData(*src);
 
 		dst->mInternal			= src->mInternal;
 	}
@@ -171,7 +171,7 @@ namespace Gu
 		dst->mFacesByEdges		= src->getFacesByEdges8();
 		dst->mVerticesByEdges   = src->getVerticesByEdges16();
 
-		dst->mBigData			= src->mBigConvexRawData;
+		dst->mBigData			= getBigConvexRawData(*src);
 		dst->mInternal			= src->mInternal;
 	}
 
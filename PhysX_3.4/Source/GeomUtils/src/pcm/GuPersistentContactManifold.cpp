@@ -2375,10 +2375,22 @@ void physx::Gu::MultiplePersistentContactManifold::fromBuffer(PxU8* PX_RESTRICT
 			}
 			buff += sizeof(Gu::CachedMeshPersistentContact) * numContacts;
 		}
+
+		mNumCachedTriangles = header->mNumCachedTriangles;
+		PX_ASSERT(mNumCachedTriangles <= GU_MAX_CACHED_TRIANGLES);
+		if(mNumCachedTriangles)
+		{
+			PX_ASSERT((uintptr_t(buff) & 0xf) == 0);
+			const TriangleCacheHeader* PX_RESTRICT triHeader = reinterpret_cast<const TriangleCacheHeader*>(buff);
+			buff += sizeof(TriangleCacheHeader);
+			mCachedTriangleBounds = triHeader->mBounds;
+			PxMemCopy(mCachedTriangles, buff, sizeof(PxU32) * mNumCachedTriangles);
+		}
 	}
 	else
 	{
 		mRelativeTransform.Invalidate();
+		mNumCachedTriangles = 0;
 	}
 	mNumManifolds = PxU8(numManifolds);
 	for(PxU32 a = numManifolds; a < GU_MAX_MANIFOLD_SIZE; ++a)
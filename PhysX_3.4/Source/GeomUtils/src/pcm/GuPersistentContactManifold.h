@@ -33,6 +33,7 @@
 #include "PxPhysXCommonConfig.h"
 #include "foundation/PxUnionCast.h"
 #include "foundation/PxMemory.h"
+#include "foundation/PxBounds3.h"
 #include "CmPhysXCommon.h"
 #include "PsVecTransform.h"
 
@@ -51,6 +52,8 @@ namespace physx
 #define GU_CAPSULE_MANIFOLD_CACHE_SIZE 3
 #define GU_MAX_MANIFOLD_SIZE 6
 #define GU_MESH_CONTACT_REDUCTION_THRESHOLD	16
+//This is the maximum number of triangles the convex vs mesh contact gen keeps in the multiple manifold between frames
+#define GU_MAX_CACHED_TRIANGLES 128
 
 #define GU_MANIFOLD_INVALID_INDEX	0xffffffff
 
@@ -305,6 +308,24 @@ public:
 		clearManifold();
 	}
 
+	//This function returns the normal(in the local space of B) of the deepest contact in the manifold. It is used to warm start EPA with the
+	//previous frame's MTD. Returns false if the manifold is empty
+	PX_FORCE_INLINE bool getDeepestNormal(Ps::aos::Vec3V& normal) const
+	{
+		using namespace Ps::aos;
+		if(mNumContacts == 0)
+			return false;
+
+		Vec4V deepest = mContactPoints[0].mLocalNormalPen;
+		for(PxU32 i = 1; i < mNumContacts; ++i)
+		{
+			const Vec4V localNormalPen = mContactPoints[i].mLocalNormalPen;
+			deepest = V4Sel(FIsGrtr(V4GetW(deepest), V4GetW(localNormalPen)), localNormalPen, deepest);
+		}
+		normal = Vec3V_From_Vec4V(deepest);
+		return true;
+	}
+
 	//This function is used to replace the existing contact with the newly created contact if their distance are within some threshold
 	bool replaceManifoldPoint(const Ps::aos::Vec3VArg localPointA, const Ps::aos::Vec3VArg localPointB, const Ps::aos::Vec4VArg localNormalPen, const Ps::aos::FloatVArg replaceBreakingThreshold);
 
@@ -482,7 +503,14 @@ struct MultiPersistentManifoldHeader
 {
 	Ps::aos::PsTransformV mRelativeTransform;//aToB
 	PxU32 mNumManifolds;
-	PxU32 pad[3];
+	PxU32 mNumCachedTriangles;//if not zero, a TriangleCacheHeader and the triangle indices follow the manifolds
+	PxU32 pad[2];
+};
+
+struct TriangleCacheHeader
+{
+	PxBounds3 mBounds;//the inflated volume the triangles have been queried with, in mesh vertex space
+	PxU32 pad[2];
 };
 
 struct SingleManifoldHeader
@@ -500,7 +528,7 @@ PX_ALIGN_PREFIX(16)
 class PX_PHYSX_COMMON_API MultiplePersistentContactManifold
 {
 public:
-	MultiplePersistentContactManifold():mNumManifolds(0), mNumTotalContacts(0)
+	MultiplePersistentContactManifold():mNumManifolds(0), mNumTotalContacts(0), mNumCachedTriangles(0)
 	{
 		mRelativeTransform.Invalidate();
 	}
@@ -666,6 +694,7 @@ public:
 	{
 		mNumManifolds = 0;
 		mNumTotalContacts = 0;
+		mNumCachedTriangles = 0;
 		mRelativeTransform.Invalidate();
 		for(PxU8 i=0; i<GU_MAX_MANIFOLD_SIZE; ++i)
 		{
@@ -707,9 +736,35 @@ public:
 	bool addManifoldContactsToContactBuffer(Gu::ContactBuffer& contactBuffer, const Ps::aos::PsTransformV& trA, const Ps::aos::PsTransformV& trB, const Ps::aos::FloatVArg radius);
 	void drawManifold(Cm::RenderOutput& out, const Ps::aos::PsTransformV& trA, const Ps::aos::PsTransformV& trB);
 
+	//This is used in the convex vs mesh contact gen to decide whether the cached triangles still cover the hull bounds(in mesh vertex space)
+	PX_FORCE_INLINE bool isTriangleCacheValid(const PxBounds3& hullBounds) const
+	{
+		return mNumCachedTriangles != 0 && hullBounds.isInside(mCachedTriangleBounds);
+	}
+
+	PX_FORCE_INLINE void setTriangleCache(const PxBounds3& bounds, const PxU32 numTriangles)
+	{
+		PX_ASSERT(numTriangles <= GU_MAX_CACHED_TRIANGLES);
+		mCachedTriangleBounds = bounds;
+		mNumCachedTriangles = numTriangles;
+	}
+
+	PX_FORCE_INLINE void invalidateTriangleCache()
+	{
+		mNumCachedTriangles = 0;
+	}
+
 	//Code to load from a buffer and store to a buffer.
 	void fromBuffer(PxU8*  PX_RESTRICT buffer);
 	void toBuffer(PxU8*  PX_RESTRICT buffer);
+	//This returns the size of the buffer toBuffer writes into
+	PX_FORCE_INLINE PxU32 getBufferSize() const
+	{
+		PxU32 size = sizeof(MultiPersistentManifoldHeader) + mNumManifolds * sizeof(SingleManifoldHeader) + mNumTotalContacts * sizeof(CachedMeshPersistentContact);
+		if(mNumCachedTriangles)
+			size += sizeof(TriangleCacheHeader) + ((mNumCachedTriangles * sizeof(PxU32) + 15) & ~15);
+		return size;
+	}
 
 	static void drawLine(Cm::RenderOutput& out, const Ps::aos::Vec3VArg p0, const Ps::aos::Vec3VArg p1, const PxU32 color = 0xff00ffff);
 	static void drawLine(Cm::RenderOutput& out, const PxVec3 p0, const PxVec3 p1, const PxU32 color = 0xff00ffff);
@@ -722,7 +777,10 @@ public:
 	PxU8 mNumManifolds;
 	PxU8 mNumTotalContacts;
 	SinglePersistentContactManifold mManifolds[GU_MAX_MANIFOLD_SIZE];
-	
+	//the triangles overlapping mCachedTriangleBounds, re-used by the convex vs mesh contact gen until the hull leaves those bounds
+	PxBounds3 mCachedTriangleBounds;
+	PxU32 mNumCachedTriangles;
+	PxU32 mCachedTriangles[GU_MAX_CACHED_TRIANGLES];
 	
 } PX_ALIGN_SUFFIX(16);
 
@@ -837,6 +895,16 @@ PX_INLINE void MultiplePersistentContactManifold::toBuffer(PxU8*  PX_RESTRICT bu
 		}
 		buff += sizeof(CachedMeshPersistentContact) * manifold.mNumContacts;
 	}
+
+	header->mNumCachedTriangles = mNumCachedTriangles;
+	if(mNumCachedTriangles)
+	{
+		PX_ASSERT((uintptr_t(buff) & 0xf) == 0);
+		TriangleCacheHeader* triHeader = reinterpret_cast<TriangleCacheHeader*>(buff);
+		buff += sizeof(TriangleCacheHeader);
+		triHeader->mBounds = mCachedTriangleBounds;
+		PxMemCopy(buff, mCachedTriangles, sizeof(PxU32) * mNumCachedTriangles);
+	}
 }
 
 #define PX_CP_TO_PCP(contactPoint)				(reinterpret_cast<PersistentContact*>(contactPoint)) //this is used in the normal pcm contact gen
@@ -192,8 +192,20 @@ bool Gu::sweepCapsuleTriangles_Precise(	PxU32 nbTris, const PxTriangle* PX_RESTR
 	CapsuleTriangleOverlapData params;
 	params.init(capsule);
 
+	// Radii of the capsule projected on the sweep axis, and of its bounding sphere, for the 4-wide culling
+	const PxReal dirRadius = radius + PxAbs(extrusionDir.dot(unitDir));
+	const PxReal boundsRadius = radius + halfHeight;
+	PxU32 cullMask = 0;
+
 	for(PxU32 ii=0; ii<nbTris; ii++)	// We need i for returned triangle index
 	{
+		// Cull the source triangles 4 by 4 before extruding them, using the best distance found so far. Single
+		// triangle queries, e.g. from the midphase callbacks, skip this.
+		if(!(ii&3))
+			cullMask = nbTris<4 ? 15 : cullTriangles4(triangles, nbTris, ii, initIndex, capsuleCenter, unitDir, curT, dirRadius, boundsRadius, dpc0);
+		if(!(cullMask & (1<<(ii&3))))
+			continue;
+
 		const PxU32 i = getTriangleIndex(ii, initIndex);
 
 		const PxTriangle& currentSrcTri = triangles[i];	// PT: src tri, i.e. non-extruded
@@ -35,6 +35,7 @@
 #include "GuInternal.h"
 #include "PxTriangle.h"
 #include "PxQueryReport.h"
+#include "PsVecMath.h"
 
 namespace physx
 {
@@ -133,6 +134,70 @@ namespace Gu
 		return true;
 	}
 
+	// Conservative culling of 4 triangles at a time, for the sweeps against arrays of triangles. Triangles are processed in
+	// the order defined by getTriangleIndex, starting from 'ii'. The swept shape moves from 'center' along 'dir' over 't'.
+	// 'dirRadius' is the radius of its projection on 'dir', and 'boundsRadius' the radius of a sphere enclosing it.
+	// A triangle is rejected when it is fully in front of or behind the swept shape along 'dir' (as in cullTriangle), or
+	// when its bounds do not touch the bounds of the swept sphere. Returns a 4-bit mask of the triangles to keep.
+	PX_FORCE_INLINE PxU32 cullTriangles4(	const PxTriangle* PX_RESTRICT triangles, PxU32 nbTris, PxU32 ii, PxU32 initIndex,
+											const PxVec3& center, const PxVec3& dir, PxReal t, PxReal dirRadius, PxReal boundsRadius, const PxReal dpc0)
+	{
+		using namespace Ps::aos;
+
+		// Gather the triangles. Missing ones at the end of the array are replaced with the last one.
+		const PxVec3* PX_RESTRICT v[4];
+		for(PxU32 j=0;j<4;j++)
+			v[j] = triangles[getTriangleIndex(PxMin(ii+j, nbTris-1), initIndex)].verts;
+
+		Vec4V minX, minY, minZ, maxX, maxY, maxZ, dpMin, dpMax;
+		{
+			const Vec4V dirX = V4Load(dir.x);
+			const Vec4V dirY = V4Load(dir.y);
+			const Vec4V dirZ = V4Load(dir.z);
+			for(PxU32 k=0;k<3;k++)
+			{
+				const Vec4V x = V4LoadXYZW(v[0][k].x, v[1][k].x, v[2][k].x, v[3][k].x);
+				const Vec4V y = V4LoadXYZW(v[0][k].y, v[1][k].y, v[2][k].y, v[3][k].y);
+				const Vec4V z = V4LoadXYZW(v[0][k].z, v[1][k].z, v[2][k].z, v[3][k].z);
+				// Project vertices on sweep axis
+				const Vec4V dp = V4MulAdd(z, dirZ, V4MulAdd(y, dirY, V4Mul(x, dirX)));
+				if(!k)
+				{
+					minX = maxX = x;
+					minY = maxY = y;
+					minZ = maxZ = z;
+					dpMin = dpMax = dp;
+				}
+				else
+				{
+					minX = V4Min(minX, x);	maxX = V4Max(maxX, x);
+					minY = V4Min(minY, y);	maxY = V4Max(maxY, y);
+					minZ = V4Min(minZ, z);	maxZ = V4Max(maxZ, z);
+					dpMin = V4Min(dpMin, dp);
+					dpMax = V4Max(dpMax, dp);
+				}
+			}
+		}
+
+		// Same epsilons as in cullTriangle, to keep triangles that are about as close as best current distance
+		const PxReal epsilon = 0.001f + GU_EPSILON_SAME_DISTANCE;
+		dirRadius += epsilon;
+		boundsRadius += epsilon;
+
+		BoolV reject = BOr(	V4IsGrtr(dpMin, V4Load(dpc0 + t + dirRadius)),
+							V4IsGrtr(V4Load(dpc0 - dirRadius), dpMax));
+
+		// Bounds of the swept sphere
+		const PxVec3 end = center + dir * t;
+		const PxVec3 sweptMin = center.minimum(end) - PxVec3(boundsRadius);
+		const PxVec3 sweptMax = center.maximum(end) + PxVec3(boundsRadius);
+		reject = BOr(reject, BOr(V4IsGrtr(minX, V4Load(sweptMax.x)), V4IsGrtr(V4Load(sweptMin.x), maxX)));
+		reject = BOr(reject, BOr(V4IsGrtr(minY, V4Load(sweptMax.y)), V4IsGrtr(V4Load(sweptMin.y), maxY)));
+		reject = BOr(reject, BOr(V4IsGrtr(minZ, V4Load(sweptMax.z)), V4IsGrtr(V4Load(sweptMin.z), maxZ)));
+
+		return ~BGetBitMask(reject) & 15;
+	}
+
 	// PT: computes distance between a point 'point' and a segment. The segment is defined as a starting point 'p0'
 	// and a direction vector 'dir' plus a length 't'. Segment's endpoint is p0 + dir * t.
 	//
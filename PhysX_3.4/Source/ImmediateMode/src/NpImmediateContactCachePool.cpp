@@ -0,0 +1,246 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#include "PxImmediateMode.h"
+#include "CmPhysXCommon.h"
+#include "PsArray.h"
+#include "PsMutex.h"
+#include "PsUserAllocated.h"
+
+using namespace physx;
+using namespace immediate;
+
+namespace
+{
+	// Same block size as the scene's narrow phase cache streams (PXC_NPCACHE_BLOCK_SIZE)
+	static const PxU32 CACHE_BLOCK_SIZE = 16384;
+
+	static const PxU32 INVALID_FRAME = 0xffffffff;
+
+	class ContactCachePool;
+
+	// Per-thread allocator carving cache data out of pool blocks, one block list per frame parity
+	class CacheStream : public PxCacheAllocator
+	{
+	public:
+		CacheStream() : mPool(NULL), mBlock(NULL), mUsed(CACHE_BLOCK_SIZE), mParity(0)
+		{
+		}
+
+		virtual PxU8* allocateCacheData(const PxU32 byteSize);
+
+		ContactCachePool*	mPool;
+		PxU8*				mBlock;
+		PxU32				mUsed;
+		PxU32				mParity;
+		Ps::Array<PxU8*>	mBlocks[2];
+		Ps::Array<PxU8*>	mLargeAllocations[2];	// requests that don't fit in a block
+	};
+
+	// Forwards the contacts of a single pair with its index in the caller's arrays
+	class PairRecorder : public PxContactRecorder
+	{
+	public:
+		PairRecorder(PxContactRecorder& recorder, const PxU32 index) : mRecorder(recorder), mIndex(index)
+		{
+		}
+
+		virtual bool recordContacts(const Gu::ContactPoint* contactPoints, const PxU32 nbContacts, const PxU32 index)
+		{
+			PX_UNUSED(index);
+			return mRecorder.recordContacts(contactPoints, nbContacts, mIndex);
+		}
+
+	private:
+		PxContactRecorder&	mRecorder;
+		const PxU32			mIndex;
+
+		PairRecorder& operator=(const PairRecorder&);
+	};
+
+	class ContactCachePool : public PxContactCachePool, public Ps::UserAllocated
+	{
+	public:
+		ContactCachePool(const PxU32 nbStreams) : mNbBlocks(0), mFrame(0)
+		{
+			mStreams.resize(PxMax(nbStreams, 1u));
+			for(PxU32 i = 0; i < mStreams.size(); ++i)
+				mStreams[i].mPool = this;
+		}
+
+		virtual ~ContactCachePool()
+		{
+			for(PxU32 i = 0; i < mStreams.size(); ++i)
+			{
+				recycle(mStreams[i], 0);
+				recycle(mStreams[i], 1);
+			}
+
+			PX_ASSERT(mFreeBlocks.size() == mNbBlocks);
+			for(PxU32 i = 0; i < mFreeBlocks.size(); ++i)
+				PX_FREE(mFreeBlocks[i]);
+		}
+
+		virtual void setNbPairs(const PxU32 nbPairs)
+		{
+			mCaches.resize(nbPairs, PxCache());
+			mFrames.resize(nbPairs, INVALID_FRAME);
+		}
+
+		virtual PxU32 getNbPairs() const
+		{
+			return mCaches.size();
+		}
+
+		virtual void beginFrame()
+		{
+			mFrame++;
+
+			// Data written two frames ago goes back to the pool...
+			const PxU32 parity = mFrame & 1;
+			for(PxU32 i = 0; i < mStreams.size(); ++i)
+			{
+				CacheStream& stream = mStreams[i];
+				recycle(stream, parity);
+				stream.mParity = parity;
+				stream.mBlock = NULL;
+				stream.mUsed = CACHE_BLOCK_SIZE;
+			}
+
+			// ...so caches that weren't refreshed last frame must no longer reference it
+			for(PxU32 i = 0; i < mCaches.size(); ++i)
+			{
+				if(mCaches[i].mCachedData && mFrames[i] + 1 != mFrame)
+					mCaches[i] = PxCache();
+			}
+		}
+
+		virtual bool generateContacts(const PxU32* pairIds, const PxGeometry* const * geom0, const PxGeometry* const * geom1, const PxTransform* pose0, const PxTransform* pose1, const PxU32 nbPairs,
+			PxContactRecorder& contactRecorder, const PxReal contactDistance, const PxReal meshContactMargin, const PxReal toleranceLength, const PxU32 streamIndex)
+		{
+			PX_ASSERT(streamIndex < mStreams.size());
+			CacheStream& stream = mStreams[streamIndex];
+
+			bool success = true;
+			for(PxU32 i = 0; i < nbPairs; ++i)
+			{
+				const PxU32 pairId = pairIds[i];
+				PX_ASSERT(pairId < mCaches.size());
+
+				PairRecorder recorder(contactRecorder, i);
+				success &= PxGenerateContacts(geom0 + i, geom1 + i, pose0 + i, pose1 + i, &mCaches[pairId], 1, recorder, contactDistance, meshContactMargin, toleranceLength, stream);
+				mFrames[pairId] = mFrame;
+			}
+			return success;
+		}
+
+		virtual void resetPair(const PxU32 pairId)
+		{
+			PX_ASSERT(pairId < mCaches.size());
+			mCaches[pairId] = PxCache();
+			mFrames[pairId] = INVALID_FRAME;
+		}
+
+		virtual PxU32 getNbBlocks() const
+		{
+			return mNbBlocks;
+		}
+
+		virtual PxU32 getNbUsedBlocks() const
+		{
+			return mNbBlocks - mFreeBlocks.size();
+		}
+
+		virtual void release()
+		{
+			PX_DELETE(this);
+		}
+
+		PxU8* acquireBlock()
+		{
+			Ps::Mutex::ScopedLock lock(mMutex);
+			if(mFreeBlocks.size())
+				return mFreeBlocks.popBack();
+
+			mNbBlocks++;
+			return reinterpret_cast<PxU8*>(PX_ALLOC(CACHE_BLOCK_SIZE, "ContactCacheBlock"));
+		}
+
+	private:
+		void recycle(CacheStream& stream, const PxU32 parity)
+		{
+			Ps::Array<PxU8*>& blocks = stream.mBlocks[parity];
+			for(PxU32 i = 0; i < blocks.size(); ++i)
+				mFreeBlocks.pushBack(blocks[i]);
+			blocks.clear();
+
+			Ps::Array<PxU8*>& largeAllocations = stream.mLargeAllocations[parity];
+			for(PxU32 i = 0; i < largeAllocations.size(); ++i)
+				PX_FREE(largeAllocations[i]);
+			largeAllocations.clear();
+		}
+
+		Ps::Array<PxCache>		mCaches;
+		Ps::Array<PxU32>		mFrames;		// last frame each pair's cache was written
+		Ps::Array<CacheStream>	mStreams;
+		Ps::Array<PxU8*>		mFreeBlocks;
+		PxU32					mNbBlocks;
+		PxU32					mFrame;
+		Ps::Mutex				mMutex;
+	};
+
+	PxU8* CacheStream::allocateCacheData(const PxU32 byteSize)
+	{
+		const PxU32 size = (byteSize + 15) & ~15;
+
+		if(size > CACHE_BLOCK_SIZE)
+		{
+			PxU8* data = reinterpret_cast<PxU8*>(PX_ALLOC(size, "ContactCacheLargeData"));
+			mLargeAllocations[mParity].pushBack(data);
+			return data;
+		}
+
+		if(mUsed + size > CACHE_BLOCK_SIZE)
+		{
+			mBlock = mPool->acquireBlock();
+			mBlocks[mParity].pushBack(mBlock);
+			mUsed = 0;
+		}
+
+		PxU8* data = mBlock + mUsed;
+		mUsed += size;
+		return data;
+	}
+}
+
+PxContactCachePool* immediate::PxCreateContactCachePool(const PxU32 nbStreams)
+{
+	return PX_NEW(ContactCachePool)(nbStreams);
+}
@@ -702,9 +702,7 @@ namespace physx
 				//Do collision detection, then write manifold out...
 				g_PCMContactMethodTable[type0][type1](geomUnion0, geomUnion1, transform0, transform1, params, cache, contactBuffer, NULL);
 
-				const PxU32 size = (sizeof(Gu::MultiPersistentManifoldHeader) +
-					multiManifold.mNumManifolds * sizeof(Gu::SingleManifoldHeader) +
-					multiManifold.mNumTotalContacts * sizeof(Gu::CachedMeshPersistentContact));
+				const PxU32 size = multiManifold.getBufferSize();
 
 				PxU8* buffer = allocator.allocateCacheData(size);
 
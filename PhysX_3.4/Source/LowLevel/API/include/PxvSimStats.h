@@ -35,6 +35,7 @@
 #include "foundation/PxMemory.h"
 #include "CmPhysXCommon.h"
 #include "PxGeometry.h"
+#include "PxSimulationStatistics.h"
 
 namespace physx
 {
@@ -100,6 +101,9 @@ struct PxvSimStats
 	PxU32	mTotalConstraintSize;
 	PxU32	mPeakConstraintBlockAllocations;
 
+	PxU32	mNbNpMemBlockAcquires;				// 16K blocks taken by the narrow phase contact and cache streams
+	PxU32	mNbNpMemBlockPoolRefills;			// times those streams had to lock the block pool, i.e. the thread-local cache was empty or full
+
 	PxU32	mNbNewPairs;
 	PxU32	mNbLostPairs;
 
@@ -107,6 +111,9 @@ struct PxvSimStats
 	PxU32	mNbLostTouches;
 
 	PxU32	mNbPartitions;
+
+	PxU32	mNbIslandsPerPositionIterations[PxSimulationStatistics::eSOLVER_ITERATION_HISTOGRAM_SIZE];
+	PxU32	mNbIslandsPerVelocityIterations[PxSimulationStatistics::eSOLVER_ITERATION_HISTOGRAM_SIZE];
 };
 
 }
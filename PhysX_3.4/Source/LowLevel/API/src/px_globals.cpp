@@ -89,12 +89,18 @@ void PxvRegisterLegacyHeightFields()
 	gUnifiedHeightfieldCollision = false;
 }
 
+namespace Dy
+{
+	void SolverCoreRegisterFmaFns();
+}
+
 void PxvInit(const PxvOffsetTable& offsetTable)
 {
 #if PX_SUPPORT_GPU_PHYSX
 	gPxPhysXGpu = NULL;
 #endif
 	gPxvOffsetTable = offsetTable;
+	Dy::SolverCoreRegisterFmaFns();
 }
 
 void PxvTerm()
@@ -117,6 +117,7 @@ class PxcContactBlockStream
 public:
 	PxcContactBlockStream(PxcNpMemBlockPool & blockPool):
 		mBlockPool(blockPool),
+		mBlockCache(blockPool, PxcNpMemBlockPool::eCONTACT_STREAM),
 		mBlock(NULL),
 		mUsed(0)
 	{
@@ -133,7 +134,7 @@ public:
 
 											if(mBlock == NULL || size+mUsed>PxcNpMemBlock::SIZE)
 											{
-												mBlock = mBlockPool.acquireContactBlock();
+												mBlock = mBlockCache.acquire();
 												PX_ASSERT(0==mBlock || mBlock->data == reinterpret_cast<PxU8*>(mBlock));
 												mUsed = size;
 												return reinterpret_cast<PxU8*>(mBlock);
@@ -148,6 +149,7 @@ public:
 										{
 											mBlock = NULL;
 											mUsed = 0;
+											mBlockCache.flush();
 										}
 
 	PX_FORCE_INLINE PxcNpMemBlockPool&	getMemBlockPool()
@@ -155,8 +157,14 @@ public:
 		return mBlockPool;
 	}
 
+	PX_FORCE_INLINE PxcNpMemBlockCache&	getMemBlockCache()
+	{
+		return mBlockCache;
+	}
+
 private:
 			PxcNpMemBlockPool&			mBlockPool;
+			PxcNpMemBlockCache			mBlockCache;	// per-thread cache of contact blocks
 			PxcNpMemBlock*				mBlock;	// current constraint block
 			PxU32						mUsed;	// number of bytes used in constraint block
 };
@@ -44,6 +44,7 @@ struct PxsContactManagerOutput;
 namespace Gu
 {
 	struct Cache;
+	struct ContactPoint;
 }
 
 namespace Cm
@@ -60,6 +61,12 @@ namespace Gu
 
 void PxcDiscreteNarrowPhase(PxcNpThreadContext& context, const PxcNpWorkUnit& cmInput, Gu::Cache& cache, PxsContactManagerOutput& output);
 void PxcDiscreteNarrowPhasePCM(PxcNpThreadContext& context, const PxcNpWorkUnit& cmInput, Gu::Cache& cache, PxsContactManagerOutput& output);
+
+// Split version of the discrete narrow phase, for contacts generated outside the SDK. The first function returns false when
+// no new contacts are needed, in which case the last contacts have already been kept. Otherwise it sets the contact distance
+// of the pair in context.mNarrowPhaseParams, and the second function must be called later with the new contacts.
+bool PxcDiscreteNarrowPhaseMustGenerateContacts(PxcNpThreadContext& context, const PxcNpWorkUnit& cmInput, Gu::Cache& cache, PxsContactManagerOutput& output);
+void PxcDiscreteNarrowPhaseFinish(PxcNpThreadContext& context, const PxcNpWorkUnit& cmInput, PxsContactManagerOutput& output, const Gu::ContactPoint* contacts, PxU32 nbContacts);
 }
 
 #endif
@@ -50,8 +50,11 @@ public:
 	// reserve can fail and return null.
 	PxU8*					reserve(PxU32 byteCount);
 	void					reset();
+
+	PX_FORCE_INLINE	PxcNpMemBlockCache&	getMemBlockCache()	{ return mBlockCache;	}
 private:
 	PxcNpMemBlockPool&	mBlockPool;
+	PxcNpMemBlockCache	mBlockCache;	// per-thread cache of NP cache blocks
 	PxcNpMemBlock*		mBlock;
 	PxU32				mUsed;
 private:
@@ -49,10 +49,21 @@ struct PxcNpMemBlock
 
 typedef Ps::Array<PxcNpMemBlock*> PxcNpMemBlockArray;
 
+#define PXC_NP_MEM_BLOCK_CACHE_SIZE	8
+
+class PxcNpMemBlockCache;
+
 class PxcNpMemBlockPool
 {
 	PX_NOCOPY(PxcNpMemBlockPool)
 public:
+	// streams that can be fed through a PxcNpMemBlockCache
+	enum CachedStream
+	{
+		eCONTACT_STREAM,
+		eNP_CACHE_STREAM
+	};
+
 	PxcNpMemBlockPool(PxcScratchAllocator& allocator);
 	~PxcNpMemBlockPool();
 
@@ -80,6 +91,10 @@ public:
 	void			swapNpCacheStreams();
 
 	void			flushUnused();
+
+	// slow paths of PxcNpMemBlockCache. They take the pool lock once for a whole batch of blocks.
+	PxcNpMemBlock*	refillCache(PxcNpMemBlockCache& cache);
+	void			flushCache(PxcNpMemBlockCache& cache, bool releaseFreeBlocks);
 	
 private:
 
@@ -111,9 +126,61 @@ private:
 	PxU32					mConstraintAllocations;
 
 	PxcNpMemBlock*	acquire(PxcNpMemBlockArray& trackingArray, PxU32* allocationCount = NULL, PxU32* peakAllocationCount = NULL, bool isScratchAllocation = false);
+	PxcNpMemBlock*	acquireBlockLocked(bool allowAllocation);
+	PxcNpMemBlockArray&	getCachedStreamArray(CachedStream stream);
 	void			release(PxcNpMemBlockArray& deadArray, PxU32* allocationCount = NULL);
 };
 
+// Per-thread cache of blocks for the contact and NP cache streams. Blocks are taken from the pool in batches and the blocks handed
+// out are only reported to the pool's tracking arrays when the cache is flushed or refilled, so the pool lock is taken once per
+// batch instead of once per block. The thread context flushes its caches when it is reset.
+class PxcNpMemBlockCache
+{
+	PX_NOCOPY(PxcNpMemBlockCache)
+public:
+	PxcNpMemBlockCache(PxcNpMemBlockPool& blockPool, PxcNpMemBlockPool::CachedStream stream) :
+		mBlockPool(blockPool), mStream(stream), mNbFree(0), mNbUsed(0), mNbAcquires(0), mNbRefills(0)
+	{
+	}
+
+	~PxcNpMemBlockCache()
+	{
+		mBlockPool.flushCache(*this, true);
+	}
+
+	PX_FORCE_INLINE	PxcNpMemBlock*	acquire()
+	{
+		mNbAcquires++;
+		if(mNbFree && mNbUsed<PXC_NP_MEM_BLOCK_CACHE_SIZE)
+		{
+			PxcNpMemBlock* block = mFree[--mNbFree];
+			mUsed[mNbUsed++] = block;
+			return block;
+		}
+		mNbRefills++;
+		return mBlockPool.refillCache(*this);
+	}
+
+	PX_FORCE_INLINE	void			flush()					{ if(mNbUsed) mBlockPool.flushCache(*this, false);	}
+
+	// stats: number of blocks handed out, and number of times the pool lock had to be taken to do so
+	PX_FORCE_INLINE	PxU32			getNbAcquires()	const	{ return mNbAcquires;	}
+	PX_FORCE_INLINE	PxU32			getNbRefills()	const	{ return mNbRefills;	}
+	PX_FORCE_INLINE	void			clearStats()			{ mNbAcquires = mNbRefills = 0;	}
+
+private:
+	PxcNpMemBlockPool&					mBlockPool;
+	const PxcNpMemBlockPool::CachedStream	mStream;
+	PxcNpMemBlock*						mFree[PXC_NP_MEM_BLOCK_CACHE_SIZE];	// blocks owned by the cache, not handed out yet
+	PxcNpMemBlock*						mUsed[PXC_NP_MEM_BLOCK_CACHE_SIZE];	// blocks handed out, not in the pool's tracking array yet
+	PxU32								mNbFree;
+	PxU32								mNbUsed;
+	PxU32								mNbAcquires;
+	PxU32								mNbRefills;
+
+	friend class PxcNpMemBlockPool;
+};
+
 }
 
 #endif
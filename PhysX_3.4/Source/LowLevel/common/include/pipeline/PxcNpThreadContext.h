@@ -40,6 +40,7 @@
 #include "PxvContext.h"
 #include "PxcThreadCoherentCache.h"
 #include "CmBitMap.h"
+#include "PsAtomic.h"
 #include "../pcm/GuPersistentContactManifold.h"
 
 namespace physx
@@ -87,7 +88,8 @@ struct PxcNpContext
 													mContactStreamPool		(NULL),
 													mPatchStreamPool		(NULL),
 													mForceAndIndiceStreamPool(NULL),
-													mMaterialManager		(NULL)
+													mMaterialManager		(NULL),
+													mNbThreadContexts		(0)
 												{
 												}
 
@@ -102,6 +104,7 @@ struct PxcNpContext
 					PxcDataStreamPool*			mForceAndIndiceStreamPool;
 					PxcDataStreamPool*			mConstraintWriteBackStreamPool;
 					PxsMaterialManager*			mMaterialManager;
+					volatile PxI32				mNbThreadContexts;	// number of thread contexts created so far, used to hand out thread context indices
 
 	PX_FORCE_INLINE	PxReal						getToleranceLength()		const	{ return mToleranceLength;					}
 	PX_FORCE_INLINE	void						setToleranceLength(PxReal x)		{ mToleranceLength = x;						}
@@ -144,6 +147,10 @@ public:
 
 	PX_FORCE_INLINE Cm::BitMap&					getLocalPatchChangeMap()						{ return mLocalPatchCountChange;			}
 
+	// Unique per thread context and smaller than the number of contexts in the pool. A context is used by one thread at a time,
+	// so the index can be used to address per-thread scratch data.
+	PX_FORCE_INLINE PxU32						getThreadIndex()						const	{ return mThreadIndex;						}
+
 	void										reset(PxU32 cmCount);
 	// debugging
 					Cm::RenderOutput 			mRenderOutput;
@@ -177,6 +184,9 @@ public:
 					bool						mContactCache;
 					bool						mCreateContactStream;	// flag to enforce that contacts are stored persistently per workunit. Used for PVD.
 					bool						mCreateAveragePoint;	// flag to enforce whether we create average points
+					bool						mContactReuse;			// flag to enforce whether PCM pairs with a small relative motion reuse their contacts
+					PxReal						mContactReuseLinearThreshold;
+					PxReal						mContactReuseCosHalfAngle;
 #if PX_ENABLE_SIM_STATS
 					PxU32						mCompressedCacheSize;
 					PxU32						mNbDiscreteContactPairsWithCacheHits;
@@ -204,6 +214,7 @@ private:
 					PxU32						mLocalLostTouchCount;
 					PxU32						mLocalFoundPatchCount;
 					PxU32						mLocalLostPatchCount;
+					PxU32						mThreadIndex;
 };
 
 }
@@ -32,10 +32,12 @@
 #define PXC_SCRATCHALLOCATOR_H
 
 #include "foundation/PxAssert.h"
+#include "foundation/PxMath.h"
 #include "PxvConfig.h"
 #include "PsMutex.h"
 #include "PsArray.h"
 #include "PsAllocator.h"
+#include "PsFoundation.h"
 
 namespace physx
 {
@@ -43,7 +45,7 @@ class PxcScratchAllocator
 {
 	PX_NOCOPY(PxcScratchAllocator)
 public:
-	PxcScratchAllocator() : mStack(PX_DEBUG_EXP("PxcScratchAllocator")), mStart(NULL), mSize(0)
+	PxcScratchAllocator() : mStack(PX_DEBUG_EXP("PxcScratchAllocator")), mStart(NULL), mSize(0), mPeakUsage(0), mNbOverflows(0), mOverflowSize(0)
 	{
 		mStack.reserve(64);
 		mStack.pushBack(0);
@@ -61,6 +63,10 @@ public:
 		mStart = reinterpret_cast<PxU8*>(addr);
 		mSize = size;
 		mStack.pushBack(mStart + size);
+
+		mPeakUsage = 0;
+		mNbOverflows = 0;
+		mOverflowSize = 0;
 	}
 
 	void* allocAll(PxU32& size)
@@ -77,7 +83,8 @@ public:
 	}
 
 
-	void* alloc(PxU32 requestedSize, bool fallBackToHeap = false)
+	// file and line identify the call site in the overflow report
+	void* alloc(PxU32 requestedSize, bool fallBackToHeap = false, const char* file = NULL, int line = 0)
 	{
 		requestedSize = (requestedSize+15)&~15;
 
@@ -90,12 +97,22 @@ public:
 		{
 			PxU8* addr = top - requestedSize;
 			mStack.pushBack(addr);
+			mPeakUsage = PxMax(mPeakUsage, PxU32(mStart + mSize - addr));
 			return addr;
 		}
 
 		if(!fallBackToHeap)
 			return NULL;
 
+		// only a user provided block has a budget to overflow
+		if(mSize)
+		{
+			mNbOverflows++;
+			mOverflowSize += requestedSize;
+			if(file)
+				Ps::getFoundation().error(PxErrorCode::ePERF_WARNING, file, line, "Scratch block overflow: %d bytes allocated from the heap.", requestedSize);
+		}
+
 		return PX_ALLOC(requestedSize, "Scratch Block Fallback");
 	}
 
@@ -126,11 +143,19 @@ public:
 		return a>= mStart && a<mStart+mSize;
 	}
 
+	// stats since the last setBlock() call, the block taken by allocAll() is not counted in the peak usage
+	PX_FORCE_INLINE PxU32 getPeakUsage()	const	{ return mPeakUsage;	}
+	PX_FORCE_INLINE PxU32 getNbOverflows()	const	{ return mNbOverflows;	}
+	PX_FORCE_INLINE PxU32 getOverflowSize()	const	{ return mOverflowSize;	}
+
 private:
 	Ps::Mutex			mLock;
 	Ps::Array<PxU8*>	mStack;
 	PxU8*				mStart;
 	PxU32				mSize;
+	PxU32				mPeakUsage;
+	PxU32				mNbOverflows;
+	PxU32				mOverflowSize;
 };
 
 }
@@ -72,11 +72,19 @@ bool physx::PxcGetMaterialHeightField(const PxsShapeCore* shape, const PxU32 ind
 			
 		const Gu::HeightFieldData* hf = hfGeom.heightFieldData;
 		
+		//Consecutive contacts usually come from the same triangle, so only fetch the sample when the face changes.
+		PxU32 lastFaceIndex = 0xffffffff;
+		PxU16 lastMaterialIndex = 0;
 		for(PxU32 i=0; i< contactBuffer.count; ++i)
 		{
 			const Gu::ContactPoint& contact = contactBuffer.contacts[i];
-			const PxU32 localMaterialIndex = GetMaterialIndex(hf, contact.internalFaceIndex1);
-			(&materialInfo[i].mMaterialIndex0)[index] = materialIndices[localMaterialIndex];
+			if(contact.internalFaceIndex1 != lastFaceIndex)
+			{
+				lastFaceIndex = contact.internalFaceIndex1;
+				const PxU32 localMaterialIndex = GetMaterialIndex(hf, lastFaceIndex);
+				lastMaterialIndex = materialIndices[localMaterialIndex];
+			}
+			(&materialInfo[i].mMaterialIndex0)[index] = lastMaterialIndex;
 		}
 	}
 	return true;
@@ -100,15 +108,24 @@ bool physx::PxcGetMaterialShapeHeightField(const PxsShapeCore* shape0, const Pxs
 			
 		const Gu::HeightFieldData* hf = hfGeom.heightFieldData;
 		
+		const PxU16 materialIndex0 = shape0->materialIndex;
+
+		PxU32 lastFaceIndex = 0xffffffff;
+		PxU16 lastMaterialIndex = 0;
 		for(PxU32 i=0; i< contactBuffer.count; ++i)
 		{
 			const Gu::ContactPoint& contact = contactBuffer.contacts[i];
-			materialInfo[i].mMaterialIndex0 = shape0->materialIndex;
+			materialInfo[i].mMaterialIndex0 = materialIndex0;
 			//contact.featureIndex0 = shape0->materialIndex;
-			const PxU32 localMaterialIndex = GetMaterialIndex(hf, contact.internalFaceIndex1);
+			if(contact.internalFaceIndex1 != lastFaceIndex)
+			{
+				lastFaceIndex = contact.internalFaceIndex1;
+				const PxU32 localMaterialIndex = GetMaterialIndex(hf, lastFaceIndex);
+				PX_ASSERT(localMaterialIndex<hfGeom.materials.numIndices);
+				lastMaterialIndex = materialIndices[localMaterialIndex];
+			}
 			//contact.featureIndex1 = materialIndices[localMaterialIndex];
-			PX_ASSERT(localMaterialIndex<hfGeom.materials.numIndices);
-			materialInfo[i].mMaterialIndex1 = materialIndices[localMaterialIndex];
+			materialInfo[i].mMaterialIndex1 = lastMaterialIndex;
 		}
 	}
 	return true;
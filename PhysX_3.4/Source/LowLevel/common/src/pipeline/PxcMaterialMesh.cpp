@@ -58,14 +58,23 @@ bool physx::PxcGetMaterialMesh(const PxsShapeCore* shape, const PxU32 index, Pxc
 	}
 	else
 	{
+		const PxU16* eaMaterialIndices = shapeMesh.materialIndices;
+
+		//Contacts are generated triangle by triangle, so consecutive contacts usually share a face. Only resolve
+		//the material when the face changes.
+		PxU32 lastFaceIndex = 0xffffffff;
+		PxU16 lastMaterialIndex = 0;
 		for(PxU32 i=0; i< contactBuffer.count; ++i)
 		{
 
 			Gu::ContactPoint& contact = contactBuffer.contacts[i];
-			const PxU16* eaMaterialIndices = shapeMesh.materialIndices;
-
-			const PxU32 localMaterialIndex = eaMaterialIndices[contact.internalFaceIndex1];//shapeMesh.triangleMesh->getTriangleMaterialIndex(contact.featureIndex1);
-			(&materialInfo[i].mMaterialIndex0)[index] = shapeMesh.materials.indices[localMaterialIndex];
+			if(contact.internalFaceIndex1 != lastFaceIndex)
+			{
+				lastFaceIndex = contact.internalFaceIndex1;
+				const PxU32 localMaterialIndex = eaMaterialIndices[lastFaceIndex];//shapeMesh.triangleMesh->getTriangleMaterialIndex(contact.featureIndex1);
+				lastMaterialIndex = shapeMesh.materials.indices[localMaterialIndex];
+			}
+			(&materialInfo[i].mMaterialIndex0)[index] = lastMaterialIndex;
 		}
 	}
 	return true;
@@ -87,18 +96,25 @@ bool physx::PxcGetMaterialShapeMesh(const PxsShapeCore* shape0, const PxsShapeCo
 	}
 	else
 	{
+		const PxU16* eaMaterialIndices = shapeMesh.materialIndices;
+		const PxU16 materialIndex0 = shape0->materialIndex;
 
+		PxU32 lastFaceIndex = 0xffffffff;
+		PxU16 lastMaterialIndex = 0;
 		for(PxU32 i=0; i< contactBuffer.count; ++i)
 		{
 
 			Gu::ContactPoint& contact = contactBuffer.contacts[i];
 			//contact.featureIndex0 = shape0->materialIndex;
-			materialInfo[i].mMaterialIndex0 = shape0->materialIndex;
-			const PxU16* eaMaterialIndices = shapeMesh.materialIndices;
-
-			const PxU32 localMaterialIndex = eaMaterialIndices[contact.internalFaceIndex1];//shapeMesh.triangleMesh->getTriangleMaterialIndex(contact.featureIndex1);
+			materialInfo[i].mMaterialIndex0 = materialIndex0;
+			if(contact.internalFaceIndex1 != lastFaceIndex)
+			{
+				lastFaceIndex = contact.internalFaceIndex1;
+				const PxU32 localMaterialIndex = eaMaterialIndices[lastFaceIndex];//shapeMesh.triangleMesh->getTriangleMaterialIndex(contact.featureIndex1);
+				lastMaterialIndex = shapeMesh.materials.indices[localMaterialIndex];
+			}
 			//contact.featureIndex1 = shapeMesh.materials.indices[localMaterialIndex];
-			materialInfo[i].mMaterialIndex1 = shapeMesh.materials.indices[localMaterialIndex];
+			materialInfo[i].mMaterialIndex1 = lastMaterialIndex;
 
 		}
 	}
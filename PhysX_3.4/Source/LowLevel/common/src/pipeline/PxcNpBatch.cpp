@@ -270,6 +270,35 @@ static bool finishContacts(const PxcNpWorkUnit& input, PxsContactManagerOutput&
 	return res;
 }
 
+// PT: tests whether a PCM pair moved so little, relative to the pose stored in its manifold when the contacts were last
+// fully generated, that last step's contacts can be reused without running GJK or refreshing the manifold.
+static PX_FORCE_INLINE bool hasSmallRelativeMotion(const PxcNpThreadContext& context, const Gu::Cache& cache,
+												   const PxsCachedTransform* cachedTransform0, const PxsCachedTransform* cachedTransform1,
+												   const bool flip, const PxGeometryType::Enum minType)
+{
+	using namespace Ps::aos;
+
+	if(!cache.isManifold())
+		return false;
+
+	const PsTransformV& lastRelativeTransform = cache.isMultiManifold() ?
+		reinterpret_cast<const Gu::MultiPersistentManifoldHeader*>(cache.mCachedData)->mRelativeTransform :
+		reinterpret_cast<const Gu::PersistentContactManifold*>(cache.mCachedData)->mRelativeTransform;
+
+	// PT: the contact functions store the pose of the shape with the smaller type relative to the other one, except for planes
+	// which store the pose of the other shape relative to the plane.
+	const bool swapped = flip != (minType == PxGeometryType::ePLANE);
+	const PsTransformV transfA = loadTransformA(swapped ? cachedTransform1->transform : cachedTransform0->transform);
+	const PsTransformV transfB = loadTransformA(swapped ? cachedTransform0->transform : cachedTransform1->transform);
+	const PsTransformV curRTrans(transfB.transformInv(transfA));
+
+	const Vec3V deltaP = V3Sub(curRTrans.p, lastRelativeTransform.p);
+	const FloatV linearThreshold = FLoad(context.mContactReuseLinearThreshold);
+	const BoolV smallTranslation = FIsGrtrOrEq(FMul(linearThreshold, linearThreshold), V3Dot(deltaP, deltaP));
+	const BoolV smallRotation = FIsGrtrOrEq(FAbs(QuatDot(curRTrans.q, lastRelativeTransform.q)), FLoad(context.mContactReuseCosHalfAngle));
+	return BAllEqTTTT(BAnd(smallTranslation, smallRotation)) != 0;
+}
+
 template<bool useContactCacheT>
 static PX_FORCE_INLINE bool checkContactsMustBeGenerated(PxcNpThreadContext& context, const PxcNpWorkUnit& input, Gu::Cache& cache, PxsContactManagerOutput& output,
 										 const PxsCachedTransform* cachedTransform0, const PxsCachedTransform* cachedTransform1,
@@ -289,7 +318,19 @@ static PX_FORCE_INLINE bool checkContactsMustBeGenerated(PxcNpThreadContext& con
 		const PxU32 active0 = PxU32(body0Dynamic && !cachedTransform0->isFrozen());
 		const PxU32 active1 = PxU32(body1Dynamic && !cachedTransform1->isFrozen());
 
-		if(!(active0 || active1))
+		// PT: contacts are reused from last step, i.e. in world space, so a pair with a small relative motion can only reuse them
+		// when its other shape did not move at all. Otherwise a pair moving as a whole would keep stale contacts forever.
+		bool reuseContacts = false;
+		if(!useContactCacheT && context.mContactReuse && (active0 != active1))
+		{
+			reuseContacts = hasSmallRelativeMotion(context, cache, cachedTransform0, cachedTransform1, flip, PxMin(type0, type1));
+#if PX_ENABLE_SIM_STATS
+			if(reuseContacts)
+				context.mNbDiscreteContactPairsWithCacheHits++;
+#endif
+		}
+
+		if(!(active0 || active1) || reuseContacts)
 		{
 			if(flip)
 				Ps::swap(type0, type1);
@@ -316,6 +357,51 @@ static PX_FORCE_INLINE bool checkContactsMustBeGenerated(PxcNpThreadContext& con
 	return true;
 }
 
+#if PX_STATIC_PCM_NARROWPHASE
+#define PXC_PCM_PAIR(type0, type1)	(PxGeometryType::type0 * PxGeometryType::eGEOMETRY_COUNT + PxGeometryType::type1)
+#define PXC_PCM_ARGS				shape0, shape1, transform0, transform1, params, cache, contactBuffer, renderOutput
+
+// Same entries as g_PCMContactMethodTable, resolved at compile time so that the calls are direct (and can be inlined with
+// link-time code generation). Heightfield pairs still go through the table, which the heightfield registration fills in.
+static PX_FORCE_INLINE bool generatePCMContacts(PxGeometryType::Enum type0, PxGeometryType::Enum type1, GU_CONTACT_METHOD_ARGS)
+{
+	switch(type0 * PxGeometryType::eGEOMETRY_COUNT + type1)
+	{
+		case PXC_PCM_PAIR(eSPHERE, eSPHERE):			return pcmContactSphereSphere(PXC_PCM_ARGS);
+		case PXC_PCM_PAIR(eSPHERE, ePLANE):				return pcmContactSpherePlane(PXC_PCM_ARGS);
+		case PXC_PCM_PAIR(eSPHERE, eCAPSULE):			return pcmContactSphereCapsule(PXC_PCM_ARGS);
+		case PXC_PCM_PAIR(eSPHERE, eBOX):				return pcmContactSphereBox(PXC_PCM_ARGS);
+		case PXC_PCM_PAIR(eSPHERE, eCONVEXMESH):		return pcmContactSphereConvex(PXC_PCM_ARGS);
+		case PXC_PCM_PAIR(eSPHERE, eTRIANGLEMESH):		return pcmContactSphereMesh(PXC_PCM_ARGS);
+
+		case PXC_PCM_PAIR(ePLANE, eCAPSULE):			return pcmContactPlaneCapsule(PXC_PCM_ARGS);
+		case PXC_PCM_PAIR(ePLANE, eBOX):				return pcmContactPlaneBox(PXC_PCM_ARGS);
+		case PXC_PCM_PAIR(ePLANE, eCONVEXMESH):			return pcmContactPlaneConvex(PXC_PCM_ARGS);
+
+		case PXC_PCM_PAIR(eCAPSULE, eCAPSULE):			return pcmContactCapsuleCapsule(PXC_PCM_ARGS);
+		case PXC_PCM_PAIR(eCAPSULE, eBOX):				return pcmContactCapsuleBox(PXC_PCM_ARGS);
+		case PXC_PCM_PAIR(eCAPSULE, eCONVEXMESH):		return pcmContactCapsuleConvex(PXC_PCM_ARGS);
+		case PXC_PCM_PAIR(eCAPSULE, eTRIANGLEMESH):		return pcmContactCapsuleMesh(PXC_PCM_ARGS);
+
+		case PXC_PCM_PAIR(eBOX, eBOX):					return pcmContactBoxBox(PXC_PCM_ARGS);
+		case PXC_PCM_PAIR(eBOX, eCONVEXMESH):			return pcmContactBoxConvex(PXC_PCM_ARGS);
+		case PXC_PCM_PAIR(eBOX, eTRIANGLEMESH):			return pcmContactBoxMesh(PXC_PCM_ARGS);
+
+		case PXC_PCM_PAIR(eCONVEXMESH, eCONVEXMESH):	return pcmContactConvexConvex(PXC_PCM_ARGS);
+		case PXC_PCM_PAIR(eCONVEXMESH, eTRIANGLEMESH):	return pcmContactConvexMesh(PXC_PCM_ARGS);
+
+		default:
+		{
+			const PxcContactMethod conMethod = g_PCMContactMethodTable[type0][type1];
+			PX_ASSERT(conMethod);
+			return conMethod(PXC_PCM_ARGS);
+		}
+	}
+}
+#undef PXC_PCM_ARGS
+#undef PXC_PCM_PAIR
+#endif
+
 template<bool useLegacyCodepath>
 static PX_FORCE_INLINE void discreteNarrowPhase(PxcNpThreadContext& context, const PxcNpWorkUnit& input, Gu::Cache& cache, PxsContactManagerOutput& output)
 {
@@ -398,10 +484,14 @@ static PX_FORCE_INLINE void discreteNarrowPhase(PxcNpThreadContext& context, con
 	}
 	else
 	{
+#if PX_STATIC_PCM_NARROWPHASE
+		generatePCMContacts(type0, type1, shape0->geometry, shape1->geometry, *tm0, *tm1, context.mNarrowPhaseParams, cache, context.mContactBuffer, &context.mRenderOutput);
+#else
 		const PxcContactMethod conMethod = g_PCMContactMethodTable[type0][type1];
 		PX_ASSERT(conMethod);
 
 		conMethod(shape0->geometry, shape1->geometry, *tm0, *tm1, context.mNarrowPhaseParams, cache, context.mContactBuffer, &context.mRenderOutput);
+#endif
 	}
 
 	const PxcGetMaterialMethod materialMethod = g_GetMaterialMethodTable[type0][type1];
@@ -417,9 +507,7 @@ static PX_FORCE_INLINE void discreteNarrowPhase(PxcNpThreadContext& context, con
 		if(isMultiManifold)
 		{
 			//Store the manifold back...
-			const PxU32 size = (sizeof(MultiPersistentManifoldHeader) +
-				manifold.mNumManifolds * sizeof(SingleManifoldHeader) +
-				manifold.mNumTotalContacts * sizeof(Gu::CachedMeshPersistentContact));
+			const PxU32 size = manifold.getBufferSize();
 
 			PxU8* buffer = context.mNpCacheStreamPair.reserve(size);
 
@@ -443,3 +531,53 @@ void physx::PxcDiscreteNarrowPhasePCM(PxcNpThreadContext& context, const PxcNpWo
 {
 	discreteNarrowPhase<false>(context, input, cache, output);
 }
+
+bool physx::PxcDiscreteNarrowPhaseMustGenerateContacts(PxcNpThreadContext& context, const PxcNpWorkUnit& input, Gu::Cache& cache, PxsContactManagerOutput& output)
+{
+	const PxGeometryType::Enum type0 = static_cast<PxGeometryType::Enum>(input.geomType0);
+	const PxGeometryType::Enum type1 = static_cast<PxGeometryType::Enum>(input.geomType1);
+
+	const PxsCachedTransform* cachedTransform0 = &context.mTransformCache->getTransformCache(input.mTransformCache0);
+	const PxsCachedTransform* cachedTransform1 = &context.mTransformCache->getTransformCache(input.mTransformCache1);
+
+	// the SDK does not cache data for these pairs, so the contact cache and the manifold-based contact reuse do not apply
+	return checkContactsMustBeGenerated<false>(context, input, cache, output, cachedTransform0, cachedTransform1, type1<type0, type0, type1);
+}
+
+void physx::PxcDiscreteNarrowPhaseFinish(PxcNpThreadContext& context, const PxcNpWorkUnit& input, PxsContactManagerOutput& output, const Gu::ContactPoint* contacts, PxU32 nbContacts)
+{
+	PxGeometryType::Enum type0 = static_cast<PxGeometryType::Enum>(input.geomType0);
+	PxGeometryType::Enum type1 = static_cast<PxGeometryType::Enum>(input.geomType1);
+
+	PxsShapeCore* shape0 = const_cast<PxsShapeCore*>(input.shapeCore0);
+	PxsShapeCore* shape1 = const_cast<PxsShapeCore*>(input.shapeCore1);
+
+	const bool flip = (type1<type0);
+	if(flip)
+	{
+		Ps::swap(type0, type1);
+		Ps::swap(shape0, shape1);
+	}
+
+	updateDiscreteContactStats(context, type0, type1);
+
+	startContacts(output, context);
+
+	ContactBuffer& buffer = context.mContactBuffer;
+	nbContacts = PxMin(nbContacts, ContactBuffer::MAX_CONTACTS);
+	for(PxU32 i=0;i<nbContacts;i++)
+		buffer.contact(contacts[i].point, contacts[i].normal, contacts[i].separation, contacts[i].internalFaceIndex1);
+
+	PxsMaterialInfo materialInfo[ContactBuffer::MAX_CONTACTS];
+
+	const PxcGetMaterialMethod materialMethod = g_GetMaterialMethodTable[type0][type1];
+	PX_ASSERT(materialMethod);
+
+	materialMethod(shape0, shape1, context, materialInfo);
+
+	if(flip)
+		flipContacts(context, materialInfo);
+
+	const bool isMeshType = type1 > PxGeometryType::eCONVEXMESH;
+	finishContacts(input, output, context, materialInfo, isMeshType);
+}
@@ -38,10 +38,11 @@ void PxcNpCacheStreamPair::reset()
 {
 	mBlock = NULL;
 	mUsed = 0;
+	mBlockCache.flush();
 }
 
 PxcNpCacheStreamPair::PxcNpCacheStreamPair(PxcNpMemBlockPool& blockPool):
-  mBlockPool(blockPool), mBlock(NULL), mUsed(0)
+  mBlockPool(blockPool), mBlockCache(blockPool, PxcNpMemBlockPool::eNP_CACHE_STREAM), mBlock(NULL), mUsed(0)
 {
 }
 
@@ -57,7 +58,7 @@ PxU8* PxcNpCacheStreamPair::reserve(PxU32 size)
 
 	if(mBlock == NULL || mUsed + size > PxcNpMemBlock::SIZE)
 	{
-		mBlock = mBlockPool.acquireNpCacheBlock();
+		mBlock = mBlockCache.acquire();
 		mUsed = 0;
 	}
 
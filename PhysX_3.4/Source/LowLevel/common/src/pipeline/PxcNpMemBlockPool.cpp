@@ -200,16 +200,25 @@ PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockArray& trackingArray, PxU
 		return block;
 	}
 
-	
+	PxcNpMemBlock* block = acquireBlockLocked(true);
+	if(block)
+		trackingArray.pushBack(block);
+	return block;
+}
+
+// takes an unused block, or allocates a new one if allowed. The caller must hold the lock and track the block.
+PxcNpMemBlock* PxcNpMemBlockPool::acquireBlockLocked(bool allowAllocation)
+{
 	if(mUnused.size())
 	{
 		PxcNpMemBlock* block = mUnused.popBack();
-		trackingArray.pushBack(block);
 		mMaxUsedBlocks = PxMax<PxU32>(mUsedBlocks+1, mMaxUsedBlocks);
 		mUsedBlocks++;
 		return block;
 	}	
 
+	if(!allowAllocation)
+		return NULL;
 
 	if(mAllocatedBlocks == mMaxBlocks)
 	{
@@ -235,7 +244,6 @@ PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockArray& trackingArray, PxU
 
 	if(block)
 	{
-		trackingArray.pushBack(block);
 		mMaxUsedBlocks = PxMax<PxU32>(mUsedBlocks+1, mMaxUsedBlocks);
 		mUsedBlocks++;
 	}
@@ -245,6 +253,67 @@ PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockArray& trackingArray, PxU
 	return block;
 }
 
+PxcNpMemBlockArray& PxcNpMemBlockPool::getCachedStreamArray(CachedStream stream)
+{
+	return stream == eCONTACT_STREAM ? mContacts[mContactIndex] : mNpCache[mNpCacheActiveStream];
+}
+
+PxcNpMemBlock* PxcNpMemBlockPool::refillCache(PxcNpMemBlockCache& cache)
+{
+	Ps::Mutex::ScopedLock lock(mLock);
+
+	// Blocks handed out by the cache are tracked by the active stream. They may have been handed out before the streams were last
+	// swapped, in which case they now end up in the more recent stream. That only delays their release.
+	PxcNpMemBlockArray& trackingArray = getCachedStreamArray(cache.mStream);
+	for(PxU32 i=0;i<cache.mNbUsed;i++)
+		trackingArray.pushBack(cache.mUsed[i]);
+	cache.mNbUsed = 0;
+
+	// same as acquireContactBlock: scratch blocks are used first while they are available. They are only valid until the constraint
+	// memory is released, so they are tracked right away and never cached.
+	if(cache.mStream == eCONTACT_STREAM && mScratchBlocks.size()>0)
+	{
+		PxcNpMemBlock* block = mScratchBlocks.popBack();
+		trackingArray.pushBack(block);
+		return block;
+	}
+
+	// only the first block may need a new allocation, the rest of the batch comes from the unused blocks, so that
+	// caching does not grow the pool
+	while(cache.mNbFree<PXC_NP_MEM_BLOCK_CACHE_SIZE)
+	{
+		PxcNpMemBlock* block = acquireBlockLocked(cache.mNbFree==0);
+		if(!block)
+			break;
+		cache.mFree[cache.mNbFree++] = block;
+	}
+
+	if(!cache.mNbFree)
+		return NULL;
+
+	PxcNpMemBlock* block = cache.mFree[--cache.mNbFree];
+	cache.mUsed[cache.mNbUsed++] = block;
+	return block;
+}
+
+void PxcNpMemBlockPool::flushCache(PxcNpMemBlockCache& cache, bool releaseFreeBlocks)
+{
+	Ps::Mutex::ScopedLock lock(mLock);
+
+	PxcNpMemBlockArray& trackingArray = getCachedStreamArray(cache.mStream);
+	for(PxU32 i=0;i<cache.mNbUsed;i++)
+		trackingArray.pushBack(cache.mUsed[i]);
+	cache.mNbUsed = 0;
+
+	if(releaseFreeBlocks)
+	{
+		PX_ASSERT(mUsedBlocks>=cache.mNbFree);
+		mUsedBlocks -= cache.mNbFree;
+		while(cache.mNbFree)
+			mUnused.pushBack(cache.mFree[--cache.mNbFree]);
+	}
+}
+
 PxU8* PxcNpMemBlockPool::acquireExceptionalConstraintMemory(PxU32 size)
 {
 	PxU8* memory = reinterpret_cast<PxU8*>(PX_ALLOC(size, "PxcNpExceptionalMemory"));
@@ -41,6 +41,9 @@ PxcNpThreadContext::PxcNpThreadContext(PxcNpContext* params) :
 	mContactCache						(false),
 	mCreateContactStream				(params->mCreateContactStream),
 	mCreateAveragePoint					(false),
+	mContactReuse						(false),
+	mContactReuseLinearThreshold		(0.0f),
+	mContactReuseCosHalfAngle			(1.0f),
 #if PX_ENABLE_SIM_STATS
 	mCompressedCacheSize				(0),
 	mNbDiscreteContactPairsWithCacheHits(0),
@@ -55,7 +58,8 @@ PxcNpThreadContext::PxcNpThreadContext(PxcNpContext* params) :
 	mLocalNewTouchCount					(0), 
 	mLocalLostTouchCount				(0),
 	mLocalFoundPatchCount				(0),	
-	mLocalLostPatchCount				(0)
+	mLocalLostPatchCount				(0),
+	mThreadIndex						(PxU32(Ps::atomicIncrement(&params->mNbThreadContexts) - 1))
 {
 #if PX_ENABLE_SIM_STATS
 	clearStats();
@@ -74,6 +78,8 @@ void PxcNpThreadContext::clearStats()
 	mCompressedCacheSize					= 0;
 	mNbDiscreteContactPairsWithCacheHits	= 0;
 	mNbDiscreteContactPairsWithContacts		= 0;
+	mContactBlockStream.getMemBlockCache().clearStats();
+	mNpCacheStreamPair.getMemBlockCache().clearStats();
 }
 #endif
 
@@ -138,6 +138,10 @@ public:
 	PX_FORCE_INLINE	const PxcNpWorkUnit&	getWorkUnit()						const	{ return mNpUnit;		}
 
 	PX_FORCE_INLINE	void*					getUserData()						const	{ return mShapeInteraction;		}
+
+	// Partition the contact constraint was placed in by the last persistent partitioning pass, PX_MAX_U16 if none
+	PX_FORCE_INLINE	PxU16					getPartitionHint()					const	{ return mPartitionHint;		}
+	PX_FORCE_INLINE	void					setPartitionHint(PxU16 partition)			{ mPartitionHint = partition;	}
 	
 	// Setup solver-constraints
 						void				resetCachedState();
@@ -152,6 +156,7 @@ private:
 						PxsRigidBody*			mRigidBody1;					//8		//16	
 						PxU32					mFlags;							//20	//36
 						Sc::ShapeInteraction*	mShapeInteraction;				//16	//32
+						PxU16					mPartitionHint;
 						
 
 
@@ -164,12 +164,15 @@ public:
 	PX_FORCE_INLINE	bool						getPCM()					const	{ return mPCM;														}
 	PX_FORCE_INLINE	bool						getContactCacheFlag()		const	{ return mContactCache;												}
 	PX_FORCE_INLINE	bool						getCreateAveragePoint()		const	{ return mCreateAveragePoint;										}
+	PX_FORCE_INLINE	PxReal						getContactReuseLinearThreshold()	const	{ return mContactReuseLinearThreshold;						}
+	PX_FORCE_INLINE	PxReal						getContactReuseCosHalfAngle()		const	{ return mContactReuseCosHalfAngle;							}
+	PX_FORCE_INLINE	PxU32						getNarrowPhaseSortInterval()		const	{ return mNarrowPhaseSortInterval;							}
 
 	// general stuff
 					void						shiftOrigin(const PxVec3& shift);
 
 					void						setCreateContactStream(bool to);
-	PX_FORCE_INLINE	void						setPCM(bool enabled)					{ mPCM = enabled;				}
+	PX_FORCE_INLINE	void						setPCM(bool enabled)					{ mPCM = enabled || PX_STATIC_PCM_NARROWPHASE;	}
 	PX_FORCE_INLINE	void						setContactCache(bool enabled)			{ mContactCache = enabled;		}
 
 	PX_FORCE_INLINE	PxcScratchAllocator&		getScratchAllocator()					{ return mScratchAllocator;		}
@@ -300,6 +303,9 @@ private:
 					bool										mPCM;
 					bool										mContactCache;
 					bool										mCreateAveragePoint;
+					PxReal										mContactReuseLinearThreshold;
+					PxReal										mContactReuseCosHalfAngle;	// cos(0.5 * contactReuseAngularThreshold)
+					PxU32										mNarrowPhaseSortInterval;
 
 					PxsTransformCache*							mTransformCache;
 					Ps::Array<PxReal, Ps::VirtualAllocator>*	mContactDistance;
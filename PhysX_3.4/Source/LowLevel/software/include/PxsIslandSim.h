@@ -33,6 +33,7 @@
 #include "CmPhysXCommon.h"
 #include "foundation/PxAssert.h"
 #include "PsArray.h"
+#include "PsSort.h"
 #include "CmBitMap.h"
 #include "CmPriorityQueue.h"
 
@@ -223,6 +224,40 @@ public:
 	}
 
 	PX_FORCE_INLINE PxU32 getTotalHandles() const { return mCurrentHandle; }
+
+	PX_FORCE_INLINE PxU32 getNbFreeHandles() const { return mFreeHandles.size(); }
+
+	//Sorts the free handles so that getHandle() returns the lowest ones first
+	void sortFreeHandles()
+	{
+		Ps::sort(mFreeHandles.begin(), mFreeHandles.size(), Ps::Greater<Handle>());
+	}
+
+	//Shrinks the range of handles past the free handles at its end. The free handles must be sorted.
+	void releaseTrailingFreeHandles()
+	{
+		PxU32 nbTrailing = 0;
+		while(nbTrailing < mFreeHandles.size() && mFreeHandles[nbTrailing] == mCurrentHandle-1)
+		{
+			mCurrentHandle--;
+			nbTrailing++;
+		}
+		if(nbTrailing)
+		{
+			const PxU32 nbLeft = mFreeHandles.size() - nbTrailing;
+			for(PxU32 a = 0; a < nbLeft; ++a)
+				mFreeHandles[a] = mFreeHandles[a + nbTrailing];
+			mFreeHandles.forceSize_Unsafe(nbLeft);
+		}
+	}
+
+	//Releases the last handle of the range, which must be in use
+	void releaseLastHandle()
+	{
+		PX_ASSERT(mCurrentHandle > 0);
+		PX_ASSERT(isNotFreeHandle(mCurrentHandle-1));
+		mCurrentHandle--;
+	}
 };
 
 class Node
@@ -412,6 +447,49 @@ private:
 	NodeComparator& operator = (const NodeComparator&);
 };
 
+//An island split off from its parent island while processing a dirty node. The nodes and edges are already unlinked from the parent
+//island and linked together, but the island itself is only created once a handle can be allocated for it.
+struct IslandSplit
+{
+	NodeIndex mRootNode;									//! The dirty node that could not find its root. It roots the new island.
+	NodeIndex mLastNode;
+	IslandId mParentIsland;
+	PxU32 mSize[Node::eTYPE_COUNT];
+	PxU32 mStaticTouchCount;
+	EdgeIndex mFirstEdge[Edge::eEDGE_TYPE_COUNT];
+	EdgeIndex mLastEdge[Edge::eEDGE_TYPE_COUNT];
+	PxU32 mEdgeCount[Edge::eEDGE_TYPE_COUNT];
+};
+
+//Temporary, transient data used for traversals. The serial path uses the first one and each island break task uses its own.
+struct TraversalScratch
+{
+	Cm::PriorityQueue<QueueElement, NodeComparator> 
+		mPriorityQueue;										//! Priority queue used for graph traversal
+	Ps::Array<TraversalState> mVisitedNodes;				//! The list of nodes visited in the current traversal
+	Cm::BitMap mVisitedState;								//! Indicates whether a node has been visited
+	Ps::Array<EdgeIndex> mIslandSplitEdges[Edge::eEDGE_TYPE_COUNT];
+	Ps::Array<IslandSplit> mIslandSplits;					//! Islands split off by this traversal that still need creating
+};
+
+#define IG_MAX_NB_ISLAND_BREAK_TASKS	16
+#define IG_MIN_ISLAND_BREAK_TASK_COST	256		//Minimum number of nodes in the dirty islands of each island break task
+
+#define IG_MIN_NB_ISLANDS_FOR_COMPACTION	256		//Smaller island ranges are never compacted
+#define IG_COMPACTION_BUDGET				4096	//Number of nodes and edges relinked by each compaction step
+
+struct IslandCompactionStats
+{
+	PxU32 mNbIslandSlots;			//! Number of island ids in use, including the free ones
+	PxU32 mNbFreeIslandSlots;		//! Number of free island ids below the last island in use
+	PxU32 mNbMovedIslands;			//! Number of islands moved to a lower id by the last compaction step
+	PxU32 mNbRelinkedIslands;		//! Number of islands whose node and edge lists were reordered by the last compaction step
+
+	IslandCompactionStats() : mNbIslandSlots(0), mNbFreeIslandSlots(0), mNbMovedIslands(0), mNbRelinkedIslands(0)
+	{
+	}
+};
+
 
 class IslandSim
 {
@@ -467,11 +545,21 @@ class IslandSim
 	
 	//Temporary, transient data used for traversals. TODO - move to PxsSimpleIslandManager. Or if we keep it here, we can 
 	//process multiple island simulations in parallel
-	Cm::PriorityQueue<QueueElement, NodeComparator> 
-		mPriorityQueue;										//! Priority queue used for graph traversal
-	Ps::Array<TraversalState> mVisitedNodes;				//! The list of nodes visited in the current traversal
-	Cm::BitMap mVisitedState;								//! Indicates whether a node has been visited
-	Ps::Array<EdgeIndex> mIslandSplitEdges[Edge::eEDGE_TYPE_COUNT];
+	TraversalScratch mTraversals[IG_MAX_NB_ISLAND_BREAK_TASKS];
+
+	//Dirty nodes grouped per island for the island break tasks
+	Ps::Array<PxU32> mDirtyIslandGroups;					//! Per-island index of its group of dirty nodes, or IG_INVALID_ISLAND
+	Ps::Array<IslandId> mDirtyGroupIslands;					//! The island of each group
+	Ps::Array<PxU32> mDirtyGroupStarts;						//! Start of each group in mDirtyGroupNodes
+	Ps::Array<NodeIndex> mDirtyGroupNodes;					//! Dirty nodes, sorted by group and then by index
+	PxU32 mIslandBreakTaskGroups[IG_MAX_NB_ISLAND_BREAK_TASKS+1];	//! Range of groups processed by each island break task
+	PxU32 mNbIslandBreakTasks;
+
+	//Incremental compaction of the island data, see compactIslands()
+	PxU32 mCompactionCursor;								//! Next island to relink, or IG_INVALID_ISLAND when no compaction is running
+	Ps::Array<NodeIndex> mCompactionNodes;
+	Ps::Array<EdgeIndex> mCompactionEdges;
+	IslandCompactionStats mCompactionStats;
 
 	Ps::Array<EdgeIndex> mDeactivatingEdges[Edge::eEDGE_TYPE_COUNT];
 
@@ -612,6 +700,24 @@ public:
 
 	bool checkInternalConsistency();
 
+	/**
+	Finds the active rigid body islands that are settled as a whole but kept awake by a few bodies: the bodies ready for sleeping
+	carry at least readyMassFraction of the island's mass and the island's mass-weighted kinetic energy is below its mass-weighted
+	sleep threshold. The nodes of these islands that are not ready for sleeping are appended to notReadyNodes.
+	\return The number of islands found.
+	*/
+	PxU32 findSettledIslands(PxReal readyMassFraction, Ps::Array<NodeIndex>& notReadyNodes) const;
+
+	/**
+	Compacts the island data once the free island ids reach the given fraction of the island id range. The islands with the highest
+	ids are moved to the lowest free ids, then the node and edge lists of every island are relinked in index order, with a bounded
+	amount of work per call. Must be called between simulation steps, when no island ids are referenced outside of the island sim.
+	0 disables the compaction.
+	*/
+	void compactIslands(PxReal freeIslandFraction);
+
+	PX_FORCE_INLINE const IslandCompactionStats& getCompactionStats() const { return mCompactionStats; }
+
 private:
 
 	void insertNewEdges();
@@ -621,6 +727,24 @@ private:
 	void processNewEdges();
 	void processLostEdges(Ps::Array<NodeIndex>& destroyedNodes, bool allowDeactivation, bool permitKinematicDeactivation, PxU32 dirtyNodeLimit);
 
+	//processLostEdges is made of these 3 stages. The 2nd one is only needed when deactivation is allowed.
+	void removeLostEdgesFromIslands();
+	void findPathsAndBreakIslands(PxU32 dirtyNodeLimit);
+	void completeLostEdges(Ps::Array<NodeIndex>& destroyedNodes, bool allowDeactivation, bool permitKinematicDeactivation);
+
+	//Multi-threaded version of findPathsAndBreakIslands. Returns the number of tasks to run, or 0 if the serial version should be used.
+	//Each task must call runIslandBreakTask, then finishIslandBreakTasks must be called once they are all done.
+	PxU32 prepareIslandBreakTasks(PxU32 maxNbTasks);
+	void runIslandBreakTask(PxU32 taskIndex);
+	void finishIslandBreakTasks();
+
+	void processDirtyNode(TraversalScratch& scratch, NodeIndex dirtyNodeIndex);
+	void createSplitIsland(const IslandSplit& split);
+
+	//Used by compactIslands. They return the amount of work done.
+	PxU32 moveIsland(IslandId from, IslandId to);
+	PxU32 relinkIsland(IslandId islandId);
+
 	void removeConnectionInternal(EdgeIndex edgeIndex);
 
 	void addConnection(NodeIndex nodeHandle1, NodeIndex nodeHandle2, Edge::EdgeType edgeType, EdgeIndex handle);
@@ -639,7 +763,7 @@ private:
 	IslandSim& operator = (const IslandSim&);
 	IslandSim(const IslandSim&);
 
-	void unwindRoute(PxU32 traversalIndex, NodeIndex lastNode, PxU32 hopCount, IslandId id);
+	void unwindRoute(TraversalScratch& scratch, PxU32 traversalIndex, NodeIndex lastNode, PxU32 hopCount, IslandId id);
 
 	void activateIsland(IslandId island);
 
@@ -647,9 +771,9 @@ private:
 
 	bool canFindRoot(NodeIndex startNode, NodeIndex targetNode, Ps::Array<NodeIndex>* visitedNodes);
 
-	bool tryFastPath(NodeIndex startNode, NodeIndex targetNode, IslandId islandId);
+	bool tryFastPath(TraversalScratch& scratch, NodeIndex startNode, NodeIndex targetNode, IslandId islandId);
 
-	bool findRoute(NodeIndex startNode, NodeIndex targetNode, IslandId islandId);
+	bool findRoute(TraversalScratch& scratch, NodeIndex startNode, NodeIndex targetNode, IslandId islandId);
 
 	bool isPathTo(NodeIndex startNode, NodeIndex targetNode);
 
@@ -918,6 +1042,8 @@ private:
 
 	friend class SimpleIslandManager;
 	friend class ThirdPassTask;
+	friend class ThirdPassFinishTask;
+	friend class IslandBreakTask;
 
 };
 
@@ -67,10 +67,10 @@ private:
 class PxsNphaseImplementationContext: public PxvNphaseImplementationContextUsableAsFallback
 {
 public:
-	static PxsNphaseImplementationContext*	create(PxsContext& context, IG::IslandSim* islandSim);
+	static PxsNphaseImplementationContext*	create(PxsContext& context, IG::IslandSim* islandSim, PxNarrowPhaseBackend* backend);
 
-	PxsNphaseImplementationContext(PxsContext& context, IG::IslandSim* islandSim, PxU32 index = 0): PxvNphaseImplementationContextUsableAsFallback(context), mNarrowPhasePairs(index), mNewNarrowPhasePairs(index),
-										mModifyCallback(NULL), mIslandSim(islandSim) {}
+	PxsNphaseImplementationContext(PxsContext& context, IG::IslandSim* islandSim, PxU32 index = 0, PxNarrowPhaseBackend* backend = NULL): PxvNphaseImplementationContextUsableAsFallback(context), mNarrowPhasePairs(index), mNewNarrowPhasePairs(index),
+										mModifyCallback(NULL), mBackend(backend), mIslandSim(islandSim), mStepsSinceSort(0) {}
 	virtual void				destroy();
 	virtual void				updateContactManager(PxReal dt, bool hasBoundsArrayChanged, bool hasContactDistanceChanged, PxBaseTask* continuation, PxBaseTask* firstPassContinuation);
 	virtual void				postBroadPhaseUpdateContactManager() {}
@@ -129,11 +129,16 @@ public:
 
 	PxContactModifyCallback*	mModifyCallback;
 
+	PxNarrowPhaseBackend*		mBackend;		// generates the contacts of the supported pairs when set
+
 	IG::IslandSim*				mIslandSim;
 
+	PxU32						mStepsSinceSort;	// steps since the last sortContactManagersSpatially(), see PxsContext::getNarrowPhaseSortInterval()
+
 private:
 
 	void						unregisterContactManagerInternal(PxU32 npIndex, PxsContactManagers& managers, PxsContactManagerOutput* cmOutputs);
+	void						sortContactManagersSpatially();
 
 	PX_NOCOPY(PxsNphaseImplementationContext)
 };
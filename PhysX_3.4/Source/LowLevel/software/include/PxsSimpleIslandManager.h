@@ -45,11 +45,65 @@ namespace IG
 
 	class SimpleIslandManager;
 
+//Breaks the dirty islands of one range of dirty node groups. Spawned by ThirdPassTask when there is enough work.
+class IslandBreakTask : public Cm::Task
+{
+	IslandSim* mIslandSim;
+	PxU32 mTaskIndex;
+
+public:
+
+	IslandBreakTask() : Cm::Task(0), mIslandSim(NULL), mTaskIndex(0)
+	{
+	}
+
+	PX_FORCE_INLINE void init(PxU64 contextID, IslandSim& islandSim, PxU32 taskIndex)
+	{
+		mContextID = contextID;
+		mIslandSim = &islandSim;
+		mTaskIndex = taskIndex;
+	}
+
+	virtual void runInternal();
+
+	virtual const char* getName() const
+	{
+		return "IslandBreakTask";
+	}
+
+private:
+	PX_NOCOPY(IslandBreakTask)
+};
+
+//Completes the third pass once all the island break tasks are done
+class ThirdPassFinishTask : public Cm::Task
+{
+	SimpleIslandManager& mIslandManager;
+	IslandSim& mIslandSim;
+
+public:
+
+	ThirdPassFinishTask(PxU64 contextID, SimpleIslandManager& islandManager, IslandSim& islandSim);
+
+	virtual void runInternal();
+
+	virtual const char* getName() const
+	{
+		return "ThirdPassIslandGenFinishTask";
+	}
+
+private:
+	PX_NOCOPY(ThirdPassFinishTask)
+};
+
 class ThirdPassTask : public Cm::Task
 {
 	SimpleIslandManager& mIslandManager;
 	IslandSim& mIslandSim;
 
+	IslandBreakTask mIslandBreakTasks[IG_MAX_NB_ISLAND_BREAK_TASKS];
+	ThirdPassFinishTask mFinishTask;
+
 public:
 
 	ThirdPassTask(PxU64 contextID, SimpleIslandManager& islandManager, IslandSim& islandSim);
@@ -115,6 +169,13 @@ class SimpleIslandManager
 	PostThirdPassTask mPostThirdPassTask;
 	PxU32 mMaxDirtyNodesPerFrame;
 
+	//Island sleep heuristic, see setIslandSleepMassFraction()
+	PxReal mIslandSleepMassFraction;
+	Ps::Array<NodeIndex> mSettledNodes;		//! Nodes marked ready for sleeping by the heuristic in the last third pass
+	PxU32 mNbSettledIslands;
+
+	PxReal mIslandCompactionThreshold;		//! See setIslandCompactionThreshold()
+
 	PxU64	mContextID;
 public:
 
@@ -147,6 +208,21 @@ public:
 	void secondPassIslandGen();
 	void thirdPassIslandGen(PxBaseTask* continuation);
 
+	/**
+	Lets islands whose sleep-ready bodies carry at least the given fraction of their mass, and whose mass-weighted energy is below their
+	mass-weighted sleep threshold, go to sleep even though some bodies are not ready for sleeping. 0 disables the heuristic.
+	*/
+	PX_FORCE_INLINE void setIslandSleepMassFraction(PxReal fraction) { mIslandSleepMassFraction = fraction; }
+
+	//! Number of islands the island sleep heuristic let go to sleep in the last third pass
+	PX_FORCE_INLINE PxU32 getNbSettledIslands() const { return mNbSettledIslands; }
+
+	/**
+	Compacts the island data of both island sims once their free island ids reach the given fraction of their island id range.
+	The work is spread over the following simulation steps. 0 disables the compaction.
+	*/
+	PX_FORCE_INLINE void setIslandCompactionThreshold(PxReal fraction) { mIslandCompactionThreshold = fraction; }
+
 	void clearDestroyedEdges();
 
 	void setEdgeConnected(EdgeIndex edgeIndex);
@@ -188,9 +264,11 @@ public:
 private:
 
 	friend class ThirdPassTask;
+	friend class ThirdPassFinishTask;
 	friend class PostThirdPassTask;
 
 	bool validateDeactivations() const;
+	void markSettledIslands();
 
 	PX_NOCOPY(SimpleIslandManager)
 };
@@ -59,6 +59,7 @@ class PxsContactManager;
 struct PxsContactManagerOutput;
 class PxsKernelWranglerManager;
 class PxsHeapMemoryAllocatorManager;
+class PxNarrowPhaseBackend;
 
 
 struct PxsContactManagerBase
@@ -210,7 +211,7 @@ public:
 	virtual ~PxvNphaseImplementationContextUsableAsFallback() {}
 };
 
-PxvNphaseImplementationContextUsableAsFallback* createNphaseImplementationContext(PxsContext& context, IG::IslandSim* islandSim);
+PxvNphaseImplementationContextUsableAsFallback* createNphaseImplementationContext(PxsContext& context, IG::IslandSim* islandSim, PxNarrowPhaseBackend* backend = NULL);
 
 }
 
@@ -1325,6 +1325,8 @@ void PxsCCDContext::updateCCD(PxReal dt, PxBaseTask* continuation, bool disableR
 	PX_ASSERT(continuation);
 	PX_ASSERT(continuation->getReference() > 0);
 
+	PX_PROFILE_START_CROSSTHREAD("Sim.ccdPass", mContext->mContextID);
+
 	//printf("CCD 1\n");
 
 	mCCDThreadContext = mContext->getNpThreadContext();
@@ -1554,6 +1556,7 @@ void PxsCCDContext::updateCCD(PxReal dt, PxBaseTask* continuation, bool disableR
 		{
 			updateCCDEnd();
 			mContext->putNpThreadContext(mCCDThreadContext);
+			PX_PROFILE_STOP_CROSSTHREAD("Sim.ccdPass", mContext->mContextID);
 			return;
 		}
 	}
@@ -1578,6 +1581,8 @@ void PxsCCDContext::updateCCD(PxReal dt, PxBaseTask* continuation, bool disableR
 	}
 
 
+	PX_PROFILE_ZONE("Sim.ccdIslands", mContext->mContextID);
+
 	PxU32 ccdBodyCount = mCCDBodies.size();
 
 	// --------------------------------------------------------------------------------------
@@ -1706,8 +1711,25 @@ void PxsCCDContext::updateCCD(PxReal dt, PxBaseTask* continuation, bool disableR
 	mPostCCDSweepTask.setContinuation(&mPostCCDAdvanceTask);
 
 	// --------------------------------------------------------------------------------------
-	// sort all pairs by islands
-	shdfnd::sort(mCCDPtrPairs.begin(), mCCDPtrPairs.size(), IslandPtrCompare());
+	// sort all pairs by islands. The histogram already gives each island's range, so a counting sort is enough
+	{
+		Array<PxU32> islandOffsets;
+		islandOffsets.resize(islandCount);
+		PxU32 offset = 0;
+		for(PxU32 a = 0; a < islandCount; ++a)
+		{
+			islandOffsets[a] = offset;
+			offset += mCCDIslandHistogram[a];
+		}
+		PX_ASSERT(offset == totalActivePairs);
+		PX_UNUSED(totalActivePairs);
+
+		for(PxU32 a = 0, n = mCCDPairs.size(); a < n; ++a)
+		{
+			PxsCCDPair& p = mCCDPairs[a];
+			mCCDPtrPairs[islandOffsets[p.mIslandId]++] = &p;
+		}
+	}
 
 	// --------------------------------------------------------------------------------------
 	// sweep all CCD pairs
@@ -1776,6 +1798,8 @@ void PxsCCDContext::postCCDSweep(PxBaseTask* continuation)
 
 void PxsCCDContext::postCCDAdvance(PxBaseTask* /*continuation*/)
 {	
+	PX_PROFILE_ZONE("Sim.ccdTouchEvents", mContext->mContextID);
+
 	// --------------------------------------------------------------------------------------
 	// contact notifications: update touch status (multi-threading this section would probably slow it down but might be worth a try)
 	PxU32 countLost = 0, countFound = 0, countRetouch = 0;
@@ -1936,6 +1960,8 @@ void PxsCCDContext::postCCDDepenetrate(PxBaseTask* /*continuation*/)
 	mContext->putNpThreadContext(mCCDThreadContext);
 
 	flushCCDLog();
+
+	PX_PROFILE_STOP_CROSSTHREAD("Sim.ccdPass", mContext->mContextID);
 }
 
 Cm::SpatialVector PxsRigidBody::getPreSolverVelocities() const
@@ -40,6 +40,7 @@ PxsContactManager::PxsContactManager(PxsContext*, PxU32 index) /*:
 	mUserData	(NULL)*/
 {
 	mFlags = 0;
+	mPartitionHint = PX_MAX_U16;
 
 	// PT: TODO: any reason why we don't initialize all members here, e.g. shapeCore pointers?
 	mNpUnit.index				= index;
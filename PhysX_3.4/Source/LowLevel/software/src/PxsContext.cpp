@@ -73,9 +73,12 @@ PxsContext::PxsContext(const PxSceneDesc& desc, PxTaskManager* taskManager, Cm::
 	mNpFallbackImplementationContext(NULL),
 	mTaskManager				(taskManager),
 	mTaskPool					(taskPool),
-	mPCM						(desc.flags & PxSceneFlag::eENABLE_PCM),
+	mPCM						(PX_STATIC_PCM_NARROWPHASE || (desc.flags & PxSceneFlag::eENABLE_PCM)),
 	mContactCache				(false),
 	mCreateAveragePoint			(desc.flags & PxSceneFlag::eENABLE_AVERAGE_POINT),
+	mContactReuseLinearThreshold(desc.contactReuseLinearThreshold),
+	mContactReuseCosHalfAngle	(PxCos(desc.contactReuseAngularThreshold * 0.5f)),
+	mNarrowPhaseSortInterval	(desc.narrowPhaseSortInterval),
 	mContextID					(contextID)
 {
 	clearManagerTouchEvents();
@@ -194,6 +197,7 @@ PxsContactManager* PxsContext::createContactManager(PxsContactManager* contactMa
 	{
 		PxcNpWorkUnitClearContactState(cm->getWorkUnit());
 		PxcNpWorkUnitClearCachedState(cm->getWorkUnit());
+		cm->setPartitionHint(PX_MAX_U16);
 
 		if (contactManager == NULL)
 		{
@@ -429,6 +433,11 @@ void PxsContext::mergeCMDiscreteUpdateResults(PxBaseTask* /*continuation*/)
 		mSimStats.mNbDiscreteContactPairsWithContacts += threadContext->mNbDiscreteContactPairsWithContacts;
 
 		mSimStats.mTotalCompressedContactSize += threadContext->mCompressedCacheSize;
+
+		const PxcNpMemBlockCache& contactBlockCache = threadContext->mContactBlockStream.getMemBlockCache();
+		const PxcNpMemBlockCache& npCacheBlockCache = threadContext->mNpCacheStreamPair.getMemBlockCache();
+		mSimStats.mNbNpMemBlockAcquires += contactBlockCache.getNbAcquires() + npCacheBlockCache.getNbAcquires();
+		mSimStats.mNbNpMemBlockPoolRefills += contactBlockCache.getNbRefills() + npCacheBlockCache.getNbRefills();
 		//KS - this data is not available yet
 		//mSimStats.mTotalConstraintSize += threadContext->mConstraintSize;
 		threadContext->clearStats();
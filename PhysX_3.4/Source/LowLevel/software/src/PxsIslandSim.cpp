@@ -28,6 +28,7 @@
 // Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
 
 #include "PxsIslandSim.h"
+#include "PxsRigidBody.h"
 #include "PsSort.h"
 #include "PsUtilities.h"
 #include "foundation/PxProfiler.h"
@@ -59,9 +60,14 @@ namespace IG
 		mActivatingNodes(PX_DEBUG_EXP("IslandSim::mActivatingNodes")),
 		mDestroyedEdges(PX_DEBUG_EXP("IslandSim::mDestroyedEdges")),
 		mTempIslandIds(PX_DEBUG_EXP("IslandSim::mTempIslandIds")),
-		//mPriorityQueue(PX_DEBUG_EXP("IslandSim::mPriorityQueue")),
-		mVisitedNodes(PX_DEBUG_EXP("IslandSim::mVisitedNodes")),
-		//mVisitedState(PX_DEBUG_EXP("IslandSim::mVisitedState"))
+		mDirtyIslandGroups(PX_DEBUG_EXP("IslandSim::mDirtyIslandGroups")),
+		mDirtyGroupIslands(PX_DEBUG_EXP("IslandSim::mDirtyGroupIslands")),
+		mDirtyGroupStarts(PX_DEBUG_EXP("IslandSim::mDirtyGroupStarts")),
+		mDirtyGroupNodes(PX_DEBUG_EXP("IslandSim::mDirtyGroupNodes")),
+		mNbIslandBreakTasks(0),
+		mCompactionCursor(IG_INVALID_ISLAND),
+		mCompactionNodes(PX_DEBUG_EXP("IslandSim::mCompactionNodes")),
+		mCompactionEdges(PX_DEBUG_EXP("IslandSim::mCompactionEdges")),
 		mFirstPartitionEdges(firstPartitionEdges),
 		mEdgeNodeIndices(edgeNodeIndices),
 		mDestroyedPartitionEdges(destroyedPartitionEdges),
@@ -627,7 +633,7 @@ bool IslandSim::canFindRoot(NodeIndex startNode, NodeIndex targetNode, Ps::Array
 
 
 
-void IslandSim::unwindRoute(PxU32 traversalIndex, NodeIndex lastNode, PxU32 hopCount, IslandId id)
+void IslandSim::unwindRoute(TraversalScratch& scratch, PxU32 traversalIndex, NodeIndex lastNode, PxU32 hopCount, IslandId id)
 {
 	//We have found either a witness *or* the root node with this traversal. In the event of finding the root node, hopCount will be 0. In the event of finding
 	//a witness, hopCount will be the hopCount that witness reported as being the distance to the root.
@@ -636,7 +642,7 @@ void IslandSim::unwindRoute(PxU32 traversalIndex, NodeIndex lastNode, PxU32 hopC
 	PxU32 hc = hopCount+1; //Add on 1 for the hop to the witness/root node.
 	do
 	{
-		TraversalState& state = mVisitedNodes[currIndex];
+		TraversalState& state = scratch.mVisitedNodes[currIndex];
 		mHopCounts[state.mNodeIndex.index()] = hc++;
 		mIslandIds[state.mNodeIndex.index()] = id;
 		mFastRoute[state.mNodeIndex.index()] = lastNode;
@@ -1176,14 +1182,14 @@ bool IslandSim::isPathTo(NodeIndex startNode, NodeIndex targetNode)
 	return false;
 }
 
-bool IslandSim::tryFastPath(NodeIndex startNode, NodeIndex targetNode, IslandId islandId)
+bool IslandSim::tryFastPath(TraversalScratch& scratch, NodeIndex startNode, NodeIndex targetNode, IslandId islandId)
 {
 	PX_UNUSED(startNode);
 	PX_UNUSED(targetNode);
 
 	NodeIndex currentNode = startNode;
 
-	PxU32 currentVisitedNodes = mVisitedNodes.size();
+	PxU32 currentVisitedNodes = scratch.mVisitedNodes.size();
 
 	PxU32 depth = 0;
 	
@@ -1192,7 +1198,7 @@ bool IslandSim::tryFastPath(NodeIndex startNode, NodeIndex targetNode, IslandId
 	{
 		//Get the fast path from this node...
 		
-		if(mVisitedState.test(currentNode.index()))
+		if(scratch.mVisitedState.test(currentNode.index()))
 		{
 			found = mIslandIds[currentNode.index()] != IG_INVALID_ISLAND; //Already visited and not tagged with invalid island == a witness!
 			break;
@@ -1203,38 +1209,38 @@ bool IslandSim::tryFastPath(NodeIndex startNode, NodeIndex targetNode, IslandId
 			break;
 		}
 
-		mVisitedNodes.pushBack(TraversalState(currentNode, mVisitedNodes.size(), mVisitedNodes.size()-1, depth++));
+		scratch.mVisitedNodes.pushBack(TraversalState(currentNode, scratch.mVisitedNodes.size(), scratch.mVisitedNodes.size()-1, depth++));
 
 		PX_ASSERT(mFastRoute[currentNode.index()].index() == IG_INVALID_NODE || isPathTo(currentNode, mFastRoute[currentNode.index()]));
 
 		mIslandIds[currentNode.index()] = IG_INVALID_ISLAND;
-		mVisitedState.set(currentNode.index());
+		scratch.mVisitedState.set(currentNode.index());
 
 		currentNode = mFastRoute[currentNode.index()];
 	}
 	while(currentNode.index() != IG_INVALID_NODE);
 
-	for(PxU32 a = currentVisitedNodes; a < mVisitedNodes.size(); ++a)
+	for(PxU32 a = currentVisitedNodes; a < scratch.mVisitedNodes.size(); ++a)
 	{
-		TraversalState& state = mVisitedNodes[a];
+		TraversalState& state = scratch.mVisitedNodes[a];
 		mIslandIds[state.mNodeIndex.index()] = islandId;
 	}
 
 	if(!found)
 	{
-		for(PxU32 a = currentVisitedNodes; a < mVisitedNodes.size(); ++a)
+		for(PxU32 a = currentVisitedNodes; a < scratch.mVisitedNodes.size(); ++a)
 		{
-			TraversalState& state = mVisitedNodes[a];
-			mVisitedState.reset(state.mNodeIndex.index());
+			TraversalState& state = scratch.mVisitedNodes[a];
+			scratch.mVisitedState.reset(state.mNodeIndex.index());
 		}
 
-		mVisitedNodes.forceSize_Unsafe(currentVisitedNodes);
+		scratch.mVisitedNodes.forceSize_Unsafe(currentVisitedNodes);
 	}
 	return found;
 
 }
 
-bool IslandSim::findRoute(NodeIndex startNode, NodeIndex targetNode, IslandId islandId)
+bool IslandSim::findRoute(TraversalScratch& scratch, NodeIndex startNode, NodeIndex targetNode, IslandId islandId)
 {
 
 	//Firstly, traverse the fast path and tag up witnesses. TryFastPath can fail. In that case, no witnesses are left but this node is permitted to report
@@ -1242,7 +1248,7 @@ bool IslandSim::findRoute(NodeIndex startNode, NodeIndex targetNode, IslandId is
 	//and tagging up the visited nodes
 	if(mFastRoute[startNode.index()].index() != IG_INVALID_NODE)
 	{
-		if(tryFastPath(startNode, targetNode, islandId))
+		if(tryFastPath(scratch, startNode, targetNode, islandId))
 			return true;
 
 		//Try fast path can either be successful or not. If it was successful, then we had a valid fast path cached and all nodes on that fast path were tagged
@@ -1260,14 +1266,14 @@ bool IslandSim::findRoute(NodeIndex startNode, NodeIndex targetNode, IslandId is
 		//as new edges are formed or when traversals occur to re-establish islands. As a result, they may be inaccurate but they still serve the purpose
 		//of guiding our search to minimize the chances of us doing an exhaustive search to find the root node.
 		mIslandIds[startNode.index()] = IG_INVALID_ISLAND;
-		TraversalState* startTraversal = &mVisitedNodes.pushBack(TraversalState(startNode, mVisitedNodes.size(), IG_INVALID_NODE, 0));
-		mVisitedState.set(startNode.index());
+		TraversalState* startTraversal = &scratch.mVisitedNodes.pushBack(TraversalState(startNode, scratch.mVisitedNodes.size(), IG_INVALID_NODE, 0));
+		scratch.mVisitedState.set(startNode.index());
 		QueueElement element(startTraversal, mHopCounts[startNode.index()]);
-		mPriorityQueue.push(element);
+		scratch.mPriorityQueue.push(element);
 
 		do
 		{
-			QueueElement currentQE = mPriorityQueue.pop();
+			QueueElement currentQE = scratch.mPriorityQueue.pop();
 
 			TraversalState& currentState = *currentQE.mState;
 
@@ -1286,11 +1292,11 @@ bool IslandSim::findRoute(NodeIndex startNode, NodeIndex targetNode, IslandId is
 					{
 						if(nextIndex.index() == targetNode.index())
 						{
-							unwindRoute(currentState.mCurrentIndex, nextIndex, 0, islandId);
+							unwindRoute(scratch, currentState.mCurrentIndex, nextIndex, 0, islandId);
 							return true;
 						}
 
-						if(mVisitedState.test(nextIndex.index()))
+						if(scratch.mVisitedState.test(nextIndex.index()))
 						{
 							//We already visited this node. This means that it's either in the priority queue already or we 
 							//visited in on a previous pass. If it was visited on a previous pass, then it already knows what island it's in. 
@@ -1304,17 +1310,17 @@ bool IslandSim::findRoute(NodeIndex startNode, NodeIndex targetNode, IslandId is
 								//because that would caused me to have been visited already because totally separate islands trigger a full traversal on 
 								//the orphaned side.
 								PX_ASSERT(visitedIslandId == islandId);
-								unwindRoute(currentState.mCurrentIndex, nextIndex, mHopCounts[nextIndex.index()], islandId);
+								unwindRoute(scratch, currentState.mCurrentIndex, nextIndex, mHopCounts[nextIndex.index()], islandId);
 								return true;
 							}
 						}
 						else
 						{
 							//This node has not been visited yet, so we need to push it into the stack and continue traversing
-							TraversalState* state = &mVisitedNodes.pushBack(TraversalState(nextIndex, mVisitedNodes.size(), currentState.mCurrentIndex, currentState.mDepth+1));
+							TraversalState* state = &scratch.mVisitedNodes.pushBack(TraversalState(nextIndex, scratch.mVisitedNodes.size(), currentState.mCurrentIndex, currentState.mDepth+1));
 							QueueElement qe(state, mHopCounts[nextIndex.index()]);
-							mPriorityQueue.push(qe);
-							mVisitedState.set(nextIndex.index());
+							scratch.mPriorityQueue.push(qe);
+							scratch.mVisitedState.set(nextIndex.index());
 							PX_ASSERT(mIslandIds[nextIndex.index()] == islandId);
 							mIslandIds[nextIndex.index()] = IG_INVALID_ISLAND; //Flag as invalid island until we know whether we can find root or an island id.
 						}
@@ -1324,7 +1330,7 @@ bool IslandSim::findRoute(NodeIndex startNode, NodeIndex targetNode, IslandId is
 				edge = instance.mNextEdge;
 			}
 		}
-		while(mPriorityQueue.size());
+		while(scratch.mPriorityQueue.size());
 
 		return false;
 	}
@@ -1336,21 +1342,19 @@ bool IslandSim::findRoute(NodeIndex startNode, NodeIndex targetNode, IslandId is
 void IslandSim::processLostEdges(Ps::Array<NodeIndex>& destroyedNodes, bool allowDeactivation, bool permitKinematicDeactivation,
 	PxU32 dirtyNodeLimit)
 {
-	PX_UNUSED(dirtyNodeLimit);
 	PX_PROFILE_ZONE("Basic.processLostEdges", getContextId());
-	//At this point, all nodes and edges are activated. 
+	//At this point, all nodes and edges are activated.
 
-	//Bit map for visited
-	mVisitedState.resizeAndClear(mNodes.size());
-	
-	//Reserve space on priority queue for at least 1024 nodes. It will resize if more memory is required during traversal.
-	mPriorityQueue.reserve(1024);
+	removeLostEdgesFromIslands();
 
-	mIslandSplitEdges[0].reserve(1024);
-	mIslandSplitEdges[1].reserve(1024);
+	if (allowDeactivation)
+		findPathsAndBreakIslands(dirtyNodeLimit);
 
-	mVisitedNodes.reserve(mNodes.size()); //Make sure we have enough space for all nodes!
+	completeLostEdges(destroyedNodes, allowDeactivation, permitKinematicDeactivation);
+}
 
+void IslandSim::removeLostEdgesFromIslands()
+{
 	const PxU32 nbDestroyedEdges = mDestroyedEdges.size();
 	PX_UNUSED(nbDestroyedEdges);
 	{
@@ -1367,11 +1371,11 @@ void IslandSim::processLostEdges(Ps::Array<NodeIndex>& destroyedNodes, bool allo
 				{
 					PxU32 index1 = mEdgeNodeIndices[mDestroyedEdges[a] * 2].index();
 					PxU32 index2 = mEdgeNodeIndices[mDestroyedEdges[a] * 2 + 1].index();
-			
+
 					IslandId islandId = IG_INVALID_ISLAND;
 					if(index1 != IG_INVALID_NODE && index2 != IG_INVALID_NODE)
 					{
-						PX_ASSERT(mIslandIds[index1] == IG_INVALID_ISLAND || mIslandIds[index2] == IG_INVALID_ISLAND || 
+						PX_ASSERT(mIslandIds[index1] == IG_INVALID_ISLAND || mIslandIds[index2] == IG_INVALID_ISLAND ||
 							mIslandIds[index1] == mIslandIds[index2]);
 						islandId = mIslandIds[index1] != IG_INVALID_ISLAND ? mIslandIds[index1] : mIslandIds[index2];
 					}
@@ -1415,281 +1419,532 @@ void IslandSim::processLostEdges(Ps::Array<NodeIndex>& destroyedNodes, bool allo
 			}
 		}
 	}
+}
 
-	if (allowDeactivation)
-	{
-		PX_PROFILE_ZONE("Basic.findPathsAndBreakIslands", getContextId());
-		
+void IslandSim::findPathsAndBreakIslands(PxU32 dirtyNodeLimit)
+{
+	PX_UNUSED(dirtyNodeLimit);
+	PX_PROFILE_ZONE("Basic.findPathsAndBreakIslands", getContextId());
+
+	//The serial path uses the first traversal scratch. The others are only used by the island break tasks.
+	TraversalScratch& scratch = mTraversals[0];
+
+	//Bit map for visited
+	scratch.mVisitedState.resizeAndClear(mNodes.size());
+
+	//Reserve space on priority queue for at least 1024 nodes. It will resize if more memory is required during traversal.
+	scratch.mPriorityQueue.reserve(1024);
+
+	scratch.mIslandSplitEdges[0].reserve(1024);
+	scratch.mIslandSplitEdges[1].reserve(1024);
+
+	scratch.mVisitedNodes.reserve(mNodes.size()); //Make sure we have enough space for all nodes!
 
-		//KS - process only this many dirty nodes, deferring future dirty nodes to subsequent frames. 
-		//This means that it may take several frames for broken edges to trigger islands to completely break but this is better
-		//than triggering large performance spikes.
+	scratch.mIslandSplits.forceSize_Unsafe(0);
+
+	//KS - process only this many dirty nodes, deferring future dirty nodes to subsequent frames.
+	//This means that it may take several frames for broken edges to trigger islands to completely break but this is better
+	//than triggering large performance spikes.
 #if IG_LIMIT_DIRTY_NODES
-		Cm::BitMap::CircularIterator iter(mDirtyMap, mLastMapIndex);
-		const PxU32 MaxCount = dirtyNodeLimit;// +10000000;
-		PxU32 lastMapIndex = mLastMapIndex;
-		PxU32 count = 0;
+	Cm::BitMap::CircularIterator iter(mDirtyMap, mLastMapIndex);
+	const PxU32 MaxCount = dirtyNodeLimit;// +10000000;
+	PxU32 lastMapIndex = mLastMapIndex;
+	PxU32 count = 0;
 #else
-		Cm::BitMap::Iterator iter(mDirtyMap);
+	Cm::BitMap::Iterator iter(mDirtyMap);
 #endif
 
-		
-		PxU32 dirtyIdx;
-		
+
+	PxU32 dirtyIdx;
+
 #if IG_LIMIT_DIRTY_NODES
-		while ((dirtyIdx = iter.getNext()) != Cm::BitMap::CircularIterator::DONE
-			&& (count++ < MaxCount)
+	while ((dirtyIdx = iter.getNext()) != Cm::BitMap::CircularIterator::DONE
+		&& (count++ < MaxCount)
 #else
-		while ((dirtyIdx = iter.getNext()) != Cm::BitMap::Iterator::DONE
+	while ((dirtyIdx = iter.getNext()) != Cm::BitMap::Iterator::DONE
+#endif
+		)
+	{
+#if IG_LIMIT_DIRTY_NODES
+		lastMapIndex = dirtyIdx + 1;
 #endif
-			)
+		//Process dirty nodes. Figure out if we can make our way from the dirty node to the root.
+		processDirtyNode(scratch, NodeIndex(dirtyIdx));
+
+		//In the serial path, the new island is created straight away so handles are allocated in dirty node order
+		if(scratch.mIslandSplits.size())
 		{
+			createSplitIsland(scratch.mIslandSplits[0]);
+			scratch.mIslandSplits.forceSize_Unsafe(0);
+		}
+
+		mNodes[dirtyIdx].clearDirty();
 #if IG_LIMIT_DIRTY_NODES
-			lastMapIndex = dirtyIdx + 1;
+		mDirtyMap.reset(dirtyIdx);
 #endif
-			//Process dirty nodes. Figure out if we can make our way from the dirty node to the root.
+	}
 
-			mPriorityQueue.clear(); //Clear the queue used for traversal
-			mVisitedNodes.forceSize_Unsafe(0); //Clear the list of nodes in this island
-			NodeIndex dirtyNodeIndex(dirtyIdx);
-			Node& dirtyNode = mNodes[dirtyNodeIndex.index()];
-		
-			//Check whether this node has already been touched. If it has been touched this frame, then its island state is reliable 
-			//and we can just unclear the dirty flag on the body. If we were already visited, then the state should have already been confirmed in a 
-			//previous pass.
-			if(!dirtyNode.isKinematic() && !dirtyNode.isDeleted() && !mVisitedState.test(dirtyNodeIndex.index()))
+
+
+#if IG_LIMIT_DIRTY_NODES
+	mLastMapIndex = lastMapIndex;
+	if (count < MaxCount)
+		mLastMapIndex = 0;
+#else
+	mDirtyMap.clear();
+#endif
+
+	//mDirtyNodes.forceSize_Unsafe(0);
+}
+
+void IslandSim::processDirtyNode(TraversalScratch& scratch, NodeIndex dirtyNodeIndex)
+{
+	scratch.mPriorityQueue.clear(); //Clear the queue used for traversal
+	scratch.mVisitedNodes.forceSize_Unsafe(0); //Clear the list of nodes in this island
+	Node& dirtyNode = mNodes[dirtyNodeIndex.index()];
+
+	//Check whether this node has already been touched. If it has been touched this frame, then its island state is reliable
+	//and we can just unclear the dirty flag on the body. If we were already visited, then the state should have already been confirmed in a
+	//previous pass.
+	if(!dirtyNode.isKinematic() && !dirtyNode.isDeleted() && !scratch.mVisitedState.test(dirtyNodeIndex.index()))
+	{
+		//We haven't visited this node in our island repair passes yet, so we still need to process until we've hit a visited node or found
+		//our root node. Note that, as soon as we hit a visited node that has already been processed in a previous pass, we know that we can rely
+		//on its island information although the hop counts may not be optimal. It also indicates that this island was not broken immediately because
+		//otherwise, the entire new sub-island would already have been visited and this node would have already had its new island state assigned.
+
+		//Indicate that I've been visited
+
+		IslandId islandId = mIslandIds[dirtyNodeIndex.index()];
+		Island& findIsland = mIslands[islandId];
+
+		NodeIndex searchNode = findIsland.mRootNode;//The node that we're searching for!
+
+		if(searchNode.index() != dirtyNodeIndex.index()) //If we are the root node, we don't need to do anything!
+		{
+			Ps::Array<TraversalState>& visitedNodes = scratch.mVisitedNodes;
+
+			if(findRoute(scratch, dirtyNodeIndex, searchNode, islandId))
 			{
-				//We haven't visited this node in our island repair passes yet, so we still need to process until we've hit a visited node or found
-				//our root node. Note that, as soon as we hit a visited node that has already been processed in a previous pass, we know that we can rely
-				//on its island information although the hop counts may not be optimal. It also indicates that this island was not broken immediately because
-				//otherwise, the entire new sub-island would already have been visited and this node would have already had its new island state assigned.
+				//We found the root node so let's let every visited node know that we found its root
+				//and we can also update our hop counts because we recorded how many hops it took to reach this
+				//node
 
-				//Indicate that I've been visited
+				//We already filled in the path to the root/witness with accurate hop counts. Now we just need to fill in the estimates
+				//for the remaining nodes and re-define their islandIds. We approximate their path to the root by just routing them through
+				//the route we already found.
 
-				IslandId islandId = mIslandIds[dirtyNodeIndex.index()];
-				Island& findIsland = mIslands[islandId];
+				//This loop works because mVisitedNodes are recorded in the order they were visited and we already filled in the critical path
+				//so the remainder of the paths will just fork from that path.
 
-				NodeIndex searchNode = findIsland.mRootNode;//The node that we're searching for!
+				//Verify state (that we can see the root from this node)...
+
+#if IG_SANITY_CHECKS
+				PX_ASSERT(canFindRoot(dirtyNode, searchNode, NULL)); //Verify that we found the connection
+#endif
 
-				if(searchNode.index() != dirtyNodeIndex.index()) //If we are the root node, we don't need to do anything!
+				for(PxU32 b = 0; b < visitedNodes.size(); ++b)
 				{
-					if(findRoute(dirtyNodeIndex, searchNode, islandId))
+					TraversalState& state = visitedNodes[b];
+					if(mIslandIds[state.mNodeIndex.index()] == IG_INVALID_ISLAND)
 					{
-						//We found the root node so let's let every visited node know that we found its root
-						//and we can also update our hop counts because we recorded how many hops it took to reach this
-						//node
+						mHopCounts[state.mNodeIndex.index()] = mHopCounts[visitedNodes[state.mPrevIndex].mNodeIndex.index()]+1;
+						mFastRoute[state.mNodeIndex.index()] = visitedNodes[state.mPrevIndex].mNodeIndex;
+						mIslandIds[state.mNodeIndex.index()] = islandId;
+					}
+				}
+			}
+			else
+			{
+				//If I traversed and could not find the root node, then I have established a new island. In this island, I am the root node
+				//and I will point all my nodes towards me. Furthermore, I have established how many steps it took to reach all nodes in my island
 
-						//We already filled in the path to the root/witness with accurate hop counts. Now we just need to fill in the estimates
-						//for the remaining nodes and re-define their islandIds. We approximate their path to the root by just routing them through
-						//the route we already found.
+				//OK. We need to separate the islands. We have a list of nodes that are part of the new island (mVisitedNodes) and we know that the
+				//first node in that list is the root node.
 
-						//This loop works because mVisitedNodes are recorded in the order they were visited and we already filled in the critical path
-						//so the remainder of the paths will just fork from that path.
 
-						//Verify state (that we can see the root from this node)...
+				//OK, we need to remove all these actors from their current island, then add them to the new island...
 
-	#if IG_SANITY_CHECKS
-						PX_ASSERT(canFindRoot(dirtyNode, searchNode, NULL)); //Verify that we found the connection
-	#endif
+				Island& oldIsland = mIslands[islandId];
+				//We can just unpick these nodes from the island because they do not contain the root node (if they did, then we wouldn't be
+				//removing this node from the island at all). The only challenge is if we need to remove the last node. In that case
+				//we need to re-establish the new last node in the island but perhaps the simplest way to do that would be to traverse
+				//the island to establish the last node again
 
-						for(PxU32 b = 0; b < mVisitedNodes.size(); ++b)
-						{
-							TraversalState& state = mVisitedNodes[b];
-							if(mIslandIds[state.mNodeIndex.index()] == IG_INVALID_ISLAND)
-							{
-								mHopCounts[state.mNodeIndex.index()] = mHopCounts[mVisitedNodes[state.mPrevIndex].mNodeIndex.index()]+1; 
-								mFastRoute[state.mNodeIndex.index()] = mVisitedNodes[state.mPrevIndex].mNodeIndex;
-								mIslandIds[state.mNodeIndex.index()] = islandId;
-							}
-						}
-					}
-					else
-					{
-						//If I traversed and could not find the root node, then I have established a new island. In this island, I am the root node
-						//and I will point all my nodes towards me. Furthermore, I have established how many steps it took to reach all nodes in my island
+#if IG_SANITY_CHECKS
+				PX_ASSERT(!canFindRoot(dirtyNode, searchNode, NULL));
+#endif
+
+				PxU32 totalStaticTouchCount = 0;
+				scratch.mIslandSplitEdges[0].forceSize_Unsafe(0);
+				scratch.mIslandSplitEdges[1].forceSize_Unsafe(0);
+				PxU32 size[2] = {0,0};
 
-						//OK. We need to separate the islands. We have a list of nodes that are part of the new island (mVisitedNodes) and we know that the 
-						//first node in that list is the root node.
+				//NodeIndex lastIndex = oldIsland.mLastNode;
 
+				//size[node.mType] = 1;
 
-						//OK, we need to remove all these actors from their current island, then add them to the new island...
+				for(PxU32 a = 0; a < visitedNodes.size(); ++a)
+				{
+					NodeIndex index = visitedNodes[a].mNodeIndex;
+					Node& node = mNodes[index.index()];
+
+					if(node.mNextNode.index() != IG_INVALID_NODE)
+						mNodes[node.mNextNode.index()].mPrevNode = node.mPrevNode;
+					else
+						oldIsland.mLastNode = node.mPrevNode;
+					if(node.mPrevNode.index() != IG_INVALID_NODE)
+						mNodes[node.mPrevNode.index()].mNextNode = node.mNextNode;
 
-						Island& oldIsland = mIslands[islandId];
-						//We can just unpick these nodes from the island because they do not contain the root node (if they did, then we wouldn't be
-						//removing this node from the island at all). The only challenge is if we need to remove the last node. In that case
-						//we need to re-establish the new last node in the island but perhaps the simplest way to do that would be to traverse
-						//the island to establish the last node again
+					size[node.mType]++;
 
-	#if IG_SANITY_CHECKS
-						PX_ASSERT(!canFindRoot(dirtyNode, searchNode, NULL));
-	#endif
+					node.mNextNode.setIndices(IG_INVALID_NODE, 0);
+					node.mPrevNode.setIndices(IG_INVALID_NODE, 0);
 
-						PxU32 totalStaticTouchCount = 0;
-						mIslandSplitEdges[0].forceSize_Unsafe(0);
-						mIslandSplitEdges[1].forceSize_Unsafe(0);
-						PxU32 size[2] = {0,0};
+					PX_ASSERT(mNodes[oldIsland.mLastNode.index()].mNextNode.index() == IG_INVALID_NODE);
 
-						//NodeIndex lastIndex = oldIsland.mLastNode;
+					totalStaticTouchCount += node.mStaticTouchCount;
 
-						//size[node.mType] = 1;
+					EdgeInstanceIndex idx = node.mFirstEdgeIndex;
 
-						for(PxU32 a = 0; a < mVisitedNodes.size(); ++a)
+					while(idx != IG_INVALID_EDGE)
+					{
+						EdgeInstance& instance = mEdgeInstances[idx];
+						const EdgeIndex edgeIndex = idx/2;
+						Edge& edge = mEdges[edgeIndex];
+
+						//Only split the island if we're processing the first node or if the first node is infinte-mass
+						if (!(idx & 1) || (mEdgeNodeIndices[idx & (~1)].index() == IG_INVALID_NODE || mNodes[mEdgeNodeIndices[idx & (~1)].index()].isKinematic()))
 						{
-							NodeIndex index = mVisitedNodes[a].mNodeIndex;
-							Node& node = mNodes[index.index()];
+							//We will remove this edge from the island...
+							scratch.mIslandSplitEdges[edge.mEdgeType].pushBack(edgeIndex);
 
-							if(node.mNextNode.index() != IG_INVALID_NODE)
-								mNodes[node.mNextNode.index()].mPrevNode = node.mPrevNode;
-							else
-								oldIsland.mLastNode = node.mPrevNode;
-							if(node.mPrevNode.index() != IG_INVALID_NODE)
-								mNodes[node.mPrevNode.index()].mNextNode = node.mNextNode;
+							removeEdgeFromIsland(oldIsland, edgeIndex);
 
-							size[node.mType]++;
+						}
+						idx = instance.mNextEdge;
+					}
 
-							node.mNextNode.setIndices(IG_INVALID_NODE, 0);
-							node.mPrevNode.setIndices(IG_INVALID_NODE, 0);
+				}
 
-							PX_ASSERT(mNodes[oldIsland.mLastNode.index()].mNextNode.index() == IG_INVALID_NODE);
+				//oldIsland.mStaticTouchCount -= totalStaticTouchCount;
+				mIslandStaticTouchCount[islandId] -= totalStaticTouchCount;
 
-							totalStaticTouchCount += node.mStaticTouchCount;
+				oldIsland.mSize[0] -= size[0];
+				oldIsland.mSize[1] -= size[1];
 
-							EdgeInstanceIndex idx = node.mFirstEdgeIndex;
+				//Now link all these nodes together. The new island itself is created in createSplitIsland, because island handles must
+				//be allocated in dirty node order even when several island break tasks run concurrently. Until then, the nodes keep
+				//the old island id. They are no longer connected to the old island so no other traversal of that island can reach them.
 
-							while(idx != IG_INVALID_EDGE)
-							{
-								EdgeInstance& instance = mEdgeInstances[idx];
-								const EdgeIndex edgeIndex = idx/2;
-								Edge& edge = mEdges[edgeIndex];
-								
-								//Only split the island if we're processing the first node or if the first node is infinte-mass
-								if (!(idx & 1) || (mEdgeNodeIndices[idx & (~1)].index() == IG_INVALID_NODE || mNodes[mEdgeNodeIndices[idx & (~1)].index()].isKinematic()))
-								{
-									//We will remove this edge from the island...
-									mIslandSplitEdges[edge.mEdgeType].pushBack(edgeIndex);
+				IslandSplit& split = scratch.mIslandSplits.insert();
+				split.mRootNode = dirtyNodeIndex;
+				split.mParentIsland = islandId;
+				split.mStaticTouchCount = totalStaticTouchCount;
 
-									removeEdgeFromIsland(oldIsland, edgeIndex);	
+				mHopCounts[dirtyNodeIndex.index()] = 0;
+				//newIsland.mTotalSize = mVisitedNodes.size();
 
-								}
-								idx = instance.mNextEdge;
-							}
+				mNodes[dirtyNodeIndex.index()].mPrevNode.setIndices(IG_INVALID_NODE, 0); //First node so doesn't have a preceding node
+				mFastRoute[dirtyNodeIndex.index()].setIndices(IG_INVALID_NODE, 0);
 
-						}
+				size[0] = 0; size[1] = 0;
 
-						//oldIsland.mStaticTouchCount -= totalStaticTouchCount;
-						mIslandStaticTouchCount[islandId] -= totalStaticTouchCount;
+				size[dirtyNode.mType] = 1;
+
+				for(PxU32 a = 1; a < visitedNodes.size(); ++a)
+				{
+					NodeIndex index = visitedNodes[a].mNodeIndex;
+					Node& thisNode = mNodes[index.index()];
+					NodeIndex prevNodeIndex = visitedNodes[a-1].mNodeIndex;
+					thisNode.mPrevNode = prevNodeIndex;
+					mNodes[prevNodeIndex.index()].mNextNode = index;
+					size[thisNode.mType]++;
+					mHopCounts[index.index()] = visitedNodes[a].mDepth; //How many hops to root
+					mFastRoute[index.index()] = visitedNodes[visitedNodes[a].mPrevIndex].mNodeIndex;
+				}
 
-						oldIsland.mSize[0] -= size[0];
-						oldIsland.mSize[1] -= size[1];
+				split.mSize[0] = size[0];
+				split.mSize[1] = size[1];
+				//Last node in the island
+				NodeIndex lastIndex = visitedNodes[visitedNodes.size()-1].mNodeIndex;
+				mNodes[lastIndex.index()].mNextNode.setIndices(IG_INVALID_NODE, 0);
+				split.mLastNode = lastIndex;
 
-						//Now add all these nodes to the new island
+				PX_ASSERT(mNodes[split.mLastNode.index()].mNextNode.index() == IG_INVALID_NODE);
 
-						//(1) Create the new island...
-						IslandId newIslandHandle = mIslandHandles.getHandle();
-						/*if(newIslandHandle == mIslands.capacity())
-						{
-							mIslands.reserve(2*mIslands.capacity() + 1);
-						}*/
-						mIslands.resize(PxMax(newIslandHandle+1, mIslands.size()));
-						mIslandStaticTouchCount.resize(PxMax(newIslandHandle+1, mIslandStaticTouchCount.size()));
-						Island& newIsland = mIslands[newIslandHandle];
-					
-						if(mIslandAwake.test(islandId))
-						{
-							newIsland.mActiveIndex = mActiveIslands.size();
-							mActiveIslands.pushBack(newIslandHandle);
-							mIslandAwake.growAndSet(newIslandHandle); //Separated island, so it should be awake
-						}
-						else
+				for(PxU32 j = 0; j < 2; ++j)
+				{
+					Ps::Array<EdgeIndex>& splitEdges = scratch.mIslandSplitEdges[j];
+					const PxU32 splitEdgeSize = splitEdges.size();
+					split.mEdgeCount[j] = splitEdgeSize;
+					if(splitEdgeSize)
+					{
+						splitEdges.pushBack(IG_INVALID_EDGE); //Push in a dummy invalid edge to complete the connectivity
+						mEdges[splitEdges[0]].mNextIslandEdge = splitEdges[1];
+						for(PxU32 a = 1; a < splitEdgeSize; ++a)
 						{
-							mIslandAwake.growAndReset(newIslandHandle);
+							EdgeIndex edgeIndex = splitEdges[a];
+							Edge& edge = mEdges[edgeIndex];
+							edge.mNextIslandEdge = splitEdges[a+1];
+							edge.mPrevIslandEdge = splitEdges[a-1];
 						}
 
-						newIsland.mRootNode = dirtyNodeIndex;
-						mHopCounts[dirtyNodeIndex.index()] = 0;
-						mIslandIds[dirtyNodeIndex.index()] = newIslandHandle;
-						//newIsland.mTotalSize = mVisitedNodes.size();
+						split.mFirstEdge[j] = splitEdges[0];
+						split.mLastEdge[j] = splitEdges[splitEdgeSize-1];
+					}
+				}
+			}
+		}
+	}
+}
 
-						mNodes[dirtyNodeIndex.index()].mPrevNode.setIndices(IG_INVALID_NODE, 0); //First node so doesn't have a preceding node
-						mFastRoute[dirtyNodeIndex.index()].setIndices(IG_INVALID_NODE, 0);
+void IslandSim::createSplitIsland(const IslandSplit& split)
+{
+	//(1) Create the new island...
+	IslandId newIslandHandle = mIslandHandles.getHandle();
+	/*if(newIslandHandle == mIslands.capacity())
+	{
+		mIslands.reserve(2*mIslands.capacity() + 1);
+	}*/
+	mIslands.resize(PxMax(newIslandHandle+1, mIslands.size()));
+	mIslandStaticTouchCount.resize(PxMax(newIslandHandle+1, mIslandStaticTouchCount.size()));
+	Island& newIsland = mIslands[newIslandHandle];
 
-						size[0] = 0; size[1] = 0;
+	if(mIslandAwake.test(split.mParentIsland))
+	{
+		newIsland.mActiveIndex = mActiveIslands.size();
+		mActiveIslands.pushBack(newIslandHandle);
+		mIslandAwake.growAndSet(newIslandHandle); //Separated island, so it should be awake
+	}
+	else
+	{
+		mIslandAwake.growAndReset(newIslandHandle);
+	}
 
-						size[dirtyNode.mType] = 1;
-					
-						for(PxU32 a = 1; a < mVisitedNodes.size(); ++a)
-						{
-							NodeIndex index = mVisitedNodes[a].mNodeIndex;
-							Node& thisNode = mNodes[index.index()];
-							NodeIndex prevNodeIndex = mVisitedNodes[a-1].mNodeIndex;
-							thisNode.mPrevNode = prevNodeIndex;
-							mNodes[prevNodeIndex.index()].mNextNode = index;
-							size[thisNode.mType]++;
-							mIslandIds[index.index()] = newIslandHandle;
-							mHopCounts[index.index()] = mVisitedNodes[a].mDepth; //How many hops to root
-							mFastRoute[index.index()] = mVisitedNodes[mVisitedNodes[a].mPrevIndex].mNodeIndex;
-						}
+	//(2) Move the nodes linked up by processDirtyNode to the new island
+	newIsland.mRootNode = split.mRootNode;
+	newIsland.mLastNode = split.mLastNode;
+	newIsland.mSize[0] = split.mSize[0];
+	newIsland.mSize[1] = split.mSize[1];
+	//newIsland.mStaticTouchCount = totalStaticTouchCount;
+	mIslandStaticTouchCount[newIslandHandle] = split.mStaticTouchCount;
 
-						newIsland.mSize[0] = size[0];
-						newIsland.mSize[1] = size[1];
-						//Last node in the island
-						NodeIndex lastIndex = mVisitedNodes[mVisitedNodes.size()-1].mNodeIndex;
-						mNodes[lastIndex.index()].mNextNode.setIndices(IG_INVALID_NODE, 0);
-						newIsland.mLastNode = lastIndex;
-						//newIsland.mStaticTouchCount = totalStaticTouchCount;
-						mIslandStaticTouchCount[newIslandHandle] = totalStaticTouchCount;
-						newIsland.mSize[0] = size[0];
-						newIsland.mSize[1] = size[1];
+	NodeIndex islandNode = split.mRootNode;
+	while(islandNode.index() != IG_INVALID_NODE)
+	{
+		mIslandIds[islandNode.index()] = newIslandHandle;
+		islandNode = mNodes[islandNode.index()].mNextNode;
+	}
 
-						PX_ASSERT(mNodes[newIsland.mLastNode.index()].mNextNode.index() == IG_INVALID_NODE);
+	for(PxU32 j = 0; j < 2; ++j)
+	{
+		if(split.mEdgeCount[j])
+		{
+			newIsland.mFirstEdge[j] = split.mFirstEdge[j];
+			newIsland.mLastEdge[j] = split.mLastEdge[j];
+			newIsland.mEdgeCount[j] = split.mEdgeCount[j];
+		}
+	}
+}
 
-						for(PxU32 j = 0; j < 2; ++j)
-						{
-							Ps::Array<EdgeIndex>& splitEdges = mIslandSplitEdges[j];
-							const PxU32 splitEdgeSize = splitEdges.size();
-							if(splitEdgeSize)
-							{
-								splitEdges.pushBack(IG_INVALID_EDGE); //Push in a dummy invalid edge to complete the connectivity
-								mEdges[splitEdges[0]].mNextIslandEdge = splitEdges[1];
-								for(PxU32 a = 1; a < splitEdgeSize; ++a)
-								{
-									EdgeIndex edgeIndex = splitEdges[a];
-									Edge& edge = mEdges[edgeIndex];
-									edge.mNextIslandEdge = splitEdges[a+1];
-									edge.mPrevIslandEdge = splitEdges[a-1];
-								}
+PxU32 IslandSim::prepareIslandBreakTasks(PxU32 maxNbTasks)
+{
+#if IG_LIMIT_DIRTY_NODES
+	//The dirty node budget is defined in serial dirty node order, so it can't be split across tasks
+	PX_UNUSED(maxNbTasks);
+	return 0;
+#else
+	mNbIslandBreakTasks = 0;
 
-								newIsland.mFirstEdge[j] = splitEdges[0];
-								newIsland.mLastEdge[j] = splitEdges[splitEdgeSize-1];
-								newIsland.mEdgeCount[j] = splitEdgeSize;
-							}
-						}
+	maxNbTasks = PxMin(maxNbTasks, PxU32(IG_MAX_NB_ISLAND_BREAK_TASKS));
+	if(maxNbTasks < 2)
+		return 0;
 
-					}
-				}
+	PX_PROFILE_ZONE("Basic.prepareIslandBreakTasks", getContextId());
 
+	//Dirty nodes can only ever reach nodes of their own island during traversal, and all the data written when breaking an island
+	//belongs to that island. So we group the dirty nodes per island, keeping the serial order within each group, and give each
+	//task a contiguous range of groups. Only the creation of the new islands is shared and that is deferred to finishIslandBreakTasks.
+
+	//The group LUT entries are reset to IG_INVALID_ISLAND after use, so only new islands need initializing here
+	mDirtyIslandGroups.resize(mIslands.size(), IG_INVALID_ISLAND);
+	mDirtyGroupIslands.forceSize_Unsafe(0);
+	mDirtyGroupStarts.forceSize_Unsafe(0);
+
+	PxU32 nbDirtyNodes = 0;
+	{
+		Cm::BitMap::Iterator iter(mDirtyMap);
+		PxU32 dirtyIdx;
+		while((dirtyIdx = iter.getNext()) != Cm::BitMap::Iterator::DONE)
+		{
+			const Node& node = mNodes[dirtyIdx];
+			if(node.isKinematic() || node.isDeleted())
+				continue;
+
+			const IslandId islandId = mIslandIds[dirtyIdx];
+			PxU32 group = mDirtyIslandGroups[islandId];
+			if(group == IG_INVALID_ISLAND)
+			{
+				group = mDirtyGroupIslands.size();
+				mDirtyIslandGroups[islandId] = group;
+				mDirtyGroupIslands.pushBack(islandId);
+				mDirtyGroupStarts.pushBack(0);
 			}
+			mDirtyGroupStarts[group]++;
+			nbDirtyNodes++;
+		}
+	}
 
-			dirtyNode.clearDirty();
-#if IG_LIMIT_DIRTY_NODES
-			mDirtyMap.reset(dirtyIdx);
+	const PxU32 nbGroups = mDirtyGroupIslands.size();
+
+	//The cost of a group is bounded by the size of its island, since traversals never leave the island
+	PxU32 totalCost = 0;
+	for(PxU32 a = 0; a < nbGroups; ++a)
+	{
+		const Island& island = mIslands[mDirtyGroupIslands[a]];
+		totalCost += island.mSize[0] + island.mSize[1];
+	}
+
+	const PxU32 nbTasks = PxMin(PxMin(maxNbTasks, nbGroups), totalCost / IG_MIN_ISLAND_BREAK_TASK_COST);
+	if(nbTasks < 2)
+	{
+		for(PxU32 a = 0; a < nbGroups; ++a)
+			mDirtyIslandGroups[mDirtyGroupIslands[a]] = IG_INVALID_ISLAND;
+		return 0;
+	}
+
+	//Counts to start offsets, then bucket the dirty nodes. Bucketing advances each start offset to the next group's start,
+	//so the offsets are shifted back afterwards.
+	PxU32 offset = 0;
+	for(PxU32 a = 0; a < nbGroups; ++a)
+	{
+		const PxU32 count = mDirtyGroupStarts[a];
+		mDirtyGroupStarts[a] = offset;
+		offset += count;
+	}
+	mDirtyGroupStarts.pushBack(offset);
+	PX_ASSERT(offset == nbDirtyNodes);
+
+	mDirtyGroupNodes.resizeUninitialized(nbDirtyNodes);
+	{
+		Cm::BitMap::Iterator iter(mDirtyMap);
+		PxU32 dirtyIdx;
+		while((dirtyIdx = iter.getNext()) != Cm::BitMap::Iterator::DONE)
+		{
+			const Node& node = mNodes[dirtyIdx];
+			if(node.isKinematic() || node.isDeleted())
+				continue;
+
+			const PxU32 group = mDirtyIslandGroups[mIslandIds[dirtyIdx]];
+			mDirtyGroupNodes[mDirtyGroupStarts[group]++] = NodeIndex(dirtyIdx);
+		}
+	}
+	for(PxU32 a = nbGroups; a > 0; --a)
+		mDirtyGroupStarts[a] = mDirtyGroupStarts[a-1];
+	mDirtyGroupStarts[0] = 0;
+
+	//Give each task a contiguous range of groups of roughly equal cost
+	const PxU32 costPerTask = (totalCost + nbTasks - 1) / nbTasks;
+	PxU32 taskIndex = 0;
+	PxU32 cost = 0;
+	mIslandBreakTaskGroups[0] = 0;
+	for(PxU32 a = 0; a < nbGroups - 1 && taskIndex < nbTasks - 1; ++a)
+	{
+		const Island& island = mIslands[mDirtyGroupIslands[a]];
+		cost += island.mSize[0] + island.mSize[1];
+		if(cost >= costPerTask * (taskIndex + 1))
+			mIslandBreakTaskGroups[++taskIndex] = a + 1;
+	}
+	mNbIslandBreakTasks = taskIndex + 1;
+	mIslandBreakTaskGroups[mNbIslandBreakTasks] = nbGroups;
+
+	return mNbIslandBreakTasks;
 #endif
+}
+
+void IslandSim::runIslandBreakTask(PxU32 taskIndex)
+{
+	PX_PROFILE_ZONE("Basic.islandBreakTask", getContextId());
+	PX_ASSERT(taskIndex < mNbIslandBreakTasks);
+
+	TraversalScratch& scratch = mTraversals[taskIndex];
+
+	const PxU32 firstGroup = mIslandBreakTaskGroups[taskIndex];
+	const PxU32 lastGroup = mIslandBreakTaskGroups[taskIndex + 1];
+
+	//A traversal never visits more nodes than its island contains. This must be reserved up front because the priority queue
+	//references the visited nodes.
+	PxU32 maxIslandSize = 0;
+	for(PxU32 a = firstGroup; a < lastGroup; ++a)
+	{
+		const Island& island = mIslands[mDirtyGroupIslands[a]];
+		maxIslandSize = PxMax(maxIslandSize, island.mSize[0] + island.mSize[1]);
+	}
+
+	scratch.mVisitedState.resizeAndClear(mNodes.size());
+	scratch.mPriorityQueue.reserve(1024);
+	scratch.mIslandSplitEdges[0].reserve(1024);
+	scratch.mIslandSplitEdges[1].reserve(1024);
+	scratch.mVisitedNodes.reserve(maxIslandSize);
+	scratch.mIslandSplits.forceSize_Unsafe(0);
+
+	//Dirty flags are cleared in finishIslandBreakTasks, together with those of the skipped kinematic and deleted nodes
+	for(PxU32 a = mDirtyGroupStarts[firstGroup], end = mDirtyGroupStarts[lastGroup]; a < end; ++a)
+		processDirtyNode(scratch, mDirtyGroupNodes[a]);
+}
+
+namespace
+{
+	struct IslandSplitComparator
+	{
+		PX_FORCE_INLINE bool operator()(const IslandSplit& split0, const IslandSplit& split1) const
+		{
+			return split0.mRootNode.index() < split1.mRootNode.index();
 		}
+	};
+}
 
-		
+void IslandSim::finishIslandBreakTasks()
+{
+	PX_PROFILE_ZONE("Basic.finishIslandBreakTasks", getContextId());
 
-#if IG_LIMIT_DIRTY_NODES
-		mLastMapIndex = lastMapIndex;
-		if (count < MaxCount)
-			mLastMapIndex = 0;
-#else
-		mDirtyMap.clear();
-#endif
-		
-		//mDirtyNodes.forceSize_Unsafe(0);
+	//The serial path visits dirty nodes in increasing index order and creates each new island as soon as it is found. Each new island
+	//was rooted at the dirty node that split it, so sorting on the root node creates the islands in exactly the same order and they
+	//get the same handles and active island slots.
+	Ps::Array<IslandSplit>& splits = mTraversals[0].mIslandSplits;
+	for(PxU32 a = 1; a < mNbIslandBreakTasks; ++a)
+	{
+		const Ps::Array<IslandSplit>& taskSplits = mTraversals[a].mIslandSplits;
+		for(PxU32 b = 0; b < taskSplits.size(); ++b)
+			splits.pushBack(taskSplits[b]);
 	}
 
+	if(splits.size() > 1)
+		Ps::sort(splits.begin(), splits.size(), IslandSplitComparator());
+
+	for(PxU32 a = 0; a < splits.size(); ++a)
+		createSplitIsland(splits[a]);
+
+	for(PxU32 a = 0; a < mNbIslandBreakTasks; ++a)
+		mTraversals[a].mIslandSplits.forceSize_Unsafe(0);
 
+	{
+		Cm::BitMap::Iterator iter(mDirtyMap);
+		PxU32 dirtyIdx;
+		while((dirtyIdx = iter.getNext()) != Cm::BitMap::Iterator::DONE)
+			mNodes[dirtyIdx].clearDirty();
+	}
+	mDirtyMap.clear();
+
+	for(PxU32 a = 0; a < mDirtyGroupIslands.size(); ++a)
+		mDirtyIslandGroups[mDirtyGroupIslands[a]] = IG_INVALID_ISLAND;
+
+	mNbIslandBreakTasks = 0;
+}
+
+void IslandSim::completeLostEdges(Ps::Array<NodeIndex>& destroyedNodes, bool allowDeactivation, bool permitKinematicDeactivation)
+{
 	{
 		PX_PROFILE_ZONE("Basic.clearDestroyedEdges", getContextId());
 		//Now process the lost edges...
@@ -1885,6 +2140,223 @@ void IslandSim::processLostEdges(Ps::Array<NodeIndex>& destroyedNodes, bool allo
 }
 
 
+PxU32 IslandSim::findSettledIslands(PxReal readyMassFraction, Ps::Array<NodeIndex>& notReadyNodes) const
+{
+	PX_PROFILE_ZONE("Basic.findSettledIslands", getContextId());
+
+	PxU32 nbSettledIslands = 0;
+	for(PxU32 a = 0; a < mActiveIslands.size(); ++a)
+	{
+		const Island& island = mIslands[mActiveIslands[a]];
+
+		//Articulations have their own sleep logic
+		if(island.mSize[Node::eARTICULATION_TYPE])
+			continue;
+
+		PxReal mass = 0.0f, readyMass = 0.0f, energy = 0.0f, threshold = 0.0f;
+		bool allReady = true;
+		NodeIndex nodeId = island.mRootNode;
+		while(nodeId.index() != IG_INVALID_NODE)
+		{
+			const Node& node = mNodes[nodeId.index()];
+			const PxsBodyCore& core = node.mRigidBody->getCore();
+
+			//Same normalized kinetic energy as the per-body sleep check, weighted by mass
+			const PxReal bodyMass = core.inverseMass > 0.0f ? 1.0f/core.inverseMass : 0.0f;
+			const PxVec3 t = core.inverseInertia;
+			const PxVec3 inertia(t.x > 0.f ? 1.0f/t.x : 1.f, t.y > 0.f ? 1.0f/t.y : 1.f, t.z > 0.f ? 1.0f/t.z : 1.f);
+			const PxVec3 angVel = core.body2World.q.rotateInv(core.angularVelocity);
+			const PxReal normalizedEnergy = 0.5f * (angVel.multiply(angVel).dot(inertia) * core.inverseMass + core.linearVelocity.magnitudeSquared());
+
+			mass += bodyMass;
+			energy += bodyMass * normalizedEnergy;
+			threshold += bodyMass * PxReal(1u + core.numCountedInteractions) * core.sleepThreshold;
+			if(node.isReadyForSleeping())
+				readyMass += bodyMass;
+			else
+				allReady = false;
+
+			nodeId = node.mNextNode;
+		}
+
+		//Islands where every node is ready go to sleep anyway
+		if(allReady || readyMass < readyMassFraction * mass || energy >= threshold)
+			continue;
+
+		nbSettledIslands++;
+		nodeId = island.mRootNode;
+		while(nodeId.index() != IG_INVALID_NODE)
+		{
+			const Node& node = mNodes[nodeId.index()];
+			if(!node.isReadyForSleeping())
+				notReadyNodes.pushBack(nodeId);
+			nodeId = node.mNextNode;
+		}
+	}
+	return nbSettledIslands;
+}
+
+namespace
+{
+	struct NodeIndexComparator
+	{
+		PX_FORCE_INLINE bool operator()(const NodeIndex& node0, const NodeIndex& node1) const
+		{
+			return node0.index() < node1.index();
+		}
+	};
+}
+
+PxU32 IslandSim::relinkIsland(IslandId islandId)
+{
+	Island& island = mIslands[islandId];
+	PX_ASSERT(island.mRootNode.isValid());
+
+	//The root node stays first because the hop counts and fast routes lead to it. The other nodes follow in index order.
+	mCompactionNodes.forceSize_Unsafe(0);
+	mIslandIds[island.mRootNode.index()] = islandId;
+	NodeIndex nodeIndex = mNodes[island.mRootNode.index()].mNextNode;
+	while(nodeIndex.isValid())
+	{
+		mIslandIds[nodeIndex.index()] = islandId;
+		mCompactionNodes.pushBack(nodeIndex);
+		nodeIndex = mNodes[nodeIndex.index()].mNextNode;
+	}
+	Ps::sort(mCompactionNodes.begin(), mCompactionNodes.size(), NodeIndexComparator());
+
+	NodeIndex prevIndex = island.mRootNode;
+	for(PxU32 a = 0; a < mCompactionNodes.size(); ++a)
+	{
+		const NodeIndex index = mCompactionNodes[a];
+		mNodes[prevIndex.index()].mNextNode = index;
+		mNodes[index.index()].mPrevNode = prevIndex;
+		prevIndex = index;
+	}
+	mNodes[prevIndex.index()].mNextNode = NodeIndex();
+	island.mLastNode = prevIndex;
+
+	PxU32 work = mCompactionNodes.size() + 1;
+
+	for(PxU32 a = 0; a < Edge::eEDGE_TYPE_COUNT; ++a)
+	{
+		mCompactionEdges.forceSize_Unsafe(0);
+		for(EdgeIndex edgeIndex = island.mFirstEdge[a]; edgeIndex != IG_INVALID_EDGE; edgeIndex = mEdges[edgeIndex].mNextIslandEdge)
+			mCompactionEdges.pushBack(edgeIndex);
+		PX_ASSERT(mCompactionEdges.size() == island.mEdgeCount[a]);
+		if(mCompactionEdges.size() == 0)
+			continue;
+
+		Ps::sort(mCompactionEdges.begin(), mCompactionEdges.size());
+
+		EdgeIndex prevEdge = IG_INVALID_EDGE;
+		for(PxU32 b = 0; b < mCompactionEdges.size(); ++b)
+		{
+			const EdgeIndex edgeIndex = mCompactionEdges[b];
+			mEdges[edgeIndex].mPrevIslandEdge = prevEdge;
+			if(prevEdge != IG_INVALID_EDGE)
+				mEdges[prevEdge].mNextIslandEdge = edgeIndex;
+			else
+				island.mFirstEdge[a] = edgeIndex;
+			prevEdge = edgeIndex;
+		}
+		mEdges[prevEdge].mNextIslandEdge = IG_INVALID_EDGE;
+		island.mLastEdge[a] = prevEdge;
+
+		work += mCompactionEdges.size();
+	}
+	return work;
+}
+
+PxU32 IslandSim::moveIsland(IslandId from, IslandId to)
+{
+	PX_ASSERT(!mIslands[to].mRootNode.isValid());
+
+	mIslands[to] = mIslands[from];
+	mIslandStaticTouchCount[to] = mIslandStaticTouchCount[from];
+	if(mIslandAwake.test(from))
+	{
+		mIslandAwake.set(to);
+		mIslandAwake.reset(from);
+	}
+	else
+	{
+		mIslandAwake.reset(to);
+	}
+
+	const Island& island = mIslands[to];
+	if(island.mActiveIndex != IG_INVALID_ISLAND)
+	{
+		PX_ASSERT(mActiveIslands[island.mActiveIndex] == from);
+		mActiveIslands[island.mActiveIndex] = to;
+	}
+
+	mIslands[from] = Island();
+	mIslandStaticTouchCount[from] = 0;
+
+	//The nodes need their new island id anyway, so the island gets relinked at the same time
+	return relinkIsland(to);
+}
+
+void IslandSim::compactIslands(PxReal freeIslandFraction)
+{
+	mCompactionStats.mNbMovedIslands = 0;
+	mCompactionStats.mNbRelinkedIslands = 0;
+
+	if(mCompactionCursor == IG_INVALID_ISLAND)
+	{
+		const PxU32 nbSlots = mIslandHandles.getTotalHandles();
+		const PxU32 nbFree = mIslandHandles.getNbFreeHandles();
+		mCompactionStats.mNbIslandSlots = nbSlots;
+		mCompactionStats.mNbFreeIslandSlots = nbFree;
+		if(freeIslandFraction <= 0.0f || nbSlots < IG_MIN_NB_ISLANDS_FOR_COMPACTION || PxReal(nbFree) < freeIslandFraction * PxReal(nbSlots))
+			return;
+
+		mCompactionCursor = 0;
+	}
+
+	PX_PROFILE_ZONE("Basic.compactIslands", getContextId());
+
+	PxU32 budget = IG_COMPACTION_BUDGET;
+
+	//Stage 1 - the islands with the highest ids move to the lowest free ids, until no free id is left below the last island
+	mIslandHandles.sortFreeHandles();
+	mIslandHandles.releaseTrailingFreeHandles();
+	while(budget && mIslandHandles.getNbFreeHandles())
+	{
+		const IslandId to = mIslandHandles.getHandle();
+		const IslandId from = mIslandHandles.getTotalHandles() - 1;
+		PX_ASSERT(to < from);
+
+		const PxU32 work = moveIsland(from, to);
+		mIslandHandles.releaseLastHandle();
+		mIslandHandles.releaseTrailingFreeHandles();
+
+		mCompactionStats.mNbMovedIslands++;
+		budget -= PxMin(budget, work);
+	}
+
+	const PxU32 nbSlots = mIslandHandles.getTotalHandles();
+	mIslands.resize(nbSlots);
+	mIslandStaticTouchCount.resize(nbSlots);
+
+	//Stage 2 - the node and edge lists of all islands are relinked in index order. This only starts once the ids are compact.
+	while(budget && mCompactionCursor < nbSlots)
+	{
+		const IslandId islandId = mCompactionCursor++;
+		if(!mIslands[islandId].mRootNode.isValid())
+			continue;
+
+		budget -= PxMin(budget, relinkIsland(islandId));
+		mCompactionStats.mNbRelinkedIslands++;
+	}
+
+	if(mCompactionCursor >= nbSlots)
+		mCompactionCursor = IG_INVALID_ISLAND;
+
+	mCompactionStats.mNbIslandSlots = nbSlots;
+	mCompactionStats.mNbFreeIslandSlots = mIslandHandles.getNbFreeHandles();
+}
+
 IslandId IslandSim::mergeIslands(IslandId island0, IslandId island1, NodeIndex node0, NodeIndex node1)
 {
 	Island& is0 = mIslands[island0];
@@ -44,6 +44,9 @@
 #include "PxvDynamics.h"
 
 #include "PxcNpContactPrepShared.h"
+#include "PxNarrowPhaseBackend.h"
+#include "PsSort.h"
+#include "CmRadixSortBuffered.h"
 
 using namespace physx;
 using namespace physx::shdfnd;
@@ -69,6 +72,21 @@ public:
 
 	virtual void release();
 
+	void setupThreadContext(PxcNpThreadContext& threadContext) const
+	{
+		threadContext.mDt = mDt;
+
+		const bool pcm = mContext->getPCM();
+		threadContext.mPCM = pcm;
+		threadContext.mCreateAveragePoint = mContext->getCreateAveragePoint();
+		threadContext.mContactReuseLinearThreshold = mContext->getContactReuseLinearThreshold();
+		threadContext.mContactReuseCosHalfAngle = mContext->getContactReuseCosHalfAngle();
+		threadContext.mContactReuse = pcm && (threadContext.mContactReuseLinearThreshold > 0.0f || threadContext.mContactReuseCosHalfAngle < 1.0f);
+		threadContext.mContactCache = mContext->getContactCacheFlag();
+		threadContext.mTransformCache = &mContext->getTransformCache();
+		threadContext.mContactDistance = mContext->getContactDistance();
+	}
+
 	/*PX_FORCE_INLINE void insert(PxsContactManager* cm)
 	{
 		PX_ASSERT(mCmCount < BATCH_SIZE);
@@ -86,6 +104,35 @@ protected:
 	PxContactModifyCallback* mCallback;
 };
 
+// Prefetch distances (in pairs) of the two stages of PxsCMDiscreteUpdateTask::processCms. The far stage requests the contact manager,
+// its output and its cache. The near stage reads the work unit and cache loaded by the far stage to request the shape cores,
+// transforms and persistent manifold that contact generation reads.
+static const PxU32 gNpFarPrefetchDistance = 8;
+static const PxU32 gNpNearPrefetchDistance = 4;
+
+static PX_FORCE_INLINE void prefetchPairInputs(const PxcNpThreadContext& context, const PxcNpWorkUnit& unit, const Gu::Cache& cache)
+{
+	Ps::prefetchLine(unit.shapeCore0);
+	Ps::prefetchLine(unit.shapeCore1);
+	Ps::prefetchLine(&context.mTransformCache->getTransformCache(unit.mTransformCache0));
+	Ps::prefetchLine(&context.mTransformCache->getTransformCache(unit.mTransformCache1));
+	if(cache.mCachedData)
+	{
+		Ps::prefetchLine(cache.mCachedData);
+		Ps::prefetchLine(cache.mCachedData, 64);
+	}
+}
+
+// Contact generation functor for PxsCMDiscreteUpdateTask::processCms, running the whole discrete narrow phase of a pair.
+template < void (*NarrowPhase)(PxcNpThreadContext&, const PxcNpWorkUnit&, Gu::Cache&, PxsContactManagerOutput&)>
+struct PxsDiscreteNarrowPhase
+{
+	PX_FORCE_INLINE void operator()(PxcNpThreadContext& context, const PxcNpWorkUnit& unit, Gu::Cache& cache, PxsContactManagerOutput& output, PxU32 /*index*/) const
+	{
+		NarrowPhase(context, unit, cache, output);
+	}
+};
+
 void PxsCMUpdateTask::release()
 {
 	// We used to do Task::release(); here before fixing DE1106 (xbox pure virtual crash)
@@ -187,7 +234,7 @@ public:
 				}
 			}
 	
-			mCallback->onContactModify(mModifiablePairArray, nbModifiableManagers);
+			mCallback->onContactModifyBatch(mModifiablePairArray, nbModifiableManagers, threadContext.getThreadIndex());
 		}
 	
 		for(PxU32 i = 0; i < nbModifiableManagers; ++i)
@@ -390,8 +437,49 @@ public:
 	}
 
 
-	template < void (*NarrowPhase)(PxcNpThreadContext&, const PxcNpWorkUnit&, Gu::Cache&, PxsContactManagerOutput&)>
-	void processCms(PxcNpThreadContext* threadContext)
+	// PT: computes an order in which pairs of the same geometry types are processed back-to-back, so that each contact
+	// function (e.g. the convex-convex GJK/EPA path) runs over all its pairs while its code and data are still in the caches.
+	// The sort key ignores the order of the two types since the narrow phase flips pairs internally. Null entries go last.
+	void groupByGeometryType(PxU32* PX_RESTRICT order) const
+	{
+		const PxU32 nb = mCmCount;
+		PxsContactManager** PX_RESTRICT cmArray = mCmArray;
+
+		const PxU32 nbTypes = PxGeometryType::eGEOMETRY_COUNT;
+		const PxU32 nbKeys = nbTypes * nbTypes + 1;
+		PxU32 histogram[nbKeys];
+		PxMemZero(histogram, sizeof(histogram));
+
+		PX_ALLOCA(keys, PxU8, nb);
+
+		for(PxU32 i=0;i<nb;i++)
+		{
+			PxU32 key = nbKeys - 1;
+			if(cmArray[i])
+			{
+				const PxcNpWorkUnit& unit = cmArray[i]->getWorkUnit();
+				const PxU32 type0 = unit.geomType0;
+				const PxU32 type1 = unit.geomType1;
+				key = type0 <= type1 ? type0 * nbTypes + type1 : type1 * nbTypes + type0;
+			}
+			keys[i] = Ps::to8(key);
+			histogram[key]++;
+		}
+
+		PxU32 offset = 0;
+		for(PxU32 k=0;k<nbKeys;k++)
+		{
+			const PxU32 count = histogram[k];
+			histogram[k] = offset;
+			offset += count;
+		}
+
+		for(PxU32 i=0;i<nb;i++)
+			order[histogram[keys[i]]++] = i;
+	}
+
+	template <typename NarrowPhaseT>
+	void processCms(PxcNpThreadContext* threadContext, const NarrowPhaseT& narrowPhase)
 	{
 		// PT: use local variables to avoid reading class members N times, if possible
 		const PxU32 nb = mCmCount;
@@ -408,17 +496,48 @@ public:
 		PX_ALLOCA(modifiableIndices, PxU32, nb);
 		PxU32 modifiableCount = 0;
 
-		for(PxU32 i=0;i<nb;i++)
+		PX_ALLOCA(order, PxU32, nb);
+		groupByGeometryType(order);
+
+		// prime both stages of the prefetch pipeline
+		for(PxU32 j=0;j<PxMin(nb, gNpFarPrefetchDistance);j++)
+		{
+			const PxU32 i = order[j];
+			if(cmArray[i])
+				Ps::prefetchLine(&cmArray[i]->getWorkUnit());
+			Ps::prefetchLine(&mCmOutputs[i]);
+			Ps::prefetchLine(&mCaches[i]);
+		}
+		for(PxU32 j=0;j<PxMin(nb, gNpNearPrefetchDistance);j++)
+		{
+			const PxU32 i = order[j];
+			if(cmArray[i])
+				prefetchPairInputs(*threadContext, cmArray[i]->getWorkUnit(), mCaches[i]);
+		}
+
+		for(PxU32 j=0;j<nb;j++)
 		{
-			const PxU32 prefetch1 = PxMin(i + 1, nb - 1);
-			const PxU32 prefetch2 = PxMin(i + 2, nb - 1);
+			const PxU32 i = order[j];
+
+			if(j + gNpFarPrefetchDistance < nb)
+			{
+				const PxU32 farIndex = order[j + gNpFarPrefetchDistance];
+				if(cmArray[farIndex])
+				{
+					const PxcNpWorkUnit* farUnit = &cmArray[farIndex]->getWorkUnit();
+					Ps::prefetchLine(farUnit);
+					Ps::prefetchLine(farUnit, sizeof(PxcNpWorkUnit) - 1);
+				}
+				Ps::prefetchLine(&mCmOutputs[farIndex]);
+				Ps::prefetchLine(&mCaches[farIndex]);
+			}
 
-			Ps::prefetchLine(cmArray[prefetch2]);
-			Ps::prefetchLine(&mCmOutputs[prefetch2]);
-			Ps::prefetchLine(cmArray[prefetch1]->getWorkUnit().shapeCore0);
-			Ps::prefetchLine(cmArray[prefetch1]->getWorkUnit().shapeCore1);
-			Ps::prefetchLine(&threadContext->mTransformCache->getTransformCache(cmArray[prefetch1]->getWorkUnit().mTransformCache0));
-			Ps::prefetchLine(&threadContext->mTransformCache->getTransformCache(cmArray[prefetch1]->getWorkUnit().mTransformCache1));
+			if(j + gNpNearPrefetchDistance < nb)
+			{
+				const PxU32 nearIndex = order[j + gNpNearPrefetchDistance];
+				if(cmArray[nearIndex])
+					prefetchPairInputs(*threadContext, cmArray[nearIndex]->getWorkUnit(), mCaches[nearIndex]);
+			}
 
 			PxsContactManager* cm = cmArray[i];			
 
@@ -436,7 +555,7 @@ public:
 
 				Gu::Cache& cache = mCaches[i];
 
-				NarrowPhase(*threadContext, unit, cache, output);
+				narrowPhase(*threadContext, unit, cache, output, i);
 				
 				PxU16 newTouch = Ps::to8(output.statusFlag & PxsContactManagerStatusFlag::eHAS_TOUCH);
 				
@@ -479,6 +598,8 @@ public:
 
 		if(modifiableCount)
 		{
+			// PT: keep reporting modifiable pairs in their original order
+			Ps::sort<PxU32>(modifiableIndices, modifiableCount);
 			runModifiableContactManagers(modifiableIndices, modifiableCount, *threadContext, foundPatchCount, lostPatchCount, maxPatches);
 		}
 
@@ -498,23 +619,21 @@ public:
 
 		PxcNpThreadContext* PX_RESTRICT threadContext = mContext->getNpThreadContext(); 
 	
-		threadContext->mDt = mDt;
-
-		const bool pcm = mContext->getPCM();
-		threadContext->mPCM = pcm;
-		threadContext->mCreateAveragePoint = mContext->getCreateAveragePoint();
-		threadContext->mContactCache = mContext->getContactCacheFlag();
-		threadContext->mTransformCache = &mContext->getTransformCache();
-		threadContext->mContactDistance = mContext->getContactDistance();
+		setupThreadContext(*threadContext);
 
-		if(pcm)
+#if PX_STATIC_PCM_NARROWPHASE
+		PX_ASSERT(threadContext->mPCM);
+		processCms(threadContext, PxsDiscreteNarrowPhase<PxcDiscreteNarrowPhasePCM>());
+#else
+		if(threadContext->mPCM)
 		{
-			processCms<PxcDiscreteNarrowPhasePCM>(threadContext);
+			processCms(threadContext, PxsDiscreteNarrowPhase<PxcDiscreteNarrowPhasePCM>());
 		}
 		else
 		{
-			processCms<PxcDiscreteNarrowPhase>(threadContext);
+			processCms(threadContext, PxsDiscreteNarrowPhase<PxcDiscreteNarrowPhase>());
 		}
+#endif
 
 		mContext->putNpThreadContext(threadContext);
 	}
@@ -525,6 +644,194 @@ public:
 	}
 };
 
+// With a PxNarrowPhaseBackend, a batch of contact managers goes through two tasks. PxsCMBackendUpdateTask gathers the pairs
+// needing new contacts and submits them to the backend. PxsCMBackendFinishTask, its continuation, runs once the backend has
+// completed the batch. It builds the contact streams from the backend's contacts, runs the built-in narrow phase for the pairs
+// the backend does not support, and updates the touch states as PxsCMDiscreteUpdateTask does.
+class PxsCMBackendFinishTask : public PxsCMDiscreteUpdateTask
+{
+public:
+	// values of mSlots for the contact managers not submitted to the backend
+	static const PxU8 NO_NEW_CONTACTS = 0xfe;
+	static const PxU8 UNSUPPORTED = 0xff;
+
+	template < void (*NarrowPhase)(PxcNpThreadContext&, const PxcNpWorkUnit&, Gu::Cache&, PxsContactManagerOutput&)>
+	struct BackendNarrowPhase
+	{
+		BackendNarrowPhase(const PxsCMBackendFinishTask& task) : mTask(task)	{}
+
+		PX_FORCE_INLINE void operator()(PxcNpThreadContext& context, const PxcNpWorkUnit& unit, Gu::Cache& cache, PxsContactManagerOutput& output, PxU32 index) const
+		{
+			const PxU8 slot = mTask.mSlots[index];
+			if(slot == UNSUPPORTED)
+				NarrowPhase(context, unit, cache, output);
+			else if(slot != NO_NEW_CONTACTS)
+				PxcDiscreteNarrowPhaseFinish(context, unit, output, mTask.mContacts[slot], mTask.mNbContacts[slot]);
+		}
+
+		const PxsCMBackendFinishTask& mTask;
+		PX_NOCOPY(BackendNarrowPhase)
+	};
+
+	PxsCMBackendFinishTask(PxsContext* context, PxReal dt, PxsContactManager** cms, PxsContactManagerOutput* cmOutputs, Gu::Cache* caches, PxU32 nbCms,
+		PxContactModifyCallback* callback) :
+		PxsCMDiscreteUpdateTask(context, dt, cms, cmOutputs, caches, nbCms, callback)
+	{
+		PX_COMPILE_TIME_ASSERT(BATCH_SIZE <= NO_NEW_CONTACTS);
+
+		mBatch.nbPairs = 0;
+		mBatch.pairIds = mPairIds;
+		mBatch.geometries0 = mGeometries0;
+		mBatch.geometries1 = mGeometries1;
+		mBatch.poses0 = mPoses0;
+		mBatch.poses1 = mPoses1;
+		mBatch.contactDistances = mContactDistances;
+		mBatch.contacts = mContacts;
+		mBatch.nbContacts = mNbContacts;
+	}
+
+	// fills the batch with the pairs the backend must generate contacts for. The others keep their last contacts, or are
+	// left to the built-in narrow phase.
+	PxU32 gatherPairs(PxcNpThreadContext& threadContext, const PxNarrowPhaseBackend& backend)
+	{
+		PxU32 nbPairs = 0;
+		for(PxU32 i=0;i<mCmCount;i++)
+		{
+			PxsContactManager* cm = mCmArray[i];
+			if(!cm)
+				continue;
+
+			const PxcNpWorkUnit& unit = cm->getWorkUnit();
+			const PxGeometryType::Enum type0 = static_cast<PxGeometryType::Enum>(unit.geomType0);
+			const PxGeometryType::Enum type1 = static_cast<PxGeometryType::Enum>(unit.geomType1);
+			const bool flip = type1<type0;
+
+			if(!backend.supportsPair(flip ? type1 : type0, flip ? type0 : type1))
+			{
+				mSlots[i] = UNSUPPORTED;
+				continue;
+			}
+
+			if(!PxcDiscreteNarrowPhaseMustGenerateContacts(threadContext, unit, mCaches[i], mCmOutputs[i]))
+			{
+				mSlots[i] = NO_NEW_CONTACTS;
+				continue;
+			}
+
+			const PxsShapeCore* shape0 = flip ? unit.shapeCore1 : unit.shapeCore0;
+			const PxsShapeCore* shape1 = flip ? unit.shapeCore0 : unit.shapeCore1;
+			const PxU32 transformCache0 = flip ? unit.mTransformCache1 : unit.mTransformCache0;
+			const PxU32 transformCache1 = flip ? unit.mTransformCache0 : unit.mTransformCache1;
+
+			mPairIds[nbPairs] = cm->getIndex();
+			mGeometries0[nbPairs] = &shape0->geometry.getGeometry();
+			mGeometries1[nbPairs] = &shape1->geometry.getGeometry();
+			mPoses0[nbPairs] = threadContext.mTransformCache->getTransformCache(transformCache0).transform;
+			mPoses1[nbPairs] = threadContext.mTransformCache->getTransformCache(transformCache1).transform;
+			mContactDistances[nbPairs] = threadContext.mNarrowPhaseParams.mContactDistance;
+			mContacts[nbPairs] = NULL;
+			mNbContacts[nbPairs] = 0;
+			mSlots[i] = Ps::to8(nbPairs++);
+		}
+		mBatch.nbPairs = nbPairs;
+		return nbPairs;
+	}
+
+	virtual void runInternal()
+	{
+		PX_PROFILE_ZONE("Sim.narrowPhaseBackendFinish", mContext->getContextId());
+
+		PxcNpThreadContext* PX_RESTRICT threadContext = mContext->getNpThreadContext(); 
+
+		setupThreadContext(*threadContext);
+
+#if PX_STATIC_PCM_NARROWPHASE
+		PX_ASSERT(threadContext->mPCM);
+		processCms(threadContext, BackendNarrowPhase<PxcDiscreteNarrowPhasePCM>(*this));
+#else
+		if(threadContext->mPCM)
+			processCms(threadContext, BackendNarrowPhase<PxcDiscreteNarrowPhasePCM>(*this));
+		else
+			processCms(threadContext, BackendNarrowPhase<PxcDiscreteNarrowPhase>(*this));
+#endif
+
+		mContext->putNpThreadContext(threadContext);
+	}
+
+	virtual const char* getName() const
+	{
+		return "PxsContext.contactManagerBackendFinish";
+	}
+
+	PxNarrowPhaseBackendBatch	mBatch;
+	PxU32						mPairIds[BATCH_SIZE];
+	const PxGeometry*			mGeometries0[BATCH_SIZE];
+	const PxGeometry*			mGeometries1[BATCH_SIZE];
+	PxTransform					mPoses0[BATCH_SIZE];
+	PxTransform					mPoses1[BATCH_SIZE];
+	PxReal						mContactDistances[BATCH_SIZE];
+	const Gu::ContactPoint*		mContacts[BATCH_SIZE];
+	PxU32						mNbContacts[BATCH_SIZE];
+	PxU8						mSlots[BATCH_SIZE];			// batch entry of each contact manager, or one of the values above
+};
+
+class PxsCMBackendUpdateTask : public PxsCMUpdateTask
+{
+public:
+	PxsCMBackendUpdateTask(PxsContext* context, PxReal dt, PxsCMBackendFinishTask& finishTask, PxNarrowPhaseBackend& backend) :
+		PxsCMUpdateTask	(context, dt, NULL, NULL, NULL, 0, NULL),
+		mFinishTask		(finishTask),
+		mBackend		(backend)
+	{
+	}
+
+	virtual void runInternal()
+	{
+		PX_PROFILE_ZONE("Sim.narrowPhaseBackendSubmit", mContext->getContextId());
+
+		PxcNpThreadContext* PX_RESTRICT threadContext = mContext->getNpThreadContext(); 
+
+		setupThreadContext(*threadContext);
+
+		const PxU32 nbPairs = mFinishTask.gatherPairs(*threadContext, mBackend);
+
+		mContext->putNpThreadContext(threadContext);
+
+		// the backend releases this reference once the batch is completed. Our own reference, released after this task, keeps
+		// the finish task from running before the backend got the batch.
+		if(nbPairs)
+		{
+			mFinishTask.addReference();
+			mBackend.submit(mFinishTask.mBatch, mFinishTask);
+		}
+	}
+
+	virtual const char* getName() const
+	{
+		return "PxsContext.contactManagerBackendSubmit";
+	}
+
+private:
+	PxsCMBackendFinishTask&	mFinishTask;
+	PxNarrowPhaseBackend&	mBackend;
+	PX_NOCOPY(PxsCMBackendUpdateTask)
+};
+
+static void startBackendUpdateTasks(PxsContext& context, PxReal dt, PxsContactManager** cms, PxsContactManagerOutput* cmOutputs, Gu::Cache* caches, PxU32 nbCms,
+	PxContactModifyCallback* callback, PxNarrowPhaseBackend& backend, PxBaseTask* continuation)
+{
+	void* finishPtr = context.getTaskPool().allocateNotThreadSafe(sizeof(PxsCMBackendFinishTask));
+	PxsCMBackendFinishTask* finishTask = PX_PLACEMENT_NEW(finishPtr, PxsCMBackendFinishTask)(&context, dt, cms, cmOutputs, caches, nbCms, callback);
+
+	void* updatePtr = context.getTaskPool().allocateNotThreadSafe(sizeof(PxsCMBackendUpdateTask));
+	PxsCMBackendUpdateTask* updateTask = PX_PLACEMENT_NEW(updatePtr, PxsCMBackendUpdateTask)(&context, dt, *finishTask, backend);
+
+	finishTask->setContinuation(continuation);
+	updateTask->setContinuation(finishTask);
+	finishTask->removeReference();
+	updateTask->removeReference();
+}
+
 void PxsNphaseImplementationContext::processContactManager(PxReal dt, PxsContactManagerOutput* cmOutputs, PxBaseTask* continuation)
 {
 		//Iterate all active contact managers
@@ -533,8 +840,16 @@ void PxsNphaseImplementationContext::processContactManager(PxReal dt, PxsContact
 
 	for(PxU32 a = 0; a < nbCmsToProcess;)
 	{
-		void* ptr = mContext.mTaskPool.allocateNotThreadSafe(sizeof(PxsCMDiscreteUpdateTask));
 		PxU32 nbToProcess = PxMin(nbCmsToProcess - a, PxsCMUpdateTask::BATCH_SIZE);
+		if(mBackend)
+		{
+			startBackendUpdateTasks(mContext, dt, mNarrowPhasePairs.mContactManagerMapping.begin() + a, cmOutputs + a, mNarrowPhasePairs.mCaches.begin() + a, nbToProcess,
+				mModifyCallback, *mBackend, continuation);
+			a += nbToProcess;
+			continue;
+		}
+
+		void* ptr = mContext.mTaskPool.allocateNotThreadSafe(sizeof(PxsCMDiscreteUpdateTask));
 		PxsCMDiscreteUpdateTask* task = PX_PLACEMENT_NEW(ptr, PxsCMDiscreteUpdateTask)(&mContext, dt, mNarrowPhasePairs.mContactManagerMapping.begin() + a, 
 			cmOutputs + a, mNarrowPhasePairs.mCaches.begin() + a, nbToProcess, mModifyCallback);
 
@@ -555,8 +870,16 @@ void PxsNphaseImplementationContext::processContactManagerSecondPass(PxReal dt,
 
 	for(PxU32 a = 0; a < nbCmsToProcess;)
 	{
-		void* ptr = mContext.mTaskPool.allocateNotThreadSafe(sizeof(PxsCMDiscreteUpdateTask));
 		PxU32 nbToProcess = PxMin(nbCmsToProcess - a, PxsCMUpdateTask::BATCH_SIZE);
+		if(mBackend)
+		{
+			startBackendUpdateTasks(mContext, dt, mNewNarrowPhasePairs.mContactManagerMapping.begin() + a, mNewNarrowPhasePairs.mOutputContactManagers.begin() + a,
+				mNewNarrowPhasePairs.mCaches.begin() + a, nbToProcess, mModifyCallback, *mBackend, continuation);
+			a += nbToProcess;
+			continue;
+		}
+
+		void* ptr = mContext.mTaskPool.allocateNotThreadSafe(sizeof(PxsCMDiscreteUpdateTask));
 		PxsCMDiscreteUpdateTask* task = PX_PLACEMENT_NEW(ptr, PxsCMDiscreteUpdateTask)(&mContext, dt, mNewNarrowPhasePairs.mContactManagerMapping.begin() + a, 
 			mNewNarrowPhasePairs.mOutputContactManagers.begin() + a, mNewNarrowPhasePairs.mCaches.begin() + a, nbToProcess,
 			mModifyCallback);
@@ -587,6 +910,16 @@ void PxsNphaseImplementationContext::updateContactManager(PxReal dt, bool /*hasB
 	//KS - temporarily put this here. TODO - move somewhere better
 	mContext.mTotalCompressedCacheSize = 0;
 	mContext.mMaxPatches = 0;
+
+	if(mBackend)
+		mBackend->beginStep();
+
+	const PxU32 sortInterval = mContext.getNarrowPhaseSortInterval();
+	if(sortInterval && ++mStepsSinceSort >= sortInterval)
+	{
+		sortContactManagersSpatially();
+		mStepsSinceSort = 0;
+	}
 	
 	processContactManager(dt, mNarrowPhasePairs.mOutputContactManagers.begin(), continuation);
 
@@ -599,14 +932,14 @@ void PxsNphaseImplementationContext::secondPassUpdateContactManager(PxReal dt, P
 	processContactManagerSecondPass(dt, continuation);		
 }
 
-PxsNphaseImplementationContext* PxsNphaseImplementationContext::create(PxsContext& context, IG::IslandSim* islandSim)
+PxsNphaseImplementationContext* PxsNphaseImplementationContext::create(PxsContext& context, IG::IslandSim* islandSim, PxNarrowPhaseBackend* backend)
 {
 	PxsNphaseImplementationContext* npImplContext = reinterpret_cast<PxsNphaseImplementationContext*>(
 		PX_ALLOC(sizeof(PxsNphaseImplementationContext), "PxsNphaseImplementationContext"));
 
 	if (npImplContext)
 	{
-		new(npImplContext) PxsNphaseImplementationContext(context, islandSim);
+		new(npImplContext) PxsNphaseImplementationContext(context, islandSim, 0, backend);
 	}
 
 	return npImplContext;
@@ -906,6 +1239,25 @@ void PxsNphaseImplementationContext::appendContactManagersFallback(PxsContactMan
 
 
 
+// Also updates the np index referenced by the partition edges of touching pairs, which the solver uses to find the contacts.
+static void setNpIndex(IG::IslandSim& islandSim, PxcNpWorkUnit& unit, PxU32 npIndex)
+{
+	unit.mNpIndex = npIndex;
+	if(unit.statusFlags & PxcNpWorkUnitStatusFlag::eHAS_TOUCH)
+	{
+		if(!(unit.flags & PxcNpWorkUnitFlag::eDISABLE_RESPONSE))
+		{
+			PxU32* edgeNodeIndices = islandSim.getEdgeNodeIndexPtr();
+			PartitionEdge* partitionEdge = islandSim.getFirstPartitionEdge(unit.mEdgeIndex);
+			while(partitionEdge)
+			{
+				edgeNodeIndices[partitionEdge->mUniqueIndex] = npIndex;
+				partitionEdge = partitionEdge->mNextPatch;
+			}
+		}
+	}
+}
+
 void PxsNphaseImplementationContext::unregisterContactManagerInternal(PxU32 npIndex, PxsContactManagers& managers, PxsContactManagerOutput* cmOutputs)
 {
 	//TODO - remove this element from the list.
@@ -918,30 +1270,98 @@ void PxsNphaseImplementationContext::unregisterContactManagerInternal(PxU32 npIn
 	PxsContactManager* replaceManager = managers.mContactManagerMapping[replaceIndex];
 
 	mContext.destroyCache(managers.mCaches[index]);
+	if(mBackend)
+		mBackend->releasePair(managers.mContactManagerMapping[index]->getIndex());
 
 	managers.mContactManagerMapping[index] = replaceManager;
 	managers.mCaches[index] = managers.mCaches[replaceIndex];
 	cmOutputs[index] = cmOutputs[replaceIndex];
 
-	PxU32* edgeNodeIndices = mIslandSim->getEdgeNodeIndexPtr();
+	setNpIndex(*mIslandSim, replaceManager->getWorkUnit(), npIndex);
+
+	managers.mContactManagerMapping.forceSize_Unsafe(replaceIndex);
+	managers.mCaches.forceSize_Unsafe(replaceIndex);
+}
 
-	PxcNpWorkUnit& replaceUnit = replaceManager->getWorkUnit();
-	replaceUnit.mNpIndex = npIndex;
-	if(replaceUnit.statusFlags & PxcNpWorkUnitStatusFlag::eHAS_TOUCH)
+// 10 bits per axis
+static PX_FORCE_INLINE PxU32 computeMortonKey(PxU32 x, PxU32 y, PxU32 z)
+{
+	PxU32 key = 0;
+	for(PxU32 bit = 0; bit < 10; ++bit)
 	{
-		if(!(replaceUnit.flags & PxcNpWorkUnitFlag::eDISABLE_RESPONSE))
-		{
-			PartitionEdge* partitionEdge = mIslandSim->getFirstPartitionEdge(replaceUnit.mEdgeIndex);
-			while(partitionEdge)
-			{
-				edgeNodeIndices[partitionEdge->mUniqueIndex] = replaceUnit.mNpIndex;
-				partitionEdge = partitionEdge->mNextPatch;
-			}
-		}
+		key |= ((x >> bit) & 1) << (3 * bit + 2);
+		key |= ((y >> bit) & 1) << (3 * bit + 1);
+		key |= ((z >> bit) & 1) << (3 * bit);
 	}
+	return key;
+}
 
-	managers.mContactManagerMapping.forceSize_Unsafe(replaceIndex);
-	managers.mCaches.forceSize_Unsafe(replaceIndex);
+static PX_FORCE_INLINE PxU32 quantizeMortonCoordinate(PxReal value, PxReal minimum, PxReal scale)
+{
+	return PxMin(PxU32((value - minimum) * scale), PxU32(1023));
+}
+
+// Sorts the persistent pairs by the Morton code of the midpoint of their two shapes, so that the fixed size batches of
+// processContactManager() touch nearby transforms and shapes.
+void PxsNphaseImplementationContext::sortContactManagersSpatially()
+{
+	PxsContactManagers& managers = mNarrowPhasePairs;
+	const PxU32 nbManagers = managers.mContactManagerMapping.size();
+	if(nbManagers <= PxsCMUpdateTask::BATCH_SIZE)
+		return;
+
+	PX_PROFILE_ZONE("Sim.sortNarrowPhasePairs", mContext.mContextID);
+
+	const PxsTransformCache& transformCache = mContext.getTransformCache();
+
+	Ps::Array<PxVec3> midpoints(nbManagers);
+	PxBounds3 bounds = PxBounds3::empty();
+	for(PxU32 i = 0; i < nbManagers; ++i)
+	{
+		const PxcNpWorkUnit& unit = managers.mContactManagerMapping[i]->getWorkUnit();
+		const PxVec3& p0 = transformCache.getTransformCache(unit.mTransformCache0).transform.p;
+		const PxVec3& p1 = transformCache.getTransformCache(unit.mTransformCache1).transform.p;
+		midpoints[i] = (p0 + p1) * 0.5f;
+		bounds.include(midpoints[i]);
+	}
+
+	const PxVec3 extents = bounds.maximum - bounds.minimum;
+	const PxVec3 scale(	extents.x > 0.0f ? 1023.0f / extents.x : 0.0f,
+						extents.y > 0.0f ? 1023.0f / extents.y : 0.0f,
+						extents.z > 0.0f ? 1023.0f / extents.z : 0.0f);
+
+	Ps::Array<PxU32> keys(nbManagers);
+	for(PxU32 i = 0; i < nbManagers; ++i)
+	{
+		const PxVec3& p = midpoints[i];
+		keys[i] = computeMortonKey(	quantizeMortonCoordinate(p.x, bounds.minimum.x, scale.x),
+									quantizeMortonCoordinate(p.y, bounds.minimum.y, scale.y),
+									quantizeMortonCoordinate(p.z, bounds.minimum.z, scale.z));
+	}
+
+	Cm::RadixSortBuffered rs;
+	const PxU32* ranks = rs.Sort(keys.begin(), nbManagers, Cm::RADIX_UNSIGNED).GetRanks();
+
+	// the managers, their caches and their outputs are parallel arrays indexed by the np index, permute them together
+	Ps::Array<PxsContactManager*> sortedManagers(nbManagers);
+	Ps::Array<Gu::Cache> sortedCaches(nbManagers);
+	Ps::Array<PxsContactManagerOutput> sortedOutputs(nbManagers);
+	for(PxU32 i = 0; i < nbManagers; ++i)
+	{
+		const PxU32 src = ranks[i];
+		sortedManagers[i] = managers.mContactManagerMapping[src];
+		sortedCaches[i] = managers.mCaches[src];
+		sortedOutputs[i] = managers.mOutputContactManagers[src];
+	}
+
+	for(PxU32 i = 0; i < nbManagers; ++i)
+	{
+		managers.mContactManagerMapping[i] = sortedManagers[i];
+		managers.mCaches[i] = sortedCaches[i];
+		managers.mOutputContactManagers[i] = sortedOutputs[i];
+		if(ranks[i] != i)
+			setNpIndex(*mIslandSim, sortedManagers[i]->getWorkUnit(), managers.computeId(i));
+	}
 }
 
 PxsContactManagerOutput& PxsNphaseImplementationContext::getNewContactManagerOutput(PxU32 npId)
@@ -992,8 +1412,8 @@ PxsContactManagerOutputIterator PxsNphaseImplementationContext::getContactManage
 }
 
 
-PxvNphaseImplementationContextUsableAsFallback* physx::createNphaseImplementationContext(PxsContext& context, IG::IslandSim* islandSim)
+PxvNphaseImplementationContextUsableAsFallback* physx::createNphaseImplementationContext(PxsContext& context, IG::IslandSim* islandSim, PxNarrowPhaseBackend* backend)
 {
-	return PxsNphaseImplementationContext::create(context, islandSim);
+	return PxsNphaseImplementationContext::create(context, islandSim, backend);
 }
 
@@ -31,6 +31,7 @@
 #include "PxsSimpleIslandManager.h"
 #include "PsSort.h"
 #include "PxsContactManager.h"
+#include "PxsRigidBody.h"
 #include "CmTask.h"
 
 #define IG_SANITY_CHECKS 0
@@ -40,7 +41,14 @@ namespace physx
 namespace IG
 {
 
-	ThirdPassTask::ThirdPassTask(PxU64 contextID, SimpleIslandManager& islandManager, IslandSim& islandSim) : Cm::Task(contextID), mIslandManager(islandManager), mIslandSim(islandSim)
+	ThirdPassTask::ThirdPassTask(PxU64 contextID, SimpleIslandManager& islandManager, IslandSim& islandSim) : Cm::Task(contextID), mIslandManager(islandManager), mIslandSim(islandSim),
+		mFinishTask(contextID, islandManager, islandSim)
+	{
+		for(PxU32 a = 0; a < IG_MAX_NB_ISLAND_BREAK_TASKS; ++a)
+			mIslandBreakTasks[a].init(contextID, islandSim, a);
+	}
+
+	ThirdPassFinishTask::ThirdPassFinishTask(PxU64 contextID, SimpleIslandManager& islandManager, IslandSim& islandSim) : Cm::Task(contextID), mIslandManager(islandManager), mIslandSim(islandSim)
 	{
 	}
 
@@ -61,6 +69,10 @@ namespace IG
 		mSpeculativeThirdPassTask(contextID, *this, mSpeculativeIslandManager),
 		mAccurateThirdPassTask(contextID, *this, mIslandManager),
 		mPostThirdPassTask(contextID, *this),
+		mIslandSleepMassFraction(0.0f),
+		mSettledNodes(PX_DEBUG_EXP("mSettledNodes")),
+		mNbSettledIslands(0),
+		mIslandCompactionThreshold(0.0f),
 		mContextID(contextID)
 {
 	mFirstPartitionEdges.resize(1024);
@@ -201,6 +213,7 @@ void SimpleIslandManager::firstPassIslandGen()
 {
 	PX_PROFILE_ZONE("Basic.firstPassIslandGen", getContextId());
 	mSpeculativeIslandManager.clearDeactivations();
+	mSpeculativeIslandManager.compactIslands(mIslandCompactionThreshold);
 	mSpeculativeIslandManager.wakeIslands();
 	mSpeculativeIslandManager.processNewEdges();
 	mSpeculativeIslandManager.removeDestroyedEdges();
@@ -216,6 +229,7 @@ void SimpleIslandManager::secondPassIslandGen()
 {
 	PX_PROFILE_ZONE("Basic.secondPassIslandGen", getContextId());
 	
+	mIslandManager.compactIslands(mIslandCompactionThreshold);
 	mIslandManager.wakeIslands();
 	mIslandManager.processNewEdges();
 
@@ -255,7 +269,37 @@ void ThirdPassTask::runInternal()
 {
 	PX_PROFILE_ZONE("Basic.thirdPassIslandGen", mIslandSim.getContextId());
 	mIslandSim.removeDestroyedEdges();
-	mIslandSim.processLostEdges(mIslandManager.mDestroyedNodes, true, true, mIslandManager.mMaxDirtyNodesPerFrame);
+	mIslandSim.removeLostEdgesFromIslands();
+
+	//Breaking islands is the expensive part of the third pass. When enough islands lost edges, spread them over several tasks.
+	//The new islands are created by the finish task in the serial order, so the results do not depend on the number of tasks.
+	const PxU32 nbTasks = mIslandSim.prepareIslandBreakTasks(getTaskManager()->getCpuDispatcher()->getWorkerCount());
+	if(!nbTasks)
+	{
+		mIslandSim.findPathsAndBreakIslands(mIslandManager.mMaxDirtyNodesPerFrame);
+		mIslandSim.completeLostEdges(mIslandManager.mDestroyedNodes, true, true);
+		return;
+	}
+
+	mFinishTask.setContinuation(getContinuation());
+	for(PxU32 a = 0; a < nbTasks; ++a)
+	{
+		mIslandBreakTasks[a].setContinuation(&mFinishTask);
+		mIslandBreakTasks[a].removeReference();
+	}
+	mFinishTask.removeReference();
+}
+
+void ThirdPassFinishTask::runInternal()
+{
+	PX_PROFILE_ZONE("Basic.thirdPassIslandGenFinish", mIslandSim.getContextId());
+	mIslandSim.finishIslandBreakTasks();
+	mIslandSim.completeLostEdges(mIslandManager.mDestroyedNodes, true, true);
+}
+
+void IslandBreakTask::runInternal()
+{
+	mIslandSim->runIslandBreakTask(mTaskIndex);
 }
 
 void PostThirdPassTask::runInternal()
@@ -275,8 +319,37 @@ void PostThirdPassTask::runInternal()
 	PX_ASSERT(mIslandManager.validateDeactivations());
 }
 
+void SimpleIslandManager::markSettledIslands()
+{
+	//Nodes marked last time whose island stayed awake (e.g. it was touched by an active kinematic) go back to the solver's opinion
+	for(PxU32 a = 0; a < mSettledNodes.size(); ++a)
+	{
+		const NodeIndex index = mSettledNodes[a];
+		const Node& node = mIslandManager.getNode(index);
+		if(node.isActive() && node.getRigidBody()->getCore().wakeCounter > 0.0f)
+		{
+			mIslandManager.activateNode(index);
+			if(mSpeculativeIslandManager.getNode(index).isActive())
+				mSpeculativeIslandManager.activateNode(index);
+		}
+	}
+	mSettledNodes.forceSize_Unsafe(0);
+	mNbSettledIslands = 0;
+
+	if(mIslandSleepMassFraction <= 0.0f)
+		return;
+
+	//The islands are found in the accurate island sim and the nodes marked ready in both sims, just like bodies whose wake counter
+	//reached zero, so the speculative sim never deactivates more than the accurate one. The IG decision is authoritative: the
+	//remaining wake counters and velocities are cleared when the bodies get deactivated.
+	mNbSettledIslands = mIslandManager.findSettledIslands(mIslandSleepMassFraction, mSettledNodes);
+	for(PxU32 a = 0; a < mSettledNodes.size(); ++a)
+		deactivateNode(mSettledNodes[a]);
+}
+
 void SimpleIslandManager::thirdPassIslandGen(PxBaseTask* continuation)
 {
+	markSettledIslands();
 
 	mIslandManager.clearDeactivations();
 
@@ -154,6 +154,27 @@ class BroadPhaseBase
 		return false;	
 	}
 
+	/**
+	\brief Enables or disables automatic broad-phase regions.
+
+	When enabled, the broad-phase starts with a single region covering the world bounds, and then subdivides or
+	merges regions automatically during updates, so that the number of objects per region stays close to the
+	provided limit. Automatic regions coexist with user-defined regions. Objects outside of the world bounds
+	are still reported as out-of-bounds.
+
+	Calling the function again replaces the previous automatic regions.
+
+	\param[in]	worldBounds				Bounds of the initial region
+	\param[in]	maxNbObjectsPerRegion	Number of objects above which a region gets subdivided, or 0 to disable automatic regions
+	\return True if success
+	*/
+	virtual	bool					setAutoRegions(const PxBounds3& worldBounds, PxU32 maxNbObjectsPerRegion)
+	{
+		PX_UNUSED(worldBounds);
+		PX_UNUSED(maxNbObjectsPerRegion);
+		return false;
+	}
+
 	/*
 	\brief Return the number of objects that are not in any region.
 	*/
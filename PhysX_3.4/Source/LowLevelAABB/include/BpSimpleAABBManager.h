@@ -143,6 +143,13 @@ namespace Bp
 			mHasAnythingChanged = true;
 		}
 
+		// For shapes whose mesh-scaled local bounds are cached, see Gu::computeScaledLocalBounds
+		PX_FORCE_INLINE void updateBoundsFromScaledLocalBounds(const PxTransform& transform, const PxVec3& center, const PxVec3& extents, PxU32 index)
+		{
+			Gu::computeBoundsFromScaledLocalBounds(mBounds[index], center, extents, transform);
+			mHasAnythingChanged = true;
+		}
+
 		PX_FORCE_INLINE const PxBounds3& getBounds(PxU32 index) const
 		{
 			return mBounds[index];
@@ -375,6 +382,11 @@ namespace Bp
 											PxBaseTask* continuation,
 											PxBaseTask* narrowPhaseUnlockTask);
 
+		// Skips the broad phase for the current step when no volume was added or removed. Changed handles are left in
+		// the changed map so that the next updateAABBsAndBP() sends them to the broad phase. Returns false if the update
+		// cannot be deferred, in which case updateAABBsAndBP() must be called as usual.
+		bool			deferUpdate(bool hasContactDistanceUpdated, PxBaseTask* narrowPhaseUnlockTask);
+
 		void			finalizeUpdate(		PxU32 numCpuTasks,
 											PxcScratchAllocator* scratchAllocator,
 											PxBaseTask* continuation,
@@ -0,0 +1,133 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#ifndef BP_BOX_PRUNING_AVX2_H
+#define BP_BOX_PRUNING_AVX2_H
+
+#include "BpBroadPhaseMBPCommon.h"
+#include "PsBitUtils.h"
+
+// PT: AVX2 version of the box-pruning inner loop, shared by MBP and the aggregates. The rest of the code is compiled
+// for SSE2, so the kernel uses per-function target attributes and is only called when the CPU supports AVX2.
+#if PX_INTEL_FAMILY && !defined(PX_SIMD_DISABLED) && ((PX_WINDOWS_FAMILY && PX_VC >= 12) || ((PX_LINUX || PX_OSX) && PX_GCC_FAMILY))
+	#define BP_AVX2_OVERLAP
+#endif
+
+#ifdef BP_AVX2_OVERLAP
+
+#if PX_WINDOWS_FAMILY
+	#include <intrin.h>
+	#define BP_AVX2_TARGET
+#else
+	#define BP_AVX2_TARGET	__attribute__((target("avx2")))
+#endif
+#include <immintrin.h>
+
+namespace physx
+{
+namespace Bp
+{
+	static bool detectAVX2()
+	{
+#if PX_WINDOWS_FAMILY
+		// PT: checks that the OS uses XSAVE/XRSTOR and saves YMM registers, and that the CPU supports AVX and AVX2
+		int cpuInfo[4];
+		__cpuid(cpuInfo, 1);
+		const int avxFlags = 3<<27;
+		if((cpuInfo[2] & avxFlags)!=avxFlags)
+			return false;
+
+		if((_xgetbv(0) & 0x6)!=0x6)
+			return false;
+
+		__cpuidex(cpuInfo, 7, 0);
+		return (cpuInfo[1] & (1<<5))!=0;
+#else
+		// PT: this also checks that the OS saves YMM registers
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2")!=0;
+#endif
+	}
+
+	static const bool gHasAVX2 = detectAVX2();
+
+	// PT: tests box0 against candidate boxes starting at index1, 8 boxes per iteration, using the same overlap test as
+	// the SSE2 code (SIMD_OVERLAP_TEST). Candidates must be sorted along X. Overlapping candidates are reported in
+	// increasing order through callback(index). The kernel only reads boxes below nbBoxes, and returns the index of the
+	// first candidate it did not process. Callers finish the job with their regular scalar loop starting from there,
+	// which immediately stops if the kernel already reached a box beyond box0's max X.
+	template<class Callback>
+	BP_AVX2_TARGET static PxU32 findOverlapsAVX2(const SIMD_AABB& box0, const SIMD_AABB* PX_RESTRICT boxes, PxU32 index1, const PxU32 nbBoxes, Callback& callback)
+	{
+		// PT: encoded bounds use 31 bits so signed comparisons are fine, as in the SSE2 code
+		const __m256i maxX0 = _mm256_set1_epi32(int(box0.mMaxX));
+		const __m256i minY0 = _mm256_set1_epi32(int(box0.mMinY));
+		const __m256i minZ0 = _mm256_set1_epi32(int(box0.mMinZ));
+		const __m256i maxY0 = _mm256_set1_epi32(int(box0.mMaxY));
+		const __m256i maxZ0 = _mm256_set1_epi32(int(box0.mMaxZ));
+		const __m256i offsets = _mm256_setr_epi32(0, 6, 12, 18, 24, 30, 36, 42);	// PT: SIMD_AABB is 6 dwords
+
+		while(index1+8<=nbBoxes)
+		{
+			const int* PX_RESTRICT base = reinterpret_cast<const int*>(&boxes[index1].mMinX);
+			const __m256i minX1 = _mm256_i32gather_epi32(base, offsets, 4);
+			const __m256i minY1 = _mm256_i32gather_epi32(base + 2, offsets, 4);
+			const __m256i minZ1 = _mm256_i32gather_epi32(base + 3, offsets, 4);
+			const __m256i maxY1 = _mm256_i32gather_epi32(base + 4, offsets, 4);
+			const __m256i maxZ1 = _mm256_i32gather_epi32(base + 5, offsets, 4);
+
+			const __m256i separated = _mm256_or_si256(_mm256_cmpgt_epi32(minY1, maxY0), _mm256_cmpgt_epi32(minZ1, maxZ0));
+			const __m256i overlapping = _mm256_and_si256(_mm256_cmpgt_epi32(maxY1, minY0), _mm256_cmpgt_epi32(maxZ1, minZ0));
+			PxU32 mask = PxU32(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_andnot_si256(separated, overlapping))));
+
+			// PT: candidates are sorted so everything after the first box beyond the limit is beyond as well
+			const PxU32 stopMask = PxU32(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(minX1, maxX0))));
+			const PxU32 nbValid = stopMask ? Ps::lowestSetBitUnsafe(stopMask) : 8;
+			mask &= (1<<nbValid)-1;
+
+			while(mask)
+			{
+				const PxU32 bit = Ps::lowestSetBitUnsafe(mask);
+				callback(index1 + bit);
+				mask &= mask-1;
+			}
+
+			index1 += nbValid;
+			if(stopMask)
+				break;
+		}
+		return index1;
+	}
+}
+}
+
+#endif
+
+#endif // BP_BOX_PRUNING_AVX2_H
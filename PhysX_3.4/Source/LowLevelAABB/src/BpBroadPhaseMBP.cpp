@@ -29,7 +29,10 @@
 
 #include "foundation/PxProfiler.h"
 #include "PsHash.h"
+#include "PsAtomic.h"
+#include "PsSort.h"
 #include "BpBroadPhaseMBP.h"
+#include "BpBoxPruningAVX2.h"
 #include "CmRadixSortBuffered.h"
 #include "CmUtils.h"
 #include "PsUtilities.h"
@@ -81,6 +84,7 @@ using namespace Cm;
 #define DELETEARRAY(x)		if (x) { delete []x;	x = NULL; }
 
 #define	INVALID_ID	0xffffffff
+#define MBP_MIN_COST_PER_REGION_TASK	256	// PT: minimum number of boxes to process per region task
 
 	typedef	MBP_Index*	MBP_Mapping;
 
@@ -361,9 +365,18 @@ static PX_FORCE_INLINE void clearBit(BitArray& bitmap, MBP_ObjectIndex objectInd
 						void				purge();
 						void				shrinkMemory();
 
+						void				resetPairs();
+
 						MBP_Pair*			addPair						(PxU32 id0, PxU32 id1);
+						MBP_Pair*			addPairNoFiltering			(PxU32 id0, PxU32 id1);
 						bool				removePair					(PxU32 id0, PxU32 id1);
 						bool				computeCreatedDeletedPairs	(const MBP_Object* objects, BroadPhaseMBP* mbp, const BitArray& updated, const BitArray& removed);
+
+						// lock-free insertion of already filtered pairs from several threads, see MBP::mergeTaskPairs()
+						void				beginConcurrentInsert		(PxU32 nbExtraPairs);
+						bool				addPairConcurrent			(PxU32 id0, PxU32 id1);
+						void				endConcurrentInsert			();
+						void				sortNewPairs				(PxU32 firstNewPair);
 		PX_FORCE_INLINE	PxU32				getPairIndex				(const MBP_Pair* pair)		const
 											{
 												return (PxU32((size_t(pair) - size_t(mActivePairs)))/sizeof(MBP_Pair));
@@ -376,6 +389,7 @@ static PX_FORCE_INLINE void clearBit(BitArray& bitmap, MBP_ObjectIndex objectInd
 						PxU32*				mNext;
 						MBP_Pair*			mActivePairs;
 						PxU32				mReservedMemory;
+						volatile PxI32		mNbConcurrentPairs;	// slot allocator of addPairConcurrent()
 
 						const Bp::FilterGroup::Enum*	mGroups;
 						const MBP_Object*				mObjects;
@@ -398,6 +412,7 @@ static PX_FORCE_INLINE void clearBit(BitArray& bitmap, MBP_ObjectIndex objectInd
 					~MBPOS_TmpBuffers();
 
 		void		allocateSleeping(PxU32 nbSleeping, PxU32 nbSentinels);
+		void		growSleeping(PxU32 nbSleeping, PxU32 nbSentinels, PxU32 nbToKeep);
 		void		allocateUpdated(PxU32 nbUpdated, PxU32 nbSentinels);
 
 		// PT: wtf, why doesn't the 128 version compile?
@@ -500,12 +515,21 @@ static PX_FORCE_INLINE void clearBit(BitArray& bitmap, MBP_ObjectIndex objectInd
 		RadixSortBuffered	mRS;
 		bool				mNeedsSorting;
 		bool				mNeedsSortingSleeping;
+		// PT: the sorted sleeping boxes are kept from one pass to the next (the "frozen" layer). When objects wake up or fall
+		// asleep the layer is patched using the sorted list of objects updated during the previous pass, instead of re-sorting it.
+		bool				mSleepingBoxesValid;	// True if mTmpBuffers contains the sorted sleeping boxes of the last pass
+		PxU32				mNbSleepingBoxes;		// Number of sorted sleeping boxes in mTmpBuffers
+		MBP_Index*			mPrevUpdated;			// Objects updated during the last pass, sorted by their boxes' mMinX
+		PxU32				mNbPrevUpdated;
+		PxU32				mMaxNbPrevUpdated;
 				
 		MBPOS_TmpBuffers	mTmpBuffers;
 
 		void				optimizeMemory();
 		void				resizeObjects();
 		void				staticSort();
+		bool				updateSleepingBoxes(MBPOS_TmpBuffers& buffers, PxU32 nbUpdated, PxU32 nbNonUpdated);
+		void				savePrevUpdated(const MBP_Index* PX_RESTRICT inToOut_Dynamic, PxU32 nbUpdated);
 		void				preparePruning(MBPOS_TmpBuffers& buffers);
 		void				prepareBIPPruning(const MBPOS_TmpBuffers& buffers);
 	};
@@ -537,6 +561,8 @@ struct RegionData : public Ps::UserAllocated
 						PxU32					addRegion(const PxBroadPhaseRegion& region, bool populateRegion);
 						bool					removeRegion(PxU32 handle);
 						const Region*			getRegion(PxU32 i)		const;
+						PxU32					getNbFreeRegionSlots()	const;
+						void					clearFullyInsideFlags(PxU32 handle);
 		PX_FORCE_INLINE	PxU32					getNbRegions()			const	{ return mNbRegions;	}
 
 						MBP_Handle				addObject(const MBP_AABB& box, BpHandle userID, bool isStatic);
@@ -550,6 +576,14 @@ struct RegionData : public Ps::UserAllocated
 	, const bool* PX_RESTRICT lut
 #endif
 							);
+						PxU32					partitionRegions(PxU32 maxNbTasks, PxU32* PX_RESTRICT regionStarts)	const;
+						void					findOverlaps(PxU32 taskIndex, PxU32 startRegion, PxU32 endRegion, const Bp::FilterGroup::Enum* PX_RESTRICT groups
+#ifdef BP_FILTERING_USES_TYPE_IN_GROUP
+	, const bool* PX_RESTRICT lut
+#endif
+							);
+						void					prepareTaskPairs();
+						void					mergeTaskPairs(PxU32 nbTasks);
 						PxU32					finalize(BroadPhaseMBP* mbp);
 						void					shiftOrigin(const PxVec3& shift);
 
@@ -561,6 +595,9 @@ struct RegionData : public Ps::UserAllocated
 						Ps::Array<RegionData>	mRegions;
 						Ps::Array<MBP_Object>	mMBP_Objects;
 						MBP_PairManager			mPairManager;
+						MBP_PairManager			mTaskPairManagers[MBP_MAX_NB_REGION_TASKS];	// PT: per-task overlaps of multi-threaded updates
+						PxU32					mNbTaskOverflowPairs[MBP_MAX_NB_REGION_TASKS];	// per-task pairs that did not fit in mPairManager
+						PxU32					mFirstNewPair;	// number of pairs in mPairManager before the region tasks ran
 
 						BitArray				mUpdatedObjects;	// Indexed by MBP_ObjectIndex
 						BitArray				mRemoved;			// Indexed by MBP_ObjectIndex
@@ -640,6 +677,7 @@ MBP_PairManager::MBP_PairManager() :
 	mNext			(NULL),
 	mActivePairs	(NULL),
 	mReservedMemory (0),
+	mNbConcurrentPairs	(0),
 	mGroups			(NULL),
 	mObjects		(NULL)
 #ifdef BP_FILTERING_USES_TYPE_IN_GROUP
@@ -657,6 +695,16 @@ MBP_PairManager::~MBP_PairManager()
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void MBP_PairManager::resetPairs()
+{
+	// PT: keeps the memory around for next frame
+	if(mHashTable)
+		storeDwords(mHashTable, mHashSize, INVALID_ID);
+	mNbActivePairs = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void MBP_PairManager::purge()
 {
 	MBP_FREE(mNext);
@@ -722,6 +770,13 @@ MBP_Pair* MBP_PairManager::addPair(PxU32 id0, PxU32 id1)
 			return NULL;
 	}
 
+	return addPairNoFiltering(id0, id1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+MBP_Pair* MBP_PairManager::addPairNoFiltering(PxU32 id0, PxU32 id1)
+{
 	// Order the ids
 	sort(id0, id1);
 
@@ -762,6 +817,127 @@ MBP_Pair* MBP_PairManager::addPair(PxU32 id0, PxU32 id1)
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// makes room for nbExtraPairs new pairs, since the arrays cannot be reallocated while pairs are inserted concurrently.
+void MBP_PairManager::beginConcurrentInsert(PxU32 nbExtraPairs)
+{
+	const PxU32 requiredSize = Ps::nextPowerOfTwo(mNbActivePairs + nbExtraPairs);
+	if(requiredSize > mHashSize)
+	{
+		mHashSize = requiredSize;
+		mMask = mHashSize-1;
+		reallocPairs();
+	}
+	// keep the headroom for the next frames, shrinkMemory() would otherwise free it after each update
+	mReservedMemory = PxMax(mReservedMemory, mHashSize);
+	mNbConcurrentPairs = PxI32(mNbActivePairs);
+}
+
+// the pair is either found and marked as updated, or appended and pushed at the head of its hash chain with a CAS.
+// Linked entries are never modified during the concurrent phase, so a chain can be walked while other threads push.
+// When two threads insert the same pair at the same time, the loser sees the winner's entry when its CAS fails and
+// turns its own slot into a hole (ids set to INVALID_ID), which sortNewPairs() drops. Returns false when the arrays
+// are full, in which case the caller keeps the pair and adds it serially after endConcurrentInsert().
+bool MBP_PairManager::addPairConcurrent(PxU32 id0, PxU32 id1)
+{
+	PX_ASSERT(id0<id1);
+	volatile PxI32* head = reinterpret_cast<volatile PxI32*>(mHashTable + (hash(id0, id1) & mMask));
+
+	MBP_Pair* PX_RESTRICT activePairs = mActivePairs;
+	const PxU32* PX_RESTRICT next = mNext;
+
+	PxU32 offset = PxU32(*head);
+	PxU32 end = INVALID_ID;
+	PxU32 pairIndex = INVALID_ID;
+	for(;;)
+	{
+		// only the entries pushed since the last look need to be checked
+		for(PxU32 i=offset; i!=end; i=next[i])
+		{
+			if(!differentPair(activePairs[i], id0, id1))
+			{
+				activePairs[i].isUpdated = true;	// benign race, all threads write the same value
+				if(pairIndex!=INVALID_ID)
+				{
+					activePairs[pairIndex].id0 = INVALID_ID;
+					activePairs[pairIndex].id1 = INVALID_ID;
+				}
+				return true;
+			}
+		}
+
+		if(pairIndex==INVALID_ID)
+		{
+			pairIndex = PxU32(Ps::atomicIncrement(&mNbConcurrentPairs)) - 1;
+			if(pairIndex>=mHashSize)
+				return false;
+
+			MBP_Pair* PX_RESTRICT p = &activePairs[pairIndex];
+			p->id0		= id0;
+			p->id1		= id1;
+			p->isNew	= true;
+			p->isUpdated= false;
+		}
+
+		mNext[pairIndex] = offset;
+		const PxU32 previous = PxU32(Ps::atomicCompareExchange(head, PxI32(pairIndex), PxI32(offset)));
+		if(previous==offset)
+			return true;
+
+		end = offset;
+		offset = previous;
+	}
+}
+
+void MBP_PairManager::endConcurrentInsert()
+{
+	// the slot allocator overshoots the array size once per failed insertion
+	mNbActivePairs = PxMin(PxU32(mNbConcurrentPairs), mHashSize);
+}
+
+namespace
+{
+	struct PairIdsLess
+	{
+		PX_FORCE_INLINE bool operator()(const MBP_Pair& a, const MBP_Pair& b) const
+		{
+			return a.id0<b.id0 || (a.id0==b.id0 && a.id1<b.id1);
+		}
+	};
+}
+
+// concurrent insertion appends the new pairs in a thread-dependent order. They are sorted by ids here, so that the
+// created pairs are reported in the same order from one run to the next, and the holes go to the end of the array
+// where they are dropped. New pairs are always at the head of their hash chain, so unlinking them only walks prefixes.
+void MBP_PairManager::sortNewPairs(PxU32 firstNewPair)
+{
+	if(firstNewPair>=mNbActivePairs)
+		return;
+
+	for(PxU32 i=firstNewPair;i<mNbActivePairs;i++)
+	{
+		// holes are hashed like any other pair, in case reallocPairs() linked them
+		const PxU32 hashValue = hash(mActivePairs[i].id0, mActivePairs[i].id1) & mMask;
+		PxU32 offset = mHashTable[hashValue];
+		while(offset!=INVALID_ID && offset>=firstNewPair)
+			offset = mNext[offset];
+		mHashTable[hashValue] = offset;
+	}
+
+	Ps::sort(mActivePairs + firstNewPair, mNbActivePairs - firstNewPair, PairIdsLess());
+
+	while(mNbActivePairs>firstNewPair && mActivePairs[mNbActivePairs-1].id0==INVALID_ID)
+		mNbActivePairs--;
+
+	for(PxU32 i=firstNewPair;i<mNbActivePairs;i++)
+	{
+		const PxU32 hashValue = hash(mActivePairs[i].id0, mActivePairs[i].id1) & mMask;
+		mNext[i] = mHashTable[hashValue];
+		mHashTable[hashValue] = i;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void MBP_PairManager::removePair(PxU32 /*id0*/, PxU32 /*id1*/, PxU32 hashValue, PxU32 pairIndex)
 {
 	// Walk the hash table to fix mNext
@@ -985,13 +1161,19 @@ Region::Region() :
 	mNbUpdatedBoxes			(0),
 	mPrevNbUpdatedBoxes		(0),
 	mNeedsSorting			(false),
-	mNeedsSortingSleeping	(true)
+	mNeedsSortingSleeping	(true),
+	mSleepingBoxesValid		(false),
+	mNbSleepingBoxes		(0),
+	mPrevUpdated			(NULL),
+	mNbPrevUpdated			(0),
+	mMaxNbPrevUpdated		(0)
 {
 }
 
 Region::~Region()
 {
 	DELETEARRAY(mObjects);
+	MBP_FREE(mPrevUpdated);
 	MBP_FREE(mPosList);
 	MBP_FREE(mInToOut_Dynamic);
 	MBP_FREE(mInToOut_Static);
@@ -1429,6 +1611,9 @@ void Region::setBounds(MBP_Index handle, const MBP_AABB& bounds)
 	{
 		PX_ASSERT(object.mIndex < mNbDynamicBoxes);
 		mDynamicBoxes[object.mIndex] = bounds;
+		// PT: the box may be in the frozen layer, which must then be rebuilt
+		mSleepingBoxesValid = false;
+		mNeedsSortingSleeping = true;
 	}
 	else
 	{
@@ -1505,6 +1690,44 @@ static PX_FORCE_INLINE void outputPair(	MBP_PairManager& pairManager,
 	pairManager.addPair(id0, id1);
 }
 
+#if defined(MBP_SIMD_OVERLAP) && defined(BP_AVX2_OVERLAP)
+	#define MBP_AVX2_OVERLAP
+
+	// PT: box0 comes from the first array, candidates from the second one. The "swapped" version keeps the same
+	// outputPair() arguments as the scalar loops that prune the second array against the first one.
+	template<bool swapped>
+	struct MBPOverlapCallback
+	{
+		PX_FORCE_INLINE	MBPOverlapCallback(MBP_PairManager& pairManager, PxU32 index0, const MBP_Index* PX_RESTRICT inToOut0, const MBP_Index* PX_RESTRICT inToOut1, const MBPEntry* PX_RESTRICT objects) :
+			mPairManager(pairManager), mIndex0(index0), mInToOut0(inToOut0), mInToOut1(inToOut1), mObjects(objects)	{}
+
+		PX_FORCE_INLINE	void	operator()(PxU32 index1)
+		{
+			if(swapped)
+				outputPair(mPairManager, index1, mIndex0, mInToOut1, mInToOut0, mObjects);
+			else
+				outputPair(mPairManager, mIndex0, index1, mInToOut0, mInToOut1, mObjects);
+		}
+
+		MBP_PairManager&				mPairManager;
+		const PxU32						mIndex0;
+		const MBP_Index* PX_RESTRICT	mInToOut0;
+		const MBP_Index* PX_RESTRICT	mInToOut1;
+		const MBPEntry* PX_RESTRICT		mObjects;
+
+		PX_NOCOPY(MBPOverlapCallback)
+	};
+
+	#define MBP_AVX2_PRUNE(swapped, boxes, nbBoxes, inToOut0, inToOut1, objects)								\
+	if(gHasAVX2)																							\
+	{																										\
+		MBPOverlapCallback<swapped> callback(*pairManager, index0, inToOut0, inToOut1, objects);			\
+		index1 = findOverlapsAVX2(box0, boxes, index1, nbBoxes, callback);									\
+	}
+#else
+	#define MBP_AVX2_PRUNE(swapped, boxes, nbBoxes, inToOut0, inToOut1, objects)
+#endif
+
 MBPOS_TmpBuffers::MBPOS_TmpBuffers() :
 	mNbSleeping					(0),
 	mNbUpdated					(0),
@@ -1553,6 +1776,41 @@ void MBPOS_TmpBuffers::allocateSleeping(PxU32 nbSleeping, PxU32 nbSentinels)
 	}
 }
 
+// Same as allocateSleeping but preserves the first 'nbToKeep' entries
+void MBPOS_TmpBuffers::growSleeping(PxU32 nbSleeping, PxU32 nbSentinels, PxU32 nbToKeep)
+{
+	PX_ASSERT(nbToKeep<=mNbSleeping);
+	if(nbSleeping>mNbSleeping)
+	{
+		if(nbSleeping+nbSentinels<=STACK_BUFFER_SIZE)
+		{
+			// PT: the previous buffers were either empty or already on the stack
+			PX_ASSERT(!mSleepingDynamicBoxes || mSleepingDynamicBoxes==mSleepingDynamicBoxes_Stack);
+			mSleepingDynamicBoxes = mSleepingDynamicBoxes_Stack;
+			mInToOut_Dynamic_Sleeping = mInToOut_Dynamic_Sleeping_Stack;
+		}
+		else
+		{
+			MBP_AABB* newBoxes = PX_NEW_TEMP(MBP_AABB)[nbSleeping+nbSentinels];
+			MBP_Index* newMapping = reinterpret_cast<MBP_Index*>(MBP_ALLOC(sizeof(MBP_Index)*nbSleeping));
+			if(nbToKeep)
+			{
+				PxMemCopy(newBoxes, mSleepingDynamicBoxes, nbToKeep*sizeof(MBP_AABB));
+				PxMemCopy(newMapping, mInToOut_Dynamic_Sleeping, nbToKeep*sizeof(MBP_Index));
+			}
+
+			if(mInToOut_Dynamic_Sleeping!=mInToOut_Dynamic_Sleeping_Stack)
+				MBP_FREE(mInToOut_Dynamic_Sleeping);
+			if(mSleepingDynamicBoxes!=mSleepingDynamicBoxes_Stack)
+				DELETEARRAY(mSleepingDynamicBoxes);
+
+			mSleepingDynamicBoxes = newBoxes;
+			mInToOut_Dynamic_Sleeping = newMapping;
+		}
+		mNbSleeping = nbSleeping;
+	}
+}
+
 void MBPOS_TmpBuffers::allocateUpdated(PxU32 nbUpdated, PxU32 nbSentinels)
 {
 	if(nbUpdated>mNbUpdated)
@@ -1569,6 +1827,101 @@ void MBPOS_TmpBuffers::allocateUpdated(PxU32 nbUpdated, PxU32 nbSentinels)
 	}
 }
 
+static PX_FORCE_INLINE bool isSleepingDynamic(const MBPEntry& object, PxU32 nbUpdated)
+{
+	// PT: updated boxes are always first in the dynamic array
+	return object.mMBPHandle!=INVALID_ID && !object.isStatic() && object.mIndex>=nbUpdated;
+}
+
+// PT: patches the sorted sleeping boxes of the previous pass instead of re-sorting all of them. Boxes that have been
+// updated or removed since then are dropped, and boxes updated during the previous pass but not during this one are
+// merged in. The latter are taken from mPrevUpdated, which is already sorted. Returns false if the result would not
+// contain exactly the current sleeping boxes, in which case the caller must re-sort them.
+bool Region::updateSleepingBoxes(MBPOS_TmpBuffers& buffers, PxU32 nbUpdated, PxU32 nbNonUpdated)
+{
+	PX_ASSERT(mSleepingBoxesValid);
+	const MBPEntry* PX_RESTRICT objects = mObjects;
+
+	PxU32 nbKept = 0;
+	{
+		MBP_AABB* PX_RESTRICT sleepingBoxes = buffers.mSleepingDynamicBoxes;
+		MBP_Index* PX_RESTRICT sleepingMapping = buffers.mInToOut_Dynamic_Sleeping;
+		const PxU32 nbSleeping = mNbSleepingBoxes;
+		for(PxU32 i=0;i<nbSleeping;i++)
+		{
+			if(isSleepingDynamic(objects[sleepingMapping[i]], nbUpdated))
+			{
+				sleepingBoxes[nbKept] = sleepingBoxes[i];
+				sleepingMapping[nbKept] = sleepingMapping[i];
+				nbKept++;
+			}
+		}
+	}
+
+	MBP_Index* PX_RESTRICT fellAsleep = mPrevUpdated;
+	PxU32 nbFellAsleep = 0;
+	{
+		const PxU32 nbPrevUpdated = mNbPrevUpdated;
+		for(PxU32 i=0;i<nbPrevUpdated;i++)
+		{
+			const MBP_Index handle = mPrevUpdated[i];
+			if(isSleepingDynamic(objects[handle], nbUpdated))
+				fellAsleep[nbFellAsleep++] = handle;
+		}
+	}
+
+	mNbSleepingBoxes = nbKept;
+	mNbPrevUpdated = 0;
+	if(nbKept+nbFellAsleep!=nbNonUpdated)
+		return false;
+
+	const PxU32 nbSentinels = 2;
+	buffers.growSleeping(nbNonUpdated, nbSentinels, nbKept);
+	MBP_AABB* PX_RESTRICT sleepingBoxes = buffers.mSleepingDynamicBoxes;
+	MBP_Index* PX_RESTRICT sleepingMapping = buffers.mInToOut_Dynamic_Sleeping;
+	const MBP_AABB* PX_RESTRICT dynamicBoxes = mDynamicBoxes;
+
+	// PT: merge from the end so that it can be done in place
+	PxU32 i = nbKept;
+	PxU32 j = nbFellAsleep;
+	PxU32 dst = nbNonUpdated;
+	while(j)
+	{
+		const MBP_Index handle = fellAsleep[j-1];
+		const MBP_AABB& box = dynamicBoxes[objects[handle].mIndex];
+		dst--;
+		if(i && sleepingBoxes[i-1].mMinX>box.mMinX)
+		{
+			i--;
+			sleepingBoxes[dst] = sleepingBoxes[i];
+			sleepingMapping[dst] = sleepingMapping[i];
+		}
+		else
+		{
+			j--;
+			sleepingBoxes[dst] = box;
+			sleepingMapping[dst] = handle;
+		}
+	}
+	PX_ASSERT(dst==i);
+	initSentinel(sleepingBoxes[nbNonUpdated]);
+	initSentinel(sleepingBoxes[nbNonUpdated+1]);
+	mNbSleepingBoxes = nbNonUpdated;
+	return true;
+}
+
+void Region::savePrevUpdated(const MBP_Index* PX_RESTRICT inToOut_Dynamic, PxU32 nbUpdated)
+{
+	if(nbUpdated>mMaxNbPrevUpdated)
+	{
+		MBP_FREE(mPrevUpdated);
+		mMaxNbPrevUpdated = mMaxNbDynamicBoxes;
+		mPrevUpdated = reinterpret_cast<MBP_Index*>(MBP_ALLOC(sizeof(MBP_Index)*mMaxNbPrevUpdated));
+	}
+	PxMemCopy(mPrevUpdated, inToOut_Dynamic, nbUpdated*sizeof(MBP_Index));
+	mNbPrevUpdated = nbUpdated;
+}
+
 void Region::preparePruning(MBPOS_TmpBuffers& buffers)
 {
 PxU32 _saved = mNbUpdatedBoxes;
@@ -1583,6 +1936,7 @@ mNbUpdatedBoxes = 0;
 		mInput.mNeeded = false;
 		mPrevNbUpdatedBoxes = 0;
 		mNeedsSortingSleeping = true;
+		mSleepingBoxesValid = false;
 		return;
 	}
 	const MBP_AABB* PX_RESTRICT dynamicBoxes = mDynamicBoxes;
@@ -1614,7 +1968,8 @@ mNbUpdatedBoxes = 0;
 #endif
 			posList[i] = dynamicBoxes[i].mMinX;
 		}
-		if(mNeedsSortingSleeping)
+		// PT: sleeping positions are only needed to re-sort the frozen layer from scratch
+		if(mNeedsSortingSleeping && !mSleepingBoxesValid)
 		{
 			for(PxU32 i=0;i<nbNonUpdated;i++)
 			{
@@ -1633,8 +1988,6 @@ mNbUpdatedBoxes = 0;
 			{
 				const PxU32 objectIndex = mInToOut_Dynamic[i];
 				PX_ASSERT(!mObjects[objectIndex].mUpdated);
-				PxU32 j = i + nbUpdated;
-				PX_ASSERT(posList[j] == dynamicBoxes[j].mMinX);
 			}
 		}
 #endif
@@ -1659,8 +2012,21 @@ mNbUpdatedBoxes = 0;
 	MBP_AABB* PX_RESTRICT sleepingDynamicBoxes = NULL;
 	if(nbNonUpdated)
 	{
-		if(mNeedsSortingSleeping)
+		if(mNeedsSortingSleeping && mSleepingBoxesValid && updateSleepingBoxes(buffers, nbUpdated, nbNonUpdated))
+		{
+			sleepingDynamicBoxes = buffers.mSleepingDynamicBoxes;
+			inToOut_Dynamic_Sleeping = buffers.mInToOut_Dynamic_Sleeping;
+			mNeedsSortingSleeping = false;
+		}
+		else if(mNeedsSortingSleeping)
 		{
+			if(mSleepingBoxesValid)
+			{
+				// PT: the frozen layer could not be patched, positions have not been gathered yet
+				for(PxU32 i=nbUpdated;i<nb;i++)
+					posList[i] = dynamicBoxes[i].mMinX;
+			}
+
 			const PxU32* PX_RESTRICT sorted = mRS.Sort(posList+nbUpdated, nbNonUpdated, RADIX_UNSIGNED).GetRanks();
 
 			const PxU32 nbSentinels = 2;
@@ -1676,6 +2042,8 @@ mNbUpdatedBoxes = 0;
 			initSentinel(sleepingDynamicBoxes[nbNonUpdated]);
 			initSentinel(sleepingDynamicBoxes[nbNonUpdated+1]);
 			mNeedsSortingSleeping = false;
+			mSleepingBoxesValid = true;
+			mNbSleepingBoxes = nbNonUpdated;
 		}
 		else
 		{
@@ -1690,6 +2058,9 @@ mNbUpdatedBoxes = 0;
 	else
 	{
 		mNeedsSortingSleeping = true;
+		// PT: nothing is sleeping, i.e. the frozen layer is empty but still valid
+		mSleepingBoxesValid = true;
+		mNbSleepingBoxes = 0;
 	}
 
 	///////
@@ -1715,6 +2086,8 @@ mNbUpdatedBoxes = 0;
 	initSentinel(updatedDynamicBoxes[nbUpdated+1]);
 	dynamicBoxes = updatedDynamicBoxes;
 
+	savePrevUpdated(inToOut_Dynamic, nbUpdated);
+
 	mInput.mObjects						= mObjects;					// Can be shared (1)
 	mInput.mUpdatedDynamicBoxes			= updatedDynamicBoxes;		// Can be shared (2) => buffers.mUpdatedDynamicBoxes;
 	mInput.mSleepingDynamicBoxes		= sleepingDynamicBoxes;
@@ -1777,6 +2150,7 @@ static void doCompleteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, const
 				runningIndex1++;
 
 			PxU32 index1 = runningIndex1;
+			MBP_AVX2_PRUNE(false, sleepingDynamicBoxes, nb1, inToOut_Dynamic, inToOut_Dynamic_Sleeping, objects)
 
 			while(sleepingDynamicBoxes[index1].mMinX<=limit)
 			{
@@ -1804,6 +2178,7 @@ static void doCompleteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, const
 				runningIndex0++;
 
 			PxU32 index1 = runningIndex0;
+			MBP_AVX2_PRUNE(true, updatedDynamicBoxes, nb0, inToOut_Dynamic_Sleeping, inToOut_Dynamic, objects)
 
 			while(updatedDynamicBoxes[index1].mMinX<=limit)
 			{
@@ -1836,6 +2211,8 @@ static void doCompleteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, const
 		if(runningIndex<nbUpdated)
 		{
 			PxU32 index1 = runningIndex;
+			MBP_AVX2_PRUNE(false, updatedDynamicBoxes, nbUpdated, inToOut_Dynamic, inToOut_Dynamic, objects)
+
 			while(updatedDynamicBoxes[index1].mMinX<=limit)
 			{
 				MBP_OVERLAP_TEST(updatedDynamicBoxes[index1])
@@ -1886,6 +2263,7 @@ static void doBipartiteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, cons
 			runningIndex1++;
 
 		PxU32 index1 = runningIndex1;
+		MBP_AVX2_PRUNE(false, staticBoxes, nb1, inToOut_Dynamic, inToOut_Static, mObjects)
 
 		while(staticBoxes[index1].mMinX<=limit)
 		{
@@ -1913,6 +2291,7 @@ static void doBipartiteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, cons
 			runningIndex0++;
 
 		PxU32 index1 = runningIndex0;
+		MBP_AVX2_PRUNE(true, dynamicBoxes, nb0, inToOut_Static, inToOut_Dynamic, mObjects)
 
 		while(dynamicBoxes[index1].mMinX<=limit)
 		{
@@ -1983,7 +2362,8 @@ void Region::findOverlaps(MBP_PairManager& pairManager)
 MBP::MBP() :
 	mNbRegions			(0),
 	mFirstFreeIndex		(INVALID_ID),
-	mFirstFreeIndexBP	(INVALID_ID)
+	mFirstFreeIndexBP	(INVALID_ID),
+	mFirstNewPair		(0)
 #ifdef MBP_REGION_BOX_PRUNING
 	,mNbActiveRegions	(0),
 	mDirtyRegions		(true)
@@ -2009,6 +2389,9 @@ MBP::~MBP()
 
 void MBP::freeBuffers()
 {
+	for(PxU32 i=0;i<MBP_MAX_NB_REGION_TASKS;i++)
+		mTaskPairManagers[i].purge();
+
 	mRemoved.empty();
 	mOutOfBoundsObjects.clear();
 }
@@ -2486,6 +2869,42 @@ const Region* MBP::getRegion(PxU32 i) const
 	return regions[i].mBP;
 }
 
+// PT: number of regions that can still be added before addRegion() fails
+PxU32 MBP::getNbFreeRegionSlots() const
+{
+	PxU32 nbFree = MAX_NB_MBP - mNbRegions;
+	const RegionData* PX_RESTRICT regions = mRegions.begin();
+	PxU32 index = mFirstFreeIndexBP;
+	while(index!=INVALID_ID)
+	{
+		nbFree++;
+		index = PxU32(size_t(regions[index].mUserData));
+	}
+	return nbFree;
+}
+
+// PT: populateNewRegion() skips objects that are fully inside their regions. That is fine as long as these regions stay
+// around, but not when the new region is meant to replace them: such objects would go out-of-bounds when the old region is
+// removed. So we conservatively clear the flags of the region's objects first. They are set again when objects are updated.
+void MBP::clearFullyInsideFlags(PxU32 handle)
+{
+#ifdef USE_FULLY_INSIDE_FLAG
+	const Region* bp = getRegion(handle);
+	if(!bp)
+		return;
+
+	const PxU32 maxNbObjects = bp->mMaxNbObjects;
+	const MBPEntry* PX_RESTRICT objects = bp->mObjects;
+	for(PxU32 j=0;j<maxNbObjects;j++)
+	{
+		if(objects[j].mMBPHandle!=INVALID_ID)
+			clearBit(mFullyInsideBitmap, decodeHandle_Index(objects[j].mMBPHandle));
+	}
+#else
+	PX_UNUSED(handle);
+#endif
+}
+
 #ifdef MBP_REGION_BOX_PRUNING
 void MBP::buildRegionData()
 {
@@ -3107,6 +3526,120 @@ void MBP::findOverlaps(const Bp::FilterGroup::Enum* PX_RESTRICT groups
 	}
 }
 
+// PT: splits the regions that have work to do into at most maxNbTasks contiguous ranges of similar cost.
+// Returns the number of ranges, range i being [regionStarts[i], regionStarts[i+1]).
+PxU32 MBP::partitionRegions(PxU32 maxNbTasks, PxU32* PX_RESTRICT regionStarts) const
+{
+	const PxU32 nb = mNbRegions;
+	const RegionData* PX_RESTRICT regions = mRegions.begin();
+
+	PxU32 totalCost = 0;
+	PxU32 nbBusyRegions = 0;
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const Region* region = regions[i].mBP;
+		if(region && (region->mNbUpdatedBoxes || region->mNeedsSorting))
+		{
+			totalCost += region->mNeedsSorting ? region->mNbDynamicBoxes + region->mNbStaticBoxes : region->mNbUpdatedBoxes;
+			nbBusyRegions++;
+		}
+	}
+
+	// PT: not worth the task overhead
+	if(nbBusyRegions<2 || totalCost<MBP_MIN_COST_PER_REGION_TASK*2)
+		return 0;
+
+	PxU32 nbTasks = PxMin(PxMin(maxNbTasks, nbBusyRegions), totalCost/MBP_MIN_COST_PER_REGION_TASK);
+	const PxU32 costPerTask = (totalCost + nbTasks - 1)/nbTasks;
+
+	PxU32 nbRanges = 0;
+	PxU32 currentCost = 0;
+	regionStarts[nbRanges++] = 0;
+	for(PxU32 i=0;i<nb && nbRanges<nbTasks;i++)
+	{
+		const Region* region = regions[i].mBP;
+		if(region && (region->mNbUpdatedBoxes || region->mNeedsSorting))
+			currentCost += region->mNeedsSorting ? region->mNbDynamicBoxes + region->mNbStaticBoxes : region->mNbUpdatedBoxes;
+
+		if(currentCost>=costPerTask)
+		{
+			regionStarts[nbRanges++] = i+1;
+			currentCost = 0;
+		}
+	}
+	regionStarts[nbRanges] = nb;
+
+	// PT: the last range can be empty if the last busy region closed the previous one
+	if(regionStarts[nbRanges-1]==nb)
+		nbRanges--;
+
+	return nbRanges;
+}
+
+void MBP::findOverlaps(PxU32 taskIndex, PxU32 startRegion, PxU32 endRegion, const Bp::FilterGroup::Enum* PX_RESTRICT groups
+#ifdef BP_FILTERING_USES_TYPE_IN_GROUP
+	, const bool* PX_RESTRICT lut
+#endif
+	)
+{
+	PX_ASSERT(taskIndex<MBP_MAX_NB_REGION_TASKS);
+	MBP_PairManager& pairManager = mTaskPairManagers[taskIndex];
+	pairManager.resetPairs();
+	pairManager.mObjects = mMBP_Objects.begin();
+	pairManager.mGroups = groups;
+#ifdef BP_FILTERING_USES_TYPE_IN_GROUP
+	pairManager.mLUT = lut;
+#endif
+
+	const RegionData* PX_RESTRICT regions = mRegions.begin();
+	for(PxU32 i=startRegion;i<endRegion;i++)
+	{
+		if(regions[i].mBP)
+		{
+			regions[i].mBP->prepareOverlaps();
+			regions[i].mBP->findOverlaps(pairManager);
+		}
+	}
+
+	// the task's pairs are already filtered and unique within the task. They go straight into the main pair manager,
+	// the ones that do not fit are moved to the front of the task's array for mergeTaskPairs(). This breaks the task's
+	// hash table, which is fine since it is reset before the next update.
+	MBP_Pair* PX_RESTRICT pairs = pairManager.mActivePairs;
+	const PxU32 nbPairs = pairManager.mNbActivePairs;
+	PxU32 nbOverflow = 0;
+	for(PxU32 j=0;j<nbPairs;j++)
+	{
+		if(!mPairManager.addPairConcurrent(pairs[j].id0, pairs[j].id1))
+			pairs[nbOverflow++] = pairs[j];
+	}
+	mNbTaskOverflowPairs[taskIndex] = nbOverflow;
+}
+
+// called before the region tasks are spawned, so that they can insert their pairs in the main pair manager concurrently
+void MBP::prepareTaskPairs()
+{
+	mFirstNewPair = mPairManager.mNbActivePairs;
+	mPairManager.beginConcurrentInsert(PxMax(mFirstNewPair/4, 1024u));
+}
+
+// adds the pairs that did not fit during the concurrent phase, in task order, then sorts the new pairs. The created
+// pairs are thus reported in the same order whatever the number of tasks and their timing, but not in the order of a
+// single-threaded update.
+void MBP::mergeTaskPairs(PxU32 nbTasks)
+{
+	mPairManager.endConcurrentInsert();
+
+	for(PxU32 i=0;i<nbTasks;i++)
+	{
+		const MBP_Pair* PX_RESTRICT pairs = mTaskPairManagers[i].mActivePairs;
+		const PxU32 nbPairs = mNbTaskOverflowPairs[i];
+		for(PxU32 j=0;j<nbPairs;j++)
+			mPairManager.addPairNoFiltering(pairs[j].id0, pairs[j].id1);
+	}
+
+	mPairManager.sortNewPairs(mFirstNewPair);
+}
+
 PxU32 MBP::finalize(BroadPhaseMBP* mbp)
 {
 	const MBP_Object* objects = mMBP_Objects.begin();
@@ -3219,6 +3752,8 @@ BroadPhaseMBP::BroadPhaseMBP(	PxU32 maxNbRegions,
 								PxU64 contextID) :
 	mMBPUpdateWorkTask		(contextID),
 	mMBPPostUpdateWorkTask	(contextID),
+	mNbRegionTasks			(0),
+	mAutoRegionMaxNbObjects	(0),
 	mMapping				(NULL),
 	mCapacity				(0),
 	mGroups					(NULL)
@@ -3226,6 +3761,9 @@ BroadPhaseMBP::BroadPhaseMBP(	PxU32 maxNbRegions,
 	,mLUT					(NULL)
 #endif
 {
+	for(PxU32 i=0;i<MBP_MAX_NB_REGION_TASKS;i++)
+		mMBPRegionOverlapsTasks[i].setContextId(contextID);
+
 	mMBP = PX_NEW(MBP)();
 
 	const PxU32 nbObjects = maxNbStaticShapes + maxNbDynamicShapes;
@@ -3324,6 +3862,248 @@ bool BroadPhaseMBP::removeRegion(PxU32 handle)
 	return mMBP->removeRegion(handle);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+// PT: automatic regions. We maintain a binary tree of regions over the world bounds. Leaves are actual MBP regions,
+// split in two when they contain too many objects and merged back when both halves get sparse. Split planes are
+// taken from a histogram of the objects' centers so that both halves get a similar number of objects. At most one
+// split or merge is done per update since populating a new region has to go over all objects.
+#define MBP_AUTO_REGION_MAX_DEPTH	8
+#define MBP_AUTO_REGION_NB_BINS		16
+#define MBP_AUTO_REGION_MERGE_RATIO	4	// PT: siblings are merged when they contain less than 1/4 of the limit, to avoid split/merge oscillations
+
+static void addToAutoRegionHistogram(PxU32* PX_RESTRICT histogram, const MBP_AABB* PX_RESTRICT boxes, PxU32 nbBoxes, PxU32 axis, float minValue, float binScale)
+{
+	for(PxU32 i=0;i<nbBoxes;i++)
+	{
+		PxBounds3 bounds;
+		boxes[i].decode(bounds);
+		const float bin = ((bounds.minimum[axis] + bounds.maximum[axis])*0.5f - minValue)*binScale;
+		const PxU32 binIndex = bin<=0.0f ? 0 : PxMin(PxU32(bin), PxU32(MBP_AUTO_REGION_NB_BINS-1));
+		histogram[binIndex]++;
+	}
+}
+
+bool BroadPhaseMBP::setAutoRegions(const PxBounds3& worldBounds, PxU32 maxNbObjectsPerRegion)
+{
+	if(maxNbObjectsPerRegion && (!worldBounds.isValid() || worldBounds.isEmpty()))
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "BroadPhaseMBP::setAutoRegions: invalid world bounds.");
+		return false;
+	}
+
+	// PT: we add the new root before removing the previous regions, so that objects don't go out-of-bounds in-between
+	PxU32 rootHandle = INVALID_ID;
+	if(maxNbObjectsPerRegion)
+	{
+		for(PxU32 i=0;i<mAutoRegions.size();i++)
+		{
+			if(mAutoRegions[i].mRegionHandle!=INVALID_ID)
+				mMBP->clearFullyInsideFlags(mAutoRegions[i].mRegionHandle);
+		}
+
+		PxBroadPhaseRegion region;
+		region.bounds	= worldBounds;
+		region.userData	= NULL;
+		rootHandle = mMBP->addRegion(region, true);
+		if(rootHandle==INVALID_ID)
+			return false;
+	}
+
+	releaseAutoRegions();
+
+	if(rootHandle!=INVALID_ID)
+	{
+		MBPAutoRegionNode root;
+		root.mBounds		= worldBounds;
+		root.mRegionHandle	= rootHandle;
+		root.mParent		= INVALID_ID;
+		root.mChildren		= INVALID_ID;
+		mAutoRegions.pushBack(root);
+		mAutoRegionMaxNbObjects = maxNbObjectsPerRegion;
+	}
+	return true;
+}
+
+void BroadPhaseMBP::releaseAutoRegions()
+{
+	const PxU32 nbNodes = mAutoRegions.size();
+	for(PxU32 i=0;i<nbNodes;i++)
+	{
+		if(mAutoRegions[i].mRegionHandle!=INVALID_ID)
+			mMBP->removeRegion(mAutoRegions[i].mRegionHandle);
+	}
+	mAutoRegions.clear();
+	mFreeAutoRegionNodes.clear();
+	mAutoRegionMaxNbObjects = 0;
+}
+
+PxU32 BroadPhaseMBP::getAutoRegionNbObjects(const MBPAutoRegionNode& node) const
+{
+	PX_ASSERT(node.mRegionHandle!=INVALID_ID);
+	const Region* region = mMBP->getRegion(node.mRegionHandle);
+	PX_ASSERT(region);
+	return region->mNbStaticBoxes + region->mNbDynamicBoxes;
+}
+
+void BroadPhaseMBP::updateAutoRegions()
+{
+	if(!mAutoRegionMaxNbObjects)
+		return;
+
+	const PxU32 mergeLimit = mAutoRegionMaxNbObjects/MBP_AUTO_REGION_MERGE_RATIO;
+
+	// PT: look for the most crowded leaf, and for the emptiest pair of sibling leaves
+	PxU32 splitCandidate = INVALID_ID;
+	PxU32 splitNbObjects = mAutoRegionMaxNbObjects;
+	PxU32 mergeCandidate = INVALID_ID;
+	PxU32 mergeNbObjects = mergeLimit;
+
+	const PxU32 nbNodes = mAutoRegions.size();
+	const MBPAutoRegionNode* PX_RESTRICT nodes = mAutoRegions.begin();
+	for(PxU32 i=0;i<nbNodes;i++)
+	{
+		const MBPAutoRegionNode& node = nodes[i];
+		if(node.mRegionHandle!=INVALID_ID)
+		{
+			const PxU32 nbObjects = getAutoRegionNbObjects(node);
+			if(nbObjects>splitNbObjects)
+			{
+				PxU32 depth = 0;
+				for(PxU32 parent=node.mParent; parent!=INVALID_ID; parent=nodes[parent].mParent)
+					depth++;
+
+				if(depth<MBP_AUTO_REGION_MAX_DEPTH)
+				{
+					splitCandidate = i;
+					splitNbObjects = nbObjects;
+				}
+			}
+		}
+		else if(node.mChildren!=INVALID_ID)
+		{
+			const MBPAutoRegionNode& child0 = nodes[node.mChildren];
+			const MBPAutoRegionNode& child1 = nodes[node.mChildren+1];
+			if(child0.mRegionHandle!=INVALID_ID && child1.mRegionHandle!=INVALID_ID)
+			{
+				const PxU32 nbObjects = getAutoRegionNbObjects(child0) + getAutoRegionNbObjects(child1);
+				if(nbObjects<mergeNbObjects)
+				{
+					mergeCandidate = i;
+					mergeNbObjects = nbObjects;
+				}
+			}
+		}
+	}
+
+	if(splitCandidate!=INVALID_ID)
+		splitAutoRegion(splitCandidate);
+	else if(mergeCandidate!=INVALID_ID)
+		mergeAutoRegions(mergeCandidate);
+}
+
+bool BroadPhaseMBP::splitAutoRegion(PxU32 nodeIndex)
+{
+	// PT: we temporarily need one more region than we will end up with
+	if(mMBP->getNbFreeRegionSlots()<2)
+		return false;
+
+	const MBPAutoRegionNode node = mAutoRegions[nodeIndex];
+	const Region* region = mMBP->getRegion(node.mRegionHandle);
+	PX_ASSERT(region);
+
+	// PT: split along the largest extent, at the histogram bin boundary closest to the median object
+	const PxVec3 extents = node.mBounds.getDimensions();
+	const PxU32 axis = extents.x>extents.y ? (extents.x>extents.z ? 0u : 2u) : (extents.y>extents.z ? 1u : 2u);
+	const float minValue = node.mBounds.minimum[axis];
+	const float binSize = extents[axis]/float(MBP_AUTO_REGION_NB_BINS);
+
+	PxU32 histogram[MBP_AUTO_REGION_NB_BINS];
+	PxMemZero(histogram, sizeof(histogram));
+	addToAutoRegionHistogram(histogram, region->mStaticBoxes, region->mNbStaticBoxes, axis, minValue, 1.0f/binSize);
+	addToAutoRegionHistogram(histogram, region->mDynamicBoxes, region->mNbDynamicBoxes, axis, minValue, 1.0f/binSize);
+
+	const PxU32 nbObjects = region->mNbStaticBoxes + region->mNbDynamicBoxes;
+	PxU32 splitBin = 1;
+	PxU32 nbBelow = histogram[0];
+	while(splitBin<MBP_AUTO_REGION_NB_BINS-1 && nbBelow*2<nbObjects)
+		nbBelow += histogram[splitBin++];
+
+	PxBroadPhaseRegion regions[2];
+	regions[0].bounds	= node.mBounds;
+	regions[0].userData	= NULL;
+	regions[1].bounds	= node.mBounds;
+	regions[1].userData	= NULL;
+	regions[0].bounds.maximum[axis] = regions[1].bounds.minimum[axis] = minValue + float(splitBin)*binSize;
+
+	mMBP->clearFullyInsideFlags(node.mRegionHandle);
+
+	const PxU32 handle0 = mMBP->addRegion(regions[0], true);
+	if(handle0==INVALID_ID)
+		return false;
+	const PxU32 handle1 = mMBP->addRegion(regions[1], true);
+	if(handle1==INVALID_ID)
+	{
+		mMBP->removeRegion(handle0);
+		return false;
+	}
+	mMBP->removeRegion(node.mRegionHandle);
+
+	PxU32 children;
+	if(mFreeAutoRegionNodes.size())
+	{
+		children = mFreeAutoRegionNodes.popBack();
+	}
+	else
+	{
+		children = mAutoRegions.size();
+		mAutoRegions.resizeUninitialized(children+2);
+	}
+
+	for(PxU32 i=0;i<2;i++)
+	{
+		MBPAutoRegionNode& child = mAutoRegions[children+i];
+		child.mBounds		= regions[i].bounds;
+		child.mRegionHandle	= i ? handle1 : handle0;
+		child.mParent		= nodeIndex;
+		child.mChildren		= INVALID_ID;
+	}
+
+	MBPAutoRegionNode& parent = mAutoRegions[nodeIndex];
+	parent.mRegionHandle	= INVALID_ID;
+	parent.mChildren		= children;
+	return true;
+}
+
+bool BroadPhaseMBP::mergeAutoRegions(PxU32 nodeIndex)
+{
+	const MBPAutoRegionNode node = mAutoRegions[nodeIndex];
+	PX_ASSERT(node.mRegionHandle==INVALID_ID && node.mChildren!=INVALID_ID);
+
+	MBPAutoRegionNode& child0 = mAutoRegions[node.mChildren];
+	MBPAutoRegionNode& child1 = mAutoRegions[node.mChildren+1];
+
+	mMBP->clearFullyInsideFlags(child0.mRegionHandle);
+	mMBP->clearFullyInsideFlags(child1.mRegionHandle);
+
+	PxBroadPhaseRegion region;
+	region.bounds	= node.mBounds;
+	region.userData	= NULL;
+	const PxU32 handle = mMBP->addRegion(region, true);
+	if(handle==INVALID_ID)
+		return false;
+
+	mMBP->removeRegion(child0.mRegionHandle);
+	mMBP->removeRegion(child1.mRegionHandle);
+	child0.mRegionHandle = child1.mRegionHandle = INVALID_ID;
+	mFreeAutoRegionNodes.pushBack(node.mChildren);
+
+	MBPAutoRegionNode& parent = mAutoRegions[nodeIndex];
+	parent.mRegionHandle	= handle;
+	parent.mChildren		= INVALID_ID;
+	return true;
+}
+
 void BroadPhaseMBP::update(const PxU32 numCpuTasks, PxcScratchAllocator* scratchAllocator, const BroadPhaseUpdateData& updateData, physx::PxBaseTask* continuation, physx::PxBaseTask* narrowPhaseUnblockTask)
 {
 #if PX_CHECKED
@@ -3336,21 +4116,33 @@ void BroadPhaseMBP::update(const PxU32 numCpuTasks, PxcScratchAllocator* scratch
 
 	setUpdateData(updateData);
 
-	if(1)
+	PxU32 regionStarts[MBP_MAX_NB_REGION_TASKS+1];
+	const PxU32 nbTasks = numCpuTasks>1 ? mMBP->partitionRegions(PxMin(numCpuTasks, PxU32(MBP_MAX_NB_REGION_TASKS)), regionStarts) : 0;
+
+	if(!nbTasks)
 	{
 		update();
 		postUpdate();
 	}
 	else
 	{
-		mMBPPostUpdateWorkTask.set(this, scratchAllocator, numCpuTasks);
-		mMBPUpdateWorkTask.set(this, scratchAllocator, numCpuTasks);
+		// PT: regions are independent, so each range of regions is prepared and pruned in its own task
+		mNbRegionTasks = nbTasks;
+		mMBP->prepareTaskPairs();
 
+		mMBPPostUpdateWorkTask.set(this, scratchAllocator, numCpuTasks);
 		mMBPPostUpdateWorkTask.setContinuation(continuation);
-		mMBPUpdateWorkTask.setContinuation(&mMBPPostUpdateWorkTask);
+
+		for(PxU32 i=0;i<nbTasks;i++)
+		{
+			mMBPRegionOverlapsTasks[i].set(this, scratchAllocator, numCpuTasks);
+			mMBPRegionOverlapsTasks[i].setRegions(i, regionStarts[i], regionStarts[i+1]);
+			mMBPRegionOverlapsTasks[i].setContinuation(&mMBPPostUpdateWorkTask);
+		}
 
 		mMBPPostUpdateWorkTask.removeReference();
-		mMBPUpdateWorkTask.removeReference();
+		for(PxU32 i=0;i<nbTasks;i++)
+			mMBPRegionOverlapsTasks[i].removeReference();
 	}
 }
 
@@ -3433,6 +4225,11 @@ void MBPPostUpdateWorkTask::runInternal()
 	mMBP->postUpdate();
 }
 
+void MBPRegionOverlapsTask::runInternal()
+{
+	mMBP->findRegionOverlaps(mTaskIndex, mStartRegion, mEndRegion);
+}
+
 void BroadPhaseMBP::removeObjects(const BroadPhaseUpdateData& updateData)
 {
 	const BpHandle* PX_RESTRICT removed = updateData.getRemovedHandles();
@@ -3529,10 +4326,11 @@ void BroadPhaseMBP::setUpdateData(const BroadPhaseUpdateData& updateData)
 	addObjects(updateData);
 	updateObjects(updateData);
 
+	// PT: done after the objects have been updated, so that new regions are populated with up-to-date bounds
+	updateAutoRegions();
+
 	PX_ASSERT(!mCreated.size());
 	PX_ASSERT(!mDeleted.size());
-
-	mMBP->prepareOverlaps();
 }
 
 void BroadPhaseMBP::update()
@@ -3540,6 +4338,7 @@ void BroadPhaseMBP::update()
 #ifdef CHECK_NB_OVERLAPS
 	gNbOverlaps = 0;
 #endif
+	mMBP->prepareOverlaps();
 	mMBP->findOverlaps(mGroups
 #ifdef BP_FILTERING_USES_TYPE_IN_GROUP
 	, mLUT
@@ -3550,8 +4349,25 @@ void BroadPhaseMBP::update()
 #endif
 }
 
+void BroadPhaseMBP::findRegionOverlaps(PxU32 taskIndex, PxU32 startRegion, PxU32 endRegion)
+{
+	PX_PROFILE_ZONE("BroadPhase.MBPRegionOverlaps", mMBPPostUpdateWorkTask.getContextId());
+
+	mMBP->findOverlaps(taskIndex, startRegion, endRegion, mGroups
+#ifdef BP_FILTERING_USES_TYPE_IN_GROUP
+	, mLUT
+#endif		
+		);
+}
+
 void BroadPhaseMBP::postUpdate()
 {
+	if(mNbRegionTasks)
+	{
+		mMBP->mergeTaskPairs(mNbRegionTasks);
+		mNbRegionTasks = 0;
+	}
+
 	{
 		PxU32 Nb = mMBP->mNbRegions;
 		const RegionData* PX_RESTRICT regions = mMBP->mRegions.begin();
@@ -3678,4 +4494,11 @@ bool BroadPhaseMBP::isValid(const BroadPhaseUpdateData& updateData) const
 void BroadPhaseMBP::shiftOrigin(const PxVec3& shift)
 {
 	mMBP->shiftOrigin(shift);
+
+	const PxU32 nbNodes = mAutoRegions.size();
+	for(PxU32 i=0;i<nbNodes;i++)
+	{
+		mAutoRegions[i].mBounds.minimum -= shift;
+		mAutoRegions[i].mBounds.maximum -= shift;
+	}
 }
@@ -41,6 +41,16 @@ namespace physx
 {
 namespace Bp
 {
+	// PT: node of the automatic region tree. Leaves own an MBP region. Inner nodes only keep their bounds, so that
+	// their two children can be merged back when they get empty enough.
+	struct MBPAutoRegionNode
+	{
+		PxBounds3	mBounds;
+		PxU32		mRegionHandle;	// MBP region for leaves, 0xffffffff for inner nodes and free nodes
+		PxU32		mParent;		// 0xffffffff for the root
+		PxU32		mChildren;		// Index of first child (children are consecutive), 0xffffffff for leaves and free nodes
+	};
+
 	class BroadPhaseMBP : public BroadPhase, public Ps::UserAllocated
 	{
 											PX_NOCOPY(BroadPhaseMBP)
@@ -59,6 +69,7 @@ namespace Bp
 		virtual	PxU32						getRegions(PxBroadPhaseRegionInfo* userBuffer, PxU32 bufferSize, PxU32 startIndex=0) const;
 		virtual	PxU32						addRegion(const PxBroadPhaseRegion& region, bool populateRegion);
 		virtual	bool						removeRegion(PxU32 handle);
+		virtual	bool						setAutoRegions(const PxBounds3& worldBounds, PxU32 maxNbObjectsPerRegion);
 		virtual	PxU32						getNbOutOfBoundsObjects()	const;
 		virtual	const PxU32*				getOutOfBoundsObjects()		const;
 	//~BroadPhaseBase
@@ -84,6 +95,8 @@ namespace Bp
 
 				MBPUpdateWorkTask			mMBPUpdateWorkTask;
 				MBPPostUpdateWorkTask		mMBPPostUpdateWorkTask;
+				MBPRegionOverlapsTask		mMBPRegionOverlapsTasks[MBP_MAX_NB_REGION_TASKS];
+				PxU32						mNbRegionTasks;	// PT: number of region tasks run this frame, 0 for the single-threaded path
 
 				MBP*						mMBP;		// PT: TODO: aggregate
 
@@ -101,7 +114,18 @@ namespace Bp
 				void						removeObjects(const BroadPhaseUpdateData& updateData);
 				void						updateObjects(const BroadPhaseUpdateData& updateData);
 
+				Ps::Array<MBPAutoRegionNode>	mAutoRegions;				// PT: automatic region tree, node 0 is the root
+				Ps::Array<PxU32>			mFreeAutoRegionNodes;		// PT: recycled pairs of nodes, as index of the first node
+				PxU32						mAutoRegionMaxNbObjects;	// PT: 0 when automatic regions are disabled
+
+				void						updateAutoRegions();
+				bool						splitAutoRegion(PxU32 nodeIndex);
+				bool						mergeAutoRegions(PxU32 nodeIndex);
+				PxU32						getAutoRegionNbObjects(const MBPAutoRegionNode& node)	const;
+				void						releaseAutoRegions();
+
 				void						update();
+				void						findRegionOverlaps(PxU32 taskIndex, PxU32 startRegion, PxU32 endRegion);
 				void						postUpdate();
 				void						allocateMappingArray(PxU32 newCapacity);
 	};
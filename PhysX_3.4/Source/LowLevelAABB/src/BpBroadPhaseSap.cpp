@@ -47,6 +47,9 @@ namespace Bp
 #define DEFAULT_CREATEDDELETED_PAIR_ARRAY_CAPACITY 64
 #define DEFAULT_CREATEDDELETED1AXIS_CAPACITY 8192
 
+//Below this number of boxes the three axes are always updated serially, the task overhead would dominate.
+#define PARALLEL_BATCH_UPDATE_MIN_BOXES 2048
+
 BroadPhaseSap::BroadPhaseSap(
 	const PxU32 maxNbBroadPhaseOverlaps,
 	const PxU32 maxNbStaticShapes,
@@ -54,12 +57,18 @@ BroadPhaseSap::BroadPhaseSap(
 	PxU64 contextID) :
 	mScratchAllocator		(NULL),
 	mSapUpdateWorkTask		(contextID),
+	mSapBatchUpdateJoinTask	(contextID),
 	mSapPostUpdateWorkTask	(contextID),
 	mContextID				(contextID)
 {
 
 	for(PxU32 i=0;i<3;i++)
+	{
 		mBatchUpdateTasks[i].setContextId(contextID);
+		mBatchUpdateFilterTasks[i].setContextId(contextID);
+		mBatchUpdateFilterTasks[i].set(this, i);
+		mPrevBoxEndPts[i] = NULL;
+	}
 
 	//Boxes
 	mBoxesSize=0;
@@ -83,7 +92,8 @@ BroadPhaseSap::BroadPhaseSap(
 
 	mBoxesUpdated = reinterpret_cast<PxU8*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(PxU8)*mBoxesCapacity)), "BoxesUpdated"));
 	mSortedUpdateElements = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*mEndPointsCapacity)), "SortedUpdateElements"));
-	mActivityPockets = reinterpret_cast<BroadPhaseActivityPocket*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BroadPhaseActivityPocket)*mEndPointsCapacity)), "BroadPhaseActivityPocket"));
+	for(PxU32 axis=0;axis<3;axis++)
+		mActivityPockets[axis] = reinterpret_cast<BroadPhaseActivityPocket*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BroadPhaseActivityPocket)*mEndPointsCapacity)), "BroadPhaseActivityPocket"));
 
 	mEndPointValues[0] = reinterpret_cast<ValType*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(ValType)*(mEndPointsCapacity))), "ValType"));
 	mEndPointValues[1] = reinterpret_cast<ValType*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(ValType)*(mEndPointsCapacity))), "ValType"));
@@ -100,16 +110,13 @@ BroadPhaseSap::BroadPhaseSap(
 	setMinSentinel(mEndPointValues[2][0],mEndPointDatas[2][0]);
 	setMaxSentinel(mEndPointValues[2][1],mEndPointDatas[2][1]);
 
-	mListNext = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*mEndPointsCapacity)), "NextList"));
-	mListPrev = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*mEndPointsCapacity)), "PrevList"));
-
-	for(PxU32 a = 1; a < mEndPointsCapacity; ++a)
+	//Each axis gets its own linked lists so that the axes can be updated in parallel.
+	for(PxU32 axis=0;axis<3;axis++)
 	{
-		mListNext[a-1] = BpHandle(a);
-		mListPrev[a] = BpHandle(a-1);
+		mListNext[axis] = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*mEndPointsCapacity)), "NextList"));
+		mListPrev[axis] = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*mEndPointsCapacity)), "PrevList"));
+		initLists(axis, mEndPointsCapacity);
 	}
-	mListNext[mEndPointsCapacity-1] = BpHandle(mEndPointsCapacity-1);
-	mListPrev[0] = 0;
 
 	mDefaultPairsCapacity = PxMax(maxNbBroadPhaseOverlaps, PxU32(DEFAULT_CREATEDDELETED_PAIR_ARRAY_CAPACITY));
 
@@ -154,11 +161,14 @@ BroadPhaseSap::~BroadPhaseSap()
 	PX_FREE(mEndPointDatas[1]);
 	PX_FREE(mEndPointDatas[2]);
 
-	PX_FREE(mListNext);
-	PX_FREE(mListPrev);
+	for(PxU32 axis=0;axis<3;axis++)
+	{
+		PX_FREE(mListNext[axis]);
+		PX_FREE(mListPrev[axis]);
+		PX_FREE(mActivityPockets[axis]);
+	}
 
 	PX_FREE(mSortedUpdateElements);
-	PX_FREE(mActivityPockets);
 	PX_FREE(mBoxesUpdated);
 
 	mPairs.release();
@@ -180,27 +190,40 @@ void BroadPhaseSap::destroy()
 	PX_FREE(this);
 }
 
+void BroadPhaseSap::initLists(const PxU32 axis, const PxU32 endPointsCapacity)
+{
+	BpHandle* PX_RESTRICT listNext = mListNext[axis];
+	BpHandle* PX_RESTRICT listPrev = mListPrev[axis];
+	for(PxU32 a = 1; a < endPointsCapacity; ++a)
+	{
+		listNext[a-1] = BpHandle(a);
+		listPrev[a] = BpHandle(a-1);
+	}
+	listNext[endPointsCapacity-1] = BpHandle(endPointsCapacity-1);
+	listPrev[0] = 0;
+}
+
 void BroadPhaseSap::resizeBuffers()
 {
 	const PxU32 defaultPairsCapacity = mDefaultPairsCapacity;
 
-	mCreatedPairsArray = reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true));
+	mCreatedPairsArray = reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true, __FILE__, __LINE__));
 	mCreatedPairsCapacity = defaultPairsCapacity;
 	mCreatedPairsSize = 0;
 
-	mDeletedPairsArray = reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true));
+	mDeletedPairsArray = reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true, __FILE__, __LINE__));
 	mDeletedPairsCapacity = defaultPairsCapacity;
 	mDeletedPairsSize = 0;
 
-	mData = reinterpret_cast<BpHandle*>(mScratchAllocator->alloc(sizeof(BpHandle)*defaultPairsCapacity, true));
+	mData = reinterpret_cast<BpHandle*>(mScratchAllocator->alloc(sizeof(BpHandle)*defaultPairsCapacity, true, __FILE__, __LINE__));
 	mDataCapacity = defaultPairsCapacity;
 	mDataSize = 0;
 
-	mBatchUpdateTasks[0].setPairs(reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true)), defaultPairsCapacity);
+	mBatchUpdateTasks[0].setPairs(reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true, __FILE__, __LINE__)), defaultPairsCapacity);
 	mBatchUpdateTasks[0].setNumPairs(0);
-	mBatchUpdateTasks[1].setPairs(reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true)), defaultPairsCapacity);
+	mBatchUpdateTasks[1].setPairs(reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true, __FILE__, __LINE__)), defaultPairsCapacity);
 	mBatchUpdateTasks[1].setNumPairs(0);
-	mBatchUpdateTasks[2].setPairs(reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true)), defaultPairsCapacity);
+	mBatchUpdateTasks[2].setPairs(reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true, __FILE__, __LINE__)), defaultPairsCapacity);
 	mBatchUpdateTasks[2].setNumPairs(0);
 }
 
@@ -578,20 +601,15 @@ bool BroadPhaseSap::setUpdateData(const BroadPhaseUpdateData& updateData)
 		BpHandle* newEndPointDatasY = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*(newEndPointsCapacity))), "BpHandle"));
 		BpHandle* newEndPointDatasZ = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*(newEndPointsCapacity))), "BpHandle"));
 
-		PX_FREE(mListNext);
-		PX_FREE(mListPrev);
-
-		mListNext = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*newEndPointsCapacity)), "NextList"));
-		mListPrev = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*newEndPointsCapacity)), "Prev"));
-
-
-		for(PxU32 a = 1; a < newEndPointsCapacity; ++a)
+		for(PxU32 axis=0;axis<3;axis++)
 		{
-			mListNext[a-1] = BpHandle(a);
-			mListPrev[a] = BpHandle(a-1);
+			PX_FREE(mListNext[axis]);
+			PX_FREE(mListPrev[axis]);
+
+			mListNext[axis] = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*newEndPointsCapacity)), "NextList"));
+			mListPrev[axis] = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*newEndPointsCapacity)), "Prev"));
+			initLists(axis, newEndPointsCapacity);
 		}
-		mListNext[newEndPointsCapacity-1] = BpHandle(newEndPointsCapacity-1);
-		mListPrev[0] = 0;
 
 		PxMemCopy(newEndPointValuesX, mEndPointValues[0], sizeof(ValType)*(mBoxesSize*2+NUM_SENTINELS));
 		PxMemCopy(newEndPointValuesY, mEndPointValues[1], sizeof(ValType)*(mBoxesSize*2+NUM_SENTINELS));
@@ -614,9 +632,12 @@ bool BroadPhaseSap::setUpdateData(const BroadPhaseUpdateData& updateData)
 		mEndPointsCapacity = newEndPointsCapacity;
 
 		PX_FREE(mSortedUpdateElements);
-		PX_FREE(mActivityPockets);
 		mSortedUpdateElements = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*newEndPointsCapacity)), "SortedUpdateElements"));
-		mActivityPockets = reinterpret_cast<BroadPhaseActivityPocket*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BroadPhaseActivityPocket)*newEndPointsCapacity)), "BroadPhaseActivityPocket"));
+		for(PxU32 axis=0;axis<3;axis++)
+		{
+			PX_FREE(mActivityPockets[axis]);
+			mActivityPockets[axis] = reinterpret_cast<BroadPhaseActivityPocket*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BroadPhaseActivityPocket)*newEndPointsCapacity)), "BroadPhaseActivityPocket"));
+		}
 	}
 
 	PxMemZero(mBoxesUpdated, sizeof(PxU8) * (mBoxesCapacity));	
@@ -639,6 +660,15 @@ void BroadPhaseSap::postUpdate()
 {
 	PX_PROFILE_ZONE("BroadPhase.SapPostUpdate", mContextID);
 
+	for(PxU32 i=1;i<3;i++)
+	{
+		if(mPrevBoxEndPts[i])
+		{
+			mScratchAllocator->free(mPrevBoxEndPts[i]);
+			mPrevBoxEndPts[i] = NULL;
+		}
+	}
+
 	DataArray da(mData, mDataSize, mDataCapacity);
 
 	for(PxU32 i=0;i<3;i++)
@@ -688,7 +718,12 @@ void BroadPhaseSap::deletePairs()
 void BroadPhaseBatchUpdateWorkTask::runInternal()
 {
 	mPairsSize=0;
-	mSap->batchUpdate(mAxis, mPairs, mPairsSize, mPairsCapacity);
+	mSap->batchUpdate(mAxis, mPairs, mPairsSize, mPairsCapacity, mDefer2DTest);
+}
+
+void BroadPhaseBatchUpdateFilterTask::runInternal()
+{
+	mSap->batchUpdateFilterPairs(mAxis);
 }
 
 void BroadPhaseSap::update()
@@ -702,11 +737,103 @@ void BroadPhaseSap::update()
 	PX_ASSERT(0==mBatchUpdateTasks[1].getPairsSize());
 	PX_ASSERT(0==mBatchUpdateTasks[2].getPairsSize());
 
+	mBatchUpdateTasks[0].setDefer2DTest(false);
+	mBatchUpdateTasks[1].setDefer2DTest(false);
+	mBatchUpdateTasks[2].setDefer2DTest(false);
+
 	mBatchUpdateTasks[0].runInternal();
 	mBatchUpdateTasks[1].runInternal();
 	mBatchUpdateTasks[2].runInternal();
 }
 
+//The axes are sorted in parallel, each one with its own linked lists and activity pockets. The serial update
+//performs the 2D overlap test of axis N against the final state of the axes below N and the previous state of
+//the axes above N, so those previous states are copied first and the test is deferred until all axes are sorted.
+//This produces the same pairs, in the same order, as the serial update.
+void BroadPhaseSap::update(PxBaseTask* continuation)
+{
+	PX_PROFILE_ZONE("BroadPhase.SapUpdate", mContextID);
+
+	batchRemove();
+
+	//Check that the overlap pairs per axis have been reset.
+	PX_ASSERT(0==mBatchUpdateTasks[0].getPairsSize());
+	PX_ASSERT(0==mBatchUpdateTasks[1].getPairsSize());
+	PX_ASSERT(0==mBatchUpdateTasks[2].getPairsSize());
+
+	//Only the full batch update reads the other axes in a way that can be deferred. Few updates, or a scene
+	//too small to amortize the tasks, go down the serial path.
+	const bool runParallel = mUpdatedSize && (mUpdatedSize*5) >= mBoxesSize && mBoxesSize >= PARALLEL_BATCH_UPDATE_MIN_BOXES;
+	if(runParallel)
+	{
+		for(PxU32 i=1;i<3;i++)
+		{
+			mPrevBoxEndPts[i] = reinterpret_cast<SapBox1D*>(mScratchAllocator->alloc(sizeof(SapBox1D)*mBoxesCapacity, true, __FILE__, __LINE__));
+			PxMemCopy(mPrevBoxEndPts[i], mBoxEndPts[i], sizeof(SapBox1D)*mBoxesCapacity);
+		}
+	}
+
+	for(PxU32 i=0;i<3;i++)
+		mBatchUpdateTasks[i].setDefer2DTest(runParallel);
+
+	if(!runParallel)
+	{
+		mBatchUpdateTasks[0].runInternal();
+		mBatchUpdateTasks[1].runInternal();
+		mBatchUpdateTasks[2].runInternal();
+		return;
+	}
+
+	mSapBatchUpdateJoinTask.setBroadPhase(this);
+	mSapBatchUpdateJoinTask.setContinuation(continuation);
+	for(PxU32 i=0;i<3;i++)
+		mBatchUpdateTasks[i].setContinuation(&mSapBatchUpdateJoinTask);
+
+	mSapBatchUpdateJoinTask.removeReference();
+	for(PxU32 i=0;i<3;i++)
+		mBatchUpdateTasks[i].removeReference();
+}
+
+void BroadPhaseSap::spawnBatchUpdateFilterTasks(PxBaseTask* continuation)
+{
+	for(PxU32 i=0;i<3;i++)
+		mBatchUpdateFilterTasks[i].setContinuation(continuation);
+	for(PxU32 i=0;i<3;i++)
+		mBatchUpdateFilterTasks[i].removeReference();
+}
+
+void BroadPhaseSap::batchUpdateFilterPairs(const PxU32 Axis)
+{
+	PX_ASSERT(mPrevBoxEndPts[1] && mPrevBoxEndPts[2]);
+
+	//Same pairing of axes as in batchUpdate. Axes below Axis are read in their updated state, axes above in their previous state.
+	static const PxU32 otherAxes[6]={1,2,2,0,0,1};
+	const PxU32 axis0=otherAxes[2*Axis+0];
+	const PxU32 axis1=otherAxes[2*Axis+1];
+	const SapBox1D* PX_RESTRICT boxMinMax0 = axis0 < Axis ? mBoxEndPts[axis0] : mPrevBoxEndPts[axis0];
+	const SapBox1D* PX_RESTRICT boxMinMax1 = axis1 < Axis ? mBoxEndPts[axis1] : mPrevBoxEndPts[axis1];
+
+	BroadPhaseBatchUpdateWorkTask& task = mBatchUpdateTasks[Axis];
+	BroadPhasePair* PX_RESTRICT pairs = task.getPairs();
+	const PxU32 numPairs = task.getPairsSize();
+
+	PxU32 numKept=0;
+	for(PxU32 j=0;j<numPairs;j++)
+	{
+		const BpHandle volA=pairs[j].mVolA;
+		const BpHandle volB=pairs[j].mVolB;
+
+		//Created pairs (volA > volB) are always tested, deleted pairs only like in batchUpdate.
+		const bool test = BP_SAP_USE_OVERLAP_TEST_ON_REMOVES || volA > volB;
+		if(!test || Intersect2D_Handle(boxMinMax0[volA].mMinMax[0], boxMinMax0[volA].mMinMax[1], boxMinMax1[volA].mMinMax[0], boxMinMax1[volA].mMinMax[1],
+									   boxMinMax0[volB].mMinMax[0], boxMinMax0[volB].mMinMax[1], boxMinMax1[volB].mMinMax[0], boxMinMax1[volB].mMinMax[1]))
+		{
+			pairs[numKept++] = pairs[j];
+		}
+	}
+	task.setNumPairs(numKept);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static PX_FORCE_INLINE void InsertEndPoints(const ValType* PX_RESTRICT newEndPointValues, const BpHandle* PX_RESTRICT newEndPointDatas, PxU32 numNewEndPoints,
@@ -1112,7 +1239,7 @@ static BroadPhasePair* resizeBroadPhasePairArray(const PxU32 oldMaxNb, const PxU
 	PX_ASSERT(newMaxNb > oldMaxNb);
 	PX_ASSERT(newMaxNb > 0);
 	PX_ASSERT(0==((newMaxNb*sizeof(BroadPhasePair)) & 15)); 
-	BroadPhasePair* newElements = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*newMaxNb, true));
+	BroadPhasePair* newElements = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*newMaxNb, true, __FILE__, __LINE__));
 	PX_ASSERT(0==(uintptr_t(newElements) & 0x0f));
 	PxMemCopy(newElements, elements, oldMaxNb*sizeof(BroadPhasePair));
 	scratchAllocator->free(elements);
@@ -1123,12 +1250,15 @@ static BroadPhasePair* resizeBroadPhasePairArray(const PxU32 oldMaxNb, const PxU
 
 
 void BroadPhaseSap::batchUpdate
-(const PxU32 Axis, BroadPhasePair*& pairs, PxU32& pairsSize, PxU32& pairsCapacity)
+(const PxU32 Axis, BroadPhasePair*& pairs, PxU32& pairsSize, PxU32& pairsCapacity, const bool defer2DTest)
 {
 	//Nothin updated so don't do anything
 	if(mUpdatedSize == 0)
 		return;
 
+	//Deferring the 2D test is only valid for the full update, the other axes are being modified concurrently.
+	PX_ASSERT(!defer2DTest || (mUpdatedSize*5) >= mBoxesSize);
+
 		//If number updated is sufficiently fewer than number of boxes (say less than 20%)
 	if((mUpdatedSize*5) < mBoxesSize)
 	{
@@ -1159,6 +1289,10 @@ void BroadPhaseSap::batchUpdate
 
 	PxU8* PX_RESTRICT updated = mBoxesUpdated;
 
+	BpHandle* PX_RESTRICT listNext = mListNext[Axis];
+	BpHandle* PX_RESTRICT listPrev = mListPrev[Axis];
+	BroadPhaseActivityPocket* PX_RESTRICT activityPockets = mActivityPockets[Axis];
+
 	//KS - can we lazy create these inside the loop? Might benefit us
 
 	//There are no extents, jus the sentinels, so exit early.
@@ -1185,7 +1319,7 @@ void BroadPhaseSap::batchUpdate
 	//We'll never overlap with this sentinel but it just ensures that we don't need to branch to see if
 	//there's a pocket that we need to test against
 	
-	BroadPhaseActivityPocket* PX_RESTRICT currentPocket = mActivityPockets;
+	BroadPhaseActivityPocket* PX_RESTRICT currentPocket = activityPockets;
 
 	currentPocket->mEndIndex = 0;
 	currentPocket->mStartIndex = 0;
@@ -1221,7 +1355,7 @@ void BroadPhaseSap::batchUpdate
 
 			//We always iterate back through the list...
 
-			BpHandle CurrentIndex = mListPrev[ThisIndex];
+			BpHandle CurrentIndex = listPrev[ThisIndex];
 			ValType CurrentValue = BaseEPValues[CurrentIndex];
 			//PxBpHandle CurrentData = BaseEPDatas[CurrentIndex];
 
@@ -1261,8 +1395,8 @@ void BroadPhaseSap::batchUpdate
 							if(
 								BaseEPValues[id1->mMinMax[0]] < boxMax && 
 								//2D intersection test using up-to-date values
-								Intersect2D_Handle(boxMinMax0[handle].mMinMax[0], boxMinMax0[handle].mMinMax[1], boxMinMax1[handle].mMinMax[0], boxMinMax1[handle].mMinMax[1],
-								            boxMinMax0[ownerId].mMinMax[0],boxMinMax0[ownerId].mMinMax[1],boxMinMax1[ownerId].mMinMax[0],boxMinMax1[ownerId].mMinMax[1])
+								(defer2DTest || Intersect2D_Handle(boxMinMax0[handle].mMinMax[0], boxMinMax0[handle].mMinMax[1], boxMinMax1[handle].mMinMax[0], boxMinMax1[handle].mMinMax[1],
+								            boxMinMax0[ownerId].mMinMax[0],boxMinMax0[ownerId].mMinMax[1],boxMinMax1[ownerId].mMinMax[0],boxMinMax1[ownerId].mMinMax[1]))
 
 	#if BP_SAP_TEST_GROUP_ID_CREATEUPDATE
 		#ifdef BP_FILTERING_USES_TYPE_IN_GROUP
@@ -1290,7 +1424,7 @@ void BroadPhaseSap::batchUpdate
 						}
 	#endif
 						startIndex--;
-						CurrentIndex = mListPrev[CurrentIndex];
+						CurrentIndex = listPrev[CurrentIndex];
 						CurrentValue = BaseEPValues[CurrentIndex];
 					}
 					while(ThisValue < CurrentValue);
@@ -1312,8 +1446,8 @@ void BroadPhaseSap::batchUpdate
 #if 1
 							if(
 #if BP_SAP_USE_OVERLAP_TEST_ON_REMOVES
-								Intersect2D_Handle(boxMinMax0[handle].mMinMax[0], boxMinMax0[handle].mMinMax[1], boxMinMax1[handle].mMinMax[0], boxMinMax1[handle].mMinMax[1],
-								       boxMinMax0[ownerId].mMinMax[0],boxMinMax0[ownerId].mMinMax[1],boxMinMax1[ownerId].mMinMax[0],boxMinMax1[ownerId].mMinMax[1])
+								(defer2DTest || Intersect2D_Handle(boxMinMax0[handle].mMinMax[0], boxMinMax0[handle].mMinMax[1], boxMinMax1[handle].mMinMax[0], boxMinMax1[handle].mMinMax[1],
+								       boxMinMax0[ownerId].mMinMax[0],boxMinMax0[ownerId].mMinMax[1],boxMinMax1[ownerId].mMinMax[0],boxMinMax1[ownerId].mMinMax[1]))
 #endif
 #if BP_SAP_TEST_GROUP_ID_CREATEUPDATE
 	#ifdef BP_FILTERING_USES_TYPE_IN_GROUP
@@ -1342,7 +1476,7 @@ void BroadPhaseSap::batchUpdate
 						}
 	#endif
 						startIndex--;
-						CurrentIndex = mListPrev[CurrentIndex];
+						CurrentIndex = listPrev[CurrentIndex];
 						CurrentValue = BaseEPValues[CurrentIndex];
 					}
 					while(ThisValue < CurrentValue);
@@ -1351,21 +1485,21 @@ void BroadPhaseSap::batchUpdate
 				//This test is unnecessary. If we entered the outer loop, we're doing the swap in here
 				{
 					//Unlink from old position and re-link to new position
-					BpHandle oldNextIndex = mListNext[ThisIndex];
-					BpHandle oldPrevIndex = mListPrev[ThisIndex];
+					BpHandle oldNextIndex = listNext[ThisIndex];
+					BpHandle oldPrevIndex = listPrev[ThisIndex];
 
-					BpHandle newNextIndex = mListNext[CurrentIndex];
+					BpHandle newNextIndex = listNext[CurrentIndex];
 					BpHandle newPrevIndex = CurrentIndex;
 					
 					//Unlink this node
-					mListNext[oldPrevIndex] = oldNextIndex;
-					mListPrev[oldNextIndex] = oldPrevIndex;
+					listNext[oldPrevIndex] = oldNextIndex;
+					listPrev[oldNextIndex] = oldPrevIndex;
 
 					//Link it to it's new place in the list
-					mListNext[ThisIndex] = newNextIndex;
-					mListPrev[ThisIndex] = newPrevIndex;
-					mListPrev[newNextIndex] = ThisIndex;
-					mListNext[newPrevIndex] = ThisIndex;
+					listNext[ThisIndex] = newNextIndex;
+					listPrev[ThisIndex] = newPrevIndex;
+					listPrev[newNextIndex] = ThisIndex;
+					listNext[newPrevIndex] = ThisIndex;
 				}
 
 				//There is a sentinel with 0 index, so we don't need
@@ -1375,7 +1509,7 @@ void BroadPhaseSap::batchUpdate
 					currentPocket--;
 				}
 				//If our start index > currentPocket->mEndIndex, then we don't overlap so create a new pocket
-				if(currentPocket == mActivityPockets || startIndex > (currentPocket->mEndIndex+1))
+				if(currentPocket == activityPockets || startIndex > (currentPocket->mEndIndex+1))
 				{
 					currentPocket++;
 					currentPocket->mStartIndex = startIndex;
@@ -1393,13 +1527,13 @@ void BroadPhaseSap::batchUpdate
 	pairsCapacity=maxNumPairs;
 
 
-	BroadPhaseActivityPocket* pocket = mActivityPockets+1;
+	BroadPhaseActivityPocket* pocket = activityPockets+1;
 
 	while(pocket <= currentPocket)
 	{
 		for(PxU32 a = pocket->mStartIndex; a <= pocket->mEndIndex; ++a)
 		{
-			mListPrev[a] = BpHandle(a);
+			listPrev[a] = BpHandle(a);
 		}
 
 		//Now copy all the data to the array, updating the remap table
@@ -1407,9 +1541,9 @@ void BroadPhaseSap::batchUpdate
 		PxU32 CurrIndex = pocket->mStartIndex-1;
 		for(PxU32 a = pocket->mStartIndex; a <= pocket->mEndIndex; ++a)
 		{
-			CurrIndex = mListNext[CurrIndex];
+			CurrIndex = listNext[CurrIndex];
 			PxU32 origIndex =  CurrIndex;
-			BpHandle remappedIndex = mListPrev[origIndex];
+			BpHandle remappedIndex = listPrev[origIndex];
 
 			if(origIndex != a)
 			{
@@ -1424,9 +1558,9 @@ void BroadPhaseSap::batchUpdate
 				BaseEPValues[remappedIndex] = tmp;
 				BaseEPDatas[remappedIndex] = tmpHandle;
 
-				mListPrev[remappedIndex] = mListPrev[a];
+				listPrev[remappedIndex] = listPrev[a];
 				//Write back remap index (should be an immediate jump to original index)
-				mListPrev[mListPrev[a]] = remappedIndex;
+				listPrev[listPrev[a]] = remappedIndex;
 				asapBoxes[ownerId].mMinMax[IsMax] = BpHandle(a);
 			}
 			
@@ -1435,13 +1569,13 @@ void BroadPhaseSap::batchUpdate
 		////Reset next and prev ptrs back
 		for(PxU32 a = pocket->mStartIndex-1; a <= pocket->mEndIndex; ++a)
 		{
-			mListPrev[a+1] = BpHandle(a);
-			mListNext[a] = BpHandle(a+1);
+			listPrev[a+1] = BpHandle(a);
+			listNext[a] = BpHandle(a+1);
 		}
 
 		pocket++;
 	}
-	mListPrev[0] = 0;
+	listPrev[0] = 0;
 }
 
 
@@ -1474,6 +1608,10 @@ void BroadPhaseSap::batchUpdateFewUpdates
 
 	PxU8* PX_RESTRICT updated = mBoxesUpdated;
 
+	BpHandle* PX_RESTRICT listNext = mListNext[Axis];
+	BpHandle* PX_RESTRICT listPrev = mListPrev[Axis];
+	BroadPhaseActivityPocket* PX_RESTRICT activityPockets = mActivityPockets[Axis];
+
 	const PxU32 endPointSize = mBoxesSize*2 + 1;
 
 	//There are no extents, just the sentinels, so exit early.
@@ -1536,7 +1674,7 @@ void BroadPhaseSap::batchUpdateFewUpdates
 	
 	//We'll never overlap with this sentinel but it just ensures that we don't need to branch to see if
 	//there's a pocket that we need to test against
-	BroadPhaseActivityPocket* PX_RESTRICT currentPocket = mActivityPockets;
+	BroadPhaseActivityPocket* PX_RESTRICT currentPocket = activityPockets;
 	currentPocket->mEndIndex = 0;
 	currentPocket->mStartIndex = 0;
 
@@ -1570,7 +1708,7 @@ void BroadPhaseSap::batchUpdateFewUpdates
 			const ValType boxMax=encodeMax(boxMinMax3D[handle], Axis, mContactDistance[handle]);
 
 			//We always iterate back through the list...
-			BpHandle CurrentIndex = mListPrev[ThisIndex];
+			BpHandle CurrentIndex = listPrev[ThisIndex];
 			ValType CurrentValue = BaseEPValues[CurrentIndex];
 
 			if(CurrentValue > ThisValue)
@@ -1632,7 +1770,7 @@ void BroadPhaseSap::batchUpdateFewUpdates
 						}
 	#endif
 						startIndex--;
-						CurrentIndex = mListPrev[CurrentIndex];
+						CurrentIndex = listPrev[CurrentIndex];
 						CurrentValue = BaseEPValues[CurrentIndex];
 					}
 					while(ThisValue < CurrentValue);
@@ -1684,7 +1822,7 @@ void BroadPhaseSap::batchUpdateFewUpdates
 						}
 	#endif
 						startIndex--;
-						CurrentIndex = mListPrev[CurrentIndex];
+						CurrentIndex = listPrev[CurrentIndex];
 						CurrentValue = BaseEPValues[CurrentIndex];
 					}
 					while(ThisValue < CurrentValue);
@@ -1693,21 +1831,21 @@ void BroadPhaseSap::batchUpdateFewUpdates
 				//This test is unnecessary. If we entered the outer loop, we're doing the swap in here
 				{
 					//Unlink from old position and re-link to new position
-					BpHandle oldNextIndex = mListNext[ThisIndex];
-					BpHandle oldPrevIndex = mListPrev[ThisIndex];
+					BpHandle oldNextIndex = listNext[ThisIndex];
+					BpHandle oldPrevIndex = listPrev[ThisIndex];
 
-					BpHandle newNextIndex = mListNext[CurrentIndex];
+					BpHandle newNextIndex = listNext[CurrentIndex];
 					BpHandle newPrevIndex = CurrentIndex;
 					
 					//Unlink this node
-					mListNext[oldPrevIndex] = oldNextIndex;
-					mListPrev[oldNextIndex] = oldPrevIndex;
+					listNext[oldPrevIndex] = oldNextIndex;
+					listPrev[oldNextIndex] = oldPrevIndex;
 
 					//Link it to it's new place in the list
-					mListNext[ThisIndex] = newNextIndex;
-					mListPrev[ThisIndex] = newPrevIndex;
-					mListPrev[newNextIndex] = ThisIndex;
-					mListNext[newPrevIndex] = ThisIndex;
+					listNext[ThisIndex] = newNextIndex;
+					listPrev[ThisIndex] = newPrevIndex;
+					listPrev[newNextIndex] = ThisIndex;
+					listNext[newPrevIndex] = ThisIndex;
 				}
 
 				//Loop over the activity pocket stack to make sure this set of shuffles didn't 
@@ -1718,7 +1856,7 @@ void BroadPhaseSap::batchUpdateFewUpdates
 					currentPocket--;
 				}
 				//If our start index > currentPocket->mEndIndex, then we don't overlap so create a new pocket
-				if(currentPocket == mActivityPockets || startIndex > (currentPocket->mEndIndex+1))
+				if(currentPocket == activityPockets || startIndex > (currentPocket->mEndIndex+1))
 				{
 					currentPocket++;
 					currentPocket->mStartIndex = startIndex;
@@ -1728,7 +1866,7 @@ void BroadPhaseSap::batchUpdateFewUpdates
 			//Get prev and next ptr...
 
 			NextData = BaseEPDatas[++ind];
-			PrevData = BaseEPDatas[mListPrev[ind]];
+			PrevData = BaseEPDatas[listPrev[ind]];
 
 		}while(!isSentinel(NextData) && !updated[getOwner(NextData)] && updated[getOwner(PrevData)]);
 		
@@ -1738,23 +1876,23 @@ void BroadPhaseSap::batchUpdateFewUpdates
 	pairsCapacity=maxNumPairs;
 
 
-	BroadPhaseActivityPocket* pocket = mActivityPockets+1;
+	BroadPhaseActivityPocket* pocket = activityPockets+1;
 
 	while(pocket <= currentPocket)
 	{
-		//PxU32 CurrIndex = mListPrev[pocket->mStartIndex];
+		//PxU32 CurrIndex = listPrev[pocket->mStartIndex];
 		for(PxU32 a = pocket->mStartIndex; a <= pocket->mEndIndex; ++a)
 		{
-			mListPrev[a] = BpHandle(a);
+			listPrev[a] = BpHandle(a);
 		}
 
 		//Now copy all the data to the array, updating the remap table
 		PxU32 CurrIndex = pocket->mStartIndex-1;
 		for(PxU32 a = pocket->mStartIndex; a <= pocket->mEndIndex; ++a)
 		{
-			CurrIndex = mListNext[CurrIndex];
+			CurrIndex = listNext[CurrIndex];
 			PxU32 origIndex =  CurrIndex;
-			BpHandle remappedIndex = mListPrev[origIndex];
+			BpHandle remappedIndex = listPrev[origIndex];
 
 			if(origIndex != a)
 			{
@@ -1769,9 +1907,9 @@ void BroadPhaseSap::batchUpdateFewUpdates
 				BaseEPValues[remappedIndex] = tmp;
 				BaseEPDatas[remappedIndex] = tmpHandle;
 
-				mListPrev[remappedIndex] = mListPrev[a];
+				listPrev[remappedIndex] = listPrev[a];
 				//Write back remap index (should be an immediate jump to original index)
-				mListPrev[mListPrev[a]] = remappedIndex;
+				listPrev[listPrev[a]] = remappedIndex;
 				asapBoxes[ownerId].mMinMax[IsMax] = BpHandle(a);
 			}
 			
@@ -1779,8 +1917,8 @@ void BroadPhaseSap::batchUpdateFewUpdates
 
 		for(PxU32 a = pocket->mStartIndex-1; a <= pocket->mEndIndex; ++a)
 		{
-			mListPrev[a+1] = BpHandle(a);
-			mListNext[a] = BpHandle(a+1);
+			listPrev[a+1] = BpHandle(a);
+			listNext[a] = BpHandle(a+1);
 		}
 		pocket++;
 	}
@@ -66,7 +66,8 @@ public:
 		mAxis(0xffffffff),
 		mPairs(NULL),
 		mPairsSize(0),
-		mPairsCapacity(0)
+		mPairsCapacity(0),
+		mDefer2DTest(false)
 	{
 	}
 
@@ -76,6 +77,8 @@ public:
 
 	void set(class BroadPhaseSap* sap, const PxU32 axis) {mSap = sap; mAxis = axis;}
 
+	void setDefer2DTest(const bool defer2DTest) {mDefer2DTest = defer2DTest;}
+
 	BroadPhasePair* getPairs() const {return mPairs;}
 	PxU32 getPairsSize() const {return mPairsSize;}
 	PxU32 getPairsCapacity() const {return mPairsCapacity;}
@@ -92,6 +95,33 @@ private:
 	BroadPhasePair* mPairs;
 	PxU32 mPairsSize;
 	PxU32 mPairsCapacity;
+
+	//True when the axes are updated in parallel. The 2D overlap test on the other two axes is then
+	//skipped during the sort and performed afterwards by BroadPhaseBatchUpdateFilterTask.
+	bool mDefer2DTest;
+};
+
+class BroadPhaseBatchUpdateFilterTask: public Cm::Task
+{
+public:
+
+	BroadPhaseBatchUpdateFilterTask(PxU64 contextId=0) :
+		Cm::Task(contextId),
+		mSap(NULL),
+		mAxis(0xffffffff)
+	{
+	}
+
+	virtual void runInternal();
+
+	virtual const char* getName() const { return "BpBroadphaseSap.batchUpdateFilter"; }
+
+	void set(class BroadPhaseSap* sap, const PxU32 axis) {mSap = sap; mAxis = axis;}
+
+private:
+
+	class BroadPhaseSap* mSap;
+	PxU32 mAxis;
 };
 
 //KS - TODO, this could be reduced to U16 in smaller scenes
@@ -108,7 +138,9 @@ class BroadPhaseSap : public BroadPhase, public Ps::UserAllocated
 public:
 
 	friend class BroadPhaseBatchUpdateWorkTask;
+	friend class BroadPhaseBatchUpdateFilterTask;
 	friend class SapUpdateWorkTask;
+	friend class SapBatchUpdateJoinTask;
 	friend class SapPostUpdateWorkTask;
 
 										BroadPhaseSap(const PxU32 maxNbBroadPhaseOverlaps, const PxU32 maxNbStaticShapes, const PxU32 maxNbDynamicShapes, PxU64 contextID);
@@ -139,6 +171,7 @@ private:
 			PxcScratchAllocator*		mScratchAllocator;
 
 			SapUpdateWorkTask			mSapUpdateWorkTask;
+			SapBatchUpdateJoinTask		mSapBatchUpdateJoinTask;
 			SapPostUpdateWorkTask		mSapPostUpdateWorkTask;
 
 	//Data passed in from updateV.
@@ -166,9 +199,12 @@ private:
 
 			PxU8*						mBoxesUpdated;	
 			BpHandle*					mSortedUpdateElements;	
-			BroadPhaseActivityPocket*	mActivityPockets;
-			BpHandle*					mListNext;
-			BpHandle*					mListPrev;
+			BroadPhaseActivityPocket*	mActivityPockets[3];
+			BpHandle*					mListNext[3];
+			BpHandle*					mListPrev[3];
+
+	//Copy of the box end point indices of axes 1 and 2 taken before a parallel batch update (index 0 is unused).
+			SapBox1D*					mPrevBoxEndPts[3];
 
 			PxU32						mBoxesSize;				//Number of sorted boxes + number of unsorted (new) boxes
 			PxU32						mBoxesSizePrev;			//Number of sorted boxes 
@@ -196,14 +232,20 @@ private:
 
 			bool						setUpdateData(const BroadPhaseUpdateData& updateData);
 			void						update();
+			void						update(physx::PxBaseTask* continuation);
 			void						postUpdate();
 
+			void						initLists(const PxU32 axis, const PxU32 endPointsCapacity);
+
 	//Batch create/remove/update.
 			void						batchCreate();
 			void						batchRemove();
 			void						batchUpdate();
 
-			void						batchUpdate(const PxU32 Axis, BroadPhasePair*& pairs, PxU32& pairsSize, PxU32& pairsCapacity);
+			void						batchUpdate(const PxU32 Axis, BroadPhasePair*& pairs, PxU32& pairsSize, PxU32& pairsCapacity, const bool defer2DTest);
+
+			void						batchUpdateFilterPairs(const PxU32 Axis);
+			void						spawnBatchUpdateFilterTasks(physx::PxBaseTask* continuation);
 
 			void						batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pairs, PxU32& pairsSize, PxU32& pairsCapacity);
 
@@ -211,6 +253,7 @@ private:
 															bool& allNewBoxesStatics, bool& allOldBoxesStatics);
 
 			BroadPhaseBatchUpdateWorkTask mBatchUpdateTasks[3];
+			BroadPhaseBatchUpdateFilterTask mBatchUpdateFilterTasks[3];
 
 			PxU64						mContextID;
 #if PX_DEBUG
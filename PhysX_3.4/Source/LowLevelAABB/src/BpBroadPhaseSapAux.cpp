@@ -510,7 +510,7 @@ void ComputeCreatedDeletedPairsLists
 				// No need to call "ClearInArray" in this case, since the pair will get removed anyway
 				if(numDeletedPairs==maxNumDeletedPairs)
 				{
-					BroadPhasePair* newDeletedPairsList = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*2*maxNumDeletedPairs, true));
+					BroadPhasePair* newDeletedPairsList = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*2*maxNumDeletedPairs, true, __FILE__, __LINE__));
 					PxMemCopy(newDeletedPairsList, deletedPairsList, sizeof(BroadPhasePair)*maxNumDeletedPairs);
 					scratchAllocator->free(deletedPairsList);
 					deletedPairsList = newDeletedPairsList;
@@ -534,7 +534,7 @@ void ComputeCreatedDeletedPairsLists
 				{
 					if(numCreatedPairs==maxNumCreatedPairs)
 					{
-						BroadPhasePair* newCreatedPairsList = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*2*maxNumCreatedPairs, true));
+						BroadPhasePair* newCreatedPairsList = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*2*maxNumCreatedPairs, true, __FILE__, __LINE__));
 						PxMemCopy(newCreatedPairsList, createdPairsList, sizeof(BroadPhasePair)*maxNumCreatedPairs);
 						scratchAllocator->free(createdPairsList);
 						createdPairsList = newCreatedPairsList;
@@ -563,7 +563,7 @@ void ComputeCreatedDeletedPairsLists
 
 			if(numActualDeletedPairs==maxNumDeletedPairs)
 			{
-				BroadPhasePair* newDeletedPairsList = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*2*maxNumDeletedPairs, true));
+				BroadPhasePair* newDeletedPairsList = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*2*maxNumDeletedPairs, true, __FILE__, __LINE__));
 				PxMemCopy(newDeletedPairsList, deletedPairsList, sizeof(BroadPhasePair)*maxNumDeletedPairs);
 				scratchAllocator->free(deletedPairsList);
 				deletedPairsList = newDeletedPairsList;
@@ -644,7 +644,7 @@ void DeletePairsLists(const PxU32 numActualDeletedPairs, BroadPhasePair* deleted
 
 void DataArray::Resize(PxcScratchAllocator* scratchAllocator)
 {
-	BpHandle* newDataArray = reinterpret_cast<BpHandle*>(scratchAllocator->alloc(sizeof(BpHandle)*mCapacity*2, true));
+	BpHandle* newDataArray = reinterpret_cast<BpHandle*>(scratchAllocator->alloc(sizeof(BpHandle)*mCapacity*2, true, __FILE__, __LINE__));
 	PxMemCopy(newDataArray, mData, mCapacity*sizeof(BpHandle));
 	scratchAllocator->free(mData);
 	mData = newDataArray;
@@ -44,6 +44,9 @@ namespace physx
 
 #define MBP_USE_SCRATCHPAD
 
+// PT: max number of tasks the regions are distributed to in a multi-threaded update
+#define MBP_MAX_NB_REGION_TASKS	16
+
 	class MBPTask : public Cm::Task, public shdfnd::UserAllocated
 	{
 		public:
@@ -81,6 +84,37 @@ namespace physx
 		MBPUpdateWorkTask& operator=(const MBPUpdateWorkTask&);
 	};
 
+	// PT: multi-threaded version of MBPUpdateWorkTask. Each task prepares and prunes a contiguous range of regions,
+	// and collects the overlaps in its own pair manager. The task then inserts them into the shared pair manager without locks,
+	// and the pairs that did not fit are merged in MBPPostUpdateWorkTask.
+	class MBPRegionOverlapsTask : public MBPTask
+	{
+	public:
+								MBPRegionOverlapsTask(PxU64 contextId=0) : MBPTask(contextId), mTaskIndex(0), mStartRegion(0), mEndRegion(0)	{}
+								~MBPRegionOverlapsTask()																				{}
+
+		PX_FORCE_INLINE	void	setRegions(PxU32 taskIndex, PxU32 startRegion, PxU32 endRegion)
+								{
+									mTaskIndex = taskIndex;
+									mStartRegion = startRegion;
+									mEndRegion = endRegion;
+								}
+		// PxBaseTask
+		virtual const char*		getName() const { return "BpMBP.regionOverlaps"; }
+		//~PxBaseTask
+
+		// Cm::Task
+		virtual void			runInternal();
+		//~Cm::Task
+
+	private:
+				PxU32			mTaskIndex;
+				PxU32			mStartRegion;
+				PxU32			mEndRegion;
+
+		MBPRegionOverlapsTask& operator=(const MBPRegionOverlapsTask&);
+	};
+
 	// PT: this task runs after MBPUpdateWorkTask. This is where MBP_PairManager::removeMarkedPairs is called, to finalize
 	// the work and come up with created/removed lists. This is single-threaded.
 	class MBPPostUpdateWorkTask : public MBPTask
@@ -52,7 +52,15 @@ namespace Bp
 
 void SapUpdateWorkTask::runInternal()
 {
-	mSAP->update();
+	if(mNumCpuTasks > 1)
+		mSAP->update(mCont);
+	else
+		mSAP->update();
+}
+
+void SapBatchUpdateJoinTask::runInternal()
+{
+	mSAP->spawnBatchUpdateFilterTasks(mCont);
 }
 
 void SapPostUpdateWorkTask::runInternal()
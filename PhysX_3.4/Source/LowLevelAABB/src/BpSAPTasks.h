@@ -68,6 +68,29 @@ namespace Bp
 		PxU32 mNumCpuTasks;
 	};
 
+	// Runs once the three axes of a parallel batch update are sorted, and fans out the deferred overlap tests.
+	class SapBatchUpdateJoinTask: public Cm::Task
+	{
+	public:
+
+		SapBatchUpdateJoinTask(PxU64 contextId) : Cm::Task(contextId), mSAP(NULL)
+		{
+		}
+
+		void setBroadPhase(BroadPhaseSap* sap) 
+		{
+			mSAP = sap;
+		}
+
+		virtual void runInternal();
+
+		virtual const char* getName() const { return "BpSAP.batchUpdateJoin"; }
+
+	private:
+
+		BroadPhaseSap* mSAP;
+	};
+
 	class SapPostUpdateWorkTask: public Cm::Task
 	{
 	public:
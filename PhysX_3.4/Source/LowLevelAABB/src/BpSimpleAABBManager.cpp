@@ -30,6 +30,7 @@
 #include "CmRenderOutput.h"
 #include "CmFlushPool.h"
 #include "BpBroadPhaseMBPCommon.h"
+#include "BpBoxPruningAVX2.h"
 #include "BpSimpleAABBManager.h"
 #include "BpBroadPhase.h"
 #include "PsFoundation.h"
@@ -158,8 +159,9 @@ static void resetOrClear(T& a)
 		PX_FORCE_INLINE	PxU32							getNbAggregated()		const	{ return mAggregated.size();					}
 		PX_FORCE_INLINE	BoundsIndex						getAggregated(PxU32 i)	const	{ return mAggregated[i];						}
 		PX_FORCE_INLINE	const BoundsIndex*				getIndices()			const	{ return mAggregated.begin();					}
-		PX_FORCE_INLINE	void							addAggregated(BoundsIndex i)	{ mAggregated.pushBack(i);						}
-		PX_FORCE_INLINE	bool							removeAggregated(BoundsIndex i)	{ return mAggregated.findAndReplaceWithLast(i);	}	// PT: TODO: optimize?
+		PX_FORCE_INLINE	void							addAggregated(BoundsIndex i)	{ mAggregated.pushBack(i); invalidateBounds();	}
+		PX_FORCE_INLINE	bool							removeAggregated(BoundsIndex i)	{ invalidateBounds(); return mAggregated.findAndReplaceWithLast(i);	}	// PT: TODO: optimize?
+		PX_FORCE_INLINE	void							invalidateBounds()				{ mIncrementalBounds = false;					}
 
 		PX_FORCE_INLINE	void							resetDirtyState()				{ mDirtyIndex = PX_INVALID_U32;				}
 		PX_FORCE_INLINE	bool							isDirty()				const	{ return mDirtyIndex != PX_INVALID_U32;		}
@@ -173,7 +175,7 @@ static void resetOrClear(T& a)
 														}
 
 						void							allocateBounds();
-						void							computeBounds(const BoundsArray& boundsArray, const float* contactDistances)	/*PX_RESTRICT*/;
+						void							computeBounds(const BoundsArray& boundsArray, const float* contactDistances, const Cm::BitMapPinned* changedMap)	/*PX_RESTRICT*/;
 
 #ifdef STORE_SORTED_BOUNDS
 		PX_FORCE_INLINE	void							getSortedMinBounds()
@@ -196,6 +198,7 @@ static void resetOrClear(T& a)
 						Cm::RadixSortBuffered			mRS;
 #endif
 						bool							mDirtySort;
+						bool							mIncrementalBounds;	// PT: true when mInflatedBounds matches mAggregated, i.e. only changed shapes need to be re-encoded
 
 						void							sortBounds();
 						PX_NOCOPY(Aggregate)
@@ -776,6 +779,64 @@ static /*PX_FORCE_INLINE*/ void boxPruning(PairArray& pairs, const InflatedAABB*
 }
 #endif
 
+#if defined(USE_SIMD_BOUNDS) && defined(BP_AVX2_OVERLAP) && defined(STORE_SORTED_BOUNDS)
+	#define AGG_AVX2_OVERLAP
+
+	// PT: same filtering and reporting as the scalar loops, used by the AVX2 kernel
+	struct AggregateOverlapCallback
+	{
+		PX_FORCE_INLINE	AggregateOverlapCallback(PairArray& pairs, const Bp::FilterGroup::Enum* PX_RESTRICT groups,
+#ifdef BP_FILTERING_USES_TYPE_IN_GROUP
+			const bool* PX_RESTRICT lut,
+#endif
+			PxU32 aggIndex0, const BoundsIndex* PX_RESTRICT aggIndices1) :
+			mPairs(pairs), mGroups(groups),
+#ifdef BP_FILTERING_USES_TYPE_IN_GROUP
+			mLUT(lut),
+#endif
+			mAggIndex0(aggIndex0), mAggIndices1(aggIndices1)	{}
+
+		PX_FORCE_INLINE	void	operator()(PxU32 index1)
+		{
+			const PxU32 aggIndex1 = mAggIndices1[index1];
+#ifdef BP_FILTERING_USES_TYPE_IN_GROUP
+			if(groupFiltering(mGroups[mAggIndex0], mGroups[aggIndex1], mLUT))
+#else
+			if(groupFiltering(mGroups[mAggIndex0], mGroups[aggIndex1]))
+#endif
+				outputPair(mPairs, mAggIndex0, aggIndex1);
+		}
+
+		PairArray&								mPairs;
+		const Bp::FilterGroup::Enum* PX_RESTRICT	mGroups;
+#ifdef BP_FILTERING_USES_TYPE_IN_GROUP
+		const bool* PX_RESTRICT					mLUT;
+#endif
+		const PxU32								mAggIndex0;
+		const BoundsIndex* PX_RESTRICT			mAggIndices1;
+
+		PX_NOCOPY(AggregateOverlapCallback)
+	};
+
+	#ifdef BP_FILTERING_USES_TYPE_IN_GROUP
+		#define AGG_AVX2_PRUNE(box, boxes, nbBoxes, aggIndex, aggIndices)						\
+		if(gHasAVX2)																			\
+		{																						\
+			AggregateOverlapCallback callback(pairs, groups, lut, aggIndex, aggIndices);		\
+			index1 = findOverlapsAVX2(box, boxes, index1, nbBoxes, callback);					\
+		}
+	#else
+		#define AGG_AVX2_PRUNE(box, boxes, nbBoxes, aggIndex, aggIndices)						\
+		if(gHasAVX2)																			\
+		{																						\
+			AggregateOverlapCallback callback(pairs, groups, aggIndex, aggIndices);			\
+			index1 = findOverlapsAVX2(box, boxes, index1, nbBoxes, callback);					\
+		}
+	#endif
+#else
+	#define AGG_AVX2_PRUNE(box, boxes, nbBoxes, aggIndex, aggIndices)
+#endif
+
 #ifdef STORE_SORTED_BOUNDS
 static void boxPruning(	PairArray& pairs, const InflatedAABB* PX_RESTRICT bounds0, const InflatedAABB* PX_RESTRICT bounds1, const Bp::FilterGroup::Enum* PX_RESTRICT groups,
 #ifdef BP_FILTERING_USES_TYPE_IN_GROUP
@@ -799,6 +860,7 @@ static void boxPruning(	PairArray& pairs, const InflatedAABB* PX_RESTRICT bounds
 				runningAddress1++;
 
 			PxU32 index1 = runningAddress1;
+			AGG_AVX2_PRUNE(box0, bounds1, size1, aggIndex0, aggIndices1)
 			const InflatedType maxLimit = getMaxX(box0);
 			while(getMinX(bounds1[index1])<=maxLimit)
 			{
@@ -842,6 +904,7 @@ static void boxPruning(	PairArray& pairs, const InflatedAABB* PX_RESTRICT bounds
 				runningAddress0++;
 
 			PxU32 index1 = runningAddress0;
+			AGG_AVX2_PRUNE(box1, bounds0, size0, aggIndex0, aggIndices0)
 			const InflatedType maxLimit = getMaxX(box1);
 			while(getMinX(bounds0[index1])<=maxLimit)
 			{
@@ -1271,6 +1334,7 @@ void PersistentSelfCollisionPairs::findOverlaps(PairArray& pairs, const PxBounds
 			while(getMinX(bounds[runningAddress++])<minLimit);
 
 			PxU32 index1 = runningAddress;
+			AGG_AVX2_PRUNE(box0, bounds, size0, aggIndex0, mAggregate->getIndices())
 			const InflatedType maxLimit = getMaxX(box0);
 			while(getMinX(bounds[index1])<=maxLimit)
 			{
@@ -1323,7 +1387,8 @@ Aggregate::Aggregate(BoundsIndex index, bool selfCollisions) :
 	mIndex			(index),
 	mInflatedBounds	(NULL),
 	mAllocatedSize	(0),
-	mDirtySort		(false)
+	mDirtySort		(false),
+	mIncrementalBounds	(false)
 {
 	resetDirtyState();
 	mSelfCollisionPairs = selfCollisions ? PX_NEW(PersistentSelfCollisionPairs)(this) : NULL;
@@ -1342,6 +1407,38 @@ void Aggregate::sortBounds()
 	mDirtySort = false;
 	const PxU32 nbObjects = getNbAggregated();
 
+#ifdef STORE_SORTED_BOUNDS
+	// PT: aggregated shapes usually move a little from one frame to the next, so the previous order is almost right and an
+	// insertion sort fixes it in close to linear time. It is stable like the radix sort, so both give the same order. We
+	// give up when too many moves are needed and let the radix sort finish the job.
+	{
+		PxI32 budget = PxI32(nbObjects*4);
+		PxU32 i=1;
+		for(;i<nbObjects && budget>=0;i++)
+		{
+			const InflatedType minB = getMinX(mInflatedBounds[i]);
+			if(getMinX(mInflatedBounds[i-1])<=minB)
+				continue;
+
+			const InflatedAABB box = mInflatedBounds[i];
+			const BoundsIndex index = mAggregated[i];
+			PxU32 j = i;
+			do
+			{
+				mInflatedBounds[j] = mInflatedBounds[j-1];
+				mAggregated[j] = mAggregated[j-1];
+				j--;
+			}
+			while(j && getMinX(mInflatedBounds[j-1])>minB);
+			mInflatedBounds[j] = box;
+			mAggregated[j] = index;
+			budget -= PxI32(i-j);
+		}
+		if(i>=nbObjects && budget>=0)
+			return;
+	}
+#endif
+
 //	if(nbObjects>128)
 	{
 		PX_ALLOCA(minPosBounds, InflatedType, nbObjects+1);
@@ -1484,19 +1581,26 @@ void Aggregate::allocateBounds()
 	const PxU32 size = getNbAggregated();
 	if(size!=mAllocatedSize)
 	{
+		invalidateBounds();
 		mAllocatedSize = size;
 		PX_FREE(mInflatedBounds);
 		mInflatedBounds = reinterpret_cast<InflatedAABB*>(PX_ALLOC(sizeof(InflatedAABB)*(size+1), "mInflatedBounds"));
 	}
 }
 
-void Aggregate::computeBounds(const BoundsArray& boundsArray, const float* contactDistances) /*PX_RESTRICT*/
+// PT: the aggregate bounds always need all shapes, but when the inflated bounds are still in sync with mAggregated we only
+// re-encode the shapes marked in changedMap. Pass NULL to recompute everything.
+void Aggregate::computeBounds(const BoundsArray& boundsArray, const float* contactDistances, const Cm::BitMapPinned* changedMap) /*PX_RESTRICT*/
 {
 //	PX_PROFILE_ZONE("Aggregate::computeBounds",0);
 
 	const PxU32 size = getNbAggregated();
 	PX_ASSERT(size);
 
+	if(!mIncrementalBounds)
+		changedMap = NULL;
+	bool encodedBounds = false;
+
 	// PT: TODO: delay the conversion to integers until we sort (i.e. really need) the aggregated bounds?
 
 	const PxU32 lookAhead = 4;
@@ -1516,11 +1620,15 @@ void Aggregate::computeBounds(const BoundsArray& boundsArray, const float* conta
 		const Vec4V offsetV = V4Load(contactDistances[index0]);
 		minimumV = V4Sub(V4LoadU(&b.minimum.x), offsetV);
 		maximumV = V4Add(V4LoadU(&b.maximum.x), offsetV);
+		if(!changedMap || changedMap->boundedTest(index0))
+		{
 #ifdef USE_SIMD_BOUNDS
-		encodeBounds(&mInflatedBounds[0], minimumV, maximumV);
+			encodeBounds(&mInflatedBounds[0], minimumV, maximumV);
 #else
-		StoreBounds(mInflatedBounds[0], minimumV, maximumV);
+			StoreBounds(mInflatedBounds[0], minimumV, maximumV);
 #endif
+			encodedBounds = true;
+		}
 	}
 
 	for(PxU32 i=1;i<size;i++)
@@ -1538,11 +1646,15 @@ void Aggregate::computeBounds(const BoundsArray& boundsArray, const float* conta
 		const Vec4V aggregatedBoundsMaxV = V4Add(V4LoadU(&b.maximum.x), offsetV);
 		minimumV = V4Min(minimumV, aggregatedBoundsMinV);
 		maximumV = V4Max(maximumV, aggregatedBoundsMaxV);
+		if(!changedMap || changedMap->boundedTest(index))
+		{
 #ifdef USE_SIMD_BOUNDS
-		encodeBounds(&mInflatedBounds[i], aggregatedBoundsMinV, aggregatedBoundsMaxV);
+			encodeBounds(&mInflatedBounds[i], aggregatedBoundsMinV, aggregatedBoundsMaxV);
 #else
-		StoreBounds(mInflatedBounds[i], aggregatedBoundsMinV, aggregatedBoundsMaxV);
+			StoreBounds(mInflatedBounds[i], aggregatedBoundsMinV, aggregatedBoundsMaxV);
 #endif
+			encodedBounds = true;
+		}
 	}
 
 	StoreBounds(mBounds, minimumV, maximumV);
@@ -1563,7 +1675,10 @@ void Aggregate::computeBounds(const BoundsArray& boundsArray, const float* conta
 #else
 	mInflatedBounds[size].minimum.x = PX_MAX_F32;
 #endif
-	mDirtySort = true;
+	// PT: if no shape moved the previous order is still valid
+	if(encodedBounds)
+		mDirtySort = true;
+	mIncrementalBounds = true;
 }
 
 /////
@@ -1734,6 +1849,7 @@ void SimpleAABBManager::reserveSpaceForBounds(BoundsIndex index)
 // PT: TODO: what is the "userData" here?
 bool SimpleAABBManager::addBounds(BoundsIndex index, PxReal contactDistance, Bp::FilterGroup::Enum group, void* userData, AggregateHandle aggregateHandle, PxU8 volumeType)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eBROADPHASE);
 //	PX_ASSERT(checkID(index));
 
 	initEntry(index, contactDistance, group, userData);
@@ -1967,7 +2083,7 @@ void SimpleAABBManager::handleOriginShift()
 				{
 					aggregate->markAsDirty(mDirtyAggregates);
 					aggregate->allocateBounds();
-					aggregate->computeBounds(mBoundsArray, mContactDistance.begin());
+					aggregate->computeBounds(mBoundsArray, mContactDistance.begin(), NULL);
 					mBoundsArray.begin()[aggregate->mIndex] = aggregate->mBounds;
 					if(!mAddedHandleMap.test(i))
 						mUpdatedHandles.pushBack(i);	// PT: TODO: BoundsIndex-to-ShapeHandle confusion here
@@ -1981,6 +2097,7 @@ void AggregateBoundsComputationTask::runInternal()
 {
 	const BoundsArray& boundArray = mManager->getBoundsArray();
 	const float* contactDistances = mManager->getContactDistances();
+	const Cm::BitMapPinned& changedMap = mManager->getChangedAABBMgActorHandleMap();
 
 	PxU32 size = mNbToGo;
 	Aggregate** currentAggregate = mAggregates + mStart;
@@ -1993,7 +2110,7 @@ void AggregateBoundsComputationTask::runInternal()
 			Ps::prefetchLine(nextAggregate, 64);
 		}
 
-		(*currentAggregate)->computeBounds(boundArray, contactDistances);
+		(*currentAggregate)->computeBounds(boundArray, contactDistances, &changedMap);
 		currentAggregate++;
 	}
 }
@@ -2026,6 +2143,7 @@ void SimpleAABBManager::startAggregateBoundsComputationTasks(PxU32 nbToGo, PxU32
 
 void SimpleAABBManager::updateAABBsAndBP(PxU32 numCpuTasks, Cm::FlushPool& flushPool, PxcScratchAllocator* scratchAllocator, bool hasContactDistanceUpdated, PxBaseTask* continuation, PxBaseTask* narrowPhaseUnlockTask)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eBROADPHASE);
 	PX_PROFILE_ZONE("SimpleAABBManager::updateAABBsAndBP", getContextId());
 
 	mPersistentStateChanged = mPersistentStateChanged || hasContactDistanceUpdated;
@@ -2135,9 +2253,12 @@ void SimpleAABBManager::updateAABBsAndBP(PxU32 numCpuTasks, Cm::FlushPool& flush
 					}
 
 					aggregate->allocateBounds();
+					// PT: contact distances are not tracked per shape, so all shapes need to be re-encoded
+					if(hasContactDistanceUpdated)
+						aggregate->invalidateBounds();
 					if(singleThreaded)
 					{
-						aggregate->computeBounds(mBoundsArray, mContactDistance.begin());
+						aggregate->computeBounds(mBoundsArray, mContactDistance.begin(), &mChangedHandleMap);
 						mBoundsArray.begin()[aggregate->mIndex] = aggregate->mBounds;
 					}
 
@@ -2197,8 +2318,30 @@ void SimpleAABBManager::updateAABBsAndBP(PxU32 numCpuTasks, Cm::FlushPool& flush
 		mFinalizeUpdateTask.removeReference();
 }
 
+bool SimpleAABBManager::deferUpdate(bool hasContactDistanceUpdated, PxBaseTask* narrowPhaseUnlockTask)
+{
+	// Added and removed volumes must reach the broad phase in the step they were submitted, otherwise their pairs
+	// would be reported late (or, for removed volumes, reported for objects that do not exist anymore).
+	if(mOriginShifted || mAddedHandleMap.count() || mRemovedHandleMap.count())
+		return false;
+
+	PX_PROFILE_ZONE("SimpleAABBManager::deferUpdate", getContextId());
+
+	mPersistentStateChanged = mPersistentStateChanged || hasContactDistanceUpdated;
+
+	// postBroadPhase() only fetches broad phase results when one of these arrays is not empty
+	resetOrClear(mAddedHandles);
+	resetOrClear(mUpdatedHandles);
+	resetOrClear(mRemovedHandles);
+
+	mNarrowPhaseUnblockTask = narrowPhaseUnlockTask;
+	narrowPhaseUnlockTask->removeReference();
+	return true;
+}
+
 void SimpleAABBManager::finalizeUpdate(PxU32 numCpuTasks, PxcScratchAllocator* scratchAllocator, PxBaseTask* continuation, PxBaseTask* narrowPhaseUnlockTask)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eBROADPHASE);
 	PX_PROFILE_ZONE("SimpleAABBManager::finalizeUpdate", getContextId());
 
 	const bool singleThreaded = gSingleThreaded || numCpuTasks<2;
@@ -2802,6 +2945,7 @@ static void processAggregatePairsParallel(AggPairMap& map, SimpleAABBManager& ma
 
 void SimpleAABBManager::postBroadPhase(PxBaseTask* continuation, PxBaseTask* narrowPhaseUnlockTask, Cm::FlushPool& flushPool)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eBROADPHASE);
 	PX_PROFILE_ZONE("SimpleAABBManager::postBroadPhase", getContextId());
 
 	//KS - There is a continuation task for discrete broad phase, but not for CCD broad phase. PostBroadPhase for CCD broad phase runs in-line.
@@ -163,6 +163,12 @@ class Cloth
 	virtual void setSolverFrequency(float) = 0;
 	virtual float getSolverFrequency() const = 0;
 
+	// level of detail, scales the solver frequency (default=1).
+	// a factor of 0 freezes the cloth: it is not simulated and
+	// reports being asleep until the factor is raised again.
+	virtual void setLodFactor(float) = 0;
+	virtual float getLodFactor() const = 0;
+
 	// damp, drag, stiffness exponent per second
 	virtual void setStiffnessFrequency(float) = 0;
 	virtual float getStiffnessFrequency() const = 0;
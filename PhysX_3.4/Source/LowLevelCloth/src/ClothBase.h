@@ -61,6 +61,7 @@ void initialize(Cloth& cloth, const PxVec4* pIt, const PxVec4* pEnd)
 	cloth.mAngularInertia = PxVec3(1.0f);
 	cloth.mCentrifugalInertia = PxVec3(1.0f);
 	cloth.mSolverFrequency = 60.0f;
+	cloth.mLodFactor = 1.0f;
 	cloth.mStiffnessFrequency = 10.0f;
 	cloth.mTargetMotion = PxTransform(PxIdentity);
 	cloth.mCurrentMotion = PxTransform(PxIdentity);
@@ -101,6 +102,7 @@ void copy(DstCloth& dstCloth, const SrcCloth& srcCloth)
 	dstCloth.mAngularInertia = srcCloth.mAngularInertia;
 	dstCloth.mCentrifugalInertia = srcCloth.mCentrifugalInertia;
 	dstCloth.mSolverFrequency = srcCloth.mSolverFrequency;
+	dstCloth.mLodFactor = srcCloth.mLodFactor;
 	dstCloth.mStiffnessFrequency = srcCloth.mStiffnessFrequency;
 	dstCloth.mTargetMotion = srcCloth.mTargetMotion;
 	dstCloth.mCurrentMotion = srcCloth.mCurrentMotion;
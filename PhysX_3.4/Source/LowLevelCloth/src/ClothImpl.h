@@ -100,6 +100,9 @@ class ClothImpl : public UserAllocated, public Cloth
 	virtual void setSolverFrequency(float frequency);
 	virtual float getSolverFrequency() const;
 
+	virtual void setLodFactor(float factor);
+	virtual float getLodFactor() const;
+
 	virtual void setStiffnessFrequency(float frequency);
 	virtual float getStiffnessFrequency() const;
 
@@ -453,6 +456,23 @@ inline float ClothImpl<T>::getSolverFrequency() const
 	return mCloth.mSolverFrequency;
 }
 
+template <typename T>
+inline void ClothImpl<T>::setLodFactor(float factor)
+{
+	if(factor == mCloth.mLodFactor)
+		return;
+
+	mCloth.mLodFactor = factor;
+	mCloth.mIterDtAvg.reset();
+	mCloth.wakeUp();
+}
+
+template <typename T>
+inline float ClothImpl<T>::getLodFactor() const
+{
+	return mCloth.mLodFactor;
+}
+
 template <typename T>
 inline void ClothImpl<T>::setStiffnessFrequency(float frequency)
 {
@@ -522,6 +542,8 @@ inline void ClothImpl<T>::setSpheres(Range<const PxVec4> spheres, uint32_t first
 	if(!oldSize && !newSize)
 		return;
 
+	bool moved = oldSize != newSize;
+
 	if(!oldSize)
 	{
 		ContextLockType contextLock(mCloth.mFactory);
@@ -584,10 +606,15 @@ inline void ClothImpl<T>::setSpheres(Range<const PxVec4> spheres, uint32_t first
 
 		// fill target elements with spheres
 		for(uint32_t i = 0; i < spheres.size(); ++i)
+		{
+			moved |= spheres[i] != start[first + i];
 			target[first + i] = spheres[i];
+		}
 	}
 
-	mCloth.wakeUp();
+	// spheres which are set to their current value every frame don't keep the cloth awake
+	if(moved)
+		mCloth.wakeUp();
 }
 
 template <typename T>
@@ -660,6 +687,8 @@ inline void ClothImpl<T>::setPlanes(Range<const PxVec4> planes, uint32_t first,
 	if(!oldSize && !newSize)
 		return;
 
+	bool moved = oldSize != newSize;
+
 	if(!oldSize)
 	{
 		ContextLockType contextLock(mCloth.mFactory);
@@ -721,10 +750,14 @@ inline void ClothImpl<T>::setPlanes(Range<const PxVec4> planes, uint32_t first,
 
 		// fill target elements with planes
 		for(uint32_t i = 0; i < planes.size(); ++i)
+		{
+			moved |= planes[i] != mCloth.mStartCollisionPlanes[first + i];
 			mCloth.mTargetCollisionPlanes[first + i] = planes[i];
+		}
 	}
 
-	mCloth.wakeUp();
+	if(moved)
+		mCloth.wakeUp();
 }
 
 template <typename T>
@@ -170,7 +170,7 @@ inline float cloth::IterationState<Simd4f>::getPreviousAlpha() const
 template <typename MyCloth>
 cloth::IterationStateFactory::IterationStateFactory(MyCloth& cloth, float frameDt)
 {
-	mNumIterations = PxMax(1, int(frameDt * cloth.mSolverFrequency + 0.5f));
+	mNumIterations = PxMax(1, int(frameDt * cloth.mSolverFrequency * cloth.mLodFactor + 0.5f));
 	mInvNumIterations = 1.0f / mNumIterations;
 	mIterDt = frameDt * mInvNumIterations;
 
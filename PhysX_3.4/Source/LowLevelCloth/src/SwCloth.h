@@ -89,7 +89,11 @@ class SwCloth
   public:
 	bool isSleeping() const
 	{
-		return mSleepPassCounter >= mSleepAfterCount;
+		return mSleepPassCounter >= mSleepAfterCount || isFrozen();
+	}
+	bool isFrozen() const
+	{
+		return mLodFactor == 0.0f;
 	}
 	void wakeUp()
 	{
@@ -126,6 +130,7 @@ class SwCloth
 	PxVec3 mAngularInertia;
 	PxVec3 mCentrifugalInertia;
 	float mSolverFrequency;
+	float mLodFactor; // solver frequency scale, 0 freezes the cloth
 	float mStiffnessFrequency;
 
 	PxTransform mTargetMotion;
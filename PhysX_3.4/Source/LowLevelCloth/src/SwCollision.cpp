@@ -38,6 +38,25 @@
 #include "SwCollisionHelpers.h"
 #include <cstring> // for memset
 
+#define PX_AVX (NV_SIMD_SIMD&&(PX_WIN32 || PX_WIN64) && PX_VC >= 10)
+
+#if PX_AVX
+namespace avx
+{
+// defined in SwSolverKernel.cpp, 0: no AVX, 1: AVX, 2: AVX+FMA
+uint32_t getSupport();
+
+// defined in SwCollideShapes.cpp
+
+template <uint32_t>
+uint32_t collideConvexes(float* __restrict, const float* __restrict, float* __restrict, const float* __restrict,
+                         uint32_t, const uint32_t* __restrict, uint32_t, float);
+
+template <uint32_t>
+uint32_t collideTriangles(float* __restrict, const float* __restrict, const float* __restrict, uint32_t);
+}
+#endif
+
 using namespace physx;
 
 // the particle trajectory needs to penetrate more than 0.2 * radius to trigger continuous collision
@@ -1196,6 +1215,74 @@ PX_INLINE void calculateFrictionImpulse(const Simd4f& deltaX, const Simd4f& delt
 	impulse[2] = rvtz * j;
 }
 
+// 8-wide collision against all convexes, returns false if AVX is not available
+template <typename Simd4f>
+bool collideConvexesAvx(const cloth::SwClothData&, const Simd4f*, uint32_t&)
+{
+	return false;
+}
+
+// 8-wide collision against all triangles, returns false if AVX is not available
+template <typename Simd4f>
+bool collideTrianglesAvx(const cloth::SwClothData&, const cloth::TriangleData*, uint32_t&)
+{
+	return false;
+}
+
+#if PX_AVX
+template <>
+bool collideConvexesAvx<Simd4f>(const cloth::SwClothData& clothData, const Simd4f* planes, uint32_t& numCollisions)
+{
+	float* curIt = clothData.mCurParticles;
+	float* curEnd = curIt + clothData.mNumParticles * 4;
+	float* prevIt = clothData.mPrevParticles;
+	const float* planePtr = array(*planes);
+
+	switch(avx::getSupport())
+	{
+	case 2:
+#if _MSC_VER >= 1700
+		numCollisions += avx::collideConvexes<2>(curIt, curEnd, prevIt, planePtr, clothData.mNumPlanes,
+		                                         clothData.mConvexMasks, clothData.mNumConvexes,
+		                                         clothData.mFrictionScale);
+		return true;
+#endif
+	case 1:
+		numCollisions += avx::collideConvexes<1>(curIt, curEnd, prevIt, planePtr, clothData.mNumPlanes,
+		                                         clothData.mConvexMasks, clothData.mNumConvexes,
+		                                         clothData.mFrictionScale);
+		return true;
+	default:
+		return false;
+	}
+}
+
+template <>
+bool collideTrianglesAvx<Simd4f>(const cloth::SwClothData& clothData, const cloth::TriangleData* triangles,
+                                 uint32_t& numCollisions)
+{
+	float* curIt = clothData.mCurParticles;
+	float* curEnd = curIt + clothData.mNumParticles * 4;
+	const float* trianglePtr = reinterpret_cast<const float*>(triangles);
+
+	switch(avx::getSupport())
+	{
+	case 2:
+#if _MSC_VER >= 1700
+		numCollisions +=
+		    avx::collideTriangles<2>(curIt, curEnd, trianglePtr, clothData.mNumCollisionTriangles);
+		return true;
+#endif
+	case 1:
+		numCollisions +=
+		    avx::collideTriangles<1>(curIt, curEnd, trianglePtr, clothData.mNumCollisionTriangles);
+		return true;
+	default:
+		return false;
+	}
+}
+#endif
+
 } // anonymous namespace
 
 template <typename Simd4f>
@@ -1611,6 +1698,12 @@ void cloth::SwCollision<Simd4f>::collideConvexes(const IterationState<Simd4f>& s
 		generatePlanes(planes, targetPlanes, mClothData.mNumPlanes);
 	}
 
+	if(collideConvexesAvx<Simd4f>(mClothData, planes, mNumCollisions))
+	{
+		mAllocator.deallocate(planes);
+		return;
+	}
+
 	Simd4f curPos[4], prevPos[4];
 
 	const bool frictionEnabled = mClothData.mFrictionScale > 0.0f;
@@ -1755,6 +1848,12 @@ void cloth::SwCollision<Simd4f>::collideTriangles(const IterationState<Simd4f>&
 		generateTriangles<Simd4f>(triangles, targetTriangles, mClothData.mNumCollisionTriangles);
 	}
 
+	if(collideTrianglesAvx<Simd4f>(mClothData, triangles, mNumCollisions))
+	{
+		mAllocator.deallocate(triangles);
+		return;
+	}
+
 	Simd4f positions[4];
 
 	float* __restrict pIt = mClothData.mCurParticles;
@@ -139,6 +139,8 @@ cloth::SwInterCollision<Simd4f>::SwInterCollision(const cloth::SwInterCollisionD
 , mClothIndices(NULL)
 , mParticleIndices(NULL)
 , mNumParticles(0)
+, mOverlapMasks(NULL)
+, mNumMaskWords(0)
 , mTotalParticles(0)
 , mFilter(filter)
 , mAllocator(alloc)
@@ -200,37 +202,39 @@ struct ClothSorter
 	uint32_t mAxis;
 };
 
-// for the given cloth array this function calculates the set of particles
-// which potentially interact, the potential colliders are returned with their
-// cloth index and particle index in clothIndices and particleIndices, the
-// function returns the number of potential colliders
+uint32_t findRoot(uint32_t* parents, uint32_t index)
+{
+	while(parents[index] != index)
+		index = parents[index] = parents[parents[index]];
+	return index;
+}
+
+// finds the pairs of cloths whose world bounds (inflated by the collision distance) overlap and which are not
+// filtered, sets the corresponding bits in overlapMasks (numMaskWords words per cloth), and groups the cloths
+// into islands of transitively overlapping cloths. The cloths of islands with at least two cloths are returned
+// in islandCloths, island i being [islandOffsets[i], islandOffsets[i+1]). The function returns the number of islands.
 template <typename Simd4f>
-uint32_t calculatePotentialColliders(const cloth::SwInterCollisionData* cBegin, const cloth::SwInterCollisionData* cEnd,
-                                     const Simd4f& colDist, uint16_t* clothIndices, uint32_t* particleIndices,
-                                     cloth::BoundingBox<Simd4f>& bounds, uint32_t* overlapMasks,
-                                     cloth::InterCollisionFilter filter, cloth::SwKernelAllocator& allocator)
+uint32_t calculateClothIslands(const cloth::SwInterCollisionData* cloths, uint32_t numCloths, const Simd4f& colDist,
+                               cloth::InterCollisionFilter filter, uint32_t* overlapMasks, uint32_t numMaskWords,
+                               uint32_t* islandCloths, uint32_t* islandOffsets, cloth::SwKernelAllocator& allocator)
 {
 	using namespace cloth;
 
 	typedef BoundingBox<Simd4f> BoundingBox;
 
-	uint32_t numParticles = 0;
-	const uint32_t numCloths = uint32_t(cEnd - cBegin);
-
 	// bounds of each cloth objects in world space
 	BoundingBox* const clothBounds = static_cast<BoundingBox*>(allocator.allocate(numCloths * sizeof(BoundingBox)));
-	BoundingBox* const overlapBounds = static_cast<BoundingBox*>(allocator.allocate(numCloths * sizeof(BoundingBox)));
 
 	// union of all cloth world bounds
 	BoundingBox totalClothBounds = emptyBounds<Simd4f>();
 
 	uint32_t* sortedIndices = static_cast<uint32_t*>(allocator.allocate(numCloths * sizeof(uint32_t)));
+	uint32_t* parents = static_cast<uint32_t*>(allocator.allocate(numCloths * sizeof(uint32_t)));
 
 	for(uint32_t i = 0; i < numCloths; ++i)
 	{
-		const SwInterCollisionData& c = cBegin[i];
+		const SwInterCollisionData& c = cloths[i];
 
-		// transform bounds from b local space to local space of a
 		PxBounds3 lcBounds = PxBounds3::centerExtents(c.mBoundsCenter, c.mBoundsHalfExtent + PxVec3(array(colDist)[0]));
 		PX_ASSERT(!lcBounds.isEmpty());
 		PxBounds3 cWorld = PxBounds3::transformFast(c.mGlobalPose, lcBounds);
@@ -239,6 +243,7 @@ uint32_t calculatePotentialColliders(const cloth::SwInterCollisionData* cBegin,
 			                    simd4f(cWorld.maximum.x, cWorld.maximum.y, cWorld.maximum.z, 0.0f) };
 
 		sortedIndices[i] = i;
+		parents[i] = i;
 		clothBounds[i] = cBounds;
 
 		totalClothBounds = expandBounds(totalClothBounds, cBounds);
@@ -250,50 +255,105 @@ uint32_t calculatePotentialColliders(const cloth::SwInterCollisionData* cBegin,
 	ClothSorter<Simd4f> predicate(clothBounds, numCloths, sweepAxis);
 	shdfnd::sort(sortedIndices, numCloths, predicate);
 
+	PxMemZero(overlapMasks, numCloths * numMaskWords * sizeof(uint32_t));
+
+	// sweep the sorted bounds, each pair is found once from the cloth with the smaller minimum extent
 	for(uint32_t i = 0; i < numCloths; ++i)
 	{
-		PX_ASSERT(sortedIndices[i] < numCloths);
+		const uint32_t aIndex = sortedIndices[i];
+		const BoundingBox& aBounds = clothBounds[aIndex];
+		const float axisMax = array(aBounds.mUpper)[sweepAxis];
 
-		const SwInterCollisionData& a = cBegin[sortedIndices[i]];
+		for(uint32_t j = i + 1; j < numCloths; ++j)
+		{
+			const uint32_t bIndex = sortedIndices[j];
+			const BoundingBox& bBounds = clothBounds[bIndex];
 
-		// local bounds
-		const Simd4f aCenter = load(reinterpret_cast<const float*>(&a.mBoundsCenter));
-		const Simd4f aHalfExtent = load(reinterpret_cast<const float*>(&a.mBoundsHalfExtent)) + colDist;
-		const BoundingBox aBounds = { aCenter - aHalfExtent, aCenter + aHalfExtent };
+			// early out if no more cloths along axis intersect us
+			if(array(bBounds.mLower)[sweepAxis] > axisMax)
+				break;
 
-		const PxMat44 aToWorld(a.mGlobalPose);
-		const PxTransform aToLocal(a.mGlobalPose.getInverse());
+			if(anyGreater(aBounds.mLower, bBounds.mUpper) != 0 || anyGreater(bBounds.mLower, aBounds.mUpper) != 0)
+				continue;
 
-		const float axisMin = array(clothBounds[sortedIndices[i]].mLower)[sweepAxis];
-		const float axisMax = array(clothBounds[sortedIndices[i]].mUpper)[sweepAxis];
+			// check if collision between these shapes is filtered
+			if(!filter(cloths[aIndex].mUserData, cloths[bIndex].mUserData))
+				continue;
 
-		uint32_t overlapMask = 0;
-		uint32_t numOverlaps = 0;
+			overlapMasks[aIndex * numMaskWords + (bIndex >> 5)] |= 1u << (bIndex & 31);
+			overlapMasks[bIndex * numMaskWords + (aIndex >> 5)] |= 1u << (aIndex & 31);
 
-		// scan back to find first intersecting bounding box
-		uint32_t startIndex = i;
-		while(startIndex > 0 && array(clothBounds[sortedIndices[startIndex]].mUpper)[sweepAxis] > axisMin)
-			--startIndex;
+			parents[findRoot(parents, aIndex)] = findRoot(parents, bIndex);
+		}
+	}
 
-		// compute all overlapping bounds
-		for(uint32_t j = startIndex; j < numCloths; ++j)
-		{
-			// ignore self-collision
-			if(i == j)
-				continue;
+	// count the cloths of each island at its root (reusing the sorted indices)
+	uint32_t* islandSizes = sortedIndices;
+	PxMemZero(islandSizes, numCloths * sizeof(uint32_t));
+	for(uint32_t i = 0; i < numCloths; ++i)
+		++islandSizes[findRoot(parents, i)];
 
-			// early out if no more cloths along axis intersect us
-			if(array(clothBounds[sortedIndices[j]].mLower)[sweepAxis] > axisMax)
-				break;
+	// turn the sizes of the islands with at least two cloths into insertion offsets, clear the others
+	uint32_t numIslands = 0, numIslandCloths = 0;
+	for(uint32_t i = 0; i < numCloths; ++i)
+	{
+		uint32_t size = islandSizes[i];
+		islandSizes[i] = uint32_t(-1);
+		if(size < 2)
+			continue;
+
+		islandOffsets[numIslands++] = numIslandCloths;
+		islandSizes[i] = numIslandCloths;
+		numIslandCloths += size;
+	}
+	islandOffsets[numIslands] = numIslandCloths;
+
+	for(uint32_t i = 0; i < numCloths; ++i)
+	{
+		uint32_t& offset = islandSizes[findRoot(parents, i)];
+		if(offset != uint32_t(-1))
+			islandCloths[offset++] = i;
+	}
 
-			const SwInterCollisionData& b = cBegin[sortedIndices[j]];
+	allocator.deallocate(parents);
+	allocator.deallocate(sortedIndices);
+	allocator.deallocate(clothBounds);
 
-			// check if collision between these shapes is filtered
-			if(!filter(a.mUserData, b.mUserData))
-				continue;
+	return numIslands;
+}
+
+// for the given cloth this function calculates the set of its particles
+// which potentially interact with the overlapping cloths, transforms them to world
+// space and appends them with their cloth and particle index to clothIndices and
+// particleIndices, the function returns the number of potential colliders
+template <typename Simd4f>
+uint32_t calculatePotentialColliders(const cloth::SwInterCollisionData* cloths, uint32_t clothIndex,
+                                     const uint32_t* overlapMask, uint32_t numMaskWords, const Simd4f& colDist,
+                                     uint16_t* clothIndices, uint32_t* particleIndices,
+                                     cloth::BoundingBox<Simd4f>& bounds, cloth::BoundingBox<Simd4f>* overlapBounds)
+{
+	using namespace cloth;
+
+	typedef BoundingBox<Simd4f> BoundingBox;
+
+	const SwInterCollisionData& a = cloths[clothIndex];
 
-			// set mask bit for this cloth
-			overlapMask |= 1 << sortedIndices[j];
+	// local bounds
+	const Simd4f aCenter = load(reinterpret_cast<const float*>(&a.mBoundsCenter));
+	const Simd4f aHalfExtent = load(reinterpret_cast<const float*>(&a.mBoundsHalfExtent)) + colDist;
+	const BoundingBox aBounds = { aCenter - aHalfExtent, aCenter + aHalfExtent };
+
+	const PxMat44 aToWorld(a.mGlobalPose);
+	const PxTransform aToLocal(a.mGlobalPose.getInverse());
+
+	uint32_t numOverlaps = 0;
+
+	// compute the bounds overlapping each cloth of the mask
+	for(uint32_t w = 0; w < numMaskWords; ++w)
+	{
+		for(uint32_t bits = overlapMask[w]; bits; bits &= bits - 1)
+		{
+			const SwInterCollisionData& b = cloths[w * 32 + shdfnd::lowestSetBitUnsafe(bits)];
 
 			// transform bounds from b local space to local space of a
 			PxBounds3 lcBounds =
@@ -314,63 +374,58 @@ uint32_t calculatePotentialColliders(const cloth::SwInterCollisionData* cBegin,
 			if(!isEmptyBounds(iBounds))
 				overlapBounds[numOverlaps++] = iBounds;
 		}
+	}
 
-		//----------------------------------------------------------------
-		// cull all particles to overlapping bounds and transform particles to world space
+	//----------------------------------------------------------------
+	// cull all particles to overlapping bounds and transform particles to world space
 
-		const uint32_t clothIndex = sortedIndices[i];
-		overlapMasks[clothIndex] = overlapMask;
+	uint32_t numParticles = 0;
 
-		Simd4f* pBegin = reinterpret_cast<Simd4f*>(a.mParticles);
-		Simd4f* qBegin = reinterpret_cast<Simd4f*>(a.mPrevParticles);
+	Simd4f* pBegin = reinterpret_cast<Simd4f*>(a.mParticles);
+	Simd4f* qBegin = reinterpret_cast<Simd4f*>(a.mPrevParticles);
 
-		const Simd4f xform[4] = { load(reinterpret_cast<const float*>(&aToWorld.column0)),
-			                      load(reinterpret_cast<const float*>(&aToWorld.column1)),
-			                      load(reinterpret_cast<const float*>(&aToWorld.column2)),
-			                      load(reinterpret_cast<const float*>(&aToWorld.column3)) };
+	const Simd4f xform[4] = { load(reinterpret_cast<const float*>(&aToWorld.column0)),
+		                      load(reinterpret_cast<const float*>(&aToWorld.column1)),
+		                      load(reinterpret_cast<const float*>(&aToWorld.column2)),
+		                      load(reinterpret_cast<const float*>(&aToWorld.column3)) };
 
-		Simd4f impulseInvScale = recip(Simd4f(simd4f(cBegin[clothIndex].mImpulseScale)));
+	Simd4f impulseInvScale = recip(Simd4f(simd4f(a.mImpulseScale)));
 
-		for(uint32_t k = 0; k < a.mNumParticles; ++k)
-		{
-			Simd4f* pIt = a.mIndices ? pBegin + a.mIndices[k] : pBegin + k;
-			Simd4f* qIt = a.mIndices ? qBegin + a.mIndices[k] : qBegin + k;
+	for(uint32_t k = 0; numOverlaps && k < a.mNumParticles; ++k)
+	{
+		Simd4f* pIt = a.mIndices ? pBegin + a.mIndices[k] : pBegin + k;
+		Simd4f* qIt = a.mIndices ? qBegin + a.mIndices[k] : qBegin + k;
 
-			const Simd4f p = *pIt;
+		const Simd4f p = *pIt;
 
-			for(const BoundingBox* oIt = overlapBounds, *oEnd = overlapBounds + numOverlaps; oIt != oEnd; ++oIt)
-			{
-				// point in box test
-				if(anyGreater(oIt->mLower, p) != 0)
-					continue;
-				if(anyGreater(p, oIt->mUpper) != 0)
-					continue;
+		for(const BoundingBox* oIt = overlapBounds, *oEnd = overlapBounds + numOverlaps; oIt != oEnd; ++oIt)
+		{
+			// point in box test
+			if(anyGreater(oIt->mLower, p) != 0)
+				continue;
+			if(anyGreater(p, oIt->mUpper) != 0)
+				continue;
 
-				// transform particle to world space in-place
-				// (will be transformed back after collision)
-				*pIt = transform(xform, p);
+			// transform particle to world space in-place
+			// (will be transformed back after collision)
+			*pIt = transform(xform, p);
 
-				Simd4f impulse = (p - *qIt) * impulseInvScale;
-				*qIt = rotate(xform, impulse);
+			Simd4f impulse = (p - *qIt) * impulseInvScale;
+			*qIt = rotate(xform, impulse);
 
-				// update world bounds
-				bounds = expandBounds(bounds, pIt, pIt + 1);
+			// update world bounds
+			bounds = expandBounds(bounds, pIt, pIt + 1);
 
-				// add particle to output arrays
-				clothIndices[numParticles] = uint16_t(clothIndex);
-				particleIndices[numParticles] = uint32_t(pIt - pBegin);
+			// add particle to output arrays
+			clothIndices[numParticles] = uint16_t(clothIndex);
+			particleIndices[numParticles] = uint32_t(pIt - pBegin);
 
-				// output each particle only once
-				++numParticles;
-				break;
-			}
+			// output each particle only once
+			++numParticles;
+			break;
 		}
 	}
 
-	allocator.deallocate(sortedIndices);
-	allocator.deallocate(overlapBounds);
-	allocator.deallocate(clothBounds);
-
 	return numParticles;
 }
 }
@@ -393,147 +448,181 @@ void cloth::SwInterCollision<Simd4f>::operator()()
 {
 	mNumTests = mNumCollisions = 0;
 
+	mNumMaskWords = (mNumInstances + 31) >> 5;
+
 	mClothIndices = static_cast<uint16_t*>(mAllocator.allocate(sizeof(uint16_t) * mTotalParticles));
 	mParticleIndices = static_cast<uint32_t*>(mAllocator.allocate(sizeof(uint32_t) * mTotalParticles));
-	mOverlapMasks = static_cast<uint32_t*>(mAllocator.allocate(sizeof(uint32_t*) * mNumInstances));
+	mOverlapMasks = static_cast<uint32_t*>(mAllocator.allocate(sizeof(uint32_t) * mNumInstances * mNumMaskWords));
 
-	for(uint32_t k = 0; k < mNumIterations; ++k)
-	{
-		// world bounds of particles
-		BoundingBox<Simd4f> bounds = emptyBounds<Simd4f>();
+	uint32_t* islandCloths = static_cast<uint32_t*>(mAllocator.allocate(sizeof(uint32_t) * mNumInstances));
+	uint32_t* islandOffsets = static_cast<uint32_t*>(mAllocator.allocate(sizeof(uint32_t) * (mNumInstances + 1)));
+	BoundingBox<Simd4f>* overlapBounds =
+	    static_cast<BoundingBox<Simd4f>*>(mAllocator.allocate(sizeof(BoundingBox<Simd4f>) * mNumInstances));
 
-		// calculate potentially colliding set
-		{
-			PX_PROFILE_ZONE("cloth::SwInterCollision::BroadPhase", 0);
+	// cloth bounds do not change during the iterations, so the cloths are culled once
+	uint32_t numIslands = 0;
+	{
+		PX_PROFILE_ZONE("cloth::SwInterCollision::ClothBroadPhase", 0);
 
-			mNumParticles =
-			    calculatePotentialColliders(mInstances, mInstances + mNumInstances, mCollisionDistance, mClothIndices,
-			                                mParticleIndices, bounds, mOverlapMasks, mFilter, mAllocator);
-		}
+		numIslands = calculateClothIslands(mInstances, mNumInstances, mCollisionDistance, mFilter, mOverlapMasks,
+		                                   mNumMaskWords, islandCloths, islandOffsets, mAllocator);
+	}
 
-		// collide
-		if(mNumParticles)
+	for(uint32_t k = 0; k < mNumIterations; ++k)
+	{
+		// islands are collided separately, each with a grid fitted to its own particles
+		for(uint32_t island = 0; island < numIslands; ++island)
 		{
-			PX_PROFILE_ZONE("cloth::SwInterCollision::Collide", 0);
+			// world bounds of particles
+			BoundingBox<Simd4f> bounds = emptyBounds<Simd4f>();
+
+			// calculate potentially colliding set
+			{
+				PX_PROFILE_ZONE("cloth::SwInterCollision::BroadPhase", 0);
 
-			Simd4f lowerBound = bounds.mLower;
-			Simd4f edgeLength = max(bounds.mUpper - lowerBound, sEpsilon);
+				mNumParticles = 0;
+				for(uint32_t i = islandOffsets[island]; i < islandOffsets[island + 1]; ++i)
+				{
+					uint32_t clothIndex = islandCloths[i];
+					mNumParticles += calculatePotentialColliders(
+					    mInstances, clothIndex, mOverlapMasks + clothIndex * mNumMaskWords, mNumMaskWords,
+					    mCollisionDistance, mClothIndices + mNumParticles, mParticleIndices + mNumParticles, bounds,
+					    overlapBounds);
+				}
+			}
 
-			// sweep along longest axis
-			uint32_t sweepAxis = longestAxis(edgeLength);
-			uint32_t hashAxis0 = (sweepAxis + 1) % 3;
-			uint32_t hashAxis1 = (sweepAxis + 2) % 3;
+			// collide
+			if(mNumParticles)
+			{
+				PX_PROFILE_ZONE("cloth::SwInterCollision::Collide", 0);
+				collideParticles(bounds);
+			}
 
-			// reserve 0, 127, and 65535 for sentinel
-			Simd4f cellSize = max(mCollisionDistance, simd4f(1.0f / 253) * edgeLength);
-			array(cellSize)[sweepAxis] = array(edgeLength)[sweepAxis] / 65533;
+			// transform back to local space
+			{
+				PX_PROFILE_ZONE("cloth::SwInterCollision::PostTransform", 0);
 
-			Simd4f one = gSimd4fOne;
-			Simd4f gridSize = simd4f(254.0f);
-			array(gridSize)[sweepAxis] = 65534.0f;
+				Simd4f toLocal[4], impulseScale;
+				uint16_t lastCloth = uint16_t(0xffff);
 
-			Simd4f gridScale = recip<1>(cellSize);
-			Simd4f gridBias = -lowerBound * gridScale + one;
+				for(uint32_t i = 0; i < mNumParticles; ++i)
+				{
+					uint16_t clothIndex = mClothIndices[i];
+					const SwInterCollisionData* instance = mInstances + clothIndex;
 
-			void* buffer = mAllocator.allocate(getBufferSize(mNumParticles));
+					// todo: could pre-compute these inverses
+					if(clothIndex != lastCloth)
+					{
+						const PxMat44 xform(instance->mGlobalPose.getInverse());
 
-			uint32_t* __restrict sortedIndices = reinterpret_cast<uint32_t*>(buffer);
-			uint32_t* __restrict sortedKeys = sortedIndices + mNumParticles;
-			uint32_t* __restrict keys = PxMax(sortedKeys + mNumParticles, sortedIndices + 2 * mNumParticles + 1024);
+						toLocal[0] = load(reinterpret_cast<const float*>(&xform.column0));
+						toLocal[1] = load(reinterpret_cast<const float*>(&xform.column1));
+						toLocal[2] = load(reinterpret_cast<const float*>(&xform.column2));
+						toLocal[3] = load(reinterpret_cast<const float*>(&xform.column3));
 
-			typedef typename Simd4fToSimd4i<Simd4f>::Type Simd4i;
+						impulseScale = simd4f(instance->mImpulseScale);
 
-			// create keys
-			for(uint32_t i = 0; i < mNumParticles; ++i)
-			{
-				// grid coordinate
-				Simd4f indexf = getParticle(i) * gridScale + gridBias;
+						lastCloth = mClothIndices[i];
+					}
 
-				// need to clamp index because shape collision potentially
-				// pushes particles outside of their original bounds
-				Simd4i indexi = intFloor(max(one, min(indexf, gridSize)));
+					uint32_t particleIndex = mParticleIndices[i];
+					Simd4f& particle = reinterpret_cast<Simd4f&>(instance->mParticles[particleIndex]);
+					Simd4f& impulse = reinterpret_cast<Simd4f&>(instance->mPrevParticles[particleIndex]);
 
-				const int32_t* ptr = array(indexi);
-				keys[i] = uint32_t(ptr[sweepAxis] | (ptr[hashAxis0] << 16) | (ptr[hashAxis1] << 24));
+					particle = transform(toLocal, particle);
+					// avoid w becoming negative due to numerical inaccuracies
+					impulse = max(sZeroW, particle - rotate(toLocal, Simd4f(impulse * impulseScale)));
+				}
 			}
+		}
+	}
 
-			// compute sorted keys indices
-			radixSort(keys, keys + mNumParticles, sortedIndices);
+	mAllocator.deallocate(overlapBounds);
+	mAllocator.deallocate(islandOffsets);
+	mAllocator.deallocate(islandCloths);
+	mAllocator.deallocate(mOverlapMasks);
+	mAllocator.deallocate(mParticleIndices);
+	mAllocator.deallocate(mClothIndices);
+}
 
-			// snoop histogram: offset of first index with 8 msb > 1 (0 is sentinel)
-			uint32_t firstColumnSize = sortedIndices[2 * mNumParticles + 769];
+template <typename Simd4f>
+void cloth::SwInterCollision<Simd4f>::collideParticles(const BoundingBox<Simd4f>& bounds)
+{
+	Simd4f lowerBound = bounds.mLower;
+	Simd4f edgeLength = max(bounds.mUpper - lowerBound, sEpsilon);
 
-			// sort keys
-			for(uint32_t i = 0; i < mNumParticles; ++i)
-				sortedKeys[i] = keys[sortedIndices[i]];
-			sortedKeys[mNumParticles] = uint32_t(-1); // sentinel
+	// sweep along longest axis
+	uint32_t sweepAxis = longestAxis(edgeLength);
+	uint32_t hashAxis0 = (sweepAxis + 1) % 3;
+	uint32_t hashAxis1 = (sweepAxis + 2) % 3;
 
-			// calculate the number of buckets we need to search forward
-			const Simd4i data = intFloor(gridScale * mCollisionDistance);
-			uint32_t collisionDistance = uint32_t(2 + array(data)[sweepAxis]);
+	// reserve 0, 127, and 65535 for sentinel
+	Simd4f cellSize = max(mCollisionDistance, simd4f(1.0f / 253) * edgeLength);
+	array(cellSize)[sweepAxis] = array(edgeLength)[sweepAxis] / 65533;
 
-			// collide particles
-			collideParticles(sortedKeys, firstColumnSize, sortedIndices, mNumParticles, collisionDistance);
+	Simd4f one = gSimd4fOne;
+	Simd4f gridSize = simd4f(254.0f);
+	array(gridSize)[sweepAxis] = 65534.0f;
 
-			mAllocator.deallocate(buffer);
-		}
+	Simd4f gridScale = recip<1>(cellSize);
+	Simd4f gridBias = -lowerBound * gridScale + one;
 
-		/*
-		// verify against brute force (disable collision response when testing)
-		uint32_t numCollisions = mNumCollisions;
-		mNumCollisions = 0;
+	void* buffer = mAllocator.allocate(getBufferSize(mNumParticles));
 
-		for(uint32_t i = 0; i < mNumParticles; ++i)
-		    for(uint32_t j = i+1; j < mNumParticles; ++j)
-		        if (mOverlapMasks[mClothIndices[i]] & (1 << mClothIndices[j]))
-		            collideParticles(getParticle(i), getParticle(j));
+	uint32_t* __restrict sortedIndices = reinterpret_cast<uint32_t*>(buffer);
+	uint32_t* __restrict sortedKeys = sortedIndices + mNumParticles;
+	uint32_t* __restrict keys = PxMax(sortedKeys + mNumParticles, sortedIndices + 2 * mNumParticles + 1024);
 
-		static uint32_t iter = 0; ++iter;
-		if(numCollisions != mNumCollisions)
-		    printf("%u: %u != %u\n", iter, numCollisions, mNumCollisions);
-		*/
+	typedef typename Simd4fToSimd4i<Simd4f>::Type Simd4i;
 
-		// transform back to local space
-		{
-			PX_PROFILE_ZONE("cloth::SwInterCollision::PostTransform", 0);
+	// create keys
+	for(uint32_t i = 0; i < mNumParticles; ++i)
+	{
+		// grid coordinate
+		Simd4f indexf = getParticle(i) * gridScale + gridBias;
 
-			Simd4f toLocal[4], impulseScale;
-			uint16_t lastCloth = uint16_t(0xffff);
+		// need to clamp index because shape collision potentially
+		// pushes particles outside of their original bounds
+		Simd4i indexi = intFloor(max(one, min(indexf, gridSize)));
 
-			for(uint32_t i = 0; i < mNumParticles; ++i)
-			{
-				uint16_t clothIndex = mClothIndices[i];
-				const SwInterCollisionData* instance = mInstances + clothIndex;
+		const int32_t* ptr = array(indexi);
+		keys[i] = uint32_t(ptr[sweepAxis] | (ptr[hashAxis0] << 16) | (ptr[hashAxis1] << 24));
+	}
 
-				// todo: could pre-compute these inverses
-				if(clothIndex != lastCloth)
-				{
-					const PxMat44 xform(instance->mGlobalPose.getInverse());
+	// compute sorted keys indices
+	radixSort(keys, keys + mNumParticles, sortedIndices);
 
-					toLocal[0] = load(reinterpret_cast<const float*>(&xform.column0));
-					toLocal[1] = load(reinterpret_cast<const float*>(&xform.column1));
-					toLocal[2] = load(reinterpret_cast<const float*>(&xform.column2));
-					toLocal[3] = load(reinterpret_cast<const float*>(&xform.column3));
+	// snoop histogram: offset of first index with 8 msb > 1 (0 is sentinel)
+	uint32_t firstColumnSize = sortedIndices[2 * mNumParticles + 769];
 
-					impulseScale = simd4f(instance->mImpulseScale);
+	// sort keys
+	for(uint32_t i = 0; i < mNumParticles; ++i)
+		sortedKeys[i] = keys[sortedIndices[i]];
+	sortedKeys[mNumParticles] = uint32_t(-1); // sentinel
 
-					lastCloth = mClothIndices[i];
-				}
+	// calculate the number of buckets we need to search forward
+	const Simd4i data = intFloor(gridScale * mCollisionDistance);
+	uint32_t collisionDistance = uint32_t(2 + array(data)[sweepAxis]);
 
-				uint32_t particleIndex = mParticleIndices[i];
-				Simd4f& particle = reinterpret_cast<Simd4f&>(instance->mParticles[particleIndex]);
-				Simd4f& impulse = reinterpret_cast<Simd4f&>(instance->mPrevParticles[particleIndex]);
+	// collide particles
+	collideParticles(sortedKeys, firstColumnSize, sortedIndices, mNumParticles, collisionDistance);
 
-				particle = transform(toLocal, particle);
-				// avoid w becoming negative due to numerical inaccuracies
-				impulse = max(sZeroW, particle - rotate(toLocal, Simd4f(impulse * impulseScale)));
-			}
-		}
-	}
+	mAllocator.deallocate(buffer);
 
-	mAllocator.deallocate(mOverlapMasks);
-	mAllocator.deallocate(mParticleIndices);
-	mAllocator.deallocate(mClothIndices);
+	/*
+	// verify against brute force (disable collision response when testing)
+	uint32_t numCollisions = mNumCollisions;
+	mNumCollisions = 0;
+
+	for(uint32_t i = 0; i < mNumParticles; ++i)
+	    for(uint32_t j = i+1; j < mNumParticles; ++j)
+	        if (isOverlapping(mClothIndices[i], mClothIndices[j]))
+	            collideParticles(getParticle(i), getParticle(j));
+
+	static uint32_t iter = 0; ++iter;
+	if(numCollisions != mNumCollisions)
+	    printf("%u: %u != %u\n", iter, numCollisions, mNumCollisions);
+	*/
 }
 
 template <typename Simd4f>
@@ -544,12 +633,13 @@ size_t cloth::SwInterCollision<Simd4f>::estimateTemporaryMemory(SwInterCollision
 	for(uint32_t i = 0; i < n; ++i)
 		numParticles += cloths[i].mNumParticles;
 
-	uint32_t boundsSize = 2 * n * sizeof(BoundingBox<Simd4f>) + n * sizeof(uint32_t);
+	uint32_t boundsSize = 2 * n * sizeof(BoundingBox<Simd4f>) + 2 * n * sizeof(uint32_t);
 	uint32_t clothIndicesSize = numParticles * sizeof(uint16_t);
 	uint32_t particleIndicesSize = numParticles * sizeof(uint32_t);
-	uint32_t masksSize = n * sizeof(uint32_t);
+	uint32_t masksSize = n * ((n + 31) >> 5) * sizeof(uint32_t);
+	uint32_t islandsSize = (2 * n + 1) * sizeof(uint32_t);
 
-	return boundsSize + clothIndicesSize + particleIndicesSize + masksSize + getBufferSize(numParticles);
+	return boundsSize + clothIndicesSize + particleIndicesSize + masksSize + islandsSize + getBufferSize(numParticles);
 }
 
 template <typename Simd4f>
@@ -567,7 +657,7 @@ void cloth::SwInterCollision<Simd4f>::collideParticle(uint32_t index)
 {
 	uint16_t clothIndex = mClothIndices[index];
 
-	if((1 << clothIndex) & ~mClothMask)
+	if(!(mClothMask[clothIndex >> 5] & (1u << (clothIndex & 31))))
 		return;
 
 	const SwInterCollisionData* instance = mInstances + clothIndex;
@@ -659,7 +749,7 @@ void cloth::SwInterCollision<Simd4f>::collideParticles(const uint32_t* keys, uin
 		PX_ASSERT(index < mNumParticles);
 		mClothIndex = mClothIndices[index];
 		PX_ASSERT(mClothIndex < mNumInstances);
-		mClothMask = mOverlapMasks[mClothIndex];
+		mClothMask = mOverlapMasks + mClothIndex * mNumMaskWords;
 
 		const SwInterCollisionData* instance = mInstances + mClothIndex;
 
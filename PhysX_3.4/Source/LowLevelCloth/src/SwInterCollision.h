@@ -45,6 +45,9 @@ namespace cloth
 class SwCloth;
 struct SwClothData;
 
+template <typename>
+struct BoundingBox;
+
 typedef StackAllocator<16> SwKernelAllocator;
 
 typedef bool (*InterCollisionFilter)(void* cloth0, void* cloth1);
@@ -99,6 +102,8 @@ class SwInterCollision
 
 	static size_t getBufferSize(uint32_t);
 
+	void collideParticles(const BoundingBox<Simd4f>& bounds);
+
 	void collideParticles(const uint32_t* keys, uint32_t firstColumnSize, const uint32_t* sortedIndices,
 	                      uint32_t numParticles, uint32_t collisionDistance);
 
@@ -115,7 +120,7 @@ class SwInterCollision
 	Simd4f mStiffness;
 
 	uint16_t mClothIndex;
-	uint32_t mClothMask;
+	const uint32_t* mClothMask;
 	uint32_t mParticleIndex;
 
 	uint32_t mNumIterations;
@@ -127,6 +132,7 @@ class SwInterCollision
 	uint32_t* mParticleIndices;
 	uint32_t mNumParticles;
 	uint32_t* mOverlapMasks;
+	uint32_t mNumMaskWords;
 
 	uint32_t mTotalParticles;
 
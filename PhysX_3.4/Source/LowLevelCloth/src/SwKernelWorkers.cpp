@@ -0,0 +1,112 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#include "SwKernelWorkers.h"
+#include "PsAtomic.h"
+#include "PsThread.h"
+
+using namespace physx;
+
+namespace
+{
+const int32_t sChunkBits = 12;
+const int32_t sChunkMask = (1 << sChunkBits) - 1;
+const int32_t sEndState = -1;
+}
+
+cloth::SwKernelWorkers::SwKernelWorkers()
+: mState(sEndState), mNumCompletedChunks(0), mFunction(NULL), mPhase(NULL), mNumChunks(0)
+{
+}
+
+void cloth::SwKernelWorkers::begin()
+{
+	// generation 0 without any chunk, helpers wait for the first phase
+	mNumChunks = 0;
+	shdfnd::atomicExchange(&mState, 0);
+}
+
+void cloth::SwKernelWorkers::end()
+{
+	shdfnd::atomicExchange(&mState, sEndState);
+}
+
+void cloth::SwKernelWorkers::run(ChunkFunction function, const void* phase, uint32_t numChunks)
+{
+	PX_ASSERT(mState != sEndState);
+	PX_ASSERT(numChunks <= sMaxNumChunks);
+
+	// all chunks of the previous phase are claimed and completed, so nobody reads the phase data now
+	mFunction = function;
+	mPhase = phase;
+	mNumChunks = numChunks;
+	mNumCompletedChunks = 0;
+
+	// the exchange is a full barrier: helpers seeing the new generation also see the phase data
+	// (wraps around before reaching the sign bit, which is reserved for sEndState)
+	const int32_t generation = ((mState >> sChunkBits) + 1) & ((1 << (31 - sChunkBits)) - 1);
+	shdfnd::atomicExchange(&mState, generation << sChunkBits);
+
+	while(runChunk(mState))
+		;
+
+	while(mNumCompletedChunks != int32_t(numChunks))
+		shdfnd::Thread::yield();
+}
+
+bool cloth::SwKernelWorkers::runChunk(int32_t state)
+{
+	// read the phase after the state: if the phase changed since, the state changed too and the claim fails
+	const uint32_t chunkIndex = uint32_t(state & sChunkMask);
+	if(state == sEndState || chunkIndex >= mNumChunks)
+		return false;
+
+	ChunkFunction function = mFunction;
+	const void* phase = mPhase;
+
+	if(shdfnd::atomicCompareExchange(&mState, state + 1, state) != state)
+		return true; // claimed by somebody else, try again
+
+	function(phase, chunkIndex);
+	shdfnd::atomicIncrement(&mNumCompletedChunks);
+	return true;
+}
+
+void cloth::SwKernelWorkers::help()
+{
+	for(;;)
+	{
+		const int32_t state = mState;
+		if(state == sEndState)
+			return;
+
+		if(!runChunk(state))
+			shdfnd::Thread::yield();
+	}
+}
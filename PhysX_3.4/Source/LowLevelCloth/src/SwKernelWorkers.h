@@ -0,0 +1,79 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#pragma once
+
+#include "Types.h"
+
+namespace physx
+{
+
+namespace cloth
+{
+
+// Lets worker threads help the thread running a solver kernel with its constraint phases.
+// The kernel thread publishes one phase at a time as a number of independent chunks. The kernel
+// thread and the helpers claim chunks until none is left, then the kernel thread waits for the
+// claimed chunks to complete before going on. Helpers that start late, or never, do not hold
+// the kernel thread back: it runs all chunks left unclaimed.
+class SwKernelWorkers
+{
+  public:
+	typedef void (*ChunkFunction)(const void* phase, uint32_t chunkIndex);
+
+	// maximum number of chunks in a phase
+	static const uint32_t sMaxNumChunks = (1 << 12) - 1;
+
+	SwKernelWorkers();
+
+	// called by the kernel thread before the first and after the last phase
+	void begin();
+	void end();
+
+	// runs function(phase, i) for each i in [0, numChunks) and returns when all calls have completed
+	void run(ChunkFunction function, const void* phase, uint32_t numChunks);
+
+	// called by the helper tasks, returns once end() has been called
+	void help();
+
+  private:
+	// claims the next chunk of the current phase and runs it, returns false if all chunks were claimed
+	bool runChunk(int32_t state);
+
+	// (generation << 12) | next chunk index, or -1 once end() was called
+	volatile int32_t mState;
+	volatile int32_t mNumCompletedChunks;
+
+	// current phase, only written by the kernel thread while no chunk is claimable
+	ChunkFunction mFunction;
+	const void* mPhase;
+	uint32_t mNumChunks;
+};
+}
+}
@@ -39,6 +39,7 @@
 #include "PsFPU.h"
 #include "PsFoundation.h"
 #include "PsSort.h"
+#include "task/PxCpuDispatcher.h"
 
 namespace physx
 {
@@ -56,6 +57,12 @@ typedef Simd4f Simd4fType;
 typedef Scalar4f Simd4fType;
 #endif
 
+namespace
+{
+// cloths with fewer particles are solved by a single thread
+const uint32_t sMinNumParallelParticles = 4096;
+}
+
 cloth::SwSolver::SwSolver(physx::PxTaskManager* taskMgr)
 : mInterCollisionDistance(0.0f)
 , mInterCollisionStiffness(1.0f)
@@ -245,6 +252,20 @@ void cloth::SwSolver::CpuClothSimulationTask::runInternal()
 	if(mContinuation->mDt == 0.0f)
 		return;
 
+	// large cloths let idle worker threads help with their constraint phases
+	SwKernelWorkers* workers = NULL;
+	if(uint32_t numHelperTasks = getNumHelperTasks())
+	{
+		workers = &mWorkers;
+		mWorkers.begin();
+		for(uint32_t i = 0; i < numHelperTasks; ++i)
+		{
+			mHelperTasks[i].mWorkers = workers;
+			mHelperTasks[i].setContinuation(mContinuation);
+			mHelperTasks[i].removeReference();
+		}
+	}
+
 	IterationStateFactory factory(*mCloth, mContinuation->mDt);
 	mInvNumIterations = factory.mInvNumIterations;
 
@@ -257,16 +278,40 @@ void cloth::SwSolver::CpuClothSimulationTask::runInternal()
 #if PX_ANDROID
 // if(!neonSolverKernel(cloth, data, allocator, factory))
 #endif
-	SwSolverKernel<Simd4fType>(*mCloth, data, allocator, factory)();
+	SwSolverKernel<Simd4fType>(*mCloth, data, allocator, factory, workers)();
+
+	// helper tasks that did not start yet return straight away
+	if(workers)
+		workers->end();
 
 	data.reconcile(*mCloth); // update cloth
 }
 
+uint32_t cloth::SwSolver::CpuClothSimulationTask::getNumHelperTasks() const
+{
+	if(mCloth->mCurParticles.size() < sMinNumParallelParticles)
+		return 0;
+
+	uint32_t numWorkers = mTm->getCpuDispatcher()->getWorkerCount();
+	return numWorkers > 1 ? PxMin(numWorkers - 1, sMaxNumHelperTasks) : 0;
+}
+
 const char* cloth::SwSolver::CpuClothSimulationTask::getName() const
 {
 	return "cloth.SwSolver.cpuClothSimulation";
 }
 
+void cloth::SwSolver::CpuClothHelperTask::runInternal()
+{
+	shdfnd::SIMDGuard simdGuard;
+	mWorkers->help();
+}
+
+const char* cloth::SwSolver::CpuClothHelperTask::getName() const
+{
+	return "cloth.SwSolver.cpuClothHelper";
+}
+
 void cloth::SwSolver::CpuClothSimulationTask::release()
 {
 	mCloth->mMotionConstraints.pop();
@@ -32,6 +32,7 @@
 #include "Solver.h"
 #include "Allocator.h"
 #include "SwInterCollision.h"
+#include "SwKernelWorkers.h"
 #include "CmTask.h"
 
 namespace physx
@@ -70,18 +71,34 @@ class SwSolver : public UserAllocated, public Solver
 		float mDt;
 	};
 
+	// helps a CpuClothSimulationTask with the constraint phases of a large cloth
+	struct CpuClothHelperTask : public Cm::Task
+	{
+		CpuClothHelperTask() : Cm::Task(0), mWorkers(NULL)	{}
+
+		virtual void runInternal();
+		virtual const char* getName() const;
+		SwKernelWorkers* mWorkers;
+	};
+
 	struct CpuClothSimulationTask : public Cm::Task
 	{
+		static const uint32_t sMaxNumHelperTasks = 7;
+
 		CpuClothSimulationTask(SwCloth&, EndSimulationTask&);
 		virtual void runInternal();
 		virtual const char* getName() const;
 		virtual void release();
 
+		uint32_t getNumHelperTasks() const;
+
 		SwCloth* mCloth;
 		EndSimulationTask* mContinuation;
 		uint32_t mScratchMemorySize;
 		void* mScratchMemory;
 		float mInvNumIterations;
+		SwKernelWorkers mWorkers;
+		CpuClothHelperTask mHelperTasks[sMaxNumHelperTasks];
 	};
 
   public:
@@ -33,6 +33,7 @@
 #include "SwClothData.h"
 #include "SwFabric.h"
 #include "SwFactory.h"
+#include "SwKernelWorkers.h"
 #include "PointInterpolator.h"
 #include "BoundingBox.h"
 
@@ -95,6 +96,15 @@ uint32_t getAvxSupport()
 
 const uint32_t sAvxSupport = getAvxSupport(); // 0: no AVX, 1: AVX, 2: AVX+FMA
 }
+
+namespace avx
+{
+// used by the collision kernels in SwCollision.cpp
+uint32_t getSupport()
+{
+	return sAvxSupport;
+}
+}
 #endif
 
 using namespace physx;
@@ -405,14 +415,139 @@ void applyWind(Simd4f* __restrict curIt, const Simd4f* __restrict prevIt, const
 	}
 }
 
+// solves the constraints [rIt, rEnd) of a fabric phase
+template <typename Simd4f>
+void solvePhase(float* __restrict pIt, const float* __restrict rIt, const float* __restrict rEnd,
+                const uint16_t* __restrict iIt, const Simd4f& stiffness, int neutralMultiplier)
+{
+#if PX_AVX
+	switch(sAvxSupport)
+	{
+	case 2:
+#if _MSC_VER >= 1700
+		neutralMultiplier ? avx::solveConstraints<false, 2>(pIt, rIt, rEnd, iIt, stiffness)
+		                  : avx::solveConstraints<true, 2>(pIt, rIt, rEnd, iIt, stiffness);
+		break;
+#endif
+	case 1:
+		neutralMultiplier ? avx::solveConstraints<false, 1>(pIt, rIt, rEnd, iIt, stiffness)
+		                  : avx::solveConstraints<true, 1>(pIt, rIt, rEnd, iIt, stiffness);
+		break;
+	default:
+#endif
+		neutralMultiplier ? solveConstraints<false>(pIt, rIt, rEnd, iIt, stiffness)
+		                  : solveConstraints<true>(pIt, rIt, rEnd, iIt, stiffness);
+#if PX_AVX
+		break;
+	}
+#endif
+}
+
+// minimum number of constraints of a phase chunk, a multiple of the SIMD width of the fabric sets
+const uint32_t sNumConstraintsPerChunk = 256;
+
+// the constraints of a phase are independent, so chunks of the phase can be solved concurrently
+template <typename Simd4f>
+struct FabricPhaseChunks
+{
+	Simd4f mStiffness;
+	float* mParticles;
+	const float* mRestvalues;
+	const float* mRestvaluesEnd;
+	const uint16_t* mIndices;
+	uint32_t mNumConstraintsPerChunk;
+	int mNeutralMultiplier;
+
+	static void solveChunk(const void* phase, uint32_t chunkIndex)
+	{
+		const FabricPhaseChunks& chunks = *static_cast<const FabricPhaseChunks*>(phase);
+		uint32_t offset = chunkIndex * chunks.mNumConstraintsPerChunk;
+		const float* rIt = chunks.mRestvalues + offset;
+		const float* rEnd = PxMin(rIt + chunks.mNumConstraintsPerChunk, chunks.mRestvaluesEnd);
+		solvePhase(chunks.mParticles, rIt, rEnd, chunks.mIndices + offset * 2, chunks.mStiffness,
+		           chunks.mNeutralMultiplier);
+	}
+};
+
+template <typename Simd4f>
+void constrainTether(float* __restrict curFirst, uint32_t first, uint32_t last, const cloth::SwTether* __restrict tethers,
+                     uint32_t numParticles, uint32_t numTethers, const Simd4f& stiffness, const Simd4f& scale)
+{
+	typedef const cloth::SwTether* __restrict TetherIter;
+	TetherIter tFirst = tethers + first;
+	TetherIter tEnd = tethers + numTethers;
+
+	float* __restrict curIt = curFirst + 4 * first;
+	const float* __restrict curEnd = curFirst + 4 * last;
+
+	for(; curIt != curEnd; curIt += 4, ++tFirst)
+	{
+		Simd4f position = loadAligned(curIt);
+		Simd4f offset = gSimd4fZero;
+
+		for(TetherIter tIt = tFirst; tIt < tEnd; tIt += numParticles)
+		{
+			PX_ASSERT(tIt->mAnchor < numParticles);
+			Simd4f anchor = loadAligned(curFirst, tIt->mAnchor * sizeof(PxVec4));
+			Simd4f delta = anchor - position;
+			Simd4f sqrLength = gSimd4fEpsilon + dot3(delta, delta);
+
+			Simd4f tetherLength = load(&tIt->mLength);
+			tetherLength = splat<0>(tetherLength);
+
+			Simd4f radius = tetherLength * scale;
+			Simd4f slack = gSimd4fOne - radius * rsqrt(sqrLength);
+
+			offset = offset + delta * max(slack, gSimd4fZero);
+		}
+
+		storeAligned(curIt, position + offset * stiffness);
+	}
+}
+
+// number of particles of a tether chunk
+const uint32_t sNumTetherParticlesPerChunk = 256;
+
+// anchors are attached particles, tethered to themselves with zero length, so chunks only move
+// their own particles and can be solved concurrently
+template <typename Simd4f>
+struct TetherChunks
+{
+	Simd4f mStiffness;
+	Simd4f mScale;
+	float* mParticles;
+	const cloth::SwTether* mTethers;
+	uint32_t mNumParticles;
+	uint32_t mNumTethers;
+	uint32_t mNumParticlesPerChunk;
+
+	static void solveChunk(const void* phase, uint32_t chunkIndex)
+	{
+		const TetherChunks& chunks = *static_cast<const TetherChunks*>(phase);
+		uint32_t first = chunkIndex * chunks.mNumParticlesPerChunk;
+		uint32_t last = PxMin(first + chunks.mNumParticlesPerChunk, chunks.mNumParticles);
+		constrainTether(chunks.mParticles, first, last, chunks.mTethers, chunks.mNumParticles, chunks.mNumTethers,
+		                chunks.mStiffness, chunks.mScale);
+	}
+};
+
+// smallest multiple of minChunkSize that covers numItems with at most SwKernelWorkers::sMaxNumChunks chunks
+uint32_t getChunkSize(uint32_t numItems, uint32_t minChunkSize)
+{
+	uint32_t numUnits = (numItems + minChunkSize - 1) / minChunkSize;
+	return minChunkSize * ((numUnits + cloth::SwKernelWorkers::sMaxNumChunks - 1) / cloth::SwKernelWorkers::sMaxNumChunks);
+}
+
 } // anonymous namespace
 
 template <typename Simd4f>
 cloth::SwSolverKernel<Simd4f>::SwSolverKernel(SwCloth const& cloth, SwClothData& clothData,
-                                              SwKernelAllocator& allocator, IterationStateFactory& factory)
+                                              SwKernelAllocator& allocator, IterationStateFactory& factory,
+                                              SwKernelWorkers* workers)
 : mCloth(cloth)
 , mClothData(clothData)
 , mAllocator(allocator)
+, mWorkers(workers)
 , mCollision(clothData, allocator)
 , mSelfCollision(clothData, allocator)
 , mState(factory.create<Simd4f>(cloth))
@@ -493,41 +628,28 @@ void cloth::SwSolverKernel<Simd4f>::constrainTether()
 	uint32_t numTethers = mClothData.mNumTethers;
 	PX_ASSERT(0 == numTethers % numParticles);
 
-	float* __restrict curIt = mClothData.mCurParticles;
-	const float* __restrict curFirst = curIt;
-	const float* __restrict curEnd = curIt + 4 * numParticles;
-
-	typedef const SwTether* __restrict TetherIter;
-	TetherIter tFirst = mClothData.mTethers;
-	TetherIter tEnd = tFirst + numTethers;
-
 	Simd4f stiffness =
 	    static_cast<Simd4f>(sMaskXYZ) & simd4f(numParticles * mClothData.mTetherConstraintStiffness / numTethers);
 	Simd4f scale = simd4f(mClothData.mTetherConstraintScale);
 
-	for(; curIt != curEnd; curIt += 4, ++tFirst)
+	if(mWorkers && numParticles >= 2 * sNumTetherParticlesPerChunk)
 	{
-		Simd4f position = loadAligned(curIt);
-		Simd4f offset = gSimd4fZero;
-
-		for(TetherIter tIt = tFirst; tIt < tEnd; tIt += numParticles)
-		{
-			PX_ASSERT(tIt->mAnchor < numParticles);
-			Simd4f anchor = loadAligned(curFirst, tIt->mAnchor * sizeof(PxVec4));
-			Simd4f delta = anchor - position;
-			Simd4f sqrLength = gSimd4fEpsilon + dot3(delta, delta);
-
-			Simd4f tetherLength = load(&tIt->mLength);
-			tetherLength = splat<0>(tetherLength);
-
-			Simd4f radius = tetherLength * scale;
-			Simd4f slack = gSimd4fOne - radius * rsqrt(sqrLength);
-
-			offset = offset + delta * max(slack, gSimd4fZero);
-		}
-
-		storeAligned(curIt, position + offset * stiffness);
+		TetherChunks<Simd4f> chunks;
+		chunks.mStiffness = stiffness;
+		chunks.mScale = scale;
+		chunks.mParticles = mClothData.mCurParticles;
+		chunks.mTethers = mClothData.mTethers;
+		chunks.mNumParticles = numParticles;
+		chunks.mNumTethers = numTethers;
+		chunks.mNumParticlesPerChunk = getChunkSize(numParticles, sNumTetherParticlesPerChunk);
+
+		uint32_t numChunks = (numParticles + chunks.mNumParticlesPerChunk - 1) / chunks.mNumParticlesPerChunk;
+		mWorkers->run(&TetherChunks<Simd4f>::solveChunk, &chunks, numChunks);
+		return;
 	}
+
+	::constrainTether(mClothData.mCurParticles, 0, numParticles, mClothData.mTethers, numParticles, numTethers,
+	                  stiffness, scale);
 }
 
 template <typename Simd4f>
@@ -567,27 +689,24 @@ void cloth::SwSolverKernel<Simd4f>::solveFabric()
 
 		int neutralMultiplier = allEqual(sMaskYZW & stiffness, gSimd4fZero);
 
-#if PX_AVX
-		switch(sAvxSupport)
+		uint32_t numConstraints = uint32_t(rEnd - rIt);
+		if(mWorkers && numConstraints >= 2 * sNumConstraintsPerChunk)
 		{
-		case 2:
-#if _MSC_VER >= 1700
-			neutralMultiplier ? avx::solveConstraints<false, 2>(pIt, rIt, rEnd, iIt, stiffness)
-			                  : avx::solveConstraints<true, 2>(pIt, rIt, rEnd, iIt, stiffness);
-			break;
-#endif
-		case 1:
-			neutralMultiplier ? avx::solveConstraints<false, 1>(pIt, rIt, rEnd, iIt, stiffness)
-			                  : avx::solveConstraints<true, 1>(pIt, rIt, rEnd, iIt, stiffness);
-			break;
-		default:
-#endif
-			neutralMultiplier ? solveConstraints<false>(pIt, rIt, rEnd, iIt, stiffness)
-			                  : solveConstraints<true>(pIt, rIt, rEnd, iIt, stiffness);
-#if PX_AVX
-			break;
+			FabricPhaseChunks<Simd4f> chunks;
+			chunks.mStiffness = stiffness;
+			chunks.mParticles = pIt;
+			chunks.mRestvalues = rIt;
+			chunks.mRestvaluesEnd = rEnd;
+			chunks.mIndices = iIt;
+			chunks.mNumConstraintsPerChunk = getChunkSize(numConstraints, sNumConstraintsPerChunk);
+			chunks.mNeutralMultiplier = neutralMultiplier;
+
+			uint32_t numChunks = (numConstraints + chunks.mNumConstraintsPerChunk - 1) / chunks.mNumConstraintsPerChunk;
+			mWorkers->run(&FabricPhaseChunks<Simd4f>::solveChunk, &chunks, numChunks);
+			continue;
 		}
-#endif
+
+		solvePhase(pIt, rIt, rEnd, iIt, stiffness, neutralMultiplier);
 	}
 }
 
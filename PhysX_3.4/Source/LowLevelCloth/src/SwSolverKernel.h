@@ -40,12 +40,14 @@ namespace cloth
 
 class SwCloth;
 struct SwClothData;
+class SwKernelWorkers;
 
 template <typename Simd4f>
 class SwSolverKernel
 {
   public:
-	SwSolverKernel(SwCloth const&, SwClothData&, SwKernelAllocator&, IterationStateFactory&);
+	// the constraint phases are split across the (optional) workers
+	SwSolverKernel(SwCloth const&, SwClothData&, SwKernelAllocator&, IterationStateFactory&, SwKernelWorkers* = NULL);
 
 	void operator()();
 
@@ -70,6 +72,7 @@ class SwSolverKernel
 	SwCloth const& mCloth;
 	SwClothData& mClothData;
 	SwKernelAllocator& mAllocator;
+	SwKernelWorkers* mWorkers;
 
 	SwCollision<Simd4f> mCollision;
 	SwSelfCollision<Simd4f> mSelfCollision;
@@ -0,0 +1,382 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#pragma warning(push)
+#pragma warning(disable : 4668) //'symbol' is not defined as a preprocessor macro, replacing with '0' for 'directives'
+#pragma warning(disable : 4987) // nonstandard extension used: 'throw (...)'
+#include <intrin.h>
+#pragma warning(pop)
+
+#pragma warning(disable : 4127) // conditional expression is constant
+
+typedef unsigned __int32 uint32_t;
+
+namespace avx
+{
+// defined in SwSolveConstraints.cpp
+extern __m256 sOne, sEpsilon;
+
+namespace
+{
+template <uint32_t>
+__m256 fmadd_ps(__m256 a, __m256 b, __m256 c)
+{
+	return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+}
+template <uint32_t>
+__m256 fnmadd_ps(__m256 a, __m256 b, __m256 c)
+{
+	return _mm256_sub_ps(c, _mm256_mul_ps(a, b));
+}
+#if _MSC_VER >= 1700
+template <>
+__m256 fmadd_ps<2>(__m256 a, __m256 b, __m256 c)
+{
+	return _mm256_fmadd_ps(a, b, c);
+}
+template <>
+__m256 fnmadd_ps<2>(__m256 a, __m256 b, __m256 c)
+{
+	return _mm256_fnmadd_ps(a, b, c);
+}
+#endif
+
+// loads 8 particles and transposes them into x, y, z and w vectors
+void loadParticles(const float* __restrict ptr, __m256* v)
+{
+	__m256 v04 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(ptr)), _mm_load_ps(ptr + 16), 1);
+	__m256 v15 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(ptr + 4)), _mm_load_ps(ptr + 20), 1);
+	__m256 v26 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(ptr + 8)), _mm_load_ps(ptr + 24), 1);
+	__m256 v37 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(ptr + 12)), _mm_load_ps(ptr + 28), 1);
+
+	__m256 a = _mm256_unpacklo_ps(v04, v26);
+	__m256 b = _mm256_unpackhi_ps(v04, v26);
+	__m256 c = _mm256_unpacklo_ps(v15, v37);
+	__m256 d = _mm256_unpackhi_ps(v15, v37);
+
+	v[0] = _mm256_unpacklo_ps(a, c);
+	v[1] = _mm256_unpackhi_ps(a, c);
+	v[2] = _mm256_unpacklo_ps(b, d);
+	v[3] = _mm256_unpackhi_ps(b, d);
+}
+
+// transposes x, y, z and w vectors back and stores them as 8 particles
+void storeParticles(float* __restrict ptr, const __m256* v)
+{
+	__m256 xy01 = _mm256_unpacklo_ps(v[0], v[1]);
+	__m256 xy23 = _mm256_unpackhi_ps(v[0], v[1]);
+	__m256 zw01 = _mm256_unpacklo_ps(v[2], v[3]);
+	__m256 zw23 = _mm256_unpackhi_ps(v[2], v[3]);
+
+	__m256 v04 = _mm256_shuffle_ps(xy01, zw01, _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 v15 = _mm256_shuffle_ps(xy01, zw01, _MM_SHUFFLE(3, 2, 3, 2));
+	__m256 v26 = _mm256_shuffle_ps(xy23, zw23, _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 v37 = _mm256_shuffle_ps(xy23, zw23, _MM_SHUFFLE(3, 2, 3, 2));
+
+	_mm_store_ps(ptr, _mm256_castps256_ps128(v04));
+	_mm_store_ps(ptr + 4, _mm256_castps256_ps128(v15));
+	_mm_store_ps(ptr + 8, _mm256_castps256_ps128(v26));
+	_mm_store_ps(ptr + 12, _mm256_castps256_ps128(v37));
+	_mm_store_ps(ptr + 16, _mm256_extractf128_ps(v04, 1));
+	_mm_store_ps(ptr + 20, _mm256_extractf128_ps(v15, 1));
+	_mm_store_ps(ptr + 24, _mm256_extractf128_ps(v26, 1));
+	_mm_store_ps(ptr + 28, _mm256_extractf128_ps(v37, 1));
+}
+
+uint32_t horizontalSum(__m256 v)
+{
+	__declspec(align(32)) float buffer[8];
+	_mm256_store_ps(buffer, v);
+
+	uint32_t sum = 0;
+	for(uint32_t i = 0; i < 8; ++i)
+		sum += uint32_t(buffer[i]);
+	return sum;
+}
+} // anonymous namespace
+
+// 8-wide version of SwCollision::collideConvexes(), planes are xyz normal and w distance, the
+// particle range is padded to a multiple of 8. Returns the number of particle/convex collisions.
+template <uint32_t avx>
+uint32_t collideConvexes(float* __restrict curIt, const float* __restrict curEnd, float* __restrict prevIt,
+                         const float* __restrict planes, uint32_t numPlanes, const uint32_t* __restrict convexMasks,
+                         uint32_t numConvexes, float frictionScale)
+{
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 minusOne = _mm256_set1_ps(-1.0f);
+	const __m256 frictionCoefficient = _mm256_set1_ps(frictionScale);
+
+	// signed distances of the 8 particles to each plane (at most 32)
+	__m256 distances[32];
+
+	uint32_t numCollisions = 0;
+
+	for(; curIt < curEnd; curIt += 32, prevIt += 32)
+	{
+		__m256 curPos[4];
+		loadParticles(curIt, curPos);
+
+		// planes with at least one particle behind them
+		uint32_t result = 0;
+		for(uint32_t i = 0; i < numPlanes; ++i)
+		{
+			const float* plane = planes + i * 4;
+			distances[i] = fmadd_ps<avx>(curPos[0], _mm256_broadcast_ss(plane),
+			                             fmadd_ps<avx>(curPos[1], _mm256_broadcast_ss(plane + 1),
+			                                           fmadd_ps<avx>(curPos[2], _mm256_broadcast_ss(plane + 2),
+			                                                         _mm256_broadcast_ss(plane + 3))));
+			if(_mm256_movemask_ps(_mm256_cmp_ps(distances[i], zero, _CMP_LT_OQ)))
+				result |= 1u << i;
+		}
+
+		if(!result)
+			continue;
+
+		__m256 deltaX = zero, deltaY = zero, deltaZ = zero;
+		__m256 numContacts = sEpsilon;
+
+		for(const uint32_t* cIt = convexMasks, *cEnd = convexMasks + numConvexes; cIt != cEnd; ++cIt)
+		{
+			uint32_t mask = *cIt;
+			if((mask & result) != mask)
+				continue;
+
+			// find the closest plane of the convex for each particle
+			unsigned long planeIndex;
+			_BitScanForward(&planeIndex, mask);
+			const float* plane = planes + planeIndex * 4;
+			__m256 planeX = _mm256_broadcast_ss(plane);
+			__m256 planeY = _mm256_broadcast_ss(plane + 1);
+			__m256 planeZ = _mm256_broadcast_ss(plane + 2);
+			__m256 planeD = distances[planeIndex];
+			__m256 inside = _mm256_cmp_ps(planeD, zero, _CMP_LT_OQ);
+			while(mask &= mask - 1)
+			{
+				_BitScanForward(&planeIndex, mask);
+				plane = planes + planeIndex * 4;
+				__m256 dist = distances[planeIndex];
+				__m256 closer = _mm256_cmp_ps(dist, planeD, _CMP_GT_OQ);
+				planeX = _mm256_blendv_ps(planeX, _mm256_broadcast_ss(plane), closer);
+				planeY = _mm256_blendv_ps(planeY, _mm256_broadcast_ss(plane + 1), closer);
+				planeZ = _mm256_blendv_ps(planeZ, _mm256_broadcast_ss(plane + 2), closer);
+				planeD = _mm256_max_ps(dist, planeD);
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, zero, _CMP_LT_OQ));
+			}
+
+			if(!_mm256_movemask_ps(inside))
+				continue;
+
+			__m256 scale = _mm256_and_ps(planeD, inside);
+			deltaX = fnmadd_ps<avx>(planeX, scale, deltaX);
+			deltaY = fnmadd_ps<avx>(planeY, scale, deltaY);
+			deltaZ = fnmadd_ps<avx>(planeZ, scale, deltaZ);
+			numContacts = _mm256_add_ps(numContacts, _mm256_and_ps(sOne, inside));
+		}
+
+		__m256 contactMask = _mm256_cmp_ps(numContacts, sEpsilon, _CMP_GT_OQ);
+		if(!_mm256_movemask_ps(contactMask))
+			continue;
+
+		__m256 invNumContacts = _mm256_rcp_ps(numContacts);
+
+		if(frictionScale > 0.0f)
+		{
+			__m256 prevPos[4];
+			loadParticles(prevIt, prevPos);
+
+			// collision normal
+			__m256 deltaSq = fmadd_ps<avx>(deltaX, deltaX, fmadd_ps<avx>(deltaY, deltaY, _mm256_mul_ps(deltaZ, deltaZ)));
+			__m256 rcpDelta = _mm256_rsqrt_ps(_mm256_add_ps(deltaSq, sEpsilon));
+
+			__m256 nx = _mm256_mul_ps(deltaX, rcpDelta);
+			__m256 ny = _mm256_mul_ps(deltaY, rcpDelta);
+			__m256 nz = _mm256_mul_ps(deltaZ, rcpDelta);
+
+			// relative velocity, planes are static
+			__m256 rvx = _mm256_sub_ps(curPos[0], prevPos[0]);
+			__m256 rvy = _mm256_sub_ps(curPos[1], prevPos[1]);
+			__m256 rvz = _mm256_sub_ps(curPos[2], prevPos[2]);
+
+			__m256 rvn = fmadd_ps<avx>(rvx, nx, fmadd_ps<avx>(rvy, ny, _mm256_mul_ps(rvz, nz)));
+
+			// relative tangential velocity
+			__m256 rvtx = fnmadd_ps<avx>(rvn, nx, rvx);
+			__m256 rvty = fnmadd_ps<avx>(rvn, ny, rvy);
+			__m256 rvtz = fnmadd_ps<avx>(rvn, nz, rvz);
+
+			__m256 rcpVt = _mm256_rsqrt_ps(
+			    fmadd_ps<avx>(rvtx, rvtx, fmadd_ps<avx>(rvty, rvty, fmadd_ps<avx>(rvtz, rvtz, sEpsilon))));
+
+			// magnitude of friction impulse (cannot be greater than -vt)
+			__m256 j = _mm256_mul_ps(_mm256_mul_ps(frictionCoefficient, deltaSq), _mm256_mul_ps(rcpDelta, rcpVt));
+			j = _mm256_and_ps(_mm256_max_ps(_mm256_sub_ps(zero, j), minusOne), contactMask);
+
+			prevPos[0] = fnmadd_ps<avx>(rvtx, j, prevPos[0]);
+			prevPos[1] = fnmadd_ps<avx>(rvty, j, prevPos[1]);
+			prevPos[2] = fnmadd_ps<avx>(rvtz, j, prevPos[2]);
+
+			storeParticles(prevIt, prevPos);
+		}
+
+		curPos[0] = fmadd_ps<avx>(deltaX, invNumContacts, curPos[0]);
+		curPos[1] = fmadd_ps<avx>(deltaY, invNumContacts, curPos[1]);
+		curPos[2] = fmadd_ps<avx>(deltaZ, invNumContacts, curPos[2]);
+
+		storeParticles(curIt, curPos);
+
+		numCollisions += horizontalSum(numContacts);
+	}
+
+	_mm256_zeroupper();
+
+	return numCollisions;
+}
+
+// 8-wide version of SwCollision::collideTriangles(), triangles are laid out as cloth::TriangleData
+// (20 floats each), the particle range is padded to a multiple of 8. Returns the number of collisions.
+template <uint32_t avx>
+uint32_t collideTriangles(float* __restrict curIt, const float* __restrict curEnd, const float* __restrict triangles,
+                          uint32_t numTriangles)
+{
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 floatMax = _mm256_set1_ps(3.402823466e+38f);
+	const __m256 slackScale = _mm256_set1_ps(1e-4f);
+
+	const float* tEnd = triangles + numTriangles * 20;
+
+	uint32_t numCollisions = 0;
+
+	for(; curIt < curEnd; curIt += 32)
+	{
+		__m256 curPos[4];
+		loadParticles(curIt, curPos);
+
+		__m256 normalX = zero, normalY = zero, normalZ = zero, normalD = zero;
+		__m256 minSqrLength = floatMax;
+
+		for(const float* tIt = triangles; tIt != tEnd; tIt += 20)
+		{
+			__m256 dx = _mm256_sub_ps(curPos[0], _mm256_broadcast_ss(tIt));
+			__m256 dy = _mm256_sub_ps(curPos[1], _mm256_broadcast_ss(tIt + 1));
+			__m256 dz = _mm256_sub_ps(curPos[2], _mm256_broadcast_ss(tIt + 2));
+
+			__m256 e0x = _mm256_broadcast_ss(tIt + 4);
+			__m256 e0y = _mm256_broadcast_ss(tIt + 5);
+			__m256 e0z = _mm256_broadcast_ss(tIt + 6);
+
+			__m256 e1x = _mm256_broadcast_ss(tIt + 8);
+			__m256 e1y = _mm256_broadcast_ss(tIt + 9);
+			__m256 e1z = _mm256_broadcast_ss(tIt + 10);
+
+			__m256 nx = _mm256_broadcast_ss(tIt + 12);
+			__m256 ny = _mm256_broadcast_ss(tIt + 13);
+			__m256 nz = _mm256_broadcast_ss(tIt + 14);
+
+			__m256 deltaDotEdge0 = fmadd_ps<avx>(dx, e0x, fmadd_ps<avx>(dy, e0y, _mm256_mul_ps(dz, e0z)));
+			__m256 deltaDotEdge1 = fmadd_ps<avx>(dx, e1x, fmadd_ps<avx>(dy, e1y, _mm256_mul_ps(dz, e1z)));
+			__m256 deltaDotNormal = fmadd_ps<avx>(dx, nx, fmadd_ps<avx>(dy, ny, _mm256_mul_ps(dz, nz)));
+
+			__m256 edge0DotEdge1 = _mm256_broadcast_ss(tIt + 3);
+			__m256 edge0SqrLength = _mm256_broadcast_ss(tIt + 7);
+			__m256 edge1SqrLength = _mm256_broadcast_ss(tIt + 11);
+
+			__m256 s = fnmadd_ps<avx>(edge0DotEdge1, deltaDotEdge1, _mm256_mul_ps(edge1SqrLength, deltaDotEdge0));
+			__m256 t = fnmadd_ps<avx>(edge0DotEdge1, deltaDotEdge0, _mm256_mul_ps(edge0SqrLength, deltaDotEdge1));
+
+			__m256 sPositive = _mm256_cmp_ps(s, zero, _CMP_GT_OQ);
+			__m256 tPositive = _mm256_cmp_ps(t, zero, _CMP_GT_OQ);
+
+			__m256 det = _mm256_broadcast_ss(tIt + 16);
+
+			s = _mm256_blendv_ps(_mm256_mul_ps(deltaDotEdge0, _mm256_broadcast_ss(tIt + 18)), _mm256_mul_ps(s, det),
+			                     tPositive);
+			t = _mm256_blendv_ps(_mm256_mul_ps(deltaDotEdge1, _mm256_broadcast_ss(tIt + 19)), _mm256_mul_ps(t, det),
+			                     sPositive);
+
+			__m256 clamp = _mm256_cmp_ps(sOne, _mm256_add_ps(s, t), _CMP_LT_OQ);
+			__m256 numerator =
+			    _mm256_sub_ps(_mm256_add_ps(_mm256_sub_ps(edge1SqrLength, edge0DotEdge1), deltaDotEdge0), deltaDotEdge1);
+
+			s = _mm256_blendv_ps(s, _mm256_mul_ps(numerator, _mm256_broadcast_ss(tIt + 17)), clamp);
+
+			s = _mm256_max_ps(zero, _mm256_min_ps(sOne, s));
+			t = _mm256_max_ps(zero, _mm256_min_ps(_mm256_sub_ps(sOne, s), t));
+
+			dx = fnmadd_ps<avx>(e1x, t, fnmadd_ps<avx>(e0x, s, dx));
+			dy = fnmadd_ps<avx>(e1y, t, fnmadd_ps<avx>(e0y, s, dy));
+			dz = fnmadd_ps<avx>(e1z, t, fnmadd_ps<avx>(e0z, s, dz));
+
+			__m256 sqrLength = fmadd_ps<avx>(dx, dx, fmadd_ps<avx>(dy, dy, _mm256_mul_ps(dz, dz)));
+
+			// slightly increase distance for colliding triangles
+			__m256 slack = _mm256_and_ps(_mm256_cmp_ps(deltaDotNormal, zero, _CMP_LT_OQ), slackScale);
+			sqrLength = fmadd_ps<avx>(sqrLength, slack, sqrLength);
+
+			__m256 mask = _mm256_cmp_ps(sqrLength, minSqrLength, _CMP_LT_OQ);
+
+			normalX = _mm256_blendv_ps(normalX, nx, mask);
+			normalY = _mm256_blendv_ps(normalY, ny, mask);
+			normalZ = _mm256_blendv_ps(normalZ, nz, mask);
+			normalD = _mm256_blendv_ps(normalD, deltaDotNormal, mask);
+
+			minSqrLength = _mm256_min_ps(sqrLength, minSqrLength);
+		}
+
+		__m256 contactMask = _mm256_cmp_ps(normalD, zero, _CMP_LT_OQ);
+		if(!_mm256_movemask_ps(contactMask))
+			continue;
+
+		__m256 numContacts = _mm256_add_ps(sEpsilon, _mm256_and_ps(sOne, contactMask));
+		__m256 scale = _mm256_and_ps(_mm256_mul_ps(normalD, _mm256_rcp_ps(numContacts)), contactMask);
+
+		curPos[0] = fnmadd_ps<avx>(normalX, scale, curPos[0]);
+		curPos[1] = fnmadd_ps<avx>(normalY, scale, curPos[1]);
+		curPos[2] = fnmadd_ps<avx>(normalZ, scale, curPos[2]);
+
+		storeParticles(curIt, curPos);
+
+		numCollisions += horizontalSum(numContacts);
+	}
+
+	_mm256_zeroupper();
+
+	return numCollisions;
+}
+
+template uint32_t collideConvexes<1>(float* __restrict, const float* __restrict, float* __restrict,
+                                     const float* __restrict, uint32_t, const uint32_t* __restrict, uint32_t, float);
+template uint32_t collideTriangles<1>(float* __restrict, const float* __restrict, const float* __restrict, uint32_t);
+
+#if _MSC_VER >= 1700
+template uint32_t collideConvexes<2>(float* __restrict, const float* __restrict, float* __restrict,
+                                     const float* __restrict, uint32_t, const uint32_t* __restrict, uint32_t, float);
+template uint32_t collideTriangles<2>(float* __restrict, const float* __restrict, const float* __restrict, uint32_t);
+#endif
+
+} // namespace avx
@@ -91,7 +91,11 @@ public:
   public:
 	bool isSleeping() const
 	{
-		return mSleepPassCounter >= mSleepAfterCount;
+		return mSleepPassCounter >= mSleepAfterCount || isFrozen();
+	}
+	bool isFrozen() const
+	{
+		return mLodFactor == 0.0f;
 	}
 	void wakeUp()
 	{
@@ -138,6 +142,7 @@ public:
 	PxVec3 mAngularInertia;
 	PxVec3 mCentrifugalInertia;
 	float mSolverFrequency;
+	float mLodFactor; // solver frequency scale, 0 freezes the cloth
 	float mStiffnessFrequency;
 
 	PxTransform mTargetMotion;
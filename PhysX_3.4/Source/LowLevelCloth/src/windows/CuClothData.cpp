@@ -195,7 +195,8 @@ cloth::CuFrameData::CuFrameData(CuCloth& cloth, uint32_t numSharedPositions, con
 		mParticleBounds[i * 2 + 1] = r - c;
 	}
 
-	mSleepPassCounter = cloth.mSleepPassCounter;
+	// frozen cloths are passed to the kernel as sleeping
+	mSleepPassCounter = cloth.isFrozen() ? cloth.mSleepAfterCount : cloth.mSleepPassCounter;
 	mSleepTestCounter = cloth.mSleepTestCounter;
 
 	mStiffnessExponent = cloth.mStiffnessFrequency * mIterDt;
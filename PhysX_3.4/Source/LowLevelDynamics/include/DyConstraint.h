@@ -72,6 +72,9 @@ public:
 	PxU32								flags;																//40
 	PxU32								index;																//44 //this is also a constraint write back index
 	PxReal								minResponseThreshold;												//48
+	PxU16								partitionHint;														//52 //partition used by the last persistent partitioning pass, PX_MAX_U16 if none
+	PxU16								pad;																//54
+	PxConstraintSolverPrep4				solverPrep4;														//56
 }
 PX_ALIGN_SUFFIX(16);
 #if PX_VC 
@@ -175,6 +175,54 @@ public:
 	*/
 	PX_FORCE_INLINE void				setFrictionType(PxFrictionType::Enum f) 	{ mFrictionType = f; }
 
+	/**
+	\brief Returns whether pairs of 4-wide constraint batches may be solved 8 at a time.
+	\return True if the 8-wide solver path is enabled.
+	*/
+	PX_FORCE_INLINE bool				getSolverBatch8Enabled()		const	{ return mSolverBatch8Enabled; }
+
+	/**
+	\brief Enables or disables solving pairs of 4-wide constraint batches 8 at a time.
+	\param[in] enabled True to enable the 8-wide solver path. Only honored if the CPU supports it.
+	*/
+	PX_FORCE_INLINE void				setSolverBatch8Enabled(bool enabled)		{ mSolverBatch8Enabled = enabled; }
+
+	/**
+	\brief Returns whether constraint partitions are built incrementally from the previous frame's partitions.
+	\return True if incremental partitioning is enabled.
+	*/
+	PX_FORCE_INLINE bool				getIncrementalPartitioningEnabled()	const	{ return mIncrementalPartitioning; }
+
+	/**
+	\brief Enables or disables incremental constraint partitioning.
+	\param[in] enabled True to enable incremental partitioning. Ignored when enhanced determinism is enabled.
+	*/
+	PX_FORCE_INLINE void				setIncrementalPartitioningEnabled(bool enabled)	{ mIncrementalPartitioning = enabled; }
+
+	/**
+	\brief Returns whether islands may stop iterating before the configured solver iteration counts are reached.
+	\return True if adaptive solver iterations are enabled.
+	*/
+	PX_FORCE_INLINE bool				getAdaptiveSolverIterationsEnabled()	const	{ return mAdaptiveSolverIterations; }
+
+	/**
+	\brief Enables or disables adaptive solver iteration counts.
+	\param[in] enabled True to let converged islands skip their remaining solver iterations.
+	*/
+	PX_FORCE_INLINE void				setAdaptiveSolverIterationsEnabled(bool enabled)	{ mAdaptiveSolverIterations = enabled; }
+
+	/**
+	\brief Returns the velocity change below which an island is considered converged.
+	\return The solver residual tolerance.
+	*/
+	PX_FORCE_INLINE PxReal				getSolverResidualTolerance()	const	{ return mSolverResidualTolerance; }
+
+	/**
+	\brief Sets the velocity change below which an island is considered converged.
+	\param[in] tolerance The solver residual tolerance. Must be non-negative.
+	*/
+	PX_FORCE_INLINE void				setSolverResidualTolerance(PxReal tolerance)	{ mSolverResidualTolerance = tolerance; }
+
 	/**
 	\brief Destroys this dynamics context
 	*/
@@ -267,6 +315,10 @@ protected:
 
 		mBounceThreshold(-2.0f),
 		mSolverBatchSize(32),
+		mSolverBatch8Enabled(false),
+		mIncrementalPartitioning(false),
+		mAdaptiveSolverIterations(false),
+		mSolverResidualTolerance(0.0f),
 		mConstraintWriteBackPool(Ps::VirtualAllocator(allocatorCallback)),
 		mSimStats(simStats)
 		 {
@@ -345,6 +397,26 @@ protected:
 	*/
 	PxU32						mSolverBatchSize;
 
+	/**
+	\brief Whether pairs of 4-wide constraint batches in the same partition are solved 8 at a time.
+	*/
+	bool						mSolverBatch8Enabled;
+
+	/**
+	\brief Whether constraints are put back into the partitions they were in during the previous frame when possible.
+	*/
+	bool						mIncrementalPartitioning;
+
+	/**
+	\brief Whether islands stop iterating once the velocity change per iteration drops below mSolverResidualTolerance.
+	*/
+	bool						mAdaptiveSolverIterations;
+
+	/**
+	\brief The velocity change per iteration below which an island is considered converged.
+	*/
+	PxReal						mSolverResidualTolerance;
+
 	/**
 	\brief The current friction model being used
 	*/
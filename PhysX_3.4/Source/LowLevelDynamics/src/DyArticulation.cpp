@@ -176,6 +176,7 @@ void Articulation::checkLimits() const
 void PxvRegisterArticulations()
 {
 	ArticulationPImpl::sComputeUnconstrainedVelocities = &ArticulationHelper::computeUnconstrainedVelocities;
+	ArticulationPImpl::sComputeUnconstrainedVelocitiesBatch = &ArticulationHelper::computeUnconstrainedVelocitiesBatch;
 	ArticulationPImpl::sUpdateBodies = &ArticulationHelper::updateBodies;
 	ArticulationPImpl::sSaveVelocity = &ArticulationHelper::saveVelocity;
 
@@ -197,7 +198,8 @@ void Articulation::getDataSizes(PxU32 linkCount, PxU32 &solverDataSize, PxU32& t
 	totalSize = solverDataSize
 			  + sizeof(LtbRow)		 * linkCount			// lagrange matrix rows
 			  + sizeof(Cm::SpatialVectorV) * linkCount			// ref velocity
-			  + sizeof(FsRowAux)	 * linkCount;
+			  + sizeof(FsRowAux)	 * linkCount
+			  + sizeof(LtbCacheEntry) * linkCount;		// state of the cached lagrange factorization
 
 	scratchSize = PxU32(sizeof(FsInertia)*linkCount*3
 		        + ((sizeof(ArticulationJointTransforms)+15)&~15) * linkCount
@@ -57,6 +57,7 @@ namespace Dy
 {
 
 void PxcFsFlushVelocity(FsData& matrix);
+void PxcFsApplyImpulses4(const FsData* const matrices[4], const Cm::SpatialVectorV* const Z[4], Cm::SpatialVectorV* const V[4]);
 
 // we pass this around by value so that when we return from a function the size is unaltered. That means we don't preserve state
 // across functions - even though that could be handy to preserve baseInertia and jointTransforms across the solver so that if we 
@@ -680,7 +681,8 @@ void ArticulationHelper::prepareDataBlock(	FsData& fsData,
 					+ fsDataSize 
 					+ ltbDataSize
 					+ sizeof(Cm::SpatialVectorV) * linkCount
-					+ sizeof(FsRowAux)    * linkCount;
+					+ sizeof(FsRowAux)    * linkCount
+					+ sizeof(LtbCacheEntry) * linkCount;
 
 	PX_UNUSED(totalSize);
 	PX_UNUSED(expectedSize);
@@ -729,6 +731,19 @@ void ArticulationHelper::prepareDataBlock(	FsData& fsData,
 	}
 }
 
+bool ArticulationHelper::haveSameTopology(const FsData& matrix0, const FsData& matrix1)
+{
+	if(matrix0.linkCount != matrix1.linkCount)
+		return false;
+
+	for(PxU32 i=1;i<matrix0.linkCount;i++)
+	{
+		if(matrix0.parent[i] != matrix1.parent[i])
+			return false;
+	}
+	return true;
+}
+
 PxU32 ArticulationHelper::computeUnconstrainedVelocities(	const ArticulationSolverDesc& desc,
 															PxReal dt,
 															PxcConstraintBlockStream& stream,
@@ -736,6 +751,95 @@ PxU32 ArticulationHelper::computeUnconstrainedVelocities(	const ArticulationSolv
 															PxU32& acCount,
 															PxsConstraintBlockManager& constraintBlockManager,
 															const PxVec3& gravity, PxU64 contextID)
+{
+	Cm::SpatialVectorV Z[DY_ARTICULATION_MAX_SIZE];
+	prepareUnconstrainedVelocities(desc, dt, Z, gravity, contextID);
+
+	{
+		PX_PROFILE_ZONE("Articulations.applyExternalImpulses", contextID);
+		applyImpulses(*desc.fsData, Z, getVelocity(*desc.fsData));
+	}
+
+	return finishUnconstrainedVelocities(desc, dt, stream, constraintDesc, acCount, constraintBlockManager, contextID);
+}
+
+void ArticulationHelper::computeUnconstrainedVelocitiesBatch(	const ArticulationSolverDesc* descs,
+																PxU32 nbDescs,
+																PxReal dt,
+																PxcConstraintBlockStream& stream,
+																PxSolverConstraintDesc* constraintDescs,
+																PxU32* acCounts,
+																PxU32* descCounts,
+																PxsConstraintBlockManager& constraintBlockManager,
+																const PxVec3& gravity, PxU64 contextID)
+{
+	for(PxU32 base = 0; base < nbDescs; base += 32)
+	{
+		const PxU32 count = PxMin(nbDescs - base, 32u);
+		PxU32 pending = count == 32 ? 0xffffffff : (1u << count) - 1;
+
+		while(pending)
+		{
+			// gather up to four articulations sharing the topology of the first pending one
+			PxU32 batch[4], batchSize = 0;
+			batch[batchSize++] = base + Ps::lowestSetBitUnsafe(pending);
+			pending &= pending - 1;
+
+			FsData& first = *descs[batch[0]].fsData;
+			for(PxU32 candidates = pending; candidates && batchSize < 4; candidates &= candidates - 1)
+			{
+				const PxU32 index = Ps::lowestSetBitUnsafe(candidates);
+				if(haveSameTopology(first, *descs[base + index].fsData))
+				{
+					batch[batchSize++] = base + index;
+					pending &= ~(1u << index);
+				}
+			}
+
+			Cm::SpatialVectorV Z[4][DY_ARTICULATION_MAX_SIZE];
+			for(PxU32 i = 0; i < batchSize; i++)
+				prepareUnconstrainedVelocities(descs[batch[i]], dt, Z[i], gravity, contextID);
+
+			{
+				PX_PROFILE_ZONE("Articulations.applyExternalImpulses", contextID);
+
+				if(batchSize == 1)
+					applyImpulses(first, Z[0], getVelocity(first));
+				else
+				{
+					// unused lanes repeat the first articulation and write to a dummy velocity buffer
+					Cm::SpatialVectorV padVelocity[DY_ARTICULATION_MAX_SIZE];
+					PxMemZero(padVelocity, first.linkCount * sizeof(Cm::SpatialVectorV));
+
+					const FsData* matrices[4];
+					const Cm::SpatialVectorV* impulses[4];
+					Cm::SpatialVectorV* velocities[4];
+					for(PxU32 i = 0; i < 4; i++)
+					{
+						const bool isPad = i >= batchSize;
+						matrices[i] = isPad ? &first : descs[batch[i]].fsData;
+						impulses[i] = isPad ? Z[0] : Z[i];
+						velocities[i] = isPad ? padVelocity : getVelocity(*descs[batch[i]].fsData);
+					}
+
+					PxcFsApplyImpulses4(matrices, impulses, velocities);
+				}
+			}
+
+			for(PxU32 i = 0; i < batchSize; i++)
+			{
+				const PxU32 index = batch[i];
+				descCounts[index] = finishUnconstrainedVelocities(descs[index], dt, stream, constraintDescs + index * DY_ARTICULATION_MAX_SIZE,
+																  acCounts[index], constraintBlockManager, contextID);
+			}
+		}
+	}
+}
+
+void ArticulationHelper::prepareUnconstrainedVelocities(const ArticulationSolverDesc& desc,
+														PxReal dt,
+														Cm::SpatialVectorV* Z,
+														const PxVec3& gravity, PxU64 contextID)
 {
 	PX_UNUSED(contextID);
 	const ArticulationLink* links = desc.links;
@@ -760,10 +864,16 @@ PxU32 ArticulationHelper::computeUnconstrainedVelocities(	const ArticulationSolv
 
 		PX_PROFILE_ZONE("Articulations.setupProject", contextID);
 
-		PxMemZero(getLtbRows(fsData), getLtbDataSize(linkCount));
-		prepareLtbMatrix(fsData, baseInertia, poses, jointTransforms, recipDt);
+		// the factorization only depends on the link poses and mass properties, so it is kept while they barely change
+		if(!checkLtbCache(fsData, links, poses, jointTransforms, desc.core->separationTolerance * DY_ARTICULATION_LTB_REUSE_POSITION_TOLERANCE))
+		{
+			PxMemZero(getLtbRows(fsData), getLtbDataSize(linkCount));
+			prepareLtbMatrix(fsData, baseInertia, poses, jointTransforms, recipDt);
 
-		PxcLtbFactor(fsData);
+			PxcLtbFactor(fsData);
+		}
+		else
+			updateLtbError(fsData, jointTransforms, recipDt);
 	
 		Vec3V b[DY_ARTICULATION_MAX_SIZE];
 		PxcLtbComputeJv(b, fsData, velocity);
@@ -839,8 +949,7 @@ PxU32 ArticulationHelper::computeUnconstrainedVelocities(	const ArticulationSolv
 	}
 
 	{
-		PX_PROFILE_ZONE("Articulations.applyExternalImpulses", contextID);
-		Cm::SpatialVectorV	Z[DY_ARTICULATION_MAX_SIZE];
+		PX_PROFILE_ZONE("Articulations.computeExternalImpulses", contextID);
 
 		FloatV h = FLoad(dt);
 
@@ -859,9 +968,27 @@ PxU32 ArticulationHelper::computeUnconstrainedVelocities(	const ArticulationSolv
 			//KS - zero accelerations to ensure they don't get re-applied next frame if nothing touches them again.
 			acceleration[i].linear = PxVec3(0.f); acceleration[i].angular = PxVec3(0.f);
 		}
-
-		applyImpulses(fsData, Z, getVelocity(fsData));
 	}
+}
+
+PxU32 ArticulationHelper::finishUnconstrainedVelocities(const ArticulationSolverDesc& desc,
+														PxReal dt,
+														PxcConstraintBlockStream& stream,
+														PxSolverConstraintDesc* constraintDesc,
+														PxU32& acCount,
+														PxsConstraintBlockManager& constraintBlockManager,
+														PxU64 contextID)
+{
+	PX_UNUSED(contextID);
+	const ArticulationLink* links = desc.links;
+	PxU16 linkCount = desc.linkCount;
+	FsData& fsData = *desc.fsData;
+	Cm::SpatialVectorV* velocity = getVelocity(fsData);
+
+	// same allocation order as prepareUnconstrainedVelocities, to get at the joint transforms computed there
+	PxcFsScratchAllocator allocator(desc.scratchMemory, desc.scratchMemorySize);
+	allocator.alloc<FsInertia>(desc.linkCount);
+	const ArticulationJointTransforms* PX_RESTRICT jointTransforms = allocator.alloc<ArticulationJointTransforms>(desc.linkCount);
 
 	// save off the motion velocity in case there are no constraints with the articulation
 
@@ -983,6 +1110,7 @@ void ArticulationHelper::updateBodies(const ArticulationSolverDesc& desc, PxReal
 
 		ArticulationHelper::prepareLtbMatrix(fsData, baseInertia, poses, jointTransforms, recipDt);
 		PxcLtbFactor(fsData);
+		invalidateLtbCache(fsData);
 
 		LtbRow* rows = getLtbRows(fsData);
 
@@ -1098,6 +1226,65 @@ void ArticulationHelper::prepareLtbMatrix(	FsData& fsData,
 	}
 }
 
+void ArticulationHelper::updateLtbError(FsData& fsData,
+										const ArticulationJointTransforms* jointTransforms,
+										PxReal recipDt)
+{
+	LtbRow* rows = getLtbRows(fsData);
+
+	// same as the error term in prepareLtbMatrix
+	for(PxU32 i=1;i<fsData.linkCount;i++)
+	{
+		const ArticulationJointTransforms& s = jointTransforms[i];
+		rows[i].jC = V3LoadU((s.cA2w.p - s.cB2w.p) * 0.99f * recipDt);
+	}
+}
+
+bool ArticulationHelper::checkLtbCache(FsData& fsData,
+									   const ArticulationLink* links,
+									   const PxTransform* poses,
+									   const ArticulationJointTransforms* jointTransforms,
+									   PxReal tolerance)
+{
+	const PxU32 linkCount = fsData.linkCount;
+	LtbCacheEntry* cache = getLtbCache(fsData);
+	const PxReal tolerance2 = tolerance * tolerance;
+
+	bool isValid = true;
+	for(PxU32 i=0;i<linkCount && isValid;i++)
+	{
+		const LtbCacheEntry& e = cache[i];
+		const PxsBodyCore& core = *links[i].bodyCore;
+
+		isValid = (e.pose.p - poses[i].p).magnitudeSquared() <= tolerance2
+			   && PxAbs(e.pose.q.dot(poses[i].q)) >= DY_ARTICULATION_LTB_REUSE_ROTATION_TOLERANCE
+			   && (i == 0 || (e.jointAnchor - jointTransforms[i].cB2w.p).magnitudeSquared() <= tolerance2)
+			   && e.inverseInertia == core.inverseInertia
+			   && e.inverseMass == core.inverseMass;
+	}
+
+	if(isValid)
+		return true;
+
+	for(PxU32 i=0;i<linkCount;i++)
+	{
+		LtbCacheEntry& e = cache[i];
+		const PxsBodyCore& core = *links[i].bodyCore;
+
+		e.pose = poses[i];
+		e.jointAnchor = i ? jointTransforms[i].cB2w.p : PxVec3(0.0f);
+		e.inverseInertia = core.inverseInertia;
+		e.inverseMass = core.inverseMass;
+	}
+	return false;
+}
+
+void ArticulationHelper::invalidateLtbCache(FsData& fsData)
+{
+	// a zero quaternion never matches a link orientation
+	getLtbCache(fsData)[0].pose.q = PxQuat(PxZero);
+}
+
 void ArticulationHelper::prepareFsData(FsData& fsData, const ArticulationLink* links)
 {
 	typedef ArticulationFnsSimd<ArticulationFnsSimdBase> Fns;
@@ -1339,6 +1526,7 @@ void ArticulationHelper::computeJointDrives(FsData& fsData,
 }
 
 ArticulationPImpl::ComputeUnconstrainedVelocitiesFn ArticulationPImpl::sComputeUnconstrainedVelocities = NULL;
+ArticulationPImpl::ComputeUnconstrainedVelocitiesBatchFn ArticulationPImpl::sComputeUnconstrainedVelocitiesBatch = NULL;
 ArticulationPImpl::UpdateBodiesFn ArticulationPImpl::sUpdateBodies = NULL;
 ArticulationPImpl::SaveVelocityFn ArticulationPImpl::sSaveVelocity = NULL;
 
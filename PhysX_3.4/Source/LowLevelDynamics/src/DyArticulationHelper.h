@@ -69,6 +69,21 @@ public:
 												   PxsConstraintBlockManager& constraintBlockManager,
 												   const PxVec3& gravity, PxU64 contextID);
 
+	// Same as computeUnconstrainedVelocities for an array of articulations. Articulations with the same topology
+	// get their external impulses applied in batches of four, one per SIMD lane. The constraint descriptors of
+	// articulation i start at constraintDescs + i*DY_ARTICULATION_MAX_SIZE.
+	static void		computeUnconstrainedVelocitiesBatch(const ArticulationSolverDesc* descs,
+														PxU32 nbDescs,
+														PxReal dt,
+														PxcConstraintBlockStream& stream,
+														PxSolverConstraintDesc* constraintDescs,
+														PxU32* acCounts,
+														PxU32* descCounts,
+														PxsConstraintBlockManager& constraintBlockManager,
+														const PxVec3& gravity, PxU64 contextID);
+
+	static bool		haveSameTopology(const FsData& matrix0, const FsData& matrix1);
+
 	static void		updateBodies(const ArticulationSolverDesc& desc,
 							 	 PxReal dt);
 
@@ -117,6 +132,19 @@ public:
 								  Cm::SpatialVectorV* V);
 
 private:
+	static void		prepareUnconstrainedVelocities(const ArticulationSolverDesc& desc,
+												   PxReal dt,
+												   Cm::SpatialVectorV* Z,
+												   const PxVec3& gravity, PxU64 contextID);
+
+	static PxU32	finishUnconstrainedVelocities(const ArticulationSolverDesc& desc,
+												  PxReal dt,
+												  PxcConstraintBlockStream& stream,
+												  PxSolverConstraintDesc* constraintDesc,
+												  PxU32& acCount,
+												  PxsConstraintBlockManager& constraintBlockManager,
+												  PxU64 contextID);
+
 	static PxU32	getLtbDataSize(PxU32 linkCount);
 	static PxU32	getFsDataSize(PxU32 linkCount);
 
@@ -143,6 +171,18 @@ private:
 									 const ArticulationJointTransforms* jointTransforms,
 									 PxReal recipDt);
 
+	static void		updateLtbError(FsData& fsData,
+								   const ArticulationJointTransforms* jointTransforms,
+								   PxReal recipDt);
+
+	static bool		checkLtbCache(FsData& fsData,
+								  const ArticulationLink* links,
+								  const PxTransform* poses,
+								  const ArticulationJointTransforms* jointTransforms,
+								  PxReal tolerance);
+
+	static void		invalidateLtbCache(FsData& fsData);
+
 	static void		prepareFsData(FsData& fsData,
 								  const ArticulationLink* links);
 
@@ -60,12 +60,23 @@ public:
 													 PxsConstraintBlockManager& constraintBlockManager,
 													 const PxVec3& gravity, PxU64 contextID);
 
+	typedef void (*ComputeUnconstrainedVelocitiesBatchFn)(const ArticulationSolverDesc* descs,
+														  PxU32 nbDescs,
+														  PxReal dt,
+														  PxcConstraintBlockStream& stream,
+														  PxSolverConstraintDesc* constraintDescs,
+														  PxU32* acCounts,
+														  PxU32* descCounts,
+														  PxsConstraintBlockManager& constraintBlockManager,
+														  const PxVec3& gravity, PxU64 contextID);
+
 	typedef void (*UpdateBodiesFn)(const ArticulationSolverDesc& desc,
 								   PxReal dt);
 
 	typedef void (*SaveVelocityFn)(const ArticulationSolverDesc &m);
 
 	static ComputeUnconstrainedVelocitiesFn sComputeUnconstrainedVelocities;
+	static ComputeUnconstrainedVelocitiesBatchFn sComputeUnconstrainedVelocitiesBatch;
 	static UpdateBodiesFn sUpdateBodies;
 	static SaveVelocityFn sSaveVelocity;
 
@@ -85,6 +96,28 @@ public:
 			return 0;
 	}
 
+	// constraintDescs holds DY_ARTICULATION_MAX_SIZE descriptors per articulation
+	static void computeUnconstrainedVelocitiesBatch(const ArticulationSolverDesc* descs,
+													PxU32 nbDescs,
+													PxReal dt,
+													PxcConstraintBlockStream& stream,
+													PxSolverConstraintDesc* constraintDescs,
+													PxU32* acCounts,
+													PxU32* descCounts,
+													PxcScratchAllocator&,
+													PxsConstraintBlockManager& constraintBlockManager,
+													const PxVec3& gravity, PxU64 contextID)
+	{
+		PX_ASSERT(sComputeUnconstrainedVelocitiesBatch);
+		if(sComputeUnconstrainedVelocitiesBatch)
+			(sComputeUnconstrainedVelocitiesBatch)(descs, nbDescs, dt, stream, constraintDescs, acCounts, descCounts, constraintBlockManager, gravity, contextID);
+		else
+		{
+			for(PxU32 i = 0; i < nbDescs; i++)
+				descCounts[i] = 0;
+		}
+	}
+
 	static void	updateBodies(const ArticulationSolverDesc& desc,
 						 PxReal dt)
 	{
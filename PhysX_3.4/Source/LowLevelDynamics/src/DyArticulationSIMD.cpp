@@ -302,5 +302,177 @@ void PxcFsFlushVelocity(FsData& matrix)
 
 	matrix.dirty = 0;
 }
+
+namespace
+{
+	// one Vec3V per articulation of a batch of four, stored by component
+	struct Vec3V4
+	{
+		Vec4V x, y, z;
+	};
+
+	struct SpatialVectorV4
+	{
+		Vec3V4 linear, angular;
+	};
+
+	PX_FORCE_INLINE Vec3V4 load4(const Vec3V& v0, const Vec3V& v1, const Vec3V& v2, const Vec3V& v3)
+	{
+		Vec4V c0 = Vec4V_From_Vec3V(v0), c1 = Vec4V_From_Vec3V(v1), c2 = Vec4V_From_Vec3V(v2), c3 = Vec4V_From_Vec3V(v3);
+		V4Transpose(c0, c1, c2, c3);
+
+		Vec3V4 result = { c0, c1, c2 };
+		return result;
+	}
+
+	PX_FORCE_INLINE SpatialVectorV4 load4(const Cm::SpatialVectorV& v0, const Cm::SpatialVectorV& v1, 
+										  const Cm::SpatialVectorV& v2, const Cm::SpatialVectorV& v3)
+	{
+		SpatialVectorV4 result = { load4(v0.linear, v1.linear, v2.linear, v3.linear),
+								   load4(v0.angular, v1.angular, v2.angular, v3.angular) };
+		return result;
+	}
+
+	PX_FORCE_INLINE void store4(const Vec3V4& v, Vec3V& v0, Vec3V& v1, Vec3V& v2, Vec3V& v3)
+	{
+		Vec4V c0 = v.x, c1 = v.y, c2 = v.z, c3 = V4Zero();
+		V4Transpose(c0, c1, c2, c3);
+
+		v0 = Vec3V_From_Vec4V(c0);
+		v1 = Vec3V_From_Vec4V(c1);
+		v2 = Vec3V_From_Vec4V(c2);
+		v3 = Vec3V_From_Vec4V(c3);
+	}
+
+	PX_FORCE_INLINE Vec3V4 add(const Vec3V4& a, const Vec3V4& b)
+	{
+		Vec3V4 result = { V4Add(a.x, b.x), V4Add(a.y, b.y), V4Add(a.z, b.z) };
+		return result;
+	}
+
+	PX_FORCE_INLINE Vec3V4 sub(const Vec3V4& a, const Vec3V4& b)
+	{
+		Vec3V4 result = { V4Sub(a.x, b.x), V4Sub(a.y, b.y), V4Sub(a.z, b.z) };
+		return result;
+	}
+
+	PX_FORCE_INLINE Vec3V4 cross(const Vec3V4& a, const Vec3V4& b)
+	{
+		Vec3V4 result = { V4NegMulSub(a.z, b.y, V4Mul(a.y, b.z)),
+						  V4NegMulSub(a.x, b.z, V4Mul(a.z, b.x)),
+						  V4NegMulSub(a.y, b.x, V4Mul(a.x, b.y)) };
+		return result;
+	}
+
+	PX_FORCE_INLINE Vec4V dot(const Vec3V4& a, const Vec3V4& b)
+	{
+		return V4MulAdd(a.z, b.z, V4MulAdd(a.y, b.y, V4Mul(a.x, b.x)));
+	}
+
+	// c0 * s.x + c1 * s.y + c2 * s.z
+	PX_FORCE_INLINE Vec3V4 multiply(const Vec3V4& c0, const Vec3V4& c1, const Vec3V4& c2, const Vec3V4& s)
+	{
+		Vec3V4 result = { V4MulAdd(c2.x, s.z, V4MulAdd(c1.x, s.y, V4Mul(c0.x, s.x))),
+						  V4MulAdd(c2.y, s.z, V4MulAdd(c1.y, s.y, V4Mul(c0.y, s.x))),
+						  V4MulAdd(c2.z, s.z, V4MulAdd(c1.z, s.y, V4Mul(c0.z, s.x))) };
+		return result;
+	}
+}
+
+// Same as ArticulationHelper::applyImpulses, for four articulations with the same topology at once, one per SIMD lane.
+// The lanes may alias the same articulation as long as they write to different velocity buffers.
+void PxcFsApplyImpulses4(const FsData* const matrices[4],
+						 const Cm::SpatialVectorV* const Z[4],
+						 Cm::SpatialVectorV* const V[4])
+{
+	typedef ArticulationFnsSimd<ArticulationFnsSimdBase> Fns;
+
+	const FsData& m0 = *matrices[0], &m1 = *matrices[1], &m2 = *matrices[2], &m3 = *matrices[3];
+	const PxU32 linkCount = m0.linkCount;
+	PX_ASSERT(linkCount<=DY_ARTICULATION_MAX_SIZE);
+	PX_ASSERT(m1.linkCount == linkCount && m2.linkCount == linkCount && m3.linkCount == linkCount);
+
+	const FsRow* rows0 = getFsRows(m0), *rows1 = getFsRows(m1), *rows2 = getFsRows(m2), *rows3 = getFsRows(m3);
+	const FsJointVectors* jv0 = getJointVectors(m0), *jv1 = getJointVectors(m1), *jv2 = getJointVectors(m2), *jv3 = getJointVectors(m3);
+	const PxU8* parent = m0.parent;
+
+	// holds the propagated impulses first, then the velocity changes
+	SpatialVectorV4 ZdV[DY_ARTICULATION_MAX_SIZE];
+	Vec3V4 SZ[DY_ARTICULATION_MAX_SIZE];
+
+	for(PxU32 i=0;i<linkCount;i++)
+		ZdV[i] = load4(Z[0][i], Z[1][i], Z[2][i], Z[3][i]);
+
+	for(PxU32 i=linkCount;i-->1;)
+	{
+		PX_ASSERT(m1.parent[i] == parent[i] && m2.parent[i] == parent[i] && m3.parent[i] == parent[i]);
+
+		const Vec3V4 jointOffset = load4(jv0[i].jointOffset, jv1[i].jointOffset, jv2[i].jointOffset, jv3[i].jointOffset);
+		const Vec3V4 parentOffset = load4(jv0[i].parentOffset, jv1[i].parentOffset, jv2[i].parentOffset, jv3[i].parentOffset);
+		const SpatialVectorV4 DSI0 = load4(rows0[i].DSI[0], rows1[i].DSI[0], rows2[i].DSI[0], rows3[i].DSI[0]);
+		const SpatialVectorV4 DSI1 = load4(rows0[i].DSI[1], rows1[i].DSI[1], rows2[i].DSI[1], rows3[i].DSI[1]);
+		const SpatialVectorV4 DSI2 = load4(rows0[i].DSI[2], rows1[i].DSI[2], rows2[i].DSI[2], rows3[i].DSI[2]);
+
+		// see ArticulationFnsSimd::propagateImpulse
+		const SpatialVectorV4& z = ZdV[i];
+		const Vec3V4 sz = add(z.angular, cross(z.linear, jointOffset));
+		const Vec3V4 linear = sub(z.linear, multiply(DSI0.linear, DSI1.linear, DSI2.linear, sz));
+		const Vec3V4 angular = sub(z.angular, multiply(DSI0.angular, DSI1.angular, DSI2.angular, sz));
+
+		SpatialVectorV4& zp = ZdV[parent[i]];
+		zp.linear = add(zp.linear, linear);
+		zp.angular = add(zp.angular, add(angular, cross(parentOffset, linear)));
+		SZ[i] = sz;
+	}
+
+	{
+		Cm::SpatialVectorV Z0[4];
+		store4(ZdV[0].linear, Z0[0].linear, Z0[1].linear, Z0[2].linear, Z0[3].linear);
+		store4(ZdV[0].angular, Z0[0].angular, Z0[1].angular, Z0[2].angular, Z0[3].angular);
+
+		ZdV[0] = load4(Fns::multiply(getRootInverseInertia(m0), -Z0[0]),
+					   Fns::multiply(getRootInverseInertia(m1), -Z0[1]),
+					   Fns::multiply(getRootInverseInertia(m2), -Z0[2]),
+					   Fns::multiply(getRootInverseInertia(m3), -Z0[3]));
+	}
+
+	for(PxU32 i=1;i<linkCount;i++)
+	{
+		const Vec3V4 jointOffset = load4(jv0[i].jointOffset, jv1[i].jointOffset, jv2[i].jointOffset, jv3[i].jointOffset);
+		const Vec3V4 parentOffset = load4(jv0[i].parentOffset, jv1[i].parentOffset, jv2[i].parentOffset, jv3[i].parentOffset);
+		const SpatialVectorV4 DSI0 = load4(rows0[i].DSI[0], rows1[i].DSI[0], rows2[i].DSI[0], rows3[i].DSI[0]);
+		const SpatialVectorV4 DSI1 = load4(rows0[i].DSI[1], rows1[i].DSI[1], rows2[i].DSI[1], rows3[i].DSI[1]);
+		const SpatialVectorV4 DSI2 = load4(rows0[i].DSI[2], rows1[i].DSI[2], rows2[i].DSI[2], rows3[i].DSI[2]);
+		const Vec3V4 D0 = load4(rows0[i].D.col0, rows1[i].D.col0, rows2[i].D.col0, rows3[i].D.col0);
+		const Vec3V4 D1 = load4(rows0[i].D.col1, rows1[i].D.col1, rows2[i].D.col1, rows3[i].D.col1);
+		const Vec3V4 D2 = load4(rows0[i].D.col2, rows1[i].D.col2, rows2[i].D.col2, rows3[i].D.col2);
+
+		// see ArticulationFnsSimd::propagateVelocity
+		const SpatialVectorV4& v = ZdV[parent[i]];
+		const Vec3V4 wLinear = sub(v.linear, cross(parentOffset, v.angular));
+		const Vec3V4& wAngular = v.angular;
+
+		const Vec3V4 DSZ = multiply(D0, D1, D2, SZ[i]);
+		const Vec3V4 n = { V4Add(V4Add(dot(DSI0.linear, wLinear), dot(DSI0.angular, wAngular)), DSZ.x),
+						   V4Add(V4Add(dot(DSI1.linear, wLinear), dot(DSI1.angular, wAngular)), DSZ.y),
+						   V4Add(V4Add(dot(DSI2.linear, wLinear), dot(DSI2.angular, wAngular)), DSZ.z) };
+
+		SpatialVectorV4& dV = ZdV[i];
+		dV.linear = sub(wLinear, cross(jointOffset, n));
+		dV.angular = sub(wAngular, n);
+	}
+
+	for(PxU32 i=0;i<linkCount;i++)
+	{
+		Cm::SpatialVectorV dV[4];
+		store4(ZdV[i].linear, dV[0].linear, dV[1].linear, dV[2].linear, dV[3].linear);
+		store4(ZdV[i].angular, dV[0].angular, dV[1].angular, dV[2].angular, dV[3].angular);
+
+		V[0][i] += dV[0];
+		V[1][i] += dV[1];
+		V[2][i] += dV[2];
+		V[3][i] += dV[3];
+	}
+}
 }
 }
@@ -131,6 +131,24 @@ struct FsRowAux
 	Cm::SpatialVectorV		S[3];				// motion subspace
 }PX_ALIGN_SUFFIX(16);
 
+// link state the LTB factorization was last computed for
+PX_ALIGN_PREFIX(16)
+struct LtbCacheEntry
+{
+	PxTransform			pose;				// 28 bytes
+	PxVec3				jointAnchor;		// 40 bytes world-space position of the inbound joint on the child
+	PxVec3				inverseInertia;		// 52 bytes
+	PxReal				inverseMass;		// 56 bytes
+	PxU32				pad[2];				// 64 bytes
+}PX_ALIGN_SUFFIX(16);
+
+PX_COMPILE_TIME_ASSERT(sizeof(LtbCacheEntry)==64);
+
+// The LTB factorization is reused while no link moved further than this fraction of the separation tolerance
+// from, or rotated by more than about half a degree away from, the pose it was factored for.
+static const PxReal DY_ARTICULATION_LTB_REUSE_POSITION_TOLERANCE = 0.01f;
+static const PxReal DY_ARTICULATION_LTB_REUSE_ROTATION_TOLERANCE = 0.99999f;	// cosine of half the rotation angle
+
 
 struct FsData
 {
@@ -279,6 +297,11 @@ PX_FORCE_INLINE const FsRowAux* getAux(const FsData& matrix)
 	return addAddr<const FsRowAux*>(getRefVelocity(matrix),sizeof(Cm::SpatialVectorV)*matrix.linkCount);
 }
 
+PX_FORCE_INLINE LtbCacheEntry* getLtbCache(FsData& matrix)
+{
+	return addAddr<LtbCacheEntry*>(getAux(matrix),sizeof(FsRowAux)*matrix.linkCount);
+}
+
 void PxcFsApplyImpulse(FsData& matrix,
 					   PxU32 linkID,
 					   Vec3V linear,
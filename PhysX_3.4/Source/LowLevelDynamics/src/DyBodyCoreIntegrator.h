@@ -45,6 +45,25 @@ namespace physx
 namespace Dy
 {
 
+// Integration and sleepCheck() read and write fields spread over the whole 160 byte body core (pose and velocities at the
+// start, wake counter and sleep settings at the end), plus mLastTransform in the rigid body. Depending on its alignment
+// the core straddles three or four cache lines.
+PX_FORCE_INLINE void prefetchBodyForIntegration(const PxsRigidBody* body, const PxsBodyCore* core)
+{
+	Ps::prefetchLine(body);
+	Ps::prefetchLine(core);
+	Ps::prefetchLine(core, 64);
+	Ps::prefetchLine(core, 128);
+	Ps::prefetchLine(core, sizeof(PxsBodyCore) - 1);
+}
+
+PX_FORCE_INLINE void prefetchSolverBodyData(const PxSolverBodyData* data)
+{
+	Ps::prefetchLine(data);
+	Ps::prefetchLine(data, 64);
+	Ps::prefetchLine(data, sizeof(PxSolverBodyData) - 1);
+}
+
 PX_FORCE_INLINE void bodyCoreComputeUnconstrainedVelocity
 (const PxVec3& gravity, const PxReal dt, const PxReal linearDamping, const PxReal angularDamping, const PxReal accelScale, 
 const PxReal maxLinearVelocitySq, const PxReal maxAngularVelocitySq, PxVec3& inOutLinearVelocity, PxVec3& inOutAngularVelocity,
@@ -27,6 +27,9 @@
 
 #include "DyConstraintPartition.h"
 #include "DyArticulationUtils.h"
+#include "DyConstraint.h"
+#include "DySolverConstraintTypes.h"
+#include "PxsContactManager.h"
 
 #define INTERLEAVE_SELF_CONSTRAINTS 1
 
@@ -69,6 +72,32 @@ PxU32 getBit(const PxU32 index)
 	return bitTable[index];
 }
 
+#define PARTITION_UNASSIGNED 0xffffffff
+
+//Incremental partitioning stores the partition of each constraint between two rigid bodies on the object owning it. Before
+//prep, the constraint pointer of a descriptor refers to the contact manager or joint and its length holds the type.
+PX_FORCE_INLINE PxU32 getPartitionHint(const PxSolverConstraintDesc& desc)
+{
+	if(desc.linkIndexA != PxSolverConstraintDesc::NO_LINK || desc.linkIndexB != PxSolverConstraintDesc::NO_LINK)
+		return PX_MAX_U16;
+	if(desc.constraintLengthOver16 == DY_SC_TYPE_RB_CONTACT)
+		return reinterpret_cast<const PxsContactManager*>(desc.constraint)->getPartitionHint();
+	if(desc.constraintLengthOver16 == DY_SC_TYPE_RB_1D)
+		return reinterpret_cast<const Constraint*>(desc.constraint)->partitionHint;
+	return PX_MAX_U16;
+}
+
+PX_FORCE_INLINE void setPartitionHint(const PxSolverConstraintDesc& desc, const PxU32 partition)
+{
+	if(desc.linkIndexA != PxSolverConstraintDesc::NO_LINK || desc.linkIndexB != PxSolverConstraintDesc::NO_LINK)
+		return;
+	const PxU16 hint = Ps::to16(PxMin(partition, PxU32(PX_MAX_U16)));
+	if(desc.constraintLengthOver16 == DY_SC_TYPE_RB_CONTACT)
+		reinterpret_cast<PxsContactManager*>(desc.constraint)->setPartitionHint(hint);
+	else if(desc.constraintLengthOver16 == DY_SC_TYPE_RB_1D)
+		reinterpret_cast<Constraint*>(desc.constraint)->partitionHint = hint;
+}
+
 
 class RigidBodyClassification
 {
@@ -204,21 +233,69 @@ public:
 
 };
 
+//If partitionAssignments is not NULL, dynamic constraints are first put back into the partition they were in last frame if
+//it is still free for both bodies, and the partition chosen for each constraint is recorded for writeConstraintDesc.
+//Returns true if there were such constraints and all of them could be put back, i.e. the partitioning is unchanged apart from
+//removed constraints.
 template <typename Classification>
-void classifyConstraintDesc(const PxSolverConstraintDesc* PX_RESTRICT descs, const PxU32 numConstraints, Classification& classification, 
-							Ps::Array<PxU32>& numConstraintsPerPartition, PxSolverConstraintDesc* PX_RESTRICT eaTempConstraintDescriptors)
+bool classifyConstraintDesc(const PxSolverConstraintDesc* PX_RESTRICT descs, const PxU32 numConstraints, Classification& classification, 
+							Ps::Array<PxU32>& numConstraintsPerPartition, PxSolverConstraintDesc* PX_RESTRICT eaTempConstraintDescriptors,
+							PxU32* PX_RESTRICT partitionAssignments)
 {
 	const PxSolverConstraintDesc* _desc = descs;
 	const PxU32 numConstraintsMin1 = numConstraints - 1;
 
 	PxU32 numUnpartitionedConstraints = 0;
+	PxU32 numKeptConstraints = 0;
+	PxU32 numRepartitionedConstraints = 0;
 
 	numConstraintsPerPartition.forceSize_Unsafe(32);
 
 	PxMemZero(numConstraintsPerPartition.begin(), sizeof(PxU32) * 32);
 
+	if(partitionAssignments)
+	{
+		for(PxU32 i = 0; i < numConstraints; ++i, _desc++)
+		{
+			const PxU32 prefetchOffset = PxMin(numConstraintsMin1 - i, 4u);
+			Ps::prefetchLine(_desc[prefetchOffset].constraint);
+			Ps::prefetchLine(_desc[prefetchOffset].bodyA);
+			Ps::prefetchLine(_desc[prefetchOffset].bodyB);
+			Ps::prefetchLine(_desc + 8);
+
+			partitionAssignments[i] = PARTITION_UNASSIGNED;
+
+			uintptr_t indexA, indexB;
+			bool activeA, activeB;
+			if(!classification.classifyConstraint(*_desc, indexA, indexB, activeA, activeB))
+				continue;
+
+			const PxU32 hint = getPartitionHint(*_desc);
+			if(hint >= MAX_NUM_PARTITIONS)
+				continue;
+
+			const PxU32 partitionBit = getBit(hint);
+			const PxU32 partitionsA = _desc->bodyA->solverProgress;
+			const PxU32 partitionsB = _desc->bodyB->solverProgress;
+			if((partitionsA | partitionsB) & partitionBit)
+				continue;
+
+			_desc->bodyA->solverProgress = partitionsA | partitionBit;
+			_desc->bodyB->solverProgress = partitionsB | partitionBit;
+			numConstraintsPerPartition[hint]++;
+			partitionAssignments[i] = hint;
+			numKeptConstraints++;
+			_desc->bodyA->maxSolverNormalProgress = PxMax(_desc->bodyA->maxSolverNormalProgress, PxU16(hint + 1));
+			_desc->bodyB->maxSolverNormalProgress = PxMax(_desc->bodyB->maxSolverNormalProgress, PxU16(hint + 1));
+		}
+		_desc = descs;
+	}
+
 	for(PxU32 i = 0; i < numConstraints; ++i, _desc++)
 	{
+		if(partitionAssignments && partitionAssignments[i] != PARTITION_UNASSIGNED)
+			continue;
+
 		const PxU32 prefetchOffset = PxMin(numConstraintsMin1 - i, 4u);
 		Ps::prefetchLine(_desc[prefetchOffset].constraint);
 		Ps::prefetchLine(_desc[prefetchOffset].bodyA);
@@ -232,6 +309,8 @@ void classifyConstraintDesc(const PxSolverConstraintDesc* PX_RESTRICT descs, con
 		
 		if(notContainsStatic)
 		{
+			numRepartitionedConstraints++;
+
 			PxU32 partitionsA=_desc->bodyA->solverProgress;
 			PxU32 partitionsB=_desc->bodyB->solverProgress;
 			
@@ -253,6 +332,8 @@ void classifyConstraintDesc(const PxSolverConstraintDesc* PX_RESTRICT descs, con
 			_desc->bodyA->solverProgress = partitionsA;
 			_desc->bodyB->solverProgress = partitionsB;
 			numConstraintsPerPartition[availablePartition]++;
+			if(partitionAssignments)
+				partitionAssignments[i] = availablePartition;
 			availablePartition++;
 			_desc->bodyA->maxSolverNormalProgress = PxMax(_desc->bodyA->maxSolverNormalProgress, PxU16(availablePartition));
 			_desc->bodyB->maxSolverNormalProgress = PxMax(_desc->bodyB->maxSolverNormalProgress, PxU16(availablePartition));
@@ -319,12 +400,14 @@ void classifyConstraintDesc(const PxSolverConstraintDesc* PX_RESTRICT descs, con
 
 	classification.reserveSpaceForStaticConstraints(numConstraintsPerPartition);
 
+	return numKeptConstraints != 0 && numRepartitionedConstraints == 0;
 }
 
+//If partitionAssignments is not NULL, it holds the partitions chosen by classifyConstraintDesc for the dynamic constraints.
 template <typename Classification>
 void writeConstraintDesc(const PxSolverConstraintDesc* PX_RESTRICT descs, const PxU32 numConstraints, Classification& classification,
 						 Ps::Array<PxU32>& accumulatedConstraintsPerPartition, PxSolverConstraintDesc* eaTempConstraintDescriptors,
-							PxSolverConstraintDesc* PX_RESTRICT eaOrderedConstraintDesc)
+							PxSolverConstraintDesc* PX_RESTRICT eaOrderedConstraintDesc, const PxU32* PX_RESTRICT partitionAssignments)
 {
 	PX_UNUSED(eaTempConstraintDescriptors);
 	const PxSolverConstraintDesc* _desc = descs;
@@ -344,7 +427,16 @@ void writeConstraintDesc(const PxSolverConstraintDesc* PX_RESTRICT descs, const
 		bool activeA, activeB;
 		const bool notContainsStatic = classification.classifyConstraint(*_desc, indexA, indexB, activeA, activeB);
 
-		if(notContainsStatic)
+		if(notContainsStatic && partitionAssignments)
+		{
+			//Constraints that did not fit in the first 32 partitions are unassigned and partitioned again below in the same order
+			const PxU32 partition = partitionAssignments[i];
+			if(partition == PARTITION_UNASSIGNED)
+				eaTempConstraintDescriptors[numUnpartitionedConstraints++] = *_desc;
+			else
+				eaOrderedConstraintDesc[accumulatedConstraintsPerPartition[partition]++] = *_desc;
+		}
+		else if(notContainsStatic)
 		{
 			PxU32 partitionsA=_desc->bodyA->solverProgress;
 			PxU32 partitionsB=_desc->bodyB->solverProgress;
@@ -426,6 +518,139 @@ void writeConstraintDesc(const PxSolverConstraintDesc* PX_RESTRICT descs, const
 	}
 }
 
+//Puts a constraint between two dynamic bodies back into its partition from the last frame if that partition is still free for
+//both bodies. Returns the partition or PARTITION_UNASSIGNED.
+PX_FORCE_INLINE PxU32 assignHintPartition(const PxSolverConstraintDesc& desc, PxU32* PX_RESTRICT numConstraintsPerPartition)
+{
+	const PxU32 hint = getPartitionHint(desc);
+	if(hint >= MAX_NUM_PARTITIONS)
+		return PARTITION_UNASSIGNED;
+
+	const PxU32 partitionBit = getBit(hint);
+	const PxU32 partitionsA = desc.bodyA->solverProgress;
+	const PxU32 partitionsB = desc.bodyB->solverProgress;
+	if((partitionsA | partitionsB) & partitionBit)
+		return PARTITION_UNASSIGNED;
+
+	desc.bodyA->solverProgress = partitionsA | partitionBit;
+	desc.bodyB->solverProgress = partitionsB | partitionBit;
+	numConstraintsPerPartition[hint]++;
+	desc.bodyA->maxSolverNormalProgress = PxMax(desc.bodyA->maxSolverNormalProgress, PxU16(hint + 1));
+	desc.bodyB->maxSolverNormalProgress = PxMax(desc.bodyB->maxSolverNormalProgress, PxU16(hint + 1));
+	return hint;
+}
+
+//Puts a constraint between two dynamic bodies into the first of the 32 partitions starting at partitionStartIndex that is free for
+//both bodies. Returns the partition or PARTITION_UNASSIGNED if they are all taken.
+PX_FORCE_INLINE PxU32 assignFreePartition(const PxSolverConstraintDesc& desc, const PxU32 partitionStartIndex, PxU32* PX_RESTRICT numConstraintsPerPartition)
+{
+	const PxU32 partitionsA = desc.bodyA->solverProgress;
+	const PxU32 partitionsB = desc.bodyB->solverProgress;
+	const PxU32 combinedMask = (~partitionsA & ~partitionsB);
+	if(combinedMask == 0)
+		return PARTITION_UNASSIGNED;
+
+	const PxU32 availablePartition = Ps::lowestSetBit(combinedMask);
+	const PxU32 partitionBit = getBit(availablePartition);
+	desc.bodyA->solverProgress = partitionsA | partitionBit;
+	desc.bodyB->solverProgress = partitionsB | partitionBit;
+
+	const PxU32 partition = partitionStartIndex + availablePartition;
+	numConstraintsPerPartition[partition]++;
+	desc.bodyA->maxSolverNormalProgress = PxMax(desc.bodyA->maxSolverNormalProgress, PxU16(partition + 1));
+	desc.bodyB->maxSolverNormalProgress = PxMax(desc.bodyB->maxSolverNormalProgress, PxU16(partition + 1));
+	return partition;
+}
+
+//Partitions the constraints of a list of constraint indices that have not been assigned a partition yet. Returns the number of
+//constraints left unassigned.
+PX_FORCE_INLINE PxU32 assignFreePartitions(const PxSolverConstraintDesc* PX_RESTRICT descs, const PxU32* PX_RESTRICT indices, const PxU32 numIndices,
+	const PxU32 partitionStartIndex, PxU32* PX_RESTRICT numConstraintsPerPartition, PxU32* PX_RESTRICT partitions)
+{
+	PxU32 numUnassigned = 0;
+	for(PxU32 a = 0; a < numIndices; ++a)
+	{
+		const PxU32 index = indices[a];
+		if(partitions[index] != PARTITION_UNASSIGNED)
+			continue;
+
+		partitions[index] = assignFreePartition(descs[index], partitionStartIndex, numConstraintsPerPartition);
+		if(partitions[index] == PARTITION_UNASSIGNED)
+			numUnassigned++;
+	}
+	return numUnassigned;
+}
+
+//Returns the sub-range owning a body of an island split into numSubRanges ranges of bodies
+PX_FORCE_INLINE PxU32 getBodySubRange(const uintptr_t bodyIndex, const PxU32 numBodies, const PxU32 numSubRanges)
+{
+	return PxU32((PxU64(bodyIndex) * numSubRanges) / numBodies);
+}
+
+//Returns the sub-range owning a constraint, or numSubRanges if its bodies belong to different sub-ranges
+PX_FORCE_INLINE PxU32 getConstraintSubRange(const PxSolverConstraintDesc& desc, const RigidBodyClassification& classification, const PxU32 numBodies,
+	const PxU32 numSubRanges)
+{
+	uintptr_t indexA, indexB;
+	bool activeA, activeB;
+	classification.classifyConstraint(desc, indexA, indexB, activeA, activeB);
+
+	if(activeA && activeB)
+	{
+		const PxU32 subRangeA = getBodySubRange(indexA, numBodies, numSubRanges);
+		const PxU32 subRangeB = getBodySubRange(indexB, numBodies, numSubRanges);
+		return subRangeA == subRangeB ? subRangeA : numSubRanges;
+	}
+	if(activeA)
+		return getBodySubRange(indexA, numBodies, numSubRanges);
+	if(activeB)
+		return getBodySubRange(indexB, numBodies, numSubRanges);
+	return 0;
+}
+
+}
+
+//Removes empty partitions from the accumulated partition sizes and returns the number of partitions left
+static PxU32 compactPartitions(Ps::Array<PxU32>& accumulatedConstraintsPerPartition, const PxU32 numPartitions)
+{
+	PxU32 partitionCount = 0;
+	PxU32 lastPartitionCount = 0;
+	for (PxU32 a = 0; a < numPartitions; ++a)
+	{
+		const PxU32 constraintCount = accumulatedConstraintsPerPartition[a];
+		accumulatedConstraintsPerPartition[partitionCount] = constraintCount;
+		if (constraintCount != lastPartitionCount)
+		{
+			lastPartitionCount = constraintCount;
+			partitionCount++;
+		}
+	}
+
+	accumulatedConstraintsPerPartition.forceSize_Unsafe(partitionCount);
+
+	return partitionCount;
+}
+
+//Records the final partition of each dynamic constraint for the next frame's incremental partitioning
+template<typename Classification>
+void storePartitionHints(const Ps::Array<PxU32>& accumulatedConstraintsPerPartition, const PxSolverConstraintDesc* PX_RESTRICT eaOrderedConstraintDescriptors,
+	const Classification& classification)
+{
+	PxU32 startIndex = 0;
+	for(PxU32 a = 0; a < accumulatedConstraintsPerPartition.size(); ++a)
+	{
+		const PxU32 endIndex = accumulatedConstraintsPerPartition[a];
+		for(PxU32 b = startIndex; b < endIndex; ++b)
+		{
+			const PxSolverConstraintDesc& desc = eaOrderedConstraintDescriptors[b];
+
+			uintptr_t indexA, indexB;
+			bool activeA, activeB;
+			if(classification.classifyConstraint(desc, indexA, indexB, activeA, activeB))
+				setPartitionHint(desc, a);
+		}
+		startIndex = endIndex;
+	}
 }
 
 #define PX_NORMALIZE_PARTITIONS 1
@@ -533,23 +758,8 @@ PxU32 normalizePartitions(Ps::Array<PxU32>& accumulatedConstraintsPerPartition,
 			}
 		}
 	}
-		
-	PxU32 partitionCount = 0;
-	PxU32 lastPartitionCount = 0;
-	for (PxU32 a = 0; a < numPartitions; ++a)
-	{
-		const PxU32 constraintCount = accumulatedConstraintsPerPartition[a];
-		accumulatedConstraintsPerPartition[partitionCount] = constraintCount;
-		if (constraintCount != lastPartitionCount)
-		{
-			lastPartitionCount = constraintCount;
-			partitionCount++;
-		}
-	}
 
-	accumulatedConstraintsPerPartition.forceSize_Unsafe(partitionCount);
-
-	return partitionCount;
+	return compactPartitions(accumulatedConstraintsPerPartition, numPartitions);
 }
 
 #endif
@@ -587,11 +797,19 @@ PxU32 partitionContactConstraints(ConstraintPartitionArgs& args)
 
 	PxU32 numSelfConstraintBlocks=0;
 
+	PxU32* partitionAssignments = NULL;
+	if(args.mPartitionAssignments)
+	{
+		args.mPartitionAssignments->reserve(numConstraintDescriptors);
+		args.mPartitionAssignments->forceSize_Unsafe(numConstraintDescriptors);
+		partitionAssignments = args.mPartitionAssignments->begin();
+	}
+
 	if(numArticulations == 0)
 	{
 		RigidBodyClassification classification(eaAtoms, numBodies);
-		classifyConstraintDesc(eaConstraintDescriptors, numConstraintDescriptors, classification, constraintsPerPartition,
-			eaTempConstraintDescriptors);
+		const bool partitionsUnchanged = classifyConstraintDesc(eaConstraintDescriptors, numConstraintDescriptors, classification,
+			constraintsPerPartition, eaTempConstraintDescriptors, partitionAssignments);
 		
 		PxU32 accumulation = 0;
 		for(PxU32 a = 0; a < constraintsPerPartition.size(); ++a)
@@ -613,14 +831,22 @@ PxU32 partitionContactConstraints(ConstraintPartitionArgs& args)
 		}
 
 		writeConstraintDesc(eaConstraintDescriptors, numConstraintDescriptors, classification, constraintsPerPartition, 
-			eaTempConstraintDescriptors, eaOrderedConstraintDescriptors);
+			eaTempConstraintDescriptors, eaOrderedConstraintDescriptors, partitionAssignments);
 
 		numOrderedConstraints = numConstraintDescriptors;
 
-		if(!args.enhancedDeterminism)
+		//Constraints put back into last frame's partitions can leave partitions empty. If none had to be placed again, the
+		//partitions are still balanced from the last frame.
+		if(partitionAssignments)
+			maxPartition = compactPartitions(constraintsPerPartition, constraintsPerPartition.size());
+
+		if(!args.enhancedDeterminism && !partitionsUnchanged)
 			maxPartition = normalizePartitions(constraintsPerPartition, eaOrderedConstraintDescriptors, numConstraintDescriptors, *args.mBitField,
 				classification, numBodies, 0);
 
+		if(partitionAssignments)
+			storePartitionHints(constraintsPerPartition, eaOrderedConstraintDescriptors, classification);
+
 	}
 	else
 	{
@@ -638,8 +864,8 @@ PxU32 partitionContactConstraints(ConstraintPartitionArgs& args)
 		}
 		ExtendedRigidBodyClassification classification(eaAtoms, numBodies, eaFsDatas, numArticulations);
 
-		classifyConstraintDesc(eaConstraintDescriptors, numConstraintDescriptors, classification, 
-			constraintsPerPartition, eaTempConstraintDescriptors);
+		const bool partitionsUnchanged = classifyConstraintDesc(eaConstraintDescriptors, numConstraintDescriptors, classification, 
+			constraintsPerPartition, eaTempConstraintDescriptors, partitionAssignments);
 
 		PxU32 accumulation = 0;
 		for(PxU32 a = 0; a < constraintsPerPartition.size(); ++a)
@@ -668,14 +894,22 @@ PxU32 partitionContactConstraints(ConstraintPartitionArgs& args)
 		}
 
 		writeConstraintDesc(eaConstraintDescriptors, numConstraintDescriptors, classification, constraintsPerPartition, 
-			eaTempConstraintDescriptors, eaOrderedConstraintDescriptors);
+			eaTempConstraintDescriptors, eaOrderedConstraintDescriptors, partitionAssignments);
 
 		numOrderedConstraints = numConstraintDescriptors;
 
-		if (!args.enhancedDeterminism)
+		//Constraints put back into last frame's partitions can leave partitions empty. If none had to be placed again, the
+		//partitions are still balanced from the last frame.
+		if(partitionAssignments)
+			maxPartition = compactPartitions(constraintsPerPartition, constraintsPerPartition.size());
+
+		if (!args.enhancedDeterminism && !partitionsUnchanged)
 			maxPartition = normalizePartitions(constraintsPerPartition, eaOrderedConstraintDescriptors,  
 				numConstraintDescriptors, *args.mBitField, classification, numBodies, numArticulations);
 
+		if(partitionAssignments)
+			storePartitionHints(constraintsPerPartition, eaOrderedConstraintDescriptors, classification);
+
 	}
 
 
@@ -707,6 +941,360 @@ PxU32 partitionContactConstraints(ConstraintPartitionArgs& args)
 	return maxPartition;
 }
 
+//Large islands are partitioned in sub-ranges of their bodies. The constraints whose bodies all belong to one sub-range are
+//partitioned and written by that sub-range, which only touches its own solver bodies, so that all sub-ranges can be processed at
+//the same time and still share one set of partitions. The constraints between bodies of different sub-ranges and the ones that
+//did not fit in the first 32 partitions are partitioned on top of that by the merge. Finally, the partitions are normalized as in
+//partitionContactConstraints.
+
+PxU32 getNumPartitionSubRanges(const ConstraintPartitionArgs& args)
+{
+	//Islands with articulations and islands simulated with enhanced determinism are always partitioned serially
+	if(args.enhancedDeterminism || args.mNumArticulationPtrs != 0 || args.mNumBodies < 2)
+		return 1;
+
+	//The number of sub-ranges only depends on the island so that the partitions do not depend on the number of worker threads
+	return PxClamp(args.mNumContactConstraintDescriptors / PxU32(ConstraintPartitionArgs::eMIN_CONSTRAINTS_PER_SUB_RANGE), 1u,
+		PxU32(ConstraintPartitionArgs::eMAX_NUM_SUB_RANGES));
+}
+
+void beginPartitionSubRanges(ConstraintPartitionArgs& args, const PxU32 numSubRanges)
+{
+	PX_ASSERT(numSubRanges > 1 && numSubRanges <= ConstraintPartitionArgs::eMAX_NUM_SUB_RANGES);
+
+	const PxU32 numBodies = args.mNumBodies;
+	const PxU32 numConstraintDescriptors = args.mNumContactConstraintDescriptors;
+	const PxSolverConstraintDesc* PX_RESTRICT eaConstraintDescriptors = args.mContactConstraintDescriptors;
+	ConstraintPartitionSubRange* PX_RESTRICT subRanges = args.mSubRanges;
+	RigidBodyClassification classification(args.mBodies, numBodies);
+
+	args.mNumSubRanges = numSubRanges;
+
+	//The first half holds the constraints of each sub-range, the second half the constraints each sub-range leaves to the merge
+	Ps::Array<PxU32>& constraintIndices = *args.mSubRangeConstraintIndices;
+	constraintIndices.reserve(numConstraintDescriptors * 2);
+	constraintIndices.forceSize_Unsafe(numConstraintDescriptors * 2);
+	args.mSubRangeConstraintPartitions->reserve(numConstraintDescriptors);
+	args.mSubRangeConstraintPartitions->forceSize_Unsafe(numConstraintDescriptors);
+
+	for(PxU32 a = 0; a <= numSubRanges; ++a)
+	{
+		ConstraintPartitionSubRange& subRange = subRanges[a];
+		subRange.mBodyStartIndex = PxU32((PxU64(a) * numBodies + numSubRanges - 1) / numSubRanges);
+		subRange.mBodyEndIndex = PxU32((PxU64(a + 1) * numBodies + numSubRanges - 1) / numSubRanges);
+		subRange.mStartIndex = 0;
+		subRange.mNumConstraints = 0;
+		subRange.mNumDeferredConstraints = 0;
+		subRange.mNumKeptConstraints = 0;
+		subRange.mNumRepartitionedConstraints = 0;
+	}
+	//The last sub-range only holds shared constraints
+	subRanges[numSubRanges].mBodyStartIndex = subRanges[numSubRanges].mBodyEndIndex = numBodies;
+
+	//Sort the constraints by sub-range, keeping their order within each sub-range
+	PxU32* PX_RESTRICT constraintSubRanges = constraintIndices.begin() + numConstraintDescriptors;
+	for(PxU32 a = 0; a < numConstraintDescriptors; ++a)
+	{
+		const PxU32 subRange = getConstraintSubRange(eaConstraintDescriptors[a], classification, numBodies, numSubRanges);
+		constraintSubRanges[a] = subRange;
+		subRanges[subRange].mNumConstraints++;
+	}
+
+	PxU32 startIndex = 0;
+	for(PxU32 a = 0; a <= numSubRanges; ++a)
+	{
+		subRanges[a].mStartIndex = startIndex;
+		startIndex += subRanges[a].mNumConstraints;
+		subRanges[a].mNumConstraints = 0;
+	}
+
+	for(PxU32 a = 0; a < numConstraintDescriptors; ++a)
+	{
+		ConstraintPartitionSubRange& subRange = subRanges[constraintSubRanges[a]];
+		constraintIndices[subRange.mStartIndex + subRange.mNumConstraints++] = a;
+	}
+}
+
+void classifyPartitionSubRange(ConstraintPartitionArgs& args, const PxU32 subRangeIndex)
+{
+	ConstraintPartitionSubRange& subRange = args.mSubRanges[subRangeIndex];
+	const PxSolverConstraintDesc* PX_RESTRICT eaConstraintDescriptors = args.mContactConstraintDescriptors;
+	PxU32* PX_RESTRICT constraintIndices = args.mSubRangeConstraintIndices->begin() + subRange.mStartIndex;
+	PxU32* PX_RESTRICT deferredConstraintIndices = constraintIndices + args.mNumContactConstraintDescriptors;
+	PxU32* PX_RESTRICT partitions = args.mSubRangeConstraintPartitions->begin();
+	PxU32* PX_RESTRICT numConstraintsPerPartition = subRange.mNumConstraintsPerPartition;
+	const PxU32 numConstraints = subRange.mNumConstraints;
+	RigidBodyClassification classification(args.mBodies, args.mNumBodies);
+
+	for(PxU32 a = subRange.mBodyStartIndex; a < subRange.mBodyEndIndex; ++a)
+	{
+		PxSolverBody& body = args.mBodies[a];
+		body.solverProgress = 0;
+		body.maxSolverFrictionProgress = 0;
+		body.maxSolverNormalProgress = 0;
+	}
+
+	PxMemZero(numConstraintsPerPartition, sizeof(PxU32) * MAX_NUM_PARTITIONS);
+
+	PxU32 numKeptConstraints = 0;
+	if(args.mPartitionAssignments)
+	{
+		for(PxU32 a = 0; a < numConstraints; ++a)
+		{
+			const PxU32 index = constraintIndices[a];
+			const PxSolverConstraintDesc& desc = eaConstraintDescriptors[index];
+			Ps::prefetchLine(eaConstraintDescriptors + constraintIndices[PxMin(a + 4, numConstraints - 1)]);
+
+			uintptr_t indexA, indexB;
+			bool activeA, activeB;
+			partitions[index] = PARTITION_UNASSIGNED;
+			if(classification.classifyConstraint(desc, indexA, indexB, activeA, activeB))
+			{
+				partitions[index] = assignHintPartition(desc, numConstraintsPerPartition);
+				if(partitions[index] != PARTITION_UNASSIGNED)
+					numKeptConstraints++;
+			}
+		}
+	}
+
+	PxU32 numRepartitionedConstraints = 0;
+	PxU32 numDeferredConstraints = 0;
+	for(PxU32 a = 0; a < numConstraints; ++a)
+	{
+		const PxU32 index = constraintIndices[a];
+		if(args.mPartitionAssignments && partitions[index] != PARTITION_UNASSIGNED)
+			continue;
+
+		const PxSolverConstraintDesc& desc = eaConstraintDescriptors[index];
+		const PxSolverConstraintDesc& nextDesc = eaConstraintDescriptors[constraintIndices[PxMin(a + 4, numConstraints - 1)]];
+		Ps::prefetchLine(nextDesc.bodyA);
+		Ps::prefetchLine(nextDesc.bodyB);
+
+		uintptr_t indexA, indexB;
+		bool activeA, activeB;
+		if(classification.classifyConstraint(desc, indexA, indexB, activeA, activeB))
+		{
+			numRepartitionedConstraints++;
+			partitions[index] = assignFreePartition(desc, 0, numConstraintsPerPartition);
+			if(partitions[index] == PARTITION_UNASSIGNED)
+				deferredConstraintIndices[numDeferredConstraints++] = index;
+		}
+		else
+		{
+			//Just count the number of static constraints and store in maxSolverFrictionProgress...
+			if(activeA)
+				desc.bodyA->maxSolverFrictionProgress++;
+			else if(activeB)
+				desc.bodyB->maxSolverFrictionProgress++;
+		}
+	}
+
+	subRange.mNumDeferredConstraints = numDeferredConstraints;
+	subRange.mNumKeptConstraints = numKeptConstraints;
+	subRange.mNumRepartitionedConstraints = numRepartitionedConstraints;
+}
+
+void mergePartitionSubRanges(ConstraintPartitionArgs& args)
+{
+	const PxU32 numSubRanges = args.mNumSubRanges;
+	const PxU32 numBodies = args.mNumBodies;
+	const PxU32 numConstraintDescriptors = args.mNumContactConstraintDescriptors;
+	const PxSolverConstraintDesc* PX_RESTRICT eaConstraintDescriptors = args.mContactConstraintDescriptors;
+	PxSolverConstraintDesc* PX_RESTRICT eaOrderedConstraintDescriptors = args.mOrderedContactConstraintDescriptors;
+	ConstraintPartitionSubRange* PX_RESTRICT subRanges = args.mSubRanges;
+	ConstraintPartitionSubRange& sharedSubRange = subRanges[numSubRanges];
+	const PxU32* PX_RESTRICT constraintIndices = args.mSubRangeConstraintIndices->begin();
+	const PxU32* PX_RESTRICT deferredConstraintIndices = constraintIndices + numConstraintDescriptors;
+	const PxU32* PX_RESTRICT sharedConstraintIndices = constraintIndices + sharedSubRange.mStartIndex;
+	const PxU32 numSharedConstraints = sharedSubRange.mNumConstraints;
+	PxU32* PX_RESTRICT partitions = args.mSubRangeConstraintPartitions->begin();
+	Ps::Array<PxU32>& constraintsPerPartition = *args.mConstraintsPerPartition;
+	RigidBodyClassification classification(args.mBodies, numBodies);
+
+	//The shared constraints are partitioned on top of the partitions of the sub-ranges and counted in constraintsPerPartition
+	constraintsPerPartition.forceSize_Unsafe(MAX_NUM_PARTITIONS);
+	PxMemZero(constraintsPerPartition.begin(), sizeof(PxU32) * MAX_NUM_PARTITIONS);
+
+	PxU32 numKeptConstraints = 0;
+	for(PxU32 a = 0; a < numSharedConstraints; ++a)
+	{
+		const PxU32 index = sharedConstraintIndices[a];
+		partitions[index] = args.mPartitionAssignments ? assignHintPartition(eaConstraintDescriptors[index], constraintsPerPartition.begin()) : PARTITION_UNASSIGNED;
+		if(partitions[index] != PARTITION_UNASSIGNED)
+			numKeptConstraints++;
+	}
+	sharedSubRange.mNumKeptConstraints = numKeptConstraints;
+	sharedSubRange.mNumRepartitionedConstraints = numSharedConstraints - numKeptConstraints;
+
+	PxU32 partitionStartIndex = 0;
+	PxU32 numUnpartitionedConstraints = assignFreePartitions(eaConstraintDescriptors, sharedConstraintIndices, numSharedConstraints, partitionStartIndex,
+		constraintsPerPartition.begin(), partitions);
+	for(PxU32 a = 0; a < numSubRanges; ++a)
+	{
+		numUnpartitionedConstraints += assignFreePartitions(eaConstraintDescriptors, deferredConstraintIndices + subRanges[a].mStartIndex, 
+			subRanges[a].mNumDeferredConstraints, partitionStartIndex, constraintsPerPartition.begin(), partitions);
+	}
+
+	while(numUnpartitionedConstraints > 0)
+	{
+		classification.clearState();
+
+		partitionStartIndex += 32;
+		//Keep partitioning the un-partitioned constraints and blat the whole thing to 0!
+		constraintsPerPartition.resize(32 + constraintsPerPartition.size());
+		PxMemZero(constraintsPerPartition.begin() + partitionStartIndex, sizeof(PxU32) * 32);
+
+		numUnpartitionedConstraints = assignFreePartitions(eaConstraintDescriptors, sharedConstraintIndices, numSharedConstraints, partitionStartIndex,
+			constraintsPerPartition.begin(), partitions);
+		for(PxU32 a = 0; a < numSubRanges; ++a)
+		{
+			numUnpartitionedConstraints += assignFreePartitions(eaConstraintDescriptors, deferredConstraintIndices + subRanges[a].mStartIndex, 
+				subRanges[a].mNumDeferredConstraints, partitionStartIndex, constraintsPerPartition.begin(), partitions);
+		}
+	}
+
+	//The static constraints of a body go into the partitions after its last dynamic constraint
+	PxU32 numPartitions = constraintsPerPartition.size();
+	for(PxU32 a = 0; a < numBodies; ++a)
+		numPartitions = PxMax(numPartitions, PxU32(args.mBodies[a].maxSolverNormalProgress + args.mBodies[a].maxSolverFrictionProgress));
+
+	//Each partition gets a range of constraints for every sub-range, followed by a range for the shared constraints, which are
+	//counted in the last row.
+	Ps::Array<PxU32>& partitionOffsets = *args.mSubRangePartitionOffsets;
+	partitionOffsets.reserve((numSubRanges + 1) * numPartitions);
+	partitionOffsets.forceSize_Unsafe((numSubRanges + 1) * numPartitions);
+	PxMemZero(partitionOffsets.begin(), sizeof(PxU32) * partitionOffsets.size());
+
+	for(PxU32 a = 0; a < numSubRanges; ++a)
+	{
+		PxU32* PX_RESTRICT offsets = partitionOffsets.begin() + a * numPartitions;
+		PxMemCopy(offsets, subRanges[a].mNumConstraintsPerPartition, sizeof(PxU32) * MAX_NUM_PARTITIONS);
+
+		for(PxU32 b = subRanges[a].mBodyStartIndex; b < subRanges[a].mBodyEndIndex; ++b)
+		{
+			PxSolverBody& body = args.mBodies[b];
+			for(PxU32 c = 0; c < body.maxSolverFrictionProgress; ++c)
+				offsets[body.maxSolverNormalProgress + c]++;
+			//Bump the static constraint count back to 0 to place the static constraints when writing them
+			body.maxSolverFrictionProgress = 0;
+		}
+	}
+	PxMemCopy(partitionOffsets.begin() + numSubRanges * numPartitions, constraintsPerPartition.begin(), sizeof(PxU32) * constraintsPerPartition.size());
+
+	constraintsPerPartition.reserve(numPartitions);
+	constraintsPerPartition.forceSize_Unsafe(numPartitions);
+
+	PxU32 accumulation = 0;
+	for(PxU32 a = 0; a < numPartitions; ++a)
+	{
+		for(PxU32 b = 0; b <= numSubRanges; ++b)
+		{
+			const PxU32 count = partitionOffsets[b * numPartitions + a];
+			partitionOffsets[b * numPartitions + a] = accumulation;
+			accumulation += count;
+		}
+		constraintsPerPartition[a] = accumulation;
+	}
+	PX_ASSERT(accumulation == numConstraintDescriptors);
+
+	args.mNumSubRangePartitions = numPartitions;
+
+	//Write the constraints partitioned by the merge
+	PxU32* PX_RESTRICT sharedOffsets = partitionOffsets.begin() + numSubRanges * numPartitions;
+	for(PxU32 a = 0; a < numSharedConstraints; ++a)
+	{
+		const PxU32 index = sharedConstraintIndices[a];
+		eaOrderedConstraintDescriptors[sharedOffsets[partitions[index]]++] = eaConstraintDescriptors[index];
+	}
+	for(PxU32 a = 0; a < numSubRanges; ++a)
+	{
+		const PxU32* PX_RESTRICT indices = deferredConstraintIndices + subRanges[a].mStartIndex;
+		for(PxU32 b = 0; b < subRanges[a].mNumDeferredConstraints; ++b)
+			eaOrderedConstraintDescriptors[sharedOffsets[partitions[indices[b]]]++] = eaConstraintDescriptors[indices[b]];
+	}
+}
+
+void writePartitionSubRange(ConstraintPartitionArgs& args, const PxU32 subRangeIndex)
+{
+	const ConstraintPartitionSubRange& subRange = args.mSubRanges[subRangeIndex];
+	const PxSolverConstraintDesc* PX_RESTRICT eaConstraintDescriptors = args.mContactConstraintDescriptors;
+	PxSolverConstraintDesc* PX_RESTRICT eaOrderedConstraintDescriptors = args.mOrderedContactConstraintDescriptors;
+	const PxU32* PX_RESTRICT constraintIndices = args.mSubRangeConstraintIndices->begin() + subRange.mStartIndex;
+	const PxU32* PX_RESTRICT deferredConstraintIndices = constraintIndices + args.mNumContactConstraintDescriptors;
+	const PxU32* PX_RESTRICT partitions = args.mSubRangeConstraintPartitions->begin();
+	PxU32* PX_RESTRICT offsets = args.mSubRangePartitionOffsets->begin() + subRangeIndex * args.mNumSubRangePartitions;
+	const PxU32 numConstraints = subRange.mNumConstraints;
+	RigidBodyClassification classification(args.mBodies, args.mNumBodies);
+
+	PxU32 numDeferredConstraints = 0;
+	for(PxU32 a = 0; a < numConstraints; ++a)
+	{
+		const PxU32 index = constraintIndices[a];
+
+		//Deferred constraints were written by the merge. They are in the same order as the sub-range's constraints.
+		if(numDeferredConstraints < subRange.mNumDeferredConstraints && deferredConstraintIndices[numDeferredConstraints] == index)
+		{
+			numDeferredConstraints++;
+			continue;
+		}
+
+		const PxSolverConstraintDesc& desc = eaConstraintDescriptors[index];
+		const PxSolverConstraintDesc& nextDesc = eaConstraintDescriptors[constraintIndices[PxMin(a + 4, numConstraints - 1)]];
+		Ps::prefetchLine(nextDesc.bodyA);
+		Ps::prefetchLine(nextDesc.bodyB);
+
+		uintptr_t indexA, indexB;
+		bool activeA, activeB;
+		if(classification.classifyConstraint(desc, indexA, indexB, activeA, activeB))
+		{
+			eaOrderedConstraintDescriptors[offsets[partitions[index]]++] = desc;
+		}
+		else
+		{
+			PxU32 partition = 0;
+			if(activeA)
+				partition = PxU32(desc.bodyA->maxSolverNormalProgress + desc.bodyA->maxSolverFrictionProgress++);
+			else if(activeB)
+				partition = PxU32(desc.bodyB->maxSolverNormalProgress + desc.bodyB->maxSolverFrictionProgress++);
+
+			eaOrderedConstraintDescriptors[offsets[partition]++] = desc;
+		}
+	}
+}
+
+PxU32 finishPartitionSubRanges(ConstraintPartitionArgs& args)
+{
+	const PxU32 numConstraintDescriptors = args.mNumContactConstraintDescriptors;
+	Ps::Array<PxU32>& constraintsPerPartition = *args.mConstraintsPerPartition;
+	RigidBodyClassification classification(args.mBodies, args.mNumBodies);
+
+	PxU32 numKeptConstraints = 0;
+	PxU32 numRepartitionedConstraints = 0;
+	for(PxU32 a = 0; a <= args.mNumSubRanges; ++a)
+	{
+		numKeptConstraints += args.mSubRanges[a].mNumKeptConstraints;
+		numRepartitionedConstraints += args.mSubRanges[a].mNumRepartitionedConstraints;
+	}
+
+	PxU32 maxPartition = constraintsPerPartition.size();
+
+	if(args.mPartitionAssignments)
+		maxPartition = compactPartitions(constraintsPerPartition, constraintsPerPartition.size());
+
+	if(!args.mPartitionAssignments || numKeptConstraints == 0 || numRepartitionedConstraints != 0)
+		maxPartition = normalizePartitions(constraintsPerPartition, args.mOrderedContactConstraintDescriptors, numConstraintDescriptors, *args.mBitField,
+			classification, args.mNumBodies, 0);
+
+	if(args.mPartitionAssignments)
+		storePartitionHints(constraintsPerPartition, args.mOrderedContactConstraintDescriptors, classification);
+
+	args.mNumSelfConstraintBlocks = 0;
+	args.mNumDifferentBodyConstraints = numConstraintDescriptors;
+	args.mNumSelfConstraints = 0;
+
+	return maxPartition;
+}
+
 }
 
 }
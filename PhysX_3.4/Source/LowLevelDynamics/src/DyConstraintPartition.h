@@ -40,11 +40,27 @@ namespace physx
 
 namespace Dy
 {
+//Constraints owned by one sub-range of an island partitioned in parallel. The sub-range owns a contiguous range of the island's
+//bodies and all constraints that only touch those bodies. The last sub-range holds the constraints shared between sub-ranges.
+struct ConstraintPartitionSubRange
+{
+	PxU32	mBodyStartIndex;
+	PxU32	mBodyEndIndex;
+	PxU32	mStartIndex;					//first index of the sub-range's constraints in mSubRangeConstraintIndices
+	PxU32	mNumConstraints;
+	PxU32	mNumDeferredConstraints;		//constraints that did not fit in the first 32 partitions, partitioned by the merge
+	PxU32	mNumKeptConstraints;			//constraints put back into their partition from the last frame
+	PxU32	mNumRepartitionedConstraints;
+	PxU32	mNumConstraintsPerPartition[32];
+};
+
 struct ConstraintPartitionArgs
 {
 	enum
 	{
-		eMAX_NUM_BODIES = 8192
+		eMAX_NUM_BODIES = 8192,
+		eMIN_CONSTRAINTS_PER_SUB_RANGE = 2048,
+		eMAX_NUM_SUB_RANGES = 8
 	};   
 
 	//Input
@@ -63,12 +79,32 @@ struct ConstraintPartitionArgs
 	Ps::Array<PxU32>*						mConstraintsPerPartition;
 	//Ps::Array<PxU32>*						mStartIndices;
 	Ps::Array<PxU32>*						mBitField;
+	Ps::Array<PxU32>*						mPartitionAssignments;	//scratch for incremental partitioning, NULL to rebuild partitions from scratch
+	//Parallel partitioning of large islands
+	ConstraintPartitionSubRange*			mSubRanges;				//eMAX_NUM_SUB_RANGES + 1 entries
+	PxU32									mNumSubRanges;
+	PxU32									mNumSubRangePartitions;
+	Ps::Array<PxU32>*						mSubRangeConstraintIndices;
+	Ps::Array<PxU32>*						mSubRangeConstraintPartitions;
+	Ps::Array<PxU32>*						mSubRangePartitionOffsets;
 
 	bool									enhancedDeterminism;
 };
 
 PxU32 partitionContactConstraints(ConstraintPartitionArgs& args);
 
+//Partitioning of a large island split into sub-ranges that can be processed in parallel. getNumPartitionSubRanges returns 1 if
+//the island should be partitioned serially with partitionContactConstraints. Otherwise, beginPartitionSubRanges is followed by
+//classifyPartitionSubRange for each sub-range, mergePartitionSubRanges, writePartitionSubRange for each sub-range and
+//finishPartitionSubRanges, which returns the same as partitionContactConstraints. The calls for different sub-ranges can run
+//concurrently.
+PxU32 getNumPartitionSubRanges(const ConstraintPartitionArgs& args);
+void beginPartitionSubRanges(ConstraintPartitionArgs& args, const PxU32 numSubRanges);
+void classifyPartitionSubRange(ConstraintPartitionArgs& args, const PxU32 subRange);
+void mergePartitionSubRanges(ConstraintPartitionArgs& args);
+void writePartitionSubRange(ConstraintPartitionArgs& args, const PxU32 subRange);
+PxU32 finishPartitionSubRanges(ConstraintPartitionArgs& args);
+
 } // namespace physx
 
 }
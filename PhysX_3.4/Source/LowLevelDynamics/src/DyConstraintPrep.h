@@ -54,6 +54,7 @@ struct SolverConstraintShaderPrepDesc
 {
 	const Constraint* constraint;
 	PxConstraintSolverPrep solverPrep;
+	PxConstraintSolverPrep4 solverPrep4;
 	const void* constantBlock;
 	PxU32 constantBlockByteSize;
 };
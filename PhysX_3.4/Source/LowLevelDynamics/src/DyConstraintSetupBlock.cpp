@@ -100,6 +100,59 @@ PxConstraintAllocator& allocator)
 	PxU32 maxRows = 0;
 	PxU32 preppedIndex = 0;
 
+	//Four constraints of the same type can be prepped in a single call to the batched shader. Each gets its own
+	//MAX_CONSTRAINT_ROWS slot in allRows because the row counts are only known once the shader has run.
+	const PxConstraintSolverPrep solverPrep = constraintShaderDescs[0].solverPrep;
+	const PxConstraintSolverPrep4 solverPrep4 = constraintShaderDescs[0].solverPrep4;
+	if (solverPrep && solverPrep4 &&
+		constraintShaderDescs[1].solverPrep == solverPrep &&
+		constraintShaderDescs[2].solverPrep == solverPrep &&
+		constraintShaderDescs[3].solverPrep == solverPrep)
+	{
+		Px1DConstraint* rows[4];
+		PxU32 rowCounts[4];
+		PxVec3 body0WorldOffsets[4];
+		PxConstraintInvMassScale invMassScales[4];
+		const void* constantBlocks[4];
+		PxTransform bodyFrames0[4];
+		PxTransform bodyFrames1[4];
+
+		PxMemZero(allRows, sizeof(allRows));
+		for (PxU32 a = 0; a < 4; ++a)
+		{
+			rows[a] = allRows + a * MAX_CONSTRAINT_ROWS;
+			for (PxU32 b = 0; b < MAX_CONSTRAINT_ROWS; ++b)
+			{
+				rows[a][b].minImpulse = -PX_MAX_REAL;
+				rows[a][b].maxImpulse = PX_MAX_REAL;
+			}
+
+			rowCounts[a] = 0;
+			body0WorldOffsets[a] = PxVec3(0.f);
+			invMassScales[a] = PxConstraintInvMassScale(1.f, 1.f, 1.f, 1.f);
+			constantBlocks[a] = constraintShaderDescs[a].constantBlock;
+			bodyFrames0[a] = constraintDescs[a].bodyFrame0;
+			bodyFrames1[a] = constraintDescs[a].bodyFrame1;
+		}
+
+		(*solverPrep4)(rows, rowCounts, body0WorldOffsets, MAX_CONSTRAINT_ROWS, invMassScales, constantBlocks, bodyFrames0, bodyFrames1);
+
+		for (PxU32 a = 0; a < 4; ++a)
+		{
+			if (rowCounts[a] == 0)
+				return SolverConstraintPrepState::eUNBATCHABLE;
+
+			PxSolverConstraintPrepDesc& desc = constraintDescs[a];
+			desc.mInvMassScales = invMassScales[a];
+			desc.body0WorldOffset = body0WorldOffsets[a];
+			desc.rows = rows[a];
+			desc.numRows = rowCounts[a];
+			maxRows = PxMax(rowCounts[a], maxRows);
+		}
+
+		return setupSolverConstraint4(constraintDescs, dt, recipdt, totalRows, allocator, maxRows);
+	}
+
 	for (PxU32 a = 0; a < 4; ++a)
 	{
 		Px1DConstraint* rows = allRows + numRows;
@@ -32,6 +32,7 @@
 
 #include "GuContactPoint.h"
 #include "PxsMaterialManager.h"
+#include "PsVecMath.h"
 
 namespace physx
 {
@@ -45,6 +46,7 @@ namespace Dy
 #define CONTACT_REDUCTION_MAX_PATCHES 32
 #define PXS_NORMAL_TOLERANCE 0.995f
 #define PXS_SEPARATION_TOLERANCE 0.001f
+#define CONTACT_REDUCTION_MAX_GATHERED_CONTACTS 64
 
 
 	//A patch contains a normal, pair of material indices and a list of indices. These indices are 
@@ -208,48 +210,58 @@ namespace Dy
 					}
 					else
 					{
-						//Iterate through and find the most extreme point
-						
-
-						PxU32 ind = 0;
-
+						//Gather the patch into SoA form so that the extreme point searches below can process 4 contacts at a time.
+						//The gathered order matches the order in which the patch chain is walked, so ties resolve exactly as a
+						//sequential scan would.
+						PX_ASSERT(contactCount <= CONTACT_REDUCTION_MAX_GATHERED_CONTACTS);
+						PX_ALIGN(16, PxReal pointX[CONTACT_REDUCTION_MAX_GATHERED_CONTACTS]);
+						PX_ALIGN(16, PxReal pointY[CONTACT_REDUCTION_MAX_GATHERED_CONTACTS]);
+						PX_ALIGN(16, PxReal pointZ[CONTACT_REDUCTION_MAX_GATHERED_CONTACTS]);
+						PxU32 contactIndices[CONTACT_REDUCTION_MAX_GATHERED_CONTACTS];
 						{
-							PxReal dist = 0.f;
+							PxU32 nbGathered = 0;
 							ContactPatch* tmpPatch = mIntermediatePatchesPtrs[a];
 							while(tmpPatch)
 							{
 								for(PxU32 b = 0; b < tmpPatch->stride; ++b)
 								{
-									PxReal magSq = mOriginalContacts[tmpPatch->startIndex + b].point.magnitudeSquared();
-									if(dist < magSq)
-									{
-										ind = tmpPatch->startIndex + b;
-										dist = magSq;
-									}
+									const PxU32 contactIndex = tmpPatch->startIndex + b;
+									const PxVec3& p = mOriginalContacts[contactIndex].point;
+									contactIndices[nbGathered] = contactIndex;
+									pointX[nbGathered] = p.x;
+									pointY[nbGathered] = p.y;
+									pointZ[nbGathered] = p.z;
+									++nbGathered;
 								}
 								tmpPatch = tmpPatch->mNextPatch;
 							}
-						}	
+							//Pad the last block with copies of the last contact. The copies sit at higher positions than the
+							//original so they can never win a search.
+							for(; nbGathered & 3; ++nbGathered)
+							{
+								contactIndices[nbGathered] = contactIndices[nbGathered-1];
+								pointX[nbGathered] = pointX[nbGathered-1];
+								pointY[nbGathered] = pointY[nbGathered-1];
+								pointZ[nbGathered] = pointZ[nbGathered-1];
+							}
+						}
+						const PxU32 nbBlocks = (contactCount + 3) >> 2;
+
+						//Iterate through and find the most extreme point
+						PxU32 ind = 0;
+						{
+							const PxI32 pos = findFarthestFromPoint(pointX, pointY, pointZ, nbBlocks, PxVec3(0.f));
+							if(pos >= 0)
+								ind = contactIndices[pos];
+						}
 						reducedPatch.contactPoints[0] = ind;
 						const PxVec3 p0 = mOriginalContacts[ind].point;
 
-						//Now find the point farthest from this point...						
+						//Now find the point farthest from this point...
 						{
-							PxReal maxDist = 0.f;
-							ContactPatch* tmpPatch = mIntermediatePatchesPtrs[a];
-							while(tmpPatch)
-							{
-								for(PxU32 b = 0; b < tmpPatch->stride; ++b)
-								{
-									PxReal magSq = (p0 - mOriginalContacts[tmpPatch->startIndex + b].point).magnitudeSquared();
-									if(magSq > maxDist)
-									{
-										ind = tmpPatch->startIndex + b;
-										maxDist = magSq;
-									}
-								}
-								tmpPatch = tmpPatch->mNextPatch;
-							}
+							const PxI32 pos = findFarthestFromPoint(pointX, pointY, pointZ, nbBlocks, p0);
+							if(pos >= 0)
+								ind = contactIndices[pos];
 						}
 						reducedPatch.contactPoints[1] = ind;
 						const PxVec3 p1 = mOriginalContacts[ind].point;
@@ -257,53 +269,18 @@ namespace Dy
 						//Now find the point farthest from the segment
 
 						PxVec3 n = (p0 - p1).cross(mIntermediatePatchesPtrs[a]->rootNormal);
-
-						//PxReal tVal = 0.f;
 						{
-							PxReal maxDist = 0.f;
-							//PxReal tmpTVal;
-							
-							ContactPatch* tmpPatch = mIntermediatePatchesPtrs[a];
-							while(tmpPatch)
-							{
-								for(PxU32 b = 0; b < tmpPatch->stride; ++b)
-								{
-									
-									//PxReal magSq = tmpDistancePointSegmentSquared(p0, p1, mOriginalContacts[tmpPatch->startIndex + b].point, tmpTVal);
-									PxReal magSq = (mOriginalContacts[tmpPatch->startIndex + b].point - p0).dot(n);
-									if(magSq > maxDist)
-									{
-										ind = tmpPatch->startIndex + b;
-										//tVal = tmpTVal;
-										maxDist = magSq;
-									}
-								}
-								tmpPatch = tmpPatch->mNextPatch;
-							}
+							const PxI32 pos = findFarthestAlongDir(pointX, pointY, pointZ, nbBlocks, p0, n);
+							if(pos >= 0)
+								ind = contactIndices[pos];
 						}
 						reducedPatch.contactPoints[2] = ind;
 
-						//const PxVec3 closest = (p0 + (p1 - p0) * tVal);
-
-						const PxVec3 dir = -n;//closest - p3;
-
+						const PxVec3 dir = -n;
 						{
-							PxReal maxDist = 0.f;
-							//PxReal tVal = 0.f;
-							ContactPatch* tmpPatch = mIntermediatePatchesPtrs[a];
-							while(tmpPatch)
-							{
-								for(PxU32 b = 0; b < tmpPatch->stride; ++b)
-								{
-									PxReal magSq =  (mOriginalContacts[tmpPatch->startIndex + b].point - p0).dot(dir);
-									if(magSq > maxDist)
-									{
-										ind = tmpPatch->startIndex + b;
-										maxDist = magSq;
-									}
-								}
-								tmpPatch = tmpPatch->mNextPatch;
-							}
+							const PxI32 pos = findFarthestAlongDir(pointX, pointY, pointZ, nbBlocks, p0, dir);
+							if(pos >= 0)
+								ind = contactIndices[pos];
 						}
 						reducedPatch.contactPoints[3] = ind;
 
@@ -319,33 +296,21 @@ namespace Dy
 							deepestInd[i] = index;
 						}
 
-						ContactPatch* tmpPatch = mIntermediatePatchesPtrs[a];
-						while(tmpPatch)
 						{
-							for(PxU32 b = 0; b < tmpPatch->stride; ++b)
+							PX_ALIGN(16, PxReal closest[CONTACT_REDUCTION_MAX_GATHERED_CONTACTS]);
+							findClosestReferencePoints(pointX, pointY, pointZ, nbBlocks, reducedPatch.contactPoints, closest);
+
+							for(PxU32 b = 0; b < contactCount; ++b)
 							{
-								Gu::ContactPoint& point = mOriginalContacts[tmpPatch->startIndex + b];
-								
-								PxReal distance = PX_MAX_REAL;
-								PxU32 index = 0;
-								for(PxU32 c = 0; c < 4; ++c)
-								{
-									PxVec3 dif = mOriginalContacts[reducedPatch.contactPoints[c]].point - point.point;
-									PxReal d = dif.magnitudeSquared();
-									if(distance > d)
-									{
-										distance = d;
-										index = c;
-									}
-								}
+								const PxU32 contactIndex = contactIndices[b];
+								const Gu::ContactPoint& point = mOriginalContacts[contactIndex];
+								const PxU32 index = PxU32(closest[b]);
 								if(separation[index] > point.separation)
 								{
-									deepestInd[index] = tmpPatch->startIndex+b;
+									deepestInd[index] = contactIndex;
 									separation[index] = point.separation;
 								}
-
 							}
-							tmpPatch = tmpPatch->mNextPatch;
 						}
 
 						bool chosen[64];
@@ -361,31 +326,27 @@ namespace Dy
 							separation[i] = PX_MAX_REAL;
 							deepestInd[i] = 0;
 						}
-						tmpPatch = mIntermediatePatchesPtrs[a];
-						while(tmpPatch)
+						for(PxU32 b = 0; b < contactCount; ++b)
 						{
-							for(PxU32 b = 0; b < tmpPatch->stride; ++b)
+							const PxU32 contactIndex = contactIndices[b];
+							if(!chosen[contactIndex])
 							{
-								if(!chosen[tmpPatch->startIndex+b])
+								const Gu::ContactPoint& point = mOriginalContacts[contactIndex];
+								for(PxU32 j = 4; j < CONTACT_REDUCTION_MAX_CONTACTS; ++j)
 								{
-									Gu::ContactPoint& point = mOriginalContacts[tmpPatch->startIndex + b];	
-									for(PxU32 j = 4; j < CONTACT_REDUCTION_MAX_CONTACTS; ++j)
+									if(point.separation < separation[j])
 									{
-										if(point.separation < separation[j])
+										for(PxU32 k = CONTACT_REDUCTION_MAX_CONTACTS-1; k > j; --k)
 										{
-											for(PxU32 k = CONTACT_REDUCTION_MAX_CONTACTS-1; k > j; --k)
-											{
-												separation[k] = separation[k-1];
-												deepestInd[k] = deepestInd[k-1];
-											}
-											separation[j] = point.separation;
-											deepestInd[j] = tmpPatch->startIndex+b;
-											break;
+											separation[k] = separation[k-1];
+											deepestInd[k] = deepestInd[k-1];
 										}
+										separation[j] = point.separation;
+										deepestInd[j] = contactIndex;
+										break;
 									}
 								}
 							}
-							tmpPatch = tmpPatch->mNextPatch;
 						}
 
 						for(PxU32 i = 4; i < CONTACT_REDUCTION_MAX_CONTACTS; ++i)
@@ -400,6 +361,126 @@ namespace Dy
 			mNumPatches = numReducedPatches;
 		}
 
+	private:
+
+		//Picks the winner out of the 4 per-lane results of a search: the largest value strictly greater than zero, lowest
+		//position first on ties. Returns -1 if no lane found such a value.
+		static PX_FORCE_INLINE PxI32 selectLane(const Ps::aos::Vec4V bestValue, const Ps::aos::Vec4V bestPos)
+		{
+			PX_ALIGN(16, PxReal values[4]);
+			PX_ALIGN(16, PxReal positions[4]);
+			Ps::aos::V4StoreA(bestValue, values);
+			Ps::aos::V4StoreA(bestPos, positions);
+
+			PxReal best = 0.f;
+			PxI32 result = -1;
+			for(PxU32 i = 0; i < 4; ++i)
+			{
+				const PxI32 pos = PxI32(positions[i]);
+				if(values[i] > best || (result != -1 && values[i] == best && pos < result))
+				{
+					best = values[i];
+					result = pos;
+				}
+			}
+			return result;
+		}
+
+		//Returns the position of the first gathered point farthest from 'origin', or -1 if all points are at distance 0.
+		static PX_FORCE_INLINE PxI32 findFarthestFromPoint(const PxReal* PX_RESTRICT x, const PxReal* PX_RESTRICT y, const PxReal* PX_RESTRICT z, 
+			const PxU32 nbBlocks, const PxVec3& origin)
+		{
+			using namespace Ps::aos;
+			const Vec4V ox = V4Load(origin.x);
+			const Vec4V oy = V4Load(origin.y);
+			const Vec4V oz = V4Load(origin.z);
+			const Vec4V four = V4Load(4.f);
+
+			Vec4V pos = V4LoadXYZW(0.f, 1.f, 2.f, 3.f);
+			Vec4V bestValue = V4Zero();
+			Vec4V bestPos = V4Load(-1.f);
+			for(PxU32 i = 0; i < nbBlocks; ++i)
+			{
+				const Vec4V dx = V4Sub(V4LoadA(x + i*4), ox);
+				const Vec4V dy = V4Sub(V4LoadA(y + i*4), oy);
+				const Vec4V dz = V4Sub(V4LoadA(z + i*4), oz);
+				const Vec4V magSq = V4Add(V4Add(V4Mul(dx, dx), V4Mul(dy, dy)), V4Mul(dz, dz));
+				const BoolV better = V4IsGrtr(magSq, bestValue);
+				bestValue = V4Sel(better, magSq, bestValue);
+				bestPos = V4Sel(better, pos, bestPos);
+				pos = V4Add(pos, four);
+			}
+			return selectLane(bestValue, bestPos);
+		}
+
+		//Returns the position of the first gathered point with the largest positive projection of (p - origin) onto 'dir',
+		//or -1 if no point projects positively.
+		static PX_FORCE_INLINE PxI32 findFarthestAlongDir(const PxReal* PX_RESTRICT x, const PxReal* PX_RESTRICT y, const PxReal* PX_RESTRICT z, 
+			const PxU32 nbBlocks, const PxVec3& origin, const PxVec3& dir)
+		{
+			using namespace Ps::aos;
+			const Vec4V ox = V4Load(origin.x);
+			const Vec4V oy = V4Load(origin.y);
+			const Vec4V oz = V4Load(origin.z);
+			const Vec4V nx = V4Load(dir.x);
+			const Vec4V ny = V4Load(dir.y);
+			const Vec4V nz = V4Load(dir.z);
+			const Vec4V four = V4Load(4.f);
+
+			Vec4V pos = V4LoadXYZW(0.f, 1.f, 2.f, 3.f);
+			Vec4V bestValue = V4Zero();
+			Vec4V bestPos = V4Load(-1.f);
+			for(PxU32 i = 0; i < nbBlocks; ++i)
+			{
+				const Vec4V dx = V4Sub(V4LoadA(x + i*4), ox);
+				const Vec4V dy = V4Sub(V4LoadA(y + i*4), oy);
+				const Vec4V dz = V4Sub(V4LoadA(z + i*4), oz);
+				const Vec4V proj = V4Add(V4Add(V4Mul(dx, nx), V4Mul(dy, ny)), V4Mul(dz, nz));
+				const BoolV better = V4IsGrtr(proj, bestValue);
+				bestValue = V4Sel(better, proj, bestValue);
+				bestPos = V4Sel(better, pos, bestPos);
+				pos = V4Add(pos, four);
+			}
+			return selectLane(bestValue, bestPos);
+		}
+
+		//For every gathered point, writes the index (0-3) of the closest of the 4 reference contacts, first one on ties.
+		PX_FORCE_INLINE void findClosestReferencePoints(const PxReal* PX_RESTRICT x, const PxReal* PX_RESTRICT y, const PxReal* PX_RESTRICT z, 
+			const PxU32 nbBlocks, const PxU32* referenceIndices, PxReal* PX_RESTRICT closest) const
+		{
+			using namespace Ps::aos;
+			Vec4V rx[4], ry[4], rz[4];
+			for(PxU32 c = 0; c < 4; ++c)
+			{
+				const PxVec3& r = mOriginalContacts[referenceIndices[c]].point;
+				rx[c] = V4Load(r.x);
+				ry[c] = V4Load(r.y);
+				rz[c] = V4Load(r.z);
+			}
+
+			const Vec4V maxReal = V4Load(PX_MAX_REAL);
+			for(PxU32 i = 0; i < nbBlocks; ++i)
+			{
+				const Vec4V px = V4LoadA(x + i*4);
+				const Vec4V py = V4LoadA(y + i*4);
+				const Vec4V pz = V4LoadA(z + i*4);
+
+				Vec4V distance = maxReal;
+				Vec4V index = V4Zero();
+				for(PxU32 c = 0; c < 4; ++c)
+				{
+					const Vec4V dx = V4Sub(rx[c], px);
+					const Vec4V dy = V4Sub(ry[c], py);
+					const Vec4V dz = V4Sub(rz[c], pz);
+					const Vec4V d = V4Add(V4Add(V4Mul(dx, dx), V4Mul(dy, dy)), V4Mul(dz, dz));
+					const BoolV closer = V4IsGrtr(distance, d);
+					distance = V4Sel(closer, d, distance);
+					index = V4Sel(closer, V4Load(PxReal(c)), index);
+				}
+				V4StoreA(index, closest + i*4);
+			}
+		}
+
 	};
 }
 
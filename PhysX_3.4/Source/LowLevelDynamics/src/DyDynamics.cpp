@@ -49,6 +49,7 @@
 #include "DyArticulation.h"
 
 #include "CmFlushPool.h"
+#include "CmRadixSortBuffered.h"
 #include "DyArticulationPImpl.h"
 #include "PxsMaterialManager.h"
 #include "DySolverContactPF4.h"
@@ -238,6 +239,11 @@ void DynamicsContext::addThreadStats(const ThreadContext::ThreadSimStats& stats)
 	mSimStats.mNbActiveDynamicBodies += stats.numActiveDynamicBodies;
 	mSimStats.mNbActiveKinematicBodies += stats.numActiveKinematicBodies;
 	mSimStats.mNbAxisSolverConstraints += stats.numAxisSolverConstraints;
+	for(PxU32 a = 0; a < PxSimulationStatistics::eSOLVER_ITERATION_HISTOGRAM_SIZE; ++a)
+	{
+		mSimStats.mNbIslandsPerPositionIterations[a] += stats.numIslandsPerPositionIterations[a];
+		mSimStats.mNbIslandsPerVelocityIterations[a] += stats.numIslandsPerVelocityIterations[a];
+	}
 }
 #endif
 
@@ -604,6 +610,18 @@ public:
 	PxsContactManagerOutputIterator& mOutputs;
 };
 
+struct EnhancedThresholdSortPredicate
+{
+	bool operator()(const ThresholdStreamElement& left, const ThresholdStreamElement& right) const
+	{
+		if(left.nodeIndexA != right.nodeIndexA)
+			return left.nodeIndexA < right.nodeIndexA;
+		if(left.nodeIndexB != right.nodeIndexB)
+			return left.nodeIndexB < right.nodeIndexB;
+		return left.normalForce < right.normalForce;
+	}
+};
+
 class PxsForceThresholdTask  : public Cm::Task
 {
 	DynamicsContext&		mDynamicsContext;
@@ -710,7 +728,14 @@ public:
 
 	virtual void runInternal()
 	{
-		mDynamicsContext.getThresholdStream().forceSize_Unsafe(PxU32(mDynamicsContext.mThresholdStreamOut));
+		ThresholdStream& thresholdStream = mDynamicsContext.getThresholdStream();
+		thresholdStream.forceSize_Unsafe(PxU32(mDynamicsContext.mThresholdStreamOut));
+
+		//The solver tasks append to the threshold stream in whatever order they finish, and the forces of a pair are summed
+		//in stream order. Sort it so that the force reports don't depend on the number of threads.
+		if(mDynamicsContext.mUseEnhancedDeterminism && thresholdStream.size() > 1)
+			Ps::sort(thresholdStream.begin(), thresholdStream.size(), EnhancedThresholdSortPredicate());
+
 		createForceChangeThresholdStream();
 	}
 
@@ -769,19 +794,21 @@ public:
 		PxU32 maxArticulationLength = 0;
 		PxU32 maxSolverArticLength = 0;
 
-		PxU32 startIdx = mStartIdx;
+		PX_ASSERT(mNbToProcess <= NbArticulationsPerTask);
+		for(PxU32 i=0;i<mNbToProcess; i++)
+			mArticulations[i]->getSolverDesc(mArticulationDescArray[i]);
+
+		// articulations sharing a topology are processed together
+		PxU32 acCounts[NbArticulationsPerTask], descCounts[NbArticulationsPerTask];
+		ArticulationPImpl::computeUnconstrainedVelocitiesBatch(mArticulationDescArray, mNbToProcess, mContext.mDt, threadContext.mConstraintBlockStream, 
+			mIslandThreadContext.mContactDescPtr + mStartIdx, acCounts, descCounts, mContext.getScratchAllocator(), 
+			mIslandThreadContext.mConstraintBlockManager, mContext.getGravity(), mContext.getContextId());
+
 		for(PxU32 i=0;i<mNbToProcess; i++)
 		{
 			Articulation& a = *(mArticulations[i]);
-			a.getSolverDesc(mArticulationDescArray[i]);
 
-			PxU32 acCount, descCount;
-			
-			descCount = ArticulationPImpl::computeUnconstrainedVelocities(mArticulationDescArray[i], mContext.mDt, threadContext.mConstraintBlockStream, 
-				mIslandThreadContext.mContactDescPtr + startIdx, acCount, mContext.getScratchAllocator(), 
-				mIslandThreadContext.mConstraintBlockManager, mContext.getGravity(), mContext.getContextId());
-
-			mArticulationDescArray[i].numInternalConstraints = Ps::to8(descCount);
+			mArticulationDescArray[i].numInternalConstraints = Ps::to8(descCounts[i]);
 
 			maxArticulationLength = PxMax(maxArticulationLength, PxU32(mArticulationDescArray[i].totalDataSize));
 			maxSolverArticLength = PxMax(maxSolverArticLength, PxU32(mArticulationDescArray[i].solverDataSize));
@@ -789,7 +816,6 @@ public:
 			const PxU16 iterWord = a.getIterationCounts();
 			maxVelIters = PxMax<PxU32>(PxU32(iterWord >> 8),	maxVelIters);
 			maxPosIters = PxMax<PxU32>(PxU32(iterWord & 0xff), maxPosIters);
-			startIdx += DY_ARTICULATION_MAX_SIZE;
 		}
 		Ps::atomicMax(reinterpret_cast<PxI32*>(&mIslandThreadContext.mMaxSolverPositionIterations), PxI32(maxPosIters));
 		Ps::atomicMax(reinterpret_cast<PxI32*>(&mIslandThreadContext.mMaxSolverVelocityIterations), PxI32(maxVelIters));
@@ -816,6 +842,28 @@ struct EnhancedSortPredicate
 };
 
 
+// below this, a comparison sort of the contact managers is cheaper than building the keys and permuting the managers
+static const PxU32 gMinNbContactManagersForRadixSort = 1024;
+
+// same order as EnhancedSortPredicate, but stable and in linear time, using (mTransformCache0, mTransformCache1) as 64-bit key
+static void radixSortContactManagers(PxsIndexedContactManager* indexedManagers, PxU32 nbManagers)
+{
+	Ps::Array<PxU64> keys(nbManagers);
+	for(PxU32 i = 0; i < nbManagers; ++i)
+	{
+		const PxcNpWorkUnit& unit = indexedManagers[i].contactManager->getWorkUnit();
+		keys[i] = (PxU64(unit.mTransformCache0)<<32) | PxU64(unit.mTransformCache1);
+	}
+
+	Cm::RadixSortBuffered rs;
+	const PxU32* ranks = rs.Sort(keys.begin(), nbManagers).GetRanks();
+
+	Ps::Array<PxsIndexedContactManager> sorted(nbManagers, PxsIndexedContactManager(NULL));
+	for(PxU32 i = 0; i < nbManagers; ++i)
+		sorted[i] = indexedManagers[ranks[i]];
+	PxMemCopy(indexedManagers, sorted.begin(), sizeof(PxsIndexedContactManager)*nbManagers);
+}
+
 class PxsSolverStartTask : public Cm::Task
 {
 	PxsSolverStartTask& operator=(const PxsSolverStartTask&);
@@ -1024,7 +1072,10 @@ public:
 
 			if (mEnhancedDeterminism)
 			{
-				Ps::sort(indexedManagers, currentContactIndex, EnhancedSortPredicate());
+				if(currentContactIndex < gMinNbContactManagersForRadixSort)
+					Ps::sort(indexedManagers, currentContactIndex, EnhancedSortPredicate());
+				else
+					radixSortContactManagers(indexedManagers, currentContactIndex);
 			}
 
 			mIslandContext.mCounts.contactManagers = currentContactIndex;
@@ -1363,6 +1414,7 @@ public:
 
 	virtual void runInternal()
 	{
+		Ps::AllocationScope allocScope(Ps::AllocationCategory::eDYNAMICS);
 		startTasks();
 		integrate();
 		setupDescTask();
@@ -1387,6 +1439,107 @@ private:
 	bool						mEnhancedDeterminism;
 };
 
+static void storeConstraintPartitions(ThreadContext& threadContext, const ConstraintPartitionArgs& args, const PxU32 maxPartitions)
+{
+	threadContext.mMaxPartitions = maxPartitions;
+	threadContext.mNumDifferentBodyConstraints = args.mNumDifferentBodyConstraints;
+	threadContext.mNumSelfConstraints = args.mNumSelfConstraints;
+	threadContext.mNumSelfConstraintBlocks = args.mNumSelfConstraintBlocks;
+}
+
+class PxsSolverPartitionSubRangeTask : public Cm::Task
+{
+	PxsSolverPartitionSubRangeTask& operator=(const PxsSolverPartitionSubRangeTask&);
+public:
+
+	PxsSolverPartitionSubRangeTask(PxU64 contextID, ConstraintPartitionArgs& args, const PxU32 subRange, const bool write) :
+		Cm::Task(contextID),
+		mArgs(args),
+		mSubRange(subRange),
+		mWrite(write)
+	{}
+
+	virtual void runInternal()
+	{
+		if(mWrite)
+			writePartitionSubRange(mArgs, mSubRange);
+		else
+			classifyPartitionSubRange(mArgs, mSubRange);
+	}
+
+	virtual const char* getName() const { return mWrite ? "PxsDynamics.solverPartitionWriteSubRange" : "PxsDynamics.solverPartitionClassifySubRange"; }
+
+	ConstraintPartitionArgs&	mArgs;
+	const PxU32					mSubRange;
+	const bool					mWrite;
+};
+
+//Classifies or writes all sub-ranges of a large island. The first sub-range is processed inline.
+static void processPartitionSubRanges(DynamicsContext& context, ConstraintPartitionArgs& args, const bool write, PxBaseTask* continuation)
+{
+	for(PxU32 a = 1; a < args.mNumSubRanges; ++a)
+	{
+		PxsSolverPartitionSubRangeTask* task = PX_PLACEMENT_NEW(context.getTaskPool().allocate(sizeof(PxsSolverPartitionSubRangeTask)), 
+			PxsSolverPartitionSubRangeTask)(context.getContextId(), args, a, write);
+		task->setContinuation(continuation);
+		task->removeReference();
+	}
+
+	if(write)
+		writePartitionSubRange(args, 0);
+	else
+		classifyPartitionSubRange(args, 0);
+}
+
+class PxsSolverPartitionMergeTask : public Cm::Task
+{
+	PxsSolverPartitionMergeTask& operator=(const PxsSolverPartitionMergeTask&);
+public:
+
+	PxsSolverPartitionMergeTask(DynamicsContext& context, const ConstraintPartitionArgs& args) :
+		Cm::Task(context.getContextId()),
+		mContext(context),
+		mArgs(args)
+	{
+		mArgs.mSubRanges = mSubRanges;
+	}
+
+	virtual void runInternal()
+	{
+		mergePartitionSubRanges(mArgs);
+		processPartitionSubRanges(mContext, mArgs, true, mCont);
+	}
+
+	virtual const char* getName() const { return "PxsDynamics.solverPartitionMerge"; }
+
+	DynamicsContext&			mContext;
+	ConstraintPartitionArgs		mArgs;
+	ConstraintPartitionSubRange	mSubRanges[ConstraintPartitionArgs::eMAX_NUM_SUB_RANGES + 1];
+};
+
+class PxsSolverPartitionFinishTask : public Cm::Task
+{
+	PxsSolverPartitionFinishTask& operator=(const PxsSolverPartitionFinishTask&);
+public:
+
+	PxsSolverPartitionFinishTask(DynamicsContext& context, ThreadContext& threadContext, ConstraintPartitionArgs& args) :
+		Cm::Task(context.getContextId()),
+		mThreadContext(threadContext),
+		mArgs(args)
+	{}
+
+	virtual void runInternal()
+	{
+		storeConstraintPartitions(mThreadContext, mArgs, finishPartitionSubRanges(mArgs));
+		PX_ASSERT((mThreadContext.mNumDifferentBodyConstraints + mThreadContext.mNumSelfConstraints) == mArgs.mNumContactConstraintDescriptors);
+	}
+
+	virtual const char* getName() const { return "PxsDynamics.solverPartitionFinish"; }
+
+	ThreadContext&				mThreadContext;
+	ConstraintPartitionArgs&	mArgs;
+};
+
 class PxsSolverConstraintPartitionTask : public Cm::Task
 {
 	PxsSolverConstraintPartitionTask& operator=(const PxsSolverConstraintPartitionTask&);
@@ -1463,11 +1616,24 @@ public:
 				args.mConstraintsPerPartition = &mThreadContext.mConstraintsPerPartition;
 				args.mBitField = &mThreadContext.mPartitionNormalizationBitmap;
 				args.enhancedDeterminism = mEnhancedDeterminism;
+				args.mPartitionAssignments = (mContext.getIncrementalPartitioningEnabled() && !mEnhancedDeterminism) ? &mThreadContext.mPartitionAssignments : NULL;
+				args.mSubRanges = NULL;
+				args.mNumSubRanges = 1;
+				args.mNumSubRangePartitions = 0;
+				args.mSubRangeConstraintIndices = &mThreadContext.mPartitionSubRangeIndices;
+				args.mSubRangeConstraintPartitions = &mThreadContext.mPartitionSubRangeAssignments;
+				args.mSubRangePartitionOffsets = &mThreadContext.mPartitionSubRangeOffsets;
+
+				//A single large island would serialize the frame here, so its partitioning is split into sub-ranges processed in
+				//parallel. The finish task stores the results once all sub-ranges are merged and written.
+				const PxU32 numSubRanges = getNumPartitionSubRanges(args);
+				if(numSubRanges > 1)
+				{
+					partitionSubRanges(mThreadContext, args, numSubRanges);
+					return;
+				}
 				
-				mThreadContext.mMaxPartitions = partitionContactConstraints(args);
-				mThreadContext.mNumDifferentBodyConstraints = args.mNumDifferentBodyConstraints;
-				mThreadContext.mNumSelfConstraints = args.mNumSelfConstraints;
-				mThreadContext.mNumSelfConstraintBlocks = args.mNumSelfConstraintBlocks;
+				storeConstraintPartitions(mThreadContext, args, partitionContactConstraints(args));
 			}
 			else
 			{
@@ -1479,6 +1645,24 @@ public:
 
 	}
 
+	void partitionSubRanges(ThreadContext& threadContext, const ConstraintPartitionArgs& args, const PxU32 numSubRanges)
+	{
+		Cm::FlushPool& taskPool = mContext.getTaskPool();
+
+		PxsSolverPartitionMergeTask* mergeTask = PX_PLACEMENT_NEW(taskPool.allocate(sizeof(PxsSolverPartitionMergeTask)), PxsSolverPartitionMergeTask)(mContext, args);
+		PxsSolverPartitionFinishTask* finishTask = PX_PLACEMENT_NEW(taskPool.allocate(sizeof(PxsSolverPartitionFinishTask)), PxsSolverPartitionFinishTask)(mContext, 
+			threadContext, mergeTask->mArgs);
+
+		finishTask->setContinuation(mCont);
+		mergeTask->setContinuation(finishTask);
+
+		beginPartitionSubRanges(mergeTask->mArgs, numSubRanges);
+		processPartitionSubRanges(mContext, mergeTask->mArgs, false, mergeTask);
+
+		mergeTask->removeReference();
+		finishTask->removeReference();
+	}
+
 	virtual const char* getName() const { return "PxsDynamics.solverConstraintPartition"; }
 
 	DynamicsContext&			mContext;
@@ -1489,6 +1673,33 @@ public:
 };
 
 
+// Merges adjacent 4-wide blocks of the same type in a partition into headers of stride 8 so that the solver can process
+// them with the 8-wide AVX kernels. Blocks of a partition never share a dynamic body, so each pair can be solved at once.
+// Returns the number of headers left in the partition.
+static PxU32 pairBlockBatches(PxConstraintBatchHeader* PX_RESTRICT headers, const PxU32 numHeaders)
+{
+	PxU32 numOut = 0;
+	for(PxU32 a = 0; a < numHeaders; ++a)
+	{
+		const PxConstraintBatchHeader header = headers[a];
+		const bool isBlock = header.mStride == 4 && (header.mConstraintType == DY_SC_TYPE_BLOCK_RB_CONTACT ||
+			header.mConstraintType == DY_SC_TYPE_BLOCK_STATIC_RB_CONTACT || header.mConstraintType == DY_SC_TYPE_BLOCK_1D);
+
+		headers[numOut] = header;
+		if(isBlock && (a+1) < numHeaders)
+		{
+			const PxConstraintBatchHeader& next = headers[a+1];
+			if(next.mStride == 4 && next.mConstraintType == header.mConstraintType && next.mStartIndex == header.mStartIndex + 4)
+			{
+				headers[numOut].mStride = 8;
+				a++;
+			}
+		}
+		numOut++;
+	}
+	return numOut;
+}
+
 class PxsSolverSetupSolveTask : public Cm::Task
 {
 	PxsSolverSetupSolveTask& operator=(const PxsSolverSetupSolveTask&);
@@ -1531,11 +1742,15 @@ public:
 
 		PxU32 numBatches = 0;
 
+		const bool pairBlocks = mContext.getSolverBatch8Enabled() && isSolverBatch8Supported() && 
+			mContext.getFrictionType() == PxFrictionType::ePATCH;
+
 		PxU32 currIndex = 0;
 		for(PxU32 a = 0; a < mThreadContext.mConstraintsPerPartition.size(); ++a)
 		{
 			PxU32 endIndex = currIndex + mThreadContext.mConstraintsPerPartition[a];
 
+			const PxU32 partitionStart = numBatches;
 			PxU32 numBatchesInPartition = 0;
 			for(PxU32 b = currIndex; b < endIndex; ++b)
 			{
@@ -1583,6 +1798,11 @@ public:
 					numBatchesInPartition++;
 				}
 			}
+			if(pairBlocks)
+			{
+				numBatchesInPartition = pairBlockBatches(mThreadContext.contactConstraintBatchHeaders + partitionStart, numBatchesInPartition);
+				numBatches = partitionStart + numBatchesInPartition;
+			}
 			PxU32 numHeaders = numBatchesInPartition;
 			currIndex += mThreadContext.mConstraintsPerPartition[a];
 			mThreadContext.mConstraintsPerPartition[a] = numHeaders;
@@ -1790,6 +2010,10 @@ public:
 				params.numFrictionConstraintHeaders = mThreadContext.frictionConstraintBatchHeaders.size();
 				params.frictionConstraintIndex = 0;
 				params.frictionConstraintList = frictionDescs;
+				params.residualTolerance = mContext.getSolverResidualTolerance();
+				params.residualVelocityArray = NULL;
+				params.positionIterationsUsed = mThreadContext.numContactConstraintBatches ? params.positionIterations : 0;
+				params.velocityIterationsUsed = mThreadContext.numContactConstraintBatches ? params.velocityIterations : 0;
 
 				const PxU32 unrollSize = 8;
 				const PxU32 denom = PxMax(1u, (mThreadContext.mMaxPartitions*unrollSize));
@@ -1831,6 +2055,15 @@ public:
 				else
 				{
 					
+					//Adaptive iteration counts are only supported by the patch friction solver core and need an island without articulations
+					if(mContext.getAdaptiveSolverIterationsEnabled() && mContext.getFrictionType() == PxFrictionType::ePATCH && mIslandContext.mCounts.articulations == 0)
+					{
+						mThreadContext.mResidualVelocities.forceSize_Unsafe(0);
+						mThreadContext.mResidualVelocities.reserve(mIslandContext.mCounts.bodies);
+						mThreadContext.mResidualVelocities.forceSize_Unsafe(mIslandContext.mCounts.bodies);
+						params.residualVelocityArray = mThreadContext.mResidualVelocities.begin();
+					}
+
 					//Only one task - a small island so do a sequential solve (avoid the atomic overheads)
 					solveVBlock(mContext.mSolverCore[mContext.getFrictionType()], params);
 
@@ -1839,10 +2072,9 @@ public:
 					for(PxU32 k=0; k < mIslandContext.mCounts.bodies; k++)
 					{
 						const PxU32 prefetchAddress = PxMin(k+4, bodyCountMin1);
-						Ps::prefetchLine(mThreadContext.mBodyCoreArray[prefetchAddress]);
+						prefetchBodyForIntegration(mObjects.bodies[prefetchAddress], mThreadContext.mBodyCoreArray[prefetchAddress]);
 						Ps::prefetchLine(&mThreadContext.motionVelocityArray[k], 128);
-						Ps::prefetchLine(&mThreadContext.mBodyCoreArray[prefetchAddress], 128);
-						Ps::prefetchLine(&mObjects.bodies[prefetchAddress]);
+						prefetchSolverBodyData(&solverBodyData2[prefetchAddress]);
 
 						PxSolverBodyData& solverBodyData = solverBodyData2[k];
 
@@ -1870,6 +2102,12 @@ public:
 						ArticulationPImpl::updateBodies(d, mContext.getDt());
 					}
 				}
+
+#if PX_ENABLE_SIM_STATS
+				const PxU32 lastHistogramEntry = PxSimulationStatistics::eSOLVER_ITERATION_HISTOGRAM_SIZE - 1;
+				mThreadContext.getSimStats().numIslandsPerPositionIterations[PxMin(params.positionIterationsUsed, lastHistogramEntry)]++;
+				mThreadContext.getSimStats().numIslandsPerVelocityIterations[PxMin(params.velocityIterationsUsed, lastHistogramEntry)]++;
+#endif
 			}
 		}
 	}
@@ -2046,6 +2284,7 @@ PxBaseTask* createSolverTaskChain(DynamicsContext& dynamicContext,
 	// create lead task
 	PxsSolverStartTask* startTask = PX_PLACEMENT_NEW(taskPool.allocateNotThreadSafe(sizeof(PxsSolverStartTask)), PxsSolverStartTask)(dynamicContext, *islandContext, objects, solverBodyOffset, dynamicContext.getKinematicCount(), 
 		islandManager, bodyRemapTable, materialManager, iterator, useEnhancedDeterminism);
+	startTask->setPriority(PxTaskPriority::eHIGH);	// heads the island's solver chain
 	PxsSolverEndTask* endTask = PX_PLACEMENT_NEW(taskPool.allocateNotThreadSafe(sizeof(PxsSolverEndTask)), PxsSolverEndTask)(dynamicContext, *islandContext, objects, solverBodyOffset, iterator);	
 
 
@@ -2330,6 +2569,7 @@ void DynamicsContext::update(IG::SimpleIslandManager& simpleIslandManager, PxBas
 
 void DynamicsContext::updateBodyCore(PxBaseTask* continuation)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eDYNAMICS);
 	PX_UNUSED(continuation);
 }
 
@@ -2365,6 +2605,7 @@ static void preIntegrationParallel(
    volatile PxU32* maxSolverVelocityIterations,
    const PxVec3& gravity)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eDYNAMICS);
 	PxU32 localMaxPosIter = 0;
 	PxU32 localMaxVelIter = 0;
 
@@ -2372,10 +2613,9 @@ static void preIntegrationParallel(
 	for(PxU32 a = 1; a < bodyCount; ++a)
 	{
 		PxU32 i = a-1;
-		Ps::prefetchLine(bodyArray[a]);
-		Ps::prefetchLine(bodyArray[a],128);
-		Ps::prefetchLine(&solverBodyDataPool[a]);
-		Ps::prefetchLine(&solverBodyDataPool[a],128);
+		const PxU32 prefetch = PxMin(i+4, bodyCount-1);
+		prefetchBodyForIntegration(originalBodyArray[prefetch], bodyArray[prefetch]);
+		prefetchSolverBodyData(&solverBodyDataPool[prefetch + 1]);
 
 		PxsBodyCore& core = *bodyArray[i];
 		const PxsRigidBody& rBody = *originalBodyArray[i];
@@ -2548,12 +2788,12 @@ void DynamicsContext::integrateCoreParallel(SolverIslandParams& params, IG::Isla
 		for(PxI32 a = 0; a < remainder; ++a, index++)
 		{
 			const PxI32 prefetch = PxMin(index+4, numBodies - 1);
-			Ps::prefetchLine(bodyArray[prefetch]);
-			Ps::prefetchLine(bodyArray[prefetch],128);
+			prefetchBodyForIntegration(rigidBodies[prefetch], bodyArray[prefetch]);
 			Ps::prefetchLine(&solverBodies[index],128);
 			Ps::prefetchLine(&motionVelocityArray[index],128);
+			prefetchSolverBodyData(&solverBodyData[prefetch]);
 			Ps::prefetchLine(&bodyArray[index+32]);
-			Ps::prefetchLine(&rigidBodies[prefetch]);
+			Ps::prefetchLine(&rigidBodies[index+32]);
 			
 			PxSolverBodyData& data = solverBodyData[index];
 
@@ -2777,6 +3017,7 @@ static PxU32 createFinalizeContacts_Parallel(PxSolverBodyData* solverBodyData, T
 				shaderPrepDesc.constantBlockByteSize = constantBlockByteSize;
 				shaderPrepDesc.constraint = constraint;
 				shaderPrepDesc.solverPrep = solverPrep;
+				shaderPrepDesc.solverPrep4 = constraint->solverPrep4;
 
 				prepDesc.desc = &desc;
 				prepDesc.bodyFrame0 = pose0;
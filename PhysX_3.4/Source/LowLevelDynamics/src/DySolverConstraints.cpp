@@ -49,6 +49,11 @@ namespace physx
 namespace Dy
 {
 
+#ifdef DY_SOLVER_VARIANT
+namespace DY_SOLVER_VARIANT
+{
+#endif
+
 //Port of scalar implementation to SIMD maths with some interleaving of instructions
 void solve1D(const PxSolverConstraintDesc& desc, SolverContext& cache)
 {
@@ -1115,6 +1120,9 @@ void solveConcludeContact_BStatic	(const PxSolverConstraintDesc& desc, SolverCon
 	concludeContact(desc, cache);
 }
 
+#ifdef DY_SOLVER_VARIANT
+}
+#endif
 
 }
 
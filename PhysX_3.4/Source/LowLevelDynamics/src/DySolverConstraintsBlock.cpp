@@ -44,6 +44,18 @@
 #include "PsAtomic.h"
 #include "DySolverContact4.h"
 #include "DySolverConstraint1D4.h"
+#include "DySolverControl.h"
+
+#if PX_INTEL_FAMILY && !defined(PX_SIMD_DISABLED) && ((PX_WINDOWS_FAMILY && PX_VC >= 12) || ((PX_LINUX || PX_OSX) && PX_GCC_FAMILY))
+	#define DY_SOLVER_BATCH8
+#endif
+
+#ifdef DY_SOLVER_BATCH8
+	#if PX_WINDOWS_FAMILY
+		#include <intrin.h>
+	#endif
+	#include <immintrin.h>
+#endif
 
 namespace physx
 {
@@ -964,6 +976,772 @@ static void conclude1D4_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, So
 	PX_ASSERT(desc[0].constraint + getConstraintLength(desc[0]) == base);
 }
 
+#ifdef DY_SOLVER_BATCH8
+
+// The 8-wide path solves two 4-wide blocks from the same partition in lock-step, one block in each 128-bit half of the AVX
+// registers. The constraint data is the regular 4-wide data so nothing changes in the prep code. The operations mirror the
+// SSE2 Vec4V functions exactly (no FMA) so that the results are identical to solving the two blocks one after the other.
+
+#if PX_WINDOWS_FAMILY
+	#define DY_AVX_TARGET
+#else
+	#define DY_AVX_TARGET	__attribute__((target("avx")))
+#endif
+
+static bool detectAVX()
+{
+#if PX_WINDOWS_FAMILY
+	// Checks that the CPU supports AVX and that the OS uses XSAVE/XRSTOR and saves YMM registers
+	int cpuInfo[4];
+	__cpuid(cpuInfo, 1);
+	const int avxFlags = 3<<27;
+	if((cpuInfo[2] & avxFlags)!=avxFlags)
+		return false;
+
+	return (_xgetbv(0) & 0x6)==0x6;
+#else
+	// This also checks that the OS saves YMM registers
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx")!=0;
+#endif
+}
+
+static const bool gHasAVX = detectAVX();
+
+bool isSolverBatch8Supported()
+{
+	return gHasAVX;
+}
+
+typedef __m256 Vec8V;
+
+DY_AVX_TARGET static PX_FORCE_INLINE Vec8V V8Load2(const Vec4V& lo, const Vec4V& hi)	{ return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);	}
+DY_AVX_TARGET static PX_FORCE_INLINE Vec4V V8GetLo(const Vec8V v)						{ return _mm256_castps256_ps128(v);	}
+DY_AVX_TARGET static PX_FORCE_INLINE Vec4V V8GetHi(const Vec8V v)						{ return _mm256_extractf128_ps(v, 1);	}
+DY_AVX_TARGET static PX_FORCE_INLINE void V8Store2(const Vec8V v, Vec4V& lo, Vec4V& hi)	{ lo = V8GetLo(v); hi = V8GetHi(v);	}
+DY_AVX_TARGET static PX_FORCE_INLINE Vec8V V8Zero()										{ return _mm256_setzero_ps();	}
+DY_AVX_TARGET static PX_FORCE_INLINE Vec8V V8Add(const Vec8V a, const Vec8V b)			{ return _mm256_add_ps(a, b);	}
+DY_AVX_TARGET static PX_FORCE_INLINE Vec8V V8Sub(const Vec8V a, const Vec8V b)			{ return _mm256_sub_ps(a, b);	}
+DY_AVX_TARGET static PX_FORCE_INLINE Vec8V V8Mul(const Vec8V a, const Vec8V b)			{ return _mm256_mul_ps(a, b);	}
+DY_AVX_TARGET static PX_FORCE_INLINE Vec8V V8MulAdd(const Vec8V a, const Vec8V b, const Vec8V c)		{ return V8Add(V8Mul(a, b), c);	}
+DY_AVX_TARGET static PX_FORCE_INLINE Vec8V V8NegMulSub(const Vec8V a, const Vec8V b, const Vec8V c)	{ return V8Sub(c, V8Mul(a, b));	}
+DY_AVX_TARGET static PX_FORCE_INLINE Vec8V V8Neg(const Vec8V a)							{ return V8Sub(V8Zero(), a);	}
+DY_AVX_TARGET static PX_FORCE_INLINE Vec8V V8Max(const Vec8V a, const Vec8V b)			{ return _mm256_max_ps(a, b);	}
+DY_AVX_TARGET static PX_FORCE_INLINE Vec8V V8Min(const Vec8V a, const Vec8V b)			{ return _mm256_min_ps(a, b);	}
+DY_AVX_TARGET static PX_FORCE_INLINE Vec8V V8Abs(const Vec8V a)							{ return V8Max(a, V8Neg(a));	}
+DY_AVX_TARGET static PX_FORCE_INLINE Vec8V V8IsGrtr(const Vec8V a, const Vec8V b)		{ return _mm256_cmp_ps(a, b, _CMP_GT_OQ);	}
+DY_AVX_TARGET static PX_FORCE_INLINE Vec8V V8Or(const Vec8V a, const Vec8V b)			{ return _mm256_or_ps(a, b);	}
+DY_AVX_TARGET static PX_FORCE_INLINE Vec8V V8Sel(const Vec8V c, const Vec8V a, const Vec8V b)		{ return _mm256_or_ps(_mm256_andnot_ps(c, b), _mm256_and_ps(c, a));	}
+
+// Zeroed data standing in for the rows, headers and friction data a block does not have when the other block of the pair
+// has more of them. Running a zeroed row computes a zero impulse, so it leaves the bodies untouched.
+static const PX_ALIGN(16, PxU8 gSolverBatch8ZeroData[384]) = { 0 };
+
+template<class T>
+static PX_FORCE_INLINE const T& getSolverBatch8ZeroData()
+{
+	PX_COMPILE_TIME_ASSERT(sizeof(T) <= sizeof(gSolverBatch8ZeroData));
+	return *reinterpret_cast<const T*>(gSolverBatch8ZeroData);
+}
+
+// Transposed velocities of 8 solver bodies. Lane i holds the body of constraint i. The W components are not touched by
+// the solver and are only kept to store them back unchanged.
+struct SolverBodies8
+{
+	Vec8V	linVelX, linVelY, linVelZ;
+	Vec8V	angStateX, angStateY, angStateZ;
+	Vec4V	linVelW[2], angStateW[2];
+};
+
+DY_AVX_TARGET static PX_FORCE_INLINE void loadSolverBodies8(PxSolverBody* const* PX_RESTRICT bodies, SolverBodies8& b)
+{
+	Vec4V linVelT[2][3], angStateT[2][3];
+	for(PxU32 h=0; h<2; h++)
+	{
+		const PxSolverBody* const* PX_RESTRICT bh = bodies + 4*h;
+		Vec4V linVel0 = V4LoadA(&bh[0]->linearVelocity.x);
+		Vec4V linVel1 = V4LoadA(&bh[1]->linearVelocity.x);
+		Vec4V linVel2 = V4LoadA(&bh[2]->linearVelocity.x);
+		Vec4V linVel3 = V4LoadA(&bh[3]->linearVelocity.x);
+		Vec4V angState0 = V4LoadA(&bh[0]->angularState.x);
+		Vec4V angState1 = V4LoadA(&bh[1]->angularState.x);
+		Vec4V angState2 = V4LoadA(&bh[2]->angularState.x);
+		Vec4V angState3 = V4LoadA(&bh[3]->angularState.x);
+
+		PX_TRANSPOSE_44(linVel0, linVel1, linVel2, linVel3, linVelT[h][0], linVelT[h][1], linVelT[h][2], b.linVelW[h]);
+		PX_TRANSPOSE_44(angState0, angState1, angState2, angState3, angStateT[h][0], angStateT[h][1], angStateT[h][2], b.angStateW[h]);
+	}
+
+	b.linVelX = V8Load2(linVelT[0][0], linVelT[1][0]);
+	b.linVelY = V8Load2(linVelT[0][1], linVelT[1][1]);
+	b.linVelZ = V8Load2(linVelT[0][2], linVelT[1][2]);
+	b.angStateX = V8Load2(angStateT[0][0], angStateT[1][0]);
+	b.angStateY = V8Load2(angStateT[0][1], angStateT[1][1]);
+	b.angStateZ = V8Load2(angStateT[0][2], angStateT[1][2]);
+}
+
+// Stores the velocities of the bodies whose bit is set in storeMask
+DY_AVX_TARGET static PX_FORCE_INLINE void storeSolverBodies8(PxSolverBody* const* PX_RESTRICT bodies, const SolverBodies8& b, const PxU32 storeMask)
+{
+	for(PxU32 h=0; h<2; h++)
+	{
+		Vec4V linVelT0 = h ? V8GetHi(b.linVelX) : V8GetLo(b.linVelX);
+		Vec4V linVelT1 = h ? V8GetHi(b.linVelY) : V8GetLo(b.linVelY);
+		Vec4V linVelT2 = h ? V8GetHi(b.linVelZ) : V8GetLo(b.linVelZ);
+		Vec4V linVelT3 = b.linVelW[h];
+		Vec4V angStateT0 = h ? V8GetHi(b.angStateX) : V8GetLo(b.angStateX);
+		Vec4V angStateT1 = h ? V8GetHi(b.angStateY) : V8GetLo(b.angStateY);
+		Vec4V angStateT2 = h ? V8GetHi(b.angStateZ) : V8GetLo(b.angStateZ);
+		Vec4V angStateT3 = b.angStateW[h];
+
+		Vec4V linVel[4], angState[4];
+		PX_TRANSPOSE_44(linVelT0, linVelT1, linVelT2, linVelT3, linVel[0], linVel[1], linVel[2], linVel[3]);
+		PX_TRANSPOSE_44(angStateT0, angStateT1, angStateT2, angStateT3, angState[0], angState[1], angState[2], angState[3]);
+
+		for(PxU32 i=0; i<4; i++)
+		{
+			if(storeMask & (1<<(4*h+i)))
+			{
+				PxSolverBody& body = *bodies[4*h+i];
+				V4StoreA(linVel[i], &body.linearVelocity.x);
+				V4StoreA(angState[i], &body.angularState.x);
+				PX_ASSERT(body.linearVelocity.isFinite());
+				PX_ASSERT(body.angularState.isFinite());
+			}
+		}
+	}
+}
+
+// Walks the headers of one 4-wide contact block. Rows, headers and friction data beyond what the block contains are
+// replaced with zeroed data, and the forces computed for them go to a scratch location.
+template<class ContactPoint, class ContactFriction>
+struct ContactBlockCursor4
+{
+	const PxU8*					mCurrPtr;
+	const PxU8*					mLast;
+	const SolverContactHeader4*	mHdr;
+	Vec4V*						mAppliedForces;
+	const ContactPoint*			mContacts;
+	SolverFrictionSharedData4*	mFd;
+	Vec4V*						mFrictionAppliedForces;
+	const ContactFriction*		mFrictions;
+	PxU32						mNumNormalConstr;
+	PxU32						mNumFrictionConstr;
+	Vec4V*						mSink;
+	SolverFrictionSharedData4*	mDummyFd;
+
+	PX_FORCE_INLINE void init(const PxSolverConstraintDesc& desc, Vec4V* sink, SolverFrictionSharedData4* dummyFd)
+	{
+		mCurrPtr = desc.constraint;
+		mLast = desc.constraint + getConstraintLength(desc);
+		mHdr = reinterpret_cast<const SolverContactHeader4*>(mCurrPtr);
+		mSink = sink;
+		mDummyFd = dummyFd;
+	}
+
+	PX_FORCE_INLINE bool hasHeaders() const	{ return mCurrPtr < mLast;	}
+
+	PX_FORCE_INLINE void nextHeader()
+	{
+		if(mCurrPtr < mLast)
+		{
+			mHdr = reinterpret_cast<const SolverContactHeader4*>(mCurrPtr);
+			PxU8* PX_RESTRICT currPtr = reinterpret_cast<PxU8*>(const_cast<SolverContactHeader4*>(mHdr) + 1);
+
+			mNumNormalConstr = mHdr->numNormalConstr;
+			mNumFrictionConstr = mHdr->numFrictionConstr;
+
+			mAppliedForces = reinterpret_cast<Vec4V*>(currPtr);
+			currPtr += sizeof(Vec4V)*mNumNormalConstr;
+
+			mContacts = reinterpret_cast<const ContactPoint*>(currPtr);
+			currPtr += sizeof(ContactPoint)*mNumNormalConstr;
+
+			// Without friction rows the shared friction data is not there and must not be written to
+			mFd = mNumFrictionConstr ? reinterpret_cast<SolverFrictionSharedData4*>(currPtr) : mDummyFd;
+			if(mNumFrictionConstr)
+				currPtr += sizeof(SolverFrictionSharedData4);
+
+			mFrictionAppliedForces = reinterpret_cast<Vec4V*>(currPtr);
+			currPtr += sizeof(Vec4V)*mNumFrictionConstr;
+
+			mFrictions = reinterpret_cast<const ContactFriction*>(currPtr);
+			currPtr += sizeof(ContactFriction)*mNumFrictionConstr;
+
+			mCurrPtr = currPtr;
+		}
+		else
+		{
+			mHdr = &getSolverBatch8ZeroData<SolverContactHeader4>();
+			mNumNormalConstr = 0;
+			mNumFrictionConstr = 0;
+			mFd = mDummyFd;
+		}
+	}
+
+	PX_FORCE_INLINE const ContactPoint& getContact(PxU32 i)		const	{ return i < mNumNormalConstr ? mContacts[i] : getSolverBatch8ZeroData<ContactPoint>();	}
+	PX_FORCE_INLINE Vec4V& getAppliedForce(PxU32 i)				const	{ return i < mNumNormalConstr ? mAppliedForces[i] : *mSink;	}
+	PX_FORCE_INLINE const ContactFriction& getFriction(PxU32 i)	const	{ return i < mNumFrictionConstr ? mFrictions[i] : getSolverBatch8ZeroData<ContactFriction>();	}
+	PX_FORCE_INLINE Vec4V& getFrictionAppliedForce(PxU32 i)		const	{ return i < mNumFrictionConstr ? mFrictionAppliedForces[i] : *mSink;	}
+};
+
+DY_AVX_TARGET static void solveContact8_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache)
+{
+	PxSolverBody* bodies0[8];
+	PxSolverBody* bodies1[8];
+	PxU32 storeMask1 = 0;
+	for(PxU32 i=0; i<8; i++)
+	{
+		PX_ASSERT(*desc[i].constraint == DY_SC_TYPE_BLOCK_RB_CONTACT);
+		bodies0[i] = desc[i].bodyA;
+		bodies1[i] = desc[i].bodyB;
+		if(desc[i].bodyBDataIndex != 0)
+			storeMask1 |= 1<<i;
+	}
+
+	SolverBodies8 b0, b1;
+	loadSolverBodies8(bodies0, b0);
+	loadSolverBodies8(bodies1, b1);
+
+	const Vec8V vZero = V8Zero();
+
+	Vec4V sink[2];
+	SolverFrictionSharedData4 dummyFd[2];
+	PxMemZero(sink, sizeof(sink));
+	PxMemZero(dummyFd, sizeof(dummyFd));
+
+	ContactBlockCursor4<SolverContactBatchPointDynamic4, SolverContactFrictionDynamic4> blocks[2];
+	blocks[0].init(desc[0], &sink[0], &dummyFd[0]);
+	blocks[1].init(desc[4], &sink[1], &dummyFd[1]);
+
+	const Vec8V invMassA = V8Load2(blocks[0].mHdr->invMass0D0, blocks[1].mHdr->invMass0D0);
+	const Vec8V invMassB = V8Load2(blocks[0].mHdr->invMass1D1, blocks[1].mHdr->invMass1D1);
+
+	const Vec8V sumInvMass = V8Add(invMassA, invMassB);
+
+	while(blocks[0].hasHeaders() || blocks[1].hasHeaders())
+	{
+		blocks[0].nextHeader();
+		blocks[1].nextHeader();
+
+		const SolverContactHeader4* PX_RESTRICT hdr0 = blocks[0].mHdr;
+		const SolverContactHeader4* PX_RESTRICT hdr1 = blocks[1].mHdr;
+
+		const PxU32 numNormalConstr = PxMax(blocks[0].mNumNormalConstr, blocks[1].mNumNormalConstr);
+		const PxU32 numFrictionConstr = PxMax(blocks[0].mNumFrictionConstr, blocks[1].mNumFrictionConstr);
+
+		if(blocks[0].mNumNormalConstr)
+			Ps::prefetchLine(blocks[0].mContacts, 128);
+		if(blocks[1].mNumNormalConstr)
+			Ps::prefetchLine(blocks[1].mContacts, 128);
+
+		Vec8V accumulatedNormalImpulse = vZero;
+
+		const Vec8V angD0 = V8Load2(hdr0->angDom0, hdr1->angDom0);
+		const Vec8V angD1 = V8Load2(hdr0->angDom1, hdr1->angDom1);
+
+		const Vec8V _normalT0 = V8Load2(hdr0->normalX, hdr1->normalX);
+		const Vec8V _normalT1 = V8Load2(hdr0->normalY, hdr1->normalY);
+		const Vec8V _normalT2 = V8Load2(hdr0->normalZ, hdr1->normalZ);
+
+		Vec8V contactNormalVel1 = V8Mul(b0.linVelX, _normalT0);
+		Vec8V contactNormalVel3 = V8Mul(b1.linVelX, _normalT0);
+		contactNormalVel1 = V8MulAdd(b0.linVelY, _normalT1, contactNormalVel1);
+		contactNormalVel3 = V8MulAdd(b1.linVelY, _normalT1, contactNormalVel3);
+		contactNormalVel1 = V8MulAdd(b0.linVelZ, _normalT2, contactNormalVel1);
+		contactNormalVel3 = V8MulAdd(b1.linVelZ, _normalT2, contactNormalVel3);
+
+		Vec8V relVel1 = V8Sub(contactNormalVel1, contactNormalVel3);
+
+		Vec8V accumDeltaF = vZero;
+
+		for(PxU32 i=0;i<numNormalConstr;i++)
+		{
+			const SolverContactBatchPointDynamic4& c0 = blocks[0].getContact(i);
+			const SolverContactBatchPointDynamic4& c1 = blocks[1].getContact(i);
+			Vec4V& appliedForce0 = blocks[0].getAppliedForce(i);
+			Vec4V& appliedForce1 = blocks[1].getAppliedForce(i);
+
+			Ps::prefetchLine(&c0 + 1);
+			Ps::prefetchLine(&c1 + 1);
+
+			const Vec8V raXnX = V8Load2(c0.raXnX, c1.raXnX);
+			const Vec8V raXnY = V8Load2(c0.raXnY, c1.raXnY);
+			const Vec8V raXnZ = V8Load2(c0.raXnZ, c1.raXnZ);
+			const Vec8V rbXnX = V8Load2(c0.rbXnX, c1.rbXnX);
+			const Vec8V rbXnY = V8Load2(c0.rbXnY, c1.rbXnY);
+			const Vec8V rbXnZ = V8Load2(c0.rbXnZ, c1.rbXnZ);
+
+			const Vec8V appliedForce = V8Load2(appliedForce0, appliedForce1);
+			const Vec8V maxImpulse = V8Load2(c0.maxContactImpulse, c1.maxContactImpulse);
+
+			Vec8V contactNormalVel2 = V8Mul(raXnX, b0.angStateX);
+			Vec8V contactNormalVel4 = V8Mul(rbXnX, b1.angStateX);
+
+			contactNormalVel2 = V8MulAdd(raXnY, b0.angStateY, contactNormalVel2);
+			contactNormalVel4 = V8MulAdd(rbXnY, b1.angStateY, contactNormalVel4);
+
+			contactNormalVel2 = V8MulAdd(raXnZ, b0.angStateZ, contactNormalVel2);
+			contactNormalVel4 = V8MulAdd(rbXnZ, b1.angStateZ, contactNormalVel4);
+
+			const Vec8V normalVel = V8Add(relVel1, V8Sub(contactNormalVel2, contactNormalVel4));
+
+			Vec8V deltaF = V8NegMulSub(normalVel, V8Load2(c0.velMultiplier, c1.velMultiplier), V8Load2(c0.biasedErr, c1.biasedErr));
+
+			deltaF = V8Max(deltaF, V8Neg(appliedForce));
+			const Vec8V newAppliedForce = V8Min(V8Add(appliedForce, deltaF), maxImpulse);
+			deltaF = V8Sub(newAppliedForce, appliedForce);
+
+			accumDeltaF = V8Add(accumDeltaF, deltaF);
+
+			const Vec8V angDetaF0 = V8Mul(deltaF, angD0);
+			const Vec8V angDetaF1 = V8Mul(deltaF, angD1);
+
+			relVel1 = V8MulAdd(sumInvMass, deltaF, relVel1);
+
+			b0.angStateX = V8MulAdd(raXnX, angDetaF0, b0.angStateX);
+			b1.angStateX = V8NegMulSub(rbXnX, angDetaF1, b1.angStateX);
+
+			b0.angStateY = V8MulAdd(raXnY, angDetaF0, b0.angStateY);
+			b1.angStateY = V8NegMulSub(rbXnY, angDetaF1, b1.angStateY);
+
+			b0.angStateZ = V8MulAdd(raXnZ, angDetaF0, b0.angStateZ);
+			b1.angStateZ = V8NegMulSub(rbXnZ, angDetaF1, b1.angStateZ);
+
+			V8Store2(newAppliedForce, appliedForce0, appliedForce1);
+
+			accumulatedNormalImpulse = V8Add(accumulatedNormalImpulse, newAppliedForce);
+		}
+
+		const Vec8V accumDeltaF_IM0 = V8Mul(accumDeltaF, invMassA);
+		const Vec8V accumDeltaF_IM1 = V8Mul(accumDeltaF, invMassB);
+
+		b0.linVelX = V8MulAdd(_normalT0, accumDeltaF_IM0, b0.linVelX);
+		b1.linVelX = V8NegMulSub(_normalT0, accumDeltaF_IM1, b1.linVelX);
+		b0.linVelY = V8MulAdd(_normalT1, accumDeltaF_IM0, b0.linVelY);
+		b1.linVelY = V8NegMulSub(_normalT1, accumDeltaF_IM1, b1.linVelY);
+		b0.linVelZ = V8MulAdd(_normalT2, accumDeltaF_IM0, b0.linVelZ);
+		b1.linVelZ = V8NegMulSub(_normalT2, accumDeltaF_IM1, b1.linVelZ);
+
+		if(cache.doFriction && numFrictionConstr)
+		{
+			SolverFrictionSharedData4* PX_RESTRICT fd0 = blocks[0].mFd;
+			SolverFrictionSharedData4* PX_RESTRICT fd1 = blocks[1].mFd;
+
+			const Vec8V staticFric = V8Load2(hdr0->staticFriction, hdr1->staticFriction);
+			const Vec8V dynamicFric = V8Load2(hdr0->dynamicFriction, hdr1->dynamicFriction);
+
+			const Vec8V maxFrictionImpulse = V8Mul(staticFric, accumulatedNormalImpulse);
+			const Vec8V maxDynFrictionImpulse = V8Mul(dynamicFric, accumulatedNormalImpulse);
+			const Vec8V negMaxDynFrictionImpulse = V8Neg(maxDynFrictionImpulse);
+			Vec8V broken = vZero;
+
+			for(PxU32 i=0;i<numFrictionConstr;i++)
+			{
+				const SolverContactFrictionDynamic4& f0 = blocks[0].getFriction(i);
+				const SolverContactFrictionDynamic4& f1 = blocks[1].getFriction(i);
+				Vec4V& appliedForce0 = blocks[0].getFrictionAppliedForce(i);
+				Vec4V& appliedForce1 = blocks[1].getFrictionAppliedForce(i);
+
+				Ps::prefetchLine(&f0 + 1);
+				Ps::prefetchLine(&f1 + 1);
+
+				const Vec8V raXnX = V8Load2(f0.raXnX, f1.raXnX);
+				const Vec8V raXnY = V8Load2(f0.raXnY, f1.raXnY);
+				const Vec8V raXnZ = V8Load2(f0.raXnZ, f1.raXnZ);
+				const Vec8V rbXnX = V8Load2(f0.rbXnX, f1.rbXnX);
+				const Vec8V rbXnY = V8Load2(f0.rbXnY, f1.rbXnY);
+				const Vec8V rbXnZ = V8Load2(f0.rbXnZ, f1.rbXnZ);
+
+				const Vec8V appliedForce = V8Load2(appliedForce0, appliedForce1);
+
+				const Vec8V normalT0 = V8Load2(fd0->normalX[i&1], fd1->normalX[i&1]);
+				const Vec8V normalT1 = V8Load2(fd0->normalY[i&1], fd1->normalY[i&1]);
+				const Vec8V normalT2 = V8Load2(fd0->normalZ[i&1], fd1->normalZ[i&1]);
+
+				Vec8V normalVel1 = V8Mul(b0.linVelX, normalT0);
+				Vec8V normalVel2 = V8Mul(raXnX, b0.angStateX);
+				Vec8V normalVel3 = V8Mul(b1.linVelX, normalT0);
+				Vec8V normalVel4 = V8Mul(rbXnX, b1.angStateX);
+
+				normalVel1 = V8MulAdd(b0.linVelY, normalT1, normalVel1);
+				normalVel2 = V8MulAdd(raXnY, b0.angStateY, normalVel2);
+				normalVel3 = V8MulAdd(b1.linVelY, normalT1, normalVel3);
+				normalVel4 = V8MulAdd(rbXnY, b1.angStateY, normalVel4);
+
+				normalVel1 = V8MulAdd(b0.linVelZ, normalT2, normalVel1);
+				normalVel2 = V8MulAdd(raXnZ, b0.angStateZ, normalVel2);
+				normalVel3 = V8MulAdd(b1.linVelZ, normalT2, normalVel3);
+				normalVel4 = V8MulAdd(rbXnZ, b1.angStateZ, normalVel4);
+
+				const Vec8V _normalVel = V8Add(normalVel1, normalVel2);
+				const Vec8V __normalVel = V8Add(normalVel3, normalVel4);
+
+				const Vec8V normalVel = V8Sub(_normalVel, __normalVel);
+
+				const Vec8V tmp1 = V8Sub(appliedForce, V8Load2(f0.scaledBias, f1.scaledBias));
+
+				const Vec8V totalImpulse = V8NegMulSub(normalVel, V8Load2(f0.velMultiplier, f1.velMultiplier), tmp1);
+
+				broken = V8Or(broken, V8IsGrtr(V8Abs(totalImpulse), maxFrictionImpulse));
+
+				const Vec8V newAppliedForce = V8Sel(broken, V8Min(maxDynFrictionImpulse, V8Max(negMaxDynFrictionImpulse, totalImpulse)), totalImpulse);
+
+				const Vec8V deltaF = V8Sub(newAppliedForce, appliedForce);
+
+				V8Store2(newAppliedForce, appliedForce0, appliedForce1);
+
+				const Vec8V deltaFIM0 = V8Mul(deltaF, invMassA);
+				const Vec8V deltaFIM1 = V8Mul(deltaF, invMassB);
+
+				const Vec8V angDetaF0 = V8Mul(deltaF, angD0);
+				const Vec8V angDetaF1 = V8Mul(deltaF, angD1);
+
+				b0.linVelX = V8MulAdd(normalT0, deltaFIM0, b0.linVelX);
+				b1.linVelX = V8NegMulSub(normalT0, deltaFIM1, b1.linVelX);
+				b0.angStateX = V8MulAdd(raXnX, angDetaF0, b0.angStateX);
+				b1.angStateX = V8NegMulSub(rbXnX, angDetaF1, b1.angStateX);
+
+				b0.linVelY = V8MulAdd(normalT1, deltaFIM0, b0.linVelY);
+				b1.linVelY = V8NegMulSub(normalT1, deltaFIM1, b1.linVelY);
+				b0.angStateY = V8MulAdd(raXnY, angDetaF0, b0.angStateY);
+				b1.angStateY = V8NegMulSub(rbXnY, angDetaF1, b1.angStateY);
+
+				b0.linVelZ = V8MulAdd(normalT2, deltaFIM0, b0.linVelZ);
+				b1.linVelZ = V8NegMulSub(normalT2, deltaFIM1, b1.linVelZ);
+				b0.angStateZ = V8MulAdd(raXnZ, angDetaF0, b0.angStateZ);
+				b1.angStateZ = V8NegMulSub(rbXnZ, angDetaF1, b1.angStateZ);
+			}
+			fd0->broken = V8GetLo(broken);
+			fd1->broken = V8GetHi(broken);
+		}
+	}
+
+	storeSolverBodies8(bodies0, b0, 0xff);
+	storeSolverBodies8(bodies1, b1, storeMask1);
+}
+
+DY_AVX_TARGET static void solveContact8_StaticBlock(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache)
+{
+	PxSolverBody* bodies0[8];
+	for(PxU32 i=0; i<8; i++)
+	{
+		PX_ASSERT(*desc[i].constraint == DY_SC_TYPE_BLOCK_STATIC_RB_CONTACT);
+		bodies0[i] = desc[i].bodyA;
+	}
+
+	SolverBodies8 b0;
+	loadSolverBodies8(bodies0, b0);
+
+	const Vec8V vZero = V8Zero();
+
+	Vec4V sink[2];
+	SolverFrictionSharedData4 dummyFd[2];
+	PxMemZero(sink, sizeof(sink));
+	PxMemZero(dummyFd, sizeof(dummyFd));
+
+	ContactBlockCursor4<SolverContactBatchPointBase4, SolverContactFrictionBase4> blocks[2];
+	blocks[0].init(desc[0], &sink[0], &dummyFd[0]);
+	blocks[1].init(desc[4], &sink[1], &dummyFd[1]);
+
+	const Vec8V invMass0 = V8Load2(blocks[0].mHdr->invMass0D0, blocks[1].mHdr->invMass0D0);
+
+	while(blocks[0].hasHeaders() || blocks[1].hasHeaders())
+	{
+		blocks[0].nextHeader();
+		blocks[1].nextHeader();
+
+		const SolverContactHeader4* PX_RESTRICT hdr0 = blocks[0].mHdr;
+		const SolverContactHeader4* PX_RESTRICT hdr1 = blocks[1].mHdr;
+
+		const PxU32 numNormalConstr = PxMax(blocks[0].mNumNormalConstr, blocks[1].mNumNormalConstr);
+		const PxU32 numFrictionConstr = PxMax(blocks[0].mNumFrictionConstr, blocks[1].mNumFrictionConstr);
+
+		if(blocks[0].mNumNormalConstr)
+			Ps::prefetchLine(blocks[0].mContacts, 128);
+		if(blocks[1].mNumNormalConstr)
+			Ps::prefetchLine(blocks[1].mContacts, 128);
+
+		Vec8V accumulatedNormalImpulse = vZero;
+
+		const Vec8V angD0 = V8Load2(hdr0->angDom0, hdr1->angDom0);
+		const Vec8V _normalT0 = V8Load2(hdr0->normalX, hdr1->normalX);
+		const Vec8V _normalT1 = V8Load2(hdr0->normalY, hdr1->normalY);
+		const Vec8V _normalT2 = V8Load2(hdr0->normalZ, hdr1->normalZ);
+
+		Vec8V contactNormalVel1 = V8Mul(b0.linVelX, _normalT0);
+		contactNormalVel1 = V8MulAdd(b0.linVelY, _normalT1, contactNormalVel1);
+		contactNormalVel1 = V8MulAdd(b0.linVelZ, _normalT2, contactNormalVel1);
+
+		Vec8V accumDeltaF = vZero;
+
+		for(PxU32 i=0;i<numNormalConstr;i++)
+		{
+			const SolverContactBatchPointBase4& c0 = blocks[0].getContact(i);
+			const SolverContactBatchPointBase4& c1 = blocks[1].getContact(i);
+			Vec4V& appliedForce0 = blocks[0].getAppliedForce(i);
+			Vec4V& appliedForce1 = blocks[1].getAppliedForce(i);
+
+			Ps::prefetchLine(&c0 + 1);
+			Ps::prefetchLine(&c1 + 1);
+
+			const Vec8V raXnX = V8Load2(c0.raXnX, c1.raXnX);
+			const Vec8V raXnY = V8Load2(c0.raXnY, c1.raXnY);
+			const Vec8V raXnZ = V8Load2(c0.raXnZ, c1.raXnZ);
+
+			const Vec8V appliedForce = V8Load2(appliedForce0, appliedForce1);
+			const Vec8V maxImpulse = V8Load2(c0.maxContactImpulse, c1.maxContactImpulse);
+			Vec8V contactNormalVel2 = V8MulAdd(raXnX, b0.angStateX, contactNormalVel1);
+			contactNormalVel2 = V8MulAdd(raXnY, b0.angStateY, contactNormalVel2);
+			const Vec8V normalVel = V8MulAdd(raXnZ, b0.angStateZ, contactNormalVel2);
+
+			const Vec8V _deltaF = V8Max(V8NegMulSub(normalVel, V8Load2(c0.velMultiplier, c1.velMultiplier), V8Load2(c0.biasedErr, c1.biasedErr)), V8Neg(appliedForce));
+
+			Vec8V newAppliedForce(V8Add(appliedForce, _deltaF));
+			newAppliedForce = V8Min(newAppliedForce, maxImpulse);
+			const Vec8V deltaF = V8Sub(newAppliedForce, appliedForce);
+			const Vec8V angDeltaF = V8Mul(angD0, deltaF);
+
+			accumDeltaF = V8Add(accumDeltaF, deltaF);
+
+			contactNormalVel1 = V8MulAdd(invMass0, deltaF, contactNormalVel1);
+			b0.angStateX = V8MulAdd(raXnX, angDeltaF, b0.angStateX);
+			b0.angStateY = V8MulAdd(raXnY, angDeltaF, b0.angStateY);
+			b0.angStateZ = V8MulAdd(raXnZ, angDeltaF, b0.angStateZ);
+
+			V8Store2(newAppliedForce, appliedForce0, appliedForce1);
+
+			accumulatedNormalImpulse = V8Add(accumulatedNormalImpulse, newAppliedForce);
+		}
+
+		const Vec8V deltaFInvMass0 = V8Mul(accumDeltaF, invMass0);
+
+		b0.linVelX = V8MulAdd(_normalT0, deltaFInvMass0, b0.linVelX);
+		b0.linVelY = V8MulAdd(_normalT1, deltaFInvMass0, b0.linVelY);
+		b0.linVelZ = V8MulAdd(_normalT2, deltaFInvMass0, b0.linVelZ);
+
+		if(cache.doFriction && numFrictionConstr)
+		{
+			SolverFrictionSharedData4* PX_RESTRICT fd0 = blocks[0].mFd;
+			SolverFrictionSharedData4* PX_RESTRICT fd1 = blocks[1].mFd;
+
+			const Vec8V staticFric = V8Load2(hdr0->staticFriction, hdr1->staticFriction);
+			const Vec8V dynamicFric = V8Load2(hdr0->dynamicFriction, hdr1->dynamicFriction);
+
+			const Vec8V maxFrictionImpulse = V8Mul(staticFric, accumulatedNormalImpulse);
+			const Vec8V maxDynFrictionImpulse = V8Mul(dynamicFric, accumulatedNormalImpulse);
+			const Vec8V negMaxDynFrictionImpulse = V8Neg(maxDynFrictionImpulse);
+
+			Vec8V broken = vZero;
+
+			for(PxU32 i=0;i<numFrictionConstr;i++)
+			{
+				const SolverContactFrictionBase4& f0 = blocks[0].getFriction(i);
+				const SolverContactFrictionBase4& f1 = blocks[1].getFriction(i);
+				Vec4V& appliedForce0 = blocks[0].getFrictionAppliedForce(i);
+				Vec4V& appliedForce1 = blocks[1].getFrictionAppliedForce(i);
+
+				Ps::prefetchLine(&f0 + 1);
+				Ps::prefetchLine(&f1 + 1);
+
+				const Vec8V raXnX = V8Load2(f0.raXnX, f1.raXnX);
+				const Vec8V raXnY = V8Load2(f0.raXnY, f1.raXnY);
+				const Vec8V raXnZ = V8Load2(f0.raXnZ, f1.raXnZ);
+
+				const Vec8V appliedForce = V8Load2(appliedForce0, appliedForce1);
+
+				const Vec8V normalT0 = V8Load2(fd0->normalX[i&1], fd1->normalX[i&1]);
+				const Vec8V normalT1 = V8Load2(fd0->normalY[i&1], fd1->normalY[i&1]);
+				const Vec8V normalT2 = V8Load2(fd0->normalZ[i&1], fd1->normalZ[i&1]);
+
+				Vec8V normalVel1 = V8Mul(b0.linVelX, normalT0);
+				Vec8V normalVel2 = V8Mul(raXnX, b0.angStateX);
+
+				normalVel1 = V8MulAdd(b0.linVelY, normalT1, normalVel1);
+				normalVel2 = V8MulAdd(raXnY, b0.angStateY, normalVel2);
+
+				normalVel1 = V8MulAdd(b0.linVelZ, normalT2, normalVel1);
+				normalVel2 = V8MulAdd(raXnZ, b0.angStateZ, normalVel2);
+
+				const Vec8V normalVel = V8Add(normalVel1, normalVel2);
+
+				const Vec8V tmp1 = V8Sub(appliedForce, V8Load2(f0.scaledBias, f1.scaledBias));
+
+				const Vec8V totalImpulse = V8NegMulSub(normalVel, V8Load2(f0.velMultiplier, f1.velMultiplier), tmp1);
+
+				broken = V8Or(broken, V8IsGrtr(V8Abs(totalImpulse), maxFrictionImpulse));
+
+				const Vec8V newAppliedForce = V8Sel(broken, V8Min(maxDynFrictionImpulse, V8Max(negMaxDynFrictionImpulse, totalImpulse)), totalImpulse);
+
+				const Vec8V deltaF = V8Sub(newAppliedForce, appliedForce);
+
+				const Vec8V deltaFInvMass = V8Mul(invMass0, deltaF);
+				const Vec8V angDeltaF = V8Mul(angD0, deltaF);
+
+				b0.linVelX = V8MulAdd(normalT0, deltaFInvMass, b0.linVelX);
+				b0.angStateX = V8MulAdd(raXnX, angDeltaF, b0.angStateX);
+
+				b0.linVelY = V8MulAdd(normalT1, deltaFInvMass, b0.linVelY);
+				b0.angStateY = V8MulAdd(raXnY, angDeltaF, b0.angStateY);
+
+				b0.linVelZ = V8MulAdd(normalT2, deltaFInvMass, b0.linVelZ);
+				b0.angStateZ = V8MulAdd(raXnZ, angDeltaF, b0.angStateZ);
+
+				V8Store2(newAppliedForce, appliedForce0, appliedForce1);
+			}
+
+			fd0->broken = V8GetLo(broken);
+			fd1->broken = V8GetHi(broken);
+		}
+	}
+
+	storeSolverBodies8(bodies0, b0, 0xff);
+}
+
+DY_AVX_TARGET static void solve1D8_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& /*cache*/)
+{
+	PxSolverBody* bodies0[8];
+	PxSolverBody* bodies1[8];
+	for(PxU32 i=0; i<8; i++)
+	{
+		bodies0[i] = desc[i].bodyA;
+		bodies1[i] = desc[i].bodyB;
+	}
+
+	SolverBodies8 b0, b1;
+	loadSolverBodies8(bodies0, b0);
+	loadSolverBodies8(bodies1, b1);
+
+	const SolverConstraint1DHeader4* PX_RESTRICT header0 = reinterpret_cast<const SolverConstraint1DHeader4*>(desc[0].constraint);
+	const SolverConstraint1DHeader4* PX_RESTRICT header1 = reinterpret_cast<const SolverConstraint1DHeader4*>(desc[4].constraint);
+	PX_ASSERT(header0->type == DY_SC_TYPE_BLOCK_1D && header1->type == DY_SC_TYPE_BLOCK_1D);
+
+	SolverConstraint1DDynamic4* PX_RESTRICT base0 = reinterpret_cast<SolverConstraint1DDynamic4*>(const_cast<SolverConstraint1DHeader4*>(header0) + 1);
+	SolverConstraint1DDynamic4* PX_RESTRICT base1 = reinterpret_cast<SolverConstraint1DDynamic4*>(const_cast<SolverConstraint1DHeader4*>(header1) + 1);
+
+	const Vec8V invMass0D0 = V8Load2(header0->invMass0D0, header1->invMass0D0);
+	const Vec8V invMass1D1 = V8Load2(header0->invMass1D1, header1->invMass1D1);
+
+	const Vec8V angD0 = V8Load2(header0->angD0, header1->angD0);
+	const Vec8V angD1 = V8Load2(header0->angD1, header1->angD1);
+
+	const PxU32 count0 = header0->count;
+	const PxU32 count1 = header1->count;
+	const PxU32 maxConstraints = PxMax(count0, count1);
+
+	Vec4V sink[2];
+	PxMemZero(sink, sizeof(sink));
+
+	const SolverConstraint1DDynamic4& zeroRow = getSolverBatch8ZeroData<SolverConstraint1DDynamic4>();
+
+	for(PxU32 a = 0; a < maxConstraints; ++a)
+	{
+		const SolverConstraint1DDynamic4& c0 = a < count0 ? base0[a] : zeroRow;
+		const SolverConstraint1DDynamic4& c1 = a < count1 ? base1[a] : zeroRow;
+		Vec4V& appliedForce0 = a < count0 ? base0[a].appliedForce : sink[0];
+		Vec4V& appliedForce1 = a < count1 ? base1[a].appliedForce : sink[1];
+
+		Ps::prefetchLine(&c0 + 1);
+		Ps::prefetchLine(&c0 + 1, 128);
+		Ps::prefetchLine(&c0 + 1, 256);
+		Ps::prefetchLine(&c1 + 1);
+		Ps::prefetchLine(&c1 + 1, 128);
+		Ps::prefetchLine(&c1 + 1, 256);
+
+		const Vec8V lin0X = V8Load2(c0.lin0X, c1.lin0X);
+		const Vec8V lin0Y = V8Load2(c0.lin0Y, c1.lin0Y);
+		const Vec8V lin0Z = V8Load2(c0.lin0Z, c1.lin0Z);
+		const Vec8V lin1X = V8Load2(c0.lin1X, c1.lin1X);
+		const Vec8V lin1Y = V8Load2(c0.lin1Y, c1.lin1Y);
+		const Vec8V lin1Z = V8Load2(c0.lin1Z, c1.lin1Z);
+		const Vec8V ang0X = V8Load2(c0.ang0X, c1.ang0X);
+		const Vec8V ang0Y = V8Load2(c0.ang0Y, c1.ang0Y);
+		const Vec8V ang0Z = V8Load2(c0.ang0Z, c1.ang0Z);
+		const Vec8V ang1X = V8Load2(c0.ang1X, c1.ang1X);
+		const Vec8V ang1Y = V8Load2(c0.ang1Y, c1.ang1Y);
+		const Vec8V ang1Z = V8Load2(c0.ang1Z, c1.ang1Z);
+
+		const Vec8V appliedForce = V8Load2(appliedForce0, appliedForce1);
+
+		Vec8V linProj0(V8Mul(lin0X, b0.linVelX));
+		Vec8V linProj1(V8Mul(lin1X, b1.linVelX));
+		Vec8V angProj0(V8Mul(ang0X, b0.angStateX));
+		Vec8V angProj1(V8Mul(ang1X, b1.angStateX));
+
+		linProj0 = V8MulAdd(lin0Y, b0.linVelY, linProj0);
+		linProj1 = V8MulAdd(lin1Y, b1.linVelY, linProj1);
+		angProj0 = V8MulAdd(ang0Y, b0.angStateY, angProj0);
+		angProj1 = V8MulAdd(ang1Y, b1.angStateY, angProj1);
+
+		linProj0 = V8MulAdd(lin0Z, b0.linVelZ, linProj0);
+		linProj1 = V8MulAdd(lin1Z, b1.linVelZ, linProj1);
+		angProj0 = V8MulAdd(ang0Z, b0.angStateZ, angProj0);
+		angProj1 = V8MulAdd(ang1Z, b1.angStateZ, angProj1);
+
+		const Vec8V projectVel0 = V8Add(linProj0, angProj0);
+		const Vec8V projectVel1 = V8Add(linProj1, angProj1);
+
+		const Vec8V normalVel = V8Sub(projectVel0, projectVel1);
+
+		const Vec8V unclampedForce = V8MulAdd(appliedForce, V8Load2(c0.impulseMultiplier, c1.impulseMultiplier),
+			V8MulAdd(normalVel, V8Load2(c0.velMultiplier, c1.velMultiplier), V8Load2(c0.constant, c1.constant)));
+		const Vec8V clampedForce = V8Max(V8Load2(c0.minImpulse, c1.minImpulse), V8Min(V8Load2(c0.maxImpulse, c1.maxImpulse), unclampedForce));
+		const Vec8V deltaF = V8Sub(clampedForce, appliedForce);
+		V8Store2(clampedForce, appliedForce0, appliedForce1);
+
+		const Vec8V deltaFInvMass0 = V8Mul(deltaF, invMass0D0);
+		const Vec8V deltaFInvMass1 = V8Mul(deltaF, invMass1D1);
+
+		const Vec8V angDeltaFInvMass0 = V8Mul(deltaF, angD0);
+		const Vec8V angDeltaFInvMass1 = V8Mul(deltaF, angD1);
+
+		b0.linVelX = V8MulAdd(lin0X, deltaFInvMass0, b0.linVelX);
+		b1.linVelX = V8NegMulSub(lin1X, deltaFInvMass1, b1.linVelX);
+		b0.angStateX = V8MulAdd(ang0X, angDeltaFInvMass0, b0.angStateX);
+		b1.angStateX = V8NegMulSub(ang1X, angDeltaFInvMass1, b1.angStateX);
+
+		b0.linVelY = V8MulAdd(lin0Y, deltaFInvMass0, b0.linVelY);
+		b1.linVelY = V8NegMulSub(lin1Y, deltaFInvMass1, b1.linVelY);
+		b0.angStateY = V8MulAdd(ang0Y, angDeltaFInvMass0, b0.angStateY);
+		b1.angStateY = V8NegMulSub(ang1Y, angDeltaFInvMass1, b1.angStateY);
+
+		b0.linVelZ = V8MulAdd(lin0Z, deltaFInvMass0, b0.linVelZ);
+		b1.linVelZ = V8NegMulSub(lin1Z, deltaFInvMass1, b1.linVelZ);
+		b0.angStateZ = V8MulAdd(ang0Z, angDeltaFInvMass0, b0.angStateZ);
+		b1.angStateZ = V8NegMulSub(ang1Z, angDeltaFInvMass1, b1.angStateZ);
+	}
+
+	storeSolverBodies8(bodies0, b0, 0xff);
+	storeSolverBodies8(bodies1, b1, 0xff);
+}
+
+#else
+
+bool isSolverBatch8Supported()
+{
+	return false;
+}
+
+static void solveContact8_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache)
+{
+	solveContact4_Block(desc, cache);
+	solveContact4_Block(desc + 4, cache);
+}
+
+static void solveContact8_StaticBlock(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache)
+{
+	solveContact4_StaticBlock(desc, cache);
+	solveContact4_StaticBlock(desc + 4, cache);
+}
+
+static void solve1D8_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache)
+{
+	solve1D4_Block(desc, cache);
+	solve1D4_Block(desc + 4, cache);
+}
+
+#endif
+
 void writeBack1D4(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& /*cache*/,
 							 const PxSolverBodyData** PX_RESTRICT /*bd0*/, const PxSolverBodyData** PX_RESTRICT /*bd1*/)
 {
@@ -1060,30 +1838,58 @@ void writeBack1D4(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext&
 }
 
 
-void solveContactPreBlock(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 /*constraintCount*/, SolverContext& cache)
+// Block headers have a stride of 4, or 8 when two blocks of the same partition were paired to be solved with AVX.
+// The writeback iteration always processes the two blocks of a pair one after the other.
+
+void solveContactPreBlock(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache)
 {
-	solveContact4_Block(desc, cache);
+	if(constraintCount == 8)
+		solveContact8_Block(desc, cache);
+	else
+		solveContact4_Block(desc, cache);
 }
 
-void solveContactPreBlock_Static(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32  /*constraintCount*/, SolverContext& cache)
+void solveContactPreBlock_Static(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache)
 {
-	solveContact4_StaticBlock(desc, cache);
+	if(constraintCount == 8)
+		solveContact8_StaticBlock(desc, cache);
+	else
+		solveContact4_StaticBlock(desc, cache);
 }
 
-void solveContactPreBlock_Conclude(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32  /*constraintCount*/, SolverContext& cache)
+void solveContactPreBlock_Conclude(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache)
 {
-	solveContact4_Block(desc, cache);
+	if(constraintCount == 8)
+	{
+		solveContact8_Block(desc, cache);
+		concludeContact4_Block(desc + 4, cache, sizeof(SolverContactBatchPointDynamic4), sizeof(SolverContactFrictionDynamic4));
+	}
+	else
+		solveContact4_Block(desc, cache);
 	concludeContact4_Block(desc, cache, sizeof(SolverContactBatchPointDynamic4), sizeof(SolverContactFrictionDynamic4));
 }
 
-void solveContactPreBlock_ConcludeStatic(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32  /*constraintCount*/, SolverContext& cache)
+void solveContactPreBlock_ConcludeStatic(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache)
 {
-	solveContact4_StaticBlock(desc, cache);
+	if(constraintCount == 8)
+	{
+		solveContact8_StaticBlock(desc, cache);
+		concludeContact4_Block(desc + 4, cache, sizeof(SolverContactBatchPointBase4), sizeof(SolverContactFrictionBase4));
+	}
+	else
+		solveContact4_StaticBlock(desc, cache);
 	concludeContact4_Block(desc, cache, sizeof(SolverContactBatchPointBase4), sizeof(SolverContactFrictionBase4));
 }
 
-void solveContactPreBlock_WriteBack(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32  /*constraintCount*/, SolverContext& cache)
+void solveContactPreBlock_WriteBack(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache)
 {
+	if(constraintCount == 8)
+	{
+		solveContactPreBlock_WriteBack(desc, 4, cache);
+		solveContactPreBlock_WriteBack(desc + 4, 4, cache);
+		return;
+	}
+
 	solveContact4_Block(desc, cache);
 
 	const PxSolverBodyData* bd0[4] = {	&cache.solverBodyArray[desc[0].bodyADataIndex], 
@@ -1110,8 +1916,15 @@ void solveContactPreBlock_WriteBack(const PxSolverConstraintDesc* PX_RESTRICT de
 	}
 }
 
-void solveContactPreBlock_WriteBackStatic(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32  /*constraintCount*/, SolverContext& cache)
+void solveContactPreBlock_WriteBackStatic(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache)
 {
+	if(constraintCount == 8)
+	{
+		solveContactPreBlock_WriteBackStatic(desc, 4, cache);
+		solveContactPreBlock_WriteBackStatic(desc + 4, 4, cache);
+		return;
+	}
+
 	solveContact4_StaticBlock(desc, cache);
 	const PxSolverBodyData* bd0[4] = {	&cache.solverBodyArray[desc[0].bodyADataIndex], 
 										&cache.solverBodyArray[desc[1].bodyADataIndex],
@@ -1137,21 +1950,37 @@ void solveContactPreBlock_WriteBackStatic(const PxSolverConstraintDesc* PX_RESTR
 	}
 }
 
-void solve1D4_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32  /*constraintCount*/, SolverContext& cache)
+void solve1D4_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache)
 {
-	solve1D4_Block(desc, cache);
+	if(constraintCount == 8)
+		solve1D8_Block(desc, cache);
+	else
+		solve1D4_Block(desc, cache);
 }
 
 
-void solve1D4Block_Conclude(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32  /*constraintCount*/, SolverContext& cache)
+void solve1D4Block_Conclude(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache)
 {
-	solve1D4_Block(desc, cache);
+	if(constraintCount == 8)
+	{
+		solve1D8_Block(desc, cache);
+		conclude1D4_Block(desc + 4, cache);
+	}
+	else
+		solve1D4_Block(desc, cache);
 	conclude1D4_Block(desc, cache);
 }
 
 
-void solve1D4Block_WriteBack(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32  /*constraintCount*/, SolverContext& cache)
+void solve1D4Block_WriteBack(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache)
 {
+	if(constraintCount == 8)
+	{
+		solve1D4Block_WriteBack(desc, 4, cache);
+		solve1D4Block_WriteBack(desc + 4, 4, cache);
+		return;
+	}
+
 	solve1D4_Block(desc, cache);
 
 	const PxSolverBodyData* bd0[4] = {	&cache.solverBodyArray[desc[0].bodyADataIndex], 
@@ -1167,8 +1996,15 @@ void solve1D4Block_WriteBack(const PxSolverConstraintDesc* PX_RESTRICT desc, con
 	writeBack1D4(desc, cache, bd0, bd1);
 }
 
-void writeBack1D4Block(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32  /*constraintCount*/, SolverContext& cache)
+void writeBack1D4Block(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache)
 {
+	if(constraintCount == 8)
+	{
+		writeBack1D4Block(desc, 4, cache);
+		writeBack1D4Block(desc + 4, 4, cache);
+		return;
+	}
+
 	const PxSolverBodyData* bd0[4] = {	&cache.solverBodyArray[desc[0].bodyADataIndex], 
 										&cache.solverBodyArray[desc[1].bodyADataIndex],
 										&cache.solverBodyArray[desc[2].bodyADataIndex],
@@ -45,6 +45,8 @@
 #include "PsThread.h"
 #include "DySolverConstraintDesc.h"
 #include "DySolverContext.h"
+#include "DySolverFma.h"
+#include "PsCpu.h"
 
 namespace physx
 {
@@ -152,6 +154,45 @@ void SolverCoreRegisterArticulationFns()
 	gVTableSolveConcludeBlock[DY_SC_TYPE_EXT_1D] = solveExt1DConcludeBlock;
 }
 
+#if PX_DY_FMA_SOLVER
+namespace fma
+{
+void solve1DBlock						(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache);
+void solveContactBlock					(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache);
+void solveContact_BStaticBlock			(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache);
+void solve1DConcludeBlock				(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache);
+void solveContactConcludeBlock			(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache);
+void solveContact_BStaticConcludeBlock	(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache);
+void solve1DBlockWriteBack				(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache);
+void solveContactBlockWriteBack			(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache);
+void solveContact_BStaticBlockWriteBack	(const PxSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, SolverContext& cache);
+}
+#endif
+
+// Swaps in the AVX2+FMA build of the rigid body PGS kernels when the CPU and OS support it.
+void SolverCoreRegisterFmaFns()
+{
+#if PX_DY_FMA_SOLVER
+	if(!Ps::Cpu::hasAvx2Fma())
+		return;
+
+	gVTableSolveBlock[DY_SC_TYPE_RB_CONTACT] = fma::solveContactBlock;
+	gVTableSolveBlock[DY_SC_TYPE_RB_1D] = fma::solve1DBlock;
+	gVTableSolveBlock[DY_SC_TYPE_STATIC_CONTACT] = fma::solveContact_BStaticBlock;
+	gVTableSolveBlock[DY_SC_TYPE_NOFRICTION_RB_CONTACT] = fma::solveContactBlock;
+
+	gVTableSolveWriteBackBlock[DY_SC_TYPE_RB_CONTACT] = fma::solveContactBlockWriteBack;
+	gVTableSolveWriteBackBlock[DY_SC_TYPE_RB_1D] = fma::solve1DBlockWriteBack;
+	gVTableSolveWriteBackBlock[DY_SC_TYPE_STATIC_CONTACT] = fma::solveContact_BStaticBlockWriteBack;
+	gVTableSolveWriteBackBlock[DY_SC_TYPE_NOFRICTION_RB_CONTACT] = fma::solveContactBlockWriteBack;
+
+	gVTableSolveConcludeBlock[DY_SC_TYPE_RB_CONTACT] = fma::solveContactConcludeBlock;
+	gVTableSolveConcludeBlock[DY_SC_TYPE_RB_1D] = fma::solve1DConcludeBlock;
+	gVTableSolveConcludeBlock[DY_SC_TYPE_STATIC_CONTACT] = fma::solveContact_BStaticConcludeBlock;
+	gVTableSolveConcludeBlock[DY_SC_TYPE_NOFRICTION_RB_CONTACT] = fma::solveContactConcludeBlock;
+#endif
+}
+
 
 SolveBlockMethod* getSolveBlockTable()
 {
@@ -188,6 +229,23 @@ void SolverCoreGeneral::destroyV()
 	PX_FREE(this);
 }
 
+// Compares the bodies' velocities against the snapshot taken after the previous iteration and replaces the snapshot.
+// Returns true if no linear or angular velocity changed by more than the tolerance.
+static bool hasConverged(const PxSolverBody* PX_RESTRICT bodies, const PxU32 nbBodies, Cm::SpatialVector* PX_RESTRICT lastVelocities, const PxReal toleranceSq)
+{
+	bool converged = true;
+	for(PxU32 a = 0; a < nbBodies; ++a)
+	{
+		const PxSolverBody& body = bodies[a];
+		Cm::SpatialVector& lastVel = lastVelocities[a];
+		if((body.linearVelocity - lastVel.linear).magnitudeSquared() > toleranceSq || (body.angularState - lastVel.angular).magnitudeSquared() > toleranceSq)
+			converged = false;
+		lastVel.linear = body.linearVelocity;
+		lastVel.angular = body.angularState;
+	}
+	return converged;
+}
+
 void SolverCoreGeneral::solveV_Blocks(SolverIslandParams& params) const
 {
 
@@ -219,8 +277,15 @@ void SolverCoreGeneral::solveV_Blocks(SolverIslandParams& params) const
 	PX_ASSERT(velocityIterations >= 1);
 	PX_ASSERT(positionIterations >= 1);
 
+	//Only set if the island is allowed to stop iterating once converged
+	Cm::SpatialVector* PX_RESTRICT residualVelocityArray = params.residualVelocityArray;
+	const PxReal residualToleranceSq = params.residualTolerance * params.residualTolerance;
+
 	if(numConstraintHeaders == 0)
 	{
+		params.positionIterationsUsed = 0;
+		params.velocityIterationsUsed = 0;
+
 		for (PxU32 baIdx = 0; baIdx < bodyListSize; baIdx++)
 		{
 			Cm::SpatialVector& motionVel = motionVelocityArray[baIdx];
@@ -240,6 +305,15 @@ void SolverCoreGeneral::solveV_Blocks(SolverIslandParams& params) const
 
 	PxSolverConstraintDesc* PX_RESTRICT constraintList = params.constraintList;
 
+	if(residualVelocityArray)
+	{
+		for (PxU32 baIdx = 0; baIdx < bodyListSize; baIdx++)
+		{
+			residualVelocityArray[baIdx].linear = bodyListStart[baIdx].linearVelocity;
+			residualVelocityArray[baIdx].angular = bodyListStart[baIdx].angularState;
+		}
+	}
+
 	//0-(n-1) iterations
 	PxI32 normalIter = 0;
 
@@ -251,8 +325,14 @@ void SolverCoreGeneral::solveV_Blocks(SolverIslandParams& params) const
 			cache, contactIterator, iteration == 1 ? gVTableSolveConcludeBlock : gVTableSolveBlock, normalIter);
 
 		++normalIter;
+
+		//Once converged, skip ahead to the last 3 iterations, which apply friction and conclude
+		if(residualVelocityArray && iteration > 4 && hasConverged(bodyListStart, bodyListSize, residualVelocityArray, residualToleranceSq))
+			iteration = 4;
 	}
 
+	params.positionIterationsUsed = PxU32(normalIter);
+
 	for (PxU32 baIdx = 0; baIdx < bodyListSize; baIdx++)
 	{
 		const PxSolverBody& atom = bodyListStart[baIdx];
@@ -270,6 +350,12 @@ void SolverCoreGeneral::solveV_Blocks(SolverIslandParams& params) const
 
 	PxI32 iteration = 0;
 
+	if(residualVelocityArray)
+	{
+		for (PxU32 baIdx = 0; baIdx < bodyListSize; baIdx++)
+			residualVelocityArray[baIdx] = motionVelocityArray[baIdx];
+	}
+
 	for(; iteration < velItersMinOne; ++iteration)
 	{	
 
@@ -277,6 +363,12 @@ void SolverCoreGeneral::solveV_Blocks(SolverIslandParams& params) const
 			cache, contactIterator, gVTableSolveBlock, normalIter);
 		++normalIter;
 
+		//Once converged, go straight to the write-back iteration
+		if(residualVelocityArray && hasConverged(bodyListStart, bodyListSize, residualVelocityArray, residualToleranceSq))
+		{
+			iteration = velItersMinOne;
+			break;
+		}
 	}
 
 	PxI32* outThresholdPairs = params.outThresholdPairs;
@@ -296,6 +388,8 @@ void SolverCoreGeneral::solveV_Blocks(SolverIslandParams& params) const
 
 	}	
 
+	params.velocityIterationsUsed = PxU32(normalIter) - params.positionIterationsUsed;
+
 	//Write back remaining threshold streams
 	if(cache.mThresholdStreamIndex > 0)
 	{
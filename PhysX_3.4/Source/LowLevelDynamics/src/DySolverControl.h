@@ -88,6 +88,19 @@ private:
 };
 
 
+PX_FORCE_INLINE void prefetchBatch(const PxSolverConstraintDesc* PX_RESTRICT constraintList, const PxConstraintBatchHeader& header)
+{
+	const PxSolverConstraintDesc* PX_RESTRICT block = &constraintList[header.mStartIndex];
+
+	Ps::prefetch(block[0].constraint, 384);
+
+	for(PxU32 b = 0; b < header.mStride; ++b)
+	{
+		Ps::prefetchLine(block[b].bodyA);
+		Ps::prefetchLine(block[b].bodyB);
+	}
+}
+
 inline void SolveBlockParallel	(PxSolverConstraintDesc* PX_RESTRICT constraintList, const PxI32 batchCount, const PxI32 index,  
 						 const PxI32 headerCount, SolverContext& cache, BatchIterator& iterator,
 						 SolveBlockMethod solveTable[],
@@ -99,6 +112,12 @@ inline void SolveBlockParallel	(PxSolverConstraintDesc* PX_RESTRICT constraintLi
 	const PxConstraintBatchHeader* PX_RESTRICT headers = iterator.constraintBatchHeaders;
 
 	const PxI32 endIndex = indA + batchCount;
+
+	//The bodies of a batch are scattered over the solver body array, so the next batch is prefetched while the current one is
+	//solved to hide the latency of gathering them.
+	if(indA < endIndex)
+		prefetchBatch(constraintList, headers[indA]);
+
 	for(PxI32 i = indA; i < endIndex; ++i)
 	{
 		const PxConstraintBatchHeader& header = headers[i];
@@ -106,13 +125,8 @@ inline void SolveBlockParallel	(PxSolverConstraintDesc* PX_RESTRICT constraintLi
 		const PxI32 numToGrab = header.mStride;
 		PxSolverConstraintDesc* PX_RESTRICT block = &constraintList[header.mStartIndex];
 
-		Ps::prefetch(block[0].constraint, 384);
-
-		for(PxI32 b = 0; b < numToGrab; ++b)
-		{
-			Ps::prefetchLine(block[b].bodyA);
-			Ps::prefetchLine(block[b].bodyB);
-		}
+		if((i + 1) < endIndex)
+			prefetchBatch(constraintList, headers[i + 1]);
 
 		//OK. We have a number of constraints to run...
 		solveTable[header.mConstraintType](block, PxU32(numToGrab), cache);
@@ -158,6 +172,9 @@ SolveBlockMethod* getSolverConcludeBlockTable();
 
 SolveWriteBackBlockMethod* getSolveWritebackBlockTable();
 
+// True if batch headers covering two 4-wide blocks (mStride == 8) can be solved with AVX on this CPU.
+bool isSolverBatch8Supported();
+
 
 }
 
@@ -199,6 +199,14 @@ struct SolverIslandParams
 	PxU32 thresholdStreamLength;
 
 	PxI32* outThresholdPairs;
+
+	//Adaptive iteration params. residualVelocityArray is NULL if the island always runs the configured counts.
+	PxReal residualTolerance;
+	Cm::SpatialVector* PX_RESTRICT residualVelocityArray;
+
+	//Iteration counts actually run by the solver core
+	PxU32 positionIterationsUsed;
+	PxU32 velocityIterationsUsed;
 };
 
 
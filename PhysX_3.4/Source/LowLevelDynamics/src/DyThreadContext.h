@@ -46,6 +46,7 @@
 #include "DyFrictionPatchStreamPair.h"
 #include "PxcConstraintBlockStream.h"
 #include "DyCorrelationBuffer.h"
+#include "PxSimulationStatistics.h"
 
 namespace physx
 {
@@ -80,13 +81,19 @@ public:
 			numActiveKinematicBodies = 0;
 			numAxisSolverConstraints = 0;
 
+			for(PxU32 a = 0; a < PxSimulationStatistics::eSOLVER_ITERATION_HISTOGRAM_SIZE; ++a)
+			{
+				numIslandsPerPositionIterations[a] = 0;
+				numIslandsPerVelocityIterations[a] = 0;
+			}
 		}
 
 		PxU32 numActiveConstraints;
 		PxU32 numActiveDynamicBodies;
 		PxU32 numActiveKinematicBodies;
 		PxU32 numAxisSolverConstraints;
-
+		PxU32 numIslandsPerPositionIterations[PxSimulationStatistics::eSOLVER_ITERATION_HISTOGRAM_SIZE];
+		PxU32 numIslandsPerVelocityIterations[PxSimulationStatistics::eSOLVER_ITERATION_HISTOGRAM_SIZE];
 	};
 #endif
 
@@ -130,10 +137,15 @@ public:
 	Ps::Array<PxU32>					mConstraintsPerPartition;
 	Ps::Array<PxU32>					mFrictionConstraintsPerPartition;
 	Ps::Array<PxU32>					mPartitionNormalizationBitmap;
+	Ps::Array<PxU32>					mPartitionAssignments;
+	Ps::Array<PxU32>					mPartitionSubRangeIndices;
+	Ps::Array<PxU32>					mPartitionSubRangeAssignments;
+	Ps::Array<PxU32>					mPartitionSubRangeOffsets;
 	PxsBodyCore**						mBodyCoreArray;
 	PxsRigidBody**						mRigidBodyArray;
 	Articulation**						mArticulationArray;
 	Cm::SpatialVector*					motionVelocityArray;
+	Ps::Array<Cm::SpatialVector>		mResidualVelocities;	// per-body velocity snapshot used to detect convergence
 	PxU32*								bodyRemapTable;
 	PxU32*								mNodeIndexArray;
 
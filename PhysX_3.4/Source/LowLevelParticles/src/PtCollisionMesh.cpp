@@ -35,10 +35,12 @@
 #include "PtConstants.h"
 #include "GuBox.h"
 #include "GuMidphaseInterface.h"
+#include "PsVecMath.h"
 
 using namespace physx;
 using namespace Pt;
 using namespace Gu;
+using namespace physx::shdfnd::aos;
 
 //
 // Collide particle against mesh triangle
@@ -411,9 +413,90 @@ struct PxcContactCellMeshCallback : MeshHitCallback<PxRaycastHit>
 	PxcContactCellMeshCallback& operator=(const PxcContactCellMeshCallback&);
 };
 
+//
+// Triangles fetched once for a whole particle packet, shared by all cells or particles of the packet.
+// The vertices are stored as reported by the query (vertex space for triangle meshes, shape space for height fields),
+// the bounds are always in shape space.
+//
+struct PacketTriangleCache
+{
+	PxVec3 verts[PT_PACKET_TRIANGLE_CACHE_SIZE * 3];
+	PxBounds3 bounds[PT_PACKET_TRIANGLE_CACHE_SIZE];
+	PxU32 numTriangles;
+	bool overflow;
+
+	PacketTriangleCache() : numTriangles(0), overflow(false)
+	{
+	}
+
+	PX_FORCE_INLINE bool add(const PxVec3& v0, const PxVec3& v1, const PxVec3& v2, const PxBounds3& shapeBounds)
+	{
+		if(numTriangles == PT_PACKET_TRIANGLE_CACHE_SIZE)
+		{
+			overflow = true;
+			return false;
+		}
+
+		verts[numTriangles * 3] = v0;
+		verts[numTriangles * 3 + 1] = v1;
+		verts[numTriangles * 3 + 2] = v2;
+		bounds[numTriangles] = shapeBounds;
+		numTriangles++;
+		return true;
+	}
+
+	// Writes the indices of the cached triangles whose bounds overlap the given shape space bounds.
+	PX_FORCE_INLINE PxU32 overlap(PxU32* triangleIndices, const PxBounds3& shapeBounds) const
+	{
+		const Vec3V testMin = V3LoadU(shapeBounds.minimum);
+		const Vec3V testMax = V3LoadU(shapeBounds.maximum);
+
+		PxU32 numOverlaps = 0;
+		for(PxU32 i = 0; i < numTriangles; ++i)
+		{
+			const Vec3V triMin = V3LoadU(bounds[i].minimum);
+			const Vec3V triMax = V3LoadU(bounds[i].maximum);
+			const BoolV isOverlap = BAnd(V3IsGrtrOrEq(testMax, triMin), V3IsGrtrOrEq(triMax, testMin));
+			triangleIndices[numOverlaps] = i;
+			numOverlaps += BAllEqTTTT(isOverlap);
+		}
+		return numOverlaps;
+	}
+
+  private:
+	PacketTriangleCache& operator=(const PacketTriangleCache&);
+};
+
+struct PxcPacketMeshCallback : MeshHitCallback<PxRaycastHit>
+{
+	PacketTriangleCache& triangleCache;
+	const Cm::FastVertex2ShapeScaling& meshScaling;
+
+	PxcPacketMeshCallback(PacketTriangleCache& triangleCache_, const Cm::FastVertex2ShapeScaling& meshScaling_)
+	: MeshHitCallback<PxRaycastHit>(CallbackMode::eMULTIPLE), triangleCache(triangleCache_), meshScaling(meshScaling_)
+	{
+	}
+	virtual ~PxcPacketMeshCallback()
+	{
+	}
+
+	virtual PxAgain processHit( // all reported coords are in mesh local space including hit.position
+	    const PxRaycastHit&, const PxVec3& v0, const PxVec3& v1, const PxVec3& v2, PxReal&, const PxU32*)
+	{
+		PxBounds3 shapeBounds = PxBounds3::boundsOfPoints(meshScaling * v0, meshScaling * v1);
+		shapeBounds.include(meshScaling * v2);
+
+		// stop the query once the cache is full, the caller then falls back to per cell queries
+		return triangleCache.add(v0, v1, v2, shapeBounds);
+	}
+
+  private:
+	PxcPacketMeshCallback& operator=(const PxcPacketMeshCallback&);
+};
+
 void testBoundsMesh(const TriangleMesh& meshData, const PxTransform& world2Shape,
                     const Cm::FastVertex2ShapeScaling& meshScaling, bool idtScaleMesh, const PxBounds3& worldBounds,
-                    PxcContactCellMeshCallback& callback)
+                    MeshHitCallback<PxRaycastHit>& callback)
 {
 	// Find colliding triangles.
 	// Setup an OBB for the fluid particle cell (in local space of shape)
@@ -501,7 +584,13 @@ void physx::Pt::collideCellsWithStaticMesh(ParticleCollData* collData, const Loc
 	if(!idtScaleMesh)
 		meshScaling.init(meshShapeData.scale);
 
-	// process the particle cells
+	// compute the bounds of the particle cells touching the mesh and of the whole packet
+	// (there are at most as many non-empty cells as particles)
+	PxBounds3 cellBoundsBuffer[PT_SUBPACKET_PARTICLE_LIMIT_COLLISION];
+	PxU32 cellIndices[PT_SUBPACKET_PARTICLE_LIMIT_COLLISION];
+	PxU32 numCells = 0;
+	PxBounds3 packetBounds(PxBounds3::empty());
+
 	for(PxU32 c = 0; c < localCellHash.numHashEntries; c++)
 	{
 		const ParticleCell& cell = localCellHash.hashEntries[c];
@@ -509,7 +598,7 @@ void physx::Pt::collideCellsWithStaticMesh(ParticleCollData* collData, const Loc
 		if(cell.numParticles == PX_INVALID_U32)
 			continue;
 
-		PxBounds3 cellBounds;
+		PxBounds3& cellBounds = cellBoundsBuffer[numCells];
 
 		cellBounds.setEmpty();
 		PxBounds3 cellBoundsNew(PxBounds3::empty());
@@ -529,10 +618,54 @@ void physx::Pt::collideCellsWithStaticMesh(ParticleCollData* collData, const Loc
 		if(!cellBounds.intersects(shapeBounds))
 			continue; // early out if (inflated) cell doesn't intersect mesh bounds
 
-		// opcode query: cell bounds against shape bounds in unscaled mesh space
-		PxcContactCellMeshCallback callback(collData, &(localCellHash.particleIndices[cell.firstParticle]),
-		                                    cell.numParticles, *meshData, meshScaling, proxRadius, NULL, shape2World);
-		testBoundsMesh(*meshData, world2Shape, meshScaling, idtScaleMesh, cellBounds, callback);
+		packetBounds.include(cellBounds);
+		cellIndices[numCells++] = c;
+	}
+
+	if(numCells == 0)
+		return;
+
+	// opcode query: fetch the triangles for all cells of the packet at once, unless there are too many of them.
+	PacketTriangleCache triangleCache;
+	if(numCells > 1)
+	{
+		PxcPacketMeshCallback packetCallback(triangleCache, meshScaling);
+		testBoundsMesh(*meshData, world2Shape, meshScaling, idtScaleMesh, packetBounds, packetCallback);
+	}
+
+	// process the particle cells
+	for(PxU32 i = 0; i < numCells; i++)
+	{
+		const ParticleCell& cell = localCellHash.hashEntries[cellIndices[i]];
+		const PxU32* cellParticleIndices = &(localCellHash.particleIndices[cell.firstParticle]);
+
+		if(numCells == 1 || triangleCache.overflow)
+		{
+			// opcode query: cell bounds against shape bounds in unscaled mesh space
+			PxcContactCellMeshCallback callback(collData, cellParticleIndices, cell.numParticles, *meshData,
+			                                    meshScaling, proxRadius, NULL, shape2World);
+			testBoundsMesh(*meshData, world2Shape, meshScaling, idtScaleMesh, cellBoundsBuffer[i], callback);
+			continue;
+		}
+
+		for(PxU32 p = 0; p < cell.numParticles; ++p)
+		{
+			ParticleCollData& collisionShapeData = collData[cellParticleIndices[p]];
+			collisionShapeData.localDcNum = 0.0f;
+			collisionShapeData.localSurfaceNormal = PxVec3(0);
+			collisionShapeData.localSurfacePos = PxVec3(0);
+		}
+
+		// the cached triangles overlapping the cell, in shape space
+		PxU32 triangleIndices[PT_PACKET_TRIANGLE_CACHE_SIZE];
+		const PxU32 numTriangles =
+		    triangleCache.overlap(triangleIndices, PxBounds3::transformFast(world2Shape, cellBoundsBuffer[i]));
+
+		for(PxU32 t = 0; t < numTriangles; ++t)
+		{
+			collideCellWithMeshTriangles(collData, cellParticleIndices, cell.numParticles, *meshData, meshScaling,
+			                             triangleCache.verts + triangleIndices[t] * 3, 1, proxRadius, shape2World);
+		}
 	}
 }
 
@@ -650,6 +783,33 @@ void physx::Pt::collideWithStaticHeightField(ParticleCollData* particleCollData,
 	const PxHeightFieldGeometryLL& hfGeom = heightFieldShape.get<const PxHeightFieldGeometryLL>();
 	const HeightFieldUtil hfUtil(hfGeom);
 
+	// fetch the height field triangles for the whole packet at once, unless there are too many of them.
+	PacketTriangleCache triangleCache;
+	if(numCollData > 1)
+	{
+		PxBounds3 packetBounds(PxBounds3::empty());
+		for(PxU32 p = 0; p < numCollData; p++)
+		{
+			packetBounds.include(particleCollData[p].localOldPos);
+			packetBounds.include(particleCollData[p].localNewPos);
+		}
+		packetBounds.fattenFast(proxRadius);
+
+		HeightFieldAabbTest test(packetBounds, hfUtil);
+		HeightFieldAabbTest::Iterator itEnd = test.end();
+		PxVec3 triangle[3];
+		for(HeightFieldAabbTest::Iterator it = test.begin(); it != itEnd; ++it)
+		{
+			it.getTriangleVertices(triangle);
+
+			PxBounds3 triangleBounds = PxBounds3::boundsOfPoints(triangle[0], triangle[1]);
+			triangleBounds.include(triangle[2]);
+			if(!triangleCache.add(triangle[0], triangle[1], triangle[2], triangleBounds))
+				break;
+		}
+	}
+	const bool useTriangleCache = numCollData > 1 && !triangleCache.overflow;
+
 	for(PxU32 p = 0; p < numCollData; p++)
 	{
 		ParticleCollData& collData = particleCollData[p];
@@ -658,11 +818,6 @@ void physx::Pt::collideWithStaticHeightField(ParticleCollData* particleCollData,
 		PX_ASSERT(!particleBounds.isEmpty());
 		particleBounds.fattenFast(proxRadius);
 
-		HeightFieldAabbTest test(particleBounds, hfUtil);
-		HeightFieldAabbTest::Iterator itBegin = test.begin();
-		HeightFieldAabbTest::Iterator itEnd = test.end();
-		PxVec3 triangle[3];
-
 		collData.localDcNum = 0.0f;
 		collData.localSurfaceNormal = PxVec3(0);
 		collData.localSurfacePos = PxVec3(0);
@@ -675,6 +830,36 @@ void physx::Pt::collideWithStaticHeightField(ParticleCollData* particleCollData,
 		PxReal tmpCCTime(collData.ccTime);
 		PxReal tmpDistOldToSurface(0.0f);
 
+		if(useTriangleCache)
+		{
+			PxU32 triangleIndices[PT_PACKET_TRIANGLE_CACHE_SIZE];
+			const PxU32 numTriangles = triangleCache.overlap(triangleIndices, particleBounds);
+
+			for(PxU32 t = 0; t < numTriangles; ++t)
+			{
+				const PxVec3* triangle = triangleCache.verts + triangleIndices[t] * 3;
+
+				const PxVec3& origin = triangle[0];
+				PxVec3 e0, e1;
+				e0 = triangle[1] - origin;
+				e1 = triangle[2] - origin;
+
+				PxU32 tmpFlags =
+				    collideWithMeshTriangle(tmpSurfaceNormal, tmpSurfacePos, tmpProxSurfaceNormal, tmpProxSurfacePos,
+				                            tmpCCTime, tmpDistOldToSurface, collData.localOldPos, collData.localNewPos,
+				                            origin, e0, e1, hasCC, collData.restOffset, proxRadius);
+
+				updateCollShapeData(collData, hasCC, tmpFlags, tmpCCTime, tmpDistOldToSurface, tmpSurfaceNormal,
+				                    tmpSurfacePos, tmpProxSurfaceNormal, tmpProxSurfacePos, shape2World);
+			}
+			continue;
+		}
+
+		HeightFieldAabbTest test(particleBounds, hfUtil);
+		HeightFieldAabbTest::Iterator itBegin = test.begin();
+		HeightFieldAabbTest::Iterator itEnd = test.end();
+		PxVec3 triangle[3];
+
 		for(HeightFieldAabbTest::Iterator it = itBegin; it != itEnd; ++it)
 		{
 			it.getTriangleVertices(triangle);
@@ -82,6 +82,10 @@
 // a packet into sections and reordering the particles accordingly
 #define PT_SUBPACKET_PARTICLE_LIMIT_PACKET_SECTIONS PT_SUBPACKET_PARTICLE_LIMIT
 
+// Sort the particles of each packet section by cell (in Morton order), so that particles of the same and of
+// neighboring cells are stored close to each other in the packet-ordered particle copy used for SPH dynamics.
+#define PT_SORT_PACKET_SECTIONS_BY_CELL 1
+
 // Maximum number of fluid particles in a packet that can be handled at a time for SPH dynamics
 // calculations, i.e., computation of density & force
 // - Ps::nextPowerOf2((PT_SUBPACKET_PARTICLE_LIMIT_FORCE_DENSITY + 1)) must be addressable
@@ -115,6 +119,11 @@
 // Initial size of triangle mesh collision buffer (for storing indices of colliding triangles)
 #define PT_INITIAL_MESH_COLLISION_BUFFER_SIZE 1024
 
+// Maximum number of triangles fetched once per particle packet (section) from a static triangle mesh or height field
+// and shared by all cells and particles of the packet. If more triangles overlap the packet, the triangles are
+// queried per cell (triangle mesh) or per particle (height field) instead.
+#define PT_PACKET_TRIANGLE_CACHE_SIZE 128
+
 #define PT_USE_SIMD_CONVEX_COLLISION 1
 
 #endif // PX_USE_PARTICLE_SYSTEM_API
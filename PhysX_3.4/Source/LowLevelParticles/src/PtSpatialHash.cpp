@@ -39,6 +39,7 @@
 #include "PtCollisionData.h"
 #include "PsUtilities.h"
 #include "PsFoundation.h"
+#include "PsSort.h"
 
 using namespace physx;
 using namespace Pt;
@@ -286,6 +287,42 @@ void SpatialHash::buildPacketSections(const ParticleCell& packet, PacketSections
 	PxMemCopy(tmpIndexBuffer, packetParticleIndices, packet.numParticles * sizeof(PxU32));
 
 	reorderParticlesToPacketSections(packet, sections, particles, tmpIndexBuffer, packetParticleIndices, sectionIndexBuf);
+
+#if PT_SORT_PACKET_SECTIONS_BY_CELL
+	sortPacketSectionsByCell(packet, sections, particles, packetParticleIndices);
+#endif
+}
+
+void SpatialHash::sortPacketSectionsByCell(const ParticleCell& packet, const PacketSections& sections,
+                                           const Particle* particles, PxU32* packetParticleIndices)
+{
+	GridCellVector packetMinCellCoords = packet.coords << mPacketMultLog;
+
+	// cell key in the upper, particle index in the lower 32 bits
+	PX_ALLOCA(sortKeys, PxU64, packet.numParticles * sizeof(PxU64));
+	PX_ASSERT(sortKeys);
+
+	GridCellVector cellCoord;
+	for(PxU32 s = 0; s < PT_PACKET_SECTIONS; s++)
+	{
+		PxU32 numParticles = sections.numParticles[s];
+		if(numParticles < 2)
+			continue;
+
+		PxU32* sectionParticleIndices = packetParticleIndices + (sections.firstParticle[s] - packet.firstParticle);
+
+		for(PxU32 p = 0; p < numParticles; p++)
+		{
+			PxU32 particleIndex = sectionParticleIndices[p];
+			cellCoord.set(particles[particleIndex].position, mCellSizeInv);
+			sortKeys[p] = (PxU64(getCellMortonKey(cellCoord, packetMinCellCoords)) << 32) | particleIndex;
+		}
+
+		Ps::sort(static_cast<PxU64*>(sortKeys), numParticles);
+
+		for(PxU32 p = 0; p < numParticles; p++)
+			sectionParticleIndices[p] = PxU32(sortKeys[p]);
+	}
 }
 
 void SpatialHash::reorderParticlesToPacketSections(const ParticleCell& packet, PacketSections& sections,
@@ -172,6 +172,12 @@ class SpatialHash
 	                                      const Particle* particles, const PxU32* inParticleIndices,
 	                                      PxU32* outParticleIndices, PxU16* sectionIndexBuf);
 
+	/*!
+	Sorts the particle indices of each section of the packet by particle cell, see PT_SORT_PACKET_SECTIONS_BY_CELL.
+	*/
+	void sortPacketSectionsByCell(const ParticleCell& packet, const PacketSections& sections,
+	                              const Particle* particles, PxU32* packetParticleIndices);
+
   private:
 	ParticleCell* mCells;
 	PxU32 mNumCells;
@@ -104,6 +104,24 @@ Note: One section is missing in this illustration. Section 26 is in the middle o
       enclosed by the other sections. For particles in section 26 we know for sure that no interaction
       with particles of neighboring packets occur.
 */
+/*!
+Returns the Morton code of a cell relative to the minimal cell of its packet (10 bits per axis).
+*/
+PX_FORCE_INLINE PxU32 getCellMortonKey(const GridCellVector& cellCoords, const GridCellVector& packetMinCellCoords)
+{
+	GridCellVector coord(cellCoords);
+	coord -= packetMinCellCoords;
+
+	PxU32 key = 0;
+	for(PxU32 bit = 0; bit < 10; ++bit)
+	{
+		key |= ((PxU32(coord.x) >> bit) & 1) << (3 * bit + 2);
+		key |= ((PxU32(coord.y) >> bit) & 1) << (3 * bit + 1);
+		key |= ((PxU32(coord.z) >> bit) & 1) << (3 * bit);
+	}
+	return key;
+}
+
 PX_FORCE_INLINE PxU32
 getPacketSectionIndex(const GridCellVector& cellCoords, const GridCellVector& packetMinCellCoords, PxU32 packetMult)
 {
@@ -55,9 +55,11 @@ PX_COMPILE_TIME_ASSERT(0==(sizeof(PxOverlapHit)& 0x0f));
 	}
 
 NpBatchQuery::NpBatchQuery(NpScene& owner, const PxBatchQueryDesc& d)
-	: mNpScene(&owner), mNbRaycasts(0), mNbOverlaps(0), mNbSweeps(0), mBatchQueryIsRunning(0), mDesc(d), mPrevOffset(PxU32(eTERMINAL))
+	: mNpScene(&owner), mNbRaycasts(0), mNbOverlaps(0), mNbSweeps(0), mBatchQueryIsRunning(0), mDesc(d), mPrevOffset(PxU32(eTERMINAL)),
+	mContinuation(NULL), mNbChunks(0), mNextChunk(0), mNbPendingTasks(0)
 {
 	mHasMtdSweep = false;
+	mHasLiveQuery = false;
 }
 
 NpBatchQuery::~NpBatchQuery()
@@ -238,6 +240,7 @@ void NpBatchQuery::finalizeExecute()
 	mStream.rewind(); // clear out the executed queries - rewind the data stream so that the query object can be reused
 	mNbRaycasts = mNbOverlaps = mNbSweeps = 0; // also reset the counts so the query object can be reused
 	mHasMtdSweep = false; // reset the mtd flag
+	mHasLiveQuery = false;
 
 	Ps::atomicExchange(&mBatchQueryIsRunning, 0);
 }
@@ -278,45 +281,59 @@ struct PxOverflowBuffer : PxHitBuffer<HitType>
 	}
 };
 
-void NpBatchQuery::execute()
+bool NpBatchQuery::checkUserMemory() const
 {
-	NP_READ_CHECK(mNpScene);
-
 	if(mNbRaycasts)
 	{
-		PX_CHECK_AND_RETURN(mDesc.queryMemory.userRaycastResultBuffer!=NULL, "PxBatchQuery execute: userRaycastResultBuffer is NULL");
-		PX_CHECK_AND_RETURN(mDesc.queryMemory.raycastTouchBufferSize > 0 ? 
-			(mDesc.queryMemory.userRaycastTouchBuffer != NULL)	: true, "PxBatchQuery execute: userRaycastTouchBuffer is NULL");
+		PX_CHECK_AND_RETURN_VAL(mDesc.queryMemory.userRaycastResultBuffer!=NULL, "PxBatchQuery execute: userRaycastResultBuffer is NULL", false);
+		PX_CHECK_AND_RETURN_VAL(mDesc.queryMemory.raycastTouchBufferSize > 0 ? 
+			(mDesc.queryMemory.userRaycastTouchBuffer != NULL)	: true, "PxBatchQuery execute: userRaycastTouchBuffer is NULL", false);
 	}
 	if(mNbOverlaps)
 	{
-		PX_CHECK_AND_RETURN(mDesc.queryMemory.userOverlapResultBuffer!=NULL, "PxBatchQuery execute: userOverlapResultBuffer is NULL");
-		PX_CHECK_AND_RETURN(mDesc.queryMemory.overlapTouchBufferSize > 0 ? 
-			(mDesc.queryMemory.userOverlapTouchBuffer != NULL)	: true, "PxBatchQuery execute: userOverlapTouchBuffer is NULL");
+		PX_CHECK_AND_RETURN_VAL(mDesc.queryMemory.userOverlapResultBuffer!=NULL, "PxBatchQuery execute: userOverlapResultBuffer is NULL", false);
+		PX_CHECK_AND_RETURN_VAL(mDesc.queryMemory.overlapTouchBufferSize > 0 ? 
+			(mDesc.queryMemory.userOverlapTouchBuffer != NULL)	: true, "PxBatchQuery execute: userOverlapTouchBuffer is NULL", false);
 	}
 	if(mNbSweeps)
 	{
-		PX_CHECK_AND_RETURN(mDesc.queryMemory.userSweepResultBuffer!=NULL, "PxBatchQuery execute: userSweepResultBuffer is NULL");
-		PX_CHECK_AND_RETURN(mDesc.queryMemory.sweepTouchBufferSize > 0 ? 
-			(mDesc.queryMemory.userSweepTouchBuffer != NULL)	: true, "PxBatchQuery execute: userSweepTouchBuffer is NULL");
+		PX_CHECK_AND_RETURN_VAL(mDesc.queryMemory.userSweepResultBuffer!=NULL, "PxBatchQuery execute: userSweepResultBuffer is NULL", false);
+		PX_CHECK_AND_RETURN_VAL(mDesc.queryMemory.sweepTouchBufferSize > 0 ? 
+			(mDesc.queryMemory.userSweepTouchBuffer != NULL)	: true, "PxBatchQuery execute: userSweepTouchBuffer is NULL", false);
 	}
+	return true;
+}
 
-	PX_SIMD_GUARD;
-
-	PX_PROFILE_ZONE("BatchedSceneQuery.execute", mNpScene->getContextId());
+bool NpBatchQuery::startExecute(const char* queryMessage)
+{
 	PxI32 ret = Ps::atomicCompareExchange(&mBatchQueryIsRunning, 1, 0);
 	if(ret == 1)
 	{
-		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxBatchQuery::execute: This batch is already executing"); 
-		return;
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "%s: This batch is already executing", queryMessage); 
+		return false;
 	}
 	else if(ret == -1)
 	{
-		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxBatchQuery::execute: Another thread is still adding queries to this batch"); 
-		return;
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "%s: Another thread is still adding queries to this batch", queryMessage); 
+		return false;
 	}
 
 	resetResultBuffers();
+	return true;
+}
+
+void NpBatchQuery::execute()
+{
+	NP_READ_CHECK(mHasLiveQuery ? mNpScene : NULL);	// batches of snapshot queries do not need the read lock
+
+	if(!checkUserMemory())
+		return;
+
+	PX_SIMD_GUARD;
+
+	PX_PROFILE_ZONE("BatchedSceneQuery.execute", mNpScene->getContextId());
+	if(!startExecute("PxBatchQuery::execute"))
+		return;
 
 	// If PVD is connected and IS_PVD_SQ_ENABLED, record the offsets for queries in pvd buffers and run the queries on PPU
 	bool isSqCollectorLocked = false;
@@ -326,6 +343,7 @@ void NpBatchQuery::execute()
 	PxU32 pvdRayQstartIdx = 0;
 	PxU32 pvdOverlapQstartIdx = 0;
 	PxU32 pvdSweepQstartIdx = 0;
+	bool pvdCaptureBatch = false;
 
 	Vd::ScbScenePvdClient& pvdClient = mNpScene->mScene.getScenePvdClient();
 	const bool needUpdatePvd = pvdClient.checkPvdDebugFlag() && (pvdClient.getScenePvdFlagsFast() & PxPvdSceneFlag::eTRANSMIT_SCENEQUERIES);
@@ -334,6 +352,9 @@ void NpBatchQuery::execute()
 	{
 		mNpScene->getBatchedSqCollector().getLock().lock();
 		isSqCollectorLocked = true;
+
+		// the batch is captured or skipped as a whole, collectAllBatchedHits expects one recorded query per result
+		pvdCaptureBatch = mNpScene->getBatchedSqCollector().beginBatch() == Vd::PvdSceneQueryCollector::eCAPTURE_DETAILED;
 	
 		pvdRayQstartIdx = mNpScene->getBatchedSqCollector().mAccumulatedRaycastQueries.size();
 		pvdOverlapQstartIdx = mNpScene->getBatchedSqCollector().mAccumulatedOverlapQueries.size();
@@ -439,7 +460,7 @@ void NpBatchQuery::execute()
 	} while (queryCount < 1000000);
 
 #if PX_SUPPORT_PVD
-	if( isSqCollectorLocked && needUpdatePvd)	
+	if( isSqCollectorLocked && needUpdatePvd && pvdCaptureBatch)	
 	{
 		mNpScene->getBatchedSqCollector().collectAllBatchedHits(	mDesc.queryMemory.userRaycastResultBuffer, mNbRaycasts, pvdRayQstartIdx,
 																	mDesc.queryMemory.userOverlapResultBuffer, mNbOverlaps, pvdOverlapQstartIdx,
@@ -457,6 +478,333 @@ void NpBatchQuery::execute()
 	finalizeExecute();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+// number of queries executed by a task before it claims the next chunk
+static const PxU32 gNbQueriesPerChunk = 64;
+
+// runs a query with its full maxTouchHits budget, appending the touches to a chunk touch buffer
+template<typename HitType, typename ResultType>
+static PxU32 runChunkQuery(	NpScene* scene, const MultiQueryInput& input, const BatchStreamHeader& h, const BatchQueryFilterData& bfd,
+							Ps::Array<HitType>& touches, ResultType* result)
+{
+	const PxU32 firstTouch = touches.size();
+	touches.resizeUninitialized(firstTouch + h.maxTouchHits);
+
+	PxOverflowBuffer<HitType> hits(touches.begin() + firstTouch, h.maxTouchHits);
+	BatchQueryFilterData filterData = bfd;
+	scene->NpScene::multiQuery<HitType>(input, hits, h.hitFlags, h.cache, h.fd, NULL, &filterData);
+	writeStatus<ResultType, HitType>(result, hits, h.userData, hits.overflow);
+
+	touches.resizeUninitialized(firstTouch + hits.nbTouches);
+	return firstTouch;
+}
+
+// overlaps that can share a pruner traversal with the other overlaps of their chunk. Cached and snapshot queries, and
+// queries that would fail the input checks, keep their own multiQuery() call which also reports the errors.
+static PX_FORCE_INLINE bool canGroupOverlap(const BatchStreamHeader& h, const MultiQueryInput& input)
+{
+	if(h.cache || (h.fd.flags & PxQueryFlag::eSNAPSHOT) || !input.pose->isValid())
+		return false;
+	return h.maxTouchHits > 0 || (h.fd.flags & PxQueryFlag::eANY_HIT);
+}
+
+// maximum number of overlaps gathered before running them, the scene splits larger groups anyway
+static const PxU32 gNbOverlapsPerGroup = 32;
+
+// runs a group of overlaps with NpSceneQueries::multiOverlap(), each with its full maxTouchHits budget, appending their
+// touches to a chunk touch buffer like runChunkQuery() does
+static void runChunkOverlapGroup(	NpScene* scene, PxU32 nbQueries, const BatchStreamHeader* const* headers, const MultiQueryInput* const* inputs,
+									const BatchQueryFilterData& bfd, Ps::Array<PxOverlapHit>& touches, PxOverlapQueryResult* const* results, PxU32* firstTouches)
+{
+	PX_ASSERT(nbQueries <= gNbOverlapsPerGroup);
+
+	// give each query its own slice of the touch buffer, compacted once all of them completed
+	PxU32 slices[gNbOverlapsPerGroup];
+	PxU32 nbTouches = touches.size();
+	for(PxU32 i=0;i<nbQueries;i++)
+	{
+		slices[i] = nbTouches;
+		nbTouches += headers[i]->maxTouchHits;
+	}
+	const PxU32 firstTouch = touches.size();
+	touches.resizeUninitialized(nbTouches);
+
+	PX_ALIGN(16, PxU8 hitsBuffer[sizeof(PxOverflowBuffer<PxOverlapHit>)*gNbOverlapsPerGroup]);
+	PxOverflowBuffer<PxOverlapHit>* hits = reinterpret_cast<PxOverflowBuffer<PxOverlapHit>*>(hitsBuffer);
+	OverlapQueryDesc queries[gNbOverlapsPerGroup];
+	for(PxU32 i=0;i<nbQueries;i++)
+	{
+		PX_PLACEMENT_NEW(hits + i, PxOverflowBuffer<PxOverlapHit>)(touches.begin() + slices[i], headers[i]->maxTouchHits);
+		queries[i].input = inputs[i];
+		queries[i].hits = hits + i;
+		queries[i].hitFlags = headers[i]->hitFlags;
+		queries[i].filterData = &headers[i]->fd;
+		queries[i].filterCall = NULL;
+	}
+
+	BatchQueryFilterData filterData = bfd;
+	scene->NpScene::multiOverlap(nbQueries, queries, &filterData);
+
+	PxU32 index = firstTouch;
+	for(PxU32 i=0;i<nbQueries;i++)
+	{
+		writeStatus<PxOverlapQueryResult, PxOverlapHit>(results[i], hits[i], headers[i]->userData, hits[i].overflow);
+
+		// slices only move down, so copying forward is safe
+		const PxU32 nb = hits[i].nbTouches;
+		for(PxU32 j=0;j<nb;j++)
+			touches[index + j] = touches[slices[i] + j];
+		firstTouches[i] = index;
+		index += nb;
+
+		hits[i].~PxOverflowBuffer<PxOverlapHit>();
+	}
+	touches.resizeUninitialized(index);
+}
+
+// copies the touches of a query from its chunk touch buffer to the user touch buffer, in query order. Running out
+// of user buffer space truncates the touches and reports an overflow, like execute() does.
+template<typename HitType, typename ResultType>
+static void mergeChunkQuery(ResultType& result, const HitType* chunkTouches, PxU16 maxTouchHits, HitType*& userTouches, PxU32& hitsSpaceLeft)
+{
+	const PxU32 nbTouches = PxMin<PxU32>(result.nbTouches, hitsSpaceLeft);
+	const bool overflow =	result.queryStatus == PxBatchQueryStatus::eOVERFLOW || nbTouches < result.nbTouches
+						||	(hitsSpaceLeft == 0 && maxTouchHits > 0);
+
+	for(PxU32 i=0;i<nbTouches;i++)
+		userTouches[i] = chunkTouches[i];
+
+	result.nbTouches = nbTouches;
+	result.queryStatus = PxU8(overflow ? PxBatchQueryStatus::eOVERFLOW : PxBatchQueryStatus::eSUCCESS);
+	result.touches = (overflow && nbTouches == 0) ? NULL : userTouches;
+	userTouches += nbTouches;
+	hitsSpaceLeft -= nbTouches;
+}
+
+bool NpBatchQuery::executeParallel(PxCpuDispatcher& dispatcher, PxBaseTask* continuation)
+{
+	NP_READ_CHECK(mHasLiveQuery ? mNpScene : NULL);	// batches of snapshot queries do not need the read lock
+
+	PX_CHECK_AND_RETURN_VAL(continuation!=NULL, "PxBatchQuery::executeParallel: continuation is NULL", false);
+	if(!checkUserMemory())
+		return false;
+
+	PX_SIMD_GUARD;
+
+	PX_PROFILE_ZONE("BatchedSceneQuery.executeParallel", mNpScene->getContextId());
+
+#if PX_SUPPORT_PVD
+	// the PVD scene query collector is not thread safe, so captured batches run on the calling thread
+	Vd::ScbScenePvdClient& pvdClient = mNpScene->mScene.getScenePvdClient();
+	if(pvdClient.checkPvdDebugFlag() && (pvdClient.getScenePvdFlagsFast() & PxPvdSceneFlag::eTRANSMIT_SCENEQUERIES))
+	{
+		continuation->addReference();
+		execute();
+		continuation->removeReference();
+		return true;
+	}
+#endif
+
+	if(!startExecute("PxBatchQuery::executeParallel"))
+		return false;
+
+	if(mPrevOffset == eTERMINAL) // zero queries were queued
+	{
+		continuation->addReference();
+		finalizeExecute();
+		continuation->removeReference();
+		return true;
+	}
+
+	// record the queries in stream order, with the index of their result in the result buffer of their type
+	mEntries.clear();
+	mEntries.reserve(mNbRaycasts + mNbOverlaps + mNbSweeps);
+	{
+		PxU32 resultIndex[3] = { 0, 0, 0 };
+		PxU32 curQueryOffset = 0;
+		for(;;)
+		{
+			const BatchStreamHeader& h = *reinterpret_cast<const BatchStreamHeader*>(mStream.begin() + curQueryOffset);
+			QueryEntry entry;
+			entry.headerOffset = curQueryOffset;
+			entry.resultIndex = resultIndex[PxU32(h.hitTypeId)]++;
+			entry.firstTouch = 0;
+			mEntries.pushBack(entry);
+
+			if(h.nextQueryOffset == eTERMINAL)
+				break;
+			curQueryOffset = h.nextQueryOffset;
+		}
+	}
+
+	// split them in chunks. The chunk touch buffers are kept from one execution to the next.
+	const PxU32 nbEntries = mEntries.size();
+	mNbChunks = (nbEntries + gNbQueriesPerChunk - 1) / gNbQueriesPerChunk;
+	if(mChunks.size() < mNbChunks)
+		mChunks.resize(mNbChunks);
+	for(PxU32 i=0;i<mNbChunks;i++)
+	{
+		QueryChunk& chunk = mChunks[i];
+		chunk.firstEntry = i * gNbQueriesPerChunk;
+		chunk.nbEntries = PxMin(gNbQueriesPerChunk, nbEntries - chunk.firstEntry);
+		chunk.raycastTouches.clear();
+		chunk.overlapTouches.clear();
+		chunk.sweepTouches.clear();
+	}
+
+	const PxU32 nbTasks = PxMax<PxU32>(1, PxMin(dispatcher.getWorkerCount(), mNbChunks));
+	if(mTasks.size() < nbTasks)
+		mTasks.resize(nbTasks);
+
+	mContinuation = continuation;
+	mContinuation->addReference();
+	mNextChunk = 0;
+	mNbPendingTasks = PxI32(nbTasks);
+
+	for(PxU32 i=0;i<nbTasks;i++)
+	{
+		mTasks[i].mOwner = this;
+		mTasks[i].setContextId(mNpScene->getContextId());
+		dispatcher.submitTask(mTasks[i]);
+	}
+	return true;
+}
+
+void NpBatchQuery::processChunks()
+{
+	for(;;)
+	{
+		const PxU32 chunkIndex = PxU32(Ps::atomicIncrement(&mNextChunk) - 1);
+		if(chunkIndex >= mNbChunks)
+			break;
+		processChunk(mChunks[chunkIndex]);
+	}
+}
+
+void NpBatchQuery::processChunk(QueryChunk& chunk)
+{
+	PX_PROFILE_ZONE("BatchedSceneQuery.processChunk", mNpScene->getContextId());
+
+	const PxClientID clientId = mDesc.ownerClient;
+	const BatchQueryFilterData bfd(mDesc.filterShaderData, mDesc.filterShaderDataSize, mDesc.preFilterShader, mDesc.postFilterShader);
+
+	// overlaps are gathered and run together, their touches are located through firstTouch so the order does not matter
+	const BatchStreamHeader*	groupHeaders[gNbOverlapsPerGroup];
+	const MultiQueryInput*		groupInputs[gNbOverlapsPerGroup];
+	PxOverlapQueryResult*		groupResults[gNbOverlapsPerGroup];
+	QueryEntry*					groupEntries[gNbOverlapsPerGroup];
+	PxU32						groupFirstTouches[gNbOverlapsPerGroup];
+	PxU32						nbGrouped = 0;
+
+	for(PxU32 i=0;i<=chunk.nbEntries;i++)
+	{
+		if(nbGrouped == gNbOverlapsPerGroup || (i == chunk.nbEntries && nbGrouped))
+		{
+			runChunkOverlapGroup(mNpScene, nbGrouped, groupHeaders, groupInputs, bfd, chunk.overlapTouches, groupResults, groupFirstTouches);
+			for(PxU32 j=0;j<nbGrouped;j++)
+				groupEntries[j]->firstTouch = groupFirstTouches[j];
+			nbGrouped = 0;
+		}
+		if(i == chunk.nbEntries)
+			break;
+
+		QueryEntry& entry = mEntries[chunk.firstEntry + i];
+
+		BatchQueryStreamReader reader(mStream.begin() + entry.headerOffset);
+		BatchStreamHeader& h = *reader.read<BatchStreamHeader>();
+		if (h.fd.clientId == 0)
+			h.fd.clientId = clientId; // override a zero clientId with PxBatchQueryDesc.ownerClient
+
+		const MultiQueryInput& input = *readQueryInput(reader);
+
+		switch (h.hitTypeId)
+		{
+			case QTypeROS::eRAYCAST:
+				entry.firstTouch = runChunkQuery<PxRaycastHit, PxRaycastQueryResult>(mNpScene, input, h, bfd, chunk.raycastTouches, mDesc.queryMemory.userRaycastResultBuffer + entry.resultIndex);
+				break;
+			case QTypeROS::eOVERLAP:
+				if(canGroupOverlap(h, input))
+				{
+					groupHeaders[nbGrouped] = &h;
+					groupInputs[nbGrouped] = &input;
+					groupResults[nbGrouped] = mDesc.queryMemory.userOverlapResultBuffer + entry.resultIndex;
+					groupEntries[nbGrouped++] = &entry;
+				}
+				else
+					entry.firstTouch = runChunkQuery<PxOverlapHit, PxOverlapQueryResult>(mNpScene, input, h, bfd, chunk.overlapTouches, mDesc.queryMemory.userOverlapResultBuffer + entry.resultIndex);
+				break;
+			case QTypeROS::eSWEEP:
+				entry.firstTouch = runChunkQuery<PxSweepHit, PxSweepQueryResult>(mNpScene, input, h, bfd, chunk.sweepTouches, mDesc.queryMemory.userSweepResultBuffer + entry.resultIndex);
+				break;
+			default:
+				PX_ALWAYS_ASSERT_MESSAGE("Unexpected batch query type (raycast/overlap/sweep).");
+		}
+	}
+}
+
+void NpBatchQuery::mergeChunks()
+{
+	PX_PROFILE_ZONE("BatchedSceneQuery.mergeChunks", mNpScene->getContextId());
+
+	PxRaycastHit* raycastHits = mDesc.queryMemory.userRaycastTouchBuffer;
+	PxOverlapHit* overlapHits = mDesc.queryMemory.userOverlapTouchBuffer;
+	PxSweepHit* sweepHits = mDesc.queryMemory.userSweepTouchBuffer;
+	PxU32 raycastHitsSpaceLeft = mDesc.queryMemory.raycastTouchBufferSize;
+	PxU32 overlapHitsSpaceLeft = mDesc.queryMemory.overlapTouchBufferSize;
+	PxU32 sweepHitsSpaceLeft = mDesc.queryMemory.sweepTouchBufferSize;
+
+	// chunks and their queries are visited in stream order, so the final layout does not depend on the scheduling
+	for(PxU32 c=0;c<mNbChunks;c++)
+	{
+		const QueryChunk& chunk = mChunks[c];
+		for(PxU32 i=0;i<chunk.nbEntries;i++)
+		{
+			const QueryEntry& entry = mEntries[chunk.firstEntry + i];
+			const BatchStreamHeader& h = *reinterpret_cast<const BatchStreamHeader*>(mStream.begin() + entry.headerOffset);
+			switch (h.hitTypeId)
+			{
+				case QTypeROS::eRAYCAST:
+					mergeChunkQuery(mDesc.queryMemory.userRaycastResultBuffer[entry.resultIndex], chunk.raycastTouches.begin() + entry.firstTouch, h.maxTouchHits, raycastHits, raycastHitsSpaceLeft);
+					break;
+				case QTypeROS::eOVERLAP:
+					mergeChunkQuery(mDesc.queryMemory.userOverlapResultBuffer[entry.resultIndex], chunk.overlapTouches.begin() + entry.firstTouch, h.maxTouchHits, overlapHits, overlapHitsSpaceLeft);
+					break;
+				case QTypeROS::eSWEEP:
+					mergeChunkQuery(mDesc.queryMemory.userSweepResultBuffer[entry.resultIndex], chunk.sweepTouches.begin() + entry.firstTouch, h.maxTouchHits, sweepHits, sweepHitsSpaceLeft);
+					break;
+				default:
+					PX_ALWAYS_ASSERT_MESSAGE("Unexpected batch query type (raycast/overlap/sweep).");
+			}
+		}
+	}
+}
+
+void NpBatchQuery::onTaskReleased()
+{
+	if(Ps::atomicDecrement(&mNbPendingTasks))
+		return;
+
+	// last task released: the dispatcher no longer references any of them, the batch can be reused or released
+	mergeChunks();
+
+	PxBaseTask* continuation = mContinuation;
+	mContinuation = NULL;
+	finalizeExecute();
+	continuation->removeReference();
+}
+
+void NpBatchQueryTask::run()
+{
+	PX_SIMD_GUARD;
+	mOwner->processChunks();
+}
+
+void NpBatchQueryTask::release()
+{
+	mOwner->onTaskReleased();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void NpBatchQuery::writeBatchHeader(const BatchStreamHeader& h)
 {
@@ -485,6 +833,7 @@ void NpBatchQuery::raycast(
 	}
 	CHECK_RUNNING("PxBatchQuery::raycast: This batch is still executing, skipping query.");
 	mNbRaycasts++;
+	mHasLiveQuery |= !(fd.flags & PxQueryFlag::eSNAPSHOT);
 
 	writeBatchHeader(BatchStreamHeader(hitFlags, cache, fd, userData, maxTouchHits, QTypeROS::eRAYCAST));
 	writeQueryInput(mStream, MultiQueryInput(origin, unitDir, distance));
@@ -506,6 +855,7 @@ void NpBatchQuery::overlap(
 	}
 	CHECK_RUNNING("PxBatchQuery::overlap: This batch is still executing, skipping query.")
 	mNbOverlaps++;
+	mHasLiveQuery |= !(fd.flags & PxQueryFlag::eSNAPSHOT);
 
 	writeBatchHeader(BatchStreamHeader(PxHitFlags(), cache, fd, userData, maxTouchHits, QTypeROS::eOVERLAP));
 	writeQueryInput(mStream, MultiQueryInput(&geometry, &pose));
@@ -542,6 +892,7 @@ void NpBatchQuery::sweep(
 	
 	CHECK_RUNNING("PxBatchQuery::sweep: This batch is still executing, skipping query.")
 	mNbSweeps++;
+	mHasLiveQuery |= !(fd.flags & PxQueryFlag::eSNAPSHOT);
 
 	writeBatchHeader(BatchStreamHeader(hitFlags, cache, fd, userData, maxTouchHits, QTypeROS::eSWEEP));
 
@@ -38,6 +38,7 @@
 #include "PsUserAllocated.h"
 #include "CmPhysXCommon.h"
 #include "PsSync.h"
+#include "task/PxTask.h"
 
 namespace physx
 {
@@ -89,6 +90,27 @@ protected:
 	mutable PxU32 mPosition;
 };
 
+class NpBatchQuery;
+
+// a task submitted straight to the dispatcher by NpBatchQuery::executeParallel, pulling query chunks until none is left
+class NpBatchQueryTask : public PxBaseTask
+{
+public:
+									NpBatchQueryTask() : mOwner(NULL)	{}
+
+	virtual void					run();
+	virtual const char*				getName() const { return "NpBatchQuery.executeParallel"; }
+
+	// the task is owned by NpBatchQuery and never shared, so there is nothing to count
+	virtual void					addReference()			{}
+	virtual void					removeReference()		{}
+	virtual PxI32					getReference() const	{ return 1; }
+
+	virtual void					release();
+
+			NpBatchQuery*			mOwner;
+};
+
 struct BatchQueryStreamReader
 {
 	BatchQueryStreamReader(char* buffer) : mBuffer(buffer), mReadPos(0) {}
@@ -115,6 +137,7 @@ public:
 
 	// PxBatchQuery interface
 	virtual	void							execute();
+	virtual	bool							executeParallel(PxCpuDispatcher& dispatcher, PxBaseTask* continuation);
 	virtual void							release();
 	virtual	PxBatchQueryPreFilterShader		getPreFilterShader() const;
 	virtual	PxBatchQueryPostFilterShader	getPostFilterShader() const;
@@ -145,8 +168,32 @@ public:
 	// sync object for batch query completion wait
 	shdfnd::Sync							mSync;
 private:
+	// one query of the stream, recorded by executeParallel()
+	struct QueryEntry
+	{
+		PxU32	headerOffset;	// offset of the BatchStreamHeader in mStream
+		PxU32	resultIndex;	// index in the result buffer of the query type
+		PxU32	firstTouch;		// index of the first touch in the chunk's touch buffer of the query type
+	};
+
+	// a contiguous range of queries, executed by a single task with its own touch buffers
+	struct QueryChunk
+	{
+		PxU32						firstEntry;
+		PxU32						nbEntries;
+		Ps::Array<PxRaycastHit>		raycastTouches;
+		Ps::Array<PxOverlapHit>		overlapTouches;
+		Ps::Array<PxSweepHit>		sweepTouches;
+	};
+
+			bool							checkUserMemory() const;
+			bool							startExecute(const char* queryMessage);
 			void							resetResultBuffers();
 			void							finalizeExecute();
+			void							processChunks();
+			void							processChunk(QueryChunk& chunk);
+			void							onTaskReleased();
+			void							mergeChunks();
 			void							writeBatchHeader(const BatchStreamHeader& h);
 
 						NpScene*			mNpScene;
@@ -157,8 +204,20 @@ private:
 	// offset in mStream of the offset to the next query for the last header written by BQ query functions
 						PxU32				mPrevOffset;
 						bool				mHasMtdSweep;
+	// set when a queued query does not use PxQueryFlag::eSNAPSHOT, so that the execution needs the scene read lock
+						bool				mHasLiveQuery;
+
+	// executeParallel() data, sized once per execution and only read or written by the task owning a chunk until all tasks are released
+						Ps::Array<QueryEntry>		mEntries;
+						Ps::Array<QueryChunk>		mChunks;
+						Ps::Array<NpBatchQueryTask>	mTasks;
+						PxBaseTask*					mContinuation;
+						PxU32						mNbChunks;
+			volatile	PxI32						mNextChunk;
+			volatile	PxI32						mNbPendingTasks;
 
 	friend class physx::Sq::SceneQueryManager;
+	friend class NpBatchQueryTask;
 };
 
 }
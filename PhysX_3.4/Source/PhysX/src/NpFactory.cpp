@@ -836,12 +836,8 @@ NpShape* NpFactory::createShape(const PxGeometry& geometry,
 		NpMaterial::getMaterialIndices(materials, materialIndices.begin(), materialCount);
 	}
 
-	NpShape* npShape;
-	{
-		Ps::Mutex::ScopedLock lock(mShapePoolLock);
-		PxU16* mi = materialIndices.begin(); // required to placate pool constructor arg passing
-		npShape = mShapePool.construct(geometry, shapeFlags, mi, materialCount, isExclusive);
-	}
+	PxU16* mi = materialIndices.begin(); // required to placate pool constructor arg passing
+	NpShape* npShape = mShapePool.construct(geometry, shapeFlags, mi, materialCount, isExclusive);
 
 	if(!npShape)
 		return NULL;
@@ -857,7 +853,6 @@ NpShape* NpFactory::createShape(const PxGeometry& geometry,
 void NpFactory::releaseShapeToPool(NpShape& shape)
 {
 	PX_ASSERT(shape.getBaseFlags() & PxBaseFlag::eOWNS_MEMORY);
-	Ps::Mutex::ScopedLock lock(mShapePoolLock);
 	mShapePool.destroy(&shape);
 }
 
@@ -884,12 +879,7 @@ PxRigidStatic* NpFactory::createRigidStatic(const PxTransform& pose)
 {
 	PX_CHECK_AND_RETURN_NULL(pose.isValid(), "pose is not valid. createRigidStatic returns NULL.");
 
-	NpRigidStatic* npActor;
-
-	{
-		Ps::Mutex::ScopedLock lock(mRigidStaticPoolLock);
-		npActor = mRigidStaticPool.construct(pose);
-	}
+	NpRigidStatic* npActor = mRigidStaticPool.construct(pose);
 
 	addRigidStatic(npActor);
 	return npActor;
@@ -898,7 +888,6 @@ PxRigidStatic* NpFactory::createRigidStatic(const PxTransform& pose)
 void NpFactory::releaseRigidStaticToPool(NpRigidStatic& rigidStatic)
 {
 	PX_ASSERT(rigidStatic.getBaseFlags() & PxBaseFlag::eOWNS_MEMORY);
-	Ps::Mutex::ScopedLock lock(mRigidStaticPoolLock);
 	mRigidStaticPool.destroy(&rigidStatic);
 }
 
@@ -906,11 +895,7 @@ PxRigidDynamic* NpFactory::createRigidDynamic(const PxTransform& pose)
 {
 	PX_CHECK_AND_RETURN_NULL(pose.isValid(), "pose is not valid. createRigidDynamic returns NULL.");
 
-	NpRigidDynamic* npBody;
-	{
-		Ps::Mutex::ScopedLock lock(mRigidDynamicPoolLock);
-		npBody = mRigidDynamicPool.construct(pose);
-	}
+	NpRigidDynamic* npBody = mRigidDynamicPool.construct(pose);
 	addRigidDynamic(npBody);
 	return npBody;
 }
@@ -919,7 +904,6 @@ PxRigidDynamic* NpFactory::createRigidDynamic(const PxTransform& pose)
 void NpFactory::releaseRigidDynamicToPool(NpRigidDynamic& rigidDynamic)
 {
 	PX_ASSERT(rigidDynamic.getBaseFlags() & PxBaseFlag::eOWNS_MEMORY);
-	Ps::Mutex::ScopedLock lock(mRigidDynamicPoolLock);
 	mRigidDynamicPool.destroy(&rigidDynamic);
 }
 
@@ -32,6 +32,7 @@
 #define PX_PHYSICS_NP_FACTORY
 
 #include "PsPool.h"
+#include "PsConcurrentPool.h"
 #include "PsMutex.h"
 #include "PsHashSet.h"
 
@@ -248,14 +249,11 @@ private:
 				Ps::HashSet<PxActor*>			mActorTracking;				
 				Ps::CoalescedHashSet<PxShape*>	mShapeTracking;
 
-				Ps::Pool2<NpRigidDynamic, 4096>	mRigidDynamicPool;
-				Ps::Mutex						mRigidDynamicPoolLock;
-
-				Ps::Pool2<NpRigidStatic, 4096>	mRigidStaticPool;
-				Ps::Mutex						mRigidStaticPoolLock;
-
-				Ps::Pool2<NpShape, 4096>		mShapePool;
-				Ps::Mutex						mShapePoolLock;
+				// actors and shapes are the objects most often created from several threads at once, e.g. by
+				// streaming loaders, so their pools do not take a lock
+				Ps::ConcurrentPool<NpRigidDynamic, 4096>	mRigidDynamicPool;
+				Ps::ConcurrentPool<NpRigidStatic, 4096>		mRigidStaticPool;
+				Ps::ConcurrentPool<NpShape, 4096>			mShapePool;
 
 				Ps::Pool2<NpAggregate, 4096>	mAggregatePool;
 				Ps::Mutex						mAggregatePoolLock;
@@ -579,6 +579,12 @@ PxTriangleMesh* NpPhysics::createTriangleMesh(PxInputStream& stream)
 	return NpFactory::getInstance().createTriangleMesh(stream);
 }
 
+PxTriangleMesh* NpPhysics::createTriangleMeshInPlace(const void* cookedData, PxU32 size)
+{
+	PX_CHECK_AND_RETURN_NULL(cookedData && size, "PxPhysics::createTriangleMeshInPlace: invalid cooked data");
+	return NpFactory::getInstance().createTriangleMeshInPlace(cookedData, size);
+}
+
 PxU32 NpPhysics::getNbTriangleMeshes() const
 {
 	return NpFactory::getInstance().getNbTriangleMeshes();
@@ -656,7 +662,7 @@ void NpPhysics::registerCloth()
 }
 #endif
 
-PxPruningStructure* NpPhysics::createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors)
+PxPruningStructure* NpPhysics::createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors, PxCpuDispatcher* dispatcher)
 {
 	PX_SIMD_GUARD;
 
@@ -664,7 +670,7 @@ PxPruningStructure* NpPhysics::createPruningStructure(PxRigidActor*const* actors
 	PX_ASSERT(nbActors > 0);
 
 	Sq::PruningStructure* ps = PX_NEW(Sq::PruningStructure)();	
-	if(!ps->build(actors, nbActors))
+	if(!ps->build(actors, nbActors, dispatcher))
 	{
 		PX_DELETE_AND_RESET(ps);		
 	}
@@ -776,6 +782,28 @@ void NpPhysics::unregisterDeletionListenerObjects(PxDeletionListener& observer,
 	}
 }
 
+PX_COMPILE_TIME_ASSERT(PxU32(PxMemoryCategory::eCOUNT) == PxU32(Ps::AllocationCategory::eCOUNT));
+PX_COMPILE_TIME_ASSERT(PxU32(PxMemoryCategory::eEXTENSIONS) == PxU32(Ps::AllocationCategory::eEXTENSIONS));
+
+void NpPhysics::getMemoryStatistics(PxMemoryStatistics& stats) const
+{
+	Ps::AllocationStats allocStats;
+	Ps::getFoundation().getAllocationStats(allocStats);
+
+	for(PxU32 i=0; i<PxMemoryCategory::eCOUNT; i++)
+	{
+		stats.liveBytes[i] = allocStats.liveBytes[i];
+		stats.peakBytes[i] = allocStats.peakBytes[i];
+	}
+	stats.totalLiveBytes = allocStats.totalLiveBytes;
+	stats.totalPeakBytes = allocStats.totalPeakBytes;
+}
+
+void NpPhysics::resetMemoryPeakStatistics()
+{
+	Ps::getFoundation().resetAllocationPeaks();
+}
+
 
 void NpPhysics::notifyDeletionListeners(const PxBase* base, void* userData, PxDeletionEventFlag::Enum deletionEvent)
 {
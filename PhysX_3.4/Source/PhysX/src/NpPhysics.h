@@ -148,6 +148,7 @@ public:
 	virtual		PxU32				getMaterials(PxMaterial** userBuffer, PxU32 bufferSize, PxU32 startIndex=0) const;
 
 	virtual		PxTriangleMesh*		createTriangleMesh(PxInputStream&);
+	virtual		PxTriangleMesh*		createTriangleMeshInPlace(const void* cookedData, PxU32 size);
 	virtual		PxU32				getNbTriangleMeshes()	const;
 	virtual		PxU32				getTriangleMeshes(PxTriangleMesh** userBuffer, PxU32 bufferSize, PxU32 startIndex=0)	const;
 
@@ -175,7 +176,7 @@ public:
 	PX_FORCE_INLINE void			unregisterPhysXIndicatorGpuClient() {}
 #endif
 
-	virtual		PxPruningStructure*	createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors);
+	virtual		PxPruningStructure*	createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors, PxCpuDispatcher* dispatcher);
 
 	virtual		const PxTolerancesScale&		getTolerancesScale() const;
 
@@ -205,6 +206,9 @@ public:
 
 	virtual		PxPhysicsInsertionCallback&	getPhysicsInsertionCallback() { return mObjectInsertion; }
 
+	virtual		void				getMemoryStatistics(PxMemoryStatistics& stats) const;
+	virtual		void				resetMemoryPeakStatistics();
+
 				void				removeMaterialFromTable(NpMaterial&);
 				void				updateMaterial(NpMaterial&);
 				bool				sendMaterialTable(NpScene&);
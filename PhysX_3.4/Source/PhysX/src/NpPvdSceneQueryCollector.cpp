@@ -28,6 +28,7 @@
 // Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
 
 #include "NpScene.h"
+#include "PsTime.h"
 
 #if PX_SUPPORT_PVD
 using namespace physx;
@@ -41,6 +42,9 @@ static const char* gName_PvdSqHit[2]			= { "SceneQueries.Hits",			"BatchedQuerie
 static const char* gName_PxTransform[2]			= { "SceneQueries.PoseList",		"BatchedQueries.PoseList" };
 static const char* gName_PxFilterData[2]		= { "SceneQueries.FilterDataList",	"BatchedQueries.FilterDataList" };
 static const char* gName_PxGeometryHolder[2]	= { "SceneQueries.GeometryList",	"BatchedQueries.GeometryList" };
+static const char* gName_PvdSqSummary[2]		= { "SceneQueries.Summary",			"BatchedQueries.Summary" };
+
+PX_COMPILE_TIME_ASSERT(PvdSceneQueryCollector::NB_QUERY_TYPES == QueryID::QUERY_LINEAR_CONVEX_SWEEP_CLOSEST_OBJECT + 1);
 
 PvdSceneQueryCollector::PvdSceneQueryCollector(Scb::Scene& scene, bool isBatched) :
 	mAccumulatedRaycastQueries	(gName_PvdRaycast),
@@ -49,12 +53,132 @@ PvdSceneQueryCollector::PvdSceneQueryCollector(Scb::Scene& scene, bool isBatched
 	mPvdSqHits					(gName_PvdSqHit),
 	mPoses						(gName_PxTransform),
 	mFilterData					(gName_PxFilterData),
+	mSummaries					(gName_PvdSqSummary),
 	mScene						(scene),
 	mGeometries0				(gName_PxGeometryHolder),
 	mGeometries1				(gName_PxGeometryHolder),
 	mInUse						(0),
-	mIsBatched					(isBatched)
+	mIsBatched					(isBatched),
+	mBatchCaptured				(true),
+	mNbSampleCandidates			(0)
+{
+	for(PxU32 i=0; i<NB_QUERY_TYPES; i++)
+		mSummarySlots[i] = 0xffffffff;
+}
+
+PxU32 PvdSceneQueryCollector::getRaycastType(const PxQueryFilterData& fd, bool multipleHits)
+{
+	if(fd.flags & PxQueryFlag::eANY_HIT)	return QueryID::QUERY_RAYCAST_ANY_OBJECT;
+	else if(multipleHits)					return QueryID::QUERY_RAYCAST_ALL_OBJECTS;
+	else									return QueryID::QUERY_RAYCAST_CLOSEST_OBJECT;
+}
+
+PxU32 PvdSceneQueryCollector::getSweepType(const PxGeometry& geometry)
+{
+	const PxGeometryType::Enum type = geometry.getType();	// PT: TODO: QueryID::QUERY_LINEAR_xxx_SWEEP_ALL_OBJECTS are never used!
+	if(type==PxGeometryType::eBOX)												return QueryID::QUERY_LINEAR_OBB_SWEEP_CLOSEST_OBJECT;
+	else if(type==PxGeometryType::eSPHERE || type==PxGeometryType::eCAPSULE)	return QueryID::QUERY_LINEAR_CAPSULE_SWEEP_CLOSEST_OBJECT;
+	else if(type==PxGeometryType::eCONVEXMESH)									return QueryID::QUERY_LINEAR_CONVEX_SWEEP_CLOSEST_OBJECT;
+	PX_ASSERT(0);
+	return QueryID::QUERY_LINEAR_CONVEX_SWEEP_CLOSEST_OBJECT;
+}
+
+PxU32 PvdSceneQueryCollector::getOverlapType(const PxGeometry& geometry, const PxTransform& pose)
+{
+	const PxGeometryType::Enum type = geometry.getType();
+	if(type==PxGeometryType::eBOX)				return pose.q.isIdentity() ? QueryID::QUERY_OVERLAP_AABB_ALL_OBJECTS : QueryID::QUERY_OVERLAP_OBB_ALL_OBJECTS;
+	else if(type==PxGeometryType::eSPHERE)		return QueryID::QUERY_OVERLAP_SPHERE_ALL_OBJECTS;
+	else if(type==PxGeometryType::eCAPSULE)		return QueryID::QUERY_OVERLAP_CAPSULE_ALL_OBJECTS;
+	else if(type==PxGeometryType::eCONVEXMESH)	return QueryID::QUERY_OVERLAP_CONVEX_ALL_OBJECTS;
+	PX_ASSERT(0);
+	return QueryID::QUERY_OVERLAP_CONVEX_ALL_OBJECTS;
+}
+
+bool PvdSceneQueryCollector::sampleQuery(const PxPvdSceneQueryCaptureDesc& desc, const PxU32* group)
+{
+	if(group && desc.groupMask && !(*group & desc.groupMask))
+		return false;
+
+	const PxU32 candidate = mNbSampleCandidates++;
+	if(desc.sampleInterval > 1 && (candidate % desc.sampleInterval))
+		return false;
+
+	// Quotas are only consumed by the queries that pass all the tests
+	PxU32* groupCount = NULL;
+	if(group && desc.maxQueriesPerGroup)
+	{
+		groupCount = &mGroupCounts[*group];
+		if(*groupCount >= desc.maxQueriesPerGroup)
+			return false;
+	}
+
+	if(desc.maxQueriesPerThread)
+	{
+		PxU32& threadCount = mThreadCounts[Ps::Thread::getId()];
+		if(threadCount >= desc.maxQueriesPerThread)
+			return false;
+		threadCount++;
+	}
+
+	if(groupCount)
+		(*groupCount)++;
+	return true;
+}
+
+PvdSceneQueryCollector::Capture PvdSceneQueryCollector::selectCapture(const PxQueryFilterData& fd)
+{
+	const PxPvdSceneQueryCaptureDesc& desc = mScene.getScenePvdClient().getSceneQueryCaptureFast();
+	if(desc.mode == PxPvdSceneQueryCaptureMode::eALL)
+		return eCAPTURE_DETAILED;
+	if(desc.mode == PxPvdSceneQueryCaptureMode::eSUMMARY)
+		return eCAPTURE_SUMMARY;
+
+	// Queries issued from a batch follow the decision made for the whole batch
+	if(mIsBatched)
+		return mBatchCaptured ? eCAPTURE_DETAILED : eCAPTURE_NONE;
+
+	Ps::Mutex::ScopedLock lock(mMutex);
+	return sampleQuery(desc, &fd.data.word0) ? eCAPTURE_DETAILED : eCAPTURE_NONE;
+}
+
+PvdSceneQueryCollector::Capture PvdSceneQueryCollector::beginBatch()
+{
+	PX_ASSERT(mIsBatched);
+	const PxPvdSceneQueryCaptureDesc& desc = mScene.getScenePvdClient().getSceneQueryCaptureFast();
+	if(desc.mode == PxPvdSceneQueryCaptureMode::eSAMPLED)
+		mBatchCaptured = sampleQuery(desc, NULL);
+	else
+		mBatchCaptured = true;
+
+	if(desc.mode == PxPvdSceneQueryCaptureMode::eSUMMARY)
+		return eCAPTURE_SUMMARY;
+	return mBatchCaptured ? eCAPTURE_DETAILED : eCAPTURE_NONE;
+}
+
+void PvdSceneQueryCollector::addToSummary(PxU32 type, PxU32 nbHits, PxU64 elapsedTicks)
 {
+	PX_ASSERT(type < NB_QUERY_TYPES);
+	const PxF32 elapsedTime = PxF32(Ps::Time::getBootCounterFrequency().toTensOfNanos(elapsedTicks)) * 0.01f;
+
+	Ps::Mutex::ScopedLock lock(mMutex);
+
+	if(mSummarySlots[type] == 0xffffffff)
+	{
+		mSummarySlots[type] = mSummaries.size();
+		PvdSqSummary summary;
+		summary.mType		= type;
+		summary.mNbQueries	= 0;
+		summary.mNbHits		= 0;
+		summary.mTotalTime	= 0.0f;
+		summary.mMaxTime	= 0.0f;
+		mSummaries.pushBack(summary);
+	}
+
+	PvdSqSummary& summary = mSummaries[mSummarySlots[type]];
+	summary.mNbQueries++;
+	summary.mNbHits += nbHits;
+	summary.mTotalTime += elapsedTime;
+	summary.mMaxTime = PxMax(summary.mMaxTime, elapsedTime);
 }
 
 void PvdSceneQueryCollector::release()
@@ -132,9 +256,7 @@ void PvdSceneQueryCollector::raycast(const PxVec3& origin, const PxVec3& unitDir
 	raycastQuery.mUnitDir		= unitDir;
 	raycastQuery.mDistance		= distance;
 	raycastQuery.mFilterData	= fd.data;
-	if(fd.flags & PxQueryFlag::eANY_HIT)	raycastQuery.mType = QueryID::QUERY_RAYCAST_ANY_OBJECT;
-	else if(multipleHits)					raycastQuery.mType = QueryID::QUERY_RAYCAST_ALL_OBJECTS;
-	else									raycastQuery.mType = QueryID::QUERY_RAYCAST_CLOSEST_OBJECT;
+	raycastQuery.mType			= getRaycastType(fd, multipleHits);
 	clampNbHits(hitsNum, fd, multipleHits);
 
 	accumulate(raycastQuery, mAccumulatedRaycastQueries, getArrayName(mPvdSqHits), mPvdSqHits, hit, hitsNum, fd);
@@ -149,11 +271,7 @@ void PvdSceneQueryCollector::sweep(const PxGeometry& geometry, const PxTransform
 	pushBackT(mPoses, pose, sweepQuery.mPoses, getArrayName(mPoses));
 	pushBackT(mFilterData, fd.data, sweepQuery.mFilterData, getArrayName(mFilterData));
 
-	const PxGeometryType::Enum type = geometry.getType();	// PT: TODO: QueryID::QUERY_LINEAR_xxx_SWEEP_ALL_OBJECTS are never used!
-	if(type==PxGeometryType::eBOX)												sweepQuery.mType = QueryID::QUERY_LINEAR_OBB_SWEEP_CLOSEST_OBJECT;
-	else if(type==PxGeometryType::eSPHERE || type==PxGeometryType::eCAPSULE)	sweepQuery.mType = QueryID::QUERY_LINEAR_CAPSULE_SWEEP_CLOSEST_OBJECT;
-	else if(type==PxGeometryType::eCONVEXMESH)									sweepQuery.mType = QueryID::QUERY_LINEAR_CONVEX_SWEEP_CLOSEST_OBJECT;
-	else																		PX_ASSERT(0);
+	sweepQuery.mType		= getSweepType(geometry);
 	sweepQuery.mUnitDir		= unitDir;
 	sweepQuery.mDistance	= distance;
 	clampNbHits(hitsNum, fd, multipleHits);
@@ -168,12 +286,7 @@ void PvdSceneQueryCollector::overlapMultiple(const PxGeometry& geometry, const P
 	PvdOverlap overlapQuery;
 	pushBackT(getGeometries(mInUse), PxGeometryHolder(geometry), overlapQuery.mGeometries, getArrayName(getGeometries(mInUse)));	// PT: TODO: optimize this. We memcopy once to the stack, then again to the array....
 
-	const PxGeometryType::Enum type = geometry.getType();
-	if(type==PxGeometryType::eBOX)				overlapQuery.mType = pose.q.isIdentity() ? QueryID::QUERY_OVERLAP_AABB_ALL_OBJECTS : QueryID::QUERY_OVERLAP_OBB_ALL_OBJECTS;
-	else if(type==PxGeometryType::eSPHERE)		overlapQuery.mType = QueryID::QUERY_OVERLAP_SPHERE_ALL_OBJECTS;
-	else if(type==PxGeometryType::eCAPSULE)		overlapQuery.mType = QueryID::QUERY_OVERLAP_CAPSULE_ALL_OBJECTS;
-	else if(type==PxGeometryType::eCONVEXMESH)	overlapQuery.mType = QueryID::QUERY_OVERLAP_CONVEX_ALL_OBJECTS;
-	else										PX_ASSERT(0);
+	overlapQuery.mType			= getOverlapType(geometry, pose);
 	overlapQuery.mPose			= pose;
 	overlapQuery.mFilterData	= fd.data;
 
@@ -32,10 +32,13 @@
 
 #include "CmPhysXCommon.h"
 #include "PsArray.h"
+#include "PsHashMap.h"
+#include "PsThread.h"
 #include "PxFiltering.h"
 #include "PxGeometryHelpers.h"
 #include "PxQueryReport.h"
 #include "PxBatchQueryDesc.h"
+#include "PxPvdSceneClient.h"
 
 #if PX_SUPPORT_PVD
 
@@ -147,6 +150,16 @@ struct PvdSqHit
 	}
 };
 
+// Per query type totals sent instead of the individual queries in PxPvdSceneQueryCaptureMode::eSUMMARY mode.
+struct PvdSqSummary
+{
+	PxU32			mType;
+	PxU32			mNbQueries;
+	PxU32			mNbHits;
+	PxF32			mTotalTime;	// In microseconds
+	PxF32			mMaxTime;	// In microseconds
+};
+
 template <class T>
 class NamedArray : public Ps::Array<T>
 {
@@ -160,6 +173,18 @@ class PvdSceneQueryCollector
 {
 	PX_NOCOPY(PvdSceneQueryCollector)
 public:
+	enum
+	{
+		NB_QUERY_TYPES = 11		// Number of Sq::QueryID values
+	};
+
+	enum Capture
+	{
+		eCAPTURE_NONE,
+		eCAPTURE_DETAILED,
+		eCAPTURE_SUMMARY
+	};
+
 	PvdSceneQueryCollector(Scb::Scene& scene, bool isBatched);
 	~PvdSceneQueryCollector()	{}
 
@@ -173,6 +198,12 @@ public:
 		mPvdSqHits.clear();
 		mPoses.clear();
 		mFilterData.clear();
+		mSummaries.clear();
+		for(PxU32 i=0; i<NB_QUERY_TYPES; i++)
+			mSummarySlots[i] = 0xffffffff;
+		mGroupCounts.clear();
+		mThreadCounts.clear();
+		mNbSampleCandidates = 0;
 	}
 
 	void clearGeometryArrays()
@@ -187,6 +218,17 @@ public:
 	void sweep(const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, PxReal distance, const PxSweepHit* hit, PxU32 hitsNum, const PxQueryFilterData& filterData, bool multipleHits);
 	void overlapMultiple(const PxGeometry& geometry, const PxTransform& pose, const PxOverlapHit* hit, PxU32 hitsNum, const PxQueryFilterData& filterData);
 
+	// Decides how a single (non batched) query is captured, according to the scene's PxPvdSceneQueryCaptureDesc.
+	Capture	selectCapture(const PxQueryFilterData& filterData);
+	// Decides whether the next batch is captured. Batches are sampled as a whole. Call with the lock held.
+	Capture	beginBatch();
+	// Adds a query to the per type totals, for eCAPTURE_SUMMARY. The elapsed time is in counter ticks.
+	void	addToSummary(PxU32 type, PxU32 nbHits, PxU64 elapsedTicks);
+
+	static	PxU32	getRaycastType(const PxQueryFilterData& filterData, bool multipleHits);
+	static	PxU32	getSweepType(const PxGeometry& geometry);
+	static	PxU32	getOverlapType(const PxGeometry& geometry, const PxTransform& pose);
+
 	void collectAllBatchedHits	(const PxRaycastQueryResult* raycastResults, PxU32 nbRaycastResults, PxU32 batchedRayQstartIdx,
 								const PxOverlapQueryResult* overlapResults, PxU32 nbOverlapResults, PxU32 batchedOverlapQstartIdx,
 								const PxSweepQueryResult* sweepResults, PxU32 nbSweepResults, PxU32 batchedSweepQstartIdx);
@@ -214,14 +256,22 @@ public:
 	NamedArray<PvdSqHit>		mPvdSqHits;
 	NamedArray<PxTransform>		mPoses;
 	NamedArray<PxFilterData>	mFilterData;
+	NamedArray<PvdSqSummary>	mSummaries;
 
 private:
+	bool	sampleQuery(const PxPvdSceneQueryCaptureDesc& desc, const PxU32* group);
+
 	Scb::Scene&					mScene;
 	Ps::Mutex					mMutex;
 	NamedArray<PxGeometryHolder>mGeometries0;
 	NamedArray<PxGeometryHolder>mGeometries1;
 	PxU32						mInUse;
 	const bool					mIsBatched;
+	bool						mBatchCaptured;
+	PxU32						mSummarySlots[NB_QUERY_TYPES];
+	Ps::HashMap<PxU32, PxU32>	mGroupCounts;
+	Ps::HashMap<size_t, PxU32>	mThreadCounts;
+	PxU32						mNbSampleCandidates;
 };
 }
 }
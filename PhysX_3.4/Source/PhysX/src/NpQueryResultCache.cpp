@@ -0,0 +1,229 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "NpQueryResultCache.h"
+#include "NpSceneQueries.h"
+#include "NpShape.h"
+#include "NpQueryShared.h"
+#include "PsHash.h"
+#include "PsUtilities.h"
+
+using namespace physx;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static PX_FORCE_INLINE PxU32 floatBits(PxReal f)
+{
+	return PxUnionCast<PxU32, PxReal>(f);
+}
+
+static PX_FORCE_INLINE bool sameVec(const PxVec3& a, const PxVec3& b)
+{
+	return a.x==b.x && a.y==b.y && a.z==b.z;
+}
+
+static PX_FORCE_INLINE bool sameQuat(const PxQuat& a, const PxQuat& b)
+{
+	return a.x==b.x && a.y==b.y && a.z==b.z && a.w==b.w;
+}
+
+// only the geometries supported by overlap and sweep queries are compared, see QueryResultKey::set()
+static bool sameGeometry(const PxGeometryHolder& a, const PxGeometryHolder& b)
+{
+	if(a.getType()!=b.getType())
+		return false;
+
+	switch(a.getType())
+	{
+		case PxGeometryType::eSPHERE:
+			return a.sphere().radius==b.sphere().radius;
+
+		case PxGeometryType::eCAPSULE:
+			return a.capsule().radius==b.capsule().radius && a.capsule().halfHeight==b.capsule().halfHeight;
+
+		case PxGeometryType::eBOX:
+			return sameVec(a.box().halfExtents, b.box().halfExtents);
+
+		case PxGeometryType::eCONVEXMESH:
+		{
+			const PxConvexMeshGeometry& ca = a.convexMesh();
+			const PxConvexMeshGeometry& cb = b.convexMesh();
+			return ca.convexMesh==cb.convexMesh && ca.meshFlags==cb.meshFlags
+				&& sameVec(ca.scale.scale, cb.scale.scale) && sameQuat(ca.scale.rotation, cb.scale.rotation);
+		}
+
+		case PxGeometryType::ePLANE:
+		case PxGeometryType::eTRIANGLEMESH:
+		case PxGeometryType::eHEIGHTFIELD:
+		case PxGeometryType::eGEOMETRY_COUNT:
+		case PxGeometryType::eINVALID:
+			break;
+	}
+	return false;
+}
+
+template<typename HitType>
+bool QueryResultKey::set(const MultiQueryInput& input, PxHitFlags flags, const PxQueryFilterData& fd, PxQueryFilterCallback* fc, PxU32 nbTouches)
+{
+	// zero the unused members so that operator== and hash() do not need to know the query type
+	origin = dir = PxVec3(0.0f);
+	maxDistance = inflation = 0.0f;
+	pose = PxTransform(PxIdentity);
+
+	if(HitTypeSupport<HitType>::IsOverlap==0)
+	{
+		dir = input.getDir();
+		maxDistance = input.maxDistance;
+	}
+
+	if(HitTypeSupport<HitType>::IsRaycast)
+	{
+		origin = input.getOrigin();
+		geometry.storeAny(PxSphereGeometry(0.0f));
+	}
+	else
+	{
+		const PxGeometryType::Enum type = input.geometry->getType();
+		if(type!=PxGeometryType::eSPHERE && type!=PxGeometryType::eCAPSULE && type!=PxGeometryType::eBOX && type!=PxGeometryType::eCONVEXMESH)
+			return false;
+		geometry.storeAny(*input.geometry);
+		pose = *input.pose;
+		inflation = input.inflation;
+	}
+
+	filterData = fd.data;
+	filterCall = fc;
+	maxNbTouches = nbTouches;
+	queryFlags = PxU16(fd.flags);
+	hitFlags = PxU16(flags);
+	clientId = fd.clientId;
+	return true;
+}
+
+bool QueryResultKey::operator==(const QueryResultKey& other) const
+{
+	return	sameVec(origin, other.origin) && sameVec(dir, other.dir) && maxDistance==other.maxDistance && inflation==other.inflation
+		&&	sameGeometry(geometry, other.geometry) && sameVec(pose.p, other.pose.p) && sameQuat(pose.q, other.pose.q)
+		&&	filterData.word0==other.filterData.word0 && filterData.word1==other.filterData.word1
+		&&	filterData.word2==other.filterData.word2 && filterData.word3==other.filterData.word3
+		&&	filterCall==other.filterCall && maxNbTouches==other.maxNbTouches
+		&&	queryFlags==other.queryFlags && hitFlags==other.hitFlags && clientId==other.clientId;
+}
+
+PxU32 QueryResultKey::hash() const
+{
+	// queries repeated every frame differ by their position first, the rest mostly tells the callers apart
+	PxU32 h = Ps::hash(floatBits(origin.x)) ^ Ps::hash(floatBits(origin.y)+1) ^ Ps::hash(floatBits(origin.z)+2);
+	h ^= Ps::hash(floatBits(pose.p.x)+3) ^ Ps::hash(floatBits(pose.p.y)+4) ^ Ps::hash(floatBits(pose.p.z)+5);
+	h ^= Ps::hash(floatBits(dir.x) + floatBits(dir.y)*3 + floatBits(dir.z)*5 + floatBits(maxDistance)*7);
+	h ^= Ps::hash(filterData.word0 + filterData.word1*3 + filterData.word2*5 + filterData.word3*7 + PxU32(geometry.getType())*11);
+	return h;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+QueryResultCache::QueryResultCache() : mNbHits(0), mNbMisses(0)
+{
+}
+
+QueryResultCache::~QueryResultCache()
+{
+}
+
+template<typename HitType>
+bool QueryResultCache::fetch(const QueryResultKey& key, const PxU32* timestamps, PxHitCallback<HitType>& hits)
+{
+	Ps::Mutex::ScopedLock lock(mLock);
+
+	const Entry<HitType>& entry = getEntries(static_cast<const HitType*>(NULL))[key.hash() % NB_ENTRIES];
+
+	// pruners the query does not traverse can change freely, e.g. the dynamic pruner for static-only queries
+	const bool staticValid = !(key.queryFlags & PxQueryFlag::eSTATIC) || entry.timestamps[0]==timestamps[0];
+	const bool dynamicValid = !(key.queryFlags & PxQueryFlag::eDYNAMIC) || entry.timestamps[1]==timestamps[1];
+
+	if(!entry.valid || !staticValid || !dynamicValid || !(entry.key==key))
+	{
+		mNbMisses++;
+		return false;
+	}
+	mNbHits++;
+
+	PX_ASSERT(entry.touches.size()<=hits.maxNbTouches);
+	hits.hasBlock = entry.hasBlock;
+	if(entry.hasBlock)
+		hits.block = entry.block;
+	hits.nbTouches = entry.touches.size();
+	for(PxU32 i=0;i<hits.nbTouches;i++)
+		hits.touches[i] = entry.touches[i];
+	return true;
+}
+
+template<typename HitType>
+void QueryResultCache::store(const QueryResultKey& key, const PxU32* timestamps, const PxHitCallback<HitType>& hits)
+{
+	Ps::Mutex::ScopedLock lock(mLock);
+
+	Entry<HitType>& entry = getEntries(static_cast<const HitType*>(NULL))[key.hash() % NB_ENTRIES];
+
+	entry.key = key;
+	entry.timestamps[0] = timestamps[0];
+	entry.timestamps[1] = timestamps[1];
+	entry.valid = true;
+	entry.hasBlock = hits.hasBlock;
+	if(hits.hasBlock)
+		entry.block = hits.block;
+	entry.touches.clear();
+	for(PxU32 i=0;i<hits.nbTouches;i++)
+		entry.touches.pushBack(hits.touches[i]);
+}
+
+void QueryResultCache::getStats(PxU32& nbHits, PxU32& nbMisses) const
+{
+	Ps::Mutex::ScopedLock lock(mLock);
+	nbHits = mNbHits;
+	nbMisses = mNbMisses;
+}
+
+void QueryResultCache::resetStats()
+{
+	Ps::Mutex::ScopedLock lock(mLock);
+	mNbHits = 0;
+	mNbMisses = 0;
+}
+
+//explicit template instantiations
+template bool QueryResultKey::set<PxRaycastHit>(const MultiQueryInput&, PxHitFlags, const PxQueryFilterData&, PxQueryFilterCallback*, PxU32);
+template bool QueryResultKey::set<PxOverlapHit>(const MultiQueryInput&, PxHitFlags, const PxQueryFilterData&, PxQueryFilterCallback*, PxU32);
+template bool QueryResultKey::set<PxSweepHit>(const MultiQueryInput&, PxHitFlags, const PxQueryFilterData&, PxQueryFilterCallback*, PxU32);
+template bool QueryResultCache::fetch<PxRaycastHit>(const QueryResultKey&, const PxU32*, PxHitCallback<PxRaycastHit>&);
+template bool QueryResultCache::fetch<PxOverlapHit>(const QueryResultKey&, const PxU32*, PxHitCallback<PxOverlapHit>&);
+template bool QueryResultCache::fetch<PxSweepHit>(const QueryResultKey&, const PxU32*, PxHitCallback<PxSweepHit>&);
+template void QueryResultCache::store<PxRaycastHit>(const QueryResultKey&, const PxU32*, const PxHitCallback<PxRaycastHit>&);
+template void QueryResultCache::store<PxOverlapHit>(const QueryResultKey&, const PxU32*, const PxHitCallback<PxOverlapHit>&);
+template void QueryResultCache::store<PxSweepHit>(const QueryResultKey&, const PxU32*, const PxHitCallback<PxSweepHit>&);
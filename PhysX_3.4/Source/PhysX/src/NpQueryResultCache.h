@@ -0,0 +1,118 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_PHYSICS_NP_QUERYRESULTCACHE
+#define PX_PHYSICS_NP_QUERYRESULTCACHE
+
+#include "PxQueryReport.h"
+#include "PxQueryFiltering.h"
+#include "geometry/PxGeometryHelpers.h"
+#include "PsArray.h"
+#include "PsMutex.h"
+#include "CmPhysXCommon.h"
+
+namespace physx
+{
+	struct MultiQueryInput;
+
+	// Everything that determines the result of a scene query, see PxQueryFlag::eCACHE_RESULTS.
+	// The filter callbacks are identified by their address only.
+	struct QueryResultKey
+	{
+		PxVec3					origin;			// raycasts only
+		PxVec3					dir;			// raycasts and sweeps
+		PxReal					maxDistance;	// raycasts and sweeps
+		PxReal					inflation;		// sweeps only
+		PxGeometryHolder		geometry;		// overlaps and sweeps
+		PxTransform				pose;			// overlaps and sweeps
+		PxFilterData			filterData;
+		PxQueryFilterCallback*	filterCall;
+		PxU32					maxNbTouches;
+		PxU16					queryFlags;
+		PxU16					hitFlags;
+		PxU8					clientId;
+
+		// returns false if the query cannot be cached (unsupported query geometry)
+		template<typename HitType>
+		bool	set(const MultiQueryInput& input, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxU32 maxNbTouches);
+		bool	operator==(const QueryResultKey& other)	const;
+		PxU32	hash()									const;
+	};
+
+	// Results of previous scene queries, returned again for identical queries as long as the pruners
+	// they traversed did not change. Used by the queries with PxQueryFlag::eCACHE_RESULTS.
+	class QueryResultCache
+	{
+		PX_NOCOPY(QueryResultCache)
+	public:
+										QueryResultCache();
+										~QueryResultCache();
+
+		// copies the cached results to 'hits' and returns true if the query was found with unchanged pruners.
+		// 'timestamps' are the current static and dynamic pruner timestamps.
+		template<typename HitType>
+				bool					fetch(const QueryResultKey& key, const PxU32* timestamps, PxHitCallback<HitType>& hits);
+
+		// records the results of a completed query, which must not have flushed touches to processTouches()
+		template<typename HitType>
+				void					store(const QueryResultKey& key, const PxU32* timestamps, const PxHitCallback<HitType>& hits);
+
+				void					getStats(PxU32& nbHits, PxU32& nbMisses)	const;
+				void					resetStats();
+
+		template<typename HitType>
+		struct Entry
+		{
+								Entry() : valid(false), hasBlock(false)	{}
+
+			QueryResultKey		key;
+			PxU32				timestamps[2];
+			bool				valid;
+			bool				hasBlock;
+			HitType				block;
+			Ps::Array<HitType>	touches;
+		};
+
+		// direct-mapped, a new query replaces the entry of its slot
+		static const PxU32				NB_ENTRIES = 32;
+	private:
+				Entry<PxRaycastHit>		mRaycastEntries[NB_ENTRIES];
+				Entry<PxOverlapHit>		mOverlapEntries[NB_ENTRIES];
+				Entry<PxSweepHit>		mSweepEntries[NB_ENTRIES];
+				PxU32					mNbHits;
+				PxU32					mNbMisses;
+		mutable	Ps::Mutex				mLock;	// queries can run in parallel from several threads
+
+				Entry<PxRaycastHit>*	getEntries(const PxRaycastHit*)	{ return mRaycastEntries;	}
+				Entry<PxOverlapHit>*	getEntries(const PxOverlapHit*)	{ return mOverlapEntries;	}
+				Entry<PxSweepHit>*		getEntries(const PxSweepHit*)	{ return mSweepEntries;		}
+	};
+}
+
+#endif
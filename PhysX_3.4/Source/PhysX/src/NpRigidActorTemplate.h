@@ -115,7 +115,7 @@ public:
 
 #if PX_ENABLE_DEBUG_VISUALIZATION
 public:
-					void					visualize(Cm::RenderOutput& out, NpScene* scene);
+					void					visualize(Cm::RenderOutput& out, NpScene* scene, const PxTransform& actorPose);
 #endif
 protected:
 	PX_FORCE_INLINE void					setActorSimFlag(bool value);
@@ -458,9 +458,9 @@ bool NpRigidActorTemplate<APIClass>::resetFiltering(Scb::RigidObject& ro, PxShap
 
 #if PX_ENABLE_DEBUG_VISUALIZATION
 template<class APIClass>
-void NpRigidActorTemplate<APIClass>::visualize(Cm::RenderOutput& out, NpScene* scene)
+void NpRigidActorTemplate<APIClass>::visualize(Cm::RenderOutput& out, NpScene* scene, const PxTransform& actorPose)
 {
-	mShapeManager.visualize(out, scene, *this);
+	mShapeManager.visualize(out, scene, actorPose);
 }
 #endif  // PX_ENABLE_DEBUG_VISUALIZATION
 
@@ -392,7 +392,10 @@ void NpRigidBodyTemplate<APIClass>::clearSpatialForce(PxForceMode::Enum mode, bo
 template<class APIClass>
 void NpRigidBodyTemplate<APIClass>::visualize(Cm::RenderOutput& out, NpScene* scene)
 {
-	RigidActorTemplateClass::visualize(out, scene);
+	// the internal pose is used because this can run on worker threads, where the API read checks would fail
+	const PxTransform actorPose = mBody.getBody2World() * mBody.getBody2Actor().getInverse();
+
+	RigidActorTemplateClass::visualize(out, scene, actorPose);
 
 	if (mBody.getActorFlags() & PxActorFlag::eVISUALIZATION)
 	{
@@ -402,7 +405,7 @@ void NpRigidBodyTemplate<APIClass>::visualize(Cm::RenderOutput& out, NpScene* sc
 		//visualize actor frames
 		const PxReal actorAxes = scale * scbScene.getVisualizationParameter(PxVisualizationParameter::eACTOR_AXES);
 		if (actorAxes != 0.0f)
-			out << getGlobalPose() << Cm::DebugBasis(PxVec3(actorAxes));
+			out << actorPose << Cm::DebugBasis(PxVec3(actorAxes));
 
 		const PxReal bodyAxes = scale * scbScene.getVisualizationParameter(PxVisualizationParameter::eBODY_AXES);
 		if (bodyAxes != 0.0f)
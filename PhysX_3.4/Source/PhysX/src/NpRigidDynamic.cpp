@@ -75,6 +75,11 @@ void NpRigidDynamic::setGlobalPose(const PxTransform& pose, bool autowake)
 	PX_CHECK_AND_RETURN(pose.isSane(), "PxRigidDynamic::setGlobalPose: pose is not valid.");
 	NP_WRITE_CHECK(NpActor::getOwnerScene(*this));
 
+	setGlobalPoseInternal(scene, pose, autowake);
+}
+
+void NpRigidDynamic::setGlobalPoseInternal(NpScene* scene, const PxTransform& pose, bool autowake)
+{
 	if(scene)
 		updateDynamicSceneQueryShapes(mShapeManager, scene->getSceneQueryManagerFast());
 
@@ -132,6 +137,11 @@ void NpRigidDynamic::setKinematicTarget(const PxTransform& destination)
 	setKinematicTargetInternal(destination.getNormalized());
 }
 
+void NpRigidDynamic::setKinematicTargetNoCheck(const PxTransform& destination)
+{
+	setKinematicTargetInternal(destination);
+}
+
 
 bool NpRigidDynamic::getKinematicTarget(PxTransform& target) const
 {
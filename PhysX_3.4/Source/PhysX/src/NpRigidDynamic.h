@@ -142,6 +142,12 @@ public:
 	PX_FORCE_INLINE void			wakeUpInternal();
 					void			wakeUpInternalNoKinematicTest(Scb::Body& body, bool forceWakeUp, bool autowake);
 
+	// setGlobalPose() without the checks, for the bulk functions of NpScene. 'scene' is the API scene of the actor.
+					void			setGlobalPoseInternal(NpScene* scene, const PxTransform& pose, bool autowake);
+
+	// setKinematicTarget() without the checks, for the bulk functions of NpScene. Expects a normalized target.
+					void			setKinematicTargetNoCheck(const PxTransform& destination);
+
 private:
 	PX_FORCE_INLINE	void			setKinematicTargetInternal(const PxTransform& destination);
 
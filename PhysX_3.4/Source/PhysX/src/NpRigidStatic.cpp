@@ -163,7 +163,7 @@ bool NpRigidStatic::checkConstraintValidity() const
 #if PX_ENABLE_DEBUG_VISUALIZATION
 void NpRigidStatic::visualize(Cm::RenderOutput& out, NpScene* scene)
 {
-	NpRigidStaticT::visualize(out, scene);
+	NpRigidStaticT::visualize(out, scene, getGlobalPoseFast());
 
 	if (getScbRigidStaticFast().getActorFlags() & PxActorFlag::eVISUALIZATION)
 	{
@@ -173,7 +173,7 @@ void NpRigidStatic::visualize(Cm::RenderOutput& out, NpScene* scene)
 		//visualize actor frames
 		PxReal actorAxes = scale * scbScene.getVisualizationParameter(PxVisualizationParameter::eACTOR_AXES);
 		if (actorAxes != 0)
-			out << getGlobalPose() << Cm::DebugBasis(PxVec3(actorAxes));
+			out << getGlobalPoseFast() << Cm::DebugBasis(PxVec3(actorAxes));
 	}
 }
 #endif
@@ -59,6 +59,8 @@
 #include "ScbNpDeps.h"
 #include "CmCollection.h"
 #include "CmUtils.h"
+#include "CmTask.h"
+#include "ScSimStats.h"
 
 #if PX_SUPPORT_GPU_PHYSX
 #include "task/PxGpuDispatcher.h"
@@ -93,10 +95,26 @@ static PX_FORCE_INLINE bool removeFromSceneCheck(NpScene* npScene, PxScene* scen
 	}
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+class SqRefFinder: public Sc::SqRefFinder
+{
+public:
+	virtual	Sq::PrunerHandle find(const PxRigidBody* body, const PxShape* shape)
+	{
+		const Sq::PrunerData prunerdata = NpActor::getShapeManager(*body)->findSceneQueryData(*static_cast<const NpShape*>(shape));
+		return Sq::getPrunerHandle(prunerdata);
+	}
+private:
+};
+
+// stateless, shared by the scenes that sync their SQ bounds during the simulation step
+static SqRefFinder gSqRefFinder;
+
 ///////////////////////////////////////////////////////////////////////////////
 NpSceneQueries::NpSceneQueries(const PxSceneDesc& desc) : 
 	mScene					(desc, getContextId()),
-	mSQManager				(mScene, desc.staticStructure, desc.dynamicStructure, desc.dynamicTreeRebuildRateHint, desc.limits),
+	mSQManager				(mScene, desc.staticStructure, desc.dynamicStructure, desc.dynamicTreeRebuildRateHint, desc.limits, desc.flags & PxSceneFlag::eENABLE_SCENE_QUERY_SNAPSHOTS, desc.flags & PxSceneFlag::eENABLE_BACKGROUND_STATIC_TREE_REBUILD, desc.flags & PxSceneFlag::eENABLE_QUANTIZED_STATIC_TREE),
 	mCachedRaycastFuncs		(Gu::getRaycastFuncTable()),
 	mCachedSweepFuncs		(Gu::getSweepFuncTable()),
 	mCachedOverlapFuncs		(Gu::getOverlapFuncTable()),
@@ -110,6 +128,10 @@ NpSceneQueries::NpSceneQueries(const PxSceneDesc& desc) :
 {
 	mSceneQueriesStaticPrunerUpdate.setObject(this);
 	mSceneQueriesDynamicPrunerUpdate.setObject(this);
+
+	// with GPU dynamics the final bounds are only available in fetchResults()
+	if(desc.syncSceneQueryBoundsInSimulation && !(desc.flags & PxSceneFlag::eENABLE_GPU_DYNAMICS))
+		mScene.getScScene().setSqBoundsSyncInSimulation(&mSQManager.getDynamicBoundsSync(), &gSqRefFinder);
 }
 
 NpScene::NpScene(const PxSceneDesc& desc) :
@@ -125,6 +147,9 @@ NpScene::NpScene(const PxSceneDesc& desc) :
 	mPxCloths				(PX_DEBUG_EXP("sceneCloths")),
 #endif
 	mSanityBounds			(desc.sanityBounds),
+	mOriginX				(0.0),
+	mOriginY				(0.0),
+	mOriginZ				(0.0),
 	mNbClients				(1),			//we always have the default client.
 	mClientBehaviorFlags	(PX_DEBUG_EXP("sceneBehaviorFlags")),
 	mSceneCompletion		(getContextId(), mPhysicsDone),
@@ -141,7 +166,10 @@ NpScene::NpScene(const PxSceneDesc& desc) :
 	mCurrentWriter			(0),
 	mSceneQueriesUpdateRunning	(false),
 	mHasSimulatedOnce		(false),
-	mBetweenFetchResults	(false)
+	mBetweenFetchResults	(false),
+	mEventCallbacksDeferred	(false),
+	mPublishedFrameState	(0),
+	mContactSummaryCallback	(NULL)
 {
 	
 	mSceneExecution.setObject(this);
@@ -211,6 +239,10 @@ NpScene::~NpScene()
 		PX_DELETE(mBatchQueries[numSq]);
 	mBatchQueries.clear();
 
+	for(PxU32 i=0; i<mVisualizationJobBuffers.size(); i++)
+		PX_DELETE(mVisualizationJobBuffers[i]);
+	mVisualizationJobBuffers.clear();
+
 	mScene.release();
 
 	// unlock the lock taken in release(), must unlock before 
@@ -454,11 +486,20 @@ void NpScene::addActorInternal(PxActor& actor)
 	}
 }
 
-void NpScene::updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Actor& scbActor, NpShapeManager& shapeManager, bool actorDynamic, const PxBounds3* bounds, bool hasPrunerStructure)
+// scene query shapes of an addActors() call, added to each pruner with a single call. Shapes are added in actor order.
+struct NpScene::SqInsertionBatch
 {
-	// all the things Scb does in non-buffered insertion
-	SceneQueryManager& sqManager = getSceneQueryManagerFast();
+	Ps::Array<const NpShape*>		mShapes[2];
+	Ps::Array<const PxRigidActor*>	mActors[2];
+	Ps::Array<PxBounds3>			mBounds[2];
+	Ps::Array<NpShapeManager*>		mShapeManagers[2];
+	Ps::Array<PxU32>				mShapeIndices[2];
+	Ps::Array<PrunerData>			mResults;
+};
 
+void NpScene::updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Actor& scbActor, NpShapeManager& shapeManager, bool actorDynamic, const PxBounds3* bounds, SqInsertionBatch& sqBatch)
+{
+	// all the things Scb does in non-buffered insertion
 	scbActor.setScbScene(&mScene);
 	scbActor.setControlState(Scb::ControlState::eIN_SCENE);
 	NpShape*const * shapes = shapeManager.getShapes();
@@ -479,16 +520,46 @@ void NpScene::updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Acto
 		// PT: this part is copied from 'NpShapeManager::setupAllSceneQuery'
 		if(shapeFlags & PxShapeFlag::eSCENE_QUERY_SHAPE)	// PT: TODO: refactor with 'isSceneQuery' in shape manager?
 		{
-			const PrunerData data = sqManager.addPrunerShape(shape, rigidActor, actorDynamic, bounds ? bounds+i : NULL, hasPrunerStructure);
-			shapeManager.setPrunerData(i, data);
+			const PxU32 index = PxU32(actorDynamic);
+			sqBatch.mShapes[index].pushBack(&shape);
+			sqBatch.mActors[index].pushBack(&rigidActor);
+			sqBatch.mBounds[index].pushBack(bounds[i]);
+			sqBatch.mShapeManagers[index].pushBack(&shapeManager);
+			sqBatch.mShapeIndices[index].pushBack(i);
 		}
 	}			
 }
 
-PX_FORCE_INLINE	void NpScene::updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Body& body, NpShapeManager& shapeManager, bool actorDynamic, const PxBounds3* bounds, bool hasPrunerStructure)
+PX_FORCE_INLINE	void NpScene::updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Body& body, NpShapeManager& shapeManager, bool actorDynamic, const PxBounds3* bounds, SqInsertionBatch& sqBatch)
 {
 	body.initBufferedState();
-	updateScbStateAndSetupSq(rigidActor, static_cast<Scb::Actor&>(body), shapeManager, actorDynamic, bounds, hasPrunerStructure);
+	updateScbStateAndSetupSq(rigidActor, static_cast<Scb::Actor&>(body), shapeManager, actorDynamic, bounds, sqBatch);
+}
+
+void NpScene::flushSqInsertionBatch(SqInsertionBatch& sqBatch, bool hasPrunerStructure)
+{
+	SceneQueryManager& sqManager = getSceneQueryManagerFast();
+
+	for(PxU32 index=0; index<2; index++)
+	{
+		const PxU32 nbShapes = sqBatch.mShapes[index].size();
+		if(!nbShapes)
+			continue;
+
+		sqBatch.mBounds[index].insert();	// for safe reads in inflateBounds
+		sqBatch.mResults.resizeUninitialized(nbShapes);
+		sqManager.addPrunerShapes(nbShapes, sqBatch.mShapes[index].begin(), sqBatch.mActors[index].begin(), sqBatch.mBounds[index].begin(),
+			index!=0, sqBatch.mResults.begin(), hasPrunerStructure);
+
+		for(PxU32 i=0; i<nbShapes; i++)
+			sqBatch.mShapeManagers[index][i]->setPrunerData(sqBatch.mShapeIndices[index][i], sqBatch.mResults[i]);
+
+		sqBatch.mShapes[index].clear();
+		sqBatch.mActors[index].clear();
+		sqBatch.mBounds[index].clear();
+		sqBatch.mShapeManagers[index].clear();
+		sqBatch.mShapeIndices[index].clear();
+	}
 }
 
 void NpScene::addActors(PxActor*const* actors, PxU32 nbActors)
@@ -527,6 +598,8 @@ void NpScene::addActorsInternal(PxActor*const* PX_RESTRICT actors, PxU32 nbActor
 
 	Sc::BatchInsertionState scState;
 	scScene.startBatchInsertion(scState);
+	mRigidActors.reserve(mRigidActors.size() + nbActors);
+	SqInsertionBatch sqBatch;
 
 	scState.staticActorOffset		= ptrdiff_t(size_t(&(reinterpret_cast<NpRigidStatic*>(0)->getScbRigidStaticFast().getScStatic())));
 	scState.staticShapeTableOffset	= ptrdiff_t(size_t(&(reinterpret_cast<NpRigidStatic*>(0)->getShapeManager().getShapeTable())));
@@ -569,12 +642,15 @@ void NpScene::addActorsInternal(PxActor*const* PX_RESTRICT actors, PxU32 nbActor
 			{
 				shapeBounds.resizeUninitialized(a.NpRigidStatic::getNbShapes()+1);	// PT: +1 for safe reads in addPrunerData/inflateBounds
 				scScene.addStatic(&a, scState, shapeBounds.begin());
-				updateScbStateAndSetupSq(a, a.getScbActorFast(), a.getShapeManager(), false, shapeBounds.begin(), hasPrunerStructure);
+				updateScbStateAndSetupSq(a, a.getScbActorFast(), a.getShapeManager(), false, shapeBounds.begin(), sqBatch);
 				addRigidActorToArray(a, mRigidActors);
 				a.addConstraintsToScene();
 			}
 			else
+			{
+				flushSqInsertionBatch(sqBatch, hasPrunerStructure);	// keep the pruner insertion order, the pruning structure merge relies on it
 				addRigidStatic(a, hasPrunerStructure);
+			}
 		}
 		else if(type == PxConcreteType::eRIGID_DYNAMIC)
 		{
@@ -592,12 +668,15 @@ void NpScene::addActorsInternal(PxActor*const* PX_RESTRICT actors, PxU32 nbActor
 			{
 				shapeBounds.resizeUninitialized(a.NpRigidDynamic::getNbShapes()+1);	// PT: +1 for safe reads in addPrunerData/inflateBounds
 				scScene.addBody(&a, scState, shapeBounds.begin());
-				updateScbStateAndSetupSq(a, a.getScbBodyFast(), a.getShapeManager(), true, shapeBounds.begin(), hasPrunerStructure);
+				updateScbStateAndSetupSq(a, a.getScbBodyFast(), a.getShapeManager(), true, shapeBounds.begin(), sqBatch);
 				addRigidActorToArray(a, mRigidActors);
 				a.addConstraintsToScene();
 			}
 			else
+			{
+				flushSqInsertionBatch(sqBatch, hasPrunerStructure);
 				addRigidDynamic(a, hasPrunerStructure);
+			}
 		}
 		else if(type == PxConcreteType::eCLOTH || type == PxConcreteType::ePARTICLE_SYSTEM || type == PxConcreteType::ePARTICLE_FLUID)
 		{
@@ -609,6 +688,9 @@ void NpScene::addActorsInternal(PxActor*const* PX_RESTRICT actors, PxU32 nbActor
 			break;
 		}
 	}
+	// the pruner data has to be set before the pruning structure merge and before any back out below
+	flushSqInsertionBatch(sqBatch, hasPrunerStructure);
+
 	// merge sq PrunerStructure
 	if(pS)
 	{		
@@ -726,6 +808,36 @@ void NpScene::removeActors(PxActor*const* PX_RESTRICT actors, PxU32 nbActors, bo
 	scScene.setBatchRemove(NULL);
 }
 
+void NpScene::removeActors(const PxPruningStructure& ps, bool wakeOnLostTouch)
+{
+	PX_PROFILE_ZONE("API.removeActors", getContextId());
+	NP_WRITE_CHECK(this);
+
+	if(getSimulationStage() != Sc::SimulationStage::eCOMPLETE) 
+	{
+		Ps::getFoundation().error(PxErrorCode::eDEBUG_WARNING, __FILE__, __LINE__, 
+			"PxScene::removeActors() not allowed while simulation is running.");
+		return;
+	}
+
+	const Sq::PruningStructure& prunerStructure = static_cast<const Sq::PruningStructure&>(ps);
+	PxActor*const* actors = prunerStructure.getActors();
+	const PxU32 nbActors = prunerStructure.getNbActors();
+
+	// all or nothing, so that the structure can be added again as a whole
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		if(actors[i]->getScene() != this)
+		{
+			Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__,
+				"PxScene::removeActors(): Actor of the pruning structure is not in this scene. Call will be ignored!");
+			return;
+		}
+	}
+
+	removeActors(actors, nbActors, wakeOnLostTouch);
+}
+
 void NpScene::removeActor(PxActor& actor, bool wakeOnLostTouch)
 {
 	PX_PROFILE_ZONE("API.removeActor", getContextId());
@@ -1373,6 +1485,306 @@ PxU32 NpScene::getNbActors(PxActorTypeFlags types) const
 	return nbActors;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+void NpScene::getRigidDynamicPoses(PxRigidDynamic*const* actors, PxU32 nbActors, PxStrideIterator<PxTransform> poses) const
+{
+	NP_READ_CHECK(this);
+	PX_CHECK_AND_RETURN(actors && poses.ptr(), "PxScene::getRigidDynamicPoses: NULL array.");
+
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		const NpRigidDynamic* actor = static_cast<const NpRigidDynamic*>(actors[i]);
+		PX_CHECK_AND_RETURN(NpActor::getOwnerScene(*actor)==this, "PxScene::getRigidDynamicPoses: actor is not in this scene.");
+		poses[i] = actor->getGlobalPoseFast();
+	}
+}
+
+void NpScene::setRigidDynamicPoses(PxRigidDynamic*const* actors, PxU32 nbActors, PxStrideIterator<const PxTransform> poses, bool autowake)
+{
+	NP_WRITE_CHECK(this);
+	PX_CHECK_AND_RETURN(actors && poses.ptr(), "PxScene::setRigidDynamicPoses: NULL array.");
+
+#if PX_CHECKED
+	// validate everything first so that an invalid entry leaves the scene unchanged
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		const NpRigidDynamic* actor = static_cast<const NpRigidDynamic*>(actors[i]);
+		PX_CHECK_AND_RETURN(NpActor::getOwnerScene(*actor)==this, "PxScene::setRigidDynamicPoses: actor is not in this scene.");
+		PX_CHECK_AND_RETURN(poses[i].isSane(), "PxScene::setRigidDynamicPoses: pose is not valid.");
+		checkPositionSanity(*actor, poses[i], "PxScene::setRigidDynamicPoses");
+	}
+#endif
+
+	// actors added while buffering have no API scene yet, as for setGlobalPose()
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		NpRigidDynamic* actor = static_cast<NpRigidDynamic*>(actors[i]);
+		actor->setGlobalPoseInternal(NpActor::getAPIScene(*actor), poses[i], autowake);
+	}
+}
+
+void NpScene::getRigidDynamicVelocities(PxRigidDynamic*const* actors, PxU32 nbActors, PxStrideIterator<PxVec3> linearVelocities, PxStrideIterator<PxVec3> angularVelocities) const
+{
+	NP_READ_CHECK(this);
+	PX_CHECK_AND_RETURN(actors, "PxScene::getRigidDynamicVelocities: NULL array.");
+
+	PxVec3* linear = linearVelocities.ptr();
+	PxVec3* angular = angularVelocities.ptr();
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		const NpRigidDynamic* actor = static_cast<const NpRigidDynamic*>(actors[i]);
+		PX_CHECK_AND_RETURN(NpActor::getOwnerScene(*actor)==this, "PxScene::getRigidDynamicVelocities: actor is not in this scene.");
+		const Scb::Body& body = actor->getScbBodyFast();
+		if(linear)
+			linearVelocities[i] = body.getLinearVelocity();
+		if(angular)
+			angularVelocities[i] = body.getAngularVelocity();
+	}
+}
+
+void NpScene::setRigidDynamicVelocities(PxRigidDynamic*const* actors, PxU32 nbActors, PxStrideIterator<const PxVec3> linearVelocities, PxStrideIterator<const PxVec3> angularVelocities, bool autowake)
+{
+	NP_WRITE_CHECK(this);
+	PX_CHECK_AND_RETURN(actors, "PxScene::setRigidDynamicVelocities: NULL array.");
+
+	const PxVec3* linear = linearVelocities.ptr();
+	const PxVec3* angular = angularVelocities.ptr();
+
+#if PX_CHECKED
+	// validate everything first so that an invalid entry leaves the scene unchanged
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		const NpRigidDynamic* actor = static_cast<const NpRigidDynamic*>(actors[i]);
+		PX_CHECK_AND_RETURN(NpActor::getOwnerScene(*actor)==this, "PxScene::setRigidDynamicVelocities: actor is not in this scene.");
+		PX_CHECK_AND_RETURN(!linear || linearVelocities[i].isFinite(), "PxScene::setRigidDynamicVelocities: linear velocity is not valid.");
+		PX_CHECK_AND_RETURN(!angular || angularVelocities[i].isFinite(), "PxScene::setRigidDynamicVelocities: angular velocity is not valid.");
+		const Scb::Body& body = actor->getScbBodyFast();
+		PX_CHECK_AND_RETURN(!(body.getFlags() & PxRigidBodyFlag::eKINEMATIC), "PxScene::setRigidDynamicVelocities: Body must be non-kinematic!");
+		PX_CHECK_AND_RETURN(!(body.getActorFlags() & PxActorFlag::eDISABLE_SIMULATION), "PxScene::setRigidDynamicVelocities: Not allowed if PxActorFlag::eDISABLE_SIMULATION is set!");
+	}
+#endif
+
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		NpRigidDynamic* actor = static_cast<NpRigidDynamic*>(actors[i]);
+		Scb::Body& body = actor->getScbBodyFast();
+
+		// one wake up test for both velocities, with the outcome of the two setters of PxRigidDynamic
+		bool forceWakeUp = false;
+		if(linear)
+		{
+			body.setLinearVelocity(linearVelocities[i]);
+			forceWakeUp |= !linearVelocities[i].isZero();
+		}
+		if(angular)
+		{
+			body.setAngularVelocity(angularVelocities[i]);
+			forceWakeUp |= !angularVelocities[i].isZero();
+		}
+
+		if(NpActor::getAPIScene(*actor))
+			actor->wakeUpInternalNoKinematicTest(body, forceWakeUp, autowake);
+	}
+}
+
+void NpScene::setRigidDynamicKinematicTargets(PxRigidDynamic*const* actors, PxU32 nbActors, PxStrideIterator<const PxTransform> targets)
+{
+	NP_WRITE_CHECK(this);
+	PX_CHECK_AND_RETURN(actors && targets.ptr(), "PxScene::setRigidDynamicKinematicTargets: NULL array.");
+
+#if PX_CHECKED
+	// validate everything first so that an invalid entry leaves the scene unchanged
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		const NpRigidDynamic* actor = static_cast<const NpRigidDynamic*>(actors[i]);
+		PX_CHECK_AND_RETURN(NpActor::getAPIScene(*actor)==this, "PxScene::setRigidDynamicKinematicTargets: actor is not in this scene.");
+		PX_CHECK_AND_RETURN(targets[i].isSane(), "PxScene::setRigidDynamicKinematicTargets: target is not valid.");
+		checkPositionSanity(*actor, targets[i], "PxScene::setRigidDynamicKinematicTargets");
+		const Scb::Body& body = actor->getScbBodyFast();
+		PX_CHECK_AND_RETURN((body.getFlags() & PxRigidBodyFlag::eKINEMATIC), "PxScene::setRigidDynamicKinematicTargets: Body must be kinematic!");
+		PX_CHECK_AND_RETURN(!(body.getActorFlags() & PxActorFlag::eDISABLE_SIMULATION), "PxScene::setRigidDynamicKinematicTargets: Not allowed if PxActorFlag::eDISABLE_SIMULATION is set!");
+	}
+#endif
+
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		if(i + 1 < nbActors)
+			Ps::prefetchLine(actors[i + 1]);
+		static_cast<NpRigidDynamic*>(actors[i])->setKinematicTargetNoCheck(targets[i].getNormalized());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	const PxU32 SNAPSHOT_MAGIC = 0x53535850;	// "PXSS"
+
+	struct SnapshotHeader
+	{
+		PxU32	magic;
+		PxU32	nbBodies;
+		PxU32	size;
+		PxU32	pad;
+	};
+
+	struct BodySnapshot
+	{
+		enum Flags
+		{
+			eSLEEPING		= (1<<0),
+			eKINEMATIC		= (1<<1),
+			eHAS_TARGET		= (1<<2)
+		};
+
+		const NpRigidDynamic*		actor;		// only compared, never dereferenced before validation
+		PxU32						flags;
+		PxReal						wakeCounter;
+		PxTransform					body2World;
+		PxTransform					bodyTarget;	// kinematic target of the body frame
+		PxVec3						linearVelocity;
+		PxVec3						angularVelocity;
+		Sc::BodyCore::SimSnapshot	sim;
+	};
+
+	PX_FORCE_INLINE bool isSnapshotBody(const PxRigidActor* actor)
+	{
+		return actor->getConcreteType() == PxConcreteType::eRIGID_DYNAMIC;
+	}
+}
+
+PxU32 NpScene::getSnapshotSize() const
+{
+	NP_READ_CHECK(this);
+
+	PxU32 nbBodies = 0;
+	const PxU32 nbActors = mRigidActors.size();
+	for(PxU32 i=0;i<nbActors;i++)
+		nbBodies += isSnapshotBody(mRigidActors[i]) ? 1u : 0u;
+	return sizeof(SnapshotHeader) + nbBodies*sizeof(BodySnapshot);
+}
+
+PxU32 NpScene::saveSnapshot(void* buffer, PxU32 bufferSize) const
+{
+	NP_READ_CHECK(this);
+	PX_CHECK_AND_RETURN_VAL(buffer && !(size_t(buffer) & 15), "PxScene::saveSnapshot: buffer must be 16 byte aligned.", 0);
+	PX_CHECK_AND_RETURN_VAL(getSimulationStage() == Sc::SimulationStage::eCOMPLETE, "PxScene::saveSnapshot: not allowed while the simulation is running.", 0);
+
+	const PxU32 size = getSnapshotSize();
+	if(bufferSize < size)
+		return 0;
+
+	SnapshotHeader* header = reinterpret_cast<SnapshotHeader*>(buffer);
+	BodySnapshot* bodies = reinterpret_cast<BodySnapshot*>(header + 1);
+	header->magic = SNAPSHOT_MAGIC;
+	header->nbBodies = (size - PxU32(sizeof(SnapshotHeader)))/PxU32(sizeof(BodySnapshot));
+	header->size = size;
+	header->pad = 0;
+
+	const PxU32 nbActors = mRigidActors.size();
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		if(!isSnapshotBody(mRigidActors[i]))
+			continue;
+
+		const NpRigidDynamic* actor = static_cast<const NpRigidDynamic*>(mRigidActors[i]);
+		const Scb::Body& body = actor->getScbBodyFast();
+		BodySnapshot& snapshot = *bodies++;
+
+		snapshot.actor				= actor;
+		snapshot.flags				= body.isSleeping() ? PxU32(BodySnapshot::eSLEEPING) : 0;
+		snapshot.wakeCounter		= body.getWakeCounter();
+		snapshot.body2World			= body.getBody2World();
+		snapshot.bodyTarget			= snapshot.body2World;
+		snapshot.linearVelocity		= body.getLinearVelocity();
+		snapshot.angularVelocity	= body.getAngularVelocity();
+		if(body.getFlags() & PxRigidBodyFlag::eKINEMATIC)
+		{
+			snapshot.flags |= BodySnapshot::eKINEMATIC;
+			if(body.getKinematicTarget(snapshot.bodyTarget))
+				snapshot.flags |= BodySnapshot::eHAS_TARGET;
+		}
+		body.getScBody().saveSimSnapshot(snapshot.sim);
+	}
+	return size;
+}
+
+bool NpScene::restoreSnapshot(const void* buffer, PxU32 bufferSize)
+{
+	NP_WRITE_CHECK(this);
+	PX_CHECK_AND_RETURN_VAL(buffer && !(size_t(buffer) & 15), "PxScene::restoreSnapshot: buffer must be 16 byte aligned.", false);
+	PX_CHECK_AND_RETURN_VAL(getSimulationStage() == Sc::SimulationStage::eCOMPLETE, "PxScene::restoreSnapshot: not allowed while the simulation is running.", false);
+
+	const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(buffer);
+	const BodySnapshot* bodies = reinterpret_cast<const BodySnapshot*>(header + 1);
+	if(bufferSize < sizeof(SnapshotHeader) || header->magic != SNAPSHOT_MAGIC || header->size != bufferSize
+		|| bufferSize != sizeof(SnapshotHeader) + header->nbBodies*sizeof(BodySnapshot))
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "PxScene::restoreSnapshot: invalid snapshot.");
+		return false;
+	}
+
+	// the scene must hold the same rigid dynamics, in the same order and with the same kinematic state, as when the
+	// snapshot was taken. Validate everything first so that a mismatch leaves the scene unchanged.
+	const PxU32 nbActors = mRigidActors.size();
+	PxU32 nbBodies = 0;
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		if(!isSnapshotBody(mRigidActors[i]))
+			continue;
+
+		const NpRigidDynamic* actor = static_cast<const NpRigidDynamic*>(mRigidActors[i]);
+		if(nbBodies == header->nbBodies || bodies[nbBodies].actor != actor
+			|| ((bodies[nbBodies].flags & BodySnapshot::eKINEMATIC) != 0) != actor->getScbBodyFast().getFlags().isSet(PxRigidBodyFlag::eKINEMATIC))
+		{
+			Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxScene::restoreSnapshot: the rigid dynamic actors of the scene changed since the snapshot was taken.");
+			return false;
+		}
+		nbBodies++;
+	}
+	if(nbBodies != header->nbBodies)
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxScene::restoreSnapshot: the rigid dynamic actors of the scene changed since the snapshot was taken.");
+		return false;
+	}
+
+	Sq::SceneQueryManager& sqManager = getSceneQueryManagerFast();
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		const BodySnapshot& snapshot = bodies[i];
+		NpRigidDynamic* actor = const_cast<NpRigidDynamic*>(snapshot.actor);
+		Scb::Body& body = actor->getScbBodyFast();
+
+		updateDynamicSceneQueryShapes(actor->getShapeManager(), sqManager);
+		body.setBody2World(snapshot.body2World, false);
+
+		if(snapshot.flags & BodySnapshot::eKINEMATIC)
+		{
+			if(snapshot.flags & BodySnapshot::eHAS_TARGET)
+				body.setKinematicTarget(snapshot.bodyTarget);
+			else if(body.getScBody().getHasValidKinematicTarget())
+				body.getScBody().invalidateKinematicTarget();
+		}
+		else
+		{
+			body.setLinearVelocity(snapshot.linearVelocity);
+			body.setAngularVelocity(snapshot.angularVelocity);
+		}
+
+		// sleep state last: setting a kinematic target wakes the body up with the default wake counter
+		if(snapshot.flags & BodySnapshot::eSLEEPING)
+			body.putToSleepInternal();
+		else
+			body.wakeUpInternal(snapshot.wakeCounter);
+
+		body.getScBody().restoreSimSnapshot(snapshot.sim);
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 PxU32 NpScene::getActors(PxActorTypeFlags types, PxActor** buffer, PxU32 bufferSize, PxU32 startIndex) const
 {
 	NP_READ_CHECK(this);
@@ -1498,6 +1910,40 @@ const PxRenderBuffer& NpScene::getRenderBuffer()
 	return mRenderBuffer;
 }
 
+#if PX_ENABLE_DEBUG_VISUALIZATION
+namespace
+{
+	// number of rigid actors visualized by each job of the parallel visualization, see PxSceneFlag::eENABLE_PARALLEL_VISUALIZATION
+	const PxU32 gNbActorsPerVisualizationJob = 256;
+
+	PX_FORCE_INLINE void visualizeRigidActor(PxRigidActor* a, Cm::RenderOutput& out, NpScene* scene)
+	{
+		if (a->getType() == PxActorType::eRIGID_DYNAMIC)
+			static_cast<NpRigidDynamic*>(a)->visualize(out, scene);
+		else
+			static_cast<NpRigidStatic*>(a)->visualize(out, scene);
+	}
+
+	struct VisualizeActorsJob
+	{
+		NpScene*				mScene;
+		PxRigidActor*const*		mActors;
+		PxU32					mNbActors;
+		Cm::RenderBuffer*const*	mBuffers;
+
+		void operator()(PxU32 index)
+		{
+			const PxU32 start = index*gNbActorsPerVisualizationJob;
+			const PxU32 end = PxMin(start + gNbActorsPerVisualizationJob, mNbActors);
+
+			Cm::RenderOutput out(*mBuffers[index]);
+			for(PxU32 i=start; i<end; i++)
+				visualizeRigidActor(mActors[i], out, mScene);
+		}
+	};
+}
+#endif
+
 void NpScene::visualize()
 {
 	NP_READ_CHECK(this);
@@ -1505,6 +1951,8 @@ void NpScene::visualize()
 	PX_PROFILE_ZONE("NpScene::visualize", getContextId());
 
 	mRenderBuffer.clear(); // clear last frame visualizations 
+	for(PxU32 i=0; i<mVisualizationJobBuffers.size(); i++)
+		mVisualizationJobBuffers[i]->clear();
 
 #if PX_ENABLE_DEBUG_VISUALIZATION
 	if(getVisualizationParameter(PxVisualizationParameter::eSCALE) == 0.0f)
@@ -1531,13 +1979,27 @@ void NpScene::visualize()
 		static_cast<NpCloth*>(mPxCloths.getEntries()[i])->visualize(out, this);
 #endif
 
-	for(PxU32 i=0; i < rigidActorCount; i++)
+	if((mScene.getFlags() & PxSceneFlag::eENABLE_PARALLEL_VISUALIZATION) && rigidActorCount > gNbActorsPerVisualizationJob)
 	{
-		PxRigidActor* a = rigidActors[i];
-		if (a->getType() == PxActorType::eRIGID_DYNAMIC)
-			static_cast<NpRigidDynamic*>(a)->visualize(out, this);
-		else
-			static_cast<NpRigidStatic*>(a)->visualize(out, this);
+		const PxU32 nbJobs = (rigidActorCount + gNbActorsPerVisualizationJob - 1)/gNbActorsPerVisualizationJob;
+		while(mVisualizationJobBuffers.size() < nbJobs)
+			mVisualizationJobBuffers.pushBack(PX_NEW(Cm::RenderBuffer));
+
+		VisualizeActorsJob job;
+		job.mScene		= this;
+		job.mActors		= rigidActors;
+		job.mNbActors	= rigidActorCount;
+		job.mBuffers	= mVisualizationJobBuffers.begin();
+		Cm::runParallelJobs(mTaskManager->getCpuDispatcher(), nbJobs, job);
+
+		// append in job order so that the output doesn't depend on the threads
+		for(PxU32 i=0; i<nbJobs; i++)
+			mRenderBuffer.appendCopy(*mVisualizationJobBuffers[i]);
+	}
+	else
+	{
+		for(PxU32 i=0; i < rigidActorCount; i++)
+			visualizeRigidActor(rigidActors[i], out, this);
 	}
 
 	// Visualize pruning structures
@@ -1711,6 +2173,19 @@ PxSimulationEventCallback* NpScene::getSimulationEventCallback(PxClientID client
 	return mScene.getSimulationEventCallback(client);
 }
 
+void NpScene::setContactSummaryCallback(PxContactSummaryCallback* callback)
+{
+	NP_WRITE_CHECK(this);
+	PX_CHECK_AND_RETURN(getSimulationStage() == Sc::SimulationStage::eCOMPLETE, "PxScene::setContactSummaryCallback() not allowed while simulation is running. Call will be ignored.");
+	mContactSummaryCallback = callback;
+}
+
+PxContactSummaryCallback* NpScene::getContactSummaryCallback() const
+{
+	NP_READ_CHECK(this);
+	return mContactSummaryCallback;
+}
+
 void NpScene::setContactModifyCallback(PxContactModifyCallback* callback)
 {
 	NP_WRITE_CHECK(this);
@@ -1805,6 +2280,22 @@ bool NpScene::removeBroadPhaseRegion(PxU32 handle)
 	return mScene.removeBroadPhaseRegion(handle);
 }
 
+bool NpScene::setBroadPhaseAutoRegions(const PxBounds3& worldBounds, PxU32 maxNbObjectsPerRegion)
+{
+	PX_PROFILE_ZONE("BroadPhase.setBroadPhaseAutoRegions", getContextId());
+
+	NP_WRITE_CHECK(this);
+
+	PX_CHECK_AND_RETURN_VAL(!maxNbObjectsPerRegion || worldBounds.isValid(), "PxScene::setBroadPhaseAutoRegions(): invalid bounds provided!", false);
+	if(maxNbObjectsPerRegion && worldBounds.isEmpty())
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "PxScene::setBroadPhaseAutoRegions(): world bounds are empty. Call will be ignored.");
+		return false;
+	}
+
+	return mScene.setBroadPhaseAutoRegions(worldBounds, maxNbObjectsPerRegion);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 // Filtering
@@ -2026,6 +2517,8 @@ void NpScene::simulateOrCollide(PxReal elapsedTime, physx::PxBaseTask* completio
 				// when an NpScene is controlled by an APEX scene.
 				mTaskManager->resetDependencies();
 			}
+			if (simStage != Sc::SimulationStage::eADVANCE)
+				mTaskManager->resetTaskStatistics();
 			mTaskManager->startSimulation();
 		}
 
@@ -2070,6 +2563,30 @@ void NpScene::simulate(PxReal elapsedTime, physx::PxBaseTask* completionTask, vo
 						"PxScene::simulate: Simulation is still processing last simulate call, you should call fetchResults()!", Sc::SimulationStage::eADVANCE);
 }
 
+void NpScene::simulateSubsteps(PxReal elapsedTime, PxU32 nbSubsteps, void* scratchBlock, PxU32 scratchBlockSize)
+{
+	if(getSimulationStage() != Sc::SimulationStage::eCOMPLETE)
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxScene::simulateSubsteps: Simulation is still processing last simulate call, you should call fetchResults()!");
+		return;
+	}
+
+	PX_CHECK_AND_RETURN(elapsedTime > 0, "PxScene::simulateSubsteps: The elapsed time must be positive!");
+	PX_CHECK_AND_RETURN(nbSubsteps > 0, "PxScene::simulateSubsteps: The number of substeps must be positive!");
+
+	const PxReal dt = elapsedTime / PxReal(nbSubsteps);
+	Sc::Scene& scScene = mScene.getScScene();
+	for(PxU32 i=0; i<nbSubsteps; i++)
+	{
+		scScene.setSubstep(i, nbSubsteps);
+		simulate(dt, NULL, scratchBlock, scratchBlockSize, true);
+		if(getSimulationStage() != Sc::SimulationStage::eADVANCE)
+			break;	// simulate() rejected the step and already reported why
+		fetchResults(true, NULL);
+	}
+	scScene.setSubstep(0, 1);
+}
+
 void NpScene::advance( physx::PxBaseTask* completionTask)
 {
 	NP_WRITE_CHECK(this);
@@ -2208,17 +2725,6 @@ bool NpScene::fetchCollision(bool block)
 	return true;
 }
 
-class SqRefFinder: public Sc::SqRefFinder
-{
-public:
-	virtual	Sq::PrunerHandle find(const PxRigidBody* body, const PxShape* shape)
-	{
-		const Sq::PrunerData prunerdata = NpActor::getShapeManager(*body)->findSceneQueryData(*static_cast<const NpShape*>(shape));
-		return Sq::getPrunerHandle(prunerdata);
-	}
-private:
-};
-
 // The order of the following operations is important!
 // 1. Process object deletions which were carried out while the simulation was running (since these effect contact and trigger reports)
 // 2. Write contact reports to global stream (taking pending deletions into account), clear some simulation buffers (deleted objects etc.), ...
@@ -2227,7 +2733,7 @@ private:
 // 5. Synchronize the simulation and user state
 // 6. Fire callbacks which need to reflect the synchronized object state
 
-void NpScene::fetchResultsPreContactCallbacks()
+void NpScene::fetchResultsPreContactCallbacks(bool deferEventCallbacks)
 {
 #if PX_SUPPORT_PVD	
 	mScene.getScenePvdClient().updateContacts();
@@ -2240,9 +2746,201 @@ void NpScene::fetchResultsPreContactCallbacks()
 	{
 		PX_PROFILE_ZONE("Sim.fireCallbacksPreSync", getContextId());
 		fireOutOfBoundsCallbacks();		// fire out-of-bounds callbacks
-		mScene.fireBrokenConstraintCallbacks();
-		mScene.fireTriggerCallbacks();
+		mEventCallbacksDeferred = deferEventCallbacks;
+		if(!deferEventCallbacks)
+			firePreSyncEventCallbacks();
+	}
+}
+
+void NpScene::firePreSyncEventCallbacks()
+{
+	mScene.fireBrokenConstraintCallbacks();
+	mScene.fireTriggerCallbacks();
+}
+
+void NpScene::captureFrameContacts(const Ps::Array<PxContactPairHeader>& pairs)
+{
+	FrameStateBuffer& buffer = mFrameStates[1 - mPublishedFrameState];
+	buffer.mContacts.resizeUninitialized(pairs.size());
+
+	for(PxU32 i=0; i<pairs.size(); i++)
+	{
+		const PxContactPairHeader& header = pairs[i];
+		PxFrameContactSummary& summary = buffer.mContacts[i];
+		summary.actors[0] = (header.flags & PxContactPairHeaderFlag::eREMOVED_ACTOR_0) ? NULL : header.actors[0];
+		summary.actors[1] = (header.flags & PxContactPairHeaderFlag::eREMOVED_ACTOR_1) ? NULL : header.actors[1];
+		summary.nbShapePairs = header.nbPairs;
+		summary.events = PxPairFlags();
+		for(PxU32 j=0; j<header.nbPairs; j++)
+			summary.events |= header.pairs[j].events;
+	}
+}
+
+void NpScene::captureFrameBodiesAndPublish()
+{
+	const PxU32 back = 1 - mPublishedFrameState;
+	FrameStateBuffer& buffer = mFrameStates[back];
+
+	buffer.mBodies.clear();
+	const PxU32 nbActors = mRigidActors.size();
+	for(PxU32 i=0; i<nbActors; i++)
+	{
+		if(mRigidActors[i]->getConcreteType() != PxConcreteType::eRIGID_DYNAMIC)
+			continue;
+
+		NpRigidDynamic* actor = static_cast<NpRigidDynamic*>(mRigidActors[i]);
+		const Scb::Body& body = actor->getScbBodyFast();
+
+		PxRigidDynamicFrameState& state = buffer.mBodies.insert();
+		state.actor = actor;
+		state.pose = actor->getGlobalPoseFast();
+		state.linearVelocity = body.getLinearVelocity();
+		state.angularVelocity = body.getAngularVelocity();
+	}
+
+	buffer.mFrameIndex = mFrameStates[mPublishedFrameState].mFrameIndex + 1;
+
+	// the buffer contents have to be visible before readers can pick the buffer
+	Ps::memoryBarrier();
+	mPublishedFrameState = back;
+}
+
+void NpScene::ContactSummaryBuffer::resize(PxU32 nbPairs)
+{
+	for(PxU32 i=0; i<2; i++)
+	{
+		mActors[i].resizeUninitialized(nbPairs);
+		mShapes[i].resizeUninitialized(nbPairs);
+		mMaterials[i].resizeUninitialized(nbPairs);
 	}
+	mEvents.resizeUninitialized(nbPairs);
+	mTotalImpulses.resizeUninitialized(nbPairs);
+	mPoints.resizeUninitialized(nbPairs);
+	mNormals.resizeUninitialized(nbPairs);
+}
+
+void NpScene::fireContactSummary(const Ps::Array<PxContactPairHeader>& pairs)
+{
+	PX_PROFILE_ZONE("Sim.fireContactSummary", getContextId());
+
+	PxU32 nbPairs = 0;
+	for(PxU32 i=0; i<pairs.size(); i++)
+		nbPairs += pairs[i].nbPairs;
+
+	ContactSummaryBuffer& buffer = mContactSummary;
+	buffer.resize(nbPairs);
+
+	const NpMaterialManager& materialManager = static_cast<NpPhysics&>(getPhysics()).getMaterialManager();
+
+	PxU32 index = 0;
+	for(PxU32 i=0; i<pairs.size(); i++)
+	{
+		const PxContactPairHeader& header = pairs[i];
+		PxRigidActor* actor0 = (header.flags & PxContactPairHeaderFlag::eREMOVED_ACTOR_0) ? NULL : header.actors[0];
+		PxRigidActor* actor1 = (header.flags & PxContactPairHeaderFlag::eREMOVED_ACTOR_1) ? NULL : header.actors[1];
+
+		for(PxU32 j=0; j<header.nbPairs; j++, index++)
+		{
+			const PxContactPair& pair = header.pairs[j];
+			buffer.mActors[0][index] = actor0;
+			buffer.mActors[1][index] = actor1;
+			buffer.mShapes[0][index] = (pair.flags & PxContactPairFlag::eREMOVED_SHAPE_0) ? NULL : pair.shapes[0];
+			buffer.mShapes[1][index] = (pair.flags & PxContactPairFlag::eREMOVED_SHAPE_1) ? NULL : pair.shapes[1];
+			buffer.mEvents[index] = pair.events;
+
+			PxReal totalImpulse = 0.0f;
+			PxVec3 point(0.0f);
+			PxVec3 normal(0.0f);
+			PxMaterial* material0 = NULL;
+			PxMaterial* material1 = NULL;
+
+			if(pair.contactCount)
+			{
+				// Same traversal as PxContactPair::extractContacts(), but accumulated instead of copied out
+				PxContactStreamIterator iter(pair.contactPatches, pair.contactPoints, pair.getInternalFaceIndices(), pair.patchCount, pair.contactCount);
+				const PxReal* impulses = (pair.flags & PxContactPairFlag::eINTERNAL_HAS_IMPULSES) ? pair.contactImpulses : NULL;
+				const bool flipped = pair.flags.isSet(PxContactPairFlag::eINTERNAL_CONTACTS_ARE_FLIPPED);
+
+				PxVec3 pointSum(0.0f), normalSum(0.0f), weightedPointSum(0.0f), weightedNormalSum(0.0f);
+				PxU32 nbContacts = 0;
+				while(iter.hasNextPatch())
+				{
+					iter.nextPatch();
+					if(!nbContacts)
+					{
+						const PxU16 materialIndex0 = flipped ? iter.getMaterialIndex1() : iter.getMaterialIndex0();
+						const PxU16 materialIndex1 = flipped ? iter.getMaterialIndex0() : iter.getMaterialIndex1();
+						material0 = materialManager.getMaterial(materialIndex0);
+						material1 = materialManager.getMaterial(materialIndex1);
+					}
+
+					while(iter.hasNextContact())
+					{
+						iter.nextContact();
+						const PxVec3 contactPoint = iter.getContactPoint();
+						const PxVec3 contactNormal = iter.getContactNormal();
+						pointSum += contactPoint;
+						normalSum += contactNormal;
+						if(impulses)
+						{
+							const PxReal impulse = impulses[nbContacts];
+							totalImpulse += impulse;
+							weightedPointSum += contactPoint * impulse;
+							weightedNormalSum += contactNormal * impulse;
+						}
+						nbContacts++;
+					}
+				}
+
+				if(totalImpulse > 0.0f)
+				{
+					point = weightedPointSum / totalImpulse;
+					normal = weightedNormalSum;
+				}
+				else if(nbContacts)
+				{
+					point = pointSum / PxReal(nbContacts);
+					normal = normalSum;
+				}
+				normal.normalizeSafe();
+			}
+
+			buffer.mTotalImpulses[index] = totalImpulse;
+			buffer.mPoints[index] = point;
+			buffer.mNormals[index] = normal;
+			buffer.mMaterials[0][index] = material0;
+			buffer.mMaterials[1][index] = material1;
+		}
+	}
+
+	PxContactSummaryReport report;
+	report.nbPairs = nbPairs;
+	for(PxU32 i=0; i<2; i++)
+	{
+		report.actors[i] = buffer.mActors[i].begin();
+		report.shapes[i] = buffer.mShapes[i].begin();
+		report.materials[i] = buffer.mMaterials[i].begin();
+	}
+	report.events = buffer.mEvents.begin();
+	report.totalImpulses = buffer.mTotalImpulses.begin();
+	report.points = buffer.mPoints.begin();
+	report.normals = buffer.mNormals.begin();
+
+	mContactSummaryCallback->onContactSummary(report);
+}
+
+PxSceneFrameState NpScene::getFrameState() const
+{
+	// no read check, the published buffer is not written until the second fetchResults() from now
+	const FrameStateBuffer& buffer = mFrameStates[mPublishedFrameState];
+
+	PxSceneFrameState state;
+	state.bodies = buffer.mBodies.begin();
+	state.nbBodies = buffer.mBodies.size();
+	state.contacts = buffer.mContacts.begin();
+	state.nbContacts = buffer.mContacts.size();
+	state.frameIndex = buffer.mFrameIndex;
+	return state;
 }
 
 void NpScene::fetchResultsPostContactCallbacks()
@@ -2258,6 +2956,7 @@ void NpScene::fetchResultsPostContactCallbacks()
 	if((getFlagsFast() & PxSceneFlag::eSUPPRESS_EAGER_SCENE_QUERY_REFIT) && updateMode == PxSceneQueryUpdateMode::eBUILD_ENABLED_COMMIT_ENABLED)
 		updateMode = PxSceneQueryUpdateMode::eBUILD_ENABLED_COMMIT_DISABLED;
 	mSQManager.afterSync(updateMode);
+	mSQManager.publishSnapshot();
 
 #if PX_DEBUG && 0
 	mSQManager.validateSimUpdates();
@@ -2290,9 +2989,20 @@ void NpScene::fetchResultsPostContactCallbacks()
 
 	mRenderBuffer.append(mScene.getScScene().getRenderBuffer());
 
+	if(mScene.getFlags() & PxSceneFlag::eENABLE_FRAME_STATE_BUFFER)
+	{
+		PX_PROFILE_ZONE("Sim.captureFrameState", getContextId());
+		captureFrameBodiesAndPublish();
+	}
+
 	PX_ASSERT(getSimulationStage() != Sc::SimulationStage::eCOMPLETE);
+	Sc::SimStats& stats = mScene.getScScene().getStatsInternal();
+	stats.stageEnd(PxSimulationStatistics::eSTAGE_FETCH_RESULTS);
 	if (mControllingSimulation)
 	{
+		PxU32 nbTasks, taskTime;
+		mTaskManager->getTaskStatistics(nbTasks, taskTime);
+		stats.setTaskStats(nbTasks, taskTime, mTaskManager->getCpuDispatcher()->getWorkerCount());
 		mTaskManager->stopSimulation();
 	}
 
@@ -2325,9 +3035,16 @@ bool NpScene::fetchResults(bool block, PxU32* errorState)
 		// PT: TODO: why do we want to show it in the cross thread view?
 		PX_PROFILE_START_CROSSTHREAD("Basic.fetchResults", getContextId());
 		PX_PROFILE_ZONE("Sim.fetchResults", getContextId());
+		mScene.getScScene().getStatsInternal().stageStart(PxSimulationStatistics::eSTAGE_FETCH_RESULTS);
 
 		fetchResultsPreContactCallbacks();
 
+		if(mScene.getFlags() & PxSceneFlag::eENABLE_FRAME_STATE_BUFFER)
+			captureFrameContacts(mScene.getQueuedContactPairHeaders());
+
+		if(mContactSummaryCallback)
+			fireContactSummary(mScene.getQueuedContactPairHeaders());
+
 		{
 			// PT: TODO: why a cross-thread event here?
 			PX_PROFILE_START_CROSSTHREAD("Basic.processCallbacks", getContextId());
@@ -2370,12 +3087,21 @@ bool NpScene::fetchResultsStart(const PxContactPairHeader*& contactPairs, PxU32&
 	// we use cross thread profile here, to show the event in cross thread view
 	PX_PROFILE_START_CROSSTHREAD("Basic.fetchResults", getContextId());
 	PX_PROFILE_ZONE("Sim.fetchResultsStart", getContextId());
+	mScene.getScScene().getStatsInternal().stageStart(PxSimulationStatistics::eSTAGE_FETCH_RESULTS);
 
-	fetchResultsPreContactCallbacks();
+	// the trigger and constraint break callbacks run in their own tasks in processCallbacks(), or in fetchResultsFinish() if
+	// processCallbacks() is not called
+	fetchResultsPreContactCallbacks(true);
 	const Ps::Array<PxContactPairHeader>& pairs = mScene.getQueuedContactPairHeaders();
 	nbContactPairs = pairs.size();
 	contactPairs = pairs.begin();
 
+	if(mScene.getFlags() & PxSceneFlag::eENABLE_FRAME_STATE_BUFFER)
+		captureFrameContacts(pairs);
+
+	if(mContactSummaryCallback)
+		fireContactSummary(pairs);
+
 	mBetweenFetchResults = true;
 	return true;
 }
@@ -2426,6 +3152,23 @@ void NpContactCallbackTask::run()
 	mScene->unlockRead();
 }
 
+void NpEventCallbackTask::setData(NpScene* scene, Category category)
+{
+	mScene = scene;
+	mCategory = category;
+}
+
+void NpEventCallbackTask::run()
+{
+	// the two categories use disjoint report buffers of Sc::Scene, so they can be fired concurrently
+	mScene->lockRead();
+	if(mCategory==eTRIGGERS)
+		mScene->getScene().fireTriggerCallbacks();
+	else
+		mScene->getScene().fireBrokenConstraintCallbacks();
+	mScene->unlockRead();
+}
+
 void NpScene::processCallbacks(physx::PxBaseTask* continuation)
 {
 	PX_PROFILE_START_CROSSTHREAD("Basic.processCallbacks", getContextId());
@@ -2445,6 +3188,19 @@ void NpScene::processCallbacks(physx::PxBaseTask* continuation)
 		task->setContinuation(continuation);
 		task->removeReference();
 	}
+
+	// each category is a single call per client, so it gets a single task
+	if(mEventCallbacksDeferred)
+	{
+		mEventCallbacksDeferred = false;
+		for(PxU32 i=0; i<2; i++)
+		{
+			NpEventCallbackTask* task = PX_PLACEMENT_NEW(flushPool->allocate(sizeof(NpEventCallbackTask)), NpEventCallbackTask)();
+			task->setData(this, i ? NpEventCallbackTask::eCONSTRAINT_BREAKS : NpEventCallbackTask::eTRIGGERS);
+			task->setContinuation(continuation);
+			task->removeReference();
+		}
+	}
 }
 
 void NpScene::fetchResultsFinish(PxU32* errorState)
@@ -2456,6 +3212,13 @@ void NpScene::fetchResultsFinish(PxU32* errorState)
 
 		mBetweenFetchResults = false;
 		NP_WRITE_CHECK(this);
+
+		// processCallbacks() was not called, the callbacks still have to see the state before the sync
+		if(mEventCallbacksDeferred)
+		{
+			mEventCallbacksDeferred = false;
+			firePreSyncEventCallbacks();
+		}
 		
 		fetchResultsPostContactCallbacks();
 
@@ -2504,7 +3267,8 @@ void NpScene::flushQueryUpdates()
 		return;
 	}
 
-	mSQManager.flushUpdates();
+	// this is an explicit call from the user thread, so the pruners can use the scene's worker threads
+	mSQManager.flushUpdates(mScene.getScScene().getTaskManager().getCpuDispatcher());
 }
 
 /*
@@ -2825,6 +3589,16 @@ PxU32 NpScene::getSceneQueryStaticTimestamp() const
 	return mSQManager.get(PruningIndex::eSTATIC).timestamp();
 }
 
+void NpScene::getQueryResultCacheStats(PxU32& nbHits, PxU32& nbMisses) const
+{
+	mQueryResultCache.getStats(nbHits, nbMisses);
+}
+
+void NpScene::resetQueryResultCacheStats()
+{
+	mQueryResultCache.resetStats();
+}
+
 PxCpuDispatcher* NpScene::getCpuDispatcher() const
 {
 	return getTaskManager()->getCpuDispatcher();
@@ -3197,6 +3971,30 @@ void NpScene::shiftOrigin(const PxVec3& shift)
 	//
 	mRenderBuffer.shift(-shift);
 #endif
+
+	mOriginX += PxF64(shift.x);
+	mOriginY += PxF64(shift.y);
+	mOriginZ += PxF64(shift.z);
+}
+
+void NpScene::setOrigin(PxF64 x, PxF64 y, PxF64 z)
+{
+	NP_WRITE_CHECK(this);
+
+	// the shift is computed in double precision, and the origin accumulates the float shift that actually gets applied,
+	// so repeated rebasing does not drift away from the requested anchor
+	const PxVec3 shift(PxReal(x - mOriginX), PxReal(y - mOriginY), PxReal(z - mOriginZ));
+	if(!shift.isZero())
+		shiftOrigin(shift);
+}
+
+void NpScene::getOrigin(PxF64& x, PxF64& y, PxF64& z) const
+{
+	NP_READ_CHECK(this);
+
+	x = mOriginX;
+	y = mOriginY;
+	z = mOriginZ;
 }
 
 #if PX_SUPPORT_PVD
@@ -3300,8 +4098,8 @@ bool NpScene::fetchQueries(bool block)
 		// PT: TODO: why do we want to show it in the cross thread view?
 		PX_PROFILE_START_CROSSTHREAD("Basic.fetchQueries", getContextId());
 
-		// flush updates and commit if work is done
-		mSQManager.flushUpdates();
+		// flush updates and commit if work is done. Called from the user thread, so the pruners can use the worker threads.
+		mSQManager.flushUpdates(mScene.getScScene().getTaskManager().getCpuDispatcher());
 	
 		PX_PROFILE_STOP_CROSSTHREAD("Basic.fetchQueries", getContextId());
 		PX_PROFILE_STOP_CROSSTHREAD("Basic.sceneQueriesUpdate", getContextId());
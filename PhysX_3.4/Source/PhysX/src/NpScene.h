@@ -108,6 +108,30 @@ public:
 	}
 };
 
+// fires the trigger or constraint break callbacks that fetchResultsStart() deferred to processCallbacks()
+class NpEventCallbackTask : public physx::PxLightCpuTask
+{
+public:
+	enum Category
+	{
+		eTRIGGERS,
+		eCONSTRAINT_BREAKS
+	};
+
+	void setData(NpScene* scene, Category category);
+
+	virtual void run();
+
+	virtual const char* getName() const
+	{
+		return "NpEventCallbackTask";
+	}
+
+private:
+	NpScene*	mScene;
+	Category	mCategory;
+};
+
 class NpScene : public NpSceneQueries, public Ps::UserAllocated
 {
 	//virtual interfaces:
@@ -153,6 +177,19 @@ class NpScene : public NpSceneQueries, public Ps::UserAllocated
 	
 	virtual			void							addCollection(const PxCollection& collection);
 
+	// Bulk rigid dynamic state
+	virtual			void							getRigidDynamicPoses(PxRigidDynamic*const* actors, PxU32 nbActors, PxStrideIterator<PxTransform> poses) const;
+	virtual			void							setRigidDynamicPoses(PxRigidDynamic*const* actors, PxU32 nbActors, PxStrideIterator<const PxTransform> poses, bool autowake);
+	virtual			void							getRigidDynamicVelocities(PxRigidDynamic*const* actors, PxU32 nbActors,
+														PxStrideIterator<PxVec3> linearVelocities, PxStrideIterator<PxVec3> angularVelocities) const;
+	virtual			void							setRigidDynamicVelocities(PxRigidDynamic*const* actors, PxU32 nbActors,
+														PxStrideIterator<const PxVec3> linearVelocities, PxStrideIterator<const PxVec3> angularVelocities, bool autowake);
+	virtual			void							setRigidDynamicKinematicTargets(PxRigidDynamic*const* actors, PxU32 nbActors, PxStrideIterator<const PxTransform> targets);
+	virtual			PxSceneFrameState				getFrameState() const;
+	virtual			PxU32							getSnapshotSize() const;
+	virtual			PxU32							saveSnapshot(void* buffer, PxU32 bufferSize) const;
+	virtual			bool							restoreSnapshot(const void* buffer, PxU32 bufferSize);
+
 	// Groups
 	virtual			void							setDominanceGroupPair(PxDominanceGroup group1, PxDominanceGroup group2, const PxDominanceGroupPair& dominance);
 	virtual			PxDominanceGroupPair			getDominanceGroupPair(PxDominanceGroup group1, PxDominanceGroup group2) const;
@@ -188,6 +225,8 @@ class NpScene : public NpSceneQueries, public Ps::UserAllocated
 	// Callbacks
 	virtual			void							setSimulationEventCallback(PxSimulationEventCallback* callback, PxClientID client);
 	virtual			PxSimulationEventCallback*		getSimulationEventCallback(PxClientID client)	const;
+	virtual			void							setContactSummaryCallback(PxContactSummaryCallback* callback);
+	virtual			PxContactSummaryCallback*		getContactSummaryCallback()	const;
 	virtual			void							setContactModifyCallback(PxContactModifyCallback* callback);
 	virtual			PxContactModifyCallback*		getContactModifyCallback()	const;
 	virtual			void							setCCDContactModifyCallback(PxCCDContactModifyCallback* callback);
@@ -213,6 +252,7 @@ class NpScene : public NpSceneQueries, public Ps::UserAllocated
 
 	// new API methods
 	virtual			void							simulate(PxReal elapsedTime, physx::PxBaseTask* completionTask, void* scratchBlock, PxU32 scratchBlockSize, bool controlSimulation);
+	virtual			void							simulateSubsteps(PxReal elapsedTime, PxU32 nbSubsteps, void* scratchBlock, PxU32 scratchBlockSize);
 	virtual			void							advance(physx::PxBaseTask* completionTask);
 	virtual			void							collide(PxReal elapsedTime, physx::PxBaseTask* completionTask, void* scratchBlock, PxU32 scratchBlockSize, bool controlSimulation = true);
 	virtual			bool							checkResults(bool block);
@@ -263,6 +303,8 @@ class NpScene : public NpSceneQueries, public Ps::UserAllocated
 
 	virtual			PxU32							getTimestamp()	const;
 	virtual			PxU32							getSceneQueryStaticTimestamp()	const;
+	virtual			void							getQueryResultCacheStats(PxU32& nbHits, PxU32& nbMisses)	const;
+	virtual			void							resetQueryResultCacheStats();
 
 	virtual			PxCpuDispatcher*				getCpuDispatcher() const;
 	virtual			PxGpuDispatcher*				getGpuDispatcher() const;
@@ -276,10 +318,12 @@ class NpScene : public NpSceneQueries, public Ps::UserAllocated
 	virtual			PxU32							getBroadPhaseRegions(PxBroadPhaseRegionInfo* userBuffer, PxU32 bufferSize, PxU32 startIndex=0) const;
 	virtual			PxU32							addBroadPhaseRegion(const PxBroadPhaseRegion& region, bool populateRegion);
 	virtual			bool							removeBroadPhaseRegion(PxU32 handle);
+	virtual			bool							setBroadPhaseAutoRegions(const PxBounds3& worldBounds, PxU32 maxNbObjectsPerRegion);
 
 	virtual			void							addActors(PxActor*const* actors, PxU32 nbActors);
 	virtual			void							addActors(const PxPruningStructure& prunerStructure);
 	virtual			void							removeActors(PxActor*const* actors, PxU32 nbActors, bool wakeOnLostTouch);
+	virtual			void							removeActors(const PxPruningStructure& prunerStructure, bool wakeOnLostTouch);
 
 	virtual			void							lockRead(const char* file=NULL, PxU32 line=0);
 	virtual			void							unlockRead();
@@ -290,6 +334,8 @@ class NpScene : public NpSceneQueries, public Ps::UserAllocated
 	virtual			PxReal							getWakeCounterResetValue() const;
 
 	virtual			void							shiftOrigin(const PxVec3& shift);
+	virtual			void							setOrigin(PxF64 x, PxF64 y, PxF64 z);
+	virtual			void							getOrigin(PxF64& x, PxF64& y, PxF64& z) const;
 
 	virtual         PxPvdSceneClient*				getScenePvdClient();
 
@@ -396,15 +442,22 @@ private:
 					void							updateDirtyShaders();
 
 					void							fireOutOfBoundsCallbacks();
-					void							fetchResultsPreContactCallbacks();
+					void							fetchResultsPreContactCallbacks(bool deferEventCallbacks = false);
+					void							firePreSyncEventCallbacks();
+					void							captureFrameContacts(const Ps::Array<PxContactPairHeader>& pairs);
+					void							fireContactSummary(const Ps::Array<PxContactPairHeader>& pairs);
+					void							captureFrameBodiesAndPublish();
 					void							fetchResultsPostContactCallbacks();
 
 
 
-					void							updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Actor& actor, NpShapeManager& shapeManager, bool actorDynamic, const PxBounds3* bounds, bool hasPrunerStructure);
-	PX_FORCE_INLINE	void							updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Body& body, NpShapeManager& shapeManager, bool actorDynamic, const PxBounds3* bounds, bool hasPrunerStructure);
+					struct SqInsertionBatch;
+					void							updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Actor& actor, NpShapeManager& shapeManager, bool actorDynamic, const PxBounds3* bounds, SqInsertionBatch& sqBatch);
+	PX_FORCE_INLINE	void							updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Body& body, NpShapeManager& shapeManager, bool actorDynamic, const PxBounds3* bounds, SqInsertionBatch& sqBatch);
+					void							flushSqInsertionBatch(SqInsertionBatch& sqBatch, bool hasPrunerStructure);
 
 					Cm::RenderBuffer				mRenderBuffer;
+					Ps::Array<Cm::RenderBuffer*>	mVisualizationJobBuffers;	// see PxSceneFlag::eENABLE_PARALLEL_VISUALIZATION, kept to reuse their memory
 
 					Ps::CoalescedHashSet<PxConstraint*> mConstraints;
 					Ps::Array<PxRigidActor*>		mRigidActors;  // no hash set used because it would be quite a bit slower when adding a large number of actors
@@ -422,6 +475,10 @@ private:
 #endif
 
 					PxBounds3						mSanityBounds;
+
+					PxF64							mOriginX;		// Summed total origin shift, kept in double precision.
+					PxF64							mOriginY;
+					PxF64							mOriginZ;
 #if PX_SUPPORT_GPU_PHYSX
 					PhysXIndicator					mPhysXIndicator;
 #endif
@@ -497,6 +554,35 @@ private:
 
 					bool							mHasSimulatedOnce;
 					bool							mBetweenFetchResults;
+					bool							mEventCallbacksDeferred;	// trigger and constraint break callbacks left to processCallbacks()
+
+					// eENABLE_FRAME_STATE_BUFFER. fetchResults() only writes the buffer that is not published.
+					struct FrameStateBuffer
+					{
+						FrameStateBuffer() : mBodies(PX_DEBUG_EXP("frameStateBodies")), mContacts(PX_DEBUG_EXP("frameStateContacts")), mFrameIndex(0)	{}
+
+						Ps::Array<PxRigidDynamicFrameState>	mBodies;
+						Ps::Array<PxFrameContactSummary>	mContacts;
+						PxU32								mFrameIndex;
+					};
+					FrameStateBuffer				mFrameStates[2];
+					volatile PxU32					mPublishedFrameState;
+
+					// setContactSummaryCallback(). One array per PxContactSummaryReport attribute, reused every step.
+					struct ContactSummaryBuffer
+					{
+						void	resize(PxU32 nbPairs);
+
+						Ps::Array<PxRigidActor*>	mActors[2];
+						Ps::Array<PxShape*>			mShapes[2];
+						Ps::Array<PxPairFlags>		mEvents;
+						Ps::Array<PxReal>			mTotalImpulses;
+						Ps::Array<PxVec3>			mPoints;
+						Ps::Array<PxVec3>			mNormals;
+						Ps::Array<PxMaterial*>		mMaterials[2];
+					};
+					PxContactSummaryCallback*		mContactSummaryCallback;
+					ContactSummaryBuffer			mContactSummary;
 };
 
 
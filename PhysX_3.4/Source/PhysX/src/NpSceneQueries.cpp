@@ -43,6 +43,7 @@ using namespace Gu;
 
 #if PX_SUPPORT_PVD
 #include "NpPvdSceneQueryCollector.h"
+#include "PsTime.h"
 #endif
 
 namespace local
@@ -77,13 +78,18 @@ namespace local
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+static PX_FORCE_INLINE bool isSnapshotQuery(const PxQueryFilterData& filterData)
+{
+	return (filterData.flags & PxQueryFlag::eSNAPSHOT) == PxQueryFlag::eSNAPSHOT;
+}
+
 bool NpSceneQueries::raycast(
 	const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,
 	PxHitCallback<PxRaycastHit>& hits, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 	const PxQueryCache* cache) const
 {
 	PX_PROFILE_ZONE("SceneQuery.raycast", getContextId());
-	NP_READ_CHECK(this);	
+	NP_READ_CHECK(isSnapshotQuery(filterData) ? NULL : this);	// snapshot queries do not need the read lock
 	PX_SIMD_GUARD;
 
 	MultiQueryInput input(origin, unitDir, distance);
@@ -96,7 +102,7 @@ bool NpSceneQueries::overlap(
 	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall) const
 {
 	PX_PROFILE_ZONE("SceneQuery.overlap", getContextId());
-	NP_READ_CHECK(this);	
+	NP_READ_CHECK(isSnapshotQuery(filterData) ? NULL : this);	// snapshot queries do not need the read lock
 	PX_SIMD_GUARD;
 
 	MultiQueryInput input(&geometry, &pose);
@@ -111,7 +117,7 @@ bool NpSceneQueries::sweep(
 	const PxQueryCache* cache, const PxReal inflation) const
 {
 	PX_PROFILE_ZONE("SceneQuery.sweep", getContextId());
-	NP_READ_CHECK(this);	
+	NP_READ_CHECK(isSnapshotQuery(filterData) ? NULL : this);	// snapshot queries do not need the read lock
 	PX_SIMD_GUARD;
 
 #if PX_CHECKED
@@ -148,10 +154,9 @@ bool NpSceneQueries::sweep(
 ///////////////////////////////////////////////////////////////////////////////
 //========================================================================================================================
 
-static PX_FORCE_INLINE bool applyAllPreFiltersSQ(
-	const local::ActorShape* as, PxQueryHitType::Enum& hitType, const PxQueryFlags& inFilterFlags,
-	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
-	const NpSceneQueries& scene, BatchQueryFilterData* bfd, PxHitFlags& queryFlags, PxU32 /*maxNbTouches*/)
+// the filters that only depend on the data of the shape, run before any user filter
+static PX_FORCE_INLINE bool applyDataFiltersSQ(
+	const local::ActorShape* as, const PxQueryFilterData& filterData, const NpSceneQueries& scene, BatchQueryFilterData* bfd)
 {
 	if(!applyClientFilter(as->scbActor, filterData, scene))
 		return false;
@@ -161,7 +166,15 @@ static PX_FORCE_INLINE bool applyAllPreFiltersSQ(
 	// So if for BQ SPU filter shader the user tries to pass data via FD, the equation will always cut it out
 	// AP scaffold TODO: once SPU is officially phased out we can remove the !bfd clause, fix broken UTs (that are wrong)
 	// and also remove support for filter shaders
-	if(!bfd && !applyFilterEquation(*as->scbShape, filterData.data))
+	return bfd || applyFilterEquation(*as->scbShape, filterData.data);
+}
+
+static PX_FORCE_INLINE bool applyAllPreFiltersSQ(
+	const local::ActorShape* as, PxQueryHitType::Enum& hitType, const PxQueryFlags& inFilterFlags,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+	const NpSceneQueries& scene, BatchQueryFilterData* bfd, PxHitFlags& queryFlags, PxU32 /*maxNbTouches*/)
+{
+	if(!applyDataFiltersSQ(as, filterData, scene, bfd))
 		return false;
 
 	if((inFilterFlags & PxQueryFlag::ePREFILTER) && (filterCall || bfd))
@@ -330,6 +343,33 @@ struct GeomQueryAny
 	}
 };
 
+// candidates waiting for PxQueryFilterCallback::preFilterBatch(), see PxQueryFlag::eBATCH_PREFILTER
+static const PxU32 gPreFilterBatchSize = 32;
+
+struct PreFilterBatch
+{
+	local::ActorShape		candidates[gPreFilterBatchSize];
+	const PxShape*			shapes[gPreFilterBatchSize];
+	const PxRigidActor*		actors[gPreFilterBatchSize];
+	PxQueryHitType::Enum	hitTypes[gPreFilterBatchSize];
+	PxHitFlags				hitFlags[gPreFilterBatchSize];
+	PxU32					count;
+
+	PreFilterBatch() : count(0)	{}
+
+	// returns true if the batch is full
+	PX_FORCE_INLINE bool add(const local::ActorShape& as, PxQueryHitType::Enum hitType, PxHitFlags flags)
+	{
+		PX_ASSERT(count<gPreFilterBatchSize);
+		candidates[count] = as;
+		shapes[count] = as.shape;
+		actors[count] = as.actor;
+		hitTypes[count] = hitType;
+		hitFlags[count] = flags;
+		return ++count == gPreFilterBatchSize;
+	}
+};
+
 // struct to access protected data members in the public PxHitCallback API
 template<typename HitType>
 struct MultiQueryCallback : public PrunerCallback
@@ -348,6 +388,7 @@ struct MultiQueryCallback : public PrunerCallback
 	bool						mNoBlock;
 	const bool					mAnyHit;
 	bool						mIsCached; // is this call coming as a callback from the pruner or a single item cached callback?
+	bool						mTouchesFlushed; // processTouches() was called during the traversal, see PxQueryFlag::eCACHE_RESULTS
 
 	// The reason we need these bounds is because we need to know combined(inflated shape) bounds to clip the sweep path
 	// to be tolerable by GJK precision issues. This test is done for (queryShape vs touchedShapes)
@@ -356,6 +397,7 @@ struct MultiQueryCallback : public PrunerCallback
 	PxBounds3					mQueryShapeBounds;
 	bool						mQueryShapeBoundsValid;
 	const ShapeData*			mShapeData;
+	PreFilterBatch*				mPreFilterBatch; // not NULL if the user pre-filter runs on batches of candidates
 
 	MultiQueryCallback(
 		const NpSceneQueries& scene, const MultiQueryInput& input, bool anyHit, PxHitCallback<HitType>& hitCall, PxHitFlags hitFlags,
@@ -374,16 +416,15 @@ struct MultiQueryCallback : public PrunerCallback
 			mNoBlock				(filterData.flags & PxQueryFlag::eNO_BLOCK),
 			mAnyHit					(anyHit),
 			mIsCached				(false),
+			mTouchesFlushed			(false),
 			mQueryShapeBoundsValid	(false),
-			mShapeData				(NULL)
+			mShapeData				(NULL),
+			mPreFilterBatch			(NULL)
 	{
 	}
 	
 	virtual PxAgain invoke(PxReal& aDist, const PrunerPayload& aPayload)
 	{
-		const PxU32 tempCount = 1;
-		HitType tempBuf[tempCount];
-
 		// PT: TODO: do we need actorShape.actor/actorShape.shape immediately?
 		local::ActorShape actorShape;
 		local::populate(aPayload, actorShape);
@@ -401,6 +442,13 @@ struct MultiQueryCallback : public PrunerCallback
 
 		// apply pre-filter
 		PxHitFlags filteredHitFlags = mHitFlags;
+		if(mPreFilterBatch && !mIsCached)
+		{
+			// the data filters run right away, the user pre-filter once the batch is full or the traversal is over
+			if(!applyDataFiltersSQ(&actorShape, mFilterData, mScene, mBfd))
+				return true;
+			return mPreFilterBatch->add(actorShape, shapeHitType, filteredHitFlags) ? flushPreFilterBatch(aDist) : true;
+		}
 		if(!mIsCached) // don't run filters on single item cache
 			if(!applyAllPreFiltersSQ(&actorShape, shapeHitType/*in&out*/, filterFlags, mFilterData, mFilterCall,
 					mScene, mBfd, filteredHitFlags, mHitCall.maxNbTouches))
@@ -408,6 +456,39 @@ struct MultiQueryCallback : public PrunerCallback
 		if(shapeHitType == PxQueryHitType::eNONE)
 			return true;
 
+		return processShape(aDist, actorShape, shapeHitType, filteredHitFlags);
+	}
+
+	// runs the user pre-filter on the collected candidates, then the exact tests on the ones it kept
+	PxAgain flushPreFilterBatch(PxReal& aDist)
+	{
+		PreFilterBatch& batch = *mPreFilterBatch;
+		const PxU32 count = batch.count;
+		batch.count = 0;
+		if(!count)
+			return true;
+
+		mFilterCall->preFilterBatch(mFilterData.data, batch.shapes, batch.actors, count, batch.hitTypes, batch.hitFlags);
+
+		for(PxU32 i=0; i<count; i++)
+		{
+			if(batch.hitTypes[i] == PxQueryHitType::eNONE)
+				continue;
+			const PxHitFlags filteredHitFlags = (mHitFlags & ~PxHitFlag::eMODIFIABLE_FLAGS) | (batch.hitFlags[i] & PxHitFlag::eMODIFIABLE_FLAGS);
+			if(!processShape(aDist, batch.candidates[i], batch.hitTypes[i], filteredHitFlags))
+				return false;
+		}
+		return true;
+	}
+
+	// exact test and post-filter for a shape that passed the pre-filters
+	PxAgain processShape(PxReal& aDist, const local::ActorShape& actorShape, PxQueryHitType::Enum shapeHitType, PxHitFlags filteredHitFlags)
+	{
+		const PxU32 tempCount = 1;
+		HitType tempBuf[tempCount];
+
+		const PxQueryFlags filterFlags = mFilterData.flags;
+
 		PX_ASSERT(actorShape.actor && actorShape.shape);
 		const Scb::Shape* shape = actorShape.scbShape;
 		const Scb::Actor* actor = actorShape.scbActor;
@@ -529,6 +610,7 @@ struct MultiQueryCallback : public PrunerCallback
 						}
 						if(mHitCall.nbTouches == mHitCall.maxNbTouches)
 						{
+							mTouchesFlushed = true;
 							mReportTouchesAgain = mHitCall.processTouches(mHitCall.touches, mHitCall.nbTouches);
 							if(!mReportTouchesAgain)
 								return false; // optimization - buffer is full 
@@ -583,6 +665,9 @@ struct CapturePvdOnReturn : public PxHitCallback<HitType>
 	BatchQueryFilterData*		mBFD;			// PT: TODO: check if this is sometimes not NULL
 	Ps::Array<HitType>			mAllHits;
 	PxHitCallback<HitType>&		mParentCallback;
+	physx::Vd::PvdSceneQueryCollector::Capture	mCapture;
+	PxU32						mNbFlushedHits;	// hits already passed to processTouches, for summaries
+	PxU64						mStartTime;
 
 	CapturePvdOnReturn(
 		const NpSceneQueries* sq, const MultiQueryInput& input, PxHitFlags hitFlags,
@@ -596,24 +681,58 @@ struct CapturePvdOnReturn : public PxHitCallback<HitType>
 		mFilterData				(filterData),
 		mFilterCall				(filterCall),
 		mBFD					(bfd),
-		mParentCallback			(parentCallback)
-	{}
+		mParentCallback			(parentCallback),
+		mCapture				(physx::Vd::PvdSceneQueryCollector::eCAPTURE_NONE),
+		mNbFlushedHits			(0),
+		mStartTime				(0)
+	{
+		const physx::Vd::ScbScenePvdClient& pvdClient = mSQ->getScene().getScenePvdClient();
+		if(!(pvdClient.checkPvdDebugFlag() && (pvdClient.getScenePvdFlagsFast() & PxPvdSceneFlag::eTRANSMIT_SCENEQUERIES)))
+			return;
+
+		mCapture = getCollector().selectCapture(mFilterData);
+		if(mCapture == physx::Vd::PvdSceneQueryCollector::eCAPTURE_SUMMARY)
+			mStartTime = Ps::Time::getCurrentCounterValue();
+	}
+
+	PX_FORCE_INLINE physx::Vd::PvdSceneQueryCollector& getCollector()	const
+	{
+		return mBFD ? mSQ->getBatchedSqCollector() : mSQ->getSingleSqCollector();
+	}
 
 	virtual PxAgain processTouches(const HitType* hits, PxU32 nbHits)
 	{
 		const PxAgain again = mParentCallback.processTouches(hits, nbHits);
-		for(PxU32 i=0; i<nbHits; i++)
-			mAllHits.pushBack(hits[i]);
+		if(mCapture == physx::Vd::PvdSceneQueryCollector::eCAPTURE_DETAILED)
+		{
+			for(PxU32 i=0; i<nbHits; i++)
+				mAllHits.pushBack(hits[i]);
+		}
+		mNbFlushedHits += nbHits;
 		return again;
 	}
 
 	~CapturePvdOnReturn()
 	{
-		const physx::Vd::ScbScenePvdClient& pvdClient = mSQ->getScene().getScenePvdClient();
-		if(!(pvdClient.checkPvdDebugFlag() && (pvdClient.getScenePvdFlagsFast() & PxPvdSceneFlag::eTRANSMIT_SCENEQUERIES)))
+		if(mCapture == physx::Vd::PvdSceneQueryCollector::eCAPTURE_NONE)
 			return;
 
-		physx::Vd::PvdSceneQueryCollector& collector = mBFD ? mSQ->getBatchedSqCollector() : mSQ->getSingleSqCollector();
+		physx::Vd::PvdSceneQueryCollector& collector = getCollector();
+
+		if(mCapture == physx::Vd::PvdSceneQueryCollector::eCAPTURE_SUMMARY)
+		{
+			const PxU64 elapsed = Ps::Time::getCurrentCounterValue() - mStartTime;
+			PxU32 type;
+			if(HitTypeSupport<HitType>::IsRaycast)
+				type = physx::Vd::PvdSceneQueryCollector::getRaycastType(mFilterData, this->maxNbTouches!=0);
+			else if(HitTypeSupport<HitType>::IsOverlap)
+				type = physx::Vd::PvdSceneQueryCollector::getOverlapType(*mInput.geometry, *mInput.pose);
+			else
+				type = physx::Vd::PvdSceneQueryCollector::getSweepType(*mInput.geometry);
+			const PxU32 nbHits = mNbFlushedHits + mParentCallback.nbTouches + (mParentCallback.hasBlock ? 1u : 0u);
+			collector.addToSummary(type, nbHits, elapsed);
+			return;
+		}
 
 		if(mParentCallback.nbTouches)
 		{
@@ -638,6 +757,26 @@ private:
 };
 #endif // PX_SUPPORT_PVD
 
+//========================================================================================================================
+// holds the published scene query snapshot for the duration of a query
+struct SnapshotReadScope
+{
+	PX_FORCE_INLINE SnapshotReadScope(const SceneQueryManager& manager, bool acquire) :
+		mManager(manager), mSnapshot(acquire ? manager.acquireSnapshot() : NULL)	{}
+
+	PX_FORCE_INLINE ~SnapshotReadScope()
+	{
+		if(mSnapshot)
+			mManager.releaseSnapshot(mSnapshot);
+	}
+
+	const SceneQueryManager&	mManager;
+	const SceneQuerySnapshot*	mSnapshot;
+
+private:
+	SnapshotReadScope& operator=(const SnapshotReadScope&);
+};
+
 //========================================================================================================================
 template<typename HitType>
 struct IssueCallbacksOnReturn
@@ -675,6 +814,32 @@ private:
 
 #undef HITDIST
 
+//========================================================================================================================
+// records the results of a query in the result cache on return, i.e. before IssueCallbacksOnReturn reports them
+template<typename HitType>
+struct StoreResultsOnReturn
+{
+	QueryResultCache*					mCache;		// NULL if the query does not use the result cache
+	const QueryResultKey&				mKey;
+	const PxU32*						mTimestamps;
+	const MultiQueryCallback<HitType>&	mCallback;
+	const PxHitCallback<HitType>&		mHits;
+
+	PX_FORCE_INLINE StoreResultsOnReturn(QueryResultCache* cache, const QueryResultKey& key, const PxU32* timestamps,
+		const MultiQueryCallback<HitType>& callback, const PxHitCallback<HitType>& hits) :
+		mCache(cache), mKey(key), mTimestamps(timestamps), mCallback(callback), mHits(hits)	{}
+
+	PX_FORCE_INLINE ~StoreResultsOnReturn()
+	{
+		// touches already given to processTouches() cannot be replayed
+		if(mCache && !mCallback.mTouchesFlushed)
+			mCache->store(mKey, mTimestamps, mHits);
+	}
+
+private:
+	StoreResultsOnReturn<HitType>& operator=(const StoreResultsOnReturn<HitType>&);
+};
+
 //========================================================================================================================
 template<typename HitType>
 bool NpSceneQueries::multiQuery(
@@ -719,12 +884,19 @@ bool NpSceneQueries::multiQuery(
 	}
 
 	PX_CHECK_MSG(!cache || (cache && cache->shape && cache->actor), "Raycast cache specified but shape or actor pointer is NULL!");	
-	const PrunerData cacheData = cache ? NpActor::getShapeManager(*cache->actor)->findSceneQueryData(*static_cast<NpShape*>(cache->shape)) : SQ_INVALID_PRUNER_DATA;
+
+	// snapshot queries only read the published snapshot: no flush, and no cache since it would be looked up in the live pruners
+	const bool useSnapshot = isSnapshotQuery(filterData);
+	PX_CHECK_MSG(!useSnapshot || mSQManager.usesSnapshots(), "PxQueryFlag::eSNAPSHOT used on a scene created without PxSceneFlag::eENABLE_SCENE_QUERY_SNAPSHOTS, no hit will be reported.");
+	SnapshotReadScope snapshot(mSQManager, useSnapshot);
+
+	const PrunerData cacheData = (cache && !useSnapshot) ? NpActor::getShapeManager(*cache->actor)->findSceneQueryData(*static_cast<NpShape*>(cache->shape)) : SQ_INVALID_PRUNER_DATA;
 
 	// this function is logically const for the SDK user, as flushUpdates() will not have an API-visible effect on this object
 	// internally however, flushUpdates() changes the states of the Pruners in mSQManager
 	// because here is the only place we need this, const_cast instead of making SQM mutable
-	const_cast<NpSceneQueries*>(this)->mSQManager.flushUpdates();
+	if(!useSnapshot)
+		const_cast<NpSceneQueries*>(this)->mSQManager.flushUpdates();
 
 #if PX_SUPPORT_PVD
 	CapturePvdOnReturn<HitType> pvdCapture(this, input, hitFlags, cache, filterData, filterCall, bfd, hits);
@@ -734,10 +906,19 @@ bool NpSceneQueries::multiQuery(
 	hits.hasBlock = false;
 	hits.nbTouches = 0;
 
+	// the result cache is not used by batch, snapshot and nested (eRESERVED) queries, nor with a single shape cache
+	QueryResultKey resultKey;
+	const PxU32 timestamps[2] = { mSQManager.get(PruningIndex::eSTATIC).timestamp(), mSQManager.get(PruningIndex::eDYNAMIC).timestamp() };
+	const bool useResultCache = (filterData.flags & PxQueryFlag::eCACHE_RESULTS) && !(filterData.flags & PxQueryFlag::eRESERVED)
+		&& !useSnapshot && !bfd && !cache && resultKey.set<HitType>(input, hitFlags, filterData, filterCall, hits.maxNbTouches);
+	if(useResultCache && mQueryResultCache.fetch(resultKey, timestamps, hits))
+		return hits.hasAnyHits();
+
 	PxReal shrunkDistance = HitTypeSupport<HitType>::IsOverlap ? PX_MAX_REAL : input.maxDistance; // can be progressively shrunk as we go over the list of shapes
 	if(HitTypeSupport<HitType>::IsSweep)
 		shrunkDistance = PxMin(shrunkDistance, PX_MAX_SWEEP_DISTANCE);
 	MultiQueryCallback<HitType> pcb(*this, input, anyHit, hits, hitFlags, filterData, filterCall, shrunkDistance, bfd);
+	StoreResultsOnReturn<HitType> resultStore(useResultCache ? &mQueryResultCache : NULL, resultKey, timestamps, pcb, hits);
 
 	if(cacheData!=SQ_INVALID_PRUNER_DATA && hits.maxNbTouches == 0) // don't use cache for queries that can return touch hits
 	{
@@ -764,8 +945,10 @@ bool NpSceneQueries::multiQuery(
 			return hits.hasAnyHits();
 	}
 
-	const Pruner* staticPruner = mSQManager.get(PruningIndex::eSTATIC).pruner();
-	const Pruner* dynamicPruner = mSQManager.get(PruningIndex::eDYNAMIC).pruner();
+	if(useSnapshot && !snapshot.mSnapshot)
+		return false;	// nothing published yet
+	const Pruner* staticPruner = useSnapshot ? snapshot.mSnapshot->pruners[PruningIndex::eSTATIC] : mSQManager.get(PruningIndex::eSTATIC).pruner();
+	const Pruner* dynamicPruner = useSnapshot ? snapshot.mSnapshot->pruners[PruningIndex::eDYNAMIC] : mSQManager.get(PruningIndex::eDYNAMIC).pruner();
 
 	const PxU32 doStatics = filterData.flags & PxQueryFlag::eSTATIC;
 	const PxU32 doDynamics = filterData.flags & PxQueryFlag::eDYNAMIC;
@@ -788,12 +971,25 @@ bool NpSceneQueries::multiQuery(
 
 		const ShapeData sd(*input.geometry, *input.pose, input.inflation);
 		pcb.mShapeData = &sd;
+
+		PreFilterBatch preFilterBatch;
+		const PxQueryFlags batchFlags = PxQueryFlag::ePREFILTER | PxQueryFlag::eBATCH_PREFILTER;
+		if(filterCall && !bfd && (filterData.flags & batchFlags) == batchFlags)
+			pcb.mPreFilterBatch = &preFilterBatch;
+
 		PxAgain again = doStatics ? staticPruner->overlap(sd, pcb) : true;
 		if(!again) // && (filterData.flags & PxQueryFlag::eANY_HIT))
 			return hits.hasAnyHits();
 		
 		if(doDynamics)
 			again = dynamicPruner->overlap(sd, pcb);
+
+		// the candidates of the last, partial batch
+		if(again && pcb.mPreFilterBatch)
+		{
+			PxReal dummyDist = PX_MAX_REAL;
+			again = pcb.flushPreFilterBatch(dummyDist);
+		}
 		
 		cbr.again = again; // update the status to avoid duplicate processTouches()
 		return hits.hasAnyHits();
@@ -819,6 +1015,115 @@ bool NpSceneQueries::multiQuery(
 	}
 }
 
+//========================================================================================================================
+// raw storage for per-query objects of multiOverlap(), which are constructed in place and destroyed explicitly
+template<typename T, PxU32 N>
+struct InPlaceStorage
+{
+	PX_ALIGN(16, PxU8 mBuffer[sizeof(T)*N]);
+
+	PX_FORCE_INLINE	void*	at(PxU32 i)			{ return mBuffer + sizeof(T)*i;				}
+	PX_FORCE_INLINE	T&		operator[](PxU32 i)	{ return reinterpret_cast<T*>(mBuffer)[i];	}
+};
+
+// number of queries sent to the pruners at once, the pruners cannot traverse more together
+static const PxU32 gNbOverlapsPerGroup = 32;
+
+void NpSceneQueries::multiOverlap(PxU32 nbQueries, const OverlapQueryDesc* queries, BatchQueryFilterData* bfd) const
+{
+	// see multiQuery() for the const_cast
+	const_cast<NpSceneQueries*>(this)->mSQManager.flushUpdates();
+
+	const Pruner* staticPruner = mSQManager.get(PruningIndex::eSTATIC).pruner();
+	const Pruner* dynamicPruner = mSQManager.get(PruningIndex::eDYNAMIC).pruner();
+
+	while(nbQueries)
+	{
+		const PxU32 nb = PxMin(nbQueries, gNbOverlapsPerGroup);
+
+#if PX_SUPPORT_PVD
+		InPlaceStorage<CapturePvdOnReturn<PxOverlapHit>, gNbOverlapsPerGroup>	pvdCaptures;
+#endif
+		InPlaceStorage<IssueCallbacksOnReturn<PxOverlapHit>, gNbOverlapsPerGroup>	cbrs;
+		InPlaceStorage<ShapeData, gNbOverlapsPerGroup>								shapeDatas;
+		InPlaceStorage<MultiQueryCallback<PxOverlapHit>, gNbOverlapsPerGroup>		pcbs;
+
+		// same construction order as multiQuery(), so that the destructors issue the callbacks and the PVD capture the same way
+		for(PxU32 i=0;i<nb;i++)
+		{
+			const OverlapQueryDesc& q = queries[i];
+			PX_ASSERT(q.input->geometry && q.input->pose);
+			const bool anyHit = (q.filterData->flags & PxQueryFlag::eANY_HIT) == PxQueryFlag::eANY_HIT;
+
+#if PX_SUPPORT_PVD
+			PX_PLACEMENT_NEW(pvdCaptures.at(i), CapturePvdOnReturn<PxOverlapHit>)(this, *q.input, q.hitFlags, NULL, *q.filterData, q.filterCall, bfd, *q.hits);
+#endif
+			PX_PLACEMENT_NEW(cbrs.at(i), IssueCallbacksOnReturn<PxOverlapHit>)(*q.hits);
+			q.hits->hasBlock = false;
+			q.hits->nbTouches = 0;
+
+			PX_PLACEMENT_NEW(shapeDatas.at(i), ShapeData)(*q.input->geometry, *q.input->pose, q.input->inflation);
+			PX_PLACEMENT_NEW(pcbs.at(i), MultiQueryCallback<PxOverlapHit>)(*this, *q.input, anyHit, *q.hits, q.hitFlags, *q.filterData, q.filterCall, PX_MAX_REAL, bfd);
+			pcbs[i].mShapeData = &shapeDatas[i];
+		}
+
+		const ShapeData*	volumes[gNbOverlapsPerGroup];
+		PrunerCallback*		callbacks[gNbOverlapsPerGroup];
+		PxAgain				prunerAgain[gNbOverlapsPerGroup];
+		PxU32				indices[gNbOverlapsPerGroup];
+		PxAgain				staticAgain[gNbOverlapsPerGroup];
+
+		PxU32 nbStatics = 0;
+		for(PxU32 i=0;i<nb;i++)
+		{
+			staticAgain[i] = true;
+			if(queries[i].filterData->flags & PxQueryFlag::eSTATIC)
+			{
+				volumes[nbStatics] = &shapeDatas[i];
+				callbacks[nbStatics] = &pcbs[i];
+				indices[nbStatics++] = i;
+			}
+		}
+		if(nbStatics)
+		{
+			staticPruner->overlapMultiple(nbStatics, volumes, callbacks, prunerAgain);
+			for(PxU32 j=0;j<nbStatics;j++)
+				staticAgain[indices[j]] = prunerAgain[j];
+		}
+
+		// queries stopped by the static pruner skip the dynamic one and keep cbr.again = true, like multiQuery() does
+		PxU32 nbDynamics = 0;
+		for(PxU32 i=0;i<nb;i++)
+		{
+			if(staticAgain[i] && (queries[i].filterData->flags & PxQueryFlag::eDYNAMIC))
+			{
+				volumes[nbDynamics] = &shapeDatas[i];
+				callbacks[nbDynamics] = &pcbs[i];
+				indices[nbDynamics++] = i;
+			}
+		}
+		if(nbDynamics)
+		{
+			dynamicPruner->overlapMultiple(nbDynamics, volumes, callbacks, prunerAgain);
+			for(PxU32 j=0;j<nbDynamics;j++)
+				cbrs[indices[j]].again = prunerAgain[j];
+		}
+
+		for(PxU32 i=0;i<nb;i++)
+		{
+			pcbs[i].~MultiQueryCallback<PxOverlapHit>();
+			shapeDatas[i].~ShapeData();
+			cbrs[i].~IssueCallbacksOnReturn<PxOverlapHit>();
+#if PX_SUPPORT_PVD
+			pvdCaptures[i].~CapturePvdOnReturn<PxOverlapHit>();
+#endif
+		}
+
+		queries += nb;
+		nbQueries -= nb;
+	}
+}
+
 void NpSceneQueries::sceneQueriesStaticPrunerUpdate(PxBaseTask* )
 {
 	PX_PROFILE_ZONE("SceneQuery.sceneQueriesStaticPrunerUpdate", getContextId());
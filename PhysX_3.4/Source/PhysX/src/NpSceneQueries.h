@@ -40,6 +40,7 @@
 #include "GuSweepTests.h"
 #include "GuOverlapTests.h"
 #include "ScbScene.h"
+#include "NpQueryResultCache.h"
 
 #if PX_SUPPORT_PVD
 #include "NpPvdSceneQueryCollector.h"
@@ -135,6 +136,16 @@ struct BatchQueryFilterData
 	}
 };
 
+// one overlap query of a group run by NpSceneQueries::multiOverlap()
+struct OverlapQueryDesc
+{
+	const MultiQueryInput*			input;
+	PxHitCallback<PxOverlapHit>*	hits;
+	PxHitFlags						hitFlags;
+	const PxQueryFilterData*		filterData;
+	PxQueryFilterCallback*			filterCall;
+};
+
 class PxGeometry;
 
 class NpSceneQueries : public PxScene
@@ -152,6 +163,11 @@ public:
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														BatchQueryFilterData* bqFd) const;
 
+	// Runs a group of overlap queries with a single traversal of each pruner for the whole group, each query reporting
+	// to its own hit callback as multiQuery() would. The queries must not use a cache nor PxQueryFlag::eSNAPSHOT,
+	// and must pass the input checks of multiQuery(), which are not repeated here.
+					void							multiOverlap(PxU32 nbQueries, const OverlapQueryDesc* queries, BatchQueryFilterData* bqFd) const;
+
 	// Synchronous scene queries
 	virtual			bool							raycast(
 														const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,	// Ray data
@@ -195,6 +211,9 @@ public:
 
 					PxSceneQueryUpdateMode::Enum    mSceneQueryUpdateMode;
 
+					// see PxQueryFlag::eCACHE_RESULTS. Queries are const for the user, caching their results is not.
+	mutable			QueryResultCache				mQueryResultCache;
+
 #if PX_SUPPORT_PVD
 public:
 					//Scene query and hits for pvd, collected in current frame
@@ -308,6 +308,37 @@ void NpShape::setGeometry(const PxGeometry& g)
 	updateSQ("PxShape::setGeometry: Shape is a part of pruning structure, pruning structure is now invalid!");
 }
 
+void NpShape::notifyHeightFieldModified(PxI32 startCol, PxI32 startRow, PxU32 nbColumns, PxU32 nbRows)
+{
+	NP_WRITE_CHECK(getOwnerScene());
+	PX_CHECK_AND_RETURN(isWritable(), "PxShape::notifyHeightFieldModified: shared shapes attached to actors are not writable.");
+	PX_CHECK_AND_RETURN(getGeometryTypeFast() == PxGeometryType::eHEIGHTFIELD, "PxShape::notifyHeightFieldModified: the shape is not a heightfield shape.");
+	PX_SIMD_GUARD;
+
+	const PxHeightFieldGeometry& hfGeom = static_cast<const PxHeightFieldGeometry&>(mShape.getGeometry());
+	const PxI32 lastRow = PxI32(hfGeom.heightField->getNbRows()) - 1;
+	const PxI32 lastColumn = PxI32(hfGeom.heightField->getNbColumns()) - 1;
+
+	// a modified sample touches the cells on both sides of it
+	const PxI32 minRow = PxClamp(startRow - 1, 0, lastRow);
+	const PxI32 maxRow = PxClamp(startRow + PxI32(nbRows), 0, lastRow);
+	const PxI32 minColumn = PxClamp(startCol - 1, 0, lastColumn);
+	const PxI32 maxColumn = PxClamp(startCol + PxI32(nbColumns), 0, lastColumn);
+	if(!nbRows || !nbColumns || minRow >= maxRow || minColumn >= maxColumn)
+		return;
+
+	// rows go along x and columns along z. The region is unbounded vertically, the old surface may lie
+	// anywhere above or below the new one.
+	const PxReal x0 = PxReal(minRow) * hfGeom.rowScale, x1 = PxReal(maxRow) * hfGeom.rowScale;
+	const PxReal z0 = PxReal(minColumn) * hfGeom.columnScale, z1 = PxReal(maxColumn) * hfGeom.columnScale;
+	const PxBounds3 localRegion(PxVec3(PxMin(x0, x1), -PX_MAX_BOUNDS_EXTENTS, PxMin(z0, z1)),
+								PxVec3(PxMax(x0, x1), PX_MAX_BOUNDS_EXTENTS, PxMax(z0, z1)));
+
+	mShape.onGeometryRegionChange(localRegion);
+
+	updateSQ("PxShape::notifyHeightFieldModified: Shape is a part of pruning structure, pruning structure is now invalid!");
+}
+
 PxGeometryHolder NpShape::getGeometry() const
 {
 	PX_COMPILE_TIME_ASSERT(sizeof(Gu::GeometryUnion)>=sizeof(PxGeometryHolder));
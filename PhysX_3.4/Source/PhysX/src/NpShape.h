@@ -104,6 +104,7 @@ public:
 	virtual			PxGeometryType::Enum		getGeometryType() const;
 
 	virtual			void						setGeometry(const PxGeometry&);
+	virtual			void						notifyHeightFieldModified(PxI32 startCol, PxI32 startRow, PxU32 nbColumns, PxU32 nbRows);
 	virtual			PxGeometryHolder			getGeometry() const;
 	virtual			bool						getBoxGeometry(PxBoxGeometry&) const;
 	virtual			bool						getSphereGeometry(PxSphereGeometry&) const;
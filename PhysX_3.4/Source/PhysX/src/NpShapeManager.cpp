@@ -398,8 +398,8 @@ static void visualizeActiveEdges(RenderOutput& out, const Gu::TriangleMesh& mesh
 	const PxU8* extraTrigData = mesh.getExtraTrigData();
 	PX_ASSERT(extraTrigData);
 
-	const PxVec3* vertices = mesh.getVerticesFast();
-	const void* indices = mesh.getTrianglesFast();
+	const PxVec3* vertices = mesh.getVertices();
+	const void* indices = mesh.getTriangles();
 
 	out << PxU32(PxDebugColor::eARGB_YELLOW);	// PT: no need to output this for each segment!
 
@@ -464,8 +464,8 @@ static void visualizeTriangleMesh(const PxTriangleMeshGeometry& geometry, Render
 
 	PxU32 nbTriangles = triangleMesh->getNbTrianglesFast();
 	const PxU32 nbVertices = triangleMesh->getNbVerticesFast();
-	const PxVec3* vertices = triangleMesh->getVerticesFast();
-	const void* indices = triangleMesh->getTrianglesFast();
+	const PxVec3* vertices = triangleMesh->getVertices();
+	const void* indices = triangleMesh->getTriangles();
 	const bool has16Bit = triangleMesh->has16BitIndices();
 
 	// PT: TODO: don't render the same edge multiple times
@@ -638,7 +638,7 @@ static void visualize(const PxGeometry& geometry, RenderOutput& out, const PxTra
 	}
 }
 
-void NpShapeManager::visualize(RenderOutput& out, NpScene* scene, const PxRigidActor& actor)
+void NpShapeManager::visualize(RenderOutput& out, NpScene* scene, const PxTransform& actorPose)
 {
 	const PxReal scale = scene->getVisualizationParameter(PxVisualizationParameter::eSCALE);
 	if(!scale)
@@ -658,12 +658,11 @@ void NpShapeManager::visualize(RenderOutput& out, NpScene* scene, const PxRigidA
 	const bool visualizeFNormals	= fNormals!=0.0f;
 	const bool visualizeCollision	= visualizeShapes || visualizeFNormals || visualizeEdges;
 	const bool useCullBox			= !cullbox.isEmpty();
-	const bool needsShapeBounds0	= visualizeCompounds || (visualizeCollision && useCullBox);
+	// the culling box applies to everything drawn for a shape, so the bounds are needed to skip the culled shapes early
+	const bool needsShapeBounds0	= visualizeCompounds || useCullBox;
 	const PxReal collisionAxes		= scale * scene->getVisualizationParameter(PxVisualizationParameter::eCOLLISION_AXES);
 	const PxReal fscale				= scale * fNormals;
 
-	const PxTransform actorPose = actor.getGlobalPose();
-
 	PxBounds3 compoundBounds(PxBounds3::empty());
 	for(PxU32 i=0;i<nbShapes;i++)
 	{
@@ -677,7 +676,7 @@ void NpShapeManager::visualize(RenderOutput& out, NpScene* scene, const PxRigidA
 		const bool needsShapeBounds = needsShapeBounds0 || (visualizeAABBs && shapeDebugVizEnabled);
 		const PxBounds3 currentShapeBounds = needsShapeBounds ? Gu::computeBounds(geom, absPose, !gUnifiedHeightfieldCollision) : PxBounds3::empty();
 
-		if(shapeDebugVizEnabled)
+		if(shapeDebugVizEnabled && (!useCullBox || cullbox.intersects(currentShapeBounds)))
 		{
 			if(visualizeAABBs)
 				out << PxU32(PxDebugColor::eARGB_YELLOW) << PxMat44(PxIdentity) << DebugBox(currentShapeBounds);
@@ -686,10 +685,7 @@ void NpShapeManager::visualize(RenderOutput& out, NpScene* scene, const PxRigidA
 				out << PxMat44(absPose) << DebugBasis(PxVec3(collisionAxes), 0xcf0000, 0x00cf00, 0x0000cf);
 
 			if(visualizeCollision)
-			{
-				if(!useCullBox || cullbox.intersects(currentShapeBounds))
-					::visualize(geom, out, absPose, cullbox, fscale, visualizeShapes, visualizeEdges, useCullBox);
-			}
+				::visualize(geom, out, absPose, cullbox, fscale, visualizeShapes, visualizeEdges, useCullBox);
 		}
 
 		if(visualizeCompounds)
@@ -106,7 +106,7 @@ public:
 					void					releaseExclusiveUserReferences();
 
 #if PX_ENABLE_DEBUG_VISUALIZATION
-					void					visualize(Cm::RenderOutput& out, NpScene* scene, const PxRigidActor& actor);
+					void					visualize(Cm::RenderOutput& out, NpScene* scene, const PxTransform& actorPose);
 #endif
 					// for batching
 	PX_FORCE_INLINE	const Cm::PtrTable&		getShapeTable() const 		{	return mShapes; }
@@ -83,6 +83,57 @@ void NpSpatialIndex::remove(PxSpatialIndexItemId id)
 	mPendingUpdates = true;
 }
 
+void NpSpatialIndex::insert(PxSpatialIndexItem* const* items, const PxBounds3* bounds, PxU32 nbItems, PxSpatialIndexItemId* ids)
+{
+	PX_SIMD_GUARD;
+	PX_CHECK_AND_RETURN(items && bounds && ids, "PxSpatialIndex::insert: NULL array.");
+#if PX_CHECKED
+	for(PxU32 i=0;i<nbItems;i++)
+		PX_CHECK_AND_RETURN(bounds[i].isValid(), "PxSpatialIndex::insert: bounds are not valid.");
+#endif
+
+	if(!nbItems)
+		return;
+
+	Ps::Array<PrunerPayload> payloads;
+	payloads.resizeUninitialized(nbItems);
+	for(PxU32 i=0;i<nbItems;i++)
+	{
+		payloads[i].data[0] = reinterpret_cast<size_t>(items[i]);
+		payloads[i].data[1] = 0;
+	}
+
+	if(!mPruner->addObjects(ids, bounds, payloads.begin(), nbItems, false))
+	{
+		for(PxU32 i=0;i<nbItems;i++)
+			ids[i] = PX_SPATIAL_INDEX_INVALID_ITEM_ID;
+	}
+	mPendingUpdates = true;
+}
+
+void NpSpatialIndex::update(const PxSpatialIndexItemId* ids, const PxBounds3* bounds, PxU32 nbItems)
+{
+	PX_SIMD_GUARD;
+	PX_CHECK_AND_RETURN(ids && bounds, "PxSpatialIndex::update: NULL array.");
+#if PX_CHECKED
+	for(PxU32 i=0;i<nbItems;i++)
+		PX_CHECK_AND_RETURN(bounds[i].isValid(), "PxSpatialIndex::update: bounds are not valid.");
+#endif
+
+	if(!nbItems)
+		return;
+
+	for(PxU32 i=0;i<nbItems;i++)
+	{
+		PxBounds3* b;
+		mPruner->getPayload(ids[i], b);
+		*b = bounds[i];
+	}
+	mPruner->updateObjectsAfterManualBoundsUpdates(ids, nbItems);
+
+	mPendingUpdates = true;
+}
+
 namespace
 {
 	struct OverlapCallback: public PrunerCallback
@@ -186,6 +237,17 @@ void NpSpatialIndex::rebuildFull()
 	mPendingUpdates = false;
 }
 
+void NpSpatialIndex::rebuildFull(PxCpuDispatcher& dispatcher)
+{
+	PX_SIMD_GUARD;
+
+	mPruner->setBuildDispatcher(&dispatcher);
+	mPruner->purge();
+	mPruner->commit();
+	mPruner->setBuildDispatcher(NULL);
+	mPendingUpdates = false;
+}
+
 void NpSpatialIndex::setIncrementalRebuildRate(PxU32 rate)
 {
 	mPruner->setRebuildRateHint(rate);
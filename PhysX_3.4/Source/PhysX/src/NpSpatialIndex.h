@@ -56,6 +56,15 @@ public:
 
 	virtual	void					remove(PxSpatialIndexItemId id);
 
+	virtual	void					insert(PxSpatialIndexItem* const* items,
+										   const PxBounds3* bounds,
+										   PxU32 nbItems,
+										   PxSpatialIndexItemId* ids);
+
+	virtual	void					update(const PxSpatialIndexItemId* ids,
+										   const PxBounds3* bounds,
+										   PxU32 nbItems);
+
 	virtual void					overlap(const PxBounds3& aabb,
 											PxSpatialOverlapCallback& callback)		const;
 
@@ -71,6 +80,7 @@ public:
 
 	virtual void					flush()	{ flushUpdates(); }
 	virtual void					rebuildFull();
+	virtual void					rebuildFull(PxCpuDispatcher& dispatcher);
 	virtual void					setIncrementalRebuildRate(PxU32 rate);
 	virtual void					rebuildStep();
 	virtual void					release();
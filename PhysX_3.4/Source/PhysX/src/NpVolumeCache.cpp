@@ -37,6 +37,8 @@
 #include "GuIntersectionRayBox.h"
 #include "NpQueryShared.h"
 #include "NpSceneQueries.h"
+#include "NpActor.h"
+#include "NpShapeManager.h"
 #include "PsFoundation.h"
 
 namespace physx {
@@ -59,11 +61,14 @@ NpVolumeCache::NpVolumeCache(Sq::SceneQueryManager* sqm, PxU32 maxStaticShapes,
 	mIsInvalid[0] = mIsInvalid[1] = true;
 	mCache[0].reserve(maxStaticShapes);
 	mCache[1].reserve(maxDynamicShapes);
+	mLocalTree[0] = mLocalTree[1] = NULL;
 }
 
 //========================================================================================================================
 NpVolumeCache::~NpVolumeCache()
 {
+	PX_DELETE(mLocalTree[0]);
+	PX_DELETE(mLocalTree[1]);
 }
 
 //========================================================================================================================
@@ -72,9 +77,81 @@ void NpVolumeCache::invalidate()
 	mCacheVolume.any() = InvalidGeometry();
 	mCache[0].clear();
 	mCache[1].clear();
+	clearLocalTree(0);
+	clearLocalTree(1);
 	mIsInvalid[0] = mIsInvalid[1] = true;
 }
 
+//========================================================================================================================
+// below this count the cached shapes are tested one by one, the local tree would not pay for itself
+static const PxU32 gMinNbShapesForLocalTree = 16;
+
+// the scene pruner bounds of a cached shape, which the scene query that filled the cache just used
+static PX_FORCE_INLINE const PxBounds3& getPrunerBounds(const SceneQueryManager& sqm, const PxActorShape& as)
+{
+	const PrunerData data = NpActor::getShapeManager(*as.actor)->findSceneQueryData(*static_cast<NpShape*>(as.shape));
+	PxBounds3* bounds;
+	sqm.get(PruningIndex::Enum(getPrunerIndex(data))).pruner()->getPayload(getPrunerHandle(data), bounds);
+	return *bounds;
+}
+
+void NpVolumeCache::clearLocalTree(PxU32 isDynamic)
+{
+	Ps::Array<PxU32>& handles = mLocalHandles[isDynamic];
+	if(handles.size())
+	{
+		mLocalTree[isDynamic]->removeObjects(handles.begin(), handles.size());
+		handles.clear();
+	}
+}
+
+void NpVolumeCache::updateLocalTree(PxU32 isDynamic, bool sameShapes)
+{
+	const Ps::Array<PxActorShape>& cache = mCache[isDynamic];
+	Ps::Array<PxU32>& handles = mLocalHandles[isDynamic];
+	const PxU32 nbShapes = cache.size();
+	if(nbShapes < gMinNbShapesForLocalTree)
+	{
+		clearLocalTree(isDynamic);
+		return;
+	}
+
+	if(!mLocalTree[isDynamic])
+		mLocalTree[isDynamic] = createIncrementalAABBPruner();
+	Pruner* tree = mLocalTree[isDynamic];
+
+	if(sameShapes && handles.size() == nbShapes)
+	{
+		// the shapes of the previous fill, typically refilled because dynamic shapes moved: refit the tree in place
+		for(PxU32 i=0;i<nbShapes;i++)
+		{
+			PxBounds3* bounds;
+			tree->getPayload(handles[i], bounds);
+			*bounds = getPrunerBounds(*mSQManager, cache[i]);
+		}
+		tree->updateObjectsAfterManualBoundsUpdates(handles.begin(), nbShapes);
+	}
+	else
+	{
+		clearLocalTree(isDynamic);
+
+		Ps::Array<PxBounds3> bounds;
+		Ps::Array<PrunerPayload> payloads;
+		bounds.resizeUninitialized(nbShapes);
+		payloads.resizeUninitialized(nbShapes);
+		for(PxU32 i=0;i<nbShapes;i++)
+		{
+			bounds[i] = getPrunerBounds(*mSQManager, cache[i]);
+			payloads[i].data[0] = reinterpret_cast<size_t>(cache[i].shape);
+			payloads[i].data[1] = reinterpret_cast<size_t>(cache[i].actor);
+		}
+		handles.resizeUninitialized(nbShapes);
+		if(!tree->addObjects(handles.begin(), bounds.begin(), payloads.begin(), nbShapes, false))
+			handles.clear();	// out of memory, the cached shapes get tested one by one
+	}
+	tree->commit();
+}
+
 //========================================================================================================================
 void NpVolumeCache::release()
 {
@@ -202,9 +279,6 @@ PxVolumeCache::FillStatus NpVolumeCache::fillInternal(PxU32 isDynamic, const PxO
 		}
 	}
 
-	// clear current cache
-	mCache[isDynamic].resize(0);
-
 	// query the scene
 	PxI32 resultCount = prefilledCount;
 	PxQueryFilterData fd(isDynamic ? PxQueryFlag::eDYNAMIC : PxQueryFlag::eSTATIC);
@@ -220,12 +294,20 @@ PxVolumeCache::FillStatus NpVolumeCache::fillInternal(PxU32 isDynamic, const PxO
 		// cache overflow - deallocate the temp buffer
 		if(!hitBufferAlloca && hitBuffer != prefilledBuffer)
 			physx::shdfnd::TempAllocator().deallocate(hitBuffer);
+		mCache[isDynamic].resize(0);
+		clearLocalTree(isDynamic);
 		mIsInvalid[isDynamic] = true;
 		return FILL_OVER_MAX_COUNT;
 	}
 
+	// finding the shapes of the previous fill again lets the local tree be refit instead of rebuilt
+	bool sameShapes = mCache[isDynamic].size() == PxU32(resultCount);
+	for (PxI32 iHit = 0; sameShapes && iHit < resultCount; iHit++)
+		sameShapes = mCache[isDynamic][PxU32(iHit)].actor == hitBuffer[iHit].actor && mCache[isDynamic][PxU32(iHit)].shape == hitBuffer[iHit].shape;
+
 	// fill the cache
 	PX_ASSERT(resultCount <= PxI32(mMaxShapeCount[isDynamic]));
+	mCache[isDynamic].resize(0);
 	for (PxI32 iHit = 0; iHit < resultCount; iHit++)
 	{
 		PxActorShape as;
@@ -234,6 +316,7 @@ PxVolumeCache::FillStatus NpVolumeCache::fillInternal(PxU32 isDynamic, const PxO
 		PX_ASSERT(as.actor && as.shape);
 		mCache[isDynamic].pushBack(as);
 	}
+	updateLocalTree(isDynamic, sameShapes);
 
 	// timestamp the cache
 	if(isDynamic)
@@ -377,6 +460,7 @@ void NpVolumeCache::setMaxNbStaticShapes(PxU32 maxCount)
 	{
 		mIsInvalid[0] = true;
 		mCache[0].clear();
+		clearLocalTree(0);
 	}
 	mMaxShapeCount[0] = maxCount;
 	mCache[0].reserve(maxCount);
@@ -395,6 +479,7 @@ void NpVolumeCache::setMaxNbDynamicShapes(PxU32 maxCount)
 	{
 		mIsInvalid[1] = true;
 		mCache[1].clear();
+		clearLocalTree(1);
 	}
 	mMaxShapeCount[1] = maxCount;
 	mCache[1].reserve(maxCount);
@@ -539,105 +624,62 @@ PX_FORCE_INLINE void makeHitSafe(HitType& hit) // hit can contain NaNs (due to u
 }
 
 //========================================================================================================================
+// runs a cached query against one cached shape at a time, for each entry of the cache or for the entries reported by the local tree
 template<typename HitType>
-bool NpVolumeCache::multiQuery(
-	const MultiQueryInput& input, PxHitCallback<HitType>& hitCall, PxHitFlags hitFlags,
-	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxF32 inflation) const
+struct VolumeCacheQueryCallback : PrunerCallback
 {
+	const NpVolumeCache&		mCache;
+	const MultiQueryInput&		mInput;
+	PxHitCallback<HitType>&		mHitCall;
+	PxHitFlags					mHitFlags;
+	const PxQueryFilterData&	mFilterData;
+	PxQueryFilterCallback*		mFilterCall;
+	PxF32						mInflation;
+	const NpScene&				mScene;
+	HitType*					mSubHits;
+	PxU32						mMaxSubHits;
+	PxReal						mShrunkDistance;	// can be progressively shrunk as we go over the list of shapes
+	bool						mDone;				// the query completed early, mResult is what multiQuery() returns
+	bool						mResult;
+
+	VolumeCacheQueryCallback(
+		const NpVolumeCache& cache, const MultiQueryInput& input, PxHitCallback<HitType>& hitCall, PxHitFlags hitFlags,
+		const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxF32 inflation, const NpScene& scene,
+		HitType* subHits, PxU32 maxSubHits) :
+			mCache			(cache),
+			mInput			(input),
+			mHitCall		(hitCall),
+			mHitFlags		(hitFlags),
+			mFilterData		(filterData),
+			mFilterCall		(filterCall),
+			mInflation		(inflation),
+			mScene			(scene),
+			mSubHits		(subHits),
+			mMaxSubHits		(maxSubHits),
+			mShrunkDistance	(HitTypeSupport<HitType>::IsOverlap ? PX_MAX_REAL : input.maxDistance),
+			mDone			(false),
+			mResult			(false)
+	{}
 
-	if(HitTypeSupport<HitType>::IsRaycast == 0)
-	{
-		PX_CHECK_AND_RETURN_VAL(input.pose->isValid(), "sweepInputCheck: pose is not valid.", 0);
-	}
-	if(HitTypeSupport<HitType>::IsOverlap == 0)
-	{
-		PX_CHECK_AND_RETURN_VAL(input.getDir().isFinite(), "PxVolumeCache multiQuery input check: unitDir is not valid.", 0);
-		PX_CHECK_AND_RETURN_VAL(input.getDir().isNormalized(), "PxVolumeCache multiQuery input check: direction must be normalized", 0);
-	}
-	if(HitTypeSupport<HitType>::IsRaycast)
-	{
-		PX_CHECK_AND_RETURN_VAL(input.maxDistance > 0.0f, "PxVolumeCache multiQuery input check: distance cannot be negative or zero", 0);
-	}
-	if(HitTypeSupport<HitType>::IsSweep)
-	{
-		PX_CHECK_AND_RETURN_VAL(input.maxDistance >= 0.0f, "NpSceneQueries multiQuery input check: distance cannot be negative", 0);
-		PX_CHECK_AND_RETURN_VAL(input.maxDistance != 0.0f || !(hitFlags & PxHitFlag::eASSUME_NO_INITIAL_OVERLAP),
-			"PxVolumeCache multiQuery input check: zero-length sweep only valid without the PxHitFlag::eASSUME_NO_INITIAL_OVERLAP flag", 0);
-	}
-
-	hitCall.hasBlock = false;
-	hitCall.nbTouches = 0;
-
-	const PxQueryFlags filterFlags = filterData.flags;
-
-	// refill the cache if invalid
-	for(PxU32 isDynamic = 0; isDynamic <= 1; isDynamic++)
-	{
-		if(!isValid(isDynamic) && ((isDynamic+1) & PxU32(filterFlags)) != 0) // isDynamic+1 = 1 for static, 2 for dynamic
-			// check for overflow or unspecified cache volume&transform, fall back to scene query on overflow (or invalid voltype)
-			if(const_cast<NpVolumeCache*>(this)->fillInternal(isDynamic) == FILL_OVER_MAX_COUNT
-				|| mCacheVolume.getType() == PxGeometryType::eINVALID)
-			{
-				// fall back to full scene query with input flags if we blow the cache on either static or dynamic for now
-				if(mCacheVolume.getType() == PxGeometryType::eINVALID)
-					Ps::getFoundation().error(PxErrorCode::ePERF_WARNING, __FILE__, __LINE__,
-						"PxVolumeCache: unspecified volume geometry. Reverting to uncached scene query.");
-				return SceneQueryAny<HitType>::doQuery(
-					getNpScene(mSQManager), input, hitCall, hitFlags, filterData, filterCall);
-			}
-	}
-
-	// cache is now valid and there was no overflow
-	PX_ASSERT_WITH_MESSAGE(isValid() ,"PxVolumeCache became invalid inside of a scene read call.");
-
-	const PxU32 cacheSize[2] = { mCache[0].size(), mCache[1].size() };
-
-	// early out if the cache is empty and valid
-	if(cacheSize[0] == 0 && cacheSize[1] == 0)
-		return 0;
-
-	PxReal shrunkDistance = HitTypeSupport<HitType>::IsOverlap ? PX_MAX_REAL : input.maxDistance; // can be progressively shrunk as we go over the list of shapes
-	const NpScene& scene = *getNpScene(mSQManager);
-	HitType* subHits = NULL;
-
-	// make sure to deallocate the temp buffer when we return
-	struct FreeSubhits
-	{
-		HitType* toFree;
-		PX_FORCE_INLINE FreeSubhits() { toFree = NULL; }
-		PX_FORCE_INLINE ~FreeSubhits() { if (toFree) physx::shdfnd::TempAllocator().deallocate(toFree); }
-	} ds;
-
-	// allocate from temp storage rather than from the stack if we are over some shape count
-	PxU32 maxMaxShapeCount = PxMax(mMaxShapeCount[0], mMaxShapeCount[1]); // max size buffer for statics and dynamics
-	if(maxMaxShapeCount < 128) // somewhat arbitrary
-		subHits = reinterpret_cast<HitType*>(PxAlloca(sizeof(HitType)*maxMaxShapeCount));
-	else
-		ds.toFree = subHits = reinterpret_cast<HitType*>(physx::shdfnd::TempAllocator().allocate(sizeof(HitType)*maxMaxShapeCount, __FILE__, __LINE__));
-
-	const bool noBlock = (filterFlags & PxQueryFlag::eNO_BLOCK);
-
-	// for statics & dynamics
-	for(PxU32 isDynamic = 0; isDynamic <= 1; isDynamic++)
-		// iterate over all the cached shapes
-		for(PxU32 iCachedShape = 0; iCachedShape < cacheSize[isDynamic]; iCachedShape++)
+	// returns false once the query is complete
+	bool processShape(PxActorShape* as)
 	{
-		PxActorShape* as = &mCache[isDynamic][iCachedShape];
+		const PxQueryFlags filterFlags = mFilterData.flags;
 
 		const PxU32 actorFlag = (PxU32(as->actor->is<PxRigidDynamic>() != NULL) + 1); // 1 for static, 2 for dynamic
 		PX_COMPILE_TIME_ASSERT(PxQueryFlag::eSTATIC == 1);
 		PX_COMPILE_TIME_ASSERT(PxQueryFlag::eDYNAMIC == 2);
 		if((actorFlag & PxU32(filterFlags)) == 0) // filter the actor according to the input static/dynamic filter
-			continue;
+			return true;
 
 		// for no filter callback, default to eTOUCH for MULTIPLE, eBLOCK otherwise
-		PxQueryHitType::Enum shapeHitType = hitCall.maxNbTouches ? PxQueryHitType::eTOUCH : PxQueryHitType::eBLOCK;
+		PxQueryHitType::Enum shapeHitType = mHitCall.maxNbTouches ? PxQueryHitType::eTOUCH : PxQueryHitType::eBLOCK;
 
 		// apply pre-filter
-		PxHitFlags queryFlags = hitFlags;
-		as = applyAllPreFiltersVC(as, shapeHitType, filterFlags, filterData, filterCall, scene, hitFlags);
+		PxHitFlags queryFlags = mHitFlags;
+		as = applyAllPreFiltersVC(as, shapeHitType, filterFlags, mFilterData, mFilterCall, mScene, mHitFlags);
 		if(!as || shapeHitType == PxQueryHitType::eNONE)
-			continue;
+			return true;
 		PX_ASSERT(as->actor && as->shape);
 
 		NpShape* shape = static_cast<NpShape*>(as->shape);
@@ -650,16 +692,18 @@ bool NpVolumeCache::multiQuery(
 
 		// call the geometry specific intersection template
 		PxU32 nbSubHits = GeomQueryAny<HitType>::geomHit(
-			input, cachedShapeGeom.getGeometry(), globalPose, queryFlags,
+			mInput, cachedShapeGeom.getGeometry(), globalPose, queryFlags,
 			// limit number of hits to 1 for meshes if eMESH_MULTIPLE wasn't specified.
 			//this tells geomQuery to only look for a closest hit
-			(cachedShapeGeom.getType() == PxGeometryType::eTRIANGLEMESH && !(hitFlags & PxHitFlag::eMESH_MULTIPLE)) ? 1 : maxMaxShapeCount,
-			subHits, shrunkDistance);
+			(cachedShapeGeom.getType() == PxGeometryType::eTRIANGLEMESH && !(mHitFlags & PxHitFlag::eMESH_MULTIPLE)) ? 1 : mMaxSubHits,
+			mSubHits, mShrunkDistance);
+
+		const bool noBlock = (filterFlags & PxQueryFlag::eNO_BLOCK);
 
 		// iterate over geometry subhits
 		for(PxU32 iSubHit = 0; iSubHit < nbSubHits; iSubHit++)
 		{
-			HitType& hit = subHits[iSubHit];
+			HitType& hit = mSubHits[iSubHit];
 			hit.actor = as->actor;
 			hit.shape = as->shape;
 			makeHitSafe<HitType>(hit);
@@ -667,21 +711,23 @@ bool NpVolumeCache::multiQuery(
 			// some additional processing only for sweep hits with initial overlap
 			if(HitTypeSupport<HitType>::IsSweep && HITDIST(hit) == 0.0f)
 				// PT: necessary as some leaf routines are called with reversed params, thus writing +unitDir there.
-				reinterpret_cast<PxSweepHit&>(hit).normal = -input.getDir();
+				reinterpret_cast<PxSweepHit&>(hit).normal = -mInput.getDir();
 
 			// start out with hitType for this cached shape set to a pre-filtered hit type
 			PxQueryHitType::Enum hitType = shapeHitType;
 
 			// run the post-filter if specified in filterFlags and filterCall is non-NULL
-			if(filterCall && (filterFlags & PxQueryFlag::ePOSTFILTER))
-				hitType = filterCall->postFilter(filterData.data, hit);
+			if(mFilterCall && (filterFlags & PxQueryFlag::ePOSTFILTER))
+				hitType = mFilterCall->postFilter(mFilterData.data, hit);
 
 			// -------------------------- handle eANY_HIT hits ---------------------------------
 			if(filterFlags & PxQueryFlag::eANY_HIT && hitType != PxQueryHitType::eNONE)
 			{
-				hitCall.block = hit;
-				hitCall.finalizeQuery();
-				return (hitCall.hasBlock = true);
+				mHitCall.block = hit;
+				mHitCall.finalizeQuery();
+				mResult = mHitCall.hasBlock = true;
+				mDone = true;
+				return false;
 			}
 
 			if(noBlock)
@@ -691,38 +737,40 @@ bool NpVolumeCache::multiQuery(
 			{
 				// -------------------------- handle eTOUCH hits ---------------------------------
 				// for MULTIPLE hits (hitCall.touches != NULL), store the hit. For other qTypes ignore it.
-				if(hitCall.maxNbTouches && HITDIST(hit) <= shrunkDistance)
+				if(mHitCall.maxNbTouches && HITDIST(hit) <= mShrunkDistance)
 				{
 					// Buffer full: need to find the closest blocking hit, clip touch hits and flush the buffer
-					if(hitCall.nbTouches == hitCall.maxNbTouches)
+					if(mHitCall.nbTouches == mHitCall.maxNbTouches)
 					{
 						// issue a second nested query just looking for the closest blocking hit
 						// could do better perf-wise by saving traversal state (start looking for blocking from this point)
 						// but this is not a perf critical case because users can provide a bigger buffer
 						// that covers non-degenerate cases
 						PxHitBuffer<HitType> buf1;
-						if(multiQuery<HitType>(input, buf1, hitFlags, filterData, filterCall, inflation))
+						if(mCache.multiQuery<HitType>(mInput, buf1, mHitFlags, mFilterData, mFilterCall, mInflation))
 						{
-							hitCall.block = buf1.block;
-							hitCall.hasBlock = true;
-							hitCall.nbTouches =
-								clipHitsToNewMaxDist<HitType>(hitCall.touches, hitCall.nbTouches, HITDIST(buf1.block));
+							mHitCall.block = buf1.block;
+							mHitCall.hasBlock = true;
+							mHitCall.nbTouches =
+								clipHitsToNewMaxDist<HitType>(mHitCall.touches, mHitCall.nbTouches, HITDIST(buf1.block));
 						}
 
-						if(hitCall.nbTouches == hitCall.maxNbTouches)
+						if(mHitCall.nbTouches == mHitCall.maxNbTouches)
 						{
-							PxAgain again = hitCall.processTouches(hitCall.touches, hitCall.maxNbTouches);
+							PxAgain again = mHitCall.processTouches(mHitCall.touches, mHitCall.maxNbTouches);
 							if(!again) // early exit opportunity
 							{
-								hitCall.finalizeQuery();
-								return hitCall.hasBlock;
+								mHitCall.finalizeQuery();
+								mResult = mHitCall.hasBlock;
+								mDone = true;
+								return false;
 							} else
-								hitCall.nbTouches = 0; // reset nbTouches so we can continue accumulating again
+								mHitCall.nbTouches = 0; // reset nbTouches so we can continue accumulating again
 						}
 
 					} // if(hitCall.nbTouches == hitCall.maxNbTouches)
 
-					hitCall.touches[hitCall.nbTouches++] = hit;
+					mHitCall.touches[mHitCall.nbTouches++] = hit;
 				} // if(hitCall.maxNbTouches && hit.dist <= shrunkDist)
 			}
 			else if(hitType == PxQueryHitType::eBLOCK)
@@ -731,18 +779,153 @@ bool NpVolumeCache::multiQuery(
 				// former SINGLE and MULTIPLE cases => update blocking hit distance
 				// only eBLOCK qualifies as a closest hit candidate for "single" query
 				// => compare against the best distance and store
-				if(HITDIST(hit) <= shrunkDistance)
+				if(HITDIST(hit) <= mShrunkDistance)
 				{
-					shrunkDistance = HITDIST(hit);
-					hitCall.block = hit;
-					hitCall.hasBlock = true;
+					mShrunkDistance = HITDIST(hit);
+					mHitCall.block = hit;
+					mHitCall.hasBlock = true;
 				}
 			} else
 			{
 				PX_ASSERT(hitType == PxQueryHitType::eNONE);
 			}
 		} // for iSubHit
-	} // for isDynamic, for iCachedShape
+		return true;
+	}
+
+	// local tree payloads hold the shape and actor of a cache entry
+	virtual PxAgain invoke(PxReal& distance, const PrunerPayload& payload)
+	{
+		PxActorShape as;
+		as.shape = reinterpret_cast<PxShape*>(payload.data[0]);
+		as.actor = reinterpret_cast<PxRigidActor*>(payload.data[1]);
+		const PxAgain again = processShape(&as);
+
+		// lets the traversal skip the nodes beyond the closest blocking hit
+		if(HitTypeSupport<HitType>::IsOverlap == 0)
+			distance = PxMin(distance, mShrunkDistance);
+		return again;
+	}
+
+private:
+	VolumeCacheQueryCallback<HitType>& operator=(const VolumeCacheQueryCallback<HitType>&);
+};
+
+//========================================================================================================================
+template<typename HitType>
+bool NpVolumeCache::multiQuery(
+	const MultiQueryInput& input, PxHitCallback<HitType>& hitCall, PxHitFlags hitFlags,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxF32 inflation) const
+{
+
+	if(HitTypeSupport<HitType>::IsRaycast == 0)
+	{
+		PX_CHECK_AND_RETURN_VAL(input.pose->isValid(), "sweepInputCheck: pose is not valid.", 0);
+	}
+	if(HitTypeSupport<HitType>::IsOverlap == 0)
+	{
+		PX_CHECK_AND_RETURN_VAL(input.getDir().isFinite(), "PxVolumeCache multiQuery input check: unitDir is not valid.", 0);
+		PX_CHECK_AND_RETURN_VAL(input.getDir().isNormalized(), "PxVolumeCache multiQuery input check: direction must be normalized", 0);
+	}
+	if(HitTypeSupport<HitType>::IsRaycast)
+	{
+		PX_CHECK_AND_RETURN_VAL(input.maxDistance > 0.0f, "PxVolumeCache multiQuery input check: distance cannot be negative or zero", 0);
+	}
+	if(HitTypeSupport<HitType>::IsSweep)
+	{
+		PX_CHECK_AND_RETURN_VAL(input.maxDistance >= 0.0f, "NpSceneQueries multiQuery input check: distance cannot be negative", 0);
+		PX_CHECK_AND_RETURN_VAL(input.maxDistance != 0.0f || !(hitFlags & PxHitFlag::eASSUME_NO_INITIAL_OVERLAP),
+			"PxVolumeCache multiQuery input check: zero-length sweep only valid without the PxHitFlag::eASSUME_NO_INITIAL_OVERLAP flag", 0);
+	}
+
+	hitCall.hasBlock = false;
+	hitCall.nbTouches = 0;
+
+	const PxQueryFlags filterFlags = filterData.flags;
+
+	// refill the cache if invalid
+	for(PxU32 isDynamic = 0; isDynamic <= 1; isDynamic++)
+	{
+		if(!isValid(isDynamic) && ((isDynamic+1) & PxU32(filterFlags)) != 0) // isDynamic+1 = 1 for static, 2 for dynamic
+			// check for overflow or unspecified cache volume&transform, fall back to scene query on overflow (or invalid voltype)
+			if(const_cast<NpVolumeCache*>(this)->fillInternal(isDynamic) == FILL_OVER_MAX_COUNT
+				|| mCacheVolume.getType() == PxGeometryType::eINVALID)
+			{
+				// fall back to full scene query with input flags if we blow the cache on either static or dynamic for now
+				if(mCacheVolume.getType() == PxGeometryType::eINVALID)
+					Ps::getFoundation().error(PxErrorCode::ePERF_WARNING, __FILE__, __LINE__,
+						"PxVolumeCache: unspecified volume geometry. Reverting to uncached scene query.");
+				return SceneQueryAny<HitType>::doQuery(
+					getNpScene(mSQManager), input, hitCall, hitFlags, filterData, filterCall);
+			}
+	}
+
+	// cache is now valid and there was no overflow
+	PX_ASSERT_WITH_MESSAGE(isValid() ,"PxVolumeCache became invalid inside of a scene read call.");
+
+	const PxU32 cacheSize[2] = { mCache[0].size(), mCache[1].size() };
+
+	// early out if the cache is empty and valid
+	if(cacheSize[0] == 0 && cacheSize[1] == 0)
+		return 0;
+
+	const NpScene& scene = *getNpScene(mSQManager);
+	HitType* subHits = NULL;
+
+	// make sure to deallocate the temp buffer when we return
+	struct FreeSubhits
+	{
+		HitType* toFree;
+		PX_FORCE_INLINE FreeSubhits() { toFree = NULL; }
+		PX_FORCE_INLINE ~FreeSubhits() { if (toFree) physx::shdfnd::TempAllocator().deallocate(toFree); }
+	} ds;
+
+	// allocate from temp storage rather than from the stack if we are over some shape count
+	PxU32 maxMaxShapeCount = PxMax(mMaxShapeCount[0], mMaxShapeCount[1]); // max size buffer for statics and dynamics
+	if(maxMaxShapeCount < 128) // somewhat arbitrary
+		subHits = reinterpret_cast<HitType*>(PxAlloca(sizeof(HitType)*maxMaxShapeCount));
+	else
+		ds.toFree = subHits = reinterpret_cast<HitType*>(physx::shdfnd::TempAllocator().allocate(sizeof(HitType)*maxMaxShapeCount, __FILE__, __LINE__));
+
+	VolumeCacheQueryCallback<HitType> pcb(*this, input, hitCall, hitFlags, filterData, filterCall, inflation, scene, subHits, maxMaxShapeCount);
+
+	// for statics & dynamics
+	for(PxU32 isDynamic = 0; isDynamic <= 1; isDynamic++)
+	{
+		if(mLocalHandles[isDynamic].size())
+		{
+			// only the cached shapes whose bounds the query touches reach the narrow phase
+			const Pruner* tree = mLocalTree[isDynamic];
+			if(HitTypeSupport<HitType>::IsRaycast)
+			{
+				PxReal distance = pcb.mShrunkDistance;
+				tree->raycast(input.getOrigin(), input.getDir(), distance, pcb);
+			}
+			else
+			{
+				const ShapeData sd(*input.geometry, *input.pose, inflation);
+				if(HitTypeSupport<HitType>::IsOverlap)
+					tree->overlap(sd, pcb);
+				else
+				{
+					PxReal distance = pcb.mShrunkDistance;
+					tree->sweep(sd, input.getDir(), distance, pcb);
+				}
+			}
+		}
+		else
+		{
+			// iterate over all the cached shapes
+			for(PxU32 iCachedShape = 0; iCachedShape < cacheSize[isDynamic]; iCachedShape++)
+			{
+				if(!pcb.processShape(&mCache[isDynamic][iCachedShape]))
+					break;
+			}
+		}
+
+		if(pcb.mDone)
+			return pcb.mResult;
+	}
 
 	// clip any unreported touch hits to block.distance and report via callback
 	if(hitCall.hasBlock && hitCall.nbTouches)
@@ -801,6 +984,11 @@ bool NpVolumeCache::overlap(
 void NpVolumeCache::onOriginShift(const PxVec3& shift)
 {
 	mCachePose.p -= shift;
+	for(PxU32 i=0;i<2;i++)
+	{
+		if(mLocalTree[i])
+			mLocalTree[i]->shiftOrigin(shift);
+	}
 }
 
 } // namespace physx
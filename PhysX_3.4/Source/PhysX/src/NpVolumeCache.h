@@ -41,7 +41,7 @@ namespace physx
 
 	struct MultiQueryInput;
 
-namespace Sq { class SceneQueryManager; }
+namespace Sq { class SceneQueryManager; class Pruner; }
 
 
 // internal implementation for PxVolumeCache
@@ -95,6 +95,10 @@ public:
 
 					void			onOriginShift(const PxVec3& shift);
 
+					// local tree over the cached shapes, used by the cached queries once there are enough of them
+					void			updateLocalTree(PxU32 isDynamic, bool sameShapes);
+					void			clearLocalTree(PxU32 isDynamic);
+
 
 	PxGeometryHolder				mCacheVolume;
 	PxTransform						mCachePose;
@@ -104,6 +108,8 @@ public:
 	PxU32							mStaticTimestamp;
 	PxU32							mDynamicTimestamp;
 	bool							mIsInvalid[2]; // invalid for reasons other than timestamp, such as overflow on previous fill
+	Sq::Pruner*						mLocalTree[2]; // created on first use, payloads store the PxActorShape of mCache
+	Ps::Array<PxU32>				mLocalHandles[2]; // handles of the mCache entries in mLocalTree, empty when the tree is not used
 };
 
 }
@@ -43,6 +43,15 @@ using namespace physx::shdfnd;
 typedef HashSet<const PxRigidActor*> OwnerActorsValueType;
 typedef HashMap<const PxShape*, OwnerActorsValueType*> OwnerActorsMap;
 
+// state of an actor as it was last sent by updateDynamicActorsAndArticulations
+struct SentActorState
+{
+	PxTransform	mPose;
+	PxVec3		mLinearVelocity;
+	PxVec3		mAngularVelocity;
+};
+typedef HashMap<const PxActor*, SentActorState> SentActorStateMap;
+
 struct PvdMetaDataBindingData : public UserAllocated
 {
 	Array<PxU8> mTempU8Array;
@@ -51,6 +60,8 @@ struct PvdMetaDataBindingData : public UserAllocated
 	Array<PxArticulationLink*> mArticulationLinks;
 	HashSet<PxActor*> mSleepingActors;
 	OwnerActorsMap mOwnerActorsMap;
+	SentActorStateMap mSentActorStates;
+	PxReal mActorUpdateThreshold;
 
 	PvdMetaDataBindingData()
 	: mTempU8Array(PX_DEBUG_EXP("TempU8Array"))
@@ -58,6 +69,7 @@ struct PvdMetaDataBindingData : public UserAllocated
 	, mArticulations(PX_DEBUG_EXP("Articulations"))
 	, mArticulationLinks(PX_DEBUG_EXP("ArticulationLinks"))
 	, mSleepingActors(PX_DEBUG_EXP("SleepingActors"))
+	, mActorUpdateThreshold(0.0f)
 	{
 	}
 
@@ -218,6 +218,16 @@ static PX_FORCE_INLINE void registerPvdOverlap(PvdDataStream& inStream)
 	inStream.createProperty<PvdOverlap, PxU32>("hits_count");
 }
 
+static PX_FORCE_INLINE void registerPvdSqSummary(PvdDataStream& inStream)
+{
+	inStream.createClass<PvdSqSummary>();
+	definePropertyEnums<PvdSqSummary, SceneQueryIDConvertor, NameValuePair>(inStream, "type");
+	inStream.createProperty<PvdSqSummary, PxU32>("nbQueries");
+	inStream.createProperty<PvdSqSummary, PxU32>("nbHits");
+	inStream.createProperty<PvdSqSummary, PxF32>("totalTime");
+	inStream.createProperty<PvdSqSummary, PxF32>("maxTime");
+}
+
 static PX_FORCE_INLINE void registerPvdSqHit(PvdDataStream& inStream)
 {
 	inStream.createClass<PvdSqHit>();
@@ -309,6 +319,7 @@ void PvdMetaDataBinding::registerSDKProperties(PvdDataStream& inStream)
 		registerPvdRaycast(inStream);
 		registerPvdSweep(inStream);
 		registerPvdOverlap(inStream);
+		registerPvdSqSummary(inStream);
 
 		inStream.createClass<PxScene>();
 		PvdPropertyDefinitionHelper& helper(inStream.getPropertyDefinitionHelper());
@@ -331,6 +342,7 @@ void PvdMetaDataBinding::registerSDKProperties(PvdDataStream& inStream)
 		inStream.createProperty<PxScene, PxTransform>("SceneQueries.PoseList", "", PropertyType::Array);
 		inStream.createProperty<PxScene, PxFilterData>("SceneQueries.FilterDataList", "", PropertyType::Array);
 		inStream.createProperty<PxScene, ObjectRef>("SceneQueries.GeometryList", "", PropertyType::Array);
+		inStream.createProperty<PxScene, PvdSqSummary>("SceneQueries.Summary", "", PropertyType::Array);
 
 		inStream.createProperty<PxScene, PvdOverlap>("BatchedQueries.Overlaps", "", PropertyType::Array);
 		inStream.createProperty<PxScene, PvdSweep>("BatchedQueries.Sweeps", "", PropertyType::Array);
@@ -339,6 +351,7 @@ void PvdMetaDataBinding::registerSDKProperties(PvdDataStream& inStream)
 		inStream.createProperty<PxScene, PxTransform>("BatchedQueries.PoseList", "", PropertyType::Array);
 		inStream.createProperty<PxScene, PxFilterData>("BatchedQueries.FilterDataList", "", PropertyType::Array);
 		inStream.createProperty<PxScene, ObjectRef>("BatchedQueries.GeometryList", "", PropertyType::Array);
+		inStream.createProperty<PxScene, PvdSqSummary>("BatchedQueries.Summary", "", PropertyType::Array);
 
 		inStream.createProperty<PxScene, ObjectRef>("RigidStatics", "children", PropertyType::Array);
 		inStream.createProperty<PxScene, ObjectRef>("RigidDynamics", "children", PropertyType::Array);
@@ -611,6 +624,9 @@ void PvdMetaDataBinding::sendAllProperties(PvdDataStream& inStream, const PxPhys
 
 void PvdMetaDataBinding::sendAllProperties(PvdDataStream& inStream, const PxScene& inScene)
 {
+	// a new connection starts from the full state of the actors
+	mBindingData->mSentActorStates.clear();
+
 	PxPhysics& physics(const_cast<PxScene&>(inScene).getPhysics());
 	PxTolerancesScale theScale;
 	PxSceneDesc theDesc(theScale);
@@ -1226,6 +1242,7 @@ void PvdMetaDataBinding::sendAllProperties(PvdDataStream& inStream, const PxRigi
 }
 void PvdMetaDataBinding::destroyInstance(PvdDataStream& inStream, const PxRigidDynamic& inObj, const PxScene& ownerScene)
 {
+	mBindingData->mSentActorStates.erase(&inObj);
 	releaseShapes(*this, inStream, inObj);
 	removeSceneGroupProperty(inStream, "RigidDynamics", inObj, ownerScene);
 }
@@ -1305,6 +1322,7 @@ void PvdMetaDataBinding::sendAllProperties(PvdDataStream& inStream, const PxArti
 
 void PvdMetaDataBinding::destroyInstance(PvdDataStream& inStream, const PxArticulationLink& inObj)
 {
+	mBindingData->mSentActorStates.erase(&inObj);
 	PxArticulationJoint* joint(inObj.getInboundJoint());
 	if(joint)
 		inStream.destroyInstance(joint);
@@ -1460,12 +1478,27 @@ void PvdMetaDataBinding::destroyInstance(PvdDataStream& inStream, const PxPartic
 }
 #endif // PX_USE_PARTICLE_SYSTEM_API
 
+static PX_FORCE_INLINE bool movedMoreThan(const PxVec3& a, const PxVec3& b, PxReal threshold)
+{
+	return PxAbs(a.x - b.x) > threshold || PxAbs(a.y - b.y) > threshold || PxAbs(a.z - b.z) > threshold;
+}
+
+static PX_FORCE_INLINE bool movedMoreThan(const SentActorState& state, const PxTransform& pose, const PxVec3& linVel, const PxVec3& angVel, PxReal threshold)
+{
+	const PxQuat& q0 = state.mPose.q;
+	const PxQuat& q1 = pose.q;
+	return	movedMoreThan(state.mPose.p, pose.p, threshold) || movedMoreThan(state.mLinearVelocity, linVel, threshold) ||
+			movedMoreThan(state.mAngularVelocity, angVel, threshold) || movedMoreThan(PxVec3(q0.x, q0.y, q0.z), PxVec3(q1.x, q1.y, q1.z), threshold) ||
+			PxAbs(q0.w - q1.w) > threshold;
+}
+
 template <typename TBlockType, typename TActorType, typename TOperator>
 static void updateActor(PvdDataStream& inStream, TActorType** actorGroup, PxU32 numActors, TOperator sleepingOp, PvdMetaDataBindingData& bindingData)
 {
 	TBlockType theBlock;
 	if(numActors == 0)
 		return;
+	const PxReal threshold = bindingData.mActorUpdateThreshold;
 	for(PxU32 idx = 0; idx < numActors; ++idx)
 	{
 		TActorType* theActor(actorGroup[idx]);
@@ -1477,6 +1510,16 @@ static void updateActor(PvdDataStream& inStream, TActorType** actorGroup, PxU32
 			theBlock.GlobalPose = theActor->getGlobalPose();
 			theBlock.AngularVelocity = theActor->getAngularVelocity();
 			theBlock.LinearVelocity = theActor->getLinearVelocity();
+
+			// awake actors which did not move since they were last sent are skipped, PVD keeps their last values
+			const SentActorStateMap::Entry* entry = bindingData.mSentActorStates.find(theActor);
+			if(entry && sleeping == wasSleeping && !movedMoreThan(entry->second, theBlock.GlobalPose, theBlock.LinearVelocity, theBlock.AngularVelocity, threshold))
+				continue;
+			SentActorState& state = bindingData.mSentActorStates[theActor];
+			state.mPose = theBlock.GlobalPose;
+			state.mLinearVelocity = theBlock.LinearVelocity;
+			state.mAngularVelocity = theBlock.AngularVelocity;
+
 			inStream.sendPropertyMessageFromGroup(theActor, theBlock);
 			if(sleeping != wasSleeping)
 			{
@@ -1511,6 +1554,17 @@ struct ArticulationLinkUpdateOp
 	}
 };
 
+void PvdMetaDataBinding::setActorUpdateThreshold(PxReal threshold)
+{
+	PX_CHECK_AND_RETURN(threshold >= 0.0f, "PxPvdSceneClient::setActorUpdateThreshold: threshold must not be negative.");
+	mBindingData->mActorUpdateThreshold = threshold;
+}
+
+PxReal PvdMetaDataBinding::getActorUpdateThreshold() const
+{
+	return mBindingData->mActorUpdateThreshold;
+}
+
 void PvdMetaDataBinding::updateDynamicActorsAndArticulations(PvdDataStream& inStream, const PxScene* inScene, PvdVisualizer* linkJointViz)
 {
 	PX_COMPILE_TIME_ASSERT(sizeof(PxRigidDynamicUpdateBlock) == 14 * 4);
@@ -2410,6 +2464,9 @@ void PvdMetaDataBinding::sendSceneQueries(PvdDataStream& inStream, const PxScene
 
 		propName = collector.getArrayName(collector.mAccumulatedSweepQueries);
 		sendSceneArray(inStream, inScene, collector.mAccumulatedSweepQueries, propName);
+
+		propName = collector.getArrayName(collector.mSummaries);
+		sendSceneArray(inStream, inScene, collector.mSummaries, propName);
 	}
 }
 }
@@ -132,6 +132,8 @@ class PvdMetaDataBinding
 
 	// per frame update
 	void updateDynamicActorsAndArticulations(PvdDataStream& inStream, const PxScene* inScene, PvdVisualizer* linkJointViz);
+	void setActorUpdateThreshold(PxReal threshold);
+	PxReal getActorUpdateThreshold() const;
 
 	// Origin Shift
 	void originShift(PvdDataStream& inStream, const PxScene* inScene, PxVec3 shift);
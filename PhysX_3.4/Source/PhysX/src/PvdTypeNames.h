@@ -42,6 +42,7 @@ struct PvdSqHit;
 struct PvdRaycast;
 struct PvdOverlap;
 struct PvdSweep;
+struct PvdSqSummary;
 
 struct PvdHullPolygonData
 {
@@ -173,6 +174,7 @@ DEFINE_NATIVE_PVD_TYPE_MAP(PvdRaycast)
 DEFINE_NATIVE_PVD_TYPE_MAP(PvdSweep)
 DEFINE_NATIVE_PVD_TYPE_MAP(PvdOverlap)
 DEFINE_NATIVE_PVD_TYPE_MAP(PvdSqHit)
+DEFINE_NATIVE_PVD_TYPE_MAP(PvdSqSummary)
 DEFINE_NATIVE_PVD_TYPE_MAP(PvdPositionAndRadius)
 
 #undef DEFINE_NATIVE_PVD_TYPE_MAP
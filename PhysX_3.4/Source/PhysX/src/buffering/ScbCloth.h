@@ -171,6 +171,9 @@ public:
 	PX_INLINE PxReal					getSolverFrequency() const;
 	PX_INLINE void						setSolverFrequency(PxReal);
 
+	PX_INLINE PxReal					getLodFactor() const;
+	PX_INLINE void						setLodFactor(PxReal);
+
 	PX_INLINE PxReal					getStiffnessFrequency() const;
 	PX_INLINE void						setStiffnessFrequency(PxReal);
 
@@ -856,6 +859,25 @@ PX_INLINE void Cloth::setSolverFrequency(PxReal solverFreq)
 		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "Call to PxCloth::setSolverFrequency() not allowed while simulation is running.");
 }
 
+PX_INLINE PxReal Cloth::getLodFactor() const
+{
+	if(!isBuffering())
+		return mCloth.getLodFactor();
+	else
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "Call to PxCloth::getLodFactor() not allowed while simulation is running.");
+		return 1.0f;
+	}
+}
+
+PX_INLINE void Cloth::setLodFactor(PxReal factor)
+{
+	if(!isBuffering())
+		mCloth.setLodFactor(factor);
+	else
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "Call to PxCloth::setLodFactor() not allowed while simulation is running.");
+}
+
 PX_INLINE PxReal Cloth::getStiffnessFrequency() const
 {
 	if(!isBuffering())
@@ -42,6 +42,7 @@
 
 #include "PsFoundation.h"
 #include "PxArticulation.h"
+#include "CmTask.h"
 
 namespace physx
 {
@@ -1016,6 +1017,32 @@ void Scb::Scene::syncWriteThroughProperties()
 	mStream.unlock();
 }
 
+namespace
+{
+	// number of active bodies synced by each job of the parallel sync, see PxSceneFlag::eENABLE_PARALLEL_STATE_SYNC
+	const PxU32 gNbBodiesPerSyncJob = 1024;
+
+	// writes the simulation results back to the buffered state of the active bodies without user updates. Each body
+	// only touches its own data in that case, user updates call into the simulation controller and are synced serially.
+	struct SyncActiveBodiesJob
+	{
+		Sc::BodyCore*const*	mBodies;
+		PxU32				mNbBodies;
+
+		void operator()(PxU32 index)
+		{
+			const PxU32 start = index*gNbBodiesPerSyncJob;
+			const PxU32 end = PxMin(start + gNbBodiesPerSyncJob, mNbBodies);
+			for(PxU32 i=start;i<end;i++)
+			{
+				Scb::Body& bufferedBody = Scb::Body::fromSc(*mBodies[i]);
+				if(!(bufferedBody.getControlFlags() & Scb::ControlFlag::eIS_UPDATED))  // Else the data will be synced further below
+					bufferedBody.syncState();
+			}
+		}
+	};
+}
+
 void Scb::Scene::syncEntireScene()
 {
 	PX_PROFILE_ZONE("Sim.syncState", getContextId());
@@ -1058,15 +1085,13 @@ void Scb::Scene::syncEntireScene()
 	//
 	// 1) Sync simulation changed data
 	{
-		Sc::BodyCore*const* activeBodies = mScene.getActiveBodiesArray();
-		PxU32 nbActiveBodies = mScene.getNumActiveBodies();
-		while(nbActiveBodies--)
-		{
-			Sc::BodyCore* bodyCore = *activeBodies++;
-			Scb::Body& bufferedBody = Scb::Body::fromSc(*bodyCore);
-			if (!(bufferedBody.getControlFlags() & ControlFlag::eIS_UPDATED))  // Else the data will be synced further below
-				bufferedBody.syncState();
-		}
+		SyncActiveBodiesJob job;
+		job.mBodies = mScene.getActiveBodiesArray();
+		job.mNbBodies = mScene.getNumActiveBodies();
+
+		const PxU32 nbJobs = (job.mNbBodies + gNbBodiesPerSyncJob - 1)/gNbBodiesPerSyncJob;
+		PxCpuDispatcher* dispatcher = (mScene.getPublicFlags() & PxSceneFlag::eENABLE_PARALLEL_STATE_SYNC) ? mScene.getTaskManager().getCpuDispatcher() : NULL;
+		Cm::runParallelJobs(dispatcher, nbJobs, job);
 	}
 
 	// 2) Sync data of rigid dynamics which were put to sleep by the simulation
@@ -1373,6 +1398,15 @@ bool Scb::Scene::removeBroadPhaseRegion(PxU32 handle)
 	return false;
 }
 
+bool Scb::Scene::setBroadPhaseAutoRegions(const PxBounds3& worldBounds, PxU32 maxNbObjectsPerRegion)
+{
+	if(!isPhysicsBuffering())
+		return mScene.setBroadPhaseAutoRegions(worldBounds, maxNbObjectsPerRegion);
+	else
+		Ps::getFoundation().error(PxErrorCode::eDEBUG_WARNING, __FILE__, __LINE__, "PxScene::setBroadPhaseAutoRegions() not allowed while simulation is running. Call will be ignored.");
+	return false;
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 //
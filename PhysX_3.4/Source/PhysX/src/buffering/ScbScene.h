@@ -239,6 +239,7 @@ namespace Scb
 					PxU32					getBroadPhaseRegions(PxBroadPhaseRegionInfo* userBuffer, PxU32 bufferSize, PxU32 startIndex)	const;
 					PxU32					addBroadPhaseRegion(const PxBroadPhaseRegion& region, bool populateRegion);
 					bool					removeBroadPhaseRegion(PxU32 handle);
+					bool					setBroadPhaseAutoRegions(const PxBounds3& worldBounds, PxU32 maxNbObjectsPerRegion);
 
 		// Collision filtering
 		PX_INLINE void						setFilterShaderData(const void* data, PxU32 dataSize);
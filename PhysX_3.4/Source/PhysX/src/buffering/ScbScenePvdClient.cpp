@@ -356,6 +356,12 @@ void ScbScenePvdClient::setScenePvdFlag(PxPvdSceneFlag::Enum flag, bool value)
 		mFlags &= ~flag;
 }
 
+void ScbScenePvdClient::setSceneQueryCapture(const PxPvdSceneQueryCaptureDesc& desc)
+{
+	PX_CHECK_AND_RETURN(PxU32(desc.mode) <= PxPvdSceneQueryCaptureMode::eSUMMARY, "PxPvdSceneClient::setSceneQueryCapture: invalid capture mode.");
+	mSceneQueryCapture = desc;
+}
+
 void ScbScenePvdClient::onPvdConnected()
 {
 	if(mIsConnected || !mPvd)
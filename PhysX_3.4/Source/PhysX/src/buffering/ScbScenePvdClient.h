@@ -91,6 +91,10 @@ class ScbScenePvdClient : public PxPvdSceneClient, public PvdClient, public PvdV
 	virtual	void			setScenePvdFlag(PxPvdSceneFlag::Enum flag, bool value);
 	virtual	void			setScenePvdFlags(PxPvdSceneFlags flags)				{ mFlags = flags;	}
 	virtual	PxPvdSceneFlags	getScenePvdFlags()							const	{ return mFlags;	}
+	virtual	void			setActorUpdateThreshold(PxReal threshold)			{ mMetaDataBinding.setActorUpdateThreshold(threshold);	}
+	virtual	PxReal			getActorUpdateThreshold()					const	{ return mMetaDataBinding.getActorUpdateThreshold();	}
+	virtual	void			setSceneQueryCapture(const PxPvdSceneQueryCaptureDesc& desc);
+	virtual	PxPvdSceneQueryCaptureDesc	getSceneQueryCapture()			const	{ return mSceneQueryCapture;	}
 	virtual	void			updateCamera(const char* name, const PxVec3& origin, const PxVec3& up, const PxVec3& target);
 	virtual	void			drawPoints(const PvdDebugPoint* points, PxU32 count);
 	virtual	void			drawLines(const PvdDebugLine* lines, PxU32 count);
@@ -115,6 +119,7 @@ class ScbScenePvdClient : public PxPvdSceneClient, public PvdClient, public PvdV
 	}
 
 	PX_FORCE_INLINE	PxPvdSceneFlags	getScenePvdFlagsFast() const	{ return mFlags;	}
+	PX_FORCE_INLINE	const PxPvdSceneQueryCaptureDesc&	getSceneQueryCaptureFast() const	{ return mSceneQueryCapture;	}
 	PX_FORCE_INLINE	void             setPsPvd(PsPvd* pvd)			{ mPvd = pvd;		}
 
 	void frameStart(PxReal simulateElapsedTime);
@@ -204,6 +209,7 @@ class ScbScenePvdClient : public PxPvdSceneClient, public PvdClient, public PvdV
 	void				setCreateContactReports(bool b);
 
 	PxPvdSceneFlags			mFlags;
+	PxPvdSceneQueryCaptureDesc	mSceneQueryCapture;
 	PsPvd*					mPvd;
 	Scb::Scene&				mScbScene;
 	
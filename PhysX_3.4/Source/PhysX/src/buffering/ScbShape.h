@@ -119,6 +119,7 @@ public:
 	PX_INLINE	const PxGeometry&		getGeometry() const;
 	PX_INLINE	const Gu::GeometryUnion&getGeometryUnion() const;
 	PX_INLINE	Scb::ShapeBuffer*		setGeometry(const PxGeometry& geom);
+	PX_INLINE	void					onGeometryRegionChange(const PxBounds3& localRegion);
 
 	PX_INLINE	PxU16					getNbMaterials() const;
 	PX_INLINE	PxMaterial*				getMaterial(PxU32 index) const;
@@ -292,6 +293,23 @@ PX_INLINE Scb::ShapeBuffer* Shape::setGeometry(const PxGeometry& geom)
 	return shapeBuffer;
 }
 
+PX_INLINE void Shape::onGeometryRegionChange(const PxBounds3& localRegion)
+{
+	if (!isBuffering())
+	{
+		Sc::RigidCore* rigidCore = NpShapeGetScRigidObjectFromScbSLOW(*this);
+		if(rigidCore)
+			rigidCore->onShapeRegionChange(mShape, localRegion);
+	}
+	else
+	{
+		// buffered updates cannot be region limited, the shape is refreshed as with a geometry change
+		if(!isBuffered(Buf::BF_Geometry))
+			getBufferedData()->geometry.set(mShape.getGeometry());
+		markUpdated(Buf::BF_Geometry);
+	}
+}
+
 PX_INLINE PxU16 Shape::getNbMaterials() const
 {
 	if(isBuffered(Buf::BF_Material))
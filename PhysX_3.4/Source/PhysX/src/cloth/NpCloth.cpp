@@ -740,6 +740,22 @@ PxReal NpCloth::getSolverFrequency() const
 	return mCloth.getSolverFrequency();
 }
 
+void NpCloth::setLodFactor(PxReal factor)
+{
+	NP_WRITE_CHECK(NpActor::getOwnerScene(*this));
+
+	PX_CHECK_AND_RETURN(factor >= 0.0f, "PxCloth::setLodFactor: level of detail factor must not be negative!");
+
+	mCloth.setLodFactor(factor);
+}
+
+PxReal NpCloth::getLodFactor() const
+{
+	NP_READ_CHECK(NpActor::getOwnerScene(*this));
+
+	return mCloth.getLodFactor();
+}
+
 void NpCloth::setStiffnessFrequency(PxReal frequency)
 {
 	NP_WRITE_CHECK(NpActor::getOwnerScene(*this));
@@ -178,6 +178,9 @@ public:
 	virtual		void				setSolverFrequency(PxReal);
 	virtual		PxReal				getSolverFrequency() const;
 
+	virtual		void				setLodFactor(PxReal);
+	virtual		PxReal				getLodFactor() const;
+
 	virtual		void				setStiffnessFrequency(PxReal);
 	virtual		PxReal				getStiffnessFrequency() const;
 
@@ -1120,6 +1120,88 @@ static PxBounds3 getBounds3(const PxExtendedBounds3& extended)
 	return PxBounds3(toVec3(extended.minimum), toVec3(extended.maximum));	// LOSS OF ACCURACY
 }
 
+static void outputUserBox(IntArray& geomStream, const PxExtendedBox& box, const void* userData, const PxExtendedVec3& origin, const PxBounds3& singlePrecisionWorldBox)
+{
+	const Gu::Box obb(
+		toVec3(box.center),	// LOSS OF ACCURACY
+		box.extents,
+		PxMat33(box.rot));	// #### PT: TODO: useless conversion here
+
+	if(!Gu::intersectOBBAABB(obb, singlePrecisionWorldBox))
+		return;
+
+	TouchedUserBox* UserBox = reinterpret_cast<TouchedUserBox*>(reserveContainerMemory(geomStream, sizeof(TouchedUserBox)/sizeof(PxU32)));
+	UserBox->mType			= TouchedGeomType::eUSER_BOX;
+	UserBox->mTGUserData	= userData;
+	UserBox->mActor			= NULL;
+	UserBox->mOffset		= origin;
+	UserBox->mBox			= box;
+}
+
+static void outputUserCapsule(IntArray& geomStream, const PxExtendedCapsule& capsule, const void* userData, const PxExtendedVec3& origin, const PxExtendedBounds3& worldBox)
+{
+	// PT: do a quick AABB check first, to avoid calling the SDK too much
+	const PxF32 r = capsule.radius;
+	const PxExtended capMinx = PxMin(capsule.p0.x, capsule.p1.x);
+	const PxExtended capMaxx = PxMax(capsule.p0.x, capsule.p1.x);
+	if((capMinx - PxExtended(r) > worldBox.maximum.x) || (worldBox.minimum.x > capMaxx + PxExtended(r))) return;
+
+	const PxExtended capMiny = PxMin(capsule.p0.y, capsule.p1.y);
+	const PxExtended capMaxy = PxMax(capsule.p0.y, capsule.p1.y);
+	if((capMiny - PxExtended(r) > worldBox.maximum.y) || (worldBox.minimum.y > capMaxy + PxExtended(r))) return;
+
+	const PxExtended capMinz = PxMin(capsule.p0.z, capsule.p1.z);
+	const PxExtended capMaxz = PxMax(capsule.p0.z, capsule.p1.z);
+	if((capMinz - PxExtended(r) > worldBox.maximum.z) || (worldBox.minimum.z > capMaxz + PxExtended(r))) return;
+
+	PxExtendedVec3 Center;
+	PxVec3 Extents;
+	getCenter(worldBox, Center);
+	getExtents(worldBox, Extents);
+
+	// PT: more accurate capsule-box test. Not strictly necessary but worth doing if available
+	const PxReal d2 = Gu::distanceSegmentBoxSquared(toVec3(capsule.p0), toVec3(capsule.p1), toVec3(Center), Extents, PxMat33(PxIdentity));
+	if(d2>r*r)
+		return;
+
+	TouchedUserCapsule* UserCapsule = reinterpret_cast<TouchedUserCapsule*>(reserveContainerMemory(geomStream, sizeof(TouchedUserCapsule)/sizeof(PxU32)));
+	UserCapsule->mType			= TouchedGeomType::eUSER_CAPSULE;
+	UserCapsule->mTGUserData	= userData;
+	UserCapsule->mActor			= NULL;
+	UserCapsule->mOffset		= origin;
+	UserCapsule->mCapsule		= capsule;
+}
+
+namespace
+{
+	// Outputs the obstacles reported by findTouchedUserObstacles to the geom stream
+	class TouchedObstaclesReport : public UserObstacleReport
+	{
+		public:
+		TouchedObstaclesReport(IntArray& geomStream, const PxExtendedVec3& origin, const PxExtendedBounds3& worldBox) :
+			mGeomStream(geomStream), mOrigin(origin), mWorldBox(worldBox), mSinglePrecisionWorldBox(getBounds3(worldBox))
+		{
+		}
+
+		virtual	void	onBox(const PxExtendedBox& box, const void* userData)
+		{
+			outputUserBox(mGeomStream, box, userData, mOrigin, mSinglePrecisionWorldBox);
+		}
+
+		virtual	void	onCapsule(const PxExtendedCapsule& capsule, const void* userData)
+		{
+			outputUserCapsule(mGeomStream, capsule, userData, mOrigin, mWorldBox);
+		}
+
+		IntArray&					mGeomStream;
+		const PxExtendedVec3		mOrigin;
+		const PxExtendedBounds3&	mWorldBox;
+		const PxBounds3				mSinglePrecisionWorldBox;
+		private:
+		TouchedObstaclesReport& operator=(const TouchedObstaclesReport&);
+	};
+}
+
 // PT: finds both touched CCTs and touched user-defined obstacles
 void SweepTest::findTouchedObstacles(const UserObstacles& userObstacles, const PxExtendedBounds3& worldBox)
 {
@@ -1135,22 +1217,7 @@ void SweepTest::findTouchedObstacles(const UserObstacles& userObstacles, const P
 
 		// Find touched boxes, i.e. other box controllers
 		for(PxU32 i=0;i<nbBoxes;i++)
-		{
-			const Gu::Box obb(
-				toVec3(boxes[i].center),	// LOSS OF ACCURACY
-				boxes[i].extents,
-				PxMat33(boxes[i].rot));	// #### PT: TODO: useless conversion here
-
-			if(!Gu::intersectOBBAABB(obb, singlePrecisionWorldBox))
-				continue;
-
-			TouchedUserBox* UserBox = reinterpret_cast<TouchedUserBox*>(reserveContainerMemory(mGeomStream, sizeof(TouchedUserBox)/sizeof(PxU32)));
-			UserBox->mType			= TouchedGeomType::eUSER_BOX;
-			UserBox->mTGUserData	= boxUserData[i];
-			UserBox->mActor			= NULL;
-			UserBox->mOffset		= Origin;
-			UserBox->mBox			= boxes[i];
-		}
+			outputUserBox(mGeomStream, boxes[i], boxUserData[i], Origin, singlePrecisionWorldBox);
 	}
 
 	{
@@ -1159,39 +1226,15 @@ void SweepTest::findTouchedObstacles(const UserObstacles& userObstacles, const P
 		const PxExtendedCapsule* capsules = userObstacles.mCapsules;
 		const void** capsuleUserData = userObstacles.mCapsuleUserData;
 
-		PxExtendedVec3 Center;
-		PxVec3 Extents;
-		getCenter(worldBox, Center);
-		getExtents(worldBox, Extents);
-
 		for(PxU32 i=0;i<nbCapsules;i++)
-		{
-			// PT: do a quick AABB check first, to avoid calling the SDK too much
-			const PxF32 r = capsules[i].radius;
-			const PxExtended capMinx = PxMin(capsules[i].p0.x, capsules[i].p1.x);
-			const PxExtended capMaxx = PxMax(capsules[i].p0.x, capsules[i].p1.x);
-			if((capMinx - PxExtended(r) > worldBox.maximum.x) || (worldBox.minimum.x > capMaxx + PxExtended(r))) continue;
-
-			const PxExtended capMiny = PxMin(capsules[i].p0.y, capsules[i].p1.y);
-			const PxExtended capMaxy = PxMax(capsules[i].p0.y, capsules[i].p1.y);
-			if((capMiny - PxExtended(r) > worldBox.maximum.y) || (worldBox.minimum.y > capMaxy + PxExtended(r))) continue;
-
-			const PxExtended capMinz = PxMin(capsules[i].p0.z, capsules[i].p1.z);
-			const PxExtended capMaxz = PxMax(capsules[i].p0.z, capsules[i].p1.z);
-			if((capMinz - PxExtended(r) > worldBox.maximum.z) || (worldBox.minimum.z > capMaxz + PxExtended(r))) continue;
-
-			// PT: more accurate capsule-box test. Not strictly necessary but worth doing if available
-			const PxReal d2 = Gu::distanceSegmentBoxSquared(toVec3(capsules[i].p0), toVec3(capsules[i].p1), toVec3(Center), Extents, PxMat33(PxIdentity));
-			if(d2>r*r)
-				continue;
+			outputUserCapsule(mGeomStream, capsules[i], capsuleUserData[i], Origin, worldBox);
+	}
 
-			TouchedUserCapsule* UserCapsule = reinterpret_cast<TouchedUserCapsule*>(reserveContainerMemory(mGeomStream, sizeof(TouchedUserCapsule)/sizeof(PxU32)));
-			UserCapsule->mType			= TouchedGeomType::eUSER_CAPSULE;
-			UserCapsule->mTGUserData	= capsuleUserData[i];
-			UserCapsule->mActor			= NULL;
-			UserCapsule->mOffset		= Origin;
-			UserCapsule->mCapsule		= capsules[i];
-		}
+	// Find touched obstacles stored in the user's acceleration structure
+	if(userObstacles.mQueryData)
+	{
+		TouchedObstaclesReport report(mGeomStream, Origin, worldBox);
+		findTouchedUserObstacles(userObstacles.mQueryData, worldBox, report);
 	}
 }
 
@@ -2048,6 +2091,8 @@ void Controller::findTouchedObject(const PxControllerFilters& filters, const PxO
 		// PT: but we may need the post-filter callback as well if users want it
 		if(filters.mFilterFlags & PxQueryFlag::ePOSTFILTER)
 			filterFlags |= PxQueryFlag::ePOSTFILTER;
+		if(mManager->mSceneQuerySnapshots)
+			filterFlags |= PxQueryFlag::eSNAPSHOT;
 
 		PxQueryFilterData filterData(filters.mFilterData ? *filters.mFilterData : PxFilterData(), filterFlags);
 
@@ -2215,6 +2260,7 @@ bool Controller::rideOnTouchedObject(SweptVolume& volume, const PxVec3& upDirect
 
 PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& originalDisp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, bool constrainedClimbingMode)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eCHARACTER);
 	const bool lockWrite = mManager->mLockingEnabled;
 	if(lockWrite)
 		mWriteLock.lock();	
@@ -2222,7 +2268,8 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	mGlobalTime += PxF64(elapsedTime);
 
 	// Init CCT with per-controller settings
-	RenderBuffer* renderBuffer										= mManager->mRenderBuffer;
+	// Debug rendering is not thread-safe so it is disabled for concurrent moves
+	RenderBuffer* renderBuffer										= mManager->mBatchMove ? NULL : mManager->mRenderBuffer;
 	const PxU32 debugRenderFlags									= mManager->mDebugRenderingFlags;
 	mCctModule.mRenderBuffer										= renderBuffer;
 	mCctModule.mRenderFlags											= debugRenderFlags;
@@ -2311,10 +2358,11 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 //	printf("standingOnMoving: %d\n", standingOnMoving);
 
 	///////////
-	Ps::Array<const void*>&			boxUserData		= mManager->mBoxUserData;
-	Ps::Array<PxExtendedBox>&		boxes			= mManager->mBoxes;
-	Ps::Array<const void*>&			capsuleUserData	= mManager->mCapsuleUserData;
-	Ps::Array<PxExtendedCapsule>&	capsules		= mManager->mCapsules;
+	ObstacleBuffers&				obstacleBuffers	= mObstacleBuffers ? *mObstacleBuffers : mManager->mObstacleBuffers;
+	Ps::Array<const void*>&			boxUserData		= obstacleBuffers.mBoxUserData;
+	Ps::Array<PxExtendedBox>&		boxes			= obstacleBuffers.mBoxes;
+	Ps::Array<const void*>&			capsuleUserData	= obstacleBuffers.mCapsuleUserData;
+	Ps::Array<PxExtendedCapsule>&	capsules		= obstacleBuffers.mCapsules;
 	PX_ASSERT(!boxUserData.size());
 	PX_ASSERT(!boxes.size());
 	PX_ASSERT(!capsuleUserData.size());
@@ -2326,6 +2374,8 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 		// Experiment - to do better
 		const PxU32 nbControllers = mManager->getNbControllers();
 		Controller** controllers = mManager->getControllers();
+		// Concurrent moves use the volumes captured before any controller moved
+		const bool batchMove = mManager->mBatchMove;
 
 		for(PxU32 i=0;i<nbControllers;i++)
 		{
@@ -2342,9 +2392,16 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 				if(currentController->mType==PxControllerShapeType::eBOX)
 				{
 					// PT: TODO: optimize this
-					BoxController* BC = static_cast<BoxController*>(currentController);
 					PxExtendedBox obb;
-					BC->getOBB(obb);
+					if(batchMove)
+					{
+						obb = mManager->mBatchBoxes[i];
+					}
+					else
+					{
+						BoxController* BC = static_cast<BoxController*>(currentController);
+						BC->getOBB(obb);
+					}
 
 					boxes.pushBack(obb);
 
@@ -2364,11 +2421,17 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 				}
 				else if(currentController->mType==PxControllerShapeType::eCAPSULE)
 				{
-					CapsuleController* CC = static_cast<CapsuleController*>(currentController);
-
 					// PT: TODO: optimize this
 					PxExtendedCapsule worldCapule;
-					CC->getCapsule(worldCapule);
+					if(batchMove)
+					{
+						worldCapule = mManager->mBatchCapsules[i];
+					}
+					else
+					{
+						CapsuleController* CC = static_cast<CapsuleController*>(currentController);
+						CC->getCapsule(worldCapule);
+					}
 					capsules.pushBack(worldCapule);
 
 					const size_t code = encodeUserObject(i, USER_OBJECT_CCT);
@@ -2380,59 +2443,31 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	}
 
 	const ObstacleContext* obstacles = NULL;
+	PxInternalCBData_FindTouchedObstacles obstacleQueryData;
 	if(obstacleContext)
 	{
 		obstacles = static_cast<const ObstacleContext*>(obstacleContext);
 
-		// PT: TODO: optimize this
-		const PxU32 nbExtraBoxes = obstacles->mBoxObstacles.size();
-		for(PxU32 i=0;i<nbExtraBoxes;i++)
-		{
-			const PxBoxObstacle& userBoxObstacle = obstacles->mBoxObstacles[i].mData;
-
-			PxExtendedBox extraBox;
-			extraBox.center		= userBoxObstacle.mPos;
-			extraBox.extents	= userBoxObstacle.mHalfExtents;
-			extraBox.rot		= userBoxObstacle.mRot;
-			boxes.pushBack(extraBox);
+		// Obstacles are not copied to the buffers, they are found in the obstacle context's tree during the sweeps
+		obstacleQueryData.obstacles = obstacles;
 
-			const size_t code = encodeUserObject(i, USER_OBJECT_BOX_OBSTACLE);
-			boxUserData.pushBack(reinterpret_cast<const void*>(code));
+		if(renderBuffer && (debugRenderFlags & PxControllerDebugRenderFlag::eOBSTACLES))
+		{
+			RenderOutput out(*renderBuffer);
+			out << gObstacleDebugColor;
 
-			if(renderBuffer && (debugRenderFlags & PxControllerDebugRenderFlag::eOBSTACLES))
+			const PxU32 nbExtraBoxes = obstacles->mBoxObstacles.size();
+			for(PxU32 i=0;i<nbExtraBoxes;i++)
 			{
-				RenderOutput out(*renderBuffer);
-				out << gObstacleDebugColor;
-
+				const PxBoxObstacle& userBoxObstacle = obstacles->mBoxObstacles[i].mData;
 				out << PxTransform(toVec3(userBoxObstacle.mPos), userBoxObstacle.mRot);
-
 				out << DebugBox(userBoxObstacle.mHalfExtents, true);
 			}
-		}
 
-		const PxU32 nbExtraCapsules = obstacles->mCapsuleObstacles.size();
-		for(PxU32 i=0;i<nbExtraCapsules;i++)
-		{
-			const PxCapsuleObstacle& userCapsuleObstacle = obstacles->mCapsuleObstacles[i].mData;
-
-			PxExtendedCapsule extraCapsule;
-			const PxVec3 capsuleAxis = userCapsuleObstacle.mRot.getBasisVector0() * userCapsuleObstacle.mHalfHeight;
-			extraCapsule.p0		= PxExtendedVec3(	userCapsuleObstacle.mPos.x - PxExtended(capsuleAxis.x),
-													userCapsuleObstacle.mPos.y - PxExtended(capsuleAxis.y),
-													userCapsuleObstacle.mPos.z - PxExtended(capsuleAxis.z));
-			extraCapsule.p1		= PxExtendedVec3(	userCapsuleObstacle.mPos.x + PxExtended(capsuleAxis.x),
-													userCapsuleObstacle.mPos.y + PxExtended(capsuleAxis.y),
-													userCapsuleObstacle.mPos.z + PxExtended(capsuleAxis.z));
-
-			extraCapsule.radius	= userCapsuleObstacle.mRadius;
-			capsules.pushBack(extraCapsule);
-			const size_t code = encodeUserObject(i, USER_OBJECT_CAPSULE_OBSTACLE);
-			capsuleUserData.pushBack(reinterpret_cast<const void*>(code));
-
-			if(renderBuffer && (debugRenderFlags & PxControllerDebugRenderFlag::eOBSTACLES))
+			const PxU32 nbExtraCapsules = obstacles->mCapsuleObstacles.size();
+			for(PxU32 i=0;i<nbExtraCapsules;i++)
 			{
-				RenderOutput out(*renderBuffer);
-				out << gObstacleDebugColor;
+				const PxCapsuleObstacle& userCapsuleObstacle = obstacles->mCapsuleObstacles[i].mData;
 				out.outputCapsule(userCapsuleObstacle.mRadius, userCapsuleObstacle.mHalfHeight, PxTransform(toVec3(userCapsuleObstacle.mPos), userCapsuleObstacle.mRot));
 			}
 		}
@@ -2450,6 +2485,7 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	userObstacles.mNbCapsules		= nbCapsules;
 	userObstacles.mCapsules			= nbCapsules ? capsules.begin() : NULL;
 	userObstacles.mCapsuleUserData	= nbCapsules ? capsuleUserData.begin() : NULL;
+	userObstacles.mQueryData		= obstacles ? &obstacleQueryData : NULL;
 
 	PxInternalCBData_OnHit userHitData;
 	userHitData.controller	= this;
@@ -2463,6 +2499,10 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	findGeomData.scene				= mScene;
 	findGeomData.renderBuffer		= renderBuffer;
 	findGeomData.cctShapeHashSet	= &mManager->mCCTShapes;
+	findGeomData.sharedMeshCache	= &mManager->mSharedMeshCache;
+	findGeomData.sharedMeshes		= &mSharedTouchedMeshes;
+	findGeomData.shareStaticMeshes	= mManager->mStaticGeometrySharing;
+	findGeomData.useSnapshots		= mManager->mSceneQuerySnapshots;
 
 	mCctModule.mFlags &= ~STF_WALK_EXPERIMENT;
 
@@ -2505,14 +2545,16 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 		const PxF32 deltaM2 = delta.magnitudeSquared();
 		if(deltaM2!=0.0f)
 		{
-			PxTransform targetPose = mKineActor->getGlobalPose();
-			targetPose.p = toVec3(mPosition);
-			targetPose.q = mUserParams.mQuatFromUp;
-			mKineActor->setKinematicTarget(targetPose);
+			// Scene writes are not thread-safe so concurrent moves leave them to moveControllers, and
+			// moves running against the snapshot leave them to applyPendingMoves
+			if(mManager->mBatchMove || mManager->mSceneQuerySnapshots)
+				mPendingKinematicTarget = true;
+			else
+				updateKinematicTarget();
 		}
 	}
 
-	mManager->resetObstaclesBuffers();
+	obstacleBuffers.reset();
 
 	if (lockWrite)
 		mWriteLock.unlock();
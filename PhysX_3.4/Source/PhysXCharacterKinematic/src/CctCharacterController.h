@@ -253,6 +253,8 @@ namespace Cct
 	// PT: user-defined obstacles. Note that "user" is from the SweepTest class' point of view,
 	// i.e. the PhysX CCT module is the user in this case. This is to limit coupling between the
 	// core CCT module and the PhysX classes.
+	struct InternalCBData_FindTouchedObstacles{};
+
 	struct UserObstacles// : PxObstacleContext
 	{
 		PxU32						mNbBoxes;
@@ -262,6 +264,19 @@ namespace Cct
 		PxU32						mNbCapsules;
 		const PxExtendedCapsule*	mCapsules;
 		const void**				mCapsuleUserData;
+
+		// Additional obstacles, found by findTouchedUserObstacles in the user's own structure. Can be NULL.
+		const InternalCBData_FindTouchedObstacles*	mQueryData;
+	};
+
+	// Receives the obstacles found by findTouchedUserObstacles
+	class UserObstacleReport
+	{
+		public:
+		virtual	void	onBox(const PxExtendedBox& box, const void* userData)				= 0;
+		virtual	void	onCapsule(const PxExtendedCapsule& capsule, const void* userData)	= 0;
+		protected:
+		virtual			~UserObstacleReport()												{}
 	};
 
 	struct InternalCBData_OnHit{};
@@ -470,6 +485,9 @@ namespace Cct
 		const CCTParams& params,
 		PxU16& nbTessellation);
 
+	// Reports the user obstacles whose bounds overlap "worldBox"
+	void findTouchedUserObstacles(const InternalCBData_FindTouchedObstacles* userData, const PxExtendedBounds3& worldBox, UserObstacleReport& report);
+
 	PxU32 shapeHitCallback(const InternalCBData_OnHit* userData, const SweptContact& contact, const PxVec3& dir, PxF32 length);
 	PxU32 userHitCallback(const InternalCBData_OnHit* userData, const SweptContact& contact, const PxVec3& dir, PxF32 length);
 
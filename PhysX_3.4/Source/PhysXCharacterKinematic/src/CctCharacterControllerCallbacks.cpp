@@ -484,8 +484,17 @@ static PxU32 createInvisibleWalls(const CCTParams& params, const PxTriangle& cur
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+static PX_FORCE_INLINE void getTouchedTriangle(const PxTriangleMeshGeometry& triGeom, const PxTransform& meshPose, const PxTriangle* sharedTriangles, PxU32 i, PxU32 triangleIndex, PxTriangle& triangle)
+{
+	if(sharedTriangles)
+		triangle = sharedTriangles[i];
+	else
+		PxMeshQuery::getTriangle(triGeom, meshPose, triangleIndex, triangle);
+}
+
 static void outputMeshToStream(	PxShape* meshShape, const PxRigidActor* actor, const PxTransform& meshPose, IntArray& geomStream, TriArray& worldTriangles, IntArray& triIndicesArray,
-								const PxExtendedVec3& origin, const PxBounds3& tmpBounds, const CCTParams& params, RenderBuffer* renderBuffer, PxU16& nbTessellation)
+								const PxExtendedVec3& origin, const PxBounds3& tmpBounds, const CCTParams& params, RenderBuffer* renderBuffer, PxU16& nbTessellation,
+								const PxInternalCBData_FindTouchedGeom* sharedData)
 {
 	PX_ASSERT(meshShape->getGeometryType() == PxGeometryType::eTRIANGLEMESH);
 	// Do AABB-mesh query
@@ -496,9 +505,25 @@ static void outputMeshToStream(	PxShape* meshShape, const PxRigidActor* actor, c
 	const PxBoxGeometry boxGeom(tmpBounds.getExtents());
 	const PxTransform boxPose(tmpBounds.getCenter(), PxQuat(PxIdentity));
 
-	// Collide AABB against current mesh
+	// Fetch the touched triangles from the shared static data if possible, else collide AABB against current mesh
 	PxMeshOverlapUtil overlapUtil;
-	const PxU32 nbTouchedTris = overlapUtil.findOverlap(boxGeom, boxPose, triGeom, meshPose);
+	Ps::Array<PxTriangle> sharedTris;
+	Ps::Array<PxU32> sharedIndices;
+	const PxTriangle* sharedTriangles = NULL;
+	PxU32 nbTouchedTris;
+	const PxU32* PX_RESTRICT indices;
+	if(sharedData && sharedData->sharedMeshCache->getTriangles(meshShape, triGeom, meshPose, sharedData->scene->getSceneQueryStaticTimestamp(),
+																tmpBounds, *sharedData->sharedMeshes, sharedTris, sharedIndices))
+	{
+		nbTouchedTris = sharedIndices.size();
+		indices = sharedIndices.begin();
+		sharedTriangles = sharedTris.begin();
+	}
+	else
+	{
+		nbTouchedTris = overlapUtil.findOverlap(boxGeom, boxPose, triGeom, meshPose);
+		indices = overlapUtil.getResults();
+	}
 
 	const PxVec3 offset(float(-origin.x), float(-origin.y), float(-origin.z));
 
@@ -510,8 +535,6 @@ static void outputMeshToStream(	PxShape* meshShape, const PxRigidActor* actor, c
 	touchedMesh->mNbTris				= nbTouchedTris;
 	touchedMesh->mIndexWorldTriangles	= worldTriangles.size();
 
-	const PxU32* PX_RESTRICT indices = overlapUtil.getResults();
-
 	if(params.mSlopeLimit!=0.0f)
 	{
 		if(!params.mTessellation)
@@ -524,7 +547,7 @@ static void outputMeshToStream(	PxShape* meshShape, const PxRigidActor* actor, c
 
 				// Compute triangle in world space, add to array
 				TrianglePadded currentTriangle;
-				PxMeshQuery::getTriangle(triGeom, meshPose, triangleIndex, currentTriangle);
+				getTouchedTriangle(triGeom, meshPose, sharedTriangles, i, triangleIndex, currentTriangle);
 				currentTriangle.verts[0] += offset;
 				currentTriangle.verts[1] += offset;
 				currentTriangle.verts[2] += offset;
@@ -553,7 +576,7 @@ static void outputMeshToStream(	PxShape* meshShape, const PxRigidActor* actor, c
 
 				// Compute triangle in world space, add to array
 				TrianglePadded currentTriangle;
-				PxMeshQuery::getTriangle(triGeom, meshPose, triangleIndex, currentTriangle);
+				getTouchedTriangle(triGeom, meshPose, sharedTriangles, i, triangleIndex, currentTriangle);
 				currentTriangle.verts[0] += offset;
 				currentTriangle.verts[1] += offset;
 				currentTriangle.verts[2] += offset;
@@ -588,7 +611,7 @@ static void outputMeshToStream(	PxShape* meshShape, const PxRigidActor* actor, c
 
 				// Compute triangle in world space, add to array
 				PxTriangle& currentTriangle = *TouchedTriangles++;
-				PxMeshQuery::getTriangle(triGeom, meshPose, triangleIndex, currentTriangle);
+				getTouchedTriangle(triGeom, meshPose, sharedTriangles, i, triangleIndex, currentTriangle);
 				currentTriangle.verts[0] += offset;
 				currentTriangle.verts[1] += offset;
 				currentTriangle.verts[2] += offset;
@@ -607,7 +630,7 @@ static void outputMeshToStream(	PxShape* meshShape, const PxRigidActor* actor, c
 
 				// Compute triangle in world space, add to array
 				TrianglePadded currentTriangle;
-				PxMeshQuery::getTriangle(triGeom, meshPose, triangleIndex, currentTriangle);
+				getTouchedTriangle(triGeom, meshPose, sharedTriangles, i, triangleIndex, currentTriangle);
 
 				currentTriangle.verts[0] += offset;
 				currentTriangle.verts[1] += offset;
@@ -943,6 +966,8 @@ void Cct::findTouchedGeometry(
 		if(filter.mPostFilter)
 			sqFilterFlags |= PxQueryFlag::ePOSTFILTER;
 	}
+	if(internalData->useSnapshots)
+		sqFilterFlags |= PxQueryFlag::eSNAPSHOT;
 
 	// ### this one is dangerous
 	const PxBounds3 tmpBounds(toVec3(worldBounds.minimum), toVec3(worldBounds.maximum));	// LOSS OF ACCURACY
@@ -960,6 +985,13 @@ void Cct::findTouchedGeometry(
 	sceneQueryFilterData.flags |= PxQueryFlag::eNO_BLOCK; // fix for DE8255
 	scene->overlap(PxBoxGeometry(extents), PxTransform(center), hitBuffer, sceneQueryFilterData, filter.mFilterCallback);
 	PxU32 numberHits = hitBuffer.getNbAnyHits();
+
+	// The static pass refills the static part of the cache. The shared sets used by the previous static data are
+	// released once the new ones have been acquired, so that sets used by both are not recomputed.
+	const bool staticPass = filter.mStaticShapes && !filter.mDynamicShapes;
+	const PxU32 nbPreviousSharedMeshes = staticPass ? internalData->sharedMeshes->size() : 0;
+	const PxInternalCBData_FindTouchedGeom* sharedData = staticPass && internalData->shareStaticMeshes ? internalData : NULL;
+
 	for(PxU32 i = 0; i < numberHits; i++)
 	{
 		const PxOverlapHit& hit = hitBuffer.getAnyHit(i);
@@ -988,11 +1020,15 @@ void Cct::findTouchedGeometry(
 		if(type==PxGeometryType::eSPHERE)				outputSphereToStream		(shape, actor, globalPose, geomStream, Origin);
 		else	if(type==PxGeometryType::eCAPSULE)		outputCapsuleToStream		(shape, actor, globalPose, geomStream, Origin);
 		else	if(type==PxGeometryType::eBOX)			outputBoxToStream			(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, nbTessellation);
-		else	if(type==PxGeometryType::eTRIANGLEMESH)	outputMeshToStream			(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer, nbTessellation);
+		else	if(type==PxGeometryType::eTRIANGLEMESH)	outputMeshToStream			(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer, nbTessellation,
+																				 actor->getConcreteType()==PxConcreteType::eRIGID_STATIC ? sharedData : NULL);
 		else	if(type==PxGeometryType::eHEIGHTFIELD)	outputHeightFieldToStream	(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer, nbTessellation);
 		else	if(type==PxGeometryType::eCONVEXMESH)	outputConvexToStream		(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer, nbTessellation);
 		else	if(type==PxGeometryType::ePLANE)		outputPlaneToStream			(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer);
 	}
+
+	if(nbPreviousSharedMeshes)
+		internalData->sharedMeshCache->release(*internalData->sharedMeshes, nbPreviousSharedMeshes);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1015,6 +1051,64 @@ static void fillCCTHit(PxControllerHit& hit, const SweptContact& contact, const
 
 static const PxU32 defaultBehaviorFlags = 0;
 
+namespace
+{
+	// Converts the obstacles found in the obstacle context to the format used by the sweep tests
+	class ObstacleToUserReport : public ObstacleOverlapReport
+	{
+		public:
+		ObstacleToUserReport(const ObstacleContext& obstacles, UserObstacleReport& report) : mObstacles(obstacles), mReport(report)	{}
+
+		virtual	void	onBoxObstacle(PxU32 index)
+		{
+			const PxBoxObstacle& userBoxObstacle = mObstacles.mBoxObstacles[index].mData;
+
+			PxExtendedBox extraBox;
+			extraBox.center		= userBoxObstacle.mPos;
+			extraBox.extents	= userBoxObstacle.mHalfExtents;
+			extraBox.rot		= userBoxObstacle.mRot;
+
+			const size_t code = encodeUserObject(index, USER_OBJECT_BOX_OBSTACLE);
+			mReport.onBox(extraBox, reinterpret_cast<const void*>(code));
+		}
+
+		virtual	void	onCapsuleObstacle(PxU32 index)
+		{
+			const PxCapsuleObstacle& userCapsuleObstacle = mObstacles.mCapsuleObstacles[index].mData;
+
+			PxExtendedCapsule extraCapsule;
+			const PxVec3 capsuleAxis = userCapsuleObstacle.mRot.getBasisVector0() * userCapsuleObstacle.mHalfHeight;
+			extraCapsule.p0		= PxExtendedVec3(	userCapsuleObstacle.mPos.x - PxExtended(capsuleAxis.x),
+													userCapsuleObstacle.mPos.y - PxExtended(capsuleAxis.y),
+													userCapsuleObstacle.mPos.z - PxExtended(capsuleAxis.z));
+			extraCapsule.p1		= PxExtendedVec3(	userCapsuleObstacle.mPos.x + PxExtended(capsuleAxis.x),
+													userCapsuleObstacle.mPos.y + PxExtended(capsuleAxis.y),
+													userCapsuleObstacle.mPos.z + PxExtended(capsuleAxis.z));
+			extraCapsule.radius	= userCapsuleObstacle.mRadius;
+
+			const size_t code = encodeUserObject(index, USER_OBJECT_CAPSULE_OBSTACLE);
+			mReport.onCapsule(extraCapsule, reinterpret_cast<const void*>(code));
+		}
+
+		const ObstacleContext&	mObstacles;
+		UserObstacleReport&		mReport;
+		private:
+		ObstacleToUserReport& operator=(const ObstacleToUserReport&);
+	};
+}
+
+void Cct::findTouchedUserObstacles(const InternalCBData_FindTouchedObstacles* userData, const PxExtendedBounds3& worldBox, UserObstacleReport& report)
+{
+	PX_ASSERT(userData);
+	const PxInternalCBData_FindTouchedObstacles* internalData = static_cast<const PxInternalCBData_FindTouchedObstacles*>(userData);
+	const ObstacleContext* obstacles = internalData->obstacles;
+
+	const PxBounds3 bounds(toVec3(worldBox.minimum), toVec3(worldBox.maximum));	// LOSS OF ACCURACY
+
+	ObstacleToUserReport obstacleReport(*obstacles, report);
+	obstacles->overlap(bounds, obstacleReport);
+}
+
 PxU32 Cct::shapeHitCallback(const InternalCBData_OnHit* userData, const SweptContact& contact, const PxVec3& dir, float length)
 {
 	Controller* controller = static_cast<const PxInternalCBData_OnHit*>(userData)->controller;
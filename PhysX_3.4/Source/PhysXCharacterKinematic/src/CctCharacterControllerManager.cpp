@@ -40,6 +40,7 @@
 #include "PxScene.h"
 #include "PxPhysics.h"
 #include "PsFoundation.h"
+#include "CmTask.h"
 
 using namespace physx;
 using namespace Cct;
@@ -57,6 +58,9 @@ CharacterControllerManager::CharacterControllerManager(PxScene& scene, bool lock
 	mOverlapRecovery						(true),
 	mPreciseSweeps							(true),
 	mPreventVerticalSlidingAgainstCeiling	(false),
+	mStaticGeometrySharing					(false),
+	mSceneQuerySnapshots					(false),
+	mBatchMove								(false),
 	mLockingEnabled							(lockingEnabled)
 {
 	// PT: register ourself as a deletion listener, to be called by the SDK whenever an object is deleted	
@@ -182,6 +186,8 @@ void CharacterControllerManager::releaseController(PxController& controller)
 	{
 		if(mControllers[i]->getPxController() == &controller)
 		{
+			Controller* ctrl = mControllers[i];
+			mSharedMeshCache.release(ctrl->mSharedTouchedMeshes, ctrl->mSharedTouchedMeshes.size());
 			mControllers.replaceWithLast(i);
 			break;
 		}
@@ -344,7 +350,7 @@ void resetOrClear(T& a)
 		a.reset();
 }
 
-void CharacterControllerManager::resetObstaclesBuffers()
+void ObstacleBuffers::reset()
 {
 	resetOrClear(mBoxUserData);
 	resetOrClear(mBoxes);
@@ -352,6 +358,11 @@ void CharacterControllerManager::resetObstaclesBuffers()
 	resetOrClear(mCapsules);
 }
 
+void CharacterControllerManager::resetObstaclesBuffers()
+{
+	mObstacleBuffers.reset();
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void CharacterControllerManager::setTessellation(bool flag, float maxEdgeLength)
@@ -383,6 +394,42 @@ void CharacterControllerManager::setPreventVerticalSlidingAgainstCeiling(bool fl
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void CharacterControllerManager::setStaticGeometrySharing(bool flag)
+{
+	mStaticGeometrySharing = flag;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void CharacterControllerManager::setSceneQuerySnapshots(bool flag)
+{
+	// Targets left by previous moves would not be applied anymore
+	if(mSceneQuerySnapshots && !flag)
+		applyPendingMoves();
+
+	mSceneQuerySnapshots = flag;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void CharacterControllerManager::applyPendingMoves()
+{
+	PX_PROFILE_ZONE("CharacterControllerManager.applyPendingMoves", PxU64(reinterpret_cast<size_t>(&mScene)));
+
+	const PxU32 nbControllers = mControllers.size();
+	for(PxU32 i=0;i<nbControllers;i++)
+	{
+		Controller* controller = mControllers[i];
+		if(controller->mPendingKinematicTarget)
+		{
+			controller->mPendingKinematicTarget = false;
+			controller->updateKinematicTarget();
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void CharacterControllerManager::shiftOrigin(const PxVec3& shift)
 {
 	for(PxU32 i=0; i < mControllers.size(); i++)
@@ -398,9 +445,11 @@ void CharacterControllerManager::shiftOrigin(const PxVec3& shift)
 	if (mRenderBuffer)
 		mRenderBuffer->shift(-shift);
 
+	mSharedMeshCache.invalidate();
+
 	// assumption is that these are just used for temporary stuff
-	PX_ASSERT(!mBoxes.size());
-	PX_ASSERT(!mCapsules.size());
+	PX_ASSERT(!mObstacleBuffers.mBoxes.size());
+	PX_ASSERT(!mObstacleBuffers.mCapsules.size());
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -652,6 +701,109 @@ void CharacterControllerManager::computeInteractions(PxF32 elapsedTime, PxContro
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static PX_FORCE_INLINE Controller* getInternalController(PxController* controller)
+{
+	if(controller->getType()==PxControllerShapeType::eBOX)
+		return static_cast<BoxController*>(controller);
+	PX_ASSERT(controller->getType()==PxControllerShapeType::eCAPSULE);
+	return static_cast<CapsuleController*>(controller);
+}
+
+namespace
+{
+	struct MoveControllersJob
+	{
+		enum { NB_CONTROLLERS_PER_JOB = 32 };
+
+		PxController* const*		mControllers;
+		const PxVec3*				mDisps;
+		PxControllerCollisionFlags*	mCollisionFlags;
+		PxU32						mNbControllers;
+		PxF32						mMinDist;
+		PxF32						mElapsedTime;
+		const PxControllerFilters*	mFilters;
+		const PxObstacleContext*	mObstacles;
+
+		void operator()(PxU32 jobIndex)
+		{
+			// Each job gathers the obstacles of its controllers in its own buffers
+			ObstacleBuffers obstacleBuffers;
+
+			const PxU32 start = jobIndex*NB_CONTROLLERS_PER_JOB;
+			const PxU32 end = PxMin(start + NB_CONTROLLERS_PER_JOB, mNbControllers);
+			for(PxU32 i=start;i<end;i++)
+			{
+				Controller* controller = getInternalController(mControllers[i]);
+				controller->mObstacleBuffers = &obstacleBuffers;
+				const PxControllerCollisionFlags flags = mControllers[i]->move(mDisps[i], mMinDist, mElapsedTime, *mFilters, mObstacles);
+				controller->mObstacleBuffers = NULL;
+				if(mCollisionFlags)
+					mCollisionFlags[i] = flags;
+			}
+		}
+	};
+}
+
+void CharacterControllerManager::moveControllers(PxU32 nbControllers, PxController* const* controllers, const PxVec3* disps, PxF32 minDist, PxF32 elapsedTime,
+												 const PxControllerFilters& filters, const PxObstacleContext* obstacles, PxCpuDispatcher& dispatcher,
+												 PxControllerCollisionFlags* collisionFlags)
+{
+	PX_PROFILE_ZONE("CharacterControllerManager.moveControllers", PxU64(reinterpret_cast<size_t>(&mScene)));
+
+	if(!nbControllers)
+		return;
+
+	// Capture the volumes of all controllers so that each move sees the others at their initial positions,
+	// whatever the order in which the jobs run.
+	const PxU32 nbManagedControllers = mControllers.size();
+	mBatchBoxes.resizeUninitialized(nbManagedControllers);
+	mBatchCapsules.resizeUninitialized(nbManagedControllers);
+	for(PxU32 i=0;i<nbManagedControllers;i++)
+	{
+		Controller* current = mControllers[i];
+		if(current->mType==PxControllerShapeType::eBOX)
+			static_cast<BoxController*>(current)->getOBB(mBatchBoxes[i]);
+		else
+			static_cast<CapsuleController*>(current)->getCapsule(mBatchCapsules[i]);
+	}
+
+	// The observed objects map is shared by all controllers, so it must be locked while they move concurrently
+	const bool lockingEnabled = mLockingEnabled;
+	mLockingEnabled = true;
+	mBatchMove = true;
+
+	MoveControllersJob job;
+	job.mControllers	= controllers;
+	job.mDisps			= disps;
+	job.mCollisionFlags	= collisionFlags;
+	job.mNbControllers	= nbControllers;
+	job.mMinDist		= minDist;
+	job.mElapsedTime	= elapsedTime;
+	job.mFilters		= &filters;
+	job.mObstacles		= obstacles;
+	Cm::runParallelJobs(&dispatcher, (nbControllers + MoveControllersJob::NB_CONTROLLERS_PER_JOB - 1)/MoveControllersJob::NB_CONTROLLERS_PER_JOB, job);
+
+	mBatchMove = false;
+	mLockingEnabled = lockingEnabled;
+
+	// With snapshots the scene may be simulated, and the targets are left to applyPendingMoves
+	if(mSceneQuerySnapshots)
+		return;
+
+	// Scene writes are applied here, in the order of the controllers array
+	for(PxU32 i=0;i<nbControllers;i++)
+	{
+		Controller* controller = getInternalController(controllers[i]);
+		if(controller->mPendingKinematicTarget)
+		{
+			controller->mPendingKinematicTarget = false;
+			controller->updateKinematicTarget();
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //Public factory methods
 
 PX_C_EXPORT PX_PHYSX_CHARACTER_API PxControllerManager* PX_CALL_CONV PxCreateControllerManager(PxScene& scene, bool lockingEnabled)
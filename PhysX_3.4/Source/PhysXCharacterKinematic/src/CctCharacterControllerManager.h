@@ -39,6 +39,7 @@
 #include "PxDeletionListener.h"
 #include "CmRenderOutput.h"
 #include "CctUtils.h"
+#include "CctSharedTouchedMeshCache.h"
 #include "PsHashSet.h"
 #include "PsHashMap.h"
 #include "PsMutex.h"
@@ -61,6 +62,18 @@ namespace Cct
 
 	typedef Ps::HashMap<const PxBase*, ObservedRefCounter>			ObservedRefCountMap;
 
+	// Temporary buffers gathering the obstacles of a controller during its move
+	struct ObstacleBuffers
+	{
+						void							reset();
+
+						Ps::Array<const void*>			mBoxUserData;
+						Ps::Array<PxExtendedBox>		mBoxes;
+
+						Ps::Array<const void*>			mCapsuleUserData;
+						Ps::Array<PxExtendedCapsule>	mCapsules;
+	};
+
 	//Implements the PxControllerManager interface, this class used to be called ControllerManager
 	class CharacterControllerManager : public PxControllerManager   , public Ps::UserAllocated, public PxDeletionListener
 	{		
@@ -82,10 +95,16 @@ namespace Cct
 		virtual			PxObstacleContext*				getObstacleContext(PxU32 index);
 		virtual			PxObstacleContext*				createObstacleContext();
 		virtual			void							computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb);
+		virtual			void							moveControllers(PxU32 nbControllers, PxController* const* controllers, const PxVec3* disps, PxF32 minDist, PxF32 elapsedTime,
+																		const PxControllerFilters& filters, const PxObstacleContext* obstacles, PxCpuDispatcher& dispatcher,
+																		PxControllerCollisionFlags* collisionFlags);
 		virtual			void							setTessellation(bool flag, float maxEdgeLength);
 		virtual			void							setOverlapRecoveryModule(bool flag);
 		virtual			void							setPreciseSweeps(bool flag);
 		virtual			void							setPreventVerticalSlidingAgainstCeiling(bool flag);
+		virtual			void							setStaticGeometrySharing(bool flag);
+		virtual			void							setSceneQuerySnapshots(bool flag);
+		virtual			void							applyPendingMoves();
 		virtual			void							shiftOrigin(const PxVec3& shift);		
 		//~PxControllerManager
 
@@ -110,11 +129,12 @@ namespace Cct
 						Cm::RenderBuffer*				mRenderBuffer;
 						PxControllerDebugRenderFlags	mDebugRenderingFlags;
 		// Shared buffers for obstacles
-						Ps::Array<const void*>			mBoxUserData;
-						Ps::Array<PxExtendedBox>		mBoxes;
+						ObstacleBuffers					mObstacleBuffers;
 
-						Ps::Array<const void*>			mCapsuleUserData;
-						Ps::Array<PxExtendedCapsule>	mCapsules;
+		// Volumes of all controllers captured at the start of moveControllers, indexed like mControllers
+						Ps::Array<PxExtendedBox>		mBatchBoxes;
+						Ps::Array<PxExtendedCapsule>	mBatchCapsules;
+						bool							mBatchMove;
 
 						Ps::Array<Controller*>			mControllers;
 						Ps::HashSet<PxShape*>			mCCTShapes;
@@ -128,6 +148,12 @@ namespace Cct
 						bool							mPreciseSweeps;
 						bool							mPreventVerticalSlidingAgainstCeiling;
 
+		// Static mesh triangles shared by controllers
+						SharedTouchedMeshCache			mSharedMeshCache;
+						bool							mStaticGeometrySharing;
+		// Moves query the scene query snapshot and leave their kinematic targets to applyPendingMoves
+						bool							mSceneQuerySnapshots;
+
 						bool							mLockingEnabled;						
 
 	protected:
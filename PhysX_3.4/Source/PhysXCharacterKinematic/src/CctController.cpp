@@ -55,6 +55,8 @@ Controller::Controller(const PxControllerDesc& desc, PxScene* s) :
 	mProxyScaleCoeff		(0.0f),
 	mCollisionFlags			(0),
 	mCachedStandingOnMoving	(false),
+	mPendingKinematicTarget	(false),
+	mObstacleBuffers		(NULL),
 	mManager				(NULL)
 {
 	mType								= PxControllerShapeType::eFORCE_DWORD;
@@ -98,6 +100,16 @@ Controller::~Controller()
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void Controller::updateKinematicTarget()
+{
+	PxTransform targetPose = mKineActor->getGlobalPose();
+	targetPose.p = toVec3(mPosition);
+	targetPose.q = mUserParams.mQuatFromUp;
+	mKineActor->setKinematicTarget(targetPose);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void Controller::onRelease(const PxBase& observed)
 {	
 	mCctModule.onRelease(observed);
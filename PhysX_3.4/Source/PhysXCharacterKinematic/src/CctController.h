@@ -34,6 +34,7 @@
 /** \cond */
 
 #include "CctCharacterController.h"
+#include "CctSharedTouchedMeshCache.h"
 #include "PsUserAllocated.h"
 #include "PsMutex.h"
 
@@ -49,6 +50,7 @@ class PxMaterial;
 namespace Cct
 {
 	class CharacterControllerManager;
+	struct ObstacleBuffers;
 
 	class Controller : public Ps::UserAllocated
 	{
@@ -69,6 +71,8 @@ namespace Cct
 
 					void								onRelease(const PxBase& observed);
 
+					void								updateKinematicTarget();
+
 					void								setCctManager(CharacterControllerManager* cm)
 					{
 						mManager = cm;
@@ -99,6 +103,9 @@ namespace Cct
 					PxControllerCollisionFlags			mCollisionFlags;	// Last known collision flags (PxControllerCollisionFlag)
 					bool								mCachedStandingOnMoving;
 					bool								mRegisterDeletionListener;
+					bool								mPendingKinematicTarget;	// Kinematic target left to moveControllers or applyPendingMoves
+					ObstacleBuffers*					mObstacleBuffers;	// Per-job obstacle buffers used by moveControllers, NULL otherwise
+					SharedTouchedMeshArray				mSharedTouchedMeshes;	// Shared static triangle sets used by the cached geometry
 		mutable		Ps::Mutex							mWriteLock;			// Lock used for guarding touched pointers and cache data from overwriting 
 																			// during onRelease call.
 	protected:
@@ -73,12 +73,22 @@ namespace Cct
 		ObstacleHandle			touchedObstacleHandle;
 	};
 
+	struct PxInternalCBData_FindTouchedObstacles : InternalCBData_FindTouchedObstacles
+	{
+		const ObstacleContext*	obstacles;
+	};
+
 	struct PxInternalCBData_FindTouchedGeom : InternalCBData_FindTouchedGeom
 	{
 		PxScene*				scene;
 		Cm::RenderBuffer*		renderBuffer;	// Render buffer from controller manager, not the one from the scene
 
 		Ps::HashSet<PxShape*>*	cctShapeHashSet;
+
+		SharedTouchedMeshCache*	sharedMeshCache;	// Manager-level cache of static mesh triangles
+		SharedTouchedMeshArray*	sharedMeshes;		// Sets currently referenced by the controller
+		bool					shareStaticMeshes;
+		bool					useSnapshots;		// Queries run against the scene query snapshot
 	};
 }
 }
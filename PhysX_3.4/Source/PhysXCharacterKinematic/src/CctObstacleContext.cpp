@@ -203,6 +203,18 @@ static PX_FORCE_INLINE PxU32 decodeIndex(ObstacleHandle handle)
 }
 #endif
 
+static PxBounds3 computeObstacleBounds(const PxBoxObstacle& obstacle)
+{
+	return PxBounds3::basisExtent(toVec3(obstacle.mPos), PxMat33(obstacle.mRot), obstacle.mHalfExtents);	// LOSS OF ACCURACY
+}
+
+static PxBounds3 computeObstacleBounds(const PxCapsuleObstacle& obstacle)
+{
+	const PxVec3 capsuleAxis = obstacle.mRot.getBasisVector0() * obstacle.mHalfHeight;
+	const PxVec3 extents = capsuleAxis.abs() + PxVec3(obstacle.mRadius);
+	return PxBounds3::centerExtents(toVec3(obstacle.mPos), extents);	// LOSS OF ACCURACY
+}
+
 ObstacleContext::ObstacleContext(CharacterControllerManager& cctMan)
 	: mCCTManager(cctMan)
 {
@@ -233,7 +245,8 @@ ObstacleHandle ObstacleContext::addObstacle(const PxObstacle& obstacle)
 #else
 		const ObstacleHandle handle = encodeHandle(index, type);
 #endif
-		mBoxObstacles.pushBack(InternalBoxObstacle(handle, static_cast<const PxBoxObstacle&>(obstacle)));
+		const PxBoxObstacle& boxObstacle = static_cast<const PxBoxObstacle&>(obstacle);
+		mBoxObstacles.pushBack(InternalBoxObstacle(handle, boxObstacle, mTree.addObject(computeObstacleBounds(boxObstacle), handle)));
 		mCCTManager.onObstacleAdded(handle, this);
 		return handle;
 	}
@@ -245,7 +258,8 @@ ObstacleHandle ObstacleContext::addObstacle(const PxObstacle& obstacle)
 #else
 		const ObstacleHandle handle = encodeHandle(index, type);
 #endif
-		mCapsuleObstacles.pushBack(InternalCapsuleObstacle(handle, static_cast<const PxCapsuleObstacle&>(obstacle)));
+		const PxCapsuleObstacle& capsuleObstacle = static_cast<const PxCapsuleObstacle&>(obstacle);
+		mCapsuleObstacles.pushBack(InternalCapsuleObstacle(handle, capsuleObstacle, mTree.addObject(computeObstacleBounds(capsuleObstacle), handle)));
 		mCCTManager.onObstacleAdded(handle, this);
 		return handle;
 	}
@@ -289,6 +303,7 @@ bool ObstacleContext::removeObstacle(ObstacleHandle handle)
 #ifdef NEW_ENCODING
 		remove<InternalBoxObstacle>(mHandleManager, object, handle, index, size, mBoxObstacles);
 #endif
+		mTree.removeObject(mBoxObstacles[index].mTreeNode);
 		mBoxObstacles.replaceWithLast(index);
 #ifdef NEW_ENCODING
 		mCCTManager.onObstacleRemoved(handle);
@@ -308,6 +323,7 @@ bool ObstacleContext::removeObstacle(ObstacleHandle handle)
 		remove<InternalCapsuleObstacle>(mHandleManager, object, handle, index, size, mCapsuleObstacles);
 #endif
 
+		mTree.removeObject(mCapsuleObstacles[index].mTreeNode);
 		mCapsuleObstacles.replaceWithLast(index);
 #ifdef NEW_ENCODING
 		mCCTManager.onObstacleRemoved(handle);
@@ -346,6 +362,7 @@ bool ObstacleContext::updateObstacle(ObstacleHandle handle, const PxObstacle& ob
 			return false;
 
 		mBoxObstacles[index].mData = static_cast<const PxBoxObstacle&>(obstacle);
+		mTree.updateObject(mBoxObstacles[index].mTreeNode, computeObstacleBounds(mBoxObstacles[index].mData));
 		mCCTManager.onObstacleUpdated(handle,this);
 		return true;
 	}
@@ -357,6 +374,7 @@ bool ObstacleContext::updateObstacle(ObstacleHandle handle, const PxObstacle& ob
 			return false;
 
 		mCapsuleObstacles[index].mData = static_cast<const PxCapsuleObstacle&>(obstacle);
+		mTree.updateObject(mCapsuleObstacles[index].mTreeNode, computeObstacleBounds(mCapsuleObstacles[index].mData));
 		mCCTManager.onObstacleUpdated(handle,this);
 		return true;
 	}
@@ -419,64 +437,110 @@ const PxObstacle* ObstacleContext::getObstacleByHandle(ObstacleHandle handle) co
 #include "PxCapsuleGeometry.h"
 #include "PsMathUtils.h"
 using namespace Gu;
-const PxObstacle* ObstacleContext::raycastSingle(PxRaycastHit& hit, const PxVec3& origin, const PxVec3& unitDir, const PxReal distance, ObstacleHandle& obstacleHandle) const
+namespace
 {
-	PxRaycastHit localHit;
-	PxF32 t = FLT_MAX;
-	const PxObstacle* touchedObstacle = NULL;
-
-	const PxHitFlags hitFlags = PxHitFlag::eDISTANCE;
-
+	struct ObstacleRaycastCallback
 	{
-		const RaycastFunc raycastFunc = Gu::getRaycastFuncTable()[PxGeometryType::eBOX];
-		PX_ASSERT(raycastFunc);
+		ObstacleRaycastCallback(const ObstacleContext& context, const HandleManager& handleManager, const PxVec3& origin, const PxVec3& unitDir, PxRaycastHit& hit) :
+			mContext(context), mHandleManager(handleManager), mOrigin(origin), mUnitDir(unitDir), mHit(hit),
+			mTouchedObstacle(NULL), mTouchedHandle(INVALID_OBSTACLE_HANDLE), mT(FLT_MAX)
+		{
+		}
 
-		const PxU32 nbExtraBoxes = mBoxObstacles.size();
-		for(PxU32 i=0;i<nbExtraBoxes;i++)
+		void operator()(ObstacleHandle handle, PxReal& maxDist)
 		{
-			const PxBoxObstacle& userBoxObstacle = mBoxObstacles[i].mData;
-
-			PxU32 status = raycastFunc(	PxBoxGeometry(userBoxObstacle.mHalfExtents),
-										PxTransform(toVec3(userBoxObstacle.mPos), userBoxObstacle.mRot),
-										origin, unitDir, distance,
-										hitFlags,
-										1, &localHit);
-			if(status && localHit.distance<t)
+			void* object = mHandleManager.GetObject(handle);
+			PX_ASSERT(object);
+			const PxGeometryType::Enum type = decodeInternalType(object);
+			const PxU32 index = decodeInternalIndex(object);
+
+			const PxHitFlags hitFlags = PxHitFlag::eDISTANCE;
+			PxRaycastHit localHit;
+
+			const PxObstacle* obstacle;
+			PxU32 status;
+			if(type==PxGeometryType::eBOX)
+			{
+				const PxBoxObstacle& userBoxObstacle = mContext.mBoxObstacles[index].mData;
+				obstacle = &userBoxObstacle;
+
+				status = Gu::getRaycastFuncTable()[PxGeometryType::eBOX](	PxBoxGeometry(userBoxObstacle.mHalfExtents),
+																			PxTransform(toVec3(userBoxObstacle.mPos), userBoxObstacle.mRot),
+																			mOrigin, mUnitDir, maxDist,
+																			hitFlags,
+																			1, &localHit);
+			}
+			else
 			{
-				t = localHit.distance;
-				hit = localHit;
-				obstacleHandle = mBoxObstacles[i].mHandle;
-				touchedObstacle = &userBoxObstacle;
+				PX_ASSERT(type==PxGeometryType::eCAPSULE);
+				const PxCapsuleObstacle& userCapsuleObstacle = mContext.mCapsuleObstacles[index].mData;
+				obstacle = &userCapsuleObstacle;
+
+				status = Gu::getRaycastFuncTable()[PxGeometryType::eCAPSULE](	PxCapsuleGeometry(userCapsuleObstacle.mRadius, userCapsuleObstacle.mHalfHeight),
+																				PxTransform(toVec3(userCapsuleObstacle.mPos), userCapsuleObstacle.mRot),
+																				mOrigin, mUnitDir, maxDist,
+																				hitFlags,
+																				1, &localHit);
+			}
+
+			if(status && localHit.distance<mT)
+			{
+				mT = localHit.distance;
+				mHit = localHit;
+				mTouchedHandle = handle;
+				mTouchedObstacle = obstacle;
+				maxDist = PxMin(maxDist, mT);
 			}
 		}
-	}
 
+		const ObstacleContext&	mContext;
+		const HandleManager&	mHandleManager;
+		const PxVec3			mOrigin;
+		const PxVec3			mUnitDir;
+		PxRaycastHit&			mHit;
+		const PxObstacle*		mTouchedObstacle;
+		ObstacleHandle			mTouchedHandle;
+		PxF32					mT;
+	private:
+		ObstacleRaycastCallback& operator=(const ObstacleRaycastCallback&);
+	};
+
+	struct ObstacleOverlapCallback
 	{
-		const RaycastFunc raycastFunc = Gu::getRaycastFuncTable()[PxGeometryType::eCAPSULE];
-		PX_ASSERT(raycastFunc);
+		ObstacleOverlapCallback(const HandleManager& handleManager, ObstacleOverlapReport& report) : mHandleManager(handleManager), mReport(report)	{}
 
-		const PxU32 nbExtraCapsules = mCapsuleObstacles.size();
-		for(PxU32 i=0;i<nbExtraCapsules;i++)
+		void operator()(ObstacleHandle handle)
 		{
-			const PxCapsuleObstacle& userCapsuleObstacle = mCapsuleObstacles[i].mData;
-
-			PxU32 status = raycastFunc(	PxCapsuleGeometry(userCapsuleObstacle.mRadius, userCapsuleObstacle.mHalfHeight),
-										PxTransform(toVec3(userCapsuleObstacle.mPos), userCapsuleObstacle.mRot),
-										origin, unitDir, distance,
-										hitFlags,
-										1, &localHit);
-			if(status && localHit.distance<t)
-			{
-				t = localHit.distance;
-				hit = localHit;
-				obstacleHandle = mCapsuleObstacles[i].mHandle;
-				touchedObstacle = &userCapsuleObstacle;
-			}
+			void* object = mHandleManager.GetObject(handle);
+			PX_ASSERT(object);
+			if(decodeInternalType(object)==PxGeometryType::eBOX)
+				mReport.onBoxObstacle(decodeInternalIndex(object));
+			else
+				mReport.onCapsuleObstacle(decodeInternalIndex(object));
 		}
-	}
-	return touchedObstacle;
+
+		const HandleManager&	mHandleManager;
+		ObstacleOverlapReport&	mReport;
+	private:
+		ObstacleOverlapCallback& operator=(const ObstacleOverlapCallback&);
+	};
 }
 
+const PxObstacle* ObstacleContext::raycastSingle(PxRaycastHit& hit, const PxVec3& origin, const PxVec3& unitDir, const PxReal distance, ObstacleHandle& obstacleHandle) const
+{
+	ObstacleRaycastCallback callback(*this, mHandleManager, origin, unitDir, hit);
+	mTree.raycast(origin, unitDir, distance, callback);
+
+	if(callback.mTouchedObstacle)
+		obstacleHandle = callback.mTouchedHandle;
+	return callback.mTouchedObstacle;
+}
+
+void ObstacleContext::overlap(const PxBounds3& bounds, ObstacleOverlapReport& report) const
+{
+	ObstacleOverlapCallback callback(mHandleManager, report);
+	mTree.overlap(bounds, callback);
+}
 
 const PxObstacle* ObstacleContext::raycastSingle(PxRaycastHit& hit, const ObstacleHandle& obstacleHandle, const PxVec3& origin, const PxVec3& unitDir, const PxReal distance) const
 {	
@@ -535,4 +599,6 @@ void ObstacleContext::onOriginShift(const PxVec3& shift)
 
 	for(PxU32 i=0; i < mCapsuleObstacles.size(); i++)
 		mCapsuleObstacles[i].mData.mPos -= shift;
+
+	mTree.shift(shift);
 }
@@ -37,6 +37,7 @@
 #include "PsUserAllocated.h"
 #include "PsArray.h"
 #include "CmPhysXCommon.h"
+#include "CctObstacleTree.h"
 
 namespace physx
 {
@@ -81,6 +82,16 @@ namespace Cct
 						bool		SetupLists(void** objects=NULL, PxU16* oti=NULL, PxU16* ito=NULL, PxU16* stamps=NULL);
 	};
 
+	// Receives the obstacles found by ObstacleContext::overlap, as indices in the box and capsule arrays
+	class ObstacleOverlapReport
+	{
+		public:
+		virtual			void		onBoxObstacle(PxU32 index)		= 0;
+		virtual			void		onCapsuleObstacle(PxU32 index)	= 0;
+		protected:
+		virtual						~ObstacleOverlapReport()		{}
+	};
+
 	class ObstacleContext : public PxObstacleContext, public Ps::UserAllocated
 	{
 		public:
@@ -101,29 +112,35 @@ namespace Cct
 				const PxObstacle*				raycastSingle(PxRaycastHit& hit, const PxVec3& origin, const PxVec3& unitDir, const PxReal distance, ObstacleHandle& obstacleHandle)	const;
 				const PxObstacle*				raycastSingle(PxRaycastHit& hit, const ObstacleHandle& obstacleHandle, const PxVec3& origin, const PxVec3& unitDir, const PxReal distance)	const; // raycast just one obstacle handle
 
+				// Reports the obstacles whose bounds overlap the query bounds
+				void							overlap(const PxBounds3& bounds, ObstacleOverlapReport& report)	const;
+
 				void							onOriginShift(const PxVec3& shift);
 
 				struct InternalBoxObstacle
 				{
-					InternalBoxObstacle(ObstacleHandle handle, const PxBoxObstacle& data) : mHandle(handle), mData(data)	{}
+					InternalBoxObstacle(ObstacleHandle handle, const PxBoxObstacle& data, PxU32 treeNode) : mHandle(handle), mData(data), mTreeNode(treeNode)	{}
 
 					ObstacleHandle	mHandle;
 					PxBoxObstacle	mData;
+					PxU32			mTreeNode;
 				};
 				Ps::Array<InternalBoxObstacle>	mBoxObstacles;
 
 				struct InternalCapsuleObstacle
 				{
-					InternalCapsuleObstacle(ObstacleHandle handle, const PxCapsuleObstacle& data) : mHandle(handle), mData(data)	{}
+					InternalCapsuleObstacle(ObstacleHandle handle, const PxCapsuleObstacle& data, PxU32 treeNode) : mHandle(handle), mData(data), mTreeNode(treeNode)	{}
 
 					ObstacleHandle		mHandle;
 					PxCapsuleObstacle	mData;
+					PxU32				mTreeNode;
 				};
 				Ps::Array<InternalCapsuleObstacle>	mCapsuleObstacles;
 
 	private:
 				ObstacleContext&				operator=(const ObstacleContext&);
 				HandleManager					mHandleManager;
+				ObstacleTree					mTree;				// Bounds of all obstacles, leaves store the obstacle handles
 				CharacterControllerManager&		mCCTManager;
 	};
 
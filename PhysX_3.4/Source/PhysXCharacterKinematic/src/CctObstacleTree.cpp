@@ -0,0 +1,380 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#include "CctObstacleTree.h"
+
+using namespace physx;
+using namespace Cct;
+
+// Leaf bounds are enlarged by this fraction of the object extents
+static const PxReal gFatBoundsFactor = 0.1f;
+
+static PX_FORCE_INLINE PxReal halfSurfaceArea(const PxBounds3& bounds)
+{
+	const PxVec3 d = bounds.maximum - bounds.minimum;
+	return d.x*d.y + d.y*d.z + d.z*d.x;
+}
+
+static PX_FORCE_INLINE PxBounds3 merge(const PxBounds3& b0, const PxBounds3& b1)
+{
+	return PxBounds3(b0.minimum.minimum(b1.minimum), b0.maximum.maximum(b1.maximum));
+}
+
+static PX_FORCE_INLINE PxBounds3 fatten(const PxBounds3& bounds)
+{
+	const PxVec3 margin = bounds.getExtents() * gFatBoundsFactor;
+	return PxBounds3(bounds.minimum - margin, bounds.maximum + margin);
+}
+
+ObstacleTree::ObstacleTree() : mRoot(INVALID_NODE), mFreeList(INVALID_NODE)
+{
+}
+
+ObstacleTree::~ObstacleTree()
+{
+}
+
+PxU32 ObstacleTree::allocateNode()
+{
+	PxU32 index;
+	if(mFreeList!=INVALID_NODE)
+	{
+		index = mFreeList;
+		mFreeList = mNodes[index].mParent;
+	}
+	else
+	{
+		index = mNodes.size();
+		mNodes.insert();
+	}
+
+	Node& node = mNodes[index];
+	node.mParent		= INVALID_NODE;
+	node.mChildren[0]	= INVALID_NODE;
+	node.mChildren[1]	= INVALID_NODE;
+	node.mHeight		= 0;
+	node.mHandle		= INVALID_OBSTACLE_HANDLE;
+	return index;
+}
+
+void ObstacleTree::freeNode(PxU32 node)
+{
+	mNodes[node].mParent = mFreeList;
+	mFreeList = node;
+}
+
+PxU32 ObstacleTree::addObject(const PxBounds3& bounds, ObstacleHandle handle)
+{
+	const PxU32 leaf = allocateNode();
+	mNodes[leaf].mBounds = fatten(bounds);
+	mNodes[leaf].mHandle = handle;
+	insertLeaf(leaf);
+	return leaf;
+}
+
+void ObstacleTree::removeObject(PxU32 leaf)
+{
+	PX_ASSERT(mNodes[leaf].isLeaf());
+	removeLeaf(leaf);
+	freeNode(leaf);
+}
+
+void ObstacleTree::updateObject(PxU32 leaf, const PxBounds3& bounds)
+{
+	PX_ASSERT(mNodes[leaf].isLeaf());
+
+	// Nothing to do while the object stays within its enlarged bounds
+	if(bounds.isInside(mNodes[leaf].mBounds))
+		return;
+
+	removeLeaf(leaf);
+	mNodes[leaf].mBounds = fatten(bounds);
+	insertLeaf(leaf);
+}
+
+void ObstacleTree::shift(const PxVec3& shift)
+{
+	const PxU32 nbNodes = mNodes.size();
+	for(PxU32 i=0;i<nbNodes;i++)
+	{
+		mNodes[i].mBounds.minimum -= shift;
+		mNodes[i].mBounds.maximum -= shift;
+	}
+}
+
+void ObstacleTree::insertLeaf(PxU32 leaf)
+{
+	if(mRoot==INVALID_NODE)
+	{
+		mRoot = leaf;
+		mNodes[leaf].mParent = INVALID_NODE;
+		return;
+	}
+
+	// Find the best sibling, using the surface area heuristic
+	const PxBounds3 leafBounds = mNodes[leaf].mBounds;
+	PxU32 index = mRoot;
+	while(!mNodes[index].isLeaf())
+	{
+		const Node& node = mNodes[index];
+		const PxReal area = halfSurfaceArea(node.mBounds);
+		const PxReal combinedArea = halfSurfaceArea(merge(node.mBounds, leafBounds));
+
+		// Cost of creating a new parent for this node and the new leaf
+		const PxReal cost = 2.0f * combinedArea;
+		// Minimum cost of pushing the leaf further down the tree
+		const PxReal inheritanceCost = 2.0f * (combinedArea - area);
+
+		PxReal childCosts[2];
+		for(PxU32 j=0;j<2;j++)
+		{
+			const Node& child = mNodes[node.mChildren[j]];
+			const PxReal childArea = halfSurfaceArea(merge(child.mBounds, leafBounds));
+			childCosts[j] = (child.isLeaf() ? childArea : childArea - halfSurfaceArea(child.mBounds)) + inheritanceCost;
+		}
+
+		if(cost<childCosts[0] && cost<childCosts[1])
+			break;
+
+		index = childCosts[0]<childCosts[1] ? node.mChildren[0] : node.mChildren[1];
+	}
+
+	const PxU32 sibling = index;
+	const PxU32 oldParent = mNodes[sibling].mParent;
+	const PxU32 newParent = allocateNode();	// Can resize the array
+
+	mNodes[newParent].mParent	= oldParent;
+	mNodes[newParent].mBounds	= merge(leafBounds, mNodes[sibling].mBounds);
+	mNodes[newParent].mHeight	= mNodes[sibling].mHeight + 1;
+	mNodes[newParent].mChildren[0] = sibling;
+	mNodes[newParent].mChildren[1] = leaf;
+	mNodes[sibling].mParent = newParent;
+	mNodes[leaf].mParent = newParent;
+
+	if(oldParent!=INVALID_NODE)
+	{
+		if(mNodes[oldParent].mChildren[0]==sibling)
+			mNodes[oldParent].mChildren[0] = newParent;
+		else
+			mNodes[oldParent].mChildren[1] = newParent;
+	}
+	else
+	{
+		mRoot = newParent;
+	}
+
+	refit(mNodes[leaf].mParent);
+}
+
+void ObstacleTree::removeLeaf(PxU32 leaf)
+{
+	if(leaf==mRoot)
+	{
+		mRoot = INVALID_NODE;
+		return;
+	}
+
+	const PxU32 parent = mNodes[leaf].mParent;
+	const PxU32 grandParent = mNodes[parent].mParent;
+	const PxU32 sibling = mNodes[parent].mChildren[0]==leaf ? mNodes[parent].mChildren[1] : mNodes[parent].mChildren[0];
+
+	if(grandParent!=INVALID_NODE)
+	{
+		// Destroy the parent and connect the sibling to the grand parent
+		if(mNodes[grandParent].mChildren[0]==parent)
+			mNodes[grandParent].mChildren[0] = sibling;
+		else
+			mNodes[grandParent].mChildren[1] = sibling;
+		mNodes[sibling].mParent = grandParent;
+		freeNode(parent);
+
+		refit(grandParent);
+	}
+	else
+	{
+		mRoot = sibling;
+		mNodes[sibling].mParent = INVALID_NODE;
+		freeNode(parent);
+	}
+}
+
+// Walks back up the tree from "index", rebalancing it and fixing the heights and bounds.
+void ObstacleTree::refit(PxU32 index)
+{
+	while(index!=INVALID_NODE)
+	{
+		index = balance(index);
+
+		Node& node = mNodes[index];
+		const Node& child0 = mNodes[node.mChildren[0]];
+		const Node& child1 = mNodes[node.mChildren[1]];
+		node.mHeight = 1 + PxMax(child0.mHeight, child1.mHeight);
+		node.mBounds = merge(child0.mBounds, child1.mBounds);
+
+		index = node.mParent;
+	}
+}
+
+// Performs a left or right rotation if node "a" is imbalanced. Returns the new root of the subtree.
+PxU32 ObstacleTree::balance(PxU32 a)
+{
+	Node& nodeA = mNodes[a];
+	if(nodeA.isLeaf() || nodeA.mHeight<2)
+		return a;
+
+	const PxU32 b = nodeA.mChildren[0];
+	const PxU32 c = nodeA.mChildren[1];
+	Node& nodeB = mNodes[b];
+	Node& nodeC = mNodes[c];
+
+	const PxI32 imbalance = PxI32(nodeC.mHeight) - PxI32(nodeB.mHeight);
+
+	// Rotate C up
+	if(imbalance>1)
+	{
+		const PxU32 f = nodeC.mChildren[0];
+		const PxU32 g = nodeC.mChildren[1];
+		Node& nodeF = mNodes[f];
+		Node& nodeG = mNodes[g];
+
+		// Swap A and C
+		nodeC.mChildren[0] = a;
+		nodeC.mParent = nodeA.mParent;
+		nodeA.mParent = c;
+
+		// A's old parent should point to C
+		if(nodeC.mParent!=INVALID_NODE)
+		{
+			if(mNodes[nodeC.mParent].mChildren[0]==a)
+				mNodes[nodeC.mParent].mChildren[0] = c;
+			else
+				mNodes[nodeC.mParent].mChildren[1] = c;
+		}
+		else
+		{
+			mRoot = c;
+		}
+
+		// Rotate
+		if(nodeF.mHeight>nodeG.mHeight)
+		{
+			nodeC.mChildren[1] = f;
+			nodeA.mChildren[1] = g;
+			nodeG.mParent = a;
+			nodeA.mBounds = merge(nodeB.mBounds, nodeG.mBounds);
+			nodeC.mBounds = merge(nodeA.mBounds, nodeF.mBounds);
+			nodeA.mHeight = 1 + PxMax(nodeB.mHeight, nodeG.mHeight);
+			nodeC.mHeight = 1 + PxMax(nodeA.mHeight, nodeF.mHeight);
+		}
+		else
+		{
+			nodeC.mChildren[1] = g;
+			nodeA.mChildren[1] = f;
+			nodeF.mParent = a;
+			nodeA.mBounds = merge(nodeB.mBounds, nodeF.mBounds);
+			nodeC.mBounds = merge(nodeA.mBounds, nodeG.mBounds);
+			nodeA.mHeight = 1 + PxMax(nodeB.mHeight, nodeF.mHeight);
+			nodeC.mHeight = 1 + PxMax(nodeA.mHeight, nodeG.mHeight);
+		}
+		return c;
+	}
+
+	// Rotate B up
+	if(imbalance<-1)
+	{
+		const PxU32 d = nodeB.mChildren[0];
+		const PxU32 e = nodeB.mChildren[1];
+		Node& nodeD = mNodes[d];
+		Node& nodeE = mNodes[e];
+
+		// Swap A and B
+		nodeB.mChildren[0] = a;
+		nodeB.mParent = nodeA.mParent;
+		nodeA.mParent = b;
+
+		// A's old parent should point to B
+		if(nodeB.mParent!=INVALID_NODE)
+		{
+			if(mNodes[nodeB.mParent].mChildren[0]==a)
+				mNodes[nodeB.mParent].mChildren[0] = b;
+			else
+				mNodes[nodeB.mParent].mChildren[1] = b;
+		}
+		else
+		{
+			mRoot = b;
+		}
+
+		// Rotate
+		if(nodeD.mHeight>nodeE.mHeight)
+		{
+			nodeB.mChildren[1] = d;
+			nodeA.mChildren[0] = e;
+			nodeE.mParent = a;
+			nodeA.mBounds = merge(nodeC.mBounds, nodeE.mBounds);
+			nodeB.mBounds = merge(nodeA.mBounds, nodeD.mBounds);
+			nodeA.mHeight = 1 + PxMax(nodeC.mHeight, nodeE.mHeight);
+			nodeB.mHeight = 1 + PxMax(nodeA.mHeight, nodeD.mHeight);
+		}
+		else
+		{
+			nodeB.mChildren[1] = e;
+			nodeA.mChildren[0] = d;
+			nodeD.mParent = a;
+			nodeA.mBounds = merge(nodeC.mBounds, nodeD.mBounds);
+			nodeB.mBounds = merge(nodeA.mBounds, nodeE.mBounds);
+			nodeA.mHeight = 1 + PxMax(nodeC.mHeight, nodeD.mHeight);
+			nodeB.mHeight = 1 + PxMax(nodeA.mHeight, nodeE.mHeight);
+		}
+		return b;
+	}
+
+	return a;
+}
+
+bool ObstacleTree::rayAABB(const PxVec3& origin, const PxVec3& oneOverDir, PxReal maxDist, const PxBounds3& bounds)
+{
+	PxReal tMin = 0.0f;
+	PxReal tMax = maxDist;
+	for(PxU32 i=0;i<3;i++)
+	{
+		PxReal t0 = (bounds.minimum[i] - origin[i]) * oneOverDir[i];
+		PxReal t1 = (bounds.maximum[i] - origin[i]) * oneOverDir[i];
+		if(t0>t1)
+		{
+			const PxReal tmp = t0;
+			t0 = t1;
+			t1 = tmp;
+		}
+		tMin = PxMax(tMin, t0);
+		tMax = PxMin(tMax, t1);
+		if(tMin>tMax)
+			return false;
+	}
+	return true;
+}
@@ -0,0 +1,149 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#ifndef CCT_OBSTACLE_TREE
+#define CCT_OBSTACLE_TREE
+
+/* Exclude from documentation */
+/** \cond */
+
+#include "characterkinematic/PxControllerObstacles.h"
+#include "foundation/PxBounds3.h"
+#include "PsArray.h"
+#include "CmPhysXCommon.h"
+
+namespace physx
+{
+namespace Cct
+{
+	// Small dynamic AABB tree for obstacles. Leaves store enlarged bounds, so that obstacles moving a little do not
+	// modify the tree. Leaf indices remain valid until the leaf is removed.
+	class ObstacleTree
+	{
+		public:
+								ObstacleTree();
+								~ObstacleTree();
+
+				PxU32			addObject(const PxBounds3& bounds, ObstacleHandle handle);
+				void			removeObject(PxU32 leaf);
+				void			updateObject(PxU32 leaf, const PxBounds3& bounds);
+				void			shift(const PxVec3& shift);
+
+		// Calls "callback(handle)" for all objects whose bounds overlap the query bounds.
+		template<class Callback>
+				void			overlap(const PxBounds3& bounds, Callback& callback)	const
+				{
+					if(mRoot==INVALID_NODE)
+						return;
+
+					PxU32 stack[64];
+					PxU32 nb = 0;
+					stack[nb++] = mRoot;
+					while(nb)
+					{
+						const Node& node = mNodes[stack[--nb]];
+						if(!node.mBounds.intersects(bounds))
+							continue;
+
+						if(node.isLeaf())
+							callback(node.mHandle);
+						else
+						{
+							PX_ASSERT(nb+2<=64);
+							stack[nb++] = node.mChildren[0];
+							stack[nb++] = node.mChildren[1];
+						}
+					}
+				}
+
+		// Calls "callback(handle, maxDist)" for all objects whose bounds are touched by the ray. Callbacks can shrink
+		// maxDist to the closest hit found so far.
+		template<class Callback>
+				void			raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal maxDist, Callback& callback)	const
+				{
+					if(mRoot==INVALID_NODE)
+						return;
+
+					const PxVec3 oneOverDir(	unitDir.x!=0.0f ? 1.0f/unitDir.x : PX_MAX_F32,
+												unitDir.y!=0.0f ? 1.0f/unitDir.y : PX_MAX_F32,
+												unitDir.z!=0.0f ? 1.0f/unitDir.z : PX_MAX_F32);
+
+					PxU32 stack[64];
+					PxU32 nb = 0;
+					stack[nb++] = mRoot;
+					while(nb)
+					{
+						const Node& node = mNodes[stack[--nb]];
+						if(!rayAABB(origin, oneOverDir, maxDist, node.mBounds))
+							continue;
+
+						if(node.isLeaf())
+							callback(node.mHandle, maxDist);
+						else
+						{
+							PX_ASSERT(nb+2<=64);
+							stack[nb++] = node.mChildren[0];
+							stack[nb++] = node.mChildren[1];
+						}
+					}
+				}
+
+		private:
+				enum { INVALID_NODE = 0xffffffff };
+
+				struct Node
+				{
+					PX_FORCE_INLINE	bool	isLeaf()	const	{ return mChildren[0]==INVALID_NODE;	}
+
+					PxBounds3		mBounds;
+					PxU32			mParent;		// Next free node when the node is not used
+					PxU32			mChildren[2];
+					PxU32			mHeight;
+					ObstacleHandle	mHandle;
+				};
+
+				Ps::Array<Node>	mNodes;
+				PxU32			mRoot;
+				PxU32			mFreeList;
+
+				PxU32			allocateNode();
+				void			freeNode(PxU32 node);
+				void			insertLeaf(PxU32 leaf);
+				void			removeLeaf(PxU32 leaf);
+				PxU32			balance(PxU32 node);
+				void			refit(PxU32 node);
+
+		static	bool			rayAABB(const PxVec3& origin, const PxVec3& oneOverDir, PxReal maxDist, const PxBounds3& bounds);
+	};
+
+} // namespace Cct
+
+}
+
+/** \endcond */
+#endif
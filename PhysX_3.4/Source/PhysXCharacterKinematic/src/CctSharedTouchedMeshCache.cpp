@@ -0,0 +1,189 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#include "CctSharedTouchedMeshCache.h"
+#include "PxBoxGeometry.h"
+#include "PxMeshQuery.h"
+#include "extensions/PxTriangleMeshExt.h"
+#include "GuIntersectionTriangleBox.h"
+
+using namespace physx;
+using namespace Cct;
+
+// Limits for the grid cells. Larger queries are not shared.
+static const PxI32 gMinCellLevel = -4;
+static const PxI32 gMaxCellLevel = 12;
+
+SharedTouchedMeshCache::SharedTouchedMeshCache()
+{
+}
+
+SharedTouchedMeshCache::~SharedTouchedMeshCache()
+{
+	for(SharedTouchedMeshMap::Iterator iter = mSets.getIterator(); !iter.done(); ++iter)
+	{
+		SharedTouchedMesh* set = iter->second;
+		PX_DELETE(set);
+	}
+	mSets.clear();
+}
+
+static PX_FORCE_INLINE bool isStale(const SharedTouchedMesh& set, const PxTriangleMeshGeometry& meshGeom, const PxTransform& meshPose, PxU32 timestamp)
+{
+	return		!set.mValid
+			||	set.mTimestamp!=timestamp
+			||	set.mMesh!=meshGeom.triangleMesh
+			||	set.mScale.scale!=meshGeom.scale.scale
+			||	!(set.mScale.rotation==meshGeom.scale.rotation)
+			||	!(set.mMeshPose==meshPose);
+}
+
+bool SharedTouchedMeshCache::getTriangles(	const PxShape* shape, const PxTriangleMeshGeometry& meshGeom, const PxTransform& meshPose, PxU32 timestamp,
+											const PxBounds3& bounds, SharedTouchedMeshArray& refs, Ps::Array<PxTriangle>& triangles, Ps::Array<PxU32>& indices)
+{
+	const PxVec3 center = bounds.getCenter();
+	const PxVec3 extents = bounds.getExtents();
+
+	// Find the smallest cell size so that the query bounds, whose center is inside the cell, are contained in the
+	// cell inflated by half a cell on each side.
+	const float maxExtent = PxMax(extents.x, PxMax(extents.y, extents.z));
+	if(!(maxExtent>0.0f))
+		return false;
+
+	PxI32 level = PxMax(PxI32(PxCeil(PxLog(2.0f*maxExtent)/PxLog(2.0f))), gMinCellLevel);
+	float cellSize = PxPow(2.0f, float(level));
+	while(cellSize<2.0f*maxExtent)
+	{
+		cellSize *= 2.0f;
+		level++;
+	}
+	if(level>gMaxCellLevel)
+		return false;
+
+	SharedTouchedMeshKey key;
+	key.mShape	= shape;
+	key.mLevel	= level;
+	for(PxU32 i=0;i<3;i++)
+	{
+		const float cell = PxFloor(center[i]/cellSize);
+		if(PxAbs(cell)>1e9f)
+			return false;
+		key.mCell[i] = PxI32(cell);
+	}
+
+	Ps::Mutex::ScopedLock lock(mMutex);
+
+	SharedTouchedMesh* set;
+	{
+		const SharedTouchedMeshMap::Entry* entry = mSets.find(key);
+		if(entry)
+		{
+			set = entry->second;
+		}
+		else
+		{
+			set = PX_NEW(SharedTouchedMesh);
+			set->mKey		= key;
+			set->mMesh		= NULL;
+			set->mTimestamp	= 0;
+			set->mValid		= false;
+			set->mRefCount	= 0;
+			mSets.insert(key, set);
+		}
+	}
+
+	if(isStale(*set, meshGeom, meshPose, timestamp))
+	{
+		const PxVec3 cellCenter(	(float(key.mCell[0])+0.5f)*cellSize,
+									(float(key.mCell[1])+0.5f)*cellSize,
+									(float(key.mCell[2])+0.5f)*cellSize);
+
+		PxMeshOverlapUtil overlapUtil;
+		const PxU32 nbTouchedTris = overlapUtil.findOverlap(PxBoxGeometry(PxVec3(cellSize)), PxTransform(cellCenter), meshGeom, meshPose);
+		const PxU32* PX_RESTRICT touchedIndices = overlapUtil.getResults();
+
+		set->mTriangles.resizeUninitialized(nbTouchedTris);
+		set->mIndices.resizeUninitialized(nbTouchedTris);
+		for(PxU32 i=0;i<nbTouchedTris;i++)
+		{
+			set->mIndices[i] = touchedIndices[i];
+			PxMeshQuery::getTriangle(meshGeom, meshPose, touchedIndices[i], set->mTriangles[i]);
+		}
+
+		set->mMeshPose	= meshPose;
+		set->mMesh		= meshGeom.triangleMesh;
+		set->mScale		= meshGeom.scale;
+		set->mTimestamp	= timestamp;
+		set->mValid		= true;
+	}
+
+	// Cull the shared triangles against the query bounds
+	const PxU32 nbTris = set->mTriangles.size();
+	const PxTriangle* PX_RESTRICT tris = set->mTriangles.begin();
+	for(PxU32 i=0;i<nbTris;i++)
+	{
+		if(Gu::intersectTriangleBox_ReferenceCode(center, extents, tris[i].verts[0], tris[i].verts[1], tris[i].verts[2]))
+		{
+			triangles.pushBack(tris[i]);
+			indices.pushBack(set->mIndices[i]);
+		}
+	}
+
+	set->mRefCount++;
+	refs.pushBack(set);
+	return true;
+}
+
+void SharedTouchedMeshCache::release(SharedTouchedMeshArray& refs, PxU32 nb)
+{
+	PX_ASSERT(nb<=refs.size());
+	if(!nb)
+		return;
+
+	Ps::Mutex::ScopedLock lock(mMutex);
+
+	for(PxU32 i=0;i<nb;i++)
+	{
+		SharedTouchedMesh* set = refs[i];
+		PX_ASSERT(set->mRefCount);
+		if(!--set->mRefCount)
+		{
+			mSets.erase(set->mKey);
+			PX_DELETE(set);
+		}
+	}
+	refs.removeRange(0, nb);
+}
+
+void SharedTouchedMeshCache::invalidate()
+{
+	Ps::Mutex::ScopedLock lock(mMutex);
+
+	for(SharedTouchedMeshMap::Iterator iter = mSets.getIterator(); !iter.done(); ++iter)
+		iter->second->mValid = false;
+}
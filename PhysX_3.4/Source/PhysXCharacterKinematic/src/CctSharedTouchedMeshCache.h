@@ -0,0 +1,124 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#ifndef CCT_SHARED_TOUCHED_MESH_CACHE
+#define CCT_SHARED_TOUCHED_MESH_CACHE
+
+#include "CmPhysXCommon.h"
+#include "PxTriangle.h"
+#include "PxTriangleMeshGeometry.h"
+#include "foundation/PxBounds3.h"
+#include "foundation/PxTransform.h"
+#include "PsArray.h"
+#include "PsHashMap.h"
+#include "PsMutex.h"
+#include "PsUserAllocated.h"
+
+namespace physx
+{
+	class PxShape;
+
+namespace Cct
+{
+	// A static mesh shape, and a cell of a regular grid whose size is a power of two.
+	struct SharedTouchedMeshKey
+	{
+		const PxShape*	mShape;
+		PxI32			mCell[3];
+		PxI32			mLevel;		// Log2 of the cell size
+	};
+
+	struct SharedTouchedMeshKeyHash
+	{
+		PX_FORCE_INLINE uint32_t operator()(const SharedTouchedMeshKey& key) const
+		{
+			const PxU32 h0 = Ps::hash(static_cast<const void*>(key.mShape));
+			const PxU32 h1 = Ps::hash(PxU64(PxU32(key.mCell[0])) | (PxU64(PxU32(key.mCell[1]))<<32));
+			const PxU32 h2 = Ps::hash(PxU64(PxU32(key.mCell[2])) | (PxU64(PxU32(key.mLevel))<<32));
+			return h0 ^ (h1 * 31) ^ (h2 * 131);
+		}
+		PX_FORCE_INLINE bool equal(const SharedTouchedMeshKey& k0, const SharedTouchedMeshKey& k1) const
+		{
+			return		k0.mShape==k1.mShape
+					&&	k0.mCell[0]==k1.mCell[0] && k0.mCell[1]==k1.mCell[1] && k0.mCell[2]==k1.mCell[2]
+					&&	k0.mLevel==k1.mLevel;
+		}
+	};
+
+	// World-space triangles of a static mesh shape touched by a grid cell. The set is shared by all characters whose
+	// cached volume falls within the cell, and released when the last of them refills its cache somewhere else.
+	struct SharedTouchedMesh : public Ps::UserAllocated
+	{
+		SharedTouchedMeshKey	mKey;
+		Ps::Array<PxTriangle>	mTriangles;
+		Ps::Array<PxU32>		mIndices;
+
+		// Data used to detect stale sets
+		PxTransform				mMeshPose;
+		PxTriangleMesh*			mMesh;
+		PxMeshScale				mScale;
+		PxU32					mTimestamp;
+		bool					mValid;
+
+		PxU32					mRefCount;
+	};
+
+	typedef Ps::Array<SharedTouchedMesh*>	SharedTouchedMeshArray;
+
+	// Manager-level cache of the triangles touched by characters on static meshes. This replaces the per-character
+	// mesh queries with a single query per grid cell, which pays off when many characters stand on the same geometry.
+	// All functions are thread-safe, so that controllers can be moved concurrently.
+	class SharedTouchedMeshCache
+	{
+	public:
+									SharedTouchedMeshCache();
+									~SharedTouchedMeshCache();
+
+		// Gathers the triangles of a static mesh shape overlapping "bounds", in world space. The shared set the triangles
+		// come from is appended to "refs". Returns false if the query could not be served from the cache, in which case
+		// the caller should query the mesh itself.
+				bool				getTriangles(	const PxShape* shape, const PxTriangleMeshGeometry& meshGeom, const PxTransform& meshPose, PxU32 timestamp,
+													const PxBounds3& bounds, SharedTouchedMeshArray& refs, Ps::Array<PxTriangle>& triangles, Ps::Array<PxU32>& indices);
+
+		// Releases the first "nb" references of the array and removes them from it.
+				void				release(SharedTouchedMeshArray& refs, PxU32 nb);
+
+		// Forces all sets to be recomputed the next time they are used, e.g. after an origin shift.
+				void				invalidate();
+	private:
+		typedef Ps::HashMap<SharedTouchedMeshKey, SharedTouchedMesh*, SharedTouchedMeshKeyHash>	SharedTouchedMeshMap;
+
+				SharedTouchedMeshMap	mSets;
+				Ps::Mutex				mMutex;
+	};
+
+} // namespace Cct
+
+}
+
+#endif
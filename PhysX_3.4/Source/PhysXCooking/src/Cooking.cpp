@@ -50,6 +50,9 @@
 #include "HeightFieldCooking.h"
 #include "common/PxPhysicsInsertionCallback.h"
 #include "CmUtils.h"
+#include "CmTask.h"
+#include "PsAtomic.h"
+#include "CookingCache.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -136,6 +139,34 @@ bool Cooking::cookTriangleMesh(TriangleMeshBuilder& builder, const PxTriangleMes
 
 bool Cooking::cookTriangleMesh(const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition) const
 {
+	PxCookingCache* cache = mParams.cache;
+	if(!cache)
+		return cookTriangleMeshUncached(desc, stream, condition);
+
+	PxCookingCacheKey key;
+	computeCookingCacheKey(desc, mParams, key);
+
+	CookingCacheReader reader(stream);
+	if(cache->load(key, reader) && reader.isValid())
+	{
+		if(condition)
+			*condition = PxTriangleMeshCookingResult::Enum(reader.getCondition());
+		return true;
+	}
+
+	CookingCacheRecorder recorder(stream);
+	PxTriangleMeshCookingResult::Enum result = PxTriangleMeshCookingResult::eSUCCESS;
+	const bool status = cookTriangleMeshUncached(desc, recorder, &result);
+	if(status)
+		recorder.store(*cache, key, PxU32(result));
+	if(condition)
+		*condition = result;
+	return status;
+}
+
+bool Cooking::cookTriangleMeshUncached(const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition) const
+{
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eCOOKING);
 	if((mParams.midphaseDesc.getType() == PxMeshMidPhase::eINVALID) || (mParams.midphaseDesc.getType() == PxMeshMidPhase::eBVH33))
 	{
 		RTreeTriangleMeshBuilder builder(mParams);
@@ -192,6 +223,7 @@ PxTriangleMesh* Cooking::createTriangleMesh(const PxTriangleMeshDesc& desc, PxPh
 bool Cooking::cookConvexMeshInternal(const PxConvexMeshDesc& desc_, ConvexMeshBuilder& meshBuilder, ConvexHullLib* hullLib,
 	PxConvexMeshCookingResult::Enum* condition) const
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eCOOKING);
 	if (condition)
 		*condition = PxConvexMeshCookingResult::eFAILURE;
 
@@ -270,7 +302,39 @@ bool Cooking::cookConvexMeshInternal(const PxConvexMeshDesc& desc_, ConvexMeshBu
 
 //////////////////////////////////////////////////////////////////////////
 // cook convex mesh from given desc, save the results into stream
-bool Cooking::cookConvexMesh(const PxConvexMeshDesc& desc_, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition) const
+bool Cooking::cookConvexMesh(const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition) const
+{
+	return cookConvexMesh(desc, stream, condition, NULL);
+}
+
+bool Cooking::cookConvexMesh(const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition, QuickHullScratch* scratch) const
+{
+	PxCookingCache* cache = mParams.cache;
+	if(!cache)
+		return cookConvexMeshUncached(desc, stream, condition, scratch);
+
+	PxCookingCacheKey key;
+	computeCookingCacheKey(desc, mParams, key);
+
+	CookingCacheReader reader(stream);
+	if(cache->load(key, reader) && reader.isValid())
+	{
+		if(condition)
+			*condition = PxConvexMeshCookingResult::Enum(reader.getCondition());
+		return true;
+	}
+
+	CookingCacheRecorder recorder(stream);
+	PxConvexMeshCookingResult::Enum result = PxConvexMeshCookingResult::eSUCCESS;
+	const bool status = cookConvexMeshUncached(desc, recorder, &result, scratch);
+	if(status)
+		recorder.store(*cache, key, PxU32(result));
+	if(condition)
+		*condition = result;
+	return status;
+}
+
+bool Cooking::cookConvexMeshUncached(const PxConvexMeshDesc& desc_, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition, QuickHullScratch* scratch) const
 {	
 	PX_FPU_GUARD;
 	// choose cooking library if needed
@@ -291,6 +355,10 @@ bool Cooking::cookConvexMesh(const PxConvexMeshDesc& desc_, PxOutputStream& stre
 		{
 			hullLib = PX_NEW(InflationConvexHullLib) (desc, mParams);			
 		}
+		else if(scratch)
+		{
+			hullLib = PX_NEW(QuickHullConvexHullLib) (desc, mParams, *scratch);
+		}
 		else
 		{
 			hullLib = PX_NEW(QuickHullConvexHullLib) (desc, mParams);			
@@ -322,11 +390,64 @@ bool Cooking::cookConvexMesh(const PxConvexMeshDesc& desc_, PxOutputStream& stre
 	return true;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// cook a batch of convex meshes, each job pulls meshes from a shared counter until
+// none is left so that its quickhull scratch memory is reused by all the meshes it cooks
+namespace
+{
+	class CookConvexMeshesJob
+	{
+		PX_NOCOPY(CookConvexMeshesJob)
+	public:
+		CookConvexMeshesJob(const Cooking& cooking, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions) :
+			mCooking(cooking), mNbMeshes(PxI32(nbMeshes)), mDescs(descs), mStreams(streams), mConditions(conditions), mNextMesh(0), mNbFailures(0)
+		{
+		}
+
+		void operator()(PxU32)
+		{
+			Ps::AllocationScope allocScope(Ps::AllocationCategory::eCOOKING);
+			QuickHullScratch scratch;
+			PxI32 index;
+			while((index = Ps::atomicIncrement(&mNextMesh) - 1) < mNbMeshes)
+			{
+				if(!mCooking.cookConvexMesh(mDescs[index], *mStreams[index], mConditions ? mConditions + index : NULL, &scratch))
+					Ps::atomicIncrement(&mNbFailures);
+			}
+		}
+
+		const Cooking&							mCooking;
+		const PxI32								mNbMeshes;
+		const PxConvexMeshDesc*					mDescs;
+		PxOutputStream* const*					mStreams;
+		PxConvexMeshCookingResult::Enum*		mConditions;
+		volatile PxI32							mNextMesh;
+		volatile PxI32							mNbFailures;
+	};
+}
+
+bool Cooking::cookConvexMeshes(PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions) const
+{
+	if(nbMeshes && (!descs || !streams))
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "Cooking::cookConvexMeshes: descs and streams must not be NULL!");
+		return false;
+	}
+
+	PxCpuDispatcher* dispatcher = mParams.cpuDispatcher;
+	const PxU32 nbJobs = dispatcher ? PxMin(nbMeshes, dispatcher->getWorkerCount() + 1) : PxMin(nbMeshes, 1u);
+
+	CookConvexMeshesJob job(*this, nbMeshes, descs, streams, conditions);
+	Cm::runParallelJobs(dispatcher, nbJobs, job);
+	return job.mNbFailures == 0;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // cook convex mesh from given desc, copy the results into internal convex mesh
 // and insert the mesh into PxPhysics
 PxConvexMesh* Cooking::createConvexMesh(const PxConvexMeshDesc& desc_, PxPhysicsInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* condition) const
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eCOOKING);
 	PX_FPU_GUARD;
 	// choose cooking library if needed
 	ConvexHullLib* hullLib = NULL;	
@@ -440,6 +561,7 @@ bool Cooking::computeHullPolygons(const PxSimpleTriangleMesh& mesh, PxAllocatorC
 
 bool Cooking::cookHeightField(const PxHeightFieldDesc& desc, PxOutputStream& stream) const
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eCOOKING);
 	PX_FPU_GUARD;
 
 	if(!desc.isValid())
@@ -473,6 +595,7 @@ bool Cooking::cookHeightField(const PxHeightFieldDesc& desc, PxOutputStream& str
 
 PxHeightField* Cooking::createHeightField(const PxHeightFieldDesc& desc, PxPhysicsInsertionCallback& insertionCallback) const
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eCOOKING);
 	PX_FPU_GUARD;
 
 	if(!desc.isValid())
@@ -39,6 +39,7 @@ namespace physx
 class TriangleMeshBuilder;
 class ConvexMeshBuilder;
 class ConvexHullLib;
+class QuickHullScratch;
 
 class Cooking: public PxCooking, public Ps::UserAllocated
 {
@@ -54,6 +55,7 @@ public:
 	virtual bool					validateTriangleMesh(const PxTriangleMeshDesc& desc) const;
 
 	virtual bool					cookConvexMesh(const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition) const;
+	virtual bool					cookConvexMeshes(PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions) const;
 	virtual PxConvexMesh*			createConvexMesh(const PxConvexMeshDesc& desc, PxPhysicsInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* condition) const;
 	virtual bool					validateConvexMesh(const PxConvexMeshDesc& desc) const;
 	virtual bool					computeHullPolygons(const PxSimpleTriangleMesh& mesh, PxAllocatorCallback& inCallback,PxU32& nbVerts, PxVec3*& vertices,
@@ -61,6 +63,9 @@ public:
 	virtual bool					cookHeightField(const PxHeightFieldDesc& desc, PxOutputStream& stream) const;
 	virtual PxHeightField*			createHeightField(const PxHeightFieldDesc& desc, PxPhysicsInsertionCallback& insertionCallback) const;
 
+	// cookConvexMesh() computing the hull in the given scratch memory, if any
+	bool							cookConvexMesh(const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition, QuickHullScratch* scratch) const;
+
 	PX_FORCE_INLINE static void		gatherStrided(const void* src, void* dst, PxU32 nbElem, PxU32 elemSize, PxU32 stride)
 	{
 		const PxU8* s = reinterpret_cast<const PxU8*>(src);
@@ -74,6 +79,8 @@ public:
 	}
 
 private:
+	bool							cookTriangleMeshUncached(const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition) const;
+	bool							cookConvexMeshUncached(const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition, QuickHullScratch* scratch) const;
 	bool							cookConvexMeshInternal(const PxConvexMeshDesc& desc, ConvexMeshBuilder& meshBuilder, ConvexHullLib* hullLib, PxConvexMeshCookingResult::Enum* condition) const;
 	bool							cookTriangleMesh(TriangleMeshBuilder& builder, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition) const;
 	PxTriangleMesh*					createTriangleMesh(TriangleMeshBuilder& builder, const PxTriangleMeshDesc& desc, PxPhysicsInsertionCallback& insertionCallback, PxTriangleMeshCookingResult::Enum* condition) const;
@@ -0,0 +1,280 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#include "CookingCache.h"
+#include "PxPhysicsVersion.h"
+#include "foundation/PxMemory.h"
+
+using namespace physx;
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	const PxU64 C1 = 0x87c37b91114253d5ull;
+	const PxU64 C2 = 0x4cf5ad432745937full;
+
+	PX_FORCE_INLINE PxU64 rotl64(PxU64 x, PxU32 r)
+	{
+		return (x << r) | (x >> (64 - r));
+	}
+
+	PX_FORCE_INLINE PxU64 fmix64(PxU64 k)
+	{
+		k ^= k >> 33;
+		k *= 0xff51afd7ed558ccdull;
+		k ^= k >> 33;
+		k *= 0xc4ceb9fe1a85ec53ull;
+		k ^= k >> 33;
+		return k;
+	}
+
+	PX_FORCE_INLINE PxU64 readU64(const PxU8* p)
+	{
+		PxU64 v;
+		PxMemCopy(&v, p, sizeof(PxU64));
+		return v;
+	}
+}
+
+CookingHash::CookingHash() : mH1(0x9e3779b97f4a7c15ull), mH2(0x6a09e667f3bcc909ull), mLength(0), mBufferSize(0)
+{
+}
+
+void CookingHash::mixBlock(const PxU8* block)
+{
+	PxU64 k1 = readU64(block);
+	PxU64 k2 = readU64(block + 8);
+
+	k1 *= C1; k1 = rotl64(k1, 31); k1 *= C2; mH1 ^= k1;
+	mH1 = rotl64(mH1, 27); mH1 += mH2; mH1 = mH1*5 + 0x52dce729;
+
+	k2 *= C2; k2 = rotl64(k2, 33); k2 *= C1; mH2 ^= k2;
+	mH2 = rotl64(mH2, 31); mH2 += mH1; mH2 = mH2*5 + 0x38495ab5;
+}
+
+void CookingHash::add(const void* data, PxU32 size)
+{
+	const PxU8* bytes = reinterpret_cast<const PxU8*>(data);
+	mLength += size;
+
+	if(mBufferSize)
+	{
+		const PxU32 n = PxMin(size, 16 - mBufferSize);
+		PxMemCopy(mBuffer + mBufferSize, bytes, n);
+		mBufferSize += n;
+		bytes += n;
+		size -= n;
+		if(mBufferSize < 16)
+			return;
+		mixBlock(mBuffer);
+		mBufferSize = 0;
+	}
+
+	while(size >= 16)
+	{
+		mixBlock(bytes);
+		bytes += 16;
+		size -= 16;
+	}
+
+	if(size)
+	{
+		PxMemCopy(mBuffer, bytes, size);
+		mBufferSize = size;
+	}
+}
+
+void CookingHash::addStrided(const void* data, PxU32 count, PxU32 elemSize, PxU32 stride)
+{
+	addU32(count);
+	if(!data)
+	{
+		addU32(0);
+		return;
+	}
+	addU32(1);
+
+	const PxU8* bytes = reinterpret_cast<const PxU8*>(data);
+	if(stride == elemSize)
+	{
+		add(bytes, count*elemSize);
+		return;
+	}
+	for(PxU32 i=0;i<count;i++)
+		add(bytes + i*stride, elemSize);
+}
+
+void CookingHash::finalize(PxCookingCacheKey& key)
+{
+	// tail, zero-padded, followed by the standard finalization
+	if(mBufferSize)
+	{
+		PxMemZero(mBuffer + mBufferSize, 16 - mBufferSize);
+		mixBlock(mBuffer);
+		mBufferSize = 0;
+	}
+
+	PxU64 h1 = mH1 ^ mLength;
+	PxU64 h2 = mH2 ^ mLength;
+	h1 += h2;
+	h2 += h1;
+	h1 = fmix64(h1);
+	h2 = fmix64(h2);
+	h1 += h2;
+	h2 += h1;
+
+	key.hash[0] = h1;
+	key.hash[1] = h2;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	enum CookingCacheKeyType
+	{
+		eKEY_TRIANGLE_MESH	= 1,
+		eKEY_CONVEX_MESH	= 2
+	};
+
+	// all the parameters affecting the cooked data. The dispatcher, scratch memory and cache only affect how it is computed.
+	void hashParams(CookingHash& hash, const PxCookingParams& params)
+	{
+		hash.addU32(PX_PHYSICS_VERSION);
+		hash.addU32(PxU32(params.targetPlatform));
+		hash.addFloat(params.skinWidth);
+		hash.addFloat(params.areaTestEpsilon);
+		hash.addFloat(params.planeTolerance);
+		hash.addU32(PxU32(params.convexMeshCookingType));
+		hash.addU32(PxU32(params.suppressTriangleMeshRemapTable));
+		hash.addU32(PxU32(params.buildTriangleAdjacencies));
+		hash.addU32(PxU32(params.buildGPUData));
+		hash.addFloat(params.scale.length);
+		hash.addFloat(params.scale.mass);
+		hash.addFloat(params.scale.speed);
+		hash.addU32(PxU32(params.meshPreprocessParams));
+		hash.addU32(PxU32(params.meshCookingHint));
+		hash.addFloat(params.meshSizePerformanceTradeOff);
+		hash.addFloat(params.meshWeldTolerance);
+		hash.addU32(PxU32(params.gaussMapLimit));
+
+		const PxMidphaseDesc& midphase = params.midphaseDesc;
+		hash.addU32(PxU32(midphase.getType()));
+		if(midphase.getType() == PxMeshMidPhase::eBVH33)
+		{
+			hash.addFloat(midphase.mBVH33Desc.meshSizePerformanceTradeOff);
+			hash.addU32(PxU32(midphase.mBVH33Desc.meshCookingHint));
+		}
+		else if(midphase.getType() == PxMeshMidPhase::eBVH34)
+		{
+			hash.addU32(midphase.mBVH34Desc.numTrisPerLeaf);
+			hash.addU32(PxU32(midphase.mBVH34Desc.buildStrategy));
+			hash.addU32(midphase.mBVH34Desc.numSAHBins);
+		}
+	}
+}
+
+void physx::computeCookingCacheKey(const PxTriangleMeshDesc& desc, const PxCookingParams& params, PxCookingCacheKey& key)
+{
+	CookingHash hash;
+	hash.addU32(eKEY_TRIANGLE_MESH);
+	hashParams(hash, params);
+
+	hash.addU32(PxU32(desc.flags));
+	hash.addStrided(desc.points.data, desc.points.count, sizeof(PxVec3), desc.points.stride);
+
+	const PxU32 triangleSize = desc.flags & PxMeshFlag::e16_BIT_INDICES ? 3*sizeof(PxU16) : 3*sizeof(PxU32);
+	hash.addStrided(desc.triangles.data, desc.triangles.count, triangleSize, desc.triangles.stride);
+	hash.addStrided(desc.materialIndices.data, desc.triangles.count, sizeof(PxMaterialTableIndex), desc.materialIndices.stride);
+
+	hash.finalize(key);
+}
+
+void physx::computeCookingCacheKey(const PxConvexMeshDesc& desc, const PxCookingParams& params, PxCookingCacheKey& key)
+{
+	CookingHash hash;
+	hash.addU32(eKEY_CONVEX_MESH);
+	hashParams(hash, params);
+
+	hash.addU32(PxU32(desc.flags));
+	hash.addU32(desc.vertexLimit);
+	hash.addU32(desc.quantizedCount);
+	hash.addStrided(desc.points.data, desc.points.count, sizeof(PxVec3), desc.points.stride);
+	hash.addStrided(desc.polygons.data, desc.polygons.count, sizeof(PxHullPolygon), desc.polygons.stride);
+
+	const PxU32 indexSize = desc.flags & PxConvexFlag::e16_BIT_INDICES ? sizeof(PxU16) : sizeof(PxU32);
+	hash.addStrided(desc.indices.data, desc.indices.count, indexSize, desc.indices.stride);
+
+	hash.finalize(key);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+CookingCacheRecorder::CookingCacheRecorder(PxOutputStream& stream) : mStream(stream)
+{
+	// room for the result code, written by store()
+	mData.resize(sizeof(PxU32), 0);
+}
+
+uint32_t CookingCacheRecorder::write(const void* src, uint32_t count)
+{
+	const uint32_t written = mStream.write(src, count);
+	const PxU32 size = mData.size();
+	if(size + written > mData.capacity())
+		mData.reserve(PxMax(size + written, 2*mData.capacity()));
+	mData.resizeUninitialized(size + written);
+	PxMemCopy(mData.begin() + size, src, written);
+	return written;
+}
+
+void CookingCacheRecorder::store(PxCookingCache& cache, const PxCookingCacheKey& key, PxU32 condition)
+{
+	for(PxU32 i=0;i<sizeof(PxU32);i++)
+		mData[i] = PxU8(condition >> (8*i));
+	cache.store(key, mData.begin(), mData.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint32_t CookingCacheReader::write(const void* src, uint32_t count)
+{
+	const PxU8* bytes = reinterpret_cast<const PxU8*>(src);
+	PxU32 consumed = 0;
+	while(mNbHeaderBytes < sizeof(PxU32) && consumed < count)
+	{
+		mCondition |= PxU32(bytes[consumed++]) << (8*mNbHeaderBytes);
+		mNbHeaderBytes++;
+	}
+
+	if(consumed == count)
+		return count;
+
+	mNbHeaderBytes = sizeof(PxU32) + 1;
+	return consumed + mStream.write(bytes + consumed, count - consumed);
+}
@@ -0,0 +1,104 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#ifndef PX_COOKING_CACHE_H
+#define PX_COOKING_CACHE_H
+
+#include "foundation/PxIO.h"
+#include "PxCooking.h"
+#include "CmPhysXCommon.h"
+#include "PsArray.h"
+
+namespace physx
+{
+	// Streaming 128-bit hash of the cooking inputs, based on the MurmurHash3 x64 128-bit block mix
+	class CookingHash
+	{
+	public:
+								CookingHash();
+
+				void			add(const void* data, PxU32 size);
+				// hashes count elements of elemSize bytes, stride bytes apart
+				void			addStrided(const void* data, PxU32 count, PxU32 elemSize, PxU32 stride);
+				void			finalize(PxCookingCacheKey& key);
+
+		PX_FORCE_INLINE	void	addU32(PxU32 value)		{ add(&value, sizeof(PxU32));	}
+		PX_FORCE_INLINE	void	addFloat(PxF32 value)	{ add(&value, sizeof(PxF32));	}
+
+	private:
+				void			mixBlock(const PxU8* block);
+
+				PxU64			mH1;
+				PxU64			mH2;
+				PxU64			mLength;
+				PxU8			mBuffer[16];
+				PxU32			mBufferSize;
+	};
+
+	void	computeCookingCacheKey(const PxTriangleMeshDesc& desc, const PxCookingParams& params, PxCookingCacheKey& key);
+	void	computeCookingCacheKey(const PxConvexMeshDesc& desc, const PxCookingParams& params, PxCookingCacheKey& key);
+
+	// Cached data is the cooking result code followed by the cooked stream.
+
+	// Forwards the cooked stream to the user stream and records it for PxCookingCache::store()
+	class CookingCacheRecorder : public PxOutputStream
+	{
+		PX_NOCOPY(CookingCacheRecorder)
+	public:
+								CookingCacheRecorder(PxOutputStream& stream);
+
+		virtual	uint32_t		write(const void* src, uint32_t count);
+
+				void			store(PxCookingCache& cache, const PxCookingCacheKey& key, PxU32 condition);
+
+	private:
+				PxOutputStream&	mStream;
+				Ps::Array<PxU8>	mData;
+	};
+
+	// Receives the data returned by PxCookingCache::load(): extracts the result code and forwards the cooked stream
+	class CookingCacheReader : public PxOutputStream
+	{
+		PX_NOCOPY(CookingCacheReader)
+	public:
+								CookingCacheReader(PxOutputStream& stream) : mStream(stream), mNbHeaderBytes(0), mCondition(0)	{}
+
+		virtual	uint32_t		write(const void* src, uint32_t count);
+
+		// true once the result code and at least one byte of cooked data have been received
+		PX_FORCE_INLINE	bool	isValid()		const	{ return mNbHeaderBytes > sizeof(PxU32);	}
+		PX_FORCE_INLINE	PxU32	getCondition()	const	{ return mCondition;	}
+
+	private:
+				PxOutputStream&	mStream;
+				PxU32			mNbHeaderBytes;
+				PxU32			mCondition;
+	};
+}
+
+#endif // PX_COOKING_CACHE_H
@@ -0,0 +1,124 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_COOKING_SCRATCH_H
+#define PX_COOKING_SCRATCH_H
+
+#include "foundation/PxAssert.h"
+#include "PsAllocator.h"
+
+namespace physx
+{
+	// Stack allocator carving temporary cooking buffers out of the user block provided in PxCookingParams::scratchMemory.
+	// Allocations are 16-byte aligned and should be released in reverse order. Out-of-order frees are supported but the
+	// memory is only reclaimed once the allocations above it have been released. Requests that do not fit in the block
+	// fall back to the heap. Not thread-safe: one allocator must only be used by one cooking call at a time.
+	class CookingScratchAllocator
+	{
+		PX_NOCOPY(CookingScratchAllocator)
+		enum { MAX_NB_ALLOCS = 32 };
+	public:
+		CookingScratchAllocator(void* addr, PxU32 size) : mNbAllocs(0)
+		{
+			PX_ASSERT(!(size_t(addr) & 15));
+			mStart = reinterpret_cast<PxU8*>(addr);
+			mSize = addr ? size : 0;
+			mStack[0] = mStart + mSize;
+		}
+
+		~CookingScratchAllocator()
+		{
+			PX_ASSERT(mNbAllocs==0);
+		}
+
+		void* alloc(PxU32 requestedSize, const char* name)
+		{
+			requestedSize = (requestedSize+15)&~15;
+
+			PxU8* top = mStack[mNbAllocs];
+			if(mNbAllocs<MAX_NB_ALLOCS && top - mStart >= ptrdiff_t(requestedSize))
+			{
+				PxU8* addr = top - requestedSize;
+				mStack[++mNbAllocs] = addr;
+				return addr;
+			}
+			return PX_ALLOC_TEMP(requestedSize, name);
+		}
+
+		void free(void* addr)
+		{
+			if(!addr)
+				return;
+
+			if(!isScratchAddr(addr))
+			{
+				PX_FREE(addr);
+				return;
+			}
+
+			PX_ASSERT(mNbAllocs>0);
+			PxU32 i = mNbAllocs;
+			while(mStack[i]<addr)
+				i--;
+
+			PX_ASSERT(i>0 && mStack[i]==addr);
+			for(; i<mNbAllocs; i++)
+				mStack[i] = mStack[i+1];
+			mNbAllocs--;
+		}
+
+		bool isScratchAddr(const void* addr) const
+		{
+			const PxU8* a = reinterpret_cast<const PxU8*>(addr);
+			return a>=mStart && a<mStart+mSize;
+		}
+
+	private:
+		PxU8*	mStack[MAX_NB_ALLOCS+1];
+		PxU8*	mStart;
+		PxU32	mSize;
+		PxU32	mNbAllocs;
+	};
+
+	// Helpers for code paths where the scratch allocator is optional.
+	PX_FORCE_INLINE void* cookingScratchAlloc(CookingScratchAllocator* scratch, PxU32 size, const char* name)
+	{
+		return scratch ? scratch->alloc(size, name) : PX_ALLOC_TEMP(size, name);
+	}
+
+	PX_FORCE_INLINE void cookingScratchFree(CookingScratchAllocator* scratch, void* addr)
+	{
+		if(scratch)
+			scratch->free(addr);
+		else if(addr)
+			PX_FREE(addr);
+	}
+}
+
+#endif // PX_COOKING_SCRATCH_H
@@ -30,6 +30,7 @@
 
 #include "foundation/PxMemory.h"
 #include "EdgeList.h"
+#include "CookingScratch.h"
 #include "PxTriangle.h"
 #include "PsMathUtils.h"
 #include "CmRadixSortBuffered.h"
@@ -100,15 +101,15 @@ bool Gu::EdgeListBuilder::init(const EDGELISTCREATE& create)
 	bool EdgesToFaces = create.Verts ? true : create.EdgesToFaces;
 
 	// "FacesToEdges" maps each face to three edges.
-	if(FacesToEdges && !createFacesToEdges(create.NbFaces, create.DFaces, create.WFaces))
+	if(FacesToEdges && !createFacesToEdges(create.NbFaces, create.DFaces, create.WFaces, create.Scratch))
 		return false;
 
 	// "EdgesToFaces" maps each edge to the set of faces sharing this edge
-	if(EdgesToFaces && !createEdgesToFaces(create.NbFaces, create.DFaces, create.WFaces))
+	if(EdgesToFaces && !createEdgesToFaces(create.NbFaces, create.DFaces, create.WFaces, create.Scratch))
 		return false;
 
 	// Create active edges
-	if(create.Verts && !computeActiveEdges(create.NbFaces, create.DFaces, create.WFaces, create.Verts, create.Epsilon))
+	if(create.Verts && !computeActiveEdges(create.NbFaces, create.DFaces, create.WFaces, create.Verts, create.Epsilon, create.Scratch))
 		return false;
 
 	// Get rid of useless data
@@ -136,10 +137,11 @@ bool Gu::EdgeListBuilder::init(const EDGELISTCREATE& create)
  *	\param		nb_faces	[in] a number of triangles
  *	\param		dfaces		[in] list of triangles with PxU32 vertex references (or NULL)
  *	\param		wfaces		[in] list of triangles with PxU16 vertex references (or NULL)
+ *	\param		scratch		[in] optional allocator for the temp buffers (or NULL)
  *	\return		true if success.
  */
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-bool Gu::EdgeListBuilder::createFacesToEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces)
+bool Gu::EdgeListBuilder::createFacesToEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, CookingScratchAllocator* scratch)
 {
 	// Checkings
 	if(!nb_faces || (!dfaces && !wfaces))
@@ -153,9 +155,9 @@ bool Gu::EdgeListBuilder::createFacesToEdges(PxU32 nb_faces, const PxU32* dfaces
 
 	// 1) Get some bytes: I need one EdgesRefs for each face, and some temp buffers
 	mData.mEdgeFaces	= PX_NEW(EdgeTriangleData)[nb_faces];	// Link faces to edges
-	PxU32*		VRefs0	= PX_NEW_TEMP(PxU32)[nb_faces*3];		// Temp storage
-	PxU32*		VRefs1	= PX_NEW_TEMP(PxU32)[nb_faces*3];		// Temp storage
-	EdgeData*	Buffer	= PX_NEW_TEMP(EdgeData)[nb_faces*3];	// Temp storage
+	PxU32*		VRefs0	= reinterpret_cast<PxU32*>(cookingScratchAlloc(scratch, sizeof(PxU32)*nb_faces*3, "EdgeListBuilder"));		// Temp storage
+	PxU32*		VRefs1	= reinterpret_cast<PxU32*>(cookingScratchAlloc(scratch, sizeof(PxU32)*nb_faces*3, "EdgeListBuilder"));		// Temp storage
+	EdgeData*	Buffer	= reinterpret_cast<EdgeData*>(cookingScratchAlloc(scratch, sizeof(EdgeData)*nb_faces*3, "EdgeListBuilder"));	// Temp storage
 
 	// 2) Create a full redundant list of 3 edges / face.
 	for(PxU32 i=0;i<nb_faces;i++)
@@ -215,9 +217,9 @@ bool Gu::EdgeListBuilder::createFacesToEdges(PxU32 nb_faces, const PxU32* dfaces
 	PxMemCopy(mData.mEdges, Buffer, mData.mNbEdges*sizeof(EdgeData));
 
 	// 6) Free ram and exit
-	PX_DELETE_POD(Buffer);
-	PX_DELETE_POD(VRefs1);
-	PX_DELETE_POD(VRefs0);
+	cookingScratchFree(scratch, Buffer);
+	cookingScratchFree(scratch, VRefs1);
+	cookingScratchFree(scratch, VRefs0);
 
 	return true;
 }
@@ -233,13 +235,14 @@ bool Gu::EdgeListBuilder::createFacesToEdges(PxU32 nb_faces, const PxU32* dfaces
  *	\param		nb_faces	[in] a number of triangles
  *	\param		dfaces		[in] list of triangles with PxU32 vertex references (or NULL)
  *	\param		wfaces		[in] list of triangles with PxU16 vertex references (or NULL)
+ *	\param		scratch		[in] optional allocator for the temp buffers (or NULL)
  *	\return		true if success.
  */
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-bool Gu::EdgeListBuilder::createEdgesToFaces(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces)
+bool Gu::EdgeListBuilder::createEdgesToFaces(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, CookingScratchAllocator* scratch)
 {
 	// 1) I need FacesToEdges !
-	if(!createFacesToEdges(nb_faces, dfaces, wfaces))
+	if(!createFacesToEdges(nb_faces, dfaces, wfaces, scratch))
 		return false;
 
 	// 2) Get some bytes: one Pair structure / edge
@@ -302,7 +305,7 @@ static PX_INLINE PxU32 OppositeVertex(PxU32 r0, PxU32 r1, PxU32 r2, PxU32 vref0,
 	return PX_INVALID_U32;
 }
 
-bool Gu::EdgeListBuilder::computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, const PxVec3* verts, float epsilon)
+bool Gu::EdgeListBuilder::computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, const PxVec3* verts, float epsilon, CookingScratchAllocator* scratch)
 {
 	// Checkings
 	if(!verts || (!dfaces && !wfaces))
@@ -340,7 +343,7 @@ bool Gu::EdgeListBuilder::computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces
 	}
 
 	// We first create active edges in a temporaray buffer. We have one bool / edge.
-	bool* ActiveEdges = reinterpret_cast<bool*>(PX_ALLOC_TEMP(sizeof(bool)*NbEdges, "bool"));
+	bool* ActiveEdges = reinterpret_cast<bool*>(cookingScratchAlloc(scratch, sizeof(bool)*NbEdges, "bool"));
 
 	// Loop through edges and look for convex ones
 	bool* CurrentMark = ActiveEdges;
@@ -607,7 +610,7 @@ bool Gu::EdgeListBuilder::computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces
 	}
 
 	// Free & exit
-	PX_FREE_AND_RESET(ActiveEdges);
+	cookingScratchFree(scratch, ActiveEdges);
 
 	{
 		//initially all vertices are flagged to ignore them. (we assume them to be flat)
@@ -640,7 +643,7 @@ bool Gu::EdgeListBuilder::computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces
 		}
 
 		MaxIndex++;
-		bool* ActiveVerts = reinterpret_cast<bool*>(PX_ALLOC_TEMP(sizeof(bool)*MaxIndex, "bool"));
+		bool* ActiveVerts = reinterpret_cast<bool*>(cookingScratchAlloc(scratch, sizeof(bool)*MaxIndex, "bool"));
 		PxMemZero(ActiveVerts, MaxIndex*sizeof(bool));
 
 		PX_ASSERT(dfaces || wfaces);
@@ -736,7 +739,7 @@ bool Gu::EdgeListBuilder::computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces
 			}
 		}
 
-		PX_FREE_AND_RESET(ActiveVerts);
+		cookingScratchFree(scratch, ActiveVerts);
 	}
 
 	return true;
@@ -41,6 +41,8 @@
 
 namespace physx
 {
+	class CookingScratchAllocator;
+
 namespace Gu
 {
 	//! The edge-list creation structure.
@@ -53,7 +55,8 @@ namespace Gu
 								FacesToEdges	(false),
 								EdgesToFaces	(false),
 								Verts			(NULL),
-								Epsilon			(0.1f)
+								Epsilon			(0.1f),
+								Scratch			(NULL)
 								{}
 				
 				PxU32			NbFaces;		//!< Number of faces in source topo
@@ -64,6 +67,7 @@ namespace Gu
 				bool			EdgesToFaces;
 				const PxVec3*	Verts;
 				float			Epsilon;
+				CookingScratchAllocator*	Scratch;	//!< Optional allocator for temporary buffers, or NULL
 	};
 
 	class EdgeList : public Ps::UserAllocated
@@ -99,9 +103,9 @@ namespace Gu
 
 					bool						init(const EDGELISTCREATE& create);
 		private:
-					bool						createFacesToEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces);
-					bool						createEdgesToFaces(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces);
-					bool						computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, const PxVec3* verts, float epsilon);
+					bool						createFacesToEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, CookingScratchAllocator* scratch);
+					bool						createEdgesToFaces(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, CookingScratchAllocator* scratch);
+					bool						computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, const PxVec3* verts, float epsilon, CookingScratchAllocator* scratch);
 	};
 }
 
@@ -30,6 +30,7 @@
 #include "foundation/PxVec3.h"
 #include "foundation/PxMemory.h"
 #include "MeshCleaner.h"
+#include "CookingScratch.h"
 #include "PsAllocator.h"
 #include "PsBitUtils.h"
 
@@ -74,19 +75,20 @@ static PX_FORCE_INLINE PxU32 getHashValue(const Indices& v)
 	return c;
 }
 
-MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, const PxU32* srcIndices, PxF32 meshWeldTolerance)
+MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, const PxU32* srcIndices, PxF32 meshWeldTolerance, CookingScratchAllocator* scratch) :
+	mScratch(scratch)
 {
-	PxVec3* cleanVerts = reinterpret_cast<PxVec3*>(PX_ALLOC(sizeof(PxVec3)*nbVerts, "MeshCleaner"));
+	PxVec3* cleanVerts = reinterpret_cast<PxVec3*>(cookingScratchAlloc(scratch, PxU32(sizeof(PxVec3)*nbVerts), "MeshCleaner"));
 	PX_ASSERT(cleanVerts);
 
-	PxU32* indices = reinterpret_cast<PxU32*>(PX_ALLOC(sizeof(PxU32)*nbTris*3, "MeshCleaner"));
+	PxU32* indices = reinterpret_cast<PxU32*>(cookingScratchAlloc(scratch, PxU32(sizeof(PxU32)*nbTris*3), "MeshCleaner"));
 
-	PxU32* remapTriangles = reinterpret_cast<PxU32*>(PX_ALLOC(sizeof(PxU32)*nbTris, "MeshCleaner"));
+	PxU32* remapTriangles = reinterpret_cast<PxU32*>(cookingScratchAlloc(scratch, PxU32(sizeof(PxU32)*nbTris), "MeshCleaner"));
 
 	PxU32* vertexIndices = NULL;
 	if(meshWeldTolerance!=0.0f)
 	{
-		vertexIndices = reinterpret_cast<PxU32*>(PX_ALLOC(sizeof(PxU32)*nbVerts, "MeshCleaner"));
+		vertexIndices = reinterpret_cast<PxU32*>(cookingScratchAlloc(scratch, PxU32(sizeof(PxU32)*nbVerts), "MeshCleaner"));
 		const PxF32 weldTolerance = 1.0f / meshWeldTolerance;
 		// snap to grid
 		for(PxU32 i=0; i<nbVerts; i++)
@@ -105,12 +107,12 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 	const PxU32 maxNbElems = PxMax(nbTris, nbVerts);
 	const PxU32 hashSize = shdfnd::nextPowerOfTwo(maxNbElems);
 	const PxU32 hashMask = hashSize-1;
-	PxU32* hashTable = reinterpret_cast<PxU32*>(PX_ALLOC(sizeof(PxU32)*(hashSize + maxNbElems), "MeshCleaner"));
+	PxU32* hashTable = reinterpret_cast<PxU32*>(cookingScratchAlloc(scratch, PxU32(sizeof(PxU32)*(hashSize + maxNbElems)), "MeshCleaner"));
 	PX_ASSERT(hashTable);
 	memset(hashTable, 0xff, hashSize * sizeof(PxU32));
 	PxU32* const next = hashTable + hashSize;
 
-	PxU32* remapVerts = reinterpret_cast<PxU32*>(PX_ALLOC(sizeof(PxU32)*nbVerts, "MeshCleaner"));
+	PxU32* remapVerts = reinterpret_cast<PxU32*>(cookingScratchAlloc(scratch, PxU32(sizeof(PxU32)*nbVerts), "MeshCleaner"));
 	memset(remapVerts, 0xff, nbVerts * sizeof(PxU32));
 
 	for(PxU32 i=0;i<nbTris*3;i++)
@@ -174,7 +176,7 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 		remapTriangles[nbCleanedTris] = i;
 		nbCleanedTris++;
 	}
-	PX_FREE(remapVerts);
+	cookingScratchFree(scratch, remapVerts);
 
 	PxU32 nbToGo = nbCleanedTris;
 	nbCleanedTris = 0;
@@ -203,13 +205,13 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 			hashTable[hashValue] = nbCleanedTris++;
 		}
 	}
-	PX_FREE(hashTable);
+	cookingScratchFree(scratch, hashTable);
 
 	if(vertexIndices)
 	{
 		for(PxU32 i=0;i<nbCleanedVerts;i++)
 			cleanVerts[i] = srcVerts[vertexIndices[i]];
-		PX_FREE(vertexIndices);
+		cookingScratchFree(scratch, vertexIndices);
 	}
 	mNbVerts	= nbCleanedVerts;
 	mNbTris		= nbCleanedTris;
@@ -217,7 +219,7 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 	mIndices	= indices;
 	if(idtRemap)
 	{
-		PX_FREE(remapTriangles);
+		cookingScratchFree(scratch, remapTriangles);
 		mRemap	= NULL;
 	}
 	else
@@ -228,7 +230,8 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 
 MeshCleaner::~MeshCleaner()
 {
-	PX_FREE_AND_RESET(mRemap);
-	PX_FREE_AND_RESET(mIndices);
-	PX_FREE_AND_RESET(mVerts);
+	// PT: released in reverse allocation order so that scratch memory is reclaimed
+	cookingScratchFree(mScratch, mRemap);
+	cookingScratchFree(mScratch, mIndices);
+	cookingScratchFree(mScratch, mVerts);
 }
@@ -38,10 +38,12 @@
 
 namespace physx
 {
+	class CookingScratchAllocator;
+
 	class MeshCleaner
 	{
 		public:
-			MeshCleaner(PxU32 nbVerts, const PxVec3* verts, PxU32 nbTris, const PxU32* indices, PxF32 meshWeldTolerance);
+			MeshCleaner(PxU32 nbVerts, const PxVec3* verts, PxU32 nbTris, const PxU32* indices, PxF32 meshWeldTolerance, CookingScratchAllocator* scratch = NULL);
 			~MeshCleaner();
 
 			PxU32	mNbVerts;
@@ -49,6 +51,8 @@ namespace physx
 			PxVec3*	mVerts;
 			PxU32*	mIndices;
 			PxU32*	mRemap;
+		private:
+			CookingScratchAllocator*	mScratch;
 	};
 }
 
@@ -229,45 +229,58 @@ bool ConvexHullLib::cleanupVertices(PxU32 svcount, const PxVec3* svertices, PxU3
 
 	// normalize the point cloud
 	const char * vtx = reinterpret_cast<const char *> (verticesToClean);
-	for (PxU32 i = 0; i<numVerticesToClean; i++)
+	if (mConvexMeshDesc.flags & PxConvexFlag::ePREHULLED_INPUT)
 	{
-		const PxVec3& p = *reinterpret_cast<const PxVec3 *>(vtx);
-		vtx+=stride;
-
-		PxVec3 normalizedP = p.multiply(recip); // normalize
-
-		PxU32 j;
-
-		// parse the already stored vertices and check the distance
-		for (j=0; j<vcount; j++)
+		// the input points are trusted to be unique hull vertices, no need to search for duplicates
+		for (PxU32 i = 0; i<numVerticesToClean; i++)
+		{
+			vertices[i] = reinterpret_cast<const PxVec3 *>(vtx)->multiply(recip);
+			vtx+=stride;
+		}
+		vcount = numVerticesToClean;
+	}
+	else
+	{
+		for (PxU32 i = 0; i<numVerticesToClean; i++)
 		{
-			PxVec3& v = vertices[j];
+			const PxVec3& p = *reinterpret_cast<const PxVec3 *>(vtx);
+			vtx+=stride;
 
-			const float dx = fabsf(normalizedP[0] - v[0] );
-			const float dy = fabsf(normalizedP[1] - v[1] );
-			const float dz = fabsf(normalizedP[2] - v[2] );
+			PxVec3 normalizedP = p.multiply(recip); // normalize
 
-			if ( dx < normalEpsilon && dy < normalEpsilon && dz < normalEpsilon )
+			PxU32 j;
+
+			// parse the already stored vertices and check the distance
+			for (j=0; j<vcount; j++)
 			{
-				// ok, it is close enough to the old one
-				// now let us see if it is further from the center of the point cloud than the one we already recorded.
-				// in which case we keep this one instead.
-				const float dist1 = (normalizedP - center).magnitudeSquared();
-				const float dist2 = (v - center).magnitudeSquared();
+				PxVec3& v = vertices[j];
+
+				const float dx = fabsf(normalizedP[0] - v[0] );
+				const float dy = fabsf(normalizedP[1] - v[1] );
+				const float dz = fabsf(normalizedP[2] - v[2] );
 
-				if ( dist1 > dist2 )
+				if ( dx < normalEpsilon && dy < normalEpsilon && dz < normalEpsilon )
 				{
-					v = normalizedP;
+					// ok, it is close enough to the old one
+					// now let us see if it is further from the center of the point cloud than the one we already recorded.
+					// in which case we keep this one instead.
+					const float dist1 = (normalizedP - center).magnitudeSquared();
+					const float dist2 = (v - center).magnitudeSquared();
+
+					if ( dist1 > dist2 )
+					{
+						v = normalizedP;
+					}
+					break;
 				}
-				break;
 			}
-		}
 
-		// we dont have that vertex in the output, add it
-		if ( j == vcount )
-		{
-			vertices[vcount] = normalizedP;
-			vcount++;
+			// we dont have that vertex in the output, add it
+			if ( j == vcount )
+			{
+				vertices[vcount] = normalizedP;
+				vcount++;
+			}
 		}
 	}
 
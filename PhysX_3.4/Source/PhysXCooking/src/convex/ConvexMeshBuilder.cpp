@@ -84,7 +84,13 @@ bool ConvexMeshBuilder::build(const PxConvexMeshDesc& desc, PxU32 gaussMapVertex
 
 	if(mHullData.mNbHullVertices > gaussMapVertexLimit)
 	{
-		if(!computeGaussMaps())
+		if(desc.flags & PxConvexFlag::eDEFER_GAUSS_MAP)
+		{
+			// empty data, built by the runtime on first use
+			PX_DELETE(mBigConvexData);
+			PX_NEW_SERIALIZED(mBigConvexData,BigConvexData);
+		}
+		else if(!computeGaussMaps())
 		{
 			return false;
 		}
@@ -133,7 +139,9 @@ bool ConvexMeshBuilder::save(PxOutputStream& stream, bool platformMismatch) cons
 	writeFloatBuffer(&mHullData.mCenterOfMass.x, 3, platformMismatch, stream);
 
 	// Export gaussmaps
-	if(mBigConvexData)
+	if(mBigConvexData && mBigConvexData->isDeferred())
+		writeFloat(0.0f, platformMismatch, stream);		//gauss map deferred to first use
+	else if(mBigConvexData)
 	{
 		writeFloat(1.0f, platformMismatch, stream);		//gauss map flag true
 		BigConvexDataBuilder SVMB(&mHullData, mBigConvexData, hullBuilder.mHullDataHullVertices);
@@ -79,8 +79,24 @@ namespace local
 		void init(PxU32 preallocateSize)
 		{
 			PX_ASSERT(preallocateSize);
-			mPreallocateSize = preallocateSize;
-			T* block = reinterpret_cast<T*>(PX_ALLOC_TEMP(sizeof(T)*preallocateSize, "Quickhull MemBlock"));
+			// recycle the first block if it is large enough, release the others
+			const PxU32 nbKeptBlocks = (mBlocks.size() && preallocateSize <= mPreallocateSize) ? 1u : 0u;
+			for (PxU32 i = nbKeptBlocks; i < mBlocks.size(); i++)
+			{
+				PX_FREE(mBlocks[i]);
+			}
+			mBlocks.resize(nbKeptBlocks);
+
+			mCurrentBlock = 0;
+			mCurrentIndex = 0;
+
+			if(!nbKeptBlocks)
+			{
+				mPreallocateSize = preallocateSize;
+				mBlocks.pushBack(reinterpret_cast<T*>(PX_ALLOC_TEMP(sizeof(T)*preallocateSize, "Quickhull MemBlock")));
+			}
+
+			T* block = mBlocks[0];
 			if(useIndexing)
 			{
 				for (PxU32 i = 0; i < mPreallocateSize; i++)
@@ -89,7 +105,6 @@ namespace local
 					PX_PLACEMENT_NEW(&block[i], T)(i);
 				}
 			}
-			mBlocks.pushBack(block);
 		}
 
 		~MemBlock()
@@ -103,15 +118,6 @@ namespace local
 
 		void reset()
 		{
-			for (PxU32 i = 0; i < mBlocks.size(); i++)
-			{
-				PX_FREE(mBlocks[i]);
-			}
-			mBlocks.clear();
-
-			mCurrentBlock = 0;
-			mCurrentIndex = 0;
-
 			init(mPreallocateSize);
 		}
 
@@ -383,6 +389,9 @@ namespace local
 		// preallocate the edges, faces, vertices
 		void preallocate(PxU32 numVertices);
 
+		// resets the hull state to build a new hull from the given desc, keeping the allocated memory
+		void reuse(const PxConvexMeshDesc& desc);
+
 		// parse the input verts, store them into internal format
 		void parseInputVertices(const PxVec3* verts, PxU32 numVerts);
 
@@ -464,7 +473,7 @@ namespace local
 		friend class physx::QuickHullConvexHullLib;
 
 		const PxCookingParams&	mCookingParams;		// cooking params
-		const PxConvexMeshDesc& mConvexDesc;		// convex desc
+		const PxConvexMeshDesc* mConvexDesc;		// convex desc
 
 		PxVec3					mInteriorPoint;		// interior point for int/ext tests
 
@@ -474,6 +483,7 @@ namespace local
 		PxU32					mTerminalVertex;	// in case we failed to generate hull in a regular run we set the terminal vertex and rerun
 
 		QuickHullVertex*		mVerticesList;		// vertices list preallocated
+		PxU32					mVerticesCapacity;	// number of vertices allocated in mVerticesList
 		MemBlock<QuickHullHalfEdge, false>	mFreeHalfEdges;	// free half edges
 		MemBlock<QuickHullFace, true>	mFreeFaces;			// free faces
 
@@ -695,7 +705,7 @@ namespace local
 	//////////////////////////////////////////////////////////////////////////
 
 	QuickHull::QuickHull(const PxCookingParams& params, const PxConvexMeshDesc& desc)
-		: mCookingParams(params), mConvexDesc(desc), mOutputNumVertices(0), mTerminalVertex(0xFFFFFFFF), mVerticesList(NULL), mNumHullFaces(0), mPrecomputedMinMax(false),
+		: mCookingParams(params), mConvexDesc(&desc), mOutputNumVertices(0), mTerminalVertex(0xFFFFFFFF), mVerticesList(NULL), mVerticesCapacity(0), mNumHullFaces(0), mPrecomputedMinMax(false),
 		mTolerance(-1.0f), mPlaneTolerance(-1.0f)
 	{
 	}
@@ -730,7 +740,12 @@ namespace local
 
 		// max num vertices = numVertices
 		mMaxVertices = PxMax(PxU32(8), numVertices); // 8 is min, since we can expand to AABB during the clean vertices phase
-		mVerticesList = reinterpret_cast<QuickHullVertex*> (PX_ALLOC_TEMP(sizeof(QuickHullVertex)*mMaxVertices, "QuickHullVertex"));
+		if (mMaxVertices > mVerticesCapacity)
+		{
+			PX_FREE(mVerticesList);
+			mVerticesList = reinterpret_cast<QuickHullVertex*> (PX_ALLOC_TEMP(sizeof(QuickHullVertex)*mMaxVertices, "QuickHullVertex"));
+			mVerticesCapacity = mMaxVertices;
+		}
 
 		// estimate the max half edges
 		PxU32 maxHalfEdges = (3 * mMaxVertices - 6) * 3;
@@ -749,6 +764,26 @@ namespace local
 		mHorizon.reserve(PxMin(numVertices,PxU32(128)));
 	}
 
+	//////////////////////////////////////////////////////////////////////////
+	// reset the hull state, the buffers are recycled by the next preallocate call
+	void QuickHull::reuse(const PxConvexMeshDesc& desc)
+	{
+		mConvexDesc = &desc;
+		mOutputNumVertices = 0;
+		mTerminalVertex = 0xFFFFFFFF;
+		mNumHullFaces = 0;
+		mPrecomputedMinMax = false;
+		mTolerance = -1.0f;
+		mPlaneTolerance = -1.0f;
+
+		mHullFaces.clear();
+		mUnclaimedPoints.clear();
+		mHorizon.clear();
+		mNewFaces.clear();
+		mRemovedFaces.clear();
+		mDiscardedFaces.clear();
+	}
+
 	//////////////////////////////////////////////////////////////////////////
 	// release internal buffers
 	void QuickHull::releaseHull()
@@ -757,6 +792,7 @@ namespace local
 		{
 			PX_FREE_AND_RESET(mVerticesList);
 		}
+		mVerticesCapacity = 0;
 		mHullFaces.clear();
 	}
 
@@ -1144,7 +1180,7 @@ namespace local
 		}
 
 		// simplex area test
-		const bool useAreaTest = mConvexDesc.flags & PxConvexFlag::eCHECK_ZERO_AREA_TRIANGLES ? true : false;
+		const bool useAreaTest = mConvexDesc->flags & PxConvexFlag::eCHECK_ZERO_AREA_TRIANGLES ? true : false;
 		const float areaEpsilon = mCookingParams.areaTestEpsilon * 2.0f;
 		if (useAreaTest)
 		{
@@ -1162,7 +1198,7 @@ namespace local
 		while ((eyeVtx = nextPointToAdd(eyeFace)) != NULL && eyeVtx->index != mTerminalVertex)
 		{
 			// if plane shifting vertex limit, we need the reduced hull
-			if((mConvexDesc.flags & PxConvexFlag::ePLANE_SHIFTING) && (numVerts >= mConvexDesc.vertexLimit))
+			if((mConvexDesc->flags & PxConvexFlag::ePLANE_SHIFTING) && (numVerts >= mConvexDesc->vertexLimit))
 				break;
 
 			bool addFailed = false;
@@ -1202,7 +1238,7 @@ namespace local
 		// vertex limit has been reached. We did not stopped the iteration, since we
 		// will use the produced hull to compute OBB from it and use the planes
 		// to slice the initial OBB
-		if (numVerts > mConvexDesc.vertexLimit)
+		if (numVerts > mConvexDesc->vertexLimit)
 		{
 			return QuickHullResult::eVERTEX_LIMIT_REACHED;
 		}
@@ -1806,8 +1842,19 @@ namespace local
 
 //////////////////////////////////////////////////////////////////////////
 
+QuickHullScratch::~QuickHullScratch()
+{
+	if(mQuickHull)
+	{
+		mQuickHull->releaseHull();
+		PX_DELETE(mQuickHull);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 QuickHullConvexHullLib::QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params)
-	: ConvexHullLib(desc, params),mQuickHull(NULL), mCropedConvexHull(NULL), mOutMemoryBuffer(NULL), mFaceTranslateTable(NULL)
+	: ConvexHullLib(desc, params),mQuickHull(NULL), mOwnsQuickHull(true), mCropedConvexHull(NULL), mOutMemoryBuffer(NULL), mFaceTranslateTable(NULL)
 {
 	mQuickHull = PX_NEW_TEMP(local::QuickHull)(params, desc);
 	mQuickHull->preallocate(desc.points.count);
@@ -1815,10 +1862,26 @@ QuickHullConvexHullLib::QuickHullConvexHullLib(const PxConvexMeshDesc& desc, con
 
 //////////////////////////////////////////////////////////////////////////
 
+QuickHullConvexHullLib::QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params, QuickHullScratch& scratch)
+	: ConvexHullLib(desc, params),mQuickHull(NULL), mOwnsQuickHull(false), mCropedConvexHull(NULL), mOutMemoryBuffer(NULL), mFaceTranslateTable(NULL)
+{
+	if(scratch.mQuickHull)
+		scratch.mQuickHull->reuse(desc);
+	else
+		scratch.mQuickHull = PX_NEW_TEMP(local::QuickHull)(params, desc);
+	mQuickHull = scratch.mQuickHull;
+	mQuickHull->preallocate(desc.points.count);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 QuickHullConvexHullLib::~QuickHullConvexHullLib()
 {
-	mQuickHull->releaseHull();
-	PX_DELETE(mQuickHull);
+	if(mOwnsQuickHull)
+	{
+		mQuickHull->releaseHull();
+		PX_DELETE(mQuickHull);
+	}
 
 	if(mCropedConvexHull)
 	{
@@ -1835,7 +1898,7 @@ QuickHullConvexHullLib::~QuickHullConvexHullLib()
 // 2. check we can construct the simplex, if not expand the input verts
 // 3. prepare the quickhull - preallocate, parse input verts
 // 4. construct the hull
-// 5. post merge faces if limit not reached
+// 5. post merge faces if limit not reached (skipped for pre-hulled input)
 // 6. if limit reached, expand the hull
 PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::createConvexHull()
 {
@@ -1899,7 +1962,9 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::createConvexHull()
 		res = PxConvexMeshCookingResult::eZERO_AREA_TEST_FAILED;
 		break;
 	case local::QuickHullResult::eSUCCESS:
-		mQuickHull->postMergeHull();
+		// pre-hulled input only keeps the faces merged within the hull tolerance
+		if(!(mConvexMeshDesc.flags & PxConvexFlag::ePREHULLED_INPUT))
+			mQuickHull->postMergeHull();
 		res = PxConvexMeshCookingResult::eSUCCESS;		
 		break;
 	case local::QuickHullResult::ePOLYGONS_LIMIT_REACHED:
@@ -2181,7 +2246,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::expandHull()
 	}
 
 	// construct again the hull from the new points
-	local::QuickHull* newHull = PX_NEW_TEMP(local::QuickHull)(mQuickHull->mCookingParams, mQuickHull->mConvexDesc);		
+	local::QuickHull* newHull = PX_NEW_TEMP(local::QuickHull)(mQuickHull->mCookingParams, *mQuickHull->mConvexDesc);		
 	newHull->preallocate(expandPoints.size());
 	newHull->parseInputVertices(vertices,expandPoints.size());
 
@@ -2198,9 +2263,14 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::expandHull()
 	case local::QuickHullResult::eVERTEX_LIMIT_REACHED:
 	case local::QuickHullResult::ePOLYGONS_LIMIT_REACHED:
 		{
-			mQuickHull->releaseHull();
-			PX_DELETE(mQuickHull);
+			// a scratch hull is left untouched for the next hull to reuse
+			if(mOwnsQuickHull)
+			{
+				mQuickHull->releaseHull();
+				PX_DELETE(mQuickHull);
+			}
 			mQuickHull = newHull;
+			mOwnsQuickHull = true;
 		}
 		break;
 	case local::QuickHullResult::eFAILURE:
@@ -45,6 +45,23 @@ namespace physx
 {
 	class ConvexHull;
 
+	//////////////////////////////////////////////////////////////////////////
+	// Working memory of the quickhull algorithm. Hulls computed one after the other
+	// with the same scratch object recycle its buffers instead of allocating new ones.
+	// A scratch object must not be shared between threads.
+	class QuickHullScratch
+	{
+		PX_NOCOPY(QuickHullScratch)
+	public:
+		QuickHullScratch() : mQuickHull(NULL)	{}
+		~QuickHullScratch();
+
+	private:
+		friend class QuickHullConvexHullLib;
+
+		local::QuickHull*		mQuickHull;		// created by the first hull using the scratch
+	};
+
 	//////////////////////////////////////////////////////////////////////////
 	// Quickhull lib constructs the hull from given input points. The resulting hull 
 	// will only contain a subset of the input points. The algorithm does incrementally
@@ -58,6 +75,9 @@ namespace physx
 		// functions
 		QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params);
 
+		// same as above, computing the hull in the memory of the provided scratch object
+		QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params, QuickHullScratch& scratch);
+
 		~QuickHullConvexHullLib();
 
 		// computes the convex hull from provided points
@@ -89,6 +109,7 @@ namespace physx
 
 	private:
 		local::QuickHull*		mQuickHull;		// the internal quick hull representation
+		bool					mOwnsQuickHull;	// false if mQuickHull belongs to a QuickHullScratch
 		ConvexHull*				mCropedConvexHull; //the hull cropped from OBB, used for vertex limit path
 
 		PxU8*					mOutMemoryBuffer;   // memory buffer used for output data
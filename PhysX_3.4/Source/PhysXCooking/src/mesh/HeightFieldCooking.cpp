@@ -78,6 +78,26 @@ bool saveHeightField(const HeightField& hf, PxOutputStream& stream, bool endian)
 		stream.write(&s.materialIndex1, sizeof(s.materialIndex1));
 	}
 
+	// write min/max tree
+	PxU32 nbLevels;
+	const PxU32 nbNodes = HeightField::computeMinMaxTreeSize(hfData.rows, hfData.columns, nbLevels);
+	if(hfData.nbMinMaxLevels != nbLevels)
+	{
+		// PT: the tree could not be allocated at load time, write an empty one and let the loader rebuild it
+		writeDword(0, endian, stream);
+		writeDword(0, endian, stream);
+	}
+	else
+	{
+		writeDword(nbLevels, endian, stream);
+		writeDword(nbNodes, endian, stream);
+		for(PxU32 i = 0; i < nbNodes; i++)
+		{
+			writeWord(PxU16(hfData.minMaxTree[i].minHeight), endian, stream);
+			writeWord(PxU16(hfData.minMaxTree[i].maxHeight), endian, stream);
+		}
+	}
+
 	return true;
 }
 
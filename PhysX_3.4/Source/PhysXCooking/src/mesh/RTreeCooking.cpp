@@ -39,6 +39,7 @@
 #include "QuickSelect.h"
 #include "PsInlineArray.h"
 #include "GuRTree.h"
+#include "CmTask.h"
 
 #define PRINT_RTREE_COOKING_STATS 0 // AP: keeping this frequently used macro for diagnostics/benchmarking
 
@@ -84,12 +85,12 @@ struct PxBounds3V
 static void buildFromBounds(
 	Gu::RTree& resultTree, const PxBounds3V* allBounds, PxU32 numBounds,
 	Array<PxU32>& resultPermute, RTreeCooker::RemapCallback* rc, Vec3VArg allMn, Vec3VArg allMx,
-	PxReal sizePerfTradeOff, PxMeshCookingHint::Enum hint);
+	PxReal sizePerfTradeOff, PxMeshCookingHint::Enum hint, PxCpuDispatcher* dispatcher);
 
 /////////////////////////////////////////////////////////////////////////
 void RTreeCooker::buildFromTriangles(
 	Gu::RTree& result, const PxVec3* verts, PxU32 numVerts, const PxU16* tris16, const PxU32* tris32, PxU32 numTris,
-	Array<PxU32>& resultPermute, RTreeCooker::RemapCallback* rc, PxReal sizePerfTradeOff01, PxMeshCookingHint::Enum hint)
+	Array<PxU32>& resultPermute, RTreeCooker::RemapCallback* rc, PxReal sizePerfTradeOff01, PxMeshCookingHint::Enum hint, PxCpuDispatcher* dispatcher)
 {
 	PX_UNUSED(numVerts);
 	Array<PxBounds3V> allBounds;
@@ -117,7 +118,7 @@ void RTreeCooker::buildFromTriangles(
 		allBounds.pushBack(PxBounds3V(mn, mx));
 	}
 
-	buildFromBounds(result, allBounds.begin(), numTris, resultPermute, rc, allMn, allMx, sizePerfTradeOff01, hint);
+	buildFromBounds(result, allBounds.begin(), numTris, resultPermute, rc, allMn, allMx, sizePerfTradeOff01, hint, dispatcher);
 }
 
 /////////////////////////////////////////////////////////////////////////
@@ -324,6 +325,24 @@ struct SortBoundsPredicate
 };
 
 
+/////////////////////////////////////////////////////////////////////////
+// sorts the bounds along one axis and computes the matching ranks, one job per axis
+struct SortAxisJob
+{
+	const PxBounds3V* allBounds;
+	PxU32 numBounds;
+	PxU32* orders[3];
+	PxU32* ranks[3];
+
+	void operator()(PxU32 coordIndex)
+	{
+		PxU32* PX_RESTRICT order = orders[coordIndex];
+		PxU32* PX_RESTRICT rank = ranks[coordIndex];
+		Ps::sort(order, numBounds, SortBoundsPredicate(coordIndex, allBounds));
+		for(PxU32 i = 0; i < numBounds; i++) rank[order[i]] = i;
+	}
+};
+
 /////////////////////////////////////////////////////////////////////////
 // auxiliary class for SAH build (SAH = surface area heuristic)
 struct Interval
@@ -726,7 +745,7 @@ struct SubSortSAH
 static void buildFromBounds(
 	Gu::RTree& result, const PxBounds3V* allBounds, PxU32 numBounds,
 	Array<PxU32>& permute, RTreeCooker::RemapCallback* rc, Vec3VArg allMn, Vec3VArg allMx,
-	PxReal sizePerfTradeOff01, PxMeshCookingHint::Enum hint)
+	PxReal sizePerfTradeOff01, PxMeshCookingHint::Enum hint, PxCpuDispatcher* dispatcher)
 {
 	PX_UNUSED(sizePerfTradeOff01);
 	PxBounds3V treeBounds(allMn, allMx);
@@ -753,12 +772,13 @@ static void buildFromBounds(
 		PxMemCopy(yOrder.begin(), permute.begin(), sizeof(yOrder[0])*numBounds);
 		PxMemCopy(zOrder.begin(), permute.begin(), sizeof(zOrder[0])*numBounds);
 		// sort by shuffling the permutation, precompute sorted ranks for x,y,z-orders
-		Ps::sort(xOrder.begin(), xOrder.size(), SortBoundsPredicate(0, allBounds));
-		for(PxU32 i = 0; i < numBounds; i++) xRanks[xOrder[i]] = i;
-		Ps::sort(yOrder.begin(), yOrder.size(), SortBoundsPredicate(1, allBounds));
-		for(PxU32 i = 0; i < numBounds; i++) yRanks[yOrder[i]] = i;
-		Ps::sort(zOrder.begin(), zOrder.size(), SortBoundsPredicate(2, allBounds));
-		for(PxU32 i = 0; i < numBounds; i++) zRanks[zOrder[i]] = i;
+		// the 3 axes are independent so they are sorted in parallel when a dispatcher is available
+		SortAxisJob sortJob;
+		sortJob.allBounds = allBounds;
+		sortJob.numBounds = numBounds;
+		sortJob.orders[0] = xOrder.begin(); sortJob.orders[1] = yOrder.begin(); sortJob.orders[2] = zOrder.begin();
+		sortJob.ranks[0] = xRanks.begin(); sortJob.ranks[1] = yRanks.begin(); sortJob.ranks[2] = zRanks.begin();
+		Cm::runParallelJobs(dispatcher, 3, sortJob);
 
 		SubSortSAH ss(permute.begin(), allBounds, numBounds,
 			xOrder.begin(), yOrder.begin(), zOrder.begin(), xRanks.begin(), yRanks.begin(), zRanks.begin(), sizePerfTradeOff01);
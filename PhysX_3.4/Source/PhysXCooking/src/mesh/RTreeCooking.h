@@ -46,6 +46,6 @@ namespace physx
 		// triangles will be remapped so that newIndex = resultPermute[oldIndex]
 		static void buildFromTriangles(
 			Gu::RTree& resultTree, const PxVec3* verts, PxU32 numVerts, const PxU16* tris16, const PxU32* tris32, PxU32 numTris,
-			Ps::Array<PxU32>& resultPermute, RemapCallback* rc, PxReal sizePerfTradeOff01, PxMeshCookingHint::Enum hint);
+			Ps::Array<PxU32>& resultPermute, RemapCallback* rc, PxReal sizePerfTradeOff01, PxMeshCookingHint::Enum hint, PxCpuDispatcher* dispatcher = NULL);
 	};
 }
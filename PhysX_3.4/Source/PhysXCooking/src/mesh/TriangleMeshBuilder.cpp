@@ -84,7 +84,8 @@ namespace physx {
 TriangleMeshBuilder::TriangleMeshBuilder(TriangleMeshData& m, const PxCookingParams& params) :
 	edgeList	(NULL),
 	mParams		(params),
-	mMeshData	(m)
+	mMeshData	(m),
+	mScratch	(params.scratchMemory, params.scratchMemorySize)
 {
 }
 
@@ -143,7 +144,7 @@ bool TriangleMeshBuilder::cleanMesh(bool validate, PxTriangleMeshCookingResult::
 			meshWeldTolerance = mParams.meshWeldTolerance;
 		}
 	}
-	MeshCleaner cleaner(mMeshData.mNbVertices, mMeshData.mVertices, mMeshData.mNbTriangles, reinterpret_cast<const PxU32*>(mMeshData.mTriangles), meshWeldTolerance);
+	MeshCleaner cleaner(mMeshData.mNbVertices, mMeshData.mVertices, mMeshData.mNbTriangles, reinterpret_cast<const PxU32*>(mMeshData.mTriangles), meshWeldTolerance, &mScratch);
 	if(!cleaner.mNbTris)
 		return false;
 
@@ -741,6 +742,7 @@ void TriangleMeshBuilder::createEdgeList()
 	create.FacesToEdges	= true;
 	create.EdgesToFaces	= true;
 	create.Verts		= mMeshData.mVertices;
+	create.Scratch		= &mScratch;
 	//create.Epsilon = 0.1f;
 	//	create.Epsilon		= convexEdgeThreshold;
 	edgeList = PX_NEW(Gu::EdgeListBuilder);
@@ -778,6 +780,9 @@ bool TriangleMeshBuilder::loadFromDesc(const PxTriangleMeshDesc& _desc, PxTriang
 		return false;
 	}
 
+	if((mParams.meshPreprocessParams & PxMeshPreprocessingFlag::eCOMPRESS_MESH_DATA) && (getMidphaseID()!=PxMeshMidPhase::eBVH34 || mParams.buildGPUData))
+		Ps::getFoundation().error(PxErrorCode::eDEBUG_WARNING, __FILE__, __LINE__, "TriangleMesh::loadFromDesc: PxMeshPreprocessingFlag::eCOMPRESS_MESH_DATA is only supported for BVH34 meshes without GPU data, ignored.");
+
 	// Create a local copy that we can modify
 	PxTriangleMeshDesc desc = _desc;
 
@@ -824,12 +829,96 @@ bool TriangleMeshBuilder::loadFromDesc(const PxTriangleMeshDesc& _desc, PxTriang
 
 	createGRBMidPhaseAndData(originalTriangleCount);
 
+	if(mMeshData.mCompressed)
+		finishMeshCompression();
 
 	return true;
 }
 
+// The vertices have been quantized by the midphase builder and the rest of the cooking ran on their decoded values.
+// The triangle indices are delta-coded when they would otherwise need 32 bits, as long as each block of triangles
+// spans less than 64K vertices. The regular arrays are released, the runtime only uses the compressed mesh.
+void TriangleMeshBuilder::finishMeshCompression()
+{
+	Gu::TriangleMeshData& m = mMeshData;
+	Gu::CompressedMesh* compressed = m.mCompressed;
+	PX_ASSERT(compressed && !m.has16BitIndices());
+
+	const bool force32 = mParams.meshPreprocessParams & PxMeshPreprocessingFlag::eFORCE_32BIT_INDICES;
+	if(m.mNbVertices > 0xffff || force32)
+	{
+		Gu::CompressedMesh header;
+		const PxU32 size = Gu::CompressedMesh::initLayout(header, m.mNbVertices, m.mNbTriangles, Gu::CMF_INDICES);
+		Gu::CompressedMesh* withIndices = reinterpret_cast<Gu::CompressedMesh*>(PX_ALLOC(size, "CompressedMesh"));
+		PxMemZero(withIndices, size);
+		// the vertex arrays have the same layout in both versions
+		PxMemCopy(withIndices, compressed, compressed->mTriangleBasesOffset);
+		*withIndices = header;
+
+		const PxU32* indices = reinterpret_cast<const PxU32*>(m.mTriangles);
+		PxU32* bases = withIndices->getTriangleBases();
+		PxU16* offsets = withIndices->getTriangleOffsets();
+		bool success = true;
+		const PxU32 nbBlocks = Gu::CompressedMesh::getNbTriangleBlocks(m.mNbTriangles);
+		for(PxU32 b=0;b<nbBlocks && success;b++)
+		{
+			const PxU32 first = b*GU_COMPRESSED_TRIANGLE_BLOCK_SIZE*3;
+			const PxU32 last = PxMin(first + GU_COMPRESSED_TRIANGLE_BLOCK_SIZE*3, m.mNbTriangles*3);
+			PxU32 minIndex = 0xffffffff;
+			PxU32 maxIndex = 0;
+			for(PxU32 i=first;i<last;i++)
+			{
+				minIndex = PxMin(minIndex, indices[i]);
+				maxIndex = PxMax(maxIndex, indices[i]);
+			}
+			success = maxIndex - minIndex <= 0xffff;
+
+			bases[b] = minIndex;
+			for(PxU32 i=first;i<last;i++)
+				offsets[i] = PxU16(indices[i] - minIndex);
+		}
+
+		if(success)
+		{
+			PX_FREE(compressed);
+			m.mCompressed = withIndices;
+			PX_FREE_AND_RESET(m.mTriangles);
+		}
+		else
+			PX_FREE(withIndices);
+	}
+
+	PX_FREE_AND_RESET(m.mVertices);
+	onMeshIndexFormatChange();
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Mirrors loadCompressedMesh() in GuMeshFactory.cpp: the size, then the runtime layout with each array converted
+// with its own type, padding included.
+static void saveCompressedMesh(const Gu::CompressedMesh& compressed, bool mismatch, PxOutputStream& stream)
+{
+	writeDword(compressed.mSize, mismatch, stream);
+	writeIntBuffer(&compressed.mNbVertices, sizeof(Gu::CompressedMesh)/sizeof(PxU32), mismatch, stream);
+
+	const PxU32 nbFloats = Gu::CompressedMesh::getNbVertexBlocks(compressed.mNbVertices)*sizeof(Gu::QuantizedVertexBlock)/sizeof(PxF32);
+	writeFloatBuffer(&compressed.getVertexBlocks()->mMin.x, nbFloats, mismatch, stream);
+	writeWordBuffer(compressed.getQuantizedVertices(), compressed.mNbVertices*3, mismatch, stream);
+
+	PxU32 offset = compressed.mQuantizedVerticesOffset + compressed.mNbVertices*3*sizeof(PxU16);
+	const PxU8 zeros[16] = { 0 };
+	stream.write(zeros, compressed.mTriangleBasesOffset - offset);
+	offset = compressed.mTriangleBasesOffset;
+
+	if(compressed.hasIndices())
+	{
+		writeIntBuffer(compressed.getTriangleBases(), Gu::CompressedMesh::getNbTriangleBlocks(compressed.mNbTriangles), mismatch, stream);
+		writeWordBuffer(compressed.getTriangleOffsets(), compressed.mNbTriangles*3, mismatch, stream);
+		offset = compressed.mTriangleOffsetsOffset + compressed.mNbTriangles*3*sizeof(PxU16);
+	}
+	stream.write(zeros, compressed.mSize - offset);
+}
+
 bool TriangleMeshBuilder::save(PxOutputStream& stream, bool platformMismatch, const PxCookingParams& params) const
 {
 	// Export header
@@ -845,17 +934,20 @@ bool TriangleMeshBuilder::save(PxOutputStream& stream, bool platformMismatch, co
 	if(mMeshData.mFaceRemap)		serialFlags |= Gu::IMSF_FACE_REMAP;
 	if(mMeshData.mAdjacencies)		serialFlags |= Gu::IMSF_ADJACENCIES;
 	if (params.buildGPUData)		serialFlags |= Gu::IMSF_GRB_DATA;
+	if(mMeshData.mCompressed)		serialFlags |= Gu::IMSF_COMPRESSED;
 	// Compute serialization flags for indices
 	PxU32 maxIndex=0;
 	const Gu::TriangleT<PxU32>* tris = reinterpret_cast<const Gu::TriangleT<PxU32>*>(mMeshData.mTriangles);
-	for(PxU32 i=0;i<mMeshData.mNbTriangles;i++)
+	// with compressed indices the triangles are NULL, and the flags are those of 32-bit indices
+	const PxU32 nbTrisToScan = tris ? mMeshData.mNbTriangles : 0;
+	for(PxU32 i=0;i<nbTrisToScan;i++)
 	{
 		if(tris[i].v[0]>maxIndex)	maxIndex = tris[i].v[0];
 		if(tris[i].v[1]>maxIndex)	maxIndex = tris[i].v[1];
 		if(tris[i].v[2]>maxIndex)	maxIndex = tris[i].v[2];
 	}
 
-	bool force32 = (params.meshPreprocessParams & PxMeshPreprocessingFlag::eFORCE_32BIT_INDICES);
+	bool force32 = (params.meshPreprocessParams & PxMeshPreprocessingFlag::eFORCE_32BIT_INDICES) || !tris;
 	if (maxIndex <= 0xFFFF && !force32)
 		serialFlags |= (maxIndex <= 0xFF ? Gu::IMSF_8BIT_INDICES : Gu::IMSF_16BIT_INDICES);
 	writeDword(serialFlags, platformMismatch, stream);
@@ -863,8 +955,15 @@ bool TriangleMeshBuilder::save(PxOutputStream& stream, bool platformMismatch, co
 	// Export mesh
 	writeDword(mMeshData.mNbVertices, platformMismatch, stream);
 	writeDword(mMeshData.mNbTriangles, platformMismatch, stream);
-	writeFloatBuffer(&mMeshData.mVertices->x, mMeshData.mNbVertices*3, platformMismatch, stream);
-	if(serialFlags & Gu::IMSF_8BIT_INDICES)
+	if(mMeshData.mCompressed)
+		saveCompressedMesh(*mMeshData.mCompressed, platformMismatch, stream);
+	else
+		writeFloatBuffer(&mMeshData.mVertices->x, mMeshData.mNbVertices*3, platformMismatch, stream);
+	if(!tris)
+	{
+		// indices are part of the compressed mesh
+	}
+	else if(serialFlags & Gu::IMSF_8BIT_INDICES)
 	{
 		const PxU32* indices = tris->v;
 		for(PxU32 i=0;i<mMeshData.mNbTriangles*3;i++)
@@ -1111,8 +1210,8 @@ void TriangleMeshBuilder::checkMeshIndicesSize()
 {
 	Gu::TriangleMeshData& m = mMeshData;
 
-	// check if we can change indices from 32bits to 16bits
-	if(m.mNbVertices <= 0xffff && !m.has16BitIndices())
+	// check if we can change indices from 32bits to 16bits. There are no regular indices when they are compressed.
+	if(m.mTriangles && m.mNbVertices <= 0xffff && !m.has16BitIndices())
 	{
 		const PxU32 numTriangles = m.mNbTriangles;
 		PxU32* PX_RESTRICT indices32 = reinterpret_cast<PxU32*> (m.mTriangles);
@@ -1161,6 +1260,85 @@ void BV4TriangleMeshBuilder::onMeshIndexFormatChange()
 		triangles32 = reinterpret_cast<IndTri32*>(mMeshData.mTriangles);
 
 	mData.mMeshInterface.setPointers(triangles32, triangles16, mMeshData.mVertices);
+	mData.mMeshInterface.setCompressedMesh(mMeshData.mCompressed);
+}
+
+// Sorts the vertices by first use in the BV4-ordered triangles, so that consecutive vertices are close to each other,
+// then quantizes them against the bounds of each block of GU_COMPRESSED_VERTEX_BLOCK_SIZE vertices. The vertices are
+// replaced with their decoded values and the tree is refit to them: the remaining cooking steps and the queries then
+// work with exactly the same positions.
+void BV4TriangleMeshBuilder::compressVertices(float boxEpsilon)
+{
+	const PxU32 nbVerts = mMeshData.mNbVertices;
+	const PxU32 nbIndices = mMeshData.mNbTriangles*3;
+	PX_ASSERT(!mMeshData.has16BitIndices());
+	PxU32* indices = reinterpret_cast<PxU32*>(mMeshData.mTriangles);
+
+	PxU32* newIndices = reinterpret_cast<PxU32*>(PX_ALLOC_TEMP(sizeof(PxU32)*nbVerts, "PxU32"));
+	PxMemSet(newIndices, 0xff, sizeof(PxU32)*nbVerts);
+	PxU32 nbSorted = 0;
+	for(PxU32 i=0;i<nbIndices;i++)
+	{
+		const PxU32 vref = indices[i];
+		if(newIndices[vref]==0xffffffff)
+			newIndices[vref] = nbSorted++;
+		indices[i] = newIndices[vref];
+	}
+	// unreferenced vertices go last
+	for(PxU32 i=0;i<nbVerts;i++)
+	{
+		if(newIndices[i]==0xffffffff)
+			newIndices[i] = nbSorted++;
+	}
+
+	// one more vertex to make sure it's safe to V4Load the last one
+	PxVec3* vertices = reinterpret_cast<PxVec3*>(PX_ALLOC(sizeof(PxVec3)*(nbVerts+1), "PxVec3"));
+	for(PxU32 i=0;i<nbVerts;i++)
+		vertices[newIndices[i]] = mMeshData.mVertices[i];
+	vertices[nbVerts] = PxVec3(0.0f);
+	PX_FREE(newIndices);
+	PX_FREE(mMeshData.mVertices);
+	mMeshData.mVertices = vertices;
+
+	Gu::CompressedMesh header;
+	const PxU32 size = Gu::CompressedMesh::initLayout(header, nbVerts, mMeshData.mNbTriangles, 0);
+	Gu::CompressedMesh* compressed = reinterpret_cast<Gu::CompressedMesh*>(PX_ALLOC(size, "CompressedMesh"));
+	PxMemZero(compressed, size);
+	*compressed = header;
+
+	Gu::QuantizedVertexBlock* blocks = compressed->getVertexBlocks();
+	PxU16* quantized = compressed->getQuantizedVertices();
+	const PxU32 nbBlocks = Gu::CompressedMesh::getNbVertexBlocks(nbVerts);
+	for(PxU32 b=0;b<nbBlocks;b++)
+	{
+		const PxU32 first = b*GU_COMPRESSED_VERTEX_BLOCK_SIZE;
+		const PxU32 last = PxMin(first + GU_COMPRESSED_VERTEX_BLOCK_SIZE, nbVerts);
+
+		PxBounds3 bounds = PxBounds3::empty();
+		for(PxU32 i=first;i<last;i++)
+			bounds.include(vertices[i]);
+
+		const PxVec3 extents = bounds.maximum - bounds.minimum;
+		Gu::QuantizedVertexBlock& block = blocks[b];
+		block.mMin = bounds.minimum;
+		block.mScale = extents * (1.0f/65535.0f);
+		const PxVec3 quantCoeff(extents.x!=0.0f ? 65535.0f/extents.x : 0.0f,
+								extents.y!=0.0f ? 65535.0f/extents.y : 0.0f,
+								extents.z!=0.0f ? 65535.0f/extents.z : 0.0f);
+
+		for(PxU32 i=first;i<last;i++)
+		{
+			PxU16* q = quantized + i*3;
+			for(PxU32 j=0;j<3;j++)
+				q[j] = PxU16(PxClamp((vertices[i][j] - block.mMin[j]) * quantCoeff[j] + 0.5f, 0.0f, 65535.0f));
+			vertices[i] = Gu::dequantizeVertex(block, q);
+		}
+	}
+	mMeshData.mCompressed = compressed;
+
+	mData.mMeshInterface.setPointers(reinterpret_cast<IndTri32*>(indices), NULL, vertices);
+	PxBounds3 treeBounds;
+	mData.mBV4Tree.refit(treeBounds, boxEpsilon, 0, nbVerts);
 }
 
 void BV4TriangleMeshBuilder::createMidPhaseStructure()
@@ -1184,9 +1362,11 @@ void BV4TriangleMeshBuilder::createMidPhaseStructure()
 
 	mData.mMeshInterface.setPointers(triangles32, triangles16, mMeshData.mVertices);
 
-	const PxU32 nbTrisPerLeaf = (mParams.midphaseDesc.getType() == PxMeshMidPhase::eBVH34) ? mParams.midphaseDesc.mBVH34Desc.numTrisPerLeaf : 4;
+	const bool isBVH34 = mParams.midphaseDesc.getType() == PxMeshMidPhase::eBVH34;
+	const PxU32 nbTrisPerLeaf = isBVH34 ? mParams.midphaseDesc.mBVH34Desc.numTrisPerLeaf : 4;
+	const PxU32 nbSAHBins = (isBVH34 && mParams.midphaseDesc.mBVH34Desc.buildStrategy == PxBVH34BuildStrategy::eSAH) ? mParams.midphaseDesc.mBVH34Desc.numSAHBins : 0;
 
-	if(!BuildBV4Ex(mData.mBV4Tree, mData.mMeshInterface, gBoxEpsilon, nbTrisPerLeaf))
+	if(!BuildBV4Ex(mData.mBV4Tree, mData.mMeshInterface, gBoxEpsilon, nbTrisPerLeaf, nbSAHBins, mParams.cpuDispatcher))
 	{
 		Ps::getFoundation().error(PxErrorCode::eINTERNAL_ERROR, __FILE__, __LINE__, "BV4 tree failed to build.");
 		return;
@@ -1213,6 +1393,9 @@ void BV4TriangleMeshBuilder::createMidPhaseStructure()
 		mMeshData.mFaceRemap = newMap;
 	}
 	mData.mMeshInterface.releaseRemap();
+
+	if((mParams.meshPreprocessParams & PxMeshPreprocessingFlag::eCOMPRESS_MESH_DATA) && !mParams.buildGPUData)
+		compressVertices(gBoxEpsilon);
 }
 
 void BV4TriangleMeshBuilder::saveMidPhaseStructure(PxOutputStream& stream, bool mismatch) const
@@ -1375,7 +1558,7 @@ void RTreeTriangleMeshBuilder::createMidPhaseStructure()
 		mMeshData.mVertices, mMeshData.mNbVertices,
 		(mMeshData.mFlags & PxTriangleMeshFlag::e16_BIT_INDICES) ? reinterpret_cast<PxU16*>(mMeshData.mTriangles) : NULL,
 		!(mMeshData.mFlags & PxTriangleMeshFlag::e16_BIT_INDICES) ? reinterpret_cast<PxU32*>(mMeshData.mTriangles) : NULL,
-		mMeshData.mNbTriangles, resultPermute, &rc, meshSizePerformanceTradeOff, meshCookingHint);
+		mMeshData.mNbTriangles, resultPermute, &rc, meshSizePerformanceTradeOff, meshCookingHint, mParams.cpuDispatcher);
 
 	PX_ASSERT(resultPermute.size() == mMeshData.mNbTriangles);
 
@@ -33,6 +33,7 @@
 
 #include "GuMeshData.h"
 #include "cooking/PxCooking.h"
+#include "CookingScratch.h"
 
 namespace physx
 {
@@ -70,12 +71,14 @@ namespace physx
 	PX_FORCE_INLINE	Gu::TriangleMeshData&	getMeshData()	{ return mMeshData;	}
 	protected:
 				void						computeLocalBounds();
+				void						finishMeshCompression();
 				bool						importMesh(const PxTriangleMeshDesc& desc, const PxCookingParams& params, PxTriangleMeshCookingResult::Enum* condition, bool validate = false);
 
 				TriangleMeshBuilder& operator=(const TriangleMeshBuilder&);
 				Gu::EdgeListBuilder*		edgeList;
 				const PxCookingParams&		mParams;
 				Gu::TriangleMeshData&		mMeshData;
+				CookingScratchAllocator		mScratch;	// Temporary buffers, from PxCookingParams::scratchMemory
 
 				void						releaseEdgeList();
 				void						createEdgeList();
@@ -106,6 +109,8 @@ namespace physx
 		virtual	void						onMeshIndexFormatChange();
 
 		Gu::BV4TriangleData					mData;
+		private:
+				void						compressVertices(float boxEpsilon);
 	};
 
 	class BV32TriangleMeshBuilder
@@ -35,17 +35,19 @@
 #include "foundation/PxStrideIterator.h"
 #include "extensions/PxClothFabricCooker.h"
 #include "extensions/PxClothTetherCooker.h"
+#include "task/PxCpuDispatcher.h"
 #include "PxPhysics.h"
 #include "PsFoundation.h"
 #include "PsArray.h"
 #include "PsHashMap.h"
 #include "PsSort.h"
+#include "CmTask.h"
 
 using namespace physx;
 
 struct physx::PxFabricCookerImpl
 {
-	bool cook(const PxClothMeshDesc& desc, PxVec3 gravity, bool useGeodesicTether);
+	bool cook(const PxClothMeshDesc& desc, PxVec3 gravity, bool useGeodesicTether, PxCpuDispatcher* dispatcher);
 
 	PxClothFabricDesc getDescriptor() const;
 	void save(PxOutputStream& stream, bool platformMismatch) const;
@@ -64,10 +66,10 @@ public:
 	shdfnd::Array<PxU32> mTriangles;
 };
 
-PxClothFabricCooker::PxClothFabricCooker(const PxClothMeshDesc& desc, const PxVec3& gravity, bool useGeodesicTether)
+PxClothFabricCooker::PxClothFabricCooker(const PxClothMeshDesc& desc, const PxVec3& gravity, bool useGeodesicTether, PxCpuDispatcher* dispatcher)
 : mImpl(new PxFabricCookerImpl())
 {
-	mImpl->cook(desc, gravity, useGeodesicTether);
+	mImpl->cook(desc, gravity, useGeodesicTether, dispatcher);
 }
 
 PxClothFabricCooker::~PxClothFabricCooker()
@@ -86,11 +88,11 @@ void PxClothFabricCooker::save(PxOutputStream& stream, bool platformMismatch) co
 }
 
 
-PxClothFabric* physx::PxClothFabricCreate( PxPhysics& physics, const PxClothMeshDesc& desc, const PxVec3& gravity, bool useGeodesicTether )
+PxClothFabric* physx::PxClothFabricCreate( PxPhysics& physics, const PxClothMeshDesc& desc, const PxVec3& gravity, bool useGeodesicTether, PxCpuDispatcher* dispatcher )
 {
 	PxFabricCookerImpl impl;
 
-	if(!impl.cook(desc, gravity, useGeodesicTether))
+	if(!impl.cook(desc, gravity, useGeodesicTether, dispatcher))
 		return 0;
 
 	return physics.createClothFabric(impl.getDescriptor());
@@ -285,7 +287,7 @@ namespace
 	{
 	public:
 
-		ConstraintSorter(PxU32* constraints_) : constraints(constraints_) {}
+		ConstraintSorter(const PxU32* constraints_) : constraints(constraints_) {}
 
 		bool operator()(PxU32 i, PxU32 j) const
 		{
@@ -298,12 +300,47 @@ namespace
 				return constraints[ci] < constraints[cj];
 		}
 
-		PxU32* constraints;
+		const PxU32* constraints;
+	};
+
+	// sorts the constraints of one phase set in vertex order, sets write disjoint ranges of the output arrays
+	struct ConstraintSetSortJob
+	{
+		const PxU32*	mSets;
+		const PxU32*	mIndices;
+		const PxReal*	mRestvalues;
+		PxU32*			mNewIndices;
+		PxReal*			mNewRestValues;
+
+		void operator()(PxU32 i)
+		{
+			// create a re-ordering list
+			shdfnd::Array<PxU32> reorder(mSets[i+1]-mSets[i]);
+
+			for (PxU32 r=0; r < reorder.size(); ++r)
+				reorder[r] = r;
+
+			if (reorder.empty())
+				return;
+
+			const PxU32 indicesOffset = mSets[i]*2;
+			const PxU32 restOffset = mSets[i];
+
+			ConstraintSorter predicate(mIndices + indicesOffset);
+			shdfnd::sort(&reorder[0], reorder.size(), predicate);
+		
+			for (PxU32 r=0; r < reorder.size(); ++r)
+			{
+				mNewIndices[indicesOffset + r*2] = mIndices[indicesOffset + reorder[r]*2];
+				mNewIndices[indicesOffset + r*2+1] = mIndices[indicesOffset + reorder[r]*2+1];
+				mNewRestValues[restOffset + r] = mRestvalues[restOffset + reorder[r]];
+			}
+		}
 	};
 
 } // anonymous namespace
 
-bool PxFabricCookerImpl::cook(const PxClothMeshDesc& desc, PxVec3 gravity, bool useGeodesicTether)
+bool PxFabricCookerImpl::cook(const PxClothMeshDesc& desc, PxVec3 gravity, bool useGeodesicTether, PxCpuDispatcher* dispatcher)
 {	
 	if(!desc.isValid())
 	{
@@ -531,28 +568,15 @@ bool PxFabricCookerImpl::cook(const PxClothMeshDesc& desc, PxVec3 gravity, bool
 	shdfnd::Array<PxU32> newIndices(mIndices.size());
 	shdfnd::Array<PxF32> newRestValues(mRestvalues.size());
 
-	// sort each constraint set in vertex order
-	for (PxU32 i=0; i < mSets.size()-1; ++i)
-	{
-		// create a re-ordering list
-		shdfnd::Array<PxU32> reorder(mSets[i+1]-mSets[i]);
-
-		for (PxU32 r=0; r < reorder.size(); ++r)
-			reorder[r] = r;
-
-		const PxU32 indicesOffset = mSets[i]*2;
-		const PxU32 restOffset = mSets[i];
-
-		ConstraintSorter predicate(&mIndices[indicesOffset]);
-		shdfnd::sort(&reorder[0], reorder.size(), predicate);
-		
-		for (PxU32 r=0; r < reorder.size(); ++r)
-		{
-			newIndices[indicesOffset + r*2] = mIndices[indicesOffset + reorder[r]*2];
-			newIndices[indicesOffset + r*2+1] = mIndices[indicesOffset + reorder[r]*2+1];
-			newRestValues[restOffset + r] = mRestvalues[restOffset + reorder[r]];
-		}
-	}
+	// sort each constraint set in vertex order.
+	// The graph coloring above stays serial: it is greedy and order dependent, and the phases must not change with the thread count.
+	ConstraintSetSortJob sortJob;
+	sortJob.mSets			= mSets.begin();
+	sortJob.mIndices		= mIndices.begin();
+	sortJob.mRestvalues		= mRestvalues.begin();
+	sortJob.mNewIndices		= newIndices.begin();
+	sortJob.mNewRestValues	= newRestValues.begin();
+	Cm::runParallelJobs(dispatcher, mSets.size()-1, sortJob);
 
 	mIndices = newIndices;
 	mRestvalues = newRestValues;
@@ -571,7 +595,7 @@ bool PxFabricCookerImpl::cook(const PxClothMeshDesc& desc, PxVec3 gravity, bool
 
 	if (useGeodesicTether)
 	{
-		PxClothGeodesicTetherCooker tetherCooker(desc);
+		PxClothGeodesicTetherCooker tetherCooker(desc, dispatcher);
 		if (tetherCooker.getCookerStatus() == 0)
 		{
 			PxU32 numTethersPerParticle = tetherCooker.getNbTethersPerParticle();
@@ -34,6 +34,7 @@
 #include "foundation/PxMemory.h"
 #include "foundation/PxStrideIterator.h"
 #include "extensions/PxClothTetherCooker.h"
+#include "task/PxCpuDispatcher.h"
 
 // from shared foundation
 #include <PsFoundation.h>
@@ -41,6 +42,7 @@
 #include <Ps.h>
 #include <PsMathUtils.h>
 #include "PsArray.h"
+#include "CmTask.h"
 
 using namespace physx;
 
@@ -308,13 +310,30 @@ namespace
 
 		return true;
 	}
+
+	// ---------------------------------------------------------------------------------------
+	// Shared by the per-island shortest path searches and the per-particle tether evaluations of createTetherData.
+	// Each island and each particle only writes its own entries, so they can run in any order.
+	struct TetherSearchData
+	{
+		const PxU32*	valency;
+		const PxU32*	neighbors;
+		const PxU32*	islandFirst;
+		const PxU32*	islandIndices;
+		float*			vertexDistanceBuffer;	// islandCnt * mNumParticles
+		PxU32*			vertexParentBuffer;		// islandCnt * mNumParticles
+		PxU32			islandCnt;
+		PxU32			nbTethersPerParticle;
+	};
+
+	const PxU32 gNbParticlesPerTetherJob = 256;
 }
 
 
 struct physx::PxClothGeodesicTetherCookerImpl
 {
 
-	PxClothGeodesicTetherCookerImpl(const PxClothMeshDesc& desc);
+	PxClothGeodesicTetherCookerImpl(const PxClothMeshDesc& desc, PxCpuDispatcher* dispatcher);
 
 	PxU32	getCookerStatus() const;
 	PxU32	getNbTethersPerParticle() const;
@@ -340,11 +359,15 @@ public:
 	shdfnd::Array<PxU32>	mTetherAnchors;
 	shdfnd::Array<PxReal>	mTetherLengths;
 
+	// jobs of createTetherData
+	void	computeIslandDistances(const TetherSearchData& data, PxU32 island) const;
+	void	computeParticleTethers(const TetherSearchData& data, PxU32 first, PxU32 last);
+
 protected:
-	void	createTetherData(const PxClothMeshDesc &desc);
-	int		computeVertexIntersection(PxU32 parent, PxU32 src, PathIntersection &path);
-	int		computeEdgeIntersection(PxU32 parent, PxU32 edge, float in_s, PathIntersection &path);
-	float	computeGeodesicDistance(PxU32 i, PxU32 parent, int &errorCode);
+	void	createTetherData(const PxClothMeshDesc &desc, PxCpuDispatcher* dispatcher);
+	int		computeVertexIntersection(PxU32 parent, PxU32 src, PathIntersection &path) const;
+	int		computeEdgeIntersection(PxU32 parent, PxU32 edge, float in_s, PathIntersection &path) const;
+	float	computeGeodesicDistance(PxU32 i, PxU32 parent, int &errorCode) const;
 	PxU32	findTriNeighbors();
 	void	findVertTriNeighbors();
 
@@ -352,8 +375,8 @@ private:
 	PxClothGeodesicTetherCookerImpl& operator=(const PxClothGeodesicTetherCookerImpl&);
 };
 
-PxClothGeodesicTetherCooker::PxClothGeodesicTetherCooker(const PxClothMeshDesc& desc)
-: mImpl(new PxClothGeodesicTetherCookerImpl(desc))
+PxClothGeodesicTetherCooker::PxClothGeodesicTetherCooker(const PxClothMeshDesc& desc, PxCpuDispatcher* dispatcher)
+: mImpl(new PxClothGeodesicTetherCookerImpl(desc, dispatcher))
 {
 }
 
@@ -378,15 +401,38 @@ void PxClothGeodesicTetherCooker::getTetherData(PxU32* userTetherAnchors, PxReal
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-PxClothGeodesicTetherCookerImpl::PxClothGeodesicTetherCookerImpl(const PxClothMeshDesc &desc)
+PxClothGeodesicTetherCookerImpl::PxClothGeodesicTetherCookerImpl(const PxClothMeshDesc &desc, PxCpuDispatcher* dispatcher)
 	:mDesc(desc),
 	mCookerStatus(0)
 {
-	createTetherData(desc);
+	createTetherData(desc, dispatcher);
+}
+
+namespace
+{
+	struct IslandDistanceJob
+	{
+		const PxClothGeodesicTetherCookerImpl*	mCooker;
+		const TetherSearchData*					mData;
+
+		void operator()(PxU32 island)	{ mCooker->computeIslandDistances(*mData, island);	}
+	};
+
+	struct ParticleTetherJob
+	{
+		PxClothGeodesicTetherCookerImpl*	mCooker;
+		const TetherSearchData*				mData;
+
+		void operator()(PxU32 jobIndex)
+		{
+			const PxU32 first = jobIndex * gNbParticlesPerTetherJob;
+			mCooker->computeParticleTethers(*mData, first, PxMin(first + gNbParticlesPerTetherJob, mCooker->mNumParticles));
+		}
+	};
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void PxClothGeodesicTetherCookerImpl::createTetherData(const PxClothMeshDesc &desc)
+void PxClothGeodesicTetherCookerImpl::createTetherData(const PxClothMeshDesc &desc, PxCpuDispatcher* dispatcher)
 {
 	mNumParticles = desc.points.count;
 	
@@ -518,89 +564,117 @@ void PxClothGeodesicTetherCookerImpl::createTetherData(const PxClothMeshDesc &de
 
 	shdfnd::Array<float> vertexDistanceBuffer(bufferSize, PX_MAX_F32);
 	shdfnd::Array<PxU32> vertexParentBuffer(bufferSize, 0);
+
+	const PxU32 maxTethersPerParticle = 4; // max tethers
+	const PxU32 nbTethersPerParticle = (islandCnt > maxTethersPerParticle) ? maxTethersPerParticle : islandCnt;
+
+	TetherSearchData data;
+	data.valency				= valency.begin();
+	data.neighbors				= neighbors.begin();
+	data.islandFirst			= islandFirst.begin();
+	data.islandIndices			= islandIndices.begin();
+	data.vertexDistanceBuffer	= vertexDistanceBuffer.begin();
+	data.vertexParentBuffer		= vertexParentBuffer.begin();
+	data.islandCnt				= islandCnt;
+	data.nbTethersPerParticle	= nbTethersPerParticle;
+
+	// now process each island. Islands are searched independently, so the dispatcher (if any) can process them in any order.
+	IslandDistanceJob islandJob;
+	islandJob.mCooker	= this;
+	islandJob.mData		= &data;
+	Cm::runParallelJobs(dispatcher, islandCnt, islandJob);
+
+	PxU32 nbTethers = nbTethersPerParticle * mNumParticles;
+	mTetherAnchors.resize(nbTethers);
+	mTetherLengths.resize(nbTethers);
+
+	// now process the parent and distance and add to fibers
+	ParticleTetherJob particleJob;
+	particleJob.mCooker	= this;
+	particleJob.mData	= &data;
+	Cm::runParallelJobs(dispatcher, (mNumParticles + gNbParticlesPerTetherJob - 1) / gNbParticlesPerTetherJob, particleJob);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// single source shortest paths from the attached vertices of an island
+void PxClothGeodesicTetherCookerImpl::computeIslandDistances(const TetherSearchData& data, PxU32 i) const
+{
 	shdfnd::Array<VertexDistanceCount> vertexHeap;
+	float* vertexDistance = data.vertexDistanceBuffer + (i * mNumParticles);
+	PxU32* vertexParent = data.vertexParentBuffer + (i * mNumParticles);
 
-	// now process each island 
-	for (PxU32 i = 0; i < islandCnt; i++)
+	// initialize parent and distance
+	for (PxU32 j = 0; j < mNumParticles; ++j)
 	{
-		vertexHeap.clear();
-		float* vertexDistance = &vertexDistanceBuffer[0] + (i * mNumParticles);
-		PxU32* vertexParent = &vertexParentBuffer[0] + (i * mNumParticles);
+		vertexParent[j] = j;
+		vertexDistance[j] = PX_MAX_F32;
+	}
 
-		// initialize parent and distance
-		for (PxU32 j = 0; j < mNumParticles; ++j)
-		{
-			vertexParent[j] = j;
-			vertexDistance[j] = PX_MAX_F32;
-		}
+	// put all the attached vertices in this island to heap
+	const PxU32 beginIsland = data.islandFirst[i];
+	const PxU32 endIsland = data.islandFirst[i+1];
+	for (PxU32 j = beginIsland; j < endIsland; j++)
+	{
+		PxU32 vj = data.islandIndices[j];
+		vertexDistance[vj] = 0.0f;
+		vertexHeap.pushBack(VertexDistanceCount(int(vj), 0.0f, 0));
+	}
 
-		// put all the attached vertices in this island to heap
-		const PxU32 beginIsland = islandFirst[i];
-		const PxU32 endIsland = islandFirst[i+1];
-		for (PxU32 j = beginIsland; j < endIsland; j++)
-		{
-			PxU32 vj = islandIndices[j];
-			vertexDistance[vj] = 0.0f;
-			vertexHeap.pushBack(VertexDistanceCount(int(vj), 0.0f, 0));
-		}
+	// no attached vertices in this island (error?)
+	PX_ASSERT(vertexHeap.empty() == false);
+
+	// while heap is not empty
+	while (!vertexHeap.empty())
+	{
+		// pop vi from heap
+		VertexDistanceCount vi = popHeap(vertexHeap);
 
-		// no attached vertices in this island (error?)
-		PX_ASSERT(vertexHeap.empty() == false);
-		if (vertexHeap.empty())
+		// obsolete entry ( we already found better distance)
+		if (vi.distance > vertexDistance[vi.vertNr])
 			continue;
 
-		// while heap is not empty
-		while (!vertexHeap.empty())
+		// for each adjacent vj that's not visited
+		const PxI32 begin = PxI32(data.valency[PxU32(vi.vertNr)]);
+		const PxI32 end = PxI32(data.valency[PxU32(vi.vertNr + 1)]);
+		for (PxI32 j = begin; j < end; ++j)
 		{
-			// pop vi from heap
-			VertexDistanceCount vi = popHeap(vertexHeap);
+			const PxI32 vj = PxI32(data.neighbors[PxU32(j)]);
+			PxVec3 edge = mVertices[PxU32(vj)] - mVertices[PxU32(vi.vertNr)];
+			const PxF32 edgeLength = edge.magnitude();
+			float newDistance = vi.distance + edgeLength;
 
-			// obsolete entry ( we already found better distance)
-			if (vi.distance > vertexDistance[vi.vertNr])
-				continue;
-
-			// for each adjacent vj that's not visited
-			const PxI32 begin = PxI32(valency[PxU32(vi.vertNr)]);
-			const PxI32 end = PxI32(valency[PxU32(vi.vertNr + 1)]);
-			for (PxI32 j = begin; j < end; ++j)
+			if (newDistance < vertexDistance[vj])
 			{
-				const PxI32 vj = PxI32(neighbors[PxU32(j)]);
-				PxVec3 edge = mVertices[PxU32(vj)] - mVertices[PxU32(vi.vertNr)];
-				const PxF32 edgeLength = edge.magnitude();
-				float newDistance = vi.distance + edgeLength;
+				vertexDistance[vj] = newDistance;
+				vertexParent[vj] = vertexParent[vi.vertNr];
 
-				if (newDistance < vertexDistance[vj])
-				{
-					vertexDistance[vj] = newDistance;
-					vertexParent[vj] = vertexParent[vi.vertNr];
-	
-					pushHeap(vertexHeap, VertexDistanceCount(vj, newDistance, 0));
-				}
+				pushHeap(vertexHeap, VertexDistanceCount(vj, newDistance, 0));
 			}
 		}
 	}
+}
 
-	const PxU32 maxTethersPerParticle = 4; // max tethers
-	const PxU32 nbTethersPerParticle = (islandCnt > maxTethersPerParticle) ? maxTethersPerParticle : islandCnt;
-
-	PxU32 nbTethers = nbTethersPerParticle * mNumParticles;
-	mTetherAnchors.resize(nbTethers);
-	mTetherLengths.resize(nbTethers);
+///////////////////////////////////////////////////////////////////////////////
+// picks the closest islands of particles [first, last) and computes their tether lengths
+void PxClothGeodesicTetherCookerImpl::computeParticleTethers(const TetherSearchData& data, PxU32 first, PxU32 last)
+{
+	const PxU32 islandCnt = data.islandCnt;
+	shdfnd::Array<VertexDistanceCount> vertexHeap;
+	vertexHeap.reserve(islandCnt);
 
-	// now process the parent and distance and add to fibers
-	for (PxU32 i = 0; i < mNumParticles; i++)
+	for (PxU32 i = first; i < last; i++)
 	{
 		// we use the heap to sort out N-closest island
 		vertexHeap.clear();
 		for (PxU32 j = 0; j < islandCnt; j++)
 		{
-			int parent = int(vertexParentBuffer[j * mNumParticles + i]);
-			float edgeDistance = vertexDistanceBuffer[j * mNumParticles + i];
+			int parent = int(data.vertexParentBuffer[j * mNumParticles + i]);
+			float edgeDistance = data.vertexDistanceBuffer[j * mNumParticles + i];
 			pushHeap(vertexHeap, VertexDistanceCount(parent, edgeDistance, 0));
 		}
 
 		// take out N-closest island from the heap
-		for (PxU32 j = 0; j < nbTethersPerParticle; j++)
+		for (PxU32 j = 0; j < data.nbTethersPerParticle; j++)
 		{
 			VertexDistanceCount vi = popHeap(vertexHeap);
 			PxU32 parent = PxU32(vi.vertNr);
@@ -730,7 +804,7 @@ void PxClothGeodesicTetherCookerImpl::findVertTriNeighbors()
 
 ///////////////////////////////////////////////////////////////////////////////
 // compute intersection of a ray from a source vertex in direction toward parent
-int PxClothGeodesicTetherCookerImpl::computeVertexIntersection(PxU32 parent, PxU32 src, PathIntersection &path)
+int PxClothGeodesicTetherCookerImpl::computeVertexIntersection(PxU32 parent, PxU32 src, PathIntersection &path) const
 {
 	if (src == parent)
 	{
@@ -849,7 +923,7 @@ int PxClothGeodesicTetherCookerImpl::computeVertexIntersection(PxU32 parent, PxU
 
 ///////////////////////////////////////////////////////////////////////////////
 // compute intersection of a ray from a source vertex in direction toward parent
-int PxClothGeodesicTetherCookerImpl::computeEdgeIntersection(PxU32 parent, PxU32 edge, float in_s, PathIntersection &path)
+int PxClothGeodesicTetherCookerImpl::computeEdgeIntersection(PxU32 parent, PxU32 edge, float in_s, PathIntersection &path) const
 {
 	int tid = int(edge / 3);
 	int eid = int(edge % 3);
@@ -965,7 +1039,7 @@ int PxClothGeodesicTetherCookerImpl::computeEdgeIntersection(PxU32 parent, PxU32
 
 ///////////////////////////////////////////////////////////////////////////////
 // compute geodesic distance and path from vertex i to its parent
-float PxClothGeodesicTetherCookerImpl::computeGeodesicDistance(PxU32 i, PxU32 parent, int &errorCode)
+float PxClothGeodesicTetherCookerImpl::computeGeodesicDistance(PxU32 i, PxU32 parent, int &errorCode) const
 {
 	if (i == parent)
 		return 0.0f;
@@ -0,0 +1,236 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+
+#ifndef NP_CONSTRAINT_HELPER4_H
+#define NP_CONSTRAINT_HELPER4_H
+
+#include "foundation/PxTransform.h"
+#include "PxConstraintDesc.h"
+#include "PsVecMath.h"
+
+namespace physx
+{
+namespace Ext
+{
+	namespace joint
+	{
+		using namespace Ps::aos;
+
+		// four vectors in structure-of-arrays layout, one lane per joint
+		struct Vec3V4
+		{
+			Vec4V x, y, z;
+		};
+
+		PX_FORCE_INLINE Vec3V4 loadVec3V4(const PxVec3& v0, const PxVec3& v1, const PxVec3& v2, const PxVec3& v3)
+		{
+			Vec4V c0 = Vec4V_From_Vec3V(V3LoadU(v0));
+			Vec4V c1 = Vec4V_From_Vec3V(V3LoadU(v1));
+			Vec4V c2 = Vec4V_From_Vec3V(V3LoadU(v2));
+			Vec4V c3 = Vec4V_From_Vec3V(V3LoadU(v3));
+			V4Transpose(c0, c1, c2, c3);
+
+			Vec3V4 v;
+			v.x = c0;	v.y = c1;	v.z = c2;
+			return v;
+		}
+
+		PX_FORCE_INLINE void loadQuat4(const PxTransform* t, Vec4V& x, Vec4V& y, Vec4V& z, Vec4V& w)
+		{
+			x = V4LoadU(&t[0].q.x);
+			y = V4LoadU(&t[1].q.x);
+			z = V4LoadU(&t[2].q.x);
+			w = V4LoadU(&t[3].q.x);
+			V4Transpose(x, y, z, w);
+		}
+
+		PX_FORCE_INLINE Vec3V4 add(const Vec3V4& a, const Vec3V4& b)
+		{
+			Vec3V4 r;
+			r.x = V4Add(a.x, b.x);	r.y = V4Add(a.y, b.y);	r.z = V4Add(a.z, b.z);
+			return r;
+		}
+
+		PX_FORCE_INLINE Vec3V4 sub(const Vec3V4& a, const Vec3V4& b)
+		{
+			Vec3V4 r;
+			r.x = V4Sub(a.x, b.x);	r.y = V4Sub(a.y, b.y);	r.z = V4Sub(a.z, b.z);
+			return r;
+		}
+
+		PX_FORCE_INLINE Vec3V4 scale(const Vec3V4& a, const Vec4V s)
+		{
+			Vec3V4 r;
+			r.x = V4Mul(a.x, s);	r.y = V4Mul(a.y, s);	r.z = V4Mul(a.z, s);
+			return r;
+		}
+
+		PX_FORCE_INLINE Vec4V dot(const Vec3V4& a, const Vec3V4& b)
+		{
+			return V4MulAdd(a.x, b.x, V4MulAdd(a.y, b.y, V4Mul(a.z, b.z)));
+		}
+
+		PX_FORCE_INLINE Vec3V4 cross(const Vec3V4& a, const Vec3V4& b)
+		{
+			Vec3V4 r;
+			r.x = V4NegMulSub(a.z, b.y, V4Mul(a.y, b.z));
+			r.y = V4NegMulSub(a.x, b.z, V4Mul(a.z, b.x));
+			r.z = V4NegMulSub(a.y, b.x, V4Mul(a.x, b.y));
+			return r;
+		}
+
+		PX_FORCE_INLINE void storeTransposed(const Vec3V4& v, const Vec4V w, Px1DConstraint* const* rows, PxU32 index, PxU32 offset)
+		{
+			Vec4V c0 = v.x, c1 = v.y, c2 = v.z, c3 = w;
+			V4Transpose(c0, c1, c2, c3);
+			V4StoreU(c0, reinterpret_cast<PxF32*>(rows[0] + index) + offset);
+			V4StoreU(c1, reinterpret_cast<PxF32*>(rows[1] + index) + offset);
+			V4StoreU(c2, reinterpret_cast<PxF32*>(rows[2] + index) + offset);
+			V4StoreU(c3, reinterpret_cast<PxF32*>(rows[3] + index) + offset);
+		}
+
+		// writes one hard row for each of the four joints, i.e. what ConstraintHelper::prepareLockedAxes writes for one axis
+		PX_FORCE_INLINE void writeHardRow4(Px1DConstraint* const* rows, PxU32 index,
+										   const Vec3V4& linear0, const Vec3V4& angular0, const Vec3V4& linear1, const Vec3V4& angular1,
+										   const Vec4V geometricError)
+		{
+			const Vec4V maxImpulse = V4Load(PX_MAX_F32);
+
+			// each vector is followed by a scalar in Px1DConstraint, so both are written with one store per row
+			storeTransposed(linear0, geometricError, rows, index, 0);
+			storeTransposed(angular0, V4Zero(), rows, index, 4);
+			storeTransposed(linear1, V4Neg(maxImpulse), rows, index, 8);
+			storeTransposed(angular1, maxImpulse, rows, index, 12);
+
+			for(PxU32 a=0; a<4; a++)
+			{
+				rows[a][index].solveHint = PxU16(PxConstraintSolveHint::eEQUALITY);
+				rows[a][index].flags = Px1DConstraintFlag::eOUTPUT_FORCE;
+			}
+		}
+
+		// SIMD version of ConstraintHelper::prepareLockedAxes for four joints locking the same axes. The rows are written in the
+		// same order at the start of each joint's buffer, and the number of rows written per joint is returned.
+		PX_FORCE_INLINE PxU32 prepareLockedAxes4(Px1DConstraint* const* rows, const PxTransform* cA2w, const PxTransform* cB2w,
+												 const PxVec3* ra, const PxVec3* rb, PxU32 lin, PxU32 ang)
+		{
+			const Vec4V zero = V4Zero();
+			const Vec4V one = V4One();
+
+			Vec3V4 zero3;
+			zero3.x = zero;	zero3.y = zero;	zero3.z = zero;
+
+			Vec3V4 va;
+			Vec4V wa;
+			loadQuat4(cA2w, va.x, va.y, va.z, wa);
+
+			PxU32 count = 0;
+			if(ang)
+			{
+				Vec3V4 vb;
+				Vec4V wb;
+				loadQuat4(cB2w, vb.x, vb.y, vb.z, wb);
+
+				// imaginary part of qA.getConjugate() * qB
+				const Vec3V4 imp = sub(sub(scale(vb, wa), scale(va, wb)), cross(va, vb));
+
+				// computeJacobianAxes
+				const Vec3V4 c = add(scale(vb, wa), scale(va, wb));
+				const Vec4V d0 = V4Mul(wa, wb);
+				const Vec4V d1 = dot(va, vb);
+				const Vec4V d = V4Sub(d0, d1);
+				const Vec4V half = V4Load(0.5f);
+				const Vec4V eps = V4Sel(V4IsEq(V4Add(d0, d1), zero), V4Load(PX_EPS_F32), zero);
+
+				Vec3V4 row[3], diag;
+				diag.x = d;			diag.y = c.z;			diag.z = V4Neg(c.y);
+				row[0] = scale(add(add(scale(va, vb.x), scale(vb, va.x)), diag), half);
+				diag.x = V4Neg(c.z);	diag.y = d;			diag.z = c.x;
+				row[1] = scale(add(add(scale(va, vb.y), scale(vb, va.y)), diag), half);
+				diag.x = c.y;			diag.y = V4Neg(c.x);	diag.z = d;
+				row[2] = scale(add(add(scale(va, vb.z), scale(vb, va.z)), diag), half);
+
+				row[0].x = V4Add(row[0].x, eps);
+				row[1].y = V4Add(row[1].y, eps);
+				row[2].z = V4Add(row[2].z, eps);
+
+				if(ang&1) writeHardRow4(rows, count++, zero3, row[0], zero3, row[0], V4Neg(imp.x));
+				if(ang&2) writeHardRow4(rows, count++, zero3, row[1], zero3, row[1], V4Neg(imp.y));
+				if(ang&4) writeHardRow4(rows, count++, zero3, row[2], zero3, row[2], V4Neg(imp.z));
+			}
+
+			if(lin)
+			{
+				// columns of PxMat33(qA)
+				const Vec3V4 v2 = add(va, va);
+				const Vec4V xx = V4Mul(v2.x, va.x), yy = V4Mul(v2.y, va.y), zz = V4Mul(v2.z, va.z);
+				const Vec4V xy = V4Mul(v2.x, va.y), xz = V4Mul(v2.x, va.z), xw = V4Mul(v2.x, wa);
+				const Vec4V yz = V4Mul(v2.y, va.z), yw = V4Mul(v2.y, wa), zw = V4Mul(v2.z, wa);
+
+				Vec3V4 axes[3];
+				axes[0].x = V4Sub(V4Sub(one, yy), zz);	axes[0].y = V4Add(xy, zw);				axes[0].z = V4Sub(xz, yw);
+				axes[1].x = V4Sub(xy, zw);				axes[1].y = V4Sub(V4Sub(one, xx), zz);	axes[1].z = V4Add(yz, xw);
+				axes[2].x = V4Add(xz, yw);				axes[2].y = V4Sub(yz, xw);				axes[2].z = V4Sub(V4Sub(one, xx), yy);
+
+				// cA2w.transformInv(cB2w.p)
+				const Vec3V4 d = sub(loadVec3V4(cB2w[0].p, cB2w[1].p, cB2w[2].p, cB2w[3].p), loadVec3V4(cA2w[0].p, cA2w[1].p, cA2w[2].p, cA2w[3].p));
+				const Vec4V cB2cAp[3] = { dot(axes[0], d), dot(axes[1], d), dot(axes[2], d) };
+
+				Vec3V4 raError = loadVec3V4(ra[0], ra[1], ra[2], ra[3]);
+				for(PxU32 i=0; i<3; i++)
+				{
+					if(lin & (1<<i))
+						raError = sub(raError, scale(axes[i], cB2cAp[i]));
+				}
+				const Vec3V4 rB = loadVec3V4(rb[0], rb[1], rb[2], rb[3]);
+
+				for(PxU32 i=0; i<3; i++)
+				{
+					if(lin & (1<<i))
+						writeHardRow4(rows, count++, axes[i], cross(raError, axes[i]), axes[i], cross(rB, axes[i]), V4Neg(cB2cAp[i]));
+				}
+			}
+
+			return count;
+		}
+
+		// runs the per-joint shader on each of the four joints, for batches the SIMD path does not handle
+		PX_FORCE_INLINE void solverPrep4Scalar(PxConstraintSolverPrep solverPrep, Px1DConstraint* const* constraints, PxU32* rowCounts,
+											   PxVec3* body0WorldOffsets, PxU32 maxConstraints, PxConstraintInvMassScale* invMassScales,
+											   const void* const* constantBlocks, const PxTransform* bA2w, const PxTransform* bB2w)
+		{
+			for(PxU32 a=0; a<4; a++)
+				rowCounts[a] = solverPrep(constraints[a], body0WorldOffsets[a], maxConstraints, invMassScales[a], constantBlocks[a], bA2w[a], bB2w[a]);
+		}
+	}
+} // namespace
+
+}
+
+#endif
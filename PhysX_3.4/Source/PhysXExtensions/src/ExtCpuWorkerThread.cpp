@@ -36,9 +36,13 @@
 
 using namespace physx;
 
+// number of unsuccessful fetch rounds an idle worker spins through before it blocks
+#define EXT_WORK_STEALING_SPIN_COUNT 64
+
 Ext::CpuWorkerThread::CpuWorkerThread()
 :	mQueueEntryPool(EXT_TASK_QUEUE_ENTRY_POOL_SIZE),
-	mThreadId(0)
+	mThreadId(0),
+	mRandomState(1)
 {
 }
 
@@ -48,9 +52,11 @@ Ext::CpuWorkerThread::~CpuWorkerThread()
 }
 
 
-void Ext::CpuWorkerThread::initialize(DefaultCpuDispatcher* ownerDispatcher)
+void Ext::CpuWorkerThread::initialize(DefaultCpuDispatcher* ownerDispatcher, PxU32 workerIndex)
 {
 	mOwner = ownerDispatcher;
+	// any non-zero seed works for xorshift, make them differ per worker
+	mRandomState = (workerIndex + 1) * 2654435761u;
 }
 
 
@@ -82,11 +88,21 @@ void Ext::CpuWorkerThread::execute()
 {
 	mThreadId = getId();
 
+	if(mOwner->getMode() == PxDefaultCpuDispatcherMode::eWORK_STEALING)
+	{
+		executeWorkStealing();
+		quit();
+		return;
+	}
+
 	while (!quitIsSignalled())
     {
         mOwner->resetWakeSignal();
 
-		PxBaseTask* task = TaskQueueHelper::fetchTask(mLocalJobList, mQueueEntryPool);
+		PxBaseTask* task = mOwner->getHighPriorityJob();
+
+		if(!task)
+			task = TaskQueueHelper::fetchTask(mLocalJobList, mQueueEntryPool);
 
 		if(!task)
 			task = mOwner->fetchNextTask();
@@ -104,3 +120,45 @@ void Ext::CpuWorkerThread::execute()
 
 	quit();
 }
+
+
+void Ext::CpuWorkerThread::executeWorkStealing()
+{
+	Ps::TlsSet(mOwner->getWorkerTlsSlot(), this);
+
+	PxU32 idleRounds = 0;
+	while(!quitIsSignalled())
+	{
+		PxBaseTask* task = mOwner->getHighPriorityJob();
+
+		if(!task)
+			task = mDeque.pop();
+
+		if(!task)
+			task = mOwner->getJob();
+
+		if(!task)
+			task = mOwner->stealJob(*this);
+
+		if(!task)
+		{
+			if(idleRounds < EXT_WORK_STEALING_SPIN_COUNT)
+			{
+				idleRounds++;
+				PxSpinLockPause();
+				continue;
+			}
+
+			task = mOwner->parkWorker(*this);
+		}
+
+		idleRounds = 0;
+		if(task)
+		{
+			mOwner->runTask(*task);
+			task->release();
+		}
+	}
+
+	Ps::TlsSet(mOwner->getWorkerTlsSlot(), NULL);
+}
@@ -35,6 +35,7 @@
 #include "PsThread.h"
 #include "ExtDefaultCpuDispatcher.h"
 #include "ExtSharedQueueEntryPool.h"
+#include "ExtWorkStealingDeque.h"
 
 
 namespace physx
@@ -55,17 +56,33 @@ class DefaultCpuDispatcher;
         CpuWorkerThread();
         ~CpuWorkerThread();
 		
-		void					initialize(DefaultCpuDispatcher* ownerDispatcher);
+		void					initialize(DefaultCpuDispatcher* ownerDispatcher, PxU32 workerIndex);
 		void					execute();
 		bool					tryAcceptJobToLocalQueue(PxBaseTask& task, Ps::Thread::Id taskSubmitionThread);
 		PxBaseTask*				giveUpJob();
 		Ps::Thread::Id			getWorkerThreadId() const { return mThreadId; }
 
+		// eWORK_STEALING mode
+		PX_FORCE_INLINE bool			pushLocalTask(PxBaseTask& task)	{ return mDeque.push(task);	}
+		PX_FORCE_INLINE PxBaseTask*		stealLocalTask()				{ return mDeque.steal();	}
+		PX_FORCE_INLINE PxU32			getRandom()
+										{
+											// xorshift32, only used for victim selection
+											mRandomState ^= mRandomState << 13;
+											mRandomState ^= mRandomState >> 17;
+											mRandomState ^= mRandomState << 5;
+											return mRandomState;
+										}
+
 	protected:
+		void					executeWorkStealing();
+
 		SharedQueueEntryPool<>			mQueueEntryPool;
 		DefaultCpuDispatcher*			mOwner;
 		Ps::SList      				    mLocalJobList;
 		Ps::Thread::Id					mThreadId;
+		PxU32							mRandomState;
+		WorkStealingDeque				mDeque;
 	};
 
 #if PX_VC
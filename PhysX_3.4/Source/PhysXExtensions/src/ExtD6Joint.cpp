@@ -576,5 +576,5 @@ const PxConstraintShaderTable* Ext::GetD6JointShaderTable()
 }
 
 //~PX_SERIALIZATION
-PxConstraintShaderTable Ext::D6Joint::sShaders = { Ext::D6JointSolverPrep, D6JointProject, D6JointVisualize, PxConstraintFlag::eGPU_COMPATIBLE };
+PxConstraintShaderTable Ext::D6Joint::sShaders = { Ext::D6JointSolverPrep, D6JointProject, D6JointVisualize, PxConstraintFlag::eGPU_COMPATIBLE, Ext::D6JointSolverPrep4 };
 
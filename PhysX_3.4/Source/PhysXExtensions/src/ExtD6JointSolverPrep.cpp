@@ -30,6 +30,7 @@
 
 #include "ExtD6Joint.h"
 #include "ExtConstraintHelper.h"
+#include "ExtConstraintHelper4.h"
 #include "CmConeLimitHelper.h"
 
 namespace physx
@@ -218,6 +219,60 @@ namespace Ext
 
 		return g.getCount();
 	}
+
+	void D6JointSolverPrep4(Px1DConstraint* const* constraints,
+		PxU32* rowCounts,
+		PxVec3* body0WorldOffsets,
+		PxU32 maxConstraints,
+		PxConstraintInvMassScale* invMassScales,
+		const void* const* constantBlocks,
+		const PxTransform* bA2w,
+		const PxTransform* bB2w)
+	{
+		using namespace joint;
+
+		const PxU32 SWING1_FLAG = 1<<PxD6Axis::eSWING1, 
+			SWING2_FLAG = 1<<PxD6Axis::eSWING2;
+
+		const PxU32 ANGULAR_MASK = SWING1_FLAG | SWING2_FLAG | 1<<PxD6Axis::eTWIST;
+
+		// only joints made of locked and free axes are prepped together, and they must all lock the same axes
+		const PxU32 locked = reinterpret_cast<const D6JointData*>(constantBlocks[0])->locked;
+		bool batchable = (locked & ANGULAR_MASK) != SWING1_FLAG && (locked & ANGULAR_MASK) != SWING2_FLAG;
+		for(PxU32 a=0; a<4 && batchable; a++)
+		{
+			const D6JointData& data = *reinterpret_cast<const D6JointData*>(constantBlocks[a]);
+			batchable = data.locked == locked && !data.limited && !data.driving;
+		}
+
+		if(!batchable)
+		{
+			solverPrep4Scalar(D6JointSolverPrep, constraints, rowCounts, body0WorldOffsets, maxConstraints, invMassScales, constantBlocks, bA2w, bB2w);
+			return;
+		}
+
+		PxTransform cA2w[4], cB2w[4];
+		PxVec3 ra[4], rb[4];
+		for(PxU32 a=0; a<4; a++)
+		{
+			const D6JointData& data = *reinterpret_cast<const D6JointData*>(constantBlocks[a]);
+			invMassScales[a] = data.invMassScale;
+
+			cA2w[a] = bA2w[a].transform(data.c2b[0]);
+			cB2w[a] = bB2w[a].transform(data.c2b[1]);
+
+			body0WorldOffsets[a] = cB2w[a].p-bA2w[a].p;
+			ra[a] = cB2w[a].p - bA2w[a].p;
+			rb[a] = cB2w[a].p - bB2w[a].p;
+
+			if(cA2w[a].q.dot(cB2w[a].q)<0)
+				cB2w[a].q = -cB2w[a].q;
+		}
+
+		const PxU32 count = prepareLockedAxes4(constraints, cA2w, cB2w, ra, rb, locked&7, locked>>3);
+		for(PxU32 a=0; a<4; a++)
+			rowCounts[a] = count;
+	}
 }//namespace
 
 }
@@ -0,0 +1,150 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#include "PxDefaultCookingCache.h"
+#include "foundation/PxIO.h"
+#include "CmPhysXCommon.h"
+#include "PsFoundation.h"
+#include "PsAtomic.h"
+#include "PsString.h"
+#include "PsThread.h"
+#include "SnFile.h"
+
+using namespace physx;
+
+namespace
+{
+	const PxU32 CACHE_FILE_MAGIC	= 0x43435850;	// "PXCC"
+	const PxU32 MAX_PATH_LENGTH		= 512;
+
+	struct CacheFileHeader
+	{
+		PxU32	magic;
+		PxU32	size;
+		PxU64	key[2];
+	};
+}
+
+PxDefaultCookingCache::PxDefaultCookingCache(const char* directory) : mDirectory(NULL), mNbHits(0), mNbMisses(0), mNbTempFiles(0)
+{
+	PX_CHECK_AND_RETURN(directory, "PxDefaultCookingCache: NULL directory.");
+
+	size_t length = strlen(directory);
+	while(length && (directory[length-1] == '/' || directory[length-1] == '\\'))
+		length--;
+
+	mDirectory = reinterpret_cast<char*>(PX_ALLOC(length+1, "PxDefaultCookingCache"));
+	PxMemCopy(mDirectory, directory, PxU32(length));
+	mDirectory[length] = 0;
+}
+
+PxDefaultCookingCache::~PxDefaultCookingCache()
+{
+	PX_FREE(mDirectory);
+}
+
+void PxDefaultCookingCache::getFileName(const PxCookingCacheKey& key, char* buffer, PxU32 bufferSize) const
+{
+	Ps::snprintf(buffer, bufferSize, "%s/%08x%08x%08x%08x.pxcc", mDirectory,
+		PxU32(key.hash[0]>>32), PxU32(key.hash[0]), PxU32(key.hash[1]>>32), PxU32(key.hash[1]));
+}
+
+bool PxDefaultCookingCache::load(const PxCookingCacheKey& key, PxOutputStream& stream)
+{
+	if(!mDirectory)
+		return false;
+
+	char fileName[MAX_PATH_LENGTH];
+	getFileName(key, fileName, MAX_PATH_LENGTH);
+
+	FILE* file = NULL;
+	sn::fopen_s(&file, fileName, "rb");
+	if(!file)
+	{
+		Ps::atomicIncrement(&mNbMisses);
+		return false;
+	}
+
+	// validate the whole entry before writing anything to the stream
+	CacheFileHeader header;
+	bool valid = fread(&header, sizeof(header), 1, file) == 1 && header.magic == CACHE_FILE_MAGIC
+		&& header.key[0] == key.hash[0] && header.key[1] == key.hash[1];
+	if(valid)
+	{
+		fseek(file, 0, SEEK_END);
+		valid = ftell(file) == long(sizeof(header) + header.size);
+		fseek(file, long(sizeof(header)), SEEK_SET);
+	}
+
+	PxU8 buffer[4096];
+	PxU32 remaining = valid ? header.size : 0;
+	while(remaining)
+	{
+		const PxU32 count = PxMin(remaining, PxU32(sizeof(buffer)));
+		if(fread(buffer, 1, count, file) != count)
+			break;
+		stream.write(buffer, count);
+		remaining -= count;
+	}
+	fclose(file);
+
+	valid = valid && !remaining;
+	Ps::atomicIncrement(valid ? &mNbHits : &mNbMisses);
+	return valid;
+}
+
+void PxDefaultCookingCache::store(const PxCookingCacheKey& key, const void* data, PxU32 size)
+{
+	if(!mDirectory)
+		return;
+
+	char fileName[MAX_PATH_LENGTH];
+	char tempName[MAX_PATH_LENGTH];
+	getFileName(key, fileName, MAX_PATH_LENGTH);
+	Ps::snprintf(tempName, MAX_PATH_LENGTH, "%s.%llx.%d.tmp", fileName, static_cast<unsigned long long>(size_t(Ps::Thread::getId())), Ps::atomicIncrement(&mNbTempFiles));
+
+	FILE* file = NULL;
+	sn::fopen_s(&file, tempName, "wb");
+	if(!file)
+	{
+		Ps::getFoundation().error(PxErrorCode::eDEBUG_WARNING, __FILE__, __LINE__, "PxDefaultCookingCache: unable to write %s.", tempName);
+		return;
+	}
+
+	CacheFileHeader header;
+	header.magic	= CACHE_FILE_MAGIC;
+	header.size		= size;
+	header.key[0]	= key.hash[0];
+	header.key[1]	= key.hash[1];
+	const bool written = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(data, 1, size, file) == size;
+	const bool closed = fclose(file) == 0;
+
+	// rename fails if another thread or process stored the same key first, which is fine
+	if(!written || !closed || ::rename(tempName, fileName) != 0)
+		::remove(tempName);
+}
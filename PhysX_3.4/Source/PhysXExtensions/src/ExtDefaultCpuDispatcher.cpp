@@ -32,17 +32,55 @@
 #include "ExtCpuWorkerThread.h"
 #include "ExtTaskQueueHelper.h"
 #include "PsString.h"
+#include "PsSync.h"
+#include "foundation/PxMemory.h"
+#include "SnFile.h"
 
 using namespace physx;
 
 namespace physx
 {
-	PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks);
+	PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherMode::Enum mode);
+	PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreateForNumaNode(PxU32 numaNode, PxU32 numThreads, PxDefaultCpuDispatcherMode::Enum mode);
+	PxU32 PxDefaultCpuDispatcherGetNumaNodeCount();
+	PxU32 PxDefaultCpuDispatcherGetNumaNodeAffinityMask(PxU32 numaNode);
 }
 
-PxDefaultCpuDispatcher* physx::PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks)
+PxDefaultCpuDispatcher* physx::PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherMode::Enum mode)
 {
-	return PX_NEW(Ext::DefaultCpuDispatcher)(numThreads, affinityMasks);
+	return PX_NEW(Ext::DefaultCpuDispatcher)(numThreads, affinityMasks, mode);
+}
+
+PxDefaultCpuDispatcher* physx::PxDefaultCpuDispatcherCreateForNumaNode(PxU32 numaNode, PxU32 numThreads, PxDefaultCpuDispatcherMode::Enum mode)
+{
+	const PxU32 nodeMask = Ext::DefaultCpuDispatcher::getNumaNodeAffinityMask(numaNode);
+
+	PxU32* affinityMasks = NULL;
+	if(nodeMask && numThreads)
+	{
+		affinityMasks = reinterpret_cast<PxU32*>(PX_ALLOC(numThreads * sizeof(PxU32), "ThreadAffinityMasks"));
+		for(PxU32 i = 0; i < numThreads; i++)
+			affinityMasks[i] = nodeMask;
+	}
+
+	Ext::DefaultCpuDispatcher* dispatcher = PX_NEW(Ext::DefaultCpuDispatcher)(numThreads, affinityMasks, mode);
+	if(nodeMask)
+		dispatcher->setNumaNode(numaNode);
+
+	if(affinityMasks)
+		PX_FREE(affinityMasks);
+
+	return dispatcher;
+}
+
+PxU32 physx::PxDefaultCpuDispatcherGetNumaNodeCount()
+{
+	return Ext::DefaultCpuDispatcher::getNumaNodeCount();
+}
+
+PxU32 physx::PxDefaultCpuDispatcherGetNumaNodeAffinityMask(PxU32 numaNode)
+{
+	return Ext::DefaultCpuDispatcher::getNumaNodeAffinityMask(numaNode);
 }
 
 #if !PX_PS4 && !PX_XBOXONE && !PX_SWITCH
@@ -55,8 +93,122 @@ void Ext::DefaultCpuDispatcher::getAffinityMasks(PxU32* affinityMasks, PxU32 thr
 }
 #endif
 
-Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks)
-	: mQueueEntryPool(EXT_TASK_QUEUE_ENTRY_POOL_SIZE, "QueueEntryPool"), mNumThreads(numThreads), mShuttingDown(false)
+#if PX_LINUX
+namespace
+{
+	// Reads a sysfs cpu list such as "0-7,16-23". Returns false if the file does not exist.
+	bool readNodeCpuMask(PxU32 numaNode, PxU32& mask)
+	{
+		char path[64];
+		Ps::snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", numaNode);
+
+		FILE* fp = NULL;
+		if(sn::fopen_s(&fp, path, "r") != 0)
+			return false;
+
+		char buffer[256];
+		const size_t length = fread(buffer, 1, sizeof(buffer) - 1, fp);
+		fclose(fp);
+		buffer[length] = 0;
+
+		mask = 0;
+		const char* c = buffer;
+		while(*c >= '0' && *c <= '9')
+		{
+			PxU32 first = 0;
+			while(*c >= '0' && *c <= '9')
+				first = first * 10 + PxU32(*c++ - '0');
+
+			PxU32 last = first;
+			if(*c == '-')
+			{
+				c++;
+				last = 0;
+				while(*c >= '0' && *c <= '9')
+					last = last * 10 + PxU32(*c++ - '0');
+			}
+
+			for(PxU32 cpu = first; cpu <= last && cpu < 32; cpu++)
+				mask |= 1u << cpu;
+
+			if(*c == ',')
+				c++;
+		}
+		return true;
+	}
+}
+
+PxU32 Ext::DefaultCpuDispatcher::getNumaNodeCount()
+{
+	PxU32 count = 0;
+	PxU32 mask;
+	while(readNodeCpuMask(count, mask))
+		count++;
+
+	return count ? count : 1;
+}
+
+PxU32 Ext::DefaultCpuDispatcher::getNumaNodeAffinityMask(PxU32 numaNode)
+{
+	PxU32 mask = 0;
+	return readNodeCpuMask(numaNode, mask) ? mask : 0;
+}
+#else
+// topology queries are not implemented on this platform, treat the machine as a single node
+PxU32 Ext::DefaultCpuDispatcher::getNumaNodeCount()
+{
+	return 1;
+}
+
+PxU32 Ext::DefaultCpuDispatcher::getNumaNodeAffinityMask(PxU32)
+{
+	return 0;
+}
+#endif
+
+namespace
+{
+	class FirstTouchTask : public PxBaseTask
+	{
+		PX_NOCOPY(FirstTouchTask)
+	public:
+		FirstTouchTask(PxU8* memory, PxU32 size) : mMemory(memory), mSize(size) {}
+
+		virtual void run()
+		{
+			// touching one byte per page is enough for placement, but the block is cleared for determinism
+			PxMemZero(mMemory, mSize);
+		}
+
+		virtual const char* getName() const { return "DefaultCpuDispatcher.firstTouch"; }
+
+		virtual void addReference() {}
+		virtual void removeReference() {}
+		virtual int32_t getReference() const { return 1; }
+
+		virtual void release() { mDone.set(); }
+
+		void wait() { mDone.wait(); }
+
+	private:
+		PxU8*		mMemory;
+		PxU32		mSize;
+		Ps::Sync	mDone;
+	};
+}
+
+void Ext::DefaultCpuDispatcher::firstTouch(void* memory, PxU32 size)
+{
+	if(!memory || !size)
+		return;
+
+	FirstTouchTask task(reinterpret_cast<PxU8*>(memory), size);
+	submitTask(task);
+	task.wait();
+}
+
+Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherMode::Enum mode)
+	: mQueueEntryPool(EXT_TASK_QUEUE_ENTRY_POOL_SIZE, "QueueEntryPool"), mNumThreads(numThreads), mNumaNode(0xffffffff), mWorkerTlsSlot(0), mNumParkedWorkers(0), mNumHighPriorityJobs(0), mMode(mode), mShuttingDown(false)
 #if PX_PROFILE
 	,mRunProfiled(true)
 #else
@@ -72,6 +224,9 @@ Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinit
 		affinityMasks = defaultAffinityMasks;
 	}
 	 
+	if(mMode == PxDefaultCpuDispatcherMode::eWORK_STEALING)
+		mWorkerTlsSlot = Ps::TlsAlloc();
+
 	// initialize threads first, then start
 
 	mWorkerThreads = reinterpret_cast<CpuWorkerThread*>(PX_ALLOC(numThreads * sizeof(CpuWorkerThread), "CpuWorkerThread"));
@@ -83,7 +238,7 @@ Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinit
 		for(PxU32 i = 0; i < numThreads; ++i)
 		{
 			PX_PLACEMENT_NEW(mWorkerThreads+i, CpuWorkerThread)();
-			mWorkerThreads[i].initialize(this);
+			mWorkerThreads[i].initialize(this, i);
 		}
 
 		for(PxU32 i = 0; i < numThreads; ++i)
@@ -125,6 +280,9 @@ Ext::DefaultCpuDispatcher::~DefaultCpuDispatcher()
 
 	if (mThreadNames)
 		PX_FREE(mThreadNames);
+
+	if(mMode == PxDefaultCpuDispatcherMode::eWORK_STEALING)
+		Ps::TlsFree(mWorkerTlsSlot);
 }
 
 void Ext::DefaultCpuDispatcher::submitTask(PxBaseTask& task)
@@ -137,6 +295,41 @@ void Ext::DefaultCpuDispatcher::submitTask(PxBaseTask& task)
 		return;
 	}	
 
+	// high priority tasks skip the per-worker queues, every worker looks at their list first
+	if(task.getPriority() == PxTaskPriority::eHIGH)
+	{
+		SharedQueueEntry* entry = mQueueEntryPool.getEntry(&task);
+		if(!entry)
+			return;
+		mHighPriorityJobList.push(*entry);
+		Ps::atomicIncrement(&mNumHighPriorityJobs);
+
+		Ps::memoryBarrier();
+		if(mMode != PxDefaultCpuDispatcherMode::eWORK_STEALING || mNumParkedWorkers > 0)
+			mWorkReady.set();
+		return;
+	}
+
+	if(mMode == PxDefaultCpuDispatcherMode::eWORK_STEALING)
+	{
+		// tasks spawned by a worker stay on its own deque, everything else goes to the shared list
+		CpuWorkerThread* worker = reinterpret_cast<CpuWorkerThread*>(Ps::TlsGet(mWorkerTlsSlot));
+		if(!worker || !worker->pushLocalTask(task))
+		{
+			SharedQueueEntry* entry = mQueueEntryPool.getEntry(&task);
+			if(!entry)
+				return;
+			mJobList.push(*entry);
+		}
+
+		// only pay for the wake signal if somebody is actually asleep, spinning workers will find the task.
+		// The barrier pairs with the one in parkWorker so that either we see the parked worker or it sees the task.
+		Ps::memoryBarrier();
+		if(mNumParkedWorkers > 0)
+			mWorkReady.set();
+		return;
+	}
+
 	// TODO: Could use TLS to make this more efficient
 	const Ps::Thread::Id currentThread = Ps::Thread::getId();
 	for(PxU32 i = 0; i < mNumThreads; ++i)
@@ -170,7 +363,22 @@ void Ext::DefaultCpuDispatcher::release()
 
 PxBaseTask* Ext::DefaultCpuDispatcher::getJob(void)
 {
-	return TaskQueueHelper::fetchTask(mJobList, mQueueEntryPool);
+	PxBaseTask* task = getHighPriorityJob();
+	if(!task)
+		task = TaskQueueHelper::fetchTask(mJobList, mQueueEntryPool);
+	return task;
+}
+
+PxBaseTask* Ext::DefaultCpuDispatcher::getHighPriorityJob()
+{
+	// the counter avoids touching the list in the common case where it is empty
+	if(mNumHighPriorityJobs <= 0)
+		return NULL;
+
+	PxBaseTask* task = TaskQueueHelper::fetchTask(mHighPriorityJobList, mQueueEntryPool);
+	if(task)
+		Ps::atomicDecrement(&mNumHighPriorityJobs);
+	return task;
 }
 
 PxBaseTask* Ext::DefaultCpuDispatcher::stealJob()
@@ -188,6 +396,47 @@ PxBaseTask* Ext::DefaultCpuDispatcher::stealJob()
 	return ret;
 }
 
+PxBaseTask* Ext::DefaultCpuDispatcher::stealJob(CpuWorkerThread& thief)
+{
+	if(mNumThreads < 2)
+		return NULL;
+
+	// start at a random victim so that thieves do not all hammer the first worker
+	const PxU32 start = thief.getRandom() % mNumThreads;
+	for(PxU32 i = 0; i < mNumThreads; ++i)
+	{
+		PxU32 victim = start + i;
+		if(victim >= mNumThreads)
+			victim -= mNumThreads;
+
+		if(&mWorkerThreads[victim] == &thief)
+			continue;
+
+		PxBaseTask* task = mWorkerThreads[victim].stealLocalTask();
+		if(task)
+			return task;
+	}
+	return NULL;
+}
+
+PxBaseTask* Ext::DefaultCpuDispatcher::parkWorker(CpuWorkerThread& worker)
+{
+	// Reset before announcing ourselves: a submitter that sees the parked count has to set
+	// the signal after our reset, otherwise the wakeup could be lost.
+	resetWakeSignal();
+	Ps::atomicIncrement(&mNumParkedWorkers);
+
+	PxBaseTask* task = getJob();
+	if(!task)
+		task = stealJob(worker);
+
+	if(!task)
+		waitForWork();
+
+	Ps::atomicDecrement(&mNumParkedWorkers);
+	return task;
+}
+
 void Ext::DefaultCpuDispatcher::resetWakeSignal()
 {
 	mWorkReady.reset();
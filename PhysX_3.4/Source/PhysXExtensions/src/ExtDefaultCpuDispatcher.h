@@ -38,6 +38,7 @@
 #include "PxDefaultCpuDispatcher.h"
 #include "ExtSharedQueueEntryPool.h"
 #include "foundation/PxProfiler.h"
+#include "PsAtomic.h"
 #include "task/PxTask.h"
 
 namespace physx
@@ -60,7 +61,7 @@ namespace Ext
 												DefaultCpuDispatcher() : mQueueEntryPool(0) {}
 												~DefaultCpuDispatcher();
 	public:
-												DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks);
+												DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherMode::Enum mode);
 
 		//---------------------------------------------------------------------------------
 		// PxCpuDispatcher implementation
@@ -77,12 +78,19 @@ namespace Ext
 
 		virtual			bool					getRunProfiled()	const	{ return mRunProfiled;	}
 
+		virtual			PxU32					getNumaNode()		const	{ return mNumaNode;		}
+
+		virtual			void					firstTouch(void* memory, PxU32 size);
+
 		//---------------------------------------------------------------------------------
 		// DefaultCpuDispatcher
 		//---------------------------------------------------------------------------------
 						PxBaseTask*				getJob();
+						PxBaseTask*				getHighPriorityJob();
 						PxBaseTask*				stealJob();
+						PxBaseTask*				stealJob(CpuWorkerThread& thief);
 						PxBaseTask*				fetchNextTask();
+						PxBaseTask*				parkWorker(CpuWorkerThread& worker);
 		PX_FORCE_INLINE	void					runTask(PxBaseTask& task)
 												{
 #if PX_SUPPORT_PXTASK_PROFILING
@@ -99,15 +107,27 @@ namespace Ext
     					void					waitForWork() { mWorkReady.wait(); }
 						void					resetWakeSignal();
 
+		PX_FORCE_INLINE	PxDefaultCpuDispatcherMode::Enum	getMode()	const	{ return mMode;	}
+		PX_FORCE_INLINE	void					setNumaNode(PxU32 numaNode)	{ mNumaNode = numaNode;	}
+		PX_FORCE_INLINE	PxU32					getWorkerTlsSlot()	const	{ return mWorkerTlsSlot;	}
+
 		static			void					getAffinityMasks(PxU32* affinityMasks, PxU32 threadCount);
+		static			PxU32					getNumaNodeCount();
+		static			PxU32					getNumaNodeAffinityMask(PxU32 numaNode);
 
 	protected:
 						CpuWorkerThread*		mWorkerThreads;
 						SharedQueueEntryPool<>	mQueueEntryPool;
 						Ps::SList				mJobList;
+						Ps::SList				mHighPriorityJobList;	// PxTaskPriority::eHIGH tasks, taken before any other task
 						Ps::Sync				mWorkReady;
 						PxU8*					mThreadNames;
 						PxU32					mNumThreads;
+						PxU32					mNumaNode;
+						PxU32					mWorkerTlsSlot;		// maps a worker thread to its CpuWorkerThread in eWORK_STEALING mode
+		volatile		PxI32					mNumParkedWorkers;	// workers blocked (or about to block) on mWorkReady
+		volatile		PxI32					mNumHighPriorityJobs;
+						PxDefaultCpuDispatcherMode::Enum	mMode;
 						bool					mShuttingDown;
 						bool					mRunProfiled;
 	};
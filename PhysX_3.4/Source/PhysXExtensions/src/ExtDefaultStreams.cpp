@@ -40,6 +40,19 @@
 #include "PsUtilities.h"
 #include "PsBitUtils.h"
 
+#if PX_WINDOWS_FAMILY
+	#include "windows/PsWindowsInclude.h"
+	#define EXT_MAPPED_FILE_SUPPORTED 1
+#elif PX_UNIX_FAMILY && !PX_ANDROID
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#define EXT_MAPPED_FILE_SUPPORTED 1
+#else
+	#define EXT_MAPPED_FILE_SUPPORTED 0
+#endif
+
 using namespace physx;
 
 PxDefaultMemoryOutputStream::PxDefaultMemoryOutputStream(PxAllocatorCallback &allocator) 
@@ -192,3 +205,221 @@ bool PxDefaultFileInputData::isValid() const
 {
 	return mFile != NULL;
 }
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	const size_t INVALID_FILE = size_t(-1);
+
+	// Platform layer for the mapped streams. Mappings are always read-write: copy-on-write for input files and shared
+	// (i.e. written back to the file) for output files.
+#if PX_WINDOWS_FAMILY
+
+	PX_FORCE_INLINE HANDLE toHandle(size_t file)	{ return reinterpret_cast<HANDLE>(file);	}
+
+	size_t openFile(const char* name, bool write)
+	{
+		const HANDLE file = write	? CreateFileA(name, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL)
+									: CreateFileA(name, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		return file == INVALID_HANDLE_VALUE ? INVALID_FILE : reinterpret_cast<size_t>(file);
+	}
+
+	void closeFile(size_t file)
+	{
+		CloseHandle(toHandle(file));
+	}
+
+	bool getFileSize(size_t file, PxU64& size)
+	{
+		LARGE_INTEGER value;
+		if(!GetFileSizeEx(toHandle(file), &value))
+			return false;
+		size = PxU64(value.QuadPart);
+		return true;
+	}
+
+	bool setFileSize(size_t file, PxU32 size)
+	{
+		LARGE_INTEGER offset;
+		offset.QuadPart = LONGLONG(size);
+		return SetFilePointerEx(toHandle(file), offset, NULL, FILE_BEGIN) && SetEndOfFile(toHandle(file));
+	}
+
+	// a mapping larger than the file extends it, so 'size' doesn't need a setFileSize() for output files
+	PxU8* mapFile(size_t file, PxU32 size, bool write)
+	{
+		const HANDLE mapping = CreateFileMappingA(toHandle(file), NULL, write ? PAGE_READWRITE : PAGE_WRITECOPY, 0, DWORD(size), NULL);
+		if(!mapping)
+			return NULL;
+		void* address = MapViewOfFile(mapping, write ? FILE_MAP_WRITE : FILE_MAP_COPY, 0, 0, size);
+		CloseHandle(mapping);	// the view keeps the mapping object alive
+		return reinterpret_cast<PxU8*>(address);
+	}
+
+	void unmapFile(PxU8* address, PxU32)
+	{
+		UnmapViewOfFile(address);
+	}
+
+#elif EXT_MAPPED_FILE_SUPPORTED
+
+	size_t openFile(const char* name, bool write)
+	{
+		const int fd = write ? open(name, O_RDWR | O_CREAT | O_TRUNC, 0644) : open(name, O_RDONLY);
+		return fd < 0 ? INVALID_FILE : size_t(fd);
+	}
+
+	void closeFile(size_t file)
+	{
+		::close(int(file));
+	}
+
+	bool getFileSize(size_t file, PxU64& size)
+	{
+		struct stat info;
+		if(fstat(int(file), &info) != 0)
+			return false;
+		size = PxU64(info.st_size);
+		return true;
+	}
+
+	bool setFileSize(size_t file, PxU32 size)
+	{
+		return ftruncate(int(file), off_t(size)) == 0;
+	}
+
+	PxU8* mapFile(size_t file, PxU32 size, bool write)
+	{
+		if(write && !setFileSize(file, size))
+			return NULL;
+		void* address = mmap(NULL, size, PROT_READ | PROT_WRITE, write ? MAP_SHARED : MAP_PRIVATE, int(file), 0);
+		return address == MAP_FAILED ? NULL : reinterpret_cast<PxU8*>(address);
+	}
+
+	void unmapFile(PxU8* address, PxU32 size)
+	{
+		munmap(address, size);
+	}
+
+#else
+
+	size_t openFile(const char*, bool)				{ return INVALID_FILE;	}
+	void closeFile(size_t)							{}
+	bool getFileSize(size_t, PxU64&)				{ return false;			}
+	bool setFileSize(size_t, PxU32)					{ return false;			}
+	PxU8* mapFile(size_t, PxU32, bool)				{ return NULL;			}
+	void unmapFile(PxU8*, PxU32)					{}
+
+#endif
+}
+
+PxDefaultMappedFileInputData::PxDefaultMappedFileInputData(const char* filename) :
+	mData	(NULL),
+	mLength	(0),
+	mPos	(0),
+	mValid	(false)
+{
+	const size_t file = openFile(filename, false);
+	if(file == INVALID_FILE)
+		return;
+
+	PxU64 size;
+	if(getFileSize(file, size) && size <= PX_MAX_U32)
+	{
+		mLength = PxU32(size);
+		mData = mLength ? mapFile(file, mLength, false) : NULL;
+		mValid = !mLength || mData;
+		if(!mValid)
+			mLength = 0;
+	}
+	// the mapping stays valid after the file is closed
+	closeFile(file);
+}
+
+PxDefaultMappedFileInputData::~PxDefaultMappedFileInputData()
+{
+	if(mData)
+		unmapFile(mData, mLength);
+}
+
+PxU32 PxDefaultMappedFileInputData::read(void* dest, PxU32 count)
+{
+	const PxU32 length = PxMin<PxU32>(count, mLength-mPos);
+	PxMemCopy(dest, mData+mPos, length);
+	mPos += length;
+	return length;
+}
+
+PxU32 PxDefaultMappedFileInputData::getLength() const
+{
+	return mLength;
+}
+
+void PxDefaultMappedFileInputData::seek(PxU32 pos)
+{
+	mPos = PxMin<PxU32>(mLength, pos);
+}
+
+PxU32 PxDefaultMappedFileInputData::tell() const
+{
+	return mPos;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PxDefaultMappedFileOutputStream::PxDefaultMappedFileOutputStream(const char* filename, PxU32 initialCapacity) :
+	mData		(NULL),
+	mSize		(0),
+	mCapacity	(0),
+	mFile		(openFile(filename, true))
+{
+	if(mFile == INVALID_FILE)
+	{
+		Ps::getFoundation().error(PxErrorCode::eINTERNAL_ERROR, __FILE__, __LINE__, 
+			"Unable to open file %s for mapping\n", filename);
+		return;
+	}
+
+	if(!remap(PxMax(initialCapacity, 4096u)))
+	{
+		Ps::getFoundation().error(PxErrorCode::eINTERNAL_ERROR, __FILE__, __LINE__, 
+			"Unable to map file %s\n", filename);
+	}
+}
+
+PxDefaultMappedFileOutputStream::~PxDefaultMappedFileOutputStream()
+{
+	if(mFile == INVALID_FILE)
+		return;
+
+	if(mData)
+		unmapFile(mData, mCapacity);
+	setFileSize(mFile, mSize);
+	closeFile(mFile);
+}
+
+bool PxDefaultMappedFileOutputStream::remap(PxU32 capacity)
+{
+	// the written pages live in the file, so growing only replaces the view: nothing is copied
+	if(mData)
+		unmapFile(mData, mCapacity);
+
+	mData = mapFile(mFile, capacity, true);
+	mCapacity = mData ? capacity : 0;
+	return mData != NULL;
+}
+
+PxU32 PxDefaultMappedFileOutputStream::write(const void* src, PxU32 count)
+{
+	if(!mData)
+		return 0;
+
+	const PxU32 expectedSize = mSize + count;
+	if(expectedSize > mCapacity && !remap(Ps::nextPowerOfTwo(expectedSize)))
+		return 0;
+
+	PxMemCopy(mData+mSize, src, count);
+	mSize += count;
+	return count;
+}
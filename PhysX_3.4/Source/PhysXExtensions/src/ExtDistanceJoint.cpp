@@ -235,4 +235,4 @@ const PxConstraintShaderTable* Ext::GetDistanceJointShaderTable()
 }
 
 //~PX_SERIALIZATION
-PxConstraintShaderTable Ext::DistanceJoint::sShaders = { Ext::DistanceJointSolverPrep, DistanceJointProject, DistanceJointVisualize, PxConstraintFlag::Enum(0) };
+PxConstraintShaderTable Ext::DistanceJoint::sShaders = { Ext::DistanceJointSolverPrep, DistanceJointProject, DistanceJointVisualize, PxConstraintFlag::Enum(0), NULL };
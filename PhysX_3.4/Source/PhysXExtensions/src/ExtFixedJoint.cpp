@@ -173,4 +173,4 @@ const PxConstraintShaderTable* Ext::GetFixedJointShaderTable()
 }
 
 //~PX_SERIALIZATION
-PxConstraintShaderTable Ext::FixedJoint::sShaders = { Ext::FixedJointSolverPrep, FixedJointProject, FixedJointVisualize, PxConstraintFlag::Enum(0) };
+PxConstraintShaderTable Ext::FixedJoint::sShaders = { Ext::FixedJointSolverPrep, FixedJointProject, FixedJointVisualize, PxConstraintFlag::Enum(0), Ext::FixedJointSolverPrep4 };
@@ -125,6 +125,15 @@ namespace Ext
 		const void* constantBlock,
 		const PxTransform& bA2w,
 		const PxTransform& bB2w);
+
+	extern "C"  void FixedJointSolverPrep4(Px1DConstraint* const* constraints,
+		PxU32* rowCounts,
+		PxVec3* body0WorldOffsets,
+		PxU32 maxConstraints,
+		PxConstraintInvMassScale* invMassScales,
+		const void* const* constantBlocks,
+		const PxTransform* bA2w,
+		const PxTransform* bB2w);
 	
 	// global function to share the joint shaders with API capture	
 	extern "C" const PxConstraintShaderTable* GetFixedJointShaderTable();
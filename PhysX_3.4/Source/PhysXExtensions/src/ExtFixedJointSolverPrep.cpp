@@ -30,6 +30,7 @@
 
 #include "ExtFixedJoint.h"
 #include "ExtConstraintHelper.h"
+#include "ExtConstraintHelper4.h"
 
 namespace physx
 {
@@ -61,6 +62,37 @@ namespace Ext
 		return ch.getCount();
 	}
 
+	void FixedJointSolverPrep4(Px1DConstraint* const* constraints,
+		PxU32* rowCounts,
+		PxVec3* body0WorldOffsets,
+		PxU32 maxConstraints,
+		PxConstraintInvMassScale* invMassScales,
+		const void* const* constantBlocks,
+		const PxTransform* bA2w,
+		const PxTransform* bB2w)
+	{
+		PX_UNUSED(maxConstraints);
+
+		PxTransform cA2w[4], cB2w[4];
+		PxVec3 ra[4], rb[4];
+		for(PxU32 a=0; a<4; a++)
+		{
+			const FixedJointData& data = *reinterpret_cast<const FixedJointData*>(constantBlocks[a]);
+			invMassScales[a] = data.invMassScale;
+
+			cA2w[a] = bA2w[a].transform(data.c2b[0]);
+			cB2w[a] = bB2w[a].transform(data.c2b[1]);
+
+			body0WorldOffsets[a] = cB2w[a].p-bA2w[a].p;
+			ra[a] = cB2w[a].p - bA2w[a].p;
+			rb[a] = cB2w[a].p - bB2w[a].p;
+		}
+
+		const PxU32 count = joint::prepareLockedAxes4(constraints, cA2w, cB2w, ra, rb, 7, 7);
+		for(PxU32 a=0; a<4; a++)
+			rowCounts[a] = count;
+	}
+
 
 }//namespace
 
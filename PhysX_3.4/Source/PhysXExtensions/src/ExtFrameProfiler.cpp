@@ -0,0 +1,273 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "PxFrameProfiler.h"
+
+using namespace physx;
+
+#include "foundation/PxIO.h"
+#include "foundation/PxMath.h"
+#include "CmPhysXCommon.h"
+#include "PsFoundation.h"
+#include "PsAtomic.h"
+#include "PsBitUtils.h"
+#include "PsIntrinsics.h"
+#include "PsString.h"
+#include "PsThread.h"
+#include "PsTime.h"
+
+namespace physx
+{
+class FrameProfilerInternal : public Ps::UserAllocated
+{
+	public:
+		enum EventType
+		{
+			eBEGIN,
+			eEND,
+			eBEGIN_DETACHED,
+			eEND_DETACHED
+		};
+
+		struct Event
+		{
+			const char*	mName;
+			PxU64		mContextId;
+			PxU64		mTime;		// counter ticks
+			PxU32		mType;
+			PxU32		mPad;
+		};
+
+		// Only written by its owner thread. mNbWritten is published after the event it covers.
+		struct ThreadBuffer : public Ps::UserAllocated
+		{
+			Event*			mEvents;
+			size_t			mThreadId;
+			volatile PxU32	mNbWritten;
+		};
+
+						FrameProfilerInternal(PxU32 eventsPerThread, PxU32 maxFrames, PxU32 maxThreads, PxProfilerCallback* forward);
+						~FrameProfilerInternal();
+
+		ThreadBuffer*	getThreadBuffer();
+		void			record(const char* name, PxU64 contextId, EventType type);
+		PxU32			dump(PxOutputStream& stream, PxU32 nbFrames)	const;
+
+		ThreadBuffer**		mThreads;
+		PxU64*				mFrameTimes;
+		PxProfilerCallback*	mForward;
+		PxU32				mEventMask;
+		PxU32				mMaxFrames;
+		PxU32				mMaxThreads;
+		PxU32				mFrameCount;
+		volatile PxI32		mNbThreads;
+		PxU32				mTlsSlot;
+};
+}
+
+FrameProfilerInternal::FrameProfilerInternal(PxU32 eventsPerThread, PxU32 maxFrames, PxU32 maxThreads, PxProfilerCallback* forward) :
+	mForward	(forward),
+	mEventMask	(Ps::nextPowerOfTwo(PxMax(eventsPerThread, 2u) - 1) - 1),
+	mMaxFrames	(PxMax(maxFrames, 1u)),
+	mMaxThreads	(PxMax(maxThreads, 1u)),
+	mFrameCount	(0),
+	mNbThreads	(0),
+	mTlsSlot	(Ps::TlsAlloc())
+{
+	mThreads = reinterpret_cast<ThreadBuffer**>(PX_ALLOC(sizeof(ThreadBuffer*)*mMaxThreads, "FrameProfiler"));
+	mFrameTimes = reinterpret_cast<PxU64*>(PX_ALLOC(sizeof(PxU64)*mMaxFrames, "FrameProfiler"));
+	for(PxU32 i=0;i<mMaxThreads;i++)
+		mThreads[i] = NULL;
+}
+
+FrameProfilerInternal::~FrameProfilerInternal()
+{
+	const PxU32 nbThreads = PxMin(PxU32(mNbThreads), mMaxThreads);
+	for(PxU32 i=0;i<nbThreads;i++)
+	{
+		if(mThreads[i])
+		{
+			PX_FREE(mThreads[i]->mEvents);
+			PX_DELETE(mThreads[i]);
+		}
+	}
+	PX_FREE(mFrameTimes);
+	PX_FREE(mThreads);
+	Ps::TlsFree(mTlsSlot);
+}
+
+FrameProfilerInternal::ThreadBuffer* FrameProfilerInternal::getThreadBuffer()
+{
+	ThreadBuffer* buffer = reinterpret_cast<ThreadBuffer*>(Ps::TlsGet(mTlsSlot));
+	if(buffer)
+		return buffer;
+
+	// Slots are never recycled: a thread past the limit is only counted, and its events are dropped.
+	const PxU32 index = PxU32(Ps::atomicIncrement(&mNbThreads) - 1);
+	if(index >= mMaxThreads)
+		return NULL;
+
+	buffer = PX_NEW(ThreadBuffer);
+	buffer->mEvents = reinterpret_cast<Event*>(PX_ALLOC(sizeof(Event)*(mEventMask+1), "FrameProfiler"));
+	buffer->mThreadId = size_t(Ps::Thread::getId());
+	buffer->mNbWritten = 0;
+	Ps::TlsSet(mTlsSlot, buffer);
+
+	Ps::memoryBarrier();
+	mThreads[index] = buffer;
+	return buffer;
+}
+
+void FrameProfilerInternal::record(const char* name, PxU64 contextId, EventType type)
+{
+	ThreadBuffer* buffer = getThreadBuffer();
+	if(!buffer)
+		return;
+
+	const PxU32 nbWritten = buffer->mNbWritten;
+	Event& event = buffer->mEvents[nbWritten & mEventMask];
+	event.mName = name;
+	event.mContextId = contextId;
+	event.mTime = Ps::Time::getCurrentCounterValue();
+	event.mType = type;
+
+	Ps::memoryBarrier();
+	buffer->mNbWritten = nbWritten + 1;
+}
+
+static void writeString(PxOutputStream& stream, const char* str)
+{
+	stream.write(str, PxU32(strlen(str)));
+}
+
+static void writeEscaped(PxOutputStream& stream, const char* str)
+{
+	for(const char* c = str; *c; c++)
+	{
+		if(*c=='"' || *c=='\\')
+			stream.write("\\", 1);
+		if(PxU8(*c) >= 0x20)
+			stream.write(c, 1);
+	}
+}
+
+PxU32 FrameProfilerInternal::dump(PxOutputStream& stream, PxU32 nbFrames) const
+{
+	PxU64 startTime = 0;
+	const PxU32 nbKeptFrames = PxMin(mFrameCount, mMaxFrames);
+	if(nbFrames && nbKeptFrames)
+		startTime = mFrameTimes[(mFrameCount - PxMin(nbFrames, nbKeptFrames)) % mMaxFrames];
+
+	const Ps::CounterFrequencyToTensOfNanos& freq = Ps::Time::getBootCounterFrequency();
+	const double ticksToMicroseconds = double(freq.mNumerator) / (double(freq.mDenominator) * 100.0);
+
+	writeString(stream, "{\"traceEvents\":[");
+
+	char buf[256];
+	PxU32 nbEvents = 0;
+	const PxU32 nbThreads = PxMin(PxU32(mNbThreads), mMaxThreads);
+	for(PxU32 t=0;t<nbThreads;t++)
+	{
+		const ThreadBuffer* buffer = mThreads[t];
+		if(!buffer)
+			continue;
+
+		const PxU32 nbWritten = buffer->mNbWritten;
+		Ps::memoryBarrier();
+		const PxU32 capacity = mEventMask + 1;
+		const PxU32 first = nbWritten > capacity ? nbWritten - capacity : 0;
+
+		// Ends of zones which started before the window are skipped, so that the nesting is valid.
+		PxU32 depth = 0;
+		for(PxU32 i=first;i<nbWritten;i++)
+		{
+			const Event& event = buffer->mEvents[i & mEventMask];
+			if(event.mTime < startTime)
+				continue;
+
+			const char* phase;
+			switch(event.mType)
+			{
+				case eBEGIN:			phase = "B";	depth++;	break;
+				case eEND:				if(!depth) continue;	phase = "E";	depth--;	break;
+				case eBEGIN_DETACHED:	phase = "b";	break;
+				default:				phase = "e";	break;
+			}
+
+			writeString(stream, nbEvents ? ",\n{\"name\":\"" : "\n{\"name\":\"");
+			writeEscaped(stream, event.mName);
+			Ps::snprintf(buf, sizeof(buf), "\",\"cat\":\"PhysX\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":0,\"tid\":%llu,\"id\":%llu}",
+				phase, double(event.mTime) * ticksToMicroseconds, static_cast<unsigned long long>(buffer->mThreadId), static_cast<unsigned long long>(event.mContextId));
+			writeString(stream, buf);
+			nbEvents++;
+		}
+	}
+
+	writeString(stream, "\n]}\n");
+	return nbEvents;
+}
+
+PxFrameProfiler::PxFrameProfiler(PxU32 eventsPerThread, PxU32 maxFrames, PxU32 maxThreads, PxProfilerCallback* forward)
+{
+	mImpl = PX_NEW(FrameProfilerInternal)(eventsPerThread, maxFrames, maxThreads, forward);
+}
+
+PxFrameProfiler::~PxFrameProfiler()
+{
+	PX_DELETE(mImpl);
+}
+
+void PxFrameProfiler::beginFrame()
+{
+	mImpl->mFrameTimes[mImpl->mFrameCount % mImpl->mMaxFrames] = Ps::Time::getCurrentCounterValue();
+	mImpl->mFrameCount++;
+}
+
+PxU32 PxFrameProfiler::getNbFrames() const
+{
+	return mImpl->mFrameCount;
+}
+
+PxU32 PxFrameProfiler::dumpChromeTrace(PxOutputStream& stream, PxU32 nbFrames) const
+{
+	return mImpl->dump(stream, nbFrames);
+}
+
+void* PxFrameProfiler::zoneStart(const char* eventName, bool detached, uint64_t contextId)
+{
+	mImpl->record(eventName, contextId, detached ? FrameProfilerInternal::eBEGIN_DETACHED : FrameProfilerInternal::eBEGIN);
+	return mImpl->mForward ? mImpl->mForward->zoneStart(eventName, detached, contextId) : NULL;
+}
+
+void PxFrameProfiler::zoneEnd(void* profilerData, const char* eventName, bool detached, uint64_t contextId)
+{
+	if(mImpl->mForward)
+		mImpl->mForward->zoneEnd(profilerData, eventName, detached, contextId);
+	mImpl->record(eventName, contextId, detached ? FrameProfilerInternal::eEND_DETACHED : FrameProfilerInternal::eEND);
+}
@@ -0,0 +1,268 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "PxHeightFieldTileManager.h"
+
+using namespace physx;
+
+#include "geometry/PxHeightField.h"
+#include "geometry/PxHeightFieldGeometry.h"
+#include "PxPhysics.h"
+#include "PxScene.h"
+#include "PxRigidStatic.h"
+#include "PxRigidDynamic.h"
+#include "extensions/PxRigidActorExt.h"
+#include "CmPhysXCommon.h"
+#include "PsFoundation.h"
+#include "PsArray.h"
+#include "PsMathUtils.h"
+
+namespace physx
+{
+class HeightFieldTileManagerInternal : public Ps::UserAllocated
+{
+	PX_NOCOPY(HeightFieldTileManagerInternal)
+	public:
+						HeightFieldTileManagerInternal(PxPhysics& physics, PxScene& scene, const PxHeightFieldTileManagerDesc& desc, PxHeightFieldTileStream& stream);
+						~HeightFieldTileManagerInternal();
+
+		void			update(const PxBounds3* regions, PxU32 nbRegions);
+		void			updateFromScene();
+
+		struct Tile
+		{
+			PxRigidStatic*	mActor;
+			PxHeightField*	mHeightField;
+			PxU32			mTimestamp;	// Last update for which the tile overlapped an active region
+		};
+
+		PxPhysics&					mPhysics;
+		PxScene&					mScene;
+		PxHeightFieldTileStream&	mStream;
+		PxHeightFieldTileManagerDesc	mDesc;
+		PxTransform					mInvPose;
+		PxReal						mTileExtentX;
+		PxReal						mTileExtentZ;
+		Ps::Array<Tile>				mTiles;
+		Ps::Array<PxActor*>			mActorBuffer;
+		Ps::Array<PxBounds3>		mRegionBuffer;
+		PxU32						mTimestamp;
+		PxU32						mNbMappedTiles;
+
+	private:
+		void			mapTile(PxU32 tileRow, PxU32 tileColumn, Tile& tile);
+		void			unmapTile(PxU32 tileRow, PxU32 tileColumn, Tile& tile);
+		void			markTiles(const PxBounds3& region);
+};
+}
+
+HeightFieldTileManagerInternal::HeightFieldTileManagerInternal(PxPhysics& physics, PxScene& scene, const PxHeightFieldTileManagerDesc& desc, PxHeightFieldTileStream& stream) :
+	mPhysics		(physics),
+	mScene			(scene),
+	mStream			(stream),
+	mDesc			(desc),
+	mInvPose		(desc.pose.getInverse()),
+	mTileExtentX	(PxReal(desc.nbSampleRows-1)*desc.rowScale),
+	mTileExtentZ	(PxReal(desc.nbSampleColumns-1)*desc.columnScale),
+	mTimestamp		(0),
+	mNbMappedTiles	(0)
+{
+	Tile emptyTile;
+	emptyTile.mActor		= NULL;
+	emptyTile.mHeightField	= NULL;
+	emptyTile.mTimestamp	= 0;
+	mTiles.resize(desc.nbTileRows*desc.nbTileColumns, emptyTile);
+}
+
+HeightFieldTileManagerInternal::~HeightFieldTileManagerInternal()
+{
+	for(PxU32 i=0;i<mDesc.nbTileRows;i++)
+	{
+		for(PxU32 j=0;j<mDesc.nbTileColumns;j++)
+		{
+			Tile& tile = mTiles[i*mDesc.nbTileColumns+j];
+			if(tile.mActor)
+				unmapTile(i, j, tile);
+		}
+	}
+}
+
+void HeightFieldTileManagerInternal::mapTile(PxU32 tileRow, PxU32 tileColumn, Tile& tile)
+{
+	PxHeightField* heightField = mStream.loadTile(tileRow, tileColumn);
+	if(!heightField)
+		return;
+
+	if(heightField->getNbRows()!=mDesc.nbSampleRows || heightField->getNbColumns()!=mDesc.nbSampleColumns)
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "PxHeightFieldTileManager: tile height field doesn't match the descriptor's number of samples. Tile ignored.");
+		mStream.unloadTile(tileRow, tileColumn, *heightField);
+		return;
+	}
+
+	const PxTransform tilePose = mDesc.pose.transform(PxTransform(PxVec3(PxReal(tileRow)*mTileExtentX, 0.0f, PxReal(tileColumn)*mTileExtentZ)));
+	PxRigidStatic* actor = mPhysics.createRigidStatic(tilePose);
+	if(!actor)
+	{
+		mStream.unloadTile(tileRow, tileColumn, *heightField);
+		return;
+	}
+
+	const PxHeightFieldGeometry geometry(heightField, mDesc.heightFieldFlags, mDesc.heightScale, mDesc.rowScale, mDesc.columnScale);
+	if(!PxRigidActorExt::createExclusiveShape(*actor, geometry, *mDesc.material, mDesc.shapeFlags))
+	{
+		actor->release();
+		mStream.unloadTile(tileRow, tileColumn, *heightField);
+		return;
+	}
+
+	mScene.addActor(*actor);
+
+	tile.mActor			= actor;
+	tile.mHeightField	= heightField;
+	mNbMappedTiles++;
+}
+
+void HeightFieldTileManagerInternal::unmapTile(PxU32 tileRow, PxU32 tileColumn, Tile& tile)
+{
+	PX_ASSERT(tile.mActor && tile.mHeightField);
+
+	// PT: the shape holds a reference to the height field, so the actor goes first
+	mScene.removeActor(*tile.mActor);
+	tile.mActor->release();
+	mStream.unloadTile(tileRow, tileColumn, *tile.mHeightField);
+
+	tile.mActor			= NULL;
+	tile.mHeightField	= NULL;
+	PX_ASSERT(mNbMappedTiles);
+	mNbMappedTiles--;
+}
+
+void HeightFieldTileManagerInternal::markTiles(const PxBounds3& region)
+{
+	if(region.isEmpty())
+		return;
+
+	PxBounds3 localRegion = PxBounds3::transformSafe(mInvPose, region);
+	localRegion.fattenFast(mDesc.margin);
+
+	const PxReal maxRow = PxReal(mDesc.nbTileRows);
+	const PxReal maxColumn = PxReal(mDesc.nbTileColumns);
+	const PxReal minX = PxClamp(localRegion.minimum.x / mTileExtentX, 0.0f, maxRow);
+	const PxReal maxX = PxClamp(localRegion.maximum.x / mTileExtentX, 0.0f, maxRow);
+	const PxReal minZ = PxClamp(localRegion.minimum.z / mTileExtentZ, 0.0f, maxColumn);
+	const PxReal maxZ = PxClamp(localRegion.maximum.z / mTileExtentZ, 0.0f, maxColumn);
+	if(minX>=maxRow || maxX<=0.0f || minZ>=maxColumn || maxZ<=0.0f)
+		return;
+
+	const PxU32 row0 = PxU32(minX);
+	const PxU32 row1 = PxMin(PxU32(maxX), mDesc.nbTileRows-1);
+	const PxU32 column0 = PxU32(minZ);
+	const PxU32 column1 = PxMin(PxU32(maxZ), mDesc.nbTileColumns-1);
+	for(PxU32 i=row0;i<=row1;i++)
+		for(PxU32 j=column0;j<=column1;j++)
+			mTiles[i*mDesc.nbTileColumns+j].mTimestamp = mTimestamp;
+}
+
+void HeightFieldTileManagerInternal::update(const PxBounds3* regions, PxU32 nbRegions)
+{
+	// PT: a timestamp avoids clearing a flag in all the tiles for each update
+	mTimestamp++;
+	if(!mTimestamp)
+	{
+		for(PxU32 i=0;i<mTiles.size();i++)
+			mTiles[i].mTimestamp = 0;
+		mTimestamp = 1;
+	}
+
+	for(PxU32 i=0;i<nbRegions;i++)
+		markTiles(regions[i]);
+
+	for(PxU32 i=0;i<mDesc.nbTileRows;i++)
+	{
+		for(PxU32 j=0;j<mDesc.nbTileColumns;j++)
+		{
+			Tile& tile = mTiles[i*mDesc.nbTileColumns+j];
+			const bool active = tile.mTimestamp==mTimestamp;
+			if(active && !tile.mActor)
+				mapTile(i, j, tile);
+			else if(!active && tile.mActor)
+				unmapTile(i, j, tile);
+		}
+	}
+}
+
+void HeightFieldTileManagerInternal::updateFromScene()
+{
+	const PxU32 nbActors = mScene.getNbActors(PxActorTypeFlag::eRIGID_DYNAMIC);
+	mActorBuffer.resizeUninitialized(nbActors);
+	if(nbActors)
+		mScene.getActors(PxActorTypeFlag::eRIGID_DYNAMIC, mActorBuffer.begin(), nbActors);
+
+	mRegionBuffer.resizeUninitialized(nbActors);
+	for(PxU32 i=0;i<nbActors;i++)
+		mRegionBuffer[i] = mActorBuffer[i]->getWorldBounds();
+
+	update(mRegionBuffer.begin(), nbActors);
+}
+
+PxHeightFieldTileManager::PxHeightFieldTileManager(PxPhysics& physics, PxScene& scene, const PxHeightFieldTileManagerDesc& desc, PxHeightFieldTileStream& stream) : mImpl(NULL)
+{
+	PX_CHECK_AND_RETURN(desc.isValid(), "PxHeightFieldTileManager: descriptor is not valid.");
+	mImpl = PX_NEW(HeightFieldTileManagerInternal)(physics, scene, desc, stream);
+}
+
+PxHeightFieldTileManager::~PxHeightFieldTileManager()
+{
+	PX_DELETE(mImpl);
+}
+
+void PxHeightFieldTileManager::update(const PxBounds3* regions, PxU32 nbRegions)
+{
+	if(mImpl)
+		mImpl->update(regions, nbRegions);
+}
+
+void PxHeightFieldTileManager::updateFromScene()
+{
+	if(mImpl)
+		mImpl->updateFromScene();
+}
+
+PxU32 PxHeightFieldTileManager::getNbMappedTiles() const
+{
+	return mImpl ? mImpl->mNbMappedTiles : 0;
+}
+
+PxRigidStatic* PxHeightFieldTileManager::getTileActor(PxU32 tileRow, PxU32 tileColumn) const
+{
+	if(!mImpl || tileRow>=mImpl->mDesc.nbTileRows || tileColumn>=mImpl->mDesc.nbTileColumns)
+		return NULL;
+	return mImpl->mTiles[tileRow*mImpl->mDesc.nbTileColumns+tileColumn].mActor;
+}
@@ -0,0 +1,895 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "PxImmediatePipeline.h"
+
+using namespace physx;
+
+#include "foundation/PxBounds3.h"
+#include "geometry/PxGeometryQuery.h"
+#include "task/PxCpuDispatcher.h"
+#include "CmPhysXCommon.h"
+#include "CmTask.h"
+#include "PsFoundation.h"
+#include "PsArray.h"
+#include "PsAtomic.h"
+#include "PsSort.h"
+
+namespace physx
+{
+namespace
+{
+	// Linear allocator over pages that are kept and recycled by reset().
+	class BlockAllocator
+	{
+		struct Page
+		{
+			PxU8*	mData;
+			PxU32	mSize;
+		};
+
+		static const PxU32 PAGE_SIZE = 32 * 1024;
+
+	public:
+		BlockAllocator() : mCurrentPage(0), mOffset(0)	{}
+		~BlockAllocator()
+		{
+			for(PxU32 i=0;i<mPages.size();i++)
+				PX_FREE(mPages[i].mData);
+		}
+
+		PxU8* allocate(PxU32 byteSize)
+		{
+			const PxU32 alignedSize = (byteSize + 15) & ~15;
+			while(mCurrentPage < mPages.size())
+			{
+				Page& page = mPages[mCurrentPage];
+				if(mOffset + alignedSize <= page.mSize)
+				{
+					PxU8* data = page.mData + mOffset;
+					mOffset += alignedSize;
+					return data;
+				}
+				mCurrentPage++;
+				mOffset = 0;
+			}
+
+			Page page;
+			page.mSize = PxMax(alignedSize, PAGE_SIZE);
+			page.mData = reinterpret_cast<PxU8*>(PX_ALLOC(page.mSize, "ImmediatePipeline page"));
+			if(!page.mData)
+				return NULL;
+			mPages.pushBack(page);
+			mCurrentPage = mPages.size() - 1;
+			mOffset = alignedSize;
+			return page.mData;
+		}
+
+		void reset()
+		{
+			mCurrentPage = 0;
+			mOffset = 0;
+		}
+
+	private:
+		Ps::Array<Page>	mPages;
+		PxU32			mCurrentPage;
+		PxU32			mOffset;
+	};
+
+	// The caches of a step are read by the next step, so they alternate between two allocators.
+	class CacheAllocator : public PxCacheAllocator
+	{
+	public:
+		CacheAllocator() : mCurrent(0)	{}
+
+		virtual PxU8* allocateCacheData(const PxU32 byteSize)	{ return mBlocks[mCurrent].allocate(byteSize); }
+
+		void beginStep(PxU32 parity)	{ mCurrent = parity; mBlocks[parity].reset(); }
+
+	private:
+		BlockAllocator	mBlocks[2];
+		PxU32			mCurrent;
+	};
+
+	// Constraints only live until the end of the solve, friction patches are read by the next step.
+	class ConstraintAllocator : public PxConstraintAllocator
+	{
+	public:
+		ConstraintAllocator() : mCurrent(0)	{}
+
+		virtual PxU8* reserveConstraintData(const PxU32 byteSize)	{ return mConstraints.allocate(byteSize); }
+		virtual PxU8* reserveFrictionData(const PxU32 byteSize)		{ return mFrictions[mCurrent].allocate(byteSize); }
+
+		void beginStep(PxU32 parity)	{ mCurrent = parity; mConstraints.reset(); mFrictions[parity].reset(); }
+
+	private:
+		BlockAllocator	mConstraints;
+		BlockAllocator	mFrictions[2];
+		PxU32			mCurrent;
+	};
+
+	// Everything a worker writes to. There is one context per job, and a job only ever uses its own context.
+	struct ThreadContext : public Ps::UserAllocated
+	{
+		ThreadContext(PxU32 index) : mIndex(index)	{}
+
+		const PxU32							mIndex;
+		CacheAllocator						mCacheAllocator;
+		ConstraintAllocator					mConstraintAllocator;
+		Ps::Array<PxU64>					mPairKeys;
+		Ps::Array<Gu::ContactPoint>			mContacts;
+		Ps::Array<PxReal>					mContactForces;
+		Ps::Array<PxSolverConstraintDesc>	mDescs;
+		Ps::Array<PxSolverConstraintDesc>	mOrderedDescs;
+		Ps::Array<PxConstraintBatchHeader>	mHeaders;
+	};
+
+	struct Pair
+	{
+		PxU64		mKey;				// smaller body index in the high bits
+		PxU32		mBody0;				// always dynamic
+		PxU32		mBody1;
+		PxCache		mCache;
+		PxU8*		mFrictions;
+		PxU32		mNbFrictions;
+		PxU16		mGeomType0;			// the cache is only valid for the geometry types it was built for
+		PxU16		mGeomType1;
+		PxU32		mContext;			// context holding the contacts of this step
+		PxU32		mStartContact;
+		PxU32		mNbContacts;
+	};
+
+	struct Island
+	{
+		PxU32	mBodyStart;		// first solver body, the dynamic bodies of an island are contiguous
+		PxU32	mNbBodies;
+		PxU32	mPairStart;		// first entry in mIslandPairs
+		PxU32	mNbPairs;
+	};
+
+	struct SweepEntry
+	{
+		PxReal	mMinX;
+		PxU32	mBody;
+
+		PX_FORCE_INLINE bool operator<(const SweepEntry& other) const
+		{
+			return mMinX < other.mMinX || (mMinX == other.mMinX && mBody < other.mBody);
+		}
+	};
+
+	class PairContactRecorder : public immediate::PxContactRecorder
+	{
+	public:
+		PairContactRecorder(Ps::Array<Gu::ContactPoint>& contacts, const PxImmediatePipelineBody& body0, const PxImmediatePipelineBody& body1) :
+			mContacts			(contacts),
+			mStaticFriction		((body0.staticFriction + body1.staticFriction) * 0.5f),
+			mDynamicFriction	((body0.dynamicFriction + body1.dynamicFriction) * 0.5f),
+			mRestitution		((body0.restitution + body1.restitution) * 0.5f)
+		{
+		}
+
+		virtual bool recordContacts(const Gu::ContactPoint* contactPoints, const PxU32 nbContacts, const PxU32 /*index*/)
+		{
+			for(PxU32 i=0;i<nbContacts;i++)
+			{
+				Gu::ContactPoint point = contactPoints[i];
+				point.maxImpulse = PX_MAX_F32;
+				point.targetVel = PxVec3(0.0f);
+				point.staticFriction = mStaticFriction;
+				point.dynamicFriction = mDynamicFriction;
+				point.restitution = mRestitution;
+				point.materialFlags = 0;
+				mContacts.pushBack(point);
+			}
+			return true;
+		}
+
+	private:
+		Ps::Array<Gu::ContactPoint>&	mContacts;
+		const PxReal					mStaticFriction;
+		const PxReal					mDynamicFriction;
+		const PxReal					mRestitution;
+		PX_NOCOPY(PairContactRecorder)
+	};
+
+	PX_FORCE_INLINE bool isDynamic(const PxImmediatePipelineBody& body)
+	{
+		return body.rigidData.invMass != 0.0f;
+	}
+
+	PX_FORCE_INLINE void resetPairCache(Pair& pair)
+	{
+		pair.mCache = PxCache();
+		pair.mFrictions = NULL;
+		pair.mNbFrictions = 0;
+	}
+}
+
+class ImmediatePipelineInternal : public Ps::UserAllocated
+{
+	public:
+		enum Phase
+		{
+			eBOUNDS,
+			eSWEEP,
+			eCONTACTS,
+			eISLANDS
+		};
+
+		// work items claimed at once by a job in each phase
+		static const PxU32 BODIES_PER_CLAIM = 256;
+		static const PxU32 SWEEP_ENTRIES_PER_CLAIM = 64;
+		static const PxU32 PAIRS_PER_CLAIM = 32;
+
+		class PhaseJob
+		{
+		public:
+			PhaseJob(ImmediatePipelineInternal& pipeline, Phase phase) : mPipeline(pipeline), mPhase(phase)	{}
+			void operator()(PxU32 contextIndex)	{ mPipeline.runPhase(mPhase, *mPipeline.mContexts[contextIndex]); }
+		private:
+			ImmediatePipelineInternal&	mPipeline;
+			const Phase					mPhase;
+			PX_NOCOPY(PhaseJob)
+		};
+
+							ImmediatePipelineInternal(const PxImmediatePipelineDesc& desc);
+							~ImmediatePipelineInternal();
+
+		void				simulate(PxImmediatePipelineBody* bodies, PxU32 nbBodies, PxReal dt);
+		void				resetCaches();
+
+		void				runParallel(Phase phase);
+		void				runPhase(Phase phase, ThreadContext& context);
+		PX_FORCE_INLINE bool	claim(PxU32 itemsPerClaim, PxU32 nbItems, PxU32& start, PxU32& end)
+		{
+			start = PxU32(Ps::atomicAdd(&mNextItem, PxI32(itemsPerClaim)) - PxI32(itemsPerClaim));
+			end = PxMin(start + itemsPerClaim, nbItems);
+			return start < nbItems;
+		}
+
+		void				computeBounds(ThreadContext& context);
+		void				sweep(ThreadContext& context);
+		void				updatePairs();
+		void				groupPairsByGeometryType();
+		void				generateContacts(ThreadContext& context);
+		void				buildIslands();
+		void				solveIslands(ThreadContext& context);
+		void				solveIsland(const Island& island, ThreadContext& context);
+
+		PxU32				findRoot(PxU32 body);
+
+		const PxImmediatePipelineDesc		mDesc;
+		Ps::Array<ThreadContext*>			mContexts;
+		PxU32								mParity;
+
+		// step inputs
+		PxImmediatePipelineBody*			mBodies;
+		PxU32								mNbBodies;
+		PxU32								mNbDynamics;
+		PxReal								mDt;
+		volatile PxI32						mNextItem;
+
+		// per-body data, indexed by body index
+		Ps::Array<PxBounds3>				mBounds;
+		Ps::Array<PxU32>					mSolverIndices;
+		Ps::Array<PxU32>					mParents;		// union-find over the dynamic bodies
+		Ps::Array<PxU32>					mIslandIds;
+
+		Ps::Array<SweepEntry>				mSweepEntries;
+		Ps::Array<PxU64>					mPairKeys;
+		Ps::Array<Pair>						mPairs;			// sorted by key, kept from one step to the next
+		Ps::Array<Pair>						mNewPairs;
+		Ps::Array<PxU32>					mContactOrder;	// pair indices, pairs of the same geometry types back-to-back
+
+		Ps::Array<Island>					mIslands;
+		Ps::Array<PxU32>					mIslandOrder;	// largest islands first
+		Ps::Array<PxU32>					mIslandPairs;
+		Ps::Array<PxU32>					mSolverToBody;
+
+		// per-solver-body data: the dynamic bodies grouped by island, then the static bodies
+		Ps::Array<PxSolverBody>				mSolverBodies;
+		Ps::Array<PxSolverBodyData>			mSolverBodyData;
+		Ps::Array<PxVec3>					mLinearMotionVelocities;
+		Ps::Array<PxVec3>					mAngularMotionVelocities;
+
+		PxU32								mNbTouchingPairs;
+};
+
+namespace
+{
+	struct LargerIslandFirst
+	{
+		LargerIslandFirst(const Ps::Array<Island>& islands) : mIslands(islands)	{}
+		bool operator()(PxU32 a, PxU32 b) const
+		{
+			const PxU32 sizeA = mIslands[a].mNbPairs + mIslands[a].mNbBodies;
+			const PxU32 sizeB = mIslands[b].mNbPairs + mIslands[b].mNbBodies;
+			return sizeA > sizeB || (sizeA == sizeB && a < b);
+		}
+		const Ps::Array<Island>& mIslands;
+		PX_NOCOPY(LargerIslandFirst)
+	};
+}
+}
+
+ImmediatePipelineInternal::ImmediatePipelineInternal(const PxImmediatePipelineDesc& desc) :
+	mDesc				(desc),
+	mParity				(0),
+	mBodies				(NULL),
+	mNbBodies			(0),
+	mNbDynamics			(0),
+	mDt					(0.0f),
+	mNextItem			(0),
+	mNbTouchingPairs	(0)
+{
+	// Cm::runParallelJobs runs at most 32 tasks next to the calling thread
+	const PxU32 nbContexts = desc.cpuDispatcher ? PxMin(desc.cpuDispatcher->getWorkerCount() + 1, 33u) : 1;
+	mContexts.resize(nbContexts);
+	for(PxU32 i=0;i<nbContexts;i++)
+		mContexts[i] = PX_NEW(ThreadContext)(i);
+}
+
+ImmediatePipelineInternal::~ImmediatePipelineInternal()
+{
+	for(PxU32 i=0;i<mContexts.size();i++)
+		PX_DELETE(mContexts[i]);
+}
+
+void ImmediatePipelineInternal::resetCaches()
+{
+	mPairs.clear();
+}
+
+PxU32 ImmediatePipelineInternal::findRoot(PxU32 body)
+{
+	PxU32 root = body;
+	while(mParents[root] != root)
+		root = mParents[root];
+
+	while(mParents[body] != root)
+	{
+		const PxU32 next = mParents[body];
+		mParents[body] = root;
+		body = next;
+	}
+	return root;
+}
+
+void ImmediatePipelineInternal::runParallel(Phase phase)
+{
+	mNextItem = 0;
+	PhaseJob job(*this, phase);
+	Cm::runParallelJobs(mDesc.cpuDispatcher, mContexts.size(), job);
+}
+
+void ImmediatePipelineInternal::runPhase(Phase phase, ThreadContext& context)
+{
+	switch(phase)
+	{
+		case eBOUNDS:	computeBounds(context);		break;
+		case eSWEEP:	sweep(context);				break;
+		case eCONTACTS:	generateContacts(context);	break;
+		case eISLANDS:	solveIslands(context);		break;
+	}
+}
+
+void ImmediatePipelineInternal::computeBounds(ThreadContext&)
+{
+	const PxReal inflation = mDesc.contactDistance * 0.5f;
+
+	PxU32 start, end;
+	while(claim(BODIES_PER_CLAIM, mNbBodies, start, end))
+	{
+		for(PxU32 i=start;i<end;i++)
+		{
+			const PxImmediatePipelineBody& body = mBodies[i];
+			PxBounds3 bounds = PxGeometryQuery::getWorldBounds(body.geometry.any(), body.rigidData.body2World, 1.0f);
+			bounds.fattenFast(inflation);
+			mBounds[i] = bounds;
+			mSweepEntries[i].mMinX = bounds.minimum.x;
+			mSweepEntries[i].mBody = i;
+
+			if(!isDynamic(body))
+				immediate::PxConstructStaticSolverBody(body.rigidData.body2World, mSolverBodyData[mSolverIndices[i]]);
+		}
+	}
+}
+
+void ImmediatePipelineInternal::sweep(ThreadContext& context)
+{
+	const PxU32 nbEntries = mSweepEntries.size();
+
+	PxU32 start, end;
+	while(claim(SWEEP_ENTRIES_PER_CLAIM, nbEntries, start, end))
+	{
+		for(PxU32 i=start;i<end;i++)
+		{
+			const PxU32 body0 = mSweepEntries[i].mBody;
+			const PxBounds3& bounds0 = mBounds[body0];
+			const bool dynamic0 = isDynamic(mBodies[body0]);
+
+			for(PxU32 j=i+1; j<nbEntries && mSweepEntries[j].mMinX <= bounds0.maximum.x; j++)
+			{
+				const PxU32 body1 = mSweepEntries[j].mBody;
+				if(!dynamic0 && !isDynamic(mBodies[body1]))
+					continue;
+
+				if(bounds0.intersects(mBounds[body1]))
+					context.mPairKeys.pushBack(body0 < body1 ? (PxU64(body0)<<32 | body1) : (PxU64(body1)<<32 | body0));
+			}
+		}
+	}
+}
+
+// Rebuilds the pair list from the keys found by the sweep, keeping the caches of the pairs already found in the previous step.
+void ImmediatePipelineInternal::updatePairs()
+{
+	mPairKeys.clear();
+	for(PxU32 i=0;i<mContexts.size();i++)
+	{
+		Ps::Array<PxU64>& keys = mContexts[i]->mPairKeys;
+		for(PxU32 j=0;j<keys.size();j++)
+			mPairKeys.pushBack(keys[j]);
+		keys.clear();
+	}
+
+	const PxU32 nbKeys = mPairKeys.size();
+	if(nbKeys>1)
+		Ps::sort(mPairKeys.begin(), nbKeys);
+
+	mNewPairs.resizeUninitialized(nbKeys);
+	PxU32 previous = 0;
+	for(PxU32 i=0;i<nbKeys;i++)
+	{
+		const PxU64 key = mPairKeys[i];
+		const PxU32 low = PxU32(key>>32);
+		const PxU32 high = PxU32(key & 0xffffffff);
+
+		Pair& pair = mNewPairs[i];
+		pair.mKey = key;
+		pair.mBody0 = isDynamic(mBodies[low]) ? low : high;
+		pair.mBody1 = isDynamic(mBodies[low]) ? high : low;
+
+		const PxU16 geomType0 = PxU16(mBodies[pair.mBody0].geometry.getType());
+		const PxU16 geomType1 = PxU16(mBodies[pair.mBody1].geometry.getType());
+
+		while(previous < mPairs.size() && mPairs[previous].mKey < key)
+			previous++;
+
+		if(previous < mPairs.size() && mPairs[previous].mKey == key &&
+			mPairs[previous].mBody0 == pair.mBody0 && mPairs[previous].mGeomType0 == geomType0 && mPairs[previous].mGeomType1 == geomType1)
+		{
+			const Pair& old = mPairs[previous];
+			pair.mCache = old.mCache;
+			pair.mFrictions = old.mFrictions;
+			pair.mNbFrictions = old.mNbFrictions;
+		}
+		else
+		{
+			resetPairCache(pair);
+		}
+
+		pair.mGeomType0 = geomType0;
+		pair.mGeomType1 = geomType1;
+		pair.mContext = 0;
+		pair.mStartContact = 0;
+		pair.mNbContacts = 0;
+	}
+
+	mPairs.swap(mNewPairs);
+	groupPairsByGeometryType();
+}
+
+// The pairs are sorted by key for merging with the previous step. Contacts are generated in a different order, where pairs
+// of the same geometry types are processed back-to-back so that each contact function runs while its code is in the caches.
+// The contacts of a pair do not depend on the order, so results do not change.
+void ImmediatePipelineInternal::groupPairsByGeometryType()
+{
+	const PxU32 nbPairs = mPairs.size();
+	const PxU32 nbTypes = PxGeometryType::eGEOMETRY_COUNT;
+	PxU32 offsets[nbTypes * nbTypes];
+	PxMemZero(offsets, sizeof(offsets));
+
+	for(PxU32 i=0;i<nbPairs;i++)
+		offsets[mPairs[i].mGeomType0 * nbTypes + mPairs[i].mGeomType1]++;
+
+	PxU32 offset = 0;
+	for(PxU32 k=0;k<nbTypes * nbTypes;k++)
+	{
+		const PxU32 count = offsets[k];
+		offsets[k] = offset;
+		offset += count;
+	}
+
+	mContactOrder.resizeUninitialized(nbPairs);
+	for(PxU32 i=0;i<nbPairs;i++)
+		mContactOrder[offsets[mPairs[i].mGeomType0 * nbTypes + mPairs[i].mGeomType1]++] = i;
+}
+
+void ImmediatePipelineInternal::generateContacts(ThreadContext& context)
+{
+	PxU32 start, end;
+	while(claim(PAIRS_PER_CLAIM, mPairs.size(), start, end))
+	{
+		for(PxU32 i=start;i<end;i++)
+		{
+			Pair& pair = mPairs[mContactOrder[i]];
+			const PxImmediatePipelineBody& body0 = mBodies[pair.mBody0];
+			const PxImmediatePipelineBody& body1 = mBodies[pair.mBody1];
+
+			const PxGeometry* geom0 = &body0.geometry.any();
+			const PxGeometry* geom1 = &body1.geometry.any();
+
+			PairContactRecorder recorder(context.mContacts, body0, body1);
+
+			pair.mContext = context.mIndex;
+			pair.mStartContact = context.mContacts.size();
+			immediate::PxGenerateContacts(&geom0, &geom1, &body0.rigidData.body2World, &body1.rigidData.body2World, &pair.mCache, 1, recorder,
+				mDesc.contactDistance, mDesc.meshContactMargin, mDesc.toleranceLength, context.mCacheAllocator);
+			pair.mNbContacts = context.mContacts.size() - pair.mStartContact;
+
+			// the friction patches are only correlated while the pair keeps touching
+			if(!pair.mNbContacts)
+			{
+				pair.mFrictions = NULL;
+				pair.mNbFrictions = 0;
+			}
+		}
+	}
+}
+
+void ImmediatePipelineInternal::buildIslands()
+{
+	// union-find over the dynamic bodies connected by touching pairs. Static bodies do not connect islands.
+	for(PxU32 i=0;i<mNbBodies;i++)
+		mParents[i] = i;
+
+	mNbTouchingPairs = 0;
+	for(PxU32 i=0;i<mPairs.size();i++)
+	{
+		const Pair& pair = mPairs[i];
+		if(!pair.mNbContacts)
+			continue;
+
+		mNbTouchingPairs++;
+		if(isDynamic(mBodies[pair.mBody1]))
+		{
+			const PxU32 root0 = findRoot(pair.mBody0);
+			const PxU32 root1 = findRoot(pair.mBody1);
+			if(root0 != root1)
+				mParents[PxMax(root0, root1)] = PxMin(root0, root1);
+		}
+	}
+
+	// Roots are the smallest body of their island, so numbering the islands while walking the bodies in order
+	// reaches each root before the other bodies of its island, and gives an order that only depends on the inputs.
+	mIslands.clear();
+	for(PxU32 i=0;i<mNbBodies;i++)
+	{
+		if(!isDynamic(mBodies[i]))
+			continue;
+
+		const PxU32 root = findRoot(i);
+		if(root == i)
+		{
+			Island island;
+			island.mBodyStart = 0;
+			island.mNbBodies = 0;
+			island.mPairStart = 0;
+			island.mNbPairs = 0;
+			mIslandIds[i] = mIslands.size();
+			mIslands.pushBack(island);
+		}
+		else
+		{
+			mIslandIds[i] = mIslandIds[root];
+		}
+		mIslands[mIslandIds[i]].mNbBodies++;
+	}
+
+	for(PxU32 i=0;i<mPairs.size();i++)
+	{
+		if(mPairs[i].mNbContacts)
+			mIslands[mIslandIds[mPairs[i].mBody0]].mNbPairs++;
+	}
+
+	PxU32 bodyStart = 0, pairStart = 0;
+	for(PxU32 i=0;i<mIslands.size();i++)
+	{
+		Island& island = mIslands[i];
+		island.mBodyStart = bodyStart;
+		island.mPairStart = pairStart;
+		bodyStart += island.mNbBodies;
+		pairStart += island.mNbPairs;
+		island.mNbBodies = 0;
+		island.mNbPairs = 0;
+	}
+
+	mSolverToBody.resizeUninitialized(mNbDynamics);
+	for(PxU32 i=0;i<mNbBodies;i++)
+	{
+		if(!isDynamic(mBodies[i]))
+			continue;
+
+		Island& island = mIslands[mIslandIds[i]];
+		const PxU32 solverIndex = island.mBodyStart + island.mNbBodies++;
+		mSolverIndices[i] = solverIndex;
+		mSolverToBody[solverIndex] = i;
+	}
+
+	mIslandPairs.resizeUninitialized(pairStart);
+	for(PxU32 i=0;i<mPairs.size();i++)
+	{
+		if(!mPairs[i].mNbContacts)
+			continue;
+
+		Island& island = mIslands[mIslandIds[mPairs[i].mBody0]];
+		mIslandPairs[island.mPairStart + island.mNbPairs++] = i;
+	}
+
+	const PxU32 nbIslands = mIslands.size();
+	mIslandOrder.resizeUninitialized(nbIslands);
+	for(PxU32 i=0;i<nbIslands;i++)
+		mIslandOrder[i] = i;
+	if(nbIslands>1)
+		Ps::sort(mIslandOrder.begin(), nbIslands, LargerIslandFirst(mIslands));
+}
+
+void ImmediatePipelineInternal::solveIslands(ThreadContext& context)
+{
+	PxU32 start, end;
+	while(claim(1, mIslands.size(), start, end))
+		solveIsland(mIslands[mIslandOrder[start]], context);
+}
+
+void ImmediatePipelineInternal::solveIsland(const Island& island, ThreadContext& context)
+{
+	PxSolverBody* bodies = mSolverBodies.begin() + island.mBodyStart;
+	PxSolverBodyData* bodyData = mSolverBodyData.begin() + island.mBodyStart;
+
+	for(PxU32 i=0;i<island.mNbBodies;i++)
+		immediate::PxConstructSolverBodies(&mBodies[mSolverToBody[island.mBodyStart + i]].rigidData, bodyData + i, 1, mDesc.gravity, mDt);
+
+	// the solver accumulates delta velocities in the solver bodies, they must start at zero
+	PxMemZero(bodies, island.mNbBodies * sizeof(PxSolverBody));
+
+	PxVec3* linearMotionVelocities = mLinearMotionVelocities.begin() + island.mBodyStart;
+	PxVec3* angularMotionVelocities = mAngularMotionVelocities.begin() + island.mBodyStart;
+
+	if(island.mNbPairs)
+	{
+		const PxU32 nbPairs = island.mNbPairs;
+		context.mDescs.resizeUninitialized(nbPairs);
+		context.mOrderedDescs.resizeUninitialized(nbPairs);
+		context.mHeaders.resizeUninitialized(nbPairs);
+
+		for(PxU32 i=0;i<nbPairs;i++)
+		{
+			Pair& pair = mPairs[mIslandPairs[island.mPairStart + i]];
+			const PxU32 solverIndex0 = mSolverIndices[pair.mBody0];
+			const PxU32 solverIndex1 = mSolverIndices[pair.mBody1];
+
+			PxSolverConstraintDesc& desc = context.mDescs[i];
+			desc.bodyA = &mSolverBodies[solverIndex0];
+			desc.bodyB = &mSolverBodies[solverIndex1];
+			desc.bodyADataIndex = solverIndex0;
+			desc.bodyBDataIndex = solverIndex1;
+			desc.linkIndexA = PxSolverConstraintDesc::NO_LINK;
+			desc.linkIndexB = PxSolverConstraintDesc::NO_LINK;
+			desc.constraint = reinterpret_cast<PxU8*>(&pair);
+			desc.constraintLengthOver16 = PxSolverConstraintDesc::eCONTACT_CONSTRAINT;
+			desc.writeBack = NULL;
+		}
+
+		// static bodies are stored after all the dynamic ones, so they are outside of the island's range as the batching expects
+		const PxU32 nbHeaders = immediate::PxBatchConstraints(context.mDescs.begin(), nbPairs, bodies, island.mNbBodies, context.mHeaders.begin(), context.mOrderedDescs.begin());
+
+		for(PxU32 h=0;h<nbHeaders;h++)
+		{
+			PxConstraintBatchHeader& header = context.mHeaders[h];
+
+			PxSolverContactDesc contactDescs[4];
+			Pair* pairs[4];
+			for(PxU32 a=0;a<header.mStride;a++)
+			{
+				PxSolverConstraintDesc& constraintDesc = context.mOrderedDescs[header.mStartIndex + a];
+				Pair& pair = *reinterpret_cast<Pair*>(constraintDesc.constraint);
+				ThreadContext& contactContext = *mContexts[pair.mContext];
+				pairs[a] = &pair;
+
+				PxSolverContactDesc& contactDesc = contactDescs[a];
+				contactDesc.body0 = constraintDesc.bodyA;
+				contactDesc.body1 = constraintDesc.bodyB;
+				contactDesc.data0 = &mSolverBodyData[constraintDesc.bodyADataIndex];
+				contactDesc.data1 = &mSolverBodyData[constraintDesc.bodyBDataIndex];
+				contactDesc.bodyFrame0 = contactDesc.data0->body2World;
+				contactDesc.bodyFrame1 = contactDesc.data1->body2World;
+				contactDesc.contactForces = &contactContext.mContactForces[pair.mStartContact];
+				contactDesc.contacts = &contactContext.mContacts[pair.mStartContact];
+				contactDesc.numContacts = pair.mNbContacts;
+				contactDesc.frictionPtr = pair.mFrictions;
+				contactDesc.frictionCount = PxU8(pair.mNbFrictions);
+				contactDesc.disableStrongFriction = false;
+				contactDesc.hasMaxImpulse = false;
+				contactDesc.hasForceThresholds = false;
+				contactDesc.shapeInteraction = NULL;
+				contactDesc.restDistance = 0.0f;
+				contactDesc.maxCCDSeparation = PX_MAX_F32;
+				contactDesc.bodyState0 = PxSolverConstraintPrepDescBase::eDYNAMIC_BODY;
+				contactDesc.bodyState1 = isDynamic(mBodies[pair.mBody1]) ? PxSolverConstraintPrepDescBase::eDYNAMIC_BODY : PxSolverConstraintPrepDescBase::eSTATIC_BODY;
+				contactDesc.desc = &constraintDesc;
+				contactDesc.mInvMassScales.linear0 = contactDesc.mInvMassScales.linear1 = contactDesc.mInvMassScales.angular0 = contactDesc.mInvMassScales.angular1 = 1.0f;
+			}
+
+			immediate::PxCreateContactConstraints(&header, 1, contactDescs, context.mConstraintAllocator, 1.0f/mDt,
+				mDesc.bounceThreshold, mDesc.frictionOffsetThreshold, mDesc.correlationDistance);
+
+			for(PxU32 a=0;a<header.mStride;a++)
+			{
+				pairs[a]->mFrictions = contactDescs[a].frictionPtr;
+				pairs[a]->mNbFrictions = contactDescs[a].frictionCount;
+			}
+		}
+
+		immediate::PxSolveConstraints(context.mHeaders.begin(), nbHeaders, context.mOrderedDescs.begin(), bodies,
+			linearMotionVelocities, angularMotionVelocities, island.mNbBodies, mDesc.nbPositionIterations, mDesc.nbVelocityIterations);
+	}
+	else
+	{
+		for(PxU32 i=0;i<island.mNbBodies;i++)
+		{
+			linearMotionVelocities[i] = PxVec3(0.0f);
+			angularMotionVelocities[i] = PxVec3(0.0f);
+		}
+	}
+
+	immediate::PxIntegrateSolverBodies(bodyData, bodies, linearMotionVelocities, angularMotionVelocities, island.mNbBodies, mDt);
+
+	for(PxU32 i=0;i<island.mNbBodies;i++)
+	{
+		immediate::PxRigidBodyData& rigidData = mBodies[mSolverToBody[island.mBodyStart + i]].rigidData;
+		rigidData.linearVelocity = bodyData[i].linearVelocity;
+		rigidData.angularVelocity = bodyData[i].angularVelocity;
+		rigidData.body2World = bodyData[i].body2World;
+	}
+}
+
+void ImmediatePipelineInternal::simulate(PxImmediatePipelineBody* bodies, PxU32 nbBodies, PxReal dt)
+{
+	mBodies = bodies;
+	mNbBodies = nbBodies;
+	mDt = dt;
+
+	mParity = 1 - mParity;
+	for(PxU32 i=0;i<mContexts.size();i++)
+	{
+		ThreadContext& context = *mContexts[i];
+		context.mCacheAllocator.beginStep(mParity);
+		context.mConstraintAllocator.beginStep(mParity);
+		context.mContacts.clear();
+	}
+
+	// static bodies go after the dynamic ones in the solver arrays, the dynamic ones get their index once the islands are known
+	mNbDynamics = 0;
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		if(isDynamic(bodies[i]))
+			mNbDynamics++;
+	}
+
+	mSolverIndices.resizeUninitialized(nbBodies);
+	PxU32 nbStatics = 0;
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		if(!isDynamic(bodies[i]))
+			mSolverIndices[i] = mNbDynamics + nbStatics++;
+	}
+
+	mBounds.resizeUninitialized(nbBodies);
+	mSweepEntries.resizeUninitialized(nbBodies);
+	mParents.resizeUninitialized(nbBodies);
+	mIslandIds.resizeUninitialized(nbBodies);
+	mSolverBodies.resizeUninitialized(nbBodies);
+	mSolverBodyData.resizeUninitialized(nbBodies);
+	mLinearMotionVelocities.resizeUninitialized(mNbDynamics);
+	mAngularMotionVelocities.resizeUninitialized(mNbDynamics);
+
+	// the static solver bodies are never written by the solver, but the batching reads them
+	for(PxU32 i=mNbDynamics;i<nbBodies;i++)
+		PxMemZero(&mSolverBodies[i], sizeof(PxSolverBody));
+
+	runParallel(eBOUNDS);
+
+	if(nbBodies>1)
+		Ps::sort(mSweepEntries.begin(), nbBodies);
+	runParallel(eSWEEP);
+
+	updatePairs();
+	runParallel(eCONTACTS);
+
+	for(PxU32 i=0;i<mContexts.size();i++)
+	{
+		ThreadContext& context = *mContexts[i];
+		context.mContactForces.resizeUninitialized(context.mContacts.size());
+	}
+
+	buildIslands();
+	runParallel(eISLANDS);
+
+	mBodies = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PxImmediatePipeline::PxImmediatePipeline(const PxImmediatePipelineDesc& desc) : mImpl(NULL)
+{
+	if(!desc.isValid())
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "PxImmediatePipeline: invalid descriptor.");
+		return;
+	}
+	mImpl = PX_NEW(ImmediatePipelineInternal)(desc);
+}
+
+PxImmediatePipeline::~PxImmediatePipeline()
+{
+	PX_DELETE(mImpl);
+}
+
+void PxImmediatePipeline::simulate(PxImmediatePipelineBody* bodies, PxU32 nbBodies, PxReal dt)
+{
+	if(!mImpl || !nbBodies)
+		return;
+
+	if(!(dt > 0.0f))
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "PxImmediatePipeline::simulate: dt must be positive.");
+		return;
+	}
+
+	mImpl->simulate(bodies, nbBodies, dt);
+}
+
+void PxImmediatePipeline::resetCaches()
+{
+	if(mImpl)
+		mImpl->resetCaches();
+}
+
+PxU32 PxImmediatePipeline::getNbTouchingPairs() const
+{
+	return mImpl ? mImpl->mNbTouchingPairs : 0;
+}
+
+PxU32 PxImmediatePipeline::getNbIslands() const
+{
+	return mImpl ? mImpl->mIslands.size() : 0;
+}
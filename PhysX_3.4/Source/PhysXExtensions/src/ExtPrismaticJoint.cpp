@@ -215,6 +215,6 @@ const PxConstraintShaderTable* Ext::GetPrismaticJointShaderTable()
 }
 
 //~PX_SERIALIZATION
-PxConstraintShaderTable Ext::PrismaticJoint::sShaders = { Ext::PrismaticJointSolverPrep, PrismaticJointProject, PrismaticJointVisualize, PxConstraintFlag::Enum(0) };
+PxConstraintShaderTable Ext::PrismaticJoint::sShaders = { Ext::PrismaticJointSolverPrep, PrismaticJointProject, PrismaticJointVisualize, PxConstraintFlag::Enum(0), NULL };
 
 
@@ -38,22 +38,49 @@ using namespace physx;
 #include "geometry/PxConvexMesh.h"
 #include "PxScene.h"
 #include "PxRigidDynamic.h"
+#include "PxBatchQuery.h"
+#include "PxBatchQueryDesc.h"
+#include "task/PxTask.h"
 #include "extensions/PxShapeExt.h"
 #include "PsArray.h"
+#include "PsSync.h"
+#include "PsAtomic.h"
 
 namespace physx
 {
+// Continuation of the batched CCD raycasts. It is never run as a task: the last removeReference() just signals the waiting thread.
+class RaycastCCDCompletionTask : public PxBaseTask
+{
+	public:
+								RaycastCCDCompletionTask() : mRefCount(0)	{}
+
+		virtual	void			run()								{}
+		virtual	const char*		getName()					const	{ return "RaycastCCD.completion";	}
+		virtual	void			addReference()						{ shdfnd::atomicIncrement(&mRefCount);	}
+		virtual	void			removeReference()					{ if(!shdfnd::atomicDecrement(&mRefCount)) mSync.set();	}
+		virtual	int32_t			getReference()				const	{ return mRefCount;	}
+		virtual	void			release()							{}
+
+				void			wait()								{ mSync.wait(); mSync.reset();	}
+	private:
+				volatile PxI32	mRefCount;
+				shdfnd::Sync	mSync;
+};
+
 class RaycastCCDManagerInternal
 {
 	PX_NOCOPY(RaycastCCDManagerInternal)
 	public:
-				RaycastCCDManagerInternal(PxScene* scene) : mScene(scene)	{}
-				~RaycastCCDManagerInternal(){}
+				RaycastCCDManagerInternal(PxScene* scene) : mScene(scene), mBatchQuery(NULL), mDynaDyna(false), mPending(false)	{}
+				~RaycastCCDManagerInternal();
 
 		bool	registerRaycastCCDObject(PxRigidDynamic* actor, PxShape* shape);
 
 		void	doRaycastCCD(bool doDynamicDynamicCCD);
 
+		bool	beginRaycastCCD(bool doDynamicDynamicCCD, PxCpuDispatcher& dispatcher);
+		void	endRaycastCCD();
+
 		struct CCDObject
 		{
 			PX_FORCE_INLINE	CCDObject(PxRigidDynamic* actor, PxShape* shape, const PxVec3& witness) : mActor(actor), mShape(shape), mWitness(witness)	{}
@@ -62,9 +89,32 @@ class RaycastCCDManagerInternal
 			PxVec3			mWitness;
 		};
 
+		// A raycast issued for a moving object, with the data needed to correct its pose once the hit is known.
+		struct CCDQuery
+		{
+			PxTransform		mNewPose;			// shape's global pose after the simulation step
+			PxVec3			mNewShapeCenter;
+			PxVec3			mDir;
+			PxReal			mLength;
+			PxU32			mObjectIndex;
+		};
+
 	private:
-		PxScene*						mScene;
-		physx::shdfnd::Array<CCDObject>	mObjects;
+		PxU32	prepareQueries(bool doDynamicDynamicCCD);
+		void	processResults();
+
+		PxScene*								mScene;
+		physx::shdfnd::Array<CCDObject>			mObjects;
+
+		PxBatchQuery*							mBatchQuery;
+		shdfnd::Array<CCDQuery>					mQueries;
+		shdfnd::Array<PxRaycastQueryResult>		mResults;
+		shdfnd::Array<PxRaycastHit>				mTouches;
+		shdfnd::Array<PxRigidDynamic*>			mActors;		// awake actors, then corrected actors
+		shdfnd::Array<PxTransform>				mPoses;			// their global poses
+		RaycastCCDCompletionTask				mCompletionTask;
+		bool									mDynaDyna;
+		bool									mPending;
 };
 }
 
@@ -209,52 +259,46 @@ static PxRigidDynamic* canDoCCD(PxRigidActor& actor, PxShape* /*shape*/)
 	return dyna;
 }
 
-static bool doRaycastCCD(PxScene* scene, const RaycastCCDManagerInternal::CCDObject& object, PxTransform& newPose, PxVec3& newShapeCenter, bool dyna_dyna)
+static PX_FORCE_INLINE bool supportsRaycastCCD(PxGeometryType::Enum type)
 {
-	PxRigidDynamic* dyna = canDoCCD(*object.mActor, object.mShape);
-	if(!dyna)
-		return true;
+	// computeInternalRadius() returns 0 for the other types, and such objects are never corrected
+	return type==PxGeometryType::eSPHERE || type==PxGeometryType::eBOX || type==PxGeometryType::eCAPSULE || type==PxGeometryType::eCONVEXMESH;
+}
 
-	bool updateCCDWitness = true;
+// Dynamic-vs-dynamic batched raycasts report everything as touches, so that the object's own shape can be discarded afterwards.
+// The batched pre-filter only sees filter data, it cannot do that test itself.
+static PxQueryHitType::Enum CCDRaycastPreFilterShader(PxFilterData, PxFilterData, const void*, PxU32, PxHitFlags&)
+{
+	return PxQueryHitType::eTOUCH;
+}
 
-	const PxVec3 offset = newPose.p - newShapeCenter;
-	const PxVec3& origin = object.mWitness;
-	const PxVec3& dest = newShapeCenter;
+static const PxU16 gMaxCCDTouchHits = 8;	// beyond that, the object falls back to a regular scene raycast
 
-	PxVec3 dir = dest - origin;
-	const PxReal length = dir.magnitude();
-	if(length!=0.0f)
+// Closest touch of a dynamic-vs-dynamic CCD raycast, ignoring the object itself.
+static bool getClosestTouch(const PxRaycastQueryResult& result, const PxRigidActor* actor, const PxShape* shape, PxRaycastHit& hit)
+{
+	bool hasHit = false;
+	for(PxU32 i=0;i<result.nbTouches;i++)
 	{
-		dir /= length;
-
-		const PxReal internalRadius = computeInternalRadius(object.mActor, object.mShape, dir);
-
-		PxRaycastHit hit;
-		if(internalRadius!=0.0f && CCDRaycast(scene, object.mActor, object.mShape, origin, dir, length, hit, dyna_dyna))
+		const PxRaycastHit& touch = result.touches[i];
+		if(touch.actor==actor && touch.shape==shape)
+			continue;
+		if(!hasHit || touch.distance<hit.distance)
 		{
-			updateCCDWitness = false;
-
-			const PxReal radiusLimit = internalRadius * 0.75f;
-			if(hit.distance>radiusLimit)
-			{
-				newShapeCenter = origin + dir * (hit.distance - radiusLimit);
-			}
-			else
-			{
-				if(hit.actor->getConcreteType()==PxConcreteType::eRIGID_DYNAMIC)
-					return true;
-
-				newShapeCenter = origin;
-			}
-
-			newPose.p = offset + newShapeCenter;
-			const PxTransform shapeLocalPose = object.mShape->getLocalPose();
-			const PxTransform inverseShapeLocalPose = shapeLocalPose.getInverse();
-			const PxTransform newGlobalPose = newPose * inverseShapeLocalPose;
-			dyna->setGlobalPose(newGlobalPose);
+			hit = touch;
+			hasHit = true;
 		}
 	}
-	return updateCCDWitness;
+	return hasHit;
+}
+
+RaycastCCDManagerInternal::~RaycastCCDManagerInternal()
+{
+	// the batch must not be released while its tasks are running. Pending corrections are dropped.
+	if(mPending && mQueries.size())
+		mCompletionTask.wait();
+	if(mBatchQuery)
+		mBatchQuery->release();
 }
 
 bool RaycastCCDManagerInternal::registerRaycastCCDObject(PxRigidDynamic* actor, PxShape* shape)
@@ -266,22 +310,192 @@ bool RaycastCCDManagerInternal::registerRaycastCCDObject(PxRigidDynamic* actor,
 	return true;
 }
 
-void RaycastCCDManagerInternal::doRaycastCCD(bool doDynamicDynamicCCD)
+// Reads the poses of the awake objects in bulk and queues one raycast per moving object. Objects that cannot move through
+// anything get their witness updated right away.
+PxU32 RaycastCCDManagerInternal::prepareQueries(bool doDynamicDynamicCCD)
 {
+	mQueries.clear();
+	mActors.clear();
+
 	const PxU32 nbObjects = mObjects.size();
 	for(PxU32 i=0;i<nbObjects;i++)
 	{
-		CCDObject& object = mObjects[i];
+		if(!mObjects[i].mActor->isSleeping())
+			mActors.pushBack(mObjects[i].mActor);
+	}
+
+	const PxU32 nbAwake = mActors.size();
+	if(!nbAwake)
+		return 0;
+
+	mPoses.resizeUninitialized(nbAwake);
+	mScene->getRigidDynamicPoses(mActors.begin(), nbAwake, PxStrideIterator<PxTransform>(mPoses.begin()));
 
+	PxU32 awakeIndex = 0;
+	for(PxU32 i=0;i<nbObjects;i++)
+	{
+		CCDObject& object = mObjects[i];
 		if(object.mActor->isSleeping())
 			continue;
 
-		PxTransform newPose = PxShapeExt::getGlobalPose(*object.mShape, *object.mActor);
-		PxVec3 newShapeCenter = getShapeCenter(object.mShape, newPose);
+		const PxTransform newPose = mPoses[awakeIndex++] * object.mShape->getLocalPose();
+		const PxVec3 newShapeCenter = getShapeCenter(object.mShape, newPose);
 
-		if(::doRaycastCCD(mScene, object, newPose, newShapeCenter, doDynamicDynamicCCD))
+		PxVec3 dir = newShapeCenter - object.mWitness;
+		const PxReal length = dir.magnitude();
+		if(length==0.0f || !canDoCCD(*object.mActor, object.mShape) || !supportsRaycastCCD(object.mShape->getGeometryType()))
+		{
 			object.mWitness = newShapeCenter;
+			continue;
+		}
+		dir /= length;
+
+		CCDQuery query;
+		query.mNewPose			= newPose;
+		query.mNewShapeCenter	= newShapeCenter;
+		query.mDir				= dir;
+		query.mLength			= length;
+		query.mObjectIndex		= i;
+		mQueries.pushBack(query);
+	}
+
+	const PxU32 nbQueries = mQueries.size();
+	if(!nbQueries)
+		return 0;
+
+	if(!mBatchQuery)
+	{
+		PxBatchQueryDesc desc(0, 0, 0);
+		desc.preFilterShader = CCDRaycastPreFilterShader;
+		mBatchQuery = mScene->createBatchQuery(desc);
+		if(!mBatchQuery)
+			return 0;
+	}
+
+	const PxU16 maxTouchHits = doDynamicDynamicCCD ? gMaxCCDTouchHits : PxU16(0);
+	mResults.resizeUninitialized(nbQueries);
+	mTouches.resizeUninitialized(nbQueries * maxTouchHits);
+
+	PxBatchQueryMemory memory(nbQueries, 0, 0);
+	memory.userRaycastResultBuffer	= mResults.begin();
+	memory.userRaycastTouchBuffer	= mTouches.begin();
+	memory.raycastTouchBufferSize	= mTouches.size();
+	mBatchQuery->setUserMemory(memory);
+
+	const PxQueryFilterData filterData(PxFilterData(), doDynamicDynamicCCD ? PxQueryFlags(PxQueryFlag::eSTATIC|PxQueryFlag::eDYNAMIC|PxQueryFlag::ePREFILTER) : PxQueryFlags(PxQueryFlag::eSTATIC));
+	for(PxU32 i=0;i<nbQueries;i++)
+	{
+		const CCDQuery& query = mQueries[i];
+		mBatchQuery->raycast(mObjects[query.mObjectIndex].mWitness, query.mDir, query.mLength, maxTouchHits, PxHitFlag::eDISTANCE, filterData);
 	}
+	return nbQueries;
+}
+
+// Turns the raycast hits into pose corrections, and applies all of them with a single bulk update.
+void RaycastCCDManagerInternal::processResults()
+{
+	mActors.clear();
+	mPoses.clear();
+
+	const PxU32 nbQueries = mQueries.size();
+	for(PxU32 i=0;i<nbQueries;i++)
+	{
+		const CCDQuery& query = mQueries[i];
+		const PxRaycastQueryResult& result = mResults[i];
+		CCDObject& object = mObjects[query.mObjectIndex];
+		const PxVec3& origin = object.mWitness;
+
+		PxRaycastHit hit;
+		bool hasHit;
+		if(!mDynaDyna)
+		{
+			hasHit = result.hasBlock;
+			if(hasHit)
+				hit = result.block;
+		}
+		else if(result.queryStatus==PxBatchQueryStatus::eOVERFLOW || result.nbTouches==gMaxCCDTouchHits)
+			hasHit = CCDRaycast(mScene, object.mActor, object.mShape, origin, query.mDir, query.mLength, hit, true);
+		else
+			hasHit = getClosestTouch(result, object.mActor, object.mShape, hit);
+
+		const PxReal internalRadius = hasHit ? computeInternalRadius(object.mActor, object.mShape, query.mDir) : 0.0f;
+		if(internalRadius==0.0f)
+		{
+			object.mWitness = query.mNewShapeCenter;
+			continue;
+		}
+
+		PxVec3 newShapeCenter;
+		const PxReal radiusLimit = internalRadius * 0.75f;
+		if(hit.distance>radiusLimit)
+		{
+			newShapeCenter = origin + query.mDir * (hit.distance - radiusLimit);
+		}
+		else
+		{
+			if(hit.actor->getConcreteType()==PxConcreteType::eRIGID_DYNAMIC)
+			{
+				object.mWitness = query.mNewShapeCenter;
+				continue;
+			}
+			newShapeCenter = origin;
+		}
+
+		// the witness is kept where it was, so that the next frame raycasts from there again
+		PxTransform newPose = query.mNewPose;
+		newPose.p += newShapeCenter - query.mNewShapeCenter;
+		mActors.pushBack(object.mActor);
+		mPoses.pushBack(newPose * object.mShape->getLocalPose().getInverse());
+	}
+
+	if(mActors.size())
+		mScene->setRigidDynamicPoses(mActors.begin(), mActors.size(), PxStrideIterator<const PxTransform>(mPoses.begin()));
+}
+
+void RaycastCCDManagerInternal::doRaycastCCD(bool doDynamicDynamicCCD)
+{
+	PX_ASSERT(!mPending);
+	mDynaDyna = doDynamicDynamicCCD;
+	if(!prepareQueries(doDynamicDynamicCCD))
+		return;
+
+	mBatchQuery->execute();
+	processResults();
+}
+
+bool RaycastCCDManagerInternal::beginRaycastCCD(bool doDynamicDynamicCCD, PxCpuDispatcher& dispatcher)
+{
+	if(mPending)
+		return false;
+
+	mDynaDyna = doDynamicDynamicCCD;
+	mPending = true;
+	if(!prepareQueries(doDynamicDynamicCCD))
+	{
+		mQueries.clear();
+		return true;
+	}
+
+	if(!mBatchQuery->executeParallel(dispatcher, &mCompletionTask))
+	{
+		mQueries.clear();
+		mPending = false;
+		return false;
+	}
+	return true;
+}
+
+void RaycastCCDManagerInternal::endRaycastCCD()
+{
+	if(!mPending)
+		return;
+	mPending = false;
+
+	if(!mQueries.size())
+		return;
+
+	mCompletionTask.wait();
+	processResults();
 }
 
 RaycastCCDManager::RaycastCCDManager(PxScene* scene)
@@ -303,3 +517,13 @@ void RaycastCCDManager::doRaycastCCD(bool doDynamicDynamicCCD)
 {
 	mImpl->doRaycastCCD(doDynamicDynamicCCD);
 }
+
+bool RaycastCCDManager::beginRaycastCCD(bool doDynamicDynamicCCD, PxCpuDispatcher& dispatcher)
+{
+	return mImpl->beginRaycastCCD(doDynamicDynamicCCD, dispatcher);
+}
+
+void RaycastCCDManager::endRaycastCCD()
+{
+	mImpl->endRaycastCCD();
+}
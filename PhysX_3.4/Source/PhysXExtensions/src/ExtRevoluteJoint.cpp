@@ -309,4 +309,4 @@ const PxConstraintShaderTable* Ext::GetRevoluteJointShaderTable()
 }
 
 //~PX_SERIALIZATION
-PxConstraintShaderTable Ext::RevoluteJoint::sShaders = { Ext::RevoluteJointSolverPrep, RevoluteJointProject, RevoluteJointVisualize, PxConstraintFlag::Enum(0) };
+PxConstraintShaderTable Ext::RevoluteJoint::sShaders = { Ext::RevoluteJointSolverPrep, RevoluteJointProject, RevoluteJointVisualize, PxConstraintFlag::Enum(0), Ext::RevoluteJointSolverPrep4 };
@@ -31,6 +31,7 @@
 #include "ExtRevoluteJoint.h"
 #include "PsUtilities.h"
 #include "ExtConstraintHelper.h"
+#include "ExtConstraintHelper4.h"
 #include "CmRenderOutput.h"
 #include "PsMathUtils.h"
 
@@ -112,6 +113,51 @@ namespace Ext
 
 		return ch.getCount();
 	}
+
+	void RevoluteJointSolverPrep4(Px1DConstraint* const* constraints,
+		PxU32* rowCounts,
+		PxVec3* body0WorldOffsets,
+		PxU32 maxConstraints,
+		PxConstraintInvMassScale* invMassScales,
+		const void* const* constantBlocks,
+		const PxTransform* bA2w,
+		const PxTransform* bB2w)
+	{
+		using namespace joint;
+
+		// drives and limits add rows depending on the joint state, so only plain hinges are prepped together
+		for(PxU32 a=0; a<4; a++)
+		{
+			const RevoluteJointData& data = *reinterpret_cast<const RevoluteJointData*>(constantBlocks[a]);
+			if(data.jointFlags & (PxRevoluteJointFlag::eLIMIT_ENABLED | PxRevoluteJointFlag::eDRIVE_ENABLED))
+			{
+				solverPrep4Scalar(RevoluteJointSolverPrep, constraints, rowCounts, body0WorldOffsets, maxConstraints, invMassScales, constantBlocks, bA2w, bB2w);
+				return;
+			}
+		}
+
+		PxTransform cA2w[4], cB2w[4];
+		PxVec3 ra[4], rb[4];
+		for(PxU32 a=0; a<4; a++)
+		{
+			const RevoluteJointData& data = *reinterpret_cast<const RevoluteJointData*>(constantBlocks[a]);
+			invMassScales[a] = data.invMassScale;
+
+			cA2w[a] = bA2w[a] * data.c2b[0];
+			cB2w[a] = bB2w[a] * data.c2b[1];
+
+			if(cB2w[a].q.dot(cA2w[a].q)<0.f)
+				cB2w[a].q = -cB2w[a].q;
+
+			body0WorldOffsets[a] = cB2w[a].p-bA2w[a].p;
+			ra[a] = cB2w[a].p - bA2w[a].p;
+			rb[a] = cB2w[a].p - bB2w[a].p;
+		}
+
+		const PxU32 count = prepareLockedAxes4(constraints, cA2w, cB2w, ra, rb, 7, 6);
+		for(PxU32 a=0; a<4; a++)
+			rowCounts[a] = count;
+	}
 }//namespace
 
 }
@@ -0,0 +1,212 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "PxSceneGroup.h"
+
+using namespace physx;
+
+#include "PxScene.h"
+#include "CmPhysXCommon.h"
+#include "PsFoundation.h"
+#include "PsArray.h"
+#include "PsSort.h"
+#include "PsThread.h"
+#include "PsTime.h"
+
+namespace physx
+{
+class SceneGroupInternal : public Ps::UserAllocated
+{
+	public:
+		struct Entry
+		{
+			PxScene*			mScene;
+			PxSceneGroupTiming	mTiming;
+			PxU64				mStartTime;	// tens of nanoseconds
+			bool				mPending;
+		};
+
+		// slowest scenes first
+		struct SlowerFirst
+		{
+			SlowerFirst(const Ps::Array<Entry>& entries) : mEntries(entries)	{}
+			bool operator()(PxU32 a, PxU32 b) const	{ return mEntries[a].mTiming.averageStepTime > mEntries[b].mTiming.averageStepTime; }
+			const Ps::Array<Entry>& mEntries;
+			PX_NOCOPY(SlowerFirst)
+		};
+
+						SceneGroupInternal() : mSimulating(false)	{}
+
+		PxU32			find(const PxScene& scene)	const;
+		void			simulate(PxReal elapsedTime);
+		void			fetchResults();
+
+		Ps::Array<Entry>	mEntries;
+		Ps::Array<PxU32>	mOrder;
+		bool				mSimulating;
+};
+}
+
+static const PxReal gAverageWeight = 0.1f;
+
+static PX_FORCE_INLINE PxReal toSeconds(PxU64 tensOfNanos)
+{
+	return PxReal(double(tensOfNanos) / double(Ps::Time::sNumTensOfNanoSecondsInASecond));
+}
+
+PxU32 SceneGroupInternal::find(const PxScene& scene) const
+{
+	for(PxU32 i=0;i<mEntries.size();i++)
+	{
+		if(mEntries[i].mScene==&scene)
+			return i;
+	}
+	return 0xffffffff;
+}
+
+void SceneGroupInternal::simulate(PxReal elapsedTime)
+{
+	const PxU32 nbScenes = mEntries.size();
+	mOrder.resizeUninitialized(nbScenes);
+	for(PxU32 i=0;i<nbScenes;i++)
+		mOrder[i] = i;
+	if(nbScenes>1)
+		Ps::sort(mOrder.begin(), nbScenes, SlowerFirst(mEntries));
+
+	for(PxU32 i=0;i<nbScenes;i++)
+	{
+		Entry& entry = mEntries[mOrder[i]];
+		entry.mStartTime = Ps::Time::getCurrentTimeInTensOfNanoSeconds();
+		entry.mScene->simulate(elapsedTime);
+		entry.mPending = true;
+	}
+	mSimulating = true;
+}
+
+void SceneGroupInternal::fetchResults()
+{
+	if(!mSimulating)
+		return;
+
+	PxU32 nbPending = 0;
+	for(PxU32 i=0;i<mEntries.size();i++)
+		nbPending += mEntries[i].mPending ? 1 : 0;
+
+	while(nbPending)
+	{
+		bool fetched = false;
+		for(PxU32 i=0;i<mEntries.size();i++)
+		{
+			Entry& entry = mEntries[mOrder[i]];
+			if(!entry.mPending || !entry.mScene->checkResults(false))
+				continue;
+
+			const PxU64 completionTime = Ps::Time::getCurrentTimeInTensOfNanoSeconds();
+			entry.mScene->fetchResults(true);
+			const PxU64 fetchedTime = Ps::Time::getCurrentTimeInTensOfNanoSeconds();
+
+			PxSceneGroupTiming& timing = entry.mTiming;
+			timing.lastStepTime = toSeconds(completionTime - entry.mStartTime);
+			timing.lastFetchTime = toSeconds(fetchedTime - completionTime);
+			timing.averageStepTime = timing.nbSteps ? timing.averageStepTime + (timing.lastStepTime - timing.averageStepTime) * gAverageWeight : timing.lastStepTime;
+			timing.nbSteps++;
+
+			entry.mPending = false;
+			nbPending--;
+			fetched = true;
+		}
+
+		// the worker threads are busy with the remaining scenes
+		if(!fetched)
+			Ps::Thread::yield();
+	}
+	mSimulating = false;
+}
+
+PxSceneGroup::PxSceneGroup()
+{
+	mImpl = PX_NEW(SceneGroupInternal);
+}
+
+PxSceneGroup::~PxSceneGroup()
+{
+	PX_DELETE(mImpl);
+}
+
+bool PxSceneGroup::addScene(PxScene& scene)
+{
+	PX_CHECK_AND_RETURN_VAL(!mImpl->mSimulating, "PxSceneGroup::addScene: not allowed between simulate() and fetchResults().", false);
+	if(mImpl->find(scene)!=0xffffffff)
+		return false;
+
+	SceneGroupInternal::Entry& entry = mImpl->mEntries.insert();
+	entry.mScene = &scene;
+	entry.mTiming.lastStepTime = 0.0f;
+	entry.mTiming.averageStepTime = 0.0f;
+	entry.mTiming.lastFetchTime = 0.0f;
+	entry.mTiming.nbSteps = 0;
+	entry.mStartTime = 0;
+	entry.mPending = false;
+	return true;
+}
+
+void PxSceneGroup::removeScene(PxScene& scene)
+{
+	PX_CHECK_AND_RETURN(!mImpl->mSimulating, "PxSceneGroup::removeScene: not allowed between simulate() and fetchResults().");
+	const PxU32 index = mImpl->find(scene);
+	if(index!=0xffffffff)
+		mImpl->mEntries.remove(index);
+}
+
+PxU32 PxSceneGroup::getNbScenes() const
+{
+	return mImpl->mEntries.size();
+}
+
+void PxSceneGroup::simulate(PxReal elapsedTime)
+{
+	PX_CHECK_AND_RETURN(!mImpl->mSimulating, "PxSceneGroup::simulate: fetchResults() must be called first.");
+	// a scene refusing to simulate would never complete, the other checks of PxScene::simulate() do not apply to the group
+	PX_CHECK_AND_RETURN(elapsedTime > 0.0f, "PxSceneGroup::simulate: The elapsed time must be positive!");
+	mImpl->simulate(elapsedTime);
+}
+
+void PxSceneGroup::fetchResults()
+{
+	mImpl->fetchResults();
+}
+
+bool PxSceneGroup::getTiming(const PxScene& scene, PxSceneGroupTiming& timing) const
+{
+	const PxU32 index = mImpl->find(scene);
+	if(index==0xffffffff)
+		return false;
+	timing = mImpl->mEntries[index].mTiming;
+	return true;
+}
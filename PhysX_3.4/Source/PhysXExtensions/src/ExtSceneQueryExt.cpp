@@ -28,6 +28,10 @@
 // Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
 
 #include "PxSceneQueryExt.h"
+#include "PxShapeExt.h"
+#include "geometry/PxGeometryQuery.h"
+#include "CmPhysXCommon.h"
+#include "PsInlineArray.h"
 
 using namespace physx;
 
@@ -195,3 +199,90 @@ bool PxSceneQueryExt::overlapAny(	const PxScene& scene,
 	hit = buf.block;
 	return buf.hasBlock;
 }
+
+namespace
+{
+	struct DepenetrationShape
+	{
+		PxGeometryHolder	mGeometry;
+		PxTransform			mPose;
+	};
+
+	// Moves the query geometry out of each overlapping shape as the overlap query reports them, and keeps the shapes for the
+	// next iterations.
+	class DepenetrationCallback : public PxOverlapCallback
+	{
+	public:
+		static const PxU32 NB_TOUCHES = 32;
+
+		DepenetrationCallback(const PxGeometry& geometry, const PxTransform& pose) :
+			PxOverlapCallback	(mTouches, NB_TOUCHES),
+			mGeometry			(geometry),
+			mPose				(pose),
+			mPenetrated			(false)
+		{
+		}
+
+		virtual PxAgain processTouches(const PxOverlapHit* buffer, PxU32 nbHits)
+		{
+			for(PxU32 i=0;i<nbHits;i++)
+			{
+				DepenetrationShape& shape = mShapes.insert();
+				shape.mGeometry = buffer[i].shape->getGeometry();
+				shape.mPose = PxShapeExt::getGlobalPose(*buffer[i].shape, *buffer[i].actor);
+				depenetrate(shape);
+			}
+			return true;
+		}
+
+		bool depenetrate(const DepenetrationShape& shape)
+		{
+			PxVec3 mtd;
+			PxF32 depth;
+			if(!PxGeometryQuery::computePenetration(mtd, depth, mGeometry, mPose, shape.mGeometry.any(), shape.mPose))
+				return false;
+
+			mPose.p += mtd * depth;
+			mPenetrated = true;
+			return true;
+		}
+
+		PxOverlapHit								mTouches[NB_TOUCHES];
+		Ps::InlineArray<DepenetrationShape, 16>		mShapes;
+		const PxGeometry&							mGeometry;
+		PxTransform									mPose;
+		bool										mPenetrated;
+
+	private:
+		DepenetrationCallback& operator=(const DepenetrationCallback&);
+	};
+}
+
+bool PxSceneQueryExt::computeDepenetration(	const PxScene& scene,
+											const PxGeometry& geometry, const PxTransform& pose,
+											PxVec3& direction, PxReal& depth,
+											const PxSceneQueryFilterData& filterData,
+											PxSceneQueryFilterCallback* filterCall,
+											PxU32 maxIter)
+{
+	PxQueryFilterData fd1 = filterData;
+	fd1.flags |= PxQueryFlag::eNO_BLOCK;
+
+	DepenetrationCallback callback(geometry, pose);
+	if(maxIter)
+		scene.overlap(geometry, pose, callback, fd1, filterCall);
+
+	// the first iteration ran during the overlap query, the next ones only go over the shapes the query found
+	bool moved = callback.mPenetrated;
+	for(PxU32 iter=1; iter<maxIter && moved; iter++)
+	{
+		moved = false;
+		for(PxU32 i=0;i<callback.mShapes.size();i++)
+			moved |= callback.depenetrate(callback.mShapes[i]);
+	}
+
+	const PxVec3 delta = callback.mPose.p - pose.p;
+	depth = delta.magnitude();
+	direction = depth > 0.0f ? delta / depth : PxVec3(0.0f);
+	return callback.mPenetrated;
+}
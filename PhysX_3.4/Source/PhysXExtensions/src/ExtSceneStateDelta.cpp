@@ -0,0 +1,1090 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#include "PxSceneStateDelta.h"
+
+using namespace physx;
+
+#include "foundation/PxIO.h"
+#include "PxScene.h"
+#include "PxSceneDesc.h"
+#include "PxRigidDynamic.h"
+#include "CmPhysXCommon.h"
+#include "PsFoundation.h"
+#include "PsArray.h"
+#include "PsHashMap.h"
+#include "PsHashSet.h"
+#include "PsSort.h"
+#include "PsMathUtils.h"
+
+// Frame layout, all values little endian:
+//
+//	header		magic (4), version (1), frame type (1), rotation bits (1), padding (1), frame index (4),
+//				keyframe index (4), position step (4), velocity step (4), payload size (4)
+//	payload		number of entries (varint), then for each entry, sorted by actor id:
+//				id minus the previous entry's id (varint), field mask (1), the fields present in the mask
+//
+// Fields are encoded against a reference state: the keyframe state of the same actor in delta frames, a zero
+// state in keyframes and for added actors. Quantized positions are stored as zig-zag varint differences with
+// the reference, quantized velocities as zig-zag varints, quantized rotations as the smallest three components
+// of the quaternion. Lossless values are the raw floats.
+
+namespace
+{
+	const PxU32	SCENE_STATE_MAGIC	= 0x44535850;	// "PXSD"
+	const PxU8	SCENE_STATE_VERSION	= 1;
+	const PxU32	HEADER_SIZE			= 28;
+
+	enum FrameType
+	{
+		eKEYFRAME,
+		eDELTA
+	};
+
+	enum FieldMask
+	{
+		eFIELD_FLAGS			= (1<<0),
+		eFIELD_POSITION			= (1<<1),
+		eFIELD_ROTATION			= (1<<2),
+		eFIELD_LINEAR_VELOCITY	= (1<<3),
+		eFIELD_ANGULAR_VELOCITY	= (1<<4),
+		eFIELD_TARGET			= (1<<5),
+		eFIELD_ADDED			= (1<<6),
+		eFIELD_REMOVED			= (1<<7)
+	};
+
+	// A state as stored in the stream: quantized values, or the bits of the lossless floats. States are compared
+	// in this form, so that the encoder and the decoder agree on what changed.
+	struct EncodedState
+	{
+		PxU32	position[3];
+		PxU32	rotation[4];		// packed smallest three in [0] and [1] when quantized
+		PxU32	linearVelocity[3];
+		PxU32	angularVelocity[3];
+		PxU32	targetPosition[3];
+		PxU32	targetRotation[4];
+		PxU32	flags;
+
+		void	setZero()	{ PxMemZero(this, sizeof(EncodedState)); }
+	};
+
+	PX_FORCE_INLINE bool isEqual(const PxU32* a, const PxU32* b, PxU32 nb)
+	{
+		for(PxU32 i=0;i<nb;i++)
+		{
+			if(a[i]!=b[i])
+				return false;
+		}
+		return true;
+	}
+
+	PxU32 getChangedFields(const EncodedState& state, const EncodedState& ref)
+	{
+		PxU32 mask = 0;
+		if(state.flags != ref.flags)
+			mask |= eFIELD_FLAGS;
+		if(!isEqual(state.position, ref.position, 3))
+			mask |= eFIELD_POSITION;
+		if(!isEqual(state.rotation, ref.rotation, 4))
+			mask |= eFIELD_ROTATION;
+		if(!isEqual(state.linearVelocity, ref.linearVelocity, 3))
+			mask |= eFIELD_LINEAR_VELOCITY;
+		if(!isEqual(state.angularVelocity, ref.angularVelocity, 3))
+			mask |= eFIELD_ANGULAR_VELOCITY;
+		if(!isEqual(state.targetPosition, ref.targetPosition, 3) || !isEqual(state.targetRotation, ref.targetRotation, 4))
+			mask |= eFIELD_TARGET;
+		return mask;
+	}
+
+	PX_FORCE_INLINE PxU32 floatToBits(PxReal value)
+	{
+		PxU32 bits;
+		PxMemCopy(&bits, &value, sizeof(PxU32));
+		return bits;
+	}
+
+	PX_FORCE_INLINE PxReal bitsToFloat(PxU32 bits)
+	{
+		PxReal value;
+		PxMemCopy(&value, &bits, sizeof(PxReal));
+		return value;
+	}
+
+	PX_FORCE_INLINE PxU32 zigZag(PxI32 value)		{ return (PxU32(value) << 1) ^ PxU32(value >> 31);	}
+	PX_FORCE_INLINE PxI32 unZigZag(PxU32 value)		{ return PxI32(value >> 1) ^ -PxI32(value & 1);		}
+
+	bool isSameQuantization(const PxSceneStateQuantization& a, const PxSceneStateQuantization& b)
+	{
+		return a.positionStep==b.positionStep && a.velocityStep==b.velocityStep && a.rotationBits==b.rotationBits;
+	}
+
+	class Quantizer
+	{
+	public:
+		Quantizer(const PxSceneStateQuantization& quantization) : mQuantization(quantization)	{}
+
+		PX_FORCE_INLINE	bool	isPositionQuantized()	const	{ return mQuantization.positionStep > 0.0f;	}
+		PX_FORCE_INLINE	bool	isVelocityQuantized()	const	{ return mQuantization.velocityStep > 0.0f;	}
+		PX_FORCE_INLINE	bool	isRotationQuantized()	const	{ return mQuantization.rotationBits != 0;	}
+		PX_FORCE_INLINE	PxU32	getNbRotationBytes()	const	{ return (2 + 3*mQuantization.rotationBits + 7)/8;	}
+
+		void encodePosition(const PxVec3& p, PxU32* words) const
+		{
+			for(PxU32 i=0;i<3;i++)
+				words[i] = isPositionQuantized() ? PxU32(quantize(p[i], mQuantization.positionStep)) : floatToBits(p[i]);
+		}
+
+		PxVec3 decodePosition(const PxU32* words) const
+		{
+			PxVec3 p;
+			for(PxU32 i=0;i<3;i++)
+				p[i] = isPositionQuantized() ? PxReal(PxI32(words[i]))*mQuantization.positionStep : bitsToFloat(words[i]);
+			return p;
+		}
+
+		void encodeVelocity(const PxVec3& v, PxU32* words) const
+		{
+			for(PxU32 i=0;i<3;i++)
+				words[i] = isVelocityQuantized() ? PxU32(quantize(v[i], mQuantization.velocityStep)) : floatToBits(v[i]);
+		}
+
+		PxVec3 decodeVelocity(const PxU32* words) const
+		{
+			PxVec3 v;
+			for(PxU32 i=0;i<3;i++)
+				v[i] = isVelocityQuantized() ? PxReal(PxI32(words[i]))*mQuantization.velocityStep : bitsToFloat(words[i]);
+			return v;
+		}
+
+		// Smallest three: the largest component is dropped (and made positive by negating the quaternion), the
+		// others lie in [-1/sqrt(2), 1/sqrt(2)]. 2 bits of index followed by 3 components of rotationBits each.
+		void encodeRotation(const PxQuat& rotation, PxU32* words) const
+		{
+			if(!isRotationQuantized())
+			{
+				words[0] = floatToBits(rotation.x);
+				words[1] = floatToBits(rotation.y);
+				words[2] = floatToBits(rotation.z);
+				words[3] = floatToBits(rotation.w);
+				return;
+			}
+
+			const PxQuat q = rotation.getNormalized();
+			PxReal c[4] = { q.x, q.y, q.z, q.w };
+			PxU32 largest = 0;
+			for(PxU32 i=1;i<4;i++)
+			{
+				if(PxAbs(c[i]) > PxAbs(c[largest]))
+					largest = i;
+			}
+			const PxReal sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+			const PxU32 maxValue = (1u<<mQuantization.rotationBits) - 1;
+
+			PxU64 packed = largest;
+			PxU32 shift = 2;
+			for(PxU32 i=0;i<4;i++)
+			{
+				if(i==largest)
+					continue;
+				const PxReal unit = PxClamp((c[i]*sign*PxSqrt(2.0f) + 1.0f)*0.5f, 0.0f, 1.0f);
+				packed |= PxU64(PxU32(unit*PxReal(maxValue) + 0.5f)) << shift;
+				shift += mQuantization.rotationBits;
+			}
+			words[0] = PxU32(packed);
+			words[1] = PxU32(packed>>32);
+			words[2] = 0;
+			words[3] = 0;
+		}
+
+		PxQuat decodeRotation(const PxU32* words) const
+		{
+			if(!isRotationQuantized())
+				return PxQuat(bitsToFloat(words[0]), bitsToFloat(words[1]), bitsToFloat(words[2]), bitsToFloat(words[3]));
+
+			const PxU64 packed = PxU64(words[0]) | (PxU64(words[1])<<32);
+			const PxU32 largest = PxU32(packed & 3);
+			const PxU32 maxValue = (1u<<mQuantization.rotationBits) - 1;
+
+			PxReal c[4];
+			PxReal sumSq = 0.0f;
+			PxU32 shift = 2;
+			for(PxU32 i=0;i<4;i++)
+			{
+				if(i==largest)
+					continue;
+				const PxU32 value = PxU32(packed >> shift) & maxValue;
+				c[i] = (PxReal(value)/PxReal(maxValue)*2.0f - 1.0f)/PxSqrt(2.0f);
+				sumSq += c[i]*c[i];
+				shift += mQuantization.rotationBits;
+			}
+			c[largest] = PxSqrt(PxMax(0.0f, 1.0f - sumSq));
+			return PxQuat(c[0], c[1], c[2], c[3]).getNormalized();
+		}
+
+		const PxSceneStateQuantization&	getQuantization()	const	{ return mQuantization;	}
+
+	private:
+		static PxI32 quantize(PxReal value, PxReal step)
+		{
+			const PxReal limit = PxReal(1<<30);
+			return PxI32(PxFloor(PxClamp(value/step, -limit, limit) + 0.5f));
+		}
+
+		PxSceneStateQuantization	mQuantization;
+	};
+
+	class ByteWriter
+	{
+		PX_NOCOPY(ByteWriter)
+	public:
+		ByteWriter(Ps::Array<PxU8>& buffer) : mBuffer(buffer)	{ mBuffer.clear();	}
+
+		void	writeU8(PxU32 value)	{ mBuffer.pushBack(PxU8(value));	}
+		void	writeU32(PxU32 value)
+		{
+			for(PxU32 i=0;i<4;i++)
+				writeU8(value>>(i*8));
+		}
+		void	writeVarint(PxU32 value)
+		{
+			while(value >= 0x80)
+			{
+				writeU8((value & 0x7f) | 0x80);
+				value >>= 7;
+			}
+			writeU8(value);
+		}
+		void	patchU32(PxU32 offset, PxU32 value)
+		{
+			for(PxU32 i=0;i<4;i++)
+				mBuffer[offset+i] = PxU8(value>>(i*8));
+		}
+		PxU32	getSize()	const	{ return mBuffer.size();	}
+
+	private:
+		Ps::Array<PxU8>&	mBuffer;
+	};
+
+	class ByteReader
+	{
+	public:
+		ByteReader(const PxU8* data, PxU32 size) : mData(data), mSize(size), mOffset(0), mFailed(false)	{}
+
+		PxU32	readU8()
+		{
+			if(mOffset >= mSize)
+			{
+				mFailed = true;
+				return 0;
+			}
+			return mData[mOffset++];
+		}
+		PxU32	readU32()
+		{
+			PxU32 value = 0;
+			for(PxU32 i=0;i<4;i++)
+				value |= readU8()<<(i*8);
+			return value;
+		}
+		PxU32	readVarint()
+		{
+			PxU32 value = 0;
+			for(PxU32 shift=0; shift<35 && !mFailed; shift+=7)
+			{
+				const PxU32 byte = readU8();
+				value |= (byte & 0x7f) << shift;
+				if(!(byte & 0x80))
+					return value;
+			}
+			mFailed = true;
+			return 0;
+		}
+		bool	isDone()	const	{ return !mFailed && mOffset==mSize;	}
+		bool	hasFailed()	const	{ return mFailed;	}
+
+	private:
+		const PxU8*	mData;
+		PxU32		mSize;
+		PxU32		mOffset;
+		bool		mFailed;
+	};
+
+	void writePosition(ByteWriter& writer, const Quantizer& quantizer, const PxU32* words, const PxU32* ref)
+	{
+		for(PxU32 i=0;i<3;i++)
+		{
+			if(quantizer.isPositionQuantized())
+				writer.writeVarint(zigZag(PxI32(words[i] - ref[i])));
+			else
+				writer.writeU32(words[i]);
+		}
+	}
+
+	void readPosition(ByteReader& reader, const Quantizer& quantizer, PxU32* words, const PxU32* ref)
+	{
+		for(PxU32 i=0;i<3;i++)
+			words[i] = quantizer.isPositionQuantized() ? ref[i] + PxU32(unZigZag(reader.readVarint())) : reader.readU32();
+	}
+
+	void writeRotation(ByteWriter& writer, const Quantizer& quantizer, const PxU32* words)
+	{
+		if(quantizer.isRotationQuantized())
+		{
+			const PxU64 packed = PxU64(words[0]) | (PxU64(words[1])<<32);
+			for(PxU32 i=0;i<quantizer.getNbRotationBytes();i++)
+				writer.writeU8(PxU32(packed>>(i*8)));
+		}
+		else
+		{
+			for(PxU32 i=0;i<4;i++)
+				writer.writeU32(words[i]);
+		}
+	}
+
+	void readRotation(ByteReader& reader, const Quantizer& quantizer, PxU32* words)
+	{
+		if(quantizer.isRotationQuantized())
+		{
+			PxU64 packed = 0;
+			for(PxU32 i=0;i<quantizer.getNbRotationBytes();i++)
+				packed |= PxU64(reader.readU8())<<(i*8);
+			words[0] = PxU32(packed);
+			words[1] = PxU32(packed>>32);
+			words[2] = 0;
+			words[3] = 0;
+		}
+		else
+		{
+			for(PxU32 i=0;i<4;i++)
+				words[i] = reader.readU32();
+		}
+	}
+
+	void writeVelocity(ByteWriter& writer, const Quantizer& quantizer, const PxU32* words)
+	{
+		for(PxU32 i=0;i<3;i++)
+		{
+			if(quantizer.isVelocityQuantized())
+				writer.writeVarint(zigZag(PxI32(words[i])));
+			else
+				writer.writeU32(words[i]);
+		}
+	}
+
+	void readVelocity(ByteReader& reader, const Quantizer& quantizer, PxU32* words)
+	{
+		for(PxU32 i=0;i<3;i++)
+			words[i] = quantizer.isVelocityQuantized() ? PxU32(unZigZag(reader.readVarint())) : reader.readU32();
+	}
+
+	void writeFields(ByteWriter& writer, const Quantizer& quantizer, PxU32 mask, const EncodedState& state, const EncodedState& ref)
+	{
+		if(mask & eFIELD_FLAGS)
+			writer.writeU8(state.flags);
+		if(mask & eFIELD_POSITION)
+			writePosition(writer, quantizer, state.position, ref.position);
+		if(mask & eFIELD_ROTATION)
+			writeRotation(writer, quantizer, state.rotation);
+		if(mask & eFIELD_LINEAR_VELOCITY)
+			writeVelocity(writer, quantizer, state.linearVelocity);
+		if(mask & eFIELD_ANGULAR_VELOCITY)
+			writeVelocity(writer, quantizer, state.angularVelocity);
+		if(mask & eFIELD_TARGET)
+		{
+			writePosition(writer, quantizer, state.targetPosition, ref.targetPosition);
+			writeRotation(writer, quantizer, state.targetRotation);
+		}
+	}
+
+	// 'state' must be initialized with the reference state, the fields of the mask are overwritten
+	void readFields(ByteReader& reader, const Quantizer& quantizer, PxU32 mask, EncodedState& state, const EncodedState& ref)
+	{
+		if(mask & eFIELD_FLAGS)
+			state.flags = reader.readU8();
+		if(mask & eFIELD_POSITION)
+			readPosition(reader, quantizer, state.position, ref.position);
+		if(mask & eFIELD_ROTATION)
+			readRotation(reader, quantizer, state.rotation);
+		if(mask & eFIELD_LINEAR_VELOCITY)
+			readVelocity(reader, quantizer, state.linearVelocity);
+		if(mask & eFIELD_ANGULAR_VELOCITY)
+			readVelocity(reader, quantizer, state.angularVelocity);
+		if(mask & eFIELD_TARGET)
+		{
+			readPosition(reader, quantizer, state.targetPosition, ref.targetPosition);
+			readRotation(reader, quantizer, state.targetRotation);
+		}
+	}
+
+	void writeHeader(ByteWriter& writer, const Quantizer& quantizer, FrameType type, PxU32 frameIndex, PxU32 keyframeIndex)
+	{
+		const PxSceneStateQuantization& quantization = quantizer.getQuantization();
+		writer.writeU32(SCENE_STATE_MAGIC);
+		writer.writeU8(SCENE_STATE_VERSION);
+		writer.writeU8(type);
+		writer.writeU8(quantization.rotationBits);
+		writer.writeU8(0);
+		writer.writeU32(frameIndex);
+		writer.writeU32(keyframeIndex);
+		writer.writeU32(floatToBits(quantization.positionStep));
+		writer.writeU32(floatToBits(quantization.velocityStep));
+		writer.writeU32(0);	// payload size, patched once known
+		PX_ASSERT(writer.getSize()==HEADER_SIZE);
+	}
+
+	struct KeyEntry
+	{
+		PxU32			id;
+		EncodedState	state;
+	};
+}
+
+namespace physx
+{
+class SceneStateEncoderInternal : public Ps::UserAllocated
+{
+	PX_NOCOPY(SceneStateEncoderInternal)
+	public:
+						SceneStateEncoderInternal(const PxSceneStateQuantization& quantization);
+
+		bool			addActor(PxRigidDynamic& actor, PxU32 id);
+		bool			removeActor(PxRigidDynamic& actor);
+		void			markDirty(PxRigidDynamic& actor);
+		PxU32			writeKeyframe(PxOutputStream& stream);
+		PxU32			writeDelta(PxOutputStream& stream, PxScene* scene);
+
+		struct Actor
+		{
+			PxRigidDynamic*	mActor;
+			PxU32			mId;
+			bool			mDirty;		// must be read again before the next frame
+			EncodedState	mState;		// state when last read
+		};
+
+		Quantizer								mQuantizer;
+		Ps::Array<Actor>						mActors;
+		Ps::HashMap<const PxRigidDynamic*, PxU32>	mActorMap;	// actor => index in mActors
+		Ps::HashSet<PxU32>						mIds;
+		Ps::Array<PxU32>						mSortedActors;	// indices in mActors sorted by id
+		bool									mSortedActorsValid;
+		Ps::Array<KeyEntry>						mKeyframe;		// sorted by id
+		Ps::Array<PxU8>							mBuffer;
+		PxU32									mNbFrames;
+		PxU32									mKeyframeIndex;
+		bool									mHasKeyframe;
+
+	private:
+		void			readState(Actor& actor);
+		void			sortActors();
+		PxU32			flush(ByteWriter& writer, PxOutputStream& stream);
+};
+
+class SceneStateDecoderInternal : public Ps::UserAllocated
+{
+	PX_NOCOPY(SceneStateDecoderInternal)
+	public:
+						SceneStateDecoderInternal();
+
+		bool			readFrame(PxInputStream& stream);
+
+		PxSceneStateQuantization		mKeyframeQuantization;
+		Ps::Array<KeyEntry>				mKeyframe;		// sorted by id
+		Ps::Array<PxRigidDynamicState>	mStates;		// sorted by id
+		Ps::Array<PxU8>					mPayload;
+		PxU32							mFrameIndex;
+		PxU32							mKeyframeIndex;
+		bool							mHasKeyframe;
+		bool							mIsKeyframe;
+
+	private:
+		bool			readKeyframe(ByteReader& reader, const Quantizer& quantizer, PxU32 nbEntries);
+		bool			readDelta(ByteReader& reader, const Quantizer& quantizer, PxU32 nbEntries);
+		void			decodeState(PxRigidDynamicState& out, PxU32 id, const EncodedState& state, const Quantizer& quantizer)	const;
+};
+}
+
+namespace
+{
+	class ActorIdLess
+	{
+	public:
+		ActorIdLess(const SceneStateEncoderInternal::Actor* actors) : mActors(actors)	{}
+		bool operator()(PxU32 a, PxU32 b) const	{ return mActors[a].mId < mActors[b].mId;	}
+	private:
+		const SceneStateEncoderInternal::Actor*	mActors;
+	};
+
+	bool invalidFrame(const char* message)
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "PxSceneStateDecoder::readFrame: %s", message);
+		return false;
+	}
+}
+
+SceneStateEncoderInternal::SceneStateEncoderInternal(const PxSceneStateQuantization& quantization) :
+	mQuantizer			(quantization),
+	mSortedActorsValid	(true),
+	mNbFrames			(0),
+	mKeyframeIndex		(0),
+	mHasKeyframe		(false)
+{
+}
+
+bool SceneStateEncoderInternal::addActor(PxRigidDynamic& actor, PxU32 id)
+{
+	if(mActorMap.find(&actor) || mIds.contains(id))
+		return false;
+
+	Actor& entry = mActors.insert();
+	entry.mActor = &actor;
+	entry.mId = id;
+	entry.mDirty = true;
+	entry.mState.setZero();
+	mActorMap.insert(&actor, mActors.size()-1);
+	mIds.insert(id);
+	mSortedActorsValid = false;
+	return true;
+}
+
+bool SceneStateEncoderInternal::removeActor(PxRigidDynamic& actor)
+{
+	const Ps::HashMap<const PxRigidDynamic*, PxU32>::Entry* entry = mActorMap.find(&actor);
+	if(!entry)
+		return false;
+
+	const PxU32 index = entry->second;
+	mIds.erase(mActors[index].mId);
+	mActorMap.erase(&actor);
+	mActors.replaceWithLast(index);
+	if(index < mActors.size())
+		mActorMap[mActors[index].mActor] = index;
+	mSortedActorsValid = false;
+	return true;
+}
+
+void SceneStateEncoderInternal::markDirty(PxRigidDynamic& actor)
+{
+	const Ps::HashMap<const PxRigidDynamic*, PxU32>::Entry* entry = mActorMap.find(&actor);
+	if(entry)
+		mActors[entry->second].mDirty = true;
+}
+
+void SceneStateEncoderInternal::readState(Actor& entry)
+{
+	const PxRigidDynamic& actor = *entry.mActor;
+	EncodedState& state = entry.mState;
+	state.setZero();
+
+	const PxTransform pose = actor.getGlobalPose();
+	mQuantizer.encodePosition(pose.p, state.position);
+	mQuantizer.encodeRotation(pose.q, state.rotation);
+
+	if(actor.isSleeping())
+		state.flags |= PxRigidDynamicState::Flag::eSLEEPING;
+
+	if(actor.getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC)
+	{
+		state.flags |= PxRigidDynamicState::Flag::eKINEMATIC;
+		PxTransform target;
+		if(actor.getKinematicTarget(target))
+		{
+			state.flags |= PxRigidDynamicState::Flag::eHAS_KINEMATIC_TARGET;
+			mQuantizer.encodePosition(target.p, state.targetPosition);
+			mQuantizer.encodeRotation(target.q, state.targetRotation);
+		}
+	}
+	else
+	{
+		mQuantizer.encodeVelocity(actor.getLinearVelocity(), state.linearVelocity);
+		mQuantizer.encodeVelocity(actor.getAngularVelocity(), state.angularVelocity);
+	}
+	entry.mDirty = false;
+}
+
+void SceneStateEncoderInternal::sortActors()
+{
+	if(mSortedActorsValid)
+		return;
+
+	const PxU32 nbActors = mActors.size();
+	mSortedActors.resize(nbActors);
+	for(PxU32 i=0;i<nbActors;i++)
+		mSortedActors[i] = i;
+	if(nbActors)
+		Ps::sort(mSortedActors.begin(), nbActors, ActorIdLess(mActors.begin()));
+	mSortedActorsValid = true;
+}
+
+PxU32 SceneStateEncoderInternal::flush(ByteWriter& writer, PxOutputStream& stream)
+{
+	const PxU32 size = writer.getSize();
+	writer.patchU32(HEADER_SIZE-4, size - HEADER_SIZE);
+	return stream.write(mBuffer.begin(), size);
+}
+
+PxU32 SceneStateEncoderInternal::writeKeyframe(PxOutputStream& stream)
+{
+	sortActors();
+
+	const PxU32 nbActors = mActors.size();
+	mKeyframe.resize(nbActors);
+
+	EncodedState zero;
+	zero.setZero();
+
+	ByteWriter writer(mBuffer);
+	writeHeader(writer, mQuantizer, eKEYFRAME, mNbFrames, mNbFrames);
+	writer.writeVarint(nbActors);
+
+	PxU32 previousId = 0;
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		Actor& actor = mActors[mSortedActors[i]];
+		readState(actor);
+		mKeyframe[i].id = actor.mId;
+		mKeyframe[i].state = actor.mState;
+
+		const PxU32 mask = getChangedFields(actor.mState, zero);
+		writer.writeVarint(actor.mId - previousId);
+		writer.writeU8(mask);
+		writeFields(writer, mQuantizer, mask, actor.mState, zero);
+		previousId = actor.mId;
+	}
+
+	mKeyframeIndex = mNbFrames++;
+	mHasKeyframe = true;
+	return flush(writer, stream);
+}
+
+PxU32 SceneStateEncoderInternal::writeDelta(PxOutputStream& stream, PxScene* scene)
+{
+	if(!mHasKeyframe)
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxSceneStateEncoder::writeDelta: writeKeyframe must be called first.");
+		return 0;
+	}
+
+	// Only read the actors the simulation or the user changed, if the scene tells which ones.
+	const PxU32 nbActors = mActors.size();
+	if(scene && (scene->getFlags() & PxSceneFlag::eENABLE_ACTIVE_ACTORS))
+	{
+		PxU32 nbActiveActors = 0;
+		PxActor** activeActors = scene->getActiveActors(nbActiveActors);
+		for(PxU32 i=0;i<nbActiveActors;i++)
+		{
+			if(!activeActors[i]->is<PxRigidDynamic>())
+				continue;
+			const Ps::HashMap<const PxRigidDynamic*, PxU32>::Entry* entry = mActorMap.find(static_cast<PxRigidDynamic*>(activeActors[i]));
+			if(entry)
+				mActors[entry->second].mDirty = true;
+		}
+	}
+	else
+	{
+		for(PxU32 i=0;i<nbActors;i++)
+			mActors[i].mDirty = true;
+	}
+
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		if(mActors[i].mDirty)
+			readState(mActors[i]);
+	}
+
+	sortActors();
+
+	EncodedState zero;
+	zero.setZero();
+
+	ByteWriter writer(mBuffer);
+	writeHeader(writer, mQuantizer, eDELTA, mNbFrames, mKeyframeIndex);
+	const PxU32 countOffset = writer.getSize();
+	writer.writeU32(0);	// entry count placeholder, a fixed size varint is patched below
+
+	// Merge the current actors with the keyframe ones, both sorted by id.
+	PxU32 nbEntries = 0;
+	PxU32 previousId = 0;
+	PxU32 actorIndex = 0;
+	PxU32 keyIndex = 0;
+	const PxU32 nbKeys = mKeyframe.size();
+	while(actorIndex < nbActors || keyIndex < nbKeys)
+	{
+		const Actor* actor = actorIndex < nbActors ? &mActors[mSortedActors[actorIndex]] : NULL;
+		const KeyEntry* key = keyIndex < nbKeys ? &mKeyframe[keyIndex] : NULL;
+
+		PxU32 id;
+		PxU32 mask;
+		const EncodedState* state = NULL;
+		const EncodedState* ref = &zero;
+		if(actor && (!key || actor->mId < key->id))
+		{
+			id = actor->mId;
+			state = &actor->mState;
+			mask = getChangedFields(*state, zero) | eFIELD_ADDED;
+			actorIndex++;
+		}
+		else if(key && (!actor || key->id < actor->mId))
+		{
+			id = key->id;
+			mask = eFIELD_REMOVED;
+			keyIndex++;
+		}
+		else
+		{
+			id = actor->mId;
+			state = &actor->mState;
+			ref = &key->state;
+			mask = getChangedFields(*state, *ref);
+			actorIndex++;
+			keyIndex++;
+		}
+
+		if(!mask)
+			continue;
+
+		writer.writeVarint(id - previousId);
+		writer.writeU8(mask);
+		if(state)
+			writeFields(writer, mQuantizer, mask, *state, *ref);
+		previousId = id;
+		nbEntries++;
+	}
+
+	// Patch the count as a 4-byte varint (at most 2^28-1 entries)
+	PX_ASSERT(nbEntries < (1u<<28));
+	for(PxU32 i=0;i<4;i++)
+		mBuffer[countOffset+i] = PxU8(((nbEntries >> (i*7)) & 0x7f) | (i<3 ? 0x80 : 0));
+
+	mNbFrames++;
+	return flush(writer, stream);
+}
+
+SceneStateDecoderInternal::SceneStateDecoderInternal() :
+	mFrameIndex		(0),
+	mKeyframeIndex	(0),
+	mHasKeyframe	(false),
+	mIsKeyframe		(false)
+{
+}
+
+void SceneStateDecoderInternal::decodeState(PxRigidDynamicState& out, PxU32 id, const EncodedState& state, const Quantizer& quantizer) const
+{
+	out.id				= id;
+	out.flags			= state.flags;
+	out.pose			= PxTransform(quantizer.decodePosition(state.position), quantizer.decodeRotation(state.rotation));
+	out.linearVelocity	= quantizer.decodeVelocity(state.linearVelocity);
+	out.angularVelocity	= quantizer.decodeVelocity(state.angularVelocity);
+	if(state.flags & PxRigidDynamicState::Flag::eHAS_KINEMATIC_TARGET)
+		out.kinematicTarget = PxTransform(quantizer.decodePosition(state.targetPosition), quantizer.decodeRotation(state.targetRotation));
+	else
+		out.kinematicTarget = out.pose;
+}
+
+bool SceneStateDecoderInternal::readKeyframe(ByteReader& reader, const Quantizer& quantizer, PxU32 nbEntries)
+{
+	EncodedState zero;
+	zero.setZero();
+
+	Ps::Array<KeyEntry> keyframe;
+	keyframe.reserve(nbEntries);
+
+	PxU32 id = 0;
+	for(PxU32 i=0;i<nbEntries && !reader.hasFailed();i++)
+	{
+		const PxU32 idDelta = reader.readVarint();
+		if(i && !idDelta)
+			return invalidFrame("actor ids are not sorted.");
+		id += idDelta;
+
+		const PxU32 mask = reader.readU8();
+		if(mask & (eFIELD_ADDED|eFIELD_REMOVED))
+			return invalidFrame("invalid keyframe entry.");
+
+		KeyEntry& entry = keyframe.insert();
+		entry.id = id;
+		entry.state = zero;
+		readFields(reader, quantizer, mask, entry.state, zero);
+	}
+	if(!reader.isDone())
+		return invalidFrame("truncated or invalid payload.");
+
+	mKeyframe.swap(keyframe);
+	mKeyframeQuantization = quantizer.getQuantization();
+	mHasKeyframe = true;
+
+	mStates.resize(mKeyframe.size());
+	for(PxU32 i=0;i<mKeyframe.size();i++)
+		decodeState(mStates[i], mKeyframe[i].id, mKeyframe[i].state, quantizer);
+	return true;
+}
+
+bool SceneStateDecoderInternal::readDelta(ByteReader& reader, const Quantizer& quantizer, PxU32 nbEntries)
+{
+	struct DeltaEntry
+	{
+		PxU32			id;
+		PxU32			mask;
+		EncodedState	state;
+	};
+
+	EncodedState zero;
+	zero.setZero();
+
+	Ps::Array<DeltaEntry> entries;
+	entries.reserve(nbEntries);
+
+	const PxU32 nbKeys = mKeyframe.size();
+	PxU32 keyIndex = 0;
+	PxU32 id = 0;
+	for(PxU32 i=0;i<nbEntries && !reader.hasFailed();i++)
+	{
+		const PxU32 idDelta = reader.readVarint();
+		if(i && !idDelta)
+			return invalidFrame("actor ids are not sorted.");
+		id += idDelta;
+
+		while(keyIndex < nbKeys && mKeyframe[keyIndex].id < id)
+			keyIndex++;
+		const KeyEntry* key = (keyIndex < nbKeys && mKeyframe[keyIndex].id == id) ? &mKeyframe[keyIndex] : NULL;
+
+		DeltaEntry& entry = entries.insert();
+		entry.id = id;
+		entry.mask = reader.readU8();
+		if(entry.mask & eFIELD_ADDED)
+		{
+			if(key || (entry.mask & eFIELD_REMOVED))
+				return invalidFrame("invalid added actor.");
+			entry.state = zero;
+			readFields(reader, quantizer, entry.mask, entry.state, zero);
+		}
+		else
+		{
+			if(!key || ((entry.mask & eFIELD_REMOVED) && entry.mask != eFIELD_REMOVED))
+				return invalidFrame("delta entry does not match the keyframe.");
+			entry.state = key->state;
+			readFields(reader, quantizer, entry.mask, entry.state, key->state);
+		}
+	}
+	if(!reader.isDone())
+		return invalidFrame("truncated or invalid payload.");
+
+	// Merge the keyframe with the delta, both sorted by id
+	mStates.clear();
+	mStates.reserve(nbKeys + entries.size());
+	PxU32 entryIndex = 0;
+	keyIndex = 0;
+	while(keyIndex < nbKeys || entryIndex < entries.size())
+	{
+		const KeyEntry* key = keyIndex < nbKeys ? &mKeyframe[keyIndex] : NULL;
+		const DeltaEntry* entry = entryIndex < entries.size() ? &entries[entryIndex] : NULL;
+
+		if(key && (!entry || key->id < entry->id))
+		{
+			decodeState(mStates.insert(), key->id, key->state, quantizer);
+			keyIndex++;
+			continue;
+		}
+
+		if(!(entry->mask & eFIELD_REMOVED))
+			decodeState(mStates.insert(), entry->id, entry->state, quantizer);
+		if(key && key->id == entry->id)
+			keyIndex++;
+		entryIndex++;
+	}
+	return true;
+}
+
+bool SceneStateDecoderInternal::readFrame(PxInputStream& stream)
+{
+	PxU8 headerData[HEADER_SIZE];
+	if(stream.read(headerData, HEADER_SIZE) != HEADER_SIZE)
+		return invalidFrame("truncated header.");
+
+	ByteReader header(headerData, HEADER_SIZE);
+	const PxU32 magic = header.readU32();
+	const PxU32 version = header.readU8();
+	const PxU32 type = header.readU8();
+	PxSceneStateQuantization quantization;
+	quantization.rotationBits = header.readU8();
+	header.readU8();
+	const PxU32 frameIndex = header.readU32();
+	const PxU32 keyframeIndex = header.readU32();
+	quantization.positionStep = bitsToFloat(header.readU32());
+	quantization.velocityStep = bitsToFloat(header.readU32());
+	const PxU32 payloadSize = header.readU32();
+
+	if(magic != SCENE_STATE_MAGIC || version != SCENE_STATE_VERSION || type > eDELTA || !quantization.isValid())
+		return invalidFrame("not a scene state frame, or an unsupported version.");
+
+	mPayload.resizeUninitialized(payloadSize);
+	if(stream.read(mPayload.begin(), payloadSize) != payloadSize)
+		return invalidFrame("truncated payload.");
+
+	if(type == eDELTA && (!mHasKeyframe || keyframeIndex != mKeyframeIndex || !isSameQuantization(quantization, mKeyframeQuantization)))
+		return invalidFrame("the keyframe of this delta frame was not the last one read.");
+
+	const Quantizer quantizer(quantization);
+	ByteReader reader(mPayload.begin(), payloadSize);
+	const PxU32 nbEntries = reader.readVarint();
+	if(reader.hasFailed())
+		return invalidFrame("truncated payload.");
+
+	const bool success = type == eKEYFRAME ? readKeyframe(reader, quantizer, nbEntries) : readDelta(reader, quantizer, nbEntries);
+	if(!success)
+		return false;
+
+	mFrameIndex = frameIndex;
+	mKeyframeIndex = keyframeIndex;
+	mIsKeyframe = type == eKEYFRAME;
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PxSceneStateEncoder::PxSceneStateEncoder(const PxSceneStateQuantization& quantization) : mImpl(NULL)
+{
+	PX_CHECK_AND_RETURN(quantization.isValid(), "PxSceneStateEncoder: quantization is not valid.");
+	mImpl = PX_NEW(SceneStateEncoderInternal)(quantization);
+}
+
+PxSceneStateEncoder::~PxSceneStateEncoder()
+{
+	PX_DELETE(mImpl);
+}
+
+bool PxSceneStateEncoder::addActor(PxRigidDynamic& actor, PxU32 id)
+{
+	return mImpl ? mImpl->addActor(actor, id) : false;
+}
+
+bool PxSceneStateEncoder::removeActor(PxRigidDynamic& actor)
+{
+	return mImpl ? mImpl->removeActor(actor) : false;
+}
+
+void PxSceneStateEncoder::markDirty(PxRigidDynamic& actor)
+{
+	if(mImpl)
+		mImpl->markDirty(actor);
+}
+
+PxU32 PxSceneStateEncoder::getNbActors() const
+{
+	return mImpl ? mImpl->mActors.size() : 0;
+}
+
+PxU32 PxSceneStateEncoder::writeKeyframe(PxOutputStream& stream)
+{
+	return mImpl ? mImpl->writeKeyframe(stream) : 0;
+}
+
+PxU32 PxSceneStateEncoder::writeDelta(PxOutputStream& stream, PxScene* scene)
+{
+	return mImpl ? mImpl->writeDelta(stream, scene) : 0;
+}
+
+PxU32 PxSceneStateEncoder::getNbFrames() const
+{
+	return mImpl ? mImpl->mNbFrames : 0;
+}
+
+PxSceneStateDecoder::PxSceneStateDecoder() : mImpl(PX_NEW(SceneStateDecoderInternal)())
+{
+}
+
+PxSceneStateDecoder::~PxSceneStateDecoder()
+{
+	PX_DELETE(mImpl);
+}
+
+bool PxSceneStateDecoder::readFrame(PxInputStream& stream)
+{
+	return mImpl->readFrame(stream);
+}
+
+bool PxSceneStateDecoder::isKeyframe() const
+{
+	return mImpl->mIsKeyframe;
+}
+
+PxU32 PxSceneStateDecoder::getFrameIndex() const
+{
+	return mImpl->mFrameIndex;
+}
+
+PxU32 PxSceneStateDecoder::getKeyframeIndex() const
+{
+	return mImpl->mKeyframeIndex;
+}
+
+PxU32 PxSceneStateDecoder::getNbStates() const
+{
+	return mImpl->mStates.size();
+}
+
+const PxRigidDynamicState* PxSceneStateDecoder::getStates() const
+{
+	return mImpl->mStates.begin();
+}
+
+const PxRigidDynamicState* PxSceneStateDecoder::findState(PxU32 id) const
+{
+	// binary search, the states are sorted by id
+	const PxRigidDynamicState* states = mImpl->mStates.begin();
+	PxU32 first = 0;
+	PxU32 last = mImpl->mStates.size();
+	while(first < last)
+	{
+		const PxU32 middle = (first + last)/2;
+		if(states[middle].id < id)
+			first = middle + 1;
+		else
+			last = middle;
+	}
+	return (first < mImpl->mStates.size() && states[first].id == id) ? states + first : NULL;
+}
+
+void PxSceneStateDecoder::applyState(PxRigidDynamic& actor, const PxRigidDynamicState& state)
+{
+	if(actor.getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC)
+	{
+		actor.setGlobalPose(state.pose, false);
+		if(state.flags & PxRigidDynamicState::Flag::eHAS_KINEMATIC_TARGET)
+			actor.setKinematicTarget(state.kinematicTarget);
+		return;
+	}
+
+	const bool sleeping = (state.flags & PxRigidDynamicState::Flag::eSLEEPING) != 0;
+	actor.setGlobalPose(state.pose, false);
+	actor.setLinearVelocity(state.linearVelocity, false);
+	actor.setAngularVelocity(state.angularVelocity, false);
+	if(sleeping)
+		actor.putToSleep();
+	else if(actor.isSleeping())
+		actor.wakeUp();
+}
@@ -0,0 +1,525 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#include "PxSharedMeshStore.h"
+
+using namespace physx;
+
+#include "PxPhysics.h"
+#include "geometry/PxTriangleMesh.h"
+#include "geometry/PxConvexMesh.h"
+#include "geometry/PxHeightField.h"
+#include "extensions/PxDefaultStreams.h"
+#include "CmPhysXCommon.h"
+#include "PsFoundation.h"
+#include "PsHashMap.h"
+#include "PsHashSet.h"
+#include "PsIntrinsics.h"
+#include "PsString.h"
+
+#if PX_WINDOWS_FAMILY
+	#include "windows/PsWindowsInclude.h"
+	#define EXT_SHARED_MEMORY_SUPPORTED 1
+#elif PX_UNIX_FAMILY && !PX_ANDROID
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#define EXT_SHARED_MEMORY_SUPPORTED 1
+#else
+	#define EXT_SHARED_MEMORY_SUPPORTED 0
+#endif
+
+namespace
+{
+	// Layout of the region: a header, the entry table, then the cooked data of each entry, 16-byte aligned.
+	// The magic is written last by the publisher, so a reader never sees a partially written region as valid.
+	const PxU32 REGION_MAGIC	= 0x534d5850;	// "PXMS"
+	const PxU32 REGION_VERSION	= 1;
+	const PxU32 MAX_REGION_NAME	= 255;
+
+	struct RegionHeader
+	{
+		PxU32	magic;
+		PxU32	version;
+		PxU32	nbEntries;
+		PxU32	pad;
+		PxU64	totalSize;
+		PxU64	pad2;
+	};
+
+	struct RegionEntry
+	{
+		char	name[PxSharedMeshStore::eMAX_NAME_LENGTH+1];
+		PxU64	offset;
+		PxU32	size;
+		PxU32	type;
+	};
+
+	PX_COMPILE_TIME_ASSERT(sizeof(RegionHeader)==32);
+	PX_COMPILE_TIME_ASSERT(sizeof(RegionEntry)==80);
+
+	PX_FORCE_INLINE PxU64 align16(PxU64 value)
+	{
+		return (value + 15) & ~PxU64(15);
+	}
+
+	// Named shared-memory mapping
+	class SharedRegion
+	{
+		public:
+						SharedRegion() : mAddress(NULL), mSize(0), mOwner(false)
+#if PX_WINDOWS_FAMILY
+						, mHandle(NULL)
+#endif
+						{
+							mName[0] = 0;
+						}
+
+						~SharedRegion()	{ close();	}
+
+		// creates a new region, mapped read-write until makeReadOnly()
+		bool			create(const char* name, PxU64 size);
+		// maps an existing region read-only
+		bool			open(const char* name);
+		void			makeReadOnly();
+		void			close();
+
+		PX_FORCE_INLINE	void*	getAddress()	const	{ return mAddress;	}
+		PX_FORCE_INLINE	PxU64	getSize()		const	{ return mSize;		}
+
+		private:
+		void*			mAddress;
+		PxU64			mSize;
+		bool			mOwner;
+		char			mName[MAX_REGION_NAME+1];
+#if PX_WINDOWS_FAMILY
+		HANDLE			mHandle;
+#endif
+		bool			setName(const char* name);
+	};
+
+	bool SharedRegion::setName(const char* name)
+	{
+		if(!name || !name[0] || strlen(name) > MAX_REGION_NAME)
+		{
+			Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "PxSharedMeshStore: invalid region name.");
+			return false;
+		}
+		Ps::strlcpy(mName, MAX_REGION_NAME+1, name);
+		return true;
+	}
+
+#if PX_WINDOWS_FAMILY
+
+	bool SharedRegion::create(const char* name, PxU64 size)
+	{
+		if(!setName(name))
+			return false;
+
+		mHandle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, DWORD(size>>32), DWORD(size), mName);
+		if(mHandle && GetLastError() == ERROR_ALREADY_EXISTS)
+		{
+			CloseHandle(mHandle);
+			mHandle = NULL;
+		}
+		if(!mHandle)
+			return false;
+
+		mAddress = MapViewOfFile(mHandle, FILE_MAP_WRITE, 0, 0, 0);
+		if(!mAddress)
+		{
+			close();
+			return false;
+		}
+		mSize = size;
+		mOwner = true;
+		return true;
+	}
+
+	bool SharedRegion::open(const char* name)
+	{
+		if(!setName(name))
+			return false;
+
+		mHandle = OpenFileMappingA(FILE_MAP_READ, FALSE, mName);
+		if(!mHandle)
+			return false;
+
+		mAddress = MapViewOfFile(mHandle, FILE_MAP_READ, 0, 0, 0);
+		MEMORY_BASIC_INFORMATION info;
+		if(!mAddress || !VirtualQuery(mAddress, &info, sizeof(info)))
+		{
+			close();
+			return false;
+		}
+		mSize = PxU64(info.RegionSize);
+		return true;
+	}
+
+	void SharedRegion::makeReadOnly()
+	{
+		DWORD oldProtect;
+		VirtualProtect(mAddress, SIZE_T(mSize), PAGE_READONLY, &oldProtect);
+	}
+
+	void SharedRegion::close()
+	{
+		// the mapping object is destroyed with its last handle, so nothing specific for the owner here
+		if(mAddress)
+			UnmapViewOfFile(mAddress);
+		if(mHandle)
+			CloseHandle(mHandle);
+		mAddress = NULL;
+		mHandle = NULL;
+		mSize = 0;
+		mOwner = false;
+	}
+
+#elif EXT_SHARED_MEMORY_SUPPORTED
+
+	bool SharedRegion::create(const char* name, PxU64 size)
+	{
+		if(!setName(name))
+			return false;
+
+		const int fd = shm_open(mName, O_CREAT | O_EXCL | O_RDWR, 0644);
+		if(fd < 0)
+			return false;
+
+		void* address = MAP_FAILED;
+		if(ftruncate(fd, off_t(size)) == 0)
+			address = mmap(NULL, size_t(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		::close(fd);
+
+		if(address == MAP_FAILED)
+		{
+			shm_unlink(mName);
+			return false;
+		}
+		mAddress = address;
+		mSize = size;
+		mOwner = true;
+		return true;
+	}
+
+	bool SharedRegion::open(const char* name)
+	{
+		if(!setName(name))
+			return false;
+
+		const int fd = shm_open(mName, O_RDONLY, 0);
+		if(fd < 0)
+			return false;
+
+		struct stat info;
+		void* address = MAP_FAILED;
+		if(fstat(fd, &info) == 0 && info.st_size > 0)
+			address = mmap(NULL, size_t(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+
+		if(address == MAP_FAILED)
+			return false;
+		mAddress = address;
+		mSize = PxU64(info.st_size);
+		return true;
+	}
+
+	void SharedRegion::makeReadOnly()
+	{
+		mprotect(mAddress, size_t(mSize), PROT_READ);
+	}
+
+	void SharedRegion::close()
+	{
+		if(mAddress)
+			munmap(mAddress, size_t(mSize));
+		if(mOwner)
+			shm_unlink(mName);
+		mAddress = NULL;
+		mSize = 0;
+		mOwner = false;
+	}
+
+#else
+
+	bool SharedRegion::create(const char*, PxU64)	{ return false;	}
+	bool SharedRegion::open(const char*)			{ return false;	}
+	void SharedRegion::makeReadOnly()				{}
+	void SharedRegion::close()						{}
+
+#endif
+}
+
+namespace physx
+{
+class SharedMeshStoreInternal : public Ps::UserAllocated
+{
+	PX_NOCOPY(SharedMeshStoreInternal)
+	public:
+							SharedMeshStoreInternal() : mHeader(NULL), mEntries(NULL)	{}
+
+		bool				publish(const char* regionName, const PxSharedMeshStoreEntry* entries, PxU32 nbEntries);
+		bool				open(const char* regionName);
+
+		PX_FORCE_INLINE	PxU32	getNbEntries()	const	{ return mHeader ? mHeader->nbEntries : 0;	}
+		PxU32				findEntry(const char* name)	const;
+		// returns the cooked data of the named entry if it has the expected type
+		const PxU8*			getData(const char* name, PxSharedMeshType::Enum type, PxU32& size)	const;
+
+		SharedRegion						mRegion;
+		const RegionHeader*					mHeader;
+		const RegionEntry*					mEntries;
+		Ps::HashMap<const char*, PxU32>		mIndices;	// keys point to the names in the region
+
+	private:
+		bool				buildIndices();
+};
+}
+
+bool SharedMeshStoreInternal::publish(const char* regionName, const PxSharedMeshStoreEntry* entries, PxU32 nbEntries)
+{
+	PX_CHECK_AND_RETURN_VAL(entries || !nbEntries, "PxSharedMeshStore: NULL entries.", false);
+
+	PxU64 totalSize = align16(sizeof(RegionHeader) + PxU64(nbEntries)*sizeof(RegionEntry));
+	{
+		Ps::HashSet<const char*> names;
+		for(PxU32 i=0;i<nbEntries;i++)
+		{
+			const PxSharedMeshStoreEntry& entry = entries[i];
+			if(!entry.name || !entry.name[0] || strlen(entry.name) > PxSharedMeshStore::eMAX_NAME_LENGTH || !entry.data || !entry.size
+				|| PxU32(entry.type) > PxU32(PxSharedMeshType::eHEIGHTFIELD))
+			{
+				Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "PxSharedMeshStore: invalid entry '%s'.", entry.name ? entry.name : "");
+				return false;
+			}
+			if(!names.insert(entry.name))
+			{
+				Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "PxSharedMeshStore: duplicate entry name '%s'.", entry.name);
+				return false;
+			}
+			totalSize = align16(totalSize + entry.size);
+		}
+	}
+
+	if(!mRegion.create(regionName, totalSize))
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxSharedMeshStore: failed to create shared-memory region '%s'.", regionName);
+		return false;
+	}
+
+	PxU8* base = reinterpret_cast<PxU8*>(mRegion.getAddress());
+	RegionHeader* header = reinterpret_cast<RegionHeader*>(base);
+	RegionEntry* regionEntries = reinterpret_cast<RegionEntry*>(header + 1);
+
+	PxMemZero(header, sizeof(RegionHeader) + nbEntries*sizeof(RegionEntry));
+	PxU64 offset = align16(sizeof(RegionHeader) + PxU64(nbEntries)*sizeof(RegionEntry));
+	for(PxU32 i=0;i<nbEntries;i++)
+	{
+		RegionEntry& dst = regionEntries[i];
+		Ps::strlcpy(dst.name, sizeof(dst.name), entries[i].name);
+		dst.offset	= offset;
+		dst.size	= entries[i].size;
+		dst.type	= PxU32(entries[i].type);
+		PxMemCopy(base + offset, entries[i].data, entries[i].size);
+		offset = align16(offset + entries[i].size);
+	}
+	header->version		= REGION_VERSION;
+	header->nbEntries	= nbEntries;
+	header->totalSize	= totalSize;
+
+	// publish: everything else must be visible before the magic
+	Ps::memoryBarrier();
+	header->magic		= REGION_MAGIC;
+
+	mRegion.makeReadOnly();
+
+	mHeader = header;
+	mEntries = regionEntries;
+	return buildIndices();
+}
+
+bool SharedMeshStoreInternal::open(const char* regionName)
+{
+	if(!mRegion.open(regionName))
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxSharedMeshStore: failed to open shared-memory region '%s'.", regionName);
+		return false;
+	}
+
+	const PxU8* base = reinterpret_cast<const PxU8*>(mRegion.getAddress());
+	const PxU64 mappedSize = mRegion.getSize();
+	const RegionHeader* header = reinterpret_cast<const RegionHeader*>(base);
+
+	bool valid = mappedSize >= sizeof(RegionHeader) && header->magic == REGION_MAGIC;
+	Ps::memoryBarrier();
+	valid = valid && header->version == REGION_VERSION && header->totalSize <= mappedSize
+		&& sizeof(RegionHeader) + PxU64(header->nbEntries)*sizeof(RegionEntry) <= header->totalSize;
+
+	const RegionEntry* entries = reinterpret_cast<const RegionEntry*>(header + 1);
+	for(PxU32 i=0; valid && i<header->nbEntries; i++)
+	{
+		const RegionEntry& entry = entries[i];
+		valid = entry.name[PxSharedMeshStore::eMAX_NAME_LENGTH] == 0 && !(entry.offset & 15)
+			&& entry.offset + entry.size <= header->totalSize && entry.type <= PxU32(PxSharedMeshType::eHEIGHTFIELD);
+	}
+
+	if(!valid)
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxSharedMeshStore: shared-memory region '%s' is invalid or not completely written.", regionName);
+		mRegion.close();
+		return false;
+	}
+
+	mHeader = header;
+	mEntries = entries;
+	return buildIndices();
+}
+
+bool SharedMeshStoreInternal::buildIndices()
+{
+	const PxU32 nbEntries = mHeader->nbEntries;
+	mIndices.reserve(nbEntries);
+	for(PxU32 i=0;i<nbEntries;i++)
+	{
+		if(!mIndices.insert(mEntries[i].name, i))
+		{
+			Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxSharedMeshStore: duplicate entry name '%s' in region.", mEntries[i].name);
+			mIndices.clear();
+			mHeader = NULL;
+			mEntries = NULL;
+			mRegion.close();
+			return false;
+		}
+	}
+	return true;
+}
+
+PxU32 SharedMeshStoreInternal::findEntry(const char* name) const
+{
+	const Ps::HashMap<const char*, PxU32>::Entry* e = name ? mIndices.find(name) : NULL;
+	return e ? e->second : 0xffffffff;
+}
+
+const PxU8* SharedMeshStoreInternal::getData(const char* name, PxSharedMeshType::Enum type, PxU32& size) const
+{
+	const PxU32 index = findEntry(name);
+	if(index == 0xffffffff || mEntries[index].type != PxU32(type))
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "PxSharedMeshStore: no entry '%s' of the requested type.", name ? name : "");
+		return NULL;
+	}
+	size = mEntries[index].size;
+	return reinterpret_cast<const PxU8*>(mHeader) + mEntries[index].offset;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PxSharedMeshStore::PxSharedMeshStore(const char* regionName, const PxSharedMeshStoreEntry* entries, PxU32 nbEntries) : mImpl(NULL)
+{
+	SharedMeshStoreInternal* impl = PX_NEW(SharedMeshStoreInternal);
+	if(impl->publish(regionName, entries, nbEntries))
+		mImpl = impl;
+	else
+		PX_DELETE(impl);
+}
+
+PxSharedMeshStore::PxSharedMeshStore(const char* regionName) : mImpl(NULL)
+{
+	SharedMeshStoreInternal* impl = PX_NEW(SharedMeshStoreInternal);
+	if(impl->open(regionName))
+		mImpl = impl;
+	else
+		PX_DELETE(impl);
+}
+
+PxSharedMeshStore::~PxSharedMeshStore()
+{
+	PX_DELETE(mImpl);
+}
+
+bool PxSharedMeshStore::isValid() const
+{
+	return mImpl != NULL;
+}
+
+PxU32 PxSharedMeshStore::getNbEntries() const
+{
+	return mImpl ? mImpl->getNbEntries() : 0;
+}
+
+bool PxSharedMeshStore::getEntry(PxU32 index, PxSharedMeshStoreEntry& entry) const
+{
+	if(index >= getNbEntries())
+		return false;
+
+	const RegionEntry& src = mImpl->mEntries[index];
+	entry.name	= src.name;
+	entry.type	= PxSharedMeshType::Enum(src.type);
+	entry.data	= reinterpret_cast<const PxU8*>(mImpl->mHeader) + src.offset;
+	entry.size	= src.size;
+	return true;
+}
+
+PxU32 PxSharedMeshStore::findEntry(const char* name) const
+{
+	return mImpl ? mImpl->findEntry(name) : 0xffffffff;
+}
+
+PxTriangleMesh* PxSharedMeshStore::createTriangleMesh(PxPhysics& physics, const char* name) const
+{
+	PX_CHECK_AND_RETURN_NULL(mImpl, "PxSharedMeshStore::createTriangleMesh: invalid store.");
+
+	PxU32 size;
+	const PxU8* data = mImpl->getData(name, PxSharedMeshType::eTRIANGLE_MESH, size);
+	return data ? physics.createTriangleMeshInPlace(data, size) : NULL;
+}
+
+PxConvexMesh* PxSharedMeshStore::createConvexMesh(PxPhysics& physics, const char* name) const
+{
+	PX_CHECK_AND_RETURN_NULL(mImpl, "PxSharedMeshStore::createConvexMesh: invalid store.");
+
+	PxU32 size;
+	const PxU8* data = mImpl->getData(name, PxSharedMeshType::eCONVEX_MESH, size);
+	if(!data)
+		return NULL;
+	PxDefaultMemoryInputData stream(const_cast<PxU8*>(data), size);
+	return physics.createConvexMesh(stream);
+}
+
+PxHeightField* PxSharedMeshStore::createHeightField(PxPhysics& physics, const char* name) const
+{
+	PX_CHECK_AND_RETURN_NULL(mImpl, "PxSharedMeshStore::createHeightField: invalid store.");
+
+	PxU32 size;
+	const PxU8* data = mImpl->getData(name, PxSharedMeshType::eHEIGHTFIELD, size);
+	if(!data)
+		return NULL;
+	PxDefaultMemoryInputData stream(const_cast<PxU8*>(data), size);
+	return physics.createHeightField(stream);
+}
@@ -226,4 +226,4 @@ const PxConstraintShaderTable* Ext::GetSphericalJointShaderTable()
 }
 
 //~PX_SERIALIZATION
-PxConstraintShaderTable Ext::SphericalJoint::sShaders = { Ext::SphericalJointSolverPrep, SphericalJointProject, SphericalJointVisualize, PxConstraintFlag::Enum(0) };
+PxConstraintShaderTable Ext::SphericalJoint::sShaders = { Ext::SphericalJointSolverPrep, SphericalJointProject, SphericalJointVisualize, PxConstraintFlag::Enum(0), Ext::SphericalJointSolverPrep4 };
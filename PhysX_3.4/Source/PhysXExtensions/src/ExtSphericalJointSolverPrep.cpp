@@ -30,6 +30,7 @@
 
 #include "ExtSphericalJoint.h"
 #include "ExtConstraintHelper.h"
+#include "ExtConstraintHelper4.h"
 #include "CmConeLimitHelper.h"
 #include "CmRenderOutput.h"
 
@@ -79,6 +80,48 @@ namespace Ext
 
 		return ch.getCount();
 	}
+
+	void SphericalJointSolverPrep4(Px1DConstraint* const* constraints,
+		PxU32* rowCounts,
+		PxVec3* body0WorldOffsets,
+		PxU32 maxConstraints,
+		PxConstraintInvMassScale* invMassScales,
+		const void* const* constantBlocks,
+		const PxTransform* bA2w,
+		const PxTransform* bB2w)
+	{
+		using namespace joint;
+
+		// the cone limit adds a row depending on the pose, so limited joints are prepped one by one
+		for(PxU32 a=0; a<4; a++)
+		{
+			const SphericalJointData& data = *reinterpret_cast<const SphericalJointData*>(constantBlocks[a]);
+			if(data.jointFlags & PxSphericalJointFlag::eLIMIT_ENABLED)
+			{
+				solverPrep4Scalar(SphericalJointSolverPrep, constraints, rowCounts, body0WorldOffsets, maxConstraints, invMassScales, constantBlocks, bA2w, bB2w);
+				return;
+			}
+		}
+
+		PxTransform cA2w[4], cB2w[4];
+		PxVec3 ra[4], rb[4];
+		for(PxU32 a=0; a<4; a++)
+		{
+			const SphericalJointData& data = *reinterpret_cast<const SphericalJointData*>(constantBlocks[a]);
+			invMassScales[a] = data.invMassScale;
+
+			cA2w[a] = bA2w[a] * data.c2b[0];
+			cB2w[a] = bB2w[a] * data.c2b[1];
+
+			body0WorldOffsets[a] = cB2w[a].p-bA2w[a].p;
+			ra[a] = cA2w[a].p - bA2w[a].p;
+			rb[a] = cB2w[a].p - bB2w[a].p;
+		}
+
+		const PxU32 count = prepareLockedAxes4(constraints, cA2w, cB2w, ra, rb, 7, 0);
+		for(PxU32 a=0; a<4; a++)
+			rowCounts[a] = count;
+	}
 }//namespace
 
 }
@@ -0,0 +1,139 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+
+#ifndef PX_PHYSICS_EXTENSIONS_NP_WORK_STEALING_DEQUE_H
+#define PX_PHYSICS_EXTENSIONS_NP_WORK_STEALING_DEQUE_H
+
+#include "task/PxTask.h"
+#include "CmPhysXCommon.h"
+#include "PsAtomic.h"
+#include "PsIntrinsics.h"
+#include "PsUserAllocated.h"
+
+namespace physx
+{
+
+#define EXT_WORK_STEALING_DEQUE_SIZE 1024	// must be a power of two
+
+namespace Ext
+{
+	/**
+	\brief Bounded lock-free Chase-Lev deque.
+
+	Only the owning worker thread may call push() and pop(), which operate on the bottom end.
+	Any other thread may call steal(), which takes from the top end. push() fails rather than
+	growing the buffer when the deque is full, in which case the caller falls back to the shared queue.
+	*/
+	class WorkStealingDeque
+	{
+		PX_NOCOPY(WorkStealingDeque)
+	public:
+		WorkStealingDeque() : mTop(0), mBottom(0)
+		{
+			for(PxU32 i = 0; i < EXT_WORK_STEALING_DEQUE_SIZE; ++i)
+				mTasks[i] = NULL;
+		}
+
+		// owner thread only
+		bool push(PxBaseTask& task)
+		{
+			const PxU32 b = PxU32(mBottom);
+			const PxU32 t = PxU32(mTop);
+			if(b - t >= EXT_WORK_STEALING_DEQUE_SIZE)
+				return false;
+
+			mTasks[b & (EXT_WORK_STEALING_DEQUE_SIZE - 1)] = &task;
+			// the task pointer must be visible before thieves can observe the new bottom
+			Ps::memoryBarrier();
+			mBottom = PxI32(b + 1);
+			return true;
+		}
+
+		// owner thread only
+		PxBaseTask* pop()
+		{
+			const PxU32 b = PxU32(mBottom) - 1;
+			Ps::atomicExchange(&mBottom, PxI32(b));	// full barrier, the store must be ordered before the load of mTop
+			const PxU32 t = PxU32(mTop);
+
+			// indices are free running and may wrap, so compare through the signed distance
+			const PxI32 count = PxI32(b - t);
+			if(count < 0)
+			{
+				// deque was empty
+				mBottom = PxI32(t);
+				return NULL;
+			}
+
+			PxBaseTask* task = mTasks[b & (EXT_WORK_STEALING_DEQUE_SIZE - 1)];
+			if(count == 0)
+			{
+				// last element, race against thieves for it
+				if(Ps::atomicCompareExchange(&mTop, PxI32(t + 1), PxI32(t)) != PxI32(t))
+					task = NULL;
+				mBottom = PxI32(t + 1);
+			}
+			return task;
+		}
+
+		// any thread
+		PxBaseTask* steal()
+		{
+			const PxU32 t = PxU32(mTop);
+			Ps::memoryBarrier();
+			const PxU32 b = PxU32(mBottom);
+
+			if(PxI32(b - t) <= 0)
+				return NULL;
+
+			PxBaseTask* task = mTasks[t & (EXT_WORK_STEALING_DEQUE_SIZE - 1)];
+			if(Ps::atomicCompareExchange(&mTop, PxI32(t + 1), PxI32(t)) != PxI32(t))
+				return NULL;	// lost the race against another thief or the owner
+
+			return task;
+		}
+
+		PX_FORCE_INLINE bool isEmpty() const { return PxI32(PxU32(mBottom) - PxU32(mTop)) <= 0; }
+
+	private:
+		// top and bottom are written by different threads, keep them on separate cache lines
+		volatile PxI32				mTop;
+		PxU8						mPad0[64 - sizeof(PxI32)];
+		volatile PxI32				mBottom;
+		PxU8						mPad1[64 - sizeof(PxI32)];
+		PxBaseTask* volatile		mTasks[EXT_WORK_STEALING_DEQUE_SIZE];
+	};
+
+} // namespace Ext
+
+}
+
+#endif
@@ -0,0 +1,147 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#include "extensions/PxSerialization.h"
+#include "extensions/PxCollectionExt.h"
+#include "foundation/PxIO.h"
+#include "PsFoundation.h"
+#include "SnBinaryDeserializer.h"
+
+using namespace physx;
+using namespace Sn;
+
+namespace
+{
+	class BinaryCollectionLoader : public PxBinaryCollectionLoader, public Ps::UserAllocated
+	{
+		PX_NOCOPY(BinaryCollectionLoader)
+	public:
+		BinaryCollectionLoader(PxInputStream& stream, PxU32 size, void* memBlock, PxSerializationRegistry& sr, const PxCollection* externalRefs)
+		: mDeserializer(sr, externalRefs)
+		, mStream(stream)
+		, mMemBlock(reinterpret_cast<PxU8*>(memBlock))
+		, mSize(size)
+		, mNbReadBytes(0)
+		, mCollection(NULL)
+		, mStatus(Status::eREADING)
+		{
+		}
+
+		virtual Status::Enum update(PxU32 maxBytes, PxU32 maxObjects)
+		{
+			if(mStatus == Status::eREADING)
+			{
+				const PxU32 nbBytes = PxMin(maxBytes, mSize - mNbReadBytes);
+				if(nbBytes)
+				{
+					const PxU32 nbReadBytes = mStream.read(mMemBlock + mNbReadBytes, nbBytes);
+					mNbReadBytes += nbReadBytes;
+					if(nbReadBytes < nbBytes)
+					{
+						Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, 
+							"PxBinaryCollectionLoader::update: the stream ended after %d of %d bytes.", mNbReadBytes, mSize);
+						mStatus = Status::eFAILED;
+						return mStatus;
+					}
+				}
+				if(mNbReadBytes < mSize)
+					return mStatus;
+
+				if(!mDeserializer.readTables(mMemBlock))
+				{
+					mStatus = Status::eFAILED;
+					return mStatus;
+				}
+				mStatus = Status::eCREATING_OBJECTS;
+			}
+
+			if(mStatus == Status::eCREATING_OBJECTS)
+			{
+				if(!mDeserializer.createObjects(maxObjects))
+				{
+					mStatus = Status::eFAILED;
+					return mStatus;
+				}
+				if(mDeserializer.isComplete())
+				{
+					mCollection = mDeserializer.finish();
+					mStatus = Status::eDONE;
+				}
+			}
+			return mStatus;
+		}
+
+		virtual Status::Enum getStatus() const
+		{
+			return mStatus;
+		}
+
+		virtual PxCollection* getCollection()
+		{
+			PxCollection* collection = mCollection;
+			mCollection = NULL;
+			return collection;
+		}
+
+		virtual void release()
+		{
+			if(mStatus == Status::eCREATING_OBJECTS && mDeserializer.createObjects(PX_MAX_U32))
+			{
+				mCollection = mDeserializer.finish();
+				mStatus = Status::eDONE;
+			}
+
+			// a collection the application did not take is released with its objects, as for an abandoned load
+			if(mCollection)
+			{
+				PxCollectionExt::releaseObjects(*mCollection);
+				mCollection->release();
+			}
+			delete this;
+		}
+
+	private:
+		BinaryDeserializer		mDeserializer;
+		PxInputStream&			mStream;
+		PxU8*					mMemBlock;
+		const PxU32				mSize;
+		PxU32					mNbReadBytes;
+		PxCollection*			mCollection;
+		Status::Enum			mStatus;
+	};
+}
+
+PxBinaryCollectionLoader* PxSerialization::createBinaryCollectionLoader(PxInputStream& stream, PxU32 size, void* memBlock, PxSerializationRegistry& sr, const PxCollection* externalRefs)
+{
+	if(size_t(memBlock) & (PX_SERIAL_FILE_ALIGN-1))
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "PxSerialization::createBinaryCollectionLoader: memory block must be 128-bytes aligned.");
+		return NULL;
+	}
+	return PX_NEW(BinaryCollectionLoader)(stream, size, memBlock, sr, externalRefs);
+}
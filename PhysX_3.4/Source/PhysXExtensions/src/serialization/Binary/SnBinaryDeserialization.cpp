@@ -37,10 +37,12 @@
 #include "PxPhysics.h"
 #include "PxPhysicsSerialization.h"
 #include "SnSerializationContext.h"
+#include "SnBinaryDeserializer.h"
 #include "PxSerializer.h"
 #include "serialization/SnSerializationRegistry.h"
 #include "serialization/SnSerialUtils.h"
 #include "CmCollection.h"
+#include "CmTask.h"
 #include "SnConvX_Align.h"
 
 using namespace physx;
@@ -65,15 +67,15 @@ namespace
 		return value;
 	}
 
-	bool readHeader(PxU8*& address, PxU32& version)
+	bool readHeader(PxU8*& address, PxU32& version, PxU32& binaryVersion)
 	{
 		const PxU32 header = read32(address);
 		PX_UNUSED(header);
 		
 		version = read32(address);
 
-		const PxU32 binaryVersion = read32(address);
-		PX_UNUSED(binaryVersion);		
+		binaryVersion = read32(address);
+
 		const PxU32 buildNumber = read32(address);
 		PX_UNUSED(buildNumber);
 		const PxU32 platformTag = read32(address);
@@ -144,68 +146,187 @@ namespace
 		}
 		return true;
 	}
-	
+
+	// Creates the objects of one level of the object layout table, in ranges of consecutive objects of that level.
+	class CreateObjectsJob
+	{
+		PX_NOCOPY(CreateObjectsJob)
+	public:
+		static const PxU32 RANGE_SIZE = 256;
+
+		CreateObjectsJob(const SerializationRegistry& sr, const ManifestEntry* manifestTable, const ImportReference* importReferences, 
+						 PxU8* objectData, const InternalRefMap& internalReferencesMap, const Cm::Collection* externalRefs,
+						 PxU8* extraData, PxU32 version, const ObjectLayoutEntry* objectLayout, const PxU32* objects, PxU32 nbObjects)
+		: mSr(sr), mManifestTable(manifestTable), mImportReferences(importReferences), mObjectData(objectData)
+		, mInternalReferencesMap(internalReferencesMap), mExternalRefs(externalRefs), mExtraData(extraData), mVersion(version)
+		, mObjectLayout(objectLayout), mObjects(objects), mNbObjects(nbObjects), mFailedType(0)
+		{
+		}
+
+		PxU32 getNbRanges() const { return (mNbObjects + RANGE_SIZE - 1)/RANGE_SIZE; }
+
+		// concrete type of an object that could not be created, 0 if none failed
+		PxI32 getFailedType() const { return mFailedType; }
+
+		void operator()(PxU32 range)
+		{
+			DeserializationContext context(mManifestTable, mImportReferences, mObjectData, mInternalReferencesMap, mExternalRefs, mExtraData, mVersion);
+
+			const PxU32 last = PxMin(mNbObjects, (range+1)*RANGE_SIZE);
+			for(PxU32 i=range*RANGE_SIZE;i<last;i++)
+			{
+				const PxU32 index = mObjects[i];
+				PxU8* address = mObjectData + mManifestTable[index].offset;
+				context.setExtraDataAddress(mExtraData + mObjectLayout[index].extraDataOffset);
+
+				const PxType classType = reinterpret_cast<PxBase*>(address)->getConcreteType();
+				const PxSerializer* serializer = mSr.getSerializer(classType);
+				PX_ASSERT(serializer);
+
+				PxU8* objectAddress = address;
+				if(serializer->createObject(address, context) != reinterpret_cast<PxBase*>(objectAddress))
+					mFailedType = PxI32(classType);
+			}
+		}
+
+	private:
+		const SerializationRegistry&	mSr;
+		const ManifestEntry*			mManifestTable;
+		const ImportReference*			mImportReferences;
+		PxU8*							mObjectData;
+		const InternalRefMap&			mInternalReferencesMap;
+		const Cm::Collection*			mExternalRefs;
+		PxU8*							mExtraData;
+		const PxU32						mVersion;
+		const ObjectLayoutEntry*		mObjectLayout;
+		const PxU32*					mObjects;
+		const PxU32						mNbObjects;
+		volatile PxI32					mFailedType;
+	};
+
+	// Creates the objects level by level, the objects of a level in parallel. Returns false if an object could not be created.
+	bool createObjectsParallel(PxCpuDispatcher& dispatcher, const SerializationRegistry& sr, const ManifestEntry* manifestTable, 
+							   const ImportReference* importReferences, PxU8* objectData, const InternalRefMap& internalReferencesMap, 
+							   PxU8* extraData, PxU32 version, const ObjectLayoutEntry* objectLayout, PxU32 nbObjects)
+	{
+		// sort the objects by level, keeping the manifest order within a level
+		PxU32 nbLevels = 0;
+		for(PxU32 i=0;i<nbObjects;i++)
+			nbLevels = PxMax(nbLevels, objectLayout[i].level + 1);
+
+		Ps::Array<PxU32> levelStarts(nbLevels + 1, 0);
+		for(PxU32 i=0;i<nbObjects;i++)
+			levelStarts[objectLayout[i].level + 1]++;
+		for(PxU32 i=0;i<nbLevels;i++)
+			levelStarts[i+1] += levelStarts[i];
+
+		Ps::Array<PxU32> objects(nbObjects);
+		{
+			Ps::Array<PxU32> nextSlot(levelStarts);
+			for(PxU32 i=0;i<nbObjects;i++)
+				objects[nextSlot[objectLayout[i].level]++] = i;
+		}
+
+		for(PxU32 level=0;level<nbLevels;level++)
+		{
+			const PxU32 start = levelStarts[level];
+			CreateObjectsJob job(sr, manifestTable, importReferences, objectData, internalReferencesMap, NULL, extraData, version, 
+								 objectLayout, objects.begin() + start, levelStarts[level+1] - start);
+			Cm::runParallelJobs(&dispatcher, job.getNbRanges(), job);
+
+			if(job.getFailedType())
+			{
+				Ps::getFoundation().error(physx::PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, 
+					"Cannot create class instance for concrete type %d.", job.getFailedType());
+				return false;
+			}
+		}
+		return true;
+	}
 }
 
-PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* pxExternalRefs)
+namespace physx { namespace Sn {
+
+BinaryDeserializer::BinaryDeserializer(PxSerializationRegistry& sr, const PxCollection* externalRefs) 
+: mSr(static_cast<SerializationRegistry&>(sr))
+, mExternalRefs(static_cast<const Cm::Collection*>(externalRefs))
+, mCollection(NULL)
+, mContext(NULL)
+, mAddress(NULL)
+, mObjectData(NULL)
+, mExtraData(NULL)
+, mManifestTable(NULL)
+, mImportReferences(NULL)
+, mExportReferences(NULL)
+, mObjectLayout(NULL)
+, mVersion(0)
+, mNbObjects(0)
+, mNbCreatedObjects(0)
+, mNbImportReferences(0)
+, mNbExportReferences(0)
+{
+}
+
+BinaryDeserializer::~BinaryDeserializer()
 {
+	PX_DELETE(mContext);
+	if(mCollection)
+		mCollection->release();
+}
+
+bool BinaryDeserializer::readTables(void* memBlock)
+{
+	PX_ASSERT(!mCollection);
 #if PX_CHECKED
 	if(size_t(memBlock) & (PX_SERIAL_FILE_ALIGN-1))
 	{
 		Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "Buffer must be 128-bytes aligned.");
-		return NULL;
+		return false;
 	}
 #endif
 	PxU8* address = reinterpret_cast<PxU8*>(memBlock);
-	const Cm::Collection* externalRefs = static_cast<const Cm::Collection*>(pxExternalRefs);
 			
-	PxU32 version;
-	if (!readHeader(address, version))
+	PxU32 binaryVersion;
+	if (!readHeader(address, mVersion, binaryVersion))
 	{
-		return NULL;
+		return false;
 	}
 
-	ManifestEntry* manifestTable;
-	PxU32 nbObjectsInCollection;
 	PxU32 objectDataEndOffset;
 
 	// read number of objects in collection
 	address = alignPtr(address);
-	nbObjectsInCollection = read32(address);
+	mNbObjects = read32(address);
 
 	// read manifest (PxU32 offset, PxConcreteType type)
 	{
 		address = alignPtr(address);
 		PxU32 nbManifestEntries = read32(address);
 		PX_ASSERT(*reinterpret_cast<PxU32*>(address) == 0); //first offset is always 0
-		manifestTable = (nbManifestEntries > 0) ? reinterpret_cast<ManifestEntry*>(address) : NULL;
+		mManifestTable = (nbManifestEntries > 0) ? reinterpret_cast<ManifestEntry*>(address) : NULL;
 		address += nbManifestEntries*sizeof(ManifestEntry);
 		objectDataEndOffset = read32(address);
 	}
 
-	ImportReference* importReferences;
-	PxU32 nbImportReferences;
 	// read import references
 	{
 		address = alignPtr(address);
-		nbImportReferences = read32(address);
-		importReferences = (nbImportReferences > 0) ? reinterpret_cast<ImportReference*>(address) : NULL;
-		address += nbImportReferences*sizeof(ImportReference);
+		mNbImportReferences = read32(address);
+		mImportReferences = (mNbImportReferences > 0) ? reinterpret_cast<ImportReference*>(address) : NULL;
+		address += mNbImportReferences*sizeof(ImportReference);
 	}
 
-	if (!checkImportReferences(importReferences, nbImportReferences, externalRefs))
+	if (!checkImportReferences(mImportReferences, mNbImportReferences, mExternalRefs))
 	{
-		return NULL;
+		return false;
 	}
 
-	ExportReference* exportReferences;
-	PxU32 nbExportReferences;
 	// read export references
 	{
 		address = alignPtr(address);
-		nbExportReferences = read32(address);
-		exportReferences = (nbExportReferences > 0) ? reinterpret_cast<ExportReference*>(address) : NULL;
-		address += nbExportReferences*sizeof(ExportReference);
+		mNbExportReferences = read32(address);
+		mExportReferences = (mNbExportReferences > 0) ? reinterpret_cast<ExportReference*>(address) : NULL;
+		address += mNbExportReferences*sizeof(ExportReference);
 	}
 
 	// read internal references arrays
@@ -229,77 +350,136 @@ PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSeri
 	PxF32 loadFactor = 0.75f;
 	PxF32 _loadFactor = 1.0f / loadFactor;
 	PxU32 hashSize = PxU32((nbInternalPtrReferences + nbInternalIdxReferences + 1)*_loadFactor);
-	InternalRefMap internalReferencesMap(hashSize, loadFactor);
+	mInternalReferencesMap.reserve(hashSize);
 	{
 		//create hash (we should load the hashes directly from memory)
 		for (PxU32 i=0;i<nbInternalPtrReferences;i++)
 		{
 			const InternalReferencePtr& ref = internalPtrReferences[i];
-			internalReferencesMap.insertUnique( InternalRefKey(ref.reference, ref.kind), SerialObjectIndex(ref.objIndex));
+			mInternalReferencesMap.insertUnique( InternalRefKey(ref.reference, ref.kind), SerialObjectIndex(ref.objIndex));
 		}
 		for (PxU32 i=0;i<nbInternalIdxReferences;i++)
 		{
 			const InternalReferenceIdx& ref = internalIdxReferences[i];
-			internalReferencesMap.insertUnique(InternalRefKey(ref.reference, ref.kind), SerialObjectIndex(ref.objIndex));
+			mInternalReferencesMap.insertUnique(InternalRefKey(ref.reference, ref.kind), SerialObjectIndex(ref.objIndex));
 		}
 	}
 
-	SerializationRegistry& sn = static_cast<SerializationRegistry&>(sr);
-	Cm::Collection* collection = static_cast<Cm::Collection*>(PxCreateCollection());
-	PX_ASSERT(collection);
-	collection->mObjects.reserve(PxU32(nbObjectsInCollection*_loadFactor) + 1);
-	if(nbExportReferences > 0)
-	    collection->mIds.reserve(PxU32(nbExportReferences*_loadFactor) + 1);
+	mCollection = static_cast<Cm::Collection*>(PxCreateCollection());
+	PX_ASSERT(mCollection);
+	mCollection->mObjects.reserve(PxU32(mNbObjects*_loadFactor) + 1);
+	if(mNbExportReferences > 0)
+	    mCollection->mIds.reserve(PxU32(mNbExportReferences*_loadFactor) + 1);
 
-	PxU8* addressObjectData = alignPtr(address);
-	PxU8* addressExtraData = alignPtr(addressObjectData + objectDataEndOffset);
+	mObjectData = alignPtr(address);
+	mExtraData = alignPtr(mObjectData + objectDataEndOffset);
 
-	DeserializationContext context(manifestTable, importReferences, addressObjectData, internalReferencesMap, externalRefs, addressExtraData, version);
-	
-	// iterate over memory containing PxBase objects, create the instances, resolve the addresses, import the external data, add to collection.
+	// read object layout table
+	if(binaryVersion >= SN_BINARY_VERSION_OBJECT_LAYOUT)
 	{
-		PxU32 nbObjects = nbObjectsInCollection;
+		PxU8* addressObjectLayout = mExtraData;
+		const PxU32 nbObjectLayoutEntries = read32(addressObjectLayout);
+		PX_ASSERT(nbObjectLayoutEntries == 0 || nbObjectLayoutEntries == mNbObjects);
+		mObjectLayout = (nbObjectLayoutEntries > 0) ? reinterpret_cast<ObjectLayoutEntry*>(addressObjectLayout) : NULL;
+		mExtraData = alignPtr(addressObjectLayout + nbObjectLayoutEntries*sizeof(ObjectLayoutEntry));
+	}
 
-		while(nbObjects--)
-		{
-			address = alignPtr(address);
-			context.alignExtraData();
+	mContext = PX_NEW(DeserializationContext)(mManifestTable, mImportReferences, mObjectData, mInternalReferencesMap, mExternalRefs, mExtraData, mVersion);
+	mAddress = mObjectData;
+	return true;
+}
 
-			// read PxBase header with type and get corresponding serializer.
-			PxBase* header = reinterpret_cast<PxBase*>(address);
-			const PxType classType = header->getConcreteType();
-			const PxSerializer* serializer = sn.getSerializer(classType);
-			PX_ASSERT(serializer);
+bool BinaryDeserializer::createObjects(PxU32 maxObjects)
+{
+	PX_ASSERT(mContext);
 
-			PxBase* instance = serializer->createObject(address, context);
-			if (!instance)
-			{
-				Ps::getFoundation().error(physx::PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, 
-					"Cannot create class instance for concrete type %d.", classType);
-				collection->release();
-				return NULL;
-			}
+	// iterate over memory containing PxBase objects, create the instances, resolve the addresses, import the external data, add to collection.
+	const PxU32 nbObjects = PxMin(maxObjects, mNbObjects - mNbCreatedObjects);
+	for(PxU32 i=0;i<nbObjects;i++)
+	{
+		mAddress = alignPtr(mAddress);
+		mContext->alignExtraData();
 
-			collection->internalAdd(instance);
+		// read PxBase header with type and get corresponding serializer.
+		PxBase* header = reinterpret_cast<PxBase*>(mAddress);
+		const PxType classType = header->getConcreteType();
+		const PxSerializer* serializer = mSr.getSerializer(classType);
+		PX_ASSERT(serializer);
+
+		PxBase* instance = serializer->createObject(mAddress, *mContext);
+		if (!instance)
+		{
+			Ps::getFoundation().error(physx::PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, 
+				"Cannot create class instance for concrete type %d.", classType);
+			return false;
 		}
+
+		mCollection->internalAdd(instance);
+		mNbCreatedObjects++;
 	}
+	return true;
+}
 
-	PX_ASSERT(nbObjectsInCollection == collection->internalGetNbObjects());
+bool BinaryDeserializer::createObjects(PxCpuDispatcher& dispatcher)
+{
+	PX_ASSERT(mContext && !mNbCreatedObjects);
+
+	// objects may update the external objects they reference, so only collections without import references are created in parallel
+	if(!mObjectLayout || mNbImportReferences)
+		return createObjects(mNbObjects);
+
+	// create the instances level by level, then add them to the collection in manifest order
+	if(!createObjectsParallel(dispatcher, mSr, mManifestTable, mImportReferences, mObjectData, mInternalReferencesMap, mExtraData, 
+							  mVersion, mObjectLayout, mNbObjects))
+		return false;
+
+	for(PxU32 i=0;i<mNbObjects;i++)
+		mCollection->internalAdd(reinterpret_cast<PxBase*>(mObjectData + mManifestTable[i].offset));
+	mNbCreatedObjects = mNbObjects;
+	return true;
+}
+
+PxCollection* BinaryDeserializer::finish()
+{
+	PX_ASSERT(mNbCreatedObjects == mNbObjects);
+	PX_ASSERT(mNbObjects == mCollection->internalGetNbObjects());
 	
 	// update new collection with export references
 	{
-		PX_ASSERT(addressObjectData != NULL);
-		for (PxU32 i=0;i<nbExportReferences;i++)
+		PX_ASSERT(mObjectData != NULL);
+		for (PxU32 i=0;i<mNbExportReferences;i++)
 		{
 			bool isExternal;
-			PxU32 manifestIndex = exportReferences[i].objIndex.getIndex(isExternal);
+			PxU32 manifestIndex = mExportReferences[i].objIndex.getIndex(isExternal);
 			PX_ASSERT(!isExternal);
-			PxBase* obj = reinterpret_cast<PxBase*>(addressObjectData + manifestTable[manifestIndex].offset);
-			collection->mIds.insertUnique(exportReferences[i].id, obj);
-			collection->mObjects[obj] = exportReferences[i].id;
+			PxBase* obj = reinterpret_cast<PxBase*>(mObjectData + mManifestTable[manifestIndex].offset);
+			mCollection->mIds.insertUnique(mExportReferences[i].id, obj);
+			mCollection->mObjects[obj] = mExportReferences[i].id;
 		}
 	}
 
-	PxAddCollectionToPhysics(*collection);
+	PxAddCollectionToPhysics(*mCollection);
+
+	PxCollection* collection = mCollection;
+	mCollection = NULL;
 	return collection;
 }
+
+} // namespace Sn
+} // namespace physx
+
+PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* pxExternalRefs)
+{
+	BinaryDeserializer deserializer(sr, pxExternalRefs);
+	if(!deserializer.readTables(memBlock) || !deserializer.createObjects(PX_MAX_U32))
+		return NULL;
+	return deserializer.finish();
+}
+
+PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, PxCpuDispatcher& dispatcher, const PxCollection* pxExternalRefs)
+{
+	BinaryDeserializer deserializer(sr, pxExternalRefs);
+	if(!deserializer.readTables(memBlock) || !deserializer.createObjects(dispatcher))
+		return NULL;
+	return deserializer.finish();
+}
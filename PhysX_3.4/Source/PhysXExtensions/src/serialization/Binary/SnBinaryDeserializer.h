@@ -0,0 +1,91 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#ifndef PX_PHYSICS_SN_BINARY_DESERIALIZER
+#define PX_PHYSICS_SN_BINARY_DESERIALIZER
+
+#include "SnSerializationContext.h"
+
+namespace physx
+{
+	class PxSerializationRegistry;
+	class PxCpuDispatcher;
+
+	namespace Sn
+	{
+		class SerializationRegistry;
+
+		// Creates a collection from a binary serialized memory block in steps, so that the object creation can be
+		// spread over several calls. readTables() must succeed before the objects are created, and finish() is called
+		// once all of them are. The collection is released if the deserializer is destroyed before finish().
+		class BinaryDeserializer : public Ps::UserAllocated
+		{
+			PX_NOCOPY(BinaryDeserializer)
+		public:
+							BinaryDeserializer(PxSerializationRegistry& sr, const PxCollection* externalRefs);
+							~BinaryDeserializer();
+
+			// reads the header and the reference tables, and creates the collection
+			bool			readTables(void* memBlock);
+
+			// creates up to maxObjects more objects, in manifest order
+			bool			createObjects(PxU32 maxObjects);
+
+			// creates all the objects, in parallel when the data has an object layout table
+			bool			createObjects(PxCpuDispatcher& dispatcher);
+
+			// adds the ids and the objects to the physics, and returns the collection
+			PxCollection*	finish();
+
+			PxU32			getNbObjects()			const	{ return mNbObjects;					}
+			PxU32			getNbCreatedObjects()	const	{ return mNbCreatedObjects;				}
+			bool			isComplete()			const	{ return mNbCreatedObjects == mNbObjects;	}
+
+		private:
+			SerializationRegistry&		mSr;
+			const Cm::Collection*		mExternalRefs;
+			Cm::Collection*				mCollection;
+			InternalRefMap				mInternalReferencesMap;
+			DeserializationContext*		mContext;
+			PxU8*						mAddress;
+			PxU8*						mObjectData;
+			PxU8*						mExtraData;
+			const ManifestEntry*		mManifestTable;
+			const ImportReference*		mImportReferences;
+			ExportReference*			mExportReferences;
+			const ObjectLayoutEntry*	mObjectLayout;
+			PxU32						mVersion;
+			PxU32						mNbObjects;
+			PxU32						mNbCreatedObjects;
+			PxU32						mNbImportReferences;
+			PxU32						mNbExportReferences;
+		};
+	} // namespace Sn
+}
+
+#endif
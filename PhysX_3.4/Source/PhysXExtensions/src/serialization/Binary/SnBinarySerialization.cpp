@@ -61,6 +61,7 @@ using namespace Sn;
 //// export references
 //// internal references
 //// object data
+//// object layout table
 //// extra data
 //------------------------------------------------------------------------------------
 //
@@ -138,6 +139,17 @@ using namespace Sn;
 // .
 // 
 //
+//------------------------------------------------------------------------------------
+//// object layout table:
+//// one entry per object, in manifest order, or none for converted collections
+//// extra data offsets relative to the extra data memory block
+//// levels give the depth of the object in the graph of required objects
+//------------------------------------------------------------------------------------
+// alignment
+// PxU32 size
+// (PxU32 extraDataOffset, PxU32 level)*size
+//
+//
 // -----------------------------------------------------------------------------------
 //// extra data:
 //// extra data memory block
@@ -199,6 +211,79 @@ namespace
 		bool mExportNames;
 	};
 
+	// Measures the extra data of the objects without writing it, to fill the object layout table ahead of the extra data.
+	// The stored size starts at the file offset of the extra data, so that alignments match the ones of the actual stream.
+	class SizeCountingStream : public PxSerializationContext
+	{
+	public:
+		SizeCountingStream(PxU32 startOffset, const PxCollection& collection, bool exportNames) : mSize(startOffset), mCollection(collection), mExportNames(exportNames) {}
+		void		writeData(const void*, PxU32 size)				{		mSize += size;	}
+		PxU32		getTotalStoredSize()							{		return mSize;	}
+		void		alignData(PxU32 alignment)						{		if(alignment) mSize += getPadding(mSize, alignment);	}
+
+		virtual void			registerReference(PxBase&, PxU32, size_t)
+		{
+			Ps::getFoundation().error(physx::PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, 
+					"Cannot register references during exportData, exportExtraData.");
+		}
+
+		virtual const PxCollection& getCollection() const
+		{
+			return mCollection;
+		}
+		virtual void writeName(const char* name)
+		{
+			PxU32 len = name && mExportNames ? PxU32(strlen(name)) + 1 : 0;
+			mSize += sizeof(len) + len;
+		}
+
+	private:
+		SizeCountingStream& operator=(const SizeCountingStream&);
+		PxU32 mSize;
+		const PxCollection& mCollection;
+		bool mExportNames;
+	};
+
+	// Computes the level of each object of a sorted collection, from the levels of the objects it requires. Required objects
+	// precede the objects requiring them, except within cycles, which are ignored.
+	class LevelCollector : public PxProcessPxBaseCallback
+	{
+	public:
+		LevelCollector(const Collection& collection, const SerializationRegistry& sr) : mCollection(collection), mSr(sr) {}
+		virtual ~LevelCollector() {}
+
+		void computeLevels(ObjectLayoutEntry* entries)
+		{
+			const PxU32 nb = mCollection.internalGetNbObjects();
+			for(PxU32 i=0;i<nb;i++)
+				mIndices.insert(mCollection.internalGetObject(i), i);
+
+			mEntries = entries;
+			for(PxU32 i=0;i<nb;i++)
+			{
+				PxBase* s = mCollection.internalGetObject(i);
+				mCurrent = i;
+				mEntries[i].level = 0;
+				mSr.getSerializer(s->getConcreteType())->requiresObjects(*s, *this);
+			}
+		}
+
+		virtual void process(PxBase& base)
+		{
+			const Ps::HashMap<const PxBase*, PxU32>::Entry* entry = mIndices.find(&base);
+			if(entry && entry->second < mCurrent)
+				mEntries[mCurrent].level = PxMax(mEntries[mCurrent].level, mEntries[entry->second].level + 1);
+		}
+
+	private:
+		LevelCollector& operator=(const LevelCollector&);
+		const Collection&						mCollection;
+		const SerializationRegistry&			mSr;
+		Ps::HashMap<const PxBase*, PxU32>		mIndices;
+		ObjectLayoutEntry*						mEntries;
+		PxU32									mCurrent;
+	};
+
 	void writeHeader(PxSerializationContext& stream, bool hasDeserializedAssets)
 	{
 		PX_UNUSED(hasDeserializedAssets);
@@ -382,9 +467,33 @@ bool PxSerialization::serializeCollectionToBinary(PxOutputStream& outputStream,
 		}
 	}
 
+	// write object layout table
+	const PxU32 nb = collection.internalGetNbObjects();
+	Ps::Array<ObjectLayoutEntry> objectLayout(nb);
+	PxU32 extraDataStart;
+	{
+		stream.alignData(PX_SERIAL_ALIGN);
+		extraDataStart = stream.getTotalStoredSize() + PxU32(sizeof(PxU32) + nb*sizeof(ObjectLayoutEntry));
+		extraDataStart += getPadding(extraDataStart, PX_SERIAL_ALIGN);
+
+		LevelCollector levels(collection, sn);
+		levels.computeLevels(objectLayout.begin());
+
+		SizeCountingStream counter(extraDataStart, collection, exportNames);
+		for(PxU32 i=0;i<nb;i++)
+		{
+			PxBase* s = collection.internalGetObject(i);
+			counter.alignData(PX_SERIAL_ALIGN);
+			objectLayout[i].extraDataOffset = counter.getTotalStoredSize() - extraDataStart;
+			sn.getSerializer(s->getConcreteType())->exportExtraData(*s, counter);
+		}
+
+		stream.writeData(&nb, sizeof(PxU32));
+		stream.writeData(objectLayout.begin(), nb*sizeof(ObjectLayoutEntry));
+	}
+
 	// write extra data
 	{
-		const PxU32 nb = collection.internalGetNbObjects();
 		for(PxU32 i=0;i<nb;i++)
 		{
 			PxBase* s = collection.internalGetObject(i);
@@ -394,9 +503,11 @@ bool PxSerialization::serializeCollectionToBinary(PxOutputStream& outputStream,
 			PX_ASSERT(serializer);
 
 			stream.alignData(PX_SERIAL_ALIGN);
+			PX_ASSERT(stream.getTotalStoredSize() == extraDataStart + objectLayout[i].extraDataOffset);
 			serializer->exportExtraData(*s, stream);
 		}
 	}
+	PX_UNUSED(extraDataStart);
 
 	return true;
 }
@@ -48,12 +48,15 @@
 #include "serialization/SnSerializationRegistry.h"
 #include <assert.h>
 #include "PsFoundation.h"
+#include "PsAtomic.h"
+#include "CmTask.h"
 
 using namespace physx;
 
 Sn::ConvX::ConvX() :
     mMetaData_Src		(NULL),
 	mMetaData_Dst		(NULL),
+	mSharedMetaData		(false),
 	mOutStream			(NULL),
 	mMustFlip			(false),
 	mOutputSize			(0),
@@ -164,3 +167,83 @@ bool Sn::ConvX::convert(PxInputStream& srcStream, PxU32 srcSize, PxOutputStream&
 	}
 	return conversionStatus;
 }
+
+void Sn::ConvX::shareMetaData(const ConvX& owner)
+{
+	releaseMetaData();
+	resetUnions();
+
+	// Meta data and unions are only read once loaded, so converters running on other threads can use them as well.
+	// The union entries point into the owner's meta data string table.
+	mMetaData_Src = owner.mMetaData_Src;
+	mMetaData_Dst = owner.mMetaData_Dst;
+	mSharedMetaData = true;
+	mUnions = owner.mUnions;
+	mReportMode = owner.mReportMode;
+}
+
+namespace
+{
+	// One job per converter: each converter pulls items until there are none left, so large
+	// and small collections balance out. A converter is only ever used by the job owning it.
+	class ConvertBatchJob
+	{
+		PX_NOCOPY(ConvertBatchJob)
+	public:
+		ConvertBatchJob(Sn::ConvX** converters, PxBinaryConverterBatchItem* items, PxU32 nbItems) :
+			mConverters(converters), mItems(items), mNbItems(PxI32(nbItems)), mNextItem(0)	{}
+
+		void operator()(PxU32 converterIndex)
+		{
+			Sn::ConvX& converter = *mConverters[converterIndex];
+			PxI32 index;
+			while((index = Ps::atomicIncrement(&mNextItem) - 1) < mNbItems)
+			{
+				PxBinaryConverterBatchItem& item = mItems[index];
+				item.success = item.srcStream && item.targetStream && converter.convert(*item.srcStream, item.srcSize, *item.targetStream);
+			}
+		}
+
+	private:
+		Sn::ConvX**					mConverters;
+		PxBinaryConverterBatchItem*	mItems;
+		const PxI32					mNbItems;
+		volatile PxI32				mNextItem;
+	};
+}
+
+bool Sn::ConvX::convertBatch(PxBinaryConverterBatchItem* items, PxU32 nbItems, PxCpuDispatcher* dispatcher)
+{
+	if(!mMetaData_Src || !mMetaData_Dst)
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__,
+			"PxBinaryConverter: metadata not defined. Call PxBinaryConverter::setMetaData first.\n");
+		return false;
+	}
+
+	if(!nbItems)
+		return true;
+
+	static const PxU32 MAX_NB_CONVERTERS = 32;
+	PxU32 nbConverters = dispatcher ? PxMin(PxMin(nbItems, dispatcher->getWorkerCount() + 1), MAX_NB_CONVERTERS) : 1;
+
+	// Converter 0 is this one, the other ones borrow its meta data.
+	ConvX* converters[MAX_NB_CONVERTERS];
+	converters[0] = this;
+	for(PxU32 i=1;i<nbConverters;i++)
+	{
+		converters[i] = PX_NEW(ConvX)();
+		converters[i]->shareMetaData(*this);
+	}
+
+	ConvertBatchJob job(converters, items, nbItems);
+	Cm::runParallelJobs(dispatcher, nbConverters, job);
+
+	for(PxU32 i=1;i<nbConverters;i++)
+		converters[i]->release();
+
+	bool success = true;
+	for(PxU32 i=0;i<nbItems;i++)
+		success &= items[i].success;
+	return success;
+}
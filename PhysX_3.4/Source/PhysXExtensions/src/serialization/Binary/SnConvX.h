@@ -81,6 +81,10 @@ namespace Sn {
 		virtual			bool					setMetaData(PxInputStream& srcMetaData, PxInputStream& dstMetaData);
 		virtual			bool					compareMetaData() const;
 		virtual			bool					convert(PxInputStream& srcStream, PxU32 srcSize, PxOutputStream& targetStream);
+		virtual			bool					convertBatch(PxBinaryConverterBatchItem* items, PxU32 nbItems, PxCpuDispatcher* dispatcher);
+
+			// Makes this converter use the meta data and unions loaded by another one, which must outlive it
+						void					shareMetaData(const ConvX& owner);
 		
 	private:
 						ConvX&					operator=(const ConvX&);
@@ -96,6 +100,7 @@ namespace Sn {
 						MetaClass*				getMetaClass(PxConcreteType::Enum concreteType, MetaDataType type);
 						MetaData*				mMetaData_Src;
 						MetaData*				mMetaData_Dst;
+						bool					mSharedMetaData;
 
 			// Convert
 						
@@ -110,7 +115,7 @@ namespace Sn {
 						const char*				convertExtraData_Array(const char* Address, const char* lastAddress, const char* objectAddress, const ExtraDataEntry& ed);
 						const char*				convertExtraData_Ptr(const char* Address, const char* lastAddress, const PxMetaDataEntry& entry, int count, int ptrSize_Src, int ptrSize_Dst);
 						int						getConcreteType(const char* buffer);
-						bool					convertCollection(const void* buffer, int fileSize, int nbObjects);
+						bool					convertCollection(const void* buffer, int fileSize, int nbObjects, bool hasObjectLayout);
 						const void*				convertManifestTable(const void* buffer, int& fileSize);
 						const void*				convertImportReferences(const void* buffer, int& fileSize);
 						const void*				convertExportReferences(const void* buffer, int& fileSize);
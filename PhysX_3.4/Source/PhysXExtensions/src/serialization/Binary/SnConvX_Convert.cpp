@@ -28,6 +28,7 @@
 #include "foundation/PxErrorCallback.h"
 #include "SnConvX.h"
 #include "serialization/SnSerialUtils.h"
+#include "SnSerializationContext.h"
 #include "PsAlloca.h"
 #include "CmUtils.h"
 #include "PxDefaultStreams.h"
@@ -751,7 +752,7 @@ struct Item : public shdfnd::UserAllocated
 	const char*	address;
 };
 
-bool Sn::ConvX::convertCollection(const void* buffer, int fileSize, int nbObjects)
+bool Sn::ConvX::convertCollection(const void* buffer, int fileSize, int nbObjects, bool hasObjectLayout)
 {
 	const char* lastAddress = reinterpret_cast<const char*>(buffer) + fileSize;
 	const char* Address = alignStream(reinterpret_cast<const char*>(buffer));
@@ -790,6 +791,17 @@ bool Sn::ConvX::convertCollection(const void* buffer, int fileSize, int nbObject
 		assert(Address<=lastAddress);
 	}
 
+	// Object layout table. The extra data offsets change with the conversion, so an empty table is written
+	// and the converted collection deserializes serially.
+	if(hasObjectLayout)
+	{
+		Address = alignStream(Address);
+		const int nbEntries = *reinterpret_cast<const int*>(Address);
+		output(0);
+		Address += 4 + nbEntries*int(sizeof(ObjectLayoutEntry));
+		assert(Address<=lastAddress);
+	}
+
 	// Fields / extra data
 	if(1)
 	{
@@ -1127,7 +1139,7 @@ bool Sn::ConvX::convert(const void* buffer, int fileSize)
 	if(!buffer)
 		return false;
 
-	bool ret = convertCollection(buffer, fileSize, nbObjectsInCollection);
+	bool ret = convertCollection(buffer, fileSize, nbObjectsInCollection, binaryVersion >= SN_BINARY_VERSION_OBJECT_LAYOUT);
 	mMarkedPadding = false;
 	return ret;
 }
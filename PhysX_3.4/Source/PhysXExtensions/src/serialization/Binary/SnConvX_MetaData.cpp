@@ -827,6 +827,13 @@ bool MetaData::compare(const MetaData& dst) const
 
 void ConvX::releaseMetaData()
 {
+	if(mSharedMetaData)
+	{
+		mMetaData_Dst = NULL;
+		mMetaData_Src = NULL;
+		mSharedMetaData = false;
+		return;
+	}
 	DELETESINGLE(mMetaData_Dst);
 	DELETESINGLE(mMetaData_Src);
 }
@@ -73,6 +73,17 @@ namespace physx
 			PxType type;
 		};
 
+		// First binary format version with an object layout table between the object data and the extra data.
+#define SN_BINARY_VERSION_OBJECT_LAYOUT 1
+
+		// Object layout table entry, one per manifest entry. PxBinaryConverter does not convert the table, it writes
+		// an empty one, since the extra data offsets change with the platform.
+		struct ObjectLayoutEntry
+		{
+			PxU32 extraDataOffset;	// relative to the start of the extra data
+			PxU32 level;			// 0 for objects requiring no other object of the collection, else 1 + the highest level of those
+		};
+
 		struct ImportReference
 		{
 		//= ATTENTION! =====================================================================================
@@ -210,6 +221,8 @@ namespace physx
 			virtual	PxBase*	resolveReference(PxU32 kind, size_t reference) const;
 
 			PxU32 getPhysXVersion() const { return mPhysXVersion; }
+
+			void setExtraDataAddress(PxU8* address) { mExtraDataAddress = address; }
 		private:
 			//various pointers to deserialized data
 			const ManifestEntry* mManifestTable;
@@ -151,20 +151,20 @@ namespace physx { namespace Sn {
 
 			if ( theSrcData )
 			{
-				static PxU32 theCount = 0;
-				++theCount;
-				char* theStartData = const_cast< char*>( copyStr( &tempAllocator, theSrcData ) );
-				const char* theData = theStartData;
+				//The scanners never write to the source, so the node data is parsed in place.
+				const char* theData = theSrcData;
 				while( !isEmpty(theData) )
 				{
 					//These buffers are whitespace delimited.
 					TDataType theType;
+					const char* thePrevData = theData;
 					strtoLong( theType, theData );
+					if ( theData == thePrevData )
+						break; //not a number, nothing more can be read from this buffer
 					tempBuffer.write( &theType, sizeof(theType) );
 				}
 				outData = reinterpret_cast< TDataType* >( tempBuffer.mBuffer );
 				outCount = tempBuffer.mWriteOffset / sizeof( TDataType );
-				tempAllocator.deallocate( reinterpret_cast<PxU8*>(theStartData) );
 			}
 			tempBuffer.releaseBuffer();
 		}
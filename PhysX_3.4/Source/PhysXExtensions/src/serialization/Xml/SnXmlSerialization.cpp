@@ -327,11 +327,36 @@ namespace physx { namespace Sn {
 
 	class XmlParser : public Ps::FastXml::Callback
 	{
+		typedef PxProfileHashMap<const char*, const char*> TNameMap;
+
 		XmlParseArgs			mParseArgs;
 		//For parse time only allocations
 		XmlMemoryAllocatorImpl& mParseAllocator;
 		XmlNode* mCurrentNode;
 		XmlNode* mTopNode;
+		//A repx file uses a few hundred distinct element names at most, spread over
+		//hundreds of thousands of nodes.  Node names are never released individually
+		//(see release( TMemoryPoolManager*, XmlNode* )), so one copy of each is shared.
+		TNameMap mNames;
+
+		const char* internName( const char* inName )
+		{
+			if ( inName == NULL || *inName == 0 )
+				return "";
+			const TNameMap::Entry* entry = mNames.find( inName );
+			if ( entry )
+				return entry->second;
+			const char* theName = copyStr( &mParseAllocator.mManager, inName );
+			mNames.insert( theName, theName );
+			return theName;
+		}
+
+		XmlNode* allocateNode( const char* inName, const char* inData )
+		{
+			XmlNode* retval = allocateRepXNode( &mParseAllocator.mManager, NULL, inData );
+			retval->mName = internName( inName );
+			return retval;
+		}
 
 	public:
 		XmlParser( XmlParseArgs inArgs, XmlMemoryAllocatorImpl& inParseAllocator )
@@ -339,6 +364,7 @@ namespace physx { namespace Sn {
 			, mParseAllocator( inParseAllocator )
 			, mCurrentNode( NULL )
 			, mTopNode( NULL )
+			, mNames( inParseAllocator.mManager.getWrapper() )
 		{
 		}
 
@@ -363,14 +389,14 @@ namespace physx { namespace Sn {
 			const Ps::FastXml::AttributePairs& attr,      // attributes
 			PxI32 /*lineno*/)
 		{
-			XmlNode* newNode = allocateRepXNode( &mParseAllocator.mManager, elementName, elementData );
+			XmlNode* newNode = allocateNode( elementName, elementData );
 			if ( mCurrentNode )
 				mCurrentNode->addChild( newNode );
 			mCurrentNode = newNode;
 			//Add the elements as children.
 			for( PxI32 item = 0; item < attr.getNbAttr(); item ++ )
 			{
-				XmlNode* node = allocateRepXNode( &mParseAllocator.mManager, attr.getKey(PxU32(item)), attr.getValue(PxU32(item)) );
+				XmlNode* node = allocateNode( attr.getKey(PxU32(item)), attr.getValue(PxU32(item)) );
 				mCurrentNode->addChild( node );
 			}
 			if ( mTopNode == NULL ) mTopNode = newNode;
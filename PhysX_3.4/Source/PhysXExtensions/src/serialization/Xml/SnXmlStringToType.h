@@ -49,17 +49,52 @@ namespace physx { namespace Sn {
 		bool compile_error;
 	};
 
+	PX_INLINE bool isXmlSpace( char c )
+	{
+		return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+	}
+
+	PX_INLINE bool isXmlDigit( char c )
+	{
+		return PxU32( c - '0' ) < 10;
+	}
+
+	//Decimal integer scanner with strtoul semantics (leading whitespace, optional sign,
+	//ioData left untouched if there are no digits).  Numbers that might overflow
+	//64 bits are handed to the crt so the saturation behavior is unchanged.
+	PX_INLINE PxU64 strToU64( const char*& ioData )
+	{
+		const char* str = ioData;
+		while ( isXmlSpace( *str ) ) ++str;
+		const bool negative = *str == '-';
+		if ( *str == '-' || *str == '+' ) ++str;
+		if ( !isXmlDigit( *str ) )
+			return 0;
+
+		const char* digits = str;
+		PxU64 value = 0;
+		while ( isXmlDigit( *str ) )
+			value = value * 10 + PxU64( *str++ - '0' );
+
+		if ( str - digits > 19 )
+			return _strtoui64( ioData, const_cast<char **>(&ioData), 10 );
+
+		ioData = str;
+		return negative ? PxU64(0) - value : value;
+	}
+
 	template<> struct StrToImpl<PxU64> { 
 		//Id's (void ptrs) are written to file as unsigned
 		//64 bit integers, so this method gets called more
 		//often than one might think.
 		PX_INLINE void strto( PxU64& ioDatatype,const char*& ioData )
 		{
-			ioDatatype = _strtoui64( ioData, const_cast<char **>(&ioData), 10 );
+			ioDatatype = strToU64( ioData );
 		}
 	};
 
-	PX_INLINE PxF32 strToFloat(const char *str,const char **nextScan)
+	//Slow path, used for anything the fast scanner below can't convert exactly.
+	PX_INLINE PxF32 strToFloatCrt(const char *str,const char **nextScan)
 	{
 		PxF32 ret;
 		while ( *str && isspace(static_cast<unsigned char>(*str))) str++; // skip leading whitespace
@@ -79,19 +114,87 @@ namespace physx { namespace Sn {
 		}
 		return ret;
 	}
+
+	//Mesh, heightfield and cloth buffers are long runs of short decimal numbers, for which strtod
+	//is by far the dominant cost of loading a repx file.  Up to 19 significant digits with a decimal
+	//exponent in [-22,22] and a mantissa below 2^53 the result is the exactly rounded double
+	//mantissa * 10^exp (both operands are exact), which is what strtod returns.  Everything else
+	//(long mantissas, large exponents, inf, nan, hex) falls back to strtod.
+	PX_INLINE PxF32 strToFloat(const char *str,const char **nextScan)
+	{
+		static const double powersOfTen[] = 
+		{
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+
+		const char* begin = str;
+		while ( isXmlSpace( *str ) ) ++str;
+		const bool negative = *str == '-';
+		if ( *str == '-' || *str == '+' ) ++str;
+
+		PxU64 mantissa = 0;
+		PxI32 nbDigits = 0;
+		PxI32 exponent = 0;
+		while ( *str == '0' ) { ++str; nbDigits = 1; }	//leading zeros are not significant
+		PxI32 nbSignificant = 0;
+		for ( ; isXmlDigit( *str ); ++str, ++nbSignificant )
+			mantissa = mantissa * 10 + PxU64( *str - '0' );
+		nbDigits += nbSignificant;
+		if ( *str == '.' )
+		{
+			++str;
+			if ( !nbSignificant )
+			{
+				for ( ; *str == '0'; ++str, ++nbDigits )
+					--exponent;
+			}
+			for ( ; isXmlDigit( *str ); ++str, ++nbDigits, ++nbSignificant, --exponent )
+				mantissa = mantissa * 10 + PxU64( *str - '0' );
+		}
+		if ( !nbDigits || nbSignificant > 19 )
+			return strToFloatCrt( begin, nextScan );
+
+		if ( *str == 'e' || *str == 'E' )
+		{
+			const char* expStart = str + 1;
+			const bool expNegative = *expStart == '-';
+			if ( *expStart == '-' || *expStart == '+' ) ++expStart;
+			if ( isXmlDigit( *expStart ) )
+			{
+				PxI32 expValue = 0;
+				for ( str = expStart; isXmlDigit( *str ); ++str )
+				{
+					if ( expValue < 10000 )
+						expValue = expValue * 10 + PxI32( *str - '0' );
+				}
+				exponent += expNegative ? -expValue : expValue;
+			}
+		}
+		if ( mantissa == 0 )
+			exponent = 0;
+		if ( exponent < -22 || exponent > 22 || mantissa > (PxU64(1) << 53) )
+			return strToFloatCrt( begin, nextScan );
+
+		double value = double( mantissa );
+		value = exponent < 0 ? value / powersOfTen[-exponent] : value * powersOfTen[exponent];
+		if ( nextScan )
+			*nextScan = str;
+		return PxF32( negative ? -value : value );
+	}
 	
 
 	template<> struct StrToImpl<PxU32> { 
 	PX_INLINE void strto( PxU32& ioDatatype,const char*& ioData )
 	{
-		ioDatatype = static_cast<PxU32>( strtoul( ioData,const_cast<char **>(&ioData), 10 ) );
+		ioDatatype = static_cast<PxU32>( strToU64( ioData ) );
 	}
 	};
 
 	template<> struct StrToImpl<PxI32> { 
 	PX_INLINE void strto( PxI32& ioDatatype,const char*& ioData )
 	{
-		ioDatatype = static_cast<PxI32>( strtoul( ioData,const_cast<char **>(&ioData), 10 ) );
+		ioDatatype = static_cast<PxI32>( strToU64( ioData ) );
 	}
 	};
 
@@ -99,7 +202,7 @@ namespace physx { namespace Sn {
 	template<> struct StrToImpl<PxU16> {
 	PX_INLINE void strto( PxU16& ioDatatype,const char*& ioData )
 	{
-		ioDatatype = static_cast<PxU16>( strtoul( ioData,const_cast<char **>(&ioData), 10 ) );
+		ioDatatype = static_cast<PxU16>( strToU64( ioData ) );
 	}
 	};
 
@@ -182,7 +285,7 @@ namespace physx { namespace Sn {
 	template<> struct StrToImpl<PxU8> {
 	PX_INLINE void strto( PxU8& ioType,const char* & inValue)
 	{
-		ioType = static_cast<PxU8>( strtoul( inValue,const_cast<char **>(&inValue), 10 ) );
+		ioType = static_cast<PxU8>( strToU64( inValue ) );
 	}
 	};
 
@@ -2403,6 +2403,16 @@ template<> struct PxEnumTraits< physx::PxHeightFieldFlag::Enum > { PxEnumTraits(
 		{ "eSUPPRESS_EAGER_SCENE_QUERY_REFIT", static_cast<PxU32>( physx::PxSceneFlag::eSUPPRESS_EAGER_SCENE_QUERY_REFIT ) },
 		{ "eENABLE_GPU_DYNAMICS", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_GPU_DYNAMICS ) },
 		{ "eENABLE_ENHANCED_DETERMINISM", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_ENHANCED_DETERMINISM ) },
+		{ "eENABLE_AVX_SOLVER", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_AVX_SOLVER ) },
+		{ "eENABLE_INCREMENTAL_PARTITIONING", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_INCREMENTAL_PARTITIONING ) },
+		{ "eENABLE_ADAPTIVE_SOLVER_ITERATIONS", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_ADAPTIVE_SOLVER_ITERATIONS ) },
+		{ "eENABLE_SCENE_QUERY_SNAPSHOTS", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_SCENE_QUERY_SNAPSHOTS ) },
+		{ "eENABLE_BACKGROUND_STATIC_TREE_REBUILD", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_BACKGROUND_STATIC_TREE_REBUILD ) },
+		{ "eENABLE_QUANTIZED_STATIC_TREE", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_QUANTIZED_STATIC_TREE ) },
+		{ "eENABLE_PARALLEL_STATE_SYNC", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_PARALLEL_STATE_SYNC ) },
+		{ "eENABLE_FRAME_STATE_BUFFER", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_FRAME_STATE_BUFFER ) },
+		{ "eENABLE_PARALLEL_VISUALIZATION", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_PARALLEL_VISUALIZATION ) },
+		{ "eENABLE_ISLAND_SLEEP", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_ISLAND_SLEEP ) },
 		{ "eMUTABLE_FLAGS", static_cast<PxU32>( physx::PxSceneFlag::eMUTABLE_FLAGS ) },
 		{ NULL, 0 }
 	};
@@ -2482,6 +2492,7 @@ template<> struct PxEnumTraits< physx::PxVisualizationParameter::Enum > { PxEnum
 		{ "eNONE", static_cast<PxU32>( physx::PxPruningStructureType::eNONE ) },
 		{ "eDYNAMIC_AABB_TREE", static_cast<PxU32>( physx::PxPruningStructureType::eDYNAMIC_AABB_TREE ) },
 		{ "eSTATIC_AABB_TREE", static_cast<PxU32>( physx::PxPruningStructureType::eSTATIC_AABB_TREE ) },
+		{ "eINCREMENTAL_AABB_TREE", static_cast<PxU32>( physx::PxPruningStructureType::eINCREMENTAL_AABB_TREE ) },
 		{ "eLAST", static_cast<PxU32>( physx::PxPruningStructureType::eLAST ) },
 		{ NULL, 0 }
 	};
@@ -0,0 +1,186 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#ifndef PX_VEHICLE_SURFACE_TYPE_HASH_TABLE_H
+#define PX_VEHICLE_SURFACE_TYPE_HASH_TABLE_H
+/** \addtogroup vehicle
+  @{
+*/
+
+#include "vehicle/PxVehicleTireFriction.h"
+#include "foundation/PxMemory.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+//Hash table of PxMaterial pointers used to associate each PxMaterial pointer
+//with a unique PxDrivableSurfaceType.  PxDrivableSurfaceType is just an integer
+//representing an id but introducing this type allows different PxMaterial pointers
+//to be associated with the same surface type.  The friction of a specific tire
+//touching a specific PxMaterial is found from a 2D table using the integers for
+//the tire type (stored in the tire) and drivable surface type (from the hash table).
+//The hash table is computed once in PxVehicleDrivableSurfaceToTireFrictionPairs::setup
+//and stored with the friction pairs so that each wheel hit only pays for the lookup.
+////////////////////////////////////////////////////////////////////////////
+
+class VehicleSurfaceTypeHashTable
+{
+public:
+
+	enum
+	{
+		eHASH_SIZE=PxVehicleDrivableSurfaceToTireFrictionPairs::eMAX_NB_SURFACE_TYPES,
+		eMAX_NB_KEYS=PxVehicleDrivableSurfaceToTireFrictionPairs::eMAX_NB_SURFACE_TYPES,
+		eINVALID_ID=0xffff
+	};
+
+	static PX_FORCE_INLINE PxU32 getByteSize()
+	{
+		return ((sizeof(PxU16)*(eHASH_SIZE + eMAX_NB_KEYS) + 15) & ~15);
+	}
+
+	//Compute the hash table of the materials of pairs into its mSurfaceTypeHashHeads and mSurfaceTypeHashNexts arrays.
+	static void build(PxVehicleDrivableSurfaceToTireFrictionPairs& pairs)
+	{
+		const PxU32 nbEntries=pairs.mNbSurfaceTypes;
+		const PxMaterial* const* materials=pairs.mDrivableSurfaceMaterials;
+		PxU16* headIds=pairs.mSurfaceTypeHashHeads;
+		PxU16* nextIds=pairs.mSurfaceTypeHashNexts;
+
+		for(PxU32 i=0;i<eHASH_SIZE;i++)
+		{
+			headIds[i]=eINVALID_ID;
+		}
+		for(PxU32 i=0;i<eMAX_NB_KEYS;i++)
+		{
+			nextIds[i]=eINVALID_ID;
+		}
+
+		pairs.mSurfaceTypeHashShift=0;
+		if(0==nbEntries)
+			return;
+
+		//Compute the number of bits to right-shift that gives the maximum number of unique hashes.
+		//Keep searching until we find either a set of completely unique hashes or a peak count of unique hashes.
+		PxU32 prevShift=0;
+		PxU32 shift=2;
+		PxU32 prevNumUniqueHashes=0;
+		PxU32 currNumUniqueHashes=0;
+		while( ((currNumUniqueHashes=computeNumUniqueHashes(materials, nbEntries, shift)) > prevNumUniqueHashes) && currNumUniqueHashes!=nbEntries)
+		{
+			prevNumUniqueHashes=currNumUniqueHashes;
+			prevShift=shift;
+			shift = (shift << 1);
+		}
+		//Either we stopped because we went past the peak number of unique hashes or because we found a unique hash for each key.
+		const PxU32 bestShift=(currNumUniqueHashes!=nbEntries) ? prevShift : shift;
+		pairs.mSurfaceTypeHashShift=bestShift;
+
+		//Compute the hash values with the optimum shift.
+		for(PxU32 i=0;i<nbEntries;i++)
+		{
+			const PxU32 hash=computeHash(materials[i],bestShift);
+			nextIds[i]=headIds[hash];
+			headIds[hash]=PxU16(i);
+		}
+	}
+
+	VehicleSurfaceTypeHashTable(const PxVehicleDrivableSurfaceToTireFrictionPairs& pairs)
+		: mMaterials(pairs.mDrivableSurfaceMaterials),
+		  mDrivableSurfaceTypes(pairs.mDrivableSurfaceTypes),
+		  mHeadIds(pairs.mSurfaceTypeHashHeads),
+		  mNextIds(pairs.mSurfaceTypeHashNexts),
+		  mShift(pairs.mSurfaceTypeHashShift)
+	{
+	}
+
+	PX_FORCE_INLINE PxU32 get(const PxMaterial* const key) const 
+	{
+		PX_ASSERT(key);
+		if(!mHeadIds)
+			return 0;
+
+		const PxU32 hash=computeHash(key, mShift);
+		PxU32 id=mHeadIds[hash];
+		while(eINVALID_ID!=id)
+		{
+			const PxMaterial* const mat=mMaterials[id];
+			if(key==mat)
+			{
+				return mDrivableSurfaceTypes[id].mType;
+			}
+			id=mNextIds[id];
+		}
+
+		return 0;
+	}
+
+private:
+
+	const PxMaterial* const* mMaterials;
+	const PxVehicleDrivableSurfaceType* mDrivableSurfaceTypes;
+	const PxU16* mHeadIds;
+	const PxU16* mNextIds;
+	PxU32 mShift;
+
+	static PX_FORCE_INLINE PxU32 computeHash(const PxMaterial* const key, const PxU32 shift) 
+	{
+		const uintptr_t ptr = ((uintptr_t(key)) >> shift);
+		const uintptr_t hash = (ptr & (eHASH_SIZE-1));
+		return PxU32(hash);
+	}
+
+	static PxU32 computeNumUniqueHashes(const PxMaterial* const* materials, const PxU32 nbEntries, const PxU32 shift)
+	{
+		PxU32 words[eHASH_SIZE >> 5];
+		PxMemZero(words, sizeof(PxU32)*(eHASH_SIZE >> 5));
+
+		PxU32 numUniqueHashes=0;
+		for(PxU32 i=0;i<nbEntries;i++)
+		{
+			const PxU32 hash=computeHash(materials[i], shift);
+			const PxU32 bit=1u<<(hash & 31);
+			if(!(words[hash>>5] & bit))
+			{
+				words[hash>>5] |= bit;
+				numUniqueHashes++;
+			}
+		}
+		return numUniqueHashes;
+	}
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif //PX_VEHICLE_SURFACE_TYPE_HASH_TABLE_H
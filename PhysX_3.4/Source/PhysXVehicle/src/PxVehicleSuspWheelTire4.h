@@ -335,7 +335,19 @@ public:
 		*/
 		PxU16 mQueryTypes[4];
 
-		PxU32 mPad1[16];
+		/**
+		\brief Start points of the suspension line raycasts that produced the cached hit planes.
+		@see PxVehicleSetSuspensionRaycastReuseTolerance
+		*/
+		PxVec3 mQueryStarts[4];
+
+		/**
+		\brief Bitmask of the wheels whose cached hit planes come from a raycast that hit a static actor or nothing.
+		@see PxVehicleSetSuspensionRaycastReuseTolerance
+		*/
+		PxU32 mReusableMask;
+
+		PxU32 mPad1[3];
 	};
 
 	/**
@@ -29,6 +29,7 @@
 
 #include "foundation/PxMemory.h"
 #include "PxVehicleTireFriction.h"
+#include "PxVehicleSurfaceTypeHashTable.h"
 #include "CmPhysXCommon.h"
 #include "PsFoundation.h"
 
@@ -40,6 +41,7 @@ PX_FORCE_INLINE PxU32 computeByteSize(const PxU32 maxNbTireTypes, const PxU32 ma
 	PxU32 byteSize = ((sizeof(PxU32)*(maxNbTireTypes*maxNbSurfaceTypes) + 15) & ~15);
 	byteSize += ((sizeof(PxMaterial*)*maxNbSurfaceTypes + 15) & ~15);
 	byteSize += ((sizeof(PxVehicleDrivableSurfaceType)*maxNbSurfaceTypes + 15) & ~15);
+	byteSize += VehicleSurfaceTypeHashTable::getByteSize();
 	byteSize += ((sizeof(PxVehicleDrivableSurfaceToTireFrictionPairs) + 15) & ~ 15);
 	return byteSize;
 }
@@ -57,6 +59,9 @@ PxVehicleDrivableSurfaceToTireFrictionPairs* PxVehicleDrivableSurfaceToTireFrict
 	pairs->mPairs = NULL;
 	pairs->mDrivableSurfaceMaterials = NULL;
 	pairs->mDrivableSurfaceTypes = NULL;
+	pairs->mSurfaceTypeHashHeads = NULL;
+	pairs->mSurfaceTypeHashNexts = NULL;
+	pairs->mSurfaceTypeHashShift = 0;
 	pairs->mNbTireTypes = 0;
 	pairs->mMaxNbTireTypes = maxNbTireTypes;
 	pairs->mNbSurfaceTypes = 0;
@@ -89,6 +94,9 @@ void PxVehicleDrivableSurfaceToTireFrictionPairs::setup
 	ptr += ((sizeof(PxMaterial*)*numSurfaceTypes + 15) & ~15);
 	mDrivableSurfaceTypes = reinterpret_cast<PxVehicleDrivableSurfaceType*>(ptr);
 	ptr += ((sizeof(PxVehicleDrivableSurfaceType)*numSurfaceTypes +15) & ~15);
+	mSurfaceTypeHashHeads = reinterpret_cast<PxU16*>(ptr);
+	mSurfaceTypeHashNexts = mSurfaceTypeHashHeads + VehicleSurfaceTypeHashTable::eHASH_SIZE;
+	ptr += VehicleSurfaceTypeHashTable::getByteSize();
 
 	for(PxU32 i=0;i<numSurfaceTypes;i++)
 	{
@@ -102,6 +110,9 @@ void PxVehicleDrivableSurfaceToTireFrictionPairs::setup
 
 	pairs->mNbTireTypes=numTireTypes;
 	pairs->mNbSurfaceTypes=numSurfaceTypes;
+
+	//Compute the material lookup once here rather than for each wheel hit in PxVehicleUpdates.
+	VehicleSurfaceTypeHashTable::build(*pairs);
 }
 
 void PxVehicleDrivableSurfaceToTireFrictionPairs::release()
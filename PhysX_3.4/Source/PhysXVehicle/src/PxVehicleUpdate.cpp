@@ -39,9 +39,11 @@
 #include "PxVehicleDefaults.h"
 #include "PxVehicleUtil.h"
 #include "PxVehicleUtilTelemetry.h"
+#include "PxVehicleSurfaceTypeHashTable.h"
 #include "PxVehicleLinearMath.h"
 #include "PxShape.h"
 #include "PxRigidDynamic.h"
+#include "PxRigidStatic.h"
 #include "PxBatchQuery.h"
 #include "PxMaterial.h"
 #include "PxTolerancesScale.h"
@@ -50,8 +52,10 @@
 #include "PsUtilities.h"
 #include "CmBitMap.h"
 #include "CmUtils.h"
+#include "CmTask.h"
 #include "PxContactModifyCallback.h"
 #include "PsFPU.h"
+#include "PsVecMath.h"
 
 using namespace physx;
 using namespace Cm;
@@ -138,6 +142,31 @@ void PxVehicleSetMaxHitActorAcceleration(const PxF32 maxHitActorAcceleration)
 	gMaxHitActorAcceleration = maxHitActorAcceleration;
 }
 
+////////////////////////////////////////////////////////////////////////////
+//Implementation of public api function PxVehicleSetSuspensionRaycastReuseTolerance
+////////////////////////////////////////////////////////////////////////////
+
+const PxF32 gSuspensionRaycastReuseToleranceDefault = 0.0f;
+PxF32 gSuspensionRaycastReuseTolerance;
+
+void PxVehicleSetSuspensionRaycastReuseTolerance(const PxF32 reuseTolerance)
+{
+	PX_CHECK_AND_RETURN(reuseTolerance >= 0.0f, "PxVehicleSetSuspensionRaycastReuseTolerance - reuseTolerance must be greater than or equal to zero");
+	gSuspensionRaycastReuseTolerance = reuseTolerance;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//Implementation of public api function PxVehicleSetSceneQuerySnapshots
+////////////////////////////////////////////////////////////////////////////
+
+const bool gUseSceneQuerySnapshotsDefault = false;
+bool gUseSceneQuerySnapshots;
+
+void PxVehicleSetSceneQuerySnapshots(const bool useSnapshots)
+{
+	gUseSceneQuerySnapshots = useSnapshots;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 //Set all defaults from PxVehicleInitSDK
 ////////////////////////////////////////////////////////////////////////////
@@ -154,6 +183,10 @@ void setVehicleDefaults()
 	gNormalRejectAngleThreshold = gNormalRejectAngleThresholdDefault;
 
 	gMaxHitActorAcceleration = gMaxHitActorAccelerationDefault;
+
+	gSuspensionRaycastReuseTolerance = gSuspensionRaycastReuseToleranceDefault;
+
+	gUseSceneQuerySnapshots = gUseSceneQuerySnapshotsDefault;
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -981,154 +1014,6 @@ PX_FORCE_INLINE void END_TIMER(const PxU32)
 #endif
 
 
-////////////////////////////////////////////////////////////////////////////
-//Hash table of PxMaterial pointers used to associate each PxMaterial pointer
-//with a unique PxDrivableSurfaceType.  PxDrivableSurfaceType is just an integer
-//representing an id but introducing this type allows different PxMaterial pointers
-//to be associated with the same surface type.  The friction of a specific tire
-//touching a specific PxMaterial is found from a 2D table using the integers for
-//the tire type (stored in the tire) and drivable surface type (from the hash table).
-//It would be great to use PsHashSet for the hash table of PxMaterials but
-//PsHashSet will never, ever work on spu so this will need to do instead.
-//Perf isn't really critical so this will do in the meantime.
-//It is probably wasteful to compute the hash table each update
-//but this is really not an expensive operation so keeping the api as 
-//simple as possible wins out at the cost of a relatively very small number of wasted cycles.
-////////////////////////////////////////////////////////////////////////////
-
-class VehicleSurfaceTypeHashTable
-{
-public:
-
-	VehicleSurfaceTypeHashTable(const PxVehicleDrivableSurfaceToTireFrictionPairs& pairs)
-		: mNbEntries(pairs.mNbSurfaceTypes),
- 	      mMaterials(pairs.mDrivableSurfaceMaterials),
-	      mDrivableSurfaceTypes(pairs.mDrivableSurfaceTypes)
-	{
-		for(PxU32 i=0;i<eHASH_SIZE;i++)
-		{
-			mHeadIds[i]=PX_MAX_U32;
-		}
-		for(PxU32 i=0;i<eMAX_NB_KEYS;i++)
-		{
-			mNextIds[i]=PX_MAX_U32;
-		}
-
-		if(mNbEntries>0)
-		{
-			//Compute the number of bits to right-shift that gives the maximum number of unique hashes.
-			//Keep searching until we find either a set of completely unique hashes or a peak count of unique hashes.
-			PxU32 prevShift=0;
-			PxU32 shift=2;
-			PxU32 prevNumUniqueHashes=0;
-			PxU32 currNumUniqueHashes=0;
-			while( ((currNumUniqueHashes=computeNumUniqueHashes(shift)) > prevNumUniqueHashes) && currNumUniqueHashes!=mNbEntries)
-			{
-				prevNumUniqueHashes=currNumUniqueHashes;
-				prevShift=shift;
-				shift = (shift << 1);
-			}
-			if(currNumUniqueHashes!=mNbEntries)
-			{
-				//Stopped searching because we have gone past the peak number of unqiue hashes.
-				mShift = prevShift;
-			}
-			else
-			{
-				//Stopped searching because we found a unique hash for each key.
-				mShift = shift;
-			}
-
-			//Compute the hash values with the optimum shift.
-			for(PxU32 i=0;i<mNbEntries;i++)
-			{
-				const PxMaterial* const material=mMaterials[i];
-				const PxU32 hash=computeHash(material,mShift);
-				if(PX_MAX_U32==mHeadIds[hash])
-				{
-					mNextIds[i]=PX_MAX_U32;
-					mHeadIds[hash]=i;
-				}
-				else
-				{
-					mNextIds[i]=mHeadIds[hash];
-					mHeadIds[hash]=i;
-				}
-			}
-		}
-	}
-	~VehicleSurfaceTypeHashTable()
-	{
-	}
-
-	PX_FORCE_INLINE PxU32 get(const PxMaterial* const key) const 
-	{
-		PX_ASSERT(key);
-		const PxU32 hash=computeHash(key, mShift);
-		PxU32 id=mHeadIds[hash];
-		while(PX_MAX_U32!=id)
-		{
-			const PxMaterial* const mat=mMaterials[id];
-			if(key==mat)
-			{
-				return mDrivableSurfaceTypes[id].mType;
-			}
-			id=mNextIds[id];
-		}
-
-		return 0;
-	}
-
-private:
-
-	PxU32 mNbEntries; 
-	const PxMaterial* const* mMaterials;
-	const PxVehicleDrivableSurfaceType* mDrivableSurfaceTypes;
-
-	static PX_FORCE_INLINE PxU32 computeHash(const PxMaterial* const key, const PxU32 shift) 
-	{
-		const uintptr_t ptr = ((uintptr_t(key)) >> shift);
-		const uintptr_t hash = (ptr & (eHASH_SIZE-1));
-		return PxU32(hash);
-	}
-
-	PxU32 computeNumUniqueHashes(const PxU32 shift) const
-	{
-		PxU32 words[eHASH_SIZE >>5];
-		PxU8* bitmapBuffer[sizeof(BitMap)];
-		BitMap* bitmap=reinterpret_cast<BitMap*>(bitmapBuffer);
-		bitmap->setWords(words, eHASH_SIZE >>5);
-
-		PxU32 numUniqueHashes=0;
-		PxMemZero(words, sizeof(PxU32)*(eHASH_SIZE >>5));
-		for(PxU32 i=0;i<mNbEntries;i++)
-		{
-			const PxMaterial* const material=mMaterials[i];
-			const PxU32 hash=computeHash(material, shift);
-			if(!bitmap->test(hash))
-			{
-				bitmap->set(hash);
-				numUniqueHashes++;
-			}
-		}
-		return numUniqueHashes;
-	}
-
-	enum
-	{
-		eHASH_SIZE=PxVehicleDrivableSurfaceToTireFrictionPairs::eMAX_NB_SURFACE_TYPES
-	};
-	PxU32 mHeadIds[eHASH_SIZE];
-	enum
-	{
-		eMAX_NB_KEYS=PxVehicleDrivableSurfaceToTireFrictionPairs::eMAX_NB_SURFACE_TYPES
-	};
-	PxU32 mNextIds[eMAX_NB_KEYS];
-
-	PxU32 mShift;
-};
-
-
 ////////////////////////////////////////////////////////////////////////////
 //Compute the suspension line raycast start point and direction.
 ////////////////////////////////////////////////////////////////////////////
@@ -2291,6 +2176,131 @@ void PxVehicleComputeTireForceDefault
 	tireAlignMoment=fMy;
 }
 
+////////////////////////////////////////////////////////////////////////////
+//Tire force shader inputs/outputs of a block of 4 wheels.
+//processSuspTireWheels gathers the shader inputs of all 4 wheels before calling the 
+//shader so that the default tire model can process the 4 wheels together.
+//Lanes that don't need a tire force keep inputs that give zero force.
+////////////////////////////////////////////////////////////////////////////
+
+struct TireForceShaderInputs4
+{
+	PxF32 frictions[4];
+	PxF32 longSlips[4];
+	PxF32 latSlips[4];
+	PxF32 cambers[4];
+	PxF32 wheelOmegas[4];
+	PxF32 wheelRadii[4];
+	PxF32 recipWheelRadii[4];
+	PxF32 restTireLoads[4];
+	PxF32 normalisedTireLoads[4];
+	PxF32 tireLoads[4];
+	const void* shaderData[4];
+};
+
+struct TireForceShaderOutputs4
+{
+	PxF32 wheelTorques[4];
+	PxF32 tireLongForceMags[4];
+	PxF32 tireLatForceMags[4];
+	PxF32 tireAlignMoments[4];
+};
+
+PX_FORCE_INLINE Ps::aos::Vec4V smoothingFunction1_4(const Ps::aos::Vec4V K)
+{
+	using namespace Ps::aos;
+	const Vec4V K2 = V4Mul(K, K);
+	const Vec4V K3 = V4Mul(K2, K);
+	return V4Min(V4One(), V4Add(V4NegScaleSub(K2, FLoad(ONE_THIRD), K), V4Scale(K3, FLoad(ONE_TWENTYSEVENTH))));
+}
+
+PX_FORCE_INLINE Ps::aos::Vec4V smoothingFunction2_4(const Ps::aos::Vec4V K)
+{
+	using namespace Ps::aos;
+	const Vec4V K2 = V4Mul(K, K);
+	const Vec4V K3 = V4Mul(K2, K);
+	const Vec4V K4 = V4Mul(K3, K);
+	return V4Sub(V4Add(V4Sub(K, K2), V4Scale(K3, FLoad(ONE_THIRD))), V4Scale(K4, FLoad(ONE_TWENTYSEVENTH)));
+}
+
+//4-wide version of PxVehicleComputeTireForceDefault, same model and same order of operations.
+//The per-wheel early out of the scalar version becomes a final select.
+void computeTireForceDefault4(const TireForceShaderInputs4& inputs, const PxF32 gravity, const PxF32 recipGravity, TireForceShaderOutputs4& outputs)
+{
+	using namespace Ps::aos;
+
+	const PxVehicleTireData& tire0=*reinterpret_cast<const PxVehicleTireData*>(inputs.shaderData[0]);
+	const PxVehicleTireData& tire1=*reinterpret_cast<const PxVehicleTireData*>(inputs.shaderData[1]);
+	const PxVehicleTireData& tire2=*reinterpret_cast<const PxVehicleTireData*>(inputs.shaderData[2]);
+	const PxVehicleTireData& tire3=*reinterpret_cast<const PxVehicleTireData*>(inputs.shaderData[3]);
+	const Vec4V latStiffX=V4LoadXYZW(tire0.mLatStiffX, tire1.mLatStiffX, tire2.mLatStiffX, tire3.mLatStiffX);
+	const Vec4V latStiffY=V4LoadXYZW(tire0.mLatStiffY, tire1.mLatStiffY, tire2.mLatStiffY, tire3.mLatStiffY);
+	const Vec4V longStiffPerUnitGravity=V4LoadXYZW(
+		tire0.mLongitudinalStiffnessPerUnitGravity, tire1.mLongitudinalStiffnessPerUnitGravity, 
+		tire2.mLongitudinalStiffnessPerUnitGravity, tire3.mLongitudinalStiffnessPerUnitGravity);
+	const Vec4V recipLongStiffPerUnitGravity=V4LoadXYZW(
+		tire0.getRecipLongitudinalStiffnessPerUnitGravity(), tire1.getRecipLongitudinalStiffnessPerUnitGravity(), 
+		tire2.getRecipLongitudinalStiffnessPerUnitGravity(), tire3.getRecipLongitudinalStiffnessPerUnitGravity());
+	const Vec4V camberStiffPerUnitGravity=V4LoadXYZW(
+		tire0.mCamberStiffnessPerUnitGravity, tire1.mCamberStiffnessPerUnitGravity, 
+		tire2.mCamberStiffnessPerUnitGravity, tire3.mCamberStiffnessPerUnitGravity);
+
+	const Vec4V zero=V4Zero();
+	const Vec4V one=V4One();
+	const FloatV g=FLoad(gravity);
+	const FloatV recipG=FLoad(recipGravity);
+
+	//Clamp the slips to a minimum value.
+	const Vec4V minSlip=V4Load(gMinimumSlipThreshold);
+	const Vec4V latSlipUnclamped=V4LoadU(inputs.latSlips);
+	const Vec4V longSlipUnclamped=V4LoadU(inputs.longSlips);
+	const Vec4V camberUnclamped=V4LoadU(inputs.cambers);
+	const Vec4V latSlip=V4Sel(V4IsGrtrOrEq(V4Abs(latSlipUnclamped), minSlip), latSlipUnclamped, zero);
+	const Vec4V longSlip=V4Sel(V4IsGrtrOrEq(V4Abs(longSlipUnclamped), minSlip), longSlipUnclamped, zero);
+	const Vec4V camber=V4Sel(V4IsGrtrOrEq(V4Abs(camberUnclamped), minSlip), camberUnclamped, zero);
+
+	//If long slip/lat slip/camber are all zero than there will be zero tire force.
+	const BoolV noForce=BAnd(V4IsEq(latSlip, zero), BAnd(V4IsEq(longSlip, zero), V4IsEq(camber, zero)));
+
+	//Compute the lateral stiffness
+	const Vec4V restTireLoad=V4LoadU(inputs.restTireLoads);
+	const Vec4V normalisedTireLoad=V4LoadU(inputs.normalisedTireLoads);
+	const Vec4V latStiff=V4Mul(V4Mul(restTireLoad, latStiffY), smoothingFunction1_4(V4Div(V4Scale(normalisedTireLoad, FLoad(3.0f)), latStiffX)));
+
+	//Get the longitudinal stiffness
+	const Vec4V longStiff=V4Scale(longStiffPerUnitGravity, g);
+	const Vec4V recipLongStiff=V4Scale(recipLongStiffPerUnitGravity, recipG);
+
+	//Get the camber stiffness.
+	const Vec4V camberStiff=V4Scale(camberStiffPerUnitGravity, g);
+
+	//Carry on and compute the forces.
+	const Vec4V TEffArg=V4Sub(latSlip, V4Div(V4Mul(camber, camberStiff), latStiff));
+	const Vec4V TEff=V4Div(V4Sin(TEffArg), V4Cos(TEffArg));
+	const Vec4V frictionTimesLoad=V4Mul(V4LoadU(inputs.frictions), V4LoadU(inputs.tireLoads));
+	const Vec4V latTerm=V4Mul(latStiff, TEff);
+	const Vec4V longTerm=V4Mul(longStiff, longSlip);
+	const Vec4V K=V4Div(V4Sqrt(V4MulAdd(latTerm, latTerm, V4Mul(longTerm, longTerm))), frictionTimesLoad);
+	const Vec4V FBar=smoothingFunction1_4(K);
+	const Vec4V MBar=smoothingFunction2_4(K);
+	const Vec4V latOverlLong=V4Mul(latStiff, recipLongStiff);
+	const Vec4V nuSmallK=V4Scale(V4Sub(V4Add(one, latOverlLong), V4Mul(V4Sub(one, latOverlLong), V4Cos(V4Scale(K, FHalf())))), FHalf());
+	const Vec4V nu=V4Sel(V4IsGrtr(K, V4Load(2.0f*PxPi)), one, nuSmallK);
+	const Vec4V nuTEff=V4Mul(nu, TEff);
+	const Vec4V FZero=V4Div(frictionTimesLoad, V4Sqrt(V4MulAdd(longSlip, longSlip, V4Mul(nuTEff, nuTEff))));
+	const Vec4V FBarFZero=V4Mul(FBar, FZero);
+	const Vec4V fz=V4Mul(longSlip, FBarFZero);
+	const Vec4V fx=V4Neg(V4Mul(nuTEff, FBarFZero));
+	//TODO: pneumatic trail (1.0 in the scalar version).
+	const Vec4V fMy=V4Mul(nuTEff, V4Mul(MBar, FZero));
+
+	//We can add the torque to the wheel.
+	V4StoreU(V4Sel(noForce, zero, V4Neg(V4Mul(fz, V4LoadU(inputs.wheelRadii)))), outputs.wheelTorques);
+	V4StoreU(V4Sel(noForce, zero, fz), outputs.tireLongForceMags);
+	V4StoreU(V4Sel(noForce, zero, fx), outputs.tireLatForceMags);
+	V4StoreU(V4Sel(noForce, zero, fMy), outputs.tireAlignMoments);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////
 //Functions required to intersect the wheel with the hit plane
@@ -2754,6 +2764,8 @@ public:
 	PxF32 cachedHitDistances[4];
 	PxF32 cachedFrictionMultipliers[4];
 	PxU16 cachedHitQueryTypes[4];
+	//Bitmask of the wheels whose cached hits may be reused without a fresh raycast.
+	PxU32 cachedHitReusableMask;
 
 	//Store the details of the force applied to any dynamic actor hit by wheel raycasts.
 	PxRigidDynamic* hitActors[4];
@@ -2962,6 +2974,7 @@ void processSuspTireWheels
 	PxF32* cachedHitDistances=outputData.cachedHitDistances;
 	PxF32* cachedFrictionMultipliers=outputData.cachedFrictionMultipliers;
 	PxU16* cachedHitQueryTypes=outputData.cachedHitQueryTypes;
+	PxU32& cachedHitReusableMask=outputData.cachedHitReusableMask;
 	//Hit actor data.
 	PxRigidDynamic** hitActors=outputData.hitActors;
 	PxVec3* hitActorForces=outputData.hitActorForces;
@@ -3148,6 +3161,19 @@ void processSuspTireWheels
 				cachedHitQueryTypes[i] = 0u;
 			}
 		}
+
+		//Only raycast hits against static actors (or no hit at all) can be reused by later updates.
+		cachedHitReusableMask=0;
+		if(raycastResults)
+		{
+			for(PxU32 i=0;i<inputData.numActiveWheels;i++)
+			{
+				if(!hitContactActors4[i] || hitContactActors4[i]->is<PxRigidStatic>())
+				{
+					cachedHitReusableMask|=(1u<<i);
+				}
+			}
+		}
 	}
 	else
 	{
@@ -3176,6 +3202,33 @@ void processSuspTireWheels
 			cachedFrictionMultipliers[i]=cachedHitResult.mFrictionMultipliers[i];
 			cachedHitQueryTypes[i]=cachedHitResult.mQueryTypes[i];
 		}
+		cachedHitReusableMask=cachedHitResult.mReusableMask;
+	}
+
+	//The tire forces are computed for all 4 wheels after the loop below.
+	//Lanes without a tire force keep inputs that give zero force with the default tire model.
+	TireForceShaderInputs4 tireShaderInputs4;
+	bool hasTireForce4[4]={false,false,false,false};
+	PxVec3 tireLongDirs4[4];
+	PxVec3 tireLatDirs4[4];
+	PxVec3 tireForceCMOffsets4[4];
+#if PX_DEBUG_VEHICLE_ON
+	PxVec3 suspForceCMOffsets4[4];
+	PxF32 normalisedTireLoads4[4];
+#endif
+	for(PxU32 i=0;i<4;i++)
+	{
+		tireShaderInputs4.frictions[i]=1.0f;
+		tireShaderInputs4.longSlips[i]=0.0f;
+		tireShaderInputs4.latSlips[i]=0.0f;
+		tireShaderInputs4.cambers[i]=0.0f;
+		tireShaderInputs4.wheelOmegas[i]=0.0f;
+		tireShaderInputs4.wheelRadii[i]=1.0f;
+		tireShaderInputs4.recipWheelRadii[i]=1.0f;
+		tireShaderInputs4.restTireLoads[i]=1.0f;
+		tireShaderInputs4.normalisedTireLoads[i]=1.0f;
+		tireShaderInputs4.tireLoads[i]=1.0f;
+		tireShaderInputs4.shaderData[i]=&wheelsSimData.getTireData(i);
 	}
 
 	//Iterate over all 4 wheels.
@@ -3491,57 +3544,96 @@ void processSuspTireWheels
 						latSlips[i]=latSlip;
 					}
 
-					//Compute the various tire torques.
-					PxF32 wheelTorque=0;
-					PxF32 tireLongForceMag=0;
-					PxF32 tireLatForceMag=0;
-					PxF32 tireAlignMoment=0;
-					const PxF32 restTireLoad=gravityMagnitude*tireRestLoads[i];
-					const PxF32 recipWheelRadius=wheel.getRecipRadius();
-					tireForceCalculator.mShader(
-						tireForceCalculator.mShaderData[i],
-						friction,
-						longSlip,latSlip,camber,
-						wheelOmega,wheelRadius,recipWheelRadius,
-						restTireLoad,filteredNormalisedTireLoad,filteredTireLoad,
-						gravityMagnitude, recipGravityMagnitude,
-						wheelTorque,tireLongForceMag,tireLatForceMag,tireAlignMoment);
-
-					//Store the tire torque ((having a local copy avoids lhs).
-					tireTorques[i]=wheelTorque;
-
-					//Apply the torque to the chassis.
-					//Compute the tire force to apply to the chassis.
-					const PxVec3 tireLongForce=tireLongDir*tireLongForceMag;
-					const PxVec3 tireLatForce=tireLatDir*tireLatForceMag;
-					const PxVec3 tireForce=tireLongForce+tireLatForce;
-					//Compute the torque to apply to the chassis.
-					const PxVec3 tireTorque=tireForceCMOffset.cross(tireForce);
-					//Add all the forces/torques together.
-					chassisForce+=tireForce;
-					chassisTorque+=tireTorque;
-
-					//Graph all the data we just computed.
+					//Store the inputs of the tire force shader, the tire torques are computed for all 4 wheels below.
+					hasTireForce4[i]=true;
+					tireShaderInputs4.frictions[i]=friction;
+					tireShaderInputs4.longSlips[i]=longSlip;
+					tireShaderInputs4.latSlips[i]=latSlip;
+					tireShaderInputs4.cambers[i]=camber;
+					tireShaderInputs4.wheelOmegas[i]=wheelOmega;
+					tireShaderInputs4.wheelRadii[i]=wheelRadius;
+					tireShaderInputs4.recipWheelRadii[i]=wheel.getRecipRadius();
+					tireShaderInputs4.restTireLoads[i]=gravityMagnitude*tireRestLoads[i];
+					tireShaderInputs4.normalisedTireLoads[i]=filteredNormalisedTireLoad;
+					tireShaderInputs4.tireLoads[i]=filteredTireLoad;
+					tireShaderInputs4.shaderData[i]=tireForceCalculator.mShaderData[i];
+					tireLongDirs4[i]=tireLongDir;
+					tireLatDirs4[i]=tireLatDir;
+					tireForceCMOffsets4[i]=tireForceCMOffset;
 #if PX_DEBUG_VEHICLE_ON
-					if(gCarTireForceAppPoints)
-						gCarTireForceAppPoints[i]=carChassisTrnsfm.p + tireForceCMOffset;
-					if(gCarSuspForceAppPoints)
-						gCarSuspForceAppPoints[i]=carChassisTrnsfm.p + suspForceCMOffset;
-
-					if(gCarWheelGraphData[0])
-					{
-						updateGraphDataNormLongTireForce(startWheelIndex, i, PxAbs(tireLongForceMag)*normalisedTireLoad/tireLoad);
-						updateGraphDataNormLatTireForce(startWheelIndex, i, PxAbs(tireLatForceMag)*normalisedTireLoad/tireLoad);
-						updateGraphDataNormTireAligningMoment(startWheelIndex, i, tireAlignMoment*normalisedTireLoad/tireLoad);
-						updateGraphDataLongTireSlip(startWheelIndex, i,longSlips[i]);
-						updateGraphDataLatTireSlip(startWheelIndex, i,latSlips[i]);
-						updateGraphDataTireFriction(startWheelIndex, i,frictions[i]);
-					}
+					suspForceCMOffsets4[i]=suspForceCMOffset;
+					normalisedTireLoads4[i]=normalisedTireLoad/tireLoad;
 #endif
 				}//filteredTireLoad*frictionMultiplier>0
 			}//if(dx > -susp.mMaxCompression)
 		}//if(numHits>0)
 	}//i
+
+	//Compute the various tire torques.
+	//The default tire model processes the 4 wheels together, custom shaders are called for each wheel.
+	TireForceShaderOutputs4 tireShaderOutputs4;
+	if(tireForceCalculator.mShader == PxVehicleComputeTireForceDefault)
+	{
+		computeTireForceDefault4(tireShaderInputs4, gravityMagnitude, recipGravityMagnitude, tireShaderOutputs4);
+	}
+	else
+	{
+		for(PxU32 i=0;i<4;i++)
+		{
+			if(!hasTireForce4[i])
+				continue;
+
+			tireForceCalculator.mShader(
+				tireShaderInputs4.shaderData[i],
+				tireShaderInputs4.frictions[i],
+				tireShaderInputs4.longSlips[i],tireShaderInputs4.latSlips[i],tireShaderInputs4.cambers[i],
+				tireShaderInputs4.wheelOmegas[i],tireShaderInputs4.wheelRadii[i],tireShaderInputs4.recipWheelRadii[i],
+				tireShaderInputs4.restTireLoads[i],tireShaderInputs4.normalisedTireLoads[i],tireShaderInputs4.tireLoads[i],
+				gravityMagnitude, recipGravityMagnitude,
+				tireShaderOutputs4.wheelTorques[i],tireShaderOutputs4.tireLongForceMags[i],tireShaderOutputs4.tireLatForceMags[i],tireShaderOutputs4.tireAlignMoments[i]);
+		}
+	}
+
+	for(PxU32 i=0;i<4;i++)
+	{
+		if(!hasTireForce4[i])
+			continue;
+
+		const PxF32 tireLongForceMag=tireShaderOutputs4.tireLongForceMags[i];
+		const PxF32 tireLatForceMag=tireShaderOutputs4.tireLatForceMags[i];
+
+		//Store the tire torque ((having a local copy avoids lhs).
+		tireTorques[i]=tireShaderOutputs4.wheelTorques[i];
+
+		//Apply the torque to the chassis.
+		//Compute the tire force to apply to the chassis.
+		const PxVec3 tireLongForce=tireLongDirs4[i]*tireLongForceMag;
+		const PxVec3 tireLatForce=tireLatDirs4[i]*tireLatForceMag;
+		const PxVec3 tireForce=tireLongForce+tireLatForce;
+		//Compute the torque to apply to the chassis.
+		const PxVec3 tireTorque=tireForceCMOffsets4[i].cross(tireForce);
+		//Add all the forces/torques together.
+		chassisForce+=tireForce;
+		chassisTorque+=tireTorque;
+
+		//Graph all the data we just computed.
+#if PX_DEBUG_VEHICLE_ON
+		if(gCarTireForceAppPoints)
+			gCarTireForceAppPoints[i]=carChassisTrnsfm.p + tireForceCMOffsets4[i];
+		if(gCarSuspForceAppPoints)
+			gCarSuspForceAppPoints[i]=carChassisTrnsfm.p + suspForceCMOffsets4[i];
+
+		if(gCarWheelGraphData[0])
+		{
+			updateGraphDataNormLongTireForce(startWheelIndex, i, PxAbs(tireLongForceMag)*normalisedTireLoads4[i]);
+			updateGraphDataNormLatTireForce(startWheelIndex, i, PxAbs(tireLatForceMag)*normalisedTireLoads4[i]);
+			updateGraphDataNormTireAligningMoment(startWheelIndex, i, tireShaderOutputs4.tireAlignMoments[i]*normalisedTireLoads4[i]);
+			updateGraphDataLongTireSlip(startWheelIndex, i,longSlips[i]);
+			updateGraphDataLatTireSlip(startWheelIndex, i,latSlips[i]);
+			updateGraphDataTireFriction(startWheelIndex, i,frictions[i]);
+		}
+#endif
+	}
 }
 
 
@@ -3634,7 +3726,7 @@ void updateJounces(const PxF32* PX_RESTRICT jounces, PxF32* PX_RESTRICT prevJoun
 
 void updateCachedHitData
 (const PxU32* PX_RESTRICT cachedHitCounts, const PxVec4* PX_RESTRICT cachedHitPlanes, const PxF32* PX_RESTRICT cachedHitDistances, const PxF32* PX_RESTRICT cachedFrictionMultipliers, const PxU16* cachedQueryTypes,
- PxVehicleWheels4DynData* wheels4DynData)
+ const PxU32 cachedReusableMask, PxVehicleWheels4DynData* wheels4DynData)
 {
 	if(wheels4DynData->mRaycastResults || wheels4DynData->mSweepResults)
 	{
@@ -3644,6 +3736,20 @@ void updateCachedHitData
 	PxVehicleWheels4DynData::CachedSuspLineSceneQuerytHitResult* cachedRaycastHitResults = 
 		reinterpret_cast<PxVehicleWheels4DynData::CachedSuspLineSceneQuerytHitResult*>(wheels4DynData->mQueryOrCachedHitResults);
 
+	//The raycast starts share memory with the cached hit data so read them before overwriting anything.
+	//With cached hit data the starts of the raycast that produced it are already in place.
+	if(wheels4DynData->mRaycastResults)
+	{
+		const PxVehicleWheels4DynData::SuspLineRaycast& raycast = 
+			reinterpret_cast<const PxVehicleWheels4DynData::SuspLineRaycast&>(wheels4DynData->mQueryOrCachedHitResults);
+		const PxVec3 queryStarts[4]={raycast.mStarts[0], raycast.mStarts[1], raycast.mStarts[2], raycast.mStarts[3]};
+		for(PxU32 i=0;i<4;i++)
+		{
+			cachedRaycastHitResults->mQueryStarts[i]=queryStarts[i];
+		}
+	}
+	cachedRaycastHitResults->mReusableMask=cachedReusableMask;
+
 
 	for(PxU32 i=0;i<4;i++)
 	{
@@ -4603,6 +4709,24 @@ public:
 		const bool* vehiclesToRaycast,
 		const PxF32 sweepWidthScale, const PxF32 sweepRadiusScale);
 
+	//Return true if the scene queries of a vehicle with reduced level of detail can be skipped and its cached hit planes used instead.
+	static bool skipSceneQueries(PxVehicleWheels& veh)
+	{
+		PxVehicleWheelsDynData& dynData=veh.mWheelsDynData;
+		if(PxVehicleUpdateLOD::eREDUCED!=dynData.mUpdateLOD)
+			return false;
+
+		bool hasCachedHitPlanes=true;
+		for(PxU32 j=0;j<dynData.mNbWheels4;j++)
+		{
+			hasCachedHitPlanes=hasCachedHitPlanes && dynData.mWheels4DynData[j].mHasCachedRaycastHitPlane;
+		}
+
+		const bool skip=hasCachedHitPlanes && (dynData.mSceneQueryCounter!=0);
+		dynData.mSceneQueryCounter=(dynData.mSceneQueryCounter+1 < dynData.mSceneQueryInterval) ? dynData.mSceneQueryCounter+1 : 0;
+		return skip;
+	}
+
 	static void updateDrive4W(
 		const PxF32 timestep, 
 		const PxVec3& gravity, const PxF32 gravityMagnitude, const PxF32 recipGravityMagnitude, 
@@ -4627,8 +4751,11 @@ public:
 		const PxVehicleDrivableSurfaceToTireFrictionPairs& drivableSurfaceToTireFrictionPairs,
 		PxVehicleNoDrive* vehDriveTank, PxVehicleWheelQueryResult* vehWheelQueryResults, PxVehicleConcurrentUpdateData* vehConcurrentUpdates);
 
-	static PxU32 computeNumberOfSubsteps(const PxVehicleWheelsSimData& wheelsSimData, const PxVec3& linVel, const PxTransform& globalPose, const PxVec3& forward)
+	static PxU32 computeNumberOfSubsteps(const PxVehicleWheelsSimData& wheelsSimData, const PxVehicleWheelsDynData& wheelsDynData, const PxVec3& linVel, const PxTransform& globalPose, const PxVec3& forward)
 	{
+		if(PxVehicleUpdateLOD::eREDUCED==wheelsDynData.mUpdateLOD)
+			return 1;
+
 		const PxVec3 z=globalPose.q.rotate(forward);
 		const PxF32 vz=PxAbs(linVel.dot(z));
 		const PxF32 thresholdVz=wheelsSimData.mThresholdLongitudinalSpeed;
@@ -4688,6 +4815,10 @@ public:
 			const PxRaycastQueryResult* raycastResults = wheels4DynDatas[i].mRaycastResults;
 			const PxSweepQueryResult* sweepResults = wheels4DynDatas[i].mSweepResults;
 
+			//Blocks using cached hits only reuse hits against static actors.
+			if(!raycastResults && !sweepResults)
+				continue;
+
 			for(PxU32 j=0;j<4;j++)
 			{
 				if(!wheelsSimData.getIsWheelDisabled(4*i + j))
@@ -5093,7 +5224,7 @@ PxVehicleDrive4W* vehDrive4W, PxVehicleWheelQueryResult* vehWheelQueryResults, P
 	//Ready to do the update.
 	PxVec3 carChassisLinVelOrig=carChassisLinVel;
 	PxVec3 carChassisAngVelOrig=carChassisAngVel;
-	const PxU32 numSubSteps=computeNumberOfSubsteps(vehDrive4W->mWheelsSimData,carChassisLinVel,carChassisTransform,gForward);
+	const PxU32 numSubSteps=computeNumberOfSubsteps(vehDrive4W->mWheelsSimData,vehDrive4W->mWheelsDynData,carChassisLinVel,carChassisTransform,gForward);
 	const PxF32 timeFraction=1.0f/(1.0f*numSubSteps);
 	const PxF32 subTimestep=timestep*timeFraction;
 	const PxF32 recipSubTimeStep=1.0f/subTimestep;
@@ -5137,7 +5268,7 @@ PxVehicleDrive4W* vehDrive4W, PxVehicleWheelQueryResult* vehWheelQueryResults, P
 			updateJounces(outputData.jounces, const_cast<PxF32*>(inputData.vehWheels4DynData->mJounces));
 			if((numSubSteps-1) == k)
 			{
-				updateCachedHitData(outputData.cachedHitCounts, outputData.cachedHitPlanes, outputData.cachedHitDistances, outputData.cachedFrictionMultipliers, outputData.cachedHitQueryTypes, &wheels4DynData);
+				updateCachedHitData(outputData.cachedHitCounts, outputData.cachedHitPlanes, outputData.cachedHitDistances, outputData.cachedFrictionMultipliers, outputData.cachedHitQueryTypes, outputData.cachedHitReusableMask, &wheels4DynData);
 			}
 			chassisForce+=outputData.chassisForce;
 			chassisTorque+=outputData.chassisTorque;
@@ -5258,7 +5389,7 @@ PxVehicleDrive4W* vehDrive4W, PxVehicleWheelQueryResult* vehWheelQueryResults, P
 			updateJounces(extraOutputData.jounces, const_cast<PxF32*>(extraInputData.vehWheels4DynData->mJounces));
 			if((numSubSteps-1) == k)
 			{
-				updateCachedHitData(extraOutputData.cachedHitCounts, extraOutputData.cachedHitPlanes, extraOutputData.cachedHitDistances, extraOutputData.cachedFrictionMultipliers, extraOutputData.cachedHitQueryTypes, &wheels4DynDatas[j]);
+				updateCachedHitData(extraOutputData.cachedHitCounts, extraOutputData.cachedHitPlanes, extraOutputData.cachedHitDistances, extraOutputData.cachedFrictionMultipliers, extraOutputData.cachedHitQueryTypes, extraOutputData.cachedHitReusableMask, &wheels4DynDatas[j]);
 			}
 			chassisForce+=extraOutputData.chassisForce;
 			chassisTorque+=extraOutputData.chassisTorque;
@@ -5683,7 +5814,7 @@ void PxVehicleUpdate::updateDriveNW
 	//Ready to do the update.
 	PxVec3 carChassisLinVelOrig=carChassisLinVel;
 	PxVec3 carChassisAngVelOrig=carChassisAngVel;
-	const PxU32 numSubSteps=computeNumberOfSubsteps(vehDriveNW->mWheelsSimData,carChassisLinVel,carChassisTransform,gForward);
+	const PxU32 numSubSteps=computeNumberOfSubsteps(vehDriveNW->mWheelsSimData,vehDriveNW->mWheelsDynData,carChassisLinVel,carChassisTransform,gForward);
 	const PxF32 timeFraction=1.0f/(1.0f*numSubSteps);
 	const PxF32 subTimestep=timestep*timeFraction;
 	const PxF32 recipSubTimeStep=1.0f/subTimestep;
@@ -5728,7 +5859,7 @@ void PxVehicleUpdate::updateDriveNW
 			updateJounces(outputData[i].jounces, const_cast<PxF32*>(inputData.vehWheels4DynData->mJounces));
 			if((numSubSteps-1) == k)
 			{
-				updateCachedHitData(outputData[i].cachedHitCounts, outputData[i].cachedHitPlanes, outputData[i].cachedHitDistances, outputData[i].cachedFrictionMultipliers, outputData[i].cachedHitQueryTypes, &wheels4DynDatas[i]);
+				updateCachedHitData(outputData[i].cachedHitCounts, outputData[i].cachedHitPlanes, outputData[i].cachedHitDistances, outputData[i].cachedFrictionMultipliers, outputData[i].cachedHitQueryTypes, outputData[i].cachedHitReusableMask, &wheels4DynDatas[i]);
 			}
 			chassisForce+=outputData[i].chassisForce;
 			chassisTorque+=outputData[i].chassisTorque;
@@ -6205,7 +6336,7 @@ void PxVehicleUpdate::updateTank
 	//Ready to do the update.
 	PxVec3 carChassisLinVelOrig=carChassisLinVel;
 	PxVec3 carChassisAngVelOrig=carChassisAngVel;
-	const PxU32 numSubSteps=computeNumberOfSubsteps(vehDriveTank->mWheelsSimData,carChassisLinVel,carChassisTransform,gForward);
+	const PxU32 numSubSteps=computeNumberOfSubsteps(vehDriveTank->mWheelsSimData,vehDriveTank->mWheelsDynData,carChassisLinVel,carChassisTransform,gForward);
 	const PxF32 timeFraction=1.0f/(1.0f*numSubSteps);
 	const PxF32 subTimestep=timestep*timeFraction;
 	const PxF32 recipSubTimeStep=1.0f/subTimestep;
@@ -6247,7 +6378,7 @@ void PxVehicleUpdate::updateTank
 			updateJounces(outputData[i].jounces, const_cast<PxF32*>(inputData.vehWheels4DynData->mJounces));
 			if((numSubSteps-1) == k)
 			{
-				updateCachedHitData(outputData[i].cachedHitCounts, outputData[i].cachedHitPlanes, outputData[i].cachedHitDistances, outputData[i].cachedFrictionMultipliers, outputData[i].cachedHitQueryTypes, &wheels4DynDatas[i]);
+				updateCachedHitData(outputData[i].cachedHitCounts, outputData[i].cachedHitPlanes, outputData[i].cachedHitDistances, outputData[i].cachedFrictionMultipliers, outputData[i].cachedHitQueryTypes, outputData[i].cachedHitReusableMask, &wheels4DynDatas[i]);
 			}
 			chassisForce+=outputData[i].chassisForce;
 			chassisTorque+=outputData[i].chassisTorque;	
@@ -6567,7 +6698,7 @@ void PxVehicleUpdate::updateNoDrive
 	//Ready to do the update.
 	PxVec3 carChassisLinVelOrig=carChassisLinVel;
 	PxVec3 carChassisAngVelOrig=carChassisAngVel;
-	const PxU32 numSubSteps=computeNumberOfSubsteps(vehNoDrive->mWheelsSimData,carChassisLinVel,carChassisTransform,gForward);
+	const PxU32 numSubSteps=computeNumberOfSubsteps(vehNoDrive->mWheelsSimData,vehNoDrive->mWheelsDynData,carChassisLinVel,carChassisTransform,gForward);
 	const PxF32 timeFraction=1.0f/(1.0f*numSubSteps);
 	const PxF32 subTimestep=timestep*timeFraction;
 	const PxF32 recipSubTimeStep=1.0f/subTimestep;
@@ -6623,7 +6754,7 @@ void PxVehicleUpdate::updateNoDrive
 			updateJounces(outputData.jounces, const_cast<PxF32*>(inputData.vehWheels4DynData->mJounces));
 			if((numSubSteps-1) == k)
 			{
-				updateCachedHitData(outputData.cachedHitCounts, outputData.cachedHitPlanes, outputData.cachedHitDistances, outputData.cachedFrictionMultipliers, outputData.cachedHitQueryTypes, &wheels4DynData);
+				updateCachedHitData(outputData.cachedHitCounts, outputData.cachedHitPlanes, outputData.cachedHitDistances, outputData.cachedFrictionMultipliers, outputData.cachedHitQueryTypes, outputData.cachedHitReusableMask, &wheels4DynData);
 			}
 			chassisForce+=outputData.chassisForce;
 			chassisTorque+=outputData.chassisTorque;
@@ -6806,7 +6937,8 @@ void PxVehicleUpdate::updateSingleVehicleAndStoreTelemetryData
 #if PX_CHECKED
 	for(PxU32 i=0;i<vehWheels->mWheelsSimData.mNbWheels4;i++)
 	{
-		PX_CHECK_MSG(vehWheels->mWheelsDynData.mWheels4DynData[i].mRaycastResults || vehWheels->mWheelsDynData.mWheels4DynData[i].mSweepResults,
+		PX_CHECK_MSG(vehWheels->mWheelsDynData.mWheels4DynData[i].mRaycastResults || vehWheels->mWheelsDynData.mWheels4DynData[i].mSweepResults ||
+			vehWheels->mWheelsDynData.mWheels4DynData[i].mHasCachedRaycastHitPlane,
 			"Need to call PxVehicleSuspensionRaycasts or PxVehicleSuspensionSweeps before trying to update");
 	}
 	for(PxU32 i=0;i<vehWheels->mWheelsSimData.mNbActiveWheels;i++)
@@ -7223,6 +7355,89 @@ void physx::PxVehicleUpdates
 	PxVehicleUpdate::update(timestep, gravity, vehicleDrivableSurfaceToTireFrictionPairs, numVehicles, vehicles, vehicleWheelQueryResults, vehicleConcurrentUpdates);
 }
 
+namespace
+{
+	struct VehicleUpdateJob
+	{
+		PxF32 timestep;
+		PxVec3 gravity;
+		const PxVehicleDrivableSurfaceToTireFrictionPairs* frictionPairs;
+		PxU32 numVehicles;
+		PxU32 numVehiclesPerJob;
+		PxVehicleWheels** vehicles;
+		PxVehicleWheelQueryResult* wheelQueryResults;
+		PxVehicleConcurrentUpdateData* concurrentUpdates;
+
+		void operator()(PxU32 jobIndex)
+		{
+			const PxU32 start=jobIndex*numVehiclesPerJob;
+			const PxU32 count=PxMin(numVehiclesPerJob, numVehicles-start);
+			PxVehicleUpdates(timestep, gravity, *frictionPairs, count, vehicles+start, 
+				wheelQueryResults ? wheelQueryResults+start : NULL, concurrentUpdates+start);
+		}
+	};
+}
+
+void physx::PxVehicleUpdates
+(const PxReal timestep, const PxVec3& gravity, const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
+ const PxU32 numVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* vehicleWheelQueryResults, 
+ PxCpuDispatcher& dispatcher, const PxU32 numVehiclesPerTask, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates)
+{
+	PX_CHECK_AND_RETURN(numVehiclesPerTask>0, "PxVehicleUpdates: numVehiclesPerTask must be greater than zero");
+	if(!numVehicles)
+		return;
+
+	VehicleUpdateJob job;
+	job.timestep=timestep;
+	job.gravity=gravity;
+	job.frictionPairs=&vehicleDrivableSurfaceToTireFrictionPairs;
+	job.numVehicles=numVehicles;
+	job.numVehiclesPerJob=numVehiclesPerTask;
+	job.vehicles=vehicles;
+	job.wheelQueryResults=vehicleWheelQueryResults;
+
+	//The actor changes recorded in user buffers are applied by the user with PxVehiclePostUpdates.
+	if(vehicleConcurrentUpdates)
+	{
+		job.concurrentUpdates=vehicleConcurrentUpdates;
+		Cm::runParallelJobs(&dispatcher, (numVehicles + numVehiclesPerTask - 1)/numVehiclesPerTask, job);
+		return;
+	}
+
+	//updatePost reads the wheel data of complete blocks of 4 wheels so reserve 4 entries per block.
+	PxU32 numWheelEntries=0;
+	for(PxU32 i=0;i<numVehicles;i++)
+	{
+		numWheelEntries+=4*vehicles[i]->mWheelsSimData.getNbWheels4();
+	}
+
+	//Allocate the concurrent update data of all vehicles in a single block.
+	const PxU32 byteSize=sizeof(PxVehicleConcurrentUpdateData)*numVehicles + sizeof(PxVehicleWheelConcurrentUpdateData)*numWheelEntries;
+	PxU8* buffer=static_cast<PxU8*>(PX_ALLOC(byteSize, "PxVehicleConcurrentUpdateData"));
+	PxVehicleConcurrentUpdateData* concurrentUpdates=reinterpret_cast<PxVehicleConcurrentUpdateData*>(buffer);
+	PxVehicleWheelConcurrentUpdateData* wheelConcurrentUpdates=reinterpret_cast<PxVehicleWheelConcurrentUpdateData*>(buffer + sizeof(PxVehicleConcurrentUpdateData)*numVehicles);
+	for(PxU32 i=0;i<numVehicles;i++)
+	{
+		const PxU32 numVehicleWheelEntries=4*vehicles[i]->mWheelsSimData.getNbWheels4();
+		for(PxU32 j=0;j<numVehicleWheelEntries;j++)
+		{
+			PX_PLACEMENT_NEW(wheelConcurrentUpdates+j, PxVehicleWheelConcurrentUpdateData)();
+		}
+		PxVehicleConcurrentUpdateData* concurrentUpdate=PX_PLACEMENT_NEW(concurrentUpdates+i, PxVehicleConcurrentUpdateData)();
+		concurrentUpdate->concurrentWheelUpdates=wheelConcurrentUpdates;
+		concurrentUpdate->nbConcurrentWheelUpdates=vehicles[i]->mWheelsSimData.getNbWheels();
+		wheelConcurrentUpdates+=numVehicleWheelEntries;
+	}
+
+	job.concurrentUpdates=concurrentUpdates;
+	Cm::runParallelJobs(&dispatcher, (numVehicles + numVehiclesPerTask - 1)/numVehiclesPerTask, job);
+
+	//Actor writes (wake-ups, velocities, shape poses and forces on hit actors) are not thread-safe so apply them here.
+	PxVehiclePostUpdates(concurrentUpdates, numVehicles, vehicles);
+
+	PX_FREE(buffer);
+}
+
 void physx::PxVehiclePostUpdates
 (const PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates, const PxU32 numVehicles, PxVehicleWheels** vehicles)
 {
@@ -7299,6 +7514,37 @@ void PxVehicleWheels4SuspensionRaycasts
 	}
 }
 
+static bool canReuseCachedHits
+(const PxVehicleWheels4SimData& wheels4SimData, const PxVehicleWheels4DynData& wheels4DynData, 
+ const bool* activeWheelStates, const PxU32 numActiveWheels, const PxTransform& carChassisTrnsfm)
+{
+	if(gSuspensionRaycastReuseTolerance<=0.0f || !wheels4DynData.mHasCachedRaycastHitPlane)
+		return false;
+
+	const PxVehicleWheels4DynData::CachedSuspLineSceneQuerytHitResult& cachedHitResult = 
+		reinterpret_cast<const PxVehicleWheels4DynData::CachedSuspLineSceneQuerytHitResult&>(wheels4DynData.mQueryOrCachedHitResults);
+
+	const PxF32 toleranceSq=gSuspensionRaycastReuseTolerance*gSuspensionRaycastReuseTolerance;
+	for(PxU32 j=0;j<numActiveWheels;j++)
+	{
+		if(!activeWheelStates[j])
+			continue;
+
+		if(!(cachedHitResult.mReusableMask & (1u<<j)))
+			return false;
+
+		//Compare the start of the suspension line with the start of the raycast that produced the cached hit.
+		const PxVehicleSuspensionData& susp=wheels4SimData.getSuspensionData(j);
+		const PxVehicleWheelData& wheel=wheels4SimData.getWheelData(j);
+		PxVec3 suspLineStart;
+		PxVec3 suspLineDir;
+		computeSuspensionRaycast(carChassisTrnsfm,wheels4SimData.getWheelCentreOffset(j),wheels4SimData.getSuspTravelDirection(j),wheel.mRadius,susp.mMaxCompression,suspLineStart,suspLineDir);
+		if((suspLineStart - cachedHitResult.mQueryStarts[j]).magnitudeSquared() > toleranceSq)
+			return false;
+	}
+	return true;
+}
+
 void PxVehicleUpdate::suspensionRaycasts(PxBatchQuery* batchQuery, const PxU32 numVehicles, PxVehicleWheels** vehicles, const PxU32 numSceneQueryResults, PxRaycastQueryResult* sceneQueryResults, const bool* vehiclesToRaycast)
 {
 	START_TIMER(TIMER_RAYCASTS);
@@ -7311,7 +7557,9 @@ void PxVehicleUpdate::suspensionRaycasts(PxBatchQuery* batchQuery, const PxU32 n
 
 	PxRaycastQueryResult* sqres=sceneQueryResults;
 
-	const PxQueryFlags flags = PxQueryFlag::eSTATIC|PxQueryFlag::eDYNAMIC|PxQueryFlag::ePREFILTER;
+	PxQueryFlags flags = PxQueryFlag::eSTATIC|PxQueryFlag::eDYNAMIC|PxQueryFlag::ePREFILTER;
+	if(gUseSceneQuerySnapshots)
+		flags |= PxQueryFlag::eSNAPSHOT;
 	PxQueryFilterData carFilterData[4];
 	carFilterData[0].flags=flags;
 	carFilterData[1].flags=flags;
@@ -7330,6 +7578,18 @@ void PxVehicleUpdate::suspensionRaycasts(PxBatchQuery* batchQuery, const PxU32 n
 		const PxU32 numActiveWheelsInLast4=numActiveWheels-4*numWheels4;
 		PxRigidDynamic* vehActor=veh.mActor;
 
+		//Vehicles with reduced level of detail reuse their cached hit planes between scene queries.
+		const bool issueSceneQueries=(NULL==vehiclesToRaycast || vehiclesToRaycast[i]) && !skipSceneQueries(veh);
+
+		//Blocks of wheels that have barely moved since their last raycast reuse their cached hit planes.
+		PxTransform carChassisTrnsfm(PxIdentity);
+		if(issueSceneQueries && gSuspensionRaycastReuseTolerance>0.0f)
+		{
+			PxTransform massXform = vehActor->getCMassLocalPose();
+			massXform.q = PxQuat(PxIdentity);
+			carChassisTrnsfm = vehActor->getGlobalPose().transform(massXform);
+		}
+
 		//Set the results pointer and start the raycasts.
 		PX_ASSERT(numActiveWheelsInLast4<4);
 
@@ -7342,7 +7602,7 @@ void PxVehicleUpdate::suspensionRaycasts(PxBatchQuery* batchQuery, const PxU32 n
 			wheels4DynData[j].mRaycastResults=NULL;
 			wheels4DynData[j].mSweepResults=NULL;
 
-			if(NULL==vehiclesToRaycast || vehiclesToRaycast[i])
+			if(issueSceneQueries && !canReuseCachedHits(wheels4SimData[j],wheels4DynData[j],activeWheelStates,4,carChassisTrnsfm))
 			{
 				if((sceneQueryResults + numSceneQueryResults) >= (sqres+4))
 				{
@@ -7371,7 +7631,7 @@ void PxVehicleUpdate::suspensionRaycasts(PxBatchQuery* batchQuery, const PxU32 n
 			wheels4DynData[j].mRaycastResults=NULL;
 			wheels4DynData[j].mSweepResults=NULL;
 			
-			if(NULL==vehiclesToRaycast || vehiclesToRaycast[i])
+			if(issueSceneQueries && !canReuseCachedHits(wheels4SimData[j],wheels4DynData[j],activeWheelStates,numActiveWheelsInLast4,carChassisTrnsfm))
 			{
 				if((sceneQueryResults + numSceneQueryResults) >= (sqres+numActiveWheelsInLast4))
 				{
@@ -7522,7 +7782,9 @@ void PxVehicleUpdate::suspensionSweeps
 
 	PxSweepQueryResult* sqres=sceneQueryResults;
 
-	const PxQueryFlags flags = PxQueryFlag::eSTATIC|PxQueryFlag::eDYNAMIC|PxQueryFlag::ePREFILTER|PxQueryFlag::ePOSTFILTER;
+	PxQueryFlags flags = PxQueryFlag::eSTATIC|PxQueryFlag::eDYNAMIC|PxQueryFlag::ePREFILTER|PxQueryFlag::ePOSTFILTER;
+	if(gUseSceneQuerySnapshots)
+		flags |= PxQueryFlag::eSNAPSHOT;
 	PxQueryFilterData carFilterData[4];
 	carFilterData[0].flags=flags;
 	carFilterData[1].flags=flags;
@@ -7541,6 +7803,9 @@ void PxVehicleUpdate::suspensionSweeps
 		const PxU32 numActiveWheelsInLast4=numActiveWheels-4*numWheels4;
 		PxRigidDynamic* vehActor=veh.mActor;
 
+		//Vehicles with reduced level of detail reuse their cached hit planes between scene queries.
+		const bool issueSceneQueries=(NULL==vehiclesToSweep || vehiclesToSweep[i]) && !skipSceneQueries(veh);
+
 		//Set the results pointer and start the raycasts.
 		PX_ASSERT(numActiveWheelsInLast4<4);
 
@@ -7564,7 +7829,7 @@ void PxVehicleUpdate::suspensionSweeps
 			wheels4DynData[j].mRaycastResults=NULL;
 			wheels4DynData[j].mSweepResults=NULL;
 
-			if(NULL==vehiclesToSweep || vehiclesToSweep[i])
+			if(issueSceneQueries)
 			{
 				if((sceneQueryResults + numSceneQueryResults) >= (sqres+4))
 				{
@@ -7602,7 +7867,7 @@ void PxVehicleUpdate::suspensionSweeps
 			wheels4DynData[j].mRaycastResults=NULL;
 			wheels4DynData[j].mSweepResults=NULL;
 
-			if(NULL==vehiclesToSweep || vehiclesToSweep[i])
+			if(issueSceneQueries)
 			{
 				if((sceneQueryResults + numSceneQueryResults) >= (sqres+numActiveWheelsInLast4))
 				{
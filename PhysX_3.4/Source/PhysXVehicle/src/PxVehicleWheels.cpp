@@ -488,6 +488,10 @@ PxVehicleWheelsDynData::PxVehicleWheelsDynData(const PxU32 numWheels)
 	mNbWheels4=numWheels4;
 	mNbActiveWheels=numWheels;
 
+	mUpdateLOD=PxVehicleUpdateLOD::eFULL;
+	mSceneQueryInterval=1;
+	mSceneQueryCounter=0;
+
 	//Placement new for wheels4
 	for(PxU32 i=0;i<numWheels4;i++)
 	{
@@ -808,6 +812,15 @@ void* PxVehicleWheelsDynData::getUserData(const PxU32 tireIdx) const
 
 ////////////////////////////////////////////////////////////////////////////
 
+void PxVehicleWheelsDynData::setUpdateLOD(const PxVehicleUpdateLOD::Enum lod, const PxU32 sceneQueryInterval)
+{
+	PX_CHECK_AND_RETURN(sceneQueryInterval>0, "PxVehicleWheelsDynData::setUpdateLOD - sceneQueryInterval must be greater than zero");
+	mUpdateLOD=PxU32(lod);
+	mSceneQueryInterval=sceneQueryInterval;
+	//Issue scene queries at the next raycast/sweep call.
+	mSceneQueryCounter=0;
+}
+
 void PxVehicleWheelsDynData::copy(const PxVehicleWheelsDynData& src, const PxU32 srcWheel, const PxU32 trgWheel)
 {
 	PX_CHECK_AND_RETURN(srcWheel < src.mNbActiveWheels, "PxVehicleWheelsDynData::copy - Illegal src wheel");
@@ -49,6 +49,8 @@ namespace physx
 
 namespace physx
 {	
+	class PxCpuDispatcher;
+
 	namespace Cm
 	{
 		class RenderOutput;
@@ -161,6 +163,24 @@ public:
 	virtual	PxAgain						overlap(const Gu::ShapeData& queryVolume, PrunerCallback&) const = 0;
 	virtual	PxAgain						sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback&) const = 0;
 
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/**
+	 *	\brief		Runs a group of overlap queries, each reporting to its own callback.
+	 *
+	 *	Pruners may traverse their structure once for the whole group. The default implementation runs the queries one after the other.
+	 *
+	 *	\param		nbQueries		[in]	the number of queries
+	 *	\param		queryVolumes	[in]	the query volumes
+	 *	\param		pcbs			[in]	the callbacks, one per query
+	 *	\param		again			[out]	the PxAgain result of each query, as overlap() would return it
+	 */
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	virtual	void						overlapMultiple(PxU32 nbQueries, const Gu::ShapeData* const* queryVolumes, PrunerCallback* const* pcbs, PxAgain* again) const
+										{
+											for(PxU32 i=0;i<nbQueries;i++)
+												again[i] = overlap(*queryVolumes[i], *pcbs[i]);
+										}
+
 	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	/**
 	 *	Retrieve the object data associated with the handle
@@ -184,6 +204,19 @@ public:
 	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	virtual const PrunerPayload&		getPayload(PrunerHandle handle, PxBounds3*& bounds) const = 0;
 
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/**
+	 *	Retrieve all the objects of the pruner, as parallel arrays of payloads and bounds. The bounds are the ones used by the
+	 *	queries, i.e. already inflated. The arrays are invalidated by the next modification of the pruner.
+	 *	
+	 *	\param	payloads	[out] the object data
+	 *	\param	bounds		[out] the object bounds
+	 *
+	 *	\return				The number of objects
+	 */
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	virtual PxU32						getObjects(const PrunerPayload*& payloads, const PxBounds3*& bounds) const = 0;
+
 	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	/**
 	 *	Preallocate space 
@@ -240,6 +273,13 @@ public:
 	 */
 	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	virtual bool						prepareBuild() = 0;	
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/** 
+	 * Sets the dispatcher used by the full rebuilds and the bucket pruner updates happening in commit(), NULL to build on the calling thread only
+	 */
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	virtual void						setBuildDispatcher(PxCpuDispatcher* dispatcher) = 0;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -249,6 +289,13 @@ public:
 //////////////////////////////////////////////////////////////////////////
 IncrementalPruner* createAABBPruner(bool incrementalRebuild);
 
+//////////////////////////////////////////////////////////////////////////
+/**
+*	Creates IncrementalAABBPruner, whose tree is updated in place by each add, update or remove
+*/
+//////////////////////////////////////////////////////////////////////////
+Pruner* createIncrementalAABBPruner();
+
 }
 
 }
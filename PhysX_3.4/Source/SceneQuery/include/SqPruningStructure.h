@@ -41,6 +41,8 @@
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 	namespace Sq
 	{				
 		class AABBTreeRuntimeNode;
@@ -79,7 +81,7 @@ namespace physx
 													PruningStructure();
 													~PruningStructure();
 
-							bool					build(PxRigidActor*const* actors, PxU32 nbActors);			
+							bool					build(PxRigidActor*const* actors, PxU32 nbActors, PxCpuDispatcher* dispatcher);			
 
 			PX_FORCE_INLINE	PxU32					getNbActors()									const	{ return mNbActors;						}
 			PX_FORCE_INLINE	PxActor*const*			getActors()										const	{ return mActors;						}
@@ -35,6 +35,7 @@
 
 #include "PxSceneDesc.h"
 #include "CmBitMap.h"
+#include "CmHierarchicalBitMap.h"
 #include "PsArray.h"
 #include "SqPruner.h"
 #include "PsMutex.h"
@@ -42,6 +43,7 @@
 #include "ScbActor.h" // needed for offset table
 // threading
 #include "PsSync.h"
+#include "task/PxTask.h"
 
 namespace physx
 {
@@ -69,6 +71,8 @@ namespace Sq
 	struct ActorShape;
 	struct PrunerPayload;
 	class Pruner;
+	class SnapshotPruner;
+	class SceneQueryManager;
 
 	struct OffsetTable
 	{
@@ -87,7 +91,7 @@ namespace Sq
 														PrunerExt();
 														~PrunerExt();
 
-						void							init(PxPruningStructureType::Enum type, PxU64 contextID);
+						void							init(PxPruningStructureType::Enum type, PxU64 contextID, bool backgroundRebuild, bool quantizedTree);
 						void							flushMemory();
 						void							preallocate(PxU32 nbShapes);
 						void							flushShapes(PxU32 index);
@@ -98,6 +102,8 @@ namespace Sq
 						void							growDirtyList(PrunerHandle handle);
 
 		PX_FORCE_INLINE	PxPruningStructureType::Enum	type()			const	{ return mPrunerType;	}
+		// true for AABB trees rebuilt by the build steps, false for AABB trees rebuilt in the background
+		PX_FORCE_INLINE	bool							progressive()	const	{ return mPrunerType==PxPruningStructureType::eDYNAMIC_AABB_TREE && !mBackgroundRebuild;	}
 		PX_FORCE_INLINE	const Pruner*					pruner()		const	{ return mPruner;		}
 		PX_FORCE_INLINE	Pruner*							pruner()				{ return mPruner;		}
 		PX_FORCE_INLINE PxU32							timestamp()		const	{ return mTimestamp;	}
@@ -109,15 +115,43 @@ namespace Sq
 						Ps::Array<PrunerHandle>			mDirtyList;
 						PxPruningStructureType::Enum	mPrunerType;
 						PxU32							mTimestamp;
+						bool							mBackgroundRebuild;
 
 						PX_NOCOPY(PrunerExt)
 
 		friend class SceneQueryManager;
 	};
 
+	// Immutable view of the scene query pruners, published by SceneQueryManager::publishSnapshot(). A snapshot returned by
+	// SceneQueryManager::acquireSnapshot() stays valid until it is given back to SceneQueryManager::releaseSnapshot().
+	struct SceneQuerySnapshot
+	{
+		const Pruner*	pruners[PruningIndex::eCOUNT];
+		PxU32			version;	// incremented each time a new snapshot is published
+	};
+
+	// Rebuilds the static AABB tree, see PxSceneFlag::eENABLE_BACKGROUND_STATIC_TREE_REBUILD
+	class StaticTreeRebuildTask : public PxBaseTask
+	{
+	public:
+										StaticTreeRebuildTask() : mOwner(NULL)	{}
+
+		virtual void					run();
+		virtual const char*				getName() const { return "SceneQuery.staticTreeRebuild"; }
+
+		// the task is owned by SceneQueryManager and never shared, so there is nothing to count
+		virtual void					addReference()			{}
+		virtual void					removeReference()		{}
+		virtual PxI32					getReference() const	{ return 1; }
+
+		virtual void					release();
+
+				SceneQueryManager*		mOwner;
+	};
+
 	struct DynamicBoundsSync : public Sc::SqBoundsSync
 	{
-		virtual void sync(const PrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds, PxU32 count, const Cm::BitMap& dirtyShapeSimMap);
+		virtual void sync(const PrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds, PxU32 count, const Cm::HierarchicalBitMap& dirtyShapeSimMap);
 		Pruner*	mPruner;
 		PxU32*	mTimestamp;
 	};
@@ -128,10 +162,14 @@ namespace Sq
 	public:
 														SceneQueryManager(Scb::Scene& scene, PxPruningStructureType::Enum staticStructure, 
 															PxPruningStructureType::Enum dynamicStructure, PxU32 dynamicTreeRebuildRateHint,
-															const PxSceneLimits& limits);
+															const PxSceneLimits& limits, bool useSnapshots, bool backgroundStaticRebuild, bool quantizedStaticTree);
 														~SceneQueryManager();
 
 						PrunerData						addPrunerShape(const NpShape& shape, const PxRigidActor& actor, bool dynamic, const PxBounds3* bounds=NULL, bool hasPrunerStructure = false);
+		// adds the shapes to the same pruner with a single addObjects() call. The bounds are the uninflated world bounds, with one
+		// more readable entry at the end for the SIMD loads.
+						void							addPrunerShapes(PxU32 nbShapes, const NpShape*const* shapes, const PxRigidActor*const* actors, const PxBounds3* bounds,
+															bool dynamic, PrunerData* results, bool hasPrunerStructure = false);
 						void							removePrunerShape(PrunerData shapeData);
 						const PrunerPayload&			getPayload(PrunerData shapeData) const;
 
@@ -146,7 +184,8 @@ namespace Sq
 						void							markForUpdate(PrunerData s);
 						void							setDynamicTreeRebuildRateHint(PxU32 dynTreeRebuildRateHint);
 						
-						void							flushUpdates();
+						// a dispatcher lets the pruner commits use its worker threads. Only pass one when called from a thread that is not one of them.
+						void							flushUpdates(PxCpuDispatcher* dispatcher = NULL);
 						void							forceDynamicTreeRebuild(bool rebuildStaticStructure, bool rebuildDynamicStructure);
 						void							sceneQueryBuildStep(PruningIndex::Enum index);
 
@@ -160,6 +199,12 @@ namespace Sq
 						void							shiftOrigin(const PxVec3& shift);
 
 						void							flushMemory();
+
+		// Snapshots. publishSnapshot() must be called from the thread modifying the scene, acquire/release from any thread.
+		PX_FORCE_INLINE	bool							usesSnapshots()					const	{ return mUseSnapshots;		}
+						void							publishSnapshot();
+						const SceneQuerySnapshot*		acquireSnapshot()				const;
+						void							releaseSnapshot(const SceneQuerySnapshot* snapshot)	const;
 	private:
 						PrunerExt						mPrunerExt[PruningIndex::eCOUNT];
 
@@ -174,7 +219,25 @@ namespace Sq
 
 						volatile bool					mPrunerNeedsUpdating;
 
+						// two snapshot slots: queries read the published one while the other one is rebuilt
+						SceneQuerySnapshot				mSnapshots[2];
+						SnapshotPruner*					mSnapshotPruners[2][PruningIndex::eCOUNT];
+						PxU32							mSnapshotTimestamps[2][PruningIndex::eCOUNT];	// source pruner timestamps when the slot was built
+		mutable	volatile PxI32							mSnapshotReaders[2];
+						volatile PxI32					mSnapshotIndex;		// published slot, -1 before the first publication
+						PxU32							mSnapshotVersion;
+						bool							mUseSnapshots;
+
+						// background rebuild of the static tree. mStaticRebuildDone is set when no task is running
+						StaticTreeRebuildTask			mStaticRebuildTask;
+						Ps::Sync						mStaticRebuildDone;
+						bool							mStaticRebuildRunning;
+
 						void							flushShapes();
+						void							launchStaticRebuild();
+						void							finishStaticRebuild(bool waitForTask);
+
+		friend class StaticTreeRebuildTask;
 
 	};
 
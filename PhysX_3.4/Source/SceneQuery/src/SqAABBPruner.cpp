@@ -41,6 +41,7 @@
 #include "GuBox.h"
 #include "GuCapsule.h"
 #include "SqAABBTreeQuery.h"
+#include "SqQuantizedAABBTreeQuery.h"
 #include "GuBounds.h"
 
 using namespace physx;
@@ -60,8 +61,9 @@ IncrementalPruner* physx::Sq::createAABBPruner(bool incrementalRebuild)
 // PT: currently limited to 15 max
 #define NB_OBJECTS_PER_NODE	4
 
-AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID) :
+AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID, bool backgroundRebuild, bool quantizedTree) :
 	mAABBTree			(NULL),
+	mQuantizedTree		(NULL),
 	mNewTree			(NULL),
 	mCachedBoxes		(NULL),
 	mNbCachedBoxes		(0),
@@ -71,11 +73,14 @@ AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID) :
 	mProgress			(BUILD_NOT_STARTED),
 	mRebuildRateHint	(100),
 	mAdaptiveRebuildTerm(0),
-	mIncrementalRebuild	(incrementalRebuild),
+	mIncrementalRebuild	(incrementalRebuild || backgroundRebuild),
+	mBackgroundRebuild	(backgroundRebuild),
+	mQuantize			(quantizedTree && !incrementalRebuild && !backgroundRebuild),
 	mUncommittedChanges	(false),
 	mNeedsNewTree		(false),
 	mNewTreeFixups		(PX_DEBUG_EXP("AABBPruner::mNewTreeFixups")),
-	mContextID			(contextID)
+	mContextID			(contextID),
+	mBuildDispatcher	(NULL)
 {
 }
 
@@ -261,13 +266,22 @@ void AABBPruner::removeObjects(const PrunerHandle* handles, PxU32 count)
  */
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+template<class Test>
+PxAgain AABBPruner::overlapTree(const Test& test, PrunerCallback& pcb) const
+{
+	if(mAABBTree)
+		return AABBTreeOverlap<Test, AABBTree, AABBTreeRuntimeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, test, pcb);
+	else
+		return QuantizedAABBTreeOverlap<Test>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mQuantizedTree, test, pcb);
+}
+
 PxAgain AABBPruner::overlap(const ShapeData& queryVolume, PrunerCallback& pcb) const
 {
 	PX_ASSERT(!mUncommittedChanges);
 
 	PxAgain again = true;
 
-	if(mAABBTree)
+	if(mAABBTree || mQuantizedTree)
 	{
 		switch(queryVolume.getType())
 		{
@@ -276,12 +290,12 @@ PxAgain AABBPruner::overlap(const ShapeData& queryVolume, PrunerCallback& pcb) c
 				if(queryVolume.isOBB())
 				{	
 					const Gu::OBBAABBTest test(queryVolume.getPrunerWorldPos(), queryVolume.getPrunerWorldRot33(), queryVolume.getPrunerBoxGeomExtentsInflated());
-					again = AABBTreeOverlap<Gu::OBBAABBTest, AABBTree, AABBTreeRuntimeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, test, pcb);
+					again = overlapTree(test, pcb);
 				}
 				else
 				{
 					const Gu::AABBAABBTest test(queryVolume.getPrunerInflatedWorldAABB());
-					again = AABBTreeOverlap<Gu::AABBAABBTest, AABBTree, AABBTreeRuntimeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, test, pcb);
+					again = overlapTree(test, pcb);
 				}
 			}
 			break;
@@ -290,20 +304,20 @@ PxAgain AABBPruner::overlap(const ShapeData& queryVolume, PrunerCallback& pcb) c
 				const Gu::Capsule& capsule = queryVolume.getGuCapsule();
 				const Gu::CapsuleAABBTest test(	capsule.p1, queryVolume.getPrunerWorldRot33().column0,
 												queryVolume.getCapsuleHalfHeight()*2.0f, PxVec3(capsule.radius*SQ_PRUNER_INFLATION));
-				again = AABBTreeOverlap<Gu::CapsuleAABBTest, AABBTree, AABBTreeRuntimeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, test, pcb);
+				again = overlapTree(test, pcb);
 			}
 			break;
 		case PxGeometryType::eSPHERE:
 			{
 				const Gu::Sphere& sphere = queryVolume.getGuSphere();
 				Gu::SphereAABBTest test(sphere.center, sphere.radius);
-				again = AABBTreeOverlap<Gu::SphereAABBTest, AABBTree, AABBTreeRuntimeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, test, pcb);
+				again = overlapTree(test, pcb);
 			}
 			break;
 		case PxGeometryType::eCONVEXMESH:
 			{
 				const Gu::OBBAABBTest test(queryVolume.getPrunerWorldPos(), queryVolume.getPrunerWorldRot33(), queryVolume.getPrunerBoxGeomExtentsInflated());
-				again = AABBTreeOverlap<Gu::OBBAABBTest, AABBTree, AABBTreeRuntimeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, test, pcb);			
+				again = overlapTree(test, pcb);			
 			}
 			break;
 		case PxGeometryType::ePLANE:
@@ -321,17 +335,134 @@ PxAgain AABBPruner::overlap(const ShapeData& queryVolume, PrunerCallback& pcb) c
 	return again;
 }
 
+namespace
+{
+	// Queries of one test type, gathered for a single AABBTreeMultiOverlap traversal
+	template<class Test>
+	struct OverlapTestGroup
+	{
+		PX_ALIGN(16, PxU8	mTests[sizeof(Test)*MAX_MULTI_OVERLAP_QUERIES]);
+		PrunerCallback*		mCallbacks[MAX_MULTI_OVERLAP_QUERIES];
+		PxU32				mIndices[MAX_MULTI_OVERLAP_QUERIES];
+		PxU32				mNb;
+
+		OverlapTestGroup() : mNb(0)	{}
+
+		// returns the storage for the next test, to be constructed in place
+		PX_FORCE_INLINE void* add(PxU32 queryIndex, PrunerCallback* pcb)
+		{
+			PX_ASSERT(mNb<MAX_MULTI_OVERLAP_QUERIES);
+			mIndices[mNb] = queryIndex;
+			mCallbacks[mNb] = pcb;
+			return mTests + sizeof(Test)*mNb++;
+		}
+
+		void run(const PrunerPayload* objects, const PxBounds3* boxes, const AABBTree& tree, PxAgain* again)
+		{
+			if(!mNb)
+				return;
+
+			PxAgain groupAgain[MAX_MULTI_OVERLAP_QUERIES];
+			AABBTreeMultiOverlap<Test, AABBTree, AABBTreeRuntimeNode>()(objects, boxes, tree, reinterpret_cast<const Test*>(mTests), mNb, mCallbacks, groupAgain);
+			for(PxU32 i=0;i<mNb;i++)
+				again[mIndices[i]] = groupAgain[i];
+			mNb = 0;
+		}
+	};
+}
+
+void AABBPruner::overlapMultiple(PxU32 nbQueries, const ShapeData* const* queryVolumes, PrunerCallback* const* pcbs, PxAgain* again) const
+{
+	PX_ASSERT(!mUncommittedChanges);
+
+	// the quantized tree has no grouped traversal, its nodes are already 4-wide
+	if(!mAABBTree)
+	{
+		Pruner::overlapMultiple(nbQueries, queryVolumes, pcbs, again);
+		return;
+	}
+
+	const PrunerPayload* objects = mPool.getObjects();
+	const PxBounds3* boxes = mPool.getCurrentWorldBoxes();
+
+	OverlapTestGroup<AABBAABBTest>		aabbTests;
+	OverlapTestGroup<OBBAABBTest>		obbTests;
+	OverlapTestGroup<CapsuleAABBTest>	capsuleTests;
+	OverlapTestGroup<SphereAABBTest>	sphereTests;
+
+	for(PxU32 base=0; base<nbQueries; base+=MAX_MULTI_OVERLAP_QUERIES)
+	{
+		const PxU32 nb = PxMin<PxU32>(nbQueries - base, MAX_MULTI_OVERLAP_QUERIES);
+		for(PxU32 j=0;j<nb;j++)
+		{
+			const PxU32 i = base + j;
+			const ShapeData& queryVolume = *queryVolumes[i];
+			again[i] = true;
+			switch(queryVolume.getType())
+			{
+			case PxGeometryType::eBOX:
+				{
+					if(queryVolume.isOBB())
+						PX_PLACEMENT_NEW(obbTests.add(i, pcbs[i]), OBBAABBTest)(queryVolume.getPrunerWorldPos(), queryVolume.getPrunerWorldRot33(), queryVolume.getPrunerBoxGeomExtentsInflated());
+					else
+						PX_PLACEMENT_NEW(aabbTests.add(i, pcbs[i]), AABBAABBTest)(queryVolume.getPrunerInflatedWorldAABB());
+				}
+				break;
+			case PxGeometryType::eCAPSULE:
+				{
+					const Gu::Capsule& capsule = queryVolume.getGuCapsule();
+					PX_PLACEMENT_NEW(capsuleTests.add(i, pcbs[i]), CapsuleAABBTest)(capsule.p1, queryVolume.getPrunerWorldRot33().column0,
+													queryVolume.getCapsuleHalfHeight()*2.0f, PxVec3(capsule.radius*SQ_PRUNER_INFLATION));
+				}
+				break;
+			case PxGeometryType::eSPHERE:
+				{
+					const Gu::Sphere& sphere = queryVolume.getGuSphere();
+					PX_PLACEMENT_NEW(sphereTests.add(i, pcbs[i]), SphereAABBTest)(sphere.center, sphere.radius);
+				}
+				break;
+			case PxGeometryType::eCONVEXMESH:
+				PX_PLACEMENT_NEW(obbTests.add(i, pcbs[i]), OBBAABBTest)(queryVolume.getPrunerWorldPos(), queryVolume.getPrunerWorldRot33(), queryVolume.getPrunerBoxGeomExtentsInflated());
+				break;
+			case PxGeometryType::ePLANE:
+			case PxGeometryType::eTRIANGLEMESH:
+			case PxGeometryType::eHEIGHTFIELD:
+			case PxGeometryType::eGEOMETRY_COUNT:
+			case PxGeometryType::eINVALID:
+				PX_ALWAYS_ASSERT_MESSAGE("unsupported overlap query volume geometry type");
+			}
+		}
+
+		aabbTests.run(objects, boxes, *mAABBTree, again);
+		obbTests.run(objects, boxes, *mAABBTree, again);
+		capsuleTests.run(objects, boxes, *mAABBTree, again);
+		sphereTests.run(objects, boxes, *mAABBTree, again);
+	}
+
+	if(mIncrementalRebuild && mBucketPruner.getNbObjects())
+	{
+		for(PxU32 i=0;i<nbQueries;i++)
+		{
+			if(again[i])
+				again[i] = mBucketPruner.overlap(*queryVolumes[i], *pcbs[i]);
+		}
+	}
+}
+
 PxAgain AABBPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback& pcb) const
 {
 	PX_ASSERT(!mUncommittedChanges);
 
 	PxAgain again = true;
 
-	if(mAABBTree)
+	if(mAABBTree || mQuantizedTree)
 	{
 		const PxBounds3& aabb = queryVolume.getPrunerInflatedWorldAABB();
 		const PxVec3 extents = aabb.getExtents();
-		again = AABBTreeRaycast<true, AABBTree, AABBTreeRuntimeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, aabb.getCenter(), unitDir, inOutDistance, extents, pcb);
+		if(mAABBTree)
+			again = AABBTreeRaycast<true, AABBTree, AABBTreeRuntimeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, aabb.getCenter(), unitDir, inOutDistance, extents, pcb);
+		else
+			again = QuantizedAABBTreeRaycast<true>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mQuantizedTree, aabb.getCenter(), unitDir, inOutDistance, extents, pcb);
 	}
 
 	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
@@ -348,6 +479,8 @@ PxAgain AABBPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal&
 
 	if(mAABBTree)
 		again = AABBTreeRaycast<false, AABBTree, AABBTreeRuntimeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
+	else if(mQuantizedTree)
+		again = QuantizedAABBTreeRaycast<false>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mQuantizedTree, origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
 		
 	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
 		again = mBucketPruner.raycast(origin, unitDir, inOutDistance, pcb);
@@ -397,7 +530,7 @@ void AABBPruner::commit()
 	if(!mAABBTree || !mIncrementalRebuild)
 	{
 #if PX_CHECKED
-		if(!mIncrementalRebuild && mAABBTree)
+		if(!mIncrementalRebuild && (mAABBTree || mQuantizedTree))
 			Ps::getFoundation().error(PxErrorCode::ePERF_WARNING, __FILE__, __LINE__, "SceneQuery static AABB Tree rebuilt, because a shape attached to a static actor was added, removed or moved, and PxSceneDesc::staticStructure is set to eSTATIC_AABB_TREE.");
 #endif
 		fullRebuildAABBTree();
@@ -513,6 +646,9 @@ void AABBPruner::shiftOrigin(const PxVec3& shift)
 	if(mAABBTree)
 		mAABBTree->shiftOrigin(shift);
 
+	if(mQuantizedTree)
+		mQuantizedTree->shiftOrigin(shift);
+
 	if(mIncrementalRebuild)
 		mBucketPruner.shiftOrigin(shift);
 
@@ -543,6 +679,22 @@ void AABBPruner::visualize(Cm::RenderOutput& out, PxU32 color) const
 		out << color;
 		Local::_Draw(tree->getNodes(), tree->getNodes(), out);
 	}
+	else if(mQuantizedTree)
+	{
+		out << PxTransform(PxIdentity);
+		out << color;
+		const QuantizedAABBTreeNode* nodes = mQuantizedTree->getNodes();
+		const PxU32 nbNodes = mQuantizedTree->getNbNodes();
+		for(PxU32 i=0;i<nbNodes;i++)
+		{
+			for(PxU32 j=0;j<4 && nodes[i].isValid(j);j++)
+			{
+				PxBounds3 bounds;
+				mQuantizedTree->getChildBounds(nodes[i], j, bounds);
+				out << Cm::DebugBox(bounds, true);
+			}
+		}
+	}
 
 	// Render added objects not yet in the tree
 	out << PxTransform(PxIdentity);
@@ -726,6 +878,45 @@ bool AABBPruner::prepareBuild()
 }
 
 
+bool AABBPruner::startBackgroundBuild()
+{
+	PX_ASSERT(mBackgroundRebuild);
+
+	// The first tree is built by commit(), we only rebuild existing trees in the background
+	if(!mAABBTree || mProgress!=BUILD_NOT_STARTED || !prepareBuild())
+		return false;
+
+	// From now on and until finishBackgroundBuild() the new tree, the cached boxes and the build params belong to backgroundBuild()
+	mProgress = BUILD_IN_PROGRESS;
+	mNbCalls = 0;
+	return true;
+}
+
+void AABBPruner::backgroundBuild()
+{
+	PX_PROFILE_ZONE("SceneQuery.prunerBackgroundBuild", mContextID);
+
+	PX_ASSERT(mBackgroundRebuild && mProgress==BUILD_IN_PROGRESS);
+
+	mNewTree->progressiveBuild(mBuilder, mBuildStats, 0, 0);
+	while(mNewTree->progressiveBuild(mBuilder, mBuildStats, 1, PX_MAX_U32));
+}
+
+void AABBPruner::finishBackgroundBuild()
+{
+	PX_PROFILE_ZONE("SceneQuery.prunerFinishBackgroundBuild", mContextID);
+
+	PX_ASSERT(mBackgroundRebuild && mProgress==BUILD_IN_PROGRESS);
+#if PX_DEBUG
+	mNewTree->validate();
+#endif
+
+	// Remap, fully refit and tag the new tree so that the next commit() switches to it. No other steps happen
+	// in between the remaining states, so the delay introduced by BUILD_LAST_FRAME is not needed here.
+	mProgress = BUILD_NEW_MAPPING;
+	while(!buildStep(true));
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /**
  *	Builds an AABB-tree for objects in the pruning pool.
@@ -738,6 +929,7 @@ bool AABBPruner::fullRebuildAABBTree()
 
 	// Release possibly already existing tree
 	PX_DELETE_AND_RESET(mAABBTree);
+	PX_DELETE_AND_RESET(mQuantizedTree);
 
 	// Don't bother building an AABB-tree if there isn't a single static object
 	const PxU32 nbObjects = mPool.getNbActiveObjects();
@@ -753,13 +945,28 @@ bool AABBPruner::fullRebuildAABBTree()
 		TB.mNbPrimitives	= nbObjects;
 		TB.mAABBArray		= mPool.getCurrentWorldBoxes();
 		TB.mLimit			= NB_OBJECTS_PER_NODE;
-		Status = mAABBTree->build(TB);
+		Status = mAABBTree->build(TB, mBuildDispatcher);
 	}
 
 	// No need for the tree map for static pruner
 	if(mIncrementalRebuild)
 		mTreeMap.initMap(PxMax(nbObjects,mNbCachedBoxes),*mAABBTree);
 
+	// Static pruner trees are never refit, so we can replace them with the compact version
+	if(Status && mQuantize)
+	{
+		mQuantizedTree = PX_NEW(QuantizedAABBTree);
+		Status = mQuantizedTree->build(*mAABBTree);
+		if(Status)
+		{
+			PX_DELETE_AND_RESET(mAABBTree);
+		}
+		else
+		{
+			PX_DELETE_AND_RESET(mQuantizedTree);
+		}
+	}
+
 	return Status;
 }
 
@@ -769,7 +976,7 @@ void AABBPruner::updateBucketPruner()
 	PX_PROFILE_ZONE("SceneQuery.prunerUpdateBucketPruner", mContextID);
 
 	PX_ASSERT(mIncrementalRebuild);
-	mBucketPruner.build();
+	mBucketPruner.build(mBuildDispatcher);
 }
 
 PxBounds3 AABBPruner::getAABB(PrunerHandle handle)
@@ -790,6 +997,7 @@ void AABBPruner::release() // this can be called from purge()
 	mBuilder.reset();
 	PX_DELETE_AND_RESET(mNewTree);
 	PX_DELETE_AND_RESET(mAABBTree);
+	PX_DELETE_AND_RESET(mQuantizedTree);
 
 	mNbCachedBoxes = 0;
 	mProgress = BUILD_NOT_STARTED;
@@ -818,8 +1026,8 @@ void AABBPruner::refitUpdatedAndRemoved()
 	if(!nbObjects)
 		return;
 
-	mBucketPruner.refitMarkedNodes(mPool.getCurrentWorldBoxes());
-	tree->refitMarkedNodes(mPool.getCurrentWorldBoxes());
+	mBucketPruner.refitMarkedNodes(mPool.getCurrentWorldBoxes(), mBuildDispatcher);
+	tree->refitMarkedNodes(mPool.getCurrentWorldBoxes(), mBuildDispatcher);
 }
 
 void AABBPruner::merge(const void* mergeParams)
@@ -34,6 +34,7 @@
 #include "SqExtendedBucketPruner.h"
 #include "SqAABBTreeUpdateMap.h"
 #include "SqAABBTree.h"
+#include "SqQuantizedAABBTree.h"
 
 namespace physx
 {
@@ -121,10 +122,15 @@ namespace Sq
 	// queries can be issued on multiple threads after commit is called
 	// commit, buildStep, add/remove/update have to be called from the same thread or otherwise strictly serialized by external code
 	// and cannot be issued while a query is running
+	// In background rebuild mode the BUILD_INIT and BUILD_IN_PROGRESS states are executed in one go by backgroundBuild(), which
+	// only touches the new tree and the cached boxes and can therefore run on another thread between startBackgroundBuild() and
+	// finishBackgroundBuild(). The remaining states are executed by finishBackgroundBuild(), and the switch happens in the next commit().
+	// In quantized mode (static pruner only) each full rebuild converts the new tree to a QuantizedAABBTree and releases it. Queries
+	// then run on the quantized tree, and pruning structures are not merged since there is no regular tree to merge them into.
 	class AABBPruner : public IncrementalPruner
 	{
 		public:
-												AABBPruner(bool incrementalRebuild, PxU64 contextID); // true is equivalent to former dynamic pruner
+												AABBPruner(bool incrementalRebuild, PxU64 contextID, bool backgroundRebuild = false, bool quantizedTree = false); // true is equivalent to former dynamic pruner
 		virtual									~AABBPruner();
 
 		// Pruner
@@ -135,9 +141,16 @@ namespace Sq
 		virtual			void					commit();
 		virtual			PxAgain					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback&)	const;
 		virtual			PxAgain					overlap(const Gu::ShapeData& queryVolume, PrunerCallback&)	const;
+		virtual			void					overlapMultiple(PxU32 nbQueries, const Gu::ShapeData* const* queryVolumes, PrunerCallback* const* pcbs, PxAgain* again)	const;
 		virtual			PxAgain					sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback&)	const;
 		virtual			const PrunerPayload&	getPayload(PrunerHandle handle)						const	{ return mPool.getPayload(handle);			}
 		virtual			const PrunerPayload&	getPayload(PrunerHandle handle, PxBounds3*& bounds)	const	{ return mPool.getPayload(handle, bounds);	}
+		virtual			PxU32					getObjects(const PrunerPayload*& payloads, const PxBounds3*& bounds)	const
+												{
+													payloads = mPool.getObjects();
+													bounds = mPool.getCurrentWorldBoxes();
+													return mPool.getNbActiveObjects();
+												}
 		virtual			void					preallocate(PxU32 entries)									{ mPool.preallocate(entries);				}
 		virtual			void					shiftOrigin(const PxVec3& shift);
 		virtual			void					visualize(Cm::RenderOutput& out, PxU32 color) const;		
@@ -149,8 +162,15 @@ namespace Sq
 		virtual			void					setRebuildRateHint(PxU32 nbStepsForRebuild);	// Besides the actual rebuild steps, 3 additional steps are needed.
 		virtual			bool					buildStep(bool synchronousCall = true);	// returns true if finished
 		virtual			bool					prepareBuild();	// returns true if new tree is needed
+		virtual			void					setBuildDispatcher(PxCpuDispatcher* dispatcher)	{ mBuildDispatcher = dispatcher;	}
 		//~IncrementalPruner
 
+		// Background rebuild mode
+		PX_FORCE_INLINE	bool					isBackgroundRebuild()	const	{ return mBackgroundRebuild;	}
+						bool					startBackgroundBuild();	// returns true if backgroundBuild() must be called
+						void					backgroundBuild();		// can be called from any thread
+						void					finishBackgroundBuild();	// to call once backgroundBuild() returned
+
 		// direct access for test code
 
 		PX_FORCE_INLINE	PxU32					getNbAddedObjects()	const		{ return mBucketPruner.getNbObjects();					}
@@ -158,11 +178,14 @@ namespace Sq
 		PX_FORCE_INLINE	Sq::AABBTree*			getAABBTree()					{ PX_ASSERT(!mUncommittedChanges); return mAABBTree;	}
 		PX_FORCE_INLINE	void					setAABBTree(Sq::AABBTree* tree)	{ mAABBTree = tree; }
 		PX_FORCE_INLINE	const Sq::AABBTree*		hasAABBTree()		const		{ return mAABBTree;	}
+		PX_FORCE_INLINE	const QuantizedAABBTree*	getQuantizedTree()	const	{ return mQuantizedTree;	}
 		PX_FORCE_INLINE	BuildStatus				getBuildStatus()	const		{ return mProgress;	}
 				
 		// local functions
 //		private:
 						Sq::AABBTree*			mAABBTree; // current active tree
+		// compact copy of the current tree in quantized mode, mAABBTree is NULL when this is used
+						QuantizedAABBTree*		mQuantizedTree;
 						Sq::AABBTreeBuildParams	mBuilder; // this class deals with the details of the actual tree building
 						BuildStats				mBuildStats;
 
@@ -220,6 +243,13 @@ namespace Sq
 		// bucket pruner is only used with incremental rebuild
 						bool					mIncrementalRebuild;
 
+		// Also only set in the constructor. Implies mIncrementalRebuild, but the new tree is built by backgroundBuild()
+		// instead of buildStep().
+						bool					mBackgroundRebuild;
+
+		// Also only set in the constructor, only for the static pruner. See class comment.
+						bool					mQuantize;
+
 		// A rebuild can be triggered even when the Pruner is not dirty
 		// mUncommittedChanges is set to true in add, remove, update and buildStep
 		// mUncommittedChanges is set to false in commit
@@ -254,12 +284,17 @@ namespace Sq
 
 						PxU64					mContextID;
 
+						PxCpuDispatcher*		mBuildDispatcher;
+
 		// Internal methods
 						bool					fullRebuildAABBTree(); // full rebuild function, used with static pruner mode
 						void					release();
 						void					refitUpdatedAndRemoved();
 						void					updateBucketPruner();
 						PxBounds3				getAABB(PrunerHandle h);
+
+		template<class Test>
+						PxAgain					overlapTree(const Test& test, PrunerCallback& pcb)	const;
 	};
 
 } // namespace Sq
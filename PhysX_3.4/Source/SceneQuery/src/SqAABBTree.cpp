@@ -32,7 +32,9 @@
 
 #include "PsMathUtils.h"
 #include "PsFoundation.h"
+#include "PsInlineArray.h"
 #include "GuInternal.h"
+#include "CmTask.h"
 
 using namespace physx;
 using namespace Sq;
@@ -128,6 +130,7 @@ AABBTree::AABBTree() :
 
 // REFIT
 	mRefitHighestSetWord = 0;
+	mNbMarkedNodes = 0;
 //~REFIT
 }
 
@@ -152,6 +155,7 @@ void AABBTree::release(bool clearRefitMap)
 	if(clearRefitMap)
 		mRefitBitmask.clearAll();
 	mRefitHighestSetWord = 0;
+	mNbMarkedNodes = 0;
 //~REFIT
 }
 
@@ -182,7 +186,7 @@ void AABBTree::shiftIndices(PxU32 offset)
 	}
 }
 
-bool AABBTree::buildInit(AABBTreeBuildParams& params, BuildStats& stats)
+bool AABBTree::buildStart(AABBTreeBuildParams& params, BuildStats& stats)
 {
 	// Checkings
 	const PxU32 nbPrimitives = params.mNbPrimitives;
@@ -202,9 +206,6 @@ bool AABBTree::buildInit(AABBTreeBuildParams& params, BuildStats& stats)
 	for(PxU32 i=0;i<nbPrimitives;i++)
 		mIndices[i] = i;
 
-	// Allocate a pool of nodes
-	mNodeAllocator.init(nbPrimitives, params.mLimit);
-
 	// Compute box centers only once and cache them
 	params.mCache = reinterpret_cast<PxVec3*>(PX_ALLOC(sizeof(PxVec3)*(nbPrimitives+1), "cache"));
 	const float half = 0.5f;
@@ -219,6 +220,16 @@ bool AABBTree::buildInit(AABBTreeBuildParams& params, BuildStats& stats)
 	return true;
 }
 
+bool AABBTree::buildInit(AABBTreeBuildParams& params, BuildStats& stats)
+{
+	if(!buildStart(params, stats))
+		return false;
+
+	// Allocate a pool of nodes
+	mNodeAllocator.init(params.mNbPrimitives, params.mLimit);
+	return true;
+}
+
 void AABBTree::buildEnd(AABBTreeBuildParams& params, BuildStats& stats)
 {
 	PX_FREE_AND_RESET(params.mCache);
@@ -232,8 +243,161 @@ void AABBTree::buildEnd(AABBTreeBuildParams& params, BuildStats& stats)
 	mNodeAllocator.release();
 }
 
-bool AABBTree::build(AABBTreeBuildParams& params)
+// Parallel building
+#define NB_PRIMS_PER_SUBTREE	4096	// Nodes with fewer primitives are not subdivided further by the serial top-down pass
+#define MAX_SUBTREE_DEPTH		6		// Depth at which the top-down pass stops, i.e. at most 2^MAX_SUBTREE_DEPTH subtrees
+#define MAX_NB_TOP_NODES		((2<<MAX_SUBTREE_DEPTH)-1)
+
+namespace
+{
+	struct Subtree : public Ps::UserAllocated
+	{
+		NodeAllocator			mNodes;
+		BuildStats				mStats;
+		AABBTreeRuntimeNode*	mRuntimeNodes;	// flattened subtree, indices relative to its root
+	};
+
+	struct BuildSubtreesJob
+	{
+		AABBTreeBuildParams*	mParams;
+		PxU32*					mIndices;
+		Subtree*				mSubtrees;
+
+		void operator()(PxU32 index)
+		{
+			// PT: subtrees cover disjoint ranges of the indices array, so they can be built independently
+			Subtree& subtree = mSubtrees[index];
+			subtree.mNodes.mPool->_buildHierarchy(*mParams, subtree.mStats, subtree.mNodes, mIndices);
+
+			subtree.mRuntimeNodes = PX_NEW(AABBTreeRuntimeNode)[subtree.mStats.getCount()];
+			flatten(subtree.mNodes, subtree.mRuntimeNodes);
+			subtree.mNodes.release();
+		}
+	};
+}
+
+static void buildTopHierarchy(AABBTreeBuildNode* node, const AABBTreeBuildParams& params, BuildStats& stats, NodeAllocator& allocator, PxU32* const indices, PxU32 depth, Ps::Array<AABBTreeBuildNode*>& subtreeRoots)
 {
+	if(depth==MAX_SUBTREE_DEPTH || node->mNbPrimitives<=NB_PRIMS_PER_SUBTREE)
+	{
+		subtreeRoots.pushBack(node);
+		return;
+	}
+
+	node->subdivide(params, stats, allocator, indices);
+	stats.mTotalPrims += node->mNbPrimitives;
+
+	if(!node->isLeaf())
+	{
+		AABBTreeBuildNode* pos = const_cast<AABBTreeBuildNode*>(node->getPos());
+		buildTopHierarchy(pos, params, stats, allocator, indices, depth+1, subtreeRoots);
+		buildTopHierarchy(pos+1, params, stats, allocator, indices, depth+1, subtreeRoots);
+	}
+}
+
+static PX_FORCE_INLINE void copySubtreeNode(AABBTreeRuntimeNode& dst, const AABBTreeRuntimeNode& src, PxU32 base)
+{
+	dst.mBV = src.mBV;
+	dst.mData = src.isLeaf() ? src.mData : (src.getPosIndex() + base)<<1;
+}
+
+// PT: replays the node allocations of the serial build: the children of a node are allocated when it is subdivided,
+// then the whole positive subtree is built before the negative one. The flattened tree is thus identical to the serial one.
+static void mergeHierarchy(AABBTreeRuntimeNode* PX_RESTRICT dest, PxU32 destIndex, const AABBTreeBuildNode* src, const AABBTreeBuildNode* topNodes,
+							const PxU32* PX_RESTRICT subtreeIndices, const Subtree* PX_RESTRICT subtrees, PxU32& count)
+{
+	const PxU32 subtreeIndex = subtreeIndices[src - topNodes];
+	if(subtreeIndex!=PX_INVALID_U32)
+	{
+		// Local node i>0 is the (i-1)-th node allocated while building the subtree
+		const Subtree& subtree = subtrees[subtreeIndex];
+		const PxU32 nbNodes = subtree.mStats.getCount();
+		const PxU32 base = count - 1;
+		copySubtreeNode(dest[destIndex], subtree.mRuntimeNodes[0], base);
+		for(PxU32 i=1;i<nbNodes;i++)
+			copySubtreeNode(dest[base + i], subtree.mRuntimeNodes[i], base);
+		count += nbNodes - 1;
+		return;
+	}
+
+	dest[destIndex].mBV = src->mBV;
+	if(src->isLeaf())
+	{
+		dest[destIndex].mData = (src->mNodeIndex<<5)|((src->getNbPrimitives()&15)<<1)|1;
+		return;
+	}
+
+	const PxU32 children = count;
+	dest[destIndex].mData = children<<1;
+	count += 2;
+	mergeHierarchy(dest, children, src->getPos(), topNodes, subtreeIndices, subtrees, count);
+	mergeHierarchy(dest, children+1, src->getNeg(), topNodes, subtreeIndices, subtrees, count);
+}
+
+bool AABBTree::buildParallel(AABBTreeBuildParams& params, PxCpuDispatcher* dispatcher)
+{
+	BuildStats stats;
+	if(!buildStart(params, stats))
+		return false;
+
+	// The top of the hierarchy is built serially, in a single slab so that node indices are simple pointer offsets
+	mNodeAllocator.initPool(params.mNbPrimitives, MAX_NB_TOP_NODES);
+	AABBTreeBuildNode* topNodes = mNodeAllocator.mPool;
+
+	Ps::Array<AABBTreeBuildNode*> subtreeRoots;
+	buildTopHierarchy(topNodes, params, stats, mNodeAllocator, mIndices, 0, subtreeRoots);
+	PX_ASSERT(mNodeAllocator.mSlabs.size()==1);
+
+	const PxU32 nbSubtrees = subtreeRoots.size();
+	Subtree* subtrees = PX_NEW(Subtree)[nbSubtrees];
+	PxU32 subtreeIndices[MAX_NB_TOP_NODES];
+	for(PxU32 i=0;i<MAX_NB_TOP_NODES;i++)
+		subtreeIndices[i] = PX_INVALID_U32;
+	for(PxU32 i=0;i<nbSubtrees;i++)
+	{
+		const AABBTreeBuildNode* root = subtreeRoots[i];
+		subtreeIndices[root - topNodes] = i;
+
+		subtrees[i].mNodes.init(root->mNbPrimitives, params.mLimit);
+		subtrees[i].mNodes.mPool->mNodeIndex = root->mNodeIndex;
+		subtrees[i].mStats.setCount(1);
+		subtrees[i].mRuntimeNodes = NULL;
+	}
+
+	BuildSubtreesJob job;
+	job.mParams		= &params;
+	job.mIndices	= mIndices;
+	job.mSubtrees	= subtrees;
+	Cm::runParallelJobs(dispatcher, nbSubtrees, job);
+
+	PX_FREE_AND_RESET(params.mCache);
+
+	mTotalNbNodes	= stats.getCount();
+	mTotalPrims		= stats.mTotalPrims;
+	for(PxU32 i=0;i<nbSubtrees;i++)
+	{
+		mTotalNbNodes	+= subtrees[i].mStats.getCount() - 1;
+		mTotalPrims		+= subtrees[i].mStats.mTotalPrims;
+	}
+
+	mRuntimePool = PX_NEW(AABBTreeRuntimeNode)[mTotalNbNodes];
+	PxU32 count = 1;
+	mergeHierarchy(mRuntimePool, 0, topNodes, topNodes, subtreeIndices, subtrees, count);
+	PX_ASSERT(count==mTotalNbNodes);
+
+	for(PxU32 i=0;i<nbSubtrees;i++)
+		PX_DELETE_ARRAY(subtrees[i].mRuntimeNodes);
+	PX_DELETE_ARRAY(subtrees);
+	mNodeAllocator.release();
+	return true;
+}
+//~Parallel building
+
+bool AABBTree::build(AABBTreeBuildParams& params, PxCpuDispatcher* dispatcher)
+{
+	if(dispatcher && params.mNbPrimitives>NB_PRIMS_PER_SUBTREE)
+		return buildParallel(params, dispatcher);
+
 	// Init stats
 	BuildStats stats;
 	if(!buildInit(params, stats))
@@ -492,6 +656,7 @@ void AABBTree::markNodeForRefit(TreeNodeIndex nodeIndex)
 		else
 		{
 			mRefitBitmask.setBit(currentIndex);
+			mNbMarkedNodes++;
 			const PxU32 currentMarkedWord = currentIndex>>5;
 			mRefitHighestSetWord = PxMax(mRefitHighestSetWord, currentMarkedWord);
 
@@ -504,13 +669,113 @@ void AABBTree::markNodeForRefit(TreeNodeIndex nodeIndex)
 	}
 }
 
+// Below this number of marked nodes the refit is done serially
+#define NB_NODES_PER_PARALLEL_REFIT	4096
+
+namespace
+{
+	// Refits the marked nodes of one subtree below the cut made by refitMarkedNodesParallel()
+	struct RefitSubtreesJob
+	{
+		const BitArray*			mRefitBitmask;
+		const PxU32*			mSubtreeRoots;
+		const PxBounds3*		mBoxes;
+		const PxU32*			mIndices;
+		AABBTreeRuntimeNode*	mNodeBase;
+
+		void operator()(PxU32 subtreeIndex)
+		{
+			// Collect the marked nodes breadth-first: children always come after their parent, so walking the list backwards
+			// refits bottom-up
+			Ps::InlineArray<PxU32, 256> nodes;
+			nodes.pushBack(mSubtreeRoots[subtreeIndex]);
+			for(PxU32 i=0;i<nodes.size();i++)
+			{
+				const AABBTreeRuntimeNode* node = mNodeBase + nodes[i];
+				if(node->isLeaf())
+					continue;
+
+				const PxU32 posIndex = node->getPosIndex();
+				const PxU32 negIndex = node->getNegIndex();
+				if(mRefitBitmask->isSet(posIndex))
+					nodes.pushBack(posIndex);
+				if(mRefitBitmask->isSet(negIndex))
+					nodes.pushBack(negIndex);
+			}
+
+			PxU32 i = nodes.size();
+			while(i--)
+				refitNode(mNodeBase + nodes[i], mBoxes, mIndices, mNodeBase);
+		}
+	};
+}
+
+void AABBTree::refitMarkedNodesParallel(const PxBounds3* boxes, PxCpuDispatcher* dispatcher)
+{
+	AABBTreeRuntimeNode* const nodeBase = mRuntimePool;
+
+	// Cut the marked part of the tree breadth-first until there are a few subtrees per thread. The nodes above the cut are
+	// refit on this thread once all subtrees are done. The root is always marked when any node is.
+	PX_ASSERT(mRefitBitmask.isSet(0));
+	const PxU32 nbSubtreesTarget = (PxMin(dispatcher->getWorkerCount(), 31u) + 1) * 4;
+
+	Ps::InlineArray<PxU32, 256> topNodes;
+	Ps::InlineArray<PxU32, 256> subtreeRoots;
+	Ps::InlineArray<PxU32, 256> frontier;
+	frontier.pushBack(0);
+	PxU32 head = 0;
+	while(head<frontier.size() && frontier.size() - head + subtreeRoots.size() < nbSubtreesTarget)
+	{
+		const PxU32 index = frontier[head++];
+		const AABBTreeRuntimeNode* node = nodeBase + index;
+		if(node->isLeaf())
+		{
+			subtreeRoots.pushBack(index);
+			continue;
+		}
+
+		topNodes.pushBack(index);
+		const PxU32 posIndex = node->getPosIndex();
+		const PxU32 negIndex = node->getNegIndex();
+		if(mRefitBitmask.isSet(posIndex))
+			frontier.pushBack(posIndex);
+		if(mRefitBitmask.isSet(negIndex))
+			frontier.pushBack(negIndex);
+	}
+	for(PxU32 i=head;i<frontier.size();i++)
+		subtreeRoots.pushBack(frontier[i]);
+
+	RefitSubtreesJob job;
+	job.mRefitBitmask	= &mRefitBitmask;
+	job.mSubtreeRoots	= subtreeRoots.begin();
+	job.mBoxes			= boxes;
+	job.mIndices		= mIndices;
+	job.mNodeBase		= nodeBase;
+	Cm::runParallelJobs(dispatcher, subtreeRoots.size(), job);
+
+	PxU32 i = topNodes.size();
+	while(i--)
+		refitNode(nodeBase + topNodes[i], boxes, mIndices, nodeBase);
+
+	// The jobs share bitmap words, so the bits are only cleared once they are all done
+	PxMemZero(const_cast<PxU32*>(mRefitBitmask.getBits()), sizeof(PxU32)*(mRefitHighestSetWord+1));
+	mRefitHighestSetWord = 0;
+	mNbMarkedNodes = 0;
+}
+
 #define FIRST_VERSION
 #ifdef FIRST_VERSION
-void AABBTree::refitMarkedNodes(const PxBounds3* boxes)
+void AABBTree::refitMarkedNodes(const PxBounds3* boxes, PxCpuDispatcher* dispatcher)
 {
 	if(!mRefitBitmask.getBits())
 		return;	// No refit needed
 
+	if(dispatcher && dispatcher->getWorkerCount() && mNbMarkedNodes>=NB_NODES_PER_PARALLEL_REFIT)
+	{
+		refitMarkedNodesParallel(boxes, dispatcher);
+		return;
+	}
+
 	{
 		/*const*/ PxU32* bits = const_cast<PxU32*>(mRefitBitmask.getBits());
 		PxU32 size = mRefitHighestSetWord+1;
@@ -558,6 +823,7 @@ void AABBTree::refitMarkedNodes(const PxBounds3* boxes)
 		}
 
 		mRefitHighestSetWord = 0;
+		mNbMarkedNodes = 0;
 //		mRefitBitmask.clearAll();
 	}
 }
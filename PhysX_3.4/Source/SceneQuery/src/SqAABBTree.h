@@ -41,6 +41,8 @@
 namespace physx
 {
 
+class PxCpuDispatcher;
+
 using namespace shdfnd::aos;
 
 namespace Sq
@@ -187,8 +189,8 @@ namespace Sq
 		public:
 													AABBTree();													
 													~AABBTree();
-		// Build
-						bool						build(AABBTreeBuildParams& params);
+		// Build. With a dispatcher, large trees are built in parallel. The result is the same as for a serial build.
+						bool						build(AABBTreeBuildParams& params, PxCpuDispatcher* dispatcher = NULL);
 		// Progressive building
 						PxU32						progressiveBuild(AABBTreeBuildParams& params, BuildStats& stats, PxU32 progress, PxU32 limit);
 		//~Progressive building
@@ -230,8 +232,10 @@ namespace Sq
 	// Progressive building
 						FIFOStack*					mStack;
 	//~Progressive building
+						bool						buildStart(AABBTreeBuildParams& params, BuildStats& stats);
 						bool						buildInit(AABBTreeBuildParams& params, BuildStats& stats);
 						void						buildEnd(AABBTreeBuildParams& params, BuildStats& stats);
+						bool						buildParallel(AABBTreeBuildParams& params, PxCpuDispatcher* dispatcher);
 
 		// tree merge							
 						void						mergeRuntimeNode(AABBTreeRuntimeNode& targetNode, const AABBTreeMergeData& tree, PxU32 targetNodeIndex);
@@ -245,10 +249,15 @@ namespace Sq
 		// adds node[index] to a list of nodes to refit when refitMarkedNodes is called
 		// Note that this includes updating the hierarchy up the chain
 						void						markNodeForRefit(TreeNodeIndex nodeIndex);
-						void						refitMarkedNodes(const PxBounds3* boxes);
+		// With a dispatcher, large refits are split over its worker threads. Only pass one when called from a thread
+		// that is not one of them.
+						void						refitMarkedNodes(const PxBounds3* boxes, PxCpuDispatcher* dispatcher = NULL);
 		private:
+						void						refitMarkedNodesParallel(const PxBounds3* boxes, PxCpuDispatcher* dispatcher);
+
 						BitArray					mRefitBitmask; //!< bit is set for each node index in markForRefit
 						PxU32						mRefitHighestSetWord;
+						PxU32						mNbMarkedNodes;	//!< number of bits set in mRefitBitmask
 		//~REFIT
 	};
 
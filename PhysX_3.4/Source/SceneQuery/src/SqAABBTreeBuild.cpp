@@ -64,14 +64,19 @@ void NodeAllocator::init(PxU32 nbPrimitives, PxU32 limit)
 {
 	const PxU32 maxSize = nbPrimitives * 2 - 1;	// PT: max possible #nodes for a complete tree
 	const PxU32 estimatedFinalSize = maxSize <= 1024 ? maxSize : maxSize / limit;
-	mPool = PX_NEW(AABBTreeBuildNode)[estimatedFinalSize];
-	PxMemZero(mPool, sizeof(AABBTreeBuildNode)*estimatedFinalSize);
+	initPool(nbPrimitives, estimatedFinalSize);
+}
+
+void NodeAllocator::initPool(PxU32 nbPrimitives, PxU32 nbNodes)
+{
+	mPool = PX_NEW(AABBTreeBuildNode)[nbNodes];
+	PxMemZero(mPool, sizeof(AABBTreeBuildNode)*nbNodes);
 
 	// Setup initial node. Here we have a complete permutation of the app's primitives.
 	mPool->mNodeIndex = 0;
 	mPool->mNbPrimitives = nbPrimitives;
 
-	mSlabs.pushBack(Slab(mPool, 1, estimatedFinalSize));
+	mSlabs.pushBack(Slab(mPool, 1, nbNodes));
 	mCurrentSlabIndex = 0;
 	mTotalNbNodes = 1;
 }
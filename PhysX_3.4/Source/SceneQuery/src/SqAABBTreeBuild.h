@@ -137,6 +137,7 @@ namespace physx
 
 			void						release();
 			void						init(PxU32 nbPrimitives, PxU32 limit);
+			void						initPool(PxU32 nbPrimitives, PxU32 nbNodes);	// same as init() with a user-defined initial number of nodes
 			AABBTreeBuildNode*			getBiNode();
 
 			AABBTreeBuildNode*			mPool;
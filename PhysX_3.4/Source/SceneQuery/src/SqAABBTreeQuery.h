@@ -32,6 +32,7 @@
 
 #include "SqAABBTree.h"
 #include "SqPrunerTestsSIMD.h"
+#include "PsBitUtils.h"
 
 namespace physx
 {
@@ -122,6 +123,114 @@ namespace physx
 
 		//////////////////////////////////////////////////////////////////////////
 
+		#define MAX_MULTI_OVERLAP_QUERIES 32
+
+		// Runs up to MAX_MULTI_OVERLAP_QUERIES overlap tests of the same type in a single traversal. Each stack entry carries
+		// the mask of the queries still touching the node, so a subtree is fetched once for the whole group. A query whose
+		// callback returns false is dropped from all further tests and gets again[i] = false, the others get true.
+		template<typename Test, typename Tree, typename Node>
+		class AABBTreeMultiOverlap
+		{
+			struct StackEntry
+			{
+				const Node*	node;
+				PxU32		mask;
+			};
+
+		public:
+			void operator()(const PrunerPayload* objects, const PxBounds3* boxes, const Tree& tree, const Test* tests, PxU32 nbTests, PrunerCallback* const* visitors, PxAgain* again)
+			{
+				using namespace Cm;
+				PX_ASSERT(nbTests && nbTests <= MAX_MULTI_OVERLAP_QUERIES);
+
+				PxU32 alive = nbTests == 32 ? 0xffffffff : (1u<<nbTests)-1;
+				for(PxU32 i=0;i<nbTests;i++)
+					again[i] = true;
+
+				Ps::InlineArray<StackEntry, RAW_TRAVERSAL_STACK_SIZE> stack;
+				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				const Node* const nodeBase = tree.getNodes();
+				stack[0].node = nodeBase;
+				stack[0].mask = alive;
+				PxU32 stackIndex = 1;
+
+				while (stackIndex > 0 && alive)
+				{
+					--stackIndex;
+					const Node* node = stack[stackIndex].node;
+					PxU32 mask = stack[stackIndex].mask;
+					for(;;)
+					{
+						Vec3V center, extents;
+						node->getAABBCenterExtentsV(&center, &extents);
+
+						PxU32 nodeMask = 0;
+						PxU32 remaining = mask & alive;
+						while(remaining)
+						{
+							const PxU32 i = Ps::lowestSetBit(remaining);
+							remaining &= remaining - 1;
+							if(tests[i](center, extents))
+								nodeMask |= 1u<<i;
+						}
+						if(!nodeMask)
+							break;
+
+						if (node->isLeaf())
+						{
+							PxU32 nbPrims = node->getNbPrimitives();
+							const bool doBoxTest = nbPrims > 1;
+							const PxU32* prims = node->getPrimitives(tree.getIndices());
+							while (nbPrims--)
+							{
+								const PoolIndex poolIndex = *prims++;
+
+								Vec3V primCenter = center, primExtents = extents;
+								if (doBoxTest)
+								{
+									Vec4V center2, extents2;
+									getBoundsTimesTwo(center2, extents2, boxes, poolIndex);
+
+									const FloatV halfV = FLoad(0.5f);
+									primCenter = Vec3V_From_Vec4V(V4Scale(center2, halfV));
+									primExtents = Vec3V_From_Vec4V(V4Scale(extents2, halfV));
+								}
+
+								PxU32 primMask = nodeMask & alive;
+								while(primMask)
+								{
+									const PxU32 i = Ps::lowestSetBit(primMask);
+									primMask &= primMask - 1;
+									if (doBoxTest && !tests[i](primCenter, primExtents))
+										continue;
+
+									PxReal unusedDistance;
+									if (!visitors[i]->invoke(unusedDistance, objects[poolIndex]))
+									{
+										alive &= ~(1u<<i);
+										again[i] = false;
+									}
+								}
+							}
+							break;
+						}
+
+						const Node* children = node->getPos(nodeBase);
+
+						node = children;
+						mask = nodeMask;
+						stack[stackIndex].node = children + 1;
+						stack[stackIndex].mask = nodeMask;
+						stackIndex++;
+						if(stackIndex == stack.capacity())
+							stack.resizeUninitialized(stack.capacity() * 2);
+					}
+				}
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////////////
+
 		template <bool tInflate, typename Tree, typename Node> // use inflate=true for sweeps, inflate=false for raycasts
 		static PX_FORCE_INLINE bool doLeafTest(const Node* node, Gu::RayAABBTest& test, PxReal& md, PxReal oldMaxDist,
 			const PrunerPayload* objects, const PxBounds3* boxes, const Tree& tree,
@@ -39,6 +39,7 @@
 #include "PsBitUtils.h"
 #include "PsIntrinsics.h"
 #include "GuBounds.h"
+#include "CmTask.h"
 
 using namespace physx::shdfnd::aos;
 
@@ -79,6 +80,7 @@ TODO:
 #define USE_SIMD				// Use SIMD code or not (sanity performance check)
 #define NODE_SORT				// Enable/disable node sorting
 #define NODE_SORT_MIN_COUNT	16	// Limit above which node sorting is performed
+#define PARALLEL_CLASSIFY_MIN_COUNT	4096	// Limit above which classifyBoxes uses the build dispatcher, if any
 #if PX_INTEL_FAMILY
 	#if COMPILE_VECTOR_INTRINSICS
 		#define CAN_USE_MOVEMASK
@@ -323,6 +325,34 @@ void BucketPrunerNode::classifyBoxes(	float limitX, float limitYZ,
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Classifies the boxes of child 'i' of 'bucket' into the 5 children of 'childBucket'. The scratch buffers must hold
+// bucket.mCounters[i] entries.
+static PX_FORCE_INLINE void processChildBucket(	PxU32 i, const BucketPrunerNode& bucket, BucketPrunerNode& childBucket,
+												BucketBox* PX_RESTRICT baseBucketsBoxes, PrunerPayload* PX_RESTRICT baseBucketsObjects,
+												BucketBox* PX_RESTRICT scratchBoxes, PrunerPayload* PX_RESTRICT scratchObjects,
+												PxU32 sortAxis)
+{
+	const PxU32 nbInBucket = bucket.mCounters[i];
+	if(!nbInBucket)
+	{
+		childBucket.initCounters();
+		return;
+	}
+	BucketBox* bucketsBoxes = baseBucketsBoxes + bucket.mOffsets[i];
+	PrunerPayload* bucketsObjects = baseBucketsObjects + bucket.mOffsets[i];
+
+	const PxU32 yz = PxU32(sortAxis == 1 ? 2 : 1);
+	const float limitX = bucket.mBucketBox[i].mCenter.x;
+	const float limitYZ = bucket.mBucketBox[i].mCenter[yz];
+	const bool isCrossBucket = i==4;
+	childBucket.classifyBoxes(limitX, limitYZ, nbInBucket, bucketsBoxes, bucketsObjects,
+		scratchBoxes, scratchObjects,
+		isCrossBucket, sortAxis);
+
+	PxMemCopy(bucketsBoxes, scratchBoxes, sizeof(BucketBox)*nbInBucket);
+	PxMemCopy(bucketsObjects, scratchObjects, sizeof(PrunerPayload)*nbInBucket);
+}
+
 static void processChildBuckets(PxU32 nbAllocated,
 								BucketBox* sortedBoxesInBucket, PrunerPayload* sortedObjectsInBucket,
 								const BucketPrunerNode& bucket, BucketPrunerNode* PX_RESTRICT childBucket,
@@ -331,31 +361,38 @@ static void processChildBuckets(PxU32 nbAllocated,
 {
 	PX_UNUSED(nbAllocated);
 
-	const PxU32 yz = PxU32(sortAxis == 1 ? 2 : 1);
 	for(PxU32 i=0;i<5;i++)
 	{
-		const PxU32 nbInBucket = bucket.mCounters[i];
-		if(!nbInBucket)
-		{
-			childBucket[i].initCounters();
-			continue;
-		}
-		BucketBox* bucketsBoxes = baseBucketsBoxes + bucket.mOffsets[i];
-		PrunerPayload* bucketsObjects = baseBucketsObjects + bucket.mOffsets[i];
-		PX_ASSERT(nbInBucket<=nbAllocated);
-
-		const float limitX = bucket.mBucketBox[i].mCenter.x;
-		const float limitYZ = bucket.mBucketBox[i].mCenter[yz];
-		const bool isCrossBucket = i==4;
-		childBucket[i].classifyBoxes(limitX, limitYZ, nbInBucket, bucketsBoxes, bucketsObjects,
-			sortedBoxesInBucket, sortedObjectsInBucket,
-			isCrossBucket, sortAxis);
-
-		PxMemCopy(bucketsBoxes, sortedBoxesInBucket, sizeof(BucketBox)*nbInBucket);
-		PxMemCopy(bucketsObjects, sortedObjectsInBucket, sizeof(PrunerPayload)*nbInBucket);
+		PX_ASSERT(bucket.mCounters[i]<=nbAllocated);
+		processChildBucket(i, bucket, childBucket[i], baseBucketsBoxes, baseBucketsObjects, sortedBoxesInBucket, sortedObjectsInBucket, sortAxis);
 	}
 }
 
+// Parallel version of the processChildBuckets() calls in classifyBoxes(). Job j processes child j%5 of parent j/5, whose
+// boxes are contiguous and disjoint from the other jobs' boxes. Each job uses the part of the temp buffers that mirrors
+// its range in the sorted arrays as scratch memory, so jobs never share data.
+struct ProcessChildBucketJob
+{
+	const BucketPrunerNode*	mParents;
+	const BucketWord*		mParentOffsets;	// offset of each parent's boxes in the sorted arrays, NULL for the root
+	BucketPrunerNode*		mChildren;		// 5 children per parent
+	BucketBox*				mSortedBoxes;
+	PrunerPayload*			mSortedObjects;
+	BucketBox*				mTempBoxes;
+	PrunerPayload*			mTempObjects;
+	PxU32					mSortAxis;
+
+	void operator()(PxU32 jobIndex)
+	{
+		const PxU32 parentIndex = jobIndex/5;
+		const PxU32 i = jobIndex%5;
+		const BucketPrunerNode& parent = mParents[parentIndex];
+		const PxU32 parentOffset = mParentOffsets ? mParentOffsets[parentIndex] : 0;
+		const PxU32 offset = parentOffset + parent.mOffsets[i];
+		processChildBucket(i, parent, mChildren[jobIndex], mSortedBoxes + parentOffset, mSortedObjects + parentOffset, mTempBoxes + offset, mTempObjects + offset, mSortAxis);
+	}
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static PX_FORCE_INLINE PxU32 encodeFloat(PxU32 newPos)
@@ -1047,7 +1084,7 @@ static void gPrecomputeSort(BucketPrunerNode& node, const PxVec3* PX_RESTRICT di
 }
 #endif
 
-void BucketPrunerCore::classifyBoxes()
+void BucketPrunerCore::classifyBoxes(PxCpuDispatcher* dispatcher)
 {
 	if(!mDirty)
 		return;
@@ -1131,14 +1168,36 @@ for(PxU32 i=0;i<nb;i++)
 		sortedBoxes, sortedObjects,
 		false, mSortAxis);
 
-	processChildBuckets(nb, tempBoxes, tempObjects,
-		mLevel1, mLevel2, mSortedWorldBoxes, mSortedObjects,
-		mSortAxis);
-
-	for(PxU32 j=0;j<5;j++)
+	if(dispatcher && nb>=PARALLEL_CLASSIFY_MIN_COUNT)
+	{
+		ProcessChildBucketJob job;
+		job.mSortedBoxes	= mSortedWorldBoxes;
+		job.mSortedObjects	= mSortedObjects;
+		job.mTempBoxes		= tempBoxes;
+		job.mTempObjects	= tempObjects;
+		job.mSortAxis		= mSortAxis;
+
+		job.mParents		= &mLevel1;
+		job.mParentOffsets	= NULL;
+		job.mChildren		= mLevel2;
+		Cm::runParallelJobs(dispatcher, 5, job);
+
+		job.mParents		= mLevel2;
+		job.mParentOffsets	= mLevel1.mOffsets;
+		job.mChildren		= &mLevel3[0][0];
+		Cm::runParallelJobs(dispatcher, 25, job);
+	}
+	else
+	{
 		processChildBuckets(nb, tempBoxes, tempObjects,
-		mLevel2[j], mLevel3[j], mSortedWorldBoxes + mLevel1.mOffsets[j], mSortedObjects + mLevel1.mOffsets[j],
-		mSortAxis);
+			mLevel1, mLevel2, mSortedWorldBoxes, mSortedObjects,
+			mSortAxis);
+
+		for(PxU32 j=0;j<5;j++)
+			processChildBuckets(nb, tempBoxes, tempObjects,
+			mLevel2[j], mLevel3[j], mSortedWorldBoxes + mLevel1.mOffsets[j], mSortedObjects + mLevel1.mOffsets[j],
+			mSortAxis);
+	}
 
 	{
 		for(PxU32 i=0;i<nb;i++)
@@ -200,7 +200,8 @@ namespace Sq
 
 						void				visualize(Cm::RenderOutput& out, PxU32 color) const;
 
-		PX_FORCE_INLINE	void				build()					{ classifyBoxes();	}
+		// the dispatcher, if any, splits the classification of large sets over its worker threads. The calling thread must not be one of them.
+		PX_FORCE_INLINE	void				build(PxCpuDispatcher* dispatcher=NULL)	{ classifyBoxes(dispatcher);	}
 
 		PX_FORCE_INLINE	PxU32				getNbObjects()	const	{ return mNbFree + mCoreNbObjects;	}
 
@@ -233,7 +234,7 @@ namespace Sq
 						bool				mDirty;
 						bool				mOwnMemory;
 		private:
-						void				classifyBoxes();
+						void				classifyBoxes(PxCpuDispatcher* dispatcher);
 						void				allocateSortedMemory(PxU32 nb);
 						void				resizeCore();
 		PX_FORCE_INLINE void				addObjectInternal(const PrunerPayload& object, const PxBounds3& worldAABB, PxU32 timeStamp);
@@ -260,6 +261,12 @@ namespace Sq
 		virtual	PxAgain					sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback&) const;
 		virtual	const PrunerPayload&	getPayload(PrunerHandle handle)						const	{ return mPool.getPayload(handle);			}
 		virtual	const PrunerPayload&	getPayload(PrunerHandle handle, PxBounds3*& bounds)	const	{ return mPool.getPayload(handle, bounds);	}
+		virtual	PxU32					getObjects(const PrunerPayload*& payloads, const PxBounds3*& bounds) const
+										{
+											payloads = mPool.getObjects();
+											bounds = mPool.getCurrentWorldBoxes();
+											return mPool.getNbActiveObjects();
+										}
 		virtual	void					preallocate(PxU32 entries)									{ mPool.preallocate(entries);				}
 		virtual	void					shiftOrigin(const PxVec3& shift);
 		virtual	void					visualize(Cm::RenderOutput& out, PxU32 color) const;
@@ -34,6 +34,7 @@
 #include "SqAABBTreeQuery.h"
 #include "GuBounds.h"
 #include "CmBitMap.h"
+#include "CmTask.h"
 
 using namespace physx;
 using namespace Sq;
@@ -265,7 +266,25 @@ bool ExtendedBucketPruner::updateObject(const PxBounds3& worldAABB, const Pruner
 //		and create new main AABB tree
 // 3. If all merged trees bounds are valid - refit main tree
 // 4. If bounds are invalid create new main AABB tree
-void ExtendedBucketPruner::refitMarkedNodes(const PxBounds3* boxes)
+namespace
+{
+	// Refits one merged tree per job. Trees are independent and each job only writes its own tree and bounds entry.
+	struct RefitMergedTreeJob
+	{
+		MergedTree*			mMergedTrees;
+		PxBounds3*			mBounds;
+		const PxBounds3*	mBoxes;
+
+		void operator()(PxU32 i)
+		{
+			AABBTree& tree = *mMergedTrees[i].mTree;
+			tree.refitMarkedNodes(mBoxes);
+			mBounds[i] = tree.getNodes()[0].mBV;
+		}
+	};
+}
+
+void ExtendedBucketPruner::refitMarkedNodes(const PxBounds3* boxes, PxCpuDispatcher* dispatcher)
 {
 	// if no tree needs update early exit
 	if(!mTreesDirty)
@@ -273,18 +292,35 @@ void ExtendedBucketPruner::refitMarkedNodes(const PxBounds3* boxes)
 
 	// refit trees and update bounds for main tree	
 	PxU32 nbValidTrees = 0;
-	for (PxU32 i = mCurrentTreeIndex; i--; )
-	{
-		AABBTree& tree = *mMergedTrees[i].mTree;
-		tree.refitMarkedNodes(boxes);
-		const PxBounds3& bounds = tree.getNodes()[0].mBV;
-		// check if bounds are valid, if all objects of the tree were released, the bounds 
-		// will be invalid, in that case we cannot use this tree anymore.
-		if(bounds.isValid())
-		{			
-			nbValidTrees++;
+	if(dispatcher && mCurrentTreeIndex>1)
+	{
+		RefitMergedTreeJob job;
+		job.mMergedTrees	= mMergedTrees;
+		job.mBounds			= mBounds;
+		job.mBoxes			= boxes;
+		Cm::runParallelJobs(dispatcher, mCurrentTreeIndex, job);
+
+		for(PxU32 i = 0; i < mCurrentTreeIndex; i++)
+		{
+			if(mBounds[i].isValid())
+				nbValidTrees++;
+		}
+	}
+	else
+	{
+		for (PxU32 i = mCurrentTreeIndex; i--; )
+		{
+			AABBTree& tree = *mMergedTrees[i].mTree;
+			tree.refitMarkedNodes(boxes, dispatcher);
+			const PxBounds3& bounds = tree.getNodes()[0].mBV;
+			// check if bounds are valid, if all objects of the tree were released, the bounds 
+			// will be invalid, in that case we cannot use this tree anymore.
+			if(bounds.isValid())
+			{			
+				nbValidTrees++;
+			}
+			mBounds[i] = bounds;
 		}
-		mBounds[i] = bounds;
 	}
 	
 	if(nbValidTrees == mCurrentTreeIndex)
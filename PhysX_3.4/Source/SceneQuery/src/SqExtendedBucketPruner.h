@@ -134,8 +134,8 @@ namespace Sq
 		// swap object index, the object index can be in core pruner or tree of trees
 		void							swapIndex(PxU32 objectIndex, const PrunerPayload& swapObject, PxU32 swapObjectIndex, bool corePrunerIncluded = true);
 
-		// refit marked nodes in tree of trees
-		void							refitMarkedNodes(const PxBounds3* boxes);
+		// refit marked nodes in tree of trees. The dispatcher, if any, refits the merged trees in parallel. The calling thread must not be one of its workers.
+		void							refitMarkedNodes(const PxBounds3* boxes, PxCpuDispatcher* dispatcher=NULL);
 
 #if USE_INCREMENTAL_PRUNER
 		// notify timestampChange - swap trees in incremental pruner
@@ -158,7 +158,15 @@ namespace Sq
 		// debug visualize
 		void							visualize(Cm::RenderOutput& out, PxU32 color) const;
 
-		PX_FORCE_INLINE	void			build()					{ mPrunerCore.build();	}
+		PX_FORCE_INLINE	void			build(PxCpuDispatcher* dispatcher=NULL)
+		{
+#if USE_INCREMENTAL_PRUNER
+			PX_UNUSED(dispatcher);
+			mPrunerCore.build();
+#else
+			mPrunerCore.build(dispatcher);
+#endif
+		}
 
 		PX_FORCE_INLINE PxU32			getNbObjects()	const	{ return mPrunerCore.getNbObjects() + mExtendedBucketPrunerMap.size(); }
 
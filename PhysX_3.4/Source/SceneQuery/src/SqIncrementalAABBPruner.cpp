@@ -0,0 +1,321 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxProfiler.h"
+#include "PsFoundation.h"
+#include "SqIncrementalAABBPruner.h"
+#include "SqAABBTree.h"
+#include "SqAABBTreeQuery.h"
+#include "GuSphere.h"
+#include "GuBox.h"
+#include "GuCapsule.h"
+#include "GuBounds.h"
+
+using namespace physx;
+using namespace Gu;
+using namespace Sq;
+using namespace Cm;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Pruner* physx::Sq::createIncrementalAABBPruner()
+{
+	return PX_NEW(Sq::IncrementalAABBPruner)(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IncrementalAABBPruner::IncrementalAABBPruner(PxU64 contextID) :
+	mAABBTree	(NULL),
+	mMapping	(PX_DEBUG_EXP("IncrementalAABBPruner::mMapping")),
+	mContextID	(contextID)
+{
+	mChangedLeaves.reserve(32);
+}
+
+IncrementalAABBPruner::~IncrementalAABBPruner()
+{
+	release();
+}
+
+void IncrementalAABBPruner::release()
+{
+	PX_DELETE_AND_RESET(mAABBTree);
+	mMapping.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *	Add, Remove, Update methods
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool IncrementalAABBPruner::addObjects(PrunerHandle* results, const PxBounds3* bounds, const PrunerPayload* payload, PxU32 count, bool)
+{
+	PX_PROFILE_ZONE("SceneQuery.prunerAddObjects", mContextID);
+
+	if(!count)
+		return true;
+
+	const PxU32 nbObjectsBefore = mPool.getNbActiveObjects();
+	const PxU32 valid = mPool.addObjects(results, bounds, payload, count);
+	const PxU32 nbObjects = mPool.getNbActiveObjects();
+	if(mMapping.size() < nbObjects)
+		mMapping.resize(nbObjects, NULL);
+
+	if(!mAABBTree)
+		mAABBTree = PX_NEW(IncrementalAABBTree)();
+
+	if(!mAABBTree->getNodes() && valid>1)
+	{
+		// the pool only contains the new objects, build the tree in one go instead of inserting them one by one
+		PX_ASSERT(!nbObjectsBefore);
+		AABBTreeBuildParams params(NB_OBJECTS_PER_NODE, nbObjects, mPool.getCurrentWorldBoxes());
+		mAABBTree->build(params, mMapping);
+	}
+	else
+	{
+		for(PxU32 i=0; i<valid; i++)
+		{
+			const PoolIndex poolIndex = nbObjectsBefore + i;
+			mChangedLeaves.clear();
+			IncrementalAABBTreeNode* node = mAABBTree->insert(poolIndex, mPool.getCurrentWorldBoxes(), mChangedLeaves);
+			updateMapping(node);
+		}
+	}
+	return valid==count;
+}
+
+void IncrementalAABBPruner::updateObjectsAfterManualBoundsUpdates(const PrunerHandle* handles, PxU32 count)
+{
+	PX_PROFILE_ZONE("SceneQuery.prunerUpdateObjects", mContextID);
+
+	if(!count || !hasTree())
+		return;
+
+	for(PxU32 i=0; i<count; i++)
+		updateObject(mPool.getIndex(handles[i]));
+}
+
+void IncrementalAABBPruner::updateObjectsAndInflateBounds(const PrunerHandle* handles, const PxU32* indices, const PxBounds3* newBounds, PxU32 count)
+{
+	PX_PROFILE_ZONE("SceneQuery.prunerUpdateObjects", mContextID);
+
+	if(!count)
+		return;
+
+	mPool.updateObjectsAndInflateBounds(handles, indices, newBounds, count);
+
+	if(!hasTree())
+		return;
+
+	for(PxU32 i=0; i<count; i++)
+		updateObject(mPool.getIndex(handles[i]));
+}
+
+void IncrementalAABBPruner::removeObjects(const PrunerHandle* handles, PxU32 count)
+{
+	PX_PROFILE_ZONE("SceneQuery.prunerRemoveObjects", mContextID);
+
+	if(!count)
+		return;
+
+	for(PxU32 i=0; i<count; i++)
+	{
+		const PoolIndex poolIndex = mPool.getIndex(handles[i]);
+		const PoolIndex poolRelocatedLastIndex = mPool.removeObject(handles[i]);
+
+		// remove the object from the tree, the remaining objects of its leaf may move to another node
+		mChangedLeaves.clear();
+		IncrementalAABBTreeNode* node = mAABBTree->remove(mMapping[poolIndex], poolIndex, mPool.getCurrentWorldBoxes());
+		updateMapping(node);
+
+		// the last object of the pool has been moved to the removed object's spot
+		if(poolIndex != poolRelocatedLastIndex)
+		{
+			IncrementalAABBTreeNode* relocatedLeaf = mMapping[poolRelocatedLastIndex];
+			mMapping[poolIndex] = relocatedLeaf;
+			mAABBTree->fixupTreeIndices(relocatedLeaf, poolRelocatedLastIndex, poolIndex);
+		}
+		mMapping[poolRelocatedLastIndex] = NULL;
+	}
+
+	// release all the internal data once all the objects are out of the pruner
+	if(!mPool.getNbActiveObjects())
+		release();
+}
+
+void IncrementalAABBPruner::updateObject(PoolIndex poolIndex)
+{
+	mChangedLeaves.clear();
+	IncrementalAABBTreeNode* node = mAABBTree->update(mMapping[poolIndex], poolIndex, mPool.getCurrentWorldBoxes(), mChangedLeaves);
+	updateMapping(node);
+}
+
+void IncrementalAABBPruner::updateMapping(IncrementalAABBTreeNode* node)
+{
+	if(node && node->isLeaf())
+	{
+		for(PxU32 j = 0; j < node->getNbPrimitives(); j++)
+			mMapping[node->getPrimitives(NULL)[j]] = node;
+	}
+
+	for(PxU32 i = 0; i < mChangedLeaves.size(); i++)
+	{
+		IncrementalAABBTreeNode* changedNode = mChangedLeaves[i];
+		PX_ASSERT(changedNode->isLeaf());
+
+		for(PxU32 j = 0; j < changedNode->getNbPrimitives(); j++)
+			mMapping[changedNode->getPrimitives(NULL)[j]] = changedNode;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *	Query Implementation
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+PxAgain IncrementalAABBPruner::overlap(const ShapeData& queryVolume, PrunerCallback& pcb) const
+{
+	PxAgain again = true;
+
+	if(hasTree())
+	{
+		switch(queryVolume.getType())
+		{
+		case PxGeometryType::eBOX:
+			{
+				if(queryVolume.isOBB())
+				{	
+					const Gu::OBBAABBTest test(queryVolume.getPrunerWorldPos(), queryVolume.getPrunerWorldRot33(), queryVolume.getPrunerBoxGeomExtentsInflated());
+					again = AABBTreeOverlap<Gu::OBBAABBTest, IncrementalAABBTree, IncrementalAABBTreeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, test, pcb);
+				}
+				else
+				{
+					const Gu::AABBAABBTest test(queryVolume.getPrunerInflatedWorldAABB());
+					again = AABBTreeOverlap<Gu::AABBAABBTest, IncrementalAABBTree, IncrementalAABBTreeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, test, pcb);
+				}
+			}
+			break;
+		case PxGeometryType::eCAPSULE:
+			{
+				const Gu::Capsule& capsule = queryVolume.getGuCapsule();
+				const Gu::CapsuleAABBTest test(	capsule.p1, queryVolume.getPrunerWorldRot33().column0,
+												queryVolume.getCapsuleHalfHeight()*2.0f, PxVec3(capsule.radius*SQ_PRUNER_INFLATION));
+				again = AABBTreeOverlap<Gu::CapsuleAABBTest, IncrementalAABBTree, IncrementalAABBTreeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, test, pcb);
+			}
+			break;
+		case PxGeometryType::eSPHERE:
+			{
+				const Gu::Sphere& sphere = queryVolume.getGuSphere();
+				Gu::SphereAABBTest test(sphere.center, sphere.radius);
+				again = AABBTreeOverlap<Gu::SphereAABBTest, IncrementalAABBTree, IncrementalAABBTreeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, test, pcb);
+			}
+			break;
+		case PxGeometryType::eCONVEXMESH:
+			{
+				const Gu::OBBAABBTest test(queryVolume.getPrunerWorldPos(), queryVolume.getPrunerWorldRot33(), queryVolume.getPrunerBoxGeomExtentsInflated());
+				again = AABBTreeOverlap<Gu::OBBAABBTest, IncrementalAABBTree, IncrementalAABBTreeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, test, pcb);
+			}
+			break;
+		case PxGeometryType::ePLANE:
+		case PxGeometryType::eTRIANGLEMESH:
+		case PxGeometryType::eHEIGHTFIELD:
+		case PxGeometryType::eGEOMETRY_COUNT:
+		case PxGeometryType::eINVALID:
+			PX_ALWAYS_ASSERT_MESSAGE("unsupported overlap query volume geometry type");
+		}
+	}
+
+	return again;
+}
+
+PxAgain IncrementalAABBPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback& pcb) const
+{
+	PxAgain again = true;
+
+	if(hasTree())
+	{
+		const PxBounds3& aabb = queryVolume.getPrunerInflatedWorldAABB();
+		const PxVec3 extents = aabb.getExtents();
+		again = AABBTreeRaycast<true, IncrementalAABBTree, IncrementalAABBTreeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, aabb.getCenter(), unitDir, inOutDistance, extents, pcb);
+	}
+
+	return again;
+}
+
+PxAgain IncrementalAABBPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback& pcb) const
+{
+	PxAgain again = true;
+
+	if(hasTree())
+		again = AABBTreeRaycast<false, IncrementalAABBTree, IncrementalAABBTreeNode>()(mPool.getObjects(), mPool.getCurrentWorldBoxes(), *mAABBTree, origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
+
+	return again;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *	Other methods of Pruner Interface
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void IncrementalAABBPruner::shiftOrigin(const PxVec3& shift)
+{
+	mPool.shiftOrigin(shift);
+
+	if(mAABBTree)
+		mAABBTree->shiftOrigin(shift);
+}
+
+#include "CmRenderOutput.h"
+void IncrementalAABBPruner::visualize(Cm::RenderOutput& out, PxU32 color) const
+{
+	if(!hasTree())
+		return;
+
+	struct Local
+	{
+		static void _Draw(const IncrementalAABBTreeNode* root, const IncrementalAABBTreeNode* node, Cm::RenderOutput& out_)
+		{
+			PxBounds3 bounds;
+			V4StoreU(node->mBVMin, &bounds.minimum.x);
+			V4StoreU(node->mBVMax, &bounds.maximum.x);
+			out_ << Cm::DebugBox(bounds, true);
+			if (node->isLeaf())
+				return;
+			_Draw(root, node->getPos(root), out_);
+			_Draw(root, node->getNeg(root), out_);
+		}
+	};
+	out << PxTransform(PxIdentity);
+	out << color;
+	Local::_Draw(mAABBTree->getNodes(), mAABBTree->getNodes(), out);
+}
@@ -0,0 +1,96 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef SQ_INCREMENTAL_AABB_PRUNER_H
+#define SQ_INCREMENTAL_AABB_PRUNER_H
+
+#include "SqPruner.h"
+#include "SqPruningPool.h"
+#include "SqIncrementalAABBTree.h"
+
+namespace physx
+{
+
+namespace Sq
+{
+	// This class implements the Pruner interface with a single IncrementalAABBTree. Changes are immediately applied to the tree:
+	// added objects are inserted, removed objects are removed, and updated objects are removed and inserted again. There is no
+	// periodic rebuild and no bucket pruner, which suits sets of objects that change a lot every frame.
+	// commit() has nothing to do, and queries can be issued on multiple threads as long as no object is added, removed or updated.
+	class IncrementalAABBPruner : public Pruner
+	{
+		public:
+												IncrementalAABBPruner(PxU64 contextID);
+		virtual									~IncrementalAABBPruner();
+
+		// Pruner
+		virtual			bool					addObjects(PrunerHandle* results, const PxBounds3* bounds, const PrunerPayload* userData, PxU32 count, bool hasPruningStructure);
+		virtual			void					removeObjects(const PrunerHandle* handles, PxU32 count);
+		virtual			void					updateObjectsAfterManualBoundsUpdates(const PrunerHandle* handles, PxU32 count);
+		virtual			void					updateObjectsAndInflateBounds(const PrunerHandle* handles, const PxU32* indices, const PxBounds3* newBounds, PxU32 count);
+		virtual			void					commit()	{}
+		virtual			PxAgain					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback&)	const;
+		virtual			PxAgain					overlap(const Gu::ShapeData& queryVolume, PrunerCallback&)	const;
+		virtual			PxAgain					sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback&)	const;
+		virtual			const PrunerPayload&	getPayload(PrunerHandle handle)						const	{ return mPool.getPayload(handle);			}
+		virtual			const PrunerPayload&	getPayload(PrunerHandle handle, PxBounds3*& bounds)	const	{ return mPool.getPayload(handle, bounds);	}
+		virtual			PxU32					getObjects(const PrunerPayload*& payloads, const PxBounds3*& bounds)	const
+												{
+													payloads = mPool.getObjects();
+													bounds = mPool.getCurrentWorldBoxes();
+													return mPool.getNbActiveObjects();
+												}
+		virtual			void					preallocate(PxU32 entries)									{ mPool.preallocate(entries);				}
+		virtual			void					shiftOrigin(const PxVec3& shift);
+		virtual			void					visualize(Cm::RenderOutput& out, PxU32 color) const;
+		virtual			void					merge(const void*)	{}	// objects of pruning structures are inserted in addObjects()
+		//~Pruner
+
+		PX_FORCE_INLINE	const IncrementalAABBTree*	getAABBTree()	const	{ return mAABBTree;	}
+
+		private:
+						void					release();
+						void					updateObject(PoolIndex poolIndex);
+						void					updateMapping(IncrementalAABBTreeNode* node);
+						bool					hasTree()	const	{ return mAABBTree && mAABBTree->getNodes();	}
+
+						PruningPool				mPool;
+						IncrementalAABBTree*	mAABBTree;
+		// maps pruning pool indices to the tree leaves containing them
+						NodeList				mMapping;
+		// leaves whose contents changed during the last tree operation
+						NodeList				mChangedLeaves;
+						PxU64					mContextID;
+	};
+
+} // namespace Sq
+
+}
+
+#endif // SQ_INCREMENTAL_AABB_PRUNER_H
@@ -145,7 +145,7 @@ static void getShapeBounds(PxRigidActor* actor, bool dynamic, PxBounds3* bounds,
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PruningStructure::build(PxRigidActor*const* actors, PxU32 nbActors)
+bool PruningStructure::build(PxRigidActor*const* actors, PxU32 nbActors, PxCpuDispatcher* dispatcher)
 {
 	PX_ASSERT(actors);
 	PX_ASSERT(nbActors > 0);
@@ -256,7 +256,7 @@ bool PruningStructure::build(PxRigidActor*const* actors, PxU32 nbActors)
 			sTB.mNbPrimitives = numShapes[i];
 			sTB.mAABBArray = bounds[i];
 			sTB.mLimit = NB_OBJECTS_PER_NODE;
-			bool status = aabbTrees[i].build(sTB);
+			bool status = aabbTrees[i].build(sTB, dispatcher);
 
 			PX_UNUSED(status);
 			PX_ASSERT(status);
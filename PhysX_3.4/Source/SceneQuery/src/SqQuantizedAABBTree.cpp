@@ -0,0 +1,234 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "SqQuantizedAABBTree.h"
+#include "SqAABBTree.h"
+
+#include "foundation/PxMemory.h"
+#include "PsArray.h"
+#include "PsMathUtils.h"
+#include "PsFoundation.h"
+
+using namespace physx;
+using namespace Sq;
+
+#define QUANTIZED_MAX	65535
+
+namespace
+{
+	class QuantizedTreeBuilder
+	{
+		public:
+		QuantizedTreeBuilder(const AABBTreeRuntimeNode* srcNodes, const PxVec3& origin, const PxVec3& scale) :
+			mSrcNodes(srcNodes), mOrigin(origin), mScale(scale), mNbIndices(0)	{}
+
+		PX_FORCE_INLINE	float dequantize(PxU32 value, PxU32 axis) const
+		{
+			return float(value)*mScale[axis] + mOrigin[axis];
+		}
+
+		// Returns a quantized value whose dequantized position is below (or above, for roundUp) the input value
+		PxU32 quantize(float value, PxU32 axis, bool roundUp) const
+		{
+			const float f = (value - mOrigin[axis])/mScale[axis];
+			PxI32 q = PxClamp(PxI32(roundUp ? PxCeil(f) : PxFloor(f)), 0, QUANTIZED_MAX);
+			if(roundUp)
+			{
+				while(q<QUANTIZED_MAX && dequantize(PxU32(q), axis)<value)
+					q++;
+				// One more step of margin, so that bounds remain conservative when shiftOrigin() changes the rounding
+				q = PxMin(q+1, QUANTIZED_MAX);
+			}
+			else
+			{
+				while(q>0 && dequantize(PxU32(q), axis)>value)
+					q--;
+				q = PxMax(q-1, 0);
+			}
+			return PxU32(q);
+		}
+
+		PX_FORCE_INLINE	PxU32 quantizeAxis(const PxBounds3& bounds, PxU32 axis) const
+		{
+			return quantize(bounds.minimum[axis], axis, false) | (quantize(bounds.maximum[axis], axis, true)<<16);
+		}
+
+		// Collapses the binary subtree below srcIndex into 4-wide nodes, and returns the index of the new node
+		PxU32 buildNode(PxU32 srcIndex)
+		{
+			PxU32 children[4];
+			PxU32 nbChildren;
+			const AABBTreeRuntimeNode& src = mSrcNodes[srcIndex];
+			if(src.isLeaf())
+			{
+				// Only happens for a root leaf
+				children[0] = srcIndex;
+				nbChildren = 1;
+			}
+			else
+			{
+				children[0] = src.getPosIndex();
+				children[1] = src.getNegIndex();
+				nbChildren = 2;
+
+				// Keep opening the largest internal child until the node is full
+				while(nbChildren<4)
+				{
+					PxU32 best = 0xffffffff;
+					float bestArea = -1.0f;
+					for(PxU32 i=0;i<nbChildren;i++)
+					{
+						const AABBTreeRuntimeNode& child = mSrcNodes[children[i]];
+						if(child.isLeaf())
+							continue;
+						const PxVec3 e = child.mBV.maximum - child.mBV.minimum;
+						const float area = e.x*e.y + e.y*e.z + e.z*e.x;
+						if(area>bestArea)
+						{
+							bestArea = area;
+							best = i;
+						}
+					}
+					if(best==0xffffffff)
+						break;
+
+					const AABBTreeRuntimeNode& opened = mSrcNodes[children[best]];
+					children[best] = opened.getPosIndex();
+					children[nbChildren++] = opened.getNegIndex();
+				}
+			}
+
+			const PxU32 nodeIndex = mNodes.size();
+			QuantizedAABBTreeNode& node = mNodes.insert();
+			for(PxU32 i=0;i<4;i++)
+			{
+				node.mX[i] = node.mY[i] = node.mZ[i] = 0;
+				node.mData[i] = QUANTIZED_EMPTY_CHILD;
+			}
+
+			for(PxU32 i=0;i<nbChildren;i++)
+			{
+				const AABBTreeRuntimeNode& child = mSrcNodes[children[i]];
+
+				PxU32 data;
+				if(child.isLeaf())
+				{
+					data = child.mData;
+					mNbIndices = PxMax(mNbIndices, (child.mData>>5) + child.getNbPrimitives());
+				}
+				else
+					data = buildNode(children[i])<<1;
+
+				// Not using 'node' here since the recursive call can resize the array
+				QuantizedAABBTreeNode& dst = mNodes[nodeIndex];
+				dst.mX[i] = quantizeAxis(child.mBV, 0);
+				dst.mY[i] = quantizeAxis(child.mBV, 1);
+				dst.mZ[i] = quantizeAxis(child.mBV, 2);
+				dst.mData[i] = data;
+			}
+			return nodeIndex;
+		}
+
+		const AABBTreeRuntimeNode*			mSrcNodes;
+		const PxVec3						mOrigin;
+		const PxVec3						mScale;
+		Ps::Array<QuantizedAABBTreeNode>	mNodes;
+		PxU32								mNbIndices;
+
+		PX_NOCOPY(QuantizedTreeBuilder)
+	};
+}
+
+QuantizedAABBTree::QuantizedAABBTree() :
+	mNodes		(NULL),
+	mIndices	(NULL),
+	mNbNodes	(0),
+	mNbIndices	(0),
+	mOrigin		(0.0f),
+	mScale		(0.0f)
+{
+}
+
+QuantizedAABBTree::~QuantizedAABBTree()
+{
+	release();
+}
+
+void QuantizedAABBTree::release()
+{
+	PX_FREE_AND_RESET(mNodes);
+	PX_FREE_AND_RESET(mIndices);
+	mNbNodes = 0;
+	mNbIndices = 0;
+}
+
+bool QuantizedAABBTree::build(const AABBTree& source)
+{
+	release();
+
+	const AABBTreeRuntimeNode* srcNodes = source.getNodes();
+	if(!srcNodes || !source.getNbNodes())
+		return false;
+
+	// Quantization domain, slightly larger than the root bounds
+	const PxBounds3& rootBounds = srcNodes[0].mBV;
+	const PxVec3 extents = rootBounds.maximum - rootBounds.minimum;
+	const float margin = PxMax(extents.maxElement(), 1.0f) * 1e-4f;
+	mOrigin = rootBounds.minimum - PxVec3(margin);
+	mScale = (extents + PxVec3(margin*2.0f)) * (1.0f/float(QUANTIZED_MAX));
+	for(PxU32 axis=0;axis<3;axis++)
+	{
+		// The largest quantized value must map above the root bounds despite rounding
+		while(float(QUANTIZED_MAX)*mScale[axis] + mOrigin[axis] < rootBounds.maximum[axis])
+			mScale[axis] *= 1.0001f;
+	}
+
+	QuantizedTreeBuilder builder(srcNodes, mOrigin, mScale);
+	builder.mNodes.reserve(source.getNbNodes()/2 + 1);
+	builder.buildNode(0);
+
+	mNbNodes = builder.mNodes.size();
+	mNodes = reinterpret_cast<QuantizedAABBTreeNode*>(PX_ALLOC(sizeof(QuantizedAABBTreeNode)*mNbNodes, "Quantized AABB tree nodes"));
+	PxMemCopy(mNodes, builder.mNodes.begin(), sizeof(QuantizedAABBTreeNode)*mNbNodes);
+
+	mNbIndices = builder.mNbIndices;
+	mIndices = reinterpret_cast<PxU32*>(PX_ALLOC(sizeof(PxU32)*mNbIndices, "Quantized AABB tree indices"));
+	PxMemCopy(mIndices, source.getIndices(), sizeof(PxU32)*mNbIndices);
+	return true;
+}
+
+void QuantizedAABBTree::getChildBounds(const QuantizedAABBTreeNode& node, PxU32 i, PxBounds3& bounds) const
+{
+	bounds.minimum.x = float(node.mX[i] & 0xffff)*mScale.x + mOrigin.x;
+	bounds.minimum.y = float(node.mY[i] & 0xffff)*mScale.y + mOrigin.y;
+	bounds.minimum.z = float(node.mZ[i] & 0xffff)*mScale.z + mOrigin.z;
+	bounds.maximum.x = float(node.mX[i] >> 16)*mScale.x + mOrigin.x;
+	bounds.maximum.y = float(node.mY[i] >> 16)*mScale.y + mOrigin.y;
+	bounds.maximum.z = float(node.mZ[i] >> 16)*mScale.z + mOrigin.z;
+}
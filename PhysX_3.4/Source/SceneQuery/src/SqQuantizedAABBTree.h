@@ -0,0 +1,136 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef SQ_QUANTIZED_AABBTREE_H
+#define SQ_QUANTIZED_AABBTREE_H
+
+#include "foundation/PxBounds3.h"
+#include "PsUserAllocated.h"
+#include "PsVecMath.h"
+#include "SqTypedef.h"
+
+namespace physx
+{
+
+using namespace shdfnd::aos;
+
+namespace Sq
+{
+	class AABBTree;
+
+	#define QUANTIZED_EMPTY_CHILD	0xffffffff
+
+	// 4-wide node of a quantized AABB tree. Child boxes are stored as 16-bit coordinates relative to the tree bounds: the low
+	// 16 bits of mX[i] hold the quantized minimum x of child i, the high 16 bits its quantized maximum x (same for y and z).
+	// mData[i] uses the AABBTreeRuntimeNode::mData encoding, except that internal children store the index of a QuantizedAABBTreeNode.
+	// Unused slots are always at the end of the node and set to QUANTIZED_EMPTY_CHILD.
+	PX_ALIGN_PREFIX(16)
+	struct QuantizedAABBTreeNode
+	{
+		PX_FORCE_INLINE	bool			isValid(PxU32 i)	const	{ return mData[i]!=QUANTIZED_EMPTY_CHILD;	}
+		PX_FORCE_INLINE	PxU32			isLeaf(PxU32 i)		const	{ return mData[i]&1;						}
+		PX_FORCE_INLINE	PxU32			getChildIndex(PxU32 i)	const	{ return mData[i]>>1;					}
+
+						PxU32			mX[4];
+						PxU32			mY[4];
+						PxU32			mZ[4];
+						PxU32			mData[4];
+	}
+	PX_ALIGN_SUFFIX(16);
+
+	PX_COMPILE_TIME_ASSERT(sizeof(QuantizedAABBTreeNode)==64);
+
+	// Children of a QuantizedAABBTreeNode, dequantized in SoA form
+	struct QuantizedAABBTreeChildren
+	{
+		Vec4V	mMinX, mMinY, mMinZ;
+		Vec4V	mMaxX, mMaxY, mMaxZ;
+	};
+
+	// Compact version of an AABBTree, used by the static pruner. It is built from a regular tree by collapsing its nodes into
+	// 4-wide nodes with quantized bounds, and cannot be refit or modified afterwards. Quantized bounds are conservative, i.e. a
+	// child box always contains the corresponding box of the source tree.
+	class QuantizedAABBTree : public Ps::UserAllocated
+	{
+		public:
+													QuantizedAABBTree();
+													~QuantizedAABBTree();
+
+		// Builds the tree from a non-empty source tree. Primitive indices are copied, the source tree can be released afterwards.
+						bool						build(const AABBTree& source);
+						void						release();
+
+		PX_FORCE_INLINE	const PxU32*				getIndices()		const	{ return mIndices;		}
+		PX_FORCE_INLINE	PxU32						getNbNodes()		const	{ return mNbNodes;		}
+		PX_FORCE_INLINE	const QuantizedAABBTreeNode*	getNodes()		const	{ return mNodes;		}
+
+		PX_FORCE_INLINE	void						shiftOrigin(const PxVec3& shift)	{ mOrigin -= shift;	}
+
+		// Dequantizes the 4 children of a node
+		PX_FORCE_INLINE	void						decode(const QuantizedAABBTreeNode& node, QuantizedAABBTreeChildren& children)	const
+													{
+														const VecI32V mask = I4Load(0xffff);
+														const VecShiftV shift = VecI32V_PrepareShift(I4Load(16));
+
+														const VecI32V x = I4LoadA(reinterpret_cast<const PxI32*>(node.mX));
+														const VecI32V y = I4LoadA(reinterpret_cast<const PxI32*>(node.mY));
+														const VecI32V z = I4LoadA(reinterpret_cast<const PxI32*>(node.mZ));
+
+														const Vec4V scaleX = V4Load(mScale.x);
+														const Vec4V scaleY = V4Load(mScale.y);
+														const Vec4V scaleZ = V4Load(mScale.z);
+														const Vec4V originX = V4Load(mOrigin.x);
+														const Vec4V originY = V4Load(mOrigin.y);
+														const Vec4V originZ = V4Load(mOrigin.z);
+
+														children.mMinX = V4MulAdd(Vec4V_From_VecI32V(VecI32V_And(x, mask)), scaleX, originX);
+														children.mMinY = V4MulAdd(Vec4V_From_VecI32V(VecI32V_And(y, mask)), scaleY, originY);
+														children.mMinZ = V4MulAdd(Vec4V_From_VecI32V(VecI32V_And(z, mask)), scaleZ, originZ);
+														children.mMaxX = V4MulAdd(Vec4V_From_VecI32V(VecI32V_RightShift(x, shift)), scaleX, originX);
+														children.mMaxY = V4MulAdd(Vec4V_From_VecI32V(VecI32V_RightShift(y, shift)), scaleY, originY);
+														children.mMaxZ = V4MulAdd(Vec4V_From_VecI32V(VecI32V_RightShift(z, shift)), scaleZ, originZ);
+													}
+
+		// Scalar version of decode(), for a single child
+						void						getChildBounds(const QuantizedAABBTreeNode& node, PxU32 i, PxBounds3& bounds)	const;
+		private:
+						QuantizedAABBTreeNode*		mNodes;
+						PxU32*						mIndices;
+						PxU32						mNbNodes;
+						PxU32						mNbIndices;
+		// A quantized coordinate q is dequantized as mOrigin + q*mScale
+						PxVec3						mOrigin;
+						PxVec3						mScale;
+	};
+
+} // namespace Sq
+
+}
+
+#endif // SQ_QUANTIZED_AABBTREE_H
@@ -0,0 +1,209 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef SQ_QUANTIZED_AABBTREEQUERY_H
+#define SQ_QUANTIZED_AABBTREEQUERY_H
+
+#include "SqQuantizedAABBTree.h"
+#include "SqAABBTreeQuery.h"
+
+namespace physx
+{
+	namespace Sq
+	{
+		// Dequantizes the children of a node, and returns center*2 and extents*2 of each child in AoS form
+		static PX_FORCE_INLINE void getChildBoundsTimesTwo(Vec4V* centers, Vec4V* extents, const QuantizedAABBTree& tree, const QuantizedAABBTreeNode& node)
+		{
+			QuantizedAABBTreeChildren children;
+			tree.decode(node, children);
+
+			centers[0] = V4Add(children.mMaxX, children.mMinX);
+			centers[1] = V4Add(children.mMaxY, children.mMinY);
+			centers[2] = V4Add(children.mMaxZ, children.mMinZ);
+			centers[3] = V4Zero();
+			V4Transpose(centers[0], centers[1], centers[2], centers[3]);
+
+			extents[0] = V4Sub(children.mMaxX, children.mMinX);
+			extents[1] = V4Sub(children.mMaxY, children.mMinY);
+			extents[2] = V4Sub(children.mMaxZ, children.mMinZ);
+			extents[3] = V4Zero();
+			V4Transpose(extents[0], extents[1], extents[2], extents[3]);
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+
+		// Child bounds are only conservative, so unlike AABBTreeOverlap we always test the primitive boxes in leaves
+		template<typename Test>
+		class QuantizedAABBTreeOverlap
+		{
+		public:
+			bool operator()(const PrunerPayload* objects, const PxBounds3* boxes, const QuantizedAABBTree& tree, const Test& test, PrunerCallback& visitor)
+			{
+				Ps::InlineArray<PxU32, RAW_TRAVERSAL_STACK_SIZE> stack;
+				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				const QuantizedAABBTreeNode* const nodeBase = tree.getNodes();
+				stack[0] = 0;
+				PxU32 stackIndex = 1;
+
+				const FloatV halfV = FLoad(0.5f);
+				while (stackIndex > 0)
+				{
+					const QuantizedAABBTreeNode& node = nodeBase[stack[--stackIndex]];
+
+					Vec4V centers[4], extents[4];
+					getChildBoundsTimesTwo(centers, extents, tree, node);
+
+					for(PxU32 i=0; i<4 && node.isValid(i); i++)
+					{
+						if (!test(Vec3V_From_Vec4V(V4Scale(centers[i], halfV)), Vec3V_From_Vec4V(V4Scale(extents[i], halfV))))
+							continue;
+
+						if (!node.isLeaf(i))
+						{
+							stack[stackIndex++] = node.getChildIndex(i);
+							if(stackIndex == stack.capacity())
+								stack.resizeUninitialized(stack.capacity() * 2);
+							continue;
+						}
+
+						const PxU32 data = node.mData[i];
+						PxU32 nbPrims = (data>>1)&15;
+						const PxU32* prims = tree.getIndices() + (data>>5);
+						while (nbPrims--)
+						{
+							const PoolIndex poolIndex = *prims++;
+
+							Vec4V center2, extents2;
+							getBoundsTimesTwo(center2, extents2, boxes, poolIndex);
+							if (!test(Vec3V_From_Vec4V(V4Scale(center2, halfV)), Vec3V_From_Vec4V(V4Scale(extents2, halfV))))
+								continue;
+
+							PxReal unusedDistance;
+							if (!visitor.invoke(unusedDistance, objects[poolIndex]))
+								return false;
+						}
+					}
+				}
+				return true;
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////////////
+
+		// The stack contains child data, i.e. both internal nodes and leaves. Hit children are pushed far-to-near so that the
+		// closest one is visited first.
+		template <bool tInflate> // use inflate=true for sweeps, inflate=false for raycasts
+		class QuantizedAABBTreeRaycast
+		{
+		public:
+			bool operator()(
+				const PrunerPayload* objects, const PxBounds3* boxes, const QuantizedAABBTree& tree,
+				const PxVec3& origin, const PxVec3& unitDir, PxReal& maxDist, const PxVec3& inflation,
+				PrunerCallback& pcb)
+			{
+				// We pass center*2 and extents*2 to the ray-box code, so the test is initialized with values multiplied by 2 as well
+				Gu::RayAABBTest test(origin*2.0f, unitDir*2.0f, maxDist, inflation*2.0f);
+
+				Ps::InlineArray<PxU32, RAW_TRAVERSAL_STACK_SIZE> stack;
+				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				const QuantizedAABBTreeNode* const nodeBase = tree.getNodes();
+				stack[0] = 0;	// internal node 0
+				PxU32 stackIndex = 1;
+
+				while (stackIndex--)
+				{
+					const PxU32 data = stack[stackIndex];
+					if (data & 1)
+					{
+						const PxReal oldMaxDist = maxDist; // we copy since maxDist can be updated in the callback
+						PxU32 nbPrims = (data>>1)&15;
+						const PxU32* prims = tree.getIndices() + (data>>5);
+						while (nbPrims--)
+						{
+							const PoolIndex poolIndex = *prims++;
+
+							Vec4V center2, extents2;
+							getBoundsTimesTwo(center2, extents2, boxes, poolIndex);
+							if (!test.check<tInflate>(Vec3V_From_Vec4V(center2), Vec3V_From_Vec4V(extents2)))
+								continue;
+
+							PxReal md = maxDist;
+							if (!pcb.invoke(md, objects[poolIndex]))
+								return false;
+
+							if (md < oldMaxDist)
+							{
+								maxDist = md;
+								test.setDistance(md);
+							}
+						}
+						continue;
+					}
+
+					const QuantizedAABBTreeNode& node = nodeBase[data>>1];
+
+					Vec4V centers[4], extents[4];
+					getChildBoundsTimesTwo(centers, extents, tree, node);
+
+					PxU32 hits[4];
+					PxReal keys[4];
+					PxU32 nbHits = 0;
+					for(PxU32 i=0; i<4 && node.isValid(i); i++)
+					{
+						const Vec3V c = Vec3V_From_Vec4V(centers[i]);
+						if (!test.check<tInflate>(c, Vec3V_From_Vec4V(extents[i])))
+							continue;
+
+						PxReal key;
+						FStore(V3Dot(c, test.mDir), &key);
+
+						// insertion sort, farthest first
+						PxU32 j = nbHits++;
+						while (j && keys[j-1] < key)
+						{
+							keys[j] = keys[j-1];
+							hits[j] = hits[j-1];
+							j--;
+						}
+						keys[j] = key;
+						hits[j] = node.mData[i];
+					}
+
+					if (stackIndex + nbHits >= stack.capacity())
+						stack.resizeUninitialized(stack.capacity() * 2);
+					for(PxU32 i=0; i<nbHits; i++)
+						stack[stackIndex++] = hits[i];
+				}
+				return true;
+			}
+		};
+	}
+}
+
+#endif   // SQ_QUANTIZED_AABBTREEQUERY_H
@@ -29,7 +29,9 @@
 
 #include "SqSceneQueryManager.h"
 #include "SqAABBPruner.h"
+#include "SqIncrementalAABBPruner.h"
 #include "SqBucketPruner.h"
+#include "SqSnapshotPruner.h"
 #include "SqBounds.h"
 #include "NpBatchQuery.h"
 #include "PxFiltering.h"
@@ -38,11 +40,14 @@
 #include "NpArticulationLink.h"
 #include "CmTransformUtils.h"
 #include "PsAllocator.h"
+#include "PsAtomic.h"
 #include "PxSceneDesc.h"
 #include "ScBodyCore.h"
 #include "SqPruner.h"
 #include "GuBounds.h"
 #include "NpShape.h"
+#include "task/PxCpuDispatcher.h"
+#include "task/PxTaskManager.h"
 
 using namespace physx;
 using namespace Sq;
@@ -60,7 +65,8 @@ PrunerExt::PrunerExt() :
 	mPruner		(NULL),
 	mDirtyList	(PX_DEBUG_EXP("SQmDirtyList")),
 	mPrunerType	(PxPruningStructureType::eLAST),
-	mTimestamp	(0xffffffff)
+	mTimestamp	(0xffffffff),
+	mBackgroundRebuild	(false)
 {
 }
 
@@ -69,16 +75,18 @@ PrunerExt::~PrunerExt()
 	PX_DELETE_AND_RESET(mPruner);
 }
 
-void PrunerExt::init(PxPruningStructureType::Enum type, PxU64 contextID)
+void PrunerExt::init(PxPruningStructureType::Enum type, PxU64 contextID, bool backgroundRebuild, bool quantizedTree)
 {
 	mPrunerType = type;
 	mTimestamp	= 0;
+	mBackgroundRebuild = backgroundRebuild && (type==PxPruningStructureType::eSTATIC_AABB_TREE || type==PxPruningStructureType::eDYNAMIC_AABB_TREE);
 	Pruner* pruner = NULL;
 	switch(type)
 	{
-		case PxPruningStructureType::eNONE:					{ pruner = PX_NEW(BucketPruner);					break;	}
-		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = PX_NEW(AABBPruner)(true, contextID);		break;	}
-		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = PX_NEW(AABBPruner)(false, contextID);	break;	}
+		case PxPruningStructureType::eNONE:					{ pruner = PX_NEW(BucketPruner);										break;	}
+		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = PX_NEW(AABBPruner)(true, contextID, mBackgroundRebuild);		break;	}
+		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = PX_NEW(AABBPruner)(false, contextID, mBackgroundRebuild, quantizedTree);	break;	}
+		case PxPruningStructureType::eINCREMENTAL_AABB_TREE:	{ pruner = PX_NEW(IncrementalAABBPruner)(contextID);						break;	}
 		case PxPruningStructureType::eLAST:					break;
 	}
 	mPruner = pruner;
@@ -177,11 +185,18 @@ void PrunerExt::growDirtyList(PrunerHandle handle)
 
 SceneQueryManager::SceneQueryManager(	Scb::Scene& scene, PxPruningStructureType::Enum staticStructure, 
 										PxPruningStructureType::Enum dynamicStructure, PxU32 dynamicTreeRebuildRateHint,
-										const PxSceneLimits& limits) :
-	mScene		(scene)
+										const PxSceneLimits& limits, bool useSnapshots, bool backgroundStaticRebuild, bool quantizedStaticTree) :
+	mScene					(scene),
+	mSnapshotIndex			(-1),
+	mSnapshotVersion		(0),
+	mUseSnapshots			(useSnapshots),
+	mStaticRebuildRunning	(false)
 {
-	mPrunerExt[PruningIndex::eSTATIC].init(staticStructure, scene.getContextId());
-	mPrunerExt[PruningIndex::eDYNAMIC].init(dynamicStructure, scene.getContextId());
+	mPrunerExt[PruningIndex::eSTATIC].init(staticStructure, scene.getContextId(), backgroundStaticRebuild, quantizedStaticTree);
+	mPrunerExt[PruningIndex::eDYNAMIC].init(dynamicStructure, scene.getContextId(), false, false);
+
+	mStaticRebuildTask.mOwner = this;
+	mStaticRebuildDone.set();
 
 	setDynamicTreeRebuildRateHint(dynamicTreeRebuildRateHint);
 
@@ -191,10 +206,31 @@ SceneQueryManager::SceneQueryManager(	Scb::Scene& scene, PxPruningStructureType:
 	mDynamicBoundsSync.mTimestamp = &mPrunerExt[PruningIndex::eDYNAMIC].mTimestamp;
 
 	mPrunerNeedsUpdating = false;
+
+	for(PxU32 s=0; s<2; s++)
+	{
+		mSnapshotReaders[s] = 0;
+		mSnapshots[s].version = 0;
+		for(PxU32 i=0; i<PruningIndex::eCOUNT; i++)
+		{
+			mSnapshotPruners[s][i] = useSnapshots ? PX_NEW(SnapshotPruner)(scene.getContextId()) : NULL;
+			mSnapshots[s].pruners[i] = mSnapshotPruners[s][i];
+			mSnapshotTimestamps[s][i] = 0xffffffff;
+		}
+	}
 }
 
 SceneQueryManager::~SceneQueryManager()
 {
+	// the task works on the static pruner, which is about to be deleted
+	mStaticRebuildDone.wait();
+
+	for(PxU32 s=0; s<2; s++)
+	{
+		PX_ASSERT(!mSnapshotReaders[s]);
+		for(PxU32 i=0; i<PruningIndex::eCOUNT; i++)
+			PX_DELETE_AND_RESET(mSnapshotPruners[s][i]);
+	}
 }
 
 void SceneQueryManager::flushMemory()
@@ -220,6 +256,7 @@ void SceneQueryManager::preallocate(PxU32 staticShapes, PxU32 dynamicShapes)
 
 PrunerData SceneQueryManager::addPrunerShape(const NpShape& shape, const PxRigidActor& actor, bool dynamic, const PxBounds3* bounds, bool hasPrunerStructure)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eSCENE_QUERY);
 	mPrunerNeedsUpdating = true;
 
 	PrunerPayload pp;
@@ -245,6 +282,42 @@ PrunerData SceneQueryManager::addPrunerShape(const NpShape& shape, const PxRigid
 	return createPrunerData(index, handle);
 }
 
+void SceneQueryManager::addPrunerShapes(PxU32 nbShapes, const NpShape*const* shapes, const PxRigidActor*const* actors, const PxBounds3* bounds,
+										bool dynamic, PrunerData* results, bool hasPrunerStructure)
+{
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eSCENE_QUERY);
+	if(!nbShapes)
+		return;
+
+	mPrunerNeedsUpdating = true;
+
+	Ps::Array<PrunerPayload> payloads;
+	Ps::Array<PxBounds3> inflatedBounds;
+	Ps::Array<PrunerHandle> handles;
+	payloads.resizeUninitialized(nbShapes);
+	inflatedBounds.resizeUninitialized(nbShapes);
+	handles.resizeUninitialized(nbShapes);
+
+	for(PxU32 i=0;i<nbShapes;i++)
+	{
+		payloads[i].data[0] = size_t(&shapes[i]->getScbShape());
+		payloads[i].data[1] = size_t(&gOffsetTable.convertPxActor2Scb(*actors[i]));
+		inflateBounds(inflatedBounds[i], bounds[i]);
+	}
+
+	const PxU32 index = PxU32(dynamic);
+	PX_ASSERT(mPrunerExt[index].pruner());
+	const PxU32 nbAdded = mPrunerExt[index].pruner()->addObjects(handles.begin(), inflatedBounds.begin(), payloads.begin(), nbShapes, hasPrunerStructure) ? nbShapes : 0;
+	PX_UNUSED(nbAdded);
+	mPrunerExt[index].invalidateTimestamp();
+
+	for(PxU32 i=0;i<nbShapes;i++)
+	{
+		mPrunerExt[index].growDirtyList(handles[i]);
+		results[i] = createPrunerData(index, handles[i]);
+	}
+}
+
 const PrunerPayload& SceneQueryManager::getPayload(PrunerData data) const
 {
 	const PxU32 index = getPrunerIndex(data);
@@ -272,7 +345,7 @@ void SceneQueryManager::setDynamicTreeRebuildRateHint(PxU32 rebuildRateHint)
 
 	for(PxU32 i=0;i<PruningIndex::eCOUNT;i++)
 	{
-		if(mPrunerExt[i].pruner() && mPrunerExt[i].type() == PxPruningStructureType::eDYNAMIC_AABB_TREE)
+		if(mPrunerExt[i].pruner() && mPrunerExt[i].progressive())
 			static_cast<AABBPruner*>(mPrunerExt[i].pruner())->setRebuildRateHint(rebuildRateHint);
 	}
 }
@@ -342,6 +415,7 @@ void SceneQueryManager::validateSimUpdates()
 
 void SceneQueryManager::afterSync(PxSceneQueryUpdateMode::Enum updateMode)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eSCENE_QUERY);
 	PX_PROFILE_ZONE("Sim.sceneQueryBuildStep", mScene.getContextId());
 
 	if(updateMode == PxSceneQueryUpdateMode::eBUILD_DISABLED_COMMIT_DISABLED)
@@ -353,17 +427,22 @@ void SceneQueryManager::afterSync(PxSceneQueryUpdateMode::Enum updateMode)
 	// flush user modified objects
 	flushShapes();
 
+	// this is also where a completed background rebuild is picked up, if no query did it before
+	finishStaticRebuild(false);
+
 	bool commit = updateMode == PxSceneQueryUpdateMode::eBUILD_ENABLED_COMMIT_ENABLED;
 
 	for(PxU32 i = 0; i<2; i++)
 	{
-		if(mPrunerExt[i].pruner() && mPrunerExt[i].type() == PxPruningStructureType::eDYNAMIC_AABB_TREE)
+		if(mPrunerExt[i].pruner() && mPrunerExt[i].progressive())
 			static_cast<AABBPruner*>(mPrunerExt[i].pruner())->buildStep(true);
 
 		if(commit)
 			mPrunerExt[i].pruner()->commit();
 	}
 
+	launchStaticRebuild();
+
 	//If we didn't commit changes, then the next query must perform that operation so this bool must be set to true, otherwise there should be 
 	//no outstanding work required by queries at this time
 	mPrunerNeedsUpdating = !commit;
@@ -371,6 +450,7 @@ void SceneQueryManager::afterSync(PxSceneQueryUpdateMode::Enum updateMode)
 
 void SceneQueryManager::flushShapes()
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eSCENE_QUERY);
 	PX_PROFILE_ZONE("SceneQuery.flushShapes", mScene.getContextId());
 
 	// must already have acquired writer lock here
@@ -379,8 +459,9 @@ void SceneQueryManager::flushShapes()
 		mPrunerExt[i].flushShapes(i);
 }
 
-void SceneQueryManager::flushUpdates()
+void SceneQueryManager::flushUpdates(PxCpuDispatcher* dispatcher)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eSCENE_QUERY);
 	PX_PROFILE_ZONE("SceneQuery.flushUpdates", mScene.getContextId());
 
 	if (mPrunerNeedsUpdating)
@@ -395,9 +476,26 @@ void SceneQueryManager::flushUpdates()
 
 			flushShapes();
 
+			finishStaticRebuild(false);
+
 			for (PxU32 i = 0; i < PruningIndex::eCOUNT; i++)
-				if (mPrunerExt[i].pruner())
+			{
+				if (!mPrunerExt[i].pruner())
+					continue;
+
+				// background rebuilds own their pruner's build, so only progressive pruners get the dispatcher
+				if (dispatcher && mPrunerExt[i].progressive())
+				{
+					AABBPruner* pruner = static_cast<AABBPruner*>(mPrunerExt[i].pruner());
+					pruner->setBuildDispatcher(dispatcher);
+					pruner->commit();
+					pruner->setBuildDispatcher(NULL);
+				}
+				else
 					mPrunerExt[i].pruner()->commit();
+			}
+
+			launchStaticRebuild();
 
 			//KS - force memory writes to have completed before updating the volatile mPrunerNeedsUpdating member. This should ensure that, if another thread
 			//reads this value and finds it is false, that all the modifications we made to the pruner are visible in memory.
@@ -418,19 +516,34 @@ void SceneQueryManager::forceDynamicTreeRebuild(bool rebuildStaticStructure, boo
 	Ps::Mutex::ScopedLock lock(mSceneQueryLock);
 	for(PxU32 i=0; i<PruningIndex::eCOUNT; i++)
 	{
-		if(rebuild[i] && mPrunerExt[i].pruner() && mPrunerExt[i].type() == PxPruningStructureType::eDYNAMIC_AABB_TREE)
+		if(!rebuild[i] || !mPrunerExt[i].pruner())
+			continue;
+
+		if(mPrunerExt[i].mBackgroundRebuild)
+		{
+			// no stall: the current tree stays in use until the new one has been built in the background.
+			// A rebuild that is already running is followed by another one.
+			static_cast<AABBPruner*>(mPrunerExt[i].pruner())->mNeedsNewTree = true;
+			launchStaticRebuild();
+		}
+		else if(mPrunerExt[i].type() == PxPruningStructureType::eDYNAMIC_AABB_TREE)
 		{
-			static_cast<AABBPruner*>(mPrunerExt[i].pruner())->purge();
-			static_cast<AABBPruner*>(mPrunerExt[i].pruner())->commit();
+			// this is called by the user thread, so the rebuild can use the scene's worker threads
+			AABBPruner* pruner = static_cast<AABBPruner*>(mPrunerExt[i].pruner());
+			pruner->setBuildDispatcher(mScene.getScScene().getTaskManager().getCpuDispatcher());
+			pruner->purge();
+			pruner->commit();
+			pruner->setBuildDispatcher(NULL);
 		}
 	}
 }
 
 void SceneQueryManager::sceneQueryBuildStep(PruningIndex::Enum index)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eSCENE_QUERY);
 	PX_PROFILE_ZONE("SceneQuery.sceneQueryBuildStep", mScene.getContextId());
 
-	if (mPrunerExt[index].pruner() && mPrunerExt[index].type() == PxPruningStructureType::eDYNAMIC_AABB_TREE)
+	if (mPrunerExt[index].pruner() && mPrunerExt[index].progressive())
 	{
 		const bool buildFinished = static_cast<AABBPruner*>(mPrunerExt[index].pruner())->buildStep(false);
 		if(buildFinished)
@@ -443,20 +556,141 @@ void SceneQueryManager::sceneQueryBuildStep(PruningIndex::Enum index)
 bool SceneQueryManager::prepareSceneQueriesUpdate(PruningIndex::Enum index)
 {
 	bool retVal = false;
-	if (mPrunerExt[index].pruner() && mPrunerExt[index].type() == PxPruningStructureType::eDYNAMIC_AABB_TREE)
+	if (mPrunerExt[index].pruner() && mPrunerExt[index].progressive())
 	{
 		retVal = static_cast<AABBPruner*>(mPrunerExt[index].pruner())->prepareBuild();
 	}
 	return retVal;
 }
 
+void SceneQueryManager::launchStaticRebuild()
+{
+	PrunerExt& ext = mPrunerExt[PruningIndex::eSTATIC];
+	if(!ext.mBackgroundRebuild || mStaticRebuildRunning)
+		return;
+
+	if(!static_cast<AABBPruner*>(ext.pruner())->startBackgroundBuild())
+		return;
+
+	mStaticRebuildRunning = true;
+	mStaticRebuildDone.reset();
+	mStaticRebuildTask.setContextId(mScene.getContextId());
+	mScene.getScScene().getTaskManager().getCpuDispatcher()->submitTask(mStaticRebuildTask);
+}
+
+void SceneQueryManager::finishStaticRebuild(bool waitForTask)
+{
+	if(!mStaticRebuildRunning)
+		return;
+
+	if(!mStaticRebuildDone.wait(waitForTask ? Ps::Sync::waitForever : 0))
+		return;
+
+	mStaticRebuildRunning = false;
+	static_cast<AABBPruner*>(mPrunerExt[PruningIndex::eSTATIC].pruner())->finishBackgroundBuild();
+	mPrunerNeedsUpdating = true;
+}
+
+void StaticTreeRebuildTask::run()
+{
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eSCENE_QUERY);
+	static_cast<AABBPruner*>(mOwner->mPrunerExt[PruningIndex::eSTATIC].pruner())->backgroundBuild();
+}
+
+void StaticTreeRebuildTask::release()
+{
+	// make the next query pick up the new tree. The owner must not be touched once the sync is set.
+	mOwner->mPrunerNeedsUpdating = true;
+	Ps::memoryBarrier();
+	mOwner->mStaticRebuildDone.set();
+}
+
 void SceneQueryManager::shiftOrigin(const PxVec3& shift)
 {
+	// the new tree must be shifted as well, so it cannot be built during the shift
+	finishStaticRebuild(true);
+
+	// the timestamps let the result and volume caches know that their hits moved too
 	for(PxU32 i=0; i<PruningIndex::eCOUNT; i++)
+	{
 		mPrunerExt[i].pruner()->shiftOrigin(shift);
+		mPrunerExt[i].invalidateTimestamp();
+	}
+
+	// the snapshots keep the old origin until the next publication, which has to rebuild them
+	for(PxU32 s=0; s<2; s++)
+		for(PxU32 i=0; i<PruningIndex::eCOUNT; i++)
+			mSnapshotTimestamps[s][i] = 0xffffffff;
+}
+
+void SceneQueryManager::publishSnapshot()
+{
+	if(!mUseSnapshots)
+		return;
+
+	PX_PROFILE_ZONE("SceneQuery.publishSnapshot", mScene.getContextId());
+
+	flushUpdates();
+
+	const PxI32 current = mSnapshotIndex;
+	if(current>=0)
+	{
+		bool changed = false;
+		for(PxU32 i=0; i<PruningIndex::eCOUNT; i++)
+			changed |= mSnapshotTimestamps[current][i] != mPrunerExt[i].timestamp();
+		if(!changed)
+			return;	// the published snapshot is still up-to-date
+	}
+
+	// The slot that is not published can only be in use by a query that acquired it before the previous publication.
+	// In that case we keep the current snapshot and try again next time, rather than waiting for the query.
+	const PxU32 slot = current<0 ? 0 : PxU32(1-current);
+	if(mSnapshotReaders[slot])
+		return;
+
+	for(PxU32 i=0; i<PruningIndex::eCOUNT; i++)
+	{
+		const PxU32 timestamp = mPrunerExt[i].timestamp();
+		if(mSnapshotTimestamps[slot][i] == timestamp)
+			continue;
+
+		const PrunerPayload* payloads;
+		const PxBounds3* bounds;
+		const PxU32 nbObjects = mPrunerExt[i].pruner()->getObjects(payloads, bounds);
+		mSnapshotPruners[slot][i]->build(payloads, bounds, nbObjects);
+		mSnapshotTimestamps[slot][i] = timestamp;
+	}
+	mSnapshots[slot].version = ++mSnapshotVersion;
+
+	// atomicExchange is a full barrier, so the slot is complete when the queries see the new index
+	Ps::atomicExchange(&mSnapshotIndex, PxI32(slot));
+}
+
+const SceneQuerySnapshot* SceneQueryManager::acquireSnapshot() const
+{
+	for(;;)
+	{
+		const PxI32 index = mSnapshotIndex;
+		if(index<0)
+			return NULL;
+
+		// The slot is only ours if it is still the published one once we registered as a reader. Otherwise it may be
+		// rebuilt at any time, so we retry with the new one without touching it.
+		Ps::atomicIncrement(&mSnapshotReaders[index]);
+		if(mSnapshotIndex == index)
+			return mSnapshots + index;
+		Ps::atomicDecrement(&mSnapshotReaders[index]);
+	}
+}
+
+void SceneQueryManager::releaseSnapshot(const SceneQuerySnapshot* snapshot) const
+{
+	const PxU32 index = PxU32(snapshot - mSnapshots);
+	PX_ASSERT(index<2 && mSnapshotReaders[index]>0);
+	Ps::atomicDecrement(&mSnapshotReaders[index]);
 }
 
-void DynamicBoundsSync::sync(const PrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds, PxU32 count, const Cm::BitMap& dirtyShapeSimMap)
+void DynamicBoundsSync::sync(const PrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds, PxU32 count, const Cm::HierarchicalBitMap& dirtyShapeSimMap)
 {
 	if(!count)
 		return;
@@ -465,7 +699,7 @@ void DynamicBoundsSync::sync(const PrunerHandle* handles, const PxU32* indices,
 	PxU32 numIndices = count;
 
 	// if shape sim map is not empty, parse the indices and skip update for the dirty one
-	if(dirtyShapeSimMap.count())
+	if(!dirtyShapeSimMap.isEmpty())
 	{
 		numIndices = 0;
 
@@ -0,0 +1,218 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#include "foundation/PxProfiler.h"
+#include "PsFoundation.h"
+#include "SqSnapshotPruner.h"
+#include "SqAABBTree.h"
+#include "SqAABBTreeQuery.h"
+#include "GuSphere.h"
+#include "GuBox.h"
+#include "GuCapsule.h"
+#include "GuBounds.h"
+
+using namespace physx;
+using namespace Gu;
+using namespace Sq;
+using namespace Cm;
+
+// same leaf size as the AABB pruner trees
+#define NB_OBJECTS_PER_NODE	4
+
+SnapshotPruner::SnapshotPruner(PxU64 contextID) :
+	mPayloads	(PX_DEBUG_EXP("SnapshotPruner::mPayloads")),
+	mBounds		(PX_DEBUG_EXP("SnapshotPruner::mBounds")),
+	mTree		(NULL),
+	mNbObjects	(0),
+	mContextID	(contextID)
+{
+}
+
+SnapshotPruner::~SnapshotPruner()
+{
+	PX_DELETE_AND_RESET(mTree);
+}
+
+void SnapshotPruner::build(const PrunerPayload* payloads, const PxBounds3* bounds, PxU32 nbObjects)
+{
+	PX_PROFILE_ZONE("SceneQuery.snapshotPrunerBuild", mContextID);
+
+	mNbObjects = nbObjects;
+	if(!nbObjects)
+		return;
+
+	mPayloads.resizeUninitialized(nbObjects);
+	PxMemCopy(mPayloads.begin(), payloads, nbObjects*sizeof(PrunerPayload));
+
+	mBounds.resizeUninitialized(nbObjects+1);
+	PxMemCopy(mBounds.begin(), bounds, nbObjects*sizeof(PxBounds3));
+	mBounds[nbObjects] = PxBounds3::empty();
+
+	if(!mTree)
+		mTree = PX_NEW(AABBTree);
+
+	AABBTreeBuildParams TB;
+	TB.mNbPrimitives	= nbObjects;
+	TB.mAABBArray		= mBounds.begin();
+	TB.mLimit			= NB_OBJECTS_PER_NODE;
+	if(!mTree->build(TB))
+		mNbObjects = 0;
+}
+
+bool SnapshotPruner::addObjects(PrunerHandle*, const PxBounds3*, const PrunerPayload*, PxU32, bool)
+{
+	PX_ALWAYS_ASSERT_MESSAGE("SnapshotPruner: snapshots are immutable");
+	return false;
+}
+
+void SnapshotPruner::removeObjects(const PrunerHandle*, PxU32)
+{
+	PX_ALWAYS_ASSERT_MESSAGE("SnapshotPruner: snapshots are immutable");
+}
+
+void SnapshotPruner::updateObjectsAfterManualBoundsUpdates(const PrunerHandle*, PxU32)
+{
+	PX_ALWAYS_ASSERT_MESSAGE("SnapshotPruner: snapshots are immutable");
+}
+
+void SnapshotPruner::updateObjectsAndInflateBounds(const PrunerHandle*, const PxU32*, const PxBounds3*, PxU32)
+{
+	PX_ALWAYS_ASSERT_MESSAGE("SnapshotPruner: snapshots are immutable");
+}
+
+void SnapshotPruner::merge(const void*)
+{
+	PX_ALWAYS_ASSERT_MESSAGE("SnapshotPruner: snapshots are immutable");
+}
+
+// snapshot objects have no handles, the handle is the index of the object in the snapshot
+const PrunerPayload& SnapshotPruner::getPayload(PrunerHandle handle) const
+{
+	PX_ASSERT(handle<mNbObjects);
+	return mPayloads[handle];
+}
+
+const PrunerPayload& SnapshotPruner::getPayload(PrunerHandle handle, PxBounds3*& bounds) const
+{
+	PX_ASSERT(handle<mNbObjects);
+	bounds = const_cast<PxBounds3*>(mBounds.begin() + handle);
+	return mPayloads[handle];
+}
+
+PxU32 SnapshotPruner::getObjects(const PrunerPayload*& payloads, const PxBounds3*& bounds) const
+{
+	payloads = mPayloads.begin();
+	bounds = mBounds.begin();
+	return mNbObjects;
+}
+
+void SnapshotPruner::shiftOrigin(const PxVec3& shift)
+{
+	for(PxU32 i=0; i<mNbObjects; i++)
+	{
+		mBounds[i].minimum -= shift;
+		mBounds[i].maximum -= shift;
+	}
+
+	if(mNbObjects)
+		mTree->shiftOrigin(shift);
+}
+
+PxAgain SnapshotPruner::overlap(const ShapeData& queryVolume, PrunerCallback& pcb) const
+{
+	if(!mNbObjects)
+		return true;
+
+	const PrunerPayload* objects = mPayloads.begin();
+	const PxBounds3* boxes = mBounds.begin();
+
+	PxAgain again = true;
+	switch(queryVolume.getType())
+	{
+	case PxGeometryType::eBOX:
+		{
+			if(queryVolume.isOBB())
+			{	
+				const Gu::OBBAABBTest test(queryVolume.getPrunerWorldPos(), queryVolume.getPrunerWorldRot33(), queryVolume.getPrunerBoxGeomExtentsInflated());
+				again = AABBTreeOverlap<Gu::OBBAABBTest, AABBTree, AABBTreeRuntimeNode>()(objects, boxes, *mTree, test, pcb);
+			}
+			else
+			{
+				const Gu::AABBAABBTest test(queryVolume.getPrunerInflatedWorldAABB());
+				again = AABBTreeOverlap<Gu::AABBAABBTest, AABBTree, AABBTreeRuntimeNode>()(objects, boxes, *mTree, test, pcb);
+			}
+		}
+		break;
+	case PxGeometryType::eCAPSULE:
+		{
+			const Gu::Capsule& capsule = queryVolume.getGuCapsule();
+			const Gu::CapsuleAABBTest test(	capsule.p1, queryVolume.getPrunerWorldRot33().column0,
+											queryVolume.getCapsuleHalfHeight()*2.0f, PxVec3(capsule.radius*SQ_PRUNER_INFLATION));
+			again = AABBTreeOverlap<Gu::CapsuleAABBTest, AABBTree, AABBTreeRuntimeNode>()(objects, boxes, *mTree, test, pcb);
+		}
+		break;
+	case PxGeometryType::eSPHERE:
+		{
+			const Gu::Sphere& sphere = queryVolume.getGuSphere();
+			Gu::SphereAABBTest test(sphere.center, sphere.radius);
+			again = AABBTreeOverlap<Gu::SphereAABBTest, AABBTree, AABBTreeRuntimeNode>()(objects, boxes, *mTree, test, pcb);
+		}
+		break;
+	case PxGeometryType::eCONVEXMESH:
+		{
+			const Gu::OBBAABBTest test(queryVolume.getPrunerWorldPos(), queryVolume.getPrunerWorldRot33(), queryVolume.getPrunerBoxGeomExtentsInflated());
+			again = AABBTreeOverlap<Gu::OBBAABBTest, AABBTree, AABBTreeRuntimeNode>()(objects, boxes, *mTree, test, pcb);			
+		}
+		break;
+	case PxGeometryType::ePLANE:
+	case PxGeometryType::eTRIANGLEMESH:
+	case PxGeometryType::eHEIGHTFIELD:
+	case PxGeometryType::eGEOMETRY_COUNT:
+	case PxGeometryType::eINVALID:
+		PX_ALWAYS_ASSERT_MESSAGE("unsupported overlap query volume geometry type");
+	}
+	return again;
+}
+
+PxAgain SnapshotPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback& pcb) const
+{
+	if(!mNbObjects)
+		return true;
+
+	const PxBounds3& aabb = queryVolume.getPrunerInflatedWorldAABB();
+	const PxVec3 extents = aabb.getExtents();
+	return AABBTreeRaycast<true, AABBTree, AABBTreeRuntimeNode>()(mPayloads.begin(), mBounds.begin(), *mTree, aabb.getCenter(), unitDir, inOutDistance, extents, pcb);
+}
+
+PxAgain SnapshotPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback& pcb) const
+{
+	if(!mNbObjects)
+		return true;
+
+	return AABBTreeRaycast<false, AABBTree, AABBTreeRuntimeNode>()(mPayloads.begin(), mBounds.begin(), *mTree, origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
+}
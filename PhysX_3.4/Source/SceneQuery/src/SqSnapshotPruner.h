@@ -0,0 +1,82 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+#ifndef SQ_SNAPSHOTPRUNER_H
+#define SQ_SNAPSHOTPRUNER_H
+
+#include "SqPruner.h"
+#include "PsArray.h"
+
+namespace physx
+{
+namespace Sq
+{
+	class AABBTree;
+
+	// Immutable copy of another pruner's objects, with its own AABB tree. Built by the scene query manager when it publishes
+	// a snapshot, and only queried afterwards, so any number of threads can query it while the source pruner is modified.
+	// The modification functions of the Pruner interface are not supported.
+	class SnapshotPruner : public Pruner
+	{
+		public:
+										SnapshotPruner(PxU64 contextID);
+		virtual							~SnapshotPruner();
+
+		// copies the objects and rebuilds the tree. Must not be called while the snapshot is queried.
+						void			build(const PrunerPayload* payloads, const PxBounds3* bounds, PxU32 nbObjects);
+
+		// Pruner
+		virtual	bool					addObjects(PrunerHandle*, const PxBounds3*, const PrunerPayload*, PxU32, bool);
+		virtual	void					removeObjects(const PrunerHandle*, PxU32);
+		virtual	void					updateObjectsAfterManualBoundsUpdates(const PrunerHandle*, PxU32);
+		virtual void				    updateObjectsAndInflateBounds(const PrunerHandle*, const PxU32*, const PxBounds3*, PxU32);
+		virtual	void					commit()	{}
+		virtual void					merge(const void*);
+		virtual	PxAgain					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback&) const;
+		virtual	PxAgain					overlap(const Gu::ShapeData& queryVolume, PrunerCallback&) const;
+		virtual	PxAgain					sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback&) const;
+		virtual	const PrunerPayload&	getPayload(PrunerHandle handle) const;
+		virtual	const PrunerPayload&	getPayload(PrunerHandle handle, PxBounds3*& bounds) const;
+		virtual	PxU32					getObjects(const PrunerPayload*& payloads, const PxBounds3*& bounds) const;
+		virtual	void					preallocate(PxU32)	{}
+		virtual	void					shiftOrigin(const PxVec3& shift);
+		//~Pruner
+
+		private:
+				Ps::Array<PrunerPayload>	mPayloads;
+				Ps::Array<PxBounds3>		mBounds;	// one extra box for the unaligned SIMD loads of the last box
+				AABBTree*					mTree;
+				PxU32						mNbObjects;
+				PxU64						mContextID;
+	};
+
+} // namespace Sq
+
+}
+
+#endif // SQ_SNAPSHOTPRUNER_H
@@ -169,6 +169,17 @@ namespace Sc
 
 						BodySim*			getSim() const;
 
+		// solver state of the simulated body that is not part of PxsBodyCore, copied by scene snapshots
+		struct SimSnapshot
+		{
+			PxVec3	sleepLinVelAcc;
+			PxReal	freezeCount;
+			PxVec3	sleepAngVelAcc;
+			PxReal	accelScale;
+		};
+						void				saveSimSnapshot(SimSnapshot& snapshot) const;
+						void				restoreSimSnapshot(const SimSnapshot& snapshot);
+
 		PX_FORCE_INLINE	PxsBodyCore&		getCore()							{ return mCore;						}
 		PX_FORCE_INLINE	const PxsBodyCore&	getCore()			const			{ return mCore;						}
 
@@ -112,6 +112,7 @@ namespace Sc
 		PxVec3 mAngularInertia;
 		PxVec3 mCentrifugalInertia;
 		PxReal mSolverFrequency;
+		PxReal mLodFactor;
 		PxReal mStiffnessFrequency;
 		PxReal mSelfCollisionDistance;
 		PxReal mSelfCollisionStiffness;
@@ -241,6 +242,9 @@ namespace Sc
 		PxReal					getSolverFrequency() const;
 		void					setSolverFrequency(PxReal);
 
+		PxReal					getLodFactor() const;
+		void					setLodFactor(PxReal);
+
 		PxReal					getStiffnessFrequency() const;
 		void					setStiffnessFrequency(PxReal);
 
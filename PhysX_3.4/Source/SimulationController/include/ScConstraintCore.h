@@ -64,6 +64,7 @@ namespace Sc
 											{ 
 												mConnector = &n;	
 												mSolverPrep = shaders.solverPrep;
+												mSolverPrep4 = shaders.solverPrep4;
 												mProject = shaders.project;
 												mVisualize = shaders.visualize;
 											}
@@ -100,6 +101,7 @@ namespace Sc
 	PX_FORCE_INLINE	PxConstraintVisualize	getVisualize()										const	{ return mVisualize;				}
 	PX_FORCE_INLINE	PxConstraintProject		getProject()										const	{ return mProject;					}
 	PX_FORCE_INLINE	PxConstraintSolverPrep	getSolverPrep()										const	{ return mSolverPrep;				}
+	PX_FORCE_INLINE	PxConstraintSolverPrep4	getSolverPrep4()									const	{ return mSolverPrep4;				}
 	PX_FORCE_INLINE	PxU32					getConstantBlockSize()								const	{ return mDataSize;					}
 
 	PX_FORCE_INLINE	void					setSim(ConstraintSim* sim)
@@ -118,6 +120,7 @@ namespace Sc
 					PxConstraintConnector*	mConnector;
 					PxConstraintProject		mProject;
 					PxConstraintSolverPrep	mSolverPrep;
+					PxConstraintSolverPrep4	mSolverPrep4;
 					PxConstraintVisualize	mVisualize;
 					PxU32					mDataSize;
 					PxReal					mLinearBreakForce;
@@ -77,6 +77,8 @@ namespace Sc
 				void		addShapeToScene(ShapeCore& shape);
 				void		removeShapeFromScene(ShapeCore& shape, bool wakeOnLostTouch);
 				void		onShapeChange(ShapeCore& shape, ShapeChangeNotifyFlags notifyFlags, PxShapeFlags newShapeFlags = PxShapeFlags(), bool forceBoundsUpdate = false);
+				// the geometry of 'shape' changed inside 'localRegion' (shape space) only
+				void		onShapeRegionChange(ShapeCore& shape, const PxBounds3& localRegion);
 
 				RigidSim*	getSim() const;
 		static	void		getBinaryMetaData(PxOutputStream& stream);
@@ -44,6 +44,7 @@
 #include "CmFlushPool.h"
 #include "CmPreallocatingPool.h"
 #include "CmBitMap.h"
+#include "CmHierarchicalBitMap.h"
 #include "ScIterators.h"
 #include "PxvContext.h"
 #include "PxsMaterialManager.h"
@@ -225,7 +226,7 @@ namespace Sc
 	// PT: TODO: revisit the need for a virtual interface
 	struct SqBoundsSync
 	{
-		virtual void sync(const Sq::PrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds, PxU32 count, const Cm::BitMap& dirtyShapeSimMap) = 0;
+		virtual void sync(const Sq::PrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds, PxU32 count, const Cm::HierarchicalBitMap& dirtyShapeSimMap) = 0;
 
 		virtual ~SqBoundsSync() {}
 	};
@@ -260,6 +261,9 @@ namespace Sc
 	PX_FORCE_INLINE	void						setGravity(const PxVec3& g)			{ mGravity = g;	mBodyGravityDirty = true;			}
 	PX_FORCE_INLINE	PxVec3						getGravity()				const	{ return mGravity;									}
 	PX_FORCE_INLINE void						setElapsedTime(const PxReal t)		{ mDt = t; mOneOverDt = t > 0.0f ? 1.0f/t : 0.0f;	}
+	// Position of the next step within a frame split into nbSubsteps steps of equal length. The broad phase is deferred for
+	// every substep but the first, and speculative contact distances cover the remaining time of the frame.
+	PX_FORCE_INLINE void						setSubstep(PxU32 index, PxU32 nbSubsteps)	{ PX_ASSERT(index < nbSubsteps); mSubstepIndex = index; mNbSubsteps = nbSubsteps;	}
 
 					void						setBounceThresholdVelocity(const PxReal t);
 					PxReal						getBounceThresholdVelocity() const;
@@ -352,6 +356,7 @@ namespace Sc
 					void						registerContactManagers(PxBaseTask* continuation);
 					void						registerInteractions(PxBaseTask* continuation);
 					void						registerSceneInteractions(PxBaseTask* continuation);
+					void						registerNPhaseInteractions(PxBaseTask* continuation);
 
 					void						secondPassNarrowPhase(PxBaseTask* continuation);
 
@@ -388,6 +393,9 @@ namespace Sc
 					void						postReportsCleanup();
 					void						fireCallbacksPostSync();
 					void						syncSceneQueryBounds(SqBoundsSync& sync, SqRefFinder& finder);
+					// when set, the SQ bounds are synced by a task at the end of the simulation step and the following
+					// syncSceneQueryBounds() call returns immediately. Pass NULL to sync in fetchResults() again.
+					void						setSqBoundsSyncInSimulation(SqBoundsSync* sync, SqRefFinder* finder);
 
 					PxU32						getDefaultContactReportStreamBufferSize() const;
 
@@ -526,7 +534,7 @@ namespace Sc
 
 	public:
 
-		PX_FORCE_INLINE Cm::BitMap&				getDirtyShapeSimMap() { return mDirtyShapeSimMap; }
+		PX_FORCE_INLINE Cm::HierarchicalBitMap&	getDirtyShapeSimMap() { return mDirtyShapeSimMap; }
 
 					void						addToActiveBodyList(BodySim& actor);
 					void						removeFromActiveBodyList(BodySim& actor);
@@ -570,6 +578,7 @@ namespace Sc
 						PxU32						getBroadPhaseRegions(PxBroadPhaseRegionInfo* userBuffer, PxU32 bufferSize, PxU32 startIndex)	const;
 						PxU32						addBroadPhaseRegion(const PxBroadPhaseRegion& region, bool populateRegion);
 						bool						removeBroadPhaseRegion(PxU32 handle);
+						bool						setBroadPhaseAutoRegions(const PxBounds3& worldBounds, PxU32 maxNbObjectsPerRegion);
 						void**						getOutOfBoundsAggregates();
 						PxU32						getNbOutOfBoundsAggregates();
 						void						clearOutOfBoundsAggregates();
@@ -588,6 +597,7 @@ namespace Sc
 		PX_FORCE_INLINE	const void*					getFilterShaderDataFast()				const	{ return mFilterShaderData;				}
 		PX_FORCE_INLINE	PxU32						getFilterShaderDataSizeFast()			const	{ return mFilterShaderDataSize;			}
 		PX_FORCE_INLINE	PxSimulationFilterShader	getFilterShaderFast()					const	{ return mFilterShader;					}
+		PX_FORCE_INLINE	PxSimulationFilterShaderBatch	getFilterShaderBatchFast()			const	{ return mFilterShaderBatch;			}
 		PX_FORCE_INLINE	PxSimulationFilterCallback*	getFilterCallbackFast()					const	{ return mFilterCallback;				}
 		PX_FORCE_INLINE	PxPairFilteringMode::Enum	getKineKineFilteringMode()				const	{ return mKineKineFilteringMode;		}
 		PX_FORCE_INLINE	PxPairFilteringMode::Enum	getStaticKineFilteringMode()			const	{ return mStaticKineFilteringMode;		}
@@ -610,6 +620,7 @@ namespace Sc
 													getTriggerBufferExtraData()						{ return *mTriggerBufferExtraData;		}
 		PX_FORCE_INLINE	Ps::Array<PxTriggerPair>&	getTriggerBufferAPI()							{ return mTriggerBufferAPI;				}
 						void						reserveTriggerReportBufferSpace(const PxU32 pairCount, PxTriggerPair*& triggerPairBuffer, TriggerPairExtraData*& triggerPairExtraBuffer);
+						void						releaseTriggerReportBufferSpace(const PxU32 pairCount);
 
 		PX_FORCE_INLINE	ObjectIDTracker&			getRigidIDTracker()								{ return *mRigidIDTracker;				}
 		PX_FORCE_INLINE	ObjectIDTracker&			getShapeIDTracker()								{ return *mShapeIDTracker;				}
@@ -788,6 +799,9 @@ namespace Sc
 		//constants set with setTiming():
 					PxReal						mDt;						//delta time for current step.
 					PxReal						mOneOverDt;					//inverse of dt.
+					PxU32						mSubstepIndex;				//index of the current substep within the frame.
+					PxU32						mNbSubsteps;				//number of substeps in the frame, 1 when not substepping.
+					bool						mBroadPhaseDeferred;		//the broad phase was skipped in the current substep.
 		//stepping / counters:
 					PxU32						mTimeStamp;					//Counts number of steps.
 					PxU32						mReportShapePairTimeStamp;	//Timestamp for refreshing the shape pair report structure. Updated before delayed shape/actor deletion and before CCD passes.
@@ -802,6 +816,9 @@ namespace Sc
 					Ps::Array<PxReal, Ps::VirtualAllocator>*		mContactDistance;
 					bool											mHasContactDistanceChanged;
 					SqBoundsManager*								mSqBoundsManager;
+					SqBoundsSync*									mSqBoundsSyncInSimulation;
+					SqRefFinder*									mSqRefFinderInSimulation;
+					bool											mSqBoundsSyncedInSimulation;	// set by the task, consumed by syncSceneQueryBounds()
 
 					Ps::Array<BodySim*>			mCcdBodies;
 					Ps::Array<BodySim*>			mProjectedBodies;
@@ -830,6 +847,7 @@ namespace Sc
 
 					Ps::Array<Sc::ConstraintCore*>	mBrokenConstraints;
 					Ps::CoalescedHashSet<Sc::ConstraintSim*> mActiveBreakableConstraints;
+					Ps::Array<Sc::ConstraintSim*>	mActiveBreakableConstraintsByIndex;	// indexed by constraint writeback slot, NULL if not active & breakable
 
 					// pools for joint buffers
 					// Fixed joint is 92 bytes, D6 is 364 bytes right now. So these three pools cover all the internal cases
@@ -850,6 +868,7 @@ namespace Sc
 					PxU32						mFilterShaderDataSize;
 					PxU32						mFilterShaderDataCapacity;
 					PxSimulationFilterShader	mFilterShader;
+					PxSimulationFilterShaderBatch	mFilterShaderBatch;
 					PxSimulationFilterCallback*	mFilterCallback;
 
 					PxPairFilteringMode::Enum	mKineKineFilteringMode;
@@ -900,7 +919,7 @@ namespace Sc
 
 					Ps::Array<PxU32>			mOutOfBoundsIDs;
 
-					Cm::BitMap					mDirtyShapeSimMap;
+					Cm::HierarchicalBitMap		mDirtyShapeSimMap;
 
 					PxU32						mDominanceBitMatrix[PX_MAX_DOMINANCE_GROUP];
 
@@ -951,6 +970,7 @@ namespace Sc
 					void						updateCCDSinglePassStage2(PxBaseTask* continuation);
 					void						updateCCDSinglePassStage3(PxBaseTask* continuation);
 					void						finalizationPhase(PxBaseTask* continuation);
+					void						syncSceneQueryBoundsTask(PxBaseTask* continuation);
 
 					void						postNarrowPhase(PxBaseTask* continuation);
 					void						particlePostCollPrep(PxBaseTask* continuation);
@@ -974,6 +994,7 @@ namespace Sc
 					Cm::FanoutTask														mParticlePostCollPrep;
 					Cm::DelegateFanoutTask<Sc::Scene, &Sc::Scene::particlePostShapeGen>	mParticlePostShapeGen;
 					Cm::DelegateFanoutTask<Sc::Scene, &Sc::Scene::finalizationPhase>	mFinalizationPhase;
+					Cm::DelegateTask<Sc::Scene, &Sc::Scene::syncSceneQueryBoundsTask>	mSyncSceneQueryBoundsTask;
 					Cm::DelegateTask<Sc::Scene, &Sc::Scene::updateCCDMultiPass>			mUpdateCCDMultiPass;
 
 					//multi-pass ccd stuff
@@ -1020,6 +1041,7 @@ namespace Sc
 					Cm::DelegateTask<Sc::Scene, &Sc::Scene::registerContactManagers>		mRegisterContactManagers;
 					Cm::DelegateTask<Sc::Scene, &Sc::Scene::registerInteractions>			mRegisterInteractions;
 					Cm::DelegateTask<Sc::Scene, &Sc::Scene::registerSceneInteractions>		mRegisterSceneInteractions;
+					Cm::DelegateTask<Sc::Scene, &Sc::Scene::registerNPhaseInteractions>		mRegisterNPhaseInteractions;
 					Cm::DelegateTask<Sc::Scene, &Sc::Scene::broadPhase>						mBroadPhase;
 					Cm::DelegateTask<Sc::Scene, &Sc::Scene::advanceStep>					mAdvanceStep;
 					Cm::DelegateTask<Sc::Scene, &Sc::Scene::collideStep>					mCollideStep;
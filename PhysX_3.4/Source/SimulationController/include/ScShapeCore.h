@@ -108,6 +108,11 @@ namespace Sc
 
 		PX_FORCE_INLINE const PxsShapeCore&			getCore()									const	{ return mCore;								}
 
+		// Mesh-scaled local bounds shared by all ShapeSims of this shape, see Gu::computeScaledLocalBounds
+		PX_FORCE_INLINE	bool						hasScaledLocalBounds()						const	{ return mHasScaledLocalBounds!=0;			}
+		PX_FORCE_INLINE	const PxVec3&				getScaledLocalCenter()						const	{ return mScaledLocalCenter;				}
+		PX_FORCE_INLINE	const PxVec3&				getScaledLocalExtents()						const	{ return mScaledLocalExtents;				}
+
 		static PX_FORCE_INLINE ShapeCore&			getCore(PxsShapeCore& core)			
 		{ 
 			size_t offset = PX_OFFSET_OF(ShapeCore, mCore);
@@ -119,6 +124,11 @@ namespace Sc
 						PxFilterData				mSimulationFilterData;	// Simulation filter data
 						PxsShapeCore				PX_ALIGN(16, mCore);	
 						PxReal						mRestOffset;			// same as the API property of the same name
+						PxVec3						mScaledLocalCenter;
+						PxVec3						mScaledLocalExtents;
+						PxU32						mHasScaledLocalBounds;	// also pads mScaledLocalExtents for SIMD loads
+
+						void						updateScaledLocalBounds();
 	};
 
 } // namespace Sc
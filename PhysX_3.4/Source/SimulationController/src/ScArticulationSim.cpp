@@ -253,6 +253,7 @@ void Sc::ArticulationSim::checkResize() const
 		PX_ASSERT(mFsDataBytes.size()!=totalSize);
 		PX_ASSERT(!(totalSize&15) && !(solverDataSize&15));
 		mFsDataBytes.resize(totalSize);
+		PxMemZero(mFsDataBytes.begin(), totalSize);	// also invalidates the cached factorization of the old layout
 
 		mSolverData.motionVelocity			= mMotionVelocity.begin();
 		mSolverData.externalLoads			= mExternalLoads.begin();
@@ -90,6 +90,36 @@ Sc::BodySim* Sc::BodyCore::getSim() const
 	return static_cast<BodySim*>(Sc::ActorCore::getSim());
 }
 
+void Sc::BodyCore::saveSimSnapshot(SimSnapshot& snapshot) const
+{
+	const BodySim* sim = getSim();
+	if(!sim)
+	{
+		PxMemZero(&snapshot, sizeof(SimSnapshot));
+		snapshot.accelScale = 1.0f;
+		return;
+	}
+
+	const PxsRigidBody& llBody = sim->getLowLevelBody();
+	snapshot.sleepLinVelAcc	= llBody.sleepLinVelAcc;
+	snapshot.freezeCount	= llBody.freezeCount;
+	snapshot.sleepAngVelAcc	= llBody.sleepAngVelAcc;
+	snapshot.accelScale		= llBody.accelScale;
+}
+
+void Sc::BodyCore::restoreSimSnapshot(const SimSnapshot& snapshot)
+{
+	BodySim* sim = getSim();
+	if(!sim)
+		return;
+
+	PxsRigidBody& llBody = sim->getLowLevelBody();
+	llBody.sleepLinVelAcc	= snapshot.sleepLinVelAcc;
+	llBody.freezeCount		= snapshot.freezeCount;
+	llBody.sleepAngVelAcc	= snapshot.sleepAngVelAcc;
+	llBody.accelScale		= snapshot.accelScale;
+}
+
 size_t Sc::BodyCore::getSerialCore(PxsBodyCore& serialCore)
 {
 	serialCore = mCore;
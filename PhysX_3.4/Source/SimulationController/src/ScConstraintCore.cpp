@@ -46,6 +46,7 @@ Sc::ConstraintCore::ConstraintCore(PxConstraintConnector& connector, const PxCon
 ,	mConnector(&connector)
 ,	mProject(shaders.project)
 ,	mSolverPrep(shaders.solverPrep)
+,	mSolverPrep4(shaders.solverPrep4)
 ,	mVisualize(shaders.visualize)
 ,	mDataSize(dataSize)
 ,	mLinearBreakForce(PX_MAX_F32)
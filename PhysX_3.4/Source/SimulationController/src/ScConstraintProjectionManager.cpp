@@ -102,7 +102,7 @@ public:
 
 	PX_FORCE_INLINE ScratchAllocatorList(PxcScratchAllocator& scratchAllocator) : mScratchAllocator(scratchAllocator)
 	{
-		mFirstBlock = reinterpret_cast<ElementBlock*>(scratchAllocator.alloc(sizeof(ElementBlock), true));
+		mFirstBlock = reinterpret_cast<ElementBlock*>(scratchAllocator.alloc(sizeof(ElementBlock), true, __FILE__, __LINE__));
 		if (mFirstBlock)
 			mFirstBlock->init(0);
 
@@ -129,7 +129,7 @@ public:
 				PX_ASSERT(mCurrentBlock->next == NULL);
 				PX_ASSERT(mCurrentBlock->count == elementsPerBlock);
 
-				ElementBlock* newBlock = reinterpret_cast<ElementBlock*>(mScratchAllocator.alloc(sizeof(ElementBlock), true));
+				ElementBlock* newBlock = reinterpret_cast<ElementBlock*>(mScratchAllocator.alloc(sizeof(ElementBlock), true, __FILE__, __LINE__));
 				if (newBlock)
 				{
 					newBlock->init(1);
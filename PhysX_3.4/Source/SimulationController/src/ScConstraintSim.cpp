@@ -145,6 +145,7 @@ bool Sc::ConstraintSim::createLLConstraint()
 	llc.constantBlockSize		= constantBlockSize;
 
 	llc.solverPrep				= core.getSolverPrep();
+	llc.solverPrep4				= core.getSolverPrep4();
 	llc.project					= core.getProject();
 	llc.constantBlock			= constantBlock;
 
@@ -155,6 +156,7 @@ bool Sc::ConstraintSim::createLLConstraint()
 	llc.bodyCore1				= mBodies[1] ? &llc.body1->getCore() : NULL;
 
 	llc.minResponseThreshold	= core.getMinResponseThreshold();
+	llc.partitionHint			= PX_MAX_U16;
 
 	return true;
 }
@@ -192,6 +192,7 @@ void Sc::ConstraintCore::getBinaryMetaData(PxOutputStream& stream)
 	PX_DEF_BIN_METADATA_ITEM(stream,	ConstraintCore, PxConstraintConnector,	mConnector,				PxMetaDataFlag::ePTR)
 	PX_DEF_BIN_METADATA_ITEM(stream,	ConstraintCore, PxConstraintProject,	mProject,				PxMetaDataFlag::ePTR)
 	PX_DEF_BIN_METADATA_ITEM(stream,	ConstraintCore, PxConstraintSolverPrep,	mSolverPrep,			PxMetaDataFlag::ePTR)
+	PX_DEF_BIN_METADATA_ITEM(stream,	ConstraintCore, PxConstraintSolverPrep4,	mSolverPrep4,			PxMetaDataFlag::ePTR)
 	PX_DEF_BIN_METADATA_ITEM(stream,	ConstraintCore, PxConstraintVisualize,	mVisualize,				PxMetaDataFlag::ePTR)
 	PX_DEF_BIN_METADATA_ITEM(stream,	ConstraintCore, PxU32,					mDataSize,				0)
 	PX_DEF_BIN_METADATA_ITEM(stream,	ConstraintCore, PxReal,					mLinearBreakForce,		0)
@@ -281,6 +282,9 @@ void Sc::ShapeCore::getBinaryMetaData(PxOutputStream& stream)
 	PX_DEF_BIN_METADATA_ITEM(stream,	ShapeCore, PxFilterData,	mSimulationFilterData,	0)
 	PX_DEF_BIN_METADATA_ITEM(stream,	ShapeCore, PxsShapeCore,	mCore,					0)
 	PX_DEF_BIN_METADATA_ITEM(stream,	ShapeCore, PxReal,		    mRestOffset,			0)
+	PX_DEF_BIN_METADATA_ITEM(stream,	ShapeCore, PxVec3,		    mScaledLocalCenter,		0)
+	PX_DEF_BIN_METADATA_ITEM(stream,	ShapeCore, PxVec3,		    mScaledLocalExtents,	0)
+	PX_DEF_BIN_METADATA_ITEM(stream,	ShapeCore, PxU32,		    mHasScaledLocalBounds,	0)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -421,6 +425,7 @@ void Sc::ClothBulkData::getBinaryMetaData(PxOutputStream& stream)
 	PX_DEF_BIN_METADATA_ITEM(stream,	Sc::ClothBulkData, PxVec3,      mCentrifugalInertia, 0)
 
 	PX_DEF_BIN_METADATA_ITEM(stream,	Sc::ClothBulkData, PxReal,      mSolverFrequency, 0)
+	PX_DEF_BIN_METADATA_ITEM(stream,	Sc::ClothBulkData, PxReal,      mLodFactor, 0)
 	PX_DEF_BIN_METADATA_ITEM(stream,	Sc::ClothBulkData, PxReal,      mStiffnessFrequency, 0)
 	PX_DEF_BIN_METADATA_ITEM(stream,	Sc::ClothBulkData, PxReal,      mSelfCollisionDistance, 0)
 	PX_DEF_BIN_METADATA_ITEM(stream,	Sc::ClothBulkData, PxReal,      mSelfCollisionStiffness, 0)
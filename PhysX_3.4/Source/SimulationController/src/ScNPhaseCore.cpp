@@ -154,6 +154,10 @@ Sc::NPhaseCore::NPhaseCore(Scene& scene, const PxSceneDesc& sceneDesc) :
 	,mMergeProcessedTriggerInteractions (scene.getContextId(), this, "ScNPhaseCore.mergeProcessedTriggerInteractions")
 	,mTmpTriggerProcessingBlock		(NULL)
 	,mTriggerPairsToDeactivateCount	(0)
+	,mTriggerReportBuffer			(NULL)
+	,mTriggerReportExtraBuffer		(NULL)
+	,mTriggerReportReservedCount	(0)
+	,mTriggerReportCount			(0)
 {
 	mFilterPairManager = PX_NEW(FilterPairManager);
 }
@@ -1197,6 +1201,14 @@ PX_INLINE PxFilterInfo Sc::NPhaseCore::runFilter(const ElementSim& e0, const Ele
 
 	runFilterShader(e0, e1, fa0, fd0, fa1, fd1, filterInfo);
 
+	return processFilterShaderResult(e0, e1, fa0, fd0, fa1, fd1, filterInfo, filterPairIndex, doCallbacks);
+}
+
+PX_INLINE PxFilterInfo Sc::NPhaseCore::processFilterShaderResult(const ElementSim& e0, const ElementSim& e1,
+										   PxFilterObjectAttributes fa0, const PxFilterData& fd0,
+										   PxFilterObjectAttributes fa1, const PxFilterData& fd1,
+										   PxFilterInfo filterInfo, PxU32 filterPairIndex, bool doCallbacks)
+{
 	if (filterInfo.filterFlags & PxFilterFlag::eCALLBACK)
 	{
 		if (mOwnerScene.getFilterCallbackFast())
@@ -1273,7 +1285,7 @@ PxFilterInfo Sc::NPhaseCore::filterRbCollisionPairSecondStage(const ShapeSim& s0
 	return filterInfo;
 }
 
-PxFilterInfo Sc::NPhaseCore::filterRbCollisionPair(const ShapeSim& s0, const ShapeSim& s1, PxU32 filterPairIndex, PxU32& isTriggerPair, bool runCallbacks)
+bool Sc::NPhaseCore::filterRbCollisionPairFirstStage(const ShapeSim& s0, const ShapeSim& s1, PxU32 filterPairIndex, PxU32& isTriggerPair, PxFilterInfo& filterInfo)
 {
 	const Sc::BodySim* b0 = s0.getBodySim();
 	const Sc::BodySim* b1 = s1.getBodySim();
@@ -1309,14 +1321,20 @@ PxFilterInfo Sc::NPhaseCore::filterRbCollisionPair(const ShapeSim& s0, const Sha
 			if(!(sceneFlags & PxSceneFlag::eENABLE_KINEMATIC_STATIC_PAIRS))
 			{
 				if(!b0 || !b1)
-					return filterOutRbCollisionPair(filterPairIndex, PxFilterFlag::eSUPPRESS);
+				{
+					filterInfo = filterOutRbCollisionPair(filterPairIndex, PxFilterFlag::eSUPPRESS);
+					return false;
+				}
 			}
 
 			// ...and ignore kinematic vs. kinematic pairs
 			if(!(sceneFlags & PxSceneFlag::eENABLE_KINEMATIC_PAIRS))
 			{
 				if(isS0Kinematic && isS1Kinematic)
-					return filterOutRbCollisionPair(filterPairIndex, PxFilterFlag::eSUPPRESS);
+				{
+					filterInfo = filterOutRbCollisionPair(filterPairIndex, PxFilterFlag::eSUPPRESS);
+					return false;
+				}
 			}
 		}
 	}
@@ -1327,17 +1345,18 @@ PxFilterInfo Sc::NPhaseCore::filterRbCollisionPair(const ShapeSim& s0, const Sha
 		{
 			if ((triggerPair & triggerMask) != triggerMask)  // only one shape is a trigger
 			{
-				return filterRbCollisionPairSecondStage(s0, s1, b0, b1, filterPairIndex, runCallbacks);
+				return true;
 			}
 			else
 			{
 				// trigger-trigger pairs are not supported
-				return filterOutRbCollisionPair(filterPairIndex, PxFilterFlag::eKILL);
+				filterInfo = filterOutRbCollisionPair(filterPairIndex, PxFilterFlag::eKILL);
+				return false;
 			}
 		}
 		else
 		{
-			return filterRbCollisionPairSecondStage(s0, s1, b0, b1, filterPairIndex, runCallbacks);
+			return true;
 		}
 	}
 
@@ -1359,7 +1378,7 @@ PxFilterInfo Sc::NPhaseCore::filterRbCollisionPair(const ShapeSim& s0, const Sha
 	{
 		if ((rbActor0.getActorType() != PxActorType::eARTICULATION_LINK) || (rbActor1.getActorType() != PxActorType::eARTICULATION_LINK))
 		{
-			return filterRbCollisionPairSecondStage(s0, s1, b0, b1, filterPairIndex, runCallbacks);
+			return true;
 		}
 		else
 		{
@@ -1373,16 +1392,88 @@ PxFilterInfo Sc::NPhaseCore::filterRbCollisionPair(const ShapeSim& s0, const Sha
 				if(interaction->getType() == InteractionType::eARTICULATION)
 				{
 					if((&interaction->getActor0() == &rbActor1) || (&interaction->getActor1() == &rbActor1))
-						return filterOutRbCollisionPair(filterPairIndex, PxFilterFlag::eKILL);
+					{
+						filterInfo = filterOutRbCollisionPair(filterPairIndex, PxFilterFlag::eKILL);
+						return false;
+					}
 				}
 			}
 		}
 
-		return filterRbCollisionPairSecondStage(s0, s1, b0, b1, filterPairIndex, runCallbacks);
+		return true;
 	}
 	else
 	{
-		return filterOutRbCollisionPair(filterPairIndex, PxFilterFlag::eSUPPRESS);
+		filterInfo = filterOutRbCollisionPair(filterPairIndex, PxFilterFlag::eSUPPRESS);
+		return false;
+	}
+}
+
+PxFilterInfo Sc::NPhaseCore::filterRbCollisionPair(const ShapeSim& s0, const ShapeSim& s1, PxU32 filterPairIndex, PxU32& isTriggerPair, bool runCallbacks)
+{
+	PxFilterInfo filterInfo;
+	if (filterRbCollisionPairFirstStage(s0, s1, filterPairIndex, isTriggerPair, filterInfo))
+		return filterRbCollisionPairSecondStage(s0, s1, s0.getBodySim(), s1.getBodySim(), filterPairIndex, runCallbacks);
+	return filterInfo;
+}
+
+void Sc::NPhaseCore::onOverlapFilter(const Bp::AABBOverlap* PX_RESTRICT pairs, PxU32 pairCount, PxFilterInfo* PX_RESTRICT filterInfo)
+{
+	const PxSimulationFilterShaderBatch batchShader = mOwnerScene.getFilterShaderBatchFast();
+	if (!batchShader)
+	{
+		for (PxU32 a = 0; a < pairCount; ++a)
+			filterInfo[a] = onOverlapFilter(reinterpret_cast<ElementSim*>(pairs[a].mUserData0), reinterpret_cast<ElementSim*>(pairs[a].mUserData1));
+		return;
+	}
+
+	// Pairs that pass the hardwired criteria are gathered and handed to the batch shader in blocks small enough for the stack
+	const PxU32 BatchSize = 64;
+	PxFilterObjectAttributes fa0[BatchSize], fa1[BatchSize];
+	PxFilterData fd0[BatchSize], fd1[BatchSize];
+	PxFilterFlags filterFlags[BatchSize];
+	PxPairFlags pairFlags[BatchSize];
+	PxU32 pairIndices[BatchSize];
+
+	PxU32 a = 0;
+	while (a < pairCount)
+	{
+		PxU32 batchCount = 0;
+		for (; a < pairCount && batchCount < BatchSize; ++a)
+		{
+			PX_ASSERT(!findInteraction(reinterpret_cast<ElementSim*>(pairs[a].mUserData0), reinterpret_cast<ElementSim*>(pairs[a].mUserData1)));
+			// same shape order as onOverlapFilter(volume0, volume1)
+			const ShapeSim* s0 = reinterpret_cast<const ShapeSim*>(pairs[a].mUserData1);
+			const ShapeSim* s1 = reinterpret_cast<const ShapeSim*>(pairs[a].mUserData0);
+			PX_ASSERT(&s0->getActor() != &s1->getActor());
+
+			PxU32 isTriggerPair = 0;
+			if (filterRbCollisionPairFirstStage(*s0, *s1, INVALID_FILTER_PAIR_INDEX, isTriggerPair, filterInfo[a]))
+			{
+				s0->getFilterInfo(fa0[batchCount], fd0[batchCount]);
+				s1->getFilterInfo(fa1[batchCount], fd1[batchCount]);
+				pairIndices[batchCount++] = a;
+			}
+		}
+
+		if (batchCount)
+		{
+			batchShader(batchCount, fa0, fd0, fa1, fd1, filterFlags, pairFlags, mOwnerScene.getFilterShaderDataFast(), mOwnerScene.getFilterShaderDataSizeFast());
+
+			for (PxU32 b = 0; b < batchCount; ++b)
+			{
+				const PxU32 index = pairIndices[b];
+				const ShapeSim* s0 = reinterpret_cast<const ShapeSim*>(pairs[index].mUserData1);
+				const ShapeSim* s1 = reinterpret_cast<const ShapeSim*>(pairs[index].mUserData0);
+
+				PxFilterInfo finfo(filterFlags[b]);
+				finfo.pairFlags = pairFlags[b];
+				finfo = processFilterShaderResult(*s0, *s1, fa0[b], fd0[b], fa1[b], fd1[b], finfo, INVALID_FILTER_PAIR_INDEX, false);
+				if (!(finfo.filterFlags & PxFilterFlag::eCALLBACK))
+					finfo.pairFlags = checkRbPairFlags(*s0, *s1, s0->getBodySim(), s1->getBodySim(), finfo.pairFlags, finfo.filterFlags);
+				filterInfo[index] = finfo;
+			}
+		}
 	}
 }
 
@@ -1635,16 +1726,22 @@ private:
 	TriggerContactTask& operator = (const TriggerContactTask&);
 
 public:
-	TriggerContactTask(	Interaction* const* triggerPairs, PxU32 triggerPairCount, Ps::Mutex& lock,
+	TriggerContactTask(	Interaction* const* triggerPairs, PxU32 triggerPairCount,
+						PxTriggerPair* triggerReportBuffer, TriggerPairExtraData* triggerReportExtraBuffer, volatile PxI32& triggerReportCount,
 						TriggerInteraction** pairsToDeactivate, volatile PxI32& pairsToDeactivateCount,
-						Scene& scene)
+						PxU32 fixedOutputOffset, Scene& scene)
 		:
 		Cm::Task(scene.getContextId()),
 		mTriggerPairs(triggerPairs),
 		mTriggerPairCount(triggerPairCount),
-		mLock(lock),
+		mTriggerReportBuffer(triggerReportBuffer),
+		mTriggerReportExtraBuffer(triggerReportExtraBuffer),
+		mTriggerReportCount(triggerReportCount),
 		mPairsToDeactivate(pairsToDeactivate),
 		mPairsToDeactivateCount(pairsToDeactivateCount),
+		mFixedOutputOffset(fixedOutputOffset),
+		mNbTriggerReports(0),
+		mNbPairsToDeactivate(0),
 		mScene(scene)
 	{
 	}
@@ -1665,6 +1762,8 @@ public:
 		for(PxU32 i=0; i < mTriggerPairCount; i++)
 		{
 			TriggerInteraction* tri = static_cast<TriggerInteraction*>(mTriggerPairs[i]);
+			if ((i + 1) < mTriggerPairCount)
+				Ps::prefetchLine(mTriggerPairs[i + 1]);
 
 			PX_ASSERT(tri->readInteractionFlag(InteractionFlag::eIS_ACTIVE));
 			
@@ -1696,19 +1795,26 @@ public:
 			}
 		}
 
-		if (triggerReportItemCount)
+		if (mFixedOutputOffset != sNoFixedOutputOffset)
 		{
-			PxTriggerPair* triggerPairBuffer;
-			TriggerPairExtraData* triggerPairExtraBuffer;
-
-			{
-				Ps::Mutex::ScopedLock lock(mLock);
+			// deterministic mode: the output goes to the slots of the task's own pairs and gets compacted in task order afterwards
+			PxMemCopy(mTriggerReportBuffer + mFixedOutputOffset, triggerPair, sizeof(PxTriggerPair) * triggerReportItemCount);
+			PxMemCopy(mTriggerReportExtraBuffer + mFixedOutputOffset, triggerPairExtra, sizeof(TriggerPairExtraData) * triggerReportItemCount);
+			PxMemCopy(mPairsToDeactivate + mFixedOutputOffset, deactivatePairs, sizeof(TriggerInteraction*) * deactivatePairCount);
+			mNbTriggerReports = triggerReportItemCount;
+			mNbPairsToDeactivate = PxU32(deactivatePairCount);
+			triggerReportItemCount = 0;
+			deactivatePairCount = 0;
+		}
 
-				mScene.reserveTriggerReportBufferSpace(triggerReportItemCount, triggerPairBuffer, triggerPairExtraBuffer);
+		if (triggerReportItemCount)
+		{
+			// every active trigger pair has a slot reserved, so claiming a range is all that needs synchronizing
+			const PxI32 newCount = Ps::atomicAdd(&mTriggerReportCount, PxI32(triggerReportItemCount));
+			const PxU32 offset = PxU32(newCount) - triggerReportItemCount;
 
-				PxMemCopy(triggerPairBuffer, triggerPair, sizeof(PxTriggerPair) * triggerReportItemCount);
-				PxMemCopy(triggerPairExtraBuffer, triggerPairExtra, sizeof(TriggerPairExtraData) * triggerReportItemCount);
-			}
+			PxMemCopy(mTriggerReportBuffer + offset, triggerPair, sizeof(PxTriggerPair) * triggerReportItemCount);
+			PxMemCopy(mTriggerReportExtraBuffer + offset, triggerPairExtra, sizeof(TriggerPairExtraData) * triggerReportItemCount);
 		}
 
 		if (deactivatePairCount)
@@ -1735,15 +1841,25 @@ public:
 		return "ScNPhaseCore.triggerInteractionWork";
 	}
 
+	PX_FORCE_INLINE PxU32 getFixedOutputOffset() const { return mFixedOutputOffset; }
+	PX_FORCE_INLINE PxU32 getNbTriggerReports() const { return mNbTriggerReports; }
+	PX_FORCE_INLINE PxU32 getNbPairsToDeactivate() const { return mNbPairsToDeactivate; }
+
 public:
 	static const PxU32 sTriggerPairsPerTask = 64;
+	static const PxU32 sNoFixedOutputOffset = 0xffffffff;
 
 private:
 	Interaction* const* mTriggerPairs;
 	const PxU32 mTriggerPairCount;
-	Ps::Mutex& mLock;
+	PxTriggerPair* mTriggerReportBuffer;
+	TriggerPairExtraData* mTriggerReportExtraBuffer;
+	volatile PxI32& mTriggerReportCount;
 	TriggerInteraction** mPairsToDeactivate;
 	volatile PxI32& mPairsToDeactivateCount;
+	const PxU32 mFixedOutputOffset;
+	PxU32 mNbTriggerReports;
+	PxU32 mNbPairsToDeactivate;
 	Scene& mScene;
 };
 
@@ -1768,7 +1884,7 @@ void Sc::NPhaseCore::processTriggerInteractions(PxBaseTask* continuation)
 		const PxU32 maxTaskCount = taskCountWithoutRemainder + 1;
 		const PxU32 pairPtrSize = pairCount * sizeof(TriggerInteraction*);
 		const PxU32 memBlockSize = pairPtrSize + (maxTaskCount * sizeof(TriggerContactTask));
-		void* triggerProcessingBlock = scene.getLowLevelContext()->getScratchAllocator().alloc(memBlockSize, true);
+		void* triggerProcessingBlock = scene.getLowLevelContext()->getScratchAllocator().alloc(memBlockSize, true, __FILE__, __LINE__);
 		if (triggerProcessingBlock)
 		{
 			const bool hasMultipleThreads = scene.getTaskManager().getCpuDispatcher()->getWorkerCount() > 1;
@@ -1778,12 +1894,20 @@ void Sc::NPhaseCore::processTriggerInteractions(PxBaseTask* continuation)
 			// seemed less of an issue). Hence, the tasks get run directly in that case. Same if there is only one batch.
 
 			mTmpTriggerProcessingBlock = triggerProcessingBlock;  // note: gets released in the continuation task
+
+			// each pair reports at most one event, unused slots get handed back in the continuation task
+			scene.reserveTriggerReportBufferSpace(pairCount, mTriggerReportBuffer, mTriggerReportExtraBuffer);
+			mTriggerReportReservedCount = pairCount;
+			mTriggerReportCount = 0;
 			if (scheduleTasks)
 				mMergeProcessedTriggerInteractions.setContinuation(continuation);
 
 			TriggerInteraction** triggerPairsToDeactivateWriteBack = reinterpret_cast<TriggerInteraction**>(triggerProcessingBlock);
 			TriggerContactTask* triggerContactTaskBuffer = reinterpret_cast<TriggerContactTask*>(reinterpret_cast<PxU8*>(triggerProcessingBlock) + pairPtrSize);
 
+			// with enhanced determinism, the order of the reports and deactivations must not depend on the order the tasks finish in
+			const bool fixedOutput = scene.getPublicFlags().isSet(PxSceneFlag::eENABLE_ENHANCED_DETERMINISM);
+
 			PxU32 remainder = pairCount;
 			while(remainder)
 			{
@@ -1791,8 +1915,10 @@ void Sc::NPhaseCore::processTriggerInteractions(PxBaseTask* continuation)
 				remainder -= nb;
 
 				TriggerContactTask* task = triggerContactTaskBuffer;
-				task = PX_PLACEMENT_NEW(task, TriggerContactTask(	triggerInteractions, nb, mTriggerWriteBackLock,
-																	triggerPairsToDeactivateWriteBack, mTriggerPairsToDeactivateCount, scene));
+				task = PX_PLACEMENT_NEW(task, TriggerContactTask(	triggerInteractions, nb,
+																	mTriggerReportBuffer, mTriggerReportExtraBuffer, mTriggerReportCount,
+																	triggerPairsToDeactivateWriteBack, mTriggerPairsToDeactivateCount,
+																	fixedOutput ? pairCount - remainder - nb : TriggerContactTask::sNoFixedOutputOffset, scene));
 				if (scheduleTasks)
 				{
 					task->setContinuation(&mMergeProcessedTriggerInteractions);
@@ -1821,14 +1947,46 @@ void Sc::NPhaseCore::mergeProcessedTriggerInteractions(PxBaseTask*)
 {
 	if (mTmpTriggerProcessingBlock)
 	{
-		// deactivate pairs that do not need trigger checks any longer (until woken up again)
 		TriggerInteraction** triggerPairsToDeactivate = reinterpret_cast<TriggerInteraction**>(mTmpTriggerProcessingBlock);
+
+		const TriggerContactTask* triggerContactTasks = reinterpret_cast<const TriggerContactTask*>(reinterpret_cast<PxU8*>(mTmpTriggerProcessingBlock) + mTriggerReportReservedCount * sizeof(TriggerInteraction*));
+		if (triggerContactTasks->getFixedOutputOffset() != TriggerContactTask::sNoFixedOutputOffset)
+		{
+			// compact the per task output in task order
+			const PxU32 taskCount = (mTriggerReportReservedCount + TriggerContactTask::sTriggerPairsPerTask - 1) / TriggerContactTask::sTriggerPairsPerTask;
+			PxU32 reportCount = 0;
+			PxU32 deactivateCount = 0;
+			for(PxU32 i=0; i < taskCount; i++)
+			{
+				const TriggerContactTask& task = triggerContactTasks[i];
+				const PxU32 offset = task.getFixedOutputOffset();
+				const PxU32 nbReports = task.getNbTriggerReports();
+				const PxU32 nbToDeactivate = task.getNbPairsToDeactivate();
+
+				PxMemMove(mTriggerReportBuffer + reportCount, mTriggerReportBuffer + offset, sizeof(PxTriggerPair) * nbReports);
+				PxMemMove(mTriggerReportExtraBuffer + reportCount, mTriggerReportExtraBuffer + offset, sizeof(TriggerPairExtraData) * nbReports);
+				PxMemMove(triggerPairsToDeactivate + deactivateCount, triggerPairsToDeactivate + offset, sizeof(TriggerInteraction*) * nbToDeactivate);
+				reportCount += nbReports;
+				deactivateCount += nbToDeactivate;
+			}
+			mTriggerReportCount = PxI32(reportCount);
+			mTriggerPairsToDeactivateCount = PxI32(deactivateCount);
+		}
+
+		// deactivate pairs that do not need trigger checks any longer (until woken up again)
 		for(PxI32 i=0; i < mTriggerPairsToDeactivateCount; i++)
 		{
 			mOwnerScene.notifyInteractionDeactivated(triggerPairsToDeactivate[i]);
 		}
 		mTriggerPairsToDeactivateCount = 0;
 
+		PX_ASSERT(PxU32(mTriggerReportCount) <= mTriggerReportReservedCount);
+		mOwnerScene.releaseTriggerReportBufferSpace(mTriggerReportReservedCount - PxU32(mTriggerReportCount));
+		mTriggerReportBuffer = NULL;
+		mTriggerReportExtraBuffer = NULL;
+		mTriggerReportReservedCount = 0;
+		mTriggerReportCount = 0;
+
 		mOwnerScene.getLowLevelContext()->getScratchAllocator().free(mTmpTriggerProcessingBlock);
 		mTmpTriggerProcessingBlock = NULL;
 	}
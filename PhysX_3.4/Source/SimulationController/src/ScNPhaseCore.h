@@ -171,6 +171,7 @@ namespace Sc
 		void onOverlapCreated(const Bp::AABBOverlap* PX_RESTRICT pairs, PxU32 pairCount, const PxU32 ccdPass);
 		Sc::Interaction* onOverlapCreated(ElementSim* volume0, ElementSim* volume1, const PxU32 ccdPass);
 		PxFilterInfo onOverlapFilter(ElementSim* volume0, ElementSim* volume1);
+		void onOverlapFilter(const Bp::AABBOverlap* PX_RESTRICT pairs, PxU32 pairCount, PxFilterInfo* PX_RESTRICT filterInfo);
 
 
 		ElementSimInteraction* onOverlapRemovedStage1(ElementSim* volume0, ElementSim* volume1);
@@ -248,6 +249,7 @@ namespace Sc
 		void releaseActorPairContactReportData(ActorPairContactReportData* data);
 
 		void registerInteraction(ElementSimInteraction* interaction);
+		PX_FORCE_INLINE void reserveInteractions(PxU32 nbToAdd) { mElementSimMap.reserve(mElementSimMap.size() + nbToAdd); }
 		void unregisterInteraction(ElementSimInteraction* interaction);
 		
 		ElementSimInteraction* createRbElementInteraction(const PxFilterInfo& fInfo, ShapeSim& s0, ShapeSim& s1, PxsContactManager* contactManager, Sc::ShapeInteraction* shapeInteraction, 
@@ -279,6 +281,11 @@ namespace Sc
 			PxFilterObjectAttributes& attr1, PxFilterData& filterData1,
 			PxFilterInfo& filterInfo);
 		PX_INLINE PxFilterInfo runFilter(const ElementSim& e0, const ElementSim& e1, PxU32 filterPairIndex, bool doCallbacks);
+		// the part of runFilter() that follows the filter shader (callbacks, flag sanitizing, filter pair bookkeeping)
+		PX_INLINE PxFilterInfo processFilterShaderResult(const ElementSim& e0, const ElementSim& e1,
+			PxFilterObjectAttributes fa0, const PxFilterData& fd0,
+			PxFilterObjectAttributes fa1, const PxFilterData& fd1,
+			PxFilterInfo filterInfo, PxU32 filterPairIndex, bool doCallbacks);
 
 		// helper method for some cleanup code that is used multiple times for early outs in case a rigid body collision pair gets filtered out due to some hardwired filter criteria
 		PX_FORCE_INLINE PxFilterInfo filterOutRbCollisionPair(PxU32 filterPairIndex, const PxFilterFlags);
@@ -286,6 +293,9 @@ namespace Sc
 		// helper method to run the filter logic after some hardwired filter criteria have been passed successfully
 		PxFilterInfo filterRbCollisionPairSecondStage(const ShapeSim& s0, const ShapeSim& s1, const Sc::BodySim* b0, const Sc::BodySim* b1, PxU32 filterPairIndex, bool runCallbacks);
 
+		// hardwired filter criteria; returns true if the pair has to go through filterRbCollisionPairSecondStage(), else filterInfo holds the result
+		bool filterRbCollisionPairFirstStage(const ShapeSim& s0, const ShapeSim& s1, PxU32 filterPairIndex, PxU32& isTriggerPair, PxFilterInfo& filterInfo);
+
 		PxFilterInfo filterRbCollisionPair(const ShapeSim& s0, const ShapeSim& s1, PxU32 filterPairIndex, PxU32& isTriggerPair, bool runCallbacks);
 		//-------------------------------------
 
@@ -351,8 +361,12 @@ namespace Sc
 
 		Cm::DelegateTask<Sc::NPhaseCore, &Sc::NPhaseCore::mergeProcessedTriggerInteractions> mMergeProcessedTriggerInteractions;
 		void*											mTmpTriggerProcessingBlock;  // temporary memory block to process trigger pairs in parallel
-		Ps::Mutex										mTriggerWriteBackLock;
 		volatile PxI32									mTriggerPairsToDeactivateCount;
+		// trigger report slots reserved up front for all active trigger pairs, claimed by the processing tasks through an atomic counter
+		PxTriggerPair*									mTriggerReportBuffer;
+		TriggerPairExtraData*							mTriggerReportExtraBuffer;
+		PxU32											mTriggerReportReservedCount;
+		volatile PxI32									mTriggerReportCount;
 		Ps::HashMap<BodyPairKey, ActorPair*> mActorPairMap; 
 
 		Ps::HashMap<ElementSimKey, ElementSimInteraction*> mElementSimMap;
@@ -93,6 +93,14 @@ void Sc::RigidCore::onShapeChange(Sc::ShapeCore& shape, ShapeChangeNotifyFlags n
 		s.onRestOffsetChange();
 }
 
+void Sc::RigidCore::onShapeRegionChange(Sc::ShapeCore& shape, const PxBounds3& localRegion)
+{
+	Sc::RigidSim* sim = getSim();
+	if(!sim)
+		return;
+	sim->getSimForShape(shape).onVolumeRegionChange(localRegion);
+}
+
 Sc::RigidSim* Sc::RigidCore::getSim() const
 {
 	return static_cast<RigidSim*>(Sc::ActorCore::getSim());
@@ -59,6 +59,7 @@
 #include "PxsContext.h"
 #include "ScSqBoundsManager.h"
 #include "ScElementSim.h"
+#include "GuBounds.h"
 
 #if defined(__APPLE__) && defined(__POWERPC__)
 #include <ppc_intrinsics.h>
@@ -135,6 +136,86 @@ static const char* sFilterShaderDataMemAllocId = "SceneDesc filterShaderData";
 void PxcClearContactCacheStats();
 void PxcDisplayContactCacheStats();
 
+// Gathers the shapes of the bodies updated by ScAfterIntegrationTask into per geometry type batches, so that their
+// bounds are written to the bounds array by the Gu batch functions rather than one shape at a time through computeBounds.
+class ShapeBoundsBatcher
+{
+	PX_NOCOPY(ShapeBoundsBatcher)
+public:
+	static const PxU32 BatchSize = 32;
+
+	ShapeBoundsBatcher(PxsTransformCache& cache, Bp::BoundsArray& boundsArray) : mCache(cache), mBounds(boundsArray.begin()), mNbScaled(0)
+	{
+		for(PxU32 i=0; i<PxGeometryType::eGEOMETRY_COUNT; i++)
+			mNbEntries[i] = 0;
+	}
+
+	PX_FORCE_INLINE void addBody(Sc::BodySim& body)
+	{
+		Sc::ShapeSim* sim;
+		for(Sc::ShapeIterator iterator(body); (sim = iterator.getNext())!=NULL;)
+			addShape(*sim);
+	}
+
+	void flush()
+	{
+		flushScaled();
+		for(PxU32 i=0; i<PxGeometryType::eGEOMETRY_COUNT; i++)
+			flushType(PxGeometryType::Enum(i));
+	}
+
+private:
+	PX_FORCE_INLINE void addShape(Sc::ShapeSim& sim)
+	{
+		const Sc::ShapeCore& core = sim.getCore();
+
+		Gu::BoundsBatchEntry* entry;
+		if(core.hasScaledLocalBounds())
+		{
+			if(mNbScaled==BatchSize)
+				flushScaled();
+			entry = &mScaled[mNbScaled++];
+			entry->scaledLocalBounds = &core.getScaledLocalCenter();
+		}
+		else
+		{
+			const PxGeometryType::Enum type = core.getGeometryType();
+			if(mNbEntries[type]==BatchSize)
+				flushType(type);
+			entry = &mEntries[type][mNbEntries[type]++];
+			entry->scaledLocalBounds = NULL;
+		}
+		entry->geometry = &core.getGeometry();
+		entry->pose = &sim.updateCachedTransform(mCache);
+		entry->boundsIndex = sim.getElementID();
+	}
+
+	void flushScaled()
+	{
+		if(mNbScaled)
+		{
+			Gu::computeBoundsFromScaledLocalBoundsBatch(mBounds, mScaled, mNbScaled);
+			mNbScaled = 0;
+		}
+	}
+
+	void flushType(PxGeometryType::Enum type)
+	{
+		if(mNbEntries[type])
+		{
+			Gu::computeBoundsBatch(mBounds, type, mEntries[type], mNbEntries[type], !physx::gUnifiedHeightfieldCollision);
+			mNbEntries[type] = 0;
+		}
+	}
+
+	PxsTransformCache&		mCache;
+	PxBounds3*				mBounds;
+	PxU32					mNbScaled;
+	PxU32					mNbEntries[PxGeometryType::eGEOMETRY_COUNT];
+	Gu::BoundsBatchEntry	mScaled[BatchSize];
+	Gu::BoundsBatchEntry	mEntries[PxGeometryType::eGEOMETRY_COUNT][BatchSize];
+};
+
 class ScAfterIntegrationTask :  public Cm::Task
 {
 public:
@@ -178,6 +259,8 @@ public:
 		PxU32 nbFrozen = 0, nbUnfrozen = 0;
 		PxU32 nbActivated = 0, nbDeactivated = 0;
 
+		ShapeBoundsBatcher boundsBatcher(mCache, boundsArray);
+
 		for(PxU32 i = 0; i < mNumBodies; i++)
 		{
 			PxsRigidBody* rigid = islandSim.getRigidBody(mIndices[i]);
@@ -199,7 +282,7 @@ public:
 
 				// PT: TODO: remove duplicate "isFrozen" test inside updateCached
 //				bodySim->updateCached(NULL);
-				bodySim->updateCached(mCache, boundsArray);
+				boundsBatcher.addBody(*bodySim);
 			}
 
 			if(llBody.isFreezeThisFrame() && isFrozen)
@@ -225,6 +308,8 @@ public:
 			}
 			llBody.clearAllFrameFlags();
 		}
+		boundsBatcher.flush();
+
 		if(nbBpUpdates)
 		{
 			mCache.setChangedState();
@@ -563,6 +648,9 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 	mBodyGravityDirty				(true),	
 	mDt								(0),
 	mOneOverDt						(0),
+	mSubstepIndex					(0),
+	mNbSubsteps						(1),
+	mBroadPhaseDeferred				(false),
 	mTimeStamp						(1),		// PT: has to start to 1 to fix determinism bug. I don't know why yet but it works.
 	mReportShapePairTimeStamp		(0),
 	mTriggerBufferAPI				(PX_DEBUG_EXP("sceneTriggerBufferAPI")),
@@ -578,6 +666,7 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 #endif
 	mBrokenConstraints				(PX_DEBUG_EXP("sceneBrokenConstraints")),
 	mActiveBreakableConstraints		(PX_DEBUG_EXP("sceneActiveBreakableConstraints")),
+	mActiveBreakableConstraintsByIndex	(PX_DEBUG_EXP("sceneActiveBreakableConstraintsByIndex")),
 	mMemBlock128Pool				(PX_DEBUG_EXP("PxsContext ConstraintBlock128Pool")),
 	mMemBlock256Pool				(PX_DEBUG_EXP("PxsContext ConstraintBlock256Pool")),
 	mMemBlock384Pool				(PX_DEBUG_EXP("PxsContext ConstraintBlock384Pool")),
@@ -604,6 +693,7 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 	mParticlePostCollPrep			(contextID, "ScScene.particlePostCollPrep"),
 	mParticlePostShapeGen			(contextID, this, "ScScene.particlePostShapeGen"),
 	mFinalizationPhase				(contextID, this, "ScScene.finalizationPhase"),
+	mSyncSceneQueryBoundsTask		(contextID, this, "ScScene.syncSceneQueryBounds"),
 	mUpdateCCDMultiPass				(contextID, this, "ScScene.updateCCDMultiPass"),
 	mAfterIntegration				(contextID, this, "ScScene.afterIntegration"),
 	mConstraintProjection			(contextID, this, "ScScene.constraintProjection"),
@@ -638,6 +728,7 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 	mRegisterContactManagers		(contextID, this, "ScScene.registerContactManagers"),
 	mRegisterInteractions			(contextID, this, "ScScene.registerInteractions"),
 	mRegisterSceneInteractions		(contextID, this, "ScScene.registerSceneInteractions"),
+	mRegisterNPhaseInteractions		(contextID, this, "ScScene.registerNPhaseInteractions"),
 	mBroadPhase						(contextID, this, "ScScene.broadPhase"),
 	mAdvanceStep					(contextID, this, "ScScene.advanceStep"),
 	mCollideStep					(contextID, this, "ScScene.collideStep"),	
@@ -652,6 +743,13 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 	for (int i=0; i < InteractionType::eTRACKED_IN_SCENE_COUNT; ++i)
 		mActiveInteractionCount[i] = 0;
 
+	// the island generation -> solver -> integration chain is the longest one in the step
+	mIslandGen.setPriority(PxTaskPriority::eHIGH);
+	mPostIslandGen.setPriority(PxTaskPriority::eHIGH);
+	mSolver.setPriority(PxTaskPriority::eHIGH);
+	mUpdateDynamics.setPriority(PxTaskPriority::eHIGH);
+	mUpdateCCDMultiPass.setPriority(PxTaskPriority::eHIGH);
+
 #if PX_USE_CLOTH_API
 	PxMemZero(mClothSolvers, sizeof(mClothSolvers));
 	PxMemZero(mClothTasks, sizeof(mClothTasks));
@@ -680,6 +778,9 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 	mProjectionManager = PX_NEW(ConstraintProjectionManager)();
 
 	mSqBoundsManager = PX_NEW(SqBoundsManager);
+	mSqBoundsSyncInSimulation = NULL;
+	mSqRefFinderInSimulation = NULL;
+	mSqBoundsSyncedInSimulation = false;
 
 	mTaskManager = physx::PxTaskManager::createTaskManager(Ps::getFoundation().getErrorCallback(), desc.cpuDispatcher, desc.gpuDispatcher);
 
@@ -794,6 +895,8 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 	const bool useAdaptiveForce = mPublicFlags & PxSceneFlag::eADAPTIVE_FORCE;
 
 	mSimpleIslandManager = PX_PLACEMENT_NEW(PX_ALLOC(sizeof(IG::SimpleIslandManager), PX_DEBUG_EXP("SimpleIslandManager")), IG::SimpleIslandManager)(useEnhancedDeterminism, contextID);
+	mSimpleIslandManager->setIslandSleepMassFraction((desc.flags & PxSceneFlag::eENABLE_ISLAND_SLEEP) ? desc.islandSleepMassFraction : 0.0f);
+	mSimpleIslandManager->setIslandCompactionThreshold(desc.islandCompactionThreshold);
 
 	if (!useGpuDynamics)
 	{
@@ -802,7 +905,7 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 			mLLContext->getTaskPool(), mLLContext->getSimStats(), &mLLContext->getTaskManager(), allocatorCallback, &getMaterialManager(),
 			&mSimpleIslandManager->getAccurateIslandSim(), contextID, mEnableStabilization, useEnhancedDeterminism, useAdaptiveForce, desc.maxBiasCoefficient);
 
-		mLLContext->setNphaseImplementationContext(createNphaseImplementationContext(*mLLContext, &mSimpleIslandManager->getAccurateIslandSim()));
+		mLLContext->setNphaseImplementationContext(createNphaseImplementationContext(*mLLContext, &mSimpleIslandManager->getAccurateIslandSim(), desc.narrowPhaseBackend));
 
 		mSimulationControllerCallback = PX_PLACEMENT_NEW(PX_ALLOC(sizeof(ScSimulationControllerCallback), PX_DEBUG_EXP("ScSimulationControllerCallback")), ScSimulationControllerCallback(this));
 		mSimulationController = createSimulationController(mSimulationControllerCallback);
@@ -867,6 +970,10 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 	mCCDContext = physx::PxsCCDContext::create(mLLContext, mDynamicsContext->getThresholdStream(), *mLLContext->getNphaseImplementationContext());
 	
 	setSolverBatchSize(desc.solverBatchSize);
+	mDynamicsContext->setSolverBatch8Enabled(desc.flags & PxSceneFlag::eENABLE_AVX_SOLVER);
+	mDynamicsContext->setIncrementalPartitioningEnabled(desc.flags & PxSceneFlag::eENABLE_INCREMENTAL_PARTITIONING);
+	mDynamicsContext->setAdaptiveSolverIterationsEnabled(desc.flags & PxSceneFlag::eENABLE_ADAPTIVE_SOLVER_ITERATIONS);
+	mDynamicsContext->setSolverResidualTolerance(desc.solverResidualTolerance);
 	mDynamicsContext->setFrictionOffsetThreshold(desc.frictionOffsetThreshold);
 	mDynamicsContext->setCCDSeparationThreshold(desc.ccdMaxSeparation);
 	mDynamicsContext->setSolverOffsetSlop(desc.solverOffsetSlop);
@@ -932,6 +1039,7 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 		mFilterShaderDataCapacity = 0;
 	}
 	mFilterShader = desc.filterShader;
+	mFilterShaderBatch = desc.filterShaderBatch;
 	mFilterCallback = desc.filterCallback;
 
 #if PX_USE_CLOTH_API
@@ -1361,6 +1469,12 @@ bool Sc::Scene::removeBroadPhaseRegion(PxU32 handle)
 	return bp->removeRegion(handle);
 }
 
+bool Sc::Scene::setBroadPhaseAutoRegions(const PxBounds3& worldBounds, PxU32 maxNbObjectsPerRegion)
+{
+	Bp::BroadPhase* bp = mAABBManager->getBroadPhase();
+	return bp->setAutoRegions(worldBounds, maxNbObjectsPerRegion);
+}
+
 void** Sc::Scene::getOutOfBoundsAggregates()
 {
 	PxU32 dummy;
@@ -1471,6 +1585,7 @@ void Sc::Scene::prepareCollide()
 
 void Sc::Scene::simulate(PxReal timeStep, PxBaseTask* continuation)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eSIMULATION);
 	if(timeStep != 0.f)
 	{
 		mDt = timeStep;
@@ -1536,6 +1651,10 @@ PxFrictionType::Enum Sc::Scene::getFrictionType() const
 
 void Sc::Scene::setPCM(bool enabled)
 {
+#if PX_STATIC_PCM_NARROWPHASE
+	if(!enabled)
+		shdfnd::getFoundation().error(PxErrorCode::eDEBUG_WARNING, __FILE__, __LINE__, "PxSceneFlag::eENABLE_PCM is not set, but this build always uses PCM contact generation.");
+#endif
 	mLLContext->setPCM(enabled);
 }
 
@@ -1776,6 +1895,11 @@ void Sc::Scene::addActiveBreakableConstraint(Sc::ConstraintSim* c, Sc::Constrain
 	PX_ASSERT(!c->isBroken());
 	mActiveBreakableConstraints.insert(c);
 	c->setFlag(ConstraintSim::eCHECK_MAX_FORCE_EXCEEDED);
+
+	const PxU32 index = c->getLowLevelConstraint().index;
+	if(index >= mActiveBreakableConstraintsByIndex.size())
+		mActiveBreakableConstraintsByIndex.resize(index+1, NULL);
+	mActiveBreakableConstraintsByIndex[index] = c;
 }
 
 void Sc::Scene::removeActiveBreakableConstraint(Sc::ConstraintSim* c)
@@ -1784,6 +1908,9 @@ void Sc::Scene::removeActiveBreakableConstraint(Sc::ConstraintSim* c)
 	PX_ASSERT(exists);
 	PX_UNUSED(exists);
 	c->clearFlag(ConstraintSim::eCHECK_MAX_FORCE_EXCEEDED);
+
+	PX_ASSERT(mActiveBreakableConstraintsByIndex[c->getLowLevelConstraint().index] == c);
+	mActiveBreakableConstraintsByIndex[c->getLowLevelConstraint().index] = NULL;
 }
 
 void* Sc::Scene::allocateConstraintBlock(PxU32 size)
@@ -1989,6 +2116,7 @@ PxBaseTask& Sc::Scene::scheduleParticleGpu(PxBaseTask& continuation)
 
 void Sc::Scene::advanceStep(PxBaseTask* continuation)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eSIMULATION);
 	PX_PROFILE_ZONE("Sim.solveQueueTasks", getContextId());
 
 	if (mDt != 0.0f)
@@ -2079,6 +2207,7 @@ void Sc::Scene::advanceStep(PxBaseTask* continuation)
 
 void Sc::Scene::collideStep(PxBaseTask* continuation)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eSIMULATION);
 	PX_PROFILE_ZONE("Sim.collideQueueTasks", getContextId());
 	PX_PROFILE_START_CROSSTHREAD("Basic.collision", getContextId());
 
@@ -2122,6 +2251,7 @@ void Sc::Scene::clothPreprocessing(PxBaseTask* /*continuation*/)
 void Sc::Scene::broadPhase(PxBaseTask* continuation)
 {
 	PX_PROFILE_START_CROSSTHREAD("Basic.broadPhase", getContextId());
+	mStats->stageStart(PxSimulationStatistics::eSTAGE_BROAD_PHASE);
 
 #if PX_USE_CLOTH_API
 		ClothCore* const* clothList = mCloths.getEntries();
@@ -2129,6 +2259,11 @@ void Sc::Scene::broadPhase(PxBaseTask* continuation)
 			clothList[i]->getSim()->updateBounds();
 #endif
 
+	//Intermediate substeps reuse the pairs found in the first substep of the frame, whose bounds were inflated to cover the whole frame.
+	mBroadPhaseDeferred = mSubstepIndex != 0 && mAABBManager->deferUpdate(mHasContactDistanceChanged, &mRigidBodyNPhaseUnlock);
+	if(mBroadPhaseDeferred)
+		return;
+
 	const PxU32 numCpuTasks = continuation->getTaskManager()->getCpuDispatcher()->getWorkerCount();
 	mAABBManager->updateAABBsAndBP(numCpuTasks, mLLContext->getTaskPool(), &mLLContext->getScratchAllocator(), mHasContactDistanceChanged, continuation, &mRigidBodyNPhaseUnlock);
 }
@@ -2145,7 +2280,10 @@ void Sc::Scene::postBroadPhase(PxBaseTask* continuation)
 
 void Sc::Scene::postBroadPhaseContinuation(PxBaseTask* continuation)
 {
-	mAABBManager->getChangedAABBMgActorHandleMap().clear();
+	//Shapes that moved during a deferred broad phase stay marked so that the next broad phase update picks them up.
+	if(!mBroadPhaseDeferred)
+		mAABBManager->getChangedAABBMgActorHandleMap().clear();
+	mBroadPhaseDeferred = false;
 
 	// - Finishes broadphase update
 	// - Adds new interactions (and thereby contact managers if needed)
@@ -2161,10 +2299,12 @@ void Sc::Scene::postBroadPhaseStage2(PxBaseTask* continuation)
 	mRegisterContactManagers.setContinuation(continuation);
 	mRegisterInteractions.setContinuation(continuation);
 	mRegisterSceneInteractions.setContinuation(continuation);
+	mRegisterNPhaseInteractions.setContinuation(continuation);
 	mIslandInsertion.removeReference();
 	mRegisterContactManagers.removeReference();
 	mRegisterInteractions.removeReference();
 	mRegisterSceneInteractions.removeReference();
+	mRegisterNPhaseInteractions.removeReference();
 
 	{
 		PX_PROFILE_ZONE("Sim.processNewOverlaps.release", getContextId());
@@ -2192,6 +2332,7 @@ void Sc::Scene::postBroadPhaseStage3(PxBaseTask* /*continuation*/)
 {
 	finishBroadPhaseStage2(0);
 
+	mStats->stageEnd(PxSimulationStatistics::eSTAGE_BROAD_PHASE);
 	PX_PROFILE_STOP_CROSSTHREAD("Basic.postBroadPhase", getContextId());
 	PX_PROFILE_STOP_CROSSTHREAD("Basic.broadPhase", getContextId());
 }
@@ -2301,7 +2442,11 @@ void Sc::Scene::preRigidBodyNarrowPhase(PxBaseTask* continuation)
 	//calculate contact distance for speculative CCD shapes
 	Cm::BitMap::Iterator speculativeCCDIter(mSpeculativeCCDRigidBodyBitMap);
 
-	SpeculativeCCDContactDistanceUpdateTask* ccdTask = PX_PLACEMENT_NEW(pool.allocate(sizeof(SpeculativeCCDContactDistanceUpdateTask)), SpeculativeCCDContactDistanceUpdateTask)(getContextId(), mContactDistance->begin(), mDt, *mBoundsArray);
+	//When substepping, the contact distance covers the rest of the frame so that the pairs found by the broad phase in the first substep
+	//remain valid while the broad phase is deferred.
+	const PxReal speculativeDt = mDt * PxReal(mNbSubsteps - mSubstepIndex);
+
+	SpeculativeCCDContactDistanceUpdateTask* ccdTask = PX_PLACEMENT_NEW(pool.allocate(sizeof(SpeculativeCCDContactDistanceUpdateTask)), SpeculativeCCDContactDistanceUpdateTask)(getContextId(), mContactDistance->begin(), speculativeDt, *mBoundsArray);
 
 	IG::IslandSim& islandSim = mSimpleIslandManager->getAccurateIslandSim();
 
@@ -2314,7 +2459,9 @@ void Sc::Scene::preRigidBodyNarrowPhase(PxBaseTask* continuation)
 	{
 		PxsRigidBody* rigidBody = islandSim.getRigidBody(IG::NodeIndex(index));
 		Sc::BodySim* bodySim = reinterpret_cast<Sc::BodySim*>(reinterpret_cast<PxU8*>(rigidBody)-bodyOffset);
-		if (bodySim)
+		//Sleeping and frozen bodies keep the contact distance computed when they last moved, so there is no need to
+		//recompute it or to push their shapes through the broad phase again.
+		if (bodySim && islandSim.getNode(IG::NodeIndex(index)).isActiveOrActivating() && !bodySim->isFrozen())
 		{
 			hasContactDistanceChanged = true;
 			ccdTask->mBodySims[ccdTask->mNbBodies++] = bodySim;
@@ -2330,7 +2477,7 @@ void Sc::Scene::preRigidBodyNarrowPhase(PxBaseTask* continuation)
 			{
 				ccdTask->setContinuation(continuation);
 				ccdTask->removeReference();
-				ccdTask = PX_PLACEMENT_NEW(pool.allocate(sizeof(SpeculativeCCDContactDistanceUpdateTask)), SpeculativeCCDContactDistanceUpdateTask)(getContextId(), mContactDistance->begin(), mDt, *mBoundsArray);
+				ccdTask = PX_PLACEMENT_NEW(pool.allocate(sizeof(SpeculativeCCDContactDistanceUpdateTask)), SpeculativeCCDContactDistanceUpdateTask)(getContextId(), mContactDistance->begin(), speculativeDt, *mBoundsArray);
 			}
 		}
 	}
@@ -2351,7 +2498,7 @@ void Sc::Scene::preRigidBodyNarrowPhase(PxBaseTask* continuation)
 		if (articulationSim)
 		{
 			hasContactDistanceChanged = true;
-			articulationUpdateTask = PX_PLACEMENT_NEW(pool.allocate(sizeof(SpeculativeCCDContactDistanceArticulationUpdateTask)), SpeculativeCCDContactDistanceArticulationUpdateTask)(getContextId(), mContactDistance->begin(), mDt, *mBoundsArray);
+			articulationUpdateTask = PX_PLACEMENT_NEW(pool.allocate(sizeof(SpeculativeCCDContactDistanceArticulationUpdateTask)), SpeculativeCCDContactDistanceArticulationUpdateTask)(getContextId(), mContactDistance->begin(), speculativeDt, *mBoundsArray);
 			articulationUpdateTask->mArticulation = articulationSim;
 			articulationUpdateTask->setContinuation(continuation);
 			articulationUpdateTask->removeReference();
@@ -2361,7 +2508,7 @@ void Sc::Scene::preRigidBodyNarrowPhase(PxBaseTask* continuation)
 	mHasContactDistanceChanged = hasContactDistanceChanged;
 	
 	//Process dirty shapeSims...
-	Cm::BitMap::Iterator dirtyShapeIter(mDirtyShapeSimMap);
+	Cm::HierarchicalBitMap::Iterator dirtyShapeIter(mDirtyShapeSimMap);
 
 	PxsTransformCache& cache = mLLContext->getTransformCache();
 	Bp::BoundsArray& boundsArray = mAABBManager->getBoundsArray();
@@ -2369,7 +2516,7 @@ void Sc::Scene::preRigidBodyNarrowPhase(PxBaseTask* continuation)
 	DirtyShapeUpdatesTask* task = PX_PLACEMENT_NEW(pool.allocate(sizeof(DirtyShapeUpdatesTask)), DirtyShapeUpdatesTask)(getContextId(), cache, boundsArray);
 
 	bool hasDirtyShapes = false;
-	while ((index = dirtyShapeIter.getNext()) != Cm::BitMap::Iterator::DONE)
+	while ((index = dirtyShapeIter.getNext()) != Cm::HierarchicalBitMap::Iterator::DONE)
 	{
 		Sc::ShapeSim* shapeSim = reinterpret_cast<Sc::ShapeSim*>(mAABBManager->getUserData(index));
 		if (shapeSim)
@@ -2406,6 +2553,7 @@ void Sc::Scene::preRigidBodyNarrowPhase(PxBaseTask* continuation)
 void Sc::Scene::rigidBodyNarrowPhase(PxBaseTask* continuation)
 {
 	PX_PROFILE_START_CROSSTHREAD("Basic.narrowPhase", getContextId());
+	mStats->stageStart(PxSimulationStatistics::eSTAGE_NARROW_PHASE);
 
 	mCCDPass = 0;
 
@@ -2476,6 +2624,7 @@ void Sc::Scene::postNarrowPhase(PxBaseTask* /*continuation*/)
 
 	releaseConstraints(false);
 
+	mStats->stageEnd(PxSimulationStatistics::eSTAGE_NARROW_PHASE);
 	PX_PROFILE_STOP_CROSSTHREAD("Basic.narrowPhase", getContextId());
 	PX_PROFILE_STOP_CROSSTHREAD("Basic.collision", getContextId());
 }
@@ -2712,6 +2861,7 @@ void Sc::Scene::processLostSolverPatches(PxBaseTask* /*continuation*/)
 void Sc::Scene::islandGen(PxBaseTask* continuation)
 {
 	PX_PROFILE_START_CROSSTHREAD("Basic.rigidBodySolver", getContextId());
+	mStats->stageStart(PxSimulationStatistics::eSTAGE_ISLAND_GEN);
 
 	//mLLContext->runModifiableContactManagers(); //KS - moved here so that we can get up-to-date touch found/lost events in IG
 
@@ -2887,6 +3037,39 @@ void Sc::Scene::postThirdPassIslandGen(PxBaseTask* /*continuation*/)
 	mNPhaseCore->processPersistentContactEvents(outputs);
 }
 
+// Looks up the interactions of a range of destroyed overlaps. The element sim map is only read here, so ranges can run in parallel.
+class FindInteractionsTask : public Cm::Task
+{
+public:
+	static const PxU32 MaxPairs = 512;
+
+	FindInteractionsTask(PxU64 contextID, Sc::NPhaseCore* nPhaseCore, Bp::AABBOverlap* PX_RESTRICT pairs, PxU32 nbPairs) :
+		Cm::Task	(contextID),
+		mNPhaseCore	(nPhaseCore),
+		mPairs		(pairs),
+		mNbPairs	(nbPairs)
+	{
+	}
+
+	virtual void runInternal()
+	{
+		for (PxU32 a = 0; a < mNbPairs; ++a)
+		{
+			Bp::AABBOverlap& pair = mPairs[a];
+			pair.mPairUserData = mNPhaseCore->onOverlapRemovedStage1(reinterpret_cast<Sc::ElementSim*>(pair.mUserData0), reinterpret_cast<Sc::ElementSim*>(pair.mUserData1));
+		}
+	}
+
+	virtual const char* getName() const { return "ScScene.findInteractionsTask"; }
+
+private:
+	PX_NOCOPY(FindInteractionsTask)
+
+	Sc::NPhaseCore*				mNPhaseCore;
+	Bp::AABBOverlap* PX_RESTRICT	mPairs;
+	const PxU32					mNbPairs;
+};
+
 void Sc::Scene::processLostContacts(PxBaseTask* continuation)
 {
 	mProcessNarrowPhaseLostTouchTasks.setContinuation(continuation);
@@ -2902,6 +3085,19 @@ void Sc::Scene::processLostContacts(PxBaseTask* continuation)
 		Bp::SimpleAABBManager* aabbMgr = mAABBManager;
 		PxU32 destroyedOverlapCount;
 		Bp::AABBOverlap* PX_RESTRICT p = aabbMgr->getDestroyedOverlaps(Bp::VolumeBuckets::eSHAPE, destroyedOverlapCount);
+
+		// the hash lookups are cache miss bound, so spread them over the workers when many pairs separate at once.
+		// The following lost contact stages read mPairUserData, they are continuations of this task.
+		while (destroyedOverlapCount > FindInteractionsTask::MaxPairs)
+		{
+			FindInteractionsTask* task = PX_PLACEMENT_NEW(mTaskPool.allocate(sizeof(FindInteractionsTask)), FindInteractionsTask)
+				(getContextId(), mNPhaseCore, p, FindInteractionsTask::MaxPairs);
+			task->setContinuation(continuation);
+			task->removeReference();
+			p += FindInteractionsTask::MaxPairs;
+			destroyedOverlapCount -= FindInteractionsTask::MaxPairs;
+		}
+
 		while (destroyedOverlapCount--)
 		{
 			ElementSim* volume0 = reinterpret_cast<ElementSim*>(p->mUserData0);
@@ -3051,6 +3247,10 @@ void Sc::Scene::processLostContacts3(PxBaseTask* /*continuation*/)
 				ElementSim* volume0 = reinterpret_cast<ElementSim*>(p->mUserData0);
 				ElementSim* volume1 = reinterpret_cast<ElementSim*>(p->mUserData1);
 
+				// the interactions are scattered in memory, fetch the next ones while this one gets torn down
+				if (destroyedOverlapCount >= 4 && p[4].mPairUserData)
+					Ps::prefetchLine(p[4].mPairUserData);
+
 				mNPhaseCore->onOverlapRemoved(volume0, volume1, false, p->mPairUserData, outputs, useAdaptiveForce);
 				p++;
 			}
@@ -3105,6 +3305,8 @@ void Sc::Scene::updateDynamics(PxBaseTask* continuation)
 	mLLContext->getNpMemBlockPool().acquireConstraintMemory();
 
 	PX_PROFILE_START_CROSSTHREAD("Basic.dynamics", getContextId());
+	mStats->stageEnd(PxSimulationStatistics::eSTAGE_ISLAND_GEN);
+	mStats->stageStart(PxSimulationStatistics::eSTAGE_SOLVER);
 	PxU32 maxPatchCount = mLLContext->getMaxPatchCount();
 
 	PxsContactManagerOutputIterator outputs = mLLContext->getNphaseImplementationContext()->getContactManagerOutputs();
@@ -3132,6 +3334,7 @@ void Sc::Scene::updateCCDMultiPass(PxBaseTask* parentContinuation)
 	// second run of the broadphase for making sure objects we have integrated did not tunnel.
 	if(mPublicFlags & PxSceneFlag::eENABLE_CCD)
 	{
+		mStats->stageStart(PxSimulationStatistics::eSTAGE_CCD);
 		if (mContactReportsNeedPostSolverVelocity)
 		{
 			// the CCD code will overwrite the post solver body velocities, hence, we need to extract the info
@@ -3223,6 +3426,76 @@ public:
 	}
 };
 
+class UpdateCCDCachedTask : public Cm::Task
+{
+	Sc::BodySim** mBodySims;
+	PxU32 mNbToProcess;
+	PxsContext* mContext;
+	PxsTransformCache& mCache;
+	Bp::BoundsArray& mBoundsArray;
+	Cm::BitMapPinned& mChangedAABBMgrHandles;
+
+	UpdateCCDCachedTask& operator=(const UpdateCCDCachedTask&);
+
+public:
+
+	static const PxU32 MaxPerTask = 256;
+
+	UpdateCCDCachedTask(PxU64 contextID, Sc::BodySim** bodySims, PxU32 nbToProcess, PxsContext* context, PxsTransformCache& cache,
+		Bp::BoundsArray& boundsArray, Cm::BitMapPinned& changedAABBMgrHandles) :
+		Cm::Task				(contextID),
+		mBodySims				(bodySims),
+		mNbToProcess			(nbToProcess),
+		mContext				(context),
+		mCache					(cache),
+		mBoundsArray			(boundsArray),
+		mChangedAABBMgrHandles	(changedAABBMgrHandles)
+	{
+	}
+
+	virtual const char* getName() const { return "UpdateCCDCachedTask";}
+
+	virtual void runInternal()
+	{
+		Sc::BodySim* bpUpdates[MaxPerTask];
+		PxU32 nbBpUpdates = 0;
+
+		for (PxU32 i = 0; i < mNbToProcess; i++)
+		{
+			Sc::BodySim* body = mBodySims[i];
+			if(i+8 < mNbToProcess)
+				Ps::prefetch(mBodySims[i+8], 512);
+
+			PX_ASSERT(body->getBody2World().p.isFinite());
+			PX_ASSERT(body->getBody2World().q.isFinite());
+
+			if(!body->isFrozen())
+			{
+				body->updateCached(mCache, mBoundsArray);
+				bpUpdates[nbBpUpdates++] = body;
+			}
+		}
+
+		if(nbBpUpdates)
+		{
+			mCache.setChangedState();
+			mBoundsArray.setChangedState();
+
+			//Write updated bodies to changed actor map
+			Ps::Mutex::ScopedLock lock(mContext->getLock());
+			for(PxU32 i = 0; i < nbBpUpdates; i++)
+			{
+				Sc::ShapeSim* sim;
+				for (Sc::ShapeIterator iterator(*bpUpdates[i]); (sim = iterator.getNext()) != NULL;)
+				{
+					if (sim->isInBroadPhase())
+						mChangedAABBMgrHandles.growAndSet(sim->getElementID());
+				}
+			}
+		}
+	}
+};
+
 void Sc::Scene::ccdBroadPhaseAABB(PxBaseTask* continuation)
 {
 	PX_PROFILE_START_CROSSTHREAD("Sim.ccdBroadPhaseComplete", getContextId());
@@ -3392,7 +3665,9 @@ public:
 	{
 		for (PxU32 i = 0; i < mNbKinematics; ++i)
 		{
-			mKinematics[i]->getSim()->updateCached(mTransformCache, mBoundsArray);
+			Sc::BodySim* sim = mKinematics[i]->getSim();
+			if (sim->readInternalFlag(Sc::BodySim::BF_KINEMATIC_MOVED))
+				sim->updateCached(mTransformCache, mBoundsArray);
 		}
 	}
 
@@ -3437,7 +3712,9 @@ void Sc::Scene::updateKinematicCached(PxBaseTask* continuation)
 		PX_ASSERT(sim->isKinematic());
 		PX_ASSERT(sim->isActive());
 
-		nbShapes += sim->getNbShapes();
+		// kinematics without a target this step (settling before sleep) have not moved, their cached data is still valid
+		if (sim->readInternalFlag(BodySim::BF_KINEMATIC_MOVED))
+			nbShapes += sim->getNbShapes();
 
 		if (nbShapes >= KinematicUpdateCachedTask::NbShapesPerTask)
 		{
@@ -3464,7 +3741,7 @@ void Sc::Scene::updateKinematicCached(PxBaseTask* continuation)
 		BodyCore* b = kinematics[i];
 		BodySim* bodySim = b->getSim();
 		Cm::BitMapPinned& changedAABBMgrActorHandles = mAABBManager->getChangedAABBMgActorHandleMap();
-		if (!(bodySim->getInternalFlag() & PxsRigidBody::eFROZEN))
+		if (!(bodySim->getInternalFlag() & PxsRigidBody::eFROZEN) && bodySim->readInternalFlag(BodySim::BF_KINEMATIC_MOVED))
 		{
 			Sc::ShapeSim* sim;
 			for (Sc::ShapeIterator iterator(*bodySim); (sim = iterator.getNext()) != NULL;)
@@ -3504,11 +3781,14 @@ public:
 			mProjectionRoots[i]->clearFlag(Sc::ConstraintGroupNode::eIN_PROJECTION_PASS_LIST);
 		}
 
-		if (tempArray.size() > 0)
+		const PxU32 nbProjected = tempArray.size();
+		if (nbProjected > 0)
 		{
+			// capacity is reserved up front in constraintProjection(), so this is a plain copy and the lock is held very briefly
 			mLLContext->getLock().lock();
-			for (PxU32 a = 0; a < tempArray.size(); ++a)
-				mProjectedBodies.pushBack(tempArray[a]);
+			const PxU32 offset = mProjectedBodies.size();
+			mProjectedBodies.resizeUninitialized(offset + nbProjected);
+			PxMemCopy(mProjectedBodies.begin() + offset, tempArray.begin(), sizeof(Sc::BodySim*) * nbProjected);
 			mLLContext->getLock().unlock();
 		}
 
@@ -3546,7 +3826,7 @@ void Sc::Scene::constraintProjection(PxBaseTask* continuation)
 
 	if(activeBodyCount)
 	{
-		mTmpConstraintGroupRootBuffer = reinterpret_cast<ConstraintGroupNode**>(mLLContext->getScratchAllocator().alloc(sizeof(ConstraintGroupNode*) * activeBodyCount, true));
+		mTmpConstraintGroupRootBuffer = reinterpret_cast<ConstraintGroupNode**>(mLLContext->getScratchAllocator().alloc(sizeof(ConstraintGroupNode*) * activeBodyCount, true, __FILE__, __LINE__));
 		if(mTmpConstraintGroupRootBuffer)
 		{
 			while(activeBodyCount--)
@@ -3570,6 +3850,9 @@ void Sc::Scene::constraintProjection(PxBaseTask* continuation)
 
 			Cm::FlushPool& flushPool = mLLContext->getTaskPool();
 
+			// each projected body is an active dynamic, so the active body count bounds the output and the tasks never grow the array under the lock
+			mProjectedBodies.reserve(islandSim.getNbActiveNodes(IG::Node::eRIGID_BODY_TYPE));
+
 			PxU32 constraintsToProjectCount = 0;
 			PxU32 startIndex = 0;
 			for(PxU32 i=0; i < constraintGroupRootCount; i++)
@@ -3637,8 +3920,10 @@ void Sc::Scene::postSolver(PxBaseTask* continuation)
 	//afterIntegration(continuation);
 }
 
-void Sc::Scene::postCCDPass(PxBaseTask* /*continuation*/)
+void Sc::Scene::postCCDPass(PxBaseTask* continuation)
 {
+	PX_PROFILE_ZONE("Sim.postCCDPass", getContextId());
+
 	// - Performs sleep check
 	// - Updates touch flags
 
@@ -3688,16 +3973,16 @@ void Sc::Scene::postCCDPass(PxBaseTask* /*continuation*/)
 	{
 		Cm::BitMapPinned& changedAABBMgrActorHandles = mAABBManager->getChangedAABBMgActorHandleMap();
 
-		for (PxU32 i = 0, s = mCcdBodies.size(); i < s; i++)
+		//Update the poses of the CCD bodies in parallel; the next pass' broad phase is the continuation
+		Cm::FlushPool& flushPool = mLLContext->getTaskPool();
+		PxsTransformCache& transformCache = mLLContext->getTransformCache();
+		for (PxU32 i = 0; i < mCcdBodies.size(); i += UpdateCCDCachedTask::MaxPerTask)
 		{
-			BodySim*const body = mCcdBodies[i];
-			if(i+8 < s)
-				Ps::prefetch(mCcdBodies[i+8], 512);
-
-			PX_ASSERT(body->getBody2World().p.isFinite());
-			PX_ASSERT(body->getBody2World().q.isFinite());
-
-			body->updateCached(&changedAABBMgrActorHandles);
+			const PxU32 nbToProcess = PxMin(UpdateCCDCachedTask::MaxPerTask, mCcdBodies.size() - i);
+			UpdateCCDCachedTask* task = PX_PLACEMENT_NEW(flushPool.allocate(sizeof(UpdateCCDCachedTask)), UpdateCCDCachedTask)(getContextId(), &mCcdBodies[i], nbToProcess,
+				mLLContext, transformCache, *mBoundsArray, changedAABBMgrActorHandles);
+			task->setContinuation(continuation);
+			task->removeReference();
 		}
 
 		ArticulationCore* const* articList = mArticulations.getEntries();
@@ -3708,10 +3993,13 @@ void Sc::Scene::postCCDPass(PxBaseTask* /*continuation*/)
 	}
 }
 
-void Sc::Scene::finalizationPhase(PxBaseTask* /*continuation*/)
+void Sc::Scene::finalizationPhase(PxBaseTask* continuation)
 {
 	PX_PROFILE_ZONE("Sim.sceneFinalization", getContextId());
 
+	if(mPublicFlags & PxSceneFlag::eENABLE_CCD)
+		mStats->stageEnd(PxSimulationStatistics::eSTAGE_CCD);
+
 	if (mCCDContext)
 	{
 		//KS - force simulation controller to update any bodies updated by the CCD. When running GPU simulation, this would be required
@@ -3756,8 +4044,18 @@ void Sc::Scene::finalizationPhase(PxBaseTask* /*continuation*/)
 
 	mTaskPool.clear();
 
+	// The bounds are final at this point. Push them to the SQ pruner now rather than in fetchResults(), the task holds
+	// the end of the step until it is done.
+	if(mSqBoundsSyncInSimulation && continuation)
+	{
+		mSyncSceneQueryBoundsTask.setContinuation(continuation);
+		mSyncSceneQueryBoundsTask.removeReference();
+	}
+
 	mReportShapePairTimeStamp++;	// important to do this before fetchResults() is called to make sure that delayed deleted actors/shapes get
 									// separate pair entries in contact reports
+
+	mStats->stepEnd();
 }
 
 void Sc::Scene::postReportsCleanup()
@@ -3774,9 +4072,30 @@ void Sc::Scene::postReportsCleanup()
 
 void Sc::Scene::syncSceneQueryBounds(SqBoundsSync& sync, SqRefFinder& finder)
 {
+	if(mSqBoundsSyncedInSimulation)
+	{
+		mSqBoundsSyncedInSimulation = false;
+		return;
+	}
 	mSqBoundsManager->syncBounds(sync, finder, mBoundsArray->begin(), getContextId(), mDirtyShapeSimMap);
 }
 
+void Sc::Scene::setSqBoundsSyncInSimulation(SqBoundsSync* sync, SqRefFinder* finder)
+{
+	PX_ASSERT((sync==NULL) == (finder==NULL));
+	mSqBoundsSyncInSimulation = sync;
+	mSqRefFinderInSimulation = finder;
+	mSqBoundsSyncedInSimulation = false;
+}
+
+void Sc::Scene::syncSceneQueryBoundsTask(PxBaseTask* /*continuation*/)
+{
+	// shapes made dirty by the application while the step runs are only flagged in fetchResults(). Their pruner bounds
+	// get recomputed from the new pose by the scene query update that follows, so syncing them here is harmless.
+	mSqBoundsManager->syncBounds(*mSqBoundsSyncInSimulation, *mSqRefFinderInSimulation, mBoundsArray->begin(), getContextId(), mDirtyShapeSimMap);
+	mSqBoundsSyncedInSimulation = true;
+}
+
 // Let the particle systems do some preparations before doing the "real" stuff.
 // - Creation / deletion of particles
 // - Particle update
@@ -4038,6 +4357,9 @@ public:
 
 void Sc::Scene::afterIntegration(PxBaseTask* continuation)
 {		
+	mStats->stageEnd(PxSimulationStatistics::eSTAGE_SOLVER);
+	mStats->stageStart(PxSimulationStatistics::eSTAGE_INTEGRATION);
+
 	mLLContext->getTransformCache().resetChangedState(); //Reset the changed state. If anything outside of the GPU kernels updates any shape's transforms, this will be raised again
 	getBoundsArray().resetChangedState();
 
@@ -4194,6 +4516,7 @@ void Sc::Scene::afterIntegration(PxBaseTask* continuation)
 	}
 
 	PX_PROFILE_STOP_CROSSTHREAD("Basic.dynamics", getContextId());
+	mStats->stageEnd(PxSimulationStatistics::eSTAGE_INTEGRATION);
 
 	checkForceThresholdContactEvents(0); 		
 }
@@ -4964,6 +5287,7 @@ void Sc::Scene::fireOnAdvanceCallback()
 
 void Sc::Scene::postCallbacksPreSync()
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eSIMULATION);
 	// clear contact stream data
 	mNPhaseCore->clearContactReportStream();
 	mNPhaseCore->clearContactReportActorPairs(false);
@@ -5025,6 +5349,26 @@ void Sc::Scene::checkConstraintBreakage()
 	PX_PROFILE_ZONE("Sim.checkConstraintBreakage", getContextId());
 
 	PxU32 count = mActiveBreakableConstraints.size();
+	if(!count)
+		return;
+
+	// The solver already tests the impulses against the break thresholds and writes the result to the dense writeback
+	// pool. When breakable constraints make up a good part of the scene, scanning that stream linearly and only touching
+	// the sims of broken constraints beats dereferencing every active breakable constraint.
+	const Ps::Array<Dy::ConstraintWriteback, Ps::VirtualAllocator>& writeBackPool = mDynamicsContext->getConstraintWriteBackPool();
+	const PxU32 nbSlots = PxMin(mActiveBreakableConstraintsByIndex.size(), writeBackPool.size());
+	if(count*4 >= nbSlots)
+	{
+		const Dy::ConstraintWriteback* PX_RESTRICT writeBacks = writeBackPool.begin();
+		ConstraintSim* const* PX_RESTRICT sims = mActiveBreakableConstraintsByIndex.begin();
+		for(PxU32 i=0; i<nbSlots; i++)
+		{
+			if(writeBacks[i].broken && sims[i])
+				sims[i]->checkMaxForceExceeded();	// clears sims[i] when the constraint breaks
+		}
+		return;
+	}
+
 	ConstraintSim* const* constraints = mActiveBreakableConstraints.getEntries(); 
 	while(count)
 	{
@@ -5036,9 +5380,19 @@ void Sc::Scene::checkConstraintBreakage()
 void Sc::Scene::getStats(PxSimulationStatistics& s) const
 {
 	mStats->readOut(s, mLLContext->getSimStats());
+	const PxcScratchAllocator& scratchAllocator = mLLContext->getScratchAllocator();
+	s.scratchBlockPeakUsage = scratchAllocator.getPeakUsage();
+	s.nbScratchBlockOverflows = scratchAllocator.getNbOverflows();
+	s.scratchBlockOverflowSize = scratchAllocator.getOverflowSize();
 	s.nbStaticBodies = mNbRigidStatics;
 	s.nbDynamicBodies = mNbRigidDynamics;
 	s.nbArticulations = mArticulations.size(); 
+	s.nbActiveIslands = mSimpleIslandManager->getAccurateIslandSim().getNbActiveIslands();
+	s.nbSettledIslands = mSimpleIslandManager->getNbSettledIslands();
+	const IG::IslandCompactionStats& compactionStats = mSimpleIslandManager->getAccurateIslandSim().getCompactionStats();
+	s.nbIslandSlots = compactionStats.mNbIslandSlots;
+	s.nbFreeIslandSlots = compactionStats.mNbFreeIslandSlots;
+	s.nbCompactedIslands = compactionStats.mNbMovedIslands + compactionStats.mNbRelinkedIslands;
 
 	s.nbAggregates = mAABBManager->getNbActiveAggregates();
 	for(PxU32 i=0; i<PxGeometryType::eGEOMETRY_COUNT; i++)
@@ -5085,6 +5439,7 @@ void Sc::Scene::removeShapes(Sc::RigidSim& sim, Ps::InlineArray<Sc::ShapeSim*, 6
 
 void Sc::Scene::addStatic(StaticCore& ro, void*const *shapes, PxU32 nbShapes, size_t shapePtrOffset, PxBounds3* uninflatedBounds)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eSIMULATION);
 	PX_ASSERT(ro.getActorCoreType() == PxActorType::eRIGID_STATIC);
 
 	// sim objects do all the necessary work of adding themselves to broad phase,
@@ -5139,6 +5494,7 @@ void Sc::Scene::removeStatic(StaticCore& ro, Ps::InlineArray<const Sc::ShapeCore
 
 void Sc::Scene::addBody(BodyCore& body, void*const *shapes, PxU32 nbShapes, size_t shapePtrOffset, PxBounds3* outBounds)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eSIMULATION);
 	// sim objects do all the necessary work of adding themselves to broad phase,
 	// activation, registering with the interaction system, etc
 
@@ -5255,6 +5611,7 @@ void Sc::Scene::addShapes(void *const* shapes, PxU32 nbShapes, size_t ptrOffset,
 
 void Sc::Scene::addStatic(PxActor* actor, BatchInsertionState& s, PxBounds3* outBounds)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eSIMULATION);
 	// static core has been prefetched by caller
 	Sc::StaticSim* sim = s.staticSim;		// static core has been prefetched by the caller
 
@@ -5272,6 +5629,7 @@ void Sc::Scene::addStatic(PxActor* actor, BatchInsertionState& s, PxBounds3* out
 
 void Sc::Scene::addBody(PxActor* actor, BatchInsertionState& s, PxBounds3* outBounds)
 {
+	Ps::AllocationScope allocScope(Ps::AllocationCategory::eSIMULATION);
 	Sc::BodySim* sim = s.bodySim;		// body core has been prefetched by the caller
 
 	const Cm::PtrTable* shapeTable = Ps::pointerOffset<const Cm::PtrTable*>(actor, s.dynamicShapeTableOffset);
@@ -5483,6 +5841,42 @@ PX_DEPRECATED PxActiveTransform* Sc::Scene::getActiveTransforms(PxU32& nbTransfo
 	return mClients[client]->activeTransforms.begin();
 }
 
+namespace
+{
+	// number of active bodies processed by each job of the parallel build, see PxSceneFlag::eENABLE_PARALLEL_STATE_SYNC
+	const PxU32 gNbBodiesPerActiveActorsJob = 2048;
+
+	// Counts (first pass) then writes (second pass) the active actors of each client for a range of bodies. The ranges
+	// are written in body order, so the lists are the same as those of the serial build.
+	struct ActiveActorsJob
+	{
+		Sc::BodyCore*const*	mBodies;
+		PxU32				mNbBodies;
+		PxU32				mNbClients;
+		PxU32*				mOffsets;		// mNbClients entries per job: counts after the first pass, write offsets in the second
+		PxActor**const*		mOutputs;		// active actors array of each client, NULL in the first pass
+
+		void operator()(PxU32 index)
+		{
+			const PxU32 start = index*gNbBodiesPerActiveActorsJob;
+			const PxU32 end = PxMin(start + gNbBodiesPerActiveActorsJob, mNbBodies);
+			PxU32* PX_RESTRICT offsets = mOffsets + index*mNbClients;
+			for(PxU32 i=start;i<end;i++)
+			{
+				const Sc::BodyCore* body = mBodies[i];
+				if(body->isFrozen())
+					continue;
+
+				const PxClientID client = body->getOwnerClient();
+				PX_ASSERT(client < mNbClients);
+				if(mOutputs)
+					mOutputs[client][offsets[client]] = body->getPxActor();
+				offsets[client]++;
+			}
+		}
+	};
+}
+
 void Sc::Scene::buildActiveActors()
 {
 	PxU32 numActiveBodies;
@@ -5504,6 +5898,40 @@ void Sc::Scene::buildActiveActors()
 	for (PxU32 i = 0; i < numClients; i++)
 		clients[i]->activeActors.clear();
 
+	if((getPublicFlags() & PxSceneFlag::eENABLE_PARALLEL_STATE_SYNC) && numActiveBodies > gNbBodiesPerActiveActorsJob)
+	{
+		PxCpuDispatcher* dispatcher = getTaskManager().getCpuDispatcher();
+		const PxU32 nbJobs = (numActiveBodies + gNbBodiesPerActiveActorsJob - 1)/gNbBodiesPerActiveActorsJob;
+
+		Ps::Array<PxU32> offsets(nbJobs*numClients, 0);
+		ActiveActorsJob job;
+		job.mBodies		= activeBodies;
+		job.mNbBodies	= numActiveBodies;
+		job.mNbClients	= numClients;
+		job.mOffsets	= offsets.begin();
+		job.mOutputs	= NULL;
+		Cm::runParallelJobs(dispatcher, nbJobs, job);
+
+		// turn the counts into write offsets, job after job for each client
+		Ps::Array<PxActor**> outputs(numClients);
+		for(PxU32 c=0; c<numClients; c++)
+		{
+			PxU32 total = 0;
+			for(PxU32 j=0; j<nbJobs; j++)
+			{
+				const PxU32 count = offsets[j*numClients + c];
+				offsets[j*numClients + c] = total;
+				total += count;
+			}
+			clients[c]->activeActors.resizeUninitialized(total);
+			outputs[c] = clients[c]->activeActors.begin();
+		}
+
+		job.mOutputs = outputs.begin();
+		Cm::runParallelJobs(dispatcher, nbJobs, job);
+		return;
+	}
+
 	for(PxU32 i=0; i<numActiveBodies; i++)
 	{
 		if(!activeBodies[i]->isFrozen())
@@ -5548,6 +5976,16 @@ void Sc::Scene::reserveTriggerReportBufferSpace(const PxU32 pairCount, PxTrigger
 	triggerPairExtraBuffer = mTriggerBufferExtraData->begin() + oldSize;
 }
 
+void Sc::Scene::releaseTriggerReportBufferSpace(const PxU32 pairCount)
+{
+	// gives back unused entries at the end of the most recent reserveTriggerReportBufferSpace() call
+	const PxU32 oldSize = mTriggerBufferAPI.size();
+	PX_ASSERT(pairCount <= oldSize);
+	PX_ASSERT(oldSize == mTriggerBufferExtraData->size());
+	mTriggerBufferAPI.forceSize_Unsafe(oldSize - pairCount);
+	mTriggerBufferExtraData->forceSize_Unsafe(oldSize - pairCount);
+}
+
 PxClientID Sc::Scene::createClient()
 {
 	mClients.pushBack(PX_NEW(Client)());
@@ -6262,10 +6700,24 @@ void Sc::Scene::registerInteractions(PxBaseTask* /*continuation*/)
 	}
 }
 
+static PX_FORCE_INLINE void reserveInteractionArray(Ps::Array<Sc::Interaction*>& interactions, PxU32 nbToAdd)
+{
+	const PxU32 needed = interactions.size() + nbToAdd;
+	if(needed > interactions.capacity())
+		interactions.reserve(PxMax(needed, interactions.capacity()*2));
+}
+
+// The scene interaction arrays, the element pair map and the active contact manager bitmap are independent, so
+// registerSceneInteractions and registerNPhaseInteractions run side by side. Both walk the preallocated arrays
+// in order, which keeps the resulting interaction ids deterministic.
 void Sc::Scene::registerSceneInteractions(PxBaseTask* /*continuation*/)
 {
 	PX_PROFILE_ZONE("Sim.processNewOverlaps.registerInteractionsScene", getContextId());
 	const PxU32 nbShapeIdxCreated = mPreallocatedShapeInteractions.size();
+	const PxU32 nbInteractionMarkers = mPreallocatedInteractionMarkers.size();
+	reserveInteractionArray(mInteractions[InteractionType::eOVERLAP], nbShapeIdxCreated);
+	reserveInteractionArray(mInteractions[InteractionType::eMARKER], nbInteractionMarkers);
+
 	for (PxU32 a = 0; a < nbShapeIdxCreated; ++a)
 	{
 		size_t address = reinterpret_cast<size_t>(mPreallocatedShapeInteractions[a]);
@@ -6273,6 +6725,33 @@ void Sc::Scene::registerSceneInteractions(PxBaseTask* /*continuation*/)
 		{
 			ShapeInteraction* interaction = reinterpret_cast<ShapeInteraction*>(address&size_t(~1));
 			registerInteraction(interaction, interaction->getContactManager() != NULL);
+		}
+	}
+
+	for (PxU32 a = 0; a < nbInteractionMarkers; ++a)
+	{
+		size_t address = reinterpret_cast<size_t>(mPreallocatedInteractionMarkers[a]);
+		if (address & 1)
+		{
+			ElementInteractionMarker* interaction = reinterpret_cast<ElementInteractionMarker*>(address&size_t(~1));
+			registerInteraction(interaction, false);
+		}
+	}
+}
+
+void Sc::Scene::registerNPhaseInteractions(PxBaseTask* /*continuation*/)
+{
+	PX_PROFILE_ZONE("Sim.processNewOverlaps.registerInteractionsNPhase", getContextId());
+	const PxU32 nbShapeIdxCreated = mPreallocatedShapeInteractions.size();
+	const PxU32 nbInteractionMarkers = mPreallocatedInteractionMarkers.size();
+	mNPhaseCore->reserveInteractions(nbShapeIdxCreated + nbInteractionMarkers);
+
+	for (PxU32 a = 0; a < nbShapeIdxCreated; ++a)
+	{
+		size_t address = reinterpret_cast<size_t>(mPreallocatedShapeInteractions[a]);
+		if (address & 1)
+		{
+			ShapeInteraction* interaction = reinterpret_cast<ShapeInteraction*>(address&size_t(~1));
 			mNPhaseCore->registerInteraction(interaction);
 
 			const PxsContactManager* cm = interaction->getContactManager();
@@ -6283,14 +6762,12 @@ void Sc::Scene::registerSceneInteractions(PxBaseTask* /*continuation*/)
 		}
 	}
 
-	const PxU32 nbInteractionMarkers = mPreallocatedInteractionMarkers.size();
 	for (PxU32 a = 0; a < nbInteractionMarkers; ++a)
 	{
 		size_t address = reinterpret_cast<size_t>(mPreallocatedInteractionMarkers[a]);
 		if (address & 1)
 		{
 			ElementInteractionMarker* interaction = reinterpret_cast<ElementInteractionMarker*>(address&size_t(~1));
-			registerInteraction(interaction, false);
 			mNPhaseCore->registerInteraction(interaction);
 		}
 	}
@@ -6330,18 +6807,14 @@ public:
 
 	virtual void runInternal()
 	{
+		mNPhaseCore->onOverlapFilter(mPairs, mNbToProcess, mFinfo);
+
 		for(PxU32 a = 0; a < mNbToProcess; ++a)
 		{
-			const Bp::AABBOverlap& pair = mPairs[a];
-			Sc::ElementSim* e0 = reinterpret_cast<Sc::ElementSim*>(pair.mUserData0);
-			Sc::ElementSim* e1 = reinterpret_cast<Sc::ElementSim*>(pair.mUserData1);
-
-			PX_ASSERT(e0 != NULL);
-			PX_ASSERT(e1 != NULL);
-
-			const PxFilterInfo finfo = mNPhaseCore->onOverlapFilter(e0, e1);
+			PX_ASSERT(mPairs[a].mUserData0 != NULL);
+			PX_ASSERT(mPairs[a].mUserData1 != NULL);
 
-			mFinfo[a] = finfo;
+			const PxFilterInfo& finfo = mFinfo[a];
 
 			if(!(finfo.filterFlags & PxFilterFlag::eKILL))
 			{
@@ -98,6 +98,8 @@ ShapeCore::ShapeCore(const PxGeometry& geometry,
 	mCore.mShapeFlags		= shapeFlags;
 
 	setMaterialIndices(materialIndices, materialCount);
+
+	updateScaledLocalBounds();
 }
 
 // PX_SERIALIZATION
@@ -250,6 +252,13 @@ void ShapeCore::setGeometry(const PxGeometry& geom)
 		// geometry changed to non-mesh type
 		materials.deallocate();
 	}
+
+	updateScaledLocalBounds();
+}
+
+void ShapeCore::updateScaledLocalBounds()
+{
+	mHasScaledLocalBounds = Gu::computeScaledLocalBounds(mScaledLocalCenter, mScaledLocalExtents, mCore.geometry.getGeometry());
 }
 
 PxShape* ShapeCore::getPxShape()
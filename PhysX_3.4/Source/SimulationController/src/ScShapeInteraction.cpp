@@ -567,6 +567,9 @@ void Sc::ShapeInteraction::processUserNotification(PxU32 contactEvent, PxU16 inf
 			infoFlags = cp->flags;
 			infoFlags |= unswapped ? 0 : PxContactPairFlag::eINTERNAL_CONTACTS_ARE_FLIPPED;
 
+			// The report references the narrow phase (or CCD) contact stream directly instead of copying it into the
+			// contact report buffer. The streams are not reset or released to other users before fetchResults() completes.
+
 			//PX_ASSERT(0==(reinterpret_cast<const uintptr_t>(impulses) & 0x0f));
 			
 			PxU32 impulseSize = impulses ? (nbPoints * sizeof(PxReal)) : 0;
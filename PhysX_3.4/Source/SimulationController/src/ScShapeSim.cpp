@@ -71,6 +71,15 @@ namespace physx
 	extern bool gUnifiedHeightfieldCollision;
 }
 
+// Shapes shared by many actors compute their mesh-scaled local bounds once in the ShapeCore, so each instance only transforms that box
+static PX_FORCE_INLINE void updateShapeBounds(Bp::BoundsArray& boundsArray, const Sc::ShapeCore& core, const PxTransform& absPose, PxU32 index)
+{
+	if(core.hasScaledLocalBounds())
+		boundsArray.updateBoundsFromScaledLocalBounds(absPose, core.getScaledLocalCenter(), core.getScaledLocalExtents(), index);
+	else
+		boundsArray.updateBounds(absPose, core.getGeometryUnion(), index, !gUnifiedHeightfieldCollision);
+}
+
 static PX_FORCE_INLINE void resetElementID(Sc::Scene& scene, Sc::ShapeSim& shapeSim)
 {
 	PX_ASSERT(!shapeSim.isInBroadPhase());
@@ -95,7 +104,7 @@ void Sc::ShapeSim::initSubsystemsDependingOnElementID()
 	cache.initEntry(index);
 	cache.setTransformCache(absPos, 0, index);
 
-	boundsArray.updateBounds(absPos, mCore.getGeometryUnion(), index, !gUnifiedHeightfieldCollision);
+	updateShapeBounds(boundsArray, mCore, absPos, index);
 	
 	{
 		PX_PROFILE_ZONE("API.simAddShapeToBroadPhase", scScene.getContextId());
@@ -389,24 +398,32 @@ void Sc::ShapeSim::updateCached(PxU32 transformCacheFlags, Cm::BitMapPinned* sha
 	const PxU32 index = getElementID();
 
 	scene.getLowLevelContext()->getTransformCache().setTransformCache(absPose, transformCacheFlags, index);
-	scene.getBoundsArray().updateBounds(absPose, mCore.getGeometryUnion(), index, !gUnifiedHeightfieldCollision);
+	updateShapeBounds(scene.getBoundsArray(), mCore, absPose, index);
 	if (shapeChangedMap && isInBroadPhase())
 		shapeChangedMap->growAndSet(index);
 }
 
-void Sc::ShapeSim::updateCached(PxsTransformCache& transformCache, Bp::BoundsArray& boundsArray)
+const PxTransform& Sc::ShapeSim::updateCachedTransform(PxsTransformCache& transformCache)
 {
-	const PxU32 index = getElementID();
-
-	PxsCachedTransform& ct = transformCache.getTransformCache(index);
+	PxsCachedTransform& ct = transformCache.getTransformCache(getElementID());
 	Ps::prefetchLine(&ct);
 
 	getAbsPoseAligned(&ct.transform);
 
 	ct.flags = 0;
 
-	PxBounds3& b = boundsArray.begin()[index];
-	Gu::computeBounds(b, mCore.getGeometryUnion().getGeometry(), ct.transform, 0.0f, NULL, 1.0f, !physx::gUnifiedHeightfieldCollision);
+	return ct.transform;
+}
+
+void Sc::ShapeSim::updateCached(PxsTransformCache& transformCache, Bp::BoundsArray& boundsArray)
+{
+	const PxTransform& pose = updateCachedTransform(transformCache);
+
+	PxBounds3& b = boundsArray.begin()[getElementID()];
+	if(mCore.hasScaledLocalBounds())
+		Gu::computeBoundsFromScaledLocalBounds(b, mCore.getScaledLocalCenter(), mCore.getScaledLocalExtents(), pose);
+	else
+		Gu::computeBounds(b, mCore.getGeometryUnion().getGeometry(), pose, 0.0f, NULL, 1.0f, !physx::gUnifiedHeightfieldCollision);
 }
 
 void Sc::ShapeSim::updateContactDistance(PxReal* contactDistance, const PxReal inflation, const PxVec3 angVel, const PxReal dt, Bp::BoundsArray& boundsArray)
@@ -522,6 +539,40 @@ void Sc::ShapeSim::onVolumeOrTransformChange(bool forceBoundsUpdate)
 	markBoundsForUpdate(forceBoundsUpdate, isDynamic);
 }
 
+void Sc::ShapeSim::onVolumeRegionChange(const PxBounds3& localRegion)
+{
+	Sc::Scene& scene = getScene();
+	Sc::BodySim* body = getBodySim();
+	const bool isDynamic = (body != NULL);
+	const bool isAsleep = body ? !body->isActive() : true;
+
+	// the test is done in shape space so that unbounded region axes stay finite
+	PX_ALIGN(16, PxTransform absPose);
+	getAbsPoseAligned(&absPose);
+	const PxTransform worldToShape = absPose.getInverse();
+	const Bp::BoundsArray& boundsArray = scene.getBoundsArray();
+
+	ElementSim::ElementInteractionIterator iter = getElemInteractions();
+	ElementSimInteraction* i = iter.getNext();
+	while(i)
+	{
+		// the bounds of the other shape of overlap and trigger pairs tell whether the pair can touch the region,
+		// other (particle) pairs are conservatively always updated
+		const InteractionType::Enum type = i->getType();
+		if(type == InteractionType::eOVERLAP || type == InteractionType::eTRIGGER)
+		{
+			const ElementSim& other = (&i->getElement0() == this) ? i->getElement1() : i->getElement0();
+			if(localRegion.intersects(PxBounds3::transformFast(worldToShape, boundsArray.getBounds(other.getElementID()))))
+				updateInteraction(scene, i, isDynamic, isAsleep);
+		}
+		else
+			updateInteraction(scene, i, isDynamic, isAsleep);
+		i = iter.getNext();
+	}
+
+	markBoundsForUpdate(false, isDynamic);
+}
+
 bool notifyActorInteractionsOfTransformChange(Sc::ActorSim& actor)
 {
 	bool isDynamic;
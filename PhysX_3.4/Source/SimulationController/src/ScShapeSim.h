@@ -107,6 +107,10 @@ namespace Sc
 						void							onFlagChange(PxShapeFlags oldFlags);
 						void							onResetFiltering();
 						void							onVolumeOrTransformChange(bool forceBoundsUpdate = false);
+														// the geometry changed inside 'localRegion' (shape space) only, e.g. modified heightfield samples.
+														// Only the pairs whose bounds overlap the region lose their cached contacts. The region can use
+														// PX_MAX_BOUNDS_EXTENTS for unbounded axes.
+						void							onVolumeRegionChange(const PxBounds3& localRegion);
 						void							onMaterialChange();  // remove when material properties are gone from PxcNpWorkUnit
 						void							onContactOffsetChange();
 						void							markBoundsForUpdate(bool forceBoundsUpdate, bool isDynamic);
@@ -126,6 +130,8 @@ namespace Sc
 
 						void							updateCached(PxU32 transformCacheFlags, Cm::BitMapPinned* shapeChangedMap);
 						void							updateCached(PxsTransformCache& transformCache, Bp::BoundsArray& boundsArray);
+						// transform cache part of updateCached, for callers computing the bounds separately
+						const PxTransform&				updateCachedTransform(PxsTransformCache& transformCache);
 						void							updateContactDistance(PxReal* contactDistance, const PxReal inflation, const PxVec3 angVel, const PxReal dt, Bp::BoundsArray& boundsArray);
 						Ps::IntBool						updateSweptBounds();
 						void							updateBPGroup();
@@ -35,11 +35,19 @@
 using namespace physx;
 
 static const PxU32 sBroadphaseAddRemoveSize = sizeof(PxU32) * PxSimulationStatistics::eVOLUME_COUNT;
-
-Sc::SimStats::SimStats()
+static const PxU32 sStageTimeSize = sizeof(PxU64) * PxSimulationStatistics::eSTAGE_COUNT;
+
+Sc::SimStats::SimStats() :
+	stepStartTime		(0),
+	stepEndTime			(0),
+	numTasks			(0),
+	taskTime			(0),
+	numWorkerThreads	(0)
 {
 	PxMemZero(&numBroadPhaseAdds, sBroadphaseAddRemoveSize);
 	PxMemZero(&numBroadPhaseRemoves, sBroadphaseAddRemoveSize);
+	PxMemZero(&stageStartTime, sStageTimeSize);
+	PxMemZero(&stageEndTime, sStageTimeSize);
 
 	clear();
 }
@@ -62,9 +70,29 @@ void Sc::SimStats::simStart()
 	PxMemMove(numBroadPhaseAdds, numBroadPhaseAddsPending, sBroadphaseAddRemoveSize);
 	PxMemMove(numBroadPhaseRemoves, numBroadPhaseRemovesPending, sBroadphaseAddRemoveSize);
 	clear();
+
+	PxMemZero(&stageStartTime, sStageTimeSize);
+	PxMemZero(&stageEndTime, sStageTimeSize);
+	stepStartTime = Ps::Time::getCurrentCounterValue();
+	stepEndTime = 0;
 #endif
 }
 
+void Sc::SimStats::setTaskStats(PxU32 nbTasks, PxU32 time, PxU32 nbWorkerThreads)
+{
+	numTasks = nbTasks;
+	taskTime = time;
+	numWorkerThreads = nbWorkerThreads;
+}
+
+static PX_FORCE_INLINE PxReal ticksToSeconds(PxU64 start, PxU64 end)
+{
+	if(!start || end <= start)
+		return 0.0f;
+	const PxU64 tensOfNanos = Ps::Time::getBootCounterFrequency().toTensOfNanos(end - start);
+	return PxReal(double(tensOfNanos) / double(Ps::Time::sNumTensOfNanoSecondsInASecond));
+}
+
 
 void Sc::SimStats::readOut(PxSimulationStatistics& s, const PxvSimStats& simStats) const
 {
@@ -130,11 +158,26 @@ void Sc::SimStats::readOut(PxSimulationStatistics& s, const PxvSimStats& simStat
 	s.peakConstraintMemory = simStats.mPeakConstraintBlockAllocations * 16 * 1024;
 	s.compressedContactSize = simStats.mTotalCompressedContactSize;
 	s.requiredContactConstraintMemory = simStats.mTotalConstraintSize;
+	s.nbNpMemBlockAcquires = simStats.mNbNpMemBlockAcquires;
+	s.nbNpMemBlockPoolRefills = simStats.mNbNpMemBlockPoolRefills;
 	s.nbNewPairs = simStats.mNbNewPairs;
 	s.nbLostPairs = simStats.mNbLostPairs;
 	s.nbNewTouches = simStats.mNbNewTouches;
 	s.nbLostTouches = simStats.mNbLostTouches;
 	s.nbPartitions = simStats.mNbPartitions;
+	for(PxU32 i=0; i < PxSimulationStatistics::eSOLVER_ITERATION_HISTOGRAM_SIZE; i++)
+	{
+		s.nbIslandsPerPositionIterations[i] = simStats.mNbIslandsPerPositionIterations[i];
+		s.nbIslandsPerVelocityIterations[i] = simStats.mNbIslandsPerVelocityIterations[i];
+	}
+
+	for(PxU32 i=0; i < PxSimulationStatistics::eSTAGE_COUNT; i++)
+		s.stageWallTime[i] = ticksToSeconds(stageStartTime[i], stageEndTime[i]);
+	s.stepWallTime = ticksToSeconds(stepStartTime, stepEndTime);
+	s.taskCpuTime = PxReal(double(taskTime) / double(Ps::Time::sNumTensOfNanoSecondsInASecond));
+	s.nbTasks = numTasks;
+	s.nbWorkerThreads = numWorkerThreads;
+	s.workerIdleTime = PxMax(PxReal(numWorkerThreads) * s.stepWallTime - s.taskCpuTime, 0.0f);
 
 #else
 	PX_UNUSED(s);
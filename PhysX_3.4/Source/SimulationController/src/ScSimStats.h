@@ -32,6 +32,7 @@
 #define PX_PHYSICS_SCP_SIM_STATS
 
 #include "PsAtomic.h"
+#include "PsTime.h"
 #include "PsUserAllocated.h"
 #include "CmPhysXCommon.h"
 #include "PxGeometry.h"
@@ -67,6 +68,36 @@ namespace Sc
 			numBroadPhaseRemovesPending[v]++;
 		}
 
+		// A stage spans from its first start to its last end within a step, so that multi-pass stages are covered.
+		PX_FORCE_INLINE void stageStart(PxSimulationStatistics::SimulationStage stage)
+		{
+#if PX_ENABLE_SIM_STATS
+			if(!stageStartTime[stage])
+				stageStartTime[stage] = Ps::Time::getCurrentCounterValue();
+#else
+			PX_UNUSED(stage);
+#endif
+		}
+
+		PX_FORCE_INLINE void stageEnd(PxSimulationStatistics::SimulationStage stage)
+		{
+#if PX_ENABLE_SIM_STATS
+			stageEndTime[stage] = Ps::Time::getCurrentCounterValue();
+#else
+			PX_UNUSED(stage);
+#endif
+		}
+
+		PX_FORCE_INLINE void stepEnd()
+		{
+#if PX_ENABLE_SIM_STATS
+			stepEndTime = Ps::Time::getCurrentCounterValue();
+#endif
+		}
+
+		// filled by the API scene once fetchResults() is done
+		void setTaskStats(PxU32 nbTasks, PxU32 taskTime, PxU32 nbWorkerThreads);
+
 	private:
 		// Broadphase adds/removes for the current simulation step
 		PxU32 numBroadPhaseAdds[PxSimulationStatistics::eVOLUME_COUNT];
@@ -76,6 +107,16 @@ namespace Sc
 		PxU32 numBroadPhaseAddsPending[PxSimulationStatistics::eVOLUME_COUNT];
 		PxU32 numBroadPhaseRemovesPending[PxSimulationStatistics::eVOLUME_COUNT];
 
+		// Stage timings of the current step, in counter ticks. Zero means not reached.
+		PxU64 stageStartTime[PxSimulationStatistics::eSTAGE_COUNT];
+		PxU64 stageEndTime[PxSimulationStatistics::eSTAGE_COUNT];
+		PxU64 stepStartTime;
+		PxU64 stepEndTime;
+
+		PxU32 numTasks;
+		PxU32 taskTime;			// tens of nanoseconds
+		PxU32 numWorkerThreads;
+
 	public:
 		typedef PxI32 TriggerPairCountsNonVolatile[PxGeometryType::eCONVEXMESH+1][PxGeometryType::eGEOMETRY_COUNT];
 		typedef volatile TriggerPairCountsNonVolatile TriggerPairCounts;
@@ -84,7 +84,7 @@ void SqBoundsManager::removeShape(ShapeSim& shape)
 	mBoundsIndices.popBack();
 }
 
-void SqBoundsManager::syncBounds(SqBoundsSync& sync, SqRefFinder& finder, const PxBounds3* bounds, PxU64 contextID, const Cm::BitMap& dirtyShapeSimMap)
+void SqBoundsManager::syncBounds(SqBoundsSync& sync, SqRefFinder& finder, const PxBounds3* bounds, PxU64 contextID, const Cm::HierarchicalBitMap& dirtyShapeSimMap)
 {
 	PX_PROFILE_ZONE("Sim.sceneQuerySyncBounds", contextID);
 	PX_UNUSED(contextID);
@@ -36,6 +36,7 @@
 #include "PsUserAllocated.h"
 #include "PsHashSet.h"
 #include "CmBitMap.h"
+#include "CmHierarchicalBitMap.h"
 
 namespace physx
 {
@@ -58,7 +59,7 @@ public:
 
 	void							addShape(ShapeSim& shape);
 	void							removeShape(ShapeSim& shape);
-	void							syncBounds(SqBoundsSync& sync, SqRefFinder& finder, const PxBounds3* bounds, PxU64 contextID, const Cm::BitMap& dirtyShapeSimMap);
+	void							syncBounds(SqBoundsSync& sync, SqRefFinder& finder, const PxBounds3* bounds, PxU64 contextID, const Cm::HierarchicalBitMap& dirtyShapeSimMap);
 
 private:
 
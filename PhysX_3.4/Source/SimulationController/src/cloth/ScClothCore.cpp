@@ -248,6 +248,7 @@ void Sc::ClothCore::updateBulkData(ClothBulkData& bulkData)
 	bulkData.mAngularInertia = mLowLevelCloth->getAngularInertia();
 	bulkData.mCentrifugalInertia = mLowLevelCloth->getCentrifugalInertia();
 	bulkData.mSolverFrequency = mLowLevelCloth->getSolverFrequency();
+	bulkData.mLodFactor = mLowLevelCloth->getLodFactor();
 	bulkData.mStiffnessFrequency = mLowLevelCloth->getStiffnessFrequency();
 	bulkData.mSelfCollisionDistance = mLowLevelCloth->getSelfCollisionDistance();
 	bulkData.mSelfCollisionStiffness = mLowLevelCloth->getSelfCollisionStiffness();
@@ -318,6 +319,7 @@ void Sc::ClothCore::resolveReferences(Sc::ClothFabricCore& fabric)
 	mLowLevelCloth->setAngularInertia(mBulkData->mAngularInertia);
 	mLowLevelCloth->setCentrifugalInertia(mBulkData->mCentrifugalInertia);
 	mLowLevelCloth->setSolverFrequency(mBulkData->mSolverFrequency);
+	mLowLevelCloth->setLodFactor(mBulkData->mLodFactor);
 	mLowLevelCloth->setStiffnessFrequency(mBulkData->mStiffnessFrequency);
 	mLowLevelCloth->setSelfCollisionDistance(mBulkData->mSelfCollisionDistance);
 	mLowLevelCloth->setSelfCollisionStiffness(mBulkData->mSelfCollisionStiffness);
@@ -870,6 +872,16 @@ PxReal Sc::ClothCore::getSolverFrequency() const
 	return mLowLevelCloth->getSolverFrequency();
 }
 
+void Sc::ClothCore::setLodFactor(PxReal factor)
+{
+	mLowLevelCloth->setLodFactor(factor);
+}
+
+PxReal Sc::ClothCore::getLodFactor() const
+{
+	return mLowLevelCloth->getLodFactor();
+}
+
 void Sc::ClothCore::setStiffnessFrequency(PxReal frequency)
 {
 	mLowLevelCloth->setStiffnessFrequency(frequency);
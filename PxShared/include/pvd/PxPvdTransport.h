@@ -121,6 +121,19 @@ PxDefaultPvdSocketTransportCreate(const char* host, int port, unsigned int timeo
 */
 PX_PVDSDK_API PxPvdTransport* PX_CALL_CONV PxDefaultPvdFileTransportCreate(const char* name);
 
+/**
+	\brief Create a file transport which writes from a dedicated thread.
+
+	The calling threads only copy the stream into a ring buffer, which a writer thread drains to the file. When the ring
+	buffer is full the calling threads wait for the writer: the capture is never truncated.
+
+	\param name full path filename used save captured pvd data, or NULL for a fake/test file transport.
+	\param bufferSize size in bytes of the ring buffer, rounded up to a power of two.
+	\param compress write the file as an LZ4 frame. Run "lz4 -d" on it to get a file PVD can load.
+*/
+PX_PVDSDK_API PxPvdTransport* PX_CALL_CONV
+PxDefaultPvdAsyncFileTransportCreate(const char* name, uint32_t bufferSize = 16 * 1024 * 1024, bool compress = true);
+
 #if !PX_DOXYGEN
 } // namespace physx
 #endif
@@ -37,6 +37,18 @@
 namespace physx
 {
 
+/**
+ * \brief Scheduling hint of a task, see PxBaseTask::setPriority()
+ */
+struct PxTaskPriority
+{
+	enum Enum
+	{
+		eNORMAL	= 0,	//!< Default priority
+		eHIGH	= 1		//!< Task on the critical path of the frame, e.g. the head of a long dependency chain
+	};
+};
+
 /**
  * \brief Base class of all task types
  *
@@ -45,7 +57,7 @@ namespace physx
 class PxBaseTask
 {
 public:
-	PxBaseTask() : mContextID(0), mTm(NULL) {}
+	PxBaseTask() : mContextID(0), mTm(NULL), mPriority(PxTaskPriority::eNORMAL) {}
 	virtual ~PxBaseTask() {}
 
     /**
@@ -94,9 +106,19 @@ public:
 	PX_FORCE_INLINE	void	setContextId(PxU64 id)			{ mContextID = id;		}
 	PX_FORCE_INLINE	PxU64	getContextId()			const	{ return mContextID;	}
 
+	/**
+	 * \brief Sets the scheduling hint of the task.
+	 *
+	 * PxCpuDispatcher implementations may run ready high priority tasks before the other ready tasks, or ignore the hint.
+	 * It must be set before the task is submitted.
+	 */
+	PX_FORCE_INLINE	void	setPriority(PxTaskPriority::Enum priority)	{ mPriority = priority;	}
+	PX_FORCE_INLINE	PxTaskPriority::Enum	getPriority()	const	{ return mPriority;		}
+
 protected:
 	PxU64				mContextID;		//!< Context ID for profiler interface
 	PxTaskManager*		mTm;			//!< Owning PxTaskManager instance
+	PxTaskPriority::Enum	mPriority;	//!< Scheduling hint for the dispatcher
 
 	friend class PxTaskMgr;
 };
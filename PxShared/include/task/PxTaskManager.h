@@ -190,6 +190,26 @@ public:
 	*/
 	virtual PxTask*   getTaskFromID(PxTaskID id) = 0;
 
+	/**
+	\brief Accounts for the run of one task. Called by tasks which measure their own run time, such as the SDK tasks.
+
+	\param[in] tensOfNanoseconds The run time of the task
+	*/
+	virtual void	addTaskRun(uint32_t tensOfNanoseconds) = 0;
+
+	/**
+	\brief Retrieves the number of task runs and their accumulated run time since the last call to resetTaskStatistics().
+
+	\param[out] nbTasks Number of tasks run
+	\param[out] tensOfNanoseconds Accumulated run time of these tasks over all threads. Wraps around after about 42 seconds.
+	*/
+	virtual void	getTaskStatistics(uint32_t& nbTasks, uint32_t& tensOfNanoseconds) const = 0;
+
+	/**
+	\brief Resets the counters returned by getTaskStatistics().
+	*/
+	virtual void	resetTaskStatistics() = 0;
+
 	/**
 	\brief Release the PxTaskManager object, referenced dispatchers will not be released
 	*/
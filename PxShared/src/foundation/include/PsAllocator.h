@@ -122,6 +122,63 @@ namespace shdfnd
 
 PX_FOUNDATION_API PxAllocatorCallback& getAllocator();
 
+/**
+Subsystems that foundation allocations are accounted against.
+*/
+struct AllocationCategory
+{
+	enum Enum
+	{
+		eOTHER = 0,
+		eFOUNDATION,
+		eSDK,
+		eSIMULATION,
+		eLOW_LEVEL,
+		eBROADPHASE,
+		eDYNAMICS,
+		eGEOMETRY,
+		eSCENE_QUERY,
+		eCOOKING,
+		eCHARACTER,
+		eVEHICLE,
+		eEXTENSIONS,
+		eCOUNT
+	};
+};
+
+/**
+Live and peak byte counts of the broadcasting allocator, per category and in total.
+Sizes are accounted in 16 byte granules, so they are rounded up per allocation.
+*/
+struct AllocationStats
+{
+	uint64_t liveBytes[AllocationCategory::eCOUNT];
+	uint64_t peakBytes[AllocationCategory::eCOUNT];
+	uint64_t totalLiveBytes;
+	uint64_t totalPeakBytes;
+};
+
+/**
+Maps a source file onto the subsystem that owns it, using the module prefix of its name (BpBroadPhase.cpp is
+eBROADPHASE). Foundation headers and unknown files return eOTHER, since containers allocate on behalf of their owner.
+*/
+PX_FOUNDATION_API AllocationCategory::Enum getAllocationCategory(const char* filename);
+
+/**
+Attributes all allocations made by the current thread to a category for the lifetime of the scope. Scopes nest, and
+take precedence over the file based category, which lets container growth be charged to the subsystem using it.
+*/
+class PX_FOUNDATION_API AllocationScope
+{
+	PX_NOCOPY(AllocationScope)
+  public:
+	AllocationScope(AllocationCategory::Enum category);
+	~AllocationScope();
+
+  private:
+	size_t mPrevious;
+};
+
 /**
 Allocator used to access the global PxAllocatorCallback instance without providing additional information.
 */
@@ -32,6 +32,8 @@
 
 #include "Ps.h"
 #include "PsInlineArray.h"
+#include "PsThread.h"
+#include "PsAtomic.h"
 
 #include "foundation/PxSimpleTypes.h"
 #include "foundation/PxErrorCallback.h"
@@ -162,9 +164,15 @@ class BroadcastingAllocator : public Broadcast<AllocationListener, PxAllocatorCa
 	/**
 	\brief The default constructor.
 	*/
-	BroadcastingAllocator(PxAllocatorCallback& allocator, PxErrorCallback& error) : mAllocator(allocator), mError(error)
+	BroadcastingAllocator(PxAllocatorCallback& allocator, PxErrorCallback& error)
+	: mAllocator(allocator), mError(error), mScopeTlsSlot(TlsAlloc()), mTotalLiveGranules(0), mTotalPeakGranules(0)
 	{
 		mListeners.clear();
+		for(uint32_t i = 0; i < AllocationCategory::eCOUNT; i++)
+		{
+			mLiveGranules[i] = 0;
+			mPeakGranules[i] = 0;
+		}
 	}
 
 	/**
@@ -173,6 +181,7 @@ class BroadcastingAllocator : public Broadcast<AllocationListener, PxAllocatorCa
 	virtual ~BroadcastingAllocator()
 	{
 		mListeners.clear();
+		TlsFree(mScopeTlsSlot);
 	}
 
 	/**
@@ -192,7 +201,7 @@ class BroadcastingAllocator : public Broadcast<AllocationListener, PxAllocatorCa
 	*/
 	void* allocate(size_t size, const char* typeName, const char* filename, int line)
 	{
-		void* mem = mAllocator.allocate(size, typeName, filename, line);
+		void* mem = mAllocator.allocate(size + sizeof(AllocationHeader), typeName, filename, line);
 
 		if(!mem)
 		{
@@ -206,6 +215,15 @@ class BroadcastingAllocator : public Broadcast<AllocationListener, PxAllocatorCa
 			return NULL;
 		}
 
+		// the scope of the allocating thread wins over the file name, which is only a fallback for direct allocations
+		const size_t scope = TlsGetValue(mScopeTlsSlot);
+		AllocationHeader* header = reinterpret_cast<AllocationHeader*>(mem);
+		header->category = scope ? uint32_t(scope - 1) : uint32_t(getAllocationCategory(filename));
+		header->granules = uint32_t((size + 15) >> 4);
+		addGranules(header->category, int32_t(header->granules));
+
+		mem = header + 1;
+
 		for(uint32_t i = 0; i < mListeners.size(); i++)
 			mListeners[i]->onAllocation(size, typeName, filename, line, mem);
 
@@ -222,16 +240,78 @@ class BroadcastingAllocator : public Broadcast<AllocationListener, PxAllocatorCa
 	*/
 	void deallocate(void* ptr)
 	{
+		if(!ptr)
+			return;
+
 		for(uint32_t i = 0; i < mListeners.size(); i++)
 		{
 			mListeners[i]->onDeallocation(ptr);
 		}
-		mAllocator.deallocate(ptr);
+
+		AllocationHeader* header = reinterpret_cast<AllocationHeader*>(ptr) - 1;
+		addGranules(header->category, -int32_t(header->granules));
+		mAllocator.deallocate(header);
+	}
+
+	/**
+	\brief The thread local slot holding the category of the innermost AllocationScope, plus one.
+	*/
+	uint32_t getScopeTlsSlot() const
+	{
+		return mScopeTlsSlot;
+	}
+
+	/**
+	\brief Reads the live and peak byte counts of all categories.
+	*/
+	void getStats(AllocationStats& stats) const
+	{
+		for(uint32_t i = 0; i < AllocationCategory::eCOUNT; i++)
+		{
+			stats.liveBytes[i] = uint64_t(uint32_t(mLiveGranules[i])) << 4;
+			stats.peakBytes[i] = uint64_t(uint32_t(mPeakGranules[i])) << 4;
+		}
+		stats.totalLiveBytes = uint64_t(uint32_t(mTotalLiveGranules)) << 4;
+		stats.totalPeakBytes = uint64_t(uint32_t(mTotalPeakGranules)) << 4;
+	}
+
+	/**
+	\brief Lowers the peak counts to the current live counts, to start a new measurement window.
+	*/
+	void resetPeaks()
+	{
+		for(uint32_t i = 0; i < AllocationCategory::eCOUNT; i++)
+			atomicExchange(&mPeakGranules[i], mLiveGranules[i]);
+		atomicExchange(&mTotalPeakGranules, mTotalLiveGranules);
 	}
 
   private:
+	// prepended to every allocation, 16 bytes to keep the user pointer 16 byte aligned
+	struct AllocationHeader
+	{
+		uint32_t category;
+		uint32_t granules;
+		uint32_t pad[2];
+	};
+
+	PX_FORCE_INLINE void addGranules(uint32_t category, int32_t granules)
+	{
+		const int32_t live = atomicAdd(&mLiveGranules[category], granules);
+		const int32_t totalLive = atomicAdd(&mTotalLiveGranules, granules);
+		if(granules > 0)
+		{
+			atomicMax(&mPeakGranules[category], live);
+			atomicMax(&mTotalPeakGranules, totalLive);
+		}
+	}
+
 	PxAllocatorCallback& mAllocator;
 	PxErrorCallback& mError;
+	const uint32_t mScopeTlsSlot;
+	volatile int32_t mLiveGranules[AllocationCategory::eCOUNT];
+	volatile int32_t mPeakGranules[AllocationCategory::eCOUNT];
+	volatile int32_t mTotalLiveGranules;
+	volatile int32_t mTotalPeakGranules;
 };
 
 /**
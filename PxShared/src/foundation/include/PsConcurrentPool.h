@@ -0,0 +1,271 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PSFOUNDATION_PSCONCURRENTPOOL_H
+#define PSFOUNDATION_PSCONCURRENTPOOL_H
+
+#include "PsArray.h"
+#include "PsSort.h"
+#include "PsBasicTemplates.h"
+#include "PsSList.h"
+#include "PsMutex.h"
+#include "PsThread.h"
+#include "PsAtomic.h"
+
+namespace physx
+{
+namespace shdfnd
+{
+
+/*!
+Allocation pool that can be used from several threads without external locking.
+
+Free elements are kept in a small set of lock-free lists, and each thread pushes to and pops from the list its id
+maps to, only stealing from the others when its own list is empty. Slab allocation is the only locked operation.
+Construction and destruction of the pool, as well as releaseEmptySlabs(), must not overlap with other calls.
+*/
+template <class T, uint32_t slabSize = 4096, class Alloc = typename AllocatorTraits<T>::Type>
+class ConcurrentPool : public UserAllocated, public Alloc
+{
+	PX_NOCOPY(ConcurrentPool)
+
+	static const uint32_t NB_LANES = 8;
+
+	// every element doubles as a free list entry, so it is padded to the SList alignment
+	static const uint32_t ELEMENT_SIZE = uint32_t((sizeof(T) + PX_SLIST_ALIGNMENT - 1) & ~(PX_SLIST_ALIGNMENT - 1));
+	static const uint32_t ELEMENTS_PER_SLAB = slabSize >= ELEMENT_SIZE ? slabSize / ELEMENT_SIZE : 1;
+	static const uint32_t SLAB_BYTES = ELEMENTS_PER_SLAB * ELEMENT_SIZE;
+
+  public:
+	ConcurrentPool(const Alloc& alloc = Alloc()) : Alloc(alloc), mSlabs(alloc), mUsed(0)
+	{
+	}
+
+	~ConcurrentPool()
+	{
+		if(mUsed)
+			disposeElements();
+
+		for(void** slabIt = mSlabs.begin(), *slabEnd = mSlabs.end(); slabIt != slabEnd; ++slabIt)
+			Alloc::deallocate(*slabIt);
+	}
+
+	// Allocate space for single object
+	PX_INLINE T* allocate()
+	{
+		const uint32_t lane = getLane();
+		SListEntry* entry = NULL;
+		for(uint32_t i = 0; i < NB_LANES && !entry; i++)
+			entry = mFreeLists[(lane + i) & (NB_LANES - 1)].pop();
+
+		T* p = entry ? reinterpret_cast<T*>(entry) : allocateSlab(lane);
+		atomicIncrement(&mUsed);
+#if PX_CHECKED
+		for(uint32_t i = 0; i < sizeof(T); ++i)
+			reinterpret_cast<uint8_t*>(p)[i] = 0xcd;
+#endif
+		return p;
+	}
+
+	// Put space for a single element back in the lists
+	PX_INLINE void deallocate(T* p)
+	{
+		if(p)
+		{
+			PX_ASSERT(mUsed);
+			atomicDecrement(&mUsed);
+			mFreeLists[getLane()].push(*PX_PLACEMENT_NEW(p, SListEntry)());
+		}
+	}
+
+	PX_INLINE T* construct()
+	{
+		T* t = allocate();
+		return t ? new (t) T() : 0;
+	}
+
+	template <class A1>
+	PX_INLINE T* construct(A1& a)
+	{
+		T* t = allocate();
+		return t ? new (t) T(a) : 0;
+	}
+
+	template <class A1, class A2>
+	PX_INLINE T* construct(A1& a, A2& b)
+	{
+		T* t = allocate();
+		return t ? new (t) T(a, b) : 0;
+	}
+
+	template <class A1, class A2, class A3>
+	PX_INLINE T* construct(A1& a, A2& b, A3& c)
+	{
+		T* t = allocate();
+		return t ? new (t) T(a, b, c) : 0;
+	}
+
+	template <class A1, class A2, class A3, class A4>
+	PX_INLINE T* construct(A1& a, A2& b, A3& c, A4& d)
+	{
+		T* t = allocate();
+		return t ? new (t) T(a, b, c, d) : 0;
+	}
+
+	template <class A1, class A2, class A3, class A4, class A5>
+	PX_INLINE T* construct(A1& a, A2& b, A3& c, A4& d, A5& e)
+	{
+		T* t = allocate();
+		return t ? new (t) T(a, b, c, d, e) : 0;
+	}
+
+	PX_INLINE void destroy(T* const p)
+	{
+		if(p)
+		{
+			p->~T();
+			deallocate(p);
+		}
+	}
+
+	PX_INLINE uint32_t getUsed() const
+	{
+		return uint32_t(mUsed);
+	}
+
+	/*
+	Give the memory of slabs without live elements back to the allocator. Not thread safe.
+	*/
+	void releaseEmptySlabs()
+	{
+		Array<void*, Alloc> freeNodes(*this);
+		gatherFreeNodes(freeNodes);
+
+		Alloc& alloc(*this);
+		sort(freeNodes.begin(), freeNodes.size(), Less<void*>(), alloc);
+		sort(mSlabs.begin(), mSlabs.size(), Less<void*>(), alloc);
+
+		// both arrays are sorted, so the free nodes of each slab are contiguous
+		void** freeIt = freeNodes.begin();
+		void** freeEnd = freeNodes.end();
+		uint32_t nbKept = 0;
+		uint32_t lane = 0;
+		for(uint32_t i = 0; i < mSlabs.size(); i++)
+		{
+			uint8_t* slab = reinterpret_cast<uint8_t*>(mSlabs[i]);
+			void** first = freeIt;
+			while(freeIt != freeEnd && reinterpret_cast<uint8_t*>(*freeIt) < slab + SLAB_BYTES)
+				++freeIt;
+
+			if(uint32_t(freeIt - first) == ELEMENTS_PER_SLAB)
+			{
+				Alloc::deallocate(slab);
+				continue;
+			}
+
+			for(void** it = first; it != freeIt; ++it)
+				mFreeLists[lane++ & (NB_LANES - 1)].push(*PX_PLACEMENT_NEW(*it, SListEntry)());
+			mSlabs[nbKept++] = slab;
+		}
+		mSlabs.forceSize_Unsafe(nbKept);
+	}
+
+  private:
+	static PX_FORCE_INLINE uint32_t getLane()
+	{
+		// Fibonacci hashing of the thread id, keeping the top bits
+		const uint32_t id = uint32_t(Thread::getId() ^ (Thread::getId() >> 16));
+		return (id * 2654435761u) >> 29;
+	}
+
+	T* allocateSlab(uint32_t lane)
+	{
+		uint8_t* slab = reinterpret_cast<uint8_t*>(Alloc::allocate(SLAB_BYTES, __FILE__, __LINE__));
+		{
+			typename MutexT<Alloc>::ScopedLock lock(mSlabLock);
+			mSlabs.pushBack(slab);
+		}
+
+		// keep the first element, the rest goes to the free list of the calling thread
+		for(uint32_t i = ELEMENTS_PER_SLAB - 1; i > 0; i--)
+			mFreeLists[lane].push(*PX_PLACEMENT_NEW(slab + i * ELEMENT_SIZE, SListEntry)());
+
+		return reinterpret_cast<T*>(slab);
+	}
+
+	void gatherFreeNodes(Array<void*, Alloc>& freeNodes)
+	{
+		for(uint32_t i = 0; i < NB_LANES; i++)
+		{
+			for(SListEntry* entry = mFreeLists[i].flush(); entry;)
+			{
+				SListEntry* next = entry->next();
+				freeNodes.pushBack(entry);
+				entry = next;
+			}
+		}
+	}
+
+	/*
+	Cleanup method. Go through all active slabs and call destructor for live objects.
+	*/
+	void disposeElements()
+	{
+		Array<void*, Alloc> freeNodes(*this);
+		gatherFreeNodes(freeNodes);
+
+		Alloc& alloc(*this);
+		sort(freeNodes.begin(), freeNodes.size(), Less<void*>(), alloc);
+		sort(mSlabs.begin(), mSlabs.size(), Less<void*>(), alloc);
+
+		void** freeIt = freeNodes.begin();
+		for(void** slabIt = mSlabs.begin(), *slabEnd = mSlabs.end(); slabIt != slabEnd; ++slabIt)
+		{
+			uint8_t* slab = reinterpret_cast<uint8_t*>(*slabIt);
+			for(uint32_t i = 0; i < ELEMENTS_PER_SLAB; i++)
+			{
+				void* element = slab + i * ELEMENT_SIZE;
+				if(freeIt != freeNodes.end() && *freeIt == element)
+					++freeIt;
+				else
+					reinterpret_cast<T*>(element)->~T();
+			}
+		}
+	}
+
+	SList mFreeLists[NB_LANES];
+	MutexT<Alloc> mSlabLock;
+	Array<void*, Alloc> mSlabs;
+	volatile int32_t mUsed;
+};
+
+} // namespace shdfnd
+} // namespace physx
+
+#endif // #ifndef PSFOUNDATION_PSCONCURRENTPOOL_H
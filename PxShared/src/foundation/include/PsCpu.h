@@ -40,6 +40,9 @@ class Cpu
 {
   public:
 	static uint8_t getCpuId();
+
+	// true if the CPU and the OS support AVX2 and FMA3, i.e. code built with /arch:AVX2 or -mavx2 -mfma can run
+	static bool hasAvx2Fma();
 };
 }
 }
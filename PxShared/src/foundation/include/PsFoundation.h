@@ -111,6 +111,19 @@ class PX_FOUNDATION_API Foundation : public PxFoundation, public UserAllocated
 		return mBroadcastingAllocator;
 	} // Return the broadcasting allocator
 
+	void getAllocationStats(AllocationStats& stats) const
+	{
+		mBroadcastingAllocator.getStats(stats);
+	}
+	void resetAllocationPeaks()
+	{
+		mBroadcastingAllocator.resetPeaks();
+	}
+	PX_INLINE uint32_t getAllocationScopeTlsSlot() const
+	{
+		return mBroadcastingAllocator.getScopeTlsSlot();
+	}
+
 	void registerAllocationListener(physx::shdfnd::AllocationListener& listener);
 	void deregisterAllocationListener(physx::shdfnd::AllocationListener& listener);
 
@@ -140,6 +153,16 @@ class PX_FOUNDATION_API Foundation : public PxFoundation, public UserAllocated
 	{
 		return mTempAllocMutex;
 	}
+	PX_INLINE uint32_t getTempAllocTlsSlot() const
+	{
+		return mTempAllocTlsSlot;
+	}
+	// must be called with the temp allocator mutex held
+	PX_INLINE void addTempAllocThreadCache(TempAllocatorThreadCache& cache)
+	{
+		cache.mNext = mTempAllocThreadCaches;
+		mTempAllocThreadCaches = &cache;
+	}
 	// End allocations
 
   private:
@@ -165,6 +188,8 @@ class PX_FOUNDATION_API Foundation : public PxFoundation, public UserAllocated
 
 	AllocFreeTable mTempAllocFreeTable;
 	Mutex mTempAllocMutex;
+	TempAllocatorThreadCache* mTempAllocThreadCaches;
+	uint32_t mTempAllocTlsSlot;
 
 	Mutex mListenerMutex;
 
@@ -46,6 +46,21 @@ union TempAllocatorChunk
 	uint8_t mPad[16];          // 16 byte aligned allocations
 };
 
+// Per-thread cache of free chunks, so that most temp allocations do not take the global temp allocator mutex.
+// The caches are owned by the foundation and freed with it, also for threads that exited.
+struct TempAllocatorThreadCache
+{
+	enum
+	{
+		eNB_SIZE_CLASSES = 9,		// one per power of two from 256B to 64kB (chunks of 512B to 128kB)
+		eMAX_CHUNKS_PER_CLASS = 4
+	};
+
+	TempAllocatorThreadCache* mNext;	// in the foundation's list of caches
+	TempAllocatorChunk* mFree[eNB_SIZE_CLASSES];
+	uint32_t mNbFree[eNB_SIZE_CLASSES];
+};
+
 class TempAllocator
 {
   public:
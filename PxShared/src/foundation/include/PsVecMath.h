@@ -71,6 +71,16 @@
 #include <xmmintrin.h>
 #endif
 
+// Translation units compiled with AVX2+FMA code generation (/arch:AVX2, -mavx2 -mfma) use fused multiply-add for
+// the MulAdd/ScaleAdd family. Such units may only be mixed with SSE2 ones when every vecmath function gets inlined,
+// i.e. not in debug builds.
+#if COMPILE_VECTOR_INTRINSICS && PX_INTEL_FAMILY && (defined(__FMA__) || defined(__AVX2__))
+#define PX_VECMATH_FMA 1
+#include <immintrin.h>
+#else
+#define PX_VECMATH_FMA 0
+#endif
+
 #if COMPILE_VECTOR_INTRINSICS
 #include "PsAoS.h"
 #else
@@ -677,7 +677,11 @@ PX_FORCE_INLINE FloatV FScaleAdd(const FloatV a, const FloatV b, const FloatV c)
 	ASSERT_ISVALIDFLOATV(a);
 	ASSERT_ISVALIDFLOATV(b);
 	ASSERT_ISVALIDFLOATV(c);
+#if PX_VECMATH_FMA
+	return _mm_fmadd_ps(a, b, c);
+#else
 	return FAdd(FMul(a, b), c);
+#endif
 }
 
 PX_FORCE_INLINE FloatV FNegScaleSub(const FloatV a, const FloatV b, const FloatV c)
@@ -685,7 +689,11 @@ PX_FORCE_INLINE FloatV FNegScaleSub(const FloatV a, const FloatV b, const FloatV
 	ASSERT_ISVALIDFLOATV(a);
 	ASSERT_ISVALIDFLOATV(b);
 	ASSERT_ISVALIDFLOATV(c);
+#if PX_VECMATH_FMA
+	return _mm_fnmadd_ps(a, b, c);
+#else
 	return FSub(c, FMul(a, b));
+#endif
 }
 
 PX_FORCE_INLINE FloatV FAbs(const FloatV a)
@@ -1157,7 +1165,11 @@ PX_FORCE_INLINE Vec3V V3ScaleAdd(const Vec3V a, const FloatV b, const Vec3V c)
 	ASSERT_ISVALIDVEC3V(a);
 	ASSERT_ISVALIDFLOATV(b);
 	ASSERT_ISVALIDVEC3V(c);
+#if PX_VECMATH_FMA
+	return _mm_fmadd_ps(a, b, c);
+#else
 	return V3Add(V3Scale(a, b), c);
+#endif
 }
 
 PX_FORCE_INLINE Vec3V V3NegScaleSub(const Vec3V a, const FloatV b, const Vec3V c)
@@ -1165,7 +1177,11 @@ PX_FORCE_INLINE Vec3V V3NegScaleSub(const Vec3V a, const FloatV b, const Vec3V c
 	ASSERT_ISVALIDVEC3V(a);
 	ASSERT_ISVALIDFLOATV(b);
 	ASSERT_ISVALIDVEC3V(c);
+#if PX_VECMATH_FMA
+	return _mm_fnmadd_ps(a, b, c);
+#else
 	return V3Sub(c, V3Scale(a, b));
+#endif
 }
 
 PX_FORCE_INLINE Vec3V V3MulAdd(const Vec3V a, const Vec3V b, const Vec3V c)
@@ -1173,7 +1189,11 @@ PX_FORCE_INLINE Vec3V V3MulAdd(const Vec3V a, const Vec3V b, const Vec3V c)
 	ASSERT_ISVALIDVEC3V(a);
 	ASSERT_ISVALIDVEC3V(b);
 	ASSERT_ISVALIDVEC3V(c);
+#if PX_VECMATH_FMA
+	return _mm_fmadd_ps(a, b, c);
+#else
 	return V3Add(V3Mul(a, b), c);
+#endif
 }
 
 PX_FORCE_INLINE Vec3V V3NegMulSub(const Vec3V a, const Vec3V b, const Vec3V c)
@@ -1181,7 +1201,11 @@ PX_FORCE_INLINE Vec3V V3NegMulSub(const Vec3V a, const Vec3V b, const Vec3V c)
 	ASSERT_ISVALIDVEC3V(a);
 	ASSERT_ISVALIDVEC3V(b);
 	ASSERT_ISVALIDVEC3V(c);
+#if PX_VECMATH_FMA
+	return _mm_fnmadd_ps(a, b, c);
+#else
 	return V3Sub(c, V3Mul(a, b));
+#endif
 }
 
 PX_FORCE_INLINE Vec3V V3Abs(const Vec3V a)
@@ -1913,23 +1937,39 @@ PX_FORCE_INLINE Vec4V V4Sqrt(const Vec4V a)
 PX_FORCE_INLINE Vec4V V4ScaleAdd(const Vec4V a, const FloatV b, const Vec4V c)
 {
 	ASSERT_ISVALIDFLOATV(b);
+#if PX_VECMATH_FMA
+	return _mm_fmadd_ps(a, b, c);
+#else
 	return V4Add(V4Scale(a, b), c);
+#endif
 }
 
 PX_FORCE_INLINE Vec4V V4NegScaleSub(const Vec4V a, const FloatV b, const Vec4V c)
 {
 	ASSERT_ISVALIDFLOATV(b);
+#if PX_VECMATH_FMA
+	return _mm_fnmadd_ps(a, b, c);
+#else
 	return V4Sub(c, V4Scale(a, b));
+#endif
 }
 
 PX_FORCE_INLINE Vec4V V4MulAdd(const Vec4V a, const Vec4V b, const Vec4V c)
 {
+#if PX_VECMATH_FMA
+	return _mm_fmadd_ps(a, b, c);
+#else
 	return V4Add(V4Mul(a, b), c);
+#endif
 }
 
 PX_FORCE_INLINE Vec4V V4NegMulSub(const Vec4V a, const Vec4V b, const Vec4V c)
 {
+#if PX_VECMATH_FMA
+	return _mm_fnmadd_ps(a, b, c);
+#else
 	return V4Sub(c, V4Mul(a, b));
+#endif
 }
 
 PX_FORCE_INLINE Vec4V V4Abs(const Vec4V a)
@@ -32,6 +32,10 @@
 #include "PsHashMap.h"
 #include "PsArray.h"
 #include "PsMutex.h"
+#include "PsThread.h"
+#include "PsUtilities.h"
+
+#include <string.h>
 
 namespace physx
 {
@@ -108,6 +112,79 @@ void NamedAllocator::deallocate(void* ptr)
 
 #endif // PX_DEBUG
 
+namespace
+{
+struct CategoryPattern
+{
+	const char* pattern;
+	AllocationCategory::Enum category;
+};
+
+// module prefixes of file names, longest first where one prefix contains another
+const CategoryPattern gFilePrefixes[] = {
+	{ "PxVehicle", AllocationCategory::eVEHICLE },	{ "Vehicle", AllocationCategory::eVEHICLE },
+	{ "Pxs", AllocationCategory::eLOW_LEVEL },		{ "Pxc", AllocationCategory::eLOW_LEVEL },
+	{ "Pxv", AllocationCategory::eLOW_LEVEL },		{ "Pxd", AllocationCategory::eLOW_LEVEL },
+	{ "Bp", AllocationCategory::eBROADPHASE },		{ "Dy", AllocationCategory::eDYNAMICS },
+	{ "Gu", AllocationCategory::eGEOMETRY },		{ "Sq", AllocationCategory::eSCENE_QUERY },
+	{ "Sc", AllocationCategory::eSIMULATION },		{ "Np", AllocationCategory::eSDK },
+	{ "Cct", AllocationCategory::eCHARACTER },		{ "Ext", AllocationCategory::eEXTENSIONS },
+	{ "Sn", AllocationCategory::eEXTENSIONS }
+};
+
+// modules whose files carry no prefix
+const CategoryPattern gDirectories[] = { { "PhysXCooking", AllocationCategory::eCOOKING },
+	                                     { "PhysXVehicle", AllocationCategory::eVEHICLE },
+	                                     { "PhysXCharacterKinematic", AllocationCategory::eCHARACTER },
+	                                     { "PhysXExtensions", AllocationCategory::eEXTENSIONS } };
+}
+
+AllocationCategory::Enum getAllocationCategory(const char* filename)
+{
+	if(!filename)
+		return AllocationCategory::eOTHER;
+
+	const char* name = filename;
+	for(const char* c = filename; *c; c++)
+	{
+		if(*c == '/' || *c == '\\')
+			name = c + 1;
+	}
+
+	// foundation sources allocate for themselves, foundation headers for whoever uses the container
+	if(name[0] == 'P' && name[1] == 's')
+	{
+		const char* ext = ::strrchr(name, '.');
+		return (ext && ext[1] == 'h') ? AllocationCategory::eOTHER : AllocationCategory::eFOUNDATION;
+	}
+
+	for(PxU32 i = 0; i < PX_ARRAY_SIZE(gFilePrefixes); i++)
+	{
+		if(!::strncmp(name, gFilePrefixes[i].pattern, ::strlen(gFilePrefixes[i].pattern)))
+			return gFilePrefixes[i].category;
+	}
+
+	for(PxU32 i = 0; i < PX_ARRAY_SIZE(gDirectories); i++)
+	{
+		if(::strstr(filename, gDirectories[i].pattern))
+			return gDirectories[i].category;
+	}
+
+	return AllocationCategory::eOTHER;
+}
+
+AllocationScope::AllocationScope(AllocationCategory::Enum category)
+{
+	const uint32_t slot = getFoundation().getAllocationScopeTlsSlot();
+	mPrevious = TlsGetValue(slot);
+	TlsSetValue(slot, size_t(category) + 1);
+}
+
+AllocationScope::~AllocationScope()
+{
+	TlsSetValue(getFoundation().getAllocationScopeTlsSlot(), mPrevious);
+}
+
 void* Allocator::allocate(size_t size, const char* file, int line)
 {
 	if(!size)
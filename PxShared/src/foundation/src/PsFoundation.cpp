@@ -33,6 +33,7 @@
 #include "PsFoundation.h"
 #include "PsString.h"
 #include "PsAllocator.h"
+#include "PsThread.h"
 
 namespace physx
 {
@@ -56,6 +57,8 @@ Foundation::Foundation(PxErrorCallback& errc, PxAllocatorCallback& alloc)
 , mErrorMutex(PX_DEBUG_EXP("Foundation::mErrorMutex"))
 , mNamedAllocMutex(PX_DEBUG_EXP("Foundation::mNamedAllocMutex"))
 , mTempAllocMutex(PX_DEBUG_EXP("Foundation::mTempAllocMutex"))
+, mTempAllocThreadCaches(NULL)
+, mTempAllocTlsSlot(TlsAlloc())
 {
 }
 
@@ -73,6 +76,24 @@ Foundation::~Foundation()
 		}
 	}
 	mTempAllocFreeTable.reset();
+
+	// and the chunks cached by the threads
+	for(TempAllocatorThreadCache* cache = mTempAllocThreadCaches; cache;)
+	{
+		for(PxU32 i = 0; i < TempAllocatorThreadCache::eNB_SIZE_CLASSES; ++i)
+		{
+			for(TempAllocatorChunk* ptr = cache->mFree[i]; ptr;)
+			{
+				TempAllocatorChunk* next = ptr->mNext;
+				alloc.deallocate(ptr);
+				ptr = next;
+			}
+		}
+		TempAllocatorThreadCache* next = cache->mNext;
+		alloc.deallocate(cache);
+		cache = next;
+	}
+	TlsFree(mTempAllocTlsSlot);
 }
 
 Foundation& Foundation::getInstance()
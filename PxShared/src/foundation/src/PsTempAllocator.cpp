@@ -36,6 +36,7 @@
 #include "PsAtomic.h"
 #include "PsIntrinsics.h"
 #include "PsBitUtils.h"
+#include "PsThread.h"
 
 #if PX_VC
 #pragma warning(disable : 4706) // assignment within conditional expression
@@ -61,6 +62,32 @@ PX_INLINE Foundation::Mutex& getMutex()
 
 const PxU32 sMinIndex = 8;  // 256B min
 const PxU32 sMaxIndex = 17; // 128kB max
+
+PX_COMPILE_TIME_ASSERT(TempAllocatorThreadCache::eNB_SIZE_CLASSES == sMaxIndex - sMinIndex);
+
+TempAllocatorThreadCache* getThreadCache(const char* filename, int line)
+{
+	Foundation& foundation = getFoundation();
+	TempAllocatorThreadCache* cache = reinterpret_cast<TempAllocatorThreadCache*>(TlsGet(foundation.getTempAllocTlsSlot()));
+	if(cache)
+		return cache;
+
+	cache = reinterpret_cast<TempAllocatorThreadCache*>(NonTrackingAllocator().allocate(sizeof(TempAllocatorThreadCache), filename, line));
+	if(!cache)
+		return NULL;
+
+	for(PxU32 i = 0; i < TempAllocatorThreadCache::eNB_SIZE_CLASSES; ++i)
+	{
+		cache->mFree[i] = NULL;
+		cache->mNbFree[i] = 0;
+	}
+	{
+		Foundation::Mutex::ScopedLock lock(getMutex());
+		foundation.addTempAllocThreadCache(*cache);
+	}
+	TlsSet(foundation.getTempAllocTlsSlot(), cache);
+	return cache;
+}
 }
 
 void* TempAllocator::allocate(size_t size, const char* filename, int line)
@@ -71,7 +98,15 @@ void* TempAllocator::allocate(size_t size, const char* filename, int line)
 	uint32_t index = PxMax(highestSetBit(uint32_t(size) + sizeof(Chunk) - 1), sMinIndex);
 
 	Chunk* chunk = 0;
-	if(index < sMaxIndex)
+	TempAllocatorThreadCache* cache = index < sMaxIndex ? getThreadCache(filename, line) : NULL;
+	if(cache && cache->mFree[index - sMinIndex])
+	{
+		// exact size class from this thread's cache, no lock
+		chunk = cache->mFree[index - sMinIndex];
+		cache->mFree[index - sMinIndex] = chunk->mNext;
+		cache->mNbFree[index - sMinIndex]--;
+	}
+	else if(index < sMaxIndex)
 	{
 		Foundation::Mutex::ScopedLock lock(getMutex());
 
@@ -115,6 +150,15 @@ void TempAllocator::deallocate(void* ptr)
 	if(index >= sMaxIndex)
 		return NonTrackingAllocator().deallocate(chunk);
 
+	TempAllocatorThreadCache* cache = reinterpret_cast<TempAllocatorThreadCache*>(TlsGet(getFoundation().getTempAllocTlsSlot()));
+	if(cache && cache->mNbFree[index - sMinIndex] < TempAllocatorThreadCache::eMAX_CHUNKS_PER_CLASS)
+	{
+		chunk->mNext = cache->mFree[index - sMinIndex];
+		cache->mFree[index - sMinIndex] = chunk;
+		cache->mNbFree[index - sMinIndex]++;
+		return;
+	}
+
 	Foundation::Mutex::ScopedLock lock(getMutex());
 
 	index -= sMinIndex;
@@ -30,6 +30,13 @@
 #include "foundation/PxSimpleTypes.h"
 #include "PsCpu.h"
 
+#if(PX_X86 || PX_X64) && !PX_EMSCRIPTEN
+#include <cpuid.h>
+#define PX_HAS_CPUID_H 1
+#else
+#define PX_HAS_CPUID_H 0
+#endif
+
 #if PX_X86 && !PX_EMSCRIPTEN
 #define cpuid(op, reg)                                                                                                 \
 	__asm__ __volatile__("pushl %%ebx      \n\t" /* save %ebx */                                                       \
@@ -54,5 +61,30 @@ uint8_t Cpu::getCpuId()
 	cpuid(1, cpuInfo);
 	return static_cast<uint8_t>(cpuInfo[1] >> 24); // APIC Physical ID
 }
+
+bool Cpu::hasAvx2Fma()
+{
+#if PX_HAS_CPUID_H
+	unsigned int eax, ebx, ecx, edx;
+	if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		return false;
+
+	const unsigned int avxFlags = (1u << 12) | (3u << 27); // FMA3, OSXSAVE and AVX
+	if((ecx & avxFlags) != avxFlags)
+		return false;
+
+	unsigned int xcr0Lo, xcr0Hi;
+	__asm__ __volatile__("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+	if((xcr0Lo & 0x6) != 0x6)
+		return false; // OS does not save YMM registers
+
+	if(__get_cpuid_max(0, NULL) < 7)
+		return false;
+	__cpuid_count(7, 0, eax, ebx, ecx, edx);
+	return (ebx & (1u << 5)) != 0; // AVX2
+#else
+	return false;
+#endif
+}
 }
 }
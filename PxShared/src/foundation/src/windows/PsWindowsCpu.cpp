@@ -51,6 +51,11 @@ uint8_t Cpu::getCpuId()
 	cpuid(cpuInfo);
 	return static_cast<uint8_t>(cpuInfo[1] >> 24); // APIC Physical ID
 }
+
+bool Cpu::hasAvx2Fma()
+{
+	return false;
+}
 #else
 uint8_t Cpu::getCpuId()
 {
@@ -59,6 +64,26 @@ uint8_t Cpu::getCpuId()
 	__cpuid(CPUInfo, InfoType);
 	return static_cast<uint8_t>(CPUInfo[1] >> 24); // APIC Physical ID
 }
+
+bool Cpu::hasAvx2Fma()
+{
+#if _MSC_FULL_VER < 160040219 || !defined(_XCR_XFEATURE_ENABLED_MASK)
+	// need at least VC10 SP1 for xgetbv
+	return false;
+#else
+	int cpuInfo[4];
+	__cpuid(cpuInfo, 1);
+	const int avxFlags = (1 << 12) | (3 << 27); // FMA3, OSXSAVE and AVX
+	if((cpuInfo[2] & avxFlags) != avxFlags)
+		return false;
+
+	if((_xgetbv(_XCR_XFEATURE_ENABLED_MASK) & 0x6) != 0x6)
+		return false; // OS does not save YMM registers
+
+	__cpuidex(cpuInfo, 7, 0);
+	return (cpuInfo[1] & (1 << 5)) != 0; // AVX2
+#endif
+}
 #endif
 }
 }
@@ -0,0 +1,301 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#include "pvd/PxPvdTransport.h"
+#include "foundation/PxAssert.h"
+#include "foundation/PxMath.h"
+
+#include "PxPvdAsyncFileTransport.h"
+#include "PxPvdLz4.h"
+#include "PsBitUtils.h"
+#include "PsIntrinsics.h"
+
+namespace physx
+{
+namespace pvdsdk
+{
+
+static const uint32_t sHashLog = 12;
+// the writer thread also wakes up on its own, so that small writes reach the file without waiting for a full block
+static const uint32_t sWriterSleepMs = 10;
+
+PvdAsyncFileTransport::PvdAsyncFileTransport(const char* name, uint32_t bufferSize, bool compress)
+: mWritePos(0)
+, mReadPos(0)
+, mBlock(NULL)
+, mCompressedBlock(NULL)
+, mHashTable(NULL)
+, mCompress(compress)
+, mStarted(false)
+, mConnected(false)
+, mWrittenData(0)
+, mNbStalls(0)
+, mLocked(false)
+{
+	mFileBuffer = PX_NEW(PsFileBuffer)(name, PxFileBuf::OPEN_WRITE_ONLY);
+
+	bufferSize = PxMax(bufferSize, lz4::sMaxBlockSize);
+	bufferSize = shdfnd::isPowerOfTwo(bufferSize) ? bufferSize : shdfnd::nextPowerOfTwo(bufferSize);
+	mRing = reinterpret_cast<uint8_t*>(PX_ALLOC(bufferSize, "PvdAsyncFileTransport"));
+	mRingMask = bufferSize - 1;
+
+	if(mCompress)
+	{
+		mBlock = reinterpret_cast<uint8_t*>(PX_ALLOC(lz4::sMaxBlockSize, "PvdAsyncFileTransport"));
+		mCompressedBlock = reinterpret_cast<uint8_t*>(PX_ALLOC(lz4::getMaxBlockSize(lz4::sMaxBlockSize), "PvdAsyncFileTransport"));
+		mHashTable = reinterpret_cast<uint32_t*>(PX_ALLOC(sizeof(uint32_t) << sHashLog, "PvdAsyncFileTransport"));
+	}
+}
+
+PvdAsyncFileTransport::~PvdAsyncFileTransport()
+{
+}
+
+bool PvdAsyncFileTransport::connect()
+{
+	PX_ASSERT(mFileBuffer);
+	if(mConnected)
+		return true;
+	if(!mFileBuffer->isOpen())
+		return false;
+
+	if(!mStarted)
+	{
+		if(mCompress)
+		{
+			uint8_t header[lz4::sFrameHeaderSize];
+			if(!writeToFile(header, lz4::writeFrameHeader(header)))
+				return false;
+		}
+		mStarted = true;
+		mConnected = true;
+		setName("PxPvdAsyncFileWriter");
+		start();
+		return true;
+	}
+
+	mConnected = true;
+	return true;
+}
+
+void PvdAsyncFileTransport::disconnect()
+{
+	mConnected = false;
+}
+
+bool PvdAsyncFileTransport::isConnected()
+{
+	return mConnected;
+}
+
+bool PvdAsyncFileTransport::write(const uint8_t* inBytes, uint32_t inLength)
+{
+	PX_ASSERT(mLocked);
+	if(!mConnected)
+		return false;
+
+	const uint32_t ringSize = mRingMask + 1;
+	const uint32_t length = inLength;
+	while(inLength)
+	{
+		const uint32_t writePos = mWritePos;
+		const uint32_t space = ringSize - (writePos - mReadPos);
+		if(!space)
+		{
+			// back-pressure: wait for the writer thread, resetting first so that its signal cannot be missed
+			mNbStalls++;
+			mDataAvailable.set();
+			mSpaceAvailable.reset();
+			if(mWritePos - mReadPos == ringSize && mConnected)
+				mSpaceAvailable.wait(sWriterSleepMs);
+			if(!mConnected)
+				return false;
+			continue;
+		}
+
+		const uint32_t size = PxMin(space, inLength);
+		const uint32_t offset = writePos & mRingMask;
+		const uint32_t firstPart = PxMin(size, ringSize - offset);
+		PxMemCopy(mRing + offset, inBytes, firstPart);
+		PxMemCopy(mRing, inBytes + firstPart, size - firstPart);
+
+		shdfnd::memoryBarrier();
+		mWritePos = writePos + size;
+		inBytes += size;
+		inLength -= size;
+	}
+
+	mWrittenData += length;
+	if(mWritePos - mReadPos >= lz4::sMaxBlockSize)
+		mDataAvailable.set();
+	return true;
+}
+
+PxPvdTransport& PvdAsyncFileTransport::lock()
+{
+	mMutex.lock();
+	PX_ASSERT(!mLocked);
+	mLocked = true;
+	return *this;
+}
+
+void PvdAsyncFileTransport::unlock()
+{
+	PX_ASSERT(mLocked);
+	mLocked = false;
+	mMutex.unlock();
+}
+
+void PvdAsyncFileTransport::flush()
+{
+	if(!mStarted)
+		return;
+
+	// blocks until everything written so far has been handed to the file
+	const uint32_t writePos = mWritePos;
+	while(mConnected && int32_t(writePos - mReadPos) > 0)
+	{
+		mSpaceAvailable.reset();
+		mDataAvailable.set();
+		if(int32_t(writePos - mReadPos) > 0)
+			mSpaceAvailable.wait(sWriterSleepMs);
+	}
+}
+
+uint64_t PvdAsyncFileTransport::getWrittenDataSize()
+{
+	return mWrittenData;
+}
+
+bool PvdAsyncFileTransport::writeToFile(const uint8_t* data, uint32_t size)
+{
+	if(mFileBuffer->write(data, size) == size)
+		return true;
+
+	// the file is unusable from now on, fail the writes instead of blocking them
+	mConnected = false;
+	mSpaceAvailable.set();
+	return false;
+}
+
+void PvdAsyncFileTransport::drain(uint32_t size)
+{
+	const uint32_t ringSize = mRingMask + 1;
+	const uint32_t offset = mReadPos & mRingMask;
+	const uint32_t firstPart = PxMin(size, ringSize - offset);
+
+	if(mCompress)
+	{
+		PX_ASSERT(size <= lz4::sMaxBlockSize);
+		PxMemCopy(mBlock, mRing + offset, firstPart);
+		PxMemCopy(mBlock + firstPart, mRing, size - firstPart);
+		writeToFile(mCompressedBlock, lz4::compressBlock(mBlock, size, mCompressedBlock, mHashTable, sHashLog));
+	}
+	else
+	{
+		if(writeToFile(mRing + offset, firstPart) && firstPart < size)
+			writeToFile(mRing, size - firstPart);
+	}
+
+	shdfnd::memoryBarrier();
+	mReadPos += size;
+	mSpaceAvailable.set();
+}
+
+void PvdAsyncFileTransport::execute()
+{
+	for(;;)
+	{
+		const bool quit = quitIsSignalled();
+		const uint32_t available = mWritePos - mReadPos;
+		shdfnd::memoryBarrier();
+
+		if(available)
+		{
+			drain(mCompress ? PxMin(available, lz4::sMaxBlockSize) : available);
+			continue;
+		}
+
+		if(quit)
+			break;
+
+		mDataAvailable.reset();
+		if(mWritePos == mReadPos)
+			mDataAvailable.wait(sWriterSleepMs);
+	}
+
+	quit();
+}
+
+void PvdAsyncFileTransport::stopWriter()
+{
+	if(!mStarted)
+		return;
+
+	signalQuit();
+	mDataAvailable.set();
+	waitForQuit();
+	mStarted = false;
+
+	if(mCompress && mFileBuffer->isOpen())
+	{
+		uint8_t endMark[lz4::sFrameEndMarkSize];
+		mFileBuffer->write(endMark, lz4::writeFrameEndMark(endMark));
+	}
+}
+
+void PvdAsyncFileTransport::release()
+{
+	stopWriter();
+	mConnected = false;
+
+	if(mFileBuffer)
+	{
+		mFileBuffer->close();
+		PX_DELETE(mFileBuffer);
+	}
+	mFileBuffer = NULL;
+
+	PX_FREE(mHashTable);
+	PX_FREE(mCompressedBlock);
+	PX_FREE(mBlock);
+	PX_FREE(mRing);
+	PX_DELETE(this);
+}
+
+} // namespace pvdsdk
+
+PxPvdTransport* PxDefaultPvdAsyncFileTransportCreate(const char* name, uint32_t bufferSize, bool compress)
+{
+	if(!name)
+		return PxDefaultPvdFileTransportCreate(NULL);
+	return PX_NEW(pvdsdk::PvdAsyncFileTransport)(name, bufferSize, compress);
+}
+
+} // namespace physx
@@ -0,0 +1,107 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef PXPVDSDK_PXPVDASYNCFILETRANSPORT_H
+#define PXPVDSDK_PXPVDASYNCFILETRANSPORT_H
+
+#include "pvd/PxPvdTransport.h"
+
+#include "PsUserAllocated.h"
+#include "PsFileBuffer.h"
+#include "PsMutex.h"
+#include "PsSync.h"
+#include "PsThread.h"
+
+namespace physx
+{
+namespace pvdsdk
+{
+
+/*
+File transport which does not write from the calling thread. write() copies the data into a ring buffer, and a writer
+thread drains it to the file, optionally as an LZ4 frame. The ring only has one producer since PVD always writes with the
+transport locked. Writers block when the ring is full: the PVD stream is stateful, so no part of it can be dropped without
+making the rest of the capture unreadable.
+*/
+class PvdAsyncFileTransport : public physx::PxPvdTransport, public physx::shdfnd::Thread
+{
+	PX_NOCOPY(PvdAsyncFileTransport)
+  public:
+	PvdAsyncFileTransport(const char* name, uint32_t bufferSize, bool compress);
+	virtual ~PvdAsyncFileTransport();
+
+	virtual bool connect();
+	virtual void disconnect();
+	virtual bool isConnected();
+
+	virtual bool write(const uint8_t* inBytes, uint32_t inLength);
+
+	virtual PxPvdTransport& lock();
+	virtual void unlock();
+
+	virtual void flush();
+
+	virtual uint64_t getWrittenDataSize();
+
+	virtual void release();
+
+	// writer thread
+	virtual void execute();
+
+  private:
+	bool writeToFile(const uint8_t* data, uint32_t size);
+	void drain(uint32_t size);
+	void stopWriter();
+
+	physx::PsFileBuffer* mFileBuffer;
+	uint8_t* mRing;
+	uint32_t mRingMask;
+	volatile uint32_t mWritePos; // only advanced by the producer
+	volatile uint32_t mReadPos;  // only advanced by the writer thread
+	physx::shdfnd::Sync mDataAvailable;
+	physx::shdfnd::Sync mSpaceAvailable;
+
+	// writer thread data
+	uint8_t* mBlock;
+	uint8_t* mCompressedBlock;
+	uint32_t* mHashTable;
+
+	bool mCompress;
+	bool mStarted;
+	volatile bool mConnected;
+	uint64_t mWrittenData;
+	uint32_t mNbStalls;
+	physx::shdfnd::Mutex mMutex;
+	bool mLocked; // for debug, remove it when finished
+};
+
+} // pvdsdk
+} // physx
+
+#endif // PXPVDSDK_PXPVDASYNCFILETRANSPORT_H
@@ -0,0 +1,212 @@
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2018 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef PXPVDSDK_PXPVDLZ4_H
+#define PXPVDSDK_PXPVDLZ4_H
+
+#include "foundation/PxSimpleTypes.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxAssert.h"
+
+namespace physx
+{
+namespace pvdsdk
+{
+// Minimal LZ4 frame writer (independent blocks, no checksums). The output can be decompressed by any LZ4 tool, e.g.
+// "lz4 -d capture.pxd2.lz4 capture.pxd2", which restores the original PVD stream.
+namespace lz4
+{
+static const uint32_t sMaxBlockSize = 64 * 1024;
+static const uint32_t sFrameHeaderSize = 7;
+static const uint32_t sFrameEndMarkSize = 4;
+
+// Worst case size of a compressed block, including its size prefix: incompressible blocks are stored raw.
+PX_INLINE uint32_t getMaxBlockSize(uint32_t inputSize)
+{
+	return inputSize + 4;
+}
+
+PX_INLINE uint32_t read32(const uint8_t* p)
+{
+	uint32_t v;
+	PxMemCopy(&v, p, 4);
+	return v;
+}
+
+PX_INLINE void writeLE32(uint8_t* p, uint32_t v)
+{
+	p[0] = uint8_t(v);
+	p[1] = uint8_t(v >> 8);
+	p[2] = uint8_t(v >> 16);
+	p[3] = uint8_t(v >> 24);
+}
+
+PX_INLINE uint32_t rotl32(uint32_t v, uint32_t r)
+{
+	return (v << r) | (v >> (32 - r));
+}
+
+// xxHash32 for inputs of less than 16 bytes, which is all the frame descriptor needs
+PX_INLINE uint32_t xxh32Small(const uint8_t* p, uint32_t len)
+{
+	const uint32_t prime1 = 2654435761u, prime2 = 2246822519u, prime3 = 3266489917u, prime4 = 668265263u, prime5 = 374761393u;
+	uint32_t h = prime5 + len;
+	uint32_t i = 0;
+	for(; i + 4 <= len; i += 4)
+	{
+		h += read32(p + i) * prime3;
+		h = rotl32(h, 17) * prime4;
+	}
+	for(; i < len; i++)
+	{
+		h += p[i] * prime5;
+		h = rotl32(h, 11) * prime1;
+	}
+	h ^= h >> 15;
+	h *= prime2;
+	h ^= h >> 13;
+	h *= prime3;
+	h ^= h >> 16;
+	return h;
+}
+
+PX_INLINE uint32_t writeFrameHeader(uint8_t* dst)
+{
+	writeLE32(dst, 0x184D2204);
+	dst[4] = 0x60; // version 01, independent blocks
+	dst[5] = 0x40; // 64 KB maximum block size
+	dst[6] = uint8_t(xxh32Small(dst + 4, 2) >> 8);
+	return sFrameHeaderSize;
+}
+
+PX_INLINE uint32_t writeFrameEndMark(uint8_t* dst)
+{
+	writeLE32(dst, 0);
+	return sFrameEndMarkSize;
+}
+
+PX_INLINE uint8_t* writeLength(uint8_t* op, uint32_t len)
+{
+	while(len >= 255)
+	{
+		*op++ = 255;
+		len -= 255;
+	}
+	*op++ = uint8_t(len);
+	return op;
+}
+
+PX_INLINE uint8_t* writeSequence(uint8_t* op, const uint8_t* literals, uint32_t nbLiterals, uint32_t offset, uint32_t matchLength)
+{
+	uint8_t* token = op++;
+	*token = uint8_t((nbLiterals >= 15 ? 15 : nbLiterals) << 4);
+	if(nbLiterals >= 15)
+		op = writeLength(op, nbLiterals - 15);
+	PxMemCopy(op, literals, nbLiterals);
+	op += nbLiterals;
+	if(matchLength)
+	{
+		*op++ = uint8_t(offset);
+		*op++ = uint8_t(offset >> 8);
+		const uint32_t len = matchLength - 4;
+		*token = uint8_t(*token | (len >= 15 ? 15 : len));
+		if(len >= 15)
+			op = writeLength(op, len - 15);
+	}
+	return op;
+}
+
+/**
+\brief Compresses one block and writes it with its size prefix.
+
+\param src input data, at most sMaxBlockSize bytes
+\param dst output, at least getMaxBlockSize(srcSize) bytes
+\param hashTable scratch table of (1<<hashLog) entries
+\return Number of bytes written to dst
+*/
+PX_INLINE uint32_t compressBlock(const uint8_t* src, uint32_t srcSize, uint8_t* dst, uint32_t* hashTable, uint32_t hashLog)
+{
+	PX_ASSERT(srcSize <= sMaxBlockSize);
+	const uint32_t minMatch = 4, lastLiterals = 5, matchLimit = 12;
+
+	uint8_t* op = dst + 4;
+	const uint8_t* const opLimit = dst + 4 + srcSize; // stored raw if compression does not gain anything
+	uint32_t anchor = 0;
+
+	if(srcSize > matchLimit)
+	{
+		for(uint32_t i = 0; i < (1u << hashLog); i++)
+			hashTable[i] = 0xffffffff;
+
+		const uint32_t matchEnd = srcSize - lastLiterals;
+		uint32_t ip = 0;
+		while(ip + matchLimit <= srcSize)
+		{
+			const uint32_t sequence = read32(src + ip);
+			const uint32_t h = (sequence * 2654435761u) >> (32 - hashLog);
+			const uint32_t ref = hashTable[h];
+			hashTable[h] = ip;
+			if(ref == 0xffffffff || ip - ref > 0xffff || read32(src + ref) != sequence)
+			{
+				ip++;
+				continue;
+			}
+
+			uint32_t len = minMatch;
+			while(ip + len < matchEnd && src[ref + len] == src[ip + len])
+				len++;
+
+			// token + literal length bytes + literals + offset + match length bytes
+			if(op + 1 + (ip - anchor) / 255 + 1 + (ip - anchor) + 2 + len / 255 + 1 > opLimit)
+				break;
+			op = writeSequence(op, src + anchor, ip - anchor, ip - ref, len);
+			ip += len;
+			anchor = ip;
+		}
+	}
+
+	const uint32_t nbLiterals = srcSize - anchor;
+	if(op + 1 + nbLiterals / 255 + 1 + nbLiterals < opLimit)
+	{
+		op = writeSequence(op, src + anchor, nbLiterals, 0, 0);
+		const uint32_t size = uint32_t(op - dst - 4);
+		writeLE32(dst, size);
+		return size + 4;
+	}
+
+	writeLE32(dst, srcSize | 0x80000000);
+	PxMemCopy(dst + 4, src, srcSize);
+	return srcSize + 4;
+}
+
+} // namespace lz4
+} // namespace pvdsdk
+} // namespace physx
+
+#endif // PXPVDSDK_PXPVDLZ4_H
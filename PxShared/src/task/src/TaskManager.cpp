@@ -153,6 +153,10 @@ public:
 	PxTaskID  submitUnnamedTask( PxTask& task, PxTaskType::Enum type = PxTaskType::TT_CPU );
 	PxTask*   getTaskFromID( PxTaskID );
 
+	void	addTaskRun( uint32_t tensOfNanoseconds );
+	void	getTaskStatistics( uint32_t& nbTasks, uint32_t& tensOfNanoseconds ) const;
+	void	resetTaskStatistics();
+
 	bool    dispatchTask( PxTaskID taskID, bool gpuGroupStart );
 	bool    resolveRow( PxTaskID taskID, bool gpuGroupStart );
 
@@ -173,6 +177,8 @@ public:
 	PxGpuDispatcher           *mGpuDispatcher;		
 	PxTaskNameToIDMap          mName2IDmap;
 	volatile int			 mPendingTasks;
+	volatile int32_t		 mNbTaskRuns;
+	volatile int32_t		 mTaskRunTime;
     shdfnd::Mutex            mMutex;
 
 	PxTaskDepTable				 mDepTable;
@@ -198,6 +204,8 @@ PxTaskMgr::PxTaskMgr(PxErrorCallback& errorCallback, PxCpuDispatcher* cpuDispatc
 	, mCpuDispatcher( cpuDispatcher )
     , mGpuDispatcher( gpuDispatcher )	
 	, mPendingTasks( 0 )
+	, mNbTaskRuns( 0 )
+	, mTaskRunTime( 0 )
 	, mDepTable(PX_DEBUG_EXP("PxTaskDepTable"))
 	, mTaskTable(PX_DEBUG_EXP("PxTaskTable"))	
 	, mStartDispatch(PX_DEBUG_EXP("StartDispatch"))
@@ -306,6 +314,24 @@ void PxTaskMgr::addReference(PxLightCpuTask& lighttask)
  * Called by the owner (Scene) at the start of every frame, before
  * asking for tasks to be submitted.
  */
+void PxTaskMgr::addTaskRun( uint32_t tensOfNanoseconds )
+{
+	shdfnd::atomicIncrement(&mNbTaskRuns);
+	shdfnd::atomicAdd(&mTaskRunTime, int32_t(tensOfNanoseconds));
+}
+
+void PxTaskMgr::getTaskStatistics( uint32_t& nbTasks, uint32_t& tensOfNanoseconds ) const
+{
+	nbTasks = uint32_t(mNbTaskRuns);
+	tensOfNanoseconds = uint32_t(mTaskRunTime);
+}
+
+void PxTaskMgr::resetTaskStatistics()
+{
+	mNbTaskRuns = 0;
+	mTaskRunTime = 0;
+}
+
 void PxTaskMgr::resetDependencies()
 {
 #if DOT_LOG